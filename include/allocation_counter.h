@@ -0,0 +1,50 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+
+// Heap accounting: every operator new in a program linked with src/allocation_counter.cpp goes through
+// these counters (malloc inside stb, tinyexr and the driver doesn't). The process totals are shared by all
+// threads; threadAllocations() counts only the calling thread's, so a frame on the GL thread can be
+// measured while the logger and the pool workers allocate next to it. Without the .cpp linked in,
+// everything stays 0.
+namespace AllocationCounter
+{
+    // operator new calls since startup
+    inline std::atomic<size_t> &allocations()
+    {
+        static std::atomic<size_t> count(0);
+        return count;
+    }
+
+    // bytes requested from operator new since startup
+    inline std::atomic<size_t> &allocatedBytes()
+    {
+        static std::atomic<size_t> bytes(0);
+        return bytes;
+    }
+
+    // bytes allocated and not yet deleted
+    inline std::atomic<size_t> &liveBytes()
+    {
+        static std::atomic<size_t> bytes(0);
+        return bytes;
+    }
+
+    // high-water mark of liveBytes(); store liveBytes() into it to start a new measurement
+    inline std::atomic<size_t> &peakLiveBytes()
+    {
+        static std::atomic<size_t> bytes(0);
+        return bytes;
+    }
+
+    // operator new calls made by the calling thread
+    inline size_t &threadAllocations()
+    {
+        static thread_local size_t count = 0;
+        return count;
+    }
+}
+
+#endif
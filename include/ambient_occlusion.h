@@ -0,0 +1,200 @@
+#ifndef AMBIENT_OCCLUSION_H
+#define AMBIENT_OCCLUSION_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// SSAO=1: screen-space ambient occlusion of the opaque scene for the diffuse IBL term, so wheel wells and
+// interiors no longer get the full sky. compute() runs between the opaque depth and the opaque shading
+// (after the depth pre-pass, or before the visibility buffer's resolve), all at half resolution:
+//   1. the scene depth is blitted (nearest) into a half-size depth texture
+//   2. shaders/ssao.fs integrates the visible arc of the hemisphere along two screen directions per pixel
+//      (ground-truth AO, horizons found in 2 x 4 depth taps), with the directions and step offsets
+//      rotating over a 4x4 pixel tile; it stores the visibility and the view depth
+//   3. shaders/ssao_blur.fs averages each pixel's 4x4 tile back out, weighted by depth similarity
+// The scene shader then reads the four half-size texels around each pixel weighted by bilinear position
+// and depth (a bilateral upsample), so edges keep their own occlusion. SSAO_RADIUS (world units, default
+// 0.5) is the reach of the occluders.
+class AmbientOcclusion
+{
+public:
+    // texture unit of the result in the scene shaders (Shader::samplerUnit), also used by the passes for
+    // their one input
+    static const unsigned int UNIT = 26;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle), ssao.fs and ssao_blur.fs
+    explicit AmbientOcclusion(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("SSAO_RADIUS"))
+            radius = std::max(0.01f, (float)std::atof(env));
+    }
+
+    AmbientOcclusion(const AmbientOcclusion &) = delete;
+    AmbientOcclusion &operator=(const AmbientOcclusion &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("SSAO");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the two passes
+    void init()
+    {
+        occlusionShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/ssao.fs").c_str()));
+        blurShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/ssao_blur.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[SSAO] Half-resolution ambient occlusion, radius " << radius);
+    }
+
+    // false before init() or once the targets turned out unusable
+    bool ready() const { return usable && occlusionShader && blurShader; }
+
+    // GL thread, with the scene framebuffer (ToneMapper's HDR target, `width` x `height`) holding the opaque
+    // depth: builds this frame's occlusion for the view's `projection`. The scene framebuffer and its
+    // viewport are bound again afterwards. False (no occlusion this frame) if the targets can't be used.
+    bool compute(int width, int height, const glm::mat4 &projection)
+    {
+        computed = false;
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!ready() || !scene || width <= 0 || height <= 0)
+            return false;
+        createTargets(std::max(1, width / 2), std::max(1, height / 2));
+        if (!usable)
+            return false;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbos[DEPTH]);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, targetWidth, targetHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glDisable(GL_DEPTH_TEST);
+        glViewport(0, 0, targetWidth, targetHeight);
+        glState().bindVertexArray(emptyVao);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[RAW]);
+        occlusionShader->use();
+        occlusionShader->setInt("depthMap", (int)UNIT);
+        occlusionShader->setMat4("inverseProjection", glm::inverse(projection));
+        occlusionShader->setFloat("radius", radius);
+        // pixels of the half-size target per world unit at view depth 1
+        occlusionShader->setFloat("radiusScale", projection[1][1] * 0.5f * (float)targetHeight);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, textures[DEPTH]);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[BLURRED]);
+        blurShader->use();
+        blurShader->setInt("rawOcclusion", (int)UNIT);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, textures[RAW]);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+        glViewport(0, 0, width, height);
+        glEnable(GL_DEPTH_TEST);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, textures[BLURRED]);
+        computed = true;
+        return true;
+    }
+
+    // points `shader` (the scene shader or its visibility resolve, already in use) at this frame's
+    // occlusion, or tells it there's none
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uScreenOcclusion = Shader::uniformHandle("screenOcclusion");
+        shader.setBool(uScreenOcclusion, computed);
+        if (computed)
+            glState().bindTexture(UNIT, GL_TEXTURE_2D, textures[BLURRED]);
+    }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        occlusionShader.reset();
+        blurShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        computed = false;
+        glState().invalidate();
+    }
+
+private:
+    // the half-size depth copy, the noisy occlusion and the blurred one (RG16F: visibility, view depth)
+    enum Target { DEPTH, RAW, BLURRED, TARGET_COUNT };
+
+    std::string shaderDir;
+    float radius = 0.5f;
+    bool usable = false;
+    bool computed = false;
+    std::unique_ptr<Shader> occlusionShader;
+    std::unique_ptr<Shader> blurShader;
+    // the passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    GLuint fbos[TARGET_COUNT] = {0, 0, 0};
+    GLuint textures[TARGET_COUNT] = {0, 0, 0};
+    int targetWidth = 0, targetHeight = 0;
+
+    void createTargets(int width, int height)
+    {
+        if (fbos[DEPTH] && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        glGenTextures(TARGET_COUNT, textures);
+        glGenFramebuffers(TARGET_COUNT, fbos);
+        for (int t = 0; t < TARGET_COUNT; ++t)
+        {
+            glBindTexture(GL_TEXTURE_2D, textures[t]);
+            // the depth copy matches the scene's 24/8 format, which the blit requires
+            if (t == DEPTH)
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+            else
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_HALF_FLOAT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbos[t]);
+            if (t == DEPTH)
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, textures[t], 0);
+            else
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[t], 0);
+            if (t == DEPTH)
+            {
+                glDrawBuffer(GL_NONE);
+                glReadBuffer(GL_NONE);
+            }
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            {
+                LOG_WARN("[SSAO] Half-size depth copy or RG16F target unsupported, no ambient occlusion");
+                usable = false;
+            }
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTargets()
+    {
+        if (fbos[0]) glDeleteFramebuffers(TARGET_COUNT, fbos);
+        if (textures[0]) glDeleteTextures(TARGET_COUNT, textures);
+        for (int t = 0; t < TARGET_COUNT; ++t)
+            fbos[t] = textures[t] = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Compile-time log threshold: messages below it compile to nothing (their arguments aren't evaluated).
+//   0 = debug (per-mesh / per-texture load lines, model positions), 1 = info, 2 = warnings, 3 = errors
+// Set it from CMake with -DLOG_MIN_LEVEL=<n>.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1
+#endif
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+
+// LOG_INFO("[Tag] " << a << "," << b); formats on the calling thread, prints on the logger's. One call is
+// one line (the newline is added).
+#define LOG_AT(level, ...)                                   \
+    do                                                       \
+    {                                                        \
+        if ((level) >= LOG_MIN_LEVEL)                        \
+        {                                                    \
+            std::ostringstream logStream_;                   \
+            logStream_ << __VA_ARGS__;                       \
+            asyncLog().write((level), logStream_.str());     \
+        }                                                    \
+    } while (0)
+// variadic so commas inside the stream expression (template arguments, calls) need no extra parentheses
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+// Console output off the render thread. Producers (any thread, including GL debug callbacks) copy a line
+// into a fixed ring of slots with one compare-and-swap (a bounded MPSC queue after Vyukov's MPMC one);
+// a background thread drains it to stdout (warnings and errors to stderr) and flushes once per batch.
+// Nothing on the producer side blocks or allocates beyond the formatting: when the ring is full the line
+// is dropped and counted. Multi-line messages (shader info logs) go in as one slot per line.
+class AsyncLog
+{
+public:
+    static const size_t CAPACITY = 4096; // slots, a power of two
+    static const size_t LINE = 496;      // bytes of text per slot; longer lines are cut
+
+    AsyncLog()
+    {
+        for (size_t i = 0; i < CAPACITY; ++i)
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        writer = std::thread(&AsyncLog::drainLoop, this);
+    }
+
+    // drains what's queued and stops the writer
+    ~AsyncLog()
+    {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+
+    AsyncLog(const AsyncLog &) = delete;
+    AsyncLog &operator=(const AsyncLog &) = delete;
+
+    // queues `text` (one line per '\n'; a trailing newline is ignored)
+    void write(int level, const std::string &text)
+    {
+        size_t start = 0;
+        const size_t end = !text.empty() && text[text.size() - 1] == '\n' ? text.size() - 1 : text.size();
+        do
+        {
+            size_t newline = text.find('\n', start);
+            if (newline == std::string::npos || newline > end)
+                newline = end;
+            push(level, text.data() + start, newline - start);
+            start = newline + 1;
+        } while (start <= end && start < text.size());
+    }
+
+    // blocks until everything queued so far has been printed (exit paths, before abort)
+    void flush()
+    {
+        const size_t target = tail.load(std::memory_order_acquire);
+        while (printed.load(std::memory_order_acquire) < target)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        int level;
+        uint32_t length;
+        char text[LINE];
+    };
+
+    Slot slots[CAPACITY];
+    // producers claim slots at `tail`; the writer consumes at `head` (its own) and publishes `printed`
+    std::atomic<size_t> tail{0};
+    size_t head = 0;
+    std::atomic<size_t> printed{0};
+    std::atomic<size_t> dropped{0};
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    void push(int level, const char *text, size_t length)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &slots[pos & (CAPACITY - 1)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // full: the writer is a whole ring behind
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+                pos = tail.load(std::memory_order_relaxed);
+        }
+        slot->level = level;
+        slot->length = (uint32_t)(length < LINE ? length : LINE);
+        std::memcpy(slot->text, text, slot->length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void drainLoop()
+    {
+        int idleMs = 1;
+        for (;;)
+        {
+            // read before draining, so a stop request can't overtake the last lines
+            const bool stop = stopping.load(std::memory_order_acquire);
+            bool out = false, err = false;
+            for (;;)
+            {
+                Slot &slot = slots[head & (CAPACITY - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+                    break;
+                FILE *stream = slot.level >= LOG_LEVEL_WARN ? stderr : stdout;
+                std::fwrite(slot.text, 1, slot.length, stream);
+                std::fputc('\n', stream);
+                (stream == stderr ? err : out) = true;
+                slot.sequence.store(head + CAPACITY, std::memory_order_release);
+                ++head;
+                printed.store(head, std::memory_order_release);
+            }
+            const size_t lost = dropped.exchange(0, std::memory_order_relaxed);
+            if (lost)
+            {
+                std::fprintf(stderr, "[Log] %zu lines dropped (queue full)\n", lost);
+                err = true;
+            }
+            if (out)
+                std::fflush(stdout);
+            if (err)
+                std::fflush(stderr);
+            if (stop)
+                return;
+            // back off while idle: 1 ms after output, up to 8 ms
+            idleMs = out || err ? 1 : (idleMs < 8 ? idleMs * 2 : 8);
+            std::this_thread::sleep_for(std::chrono::milliseconds(idleMs));
+        }
+    }
+};
+
+// process-wide; the writer thread starts with the first message
+inline AsyncLog &asyncLog()
+{
+    static AsyncLog log;
+    return log;
+}
+
+#endif
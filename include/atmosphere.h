@@ -0,0 +1,190 @@
+#ifndef ATMOSPHERE_H
+#define ATMOSPHERE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <atmosphere_model.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <procedural_sky.h>
+#include <shader.h>
+#include <tone_mapper.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+// GPU half of the procedural sky's atmosphere (AtmosphereModel): three small RGBA16F LUTs rendered by
+// shaders/atmosphere.fs. The transmittance (256x64) and multiple scattering (32x32) LUTs depend only on the
+// atmosphere and are rendered once by init(); the sky-view LUT (128x96: azimuth from the sun, elevation)
+// depends on the sun's elevation and is re-rendered by update() whenever that changes, for a fraction of a
+// millisecond. procedural_sky.fs then reads any sky direction from it (apply()), both when the IBL bake
+// renders the environment's faces and when the skybox draws the sky behind the scene every frame, so the
+// backdrop follows the sun at once while the lower resolution re-bake catches up within a few frames.
+class Atmosphere
+{
+public:
+    // texture units of the LUTs while their readers draw: the post passes' units (ToneMapper's bloom and
+    // exposure, TemporalAA's velocity), which the bake and the skybox never run alongside
+    static const unsigned int UNIT_TRANSMITTANCE = ToneMapper::UNIT_BLOOM;
+    static const unsigned int UNIT_SKY_VIEW = ToneMapper::UNIT_EXPOSURE;
+    static const unsigned int UNIT_MULTI_SCATTERING = 19;
+
+    Atmosphere() {}
+    Atmosphere(const Atmosphere &) = delete;
+    Atmosphere &operator=(const Atmosphere &) = delete;
+
+    // GL thread, once the context exists: renders the two fixed LUTs (`shaderDir` holds oit_resolve.vs,
+    // the fullscreen triangle, and atmosphere.fs)
+    void init(const std::string &shaderDir)
+    {
+        if (program)
+            return;
+        program.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/atmosphere.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        bool complete = createLut(luts[TRANSMITTANCE], 256, 64, "atmosphere transmittance") &&
+                        createLut(luts[MULTI_SCATTERING], 32, 32, "atmosphere multiple scattering") &&
+                        createLut(luts[SKY_VIEW], 128, 96, "atmosphere sky view");
+        if (!complete)
+        {
+            LOG_WARN("[Atmosphere] Float render targets unsupported, the procedural sky falls back to the gradient");
+            releaseGpu();
+            return;
+        }
+        renderLut(TRANSMITTANCE, glm::vec3(0.0f));
+        renderLut(MULTI_SCATTERING, glm::vec3(0.0f));
+        LOG_INFO("[Atmosphere] Transmittance and multiple scattering LUTs ready");
+    }
+
+    bool ready() const { return program && luts[SKY_VIEW].fbo; }
+
+    // GL thread: the sky-view LUT for a sun towards `sunDirection`, re-rendered only if its elevation changed
+    void update(const glm::vec3 &sunDirection)
+    {
+        const float elevation = glm::normalize(sunDirection).y;
+        if (!ready() || (skyViewRendered && std::fabs(elevation - skyViewElevation) < 1e-6f))
+            return;
+        renderLut(SKY_VIEW, glm::normalize(sunDirection));
+        skyViewRendered = true;
+        skyViewElevation = elevation;
+    }
+
+    // GL thread: sets up procedural_sky.fs (`shader`, in use) for `sky`: the atmosphere's LUTs bound when
+    // the sky is the atmosphere and they are ready, else the gradient. update() must have run for the sun
+    // beforehand, before the caller's program went in use (it draws with a program of its own).
+    void apply(Shader &shader, const ProceduralSky &sky)
+    {
+        const bool use = sky.atmosphere && ready();
+        shader.setBool("atmosphere", use);
+        if (!use)
+            return;
+        shader.setInt("transmittanceLut", (int)UNIT_TRANSMITTANCE);
+        shader.setInt("skyViewLut", (int)UNIT_SKY_VIEW);
+        shader.setFloat("illuminanceScale", AtmosphereModel::ILLUMINANCE_SCALE);
+        shader.setVec2("sunDiskCos", glm::vec2(std::cos(AtmosphereModel::SUN_ANGULAR_RADIUS * 1.2f),
+                                               std::cos(AtmosphereModel::SUN_ANGULAR_RADIUS * 0.8f)));
+        shader.setFloat("sunDiskRadiance", AtmosphereModel::SUN_DISK_RADIANCE);
+        glState().bindTexture(UNIT_TRANSMITTANCE, GL_TEXTURE_2D, luts[TRANSMITTANCE].texture);
+        glState().bindTexture(UNIT_SKY_VIEW, GL_TEXTURE_2D, luts[SKY_VIEW].texture);
+    }
+
+    void releaseGpu()
+    {
+        for (int l = 0; l < LUT_COUNT; ++l)
+        {
+            if (luts[l].fbo) glDeleteFramebuffers(1, &luts[l].fbo);
+            if (luts[l].texture)
+            {
+                gpuMemory().releaseTexture(luts[l].texture);
+                glDeleteTextures(1, &luts[l].texture);
+            }
+            luts[l] = Lut();
+        }
+        program.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        skyViewRendered = false;
+        glState().invalidate();
+    }
+
+private:
+    // the pass numbers of atmosphere.fs
+    enum { TRANSMITTANCE, MULTI_SCATTERING, SKY_VIEW, LUT_COUNT };
+
+    struct Lut
+    {
+        GLuint fbo = 0;
+        GLuint texture = 0;
+        int width = 0, height = 0;
+    };
+
+    std::unique_ptr<Shader> program;
+    // the passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    Lut luts[LUT_COUNT];
+    bool skyViewRendered = false;
+    float skyViewElevation = 0.0f;
+
+    bool createLut(Lut &lut, int width, int height, const char *name)
+    {
+        lut.width = width;
+        lut.height = height;
+        glGenTextures(1, &lut.texture);
+        glBindTexture(GL_TEXTURE_2D, lut.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        gpuMemory().trackTexture(lut.texture, GpuMemory::ENVIRONMENT, GL_RGBA16F, width, height, 1, false, name);
+        glGenFramebuffers(1, &lut.fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, lut.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lut.texture, 0);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+        return complete;
+    }
+
+    // one pass of atmosphere.fs into its LUT; the framebuffer, viewport and depth test are restored
+    void renderLut(int pass, const glm::vec3 &sunDirection)
+    {
+        GLint framebuffer = 0, viewport[4];
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+        const Lut &lut = luts[pass];
+        glBindFramebuffer(GL_FRAMEBUFFER, lut.fbo);
+        glViewport(0, 0, lut.width, lut.height);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        program->use();
+        program->setInt("pass", pass);
+        program->setVec2("targetTexel", glm::vec2(1.0f / lut.width, 1.0f / lut.height));
+        program->setInt("transmittanceLut", (int)UNIT_TRANSMITTANCE);
+        program->setInt("multiScatteringLut", (int)UNIT_MULTI_SCATTERING);
+        program->setVec3("sunDirection", sunDirection);
+        glState().bindTexture(UNIT_TRANSMITTANCE, GL_TEXTURE_2D, pass == TRANSMITTANCE ? 0 : luts[TRANSMITTANCE].texture);
+        glState().bindTexture(UNIT_MULTI_SCATTERING, GL_TEXTURE_2D, pass == SKY_VIEW ? luts[MULTI_SCATTERING].texture : 0);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)framebuffer);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        if (depthTest)
+            glEnable(GL_DEPTH_TEST);
+    }
+};
+
+// process-wide: the IBL bake and the skybox both read the LUTs
+inline Atmosphere &atmosphere()
+{
+    static Atmosphere instance;
+    return instance;
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef ATMOSPHERE_MODEL_H
+#define ATMOSPHERE_MODEL_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Earth's atmosphere for the procedural sky, after Hillaire, "A Scalable and Production Ready Sky and
+// Atmosphere Rendering Technique" (2020): Rayleigh and Mie scattering with exponential densities, an ozone
+// layer that only absorbs, and multiple scattering folded into an isotropic term per height and sun angle.
+// Distances are in km, radiance is per unit of sun illuminance (times ILLUMINANCE_SCALE * sunIntensity).
+//
+// This is the CPU twin of shaders/atmosphere.fs (keep the two in sync), used for the sky's diffuse SH
+// (ProceduralSky::irradiance). Its transmittance and multiple scattering tables are built once, on first
+// use, at lower resolution than the GPU's LUTs; sky radiance is marched per direction instead of read from
+// a sky-view LUT.
+namespace AtmosphereModel
+{
+    const float PI = 3.14159265f;
+    const float GROUND_RADIUS = 6360.0f;
+    const float TOP_RADIUS = 6460.0f;
+    const float VIEW_HEIGHT = 0.2f; // the viewer, above the ground
+    const glm::vec3 RAYLEIGH_SCATTERING(5.802e-3f, 13.558e-3f, 33.1e-3f);
+    const float RAYLEIGH_HEIGHT = 8.0f;
+    const float MIE_SCATTERING = 3.996e-3f;
+    const float MIE_ABSORPTION = 4.4e-3f;
+    const float MIE_HEIGHT = 1.2f;
+    const float MIE_G = 0.8f;
+    const glm::vec3 OZONE_ABSORPTION(0.650e-3f, 1.881e-3f, 0.085e-3f);
+    const glm::vec3 GROUND_ALBEDO(0.3f);
+
+    // ProceduralSky::sunIntensity times this is the sun's illuminance: the default intensity (6) then
+    // gives the sky about the brightness of the old gradient, which the direct sun light was tuned against
+    const float ILLUMINANCE_SCALE = 4.0f;
+    // the visible sun disk, enlarged about twice so that it covers a few texels of the baked cube faces,
+    // and its radiance relative to the sun's illuminance (not energy conserving: the shaders' directional
+    // sun light carries the direct light, the disk is what chrome reflects)
+    const float SUN_ANGULAR_RADIUS = 0.0087f;
+    const float SUN_DISK_RADIANCE = 150.0f;
+
+    struct Medium
+    {
+        glm::vec3 rayleigh;
+        float mie;
+        glm::vec3 extinction;
+    };
+
+    inline Medium mediumAt(float height)
+    {
+        Medium m;
+        m.rayleigh = RAYLEIGH_SCATTERING * std::exp(-height / RAYLEIGH_HEIGHT);
+        const float mieDensity = std::exp(-height / MIE_HEIGHT);
+        m.mie = MIE_SCATTERING * mieDensity;
+        const float ozone = std::max(0.0f, 1.0f - std::fabs(height - 25.0f) / 15.0f);
+        m.extinction = m.rayleigh + glm::vec3((MIE_SCATTERING + MIE_ABSORPTION) * mieDensity) + OZONE_ABSORPTION * ozone;
+        return m;
+    }
+
+    // distance along unit `dir` from `pos` (relative to the planet's centre) to the sphere of `radius`,
+    // the nearest one ahead; -1 if there is none
+    inline float raySphere(const glm::vec3 &pos, const glm::vec3 &dir, float radius)
+    {
+        const float b = glm::dot(pos, dir);
+        const float c = glm::dot(pos, pos) - radius * radius;
+        float d = b * b - c;
+        if (d < 0.0f)
+            return -1.0f;
+        d = std::sqrt(d);
+        if (-b - d > 0.0f)
+            return -b - d;
+        return -b + d > 0.0f ? -b + d : -1.0f;
+    }
+
+    // marching steps grow quadratically, so rays along the ground sample the dense low air finely
+    inline void marchStep(int step, int steps, float distance, float &t, float &dt)
+    {
+        const float t0 = (float)step / steps, t1 = (float)(step + 1) / steps;
+        t = distance * 0.5f * (t0 * t0 + t1 * t1);
+        dt = distance * (t1 * t1 - t0 * t0);
+    }
+
+    inline float rayleighPhase(float cosTheta) { return 3.0f / (16.0f * PI) * (1.0f + cosTheta * cosTheta); }
+
+    // Cornette-Shanks
+    inline float miePhase(float cosTheta)
+    {
+        const float g2 = MIE_G * MIE_G;
+        const float denominator = std::pow(std::max(1.0f + g2 - 2.0f * MIE_G * cosTheta, 1e-4f), 1.5f);
+        return 3.0f / (8.0f * PI) * (1.0f - g2) * (1.0f + cosTheta * cosTheta) / ((2.0f + g2) * denominator);
+    }
+
+    // a small RGB table over [0, 1]^2, read bilinearly like the GPU's LUTs
+    struct Table
+    {
+        int width = 0, height = 0;
+        std::vector<glm::vec3> texels;
+
+        glm::vec3 sample(float u, float v) const
+        {
+            const float x = glm::clamp(u * width - 0.5f, 0.0f, (float)(width - 1));
+            const float y = glm::clamp(v * height - 0.5f, 0.0f, (float)(height - 1));
+            const int x0 = (int)x, y0 = (int)y;
+            const int x1 = std::min(x0 + 1, width - 1), y1 = std::min(y0 + 1, height - 1);
+            const float fx = x - x0, fy = y - y0;
+            const glm::vec3 top = glm::mix(texels[y0 * width + x0], texels[y0 * width + x1], fx);
+            const glm::vec3 bottom = glm::mix(texels[y1 * width + x0], texels[y1 * width + x1], fx);
+            return glm::mix(top, bottom, fy);
+        }
+    };
+
+    // the LUTs' parameterization: cosine of the zenith angle across, height up
+    inline glm::vec2 lutUv(float height, float cosZenith)
+    {
+        return glm::vec2(cosZenith * 0.5f + 0.5f, height / (TOP_RADIUS - GROUND_RADIUS));
+    }
+
+    // transmittance from `height` to the top of the atmosphere at `cosZenith`; 0 through the ground
+    inline glm::vec3 computeTransmittance(float height, float cosZenith)
+    {
+        const glm::vec3 pos(0.0f, GROUND_RADIUS + height, 0.0f);
+        const glm::vec3 dir(std::sqrt(std::max(0.0f, 1.0f - cosZenith * cosZenith)), cosZenith, 0.0f);
+        if (raySphere(pos, dir, GROUND_RADIUS) > 0.0f)
+            return glm::vec3(0.0f);
+        const float distance = std::max(raySphere(pos, dir, TOP_RADIUS), 0.0f);
+        const int steps = 40;
+        glm::vec3 depth(0.0f);
+        for (int s = 0; s < steps; ++s)
+        {
+            float t, dt;
+            marchStep(s, steps, distance, t, dt);
+            depth += mediumAt(glm::length(pos + dir * t) - GROUND_RADIUS).extinction * dt;
+        }
+        return glm::exp(-depth);
+    }
+
+    inline const Table &transmittanceTable()
+    {
+        static const Table table = []() {
+            Table t;
+            t.width = 128;
+            t.height = 32;
+            t.texels.resize((size_t)t.width * t.height);
+            for (int y = 0; y < t.height; ++y)
+                for (int x = 0; x < t.width; ++x)
+                    t.texels[y * t.width + x] = computeTransmittance((y + 0.5f) / t.height * (TOP_RADIUS - GROUND_RADIUS),
+                                                                     (x + 0.5f) / t.width * 2.0f - 1.0f);
+            return t;
+        }();
+        return table;
+    }
+
+    // transmittance towards the sun from `pos` (relative to the planet's centre)
+    inline glm::vec3 sunTransmittance(const glm::vec3 &pos, const glm::vec3 &sun)
+    {
+        const float r = glm::length(pos);
+        const glm::vec2 uv = lutUv(r - GROUND_RADIUS, glm::dot(pos / r, sun));
+        return transmittanceTable().sample(uv.x, uv.y);
+    }
+
+    // light scattered towards `pos` from every direction once the sun's first bounce is spread out: the
+    // second order, isotropically, over a uniform sphere of directions, summed as the geometric series of
+    // the fraction each order passes on
+    inline glm::vec3 computeMultiScattering(float height, float cosSunZenith)
+    {
+        const glm::vec3 pos(0.0f, GROUND_RADIUS + height, 0.0f);
+        const glm::vec3 sun(std::sqrt(std::max(0.0f, 1.0f - cosSunZenith * cosSunZenith)), cosSunZenith, 0.0f);
+        const int rings = 8, steps = 20;
+        glm::vec3 luminance(0.0f), transfer(0.0f);
+        for (int i = 0; i < rings; ++i)
+            for (int j = 0; j < rings; ++j)
+            {
+                const float cosTheta = 1.0f - 2.0f * (i + 0.5f) / rings;
+                const float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+                const float phi = 2.0f * PI * (j + 0.5f) / rings;
+                const glm::vec3 dir(sinTheta * std::cos(phi), cosTheta, sinTheta * std::sin(phi));
+                const float ground = raySphere(pos, dir, GROUND_RADIUS);
+                const float distance = ground > 0.0f ? ground : std::max(raySphere(pos, dir, TOP_RADIUS), 0.0f);
+                glm::vec3 throughput(1.0f);
+                for (int s = 0; s < steps; ++s)
+                {
+                    float t, dt;
+                    marchStep(s, steps, distance, t, dt);
+                    const glm::vec3 p = pos + dir * t;
+                    const Medium m = mediumAt(glm::length(p) - GROUND_RADIUS);
+                    const glm::vec3 step = glm::exp(-m.extinction * dt);
+                    const glm::vec3 scattering = m.rayleigh + glm::vec3(m.mie);
+                    const glm::vec3 in = scattering * sunTransmittance(p, sun) / (4.0f * PI);
+                    luminance += throughput * (in - in * step) / m.extinction;
+                    transfer += throughput * (scattering - scattering * step) / m.extinction;
+                    throughput *= step;
+                }
+                if (ground > 0.0f)
+                {
+                    const glm::vec3 p = pos + dir * ground;
+                    luminance += throughput * sunTransmittance(p, sun) * std::max(glm::dot(glm::normalize(p), sun), 0.0f) * GROUND_ALBEDO / PI;
+                }
+            }
+        luminance /= (float)(rings * rings);
+        transfer /= (float)(rings * rings);
+        return luminance / (glm::vec3(1.0f) - transfer);
+    }
+
+    inline const Table &multiScatteringTable()
+    {
+        static const Table table = []() {
+            Table t;
+            t.width = 16;
+            t.height = 16;
+            t.texels.resize((size_t)t.width * t.height);
+            for (int y = 0; y < t.height; ++y)
+                for (int x = 0; x < t.width; ++x)
+                    t.texels[y * t.width + x] = computeMultiScattering((y + 0.5f) / t.height * (TOP_RADIUS - GROUND_RADIUS),
+                                                                       (x + 0.5f) / t.width * 2.0f - 1.0f);
+            return t;
+        }();
+        return table;
+    }
+
+    // sky radiance towards the viewer along unit `dir`, for unit sun illuminance from unit `sun` (the sun
+    // disk not included)
+    inline glm::vec3 skyRadiance(const glm::vec3 &dir, const glm::vec3 &sun)
+    {
+        const glm::vec3 pos(0.0f, GROUND_RADIUS + VIEW_HEIGHT, 0.0f);
+        const float ground = raySphere(pos, dir, GROUND_RADIUS);
+        const float distance = ground > 0.0f ? ground : std::max(raySphere(pos, dir, TOP_RADIUS), 0.0f);
+        const float cosTheta = glm::dot(dir, sun);
+        const float phaseR = rayleighPhase(cosTheta), phaseM = miePhase(cosTheta);
+        const int steps = 32;
+        glm::vec3 luminance(0.0f), throughput(1.0f);
+        for (int s = 0; s < steps; ++s)
+        {
+            float t, dt;
+            marchStep(s, steps, distance, t, dt);
+            const glm::vec3 p = pos + dir * t;
+            const float r = glm::length(p);
+            const Medium m = mediumAt(r - GROUND_RADIUS);
+            const glm::vec3 step = glm::exp(-m.extinction * dt);
+            const glm::vec2 uv = lutUv(r - GROUND_RADIUS, glm::dot(p / r, sun));
+            const glm::vec3 in = (m.rayleigh * phaseR + glm::vec3(m.mie * phaseM)) * transmittanceTable().sample(uv.x, uv.y) +
+                                 (m.rayleigh + glm::vec3(m.mie)) * multiScatteringTable().sample(uv.x, uv.y);
+            luminance += throughput * (in - in * step) / m.extinction;
+            throughput *= step;
+        }
+        if (ground > 0.0f)
+        {
+            const glm::vec3 p = pos + dir * ground;
+            luminance += throughput * sunTransmittance(p, sun) * std::max(glm::dot(glm::normalize(p), sun), 0.0f) * GROUND_ALBEDO / PI;
+        }
+        return luminance;
+    }
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef AUTO_EXPOSURE_H
+#define AUTO_EXPOSURE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <shader.h>
+#include <tone_mapper.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// AUTO_EXPOSURE=1: the exposure follows the scene's brightness, so a bright outdoor HDRI doesn't blow out
+// where a dim studio one looked right. update() measures the linear HDR image just before the tone map
+// and leaves the exposure in a one-texel R32F texture that ToneMapper reads (setAutoExposure()); it never
+// comes back to the CPU. EXPOSURE still applies on top, as compensation.
+//   GL 4.3: shaders/luminance_histogram.comp counts every second pixel of each row and column into a
+//           256-bin log-luminance histogram, shaders/exposure_adapt.comp exposes the mean of its middle
+//           (the darkest 10% and brightest 5% of the pixels left out) and clears it for the next frame
+//   GL 3.3: shaders/log_luminance.fs writes log luminance into a 256x256 target whose mip chain averages
+//           it, shaders/exposure_adapt.fs exposes that mean into the other of two exposure texels
+// The exposure eases towards its target in stops, AUTO_EXPOSURE_SPEED (default 1.5) per second;
+// AUTO_EXPOSURE_KEY (default 0.18) is the luminance the mean is exposed to, so a mid-grey scene keeps the
+// fixed exposure's look.
+class AutoExposure
+{
+public:
+    // texture unit of the images each pass reads (the HDR target, the log luminance, the previous exposure);
+    // the tone map's bloom unit, which Bloom::build binds its own levels to afterwards
+    static const unsigned int UNIT = ToneMapper::UNIT_BLOOM;
+    // the previous exposure in the GL 3.3 path: the tone map's exposure unit, rebound by it afterwards
+    static const unsigned int UNIT_PREVIOUS = ToneMapper::UNIT_EXPOSURE;
+
+    // `shaderDir` holds the two compute shaders, or oit_resolve.vs (the fullscreen triangle),
+    // log_luminance.fs and exposure_adapt.fs
+    explicit AutoExposure(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("AUTO_EXPOSURE_SPEED"))
+            speed = std::max(0.0f, (float)std::atof(env));
+        if (const char *env = std::getenv("AUTO_EXPOSURE_KEY"))
+            key = std::max(1e-4f, (float)std::atof(env));
+    }
+
+    AutoExposure(const AutoExposure &) = delete;
+    AutoExposure &operator=(const AutoExposure &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("AUTO_EXPOSURE");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the histogram programs where compute shaders are available, else the raster ones,
+    // and creates the exposure texels (0 = not measured yet)
+    void init()
+    {
+        if (ComputeShader::supported())
+        {
+            histogramProgram.reset(new ComputeShader((shaderDir + "/luminance_histogram.comp").c_str()));
+            adaptProgram.reset(new ComputeShader((shaderDir + "/exposure_adapt.comp").c_str()));
+            useHistogram = histogramProgram->valid() && adaptProgram->valid();
+        }
+        if (useHistogram)
+        {
+            glGenBuffers(1, &histogramBuffer);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, histogramBuffer);
+            const GLuint zeros[BINS] = {};
+            glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(zeros), zeros, GL_DYNAMIC_COPY);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            gpuMemory().trackBuffer(histogramBuffer, GpuMemory::DRAW_BUFFERS, sizeof(zeros), "exposure histogram");
+        }
+        else
+        {
+            histogramProgram.reset();
+            adaptProgram.reset();
+            luminanceShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/log_luminance.fs").c_str()));
+            adaptShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/exposure_adapt.fs").c_str()));
+            glGenVertexArrays(1, &emptyVao);
+            createLuminanceTarget();
+        }
+        // the compute path updates its one texel in place; the raster path alternates between two
+        for (int e = 0; e < (useHistogram ? 1 : 2); ++e)
+        {
+            const float zero = 0.0f;
+            glGenTextures(1, &exposureTexture[e]);
+            glBindTexture(GL_TEXTURE_2D, exposureTexture[e]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, 1, 1, 0, GL_RED, GL_FLOAT, &zero);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            if (!useHistogram)
+            {
+                glGenFramebuffers(1, &exposureFbo[e]);
+                glBindFramebuffer(GL_FRAMEBUFFER, exposureFbo[e]);
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, exposureTexture[e], 0);
+                usable = usable && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+            }
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+        if (!usable)
+        {
+            LOG_WARN("[AutoExposure] Float render targets unsupported, keeping the fixed exposure");
+            releaseGpu();
+            return;
+        }
+        LOG_INFO("[AutoExposure] " << (useHistogram ? "Luminance histogram (compute)" : "Log luminance mip chain") << ", key " << key
+                                   << ", " << speed << " stops/s");
+    }
+
+    bool ready() const { return usable && (useHistogram ? histogramBuffer != 0 : luminanceFbo != 0); }
+
+    // GL thread, after the scene's last HDR pass: measures `source` (linear, `width` x `height`) and moves
+    // the exposure towards it for a frame of `deltaTime` seconds (the first measurement applies at once).
+    // Returns the exposure texture for ToneMapper::setAutoExposure, or 0; the scene framebuffer is bound
+    // again afterwards, with the viewport on the whole source.
+    GLuint update(GLuint source, int width, int height, float deltaTime)
+    {
+        if (!ready() || !source || width <= 0 || height <= 0)
+            return 0;
+        const float adaptation = measured ? 1.0f - std::exp(-speed * std::max(deltaTime, 0.0f)) : 1.0f;
+        measured = true;
+        if (useHistogram)
+        {
+            const int stride = 2;
+            const int columns = (width + stride - 1) / stride, rows = (height + stride - 1) / stride;
+            histogramProgram->use();
+            histogramProgram->setInt("hdrImage", (int)UNIT);
+            histogramProgram->setIvec2("imageSize", width, height);
+            histogramProgram->setInt("stride", stride);
+            histogramProgram->setFloat("minLogLuminance", MIN_LOG_LUMINANCE);
+            histogramProgram->setFloat("logLuminanceRange", LOG_LUMINANCE_RANGE);
+            glState().bindTexture(UNIT, GL_TEXTURE_2D, source);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, histogramBuffer);
+            glDispatchCompute((GLuint)(columns + 15) / 16, (GLuint)(rows + 15) / 16, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            adaptProgram->use();
+            adaptProgram->setFloat("minLogLuminance", MIN_LOG_LUMINANCE);
+            adaptProgram->setFloat("logLuminanceRange", LOG_LUMINANCE_RANGE);
+            adaptProgram->setFloat("lowPercent", 0.10f);
+            adaptProgram->setFloat("highPercent", 0.95f);
+            adaptProgram->setFloat("key", key);
+            adaptProgram->setFloat("adaptation", adaptation);
+            adaptProgram->setFloat("minExposure", MIN_EXPOSURE);
+            adaptProgram->setFloat("maxExposure", MAX_EXPOSURE);
+            glBindImageTexture(0, exposureTexture[0], 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+            glDispatchCompute(1, 1, 1);
+            // the tone map fetches the texel; next frame's passes count into the cleared bins and load it
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+            glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+            return exposureTexture[0];
+        }
+        static const Shader::UniformHandle uHdrImage = Shader::uniformHandle("hdrImage");
+        static const Shader::UniformHandle uTargetTexel = Shader::uniformHandle("targetTexel");
+        static const Shader::UniformHandle uMinLogLuminance = Shader::uniformHandle("minLogLuminance");
+        static const Shader::UniformHandle uLogLuminanceRange = Shader::uniformHandle("logLuminanceRange");
+        static const Shader::UniformHandle uLogLuminance = Shader::uniformHandle("logLuminance");
+        static const Shader::UniformHandle uLogLuminanceLevel = Shader::uniformHandle("logLuminanceLevel");
+        static const Shader::UniformHandle uPreviousExposure = Shader::uniformHandle("previousExposure");
+        static const Shader::UniformHandle uKey = Shader::uniformHandle("key");
+        static const Shader::UniformHandle uAdaptation = Shader::uniformHandle("adaptation");
+        static const Shader::UniformHandle uMinExposure = Shader::uniformHandle("minExposure");
+        static const Shader::UniformHandle uMaxExposure = Shader::uniformHandle("maxExposure");
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        glState().bindVertexArray(emptyVao);
+        glBindFramebuffer(GL_FRAMEBUFFER, luminanceFbo);
+        glViewport(0, 0, LUMINANCE_SIZE, LUMINANCE_SIZE);
+        luminanceShader->use();
+        luminanceShader->setInt(uHdrImage, (int)UNIT);
+        luminanceShader->setVec2(uTargetTexel, glm::vec2(1.0f / LUMINANCE_SIZE));
+        luminanceShader->setFloat(uMinLogLuminance, MIN_LOG_LUMINANCE);
+        luminanceShader->setFloat(uLogLuminanceRange, LOG_LUMINANCE_RANGE);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, source);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, luminanceTexture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        const int next = 1 - current;
+        glBindFramebuffer(GL_FRAMEBUFFER, exposureFbo[next]);
+        glViewport(0, 0, 1, 1);
+        adaptShader->use();
+        adaptShader->setInt(uLogLuminance, (int)UNIT);
+        adaptShader->setFloat(uLogLuminanceLevel, (float)luminanceLevels - 1.0f);
+        adaptShader->setInt(uPreviousExposure, (int)UNIT_PREVIOUS);
+        adaptShader->setFloat(uKey, key);
+        adaptShader->setFloat(uAdaptation, adaptation);
+        adaptShader->setFloat(uMinExposure, MIN_EXPOSURE);
+        adaptShader->setFloat(uMaxExposure, MAX_EXPOSURE);
+        glState().bindTexture(UNIT_PREVIOUS, GL_TEXTURE_2D, exposureTexture[current]);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        current = next;
+        glEnable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glViewport(0, 0, width, height);
+        return exposureTexture[current];
+    }
+
+    void releaseGpu()
+    {
+        histogramProgram.reset();
+        adaptProgram.reset();
+        luminanceShader.reset();
+        adaptShader.reset();
+        if (histogramBuffer)
+        {
+            gpuMemory().releaseBuffer(histogramBuffer);
+            glDeleteBuffers(1, &histogramBuffer);
+        }
+        if (luminanceFbo) glDeleteFramebuffers(1, &luminanceFbo);
+        if (luminanceTexture) glDeleteTextures(1, &luminanceTexture);
+        for (int e = 0; e < 2; ++e)
+        {
+            if (exposureFbo[e]) glDeleteFramebuffers(1, &exposureFbo[e]);
+            if (exposureTexture[e]) glDeleteTextures(1, &exposureTexture[e]);
+            exposureFbo[e] = exposureTexture[e] = 0;
+        }
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        histogramBuffer = luminanceFbo = luminanceTexture = emptyVao = 0;
+        measured = false;
+        glState().invalidate();
+    }
+
+private:
+    // matches the bins of the two compute shaders
+    static const int BINS = 256;
+    // log2 luminance range measured: 1/1024 to 1024 (brighter or darker scenes clamp to its ends)
+    static constexpr float MIN_LOG_LUMINANCE = -10.0f;
+    static constexpr float LOG_LUMINANCE_RANGE = 20.0f;
+    static constexpr float MIN_EXPOSURE = 1.0f / 64.0f;
+    static constexpr float MAX_EXPOSURE = 64.0f;
+    // the raster path's log luminance target (a power of two, so its last mip is one texel)
+    static const int LUMINANCE_SIZE = 256;
+
+    std::string shaderDir;
+    bool usable = true;
+    bool useHistogram = false;
+    bool measured = false;
+    float speed = 1.5f;
+    float key = 0.18f;
+    std::unique_ptr<ComputeShader> histogramProgram;
+    std::unique_ptr<ComputeShader> adaptProgram;
+    GLuint histogramBuffer = 0;
+    std::unique_ptr<Shader> luminanceShader;
+    std::unique_ptr<Shader> adaptShader;
+    // the raster passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    GLuint luminanceFbo = 0;
+    GLuint luminanceTexture = 0;
+    int luminanceLevels = 0;
+    GLuint exposureTexture[2] = {0, 0};
+    GLuint exposureFbo[2] = {0, 0};
+    int current = 0; // raster path: the texel holding the latest exposure
+
+    void createLuminanceTarget()
+    {
+        luminanceLevels = 1;
+        while ((LUMINANCE_SIZE >> luminanceLevels) > 0)
+            ++luminanceLevels;
+        glGenTextures(1, &luminanceTexture);
+        glBindTexture(GL_TEXTURE_2D, luminanceTexture);
+        for (int level = 0; level < luminanceLevels; ++level)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_R16F, LUMINANCE_SIZE >> level, LUMINANCE_SIZE >> level, 0, GL_RED, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glGenFramebuffers(1, &luminanceFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, luminanceFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, luminanceTexture, 0);
+        usable = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+};
+
+#endif
@@ -0,0 +1,416 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <camera.h>
+#include <json.hpp>
+#include <render_farm.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Headless product shots (BATCH_JOB=<job.json>). The app starts with a hidden window, loads the models and
+// the startup environment once, then renders every shot of the job into an offscreen RGBA8 framebuffer of
+// the shot's size (the tone map resolves into it instead of the window) and leaves; FrameCapture reads the
+// images back and encodes them on its threads while the next shot renders. Each shot renders
+// settle_frames frames (shadows, probes, texture streaming and the TAA history settle) and is captured on
+// the last; a shot with an environment waits for it to bake first. Animation time is the shot's `time`.
+//
+//     {"output": "renders/car_", "width": 1920, "height": 1080, "settle_frames": 4,
+//      "shots": [{"name": "front", "position": [0, 1.2, 6], "target": [0, 0.6, 0], "fov": 40},
+//                {"yaw": -90, "pitch": -10, "position": [0, 2, 8], "width": 3840, "height": 2160},
+//                {"azimuth": 30, "elevation": 15, "distance": 1.2, "environment": "studio.exr"}],
+//      "turntable": {"count": 36, "elevation": 10, "distance": 1.3, "name": "spin"}}
+//
+// Shots place the camera by position with yaw/pitch or a target, or orbit the scene bounds' centre by
+// azimuth/elevation (degrees) at `distance` times the bounds' radius; "turntable" appends `count` orbit
+// shots evenly around it. Images go to <output><name>.png (names default to shot_0000, ...).
+// BATCH_FARM=<host>:<port> makes the app a render farm worker instead (render_farm.h): after loading it
+// renders the chunks of shots car_farm hands it, one after the other, and uploads their images.
+class BatchRenderer
+{
+public:
+    struct Shot
+    {
+        std::string name;
+        int width = 0, height = 0;
+        float fov = ZOOM;
+        float time = 0.0f;
+        std::string environment;
+        // explicit placement, or an orbit of the scene bounds
+        bool orbit = false;
+        glm::vec3 position = glm::vec3(0.0f);
+        bool hasTarget = false;
+        glm::vec3 target = glm::vec3(0.0f);
+        float yaw = YAW, pitch = PITCH;
+        float azimuth = 0.0f, elevation = 10.0f, distance = 1.3f;
+    };
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("BATCH_JOB");
+        return (env && *env) || FarmWorker::enabledByEnv();
+    }
+
+    BatchRenderer()
+    {
+        if (FarmWorker::enabledByEnv())
+        {
+            const char *dir = std::getenv("BATCH_FARM_DIR");
+            prefix = dir && *dir ? dir : "farm_";
+            farm.reset(new FarmWorker(std::getenv("BATCH_FARM")));
+            active = true;
+            LOG_INFO("[Batch] Render farm worker of " << std::getenv("BATCH_FARM") << ", images written to " << prefix << "*");
+            return;
+        }
+        if (!enabledByEnv())
+            return;
+        const std::string path = std::getenv("BATCH_JOB");
+        try
+        {
+            std::ifstream in(path.c_str());
+            if (!in)
+            {
+                LOG_ERROR("[Batch] Can't open job file " << path);
+                return;
+            }
+            nlohmann::json job = nlohmann::json::parse(in);
+            parse(job);
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("[Batch] Bad job file " << path << ": " << e.what());
+            shots.clear();
+            return;
+        }
+        active = !shots.empty();
+        if (active)
+            LOG_INFO("[Batch] " << shots.size() << " shots from " << path << ", " << settleFrames << " frames each");
+        else
+            LOG_WARN("[Batch] " << path << " lists no shots");
+    }
+
+    BatchRenderer(const BatchRenderer &) = delete;
+    BatchRenderer &operator=(const BatchRenderer &) = delete;
+
+    bool enabled() const { return active; }
+    // every shot is captured: leave the render loop
+    bool finished() const { return phase == DONE; }
+
+    // GL thread, first thing every frame; `sceneReady` once nothing is loading or baking any more
+    void beginFrame(bool sceneReady)
+    {
+        if (!active || phase == DONE)
+            return;
+        shotStart = false;
+        if (phase == LOADING || phase == ENVIRONMENT)
+        {
+            if (!sceneReady)
+                return;
+            if (phase == LOADING)
+                LOG_INFO("[Batch] Scene ready");
+            phase = farm && phase == LOADING ? FARM_WAIT : RENDER;
+            frame = 0;
+            shotStart = phase == RENDER;
+        }
+        else if (phase == FARM_WAIT)
+            nextChunk();
+        else if (frame == settleFrames)
+        {
+            if (++shot == shots.size())
+            {
+                LOG_INFO("[Batch] " << shots.size() << " shots rendered");
+                phase = DONE;
+                return;
+            }
+            frame = 0;
+            startShot();
+            shotStart = phase == RENDER;
+        }
+    }
+
+    // GL thread, after the frame (captured or not)
+    void endFrame()
+    {
+        if (active && phase == RENDER)
+            ++frame;
+        chunkDone = farm && phase == RENDER && frame == settleFrames && shot + 1 == shots.size();
+    }
+
+    // BATCH_FARM: the frame captured the chunk's last image; the caller writes every capture out (waits for
+    // FrameCapture::finish()) and calls submitChunk()
+    bool chunkRendered() const { return chunkDone; }
+
+    // BATCH_FARM: a capture of the chunk went to `path` (what FrameCapture::capture returned)
+    void captured(const std::string &path)
+    {
+        if (farm && !path.empty())
+            chunkFiles.push_back(path);
+    }
+
+    // BATCH_FARM: uploads the chunk's images (on the worker's thread) and waits for the next chunk
+    void submitChunk()
+    {
+        if (!chunkDone)
+            return;
+        farm->submit(chunkFiles, prefix);
+        chunkFiles.clear();
+        chunkDone = false;
+        phase = FARM_WAIT;
+    }
+
+    // true while the frame renders a shot (not while loading or waiting for its environment)
+    bool rendering() const { return active && phase == RENDER; }
+    // the first frame of a shot: a camera cut for temporal effects
+    bool shotStarted() const { return shotStart; }
+    // the frame to read back into the shot's image
+    bool capturing() const { return rendering() && frame + 1 == settleFrames; }
+
+    // shots render at least `frames` frames whatever the job asks (a progressive renderer that must converge
+    // first, PathTracer)
+    void requireFrames(int frames)
+    {
+        minimumFrames = std::max(1, frames);
+        if (active && settleFrames < minimumFrames)
+            LOG_INFO("[Batch] " << minimumFrames << " frames per shot (instead of " << settleFrames << ")");
+        settleFrames = std::max(settleFrames, minimumFrames);
+    }
+
+    // an environment the caller should load before the shot renders (empty if none; returned once)
+    std::string takeEnvironmentRequest()
+    {
+        std::string path;
+        path.swap(environmentRequest);
+        return path;
+    }
+
+    // a worker waiting for a chunk renders into a small placeholder
+    int width() const { return shot < shots.size() ? shots[shot].width : 64; }
+    int height() const { return shot < shots.size() ? shots[shot].height : 64; }
+    float time() const { return rendering() ? shots[shot].time : 0.0f; }
+    std::string outputPath() const { return prefix + shots[shot].name + ".png"; }
+
+    void placeCamera(Camera &camera, const glm::vec3 &sceneMin, const glm::vec3 &sceneMax) const
+    {
+        if (!rendering())
+            return;
+        const Shot &s = shots[shot];
+        camera.Zoom = s.fov;
+        if (s.orbit)
+        {
+            const glm::vec3 center = 0.5f * (sceneMin + sceneMax);
+            const float radius = std::max(0.5f * glm::length(sceneMax - sceneMin), 0.5f);
+            // the vertical field of view has to hold the bounding sphere
+            const float back = s.distance * radius / std::sin(glm::radians(0.5f * s.fov));
+            const float az = glm::radians(s.azimuth), el = glm::radians(s.elevation);
+            camera.Position = center + back * glm::vec3(std::sin(az) * std::cos(el), std::sin(el), std::cos(az) * std::cos(el));
+            camera.LookAt(center);
+            return;
+        }
+        camera.Position = s.position;
+        if (s.hasTarget)
+        {
+            camera.LookAt(s.target);
+            return;
+        }
+        camera.Yaw = s.yaw;
+        camera.Pitch = s.pitch;
+        camera.ProcessMouseMovement(0.0f, 0.0f);
+    }
+
+    // the job's "shots" and then its "turntable" orbits, one JSON object per shot, each with its "name"
+    // (car_farm cuts the same list into chunks, so the names stay the job's)
+    static std::vector<nlohmann::json> shotEntries(const nlohmann::json &job)
+    {
+        std::vector<nlohmann::json> entries;
+        if (job.count("shots"))
+            for (size_t i = 0; i < job["shots"].size(); ++i)
+                entries.push_back(job["shots"][i]);
+        if (job.count("turntable"))
+        {
+            const nlohmann::json &t = job["turntable"];
+            const int count = std::max(1, t.value("count", 36));
+            for (int k = 0; k < count; ++k)
+            {
+                nlohmann::json e = t;
+                e.erase("count");
+                e["azimuth"] = t.value("start", 0.0f) + 360.0f * k / count;
+                char name[32];
+                std::snprintf(name, sizeof(name), "_%03d", k);
+                e["name"] = t.value("name", std::string("turntable")) + name;
+                entries.push_back(e);
+            }
+        }
+        for (size_t i = 0; i < entries.size(); ++i)
+            if (!entries[i].count("name"))
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "shot_%04d", (int)i);
+                entries[i]["name"] = name;
+            }
+        return entries;
+    }
+
+    // GL thread: the shot-sized framebuffer the frame resolves into (re-created when the size changes)
+    GLuint outputFramebuffer()
+    {
+        const int w = width(), h = height();
+        if (fbo && w == fboWidth && h == fboHeight)
+            return fbo;
+        releaseGpu();
+        glGenTextures(1, &colorTexture);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            LOG_WARN("[Batch] " << w << "x" << h << " output framebuffer incomplete");
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        fboWidth = w;
+        fboHeight = h;
+        return fbo;
+    }
+
+    void releaseGpu()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorTexture) glDeleteTextures(1, &colorTexture);
+        fbo = colorTexture = 0;
+        fboWidth = fboHeight = 0;
+    }
+
+private:
+    enum Phase { LOADING, ENVIRONMENT, RENDER, FARM_WAIT, DONE };
+
+    bool active = false;
+    Phase phase = LOADING;
+    std::vector<Shot> shots;
+    std::string prefix = "batch_";
+    int settleFrames = 4;
+    int minimumFrames = 1;
+    size_t shot = 0;
+    int frame = 0;
+    bool shotStart = false;
+    std::string environmentRequest;
+    std::string currentEnvironment;
+    GLuint fbo = 0, colorTexture = 0;
+    int fboWidth = 0, fboHeight = 0;
+    // BATCH_FARM
+    std::unique_ptr<FarmWorker> farm;
+    std::vector<std::string> chunkFiles;
+    bool chunkDone = false;
+    int chunksRendered = 0;
+
+    static glm::vec3 vec3Of(const nlohmann::json &j)
+    {
+        return glm::vec3(j.at(0).get<float>(), j.at(1).get<float>(), j.at(2).get<float>());
+    }
+
+    // BATCH_FARM: starts the chunk that arrived, if one has; leaves when the coordinator has no more
+    void nextChunk()
+    {
+        nlohmann::json job;
+        if (farm->takeChunk(job))
+        {
+            phase = RENDER;
+            try
+            {
+                parse(job);
+            }
+            catch (const std::exception &e)
+            {
+                LOG_ERROR("[Batch] Bad chunk: " << e.what());
+                shots.clear();
+            }
+            frame = 0;
+            shotStart = phase == RENDER;
+            ++chunksRendered;
+            if (shots.empty())
+            {
+                // nothing to render: hand it back empty, the coordinator gives it to someone else
+                farm->submit(chunkFiles, prefix);
+                phase = FARM_WAIT;
+            }
+            return;
+        }
+        if (farm->finished())
+        {
+            LOG_INFO("[Batch] Farm work done: " << chunksRendered << " chunks rendered");
+            phase = DONE;
+            return;
+        }
+        // the frame renders the placeholder meanwhile; no need to spin
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    void parse(const nlohmann::json &job)
+    {
+        prefix = job.value("output", prefix);
+        settleFrames = std::max(minimumFrames, job.value("settle_frames", settleFrames));
+        const int defaultWidth = std::max(1, job.value("width", 1920));
+        const int defaultHeight = std::max(1, job.value("height", 1080));
+        const std::vector<nlohmann::json> entries = shotEntries(job);
+        shots.clear();
+        shot = 0;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const nlohmann::json &e = entries[i];
+            Shot s;
+            s.name = e["name"].get<std::string>();
+            s.width = std::max(1, e.value("width", defaultWidth));
+            s.height = std::max(1, e.value("height", defaultHeight));
+            s.fov = e.value("fov", s.fov);
+            s.time = e.value("time", s.time);
+            s.environment = e.value("environment", std::string());
+            s.orbit = e.count("azimuth") || e.count("elevation") || e.count("distance") || !e.count("position");
+            if (s.orbit)
+            {
+                s.azimuth = e.value("azimuth", s.azimuth);
+                s.elevation = e.value("elevation", s.elevation);
+                s.distance = e.value("distance", s.distance);
+            }
+            else
+            {
+                s.position = vec3Of(e["position"]);
+                s.hasTarget = e.count("target") != 0;
+                if (s.hasTarget)
+                    s.target = vec3Of(e["target"]);
+                s.yaw = e.value("yaw", s.yaw);
+                s.pitch = e.value("pitch", s.pitch);
+            }
+            shots.push_back(s);
+        }
+        if (!shots.empty())
+            startShot();
+    }
+
+    // a shot with a new environment waits for it in ENVIRONMENT, the others render right away
+    void startShot()
+    {
+        const std::string &environment = shots[shot].environment;
+        if (!environment.empty() && environment != currentEnvironment)
+        {
+            environmentRequest = environment;
+            currentEnvironment = environment;
+            if (phase != LOADING)
+                phase = ENVIRONMENT;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <allocation_counter.h>
+#include <async_log.h>
+#include <camera.h>
+#include <draw_stats.h>
+#include <frame_trace.h>
+#include <gpu_memory.h>
+#include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Reproducible performance runs (BENCHMARK=1). Once the scene has loaded and the environment is baked, the
+// camera flies a closed Catmull-Rom loop around the scene bounds: once for BENCHMARK_WARMUP frames (shader
+// variants, caches and shadows settle), then again over BENCHMARK_FRAMES measured frames. The path is
+// parameterized by frame number, not time, and animation time advances a fixed 1/60 s per frame, so every
+// run renders the same frames. Per frame it records the CPU frame time (beginFrame to beginFrame, swap
+// included), the GPU frame time (GL_TIMESTAMP at the first and last command), draw calls (DrawStats) and
+// triangles (a GL_PRIMITIVES_GENERATED query, so GPU-culled and shadow draws count as submitted) and, in
+// GL_STATS builds, the DrawStats state changes and submitted triangles, and the operator new calls the GL
+// thread made between beginFrame() and endFrame() (AllocationCounter; steady-state frames should make none),
+// then writes mean / p50 / p95 / p99 of each to BENCHMARK_JSON (benchmark.json) and asks the loop to exit.
+// Input is ignored so the run can go unattended; vsync is the caller's to turn off.
+class Benchmark
+{
+public:
+    static const int LATENCY = 4; // frames between issuing a frame's queries and reading them
+
+    struct Stats
+    {
+        double mean = 0.0, p50 = 0.0, p95 = 0.0, p99 = 0.0, min = 0.0, max = 0.0;
+        size_t samples = 0;
+    };
+
+    Benchmark()
+    {
+        const char *env = std::getenv("BENCHMARK");
+        active = env && std::string(env) == "1";
+        if (const char *f = std::getenv("BENCHMARK_FRAMES"))
+            frames = std::max(1, std::atoi(f));
+        if (const char *w = std::getenv("BENCHMARK_WARMUP"))
+            warmup = std::max(0, std::atoi(w));
+        if (const char *j = std::getenv("BENCHMARK_JSON"))
+            path = j;
+    }
+
+    Benchmark(const Benchmark &) = delete;
+    Benchmark &operator=(const Benchmark &) = delete;
+
+    bool enabled() const { return active; }
+    // all measured frames are in: write() and leave the render loop
+    bool finished() const { return phase == DONE; }
+
+    // GL thread, first thing every frame; `sceneReady` once nothing is loading or baking any more
+    void beginFrame(bool sceneReady)
+    {
+        if (!active || phase == DONE)
+            return;
+        const double now = FrameTrace::clockUs() * 1e-3;
+        if (phase == MEASURE && frame > 0)
+            cpuMs[frame - 1] = now - frameStart;
+        frameStart = now;
+        if (phase == LOADING)
+        {
+            if (!sceneReady)
+                return;
+            LOG_INFO("[Benchmark] Scene ready, " << warmup << " warm-up and " << frames << " measured frames");
+            phase = warmup > 0 ? WARMUP : MEASURE;
+            frame = 0;
+            startMeasuring();
+        }
+        else if (phase == WARMUP && frame == warmup)
+        {
+            phase = MEASURE;
+            frame = 0;
+            startMeasuring();
+        }
+        if (phase == MEASURE && frame == frames)
+        {
+            for (int k = 0; k < LATENCY; ++k)
+                collect(slots[k]);
+            releaseGpu();
+            phase = DONE;
+            return;
+        }
+        drawStats().reset();
+        if (phase == MEASURE)
+        {
+            Slot &slot = slots[frame % LATENCY];
+            collect(slot);
+            if (!slot.queries[0])
+                glGenQueries(3, slot.queries);
+            slot.frame = frame;
+            glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+            glBeginQuery(GL_PRIMITIVES_GENERATED, slot.queries[2]);
+            frameAllocations = AllocationCounter::threadAllocations();
+        }
+    }
+
+    // GL thread, after the frame's last draw (before the swap)
+    void endFrame()
+    {
+        if (!active || (phase != WARMUP && phase != MEASURE))
+            return;
+        if (phase == MEASURE)
+        {
+            Slot &slot = slots[frame % LATENCY];
+            glEndQuery(GL_PRIMITIVES_GENERATED);
+            glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+            heapAllocations[frame] = (double)(AllocationCounter::threadAllocations() - frameAllocations);
+            const DrawStats &stats = drawStats();
+            drawCalls[frame] = (double)stats.calls;
+#if GL_STATS
+            programBinds[frame] = (double)stats.programBinds;
+            textureBinds[frame] = (double)stats.textureBinds;
+            vaoBinds[frame] = (double)stats.vaoBinds;
+            uniformUploads[frame] = (double)stats.uniformUploads;
+            submitted[frame] = (double)stats.primitives;
+#endif
+        }
+        frame++;
+    }
+
+    // animation clock of the current frame: fixed steps from the start of the warm-up
+    float time() const
+    {
+        const int step = phase == MEASURE || phase == DONE ? warmup + frame : (phase == WARMUP ? frame : 0);
+        return step / 60.0f;
+    }
+
+    // puts `camera` on the path for this frame, around the box [sceneMin, sceneMax]
+    void placeCamera(Camera &camera, const glm::vec3 &sceneMin, const glm::vec3 &sceneMax) const
+    {
+        const int length = phase == WARMUP ? warmup : frames;
+        const float u = phase == WARMUP || phase == MEASURE ? (float)std::min(frame, length) / (float)length : 0.0f;
+        const glm::vec3 center = 0.5f * (sceneMin + sceneMax), size = sceneMax - sceneMin;
+        const float reach = std::max(0.5f * glm::length(glm::vec2(size.x, size.z)), 1.0f);
+        const float segment = u * CONTROL_POINTS;
+        const int k = (int)std::floor(segment) % CONTROL_POINTS;
+        const float t = segment - std::floor(segment);
+        const glm::vec3 p0 = controlPoint(k - 1, center, sceneMin.y, size.y, reach), p1 = controlPoint(k, center, sceneMin.y, size.y, reach);
+        const glm::vec3 p2 = controlPoint(k + 1, center, sceneMin.y, size.y, reach), p3 = controlPoint(k + 2, center, sceneMin.y, size.y, reach);
+        // uniform Catmull-Rom: passes through every control point with a continuous tangent
+        const float t2 = t * t, t3 = t2 * t;
+        camera.Position = 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+        camera.Zoom = ZOOM;
+        camera.LookAt(glm::vec3(center.x, sceneMin.y + 0.35f * size.y, center.z));
+    }
+
+    // the summary as JSON:
+    // {"frames", "warmup", "renderer", "cpu_frame_ms": {mean, p50, p95, p99, min, max, samples}, "gpu_frame_ms", "draw_calls", "triangles",
+    //  "heap_allocations"}
+    // plus, with GL_STATS, "program_binds", "texture_binds", "vao_binds", "uniform_uploads", "triangles_submitted",
+    // and "gpu_memory_mb" (GpuMemory totals per category at the end of the run)
+    bool write() const
+    {
+        nlohmann::json root;
+        root["frames"] = frames;
+        root["warmup"] = warmup;
+        const GLubyte *renderer = glGetString(GL_RENDERER);
+        const GLubyte *version = glGetString(GL_VERSION);
+        root["renderer"] = renderer ? (const char *)renderer : "";
+        root["gl_version"] = version ? (const char *)version : "";
+        root["cpu_frame_ms"] = toJson(summarize(cpuMs));
+        root["gpu_frame_ms"] = toJson(summarize(gpuMs));
+        root["draw_calls"] = toJson(summarize(drawCalls));
+        root["triangles"] = toJson(summarize(triangles));
+        root["heap_allocations"] = toJson(summarize(heapAllocations));
+#if GL_STATS
+        root["program_binds"] = toJson(summarize(programBinds));
+        root["texture_binds"] = toJson(summarize(textureBinds));
+        root["vao_binds"] = toJson(summarize(vaoBinds));
+        root["uniform_uploads"] = toJson(summarize(uniformUploads));
+        root["triangles_submitted"] = toJson(summarize(submitted));
+#endif
+        nlohmann::json memory;
+        const GpuMemory::Totals &totals = gpuMemory().totals();
+        for (int c = 0; c < GpuMemory::CATEGORY_COUNT; ++c)
+            memory[GpuMemory::categoryName((GpuMemory::Category)c)] = GpuMemory::mb(totals.bytes[c]);
+        memory["total"] = GpuMemory::mb(totals.total());
+        root["gpu_memory_mb"] = memory;
+        std::ofstream file(path.c_str());
+        if (file)
+            file << root.dump(2) << std::endl;
+        const Stats cpu = summarize(cpuMs), gpu = summarize(gpuMs);
+        LOG_INFO("[Benchmark] " << frames << " frames: cpu " << cpu.mean << " ms (p99 " << cpu.p99 << "), gpu " << gpu.mean << " ms (p99 " << gpu.p99
+                                << "), " << summarize(drawCalls).mean << " draw calls, " << summarize(triangles).mean << " triangles, "
+                                << summarize(heapAllocations).mean << " heap allocations per frame");
+        if (!file)
+        {
+            LOG_WARN("[Benchmark] Can't write " << path);
+            return false;
+        }
+        LOG_INFO("[Benchmark] Saved results to " << path);
+        return true;
+    }
+
+    // GL thread: deletes the queries (nothing left to measure)
+    void releaseGpu()
+    {
+        for (int k = 0; k < LATENCY; ++k)
+        {
+            if (slots[k].queries[0])
+                glDeleteQueries(3, slots[k].queries);
+            slots[k] = Slot();
+        }
+    }
+
+private:
+    static const int CONTROL_POINTS = 8;
+    enum Phase { LOADING, WARMUP, MEASURE, DONE };
+
+    // the queries of one frame in flight: begin / end timestamps, primitives generated
+    struct Slot
+    {
+        GLuint queries[3] = {0, 0, 0};
+        int frame = -1; // measured frame whose results are pending, -1 = none
+    };
+
+    bool active = false;
+    int frames = 1000;
+    int warmup = 120;
+    std::string path = "benchmark.json";
+    Phase phase = LOADING;
+    int frame = 0; // within the current phase
+    double frameStart = 0.0;
+    Slot slots[LATENCY];
+    // one entry per measured frame
+    std::vector<double> cpuMs, gpuMs, drawCalls, triangles, heapAllocations;
+    size_t frameAllocations = 0; // GL thread's AllocationCounter::threadAllocations() at the frame's start
+    std::vector<double> programBinds, textureBinds, vaoBinds, uniformUploads, submitted; // GL_STATS
+
+    void startMeasuring()
+    {
+        if (phase != MEASURE)
+            return;
+        cpuMs.assign(frames, 0.0);
+        gpuMs.assign(frames, 0.0);
+        drawCalls.assign(frames, 0.0);
+        triangles.assign(frames, 0.0);
+        heapAllocations.assign(frames, 0.0);
+        programBinds.assign(frames, 0.0);
+        textureBinds.assign(frames, 0.0);
+        vaoBinds.assign(frames, 0.0);
+        uniformUploads.assign(frames, 0.0);
+        submitted.assign(frames, 0.0);
+    }
+
+    // reads the slot's results, waiting for them if the GPU is still behind (it rarely is LATENCY frames late)
+    void collect(Slot &slot)
+    {
+        if (slot.frame < 0)
+            return;
+        GLuint64 begin = 0, end = 0, primitives = 0;
+        glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &end);
+        glGetQueryObjectui64v(slot.queries[2], GL_QUERY_RESULT, &primitives);
+        gpuMs[slot.frame] = end > begin ? (end - begin) * 1e-6 : 0.0;
+        triangles[slot.frame] = (double)primitives;
+        slot.frame = -1;
+    }
+
+    // control point `k` (wrapping) of the closed loop: varying distance and height around the scene
+    static glm::vec3 controlPoint(int k, const glm::vec3 &center, float floor, float height, float reach)
+    {
+        k = ((k % CONTROL_POINTS) + CONTROL_POINTS) % CONTROL_POINTS;
+        const float angle = 6.2831853f * k / CONTROL_POINTS;
+        const float radius = reach * (1.6f + 0.4f * std::cos(3.0f * angle));
+        const float y = floor + std::max(height, 0.5f) * (0.6f + 0.4f * std::sin(2.0f * angle));
+        return glm::vec3(center.x + radius * std::cos(angle), y, center.z + radius * std::sin(angle));
+    }
+
+    // nearest-rank percentiles
+    static Stats summarize(const std::vector<double> &samples)
+    {
+        Stats s;
+        s.samples = samples.size();
+        if (samples.empty())
+            return s;
+        std::vector<double> sorted(samples);
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+            sum += sorted[i];
+        s.mean = sum / sorted.size();
+        s.p50 = percentile(sorted, 0.50);
+        s.p95 = percentile(sorted, 0.95);
+        s.p99 = percentile(sorted, 0.99);
+        s.min = sorted.front();
+        s.max = sorted.back();
+        return s;
+    }
+
+    static double percentile(const std::vector<double> &sorted, double p)
+    {
+        const size_t rank = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    static nlohmann::json toJson(const Stats &s)
+    {
+        nlohmann::json j;
+        j["mean"] = s.mean;
+        j["p50"] = s.p50;
+        j["p95"] = s.p95;
+        j["p99"] = s.p99;
+        j["min"] = s.min;
+        j["max"] = s.max;
+        j["samples"] = s.samples;
+        return j;
+    }
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <render_graph.h>
+#include <shader.h>
+#include <tone_mapper.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Glow around what is brighter than the display can show (headlights, light bars, the sun in the chrome),
+// from the linear HDR image just before the tone map. addPasses() declares a chain of R11G11B10F levels
+// starting at half resolution, each half the size of the one above, as transients of the frame's
+// RenderGraph (its pool keeps their textures from frame to frame):
+//   1. shaders/bloom_downsample.fs reads the HDR image into level 0 with the 13-tap filter, keeping what
+//      is above BLOOM_THRESHOLD (linear radiance after the exposure, default 1, soft knee below it), then
+//      each level from the one above with the same filter
+//   2. shaders/bloom_upsample.fs walks back up, adding a tent filtered copy of each level onto the next
+//      larger one
+// ToneMapper adds level 0 times BLOOM_STRENGTH (default 0.1) to the scene in its one pass (setBloom()),
+// so the bloom costs no full resolution pass of its own. BLOOM_LEVELS (default 6) sets the chain's length,
+// i.e. how wide the glow reaches; BLOOM=0 turns it off.
+class Bloom
+{
+public:
+    // texture unit of the level each pass reads: the tone map's bloom unit (TemporalAA's current colour
+    // before that, which it is done with by then)
+    static const unsigned int UNIT = ToneMapper::UNIT_BLOOM;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle), bloom_downsample.fs and bloom_upsample.fs
+    explicit Bloom(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("BLOOM_THRESHOLD"))
+            threshold = std::max(0.0f, (float)std::atof(env));
+        if (const char *env = std::getenv("BLOOM_STRENGTH"))
+            bloomStrength = std::max(0.0f, (float)std::atof(env));
+        if (const char *env = std::getenv("BLOOM_LEVELS"))
+            maxLevels = std::min(std::max(1, std::atoi(env)), 10);
+    }
+
+    Bloom(const Bloom &) = delete;
+    Bloom &operator=(const Bloom &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("BLOOM");
+        return !(env && std::string(env) == "0");
+    }
+
+    // GL thread: compiles the two programs
+    void init()
+    {
+        downsampleShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/bloom_downsample.fs").c_str()));
+        upsampleShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/bloom_upsample.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[Bloom] " << maxLevels << " levels from half resolution, threshold " << threshold << ", strength " << bloomStrength);
+    }
+
+    // false before init()
+    bool ready() const { return usable && downsampleShader && upsampleShader && bloomStrength > 0.0f; }
+
+    float strength() const { return bloomStrength; }
+
+    // GL thread, after the scene's last HDR pass: declares the bloom of `source` (linear, `width` x `height`)
+    // in `graph` as two passes over a chain of transient levels, and returns the level of half the
+    // source's size to hand to ToneMapper::setBloom (NONE if there is none); a graph that doesn't read it
+    // culls the passes. `exposure` is AutoExposure's texel when it runs (the threshold applies to the
+    // exposed image). The passes bind the scene framebuffer again afterwards, with the viewport on the
+    // whole source.
+    RenderGraph::Resource addPasses(RenderGraph &graph, RenderGraph::Resource source, int width, int height,
+                                    RenderGraph::Resource exposure = RenderGraph::NONE)
+    {
+        if (!ready() || source == RenderGraph::NONE || width < 4 || height < 4)
+            return RenderGraph::NONE;
+        // level 0 at half the source's size, each a texture of its own, so no pass reads the one it writes;
+        // stop before the levels get too small to filter
+        std::vector<Level> levels;
+        for (int w = width / 2, h = height / 2, l = 0; l < maxLevels && std::min(w, h) >= 2; ++l, w = std::max(1, w / 2), h = std::max(1, h / 2))
+        {
+            Level level;
+            level.width = w;
+            level.height = h;
+            level.resource = graph.createTexture("bloom level", RenderGraph::TextureDesc(w, h, GL_R11F_G11F_B10F, GL_RGB, GL_HALF_FLOAT));
+            levels.push_back(level);
+        }
+        if (levels.empty())
+            return RenderGraph::NONE;
+
+        const RenderGraph::Pass down = graph.addPass("bloom down", [this, levels, source, exposure, width, height](RenderGraph &g) {
+            static const Shader::UniformHandle uSourceTexel = Shader::uniformHandle("sourceTexel");
+            static const Shader::UniformHandle uTargetTexel = Shader::uniformHandle("targetTexel");
+            static const Shader::UniformHandle uPrefilter = Shader::uniformHandle("prefilter");
+            static const Shader::UniformHandle uThreshold = Shader::uniformHandle("threshold");
+            static const Shader::UniformHandle uKnee = Shader::uniformHandle("knee");
+            static const Shader::UniformHandle uSource = Shader::uniformHandle("source");
+            static const Shader::UniformHandle uAutoExposure = Shader::uniformHandle("autoExposure");
+            glDisable(GL_DEPTH_TEST);
+            glDisable(GL_BLEND);
+            glState().bindVertexArray(emptyVao);
+            downsampleShader->use();
+            downsampleShader->setInt(uSource, (int)UNIT);
+            downsampleShader->setFloat(uThreshold, threshold);
+            downsampleShader->setFloat(uKnee, threshold * 0.5f);
+            downsampleShader->setBool(uAutoExposure, g.texture(exposure) != 0);
+            if (g.texture(exposure))
+                glState().bindTexture(ToneMapper::UNIT_EXPOSURE, GL_TEXTURE_2D, g.texture(exposure));
+            int sourceWidth = width, sourceHeight = height;
+            for (size_t l = 0; l < levels.size(); ++l)
+            {
+                const Level &level = levels[l];
+                glBindFramebuffer(GL_FRAMEBUFFER, g.framebuffer(level.resource));
+                glViewport(0, 0, level.width, level.height);
+                downsampleShader->setBool(uPrefilter, l == 0);
+                downsampleShader->setVec2(uSourceTexel, glm::vec2(1.0f / sourceWidth, 1.0f / sourceHeight));
+                downsampleShader->setVec2(uTargetTexel, glm::vec2(1.0f / level.width, 1.0f / level.height));
+                glState().bindTexture(UNIT, GL_TEXTURE_2D, g.texture(l == 0 ? source : levels[l - 1].resource));
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                drawStats().count();
+                sourceWidth = level.width;
+                sourceHeight = level.height;
+            }
+            glEnable(GL_DEPTH_TEST);
+            glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+            glViewport(0, 0, width, height);
+        });
+        graph.read(down, source);
+        graph.read(down, exposure);
+        for (size_t l = 0; l < levels.size(); ++l)
+            graph.write(down, levels[l].resource);
+
+        // each level gets the tent of the one below added on top
+        const RenderGraph::Pass up = graph.addPass("bloom up", [this, levels, width, height](RenderGraph &g) {
+            static const Shader::UniformHandle uSourceTexel = Shader::uniformHandle("sourceTexel");
+            static const Shader::UniformHandle uTargetTexel = Shader::uniformHandle("targetTexel");
+            static const Shader::UniformHandle uSource = Shader::uniformHandle("source");
+            static const Shader::UniformHandle uRadius = Shader::uniformHandle("radius");
+            glDisable(GL_DEPTH_TEST);
+            glState().bindVertexArray(emptyVao);
+            upsampleShader->use();
+            upsampleShader->setInt(uSource, (int)UNIT);
+            upsampleShader->setFloat(uRadius, 1.0f);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            for (size_t l = levels.size() - 1; l > 0; --l)
+            {
+                const Level &level = levels[l - 1];
+                glBindFramebuffer(GL_FRAMEBUFFER, g.framebuffer(level.resource));
+                glViewport(0, 0, level.width, level.height);
+                upsampleShader->setVec2(uSourceTexel, glm::vec2(1.0f / levels[l].width, 1.0f / levels[l].height));
+                upsampleShader->setVec2(uTargetTexel, glm::vec2(1.0f / level.width, 1.0f / level.height));
+                glState().bindTexture(UNIT, GL_TEXTURE_2D, g.texture(levels[l].resource));
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                drawStats().count();
+            }
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDisable(GL_BLEND);
+            glEnable(GL_DEPTH_TEST);
+            glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+            glViewport(0, 0, width, height);
+        });
+        for (size_t l = levels.size() - 1; l > 0; --l)
+        {
+            graph.read(up, levels[l].resource);
+            graph.write(up, levels[l - 1].resource);
+        }
+        return levels[0].resource;
+    }
+
+    void releaseGpu()
+    {
+        downsampleShader.reset();
+        upsampleShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    struct Level
+    {
+        RenderGraph::Resource resource = RenderGraph::NONE;
+        int width = 0, height = 0;
+    };
+
+    std::string shaderDir;
+    bool usable = false;
+    float threshold = 1.0f;
+    float bloomStrength = 0.1f;
+    int maxLevels = 6;
+    std::unique_ptr<Shader> downsampleShader;
+    std::unique_ptr<Shader> upsampleShader;
+    // the passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+};
+
+#endif
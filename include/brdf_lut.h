@@ -0,0 +1,33 @@
+#ifndef BRDF_LUT_H
+#define BRDF_LUT_H
+
+#include <glad/glad.h>
+
+#include <brdf_lut_data.h>
+#include <gpu_memory.h>
+
+// Split-sum BRDF LUT for the specular IBL term (brdfLUT in model_loading.fs). It doesn't depend on the
+// environment, so it is integrated offline by tools/brdf_lut_gen.cpp and embedded as half floats.
+namespace BRDFLUT
+{
+    const unsigned int SIZE = BRDF_LUT_SIZE;
+
+    // GL thread: creates the RG16F LUT texture (x = NdotV, y = roughness)
+    inline GLuint create()
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, SIZE, SIZE, 0, GL_RG, GL_HALF_FLOAT, BRDF_LUT_DATA);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        gpuMemory().trackTexture(texture, GpuMemory::ENVIRONMENT, GL_RG16F, SIZE, SIZE, 1, false, "brdf lut");
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        return texture;
+    }
+}
+
+#endif
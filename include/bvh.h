@@ -0,0 +1,242 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <glm/glm.hpp>
+
+#include <frustum.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+// Bounding volume hierarchy over a fixed set of boxes (meshes of a model, placed models of the scene).
+// Built by median splits along the longest axis, so it stays balanced; nodes are stored depth first
+// (left child = node + 1) and every node covers a contiguous range of the reordered items. Moving items
+// only needs refit(), which recomputes the node boxes bottom up without changing the topology.
+class BVH
+{
+public:
+    // items per leaf; leaves are frustum tested with one BoundsBatch pass over their range
+    static const unsigned int LEAF_SIZE = 8;
+
+    void build(const BoundsBatch &items)
+    {
+        nodes.clear();
+        order.resize(items.size());
+        std::iota(order.begin(), order.end(), 0u);
+        if (!order.empty())
+        {
+            nodes.reserve(2 * (items.size() / LEAF_SIZE + 1));
+            buildNode(items, 0, (unsigned int)items.size());
+        }
+        refit(items);
+    }
+
+    // new boxes for the same items (e.g. a model moved); the hierarchy stays, only its bounds change
+    void refit(const BoundsBatch &items)
+    {
+        leafItems.clear();
+        for (size_t k = 0; k < order.size(); ++k)
+            leafItems.append(items, order[k]);
+        // children always follow their parent, so a reverse sweep sees them first
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            Node &node = nodes[i];
+            if (node.right == 0)
+            {
+                node.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+                node.boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+                for (unsigned int k = node.first; k < node.first + node.count; ++k)
+                {
+                    node.boundsMin = glm::min(node.boundsMin, leafItems.boundsMin(k));
+                    node.boundsMax = glm::max(node.boundsMax, leafItems.boundsMax(k));
+                }
+            }
+            else
+            {
+                node.boundsMin = glm::min(nodes[i + 1].boundsMin, nodes[node.right].boundsMin);
+                node.boundsMax = glm::max(nodes[i + 1].boundsMax, nodes[node.right].boundsMax);
+            }
+        }
+    }
+
+    bool empty() const { return nodes.empty(); }
+    size_t size() const { return order.size(); }
+    // bounds of everything in the tree (undefined when empty)
+    glm::vec3 boundsMin() const { return nodes[0].boundsMin; }
+    glm::vec3 boundsMax() const { return nodes[0].boundsMax; }
+
+    // visible[item] = 1 for items that may intersect the frustum. Subtrees fully outside are skipped and
+    // subtrees fully inside are accepted without testing their items. Any allocator, so per-frame callers
+    // can pass a FrameVector. Const all the way down, so several views may cull one tree at once.
+    template <class Allocator>
+    void cull(const Frustum &frustum, std::vector<unsigned char, Allocator> &visible) const
+    {
+        visible.assign(order.size(), 0);
+        if (nodes.empty())
+            return;
+        unsigned int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const unsigned int index = stack[--top];
+            const Node &node = nodes[index];
+            Frustum::Containment c = frustum.classify(node.boundsMin, node.boundsMax);
+            if (c == Frustum::OUTSIDE)
+                continue;
+            if (c == Frustum::INTERSECTS && node.right != 0)
+            {
+                stack[top++] = node.right;
+                stack[top++] = index + 1;
+                continue;
+            }
+            // leaves hold at most LEAF_SIZE items
+            unsigned char inside[LEAF_SIZE];
+            std::fill(inside, inside + node.count, (unsigned char)1);
+            if (c == Frustum::INTERSECTS)
+                leafItems.cullRange(frustum, node.first, node.count, inside);
+            for (unsigned int k = 0; k < node.count; ++k)
+                visible[order[node.first + k]] = inside[k];
+        }
+    }
+
+    // the nodes cull() reaches for `frustum`, in its order: visit(boundsMin, boundsMax, containment, leaf)
+    // for each (CullDebug draws them); the children of nodes outside or fully inside aren't reached
+    template <class Visit>
+    void visitCulledNodes(const Frustum &frustum, Visit visit) const
+    {
+        if (nodes.empty())
+            return;
+        unsigned int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const unsigned int index = stack[--top];
+            const Node &node = nodes[index];
+            const Frustum::Containment c = frustum.classify(node.boundsMin, node.boundsMax);
+            visit(node.boundsMin, node.boundsMax, c, node.right == 0);
+            if (c == Frustum::INTERSECTS && node.right != 0)
+            {
+                stack[top++] = node.right;
+                stack[top++] = index + 1;
+            }
+        }
+    }
+
+    // nearest item along the ray origin + t * dir (t >= 0) whose box is hit, or -1. `hit(item, tBox)` is
+    // called for each candidate with the ray's entry distance into the item's box and returns the exact
+    // hit distance (or a negative value for a miss), for callers that refine boxes into finer geometry.
+    template <typename HitFn>
+    int raycast(const glm::vec3 &origin, const glm::vec3 &dir, float &tHit, HitFn hit) const
+    {
+        int best = -1;
+        tHit = std::numeric_limits<float>::max();
+        if (nodes.empty())
+            return best;
+        const glm::vec3 invDir = 1.0f / dir;
+        unsigned int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const unsigned int index = stack[--top];
+            const Node &node = nodes[index];
+            float tNode;
+            if (!rayBox(origin, invDir, node.boundsMin, node.boundsMax, tNode) || tNode > tHit)
+                continue;
+            if (node.right != 0)
+            {
+                stack[top++] = node.right;
+                stack[top++] = index + 1;
+                continue;
+            }
+            for (unsigned int k = node.first; k < node.first + node.count; ++k)
+            {
+                float tBox;
+                if (!rayBox(origin, invDir, leafItems.boundsMin(k), leafItems.boundsMax(k), tBox) || tBox > tHit)
+                    continue;
+                float t = hit(order[k], tBox);
+                if (t >= 0.0f && t < tHit)
+                {
+                    tHit = t;
+                    best = (int)order[k];
+                }
+            }
+        }
+        return best;
+    }
+
+    // the tree as stored, for a traversal elsewhere (RayTracedReflections uploads it): visit(boundsMin,
+    // boundsMax, right, first, count) per node in order, right = 0 for leaves, whose items are
+    // itemOrder()[first, first + count)
+    template <class Visit>
+    void visitNodes(Visit visit) const
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+            visit(nodes[i].boundsMin, nodes[i].boundsMax, nodes[i].right, nodes[i].first, nodes[i].count);
+    }
+    const std::vector<unsigned int> &itemOrder() const { return order; }
+
+    // box-level picking: the nearest item box the ray enters
+    int raycast(const glm::vec3 &origin, const glm::vec3 &dir, float &tHit) const
+    {
+        return raycast(origin, dir, tHit, [](unsigned int, float tBox) { return tBox; });
+    }
+
+    // slab test; tEnter is clamped to 0 when the origin lies inside the box
+    static bool rayBox(const glm::vec3 &origin, const glm::vec3 &invDir, const glm::vec3 &boxMin, const glm::vec3 &boxMax, float &tEnter)
+    {
+        glm::vec3 t0 = (boxMin - origin) * invDir;
+        glm::vec3 t1 = (boxMax - origin) * invDir;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float tExit = std::min(std::min(tFar.x, tFar.y), tFar.z);
+        return tEnter <= tExit;
+    }
+
+private:
+    struct Node
+    {
+        glm::vec3 boundsMin, boundsMax;
+        // range of `order` covered by the node
+        unsigned int first, count;
+        // index of the right child (the left one is the next node); 0 for leaves
+        unsigned int right;
+    };
+    std::vector<Node> nodes;
+    // item indices in tree order, and their bounds in that order
+    std::vector<unsigned int> order;
+    BoundsBatch leafItems;
+
+    void buildNode(const BoundsBatch &items, unsigned int first, unsigned int count)
+    {
+        unsigned int index = (unsigned int)nodes.size();
+        Node node = {glm::vec3(0.0f), glm::vec3(0.0f), first, count, 0};
+        nodes.push_back(node);
+        if (count <= LEAF_SIZE)
+            return;
+        // split at the median centre along the axis the centres spread most on
+        glm::vec3 cMin(std::numeric_limits<float>::max()), cMax(-std::numeric_limits<float>::max());
+        for (unsigned int k = first; k < first + count; ++k)
+        {
+            glm::vec3 c(items.cx[order[k]], items.cy[order[k]], items.cz[order[k]]);
+            cMin = glm::min(cMin, c);
+            cMax = glm::max(cMax, c);
+        }
+        glm::vec3 spread = cMax - cMin;
+        const std::vector<float> &axis = (spread.x >= spread.y && spread.x >= spread.z) ? items.cx : (spread.y >= spread.z ? items.cy : items.cz);
+        unsigned int half = count / 2;
+        std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                         [&axis](unsigned int a, unsigned int b) { return axis[a] < axis[b]; });
+        buildNode(items, first, half);
+        unsigned int right = (unsigned int)nodes.size();
+        buildNode(items, first + half, count - half);
+        nodes[index].right = right;
+    }
+};
+
+#endif
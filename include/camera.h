@@ -112,6 +112,15 @@ public:
             Zoom = 45.0f;
     }
 
+    // turns the camera towards `target` (scripted paths); Position stays where it is
+    void LookAt(glm::vec3 target)
+    {
+        glm::vec3 direction = glm::normalize(target - Position);
+        Pitch = glm::degrees(asin(glm::clamp(direction.y, -1.0f, 1.0f)));
+        Yaw = glm::degrees(atan2(direction.z, direction.x));
+        updateCameraVectors();
+    }
+
 private:
     // calculates the front vector from the Camera's (updated) Euler Angles
     void updateCameraVectors()
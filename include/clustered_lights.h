@@ -0,0 +1,266 @@
+#ifndef CLUSTERED_LIGHTS_H
+#define CLUSTERED_LIGHTS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Clustered forward lighting for local point and spot lights. The view frustum is split into a
+// GRID_X x GRID_Y screen tiles x GRID_Z exponential depth slices grid; update() assigns every light's
+// bounding sphere to the clusters it touches (on the CPU, once per frame for the main view) and uploads
+// the light list, one [first, count] range per cluster and the packed light indices as buffer textures
+// (GL 3.1, so no SSBOs needed). model_loading.fs finds its cluster from gl_FragCoord and the view depth
+// and only loops over that cluster's lights: the cost follows the local light density, not the total.
+//
+// A light with a `size` is a one-sided rectangular area light (a showroom softbox) facing `direction`: its
+// colour is the radiance of its surface, and model_loading.fs integrates the GGX and Lambert lobes over the
+// rectangle with linearly transformed cosines (LTCLUT), so its highlights take the softbox's shape at the
+// cost of two polygon integrals per pixel, whatever its size.
+class ClusteredLights
+{
+public:
+    // mirrored by CLUSTER_X/Y/Z in model_loading.fs
+    static const int GRID_X = 16;
+    static const int GRID_Y = 9;
+    static const int GRID_Z = 24;
+    static const int MAX_LIGHTS = 1024;
+    // texture units of the light list / cluster ranges / light indices (10, 14, 15 are free in the scene shader)
+    static const unsigned int UNIT_LIGHTS = 10;
+    static const unsigned int UNIT_RANGES = 14;
+    static const unsigned int UNIT_INDICES = 15;
+
+    struct Light
+    {
+        glm::vec3 position = glm::vec3(0.0f); // world space
+        float radius = 1.0f;                  // influence ends here
+        glm::vec3 color = glm::vec3(1.0f);    // times intensity
+        float intensity = 1.0f;
+        glm::vec3 direction = glm::vec3(0.0f, -1.0f, 0.0f); // spot lights: where the cone points
+        // spot cone (cosines of the half angles); outer <= -1 makes a point light
+        float cosInner = -2.0f;
+        float cosOuter = -2.0f;
+        // area lights: width and height of the rectangle (0 = point or spot), centred on `position`, its
+        // height running along `up` (projected onto the rectangle's plane)
+        glm::vec2 size = glm::vec2(0.0f);
+        glm::vec3 up = glm::vec3(0.0f, 0.0f, 1.0f);
+    };
+
+    ClusteredLights() = default;
+    ClusteredLights(const ClusteredLights &) = delete;
+    ClusteredLights &operator=(const ClusteredLights &) = delete;
+
+    // the lights are rebuilt by the caller every frame (they may move)
+    void clear() { lights.clear(); }
+    void add(const Light &light)
+    {
+        if (lights.size() < (size_t)MAX_LIGHTS)
+            lights.push_back(light);
+    }
+    size_t size() const { return lights.size(); }
+
+    // GL thread: assigns the lights to the clusters of the view (`view`, `projection` with the given planes,
+    // rendering to `width` x `height` pixels) and uploads the three buffers
+    void update(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane, int width, int height)
+    {
+        depthScale = (float)GRID_Z / std::log(farPlane / nearPlane);
+        depthBias = -depthScale * std::log(nearPlane);
+        tileSize = glm::vec2((float)std::max(width, 1) / GRID_X, (float)std::max(height, 1) / GRID_Y);
+        assign(view, projection, nearPlane, farPlane);
+        if (lights.empty())
+            return;
+        createResources();
+        // light list: 4 texels per light
+        texels.clear();
+        for (size_t i = 0; i < lights.size(); ++i)
+        {
+            const Light &l = lights[i];
+            const glm::vec3 direction = glm::normalize(l.direction);
+            texels.push_back(glm::vec4(l.position, reach(l)));
+            texels.push_back(glm::vec4(l.color * l.intensity, l.cosInner));
+            texels.push_back(glm::vec4(direction, l.cosOuter));
+            texels.push_back(areaExtent(l, direction));
+        }
+        upload(lightBuffer, texels.size() * sizeof(glm::vec4), &texels[0]);
+        upload(rangeBuffer, ranges.size() * sizeof(GLuint), &ranges[0]);
+        upload(indexBuffer, std::max<size_t>(indices.size(), 1) * sizeof(GLuint), indices.empty() ? 0 : &indices[0]);
+    }
+
+    // sets the cluster uniforms of `shader` (in use) and binds the buffers; without lights only the count
+    void apply(const Shader &shader) const
+    {
+        static const Shader::UniformHandle uCount = Shader::uniformHandle("clusterLightCount");
+        static const Shader::UniformHandle uDepth = Shader::uniformHandle("clusterDepthScaleBias");
+        static const Shader::UniformHandle uTile = Shader::uniformHandle("clusterTileSize");
+        // the buffer samplers have their units from link (Shader::samplerUnit), so they never alias a 2D
+        // unit even without lights
+        shader.setInt(uCount, lightTextures[0] ? (int)lights.size() : 0);
+        if (lights.empty() || !lightTextures[0])
+            return;
+        shader.setVec2(uDepth, glm::vec2(depthScale, depthBias));
+        shader.setVec2(uTile, tileSize);
+        // buffer textures aren't tracked by the state cache
+        const unsigned int units[3] = {UNIT_LIGHTS, UNIT_RANGES, UNIT_INDICES};
+        for (int t = 0; t < 3; ++t)
+        {
+            glState().activeTexture(units[t]);
+            glBindTexture(GL_TEXTURE_BUFFER, lightTextures[t]);
+        }
+    }
+
+    // clusters touched by at least one light and the total light references, from the last update()
+    size_t occupiedClusters() const { return occupied; }
+    size_t references() const { return indices.size(); }
+
+    void releaseGpu()
+    {
+        if (lightTextures[0])
+            glDeleteTextures(3, lightTextures);
+        GLuint buffers[3] = {lightBuffer, rangeBuffer, indexBuffer};
+        for (int b = 0; b < 3; ++b)
+            if (buffers[b])
+                glDeleteBuffers(1, &buffers[b]);
+        lightBuffer = rangeBuffer = indexBuffer = 0;
+        lightTextures[0] = lightTextures[1] = lightTextures[2] = 0;
+        glState().invalidate();
+    }
+
+private:
+    static const int CLUSTERS = GRID_X * GRID_Y * GRID_Z;
+
+    std::vector<Light> lights;
+    // per cluster [first, count] into `indices`, two uints each
+    std::vector<GLuint> ranges;
+    std::vector<GLuint> indices;
+    std::vector<glm::vec4> texels;
+    // per light, its cluster box (x0, x1, y0, y1, z0, z1; x0 > x1 = not visible)
+    std::vector<int> boxes;
+    std::vector<GLuint> counts;
+    size_t occupied = 0;
+    float depthScale = 1.0f, depthBias = 0.0f;
+    glm::vec2 tileSize = glm::vec2(1.0f);
+    GLuint lightBuffer = 0, rangeBuffer = 0, indexBuffer = 0;
+    GLuint lightTextures[3] = {0, 0, 0};
+
+    // influence radius, at least to an area light's corners
+    static float reach(const Light &l) { return std::max(l.radius, 0.5f * glm::length(l.size)); }
+
+    // half the rectangle's width along its right axis, and half its height (0 = not an area light). The
+    // shader takes the height's axis as cross(right, direction), so the corners run clockwise seen from the
+    // front as its polygon integral expects.
+    static glm::vec4 areaExtent(const Light &l, const glm::vec3 &direction)
+    {
+        if (l.size.x <= 0.0f || l.size.y <= 0.0f)
+            return glm::vec4(0.0f);
+        glm::vec3 up = l.up - direction * glm::dot(l.up, direction);
+        if (glm::dot(up, up) < 1e-8f)
+            up = std::fabs(direction.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) - direction * direction.y : glm::vec3(0.0f, 0.0f, 1.0f);
+        const glm::vec3 right = glm::normalize(glm::cross(direction, glm::normalize(up)));
+        return glm::vec4(right * (0.5f * l.size.x), 0.5f * l.size.y);
+    }
+
+    int slice(float viewDepth) const
+    {
+        return std::min(GRID_Z - 1, std::max(0, (int)std::floor(std::log(viewDepth) * depthScale + depthBias)));
+    }
+
+    // cluster box of every light, then a counting pass so each cluster's indices are contiguous
+    void assign(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane)
+    {
+        boxes.assign(lights.size() * 6, 0);
+        counts.assign(CLUSTERS, 0);
+        for (size_t i = 0; i < lights.size(); ++i)
+        {
+            int *box = &boxes[i * 6];
+            box[0] = 1;
+            box[1] = 0;
+            const glm::vec3 c = glm::vec3(view * glm::vec4(lights[i].position, 1.0f));
+            const float r = reach(lights[i]);
+            const float zNear = std::max(-c.z - r, nearPlane), zFar = std::min(-c.z + r, farPlane);
+            if (zFar < nearPlane || zNear > farPlane || zNear > zFar)
+                continue;
+            // screen bounds of the sphere's view-space box cut at the near plane (convex, so its corners bound it)
+            glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+            for (int k = 0; k < 8; ++k)
+            {
+                glm::vec3 corner = c + glm::vec3(k & 1 ? r : -r, k & 2 ? r : -r, k & 4 ? r : -r);
+                corner.z = std::min(corner.z, -nearPlane);
+                const glm::vec4 clip = projection * glm::vec4(corner, 1.0f);
+                const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            if (ndcMin.x > 1.0f || ndcMin.y > 1.0f || ndcMax.x < -1.0f || ndcMax.y < -1.0f)
+                continue;
+            box[0] = std::max(0, (int)std::floor((ndcMin.x * 0.5f + 0.5f) * GRID_X));
+            box[1] = std::min(GRID_X - 1, (int)std::floor((ndcMax.x * 0.5f + 0.5f) * GRID_X));
+            box[2] = std::max(0, (int)std::floor((ndcMin.y * 0.5f + 0.5f) * GRID_Y));
+            box[3] = std::min(GRID_Y - 1, (int)std::floor((ndcMax.y * 0.5f + 0.5f) * GRID_Y));
+            box[4] = slice(zNear);
+            box[5] = slice(zFar);
+            forEachCluster(box, [this](int cluster) { counts[cluster]++; });
+        }
+        ranges.assign(CLUSTERS * 2, 0);
+        GLuint total = 0;
+        occupied = 0;
+        for (int k = 0; k < CLUSTERS; ++k)
+        {
+            ranges[2 * k] = total;
+            total += counts[k];
+            occupied += counts[k] != 0;
+            counts[k] = ranges[2 * k];
+        }
+        indices.resize(total);
+        for (size_t i = 0; i < lights.size(); ++i)
+            forEachCluster(&boxes[i * 6], [this, i](int cluster) {
+                indices[counts[cluster]++] = (GLuint)i;
+                ranges[2 * cluster + 1]++;
+            });
+    }
+
+    template <class F>
+    static void forEachCluster(const int *box, F f)
+    {
+        for (int z = box[4]; box[0] <= box[1] && z <= box[5]; ++z)
+            for (int y = box[2]; y <= box[3]; ++y)
+                for (int x = box[0]; x <= box[1]; ++x)
+                    f((z * GRID_Y + y) * GRID_X + x);
+    }
+
+    void createResources()
+    {
+        if (lightTextures[0])
+            return;
+        glGenBuffers(1, &lightBuffer);
+        glGenBuffers(1, &rangeBuffer);
+        glGenBuffers(1, &indexBuffer);
+        glGenTextures(3, lightTextures);
+        const GLuint buffers[3] = {lightBuffer, rangeBuffer, indexBuffer};
+        const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+        for (int t = 0; t < 3; ++t)
+        {
+            glBindBuffer(GL_TEXTURE_BUFFER, buffers[t]);
+            glBufferData(GL_TEXTURE_BUFFER, 16, NULL, GL_STREAM_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, lightTextures[t]);
+            glTexBuffer(GL_TEXTURE_BUFFER, formats[t], buffers[t]);
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glState().invalidate();
+    }
+
+    // orphans and refills one buffer; the buffer texture follows the store
+    static void upload(GLuint buffer, size_t bytes, const void *data)
+    {
+        glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+        glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)bytes, data, GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef COMPUTE_SHADER_H
+#define COMPUTE_SHADER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <virtual_file_system.h>
+
+#include <string>
+
+// Single-stage compute program (GL 4.3), for offline-style passes such as the IBL prefilter. Unlike
+// Shader it is not shared or binary-cached: these programs are built once at startup and dropped.
+class ComputeShader
+{
+public:
+    unsigned int ID = 0;
+
+    // compute shaders are core from GL 4.3; callers fall back to a raster path otherwise
+    static bool supported()
+    {
+        return GLAD_GL_VERSION_4_3 != 0;
+    }
+
+    // `libraryPath`: GLSL shared by several passes (functions, buffer layouts), inserted after the
+    // program's #version line
+    explicit ComputeShader(const char *computePath, const char *libraryPath = NULL)
+    {
+        FileView file;
+        if (!fileSystem().open(computePath, file))
+        {
+            LOG_ERROR("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << computePath);
+            return;
+        }
+        std::string code((const char *)file.data(), file.size());
+        if (libraryPath)
+        {
+            FileView library;
+            if (!fileSystem().open(libraryPath, library))
+            {
+                LOG_ERROR("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << libraryPath);
+                return;
+            }
+            const size_t lineEnd = code.find('\n');
+            const size_t at = lineEnd == std::string::npos ? code.size() : lineEnd + 1;
+            code.insert(at, std::string((const char *)library.data(), library.size()) + "\n#line 2\n");
+        }
+        const char *source = code.c_str();
+        GLuint compute = glCreateShader(GL_COMPUTE_SHADER);
+        glShaderSource(compute, 1, &source, NULL);
+        glCompileShader(compute);
+        GLint success = 0;
+        glGetShaderiv(compute, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            logInfo(compute, false, computePath);
+            glDeleteShader(compute);
+            return;
+        }
+        ID = glCreateProgram();
+        glAttachShader(ID, compute);
+        glLinkProgram(ID);
+        glDeleteShader(compute);
+        glGetProgramiv(ID, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            logInfo(ID, true, computePath);
+            glDeleteProgram(ID);
+            ID = 0;
+        }
+    }
+    ~ComputeShader()
+    {
+        if (ID)
+        {
+            if (glState().program() == ID)
+                glState().useProgram(0);
+            glDeleteProgram(ID);
+        }
+    }
+    ComputeShader(const ComputeShader &) = delete;
+    ComputeShader &operator=(const ComputeShader &) = delete;
+
+    // false if the source didn't compile or link (the error is already logged)
+    bool valid() const { return ID != 0; }
+
+    void use() const
+    {
+        glState().useProgram(ID);
+    }
+    void setInt(const std::string &name, int value) const
+    {
+        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    }
+    void setUint(const std::string &name, unsigned int value) const
+    {
+        glUniform1ui(glGetUniformLocation(ID, name.c_str()), value);
+    }
+    void setFloat(const std::string &name, float value) const
+    {
+        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    }
+    void setVec2(const std::string &name, const glm::vec2 &value) const
+    {
+        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    }
+    void setVec3(const std::string &name, const glm::vec3 &value) const
+    {
+        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    }
+    void setVec4v(const std::string &name, const glm::vec4 *values, int count) const
+    {
+        glUniform4fv(glGetUniformLocation(ID, name.c_str()), count, &values[0][0]);
+    }
+    void setIvec2(const std::string &name, int x, int y) const
+    {
+        glUniform2i(glGetUniformLocation(ID, name.c_str()), x, y);
+    }
+    void setMat4(const std::string &name, const glm::mat4 &mat) const
+    {
+        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    }
+
+private:
+    static void logInfo(GLuint object, bool program, const char *path)
+    {
+        GLchar infoLog[1024];
+        if (program)
+            glGetProgramInfoLog(object, 1024, NULL, infoLog);
+        else
+            glGetShaderInfoLog(object, 1024, NULL, infoLog);
+        LOG_ERROR((program ? "ERROR::PROGRAM_LINKING_ERROR of type: COMPUTE (" : "ERROR::SHADER_COMPILATION_ERROR of type: COMPUTE (")
+                  << path << ")\n" << infoLog << "\n -- --------------------------------------------------- -- ");
+    }
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef COOKED_FORMAT_H
+#define COOKED_FORMAT_H
+
+#include <mesh.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// On-disk layout of a cooked model (written by tools/car_cook, read by Model::loadCooked).
+// Everything is little-endian POD laid out for a straight memory map:
+//
+//   Header
+//   proxy                           (optional, at proxyOffset: a complete cooked model of its own, see below)
+//   Mesh[meshCount]
+//   MeshTexture[meshTextureCount]   (each mesh owns a contiguous range)
+//   MeshLod[meshLodCount]           (each mesh owns a contiguous range, coarser levels only)
+//   Meshlet[meshletCount]           (each mesh owns a contiguous range)
+//   Instance[instanceCount]         (each instanced mesh owns a contiguous range)
+//   Node[nodeCount]                 (scene nodes, parents first)
+//   Texture[textureCount]
+//   string table                    (texture paths and types, node names, not NUL-terminated)
+//   PackedVertex[vertexCount]       (already quantized against quantizationMin/Max)
+//   index[indexCount]               (uint16 or uint32 per indexSize; per mesh: full list, then its LOD lists)
+//   pixel data                      (per texture: every mip level, largest first, tightly packed rows)
+//
+// Every section offset is absolute and 8-byte aligned. The proxy is a small stand-in the viewer draws while the
+// rest of the file is read: the same meshes and materials over each mesh's coarsest LOD (only the vertices it
+// uses), the textures from the first level of at most PROXY_TEXTURE texels on, and the same bounds and
+// quantization. It is laid out like a whole file (its offsets relative to proxyOffset, its fileSize
+// proxySize, no proxy of its own), so Model::loadCooked reads either the same way. Bump VERSION whenever any of the
+// structs or PackedVertex change; loadCooked rejects other versions and the caller falls back to
+// importing the source file.
+namespace CookedFormat
+{
+    static const char MAGIC[4] = {'C', 'A', 'R', 'C'};
+    static const uint32_t VERSION = 17;
+    // largest side of the proxy's textures
+    static const uint32_t PROXY_TEXTURE = 64;
+
+    // how a texture's levels are stored
+    enum Encoding
+    {
+        RAW8 = 0,   // uncompressed 8-bit, `components` channels
+        BC4 = 1,    // RGTC1: single channel (R)
+        BC5 = 2,    // RGTC2: tangent-space normal XY, Z rebuilt in the shader
+        BC5_GB = 3, // RGTC2 holding the G/B channels of a metallicRoughness map, swizzled back on upload
+        BC7 = 4,    // BPTC RGBA (sRGB when `gamma`)
+        RG8_GB = 5  // uncompressed counterpart of BC5_GB (components == 2)
+    };
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t vertexStride;   // sizeof(PackedVertex) at cook time
+        uint32_t meshCount;
+        uint32_t meshTextureCount;
+        uint32_t textureCount;
+        uint32_t meshLodCount;
+        uint32_t indexSize;      // 2 or 4 bytes per index (2 when every mesh has at most 65536 vertices)
+        uint32_t meshletCount;
+        uint32_t reserved;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint64_t sourceHash;     // FNV-1a of the source model file as cooked
+        float boundsMin[3];
+        float boundsMax[3];
+        // box the positions are quantized in: the model bounds, with instanced meshes in their own space
+        float quantizationMin[3];
+        float quantizationMax[3];
+        uint32_t instanceCount;
+        uint32_t nodeCount;
+        uint64_t meshOffset;
+        uint64_t meshTextureOffset;
+        uint64_t meshLodOffset;
+        uint64_t meshletOffset;
+        uint64_t instanceOffset;
+        uint64_t nodeOffset;
+        uint64_t textureOffset;
+        uint64_t stringOffset;
+        uint64_t stringSize;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint64_t pixelOffset;
+        uint64_t fileSize;
+        uint64_t proxyOffset;    // 0 = no proxy
+        uint64_t proxySize;
+    };
+
+    struct Mesh
+    {
+        int32_t baseVertex;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t vertexCount;
+        uint32_t firstTexture;   // into the MeshTexture table
+        uint32_t textureCount;
+        uint32_t transparent;    // 0 opaque, 1 sorted, 2 weighted blended (Mesh::weightedBlend)
+        uint32_t firstLod;       // into the MeshLod table
+        uint32_t lodCount;
+        uint32_t firstMeshlet;   // into the Meshlet table
+        uint32_t meshletCount;
+        uint32_t firstInstance;  // into the Instance table; instanceCount 0 = baked into model space
+        uint32_t instanceCount;
+        float baseColorFactor[4];
+        float metallicFactor;
+        float roughnessFactor;
+        uint32_t alphaMode;      // Mesh::AlphaMode
+        float alphaCutoff;
+        float clearcoatFactor;   // KHR_materials_clearcoat, 0 = no coat
+        float clearcoatRoughnessFactor;
+        float transmissionFactor; // KHR_materials_transmission, 0 = none
+        float specularFactor;     // KHR_materials_specular
+        float specularColorFactor[3];
+        float occlusionStrength;  // occlusion in R of the metallicRoughness texture, 0 = none
+        float centroid[3];
+        float boundsMin[3];
+        float boundsMax[3];
+        // instanced meshes: bounds in the mesh's own space, for recomputing the above when nodes move
+        float localCentroid[3];
+        float localBoundsMin[3];
+        float localBoundsMax[3];
+        float uvDensity;         // Mesh::uvDensity
+        uint32_t materialTag;    // MaterialOverrides tag (0 = none)
+        int32_t partNode;        // Mesh::partNode, into the Node table (-1 = not a configurable part)
+    };
+
+    struct MeshTexture
+    {
+        uint32_t texture;        // into the Texture table
+        uint32_t typeOffset;     // Texture::slotName(slot) in the string table
+        uint32_t typeLength;
+        float uvOffset[2];
+        float uvScale[2];
+        float uvRotation;
+    };
+
+    // simplified index range of a mesh, over the same vertices
+    struct MeshLod
+    {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float error;             // geometric error in model units
+    };
+
+    // Mesh::Meshlet as stored
+    struct Meshlet
+    {
+        uint32_t firstIndex;     // relative to the mesh's firstIndex
+        uint32_t indexCount;
+        float sphere[4];
+        float cone[4];
+    };
+
+    // Mesh::instances entry: column-major model-from-mesh matrix and the node it follows
+    struct Instance
+    {
+        float matrix[16];
+        int32_t node;            // into the Node table, -1 = fixed
+        uint32_t reserved;
+    };
+
+    // TransformHierarchy node
+    struct Node
+    {
+        int32_t parent;          // earlier node, -1 = root
+        uint32_t nameOffset;     // in the string table
+        uint32_t nameLength;
+        uint32_t reserved;
+        float local[16];         // column-major parent-from-node matrix
+    };
+
+    struct Texture
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t components;     // source channels (1, 3 or 4; 2 for RG8_GB), 8 bits each
+        uint32_t gamma;          // sRGB internal format
+        uint32_t levels;         // full mip chain down to 1x1
+        uint32_t pathOffset;     // Texture::path in the string table
+        uint32_t pathLength;
+        uint32_t encoding;       // Encoding
+        uint64_t dataOffset;     // absolute offset of level 0
+        uint64_t dataSize;       // all levels
+    };
+
+    inline uint64_t alignUp(uint64_t v) { return (v + 7) & ~(uint64_t)7; }
+
+    inline uint32_t blockBytes(uint32_t encoding) { return encoding == BC4 ? 8 : 16; }
+
+    // bytes of mip `level` of `t` (compressed levels are whole 4x4 blocks)
+    inline uint64_t levelSize(const Texture &t, uint32_t level)
+    {
+        uint32_t w = t.width >> level, h = t.height >> level;
+        w = w ? w : 1;
+        h = h ? h : 1;
+        if (t.encoding == RAW8 || t.encoding == RG8_GB)
+            return (uint64_t)w * h * t.components;
+        return (uint64_t)((w + 3) / 4) * ((h + 3) / 4) * blockBytes(t.encoding);
+    }
+
+    // 64-bit FNV-1a, the same hash TextureCache uses for image contents
+    inline uint64_t hashBytes(const unsigned char *bytes, size_t size)
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+        h ^= (uint64_t)size;
+        h *= 1099511628211ull;
+        return h;
+    }
+
+    // cooked file that belongs to a source model
+    inline std::string cookedPath(const std::string &sourcePath) { return sourcePath + ".cooked"; }
+
+    // Page file of a livery image (car_cook --livery, read by VirtualTexture): its mip chain, level 0 first,
+    // cut into LIVERY_PAGE x LIVERY_PAGE pages, each stored with a LIVERY_BORDER texel border taken from
+    // its neighbours (clamped at the image's edges) so bilinear lookups never leave the page. Pages are
+    // sRGB RGBA8, LiveryHeader::pageBytes each, in rows per level:
+    //
+    //   LiveryHeader
+    //   page[pageCount]                 (at pageOffset; level 0 first, each level row by row)
+    //
+    // Bump LIVERY_VERSION whenever the header or page layout change.
+    static const char LIVERY_MAGIC[4] = {'C', 'A', 'R', 'V'};
+    static const uint32_t LIVERY_VERSION = 1;
+    static const uint32_t LIVERY_PAGE = 128;
+    static const uint32_t LIVERY_BORDER = 4;
+
+    struct LiveryHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;          // level 0, powers of two
+        uint32_t height;
+        uint32_t pageSize;       // LIVERY_PAGE and LIVERY_BORDER at cook time
+        uint32_t border;
+        uint32_t levels;         // down to the level that fits one page
+        uint32_t pageCount;
+        uint64_t pageBytes;      // (pageSize + 2 * border)^2 * 4
+        uint64_t pageOffset;
+        uint64_t sourceHash;     // FNV-1a of the source image as cooked
+    };
+
+    // pages along a side of `size` texels at level 0, at level `level`
+    inline uint32_t liveryPages(uint32_t size, uint32_t level)
+    {
+        const uint32_t texels = size >> level;
+        return texels > LIVERY_PAGE ? (texels + LIVERY_PAGE - 1) / LIVERY_PAGE : 1;
+    }
+
+    inline uint32_t liveryLevels(uint32_t width, uint32_t height)
+    {
+        uint32_t levels = 1;
+        while (std::max(width, height) >> (levels - 1) > LIVERY_PAGE)
+            ++levels;
+        return levels;
+    }
+
+    // page file that belongs to a livery image
+    inline std::string liveryPath(const std::string &imagePath) { return imagePath + ".vtex"; }
+}
+
+#endif
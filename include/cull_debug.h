@@ -0,0 +1,303 @@
+#ifndef CULL_DEBUG_H
+#define CULL_DEBUG_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <draw_stats.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <model.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// What the culling decided, drawn as boxes over the window (CULL_DEBUG=1): every placed model's bounds
+// (white kept, red culled) and, in the kept ones, every mesh's bounds coloured by the level selectLods()
+// picked (green full detail, then yellow, orange, magenta), culled meshes dim red. CULL_DEBUG=nodes adds
+// the nodes of the scene and mesh hierarchies the frustum test reached (blue fully inside, cyan crossing
+// the frustum, grey outside). F freezes the culling camera: frustum culling and detail levels stay with
+// the view at the moment of the press while the camera moves on, and the frozen frustum is drawn too, so
+// what falls outside it (and whether it was drawn anyway) is plain to see. Occlusion culling keeps testing
+// the live view against the depth it sees. The HUD (O) shows the counts behind the boxes.
+class CullDebug
+{
+public:
+    // visible / tested this frame
+    struct Counts
+    {
+        size_t models = 0, modelsKept = 0;
+        size_t meshes = 0, meshesKept = 0;
+        size_t lods[4] = {}; // kept meshes per level, the last one counting it and everything coarser
+        size_t nodes = 0, nodesOutside = 0, nodesInside = 0;
+    };
+
+    // `shaderDir` holds cull_debug.vs and cull_debug.fs
+    explicit CullDebug(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        const char *env = std::getenv("CULL_DEBUG");
+        withNodes = env && std::string(env) == "nodes";
+    }
+
+    CullDebug(const CullDebug &) = delete;
+    CullDebug &operator=(const CullDebug &) = delete;
+
+    // CULL_DEBUG=1 or CULL_DEBUG=nodes
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("CULL_DEBUG");
+        return env && (std::string(env) == "1" || std::string(env) == "nodes");
+    }
+
+    // GL thread: the program and the unit cube's edges
+    void init()
+    {
+        shader.reset(new Shader((shaderDir + "/cull_debug.vs").c_str(), (shaderDir + "/cull_debug.fs").c_str()));
+        static const float corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}};
+        static const int edges[24] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 2, 1, 3, 4, 6, 5, 7, 0, 4, 1, 5, 2, 6, 3, 7};
+        float vertices[24 * 3];
+        for (int v = 0; v < 24; ++v)
+            for (int c = 0; c < 3; ++c)
+                vertices[v * 3 + c] = corners[edges[v]][c];
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &cubeVbo);
+        glGenBuffers(1, &boxVbo);
+        glState().bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, cubeVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+        for (GLuint a = 1; a <= 3; ++a)
+        {
+            glEnableVertexAttribArray(a);
+            glVertexAttribDivisor(a, 1);
+        }
+        glState().bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        usable = true;
+        LOG_INFO("[CullDebug] Drawing model and mesh bounds" << (withNodes ? " and hierarchy nodes" : "") << ", F freezes the culling camera");
+    }
+
+    // false before init()
+    bool ready() const { return usable && shader; }
+
+    bool frozen() const { return isFrozen; }
+
+    // F: keeps culling with `viewProjection` (the view's now) until pressed again
+    void toggleFreeze(const glm::mat4 &viewProjection)
+    {
+        isFrozen = !isFrozen;
+        frozenViewProjection = viewProjection;
+        LOG_INFO("[CullDebug] Culling camera " << (isFrozen ? "frozen" : "follows the view") << "; last frame " << summary());
+    }
+
+    // the view-projection frustum culling and detail levels use this frame: the frozen one, else `live`
+    glm::mat4 cullViewProjection(const glm::mat4 &live) const { return isFrozen ? frozenViewProjection : live; }
+
+    // GL-free, once per frame before the add*() calls: starts over with the culling view's frustum
+    void begin(const glm::mat4 &cullView)
+    {
+        cullFrustumMatrix = cullView;
+        boxes.clear();
+        groups.clear();
+        frameCounts = Counts();
+    }
+
+    // the nodes of the placed models' hierarchy the frustum test reaches (CULL_DEBUG=nodes)
+    void addSceneNodes(const BVH &sceneTree)
+    {
+        if (withNodes)
+            addNodes(sceneTree, glm::mat4(1.0f));
+    }
+
+    // one placed model: its world bounds, and when `kept` its meshes as the draws culled them
+    void addModel(const Model &model, const glm::mat4 &modelMatrix, const glm::vec3 &worldMin, const glm::vec3 &worldMax, bool kept)
+    {
+        frameCounts.models++;
+        frameCounts.modelsKept += kept;
+        beginGroup(glm::mat4(1.0f));
+        addBox(worldMin, worldMax, kept ? glm::vec4(1.0f, 1.0f, 1.0f, 0.9f) : glm::vec4(1.0f, 0.2f, 0.2f, 0.6f));
+        if (!kept || !model.ready())
+            return;
+        // the same test as Model::Draw's, repeated: with shared models the last placement drawn owns the
+        // model's own result
+        const Frustum frustum(cullFrustumMatrix * modelMatrix);
+        model.meshHierarchy().cull(frustum, meshKept);
+        if (withNodes)
+            addNodes(model.meshHierarchy(), modelMatrix);
+        beginGroup(modelMatrix);
+        static const glm::vec4 lodColors[4] = {glm::vec4(0.2f, 1.0f, 0.2f, 0.8f), glm::vec4(1.0f, 1.0f, 0.2f, 0.8f),
+                                               glm::vec4(1.0f, 0.55f, 0.1f, 0.8f), glm::vec4(1.0f, 0.2f, 1.0f, 0.8f)};
+        for (size_t i = 0; i < model.meshes.size() && i < meshKept.size(); ++i)
+        {
+            const Mesh &m = model.meshes[i];
+            frameCounts.meshes++;
+            if (!meshKept[i])
+            {
+                addBox(m.boundsMin, m.boundsMax, glm::vec4(0.6f, 0.1f, 0.1f, 0.35f));
+                continue;
+            }
+            const unsigned int lod = std::min(model.meshLodLevel(i), 3u);
+            frameCounts.meshesKept++;
+            frameCounts.lods[lod]++;
+            addBox(m.boundsMin, m.boundsMax, lodColors[lod]);
+        }
+    }
+
+    // GL thread, after the tone map: the boxes over the whole `width` x `height` scene framebuffer, seen
+    // through `viewProjection` (the live view), and the frozen frustum
+    void draw(const glm::mat4 &viewProjection, int width, int height)
+    {
+        static const Shader::UniformHandle uViewProjection = Shader::uniformHandle("viewProjection");
+        static const Shader::UniformHandle uBoxToWorld = Shader::uniformHandle("boxToWorld");
+        if (!ready())
+            return;
+        if (isFrozen)
+        {
+            beginGroup(glm::inverse(frozenViewProjection));
+            addBox(glm::vec3(-1.0f), glm::vec3(1.0f), glm::vec4(1.0f, 0.9f, 0.3f, 1.0f));
+        }
+        if (boxes.empty())
+            return;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glViewport(0, 0, width, height);
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        shader->use();
+        shader->setMat4(uViewProjection, viewProjection);
+        glState().bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, boxVbo);
+        // orphaned: last frame's draw may still read it
+        glBufferData(GL_ARRAY_BUFFER, boxes.size() * sizeof(Box), &boxes[0], GL_STREAM_DRAW);
+        for (size_t g = 0; g < groups.size(); ++g)
+        {
+            const Group &group = groups[g];
+            const size_t count = (g + 1 < groups.size() ? groups[g + 1].first : boxes.size()) - group.first;
+            if (count == 0)
+                continue;
+            // GL 3.3 has no base instance, so each group points the instance attributes at its own range
+            const size_t base = group.first * sizeof(Box);
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Box), (void *)(base + offsetof(Box, boundsMin)));
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Box), (void *)(base + offsetof(Box, boundsMax)));
+            glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Box), (void *)(base + offsetof(Box, color)));
+            shader->setMat4(uBoxToWorld, group.toWorld);
+            glDrawArraysInstanced(GL_LINES, 0, 24, (GLsizei)count);
+            drawStats().count();
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    const Counts &counts() const { return frameCounts; }
+
+    // the counts as the HUD's two lines (upper case, at most 48 characters each)
+    std::vector<std::string> hudLines() const
+    {
+        const Counts &c = frameCounts;
+        char models[64], levels[64];
+        std::snprintf(models, sizeof(models), "CULL%s MODELS %u/%u MESHES %u/%u", isFrozen ? " FROZEN" : "",
+                      (unsigned)c.modelsKept, (unsigned)c.models, (unsigned)c.meshesKept, (unsigned)c.meshes);
+        std::snprintf(levels, sizeof(levels), "LOD %u %u %u %u  NODES %u OUT %u IN %u", (unsigned)c.lods[0], (unsigned)c.lods[1],
+                      (unsigned)c.lods[2], (unsigned)c.lods[3], (unsigned)c.nodes, (unsigned)c.nodesOutside, (unsigned)c.nodesInside);
+        std::vector<std::string> lines;
+        lines.push_back(models);
+        lines.push_back(levels);
+        return lines;
+    }
+
+    // the counts for the log
+    std::string summary() const
+    {
+        const Counts &c = frameCounts;
+        char text[192];
+        std::snprintf(text, sizeof(text), "%u/%u models, %u/%u meshes kept (levels %u/%u/%u/%u), %u nodes tested, %u outside, %u inside",
+                      (unsigned)c.modelsKept, (unsigned)c.models, (unsigned)c.meshesKept, (unsigned)c.meshes, (unsigned)c.lods[0],
+                      (unsigned)c.lods[1], (unsigned)c.lods[2], (unsigned)c.lods[3], (unsigned)c.nodes, (unsigned)c.nodesOutside,
+                      (unsigned)c.nodesInside);
+        return text;
+    }
+
+    void releaseGpu()
+    {
+        shader.reset();
+        if (boxVbo) glDeleteBuffers(1, &boxVbo);
+        if (cubeVbo) glDeleteBuffers(1, &cubeVbo);
+        if (vao) glDeleteVertexArrays(1, &vao);
+        boxVbo = cubeVbo = vao = 0;
+        usable = false;
+        glState().invalidate();
+    }
+
+private:
+    // one instance: attributes 1-3 of cull_debug.vs
+    struct Box
+    {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        glm::vec4 color;
+    };
+
+    // boxes sharing a transform, from `first` up to the next group's
+    struct Group
+    {
+        glm::mat4 toWorld;
+        size_t first;
+    };
+
+    std::string shaderDir;
+    bool usable = false;
+    bool withNodes = false;
+    bool isFrozen = false;
+    glm::mat4 frozenViewProjection = glm::mat4(1.0f);
+    glm::mat4 cullFrustumMatrix = glm::mat4(1.0f);
+    std::unique_ptr<Shader> shader;
+    GLuint vao = 0, cubeVbo = 0, boxVbo = 0;
+    std::vector<Box> boxes;
+    std::vector<Group> groups;
+    std::vector<unsigned char> meshKept;
+    Counts frameCounts;
+
+    void beginGroup(const glm::mat4 &toWorld)
+    {
+        if (!groups.empty() && groups.back().first == boxes.size())
+            groups.back().toWorld = toWorld;
+        else if (groups.empty() || groups.back().toWorld != toWorld)
+        {
+            Group group = {toWorld, boxes.size()};
+            groups.push_back(group);
+        }
+    }
+
+    void addBox(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, const glm::vec4 &color)
+    {
+        Box box = {boundsMin, boundsMax, color};
+        boxes.push_back(box);
+    }
+
+    void addNodes(const BVH &tree, const glm::mat4 &modelMatrix)
+    {
+        beginGroup(modelMatrix);
+        tree.visitCulledNodes(Frustum(cullFrustumMatrix * modelMatrix),
+                              [this](const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, Frustum::Containment c, bool) {
+                                  frameCounts.nodes++;
+                                  frameCounts.nodesOutside += c == Frustum::OUTSIDE;
+                                  frameCounts.nodesInside += c == Frustum::INSIDE;
+                                  addBox(boundsMin, boundsMax, c == Frustum::INSIDE ? glm::vec4(0.2f, 0.4f, 1.0f, 0.5f)
+                                                                 : c == Frustum::INTERSECTS ? glm::vec4(0.0f, 0.9f, 0.9f, 0.35f)
+                                                                                            : glm::vec4(0.5f, 0.5f, 0.5f, 0.25f));
+                              });
+    }
+};
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef DEBUG_VIEWS_H
+#define DEBUG_VIEWS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+#include <tone_mapper.h>
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+
+// What the frame costs, drawn over the window in place of the scene (DEBUG_VIEW=<name>, G steps through
+// them at runtime). The visible models are drawn once more, after the tone map, with model_loading.vs,
+// shaders/debug_view.gs and shaders/debug_view.fs (through the same material variants) into a target of
+// their own, which shaders/debug_view_composite.fs then puts on the window:
+//   overdraw     fragments shaded per pixel, i.e. that passed the depth test in draw order
+//   quad         the same in 2x2 quads, the unit the GPU shades in: small and thin triangles pay for the
+//                quad pixels they don't cover
+//   texels       base colour texels per pixel (the mip level sampled)
+//   permutation  one colour per model_loading program (Shader::Feature set)
+//   triangles    pixels per triangle, red where triangles get smaller than a pixel
+//   wireframe    the nearest triangles' edges over the shaded scene (also WIREFRAME=1): the distance to the
+//                edges comes from the window-space corners the geometry shader passes on, so no line
+//                rasterization (glPolygonMode) and no hidden lines
+// overdraw, quad and triangles are counts on a heat ramp. Frame captures and streams see the debug view
+// while one is on.
+class DebugViews
+{
+public:
+    // debug_view.fs's constants
+    enum Mode
+    {
+        OFF,
+        OVERDRAW,
+        QUAD_OVERDRAW,
+        TEXEL_DENSITY,
+        PERMUTATION,
+        TRIANGLE_DENSITY,
+        WIREFRAME,
+        MODE_COUNT
+    };
+
+    // draws placed model `index` (if it's visible) with `shader`, which is in use with the view's FrameData
+    // bound; called once per model, in order, with the pass's blend and depth state restored before each
+    typedef std::function<void(size_t index, Shader &shader)> DrawModel;
+
+    // `shaderDir` holds model_loading.vs, debug_view.gs, debug_view.fs, oit_resolve.vs and
+    // debug_view_composite.fs
+    explicit DebugViews(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("DEBUG_VIEW"))
+            for (int m = 0; m < MODE_COUNT; ++m)
+                if (std::string(env) == modeName((Mode)m))
+                    activeMode = (Mode)m;
+        if (const char *env = std::getenv("WIREFRAME"))
+            if (std::string(env) == "1")
+                activeMode = WIREFRAME;
+    }
+
+    DebugViews(const DebugViews &) = delete;
+    DebugViews &operator=(const DebugViews &) = delete;
+
+    static const char *modeName(Mode mode)
+    {
+        static const char *names[MODE_COUNT] = {"off", "overdraw", "quad", "texels", "permutation", "triangles", "wireframe"};
+        return names[mode];
+    }
+
+    // GL thread: compiles the two programs (the model one's variants come as the materials ask for them)
+    void init()
+    {
+        modelShader.reset(new Shader((shaderDir + "/model_loading.vs").c_str(), (shaderDir + "/debug_view.fs").c_str(),
+                                     "#define DEBUG_VIEW 1\n", (shaderDir + "/debug_view.gs").c_str()));
+        compositeShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/debug_view_composite.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        if (activeMode != OFF)
+            LOG_INFO("[DebugView] " << modeName(activeMode));
+    }
+
+    // false before init()
+    bool ready() const { return usable && modelShader && compositeShader; }
+
+    Mode mode() const { return activeMode; }
+    bool active() const { return ready() && activeMode != OFF; }
+
+    // G: the next view, back to off after the last
+    void cycle()
+    {
+        activeMode = (Mode)((activeMode + 1) % MODE_COUNT);
+        LOG_INFO("[DebugView] " << modeName(activeMode));
+    }
+
+    // GL thread, after the tone map, with FrameData holding the main view: draws the `modelCount` placed
+    // models through `draw` into the debug target and that over the whole `width` x `height` scene
+    // framebuffer, which is bound again afterwards
+    void render(int width, int height, size_t modelCount, const DrawModel &draw)
+    {
+        static const Shader::UniformHandle uMode = Shader::uniformHandle("mode");
+        static const Shader::UniformHandle uViewportSize = Shader::uniformHandle("viewportSize");
+        static const Shader::UniformHandle uSource = Shader::uniformHandle("source");
+        static const Shader::UniformHandle uRamp = Shader::uniformHandle("ramp");
+        static const Shader::UniformHandle uOverlay = Shader::uniformHandle("overlay");
+        if (!active() || width <= 0 || height <= 0)
+            return;
+        createTarget(width, height);
+        if (!fbo)
+            return;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, width, height);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        const bool counting = activeMode == OVERDRAW || activeMode == QUAD_OVERDRAW;
+        modelShader->use();
+        modelShader->setInt(uMode, (int)activeMode);
+        modelShader->setVec2(uViewportSize, glm::vec2((float)width, (float)height));
+        for (size_t i = 0; i < modelCount; ++i)
+        {
+            // the transparent meshes turn blending off after themselves
+            glEnable(GL_DEPTH_TEST);
+            glDepthFunc(GL_LESS);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, counting ? GL_ONE : GL_ZERO);
+            modelShader->use();
+            draw(i, *modelShader);
+        }
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_BLEND);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glViewport(0, 0, width, height);
+        glDisable(GL_DEPTH_TEST);
+        // the wireframe blends its edges over the scene, the other views replace it
+        const bool overlay = activeMode == WIREFRAME;
+        if (overlay)
+            glEnable(GL_BLEND);
+        glState().bindVertexArray(emptyVao);
+        compositeShader->use();
+        compositeShader->setInt(uSource, (int)UNIT);
+        compositeShader->setBool(uRamp, activeMode == OVERDRAW || activeMode == QUAD_OVERDRAW || activeMode == TRIANGLE_DENSITY);
+        compositeShader->setBool(uOverlay, overlay);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, texture);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        if (overlay)
+            glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    void releaseGpu()
+    {
+        releaseTarget();
+        modelShader.reset();
+        compositeShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        usable = false;
+        glState().invalidate();
+    }
+
+private:
+    // the composite reads the debug target here; the post chain is done with the HDR unit by then
+    static const unsigned int UNIT = ToneMapper::UNIT_HDR;
+
+    std::string shaderDir;
+    bool usable = false;
+    Mode activeMode = OFF;
+    std::unique_ptr<Shader> modelShader;
+    std::unique_ptr<Shader> compositeShader;
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    GLuint depth = 0;
+    int targetWidth = 0, targetHeight = 0;
+    // the composite draws a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+
+    // RGBA16F, so the counts add up past 1, with a depth buffer of its own
+    void createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return;
+        releaseTarget();
+        targetWidth = width;
+        targetHeight = height;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[DebugView] Float render targets unsupported, debug views off");
+            releaseTarget();
+            usable = false;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (texture) glDeleteTextures(1, &texture);
+        if (depth) glDeleteRenderbuffers(1, &depth);
+        fbo = texture = depth = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
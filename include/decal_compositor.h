@@ -0,0 +1,413 @@
+#ifndef DECAL_COMPOSITOR_H
+#define DECAL_COMPOSITOR_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <json.hpp>
+#include <stb_image.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <material_overrides.h>
+#include <model.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+// DECALS=<decals.json>: stripes, logos and numbers stacked on the paint (MaterialOverrides::PAINT) without
+// projecting them per pixel every frame. Each car's decals are composited on the GPU into one texture laid
+// out like its paint's UVs: the paint meshes are drawn in UV space (model_loading.vs with UV_SPACE) once per
+// decal, each texel finding itself in the decal's box projector by its model-space position and blending
+// the decal over the earlier ones, premultiplied. A last pass grows a gutter around the UV islands and the
+// texture gets its mips; Model binds it with every draw, so shading costs one lookup whatever the count.
+// The file is polled twice a second and a change composites the cars again, one per frame; nothing is
+// composited otherwise. The file:
+//
+//   {"size": 2048, "decals": [{"image": "decals/stripe.png", "position": [0, 1.2, 0], "direction": [0, -1, 0],
+//     "up": [0, 0, -1], "size": [0.4, 4.5], "depth": 1.0, "opacity": 1, "model": "raptor"}, ...]}
+//
+// in model space: the decal's centre, the direction it is projected in (onto the faces looking back along
+// it), which way its image's top points, its width and height, the depth of its box and, optionally, a
+// substring of the model paths it applies to (every model by default). Images are relative to the file and
+// stacked in file order. "size" is the texture's side (DECAL_SIZE overrides it, default 2048).
+class DecalCompositor
+{
+public:
+    // `shaderDir` holds model_loading.vs, decal_composite.fs, oit_resolve.vs and decal_dilate.fs
+    explicit DecalCompositor(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    DecalCompositor(const DecalCompositor &) = delete;
+    DecalCompositor &operator=(const DecalCompositor &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("DECALS");
+        return env && *env;
+    }
+
+    // GL thread: compiles the passes and reads the decal file
+    void init()
+    {
+        file = std::getenv("DECALS") ? std::getenv("DECALS") : "";
+        compositeShader.reset(new Shader((shaderDir + "/model_loading.vs").c_str(), (shaderDir + "/decal_composite.fs").c_str(),
+                                         "#define UV_SPACE 1\n"));
+        compositeShader->use();
+        compositeShader->setInt("decalImage", 0);
+        dilateShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/decal_dilate.fs").c_str()));
+        dilateShader->use();
+        dilateShader->setInt("decalColor", 0);
+        dilateShader->setInt("decalCoverage", 1);
+        glGenVertexArrays(1, &emptyVao);
+        stamp = modified(file);
+        load();
+    }
+
+    bool ready() const { return compositeShader && dilateShader; }
+
+    // GL thread, once per frame at `now` seconds: re-reads the decal file when it changed and composites the
+    // first of `models` (loaded ones) whose texture is older than the decal set
+    void update(const std::vector<Model *> &models, double now)
+    {
+        if (!ready())
+            return;
+        if (now - lastPoll >= 0.5)
+        {
+            lastPoll = now;
+            const long long current = modified(file);
+            if (current != stamp)
+            {
+                stamp = current;
+                load();
+            }
+        }
+        for (size_t i = 0; i < models.size(); ++i)
+        {
+            if (!models[i] || !models[i]->ready())
+                continue;
+            Composite &c = composites[models[i]];
+            if (c.generation == generation)
+                continue;
+            composite(*models[i], c);
+            c.generation = generation;
+            return;
+        }
+    }
+
+    void releaseGpu()
+    {
+        for (std::map<Model *, Composite>::iterator it = composites.begin(); it != composites.end(); ++it)
+        {
+            it->first->setDecalTexture(0);
+            releaseTexture(it->second.texture);
+        }
+        composites.clear();
+        releaseImages();
+        releaseTargets();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        compositeShader.reset();
+        dilateShader.reset();
+        glState().invalidate();
+    }
+
+private:
+    struct Decal
+    {
+        GLuint image = 0;
+        glm::mat4 fromModel = glm::mat4(1.0f);
+        glm::vec3 direction = glm::vec3(0.0f, -1.0f, 0.0f);
+        float opacity = 1.0f;
+        std::string model;
+    };
+    // a car's texture and the decal set it was composited from
+    struct Composite
+    {
+        GLuint texture = 0;
+        unsigned int generation = 0;
+    };
+
+    std::string shaderDir;
+    std::string file;
+    long long stamp = 0;
+    double lastPoll = 0.0;
+    unsigned int generation = 0;
+    int size = 2048;
+    std::vector<Decal> decals;
+    std::map<Model *, Composite> composites;
+
+    std::unique_ptr<Shader> compositeShader;
+    std::unique_ptr<Shader> dilateShader;
+    GLuint emptyVao = 0;
+    // the composite before its gutter: premultiplied colour and the paint's coverage
+    GLuint fbo = 0, colorTarget = 0, coverageTarget = 0, dilateFbo = 0;
+    int targetSize = 0;
+
+    static long long modified(const std::string &path)
+    {
+        struct stat info;
+        return !path.empty() && stat(path.c_str(), &info) == 0 ? (long long)info.st_mtime : 0;
+    }
+
+    static glm::vec3 vec3Of(const nlohmann::json &j, const char *key, const glm::vec3 &fallback)
+    {
+        if (!j.contains(key) || !j[key].is_array() || j[key].size() < 3)
+            return fallback;
+        return glm::vec3(j[key][0].get<float>(), j[key][1].get<float>(), j[key][2].get<float>());
+    }
+
+    // reads the decal file and its images; a file that doesn't parse keeps the current set
+    void load()
+    {
+        std::vector<Decal> loaded;
+        int loadedSize = 2048;
+        try
+        {
+            std::ifstream in(file.c_str());
+            if (!in)
+            {
+                LOG_ERROR("[Decals] Can't open " << file);
+                return;
+            }
+            const nlohmann::json j = nlohmann::json::parse(in);
+            loadedSize = j.value("size", 2048);
+            const std::string dir = file.find_last_of("/\\") == std::string::npos ? std::string(".") : file.substr(0, file.find_last_of("/\\"));
+            const nlohmann::json &list = j.contains("decals") ? j["decals"] : nlohmann::json::array();
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                const nlohmann::json &d = list[i];
+                const std::string image = d.value("image", std::string());
+                Decal decal;
+                decal.image = loadImage(image.empty() || image[0] == '/' || image.find(':') != std::string::npos ? image : dir + "/" + image);
+                if (!decal.image)
+                    continue;
+                const glm::vec3 position = vec3Of(d, "position", glm::vec3(0.0f));
+                decal.direction = glm::normalize(vec3Of(d, "direction", glm::vec3(0.0f, -1.0f, 0.0f)));
+                glm::vec3 up = vec3Of(d, "up", glm::vec3(0.0f, 0.0f, -1.0f));
+                if (std::abs(glm::dot(glm::normalize(up), decal.direction)) > 0.999f)
+                    up = std::abs(decal.direction.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, -1.0f);
+                const glm::vec3 right = glm::normalize(glm::cross(decal.direction, up));
+                const glm::vec3 top = glm::cross(right, decal.direction);
+                float width = 1.0f, height = 1.0f;
+                if (d.contains("size") && d["size"].is_array() && d["size"].size() >= 2)
+                {
+                    width = std::max(1e-4f, d["size"][0].get<float>());
+                    height = std::max(1e-4f, d["size"][1].get<float>());
+                }
+                const float depth = std::max(1e-4f, d.value("depth", 1.0f));
+                // box corners at +-1 to model space, and back
+                glm::mat4 toModel(glm::vec4(right * (0.5f * width), 0.0f), glm::vec4(top * (0.5f * height), 0.0f),
+                                  glm::vec4(decal.direction * (0.5f * depth), 0.0f), glm::vec4(position, 1.0f));
+                decal.fromModel = glm::inverse(toModel);
+                decal.opacity = glm::clamp(d.value("opacity", 1.0f), 0.0f, 1.0f);
+                decal.model = d.value("model", std::string());
+                loaded.push_back(decal);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("[Decals] Bad decal file " << file << ": " << e.what());
+            for (size_t i = 0; i < loaded.size(); ++i)
+                releaseTexture(loaded[i].image);
+            return;
+        }
+        releaseImages();
+        decals.swap(loaded);
+        if (const char *env = std::getenv("DECAL_SIZE"))
+            loadedSize = std::atoi(env);
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        size = std::min(std::max(64, loadedSize), (int)maxSize);
+        ++generation;
+        LOG_INFO("[Decals] " << file << ": " << decals.size() << " decals, composited at " << size << "x" << size);
+    }
+
+    GLuint loadImage(const std::string &path)
+    {
+        int w = 0, h = 0, components = 0;
+        unsigned char *pixels = stbi_load(path.c_str(), &w, &h, &components, 4);
+        if (!pixels)
+        {
+            LOG_ERROR("[Decals] Can't read decal image " << path);
+            return 0;
+        }
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidate();
+        stbi_image_free(pixels);
+        gpuMemory().trackTexture(texture, GpuMemory::MODEL_TEXTURES, GL_SRGB8_ALPHA8, w, h, 1, true, "decal " + path);
+        return texture;
+    }
+
+    static GLuint createTarget(GLenum internalFormat, GLenum format, int side, bool mipmapped)
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, side, side, 0, format, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mipmapped ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return texture;
+    }
+
+    bool createTargets()
+    {
+        if (fbo && targetSize == size)
+            return true;
+        releaseTargets();
+        targetSize = size;
+        colorTarget = createTarget(GL_SRGB8_ALPHA8, GL_RGBA, size, false);
+        coverageTarget = createTarget(GL_R8, GL_RED, size, false);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTarget, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, coverageTarget, 0);
+        const GLenum buffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+        glDrawBuffers(2, buffers);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glGenFramebuffers(1, &dilateFbo);
+        if (!complete)
+        {
+            LOG_WARN("[Decals] Composite target incomplete, the paint stays without decals");
+            releaseTargets();
+            return false;
+        }
+        return true;
+    }
+
+    void releaseTargets()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (dilateFbo) glDeleteFramebuffers(1, &dilateFbo);
+        if (colorTarget) glDeleteTextures(1, &colorTarget);
+        if (coverageTarget) glDeleteTextures(1, &coverageTarget);
+        fbo = dilateFbo = colorTarget = coverageTarget = 0;
+        targetSize = 0;
+    }
+
+    void releaseImages()
+    {
+        for (size_t i = 0; i < decals.size(); ++i)
+            releaseTexture(decals[i].image);
+        decals.clear();
+    }
+
+    static void releaseTexture(GLuint &texture)
+    {
+        if (!texture)
+            return;
+        gpuMemory().releaseTexture(texture);
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+
+    // the decals of `model` into its texture; a model with none (or without paint) has its texture dropped
+    void composite(Model &model, Composite &c)
+    {
+        std::vector<const Decal *> applied;
+        for (size_t i = 0; i < decals.size(); ++i)
+            if (decals[i].model.empty() || model.directory.find(decals[i].model) != std::string::npos)
+                applied.push_back(&decals[i]);
+        bool paint = false;
+        for (size_t i = 0; i < model.meshes.size() && !paint; ++i)
+            paint = model.meshes[i].materialTag == MaterialOverrides::PAINT;
+        if (applied.empty() || !paint)
+        {
+            model.setDecalTexture(0);
+            releaseTexture(c.texture);
+            return;
+        }
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        GLint previousFbo = 0, viewport[4], blend[4];
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetIntegerv(GL_BLEND_SRC_RGB, &blend[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB, &blend[1]);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, &blend[2]);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, &blend[3]);
+        const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST), cullFace = glIsEnabled(GL_CULL_FACE);
+        const GLboolean blending = glIsEnabled(GL_BLEND), srgb = glIsEnabled(GL_FRAMEBUFFER_SRGB);
+        if (!createTargets())
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+            return;
+        }
+        if (!c.texture)
+        {
+            c.texture = createTarget(GL_SRGB8_ALPHA8, GL_RGBA, size, true);
+            gpuMemory().trackTexture(c.texture, GpuMemory::MODEL_TEXTURES, GL_SRGB8_ALPHA8, size, size, 1, true, "paint decals " + model.directory);
+        }
+
+        // the decals, in order, premultiplied over each other in linear space
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, size, size);
+        const GLfloat none[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 0, none);
+        glClearBufferfv(GL_COLOR, 1, none);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glEnable(GL_FRAMEBUFFER_SRGB);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        compositeShader->use();
+        for (size_t i = 0; i < applied.size(); ++i)
+        {
+            compositeShader->setMat4("decalFromModel", applied[i]->fromModel);
+            compositeShader->setVec3("decalDirection", applied[i]->direction);
+            compositeShader->setFloat("decalOpacity", applied[i]->opacity);
+            glState().bindTexture(0, GL_TEXTURE_2D, applied[i]->image);
+            model.drawTagged(*compositeShader, MaterialOverrides::PAINT);
+        }
+
+        // the gutter, into the car's texture, and its mips
+        glDisable(GL_BLEND);
+        glBindFramebuffer(GL_FRAMEBUFFER, dilateFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, c.texture, 0);
+        dilateShader->use();
+        glState().bindTexture(0, GL_TEXTURE_2D, colorTarget);
+        glState().bindTexture(1, GL_TEXTURE_2D, coverageTarget);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glState().bindTexture(0, GL_TEXTURE_2D, c.texture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glBlendFuncSeparate((GLenum)blend[0], (GLenum)blend[1], (GLenum)blend[2], (GLenum)blend[3]);
+        if (depthTest) glEnable(GL_DEPTH_TEST);
+        if (cullFace) glEnable(GL_CULL_FACE);
+        if (!blending) glDisable(GL_BLEND);
+        else glEnable(GL_BLEND);
+        if (!srgb) glDisable(GL_FRAMEBUFFER_SRGB);
+        glState().invalidate();
+        model.setDecalTexture(c.texture);
+        LOG_INFO("[Decals] " << applied.size() << " decals composited for " << model.directory << " in "
+                 << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms");
+    }
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DRAW_STATS_H
+#define DRAW_STATS_H
+
+#include <cstddef>
+
+// GL_STATS=0 compiles the state-change counters below out (GL_STATS_ADD expands to nothing, its argument
+// isn't evaluated). Set it from CMake with -DGL_STATS=<0|1>.
+#ifndef GL_STATS
+#define GL_STATS 1
+#endif
+
+// Draw submissions since the last reset(), counted at the glDraw* call sites: `calls` is the API calls
+// (one per multi-draw), `draws` the draws they expand to (a multi-draw's commands, GPU-culled ones included).
+// Two increments per call, so it stays on in every build; the benchmark and the HUD read and reset it per frame.
+// `meshes` / `culled` are the main view's CPU culling: meshes of the placed models tested, and skipped by the
+// frustum (whole models included) or last frame's occlusion queries.
+// With GL_STATS the binds that reach the driver through GLStateCache (cache hits aren't counted), the
+// Shader uniform uploads and the triangles submitted by Mesh and Model draws (index counts times instances,
+// before any GPU culling) are counted as well.
+struct DrawStats
+{
+    size_t calls = 0;
+    size_t draws = 0;
+    size_t meshes = 0;
+    size_t culled = 0;
+    // GL_STATS only
+    size_t primitives = 0;
+    size_t programBinds = 0;
+    size_t textureBinds = 0;
+    size_t vaoBinds = 0;
+    size_t uniformUploads = 0;
+
+    void count(size_t subDraws = 1)
+    {
+        calls++;
+        draws += subDraws;
+    }
+    void countCulled(size_t tested, size_t skipped)
+    {
+        meshes += tested;
+        culled += skipped;
+    }
+    void reset() { *this = DrawStats(); }
+};
+
+// GL thread only, like the draws it counts
+inline DrawStats &drawStats()
+{
+    static DrawStats stats;
+    return stats;
+}
+
+// GL_STATS_ADD(programBinds, 1)
+#if GL_STATS
+#define GL_STATS_ADD(counter, n) (drawStats().counter += (n))
+#else
+#define GL_STATS_ADD(counter, n) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <async_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+// Scales the scene's render target with the GPU load so the frame rate holds: update() takes the GPU time of
+// a whole frame (GpuProfiler's "frame" scope, a few frames old) and resizes the HDR target ToneMapper
+// renders into, which the tone-map pass (after TemporalAA, when on) stretches over the window. Shading cost
+// goes with the pixel count, so the scale moves by sqrt(target / measured). The scale moves in fixed steps
+// (each one re-creates the targets) and holds for a few frames after every change, so the profiler samples
+// it reacts to were rendered at the current size; a dead band around the target keeps it from hunting.
+// DYNAMIC_RES=1 enables it; DYNAMIC_RES_TARGET_MS (default 15, headroom under a 60 Hz vsync),
+// DYNAMIC_RES_MIN (default 0.5) and DYNAMIC_RES_MAX (default 1) bound it, as a fraction of each axis.
+class DynamicResolution
+{
+public:
+    static const int SETTLE_FRAMES = 8;   // frames held after a change (covers GpuProfiler::LATENCY)
+    static constexpr float STEP = 0.05f;  // scale granularity per axis
+
+    DynamicResolution()
+    {
+        const char *env = std::getenv("DYNAMIC_RES");
+        active = env && std::string(env) == "1";
+        if (const char *t = std::getenv("DYNAMIC_RES_TARGET_MS"))
+            targetMs = std::max(1.0f, (float)std::atof(t));
+        if (const char *lo = std::getenv("DYNAMIC_RES_MIN"))
+            minScale = std::min(1.0f, std::max(0.1f, (float)std::atof(lo)));
+        if (const char *hi = std::getenv("DYNAMIC_RES_MAX"))
+            maxScale = std::min(2.0f, std::max(minScale, (float)std::atof(hi)));
+        currentScale = maxScale;
+        if (active)
+            LOG_INFO("[DynRes] Scene resolution " << minScale << "x - " << maxScale << "x for " << targetMs << " ms of GPU time per frame");
+    }
+
+    bool enabled() const { return active; }
+    float scale() const { return active ? currentScale : 1.0f; }
+
+    // once per frame with the latest GPU frame time in ms (<= 0 when no new sample came back)
+    void update(double gpuMs)
+    {
+        if (!active || gpuMs <= 0.0)
+            return;
+        // light smoothing: one slow frame (a texture upload, a probe capture) shouldn't drop the resolution
+        filteredMs = filteredMs > 0.0 ? filteredMs + (gpuMs - filteredMs) * 0.25 : gpuMs;
+        if (settle > 0)
+        {
+            --settle;
+            return;
+        }
+        const double ratio = targetMs / filteredMs;
+        if (ratio > 0.9 && ratio < 1.1)
+            return;
+        float wanted = currentScale * (float)std::sqrt(ratio);
+        wanted = std::floor(wanted / STEP + 0.5f) * STEP;
+        wanted = std::min(maxScale, std::max(minScale, wanted));
+        if (std::fabs(wanted - currentScale) < STEP * 0.5f)
+            return;
+        LOG_DEBUG("[DynRes] " << filteredMs << " ms -> scale " << wanted);
+        currentScale = wanted;
+        settle = SETTLE_FRAMES;
+        // the next samples measure the new size
+        filteredMs = 0.0;
+    }
+
+    // one axis of the render target for a window axis of `size` pixels
+    int scaled(int size) const
+    {
+        return std::max(1, (int)(size * scale() + 0.5f));
+    }
+
+private:
+    bool active = false;
+    float targetMs = 15.0f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float currentScale = 1.0f;
+    double filteredMs = 0.0;
+    int settle = 0;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef ENGINE_CLOCK_H
+#define ENGINE_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+// The engine's one clock: 64-bit steady_clock ticks since the process started, read as double seconds,
+// milliseconds or microseconds. Frame deltas, the trace and GpuProfiler's CPU times, hot reload polling
+// and the startup timings all read it, so they agree and stay exact however long the viewer runs (a float
+// of seconds since start is down to 1/128 s steps after a day, which kiosks left running reach).
+//
+//     const EngineClock::Ticks start = EngineClock::ticks();
+//     ...
+//     double ms = EngineClock::toMs(EngineClock::ticks() - start);
+class EngineClock
+{
+public:
+    typedef uint64_t Ticks;
+
+    // pins the origin; main calls it first thing so times count from process start
+    static void start() { origin(); }
+
+    static Ticks ticks() { return ticksAt(std::chrono::steady_clock::now()); }
+
+    // a steady_clock reading (e.g. a request time a loader kept) on this clock; 0 if before the origin
+    static Ticks ticksAt(std::chrono::steady_clock::time_point t)
+    {
+        const std::chrono::steady_clock::duration since = t - origin();
+        return since.count() > 0 ? (Ticks)since.count() : 0;
+    }
+
+    static double ticksPerSecond() { return (double)std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num; }
+    static double toSeconds(Ticks t) { return (double)t / ticksPerSecond(); }
+    static double toMs(Ticks t) { return toSeconds(t) * 1e3; }
+    static double toUs(Ticks t) { return toSeconds(t) * 1e6; }
+
+    static double seconds() { return toSeconds(ticks()); }
+    static double ms() { return toMs(ticks()); }
+    static double us() { return toUs(ticks()); }
+
+private:
+    static std::chrono::steady_clock::time_point origin()
+    {
+        static const std::chrono::steady_clock::time_point first = std::chrono::steady_clock::now();
+        return first;
+    }
+};
+
+#endif
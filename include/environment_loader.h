@@ -0,0 +1,1052 @@
+#ifndef ENVIRONMENT_LOADER_H
+#define ENVIRONMENT_LOADER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <geometry_kernels.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <ibl_baker.h>
+#include <ibl_cache.h>
+#include <procedural_sky.h>
+#include <spherical_harmonics.h>
+#include <startup_timings.h>
+#include <thread_pool.h>
+#include <virtual_file_system.h>
+
+#if defined(HAS_TINYEXR)
+#include "tinyexr.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loads HDR environments (equirectangular EXR) and bakes their IBL maps without stalling the render loop.
+// load() reads the EXR on the VirtualFileSystem's I/O threads (so it can sit in a .carpak or be
+// memory-mounted), then decodes it and projects the diffuse SH on the worker pool; pump() (once per frame on the GL
+// thread) then runs the IBLBaker one step at a time (the env faces, the mip chain, a prefilter mip) within a
+// GPU time budget, and swaps the finished maps in at once. The maps being drawn with stay valid until then.
+//
+// Scanline EXRs are streamed: the worker only reads the header, then strips of rows are decoded a few at
+// a time on the pool (each strip's chunks repackaged as a standalone EXR for tinyexr), converted to half
+// floats and uploaded one per step through a pixel buffer, so host memory stays at a few strips whatever
+// the HDRI's size. Tiled, multipart and integer files are decoded whole. EXR_STREAM=0 decodes everything
+// whole, EXR_STRIP_MB sets the strip size (4 MB of RGB halves by default).
+//
+// loadProcedural() feeds a ProceduralSky through the same path: its faces are rendered on the GPU instead
+// of converted from an EXR, then mipped and prefiltered like any environment.
+//
+// Step costs are measured with GL_TIME_ELAPSED queries and remembered per step, so after the first bake
+// (usually the blocking one at startup) each frame runs as many steps as fit in the budget.
+class EnvironmentLoader
+{
+public:
+    typedef IBLMaps Maps;
+
+    // `shaderDir` holds the bake shaders (see IBLBaker)
+    explicit EnvironmentLoader(const std::string &shaderDir, ThreadPool &pool = ThreadPool::shared())
+        : baker(shaderDir), pool(pool)
+    {
+    }
+
+    // waits for an outstanding decode so no worker outlives the loader; GL objects go in releaseGpu()
+    ~EnvironmentLoader()
+    {
+        if (decode.valid())
+            decode.wait();
+        for (size_t i = 0; i < strips.size(); ++i)
+            strips[i].wait();
+    }
+
+    EnvironmentLoader(const EnvironmentLoader &) = delete;
+    EnvironmentLoader &operator=(const EnvironmentLoader &) = delete;
+
+    // starts loading `exrPath`; returns immediately. While another environment is still baking, the newest
+    // request waits for it and replaces any older queued one. `useCache` false bakes even over a valid cache
+    // (which is then rewritten).
+    void load(const std::string &exrPath, bool useCache = true)
+    {
+        std::shared_ptr<Decoded> job = newJob(exrPath);
+        job->rebake = !useCache;
+        // the read starts now on the I/O threads, also when the job has to queue behind another bake
+        job->file = fileSystem().readAsync(exrPath);
+        if (busy())
+        {
+            queued = job;
+            return;
+        }
+        start(job);
+    }
+
+    // starts baking `sky`, queued like load(). Only the SH projection runs on the CPU (on the worker pool);
+    // the faces are rendered by procedural_sky.fs, so re-baking after a sun change costs a few frames' budget.
+    void loadProcedural(const ProceduralSky &sky)
+    {
+        std::shared_ptr<Decoded> job = newJob("procedural sky");
+        job->procedural = true;
+        job->sky = sky;
+        job->sky.sunDirection = glm::normalize(sky.sunDirection);
+        if (busy())
+        {
+            queued = job;
+            return;
+        }
+        start(job);
+    }
+
+    bool busy() const { return decode.valid() || pending; }
+
+    // GL thread: advances the bake within `budgetMs` of GPU (and CPU) time; at least one step runs per call so
+    // a bake always finishes. budgetMs < 0 waits for the decode and bakes everything now. Returns true when a
+    // new environment became current.
+    bool pump(double budgetMs = 2.0)
+    {
+        collectTimings();
+        const bool block = budgetMs < 0.0;
+        if (decode.valid())
+        {
+            if (!block && decode.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            pending = decode.get();
+            step = 0;
+            bakeSteps = 0;
+            stripsSubmitted = 0;
+            if (!pending->error.empty())
+            {
+                LOG_WARN("[Environment] Can't load '" << pending->path << "': " << pending->error);
+                pending.reset();
+                startQueued();
+                return false;
+            }
+        }
+        if (!pending)
+            return false;
+
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+        double gpuMs = 0.0;
+        bool ran = false;
+        while (step < stepCount())
+        {
+            // strips go up as the workers finish them; a frame doesn't wait for one
+            if (!block && !stepReady(step))
+                break;
+            double cost = costOf(costSlot(step));
+            cost = cost >= 0.0 ? cost : budgetMs;
+            if (!block && ran && (gpuMs + cost > budgetMs || elapsedMs(frameStart) > budgetMs))
+                break;
+            runStep(step);
+            if (!pending)
+                break; // restarted without the cache
+            gpuMs += cost;
+            ran = true;
+            ++step;
+        }
+        glState().invalidate(); // the bake binds programs, VAOs, textures and FBOs directly
+        if (!pending)
+            return block ? pump(budgetMs) : false;
+        if (step < stepCount())
+            return false;
+
+        // bake complete: swap in the new maps at once
+        releaseMaps(maps);
+        maps = next;
+        next = Maps();
+        currentCached = pending->cached;
+        if (!pending->procedural) // sky edits re-bake every few frames while a key is held
+            LOG_INFO("[Environment] '" << pending->path << "' is now current ("
+                     << elapsedMs(pending->requested) << " ms since the request)");
+        // nothing else to bake: free the baker's programs, FBO and VAO. Kept after procedural skies, whose
+        // sun edits come in bursts.
+        if (!queued && !pending->procedural)
+            baker.release();
+        pending.reset();
+        startQueued();
+        return true;
+    }
+
+    const Maps &current() const { return maps; }
+    // the current maps were read from the IBL cache rather than baked
+    bool currentFromCache() const { return currentCached; }
+
+    // GL thread: deletes every map and bake resource (call while the context is still current)
+    void releaseGpu()
+    {
+        if (decode.valid())
+            decode.wait();
+        decode = std::future<std::shared_ptr<Decoded> >();
+        dropStrips();
+        pending.reset();
+        releaseMaps(maps);
+        releaseMaps(next);
+        if (hdrTexture)
+        {
+            gpuMemory().releaseTexture(hdrTexture);
+            glDeleteTextures(1, &hdrTexture);
+        }
+        hdrTexture = 0;
+        baker.release();
+        for (size_t i = 0; i < timings.size(); ++i)
+            glDeleteQueries(1, &timings[i].query);
+        timings.clear();
+    }
+
+private:
+    // where the rows of a scanline EXR are, for decoding it a strip at a time (see decodeStrip)
+    struct StripSource
+    {
+        VirtualFileSystem::SharedView file;
+        size_t headerSize = 0;       // magic, version and attributes: everything before the offset table
+        size_t dataWindowOffset = 0; // of the dataWindow box2i in the header
+        int minY = 0, width = 0, height = 0;  // of the source
+        int shrink = 1;                       // downsample factor (see downsampleFactor)
+        int linesPerBlock = 1, stripRows = 1; // stripRows (source rows) is a multiple of linesPerBlock and shrink
+        std::vector<uint64_t> offsets;       // file offset of each block's chunk
+        std::vector<float> cosPhi, sinPhi;   // SH azimuth terms of the output, shared by the strips
+        unsigned int strips() const { return (unsigned int)((height + stripRows - 1) / stripRows); }
+    };
+    // one decoded strip: output rows [y, y + rows) as RGB halves and their part of the SH projection
+    struct Strip
+    {
+        int y = 0, rows = 0;
+        std::vector<uint16_t> pixels;
+        SHIrradiance irradianceSH;
+        std::string error;
+    };
+
+    // worker output: the decoded image and its SH projection, or just the hash when the cache is usable.
+    // Procedural jobs carry the sky instead of a file and only get their SH from the worker.
+    struct Decoded
+    {
+        std::string path;
+        std::shared_future<VirtualFileSystem::SharedView> file; // read issued by load(); retries read in the job
+        std::chrono::steady_clock::time_point requested;
+        bool procedural = false;
+        ProceduralSky sky;
+        uint64_t sourceHash = 0;
+        uint64_t paramsHash = 0;
+        bool cached = false;
+        bool rebake = false; // skip the cache check (the bake still writes it)
+        std::vector<uint16_t> pixels; // RGB half floats; empty when streamed
+        std::shared_ptr<const StripSource> stream;
+        int width = 0, height = 0; // of the equirect texture: the source's over shrink
+        int shrink = 1;
+        SHIrradiance irradianceSH;
+        std::string error;
+    };
+    struct Timing
+    {
+        GLuint query;
+        unsigned int slot; // see costSlot()
+    };
+    static const unsigned int STRIP_SLOT = ~0u;
+    static const size_t STRIPS_IN_FLIGHT = 3;
+
+    IBLBaker baker;
+    IBLBakeSettings settings;
+    ThreadPool &pool;
+    Maps maps;
+    bool currentCached = false;
+    std::future<std::shared_ptr<Decoded> > decode;
+    std::shared_ptr<Decoded> pending;
+    std::shared_ptr<Decoded> queued; // newest request made while busy, not submitted yet
+    // bake in progress
+    Maps next;
+    GLuint hdrTexture = 0;
+    unsigned int step = 0;
+    unsigned int bakeSteps = 0; // baker steps of the pending bake, known once setup ran (or the last strip is in)
+    // strips of a streamed EXR being decoded, in order, and the pixel buffer they go up through
+    std::deque<std::future<std::shared_ptr<Strip> > > strips;
+    unsigned int stripsSubmitted = 0;
+    GLuint stripBuffer = 0;
+    // measured GPU ms per step (-1 = not measured yet; every strip shares one) and queries whose result isn't read yet
+    std::vector<double> stepCostMs;
+    double stripCostMs = -1.0;
+    std::vector<Timing> timings;
+
+    static double elapsedMs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    static bool envDisabled(const char *name)
+    {
+        const char *v = std::getenv(name);
+        return v && std::string(v) == "0";
+    }
+
+    static std::string downsampled(const Decoded &job)
+    {
+        return job.shrink > 1 ? ", downsampled " + std::to_string(job.shrink) + "x" : std::string();
+    }
+
+    uint64_t paramsHash() const
+    {
+        std::vector<uint32_t> sizes;
+        sizes.push_back(settings.envSize);
+        sizes.push_back(settings.prefilterSize);
+        sizes.push_back(settings.prefilterMips);
+        sizes.push_back(SHIrradiance::COEFFICIENTS);
+        sizes.push_back(envDisabled("EXR_DOWNSAMPLE") ? 0 : 1); // the bake source differs
+        return IBLCache::paramsHash(sizes, baker.shaderPaths());
+    }
+
+    std::shared_ptr<Decoded> newJob(const std::string &path) const
+    {
+        std::shared_ptr<Decoded> job = std::make_shared<Decoded>();
+        job->path = path;
+        job->requested = std::chrono::steady_clock::now();
+        job->paramsHash = paramsHash();
+        return job;
+    }
+
+    void start(const std::shared_ptr<Decoded> &job, bool allowCache = true)
+    {
+        if (job->procedural)
+        {
+            decode = pool.submit([job]() {
+                FrameTrace::Scope trace("sky irradiance");
+                StartupTimings::Scope startup("IBL");
+                job->irradianceSH = job->sky.irradiance();
+                return job;
+            });
+            return;
+        }
+        const bool useCache = allowCache && !job->rebake && !envDisabled("IBL_CACHE");
+        const IBLBakeSettings s = settings;
+        decode = pool.submit([job, useCache, s]() {
+            FrameTrace::Scope trace("decode environment", job->path);
+            StartupTimings::Scope startup("IBL");
+            VirtualFileSystem::SharedView file;
+            if (job->file.valid())
+                file = job->file.get();
+            else
+            {
+                file = std::make_shared<FileView>();
+                if (!fileSystem().open(job->path, *file))
+                    file.reset();
+            }
+            job->file = std::shared_future<VirtualFileSystem::SharedView>();
+            if (!file || file->empty())
+            {
+                job->error = "file not readable";
+                return job;
+            }
+            job->sourceHash = IBLCache::hashBytes(file->data(), file->size());
+            Maps probe;
+            job->cached = useCache && IBLCache::valid(IBLCache::cachePath(job->path), job->sourceHash, job->paramsHash, IBLBaker::cacheEntries(probe, s));
+            if (job->cached)
+                return job;
+#if defined(HAS_TINYEXR)
+            std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+            if (!envDisabled("EXR_STREAM") && openStripSource(file, *job, s.envSize))
+                LOG_INFO("[Environment] Streaming '" << job->path << "' (" << job->width << "x" << job->height << downsampled(*job)
+                         << ") in " << job->stream->strips() << " strips of " << job->stream->stripRows << " rows");
+            else if (decodeEXR(*job, *file, s.envSize))
+                LOG_INFO("[Environment] Decoded '" << job->path << "' (" << job->width << "x" << job->height << downsampled(*job)
+                         << ") in " << elapsedMs(decodeStart) << " ms");
+#else
+            job->error = "tinyexr not compiled in";
+#endif
+            return job;
+        });
+    }
+
+#if defined(HAS_TINYEXR)
+    // one colour channel of a decoded EXR: half or float samples, `stride` elements apart
+    struct SourceChannel
+    {
+        const unsigned char *data;
+        bool half;
+        int stride;
+    };
+
+    static float sampleOf(const SourceChannel &ch, size_t i)
+    {
+        if (!ch.data)
+            return 0.0f;
+        if (ch.half)
+            return glm::unpackHalf1x16(((const uint16_t *)ch.data)[i * ch.stride]);
+        return ((const float *)ch.data)[i * ch.stride];
+    }
+
+    // `count` samples of `ch` from element `first` on as floats (tight per-type loops the compiler vectorises)
+    static void loadSamples(const SourceChannel &ch, size_t first, int count, float *out)
+    {
+        if (!ch.data)
+            std::fill(out, out + count, 0.0f);
+        else if (ch.half)
+        {
+            const uint16_t *in = (const uint16_t *)ch.data + first * ch.stride;
+            for (int i = 0; i < count; ++i)
+                out[i] = glm::unpackHalf1x16(in[(size_t)i * ch.stride]);
+        }
+        else
+        {
+            const float *in = (const float *)ch.data + first * ch.stride;
+            for (int i = 0; i < count; ++i)
+                out[i] = in[(size_t)i * ch.stride];
+        }
+    }
+
+    // the equirect the bake needs no more of: envSize cube faces resolve 4 * envSize texels around the
+    // horizon, so larger sources are box-filtered down by the largest factor that divides both sides (each
+    // output texel averages whole source texels) and fits. 1 keeps the source; EXR_DOWNSAMPLE=0 always does.
+    static int downsampleFactor(int width, int height, unsigned int envSize)
+    {
+        if (envDisabled("EXR_DOWNSAMPLE") || envSize == 0)
+            return 1;
+        for (int f = width / (int)(4 * envSize); f > 1; --f)
+            if (width % f == 0 && height % f == 0)
+                return f;
+        return 1;
+    }
+
+    // output rows [first, first + count) of a width x height image into RGB halves at `out`, each texel the
+    // box average of `shrink` x `shrink` source texels (with 1, half sources are copied bit for bit), and
+    // adds them to `sh`; the channels hold the source rows from `top` on
+    static void convertRows(const SourceChannel rgb[3], int shrink, int width, int height, int top, int first, int count,
+                            uint16_t *out, SHIrradiance &sh, const float *cosPhi, const float *sinPhi)
+    {
+        const int sourceWidth = width * shrink;
+        const float scale = 1.0f / (float)(shrink * shrink);
+        std::vector<float> row((size_t)width * 3), source(shrink > 1 ? (size_t)sourceWidth : 0);
+        std::vector<float> sums(shrink > 1 ? (size_t)width * 3 : 0); // planar: channel c from c * width on
+        for (int y = first; y < first + count; ++y, out += (size_t)width * 3)
+        {
+            if (shrink == 1)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const size_t i = (size_t)(y - top) * width + x;
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float v = sampleOf(rgb[c], i);
+                        row[x * 3 + c] = v;
+                        out[x * 3 + c] = rgb[c].half ? ((const uint16_t *)rgb[c].data)[i * rgb[c].stride] : (uint16_t)glm::packHalf1x16(v);
+                    }
+                }
+            }
+            else
+            {
+                std::fill(sums.begin(), sums.end(), 0.0f);
+                for (int k = 0; k < shrink; ++k)
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        loadSamples(rgb[c], (size_t)(y * shrink + k - top) * sourceWidth, sourceWidth, &source[0]);
+                        GeometryKernels::addBoxSums(&source[0], (size_t)width, shrink, &sums[(size_t)c * width]);
+                    }
+                for (int x = 0; x < width; ++x)
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        const float v = sums[(size_t)c * width + x] * scale;
+                        row[x * 3 + c] = v;
+                        out[x * 3 + c] = (uint16_t)glm::packHalf1x16(v);
+                    }
+            }
+            sh.addEquirectRow(&row[0], 3, y, width, height, cosPhi, sinPhi);
+        }
+    }
+
+    // the whole image into job.pixels (job.width x job.height, `shrink` times smaller than the source) and
+    // its SH, in bands of rows across all cores
+    static void convertToHalf(const SourceChannel rgb[3], int shrink, Decoded &job)
+    {
+        const int width = job.width, height = job.height;
+        const unsigned int threads = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)height));
+        job.pixels.resize((size_t)width * height * 3);
+        std::vector<float> cosPhi, sinPhi;
+        SHIrradiance::equirectAzimuth(width, cosPhi, sinPhi);
+        std::vector<SHIrradiance> partial(threads);
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t)
+            workers.push_back(std::thread([&, t]() {
+                const int first = (int)(t * height / threads), last = (int)((t + 1) * height / threads);
+                convertRows(rgb, shrink, width, height, 0, first, last - first, &job.pixels[(size_t)first * width * 3], partial[t],
+                            &cosPhi[0], &sinPhi[0]);
+            }));
+        for (size_t t = 0; t < workers.size(); ++t)
+        {
+            workers[t].join();
+            job.irradianceSH.merge(partial[t]);
+        }
+        job.irradianceSH.finish();
+    }
+
+    // index of channel `name` (also as the last component of a layered name such as "beauty.R"), -1 if absent
+    static int findChannel(const EXRHeader &header, const char *name)
+    {
+        for (int c = 0; c < header.num_channels; ++c)
+        {
+            const char *n = header.channels[c].name;
+            const char *dot = std::strrchr(n, '.');
+            if (std::strcmp(dot ? dot + 1 : n, name) == 0)
+                return c;
+        }
+        return -1;
+    }
+
+    // the R, G and B channels of `header` (-1 where absent; a lone channel is luminance), false if one of
+    // them holds integers
+    static bool pickChannels(const EXRHeader &header, int channel[3])
+    {
+        const char *names[3] = {"R", "G", "B"};
+        for (int c = 0; c < 3; ++c)
+            channel[c] = findChannel(header, names[c]);
+        if (channel[0] < 0 && channel[1] < 0 && channel[2] < 0 && header.num_channels == 1)
+            channel[0] = channel[1] = channel[2] = 0; // luminance only
+        for (int c = 0; c < 3; ++c)
+            if (channel[c] >= 0 && header.pixel_types[channel[c]] == TINYEXR_PIXELTYPE_UINT)
+                return false;
+        return true;
+    }
+
+    static void bindChannels(const EXRHeader &header, const EXRImage &image, const int channel[3], SourceChannel rgb[3])
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            rgb[c].data = channel[c] >= 0 ? image.images[channel[c]] : nullptr;
+            rgb[c].half = channel[c] >= 0 && header.pixel_types[channel[c]] == TINYEXR_PIXELTYPE_HALF;
+            rgb[c].stride = 1;
+        }
+    }
+
+    // fills job.pixels (RGB halves, downsampled for an `envSize` bake), size and SH from `file`, the EXR's bytes. Scanline files are decoded with their native channel
+    // types (tinyexr decompresses blocks in parallel with TINYEXR_USE_THREAD), so half-float HDRIs never
+    // go through 32-bit floats; tiled and integer files go through LoadEXRFromMemory's assembled RGBA floats.
+    static bool decodeEXR(Decoded &job, const FileView &file, unsigned int envSize)
+    {
+        const char *err = nullptr;
+        EXRVersion version;
+        if (ParseEXRVersionFromMemory(&version, file.data(), file.size()) != TINYEXR_SUCCESS)
+        {
+            job.error = "not an EXR file";
+            return false;
+        }
+        EXRHeader header;
+        InitEXRHeader(&header);
+        bool native = !version.multipart && !version.non_image &&
+                      ParseEXRHeaderFromMemory(&header, &version, file.data(), file.size(), &err) == TINYEXR_SUCCESS && !header.tiled;
+        if (err)
+        {
+            FreeEXRErrorMessage(err);
+            err = nullptr;
+        }
+        int channel[3];
+        native = native && pickChannels(header, channel);
+        SourceChannel rgb[3];
+        if (native)
+        {
+            EXRImage image;
+            InitEXRImage(&image);
+            if (LoadEXRImageFromMemory(&image, &header, file.data(), file.size(), &err) != TINYEXR_SUCCESS)
+            {
+                job.error = err ? err : "LoadEXRImageFromMemory failed";
+                if (err)
+                    FreeEXRErrorMessage(err);
+                FreeEXRHeader(&header);
+                return false;
+            }
+            job.shrink = downsampleFactor(image.width, image.height, envSize);
+            job.width = image.width / job.shrink;
+            job.height = image.height / job.shrink;
+            bindChannels(header, image, channel, rgb);
+            convertToHalf(rgb, job.shrink, job);
+            FreeEXRImage(&image);
+            FreeEXRHeader(&header);
+            return true;
+        }
+        FreeEXRHeader(&header);
+
+        float *img = nullptr;
+        int width = 0, height = 0;
+        if (LoadEXRFromMemory(&img, &width, &height, file.data(), file.size(), &err) != TINYEXR_SUCCESS || !img)
+        {
+            job.error = err ? err : "LoadEXRFromMemory failed";
+            if (err)
+                FreeEXRErrorMessage(err);
+            return false;
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            rgb[c].data = (const unsigned char *)(img + c);
+            rgb[c].half = false;
+            rgb[c].stride = 4;
+        }
+        job.shrink = downsampleFactor(width, height, envSize);
+        job.width = width / job.shrink;
+        job.height = height / job.shrink;
+        convertToHalf(rgb, job.shrink, job);
+        free(img);
+        return true;
+    }
+
+    template <typename T>
+    static T readLE(const unsigned char *p)
+    {
+        T v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // sets job.stream (and the size, downsampled for an `envSize` bake) when `file` is a single-part
+    // scanline EXR with float or half colour channels in a compression tinyexr decodes; false leaves the
+    // file to decodeEXR
+    static bool openStripSource(const VirtualFileSystem::SharedView &file, Decoded &job, unsigned int envSize)
+    {
+        const unsigned char *data = file->data();
+        const size_t size = file->size();
+        EXRVersion version;
+        if (ParseEXRVersionFromMemory(&version, data, size) != TINYEXR_SUCCESS || version.tiled || version.multipart || version.non_image)
+            return false;
+        EXRHeader header;
+        InitEXRHeader(&header);
+        const char *err = nullptr;
+        int channel[3];
+        bool usable = ParseEXRHeaderFromMemory(&header, &version, data, size, &err) == TINYEXR_SUCCESS && !header.tiled &&
+                      pickChannels(header, channel);
+        if (err)
+            FreeEXRErrorMessage(err);
+        FreeEXRHeader(&header);
+        if (!usable)
+            return false;
+
+        // walk the attributes for the data window and compression, and find where the offset table starts
+        std::shared_ptr<StripSource> src = std::make_shared<StripSource>();
+        int compression = -1, minX = 0, maxX = -1, maxY = -1;
+        size_t pos = 8;
+        while (pos < size && data[pos] != 0)
+        {
+            const unsigned char *name = data + pos;
+            const unsigned char *nameEnd = (const unsigned char *)std::memchr(name, 0, size - pos);
+            if (!nameEnd)
+                return false;
+            const unsigned char *type = nameEnd + 1;
+            const unsigned char *typeEnd = type < data + size ? (const unsigned char *)std::memchr(type, 0, data + size - type) : nullptr;
+            if (!typeEnd || typeEnd + 5 > data + size)
+                return false;
+            const int32_t attributeSize = readLE<int32_t>(typeEnd + 1);
+            const size_t value = (size_t)(typeEnd + 5 - data);
+            if (attributeSize < 0 || value + (size_t)attributeSize > size)
+                return false;
+            if (std::strcmp((const char *)name, "dataWindow") == 0 && attributeSize == 16)
+            {
+                src->dataWindowOffset = value;
+                minX = readLE<int32_t>(data + value);
+                src->minY = readLE<int32_t>(data + value + 4);
+                maxX = readLE<int32_t>(data + value + 8);
+                maxY = readLE<int32_t>(data + value + 12);
+            }
+            else if (std::strcmp((const char *)name, "compression") == 0 && attributeSize == 1)
+                compression = data[value];
+            pos = value + (size_t)attributeSize;
+        }
+        src->headerSize = pos + 1;
+        switch (compression)
+        {
+        case 0: // NONE
+        case 1: // RLE
+        case 2: // ZIPS
+            src->linesPerBlock = 1;
+            break;
+        case 3: // ZIP
+            src->linesPerBlock = 16;
+            break;
+        case 4: // PIZ
+            src->linesPerBlock = 32;
+            break;
+        default:
+            return false;
+        }
+        src->width = maxX - minX + 1;
+        src->height = maxY - src->minY + 1;
+        if (!src->dataWindowOffset || src->width <= 0 || src->height <= 0)
+            return false;
+        const size_t blocks = (size_t)(src->height + src->linesPerBlock - 1) / src->linesPerBlock;
+        if (src->headerSize + blocks * 8 > size)
+            return false;
+        // a damaged offset table is left to tinyexr, which rebuilds it from the chunks
+        src->offsets.resize(blocks);
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            const uint64_t offset = readLE<uint64_t>(data + src->headerSize + b * 8);
+            if (offset < src->headerSize + blocks * 8 || offset + 8 > size ||
+                readLE<int32_t>(data + offset) != src->minY + (int)b * src->linesPerBlock ||
+                offset + 8 + (uint64_t)readLE<uint32_t>(data + offset + 4) > size)
+                return false;
+            src->offsets[b] = offset;
+        }
+
+        const char *mb = std::getenv("EXR_STRIP_MB");
+        const double stripBytes = (mb && std::atof(mb) > 0.0 ? std::atof(mb) : 4.0) * 1024.0 * 1024.0;
+        // strips hold whole blocks and whole output rows
+        src->shrink = downsampleFactor(src->width, src->height, envSize);
+        int unit = src->linesPerBlock;
+        while (unit % src->shrink)
+            unit += src->linesPerBlock;
+        const int rows = (int)(stripBytes / (src->width * 6.0));
+        src->stripRows = std::max(unit, rows / unit * unit);
+        job.shrink = src->shrink;
+        job.width = src->width / src->shrink;
+        job.height = src->height / src->shrink;
+        SHIrradiance::equirectAzimuth(job.width, src->cosPhi, src->sinPhi);
+        src->file = file;
+        job.stream = src;
+        return true;
+    }
+
+    // worker: strip `index` of `src`. Its chunks go to tinyexr as an EXR of their own (the file's header
+    // with the data window narrowed to the strip, a new offset table, the chunks as they are), so only the
+    // strip's rows are ever decompressed.
+    static std::shared_ptr<Strip> decodeStrip(const std::shared_ptr<const StripSource> &src, unsigned int index)
+    {
+        FrameTrace::Scope trace("decode environment strip", std::to_string(index));
+        StartupTimings::Scope startup("IBL");
+        std::shared_ptr<Strip> strip = std::make_shared<Strip>();
+        const int sourceY = (int)index * src->stripRows;
+        const int sourceRows = std::min(src->stripRows, src->height - sourceY);
+        strip->y = sourceY / src->shrink;
+        strip->rows = sourceRows / src->shrink;
+        const unsigned char *data = src->file->data();
+        const size_t firstBlock = (size_t)(sourceY / src->linesPerBlock);
+        const size_t blocks = (size_t)(sourceRows + src->linesPerBlock - 1) / src->linesPerBlock;
+        size_t bytes = src->headerSize + blocks * 8;
+        for (size_t b = 0; b < blocks; ++b)
+            bytes += 8 + readLE<uint32_t>(data + src->offsets[firstBlock + b] + 4);
+
+        std::vector<unsigned char> part(bytes);
+        std::memcpy(&part[0], data, src->headerSize);
+        const int32_t window[2] = {src->minY + sourceY, src->minY + sourceY + sourceRows - 1};
+        std::memcpy(&part[src->dataWindowOffset + 4], &window[0], 4);
+        std::memcpy(&part[src->dataWindowOffset + 12], &window[1], 4);
+        uint64_t at = src->headerSize + blocks * 8;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            const uint64_t offset = src->offsets[firstBlock + b];
+            const size_t chunk = 8 + readLE<uint32_t>(data + offset + 4);
+            std::memcpy(&part[src->headerSize + b * 8], &at, 8);
+            std::memcpy(&part[at], data + offset, chunk);
+            at += chunk;
+        }
+
+        EXRVersion version;
+        EXRHeader header;
+        InitEXRHeader(&header);
+        EXRImage image;
+        InitEXRImage(&image);
+        const char *err = nullptr;
+        int channel[3];
+        if (ParseEXRVersionFromMemory(&version, &part[0], part.size()) != TINYEXR_SUCCESS ||
+            ParseEXRHeaderFromMemory(&header, &version, &part[0], part.size(), &err) != TINYEXR_SUCCESS ||
+            !pickChannels(header, channel) ||
+            LoadEXRImageFromMemory(&image, &header, &part[0], part.size(), &err) != TINYEXR_SUCCESS)
+        {
+            strip->error = err ? err : "strip " + std::to_string(index) + " does not decode";
+            if (err)
+                FreeEXRErrorMessage(err);
+            FreeEXRHeader(&header);
+            return strip;
+        }
+        std::vector<unsigned char>().swap(part);
+        SourceChannel rgb[3];
+        bindChannels(header, image, channel, rgb);
+        const int width = src->width / src->shrink;
+        strip->pixels.resize((size_t)width * strip->rows * 3);
+        convertRows(rgb, src->shrink, width, src->height / src->shrink, sourceY, strip->y, strip->rows, &strip->pixels[0],
+                    strip->irradianceSH, &src->cosPhi[0], &src->sinPhi[0]);
+        FreeEXRImage(&image);
+        FreeEXRHeader(&header);
+        return strip;
+    }
+#endif
+
+
+    void startQueued()
+    {
+        if (!queued)
+            return;
+        std::shared_ptr<Decoded> job = queued;
+        queued.reset();
+        start(job);
+    }
+
+    // step layout: setup (upload, or the whole cache load), one upload per strip of a streamed EXR, the
+    // baker's steps, cache write (EXRs only)
+    unsigned int stepCount() const
+    {
+        if (pending && pending->cached)
+            return 1;
+        return 1 + stripSteps() + bakeSteps + (pending && pending->procedural ? 0 : 1);
+    }
+
+    unsigned int stripSteps() const { return pending && pending->stream ? pending->stream->strips() : 0; }
+
+    // false while step `s` is a strip upload whose strip is still decoding
+    bool stepReady(unsigned int s) const
+    {
+        if (s == 0 || s > stripSteps() || strips.empty())
+            return true;
+        return strips.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // where a step's cost is remembered: strips share one slot, so the baker's steps keep theirs whatever
+    // the strip count
+    unsigned int costSlot(unsigned int s) const
+    {
+        const unsigned int stripCount = stripSteps();
+        if (s == 0)
+            return 0;
+        if (s <= stripCount)
+            return STRIP_SLOT;
+        return s - stripCount;
+    }
+
+    double &costOf(unsigned int slot)
+    {
+        if (slot == STRIP_SLOT)
+            return stripCostMs;
+        if (slot >= stepCostMs.size())
+            stepCostMs.resize(slot + 1, -1.0);
+        return stepCostMs[slot];
+    }
+
+    void runStep(unsigned int s)
+    {
+        const unsigned int stripCount = stripSteps();
+        FrameTrace::Scope trace(s == 0                         ? "ibl setup"
+                                : s <= stripCount              ? "ibl upload strip"
+                                : s <= stripCount + bakeSteps  ? "ibl bake step"
+                                                               : "ibl cache write",
+                                std::to_string(s));
+        StartupTimings::Scope startup("IBL");
+        Timing t = {0, costSlot(s)};
+        glGenQueries(1, &t.query);
+        glBeginQuery(GL_TIME_ELAPSED, t.query);
+        if (s == 0)
+            setup();
+        else if (s <= stripCount)
+            uploadStrip();
+        else if (s <= stripCount + bakeSteps)
+        {
+            baker.runStep(s - stripCount - 1);
+            if (s == stripCount + bakeSteps)
+                finishBake();
+        }
+        else
+            saveCache();
+        glEndQuery(GL_TIME_ELAPSED);
+        timings.push_back(t);
+    }
+
+    // reads back finished timer queries without waiting for the GPU
+    void collectTimings()
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < timings.size(); ++i)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(timings[i].query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                timings[kept++] = timings[i];
+                continue;
+            }
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(timings[i].query, GL_QUERY_RESULT, &ns);
+            glDeleteQueries(1, &timings[i].query);
+            double ms = ns / 1.0e6;
+            double &cost = costOf(timings[i].slot);
+            cost = cost < 0.0 ? ms : 0.5 * (cost + ms);
+        }
+        timings.resize(kept);
+    }
+
+    void setup()
+    {
+        if (pending->cached)
+        {
+            if (IBLCache::load(IBLCache::cachePath(pending->path), pending->sourceHash, pending->paramsHash, next.irradianceSH, IBLBaker::cacheEntries(next, settings)))
+            {
+                next.prefilterMaxMip = (float)(settings.prefilterMips - 1);
+                return;
+            }
+            // the file changed after the worker checked it: start over, decoding and baking this time
+            std::shared_ptr<Decoded> job = newJob(pending->path);
+            pending.reset();
+            start(job, false);
+            return;
+        }
+        settings.compute = !envDisabled("IBL_COMPUTE");
+        if (pending->procedural)
+            baker.begin(pending->sky, proceduralSettings(pending->sky));
+        else if (pending->stream)
+        {
+            // the strips fill the texture in the next steps; the bake begins after the last one
+            createEquirect(nullptr);
+            submitStrips();
+            return;
+        }
+        else
+        {
+            createEquirect(&pending->pixels[0]);
+            std::vector<uint16_t>().swap(pending->pixels);
+            baker.begin(hdrTexture, settings);
+        }
+        bakeSteps = baker.stepCount();
+    }
+
+    // the atmosphere re-bakes whenever the sun moves: its sky has no detail 512 texel faces show that 256
+    // do not (the skybox draws it from its own LUTs), and a quarter of the texels get through the per-frame
+    // budget that much sooner
+    IBLBakeSettings proceduralSettings(const ProceduralSky &sky) const
+    {
+        IBLBakeSettings s = settings;
+        if (sky.atmosphere)
+        {
+            s.envSize = std::min(s.envSize, 256u);
+            s.prefilterSize = std::min(s.prefilterSize, 64u);
+        }
+        return s;
+    }
+
+    // RGB halves straight into an RGB16F equirectangular texture (envCubemap is RGB16F too); without
+    // `pixels` only the storage, for the strips
+    void createEquirect(const uint16_t *pixels)
+    {
+        glGenTextures(1, &hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, pending->width, pending->height, 0, GL_RGB, GL_HALF_FLOAT, pixels);
+        gpuMemory().trackTexture(hdrTexture, GpuMemory::ENVIRONMENT, GL_RGB16F, pending->width, pending->height, 1, false, "ibl equirect");
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    // keeps STRIPS_IN_FLIGHT strips decoding ahead of the uploads
+    void submitStrips()
+    {
+#if defined(HAS_TINYEXR)
+        const std::shared_ptr<const StripSource> src = pending->stream;
+        while (strips.size() < STRIPS_IN_FLIGHT && stripsSubmitted < src->strips())
+        {
+            const unsigned int index = stripsSubmitted++;
+            strips.push_back(pool.submit([src, index]() { return decodeStrip(src, index); }));
+        }
+#endif
+    }
+
+    // the next strip into its rows of the equirect texture through the pixel buffer, then its SH; after the
+    // last one the bake begins
+    void uploadStrip()
+    {
+        std::shared_ptr<Strip> strip = strips.front().get();
+        strips.pop_front();
+        if (!strip->error.empty())
+        {
+            LOG_WARN("[Environment] Can't load '" << pending->path << "': " << strip->error);
+            dropStrips();
+            if (hdrTexture)
+            {
+                gpuMemory().releaseTexture(hdrTexture);
+                glDeleteTextures(1, &hdrTexture);
+            }
+            hdrTexture = 0;
+            pending.reset();
+            startQueued();
+            return;
+        }
+        submitStrips();
+
+        const GLsizeiptr bytes = (GLsizeiptr)(strip->pixels.size() * sizeof(uint16_t));
+        if (!stripBuffer)
+            glGenBuffers(1, &stripBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stripBuffer);
+        // fresh storage each strip, so the copy doesn't wait for the previous strip's transfer
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+        void *target = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (target)
+        {
+            std::memcpy(target, &strip->pixels[0], (size_t)bytes);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        else
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, strip->y, pending->width, strip->rows, GL_RGB, GL_HALF_FLOAT,
+                        target ? NULL : &strip->pixels[0]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        pending->irradianceSH.merge(strip->irradianceSH);
+        if (!strips.empty() || stripsSubmitted < stripSteps())
+            return;
+
+        pending->irradianceSH.finish();
+        dropStrips();
+        LOG_INFO("[Environment] Streamed '" << pending->path << "' in " << elapsedMs(pending->requested) << " ms since the request");
+        baker.begin(hdrTexture, settings);
+        bakeSteps = baker.stepCount();
+    }
+
+    // waits for strips still decoding (an abandoned or finished stream) and frees the pixel buffer
+    void dropStrips()
+    {
+        for (size_t i = 0; i < strips.size(); ++i)
+            strips[i].wait();
+        strips.clear();
+        if (stripBuffer)
+            glDeleteBuffers(1, &stripBuffer);
+        stripBuffer = 0;
+    }
+
+    // last baker step ran: take its maps and drop the equirect source
+    void finishBake()
+    {
+        next = baker.finish();
+        next.irradianceSH = pending->irradianceSH;
+        if (hdrTexture)
+        {
+            gpuMemory().releaseTexture(hdrTexture);
+            glDeleteTextures(1, &hdrTexture);
+        }
+        hdrTexture = 0;
+    }
+
+    void saveCache()
+    {
+#if defined(HAS_TINYEXR)
+        const char *exportEnv = std::getenv("IBL_EXPORT_EXR");
+        if (exportEnv && std::string(exportEnv) == "1")
+            IBLCache::exportExr(pending->path, IBLBaker::cacheEntries(next, settings));
+#endif
+        if (envDisabled("IBL_CACHE"))
+            return;
+        const std::string path = IBLCache::cachePath(pending->path);
+        if (IBLCache::save(path, pending->sourceHash, pending->paramsHash, next.irradianceSH, IBLBaker::cacheEntries(next, settings)))
+            LOG_INFO("[IBL] Cached baked maps in '" << path << "'");
+        else
+            LOG_WARN("[IBL] Could not write '" << path << "'");
+    }
+
+    static void releaseMaps(Maps &m)
+    {
+        IBLBaker::releaseMaps(m);
+    }
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Linear allocator for the render loop's scratch data: allocate() bumps a cursor through one block and
+// reset() at the start of each frame rewinds it, so containers that only live for a frame (cull results,
+// pick results, transform uploads) cost no heap call once the arena has grown to the frame's high-water
+// mark. A frame that outgrows the block chains another one; the next reset() replaces the chain with a
+// single block of their combined size, so a steady scene settles on one block and zero allocations.
+// Nothing allocated from the arena may outlive the frame. GL thread only.
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialBytes = 64 << 10) : nextBlockBytes(initialBytes) {}
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    ~FrameArena()
+    {
+        for (size_t i = 0; i < blocks.size(); ++i)
+            std::free(blocks[i].data);
+    }
+
+    // start of the frame: everything allocated before is gone
+    void reset()
+    {
+        if (blocks.size() > 1)
+        {
+            size_t total = 0;
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                total += blocks[i].size;
+                std::free(blocks[i].data);
+            }
+            blocks.clear();
+            addBlock(total);
+        }
+        current = 0;
+        cursor = 0;
+        last = nullptr;
+    }
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        if (!blocks.empty())
+        {
+            Block &block = blocks[current];
+            const size_t offset = (cursor + alignment - 1) / alignment * alignment;
+            if (offset + bytes <= block.size)
+            {
+                last = block.data + offset;
+                cursor = offset + bytes;
+                return last;
+            }
+        }
+        // alignment never exceeds max_align_t's for the types drawn from here, which malloc already honours
+        addBlock(std::max(bytes, nextBlockBytes));
+        current = blocks.size() - 1;
+        last = blocks[current].data;
+        cursor = bytes;
+        return last;
+    }
+
+    // only the most recent allocation gives its space back (a vector growing in place of its old buffer)
+    void deallocate(void *p)
+    {
+        if (p && p == last)
+        {
+            cursor = (size_t)((unsigned char *)p - blocks[current].data);
+            last = nullptr;
+        }
+    }
+
+    // bytes handed out this frame in the current block, and the bytes the arena holds
+    size_t used() const { return cursor; }
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < blocks.size(); ++i)
+            total += blocks[i].size;
+        return total;
+    }
+
+private:
+    struct Block
+    {
+        unsigned char *data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0;
+    size_t cursor = 0;
+    void *last = nullptr;
+    size_t nextBlockBytes;
+
+    void addBlock(size_t bytes)
+    {
+        Block block = {(unsigned char *)std::malloc(bytes), bytes};
+        if (!block.data)
+            throw std::bad_alloc();
+        blocks.push_back(block);
+        nextBlockBytes = std::max(nextBlockBytes, 2 * bytes);
+    }
+};
+
+// GL thread only; reset at the top of every frame
+inline FrameArena &frameArena()
+{
+    static FrameArena arena;
+    return arena;
+}
+
+// STL allocator over frameArena(), for containers local to one frame
+template <class T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameAllocator() : arena(&frameArena()) {}
+    explicit FrameAllocator(FrameArena &arena) : arena(&arena) {}
+    template <class U>
+    FrameAllocator(const FrameAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *p, size_t) { arena->deallocate(p); }
+
+    template <class U>
+    bool operator==(const FrameAllocator<U> &other) const { return arena == other.arena; }
+    template <class U>
+    bool operator!=(const FrameAllocator<U> &other) const { return arena != other.arena; }
+
+private:
+    template <class U>
+    friend class FrameAllocator;
+    FrameArena *arena;
+};
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T> >;
+
+#endif
@@ -0,0 +1,329 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <image_writer.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Window captures without stalling the render loop. capture() only queues a glReadPixels into one of RING
+// pixel pack buffers and fences it; poll(), once per frame, maps the buffers whose fence has passed
+// (normally a frame or two later), copies the pixels out and hands them to the encoder threads, which write
+// them with ImageWriter (PNG, QOI or EXR, see CAPTURE_FORMAT). GL rows are bottom-up: the writers emit
+// them top down as they go, so the flip costs no extra pass or buffer. The pixel buffers are recycled; at
+// most MAX_QUEUED frames wait for the encoders, after which capture() waits for them rather than dropping
+// frames (a recording stays continuous, at the encoders' pace). EXR captures given the HDR scene texture
+// read that instead (GL_RGBA16F as half floats, at its size), so the file holds the linear radiance rather
+// than the tone-mapped window.
+// A capture given a Sink instead of a path takes the same way, and the encoder thread hands the pixels to
+// the sink (FrameStreamer compresses and sends them).
+class FrameCapture
+{
+public:
+    static const int RING = 3;
+    static const size_t MAX_QUEUED = 8;
+
+    // `encoders` threads write the images (a PNG is deflated in strips on ThreadPool::shared() on top)
+    explicit FrameCapture(unsigned int encoders = 2)
+    {
+        for (unsigned int i = 0; i < (encoders ? encoders : 1); ++i)
+            threads.push_back(std::thread(&FrameCapture::encodeLoop, this));
+    }
+
+    FrameCapture(const FrameCapture &) = delete;
+    FrameCapture &operator=(const FrameCapture &) = delete;
+
+    ~FrameCapture()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+    }
+
+    // GL thread, with the finished frame in the bound framebuffer (before the swap): starts reading its
+    // `width` x `height` pixels, to be written to `path` (with the output format's extension in place of
+    // .png); returns the file name it will have. With EXR output and an `hdrTexture` (the linear scene,
+    // `hdrWidth` x `hdrHeight` RGBA16F) that is read instead of the window.
+    std::string capture(int width, int height, const std::string &path, GLuint hdrTexture = 0, int hdrWidth = 0, int hdrHeight = 0)
+    {
+        const bool hdr = writer.outputFormat() == ImageWriter::EXR && hdrTexture && hdrWidth > 0 && hdrHeight > 0;
+        if (hdr)
+        {
+            width = hdrWidth;
+            height = hdrHeight;
+        }
+        if (width <= 0 || height <= 0)
+            return std::string();
+        Slot &slot = startRead((size_t)width * height * (hdr ? 8 : 4));
+        if (hdr)
+        {
+            glBindTexture(GL_TEXTURE_2D, hdrTexture);
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_HALF_FLOAT, 0);
+            // the bind went around the state cache
+            glState().invalidate();
+        }
+        else
+            glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        finishRead(slot, width, height, hdr);
+        slot.path = writer.pathFor(path);
+        return slot.path;
+    }
+
+    // gets a frame read by capture(width, height, sink) on an encoder thread: bottom-up RGBA8 rows
+    typedef std::function<void(const unsigned char *pixels, int width, int height)> Sink;
+
+    // GL thread: like capture() above, but the `width` x `height` pixels of the bound read framebuffer go to
+    // `sink` rather than to a file (FrameStreamer), and don't count as written
+    void capture(int width, int height, const Sink &sink)
+    {
+        if (width <= 0 || height <= 0 || !sink)
+            return;
+        Slot &slot = startRead((size_t)width * height * 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        finishRead(slot, width, height, false);
+        slot.sink = sink;
+    }
+
+    // reads the GPU hasn't finished (poll() passes them on)
+    int pending() const
+    {
+        int count = 0;
+        for (int i = 0; i < RING; ++i)
+            count += slots[i].fence ? 1 : 0;
+        return count;
+    }
+
+    // GL thread, once per frame: passes every read the GPU has finished to the encoders
+    void poll()
+    {
+        for (int i = 0; i < RING; ++i)
+            if (slots[i].fence)
+                collect(slots[i], false);
+    }
+
+    // GL thread: returns once everything captured so far is on disk
+    void finish()
+    {
+        for (int k = 0; k < RING; ++k)
+        {
+            Slot &slot = slots[(next + k) % RING]; // oldest first
+            if (slot.fence)
+                collect(slot, true);
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return jobs.empty() && busy == 0; });
+    }
+
+    // images written so far, and how many failed
+    size_t written() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return writtenCount;
+    }
+    size_t failed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failedCount;
+    }
+
+    // GL thread, before the context goes away; finish() first to keep pending captures
+    void releaseGpu()
+    {
+        for (int i = 0; i < RING; ++i)
+        {
+            Slot &slot = slots[i];
+            if (slot.fence) glDeleteSync(slot.fence);
+            if (slot.pbo)
+            {
+                gpuMemory().releaseBuffer(slot.pbo);
+                glDeleteBuffers(1, &slot.pbo);
+            }
+            slot = Slot();
+        }
+    }
+
+private:
+    struct Slot
+    {
+        GLuint pbo = 0;
+        size_t bytes = 0;
+        GLsync fence = 0;
+        int width = 0, height = 0;
+        bool hdr = false;
+        std::string path;
+        Sink sink;
+    };
+
+    struct Job
+    {
+        std::vector<unsigned char> pixels; // bottom-up rows, as read (RGBA8, or RGBA half floats if hdr)
+        int width = 0, height = 0;
+        bool hdr = false;
+        std::string path;
+        Sink sink; // instead of the path
+    };
+
+    Slot slots[RING];
+    int next = 0;
+    const ImageWriter writer;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;  // a job was queued, or stopping
+    std::condition_variable idle;  // a job finished
+    std::deque<Job> jobs;
+    std::vector<std::vector<unsigned char> > freeBuffers; // pixel buffers of written jobs, reused
+    size_t busy = 0;
+    size_t writtenCount = 0, failedCount = 0;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    // the next slot of the ring, bound as the pixel pack buffer with room for `bytes`
+    Slot &startRead(size_t bytes)
+    {
+        Slot &slot = slots[next];
+        // the ring came round before the GPU finished this slot's last read
+        if (slot.fence)
+            collect(slot, true);
+        if (!slot.pbo)
+            glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        if (bytes != slot.bytes)
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+            gpuMemory().trackBuffer(slot.pbo, GpuMemory::DRAW_BUFFERS, bytes, "capture");
+            slot.bytes = bytes;
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        slot.sink = Sink();
+        return slot;
+    }
+
+    // fences the read just issued into `slot` and moves the ring on
+    void finishRead(Slot &slot, int width, int height, bool hdr)
+    {
+        // other reads must go to client memory again
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.width = width;
+        slot.height = height;
+        slot.hdr = hdr;
+        next = (next + 1) % RING;
+    }
+
+    // maps a finished read (waiting for it if `wait`) and queues its pixels
+    void collect(Slot &slot, bool wait)
+    {
+        const GLenum status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000ull : 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            if (!wait)
+                return;
+            // a second is long enough that the device is gone; give the slot up
+            LOG_WARN("[Capture] Read of " << slot.path << " timed out");
+        }
+        glDeleteSync(slot.fence);
+        slot.fence = 0;
+        if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED)
+            return;
+
+        Job job;
+        job.width = slot.width;
+        job.height = slot.height;
+        job.hdr = slot.hdr;
+        job.path = slot.path;
+        job.sink = slot.sink;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (jobs.size() >= MAX_QUEUED)
+            {
+                LOG_DEBUG("[Capture] Encoders behind, waiting");
+                idle.wait(lock, [this]() { return jobs.size() < MAX_QUEUED; });
+            }
+            if (!freeBuffers.empty())
+            {
+                job.pixels.swap(freeBuffers.back());
+                freeBuffers.pop_back();
+            }
+        }
+        job.pixels.resize(slot.bytes);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        if (const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.bytes, GL_MAP_READ_BIT))
+        {
+            std::memcpy(job.pixels.data(), mapped, slot.bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        else
+        {
+            LOG_WARN("[Capture] Can't map the pixels of " << slot.path);
+            job.pixels.clear();
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (job.pixels.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+
+    void encodeLoop()
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                ++busy;
+            }
+            if (job.sink)
+            {
+                job.sink(job.pixels.data(), job.width, job.height);
+                std::lock_guard<std::mutex> lock(mutex);
+                --busy;
+                freeBuffers.push_back(std::vector<unsigned char>());
+                freeBuffers.back().swap(job.pixels);
+                idle.notify_all();
+                continue;
+            }
+#if defined(HAS_TINYEXR)
+            const bool ok = job.hdr ? writer.writeHdr(job.path, (const uint16_t *)job.pixels.data(), job.width, job.height)
+                                    : writer.write(job.path, job.pixels.data(), job.width, job.height);
+#else
+            const bool ok = writer.write(job.path, job.pixels.data(), job.width, job.height);
+#endif
+            if (!ok)
+                LOG_WARN("[Capture] Failed to save " << job.path);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --busy;
+                ++(ok ? writtenCount : failedCount);
+                freeBuffers.push_back(std::vector<unsigned char>());
+                freeBuffers.back().swap(job.pixels);
+            }
+            idle.notify_all();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef FRAME_DATA_H
+#define FRAME_DATA_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <frame_ring_buffer.h>
+#include <spherical_harmonics.h>
+
+// std140 `FrameData` block of model_loading.vs/.fs and depth_prepass.vs: the camera and environment values
+// every scene program shares within one view. Written once per view (the main camera, each shadow cascade,
+// each probe face) into the frame ring and bound at BINDING, so a new shader or variant adds no per-frame
+// uniform uploads. The sampler units are fixed at link instead (Shader::samplerUnit).
+struct FrameData
+{
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec3 viewPos;
+    float prefilterMaxMip;     // maximum mip level of prefilteredMap
+    glm::vec3 sunDirection;    // towards the sun, world space
+    float iblSeed;             // stochastic IBL lookups (StillAccumulator): 0 off, else this sample's index
+    glm::vec4 irradianceSH[9]; // SHIrradiance::channel(r, g, b) as three mat3, columns padded to vec4
+    // motion vectors (TemporalAA): this frame's view-projection without the sub-pixel jitter, and last frame's
+    glm::mat4 unjitteredViewProjection;
+    glm::mat4 previousViewProjection;
+
+    // uniform buffer binding point of the block (see Shader::uniformBlockBinding)
+    static const GLuint BINDING = 2;
+
+    FrameData(const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &viewPos)
+        : projection(projection), view(view), viewPos(viewPos), prefilterMaxMip(0.0f), sunDirection(0.0f, 1.0f, 0.0f), iblSeed(0.0f),
+          unjitteredViewProjection(projection * view), previousViewProjection(projection * view)
+    {
+        for (int i = 0; i < 9; ++i)
+            irradianceSH[i] = glm::vec4(0.0f);
+    }
+
+    void setEnvironment(const SHIrradiance &irradiance, float maxMip, const glm::vec3 &sun)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            const glm::mat3 channel = irradiance.channel(c);
+            for (int k = 0; k < 3; ++k)
+                irradianceSH[c * 3 + k] = glm::vec4(channel[k], 0.0f);
+        }
+        prefilterMaxMip = maxMip;
+        sunDirection = sun;
+    }
+
+    // the main view while StillAccumulator refines the image: a new seed per accumulated frame
+    void setIblSeed(float seed) { iblSeed = seed; }
+
+    // views that write motion vectors: without it the previous view is this one (no camera motion)
+    void setMotion(const glm::mat4 &unjittered, const glm::mat4 &previous)
+    {
+        unjitteredViewProjection = unjittered;
+        previousViewProjection = previous;
+    }
+
+    // GL thread: writes the block into this frame's ring region and binds it for the draws that follow
+    void bind() const
+    {
+        frameRing().bindUniform(BINDING, *this);
+    }
+};
+static_assert(sizeof(FrameData) == 432, "FrameData must match the std140 FrameData block in model_loading.vs/.fs");
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <gpu_profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Frame pacing and input latency. Without it the driver decides how many frames the CPU may queue ahead of
+// the display, and each queued frame is one more frame between a mouse move and the pixels it turns.
+//   VSYNC=0 / 1 / adaptive   swap interval (adaptive tears a late frame instead of waiting a whole refresh,
+//                            where the driver has EXT_swap_control_tear; vsync otherwise). Unset: the driver's.
+//   MAX_FRAMES_IN_FLIGHT=N   (1-4) a fence after every swap; a frame starts only once the one N frames back
+//                            has finished on the GPU. 1 is the lowest latency, 2 keeps CPU and GPU overlapped.
+//   FPS_CAP=N                frames start at most N times a second: sleeps to just short of the deadline,
+//                            then yields until it (thread sleeps alone overshoot by up to a timer tick).
+// The main loop polls events right after waitForFrame(), just before the camera moves, so the frame renders
+// the newest input rather than input from before the previous swap. With the profiler on, every frame also
+// measures "input latency": from that poll until the GPU finished the frame (a GL_TIMESTAMP query after the
+// swap, mapped onto the CPU clock), plus half a refresh for scanout with vsync on, as an estimate of
+// input-to-photon time.
+class FramePacer
+{
+public:
+    static const int MAX_IN_FLIGHT = 4; // also the depth of the latency query ring
+
+    FramePacer()
+    {
+        if (const char *v = std::getenv("VSYNC"))
+        {
+            const std::string mode = v;
+            swapInterval = mode == "adaptive" ? -1 : mode == "0" ? 0 : 1;
+            swapIntervalSet = true;
+        }
+        if (const char *n = std::getenv("MAX_FRAMES_IN_FLIGHT"))
+            framesInFlight = std::min(MAX_IN_FLIGHT, std::max(0, std::atoi(n)));
+        if (const char *c = std::getenv("FPS_CAP"))
+        {
+            const double fps = std::atof(c);
+            if (fps > 0.0)
+                periodUs = 1e6 / fps;
+        }
+    }
+
+    FramePacer(const FramePacer &) = delete;
+    FramePacer &operator=(const FramePacer &) = delete;
+
+    // GL thread, with the context current: sets the swap interval; `unthrottled` runs (benchmark, batch)
+    // always swap immediately
+    void applySwapInterval(bool unthrottled)
+    {
+        if (unthrottled)
+        {
+            glfwSwapInterval(0);
+            vsync = false;
+            return;
+        }
+        if (!swapIntervalSet)
+        {
+            // the driver's choice; glfw's windows usually start synced
+            vsync = true;
+        }
+        else
+        {
+            if (swapInterval < 0 && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+            {
+                LOG_WARN("[Pacing] Adaptive vsync unsupported here, using vsync");
+                swapInterval = 1;
+            }
+            glfwSwapInterval(swapInterval);
+            vsync = swapInterval != 0;
+        }
+        if (const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor()))
+            refreshMs = mode->refreshRate > 0 ? 1000.0 / mode->refreshRate : 0.0;
+        if (swapIntervalSet || framesInFlight || periodUs > 0.0)
+            LOG_INFO("[Pacing] vsync " << (swapInterval < 0 ? "adaptive" : vsync ? "on" : "off") << ", "
+                                       << (framesInFlight ? std::to_string(framesInFlight) : std::string("driver")) << " frames in flight"
+                                       << (periodUs > 0.0 ? ", capped at " + std::to_string((int)(1e6 / periodUs + 0.5)) + " fps" : std::string()));
+    }
+
+    // GL thread, once per frame just before input is polled: blocks until the frame-in-flight limit and the
+    // frame-rate cap let the frame start
+    void waitForFrame(GpuProfiler &profiler)
+    {
+        GpuProfiler::Scope scope(profiler, "pacing", false);
+        if (framesInFlight)
+        {
+            GLsync &fence = fences[fenceSlot];
+            if (fence)
+            {
+                // a second is long enough that the device is gone; don't hang the loop on it
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+                glDeleteSync(fence);
+                fence = 0;
+            }
+        }
+        if (periodUs > 0.0)
+        {
+            const double now = FrameTrace::clockUs();
+            if (nextStartUs > now)
+            {
+                // sleep most of the way, then yield the last stretch the OS timer can't hit reliably
+                const double sleepUs = nextStartUs - now - SPIN_US;
+                if (sleepUs > 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds((long long)sleepUs));
+                while (FrameTrace::clockUs() < nextStartUs)
+                    std::this_thread::yield();
+            }
+            // a late frame starts a new cadence rather than rushing the next ones to make up for it
+            const double start = FrameTrace::clockUs();
+            nextStartUs = std::max(nextStartUs, start - periodUs) + periodUs;
+        }
+    }
+
+    // right after the frame's input was polled
+    void markInput() { inputUs = FrameTrace::clockUs(); }
+
+    // GL thread, right after the swap: fences the frame and, with the profiler on, times its completion
+    void afterSwap(GpuProfiler &profiler)
+    {
+        if (framesInFlight)
+        {
+            fences[fenceSlot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            fenceSlot = (fenceSlot + 1) % framesInFlight;
+        }
+        if (!profiler.enabled())
+            return;
+        Probe &probe = probes[probeSlot];
+        // the probe's last use, MAX_IN_FLIGHT frames back, is normally long done; if not it's dropped
+        if (probe.pending)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(probe.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available)
+            {
+                GLuint64 doneNs = 0;
+                glGetQueryObjectui64v(probe.query, GL_QUERY_RESULT, &doneNs);
+                double ms = (probe.cpuUs - probe.inputUs) * 1e-3 + ((GLint64)doneNs - probe.gpuNs) * 1e-6;
+                if (vsync)
+                    ms += 0.5 * refreshMs;
+                profiler.addMeasurement("input latency", ms);
+            }
+        }
+        if (!probe.query)
+            glGenQueries(1, &probe.query);
+        glQueryCounter(probe.query, GL_TIMESTAMP);
+        // the GPU clock now, next to the CPU clock now: maps the query's result onto the CPU timeline
+        glGetInteger64v(GL_TIMESTAMP, &probe.gpuNs);
+        probe.cpuUs = FrameTrace::clockUs();
+        probe.inputUs = inputUs;
+        probe.pending = true;
+        probeSlot = (probeSlot + 1) % MAX_IN_FLIGHT;
+    }
+
+    void releaseGpu()
+    {
+        for (int i = 0; i < MAX_IN_FLIGHT; ++i)
+        {
+            if (fences[i]) glDeleteSync(fences[i]);
+            fences[i] = 0;
+            if (probes[i].query) glDeleteQueries(1, &probes[i].query);
+            probes[i] = Probe();
+        }
+    }
+
+private:
+    static constexpr double SPIN_US = 1500.0;
+
+    struct Probe
+    {
+        GLuint query = 0;
+        bool pending = false;
+        GLint64 gpuNs = 0;            // GPU clock when the query was issued
+        double cpuUs = 0.0, inputUs = 0.0;      // trace clock at the query, and at the frame's input
+    };
+
+    int swapInterval = 1;
+    bool swapIntervalSet = false;
+    bool vsync = false;
+    double refreshMs = 0.0;
+    int framesInFlight = 0;
+    double periodUs = 0.0;  // 0 = no cap
+    double nextStartUs = 0.0;
+    double inputUs = 0.0;
+    GLsync fences[MAX_IN_FLIGHT] = {0, 0, 0, 0};
+    int fenceSlot = 0;
+    Probe probes[MAX_IN_FLIGHT];
+    int probeSlot = 0;
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef FRAME_RING_BUFFER_H
+#define FRAME_RING_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gpu_memory.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Ring of per-frame uniform data: one buffer split into FRAMES regions, the CPU writing the current frame's
+// region while the GPU may still read the two before it. write() memcpys a block into the region and returns
+// its range for glBindBufferRange, so per-draw data goes to the driver as one copy instead of a glUniform per
+// member and per program. A fence after each frame guards its region until the ring comes back to it.
+// On GL 4.4 the buffer is immutable storage mapped once, persistently and coherently; on GL 3.3 each write
+// maps its range unsynchronized (the fences already keep the GPU off it). A frame that runs out of space
+// waits for the GPU and starts over at the region's beginning; the next beginFrame() doubles the regions.
+class FrameRingBuffer
+{
+public:
+    static const int FRAMES = 3;
+
+    struct Range
+    {
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    explicit FrameRingBuffer(size_t frameBytes = 64 << 10) : regionBytes(frameBytes) {}
+
+    FrameRingBuffer(const FrameRingBuffer &) = delete;
+    FrameRingBuffer &operator=(const FrameRingBuffer &) = delete;
+
+    // GL thread, before the frame's first write: moves to the next region, waiting for the GPU to finish
+    // the frame that last used it
+    void beginFrame()
+    {
+        epochCount++;
+        if (overflowed)
+        {
+            LOG_INFO("[FrameRing] " << regionBytes / 1024 << " KB per frame was not enough, growing to " << regionBytes / 512 << " KB");
+            releaseGpu();
+            regionBytes *= 2;
+            overflowed = false;
+        }
+        if (!buffer)
+            return;
+        region = (region + 1) % FRAMES;
+        waitFor(region);
+        cursor = 0;
+    }
+
+    // GL thread, after the frame's last draw
+    void endFrame()
+    {
+        if (!buffer)
+            return;
+        if (fences[region])
+            glDeleteSync(fences[region]);
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    // GL thread: copies `size` bytes into the current frame's region; the range stays valid for this frame's draws
+    Range write(const void *data, size_t size)
+    {
+        if (!buffer)
+            create();
+        if (cursor + size > regionBytes)
+        {
+            if (!overflowed)
+                LOG_WARN("[FrameRing] frame data over " << regionBytes / 1024 << " KB, waiting for the GPU");
+            overflowed = true;
+            glFinish();
+            cursor = 0;
+            epochCount++;
+        }
+        const size_t offset = (size_t)region * regionBytes + cursor;
+        if (mapped)
+        {
+            std::memcpy(mapped + offset, data, size);
+        }
+        else
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            void *target = glMapBufferRange(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size,
+                                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+            if (target)
+            {
+                std::memcpy(target, data, size);
+                glUnmapBuffer(GL_UNIFORM_BUFFER);
+            }
+            else
+                glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        cursor += (size + alignment - 1) / alignment * alignment;
+        Range range = {buffer, (GLintptr)offset, (GLsizeiptr)size};
+        return range;
+    }
+
+    template <class T>
+    Range write(const T &block) { return write(&block, sizeof(T)); }
+
+    // write() + glBindBufferRange of the block at uniform buffer binding point `binding`
+    template <class T>
+    void bindUniform(GLuint binding, const T &block)
+    {
+        const Range range = write(block);
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, range.buffer, range.offset, range.size);
+    }
+
+    bool persistent() const { return mapped != nullptr; }
+
+    // changes whenever the ranges written before may no longer hold their data (every beginFrame(), and a
+    // full frame starting its region over); a block shared by several draws of a frame is written once
+    // per epoch and its range reused until then
+    uint64_t epoch() const { return epochCount; }
+
+    // call before the GL context goes away; the next write() creates the buffer again
+    void releaseGpu()
+    {
+        for (int f = 0; f < FRAMES; ++f)
+            waitFor(f);
+        if (buffer)
+        {
+            gpuMemory().releaseBuffer(buffer);
+            if (mapped)
+            {
+                glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+                glUnmapBuffer(GL_UNIFORM_BUFFER);
+                glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &buffer);
+        }
+        buffer = 0;
+        mapped = nullptr;
+        region = 0;
+        cursor = 0;
+    }
+
+private:
+    GLuint buffer = 0;
+    unsigned char *mapped = nullptr; // the persistent mapping of the whole buffer (GL 4.4)
+    GLsync fences[FRAMES] = {};
+    size_t regionBytes;
+    size_t alignment = 256;
+    int region = 0;
+    size_t cursor = 0;
+    bool overflowed = false;
+    uint64_t epochCount = 0;
+
+    void create()
+    {
+        GLint align = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+        alignment = (size_t)std::max(align, 16);
+        regionBytes = (regionBytes + alignment - 1) / alignment * alignment;
+        const GLsizeiptr total = (GLsizeiptr)(regionBytes * FRAMES);
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        if (GLAD_GL_VERSION_4_4)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_UNIFORM_BUFFER, total, NULL, flags);
+            mapped = (unsigned char *)glMapBufferRange(GL_UNIFORM_BUFFER, 0, total, flags);
+        }
+        if (!mapped)
+        {
+            if (GLAD_GL_VERSION_4_4)
+            {
+                // immutable storage can't be re-specified; start over with a mutable buffer
+                glDeleteBuffers(1, &buffer);
+                glGenBuffers(1, &buffer);
+                glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            }
+            glBufferData(GL_UNIFORM_BUFFER, total, NULL, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        gpuMemory().trackBuffer(buffer, GpuMemory::DRAW_BUFFERS, (size_t)total, "frame ring");
+        LOG_INFO("[FrameRing] " << FRAMES << " x " << regionBytes / 1024 << " KB, " << (mapped ? "persistently mapped" : "mapped per write"));
+    }
+
+    void waitFor(int f)
+    {
+        if (!fences[f])
+            return;
+        while (glClientWaitSync(fences[f], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+        glDeleteSync(fences[f]);
+        fences[f] = 0;
+    }
+};
+
+// GL thread only; shared by everything that binds per-frame uniform blocks
+inline FrameRingBuffer &frameRing()
+{
+    static FrameRingBuffer ring;
+    return ring;
+}
+
+#endif
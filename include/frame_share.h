@@ -0,0 +1,517 @@
+#ifndef FRAME_SHARE_H
+#define FRAME_SHARE_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <engine_clock.h>
+#include <frame_capture.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <d3d11.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+// FRAME_SHARE=<name>: hands every finished frame (the tone-mapped window, no HUD) to other processes on
+// this machine, for OBS, vMix and the like, without a screen capture.
+//
+// On Windows the frame goes to a shared D3D11 texture through WGL_NV_DX_interop2: the window is blitted
+// into the GL name of the texture (a GPU copy, nothing read back) and the texture is registered the way
+// Spout 2 senders are (the sender list in the "SpoutSenderNames" mapping and a SharedTextureInfo mapping
+// named <name> with the texture's share handle), so Spout receivers list it as <name>. Drivers without the
+// interop, other systems, and FRAME_SHARE_MODE=memory use the CPU path instead: the window is read through
+// FrameCapture's pixel buffer ring, so the render loop never waits for it, and the encoder thread copies
+// the pixels into a shared memory block named <name> (Local\<name> on Windows, /<name> under /dev/shm
+// elsewhere) laid out as a Header followed by RGBA8 rows, bottom row first. A new read starts only once the
+// last one is copied, so a slow reader gets fewer frames, never older ones. Frames are scaled to fit
+// MAX_WIDTH x MAX_HEIGHT (the memory block is sized for that once).
+class FrameShare
+{
+public:
+    static const int MAX_WIDTH = 3840, MAX_HEIGHT = 2160;
+
+    // the start of the memory block: `sequence` is odd while a frame is being written, so a reader copies
+    // the pixels between two equal even reads of it
+    struct Header
+    {
+        char magic[8]; // "CARSHM1"
+        uint32_t width, height;
+        uint32_t stride; // bytes per row
+        uint32_t reserved;
+        std::atomic<uint64_t> sequence;
+        double time; // EngineClock seconds when the frame was read
+    };
+
+    static bool enabledByEnv() { return std::getenv("FRAME_SHARE") != NULL; }
+
+    FrameShare() {}
+    FrameShare(const FrameShare &) = delete;
+    FrameShare &operator=(const FrameShare &) = delete;
+
+    ~FrameShare() { closeMemory(); }
+
+    // GL thread, with the context current: picks the path and sets it up; false (and no sharing) if neither works
+    bool init()
+    {
+        const char *env = std::getenv("FRAME_SHARE");
+        name = env && *env ? env : "CarViewer";
+        const char *mode = std::getenv("FRAME_SHARE_MODE");
+        const bool memoryOnly = mode && std::strcmp(mode, "memory") == 0;
+#ifdef _WIN32
+        if (!memoryOnly && openInterop())
+        {
+            LOG_INFO("[FrameShare] Sharing frames as Spout sender '" << name << "' (D3D11 texture via WGL_NV_DX_interop2)");
+            return ready = true;
+        }
+#endif
+        if (!openMemory())
+            return false;
+        reader.reset(new FrameCapture(1));
+        LOG_INFO("[FrameShare] Sharing frames in shared memory '" << name << "' (" << (memoryOnly ? "FRAME_SHARE_MODE=memory" : "no GPU sharing")
+                 << ", up to " << MAX_WIDTH << "x" << MAX_HEIGHT << " RGBA8)");
+        return ready = true;
+    }
+
+    bool enabled() const { return ready; }
+
+    // GL thread, with the finished frame in the back buffer (before the swap): hands it over
+    void publish(int windowWidth, int windowHeight)
+    {
+        if (!ready || windowWidth <= 0 || windowHeight <= 0)
+            return;
+        // a read that never came back (a lost device) doesn't stop the sharing for good
+        const double now = EngineClock::seconds();
+        if (reader && copying.load() && now - readStarted < 1.0)
+            return;
+        const float fit = std::min(1.0f, std::min((float)MAX_WIDTH / windowWidth, (float)MAX_HEIGHT / windowHeight));
+        const int width = std::max(1, (int)(windowWidth * fit));
+        const int height = std::max(1, (int)(windowHeight * fit));
+#ifdef _WIN32
+        if (device)
+        {
+            publishInterop(windowWidth, windowHeight, width, height);
+            return;
+        }
+#endif
+        if (!createTarget(width, height))
+            return;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBlitFramebuffer(0, 0, windowWidth, windowHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        copying = true;
+        readStarted = now;
+        reader->capture(width, height, [this, now](const unsigned char *pixels, int w, int h) { copyOut(pixels, w, h, now); });
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // GL thread, once per frame: passes finished reads to the copy thread
+    void poll()
+    {
+        if (reader)
+            reader->poll();
+    }
+
+    // GL thread, before the context goes away
+    void releaseGpu()
+    {
+        if (reader)
+        {
+            reader->finish();
+            reader->releaseGpu();
+            reader.reset();
+        }
+#ifdef _WIN32
+        closeInterop();
+#endif
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+        fbo = colorBuffer = 0;
+        targetWidth = targetHeight = 0;
+        ready = false;
+    }
+
+private:
+    std::string name;
+    bool ready = false;
+    // the scaled copy of the window that's read (memory path)
+    GLuint fbo = 0, colorBuffer = 0;
+    int targetWidth = 0, targetHeight = 0;
+    std::unique_ptr<FrameCapture> reader;
+    std::atomic<bool> copying{false};
+    double readStarted = 0.0;
+    // the shared memory block
+    Header *header = nullptr;
+    size_t mappedSize = 0;
+#ifdef _WIN32
+    HANDLE mapping = NULL;
+#endif
+
+    bool createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return true;
+        if (!fbo)
+            glGenFramebuffers(1, &fbo);
+        if (!colorBuffer)
+            glGenRenderbuffers(1, &colorBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete)
+        {
+            LOG_WARN("[FrameShare] Copy target incomplete, not sharing");
+            ready = false;
+            return false;
+        }
+        targetWidth = width;
+        targetHeight = height;
+        return true;
+    }
+
+    bool openMemory()
+    {
+        mappedSize = sizeof(Header) + (size_t)MAX_WIDTH * MAX_HEIGHT * 4;
+        void *view = nullptr;
+#ifdef _WIN32
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)mappedSize >> 32),
+                                     (DWORD)(mappedSize & 0xffffffffu), ("Local\\" + name).c_str());
+        if (mapping)
+            view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, mappedSize);
+#else
+        const std::string shmName = "/" + name;
+        const int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd >= 0)
+        {
+            if (ftruncate(fd, (off_t)mappedSize) == 0)
+            {
+                view = mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (view == MAP_FAILED)
+                    view = nullptr;
+            }
+            ::close(fd);
+        }
+#endif
+        if (!view)
+        {
+            LOG_WARN("[FrameShare] Can't create shared memory '" << name << "', not sharing");
+            closeMemory();
+            return false;
+        }
+        header = new (view) Header();
+        std::memcpy(header->magic, "CARSHM1", 8);
+        header->width = header->height = header->stride = header->reserved = 0;
+        header->sequence.store(0);
+        header->time = 0.0;
+        return true;
+    }
+
+    void closeMemory()
+    {
+#ifdef _WIN32
+        if (header)
+            UnmapViewOfFile(header);
+        if (mapping)
+            CloseHandle(mapping);
+        mapping = NULL;
+#else
+        if (header)
+        {
+            munmap(header, mappedSize);
+            shm_unlink(("/" + name).c_str());
+        }
+#endif
+        header = nullptr;
+    }
+
+    // copy thread: one frame into the block, between the two sequence bumps
+    void copyOut(const unsigned char *pixels, int width, int height, double time)
+    {
+        if (pixels && header)
+        {
+            const uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+            header->sequence.store(sequence + 1, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+            header->width = (uint32_t)width;
+            header->height = (uint32_t)height;
+            header->stride = (uint32_t)width * 4;
+            header->time = time;
+            std::memcpy((unsigned char *)header + sizeof(Header), pixels, (size_t)width * height * 4);
+            header->sequence.store(sequence + 2, std::memory_order_release);
+        }
+        copying = false;
+    }
+
+#ifdef _WIN32
+    // WGL_NV_DX_interop2, loaded through wglGetProcAddress
+    typedef HANDLE(WINAPI *OpenDeviceProc)(void *dxDevice);
+    typedef BOOL(WINAPI *CloseDeviceProc)(HANDLE device);
+    typedef HANDLE(WINAPI *RegisterObjectProc)(HANDLE device, void *dxObject, GLuint name, GLenum type, GLenum access);
+    typedef BOOL(WINAPI *UnregisterObjectProc)(HANDLE device, HANDLE object);
+    typedef BOOL(WINAPI *LockObjectsProc)(HANDLE device, GLint count, HANDLE *objects);
+    static const GLenum WGL_ACCESS_WRITE_DISCARD = 0x0002;
+
+    // Spout 2's per-sender record, in the mapping named after the sender
+    struct SharedTextureInfo
+    {
+        uint32_t shareHandle;
+        uint32_t width, height;
+        DWORD format; // DXGI_FORMAT
+        DWORD usage;
+        wchar_t description[128];
+        uint32_t partnerId;
+    };
+    static const int SPOUT_MAX_SENDERS = 10;
+    static const int SPOUT_NAME_LENGTH = 256;
+
+    OpenDeviceProc openDevice = nullptr;
+    CloseDeviceProc closeDevice = nullptr;
+    RegisterObjectProc registerObject = nullptr;
+    UnregisterObjectProc unregisterObject = nullptr;
+    LockObjectsProc lockObjects = nullptr, unlockObjects = nullptr;
+    HMODULE d3dLibrary = NULL;
+    ID3D11Device *d3dDevice = nullptr;
+    ID3D11DeviceContext *d3dContext = nullptr;
+    ID3D11Texture2D *sharedTexture = nullptr;
+    HANDLE device = NULL;        // the interop's
+    HANDLE sharedObject = NULL;  // the texture registered with it
+    HANDLE shareHandle = NULL;   // what receivers open
+    GLuint sharedName = 0;
+    HANDLE infoMapping = NULL;
+    SharedTextureInfo *info = nullptr;
+
+    bool openInterop()
+    {
+        openDevice = (OpenDeviceProc)wglGetProcAddress("wglDXOpenDeviceNV");
+        closeDevice = (CloseDeviceProc)wglGetProcAddress("wglDXCloseDeviceNV");
+        registerObject = (RegisterObjectProc)wglGetProcAddress("wglDXRegisterObjectNV");
+        unregisterObject = (UnregisterObjectProc)wglGetProcAddress("wglDXUnregisterObjectNV");
+        lockObjects = (LockObjectsProc)wglGetProcAddress("wglDXLockObjectsNV");
+        unlockObjects = (LockObjectsProc)wglGetProcAddress("wglDXUnlockObjectsNV");
+        if (!openDevice || !closeDevice || !registerObject || !unregisterObject || !lockObjects || !unlockObjects)
+            return false;
+        d3dLibrary = LoadLibraryA("d3d11.dll");
+        PFN_D3D11_CREATE_DEVICE create = d3dLibrary ? (PFN_D3D11_CREATE_DEVICE)GetProcAddress(d3dLibrary, "D3D11CreateDevice") : nullptr;
+        if (!create || FAILED(create(NULL, D3D_DRIVER_TYPE_HARDWARE, NULL, D3D11_CREATE_DEVICE_BGRA_SUPPORT, NULL, 0, D3D11_SDK_VERSION,
+                                     &d3dDevice, NULL, &d3dContext)))
+        {
+            closeInterop();
+            return false;
+        }
+        device = openDevice(d3dDevice);
+        if (!device)
+        {
+            LOG_WARN("[FrameShare] WGL_NV_DX_interop2 can't open the D3D11 device");
+            closeInterop();
+            return false;
+        }
+        glGenFramebuffers(1, &fbo);
+        return true;
+    }
+
+    // (re)creates the shared texture at `width` x `height` and tells the receivers
+    bool createShared(int width, int height)
+    {
+        releaseShared();
+        D3D11_TEXTURE2D_DESC desc;
+        std::memset(&desc, 0, sizeof(desc));
+        desc.Width = (UINT)width;
+        desc.Height = (UINT)height;
+        desc.MipLevels = 1;
+        desc.ArraySize = 1;
+        desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+        desc.SampleDesc.Count = 1;
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+        desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+        IDXGIResource *resource = nullptr;
+        if (FAILED(d3dDevice->CreateTexture2D(&desc, NULL, &sharedTexture)) ||
+            FAILED(sharedTexture->QueryInterface(__uuidof(IDXGIResource), (void **)&resource)) || FAILED(resource->GetSharedHandle(&shareHandle)))
+        {
+            if (resource)
+                resource->Release();
+            LOG_WARN("[FrameShare] Can't create a shared " << width << "x" << height << " texture");
+            releaseShared();
+            return false;
+        }
+        resource->Release();
+        glGenTextures(1, &sharedName);
+        sharedObject = registerObject(device, sharedTexture, sharedName, GL_TEXTURE_2D, WGL_ACCESS_WRITE_DISCARD);
+        if (!sharedObject)
+        {
+            LOG_WARN("[FrameShare] WGL_NV_DX_interop2 can't register the shared texture");
+            releaseShared();
+            return false;
+        }
+        targetWidth = width;
+        targetHeight = height;
+        return announce(width, height);
+    }
+
+    void releaseShared()
+    {
+        if (sharedObject)
+            unregisterObject(device, sharedObject);
+        if (sharedName)
+            glDeleteTextures(1, &sharedName);
+        if (sharedTexture)
+            sharedTexture->Release();
+        sharedObject = NULL;
+        sharedName = 0;
+        sharedTexture = nullptr;
+        shareHandle = NULL;
+        targetWidth = targetHeight = 0;
+    }
+
+    // the copy: the window flipped into the texture (D3D rows run top down), inside the interop lock
+    void publishInterop(int windowWidth, int windowHeight, int width, int height)
+    {
+        if ((width != targetWidth || height != targetHeight) && !createShared(width, height))
+        {
+            LOG_WARN("[FrameShare] Falling back to shared memory");
+            closeInterop();
+            if (!openMemory())
+            {
+                ready = false;
+                return;
+            }
+            reader.reset(new FrameCapture(1));
+            return;
+        }
+        if (!lockObjects(device, 1, &sharedObject))
+            return;
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sharedName, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, windowWidth, windowHeight, 0, height, width, 0, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        unlockObjects(device, 1, &sharedObject);
+    }
+
+    // runs `write` on the mapping `mapName` (created at `size` if new) under Spout's "<mapName>_mutex"
+    template <class Write>
+    static bool withSpoutMapping(const std::string &mapName, size_t size, HANDLE *keep, Write write)
+    {
+        HANDLE mutex = CreateMutexA(NULL, FALSE, (mapName + "_mutex").c_str());
+        if (mutex)
+            WaitForSingleObject(mutex, 100);
+        HANDLE map = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, mapName.c_str());
+        void *view = map ? MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+        if (view)
+            write((char *)view);
+        if (view)
+            UnmapViewOfFile(view);
+        // the sender's own record lives as long as the sender; the shared list outlives it in other processes
+        if (keep && map)
+            *keep = map;
+        else if (map)
+            CloseHandle(map);
+        if (mutex)
+        {
+            ReleaseMutex(mutex);
+            CloseHandle(mutex);
+        }
+        return view != nullptr;
+    }
+
+    // publishes the texture's handle and size in the sender's record, and the sender in Spout's list
+    bool announce(int width, int height)
+    {
+        if (!infoMapping)
+        {
+            const std::string own = name;
+            bool listed = false;
+            withSpoutMapping("SpoutSenderNames", SPOUT_MAX_SENDERS * SPOUT_NAME_LENGTH, nullptr, [&own, &listed](char *names) {
+                int slot = 0;
+                for (; slot < SPOUT_MAX_SENDERS && names[slot * SPOUT_NAME_LENGTH]; ++slot)
+                    if (own == names + slot * SPOUT_NAME_LENGTH)
+                        break;
+                if (slot == SPOUT_MAX_SENDERS)
+                    return;
+                std::strncpy(names + slot * SPOUT_NAME_LENGTH, own.c_str(), SPOUT_NAME_LENGTH - 1);
+                listed = true;
+            });
+            if (!listed)
+                LOG_WARN("[FrameShare] Spout's sender list is full, '" << name << "' may not be found by receivers");
+            withSpoutMapping("ActiveSenderName", SPOUT_NAME_LENGTH, nullptr,
+                             [&own](char *active) { std::strncpy(active, own.c_str(), SPOUT_NAME_LENGTH - 1); });
+        }
+        SharedTextureInfo record;
+        std::memset(&record, 0, sizeof(record));
+        record.shareHandle = (uint32_t)(uintptr_t)shareHandle;
+        record.width = (uint32_t)width;
+        record.height = (uint32_t)height;
+        record.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+        if (!withSpoutMapping(name, sizeof(SharedTextureInfo), infoMapping ? nullptr : &infoMapping,
+                              [&record](char *view) { std::memcpy(view, &record, sizeof(record)); }))
+        {
+            LOG_WARN("[FrameShare] Can't publish sender '" << name << "'");
+            return false;
+        }
+        LOG_INFO("[FrameShare] Sender '" << name << "' is " << width << "x" << height);
+        return true;
+    }
+
+    // takes the sender off Spout's list and drops the D3D11 side
+    void closeInterop()
+    {
+        releaseShared();
+        if (infoMapping)
+        {
+            const std::string own = name;
+            withSpoutMapping("SpoutSenderNames", SPOUT_MAX_SENDERS * SPOUT_NAME_LENGTH, nullptr, [&own](char *names) {
+                int slot = 0;
+                while (slot < SPOUT_MAX_SENDERS && names[slot * SPOUT_NAME_LENGTH] && own != names + slot * SPOUT_NAME_LENGTH)
+                    ++slot;
+                if (slot == SPOUT_MAX_SENDERS || !names[slot * SPOUT_NAME_LENGTH])
+                    return;
+                std::memmove(names + slot * SPOUT_NAME_LENGTH, names + (slot + 1) * SPOUT_NAME_LENGTH,
+                             (SPOUT_MAX_SENDERS - slot - 1) * SPOUT_NAME_LENGTH);
+                std::memset(names + (SPOUT_MAX_SENDERS - 1) * SPOUT_NAME_LENGTH, 0, SPOUT_NAME_LENGTH);
+            });
+            CloseHandle(infoMapping);
+            infoMapping = NULL;
+        }
+        if (device)
+            closeDevice(device);
+        device = NULL;
+        if (d3dContext)
+            d3dContext->Release();
+        if (d3dDevice)
+            d3dDevice->Release();
+        d3dContext = nullptr;
+        d3dDevice = nullptr;
+        if (d3dLibrary)
+            FreeLibrary(d3dLibrary);
+        d3dLibrary = NULL;
+        if (fbo)
+            glDeleteFramebuffers(1, &fbo);
+        fbo = 0;
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,785 @@
+#ifndef FRAME_STREAMER_H
+#define FRAME_STREAMER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+#include <engine_clock.h>
+#include <frame_capture.h>
+#include <gl_state.h>
+
+#include "stb_image_write.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// STREAM_PORT=<port>: serves the renderer to browsers. http://<host>:<port>/ returns a small viewer page
+// that opens a WebSocket on the same port; every connected session gets the window's frames as JPEG
+// (binary messages) and sends its keys, pointer motion, wheel and clicks back (text messages), which
+// processInput and the mouse callbacks take exactly like the local ones (RemoteInput). Per frame the window
+// is scaled into an RGBA8 target (STREAM_SCALE, default 0.5 of the window) and read through FrameCapture's
+// pixel buffer ring, so the render loop never waits for the read; its encoder thread compresses the frame
+// (STREAM_QUALITY, default 75) and the network thread sends it. A session only ever has the newest frame
+// queued: a slow link skips frames instead of falling behind, and a new read starts only once the last one
+// is encoded, which bounds the latency to about two frames plus the encode. All sessions share one render
+// (they see and steer the same view) unless STREAM_SESSIONS=1 gives each its own (SessionViews renders
+// those and hands their frames to sendFrame(); the window's frame isn't streamed then). STREAM_MAX_CLIENTS
+// (default 4) caps the sessions.
+class FrameStreamer
+{
+public:
+    // input from the sessions since the last takeInput(): GLFW key codes held, pointer motion in pixels (y
+    // up, as mouse_callback computes it), wheel steps and clicks
+    struct RemoteInput
+    {
+        std::set<int> keys;
+        float mouseX = 0.0f, mouseY = 0.0f;
+        float wheel = 0.0f;
+        bool pick = false;
+
+        bool held(int key) const { return keys.count(key) != 0; }
+    };
+
+    // STREAM_SESSIONS=1: one open session and its input since the last takeSessionInput()
+    struct SessionInput
+    {
+        int id;
+        RemoteInput input;
+    };
+
+    static bool enabledByEnv() { return std::getenv("STREAM_PORT") != NULL; }
+
+    FrameStreamer() {}
+    FrameStreamer(const FrameStreamer &) = delete;
+    FrameStreamer &operator=(const FrameStreamer &) = delete;
+
+    ~FrameStreamer() { stop(); }
+
+    // opens the port and starts the network thread; false (and no streaming) if the port can't be had
+    bool start()
+    {
+        const char *env = std::getenv("STREAM_PORT");
+        const int port = env ? std::atoi(env) : 0;
+        if (const char *s = std::getenv("STREAM_SCALE"))
+            scale = std::max(0.1f, std::min(1.0f, (float)std::atof(s)));
+        if (const char *q = std::getenv("STREAM_QUALITY"))
+            quality = std::max(10, std::min(100, std::atoi(q)));
+        if (const char *c = std::getenv("STREAM_MAX_CLIENTS"))
+            maxClients = std::max(1, std::atoi(c));
+        const char *own = std::getenv("STREAM_SESSIONS");
+        ownViews = own && std::strcmp(own, "1") == 0;
+#ifdef _WIN32
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+        {
+            LOG_WARN("[Stream] Winsock unavailable, not streaming");
+            return false;
+        }
+#endif
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listener == INVALID)
+        {
+            LOG_WARN("[Stream] No socket, not streaming");
+            return false;
+        }
+        int yes = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char *)&yes, sizeof(yes));
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons((unsigned short)port);
+        if (port <= 0 || port > 65535 || bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || listen(listener, 8) != 0)
+        {
+            LOG_WARN("[Stream] Can't listen on port " << port << ", not streaming");
+            closeSocket(listener);
+            listener = INVALID;
+            return false;
+        }
+        reader.reset(new FrameCapture(1));
+        running = true;
+        network = std::thread(&FrameStreamer::networkLoop, this);
+        LOG_INFO("[Stream] Serving http://localhost:" << port << "/ (" << (int)(scale * 100.0f) << "% of the window, JPEG quality " << quality
+                 << ", up to " << maxClients << (ownViews ? " sessions with views of their own)" : " sessions)"));
+        return true;
+    }
+
+    bool enabled() const { return running; }
+    // STREAM_SESSIONS=1: every session steers a view of its own
+    bool sessionViews() const { return running && ownViews; }
+    float frameScale() const { return scale; }
+
+    // GL thread, with the finished frame in the back buffer (before the swap): starts reading it for the
+    // sessions, unless nobody watches or the last frame is still on its way
+    void capture(int windowWidth, int windowHeight)
+    {
+        if (!running || ownViews || !copyUsable || sessionCount.load() == 0 || windowWidth <= 0 || windowHeight <= 0)
+            return;
+        // a read that never came back (a lost device) doesn't stop the stream for good
+        const double now = EngineClock::seconds();
+        if (encoding.load() && now - readStarted < 1.0)
+            return;
+        const int width = std::max(1, (int)(windowWidth * scale)) & ~1;
+        const int height = std::max(1, (int)(windowHeight * scale)) & ~1;
+        if (!createTarget(std::max(width, 2), std::max(height, 2)))
+            return;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBlitFramebuffer(0, 0, windowWidth, windowHeight, 0, 0, targetWidth, targetHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        encoding = true;
+        readStarted = now;
+        const double captured = now;
+        reader->capture(targetWidth, targetHeight, [this, captured](const unsigned char *pixels, int w, int h) {
+            encode(pixels, w, h, captured);
+        });
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // GL thread, once per frame: passes finished reads to the encoder
+    void poll()
+    {
+        if (reader)
+            reader->poll();
+    }
+
+    // a frame is still being read or encoded (an idle loop should keep turning until it's out)
+    bool busy() const { return encoding.load(); }
+
+    // main thread: moves the sessions' input since the last call into `input` (keys stay held until
+    // released); true when there was any
+    bool takeInput(RemoteInput &input)
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        input.keys = keysHeld;
+        input.mouseX = pending.mouseX;
+        input.mouseY = pending.mouseY;
+        input.wheel = pending.wheel;
+        input.pick = pending.pick;
+        const bool any = inputArrived;
+        pending = RemoteInput();
+        inputArrived = wakePosted = false;
+        return any;
+    }
+
+    // STREAM_SESSIONS=1, render thread: every open session with its input since the last call (keys stay
+    // held until released)
+    void takeSessionInput(std::vector<SessionInput> &out)
+    {
+        out.clear();
+        std::lock_guard<std::mutex> lock(inputMutex);
+        for (std::map<int, RemoteInput>::iterator i = sessionInput.begin(); i != sessionInput.end(); ++i)
+        {
+            SessionInput entry;
+            entry.id = i->first;
+            entry.input = i->second;
+            out.push_back(entry);
+            const std::set<int> keys = i->second.keys;
+            i->second = RemoteInput();
+            i->second.keys = keys;
+        }
+        inputArrived = wakePosted = false;
+    }
+
+    // STREAM_SESSIONS=1, any encoder thread: a frame of session `id`'s own view (RGBA8 rows bottom-up),
+    // read at `captured`; dropped if the session has left
+    void sendFrame(int id, const unsigned char *pixels, int width, int height, double captured)
+    {
+        encode(pixels, width, height, captured, id);
+    }
+
+    // input is waiting for takeInput()
+    bool inputPending()
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        return inputArrived;
+    }
+
+    // GL thread, before the context goes away
+    void releaseGpu()
+    {
+        if (reader)
+        {
+            reader->finish();
+            reader->releaseGpu();
+        }
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+        fbo = colorBuffer = 0;
+        targetWidth = targetHeight = 0;
+    }
+
+    void stop()
+    {
+        if (!network.joinable())
+            return;
+        running = false;
+        network.join();
+        reader.reset();
+        closeSocket(listener);
+        listener = INVALID;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    typedef SOCKET Socket;
+    static const Socket INVALID = INVALID_SOCKET;
+    static void closeSocket(Socket s) { if (s != INVALID) closesocket(s); }
+#else
+    typedef int Socket;
+    static const Socket INVALID = -1;
+    static void closeSocket(Socket s) { if (s != INVALID) ::close(s); }
+#endif
+
+    struct Session
+    {
+        Socket socket = INVALID;
+        int id = 0;
+        bool upgraded = false; // the WebSocket handshake is done
+        bool closing = false;  // close once the outbox is sent
+        std::string received;  // bytes not parsed yet
+        std::string outbox;    // bytes being sent
+        size_t sent = 0;
+        std::string frame;     // the newest frame message, sent once the outbox is empty
+        std::set<int> keys;    // held by this session
+    };
+
+    float scale = 0.5f;
+    int quality = 75;
+    int maxClients = 4;
+    bool ownViews = false;
+    int nextSessionId = 1;
+    std::atomic<bool> running{false};
+    std::atomic<int> sessionCount{0};
+    std::atomic<bool> encoding{false};
+    double readStarted = 0.0;
+    Socket listener = INVALID;
+    std::thread network;
+    std::unique_ptr<FrameCapture> reader;
+    // the scaled copy of the window that's read
+    GLuint fbo = 0, colorBuffer = 0;
+    bool copyUsable = true;
+    int targetWidth = 0, targetHeight = 0;
+
+    // sessions and their outgoing frames (network thread; encode() hands frames over)
+    std::mutex sessionMutex;
+    std::vector<Session> sessions;
+    // input since the last takeInput()
+    std::mutex inputMutex;
+    std::set<int> keysHeld;
+    RemoteInput pending;
+    bool inputArrived = false;
+    bool wakePosted = false;
+    // STREAM_SESSIONS=1: each open session's own input, by id
+    std::map<int, RemoteInput> sessionInput;
+    // latency of the last second's frames, read to sent to the sessions
+    double statsStart = 0.0, latencySum = 0.0;
+    int statsFrames = 0;
+
+    bool createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return true;
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+        targetWidth = width;
+        targetHeight = height;
+        glGenRenderbuffers(1, &colorBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Stream] RGBA8 copy of the window unsupported, not streaming");
+            copyUsable = false;
+        }
+        return complete;
+    }
+
+    // encoder thread: one frame into a JPEG, queued as the newest frame of every session (or only of the
+    // session `id`)
+    void encode(const unsigned char *pixels, int width, int height, double captured, int id = 0)
+    {
+        std::string jpeg;
+        // GL rows are bottom-up; the viewer page flips the canvas instead of the encoder the rows
+        stbi_write_jpg_to_func([](void *context, void *data, int size) { ((std::string *)context)->append((const char *)data, (size_t)size); },
+                               &jpeg, width, height, 4, pixels, quality);
+        const std::string message = frameHeader(2, jpeg.size()) + jpeg;
+        // several sessions' encoders may get here at once; the stats below are shared too
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        for (size_t i = 0; i < sessions.size(); ++i)
+            if (sessions[i].upgraded && !sessions[i].closing && (id == 0 || sessions[i].id == id))
+                sessions[i].frame = message;
+        if (id == 0)
+            encoding = false;
+        const double now = EngineClock::seconds();
+        latencySum += now - captured;
+        ++statsFrames;
+        if (now - statsStart >= 5.0)
+        {
+            if (statsStart > 0.0)
+                LOG_INFO("[Stream] " << sessionCount.load() << " sessions, " << (int)(statsFrames / (now - statsStart) + 0.5)
+                         << (ownViews ? " frames/s in all, " : " fps, ")
+                         << jpeg.size() / 1024 << " KB frames, read to sent " << (int)(latencySum / statsFrames * 1000.0 + 0.5) << " ms");
+            statsStart = now;
+            latencySum = 0.0;
+            statsFrames = 0;
+        }
+    }
+
+    // network thread: accepts sessions, reads their messages and writes their frames
+    void networkLoop()
+    {
+        std::vector<char> buffer(64 * 1024);
+        while (running)
+        {
+            fd_set readable, writable;
+            FD_ZERO(&readable);
+            FD_ZERO(&writable);
+            FD_SET(listener, &readable);
+            Socket highest = listener;
+            {
+                std::lock_guard<std::mutex> lock(sessionMutex);
+                for (size_t i = 0; i < sessions.size(); ++i)
+                {
+                    FD_SET(sessions[i].socket, &readable);
+                    if (!sessions[i].outbox.empty() || !sessions[i].frame.empty())
+                        FD_SET(sessions[i].socket, &writable);
+                    highest = std::max(highest, sessions[i].socket);
+                }
+            }
+            // short, so a frame the encoder just queued goes out within a couple of milliseconds
+            timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = 2000;
+            if (select((int)highest + 1, &readable, &writable, NULL, &timeout) < 0)
+                continue;
+            if (FD_ISSET(listener, &readable))
+                accept();
+            std::lock_guard<std::mutex> lock(sessionMutex);
+            for (size_t i = 0; i < sessions.size(); ++i)
+            {
+                Session &s = sessions[i];
+                bool open = true;
+                if (FD_ISSET(s.socket, &readable))
+                {
+                    const int got = (int)recv(s.socket, buffer.data(), (int)buffer.size(), 0);
+                    if (got <= 0)
+                        open = false;
+                    else
+                    {
+                        s.received.append(buffer.data(), (size_t)got);
+                        open = s.upgraded ? readMessages(s) : handshake(s);
+                    }
+                }
+                if (open && FD_ISSET(s.socket, &writable))
+                    open = write(s);
+                if (!open || (s.closing && s.outbox.empty()))
+                    drop(i--);
+            }
+            // a main thread blocked in glfwWaitEvents (an idle loop) comes round to take the input
+            std::lock_guard<std::mutex> inputLock(inputMutex);
+            if (inputArrived && !wakePosted)
+            {
+                wakePosted = true;
+                glfwPostEmptyEvent();
+            }
+        }
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        while (!sessions.empty())
+            drop(sessions.size() - 1);
+    }
+
+    void accept()
+    {
+        const Socket client = ::accept(listener, NULL, NULL);
+        if (client == INVALID)
+            return;
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        if ((int)sessions.size() >= maxClients)
+        {
+            LOG_INFO("[Stream] Session refused, " << maxClients << " already connected");
+            closeSocket(client);
+            return;
+        }
+        // frames are latency-bound, not throughput-bound
+        int yes = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, (const char *)&yes, sizeof(yes));
+        Session s;
+        s.socket = client;
+        sessions.push_back(s);
+    }
+
+    // sessionMutex held
+    void drop(size_t index)
+    {
+        Session &s = sessions[index];
+        if (s.upgraded)
+        {
+            --sessionCount;
+            LOG_INFO("[Stream] Session " << s.id << " closed, " << sessionCount.load() << " left");
+            // its keys are let go (its view with them)
+            std::lock_guard<std::mutex> lock(inputMutex);
+            sessionInput.erase(s.id);
+            for (std::set<int>::const_iterator k = s.keys.begin(); k != s.keys.end(); ++k)
+                keysHeld.erase(*k);
+            inputArrived = true;
+        }
+        closeSocket(s.socket);
+        sessions.erase(sessions.begin() + index);
+    }
+
+    // sends what the socket takes without blocking: the outbox, then the newest frame
+    bool write(Session &s)
+    {
+        if (s.outbox.empty())
+        {
+            if (s.frame.empty())
+                return true;
+            s.outbox.swap(s.frame);
+            s.frame.clear();
+            s.sent = 0;
+        }
+#ifdef MSG_NOSIGNAL
+        const int flags = MSG_NOSIGNAL; // a closed session is an error return, not SIGPIPE
+#else
+        const int flags = 0;
+#endif
+        const int put = (int)::send(s.socket, s.outbox.data() + s.sent, (int)(s.outbox.size() - s.sent), flags);
+        if (put <= 0)
+            return false;
+        s.sent += (size_t)put;
+        if (s.sent == s.outbox.size())
+        {
+            s.outbox.clear();
+            s.sent = 0;
+        }
+        return true;
+    }
+
+    // the HTTP request: a WebSocket upgrade, or the viewer page for anything else
+    bool handshake(Session &s)
+    {
+        const size_t end = s.received.find("\r\n\r\n");
+        if (end == std::string::npos)
+            return s.received.size() < 16 * 1024;
+        const std::string request = s.received.substr(0, end);
+        s.received.erase(0, end + 4);
+        const std::string key = headerValue(request, "sec-websocket-key");
+        if (key.empty())
+        {
+            const std::string page = viewerPage();
+            s.outbox = "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=utf-8\r\nCache-Control: no-store\r\nConnection: close\r\nContent-Length: " +
+                       std::to_string(page.size()) + "\r\n\r\n" + page;
+            s.closing = true;
+            return true;
+        }
+        s.outbox = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " +
+                   base64(sha1(key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11")) + "\r\n\r\n";
+        s.upgraded = true;
+        s.id = nextSessionId++;
+        ++sessionCount;
+        LOG_INFO("[Stream] Session " << s.id << " opened, " << sessionCount.load() << " connected");
+        // the newcomer needs a frame even if nothing moves
+        std::lock_guard<std::mutex> lock(inputMutex);
+        if (ownViews)
+            sessionInput[s.id] = RemoteInput();
+        inputArrived = true;
+        return true;
+    }
+
+    // parses the complete client messages received so far (masked, unfragmented); false to close
+    bool readMessages(Session &s)
+    {
+        for (;;)
+        {
+            const unsigned char *b = (const unsigned char *)s.received.data();
+            const size_t available = s.received.size();
+            if (available < 2)
+                return true;
+            const int opcode = b[0] & 15;
+            const bool masked = (b[1] & 128) != 0;
+            uint64_t length = b[1] & 127;
+            size_t header = 2;
+            if (length == 126)
+            {
+                if (available < 4)
+                    return true;
+                length = ((uint64_t)b[2] << 8) | b[3];
+                header = 4;
+            }
+            else if (length == 127)
+            {
+                if (available < 10)
+                    return true;
+                length = 0;
+                for (int i = 0; i < 8; ++i)
+                    length = (length << 8) | b[2 + i];
+                header = 10;
+            }
+            // input messages are a few bytes; anything large isn't from the viewer page
+            if (!masked || length > 4096)
+                return false;
+            if (available < header + 4 + length)
+                return true;
+            const unsigned char *mask = b + header;
+            std::string payload((size_t)length, '\0');
+            for (size_t i = 0; i < (size_t)length; ++i)
+                payload[i] = (char)(b[header + 4 + i] ^ mask[i & 3]);
+            s.received.erase(0, header + 4 + (size_t)length);
+            if (opcode == 8)
+            {
+                s.outbox += frameHeader(8, 0);
+                s.closing = true;
+                return true;
+            }
+            if (opcode == 9)
+                s.outbox += frameHeader(10, payload.size()) + payload;
+            else if (opcode == 1)
+                handleInput(s, payload);
+        }
+    }
+
+    // the GLFW key codes of viewerPage()'s `keys` map, the only ones a session may hold
+    static bool viewerKey(int key)
+    {
+        static const int codes[] = {GLFW_KEY_A, GLFW_KEY_D, GLFW_KEY_H, GLFW_KEY_L, GLFW_KEY_M, GLFW_KEY_O, GLFW_KEY_P,
+                                    GLFW_KEY_R, GLFW_KEY_S, GLFW_KEY_T, GLFW_KEY_C, GLFW_KEY_W, GLFW_KEY_RIGHT,
+                                    GLFW_KEY_LEFT, GLFW_KEY_DOWN, GLFW_KEY_UP, GLFW_KEY_PAGE_UP, GLFW_KEY_PAGE_DOWN,
+                                    GLFW_KEY_LEFT_BRACKET, GLFW_KEY_RIGHT_BRACKET, GLFW_KEY_APOSTROPHE,
+                                    GLFW_KEY_SEMICOLON, GLFW_KEY_EQUAL, GLFW_KEY_MINUS};
+        return std::find(codes, codes + sizeof(codes) / sizeof(codes[0]), key) != codes + sizeof(codes) / sizeof(codes[0]);
+    }
+
+    // one line of the viewer's input protocol: "k <glfw key> <1|0>", "m <dx> <dy>" (pixels, y down), "w <steps>",
+    // "c" (click)
+    void handleInput(Session &s, const std::string &message)
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        // the shared view's input, or with STREAM_SESSIONS the session's own
+        RemoteInput *in = &pending;
+        std::set<int> *held = &keysHeld;
+        if (ownViews)
+        {
+            std::map<int, RemoteInput>::iterator own = sessionInput.find(s.id);
+            if (own == sessionInput.end())
+                return;
+            in = &own->second;
+            held = &own->second.keys;
+        }
+        // the most one message may move the pointer (pixels per axis) or the wheel (steps); the page sends
+        // pointer-lock movement and single wheel steps
+        const float maxMouseStep = 1000.0f, maxWheelStep = 4.0f;
+        int key = 0, down = 0;
+        float x = 0.0f, y = 0.0f;
+        if (std::sscanf(message.c_str(), "k %d %d", &key, &down) == 2)
+        {
+            // only the keys the page sends: any other code would stay held until the session closes
+            if (!viewerKey(key))
+                return;
+            if (down)
+            {
+                s.keys.insert(key);
+                held->insert(key);
+            }
+            else
+            {
+                s.keys.erase(key);
+                held->erase(key);
+            }
+        }
+        else if (std::sscanf(message.c_str(), "m %f %f", &x, &y) == 2)
+        {
+            // a nan or inf would reach the shared camera's yaw and pitch and stay there
+            if (!std::isfinite(x) || !std::isfinite(y))
+                return;
+            in->mouseX += std::max(-maxMouseStep, std::min(x, maxMouseStep));
+            in->mouseY -= std::max(-maxMouseStep, std::min(y, maxMouseStep));
+        }
+        else if (std::sscanf(message.c_str(), "w %f", &y) == 1)
+        {
+            if (!std::isfinite(y))
+                return;
+            in->wheel += std::max(-maxWheelStep, std::min(y, maxWheelStep));
+        }
+        else if (message == "c")
+            in->pick = true;
+        else
+            return;
+        inputArrived = true;
+    }
+
+    // header of an unmasked server message with `opcode` (2 binary, 8 close, 10 pong)
+    static std::string frameHeader(int opcode, size_t length)
+    {
+        std::string h(1, (char)(128 | opcode));
+        if (length < 126)
+            h += (char)length;
+        else if (length < 65536)
+        {
+            h += (char)126;
+            h += (char)(length >> 8);
+            h += (char)(length & 255);
+        }
+        else
+        {
+            h += (char)127;
+            for (int i = 7; i >= 0; --i)
+                h += (char)((uint64_t)length >> (i * 8) & 255);
+        }
+        return h;
+    }
+
+    // value of header `name` (lower case) in an HTTP request
+    static std::string headerValue(const std::string &request, const std::string &name)
+    {
+        size_t line = request.find("\r\n");
+        while (line != std::string::npos)
+        {
+            line += 2;
+            const size_t end = request.find("\r\n", line);
+            const std::string text = request.substr(line, end == std::string::npos ? std::string::npos : end - line);
+            const size_t colon = text.find(':');
+            if (colon != std::string::npos)
+            {
+                std::string field = text.substr(0, colon);
+                std::transform(field.begin(), field.end(), field.begin(), ::tolower);
+                if (field == name)
+                {
+                    const size_t start = text.find_first_not_of(' ', colon + 1);
+                    return start == std::string::npos ? std::string() : text.substr(start);
+                }
+            }
+            line = end;
+        }
+        return std::string();
+    }
+
+    static std::string sha1(const std::string &text)
+    {
+        uint32_t h[5] = {0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u};
+        std::string m = text;
+        const uint64_t bits = (uint64_t)text.size() * 8;
+        m += (char)0x80;
+        while (m.size() % 64 != 56)
+            m += (char)0;
+        for (int i = 7; i >= 0; --i)
+            m += (char)(bits >> (i * 8) & 255);
+        for (size_t chunk = 0; chunk < m.size(); chunk += 64)
+        {
+            uint32_t w[80];
+            for (int i = 0; i < 16; ++i)
+                w[i] = (uint32_t)(unsigned char)m[chunk + i * 4] << 24 | (uint32_t)(unsigned char)m[chunk + i * 4 + 1] << 16 |
+                       (uint32_t)(unsigned char)m[chunk + i * 4 + 2] << 8 | (uint32_t)(unsigned char)m[chunk + i * 4 + 3];
+            for (int i = 16; i < 80; ++i)
+            {
+                const uint32_t v = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+                w[i] = v << 1 | v >> 31;
+            }
+            uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+            for (int i = 0; i < 80; ++i)
+            {
+                uint32_t f, k;
+                if (i < 20) { f = (b & c) | (~b & d); k = 0x5A827999u; }
+                else if (i < 40) { f = b ^ c ^ d; k = 0x6ED9EBA1u; }
+                else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDCu; }
+                else { f = b ^ c ^ d; k = 0xCA62C1D6u; }
+                const uint32_t t = (a << 5 | a >> 27) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = b << 30 | b >> 2;
+                b = a;
+                a = t;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+        }
+        std::string digest;
+        for (int i = 0; i < 5; ++i)
+            for (int j = 3; j >= 0; --j)
+                digest += (char)(h[i] >> (j * 8) & 255);
+        return digest;
+    }
+
+    static std::string base64(const std::string &bytes)
+    {
+        static const char *digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        for (size_t i = 0; i < bytes.size(); i += 3)
+        {
+            const uint32_t v = (uint32_t)(unsigned char)bytes[i] << 16 | (i + 1 < bytes.size() ? (uint32_t)(unsigned char)bytes[i + 1] << 8 : 0) |
+                               (i + 2 < bytes.size() ? (uint32_t)(unsigned char)bytes[i + 2] : 0);
+            out += digits[v >> 18 & 63];
+            out += digits[v >> 12 & 63];
+            out += i + 1 < bytes.size() ? digits[v >> 6 & 63] : '=';
+            out += i + 2 < bytes.size() ? digits[v & 63] : '=';
+        }
+        return out;
+    }
+
+    // the browser side: draws each frame (flipped, GL rows are bottom-up), locks the pointer on click and
+    // sends the keys processInput reads as GLFW key codes (viewerKey() lists the same ones)
+    static std::string viewerPage()
+    {
+        return "<!doctype html><html><head><title>Car viewer</title>"
+               "<style>html,body{margin:0;height:100%;background:#111}canvas{width:100%;height:100%;object-fit:contain;transform:scaleY(-1)}</style>"
+               "</head><body><canvas id=v></canvas><script>\n"
+               "const v=document.getElementById('v'),g=v.getContext('2d');\n"
+               "const keys={KeyA:65,KeyD:68,KeyH:72,KeyL:76,KeyM:77,KeyO:79,KeyP:80,KeyR:82,KeyS:83,KeyT:84,KeyC:67,KeyW:87,"
+               "ArrowRight:262,ArrowLeft:263,ArrowDown:264,ArrowUp:265,PageUp:266,PageDown:267,"
+               "BracketLeft:91,BracketRight:93,Quote:39,Semicolon:59,Equal:61,Minus:45};\n"
+               "const ws=new WebSocket('ws://'+location.host+'/');ws.binaryType='blob';\n"
+               "let drawing=false;\n"
+               "ws.onmessage=e=>{if(drawing)return;drawing=true;createImageBitmap(e.data).then(b=>{"
+               "if(v.width!=b.width||v.height!=b.height){v.width=b.width;v.height=b.height;}g.drawImage(b,0,0);b.close();drawing=false;});};\n"
+               "const send=t=>{if(ws.readyState==1)ws.send(t);};\n"
+               "onkeydown=e=>{if(keys[e.code]&&!e.repeat){send('k '+keys[e.code]+' 1');e.preventDefault();}};\n"
+               "onkeyup=e=>{if(keys[e.code]){send('k '+keys[e.code]+' 0');e.preventDefault();}};\n"
+               "onblur=()=>{for(const c in keys)send('k '+keys[c]+' 0');};\n"
+               "v.onclick=()=>{if(document.pointerLockElement!=v)v.requestPointerLock();else send('c');};\n"
+               "onmousemove=e=>{if(document.pointerLockElement==v)send('m '+e.movementX+' '+e.movementY);};\n"
+               "onwheel=e=>{send('w '+(e.deltaY<0?1:-1));};\n"
+               "</script></body></html>";
+    }
+};
+
+#endif
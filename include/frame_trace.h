@@ -0,0 +1,179 @@
+#ifndef FRAME_TRACE_H
+#define FRAME_TRACE_H
+
+#include <engine_clock.h>
+#include <json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Timeline capture in the Chrome trace event format (chrome://tracing, ui.perfetto.dev), for stutter that
+// averages hide. TRACE_CAPTURE=1 records to frame_trace.json, TRACE_CAPTURE=<file> to that file; the file
+// is written on exit. Any thread may record: load stages on the loader and decode workers appear on their
+// own tracks. GpuProfiler adds its pass scopes on the GL thread plus their GPU execution on a separate
+// "GPU" process, shifted into the CPU clock with a GL_TIMESTAMP reading.
+//
+//     FrameTrace::Scope scope("decode image", filename);
+class FrameTrace;
+inline FrameTrace &frameTrace();
+
+class FrameTrace
+{
+public:
+    static const size_t MAX_EVENTS = 1 << 20; // later events are dropped (and counted)
+    static const int CPU_PROCESS = 1;
+    static const int GPU_PROCESS = 2;
+
+    // one complete ("X") event on the calling thread, from construction to destruction
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name, const std::string &detail = std::string())
+            : name(name), begin(frameTrace().enabled() ? clockUs() : -1.0)
+        {
+            if (begin >= 0.0)
+                this->detail = detail;
+        }
+        ~Scope()
+        {
+            if (begin >= 0.0)
+                frameTrace().complete(name, begin, clockUs() - begin, CPU_PROCESS, threadTrack(), detail);
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *name;
+        double begin;
+        std::string detail;
+    };
+
+    FrameTrace()
+    {
+        const char *env = std::getenv("TRACE_CAPTURE");
+        if (env && *env && std::string(env) != "0")
+        {
+            path = std::string(env) == "1" ? "frame_trace.json" : env;
+            active = true;
+        }
+    }
+
+    FrameTrace(const FrameTrace &) = delete;
+    FrameTrace &operator=(const FrameTrace &) = delete;
+
+    bool enabled() const { return active; }
+    const std::string &outputPath() const { return path; }
+
+    // microseconds on the EngineClock (GpuProfiler's CPU times use it too)
+    static double clockUs() { return EngineClock::us(); }
+
+    // small per-thread track id, in order of first use
+    static int threadTrack()
+    {
+        static std::mutex mutex;
+        static std::map<std::thread::id, int> tracks;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::thread::id, int>::const_iterator it = tracks.find(std::this_thread::get_id());
+        if (it != tracks.end())
+            return it->second;
+        const int track = (int)tracks.size() + 1;
+        tracks[std::this_thread::get_id()] = track;
+        return track;
+    }
+
+    // labels the calling thread's track (otherwise it shows as its number)
+    void nameThread(const std::string &name)
+    {
+        const int track = threadTrack();
+        std::lock_guard<std::mutex> lock(mutex);
+        threadNames[track] = name;
+    }
+
+    // thread safe; `name` must outlive the trace (a literal)
+    void complete(const char *name, double beginUs, double durationUs, int process, int track, const std::string &detail = std::string())
+    {
+        if (!active)
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (events.size() >= MAX_EVENTS)
+        {
+            dropped++;
+            return;
+        }
+        Event e;
+        e.name = name;
+        e.begin = beginUs;
+        e.duration = durationUs;
+        e.process = process;
+        e.track = track;
+        e.detail = detail;
+        events.push_back(e);
+    }
+
+    // writes everything recorded so far; false if the file can't be written
+    bool write() const
+    {
+        if (!active)
+            return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream out(path.c_str());
+        if (!out)
+            return false;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        // metadata: process and thread names
+        out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << CPU_PROCESS << ",\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+        out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << GPU_PROCESS << ",\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+        for (std::map<int, std::string>::const_iterator it = threadNames.begin(); it != threadNames.end(); ++it)
+            out << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << CPU_PROCESS << ",\"tid\":" << it->first
+                << ",\"args\":{\"name\":" << nlohmann::json(it->second).dump() << "}}";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const Event &e = events[i];
+            out << ",\n{\"ph\":\"X\",\"name\":" << nlohmann::json(e.name).dump() << ",\"pid\":" << e.process << ",\"tid\":" << e.track
+                << ",\"ts\":" << std::fixed << std::setprecision(3) << e.begin << ",\"dur\":" << e.duration;
+            if (!e.detail.empty())
+                out << ",\"args\":{\"detail\":" << nlohmann::json(e.detail).dump() << "}";
+            out << "}";
+        }
+        out << "\n],\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+        return (bool)out;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size();
+    }
+
+private:
+    struct Event
+    {
+        const char *name;
+        double begin, duration; // us
+        int process, track;
+        std::string detail;
+    };
+
+    bool active = false;
+    std::string path;
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    std::map<int, std::string> threadNames;
+    size_t dropped = 0;
+};
+
+// process-wide, so loaders on any thread can record without a handle
+inline FrameTrace &frameTrace()
+{
+    static FrameTrace trace;
+    return trace;
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// The six clip planes of a projection (Gribb/Hartmann extraction), normalized so plane distances are in
+// the units of the space the matrix maps from. Pass projection * view * model to get the planes in model
+// space, then untransformed mesh bounds can be tested directly.
+struct Frustum
+{
+    // xyz = inward normal, w = distance: dot(xyz, p) + w >= 0 for points inside
+    glm::vec4 planes[6];
+
+    explicit Frustum(const glm::mat4 &clip)
+    {
+        // rows of the (column-major) matrix
+        glm::vec4 row0(clip[0][0], clip[1][0], clip[2][0], clip[3][0]);
+        glm::vec4 row1(clip[0][1], clip[1][1], clip[2][1], clip[3][1]);
+        glm::vec4 row2(clip[0][2], clip[1][2], clip[2][2], clip[3][2]);
+        glm::vec4 row3(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+        planes[0] = row3 + row0; // left
+        planes[1] = row3 - row0; // right
+        planes[2] = row3 + row1; // bottom
+        planes[3] = row3 - row1; // top
+        planes[4] = row3 + row2; // near
+        planes[5] = row3 - row2; // far
+        for (int p = 0; p < 6; ++p)
+        {
+            float len = glm::length(glm::vec3(planes[p]));
+            if (len > 0.0f)
+                planes[p] /= len;
+        }
+    }
+
+    enum Containment { OUTSIDE, INTERSECTS, INSIDE };
+
+    // where the box [boundsMin, boundsMax] lies relative to the frustum
+    Containment classify(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) const
+    {
+        glm::vec3 c = (boundsMin + boundsMax) * 0.5f;
+        glm::vec3 e = (boundsMax - boundsMin) * 0.5f;
+        Containment result = INSIDE;
+        for (int p = 0; p < 6; ++p)
+        {
+            glm::vec3 n(planes[p]);
+            float d = glm::dot(n, c) + planes[p].w;
+            float r = glm::dot(glm::abs(n), e);
+            if (d + r < 0.0f)
+                return OUTSIDE;
+            if (d - r < 0.0f)
+                result = INTERSECTS;
+        }
+        return result;
+    }
+};
+
+// Bounds of many meshes stored as structure-of-arrays streams: AABB centre, AABB half extent and the radius
+// of a bounding sphere around the same centre. cull() walks the streams one plane at a time with a
+// branch-free inner loop, so the compiler turns it into SIMD over several boxes per instruction.
+struct BoundsBatch
+{
+    std::vector<float> cx, cy, cz;
+    std::vector<float> ex, ey, ez;
+    std::vector<float> radius;
+
+    size_t size() const { return cx.size(); }
+
+    void clear()
+    {
+        cx.clear(); cy.clear(); cz.clear();
+        ex.clear(); ey.clear(); ez.clear();
+        radius.clear();
+    }
+
+    void add(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float sphereRadius)
+    {
+        glm::vec3 c = (boundsMin + boundsMax) * 0.5f;
+        glm::vec3 e = (boundsMax - boundsMin) * 0.5f;
+        cx.push_back(c.x); cy.push_back(c.y); cz.push_back(c.z);
+        ex.push_back(e.x); ey.push_back(e.y); ez.push_back(e.z);
+        radius.push_back(sphereRadius);
+    }
+
+    // copies entry `i` of `other` to the end of this batch
+    void append(const BoundsBatch &other, size_t i)
+    {
+        cx.push_back(other.cx[i]); cy.push_back(other.cy[i]); cz.push_back(other.cz[i]);
+        ex.push_back(other.ex[i]); ey.push_back(other.ey[i]); ez.push_back(other.ez[i]);
+        radius.push_back(other.radius[i]);
+    }
+
+    glm::vec3 boundsMin(size_t i) const { return glm::vec3(cx[i] - ex[i], cy[i] - ey[i], cz[i] - ez[i]); }
+    glm::vec3 boundsMax(size_t i) const { return glm::vec3(cx[i] + ex[i], cy[i] + ey[i], cz[i] + ez[i]); }
+
+    // visible[i] = 1 if entry i may intersect the frustum, 0 if its box or its sphere lies fully outside
+    // one of the planes (both bounds are conservative, so either proves the mesh invisible)
+    void cull(const Frustum &frustum, std::vector<unsigned char> &visible) const
+    {
+        visible.assign(size(), 1);
+        if (!visible.empty())
+            cullRange(frustum, 0, size(), &visible[0]);
+    }
+
+    // same test for entries [first, first + count); clears out[k - first] of culled entries and leaves
+    // the others untouched
+    void cullRange(const Frustum &frustum, size_t first, size_t count, unsigned char *out) const
+    {
+        const float *pcx = &cx[first], *pcy = &cy[first], *pcz = &cz[first];
+        const float *pex = &ex[first], *pey = &ey[first], *pez = &ez[first];
+        const float *pr = &radius[first];
+        for (int p = 0; p < 6; ++p)
+        {
+            const glm::vec4 &pl = frustum.planes[p];
+            const float nx = pl.x, ny = pl.y, nz = pl.z, w = pl.w;
+            const float ax = glm::abs(nx), ay = glm::abs(ny), az = glm::abs(nz);
+            for (size_t i = 0; i < count; ++i)
+            {
+                float d = nx * pcx[i] + ny * pcy[i] + nz * pcz[i] + w;
+                float boxReach = ax * pex[i] + ay * pey[i] + az * pez[i];
+                float reach = boxReach < pr[i] ? boxReach : pr[i];
+                out[i] &= (unsigned char)(d + reach >= 0.0f);
+            }
+        }
+    }
+};
+
+#endif
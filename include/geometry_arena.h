@@ -0,0 +1,489 @@
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_handle.h>
+#include <gpu_memory.h>
+#include <mesh.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Two-level segregated fit (TLSF) allocator of element ranges [0, capacity): free blocks sit in one list
+// per (power of two, 1/16th of it) size class with a bitmap over the lists, so allocate() and free() are a
+// handful of bit scans and list splices whatever the number of blocks, and neighbouring free blocks merge
+// on free. It hands out offsets only; the memory it manages is a GL buffer.
+class TlsfRanges
+{
+public:
+    static const uint32_t NONE = 0xffffffffu;
+
+    explicit TlsfRanges(size_t capacity = 0) { reset(capacity); }
+
+    void reset(size_t capacity)
+    {
+        blocks.clear();
+        unusedBlocks.clear();
+        flBitmap = 0;
+        for (int f = 0; f < FL_COUNT; ++f)
+        {
+            slBitmap[f] = 0;
+            for (int s = 0; s < SL_COUNT; ++s)
+                heads[f][s] = NONE;
+        }
+        total = capacity;
+        used = 0;
+        if (capacity)
+            insertFree(newBlock(0, capacity));
+    }
+
+    // a block of `count` elements: its handle (NONE when nothing free is large enough) and its offset
+    uint32_t allocate(size_t count, size_t &offset)
+    {
+        if (!count || count > total - used)
+            return NONE;
+        int fl = 0, sl = 0;
+        mapping(roundUp(count), fl, sl);
+        uint32_t b = findFree(fl, sl) ? heads[fl][sl] : NONE;
+        if (b == NONE)
+        {
+            // a block that fits only just (a page sized for one range) sits in the list of `count` itself
+            mapping(count, fl, sl);
+            for (b = heads[fl][sl]; b != NONE && blocks[b].size < count; b = blocks[b].nextFree)
+                ;
+            if (b == NONE)
+                return NONE;
+        }
+        removeFree(b);
+        if (blocks[b].size > count)
+        {
+            // the remainder goes back to its free list, right behind the block
+            const uint32_t rest = newBlock(blocks[b].offset + count, blocks[b].size - count);
+            blocks[rest].prevPhys = b;
+            blocks[rest].nextPhys = blocks[b].nextPhys;
+            if (blocks[b].nextPhys != NONE)
+                blocks[blocks[b].nextPhys].prevPhys = rest;
+            blocks[b].nextPhys = rest;
+            blocks[b].size = count;
+            insertFree(rest);
+        }
+        blocks[b].used = true;
+        used += count;
+        offset = blocks[b].offset;
+        return b;
+    }
+
+    void free(uint32_t b)
+    {
+        if (b >= blocks.size() || !blocks[b].used)
+            return;
+        blocks[b].used = false;
+        used -= blocks[b].size;
+        const uint32_t prev = blocks[b].prevPhys;
+        if (prev != NONE && !blocks[prev].used)
+        {
+            removeFree(prev);
+            blocks[prev].size += blocks[b].size;
+            unlinkPhys(b);
+            b = prev;
+        }
+        const uint32_t next = blocks[b].nextPhys;
+        if (next != NONE && !blocks[next].used)
+        {
+            removeFree(next);
+            blocks[b].size += blocks[next].size;
+            unlinkPhys(next);
+        }
+        insertFree(b);
+    }
+
+    size_t capacity() const { return total; }
+    size_t usedCount() const { return used; }
+    bool empty() const { return used == 0; }
+
+    // the largest free block, i.e. the largest allocation that would still succeed
+    size_t largestFree() const
+    {
+        size_t largest = 0;
+        for (int f = FL_COUNT - 1; f >= 0 && !largest; --f)
+            for (int s = 0; s < SL_COUNT; ++s)
+                for (uint32_t b = (slBitmap[f] >> s) & 1u ? heads[f][s] : NONE; b != NONE; b = blocks[b].nextFree)
+                    largest = std::max(largest, blocks[b].size);
+        return largest;
+    }
+
+private:
+    // 16 second-level lists per power of two; sizes below 16 get one list each
+    enum { SL_LOG2 = 4, SL_COUNT = 1 << SL_LOG2, FL_COUNT = 48 };
+
+    struct Block
+    {
+        size_t offset;
+        size_t size;
+        bool used;
+        uint32_t prevPhys, nextPhys;
+        uint32_t prevFree, nextFree;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<uint32_t> unusedBlocks;
+    uint64_t flBitmap = 0;
+    uint32_t slBitmap[FL_COUNT];
+    uint32_t heads[FL_COUNT][SL_COUNT];
+    size_t total = 0, used = 0;
+
+    static int floorLog2(size_t v)
+    {
+        int log = 0;
+        while (v >>= 1)
+            ++log;
+        return log;
+    }
+
+    static int lowestBit(uint64_t v)
+    {
+        int bit = 0;
+        while (!(v & 1u))
+        {
+            v >>= 1;
+            ++bit;
+        }
+        return bit;
+    }
+
+    static void mapping(size_t size, int &fl, int &sl)
+    {
+        if (size < SL_COUNT)
+        {
+            fl = 0;
+            sl = (int)size;
+            return;
+        }
+        const int log = floorLog2(size);
+        fl = log - SL_LOG2 + 1;
+        sl = (int)((size >> (log - SL_LOG2)) ^ SL_COUNT);
+    }
+
+    // rounds a request up to the next list boundary, so any block of the list found fits it
+    static size_t roundUp(size_t size)
+    {
+        return size < SL_COUNT ? size : size + ((size_t)1 << (floorLog2(size) - SL_LOG2)) - 1;
+    }
+
+    // the first non-empty list at or above (fl, sl)
+    bool findFree(int &fl, int &sl) const
+    {
+        if (fl >= FL_COUNT)
+            return false;
+        uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (!slMap)
+        {
+            const uint64_t flMap = fl + 1 < FL_COUNT ? flBitmap & (~(uint64_t)0 << (fl + 1)) : 0;
+            if (!flMap)
+                return false;
+            fl = lowestBit(flMap);
+            slMap = slBitmap[fl];
+        }
+        sl = lowestBit(slMap);
+        return true;
+    }
+
+    uint32_t newBlock(size_t offset, size_t size)
+    {
+        const Block block = {offset, size, false, NONE, NONE, NONE, NONE};
+        if (!unusedBlocks.empty())
+        {
+            const uint32_t b = unusedBlocks.back();
+            unusedBlocks.pop_back();
+            blocks[b] = block;
+            return b;
+        }
+        blocks.push_back(block);
+        return (uint32_t)blocks.size() - 1;
+    }
+
+    // drops `b` from the physical chain once its range was merged into the block before it
+    void unlinkPhys(uint32_t b)
+    {
+        const uint32_t prev = blocks[b].prevPhys, next = blocks[b].nextPhys;
+        if (prev != NONE)
+            blocks[prev].nextPhys = next;
+        if (next != NONE)
+            blocks[next].prevPhys = prev;
+        unusedBlocks.push_back(b);
+    }
+
+    void insertFree(uint32_t b)
+    {
+        int fl = 0, sl = 0;
+        mapping(blocks[b].size, fl, sl);
+        blocks[b].prevFree = NONE;
+        blocks[b].nextFree = heads[fl][sl];
+        if (heads[fl][sl] != NONE)
+            blocks[heads[fl][sl]].prevFree = b;
+        heads[fl][sl] = b;
+        flBitmap |= (uint64_t)1 << fl;
+        slBitmap[fl] |= 1u << sl;
+    }
+
+    void removeFree(uint32_t b)
+    {
+        int fl = 0, sl = 0;
+        mapping(blocks[b].size, fl, sl);
+        const uint32_t prev = blocks[b].prevFree, next = blocks[b].nextFree;
+        if (prev != NONE)
+            blocks[prev].nextFree = next;
+        else
+            heads[fl][sl] = next;
+        if (next != NONE)
+            blocks[next].prevFree = prev;
+        if (heads[fl][sl] == NONE)
+        {
+            slBitmap[fl] &= ~(1u << sl);
+            if (!slBitmap[fl])
+                flBitmap &= ~((uint64_t)1 << fl);
+        }
+    }
+};
+
+// GEOMETRY_ARENA=1: the packed vertices and the indices of every model live in a few large GL buffers
+// (pages of GEOMETRY_ARENA_MB, default 64, per kind) instead of one vertex and one index buffer per model,
+// each model holding a range of a page handed out by TlsfRanges. Ranges are counted in elements of the
+// page's kind (PackedVertex, 16- or 32-bit index), so every range is aligned to its format. Loading and
+// unloading cars then reuses the same few driver allocations. A model larger than a page gets a page of its
+// own. Pages that stayed empty for a while are deleted by collect() on frames the loader is idle. Without
+// GEOMETRY_ARENA every range is a buffer of its own, as before. Pages are in gpuMemory() as MODEL_GEOMETRY.
+class GeometryArena
+{
+public:
+    enum Kind { VERTICES, INDICES16, INDICES32, KIND_COUNT };
+
+    // a model's range of a page; `offset` and `count` in elements of the kind
+    struct Range
+    {
+        GLuint buffer = 0;
+        size_t offset = 0;
+        size_t count = 0;
+        uint32_t page = TlsfRanges::NONE;
+        uint32_t block = TlsfRanges::NONE;
+    };
+
+    struct Stats
+    {
+        size_t pages = 0;
+        size_t ranges = 0;
+        size_t capacityBytes = 0;
+        size_t usedBytes = 0;
+        size_t largestFreeBytes = 0;
+    };
+
+    GeometryArena()
+    {
+        const char *env = std::getenv("GEOMETRY_ARENA");
+        shared = env && std::string(env) == "1";
+        if (const char *mb = std::getenv("GEOMETRY_ARENA_MB"))
+            pageBytes = (size_t)std::max(1, std::atoi(mb)) << 20;
+    }
+
+    // pages still there at exit go with the context (gpuMemory() may already be gone)
+    ~GeometryArena()
+    {
+        for (size_t p = 0; p < pages.size(); ++p)
+            pages[p].buffer.release();
+    }
+
+    GeometryArena(const GeometryArena &) = delete;
+    GeometryArena &operator=(const GeometryArena &) = delete;
+
+    static size_t elementBytes(Kind kind)
+    {
+        return kind == VERTICES ? sizeof(PackedVertex) : kind == INDICES16 ? 2 : 4;
+    }
+
+    static Kind indexKind(unsigned int indexSize) { return indexSize == 2 ? INDICES16 : INDICES32; }
+
+    // GL thread: a range of `count` elements for `owner` (a model's directory); its buffer is left bound to
+    // `target`. An empty range for count 0.
+    Range allocate(Kind kind, size_t count, GLenum target, const std::string &owner)
+    {
+        Range range;
+        if (!count)
+            return range;
+        const size_t bytes = elementBytes(kind);
+        for (size_t p = 0; p < pages.size() && range.block == TlsfRanges::NONE; ++p)
+            if (pages[p].buffer && pages[p].kind == kind && pages[p].shared)
+                range = take((uint32_t)p, count);
+        if (range.block == TlsfRanges::NONE)
+        {
+            const bool sharedPage = shared && count * bytes <= pageBytes;
+            range = take(newPage(kind, sharedPage ? pageBytes / bytes : count, target, sharedPage, owner), count);
+        }
+        glBindBuffer(target, range.buffer);
+        ++allocations;
+        return range;
+    }
+
+    // GL thread: gives `range` back (a page of its own is deleted with it); safe on empty ranges and after releaseGpu()
+    void free(Range &range)
+    {
+        if (range.page < pages.size() && range.buffer && pages[range.page].buffer.get() == range.buffer)
+        {
+            Page &page = pages[range.page];
+            page.ranges.free(range.block);
+            page.rangeCount--;
+            page.emptyFrames = 0;
+            if (!page.shared && page.ranges.empty())
+                deletePage(range.page);
+        }
+        range = Range();
+    }
+
+    // GL thread, once per frame: deletes the shared pages that have been empty for EMPTY_FRAMES frames
+    // while `idle` (the loader has nothing queued that would fill them again)
+    void collect(bool idle)
+    {
+        for (size_t p = 0; p < pages.size(); ++p)
+        {
+            Page &page = pages[p];
+            if (!page.buffer || !page.shared || !page.ranges.empty())
+                continue;
+            if (!idle)
+                page.emptyFrames = 0;
+            else if (++page.emptyFrames >= EMPTY_FRAMES)
+            {
+                LOG_INFO("[GeometryArena] Released an empty " << kindName(page.kind) << " page of "
+                         << page.ranges.capacity() * elementBytes(page.kind) / 1024 << " KiB");
+                deletePage((uint32_t)p);
+            }
+        }
+    }
+
+    Stats stats(Kind kind) const
+    {
+        Stats s;
+        for (size_t p = 0; p < pages.size(); ++p)
+        {
+            const Page &page = pages[p];
+            if (!page.buffer || page.kind != kind)
+                continue;
+            const size_t bytes = elementBytes(kind);
+            s.pages++;
+            s.ranges += page.rangeCount;
+            s.capacityBytes += page.ranges.capacity() * bytes;
+            s.usedBytes += page.ranges.usedCount() * bytes;
+            s.largestFreeBytes = std::max(s.largestFreeBytes, page.ranges.largestFree() * bytes);
+        }
+        return s;
+    }
+
+    // pages, ranges, use and the largest free block per kind
+    void report(std::ostream &out) const
+    {
+        out << "[GeometryArena] " << allocations << " ranges handed out";
+        if (shared)
+            out << " from shared pages of " << GpuMemory::mb(pageBytes) << " MB";
+        out << "\n";
+        for (int k = 0; k < KIND_COUNT; ++k)
+        {
+            const Stats s = stats((Kind)k);
+            if (!s.pages)
+                continue;
+            out << "  " << kindName((Kind)k) << ": " << s.ranges << " ranges in " << s.pages << " pages, " << GpuMemory::mb(s.usedBytes)
+                << " of " << GpuMemory::mb(s.capacityBytes) << " MB used, largest free block " << GpuMemory::mb(s.largestFreeBytes) << " MB\n";
+        }
+    }
+
+    void releaseGpu()
+    {
+        for (size_t p = 0; p < pages.size(); ++p)
+            if (pages[p].buffer)
+                deletePage((uint32_t)p);
+        pages.clear();
+    }
+
+private:
+    // ~5 s at 60 Hz
+    static const unsigned int EMPTY_FRAMES = 300;
+
+    struct Page
+    {
+        GlBuffer buffer;
+        Kind kind = VERTICES;
+        bool shared = false;
+        size_t rangeCount = 0;
+        unsigned int emptyFrames = 0;
+        TlsfRanges ranges;
+    };
+
+    std::vector<Page> pages;
+    bool shared = false;
+    size_t pageBytes = (size_t)64 << 20;
+    size_t allocations = 0;
+
+    static const char *kindName(Kind kind)
+    {
+        static const char *names[KIND_COUNT] = {"vertex", "16-bit index", "32-bit index"};
+        return names[kind];
+    }
+
+    Range take(uint32_t p, size_t count)
+    {
+        Range range;
+        size_t offset = 0;
+        const uint32_t block = pages[p].ranges.allocate(count, offset);
+        if (block == TlsfRanges::NONE)
+            return range;
+        range.buffer = pages[p].buffer.get();
+        range.offset = offset;
+        range.count = count;
+        range.page = p;
+        range.block = block;
+        pages[p].rangeCount++;
+        pages[p].emptyFrames = 0;
+        return range;
+    }
+
+    uint32_t newPage(Kind kind, size_t elements, GLenum target, bool sharedPage, const std::string &owner)
+    {
+        uint32_t p = 0;
+        while (p < pages.size() && pages[p].buffer)
+            ++p;
+        if (p == pages.size())
+            pages.push_back(Page());
+        Page &page = pages[p];
+        page.kind = kind;
+        page.shared = sharedPage;
+        page.rangeCount = 0;
+        page.emptyFrames = 0;
+        page.ranges.reset(elements);
+        const size_t bytes = elements * elementBytes(kind);
+        page.buffer = GlBuffer::create();
+        glBindBuffer(target, page.buffer.get());
+        glBufferData(target, (GLsizeiptr)bytes, NULL, GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(page.buffer.get(), GpuMemory::MODEL_GEOMETRY, bytes, sharedPage ? std::string("geometry arena") : owner);
+        if (sharedPage)
+            LOG_INFO("[GeometryArena] New " << kindName(kind) << " page of " << bytes / 1024 << " KiB");
+        return p;
+    }
+
+    void deletePage(uint32_t p)
+    {
+        Page &page = pages[p];
+        page.buffer.reset();
+        page.ranges.reset(0);
+    }
+};
+
+inline GeometryArena &geometryArena()
+{
+    static GeometryArena arena;
+    return arena;
+}
+
+#endif
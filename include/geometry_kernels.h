@@ -0,0 +1,443 @@
+#ifndef GEOMETRY_KERNELS_H
+#define GEOMETRY_KERNELS_H
+
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GEOMETRY_KERNELS_SSE2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC compiles AVX2 intrinsics in any function; the dispatch decides whether they run
+#define GEOMETRY_KERNELS_AVX2_TARGET
+#else
+#define GEOMETRY_KERNELS_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+// The vertex loops of import and placement: AABB + centroid reduction, bounding radius, and transforming
+// points and directions by a matrix. They work on streams of xyz floats `stride` bytes apart, which covers
+// the packed float3 arrays of Assimp and glTF and the VertexStreams they fill (stride 12), glTF's float4
+// tangents (stride 16) and placed positions, so nothing is copied into another layout first.
+// Each point sits in one SSE register (x, y, z, 0); the AVX2 kernels take two points per instruction with
+// FMA for the transforms. The level is picked once at startup from CPUID (and the OS saving the AVX state);
+// GEOMETRY_KERNELS=scalar|sse2|avx2 caps it, for comparing. The results match the scalar glm code up to float
+// rounding (FMA rounds once where glm rounds twice).
+// addBoxSums is the row step of the box filter that shrinks oversized HDRIs (environment_loader.h); it has an
+// SSE2 body for factors 2 and 4n, which the AVX2 level shares.
+namespace GeometryKernels
+{
+
+enum Level { SCALAR, SSE2, AVX2 };
+
+struct Table
+{
+    Level level;
+    void (*boundsAndSum)(const float *xyz, size_t stride, size_t count, glm::vec3 &bmin, glm::vec3 &bmax, glm::vec3 &sum);
+    float (*maxDistance2)(const float *xyz, size_t stride, size_t count, const glm::vec3 &centre);
+    void (*transformPoints)(const glm::mat4 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count);
+    void (*transformDirections)(const glm::mat3 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count, bool normalize);
+    void (*addBoxSums)(const float *in, size_t count, int factor, float *out);
+};
+
+inline const float *at(const float *xyz, size_t stride, size_t i) { return (const float *)((const char *)xyz + i * stride); }
+inline float *at(float *xyz, size_t stride, size_t i) { return (float *)((char *)xyz + i * stride); }
+
+// ---- scalar: the reference (and the only path off x86) ----
+
+inline void boundsAndSumScalar(const float *xyz, size_t stride, size_t count, glm::vec3 &bmin, glm::vec3 &bmax, glm::vec3 &sum)
+{
+    bmin = glm::vec3(FLT_MAX);
+    bmax = glm::vec3(-FLT_MAX);
+    sum = glm::vec3(0.0f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(xyz, stride, i);
+        const glm::vec3 v(p[0], p[1], p[2]);
+        bmin = glm::min(bmin, v);
+        bmax = glm::max(bmax, v);
+        sum += v;
+    }
+}
+
+inline float maxDistance2Scalar(const float *xyz, size_t stride, size_t count, const glm::vec3 &centre)
+{
+    float r2 = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(xyz, stride, i);
+        const glm::vec3 d = glm::vec3(p[0], p[1], p[2]) - centre;
+        r2 = glm::max(r2, glm::dot(d, d));
+    }
+    return r2;
+}
+
+inline void transformPointsScalar(const glm::mat4 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(in, inStride, i);
+        const glm::vec3 v = glm::vec3(m * glm::vec4(p[0], p[1], p[2], 1.0f));
+        float *o = at(out, outStride, i);
+        o[0] = v.x; o[1] = v.y; o[2] = v.z;
+    }
+}
+
+inline void transformDirectionsScalar(const glm::mat3 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count, bool normalize)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(in, inStride, i);
+        glm::vec3 v = m * glm::vec3(p[0], p[1], p[2]);
+        if (normalize)
+            v = glm::normalize(v);
+        float *o = at(out, outStride, i);
+        o[0] = v.x; o[1] = v.y; o[2] = v.z;
+    }
+}
+
+inline void addBoxSumsScalar(const float *in, size_t count, int factor, float *out)
+{
+    for (size_t x = 0; x < count; ++x, in += factor)
+    {
+        float sum = 0.0f;
+        for (int j = 0; j < factor; ++j)
+            sum += in[j];
+        out[x] += sum;
+    }
+}
+
+#if defined(GEOMETRY_KERNELS_SSE2)
+
+// ---- SSE2: one point per register ----
+
+// (x, y, z, 0); the last point of a packed stream has nothing readable after z, so it's loaded per lane
+inline __m128 loadPoint(const float *p, bool last)
+{
+    if (last)
+        return _mm_set_ps(0.0f, p[2], p[1], p[0]);
+    return _mm_and_ps(_mm_loadu_ps(p), _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+}
+
+// writes x, y, z only: the fourth float belongs to the next field or point
+inline void storePoint(float *p, __m128 v)
+{
+    _mm_storel_pi((__m64 *)p, v);
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+inline void boundsAndSumSse2(const float *xyz, size_t stride, size_t count, glm::vec3 &bmin, glm::vec3 &bmax, glm::vec3 &sum)
+{
+    __m128 lo = _mm_set1_ps(FLT_MAX), hi = _mm_set1_ps(-FLT_MAX), acc = _mm_setzero_ps();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const __m128 v = loadPoint(at(xyz, stride, i), i + 1 == count);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+        acc = _mm_add_ps(acc, v);
+    }
+    float l[4], h[4], s[4];
+    _mm_storeu_ps(l, lo);
+    _mm_storeu_ps(h, hi);
+    _mm_storeu_ps(s, acc);
+    bmin = glm::vec3(l[0], l[1], l[2]);
+    bmax = glm::vec3(h[0], h[1], h[2]);
+    sum = glm::vec3(s[0], s[1], s[2]);
+}
+
+inline float horizontalMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_max_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(v);
+}
+
+inline float maxDistance2Sse2(const float *xyz, size_t stride, size_t count, const glm::vec3 &centre)
+{
+    const __m128 c = _mm_set_ps(0.0f, centre.z, centre.y, centre.x);
+    __m128 r2 = _mm_setzero_ps();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const __m128 d = _mm_sub_ps(loadPoint(at(xyz, stride, i), i + 1 == count), c);
+        const __m128 d2 = _mm_mul_ps(d, d);
+        // x + y + z in lane 0
+        const __m128 dot = _mm_add_ss(_mm_add_ss(d2, _mm_shuffle_ps(d2, d2, 1)), _mm_movehl_ps(d2, d2));
+        r2 = _mm_max_ss(r2, dot);
+    }
+    return _mm_cvtss_f32(r2);
+}
+
+inline void transformPointsSse2(const glm::mat4 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count)
+{
+    const __m128 c0 = _mm_loadu_ps(&m[0][0]), c1 = _mm_loadu_ps(&m[1][0]), c2 = _mm_loadu_ps(&m[2][0]), c3 = _mm_loadu_ps(&m[3][0]);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(in, inStride, i);
+        __m128 v = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+        v = _mm_add_ps(v, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+        storePoint(at(out, outStride, i), v);
+    }
+}
+
+inline __m128 normalize3(__m128 v)
+{
+    const __m128 v2 = _mm_mul_ps(v, v);
+    const __m128 dot = _mm_add_ss(_mm_add_ss(v2, _mm_shuffle_ps(v2, v2, 1)), _mm_movehl_ps(v2, v2));
+    // a true division, as glm::normalize: rsqrt's 12 bits would show in the shading
+    return _mm_div_ps(v, _mm_shuffle_ps(_mm_sqrt_ss(dot), _mm_sqrt_ss(dot), 0));
+}
+
+inline void transformDirectionsSse2(const glm::mat3 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count, bool normalize)
+{
+    const __m128 c0 = _mm_set_ps(0.0f, m[0][2], m[0][1], m[0][0]);
+    const __m128 c1 = _mm_set_ps(0.0f, m[1][2], m[1][1], m[1][0]);
+    const __m128 c2 = _mm_set_ps(0.0f, m[2][2], m[2][1], m[2][0]);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float *p = at(in, inStride, i);
+        __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))), _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+        if (normalize)
+            v = normalize3(v);
+        storePoint(at(out, outStride, i), v);
+    }
+}
+
+// four outputs per register: factor 2 splits eight inputs into even and odd lanes; factor 4n sums each
+// output's inputs a register at a time and transposes the four partial sums into one register
+inline void addBoxSumsSse2(const float *in, size_t count, int factor, float *out)
+{
+    size_t x = 0;
+    if (factor == 2)
+        for (; x + 4 <= count; x += 4)
+        {
+            const __m128 a = _mm_loadu_ps(in + x * 2), b = _mm_loadu_ps(in + x * 2 + 4);
+            const __m128 sum = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+            _mm_storeu_ps(out + x, _mm_add_ps(_mm_loadu_ps(out + x), sum));
+        }
+    else if (factor % 4 == 0)
+        for (; x + 4 <= count; x += 4)
+        {
+            __m128 s[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                const float *p = in + (x + i) * factor;
+                s[i] = _mm_loadu_ps(p);
+                for (int j = 4; j < factor; j += 4)
+                    s[i] = _mm_add_ps(s[i], _mm_loadu_ps(p + j));
+            }
+            _MM_TRANSPOSE4_PS(s[0], s[1], s[2], s[3]);
+            const __m128 sum = _mm_add_ps(_mm_add_ps(s[0], s[1]), _mm_add_ps(s[2], s[3]));
+            _mm_storeu_ps(out + x, _mm_add_ps(_mm_loadu_ps(out + x), sum));
+        }
+    addBoxSumsScalar(in + x * factor, count - x, factor, out + x);
+}
+
+// ---- AVX2 + FMA: two points per register, one in each 128-bit half ----
+
+GEOMETRY_KERNELS_AVX2_TARGET inline __m256 loadPointPair(const float *a, const float *b, bool bLast)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(loadPoint(a, false)), loadPoint(b, bLast), 1);
+}
+
+GEOMETRY_KERNELS_AVX2_TARGET inline void boundsAndSumAvx2(const float *xyz, size_t stride, size_t count, glm::vec3 &bmin, glm::vec3 &bmax, glm::vec3 &sum)
+{
+    __m256 lo = _mm256_set1_ps(FLT_MAX), hi = _mm256_set1_ps(-FLT_MAX), acc = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 v = loadPointPair(at(xyz, stride, i), at(xyz, stride, i + 1), i + 2 == count);
+        lo = _mm256_min_ps(lo, v);
+        hi = _mm256_max_ps(hi, v);
+        acc = _mm256_add_ps(acc, v);
+    }
+    __m128 l = _mm_min_ps(_mm256_castps256_ps128(lo), _mm256_extractf128_ps(lo, 1));
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(hi), _mm256_extractf128_ps(hi, 1));
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    if (i < count)
+    {
+        const __m128 v = loadPoint(at(xyz, stride, i), true);
+        l = _mm_min_ps(l, v);
+        h = _mm_max_ps(h, v);
+        s = _mm_add_ps(s, v);
+    }
+    float lf[4], hf[4], sf[4];
+    _mm_storeu_ps(lf, l);
+    _mm_storeu_ps(hf, h);
+    _mm_storeu_ps(sf, s);
+    bmin = glm::vec3(lf[0], lf[1], lf[2]);
+    bmax = glm::vec3(hf[0], hf[1], hf[2]);
+    sum = glm::vec3(sf[0], sf[1], sf[2]);
+}
+
+GEOMETRY_KERNELS_AVX2_TARGET inline float maxDistance2Avx2(const float *xyz, size_t stride, size_t count, const glm::vec3 &centre)
+{
+    const __m256 c = _mm256_set_ps(0.0f, centre.z, centre.y, centre.x, 0.0f, centre.z, centre.y, centre.x);
+    __m256 r2 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 d = _mm256_sub_ps(loadPointPair(at(xyz, stride, i), at(xyz, stride, i + 1), i + 2 == count), c);
+        const __m256 d2 = _mm256_mul_ps(d, d);
+        // every lane of each half ends up with its x + y + z
+        __m256 dot = _mm256_add_ps(d2, _mm256_permute_ps(d2, _MM_SHUFFLE(2, 3, 0, 1)));
+        dot = _mm256_add_ps(dot, _mm256_permute_ps(dot, _MM_SHUFFLE(1, 0, 3, 2)));
+        r2 = _mm256_max_ps(r2, dot);
+    }
+    float result = horizontalMax(_mm_max_ps(_mm256_castps256_ps128(r2), _mm256_extractf128_ps(r2, 1)));
+    if (i < count)
+        result = std::max(result, maxDistance2Sse2(at(xyz, stride, i), stride, 1, centre));
+    return result;
+}
+
+GEOMETRY_KERNELS_AVX2_TARGET inline void transformPointsAvx2(const glm::mat4 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count)
+{
+    const __m256 c0 = _mm256_broadcast_ps((const __m128 *)&m[0][0]), c1 = _mm256_broadcast_ps((const __m128 *)&m[1][0]);
+    const __m256 c2 = _mm256_broadcast_ps((const __m128 *)&m[2][0]), c3 = _mm256_broadcast_ps((const __m128 *)&m[3][0]);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 p = loadPointPair(at(in, inStride, i), at(in, inStride, i + 1), i + 2 == count);
+        __m256 v = _mm256_fmadd_ps(c0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)), c3);
+        v = _mm256_fmadd_ps(c1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1)), v);
+        v = _mm256_fmadd_ps(c2, _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2)), v);
+        storePoint(at(out, outStride, i), _mm256_castps256_ps128(v));
+        storePoint(at(out, outStride, i + 1), _mm256_extractf128_ps(v, 1));
+    }
+    if (i < count)
+        transformPointsSse2(m, at(in, inStride, i), inStride, at(out, outStride, i), outStride, 1);
+}
+
+GEOMETRY_KERNELS_AVX2_TARGET inline void transformDirectionsAvx2(const glm::mat3 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count, bool normalize)
+{
+    const __m256 c0 = _mm256_set_ps(0.0f, m[0][2], m[0][1], m[0][0], 0.0f, m[0][2], m[0][1], m[0][0]);
+    const __m256 c1 = _mm256_set_ps(0.0f, m[1][2], m[1][1], m[1][0], 0.0f, m[1][2], m[1][1], m[1][0]);
+    const __m256 c2 = _mm256_set_ps(0.0f, m[2][2], m[2][1], m[2][0], 0.0f, m[2][2], m[2][1], m[2][0]);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256 p = loadPointPair(at(in, inStride, i), at(in, inStride, i + 1), i + 2 == count);
+        __m256 v = _mm256_mul_ps(c0, _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0)));
+        v = _mm256_fmadd_ps(c1, _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1)), v);
+        v = _mm256_fmadd_ps(c2, _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2)), v);
+        if (normalize)
+        {
+            const __m256 v2 = _mm256_mul_ps(v, v);
+            __m256 dot = _mm256_add_ps(v2, _mm256_permute_ps(v2, _MM_SHUFFLE(2, 3, 0, 1)));
+            dot = _mm256_add_ps(dot, _mm256_permute_ps(dot, _MM_SHUFFLE(1, 0, 3, 2)));
+            v = _mm256_div_ps(v, _mm256_sqrt_ps(dot));
+        }
+        storePoint(at(out, outStride, i), _mm256_castps256_ps128(v));
+        storePoint(at(out, outStride, i + 1), _mm256_extractf128_ps(v, 1));
+    }
+    if (i < count)
+        transformDirectionsSse2(m, at(in, inStride, i), inStride, at(out, outStride, i), outStride, 1, normalize);
+}
+
+// AVX2 and FMA in the CPU, and AVX state saved by the OS (XCR0 bits 1-2)
+inline bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0, fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave || !fma || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // GEOMETRY_KERNELS_SSE2
+
+inline Table makeTable()
+{
+    Level best = SCALAR;
+#if defined(GEOMETRY_KERNELS_SSE2)
+    best = cpuHasAvx2() ? AVX2 : SSE2;
+#endif
+    if (const char *env = std::getenv("GEOMETRY_KERNELS"))
+    {
+        const std::string cap = env;
+        const Level limit = cap == "scalar" ? SCALAR : cap == "sse2" ? SSE2 : AVX2;
+        best = best < limit ? best : limit;
+    }
+    Table t = {SCALAR, boundsAndSumScalar, maxDistance2Scalar, transformPointsScalar, transformDirectionsScalar, addBoxSumsScalar};
+#if defined(GEOMETRY_KERNELS_SSE2)
+    if (best == SSE2)
+        t = Table{SSE2, boundsAndSumSse2, maxDistance2Sse2, transformPointsSse2, transformDirectionsSse2, addBoxSumsSse2};
+    else if (best == AVX2)
+        t = Table{AVX2, boundsAndSumAvx2, maxDistance2Avx2, transformPointsAvx2, transformDirectionsAvx2, addBoxSumsSse2};
+#endif
+    LOG_DEBUG("[Geometry] Vertex kernels: " << (t.level == AVX2 ? "AVX2" : t.level == SSE2 ? "SSE2" : "scalar"));
+    return t;
+}
+
+inline const Table &table()
+{
+    static const Table t = makeTable();
+    return t;
+}
+
+// min, max and sum of `count` points (bmin = FLT_MAX, bmax = -FLT_MAX, sum = 0 for none)
+inline void boundsAndSum(const float *xyz, size_t stride, size_t count, glm::vec3 &bmin, glm::vec3 &bmax, glm::vec3 &sum)
+{
+    table().boundsAndSum(xyz, stride, count, bmin, bmax, sum);
+}
+
+// largest squared distance of the points from `centre` (bounding sphere radius^2)
+inline float maxDistance2(const float *xyz, size_t stride, size_t count, const glm::vec3 &centre)
+{
+    return table().maxDistance2(xyz, stride, count, centre);
+}
+
+// out = (m * (in, 1)).xyz; `out` may be `in`
+inline void transformPoints(const glm::mat4 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count)
+{
+    table().transformPoints(m, in, inStride, out, outStride, count);
+}
+
+// out = m * in, normalized if asked (as glm::normalize: a zero vector becomes NaN); `out` may be `in`
+inline void transformDirections(const glm::mat3 &m, const float *in, size_t inStride, float *out, size_t outStride, size_t count, bool normalize)
+{
+    table().transformDirections(m, in, inStride, out, outStride, count, normalize);
+}
+
+// out[x] += in[x * factor] + ... + in[x * factor + factor - 1] for x in [0, count): `count` box sums of a row
+inline void addBoxSums(const float *in, size_t count, int factor, float *out)
+{
+    table().addBoxSums(in, count, factor, out);
+}
+
+// AABB of the box [bmin, bmax] under `m` (the bounds of its eight transformed corners)
+inline void transformBounds(const glm::mat4 &m, const glm::vec3 &bmin, const glm::vec3 &bmax, glm::vec3 &outMin, glm::vec3 &outMax)
+{
+    float corners[8][3];
+    for (int c = 0; c < 8; ++c)
+    {
+        corners[c][0] = (c & 1) ? bmax.x : bmin.x;
+        corners[c][1] = (c & 2) ? bmax.y : bmin.y;
+        corners[c][2] = (c & 4) ? bmax.z : bmin.z;
+    }
+    transformPoints(m, &corners[0][0], sizeof(corners[0]), &corners[0][0], sizeof(corners[0]), 8);
+    glm::vec3 sum;
+    boundsAndSum(&corners[0][0], sizeof(corners[0]), 8, outMin, outMax, sum);
+}
+
+} // namespace GeometryKernels
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef GL_BACKEND_H
+#define GL_BACKEND_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+
+#include <cstdlib>
+#include <string>
+
+// How GL objects get created and modified. On a GL 4.5 driver the direct state access path names the
+// object in each call (glCreateTextures, glTextureStorage2D, glNamedBufferStorage, glVertexArrayVertexBuffer,
+// glNamedFramebufferTexture, glBindTextureUnit), so defining a texture, a buffer or a vertex layout binds
+// nothing and disturbs nothing the renderer has bound. Otherwise (or with GL_DSA=0) the same calls bind
+// the object first, as GL 3.3 requires; code that uses the bind path must leave glState() valid (the
+// texture binds here go through it). init() picks the path once the functions are loaded; until then,
+// and in tools that never call it, everything takes the bind path.
+class GlBackend
+{
+public:
+    // GL thread, after gladLoadGLLoader
+    void init()
+    {
+        const char *env = std::getenv("GL_DSA");
+        direct = GLAD_GL_VERSION_4_5 && glCreateTextures != NULL && !(env && std::string(env) == "0");
+        glState().setDirectStateAccess(direct);
+        LOG_INFO("[GlBackend] " << (direct ? "direct state access (GL 4.5)" : "bind-to-edit (GL 3.3)"));
+    }
+
+    bool dsa() const { return direct; }
+
+    // a texture of `target`; on the bind path the name only becomes an object when first bound
+    GLuint createTexture(GLenum target) const
+    {
+        GLuint texture = 0;
+        if (direct)
+            glCreateTextures(target, 1, &texture);
+        else
+            glGenTextures(1, &texture);
+        return texture;
+    }
+
+    // immutable storage for `levels` levels (all six faces of a cube map); needs GL 4.2 on the bind path
+    void textureStorage2D(GLuint texture, GLenum target, GLsizei levels, GLenum internalFormat, GLsizei width, GLsizei height) const
+    {
+        if (direct)
+            glTextureStorage2D(texture, levels, internalFormat, width, height);
+        else
+        {
+            bind(target, texture);
+            glTexStorage2D(target, levels, internalFormat, width, height);
+        }
+    }
+
+    void textureParameter(GLuint texture, GLenum target, GLenum name, GLint value) const
+    {
+        if (direct)
+            glTextureParameteri(texture, name, value);
+        else
+        {
+            bind(target, texture);
+            glTexParameteri(target, name, value);
+        }
+    }
+
+    void generateMipmap(GLuint texture, GLenum target) const
+    {
+        if (direct)
+            glGenerateTextureMipmap(texture);
+        else
+        {
+            bind(target, texture);
+            glGenerateMipmap(target);
+        }
+    }
+
+    GLuint createFramebuffer() const
+    {
+        GLuint fbo = 0;
+        if (direct)
+            glCreateFramebuffers(1, &fbo);
+        else
+            glGenFramebuffers(1, &fbo);
+        return fbo;
+    }
+
+    GLuint createVertexArray() const
+    {
+        GLuint vao = 0;
+        if (direct)
+            glCreateVertexArrays(1, &vao);
+        else
+            glGenVertexArrays(1, &vao);
+        return vao;
+    }
+
+    GLuint createBuffer() const
+    {
+        GLuint buffer = 0;
+        if (direct)
+            glCreateBuffers(1, &buffer);
+        else
+            glGenBuffers(1, &buffer);
+        return buffer;
+    }
+
+    // contents of a buffer that is written once: immutable storage on the direct path, GL_STATIC_DRAW data
+    // through `target` on the bind path (which leaves the buffer bound there)
+    void bufferStorage(GLuint buffer, GLenum target, GLsizeiptr size, const void *data) const
+    {
+        if (direct)
+            glNamedBufferStorage(buffer, size, data, 0);
+        else
+        {
+            glBindBuffer(target, buffer);
+            glBufferData(target, size, data, GL_STATIC_DRAW);
+        }
+    }
+
+    // (re)specifies a buffer's contents with `usage`, through `target` on the bind path
+    void bufferData(GLuint buffer, GLenum target, GLsizeiptr size, const void *data, GLenum usage) const
+    {
+        if (direct)
+            glNamedBufferData(buffer, size, data, usage);
+        else
+        {
+            glBindBuffer(target, buffer);
+            glBufferData(target, size, data, usage);
+        }
+    }
+
+    // `level` of `texture` (every layer of a cube map) as `attachment` of `fbo`; the bind path leaves
+    // `fbo` bound as the framebuffer
+    void framebufferTexture(GLuint fbo, GLenum attachment, GLuint texture, GLint level) const
+    {
+        if (direct)
+            glNamedFramebufferTexture(fbo, attachment, texture, level);
+        else
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glFramebufferTexture(GL_FRAMEBUFFER, attachment, texture, level);
+        }
+    }
+
+private:
+    bool direct = false;
+
+    // the bind path edits through unit 0, which the loaders and bakes use for this anyway
+    static void bind(GLenum target, GLuint texture) { glState().bindTexture(0, target, texture); }
+};
+
+// one GL context (the upload thread's shares its objects and version), so one process-wide choice
+inline GlBackend &glBackend()
+{
+    static GlBackend backend;
+    return backend;
+}
+
+#endif
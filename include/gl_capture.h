@@ -0,0 +1,1835 @@
+#ifndef GL_CAPTURE_H
+#define GL_CAPTURE_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One frame's GL command stream, recorded from inside the viewer for offline replay (GL_CAPTURE=<file>,
+// GL_CAPTURE_FRAME=N picks the frame, default 120). The recorder swaps glad's function pointers for
+// wrappers for the length of that frame, so every call the renderer makes on the GL thread goes to the
+// file with its arguments and any client memory it passes (uniform arrays, buffer and texture uploads);
+// other threads (the upload thread) pass through. Around it the file holds
+//   - the objects the frame used but didn't create, read back after the frame: buffer contents, texture
+//     levels, renderbuffer storage, vertex array and framebuffer setup, and programs (their shaders'
+//     sources, or the driver's binary for programs that came from the shader cache, with the values of
+//     their uniforms), and
+//   - a prologue of state calls that re-establish what was bound and enabled when the frame began.
+// tools/car_replay.cpp plays the prologue and the frame back in a loop and times them, so a frame can be
+// profiled away from the application, A/B'd between drivers or machines, and driver overhead told from
+// app overhead. The replay reproduces the frame's work, not its exact image: objects come back with the
+// contents they had at the end of the frame, queries, syncs and read-backs aren't recorded, and the
+// encoding is the recording machine's (same architecture, pointer size and endianness to replay).
+namespace glcapture
+{
+    static const uint32_t MAGIC = 0x50434c47; // "GLCP"
+    static const uint32_t VERSION = 1;
+
+    // the kinds of GL names, as letters in the scalar calls' name specs below
+    enum NameKind
+    {
+        TEXTURE,
+        BUFFER,
+        FRAMEBUFFER,
+        RENDERBUFFER,
+        VERTEX_ARRAY,
+        PROGRAM,
+        NAME_KINDS
+    };
+
+    // 'T' texture, 'B' buffer, 'F' framebuffer, 'R' renderbuffer, 'V' vertex array, 'P' program; -1 for
+    // '.' (a plain value) and 'L' (a uniform location of the program in use)
+    inline int nameKind(char letter)
+    {
+        switch (letter)
+        {
+        case 'T': return TEXTURE;
+        case 'B': return BUFFER;
+        case 'F': return FRAMEBUFFER;
+        case 'R': return RENDERBUFFER;
+        case 'V': return VERTEX_ARRAY;
+        case 'P': return PROGRAM;
+        default: return -1;
+        }
+    }
+
+    // Calls whose arguments are all values: recorded as the arguments' bytes, replayed through the same
+    // glad pointer. The third column has one letter per argument saying which are GL names (nameKind), so
+    // the replay can map them to its own. Pointer arguments here are offsets into a bound buffer.
+#define GL_CAPTURE_SCALAR_CALLS(X)                                                                  \
+    X(ENABLE, glEnable, ".")                                                                        \
+    X(DISABLE, glDisable, ".")                                                                      \
+    X(BLEND_FUNC, glBlendFunc, "..")                                                                \
+    X(BLEND_FUNC_SEPARATE, glBlendFuncSeparate, "....")                                             \
+    X(BLEND_EQUATION, glBlendEquation, ".")                                                         \
+    X(DEPTH_FUNC, glDepthFunc, ".")                                                                 \
+    X(DEPTH_MASK, glDepthMask, ".")                                                                 \
+    X(COLOR_MASK, glColorMask, "....")                                                              \
+    X(CULL_FACE, glCullFace, ".")                                                                   \
+    X(FRONT_FACE, glFrontFace, ".")                                                                 \
+    X(VIEWPORT, glViewport, "....")                                                                 \
+    X(SCISSOR, glScissor, "....")                                                                   \
+    X(CLEAR, glClear, ".")                                                                          \
+    X(CLEAR_COLOR, glClearColor, "....")                                                            \
+    X(CLEAR_DEPTH, glClearDepth, ".")                                                               \
+    X(STENCIL_FUNC, glStencilFunc, "...")                                                           \
+    X(STENCIL_OP, glStencilOp, "...")                                                               \
+    X(STENCIL_MASK, glStencilMask, ".")                                                             \
+    X(POLYGON_MODE, glPolygonMode, "..")                                                            \
+    X(POLYGON_OFFSET, glPolygonOffset, "..")                                                        \
+    X(PIXEL_STOREI, glPixelStorei, "..")                                                            \
+    X(ACTIVE_TEXTURE, glActiveTexture, ".")                                                         \
+    X(BIND_TEXTURE, glBindTexture, ".T")                                                            \
+    X(BIND_TEXTURE_UNIT, glBindTextureUnit, ".T")                                                   \
+    X(BIND_BUFFER, glBindBuffer, ".B")                                                              \
+    X(BIND_BUFFER_BASE, glBindBufferBase, "..B")                                                    \
+    X(BIND_BUFFER_RANGE, glBindBufferRange, "..B..")                                                \
+    X(BIND_FRAMEBUFFER, glBindFramebuffer, ".F")                                                    \
+    X(BIND_RENDERBUFFER, glBindRenderbuffer, ".R")                                                  \
+    X(BIND_VERTEX_ARRAY, glBindVertexArray, "V")                                                    \
+    X(USE_PROGRAM, glUseProgram, "P")                                                               \
+    X(BIND_IMAGE_TEXTURE, glBindImageTexture, ".T.....")                                            \
+    X(TEX_PARAMETERI, glTexParameteri, "...")                                                       \
+    X(TEX_PARAMETERF, glTexParameterf, "...")                                                       \
+    X(TEXTURE_PARAMETERI, glTextureParameteri, "T..")                                               \
+    X(GENERATE_MIPMAP, glGenerateMipmap, ".")                                                       \
+    X(GENERATE_TEXTURE_MIPMAP, glGenerateTextureMipmap, "T")                                        \
+    X(TEX_STORAGE_2D, glTexStorage2D, ".....")                                                      \
+    X(TEX_STORAGE_3D, glTexStorage3D, "......")                                                     \
+    X(TEXTURE_STORAGE_2D, glTextureStorage2D, "T....")                                              \
+    X(TEX_BUFFER, glTexBuffer, "..B")                                                               \
+    X(FRAMEBUFFER_TEXTURE, glFramebufferTexture, "..T.")                                            \
+    X(FRAMEBUFFER_TEXTURE_2D, glFramebufferTexture2D, "...T.")                                      \
+    X(FRAMEBUFFER_TEXTURE_LAYER, glFramebufferTextureLayer, "..T..")                                \
+    X(NAMED_FRAMEBUFFER_TEXTURE, glNamedFramebufferTexture, "F.T.")                                 \
+    X(FRAMEBUFFER_RENDERBUFFER, glFramebufferRenderbuffer, "...R")                                  \
+    X(RENDERBUFFER_STORAGE, glRenderbufferStorage, "....")                                          \
+    X(DRAW_BUFFER, glDrawBuffer, ".")                                                               \
+    X(READ_BUFFER, glReadBuffer, ".")                                                               \
+    X(BLIT_FRAMEBUFFER, glBlitFramebuffer, "..........")                                            \
+    X(COPY_BUFFER_SUB_DATA, glCopyBufferSubData, ".....")                                           \
+    X(VERTEX_ATTRIB_POINTER, glVertexAttribPointer, "......")                                       \
+    X(VERTEX_ATTRIB_I_POINTER, glVertexAttribIPointer, ".....")                                     \
+    X(VERTEX_ATTRIB_DIVISOR, glVertexAttribDivisor, "..")                                           \
+    X(ENABLE_VERTEX_ATTRIB_ARRAY, glEnableVertexAttribArray, ".")                                   \
+    X(DISABLE_VERTEX_ATTRIB_ARRAY, glDisableVertexAttribArray, ".")                                 \
+    X(VERTEX_ATTRIB_I4UI, glVertexAttribI4ui, ".....")                                              \
+    X(VERTEX_ARRAY_VERTEX_BUFFER, glVertexArrayVertexBuffer, "V.B..")                               \
+    X(VERTEX_ARRAY_ELEMENT_BUFFER, glVertexArrayElementBuffer, "VB")                                \
+    X(VERTEX_ARRAY_ATTRIB_BINDING, glVertexArrayAttribBinding, "V..")                               \
+    X(VERTEX_ARRAY_ATTRIB_FORMAT, glVertexArrayAttribFormat, "V.....")                              \
+    X(VERTEX_ARRAY_ATTRIB_I_FORMAT, glVertexArrayAttribIFormat, "V....")                            \
+    X(VERTEX_ARRAY_BINDING_DIVISOR, glVertexArrayBindingDivisor, "V..")                             \
+    X(ENABLE_VERTEX_ARRAY_ATTRIB, glEnableVertexArrayAttrib, "V.")                                  \
+    X(DRAW_ARRAYS, glDrawArrays, "...")                                                             \
+    X(DRAW_ARRAYS_INSTANCED, glDrawArraysInstanced, "....")                                         \
+    X(DRAW_ELEMENTS, glDrawElements, "....")                                                        \
+    X(DRAW_ELEMENTS_BASE_VERTEX, glDrawElementsBaseVertex, ".....")                                 \
+    X(DRAW_ELEMENTS_INSTANCED, glDrawElementsInstanced, ".....")                                    \
+    X(DRAW_ELEMENTS_INSTANCED_BASE_VERTEX, glDrawElementsInstancedBaseVertex, "......")             \
+    X(DRAW_ELEMENTS_INSTANCED_BASE_VERTEX_BASE_INSTANCE, glDrawElementsInstancedBaseVertexBaseInstance, ".......") \
+    X(DRAW_ELEMENTS_INDIRECT, glDrawElementsIndirect, "...")                                        \
+    X(MULTI_DRAW_ELEMENTS_INDIRECT, glMultiDrawElementsIndirect, ".....")                           \
+    X(MULTI_DRAW_ELEMENTS_INDIRECT_COUNT, glMultiDrawElementsIndirectCount, "......")               \
+    X(DISPATCH_COMPUTE, glDispatchCompute, "...")                                                   \
+    X(DISPATCH_COMPUTE_INDIRECT, glDispatchComputeIndirect, ".")                                    \
+    X(MEMORY_BARRIER, glMemoryBarrier, ".")                                                         \
+    X(UNIFORM_1I, glUniform1i, "L.")                                                                \
+    X(UNIFORM_2I, glUniform2i, "L..")                                                               \
+    X(UNIFORM_1UI, glUniform1ui, "L.")                                                              \
+    X(UNIFORM_1F, glUniform1f, "L.")                                                                \
+    X(UNIFORM_2F, glUniform2f, "L..")                                                               \
+    X(UNIFORM_3F, glUniform3f, "L...")                                                              \
+    X(UNIFORM_4F, glUniform4f, "L....")                                                             \
+    X(UNIFORM_BLOCK_BINDING, glUniformBlockBinding, "P..")
+
+    // Everything in the file is one of these (uint16) followed by its operands. The calls that carry client
+    // memory, create names or map buffers have their own layouts, written by GlCapture's hooks and read by
+    // car_replay in the same order, noted here.
+    enum Op : uint16_t
+    {
+#define GL_CAPTURE_OP(op, function, names) op,
+        GL_CAPTURE_SCALAR_CALLS(GL_CAPTURE_OP)
+#undef GL_CAPTURE_OP
+        SCALAR_CALL_COUNT,
+        // uint8 shape (1..4 components, or 0x22 / 0x33 / 0x44 for a matrix), int32 location, int32 count,
+        // uint8 transpose, the floats
+        UNIFORM_FLOATS = SCALAR_CALL_COUNT,
+        // enum target, int64 size, enum usage (or storage flags), bytes (uint64 length 0 without data)
+        BUFFER_DATA,
+        BUFFER_STORAGE,
+        // uint32 buffer, int64 size, enum usage / storage flags, bytes
+        NAMED_BUFFER_DATA,
+        NAMED_BUFFER_STORAGE,
+        // enum target, int64 offset, bytes
+        BUFFER_SUB_DATA,
+        // uint32 buffer, int64 offset, bytes
+        NAMED_BUFFER_SUB_DATA,
+        // enum target, int64 offset, bytes: what the frame wrote through a mapping, at its unmap
+        MAPPED_WRITE,
+        // the glTex*/glCompressedTex* arguments in order, then the pixels (pixelSource below)
+        TEX_IMAGE_2D,
+        TEX_IMAGE_3D,
+        TEX_SUB_IMAGE_2D,
+        TEX_SUB_IMAGE_3D,
+        TEXTURE_SUB_IMAGE_2D,
+        COMPRESSED_TEX_IMAGE_2D,
+        COMPRESSED_TEX_IMAGE_3D,
+        COMPRESSED_TEX_SUB_IMAGE_2D,
+        COMPRESSED_TEX_SUB_IMAGE_3D,
+        COMPRESSED_TEXTURE_SUB_IMAGE_2D,
+        // int32 n, the enums
+        DRAW_BUFFERS,
+        // uint8 0 float / 1 int / 2 uint, enum buffer, int32 draw buffer, 4 x 32 bits
+        CLEAR_BUFFER,
+        // enum mode, enum type, int32 draw count, then per draw int32 count, uint64 offset, int32 base vertex
+        MULTI_DRAW_ELEMENTS_BASE_VERTEX,
+        // enum target, enum pname, 4 x int32
+        TEX_PARAMETER_IV,
+        // enum target, enum internal format, enum format, enum type, bytes (one element, or none)
+        CLEAR_BUFFER_DATA,
+        // uint8 kind, int32 n, the names; CREATE_NAMES has an enum target (textures) before n
+        GEN_NAMES,
+        CREATE_NAMES,
+
+        // resources, before the prologue (see GlCapture::snapshotObjects for their layouts)
+        RESOURCE_BUFFER,
+        RESOURCE_TEXTURE,
+        RESOURCE_TEXTURE_BUFFER,
+        RESOURCE_RENDERBUFFER,
+        RESOURCE_PROGRAM,
+        RESOURCE_VERTEX_ARRAY,
+        RESOURCE_FRAMEBUFFER,
+        OP_COUNT
+    };
+
+    // how an upload's pixels follow its arguments: none (uint8 0), bytes (1, then uint64 length + data) or
+    // an offset into the bound GL_PIXEL_UNPACK_BUFFER (2, then uint64)
+    enum PixelSource
+    {
+        PIXELS_NONE,
+        PIXELS_BYTES,
+        PIXELS_UNPACK_OFFSET
+    };
+
+    inline const char *scalarNames(unsigned op)
+    {
+        static const char *names[SCALAR_CALL_COUNT] = {
+#define GL_CAPTURE_NAMES(op, function, names) names,
+            GL_CAPTURE_SCALAR_CALLS(GL_CAPTURE_NAMES)
+#undef GL_CAPTURE_NAMES
+        };
+        return op < SCALAR_CALL_COUNT ? names[op] : "";
+    }
+
+    inline bool isDraw(unsigned op)
+    {
+        return (op >= DRAW_ARRAYS && op <= DISPATCH_COMPUTE_INDIRECT) || op == MULTI_DRAW_ELEMENTS_BASE_VERTEX;
+    }
+
+    // bytes of a `width` x `height` x `depth` client image of `format` / `type` under the given unpack (or
+    // pack) alignment, row length and image height (0 = the image's own)
+    inline size_t imageBytes(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth, GLint alignment = 4,
+                             GLint rowLength = 0, GLint imageHeight = 0)
+    {
+        if (width <= 0 || height <= 0 || depth <= 0)
+            return 0;
+        size_t components = 4;
+        switch (format)
+        {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: components = 1; break;
+        case GL_RG: case GL_RG_INTEGER: components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: components = 3; break;
+        default: components = 4; break;
+        }
+        size_t pixel = 0;
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE: case GL_BYTE: pixel = components; break;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: pixel = components * 2; break;
+        case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+        case GL_UNSIGNED_INT_2_10_10_10_REV: pixel = 4; break;
+        case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: pixel = 8; break;
+        default: pixel = components * 4; break;
+        }
+        const size_t align = alignment > 0 ? (size_t)alignment : 1;
+        const size_t row = ((size_t)(rowLength > 0 ? rowLength : width) * pixel + align - 1) / align * align;
+        const size_t rows = (size_t)(imageHeight > 0 ? imageHeight : height);
+        // the last row and image need only their own pixels
+        return row * rows * (size_t)(depth - 1) + row * (size_t)(height - 1) + (size_t)width * pixel;
+    }
+
+    struct Writer
+    {
+        std::vector<unsigned char> bytes;
+
+        template <class T>
+        void put(T value)
+        {
+            const unsigned char *p = (const unsigned char *)&value;
+            bytes.insert(bytes.end(), p, p + sizeof(T));
+        }
+        // pointers in calls are buffer offsets
+        void put(const void *pointer) { put((uint64_t)(uintptr_t)pointer); }
+        void putBytes(const void *data, size_t size)
+        {
+            put((uint64_t)size);
+            if (size)
+                bytes.insert(bytes.end(), (const unsigned char *)data, (const unsigned char *)data + size);
+        }
+        void putString(const std::string &s) { putBytes(s.data(), s.size()); }
+        void append(const Writer &other) { bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end()); }
+    };
+
+    // reads what a Writer wrote; running off the end sets `failed` and yields zeros
+    struct Reader
+    {
+        const unsigned char *at = nullptr;
+        const unsigned char *end = nullptr;
+        bool failed = false;
+
+        Reader() {}
+        Reader(const unsigned char *data, size_t size) : at(data), end(data + size) {}
+
+        bool done() const { return at >= end; }
+        template <class T>
+        T get()
+        {
+            T value;
+            std::memset(&value, 0, sizeof(T));
+            if ((size_t)(end - at) < sizeof(T))
+            {
+                failed = true;
+                at = end;
+                return value;
+            }
+            std::memcpy(&value, at, sizeof(T));
+            at += sizeof(T);
+            return value;
+        }
+        // a putBytes run: its data (in place) and length; nullptr when empty
+        const unsigned char *getBytes(size_t &size)
+        {
+            const uint64_t length = get<uint64_t>();
+            if ((uint64_t)(end - at) < length)
+            {
+                failed = true;
+                at = end;
+                size = 0;
+                return nullptr;
+            }
+            size = (size_t)length;
+            const unsigned char *data = size ? at : nullptr;
+            at += size;
+            return data;
+        }
+        std::string getString()
+        {
+            size_t size = 0;
+            const unsigned char *data = getBytes(size);
+            return data ? std::string((const char *)data, size) : std::string();
+        }
+    };
+
+    // file header; then three sections (uint64 length + ops each): resources, prologue, frame
+    struct Header
+    {
+        uint32_t magic = MAGIC;
+        uint32_t version = VERSION;
+        int32_t width = 0, height = 0;
+        uint32_t frame = 0;
+        int32_t glMajor = 0, glMinor = 0;
+        uint32_t calls = 0;
+        uint32_t draws = 0;
+    };
+}
+
+class GlCapture;
+inline GlCapture &glCapture();
+
+class GlCapture
+{
+public:
+    GlCapture()
+    {
+        if (const char *env = std::getenv("GL_CAPTURE"))
+            path = env;
+        if (const char *env = std::getenv("GL_CAPTURE_FRAME"))
+            captureFrame = (unsigned)std::max(1, std::atoi(env));
+    }
+
+    GlCapture(const GlCapture &) = delete;
+    GlCapture &operator=(const GlCapture &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("GL_CAPTURE");
+        return env && *env;
+    }
+
+    bool enabled() const { return !path.empty(); }
+    bool recording() const { return active; }
+
+    // GL thread, at the start of every frame: on the chosen frame snapshots the bound state into the
+    // prologue and puts the hooks in
+    void beginFrame()
+    {
+        if (!enabled() || done || active || ++frames != captureFrame)
+            return;
+        thread = std::this_thread::get_id();
+        for (int k = 0; k < glcapture::NAME_KINDS; ++k)
+        {
+            referenced[k].clear();
+            created[k].clear();
+        }
+        prologue = glcapture::Writer();
+        frame = glcapture::Writer();
+        calls = draws = 0;
+        out = &prologue;
+        snapshotState();
+        out = &frame;
+        installHooks();
+        active = true;
+    }
+
+    // GL thread, after the frame's last call and before the swap: on the recorded frame takes the hooks
+    // out, reads back the objects the frame used and writes the file. `width` x `height` is the window's.
+    void endFrame(int width, int height)
+    {
+        if (!active)
+            return;
+        active = false;
+        removeHooks();
+        done = true;
+        glcapture::Writer resources;
+        snapshotObjects(resources);
+        // the read-backs bound objects around the cache
+        glState().invalidate();
+
+        glcapture::Header header;
+        header.width = width;
+        header.height = height;
+        header.frame = frames;
+        glGetIntegerv(GL_MAJOR_VERSION, &header.glMajor);
+        glGetIntegerv(GL_MINOR_VERSION, &header.glMinor);
+        header.calls = calls;
+        header.draws = draws;
+        std::ofstream file(path.c_str(), std::ios::binary);
+        file.write((const char *)&header, sizeof(header));
+        const glcapture::Writer *sections[3] = {&resources, &prologue, &frame};
+        for (int i = 0; i < 3; ++i)
+        {
+            const uint64_t length = sections[i]->bytes.size();
+            file.write((const char *)&length, sizeof(length));
+            if (length)
+                file.write((const char *)&sections[i]->bytes[0], (std::streamsize)length);
+        }
+        if (!file)
+        {
+            LOG_ERROR("[GlCapture] Cannot write '" << path << "'");
+            return;
+        }
+        size_t objects = 0;
+        for (int k = 0; k < glcapture::NAME_KINDS; ++k)
+            objects += referenced[k].size();
+        LOG_INFO("[GlCapture] Frame " << frames << ": " << calls << " calls, " << draws << " draws/dispatches, " << objects
+                                      << " objects, " << (resources.bytes.size() + frame.bytes.size()) / (1024 * 1024)
+                                      << " MB -> " << path << " (replay it with car_replay)");
+        prologue = glcapture::Writer();
+        frame = glcapture::Writer();
+    }
+
+    // the hooks' side: whether this thread's calls go to the file
+    bool recordingThread() const { return active && std::this_thread::get_id() == thread; }
+
+    template <class... A>
+    void recordCall(uint16_t op, const char *names, A... args)
+    {
+        out->put(op);
+        putArgs(args...);
+        noteArgs(names, args...);
+        ++calls;
+        if (glcapture::isDraw(op))
+            ++draws;
+    }
+
+    glcapture::Writer &stream() { return *out; }
+    void countCall(uint16_t op)
+    {
+        ++calls;
+        if (glcapture::isDraw(op))
+            ++draws;
+    }
+
+    // `name` of `kind` was used by the frame (and must be in the file unless the frame created it)
+    void noteName(int kind, GLuint name)
+    {
+        if (kind >= 0 && name)
+            referenced[kind].insert(name);
+    }
+    void noteCreated(int kind, GLsizei n, const GLuint *names)
+    {
+        for (GLsizei i = 0; names && i < n; ++i)
+            created[kind].insert(names[i]);
+    }
+    void noteTextureTarget(GLuint texture, GLenum target)
+    {
+        if (texture)
+            textureTargets[texture] = target;
+    }
+
+    // an upload's pixels (glcapture::PixelSource), `size` bytes from `pixels` unless an unpack buffer is bound
+    void putPixels(const void *pixels, size_t size)
+    {
+        GLint unpackBuffer = 0;
+        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpackBuffer);
+        if (unpackBuffer)
+        {
+            noteName(glcapture::BUFFER, (GLuint)unpackBuffer);
+            out->put((uint8_t)glcapture::PIXELS_UNPACK_OFFSET);
+            out->put(pixels);
+        }
+        else if (!pixels)
+            out->put((uint8_t)glcapture::PIXELS_NONE);
+        else
+        {
+            out->put((uint8_t)glcapture::PIXELS_BYTES);
+            out->putBytes(pixels, size);
+        }
+    }
+    // the client bytes an uncompressed upload reads under the current unpack state
+    static size_t unpackBytes(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth)
+    {
+        GLint alignment = 4, rowLength = 0, imageHeight = 0;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+        glGetIntegerv(GL_UNPACK_ROW_LENGTH, &rowLength);
+        glGetIntegerv(GL_UNPACK_IMAGE_HEIGHT, &imageHeight);
+        return glcapture::imageBytes(format, type, width, height, depth, alignment, rowLength, imageHeight);
+    }
+
+    // glMapBufferRange / glUnmapBuffer: non-persistent writes are recorded at the unmap
+    void noteMapping(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access, void *pointer)
+    {
+        if (!pointer || !(access & GL_MAP_WRITE_BIT) || (access & GL_MAP_PERSISTENT_BIT))
+            return;
+        Mapping &m = mappings[target];
+        m.offset = offset;
+        m.length = length;
+        m.pointer = pointer;
+    }
+    void recordUnmap(GLenum target)
+    {
+        std::map<GLenum, Mapping>::iterator it = mappings.find(target);
+        if (it == mappings.end())
+            return;
+        out->put((uint16_t)glcapture::MAPPED_WRITE);
+        out->put(target);
+        out->put((int64_t)it->second.offset);
+        out->putBytes(it->second.pointer, (size_t)it->second.length);
+        countCall(glcapture::MAPPED_WRITE);
+        mappings.erase(it);
+    }
+
+private:
+    struct Mapping
+    {
+        GLintptr offset = 0;
+        GLsizeiptr length = 0;
+        void *pointer = nullptr;
+    };
+
+    std::string path;
+    unsigned captureFrame = 120;
+    unsigned frames = 0;
+    bool active = false;
+    bool done = false;
+    std::thread::id thread;
+    glcapture::Writer prologue;
+    glcapture::Writer frame;
+    glcapture::Writer *out = &frame;
+    uint32_t calls = 0, draws = 0;
+    std::set<GLuint> referenced[glcapture::NAME_KINDS];
+    std::set<GLuint> created[glcapture::NAME_KINDS];
+    std::map<GLuint, GLenum> textureTargets;
+    std::map<GLenum, Mapping> mappings;
+
+    void putArgs() {}
+    template <class T, class... A>
+    void putArgs(T first, A... rest)
+    {
+        out->put(first);
+        putArgs(rest...);
+    }
+    void noteArgs(const char *) {}
+    template <class T, class... A>
+    void noteArgs(const char *names, T first, A... rest)
+    {
+        noteArg(*names, first);
+        noteArgs(names + 1, rest...);
+    }
+    template <class T>
+    void noteArg(char letter, T value) { noteName(glcapture::nameKind(letter), (GLuint)value); }
+    void noteArg(char, const void *) {}
+
+    template <class... A>
+    void op(glcapture::Op code, A... args) { recordCall((uint16_t)code, glcapture::scalarNames(code), args...); }
+
+    void installHooks();
+    void removeHooks();
+
+    // the prologue: what's bound and enabled as the frame starts, as calls
+    void snapshotState()
+    {
+        using namespace glcapture;
+        static const GLenum caps[] = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_SCISSOR_TEST, GL_POLYGON_OFFSET_FILL,
+                                      GL_MULTISAMPLE, GL_FRAMEBUFFER_SRGB, GL_TEXTURE_CUBE_MAP_SEAMLESS, GL_PROGRAM_POINT_SIZE,
+                                      GL_DEPTH_CLAMP, GL_RASTERIZER_DISCARD, GL_SAMPLE_ALPHA_TO_COVERAGE};
+        for (size_t i = 0; i < sizeof(caps) / sizeof(caps[0]); ++i)
+            op(glIsEnabled(caps[i]) ? ENABLE : DISABLE, caps[i]);
+        GLint v[4] = {0, 0, 0, 0};
+        GLfloat f[4] = {0, 0, 0, 0};
+        GLboolean b[4] = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
+        glGetIntegerv(GL_BLEND_SRC_RGB, &v[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB, &v[1]);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, &v[2]);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, &v[3]);
+        op(BLEND_FUNC_SEPARATE, (GLenum)v[0], (GLenum)v[1], (GLenum)v[2], (GLenum)v[3]);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, &v[0]);
+        op(BLEND_EQUATION, (GLenum)v[0]);
+        glGetIntegerv(GL_DEPTH_FUNC, &v[0]);
+        op(DEPTH_FUNC, (GLenum)v[0]);
+        glGetBooleanv(GL_DEPTH_WRITEMASK, b);
+        op(DEPTH_MASK, b[0]);
+        glGetBooleanv(GL_COLOR_WRITEMASK, b);
+        op(COLOR_MASK, b[0], b[1], b[2], b[3]);
+        glGetIntegerv(GL_CULL_FACE_MODE, &v[0]);
+        op(CULL_FACE, (GLenum)v[0]);
+        glGetIntegerv(GL_FRONT_FACE, &v[0]);
+        op(FRONT_FACE, (GLenum)v[0]);
+        glGetIntegerv(GL_VIEWPORT, v);
+        op(VIEWPORT, v[0], v[1], (GLsizei)v[2], (GLsizei)v[3]);
+        glGetIntegerv(GL_SCISSOR_BOX, v);
+        op(SCISSOR, v[0], v[1], (GLsizei)v[2], (GLsizei)v[3]);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, f);
+        op(CLEAR_COLOR, f[0], f[1], f[2], f[3]);
+        glGetFloatv(GL_DEPTH_CLEAR_VALUE, f);
+        op(CLEAR_DEPTH, (GLdouble)f[0]);
+        glGetIntegerv(GL_STENCIL_FUNC, &v[0]);
+        glGetIntegerv(GL_STENCIL_REF, &v[1]);
+        glGetIntegerv(GL_STENCIL_VALUE_MASK, &v[2]);
+        op(STENCIL_FUNC, (GLenum)v[0], v[1], (GLuint)v[2]);
+        glGetIntegerv(GL_STENCIL_FAIL, &v[0]);
+        glGetIntegerv(GL_STENCIL_PASS_DEPTH_FAIL, &v[1]);
+        glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, &v[2]);
+        op(STENCIL_OP, (GLenum)v[0], (GLenum)v[1], (GLenum)v[2]);
+        glGetIntegerv(GL_STENCIL_WRITEMASK, &v[0]);
+        op(STENCIL_MASK, (GLuint)v[0]);
+        glGetIntegerv(GL_POLYGON_MODE, v);
+        op(POLYGON_MODE, (GLenum)GL_FRONT_AND_BACK, (GLenum)v[0]);
+        glGetFloatv(GL_POLYGON_OFFSET_FACTOR, &f[0]);
+        glGetFloatv(GL_POLYGON_OFFSET_UNITS, &f[1]);
+        op(POLYGON_OFFSET, f[0], f[1]);
+        static const GLenum pixelStore[] = {GL_UNPACK_ALIGNMENT, GL_UNPACK_ROW_LENGTH, GL_UNPACK_IMAGE_HEIGHT, GL_PACK_ALIGNMENT};
+        for (size_t i = 0; i < sizeof(pixelStore) / sizeof(pixelStore[0]); ++i)
+        {
+            glGetIntegerv(pixelStore[i], &v[0]);
+            op(PIXEL_STOREI, pixelStore[i], v[0]);
+        }
+
+        // textures per unit, then the unit that was active
+        GLint activeUnit = GL_TEXTURE0, units = 0;
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit);
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        static const GLenum targets[] = {GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D, GL_TEXTURE_BUFFER,
+                                         GL_TEXTURE_2D_MULTISAMPLE};
+        static const GLenum bindings[] = {GL_TEXTURE_BINDING_2D, GL_TEXTURE_BINDING_CUBE_MAP, GL_TEXTURE_BINDING_2D_ARRAY,
+                                          GL_TEXTURE_BINDING_3D, GL_TEXTURE_BINDING_BUFFER, GL_TEXTURE_BINDING_2D_MULTISAMPLE};
+        for (GLint unit = 0; unit < std::min(units, 48); ++unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            bool selected = false;
+            for (size_t t = 0; t < sizeof(targets) / sizeof(targets[0]); ++t)
+            {
+                GLint texture = 0;
+                glGetIntegerv(bindings[t], &texture);
+                if (!texture)
+                    continue;
+                if (!selected)
+                    op(ACTIVE_TEXTURE, (GLenum)(GL_TEXTURE0 + unit));
+                selected = true;
+                op(BIND_TEXTURE, targets[t], (GLuint)texture);
+                noteTextureTarget((GLuint)texture, targets[t]);
+            }
+        }
+        glActiveTexture((GLenum)activeUnit);
+        op(ACTIVE_TEXTURE, (GLenum)activeUnit);
+
+        // indexed buffer ranges, then the generic buffer bindings
+        snapshotIndexedBuffers(GL_UNIFORM_BUFFER, GL_UNIFORM_BUFFER_BINDING, GL_UNIFORM_BUFFER_START, GL_UNIFORM_BUFFER_SIZE,
+                               GL_MAX_UNIFORM_BUFFER_BINDINGS);
+        if (GLAD_GL_VERSION_4_3)
+            snapshotIndexedBuffers(GL_SHADER_STORAGE_BUFFER, GL_SHADER_STORAGE_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_START,
+                                   GL_SHADER_STORAGE_BUFFER_SIZE, GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS);
+        snapshotBufferBinding(GL_ARRAY_BUFFER, GL_ARRAY_BUFFER_BINDING);
+        snapshotBufferBinding(GL_UNIFORM_BUFFER, GL_UNIFORM_BUFFER_BINDING);
+        snapshotBufferBinding(GL_COPY_READ_BUFFER, GL_COPY_READ_BUFFER_BINDING);
+        snapshotBufferBinding(GL_COPY_WRITE_BUFFER, GL_COPY_WRITE_BUFFER_BINDING);
+        snapshotBufferBinding(GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_UNPACK_BUFFER_BINDING);
+        snapshotBufferBinding(GL_PIXEL_PACK_BUFFER, GL_PIXEL_PACK_BUFFER_BINDING);
+        if (GLAD_GL_VERSION_4_0)
+            snapshotBufferBinding(GL_DRAW_INDIRECT_BUFFER, GL_DRAW_INDIRECT_BUFFER_BINDING);
+        if (GLAD_GL_VERSION_4_3)
+        {
+            snapshotBufferBinding(GL_SHADER_STORAGE_BUFFER, GL_SHADER_STORAGE_BUFFER_BINDING);
+            snapshotBufferBinding(GL_DISPATCH_INDIRECT_BUFFER, GL_DISPATCH_INDIRECT_BUFFER_BINDING);
+        }
+        if (GLAD_GL_VERSION_4_6)
+            snapshotBufferBinding(GL_PARAMETER_BUFFER, GL_PARAMETER_BUFFER_BINDING);
+
+        // the vertex array carries its element buffer, so it comes after GL_ARRAY_BUFFER
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &v[0]);
+        op(BIND_VERTEX_ARRAY, (GLuint)v[0]);
+        glGetIntegerv(GL_CURRENT_PROGRAM, &v[0]);
+        op(USE_PROGRAM, (GLuint)v[0]);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &v[0]);
+        op(BIND_FRAMEBUFFER, (GLenum)GL_DRAW_FRAMEBUFFER, (GLuint)v[0]);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &v[0]);
+        op(BIND_FRAMEBUFFER, (GLenum)GL_READ_FRAMEBUFFER, (GLuint)v[0]);
+        glGetIntegerv(GL_RENDERBUFFER_BINDING, &v[0]);
+        op(BIND_RENDERBUFFER, (GLenum)GL_RENDERBUFFER, (GLuint)v[0]);
+        // snapshots are calls too, but not the frame's
+        calls = draws = 0;
+    }
+
+    void snapshotBufferBinding(GLenum target, GLenum binding)
+    {
+        GLint buffer = 0;
+        glGetIntegerv(binding, &buffer);
+        op(glcapture::BIND_BUFFER, target, (GLuint)buffer);
+    }
+
+    void snapshotIndexedBuffers(GLenum target, GLenum binding, GLenum start, GLenum size, GLenum maxBindings)
+    {
+        GLint count = 0;
+        glGetIntegerv(maxBindings, &count);
+        for (GLint i = 0; i < std::min(count, 64); ++i)
+        {
+            GLint buffer = 0;
+            glGetIntegeri_v(binding, (GLuint)i, &buffer);
+            if (!buffer)
+                continue;
+            GLint64 offset = 0, length = 0;
+            glGetInteger64i_v(start, (GLuint)i, &offset);
+            glGetInteger64i_v(size, (GLuint)i, &length);
+            if (length)
+                op(glcapture::BIND_BUFFER_RANGE, target, (GLuint)i, (GLuint)buffer, (GLintptr)offset, (GLsizeiptr)length);
+            else
+                op(glcapture::BIND_BUFFER_BASE, target, (GLuint)i, (GLuint)buffer);
+        }
+    }
+
+    // the target `texture` was created with: known from a bind, asked on GL 4.5, else found by binding it
+    // to each candidate on the snapshot unit until one isn't an error
+    GLenum textureTarget(GLuint texture)
+    {
+        std::map<GLuint, GLenum>::const_iterator it = textureTargets.find(texture);
+        if (it != textureTargets.end())
+            return it->second;
+        GLenum found = 0;
+        if (GLAD_GL_VERSION_4_5)
+        {
+            GLint target = 0;
+            glGetTextureParameteriv(texture, GL_TEXTURE_TARGET, &target);
+            found = (GLenum)target;
+        }
+        else
+        {
+            static const GLenum candidates[] = {GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D,
+                                                GL_TEXTURE_BUFFER, GL_TEXTURE_2D_MULTISAMPLE};
+            while (glGetError() != GL_NO_ERROR)
+            {
+            }
+            for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]) && !found; ++i)
+            {
+                glBindTexture(candidates[i], texture);
+                if (glGetError() == GL_NO_ERROR)
+                {
+                    found = candidates[i];
+                    glBindTexture(candidates[i], 0);
+                }
+            }
+        }
+        textureTargets[texture] = found;
+        return found;
+    }
+
+    // The objects the frame used and didn't create, read back after it. Written buffers first, then what
+    // refers to them: buffers, textures, renderbuffers, programs, vertex arrays, framebuffers. Layouts:
+    //   RESOURCE_BUFFER        uint32 name, enum usage, int64 size, bytes (empty if it was mapped)
+    //   RESOURCE_TEXTURE       uint32 name, enum target, int32 samples (multisample: one level, no data),
+    //                          9 x (enum pname, int32 value), int32 levels, per level int32 width, height,
+    //                          depth, enum internal format, uint8 compressed, enum format, enum type, and
+    //                          per face (6 for cube maps) bytes
+    //   RESOURCE_TEXTURE_BUFFER uint32 name, enum internal format, uint32 buffer
+    //   RESOURCE_RENDERBUFFER  uint32 name, enum internal format, int32 width, height, samples
+    //   RESOURCE_PROGRAM       uint32 name, int32 shaders, per shader enum type + source; enum binary
+    //                          format + binary bytes (when no shaders are attached); int32 blocks, per block
+    //                          name + uint32 binding; int32 uniforms, per uniform name, int32 location,
+    //                          uint8 base type (0 float, 1 int, 2 uint, 3 matrix), uint8 components, values
+    //   RESOURCE_VERTEX_ARRAY  uint32 name, uint32 element buffer, uint8 binding model (GL 4.3 queries),
+    //                          int32 attributes, per attribute uint32 index, uint8 enabled, int32 size,
+    //                          enum type, uint8 normalized, uint8 integer, uint32 relative offset, uint32
+    //                          binding; int32 bindings, per binding uint32 index, uint32 buffer, int64
+    //                          offset, int32 stride, uint32 divisor
+    //   RESOURCE_FRAMEBUFFER   uint32 name, int32 attachments, per attachment enum attachment, enum object
+    //                          type, uint32 object, enum texture target, int32 level, int32 layer, uint8
+    //                          layered; 8 x enum draw buffer, enum read buffer
+    void snapshotObjects(glcapture::Writer &w)
+    {
+        using namespace glcapture;
+        GLint program = 0, vao = 0, drawFbo = 0, readFbo = 0, renderbuffer = 0, activeUnit = GL_TEXTURE0, units = 1;
+        GLint copyRead = 0, packBuffer = 0, packAlignment = 4, packRowLength = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFbo);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFbo);
+        glGetIntegerv(GL_RENDERBUFFER_BINDING, &renderbuffer);
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit);
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        glGetIntegerv(GL_COPY_READ_BUFFER_BINDING, &copyRead);
+        glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+        glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+        glGetIntegerv(GL_PACK_ROW_LENGTH, &packRowLength);
+        // texture reads go through the last unit, which nothing draws with
+        glActiveTexture(GL_TEXTURE0 + units - 1);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+
+        Writer framebuffers, vertexArrays, programs, textures, renderbuffers, buffers;
+        for (std::set<GLuint>::const_iterator it = referenced[FRAMEBUFFER].begin(); it != referenced[FRAMEBUFFER].end(); ++it)
+            if (!created[FRAMEBUFFER].count(*it))
+                snapshotFramebuffer(framebuffers, *it);
+        for (std::set<GLuint>::const_iterator it = referenced[VERTEX_ARRAY].begin(); it != referenced[VERTEX_ARRAY].end(); ++it)
+            if (!created[VERTEX_ARRAY].count(*it))
+                snapshotVertexArray(vertexArrays, *it);
+        for (std::set<GLuint>::const_iterator it = referenced[PROGRAM].begin(); it != referenced[PROGRAM].end(); ++it)
+            snapshotProgram(programs, *it);
+        for (std::set<GLuint>::const_iterator it = referenced[TEXTURE].begin(); it != referenced[TEXTURE].end(); ++it)
+            if (!created[TEXTURE].count(*it))
+                snapshotTexture(textures, *it);
+        for (std::set<GLuint>::const_iterator it = referenced[RENDERBUFFER].begin(); it != referenced[RENDERBUFFER].end(); ++it)
+            if (!created[RENDERBUFFER].count(*it))
+                snapshotRenderbuffer(renderbuffers, *it);
+        for (std::set<GLuint>::const_iterator it = referenced[BUFFER].begin(); it != referenced[BUFFER].end(); ++it)
+            if (!created[BUFFER].count(*it))
+                snapshotBuffer(buffers, *it);
+        w.append(buffers);
+        w.append(textures);
+        w.append(renderbuffers);
+        w.append(programs);
+        w.append(vertexArrays);
+        w.append(framebuffers);
+
+        glUseProgram((GLuint)program);
+        glBindVertexArray((GLuint)vao);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)drawFbo);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)readFbo);
+        glBindRenderbuffer(GL_RENDERBUFFER, (GLuint)renderbuffer);
+        glBindBuffer(GL_COPY_READ_BUFFER, (GLuint)copyRead);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, (GLuint)packBuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+        glPixelStorei(GL_PACK_ROW_LENGTH, packRowLength);
+        glActiveTexture((GLenum)activeUnit);
+    }
+
+    void snapshotBuffer(glcapture::Writer &w, GLuint buffer)
+    {
+        if (!glIsBuffer(buffer))
+            return;
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        GLint64 size = 0;
+        GLint usage = GL_STATIC_DRAW, mapped = GL_FALSE, access = 0;
+        glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_USAGE, &usage);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_MAPPED, &mapped);
+        glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_ACCESS_FLAGS, &access);
+        w.put((uint16_t)glcapture::RESOURCE_BUFFER);
+        w.put(buffer);
+        w.put((GLenum)usage);
+        w.put((int64_t)size);
+        // a persistent mapping may be read through; another can't
+        if (size > 0 && (!mapped || (access & GL_MAP_PERSISTENT_BIT)))
+        {
+            std::vector<unsigned char> data((size_t)size);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, (GLsizeiptr)size, &data[0]);
+            w.putBytes(&data[0], data.size());
+        }
+        else
+            w.putBytes(nullptr, 0);
+    }
+
+    // the client format glGetTexImage returns `internalFormat` in without loss (or with little)
+    static void readFormat(GLenum target, GLint level, GLenum internalFormat, GLenum &format, GLenum &type)
+    {
+        switch (internalFormat)
+        {
+        case GL_DEPTH_COMPONENT16: case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32: case GL_DEPTH_COMPONENT32F:
+        case GL_DEPTH_COMPONENT:
+            format = GL_DEPTH_COMPONENT;
+            type = GL_FLOAT;
+            return;
+        case GL_DEPTH24_STENCIL8: case GL_DEPTH_STENCIL:
+            format = GL_DEPTH_STENCIL;
+            type = GL_UNSIGNED_INT_24_8;
+            return;
+        case GL_DEPTH32F_STENCIL8:
+            format = GL_DEPTH_STENCIL;
+            type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
+            return;
+        default:
+            break;
+        }
+        GLint sizes[4] = {0, 0, 0, 0}, componentType = GL_UNSIGNED_NORMALIZED;
+        static const GLenum sizeNames[4] = {GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE};
+        int components = 0;
+        for (int c = 0; c < 4; ++c)
+        {
+            glGetTexLevelParameteriv(target, level, sizeNames[c], &sizes[c]);
+            if (sizes[c] > 0)
+                components = c + 1;
+        }
+        glGetTexLevelParameteriv(target, level, GL_TEXTURE_RED_TYPE, &componentType);
+        const bool integer = componentType == GL_INT || componentType == GL_UNSIGNED_INT;
+        static const GLenum formats[4] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+        static const GLenum integerFormats[4] = {GL_RED_INTEGER, GL_RG_INTEGER, GL_RGB_INTEGER, GL_RGBA_INTEGER};
+        components = std::max(components, 1);
+        format = integer ? integerFormats[components - 1] : formats[components - 1];
+        if (componentType == GL_INT)
+            type = GL_INT;
+        else if (componentType == GL_UNSIGNED_INT)
+            type = GL_UNSIGNED_INT;
+        else if (componentType == GL_UNSIGNED_NORMALIZED && sizes[0] <= 8)
+            type = GL_UNSIGNED_BYTE;
+        else
+            type = GL_FLOAT;
+    }
+
+    void snapshotTexture(glcapture::Writer &w, GLuint texture)
+    {
+        if (!glIsTexture(texture))
+            return;
+        const GLenum target = textureTarget(texture);
+        if (target != GL_TEXTURE_2D && target != GL_TEXTURE_CUBE_MAP && target != GL_TEXTURE_2D_ARRAY && target != GL_TEXTURE_3D &&
+            target != GL_TEXTURE_BUFFER && target != GL_TEXTURE_2D_MULTISAMPLE)
+        {
+            LOG_WARN("[GlCapture] Texture " << texture << " has a target the capture doesn't cover, left out");
+            return;
+        }
+        glBindTexture(target, texture);
+        if (target == GL_TEXTURE_BUFFER)
+        {
+            GLint format = 0, buffer = 0;
+            glGetTexLevelParameteriv(target, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+            glGetTexLevelParameteriv(target, 0, GL_TEXTURE_BUFFER_DATA_STORE_BINDING, &buffer);
+            noteName(glcapture::BUFFER, (GLuint)buffer);
+            w.put((uint16_t)glcapture::RESOURCE_TEXTURE_BUFFER);
+            w.put(texture);
+            w.put((GLenum)format);
+            w.put((GLuint)buffer);
+            glBindTexture(target, 0);
+            return;
+        }
+        w.put((uint16_t)glcapture::RESOURCE_TEXTURE);
+        w.put(texture);
+        w.put(target);
+        GLint samples = 0;
+        if (target == GL_TEXTURE_2D_MULTISAMPLE)
+            glGetTexLevelParameteriv(target, 0, GL_TEXTURE_SAMPLES, &samples);
+        w.put((int32_t)samples);
+        static const GLenum params[9] = {GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T,
+                                         GL_TEXTURE_WRAP_R, GL_TEXTURE_COMPARE_MODE, GL_TEXTURE_COMPARE_FUNC, GL_TEXTURE_BASE_LEVEL,
+                                         GL_TEXTURE_MAX_LEVEL};
+        for (int p = 0; p < 9; ++p)
+        {
+            GLint value = 0;
+            if (!samples)
+                glGetTexParameteriv(target, params[p], &value);
+            w.put(params[p]);
+            w.put((int32_t)value);
+        }
+        const GLenum levelTarget = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+        const int faces = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+        glcapture::Writer levels;
+        int32_t levelCount = 0;
+        for (GLint level = 0; level < 16; ++level)
+        {
+            GLint width = 0, height = 0, depth = 0, internalFormat = 0, compressed = 0;
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_WIDTH, &width);
+            if (width <= 0)
+                break;
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_HEIGHT, &height);
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_DEPTH, &depth);
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+            glGetTexLevelParameteriv(levelTarget, level, GL_TEXTURE_COMPRESSED, &compressed);
+            GLenum format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+            if (!compressed)
+                readFormat(levelTarget, level, (GLenum)internalFormat, format, type);
+            levels.put((int32_t)width);
+            levels.put((int32_t)height);
+            levels.put((int32_t)depth);
+            levels.put((GLenum)internalFormat);
+            levels.put((uint8_t)(compressed ? 1 : 0));
+            levels.put(format);
+            levels.put(type);
+            ++levelCount;
+            for (int face = 0; face < faces; ++face)
+            {
+                const GLenum faceTarget = levelTarget + (GLenum)face;
+                std::vector<unsigned char> data;
+                if (samples)
+                {
+                    // no contents to read
+                }
+                else if (compressed)
+                {
+                    GLint size = 0;
+                    glGetTexLevelParameteriv(faceTarget, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+                    if (size > 0)
+                    {
+                        data.resize((size_t)size);
+                        glGetCompressedTexImage(faceTarget, level, &data[0]);
+                    }
+                }
+                else
+                {
+                    data.resize(glcapture::imageBytes(format, type, width, height, std::max(depth, 1), 1));
+                    if (!data.empty())
+                        glGetTexImage(faceTarget, level, format, type, &data[0]);
+                }
+                levels.putBytes(data.empty() ? nullptr : &data[0], data.size());
+            }
+            // multisample textures have the one level and no contents to read
+            if (samples)
+                break;
+        }
+        w.put(levelCount);
+        w.append(levels);
+        glBindTexture(target, 0);
+    }
+
+    void snapshotRenderbuffer(glcapture::Writer &w, GLuint renderbuffer)
+    {
+        if (!glIsRenderbuffer(renderbuffer))
+            return;
+        glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+        GLint format = 0, width = 0, height = 0, samples = 0;
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &format);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &width);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &samples);
+        w.put((uint16_t)glcapture::RESOURCE_RENDERBUFFER);
+        w.put(renderbuffer);
+        w.put((GLenum)format);
+        w.put((int32_t)width);
+        w.put((int32_t)height);
+        w.put((int32_t)samples);
+    }
+
+    // base type (0 float, 1 int, 2 uint, 3 float matrix) and component count of a uniform; false for the
+    // types the viewer's shaders don't use (doubles, non-square matrices)
+    static bool uniformShape(GLenum type, uint8_t &base, uint8_t &components)
+    {
+        switch (type)
+        {
+        case GL_FLOAT: base = 0; components = 1; return true;
+        case GL_FLOAT_VEC2: base = 0; components = 2; return true;
+        case GL_FLOAT_VEC3: base = 0; components = 3; return true;
+        case GL_FLOAT_VEC4: base = 0; components = 4; return true;
+        case GL_FLOAT_MAT2: base = 3; components = 4; return true;
+        case GL_FLOAT_MAT3: base = 3; components = 9; return true;
+        case GL_FLOAT_MAT4: base = 3; components = 16; return true;
+        case GL_INT_VEC2: case GL_BOOL_VEC2: base = 1; components = 2; return true;
+        case GL_INT_VEC3: case GL_BOOL_VEC3: base = 1; components = 3; return true;
+        case GL_INT_VEC4: case GL_BOOL_VEC4: base = 1; components = 4; return true;
+        case GL_UNSIGNED_INT: base = 2; components = 1; return true;
+        case GL_UNSIGNED_INT_VEC2: base = 2; components = 2; return true;
+        case GL_UNSIGNED_INT_VEC3: base = 2; components = 3; return true;
+        case GL_UNSIGNED_INT_VEC4: base = 2; components = 4; return true;
+        case GL_DOUBLE: case GL_DOUBLE_VEC2: case GL_DOUBLE_VEC3: case GL_DOUBLE_VEC4: case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT2x4:
+        case GL_FLOAT_MAT3x2: case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x2: case GL_FLOAT_MAT4x3:
+            return false;
+        default:
+            // int, bool and every sampler and image type
+            base = 1;
+            components = 1;
+            return true;
+        }
+    }
+
+    void snapshotProgram(glcapture::Writer &w, GLuint program)
+    {
+        if (!glIsProgram(program))
+            return;
+        w.put((uint16_t)glcapture::RESOURCE_PROGRAM);
+        w.put(program);
+        GLint attached = 0;
+        glGetProgramiv(program, GL_ATTACHED_SHADERS, &attached);
+        std::vector<GLuint> shaders((size_t)std::max(attached, 0));
+        if (attached > 0)
+            glGetAttachedShaders(program, attached, &attached, &shaders[0]);
+        shaders.resize((size_t)std::max(attached, 0));
+        w.put((int32_t)shaders.size());
+        for (size_t i = 0; i < shaders.size(); ++i)
+        {
+            GLint type = 0, length = 0;
+            glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+            glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &length);
+            std::string source((size_t)std::max(length, 1), '\0');
+            GLsizei written = 0;
+            glGetShaderSource(shaders[i], (GLsizei)source.size(), &written, &source[0]);
+            source.resize((size_t)written);
+            w.put((GLenum)type);
+            w.putString(source);
+        }
+        // programs the shader cache loaded have no shaders to read, only the driver's binary
+        GLint binaryLength = 0;
+        GLenum binaryFormat = 0;
+        std::vector<unsigned char> binary;
+        if (shaders.empty() && GLAD_GL_VERSION_4_1)
+        {
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+            if (binaryLength > 0)
+            {
+                binary.resize((size_t)binaryLength);
+                glGetProgramBinary(program, binaryLength, &binaryLength, &binaryFormat, &binary[0]);
+                binary.resize((size_t)std::max(binaryLength, 0));
+            }
+        }
+        w.put(binaryFormat);
+        w.putBytes(binary.empty() ? nullptr : &binary[0], binary.size());
+
+        char name[256];
+        GLint blocks = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blocks);
+        w.put((int32_t)blocks);
+        for (GLint b = 0; b < blocks; ++b)
+        {
+            GLsizei length = 0;
+            GLint binding = 0;
+            glGetActiveUniformBlockName(program, (GLuint)b, sizeof(name), &length, name);
+            glGetActiveUniformBlockiv(program, (GLuint)b, GL_UNIFORM_BLOCK_BINDING, &binding);
+            w.putString(std::string(name, (size_t)length));
+            w.put((GLuint)binding);
+        }
+
+        GLint uniforms = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniforms);
+        glcapture::Writer values;
+        int32_t valueCount = 0;
+        for (GLint u = 0; u < uniforms; ++u)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(program, (GLuint)u, sizeof(name), &length, &size, &type, name);
+            uint8_t base = 0, components = 0;
+            if (!uniformShape(type, base, components))
+                continue;
+            std::string uniform(name, (size_t)length);
+            // arrays come as "name[0]"; every element has its own location
+            const bool array = uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0;
+            if (array)
+                uniform.resize(uniform.size() - 3);
+            for (GLint e = 0; e < (array ? size : 1); ++e)
+            {
+                const std::string element = array ? uniform + "[" + std::to_string(e) + "]" : uniform;
+                const GLint location = glGetUniformLocation(program, element.c_str());
+                // block members have none
+                if (location < 0)
+                    continue;
+                uint32_t raw[16];
+                if (base == 1)
+                    glGetUniformiv(program, location, (GLint *)raw);
+                else if (base == 2)
+                    glGetUniformuiv(program, location, (GLuint *)raw);
+                else
+                    glGetUniformfv(program, location, (GLfloat *)raw);
+                values.putString(element);
+                values.put((int32_t)location);
+                values.put(base);
+                values.put(components);
+                for (uint8_t c = 0; c < components; ++c)
+                    values.put(raw[c]);
+                ++valueCount;
+            }
+        }
+        w.put(valueCount);
+        w.append(values);
+    }
+
+    void snapshotVertexArray(glcapture::Writer &w, GLuint vao)
+    {
+        if (!glIsVertexArray(vao))
+            return;
+        glBindVertexArray(vao);
+        GLint elements = 0, maxAttributes = 16;
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elements);
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttributes);
+        noteName(glcapture::BUFFER, (GLuint)elements);
+        const bool bindingModel = GLAD_GL_VERSION_4_3 != 0;
+        glcapture::Writer attributes, bindings;
+        int32_t attributeCount = 0, bindingCount = 0;
+        std::set<GLuint> usedBindings;
+        for (GLint a = 0; a < std::min(maxAttributes, 32); ++a)
+        {
+            GLint enabled = 0, size = 4, type = GL_FLOAT, normalized = 0, integer = 0, buffer = 0, stride = 0, divisor = 0;
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &buffer);
+            if (!enabled && !buffer)
+                continue;
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_SIZE, &size);
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_TYPE, &type);
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized);
+            glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &integer);
+            GLint relativeOffset = 0, binding = a;
+            if (bindingModel)
+            {
+                glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_RELATIVE_OFFSET, &relativeOffset);
+                glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_BINDING, &binding);
+            }
+            else
+            {
+                // one binding per attribute, with the attribute's own pointer, stride and divisor
+                void *pointer = nullptr;
+                glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &stride);
+                glGetVertexAttribiv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_DIVISOR, &divisor);
+                glGetVertexAttribPointerv((GLuint)a, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer);
+                bindings.put((GLuint)a);
+                bindings.put((GLuint)buffer);
+                bindings.put((int64_t)(uintptr_t)pointer);
+                bindings.put((int32_t)stride);
+                bindings.put((GLuint)divisor);
+                ++bindingCount;
+                noteName(glcapture::BUFFER, (GLuint)buffer);
+            }
+            attributes.put((GLuint)a);
+            attributes.put((uint8_t)(enabled ? 1 : 0));
+            attributes.put((int32_t)size);
+            attributes.put((GLenum)type);
+            attributes.put((uint8_t)(normalized ? 1 : 0));
+            attributes.put((uint8_t)(integer ? 1 : 0));
+            attributes.put((GLuint)relativeOffset);
+            attributes.put((GLuint)binding);
+            ++attributeCount;
+            usedBindings.insert((GLuint)binding);
+        }
+        if (bindingModel)
+            for (std::set<GLuint>::const_iterator it = usedBindings.begin(); it != usedBindings.end(); ++it)
+            {
+                GLint buffer = 0, stride = 0, divisor = 0;
+                GLint64 offset = 0;
+                glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, *it, &buffer);
+                glGetInteger64i_v(GL_VERTEX_BINDING_OFFSET, *it, &offset);
+                glGetIntegeri_v(GL_VERTEX_BINDING_STRIDE, *it, &stride);
+                glGetIntegeri_v(GL_VERTEX_BINDING_DIVISOR, *it, &divisor);
+                bindings.put(*it);
+                bindings.put((GLuint)buffer);
+                bindings.put((int64_t)offset);
+                bindings.put((int32_t)stride);
+                bindings.put((GLuint)divisor);
+                ++bindingCount;
+                noteName(glcapture::BUFFER, (GLuint)buffer);
+            }
+        w.put((uint16_t)glcapture::RESOURCE_VERTEX_ARRAY);
+        w.put(vao);
+        w.put((GLuint)elements);
+        w.put((uint8_t)(bindingModel ? 1 : 0));
+        w.put(attributeCount);
+        w.append(attributes);
+        w.put(bindingCount);
+        w.append(bindings);
+    }
+
+    void snapshotFramebuffer(glcapture::Writer &w, GLuint fbo)
+    {
+        if (!glIsFramebuffer(fbo))
+            return;
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        static const GLenum points[10] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3,
+                                          GL_COLOR_ATTACHMENT4, GL_COLOR_ATTACHMENT5, GL_COLOR_ATTACHMENT6, GL_COLOR_ATTACHMENT7,
+                                          GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
+        glcapture::Writer attachments;
+        int32_t count = 0;
+        for (int i = 0; i < 10; ++i)
+        {
+            GLint type = GL_NONE, object = 0, level = 0, layer = 0, layered = 0, face = 0;
+            glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+            if (type != GL_TEXTURE && type != GL_RENDERBUFFER)
+                continue;
+            glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &object);
+            GLenum target = 0;
+            if (type == GL_TEXTURE)
+            {
+                glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &level);
+                glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER, &layer);
+                glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_LAYERED, &layered);
+                glGetFramebufferAttachmentParameteriv(GL_DRAW_FRAMEBUFFER, points[i], GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, &face);
+                target = face ? (GLenum)face : textureTarget((GLuint)object);
+                noteName(glcapture::TEXTURE, (GLuint)object);
+            }
+            else
+                noteName(glcapture::RENDERBUFFER, (GLuint)object);
+            attachments.put(points[i]);
+            attachments.put((GLenum)type);
+            attachments.put((GLuint)object);
+            attachments.put(target);
+            attachments.put((int32_t)level);
+            attachments.put((int32_t)layer);
+            attachments.put((uint8_t)(layered ? 1 : 0));
+            ++count;
+        }
+        w.put((uint16_t)glcapture::RESOURCE_FRAMEBUFFER);
+        w.put(fbo);
+        w.put(count);
+        w.append(attachments);
+        for (int i = 0; i < 8; ++i)
+        {
+            GLint buffer = GL_NONE;
+            glGetIntegerv(GL_DRAW_BUFFER0 + i, &buffer);
+            w.put((GLenum)buffer);
+        }
+        GLint readBuffer = GL_NONE;
+        glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+        w.put((GLenum)readBuffer);
+    }
+};
+
+inline GlCapture &glCapture()
+{
+    static GlCapture capture;
+    return capture;
+}
+
+// The wrappers glad's pointers are swapped for while a frame records. Each keeps the pointer it replaced
+// and calls it after recording (or straight away on other threads).
+namespace glcapture
+{
+    template <int Code, class... A>
+    struct ScalarHook
+    {
+        static void(APIENTRYP original)(A...);
+        static void APIENTRY call(A... args)
+        {
+            GlCapture &capture = glCapture();
+            if (capture.recordingThread())
+                capture.recordCall((uint16_t)Code, scalarNames(Code), args...);
+            original(args...);
+        }
+    };
+    template <int Code, class... A>
+    void(APIENTRYP ScalarHook<Code, A...>::original)(A...) = nullptr;
+
+    template <int Code, class... A>
+    void hookScalar(void(APIENTRYP &slot)(A...))
+    {
+        typedef ScalarHook<Code, A...> Hook;
+        if (!slot || slot == &Hook::call)
+            return;
+        Hook::original = slot;
+        slot = &Hook::call;
+    }
+    template <int Code, class... A>
+    void unhookScalar(void(APIENTRYP &slot)(A...))
+    {
+        typedef ScalarHook<Code, A...> Hook;
+        if (slot == &Hook::call)
+            slot = Hook::original;
+    }
+
+    // the calls with layouts of their own (function, pointer type); saved_<function>() holds the pointer each
+    // hook replaced
+    struct CustomHooks
+    {
+#define GL_CAPTURE_CUSTOM_CALLS(X)                                                                       \
+    X(glUniform1fv, PFNGLUNIFORM1FVPROC)                                                                 \
+    X(glUniform2fv, PFNGLUNIFORM2FVPROC)                                                                 \
+    X(glUniform3fv, PFNGLUNIFORM3FVPROC)                                                                 \
+    X(glUniform4fv, PFNGLUNIFORM4FVPROC)                                                                 \
+    X(glUniformMatrix2fv, PFNGLUNIFORMMATRIX2FVPROC)                                                     \
+    X(glUniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC)                                                     \
+    X(glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC)                                                     \
+    X(glBufferData, PFNGLBUFFERDATAPROC)                                                                 \
+    X(glBufferStorage, PFNGLBUFFERSTORAGEPROC)                                                           \
+    X(glNamedBufferData, PFNGLNAMEDBUFFERDATAPROC)                                                       \
+    X(glNamedBufferStorage, PFNGLNAMEDBUFFERSTORAGEPROC)                                                 \
+    X(glBufferSubData, PFNGLBUFFERSUBDATAPROC)                                                           \
+    X(glNamedBufferSubData, PFNGLNAMEDBUFFERSUBDATAPROC)                                                 \
+    X(glMapBufferRange, PFNGLMAPBUFFERRANGEPROC)                                                         \
+    X(glUnmapBuffer, PFNGLUNMAPBUFFERPROC)                                                               \
+    X(glTexImage2D, PFNGLTEXIMAGE2DPROC)                                                                 \
+    X(glTexImage3D, PFNGLTEXIMAGE3DPROC)                                                                 \
+    X(glTexSubImage2D, PFNGLTEXSUBIMAGE2DPROC)                                                           \
+    X(glTexSubImage3D, PFNGLTEXSUBIMAGE3DPROC)                                                           \
+    X(glTextureSubImage2D, PFNGLTEXTURESUBIMAGE2DPROC)                                                   \
+    X(glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC)                                             \
+    X(glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC)                                             \
+    X(glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)                                       \
+    X(glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC)                                       \
+    X(glCompressedTextureSubImage2D, PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC)                               \
+    X(glDrawBuffers, PFNGLDRAWBUFFERSPROC)                                                               \
+    X(glClearBufferfv, PFNGLCLEARBUFFERFVPROC)                                                           \
+    X(glClearBufferiv, PFNGLCLEARBUFFERIVPROC)                                                           \
+    X(glClearBufferuiv, PFNGLCLEARBUFFERUIVPROC)                                                         \
+    X(glMultiDrawElementsBaseVertex, PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC)                               \
+    X(glTexParameteriv, PFNGLTEXPARAMETERIVPROC)                                                         \
+    X(glClearBufferData, PFNGLCLEARBUFFERDATAPROC)                                                       \
+    X(glGenTextures, PFNGLGENTEXTURESPROC)                                                               \
+    X(glGenBuffers, PFNGLGENBUFFERSPROC)                                                                 \
+    X(glGenFramebuffers, PFNGLGENFRAMEBUFFERSPROC)                                                       \
+    X(glGenRenderbuffers, PFNGLGENRENDERBUFFERSPROC)                                                     \
+    X(glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC)                                                       \
+    X(glCreateTextures, PFNGLCREATETEXTURESPROC)                                                         \
+    X(glCreateBuffers, PFNGLCREATEBUFFERSPROC)                                                           \
+    X(glCreateFramebuffers, PFNGLCREATEFRAMEBUFFERSPROC)                                                 \
+    X(glCreateRenderbuffers, PFNGLCREATERENDERBUFFERSPROC)                                               \
+    X(glCreateVertexArrays, PFNGLCREATEVERTEXARRAYSPROC)
+#define GL_CAPTURE_ORIGINAL(function, type) static type &saved_##function() { static type saved = nullptr; return saved; }
+        GL_CAPTURE_CUSTOM_CALLS(GL_CAPTURE_ORIGINAL)
+#undef GL_CAPTURE_ORIGINAL
+
+        static GlCapture *recorder()
+        {
+            GlCapture &capture = glCapture();
+            return capture.recordingThread() ? &capture : nullptr;
+        }
+
+        static void uniformFloats(uint8_t shape, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+        {
+            if (GlCapture *c = recorder())
+            {
+                const size_t perElement = shape >= 0x22 ? (size_t)(shape & 0xf) * (shape & 0xf) : shape;
+                Writer &w = c->stream();
+                w.put((uint16_t)UNIFORM_FLOATS);
+                w.put(shape);
+                w.put((int32_t)location);
+                w.put((int32_t)count);
+                w.put((uint8_t)transpose);
+                w.putBytes(value, value ? perElement * (size_t)std::max(count, 0) * sizeof(GLfloat) : 0);
+                c->countCall(UNIFORM_FLOATS);
+            }
+        }
+        static void APIENTRY uniform1fv(GLint l, GLsizei n, const GLfloat *v) { uniformFloats(1, l, n, GL_FALSE, v); saved_glUniform1fv()(l, n, v); }
+        static void APIENTRY uniform2fv(GLint l, GLsizei n, const GLfloat *v) { uniformFloats(2, l, n, GL_FALSE, v); saved_glUniform2fv()(l, n, v); }
+        static void APIENTRY uniform3fv(GLint l, GLsizei n, const GLfloat *v) { uniformFloats(3, l, n, GL_FALSE, v); saved_glUniform3fv()(l, n, v); }
+        static void APIENTRY uniform4fv(GLint l, GLsizei n, const GLfloat *v) { uniformFloats(4, l, n, GL_FALSE, v); saved_glUniform4fv()(l, n, v); }
+        static void APIENTRY uniformMatrix2fv(GLint l, GLsizei n, GLboolean t, const GLfloat *v)
+        {
+            uniformFloats(0x22, l, n, t, v);
+            saved_glUniformMatrix2fv()(l, n, t, v);
+        }
+        static void APIENTRY uniformMatrix3fv(GLint l, GLsizei n, GLboolean t, const GLfloat *v)
+        {
+            uniformFloats(0x33, l, n, t, v);
+            saved_glUniformMatrix3fv()(l, n, t, v);
+        }
+        static void APIENTRY uniformMatrix4fv(GLint l, GLsizei n, GLboolean t, const GLfloat *v)
+        {
+            uniformFloats(0x44, l, n, t, v);
+            saved_glUniformMatrix4fv()(l, n, t, v);
+        }
+
+        // BUFFER_DATA / BUFFER_STORAGE and their named forms
+        static void bufferData(uint16_t code, int kind, GLuint targetOrName, GLsizeiptr size, const void *data, GLenum usage)
+        {
+            if (GlCapture *c = recorder())
+            {
+                if (kind == BUFFER)
+                    c->noteName(BUFFER, targetOrName);
+                Writer &w = c->stream();
+                w.put(code);
+                w.put(targetOrName);
+                w.put((int64_t)size);
+                w.put(usage);
+                w.putBytes(data, data ? (size_t)size : 0);
+                c->countCall(code);
+            }
+        }
+        static void APIENTRY bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+        {
+            bufferData(BUFFER_DATA, -1, target, size, data, usage);
+            saved_glBufferData()(target, size, data, usage);
+        }
+        static void APIENTRY bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+        {
+            bufferData(BUFFER_STORAGE, -1, target, size, data, flags);
+            saved_glBufferStorage()(target, size, data, flags);
+        }
+        static void APIENTRY namedBufferData(GLuint buffer, GLsizeiptr size, const void *data, GLenum usage)
+        {
+            bufferData(NAMED_BUFFER_DATA, BUFFER, buffer, size, data, usage);
+            saved_glNamedBufferData()(buffer, size, data, usage);
+        }
+        static void APIENTRY namedBufferStorage(GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags)
+        {
+            bufferData(NAMED_BUFFER_STORAGE, BUFFER, buffer, size, data, flags);
+            saved_glNamedBufferStorage()(buffer, size, data, flags);
+        }
+        static void bufferSubData(uint16_t code, int kind, GLuint targetOrName, GLintptr offset, GLsizeiptr size, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                if (kind == BUFFER)
+                    c->noteName(BUFFER, targetOrName);
+                Writer &w = c->stream();
+                w.put(code);
+                w.put(targetOrName);
+                w.put((int64_t)offset);
+                w.putBytes(data, data ? (size_t)size : 0);
+                c->countCall(code);
+            }
+        }
+        static void APIENTRY bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+        {
+            bufferSubData(BUFFER_SUB_DATA, -1, target, offset, size, data);
+            saved_glBufferSubData()(target, offset, size, data);
+        }
+        static void APIENTRY namedBufferSubData(GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data)
+        {
+            bufferSubData(NAMED_BUFFER_SUB_DATA, BUFFER, buffer, offset, size, data);
+            saved_glNamedBufferSubData()(buffer, offset, size, data);
+        }
+        static void *APIENTRY mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+        {
+            void *pointer = saved_glMapBufferRange()(target, offset, length, access);
+            if (GlCapture *c = recorder())
+                c->noteMapping(target, offset, length, access, pointer);
+            return pointer;
+        }
+        static GLboolean APIENTRY unmapBuffer(GLenum target)
+        {
+            if (GlCapture *c = recorder())
+                c->recordUnmap(target);
+            return saved_glUnmapBuffer()(target);
+        }
+
+        static void APIENTRY texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
+                                        GLenum format, GLenum type, const void *pixels)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(TEX_IMAGE_2D, ".........", target, level, internalFormat, width, height, border, format, type);
+                c->putPixels(pixels, GlCapture::unpackBytes(format, type, width, height, 1));
+            }
+            saved_glTexImage2D()(target, level, internalFormat, width, height, border, format, type, pixels);
+        }
+        static void APIENTRY texImage3D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth,
+                                        GLint border, GLenum format, GLenum type, const void *pixels)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(TEX_IMAGE_3D, ".........", target, level, internalFormat, width, height, depth, border, format, type);
+                c->putPixels(pixels, GlCapture::unpackBytes(format, type, width, height, depth));
+            }
+            saved_glTexImage3D()(target, level, internalFormat, width, height, depth, border, format, type, pixels);
+        }
+        static void APIENTRY texSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
+                                           GLenum type, const void *pixels)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(TEX_SUB_IMAGE_2D, "........", target, level, x, y, width, height, format, type);
+                c->putPixels(pixels, GlCapture::unpackBytes(format, type, width, height, 1));
+            }
+            saved_glTexSubImage2D()(target, level, x, y, width, height, format, type, pixels);
+        }
+        static void APIENTRY texSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height,
+                                           GLsizei depth, GLenum format, GLenum type, const void *pixels)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(TEX_SUB_IMAGE_3D, "..........", target, level, x, y, z, width, height, depth, format, type);
+                c->putPixels(pixels, GlCapture::unpackBytes(format, type, width, height, depth));
+            }
+            saved_glTexSubImage3D()(target, level, x, y, z, width, height, depth, format, type, pixels);
+        }
+        static void APIENTRY textureSubImage2D(GLuint texture, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                                               GLenum format, GLenum type, const void *pixels)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(TEXTURE_SUB_IMAGE_2D, "T.......", texture, level, x, y, width, height, format, type);
+                c->putPixels(pixels, GlCapture::unpackBytes(format, type, width, height, 1));
+            }
+            saved_glTextureSubImage2D()(texture, level, x, y, width, height, format, type, pixels);
+        }
+        static void APIENTRY compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                                  GLint border, GLsizei imageSize, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(COMPRESSED_TEX_IMAGE_2D, ".......", target, level, internalFormat, width, height, border, imageSize);
+                c->putPixels(data, (size_t)imageSize);
+            }
+            saved_glCompressedTexImage2D()(target, level, internalFormat, width, height, border, imageSize, data);
+        }
+        static void APIENTRY compressedTexImage3D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                                                  GLsizei depth, GLint border, GLsizei imageSize, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(COMPRESSED_TEX_IMAGE_3D, "........", target, level, internalFormat, width, height, depth, border,
+                              imageSize);
+                c->putPixels(data, (size_t)imageSize);
+            }
+            saved_glCompressedTexImage3D()(target, level, internalFormat, width, height, depth, border, imageSize, data);
+        }
+        static void APIENTRY compressedTexSubImage2D(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                                                     GLenum format, GLsizei imageSize, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(COMPRESSED_TEX_SUB_IMAGE_2D, "........", target, level, x, y, width, height, format, imageSize);
+                c->putPixels(data, (size_t)imageSize);
+            }
+            saved_glCompressedTexSubImage2D()(target, level, x, y, width, height, format, imageSize, data);
+        }
+        static void APIENTRY compressedTexSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z, GLsizei width,
+                                                     GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(COMPRESSED_TEX_SUB_IMAGE_3D, "..........", target, level, x, y, z, width, height, depth, format,
+                              imageSize);
+                c->putPixels(data, (size_t)imageSize);
+            }
+            saved_glCompressedTexSubImage3D()(target, level, x, y, z, width, height, depth, format, imageSize, data);
+        }
+        static void APIENTRY compressedTextureSubImage2D(GLuint texture, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+                                                         GLenum format, GLsizei imageSize, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(COMPRESSED_TEXTURE_SUB_IMAGE_2D, "T.......", texture, level, x, y, width, height, format, imageSize);
+                c->putPixels(data, (size_t)imageSize);
+            }
+            saved_glCompressedTextureSubImage2D()(texture, level, x, y, width, height, format, imageSize, data);
+        }
+
+        static void APIENTRY drawBuffers(GLsizei n, const GLenum *buffers)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(DRAW_BUFFERS, ".", (int32_t)n);
+                for (GLsizei i = 0; i < n; ++i)
+                    c->stream().put(buffers[i]);
+            }
+            saved_glDrawBuffers()(n, buffers);
+        }
+        static void clearBuffer(uint8_t kind, GLenum buffer, GLint drawBuffer, const void *value)
+        {
+            if (GlCapture *c = recorder())
+            {
+                uint32_t values[4] = {0, 0, 0, 0};
+                std::memcpy(values, value, buffer == GL_COLOR ? sizeof(values) : sizeof(values[0]));
+                c->recordCall(CLEAR_BUFFER, "....", kind, buffer, (int32_t)drawBuffer, values[0]);
+                for (int i = 1; i < 4; ++i)
+                    c->stream().put(values[i]);
+            }
+        }
+        static void APIENTRY clearBufferfv(GLenum buffer, GLint drawBuffer, const GLfloat *value)
+        {
+            clearBuffer(0, buffer, drawBuffer, value);
+            saved_glClearBufferfv()(buffer, drawBuffer, value);
+        }
+        static void APIENTRY clearBufferiv(GLenum buffer, GLint drawBuffer, const GLint *value)
+        {
+            clearBuffer(1, buffer, drawBuffer, value);
+            saved_glClearBufferiv()(buffer, drawBuffer, value);
+        }
+        static void APIENTRY clearBufferuiv(GLenum buffer, GLint drawBuffer, const GLuint *value)
+        {
+            clearBuffer(2, buffer, drawBuffer, value);
+            saved_glClearBufferuiv()(buffer, drawBuffer, value);
+        }
+        static void APIENTRY multiDrawElementsBaseVertex(GLenum mode, const GLsizei *count, GLenum type, const void *const *indices,
+                                                         GLsizei drawCount, const GLint *baseVertex)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(MULTI_DRAW_ELEMENTS_BASE_VERTEX, "...", mode, type, (int32_t)drawCount);
+                for (GLsizei i = 0; i < drawCount; ++i)
+                {
+                    c->stream().put((int32_t)count[i]);
+                    c->stream().put(indices[i]);
+                    c->stream().put((int32_t)baseVertex[i]);
+                }
+            }
+            saved_glMultiDrawElementsBaseVertex()(mode, count, type, indices, drawCount, baseVertex);
+        }
+        static void APIENTRY texParameteriv(GLenum target, GLenum pname, const GLint *params)
+        {
+            if (GlCapture *c = recorder())
+            {
+                GLint values[4] = {0, 0, 0, 0};
+                const bool four = pname == GL_TEXTURE_SWIZZLE_RGBA || pname == GL_TEXTURE_BORDER_COLOR;
+                std::memcpy(values, params, (four ? 4 : 1) * sizeof(GLint));
+                c->recordCall(TEX_PARAMETER_IV, "......", target, pname, values[0], values[1], values[2], values[3]);
+            }
+            saved_glTexParameteriv()(target, pname, params);
+        }
+        static void APIENTRY clearBufferData(GLenum target, GLenum internalFormat, GLenum format, GLenum type, const void *data)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->recordCall(CLEAR_BUFFER_DATA, "....", target, internalFormat, format, type);
+                c->stream().putBytes(data, data ? glcapture::imageBytes(format, type, 1, 1, 1, 1) : 0);
+            }
+            saved_glClearBufferData()(target, internalFormat, format, type, data);
+        }
+
+        static void recordNames(int kind, GLenum target, bool create, GLsizei n, const GLuint *names)
+        {
+            if (GlCapture *c = recorder())
+            {
+                c->noteCreated(kind, n, names);
+                Writer &w = c->stream();
+                w.put((uint16_t)(create ? CREATE_NAMES : GEN_NAMES));
+                w.put((uint8_t)kind);
+                if (create)
+                    w.put(target);
+                w.put((int32_t)n);
+                for (GLsizei i = 0; i < n; ++i)
+                    w.put(names[i]);
+                c->countCall(create ? CREATE_NAMES : GEN_NAMES);
+                if (kind == TEXTURE && create)
+                    for (GLsizei i = 0; i < n; ++i)
+                        c->noteTextureTarget(names[i], target);
+            }
+        }
+        static void APIENTRY genTextures(GLsizei n, GLuint *names) { saved_glGenTextures()(n, names); recordNames(TEXTURE, 0, false, n, names); }
+        static void APIENTRY genBuffers(GLsizei n, GLuint *names) { saved_glGenBuffers()(n, names); recordNames(BUFFER, 0, false, n, names); }
+        static void APIENTRY genFramebuffers(GLsizei n, GLuint *names)
+        {
+            saved_glGenFramebuffers()(n, names);
+            recordNames(FRAMEBUFFER, 0, false, n, names);
+        }
+        static void APIENTRY genRenderbuffers(GLsizei n, GLuint *names)
+        {
+            saved_glGenRenderbuffers()(n, names);
+            recordNames(RENDERBUFFER, 0, false, n, names);
+        }
+        static void APIENTRY genVertexArrays(GLsizei n, GLuint *names)
+        {
+            saved_glGenVertexArrays()(n, names);
+            recordNames(VERTEX_ARRAY, 0, false, n, names);
+        }
+        static void APIENTRY createTextures(GLenum target, GLsizei n, GLuint *names)
+        {
+            saved_glCreateTextures()(target, n, names);
+            recordNames(TEXTURE, target, true, n, names);
+        }
+        static void APIENTRY createBuffers(GLsizei n, GLuint *names) { saved_glCreateBuffers()(n, names); recordNames(BUFFER, 0, true, n, names); }
+        static void APIENTRY createFramebuffers(GLsizei n, GLuint *names)
+        {
+            saved_glCreateFramebuffers()(n, names);
+            recordNames(FRAMEBUFFER, 0, true, n, names);
+        }
+        static void APIENTRY createRenderbuffers(GLsizei n, GLuint *names)
+        {
+            saved_glCreateRenderbuffers()(n, names);
+            recordNames(RENDERBUFFER, 0, true, n, names);
+        }
+        static void APIENTRY createVertexArrays(GLsizei n, GLuint *names)
+        {
+            saved_glCreateVertexArrays()(n, names);
+            recordNames(VERTEX_ARRAY, 0, true, n, names);
+        }
+    };
+}
+
+inline void GlCapture::installHooks()
+{
+    using namespace glcapture;
+#define GL_CAPTURE_HOOK(op, function, names) hookScalar<op>(glad_##function);
+    GL_CAPTURE_SCALAR_CALLS(GL_CAPTURE_HOOK)
+#undef GL_CAPTURE_HOOK
+    // the custom hooks are named after their function, without the gl
+#define GL_CAPTURE_SWAP(function, hook)          \
+    if (glad_##function)                         \
+    {                                            \
+        CustomHooks::saved_##function() = glad_##function; \
+        glad_##function = &CustomHooks::hook;    \
+    }
+    GL_CAPTURE_SWAP(glUniform1fv, uniform1fv)
+    GL_CAPTURE_SWAP(glUniform2fv, uniform2fv)
+    GL_CAPTURE_SWAP(glUniform3fv, uniform3fv)
+    GL_CAPTURE_SWAP(glUniform4fv, uniform4fv)
+    GL_CAPTURE_SWAP(glUniformMatrix2fv, uniformMatrix2fv)
+    GL_CAPTURE_SWAP(glUniformMatrix3fv, uniformMatrix3fv)
+    GL_CAPTURE_SWAP(glUniformMatrix4fv, uniformMatrix4fv)
+    GL_CAPTURE_SWAP(glBufferData, bufferData)
+    GL_CAPTURE_SWAP(glBufferStorage, bufferStorage)
+    GL_CAPTURE_SWAP(glNamedBufferData, namedBufferData)
+    GL_CAPTURE_SWAP(glNamedBufferStorage, namedBufferStorage)
+    GL_CAPTURE_SWAP(glBufferSubData, bufferSubData)
+    GL_CAPTURE_SWAP(glNamedBufferSubData, namedBufferSubData)
+    GL_CAPTURE_SWAP(glMapBufferRange, mapBufferRange)
+    GL_CAPTURE_SWAP(glUnmapBuffer, unmapBuffer)
+    GL_CAPTURE_SWAP(glTexImage2D, texImage2D)
+    GL_CAPTURE_SWAP(glTexImage3D, texImage3D)
+    GL_CAPTURE_SWAP(glTexSubImage2D, texSubImage2D)
+    GL_CAPTURE_SWAP(glTexSubImage3D, texSubImage3D)
+    GL_CAPTURE_SWAP(glTextureSubImage2D, textureSubImage2D)
+    GL_CAPTURE_SWAP(glCompressedTexImage2D, compressedTexImage2D)
+    GL_CAPTURE_SWAP(glCompressedTexImage3D, compressedTexImage3D)
+    GL_CAPTURE_SWAP(glCompressedTexSubImage2D, compressedTexSubImage2D)
+    GL_CAPTURE_SWAP(glCompressedTexSubImage3D, compressedTexSubImage3D)
+    GL_CAPTURE_SWAP(glCompressedTextureSubImage2D, compressedTextureSubImage2D)
+    GL_CAPTURE_SWAP(glDrawBuffers, drawBuffers)
+    GL_CAPTURE_SWAP(glClearBufferfv, clearBufferfv)
+    GL_CAPTURE_SWAP(glClearBufferiv, clearBufferiv)
+    GL_CAPTURE_SWAP(glClearBufferuiv, clearBufferuiv)
+    GL_CAPTURE_SWAP(glMultiDrawElementsBaseVertex, multiDrawElementsBaseVertex)
+    GL_CAPTURE_SWAP(glTexParameteriv, texParameteriv)
+    GL_CAPTURE_SWAP(glClearBufferData, clearBufferData)
+    GL_CAPTURE_SWAP(glGenTextures, genTextures)
+    GL_CAPTURE_SWAP(glGenBuffers, genBuffers)
+    GL_CAPTURE_SWAP(glGenFramebuffers, genFramebuffers)
+    GL_CAPTURE_SWAP(glGenRenderbuffers, genRenderbuffers)
+    GL_CAPTURE_SWAP(glGenVertexArrays, genVertexArrays)
+    GL_CAPTURE_SWAP(glCreateTextures, createTextures)
+    GL_CAPTURE_SWAP(glCreateBuffers, createBuffers)
+    GL_CAPTURE_SWAP(glCreateFramebuffers, createFramebuffers)
+    GL_CAPTURE_SWAP(glCreateRenderbuffers, createRenderbuffers)
+    GL_CAPTURE_SWAP(glCreateVertexArrays, createVertexArrays)
+#undef GL_CAPTURE_SWAP
+}
+
+inline void GlCapture::removeHooks()
+{
+    using namespace glcapture;
+#define GL_CAPTURE_UNHOOK(op, function, names) unhookScalar<op>(glad_##function);
+    GL_CAPTURE_SCALAR_CALLS(GL_CAPTURE_UNHOOK)
+#undef GL_CAPTURE_UNHOOK
+#define GL_CAPTURE_RESTORE(function, type) \
+    if (CustomHooks::saved_##function())   \
+        glad_##function = CustomHooks::saved_##function();
+    GL_CAPTURE_CUSTOM_CALLS(GL_CAPTURE_RESTORE)
+#undef GL_CAPTURE_RESTORE
+}
+
+#endif
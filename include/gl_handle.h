@@ -0,0 +1,102 @@
+#ifndef GL_HANDLE_H
+#define GL_HANDLE_H
+
+#include <glad/glad.h>
+
+#include <gl_state.h>
+#include <gpu_memory.h>
+
+// Move-only owners of one GL object name: the object is deleted (and dropped from gpuMemory() and the
+// glState() cache where it can be in them) when the owner is reset, assigned or destroyed. Like every
+// GL call that has to happen on the GL thread with the context current, so owners that outlive the
+// context are reset() explicitly before glfwTerminate, as the releaseGpu() functions do with raw names.
+template <typename Kind>
+class GlHandle
+{
+public:
+    GlHandle() = default;
+    explicit GlHandle(GLuint id) : id(id) {}
+    ~GlHandle() { reset(); }
+
+    GlHandle(const GlHandle &) = delete;
+    GlHandle &operator=(const GlHandle &) = delete;
+
+    GlHandle(GlHandle &&other) : id(other.id) { other.id = 0; }
+    GlHandle &operator=(GlHandle &&other)
+    {
+        if (this != &other)
+        {
+            reset();
+            id = other.id;
+            other.id = 0;
+        }
+        return *this;
+    }
+
+    // GL thread: a new object (glGen* / glCreate*)
+    static GlHandle create() { return GlHandle(Kind::create()); }
+
+    GLuint get() const { return id; }
+    explicit operator bool() const { return id != 0; }
+
+    // GL thread: deletes the object owned so far and takes `name`
+    void reset(GLuint name = 0)
+    {
+        if (id && id != name)
+            Kind::destroy(id);
+        id = name;
+    }
+
+    // gives up ownership without deleting
+    GLuint release()
+    {
+        const GLuint name = id;
+        id = 0;
+        return name;
+    }
+
+private:
+    GLuint id = 0;
+};
+
+namespace GlKind
+{
+    struct Buffer
+    {
+        static GLuint create() { GLuint id = 0; glGenBuffers(1, &id); return id; }
+        static void destroy(GLuint id) { gpuMemory().releaseBuffer(id); glDeleteBuffers(1, &id); }
+    };
+
+    struct Texture
+    {
+        static GLuint create() { GLuint id = 0; glGenTextures(1, &id); return id; }
+        // a later texture can get the same name while the cache still has it bound
+        static void destroy(GLuint id) { gpuMemory().releaseTexture(id); glDeleteTextures(1, &id); glState().invalidate(); }
+    };
+
+    struct VertexArray
+    {
+        static GLuint create() { GLuint id = 0; glGenVertexArrays(1, &id); return id; }
+        static void destroy(GLuint id) { glDeleteVertexArrays(1, &id); glState().invalidate(); }
+    };
+
+    struct Framebuffer
+    {
+        static GLuint create() { GLuint id = 0; glGenFramebuffers(1, &id); return id; }
+        static void destroy(GLuint id) { glDeleteFramebuffers(1, &id); }
+    };
+
+    struct Program
+    {
+        static GLuint create() { return glCreateProgram(); }
+        static void destroy(GLuint id) { glDeleteProgram(id); glState().invalidate(); }
+    };
+}
+
+typedef GlHandle<GlKind::Buffer> GlBuffer;
+typedef GlHandle<GlKind::Texture> GlTexture;
+typedef GlHandle<GlKind::VertexArray> GlVertexArray;
+typedef GlHandle<GlKind::Framebuffer> GlFramebuffer;
+typedef GlHandle<GlKind::Program> GlProgram;
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <glad/glad.h>
+
+#include <draw_stats.h>
+
+// Shadow copy of the GL bind state the renderer touches most (program, VAO, texture units).
+// Binds that match the cached value are skipped. Code that binds GL objects directly (IBL bake,
+// texture upload at load time) must call invalidate() afterwards so the cache doesn't go stale.
+class GLStateCache
+{
+public:
+    static const unsigned int MAX_UNITS = 32;
+
+    GLStateCache()
+    {
+        invalidate();
+    }
+
+    void useProgram(GLuint program)
+    {
+        if (program == currentProgram)
+            return;
+        glUseProgram(program);
+        GL_STATS_ADD(programBinds, 1);
+        currentProgram = program;
+    }
+
+    void bindVertexArray(GLuint vao)
+    {
+        if (vao == currentVAO)
+            return;
+        glBindVertexArray(vao);
+        GL_STATS_ADD(vaoBinds, 1);
+        currentVAO = vao;
+    }
+
+    void activeTexture(unsigned int unit)
+    {
+        if (unit == currentUnit)
+            return;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        currentUnit = unit;
+    }
+
+    // binds `texture` to `target` on `unit`, skipping the bind (and the glActiveTexture) when already bound
+    void bindTexture(unsigned int unit, GLenum target, GLuint texture)
+    {
+        int slot = targetSlot(target);
+        if (unit < MAX_UNITS && slot >= 0 && boundTextures[unit][slot] == texture)
+            return;
+        activeTexture(unit);
+        glBindTexture(target, texture);
+        GL_STATS_ADD(textureBinds, 1);
+        if (unit < MAX_UNITS && slot >= 0)
+            boundTextures[unit][slot] = texture;
+    }
+
+    // bindTexture() for a texture that is only sampled: with direct state access (GlBackend) one
+    // glBindTextureUnit, without switching the active unit. Code that edits the bound texture afterwards
+    // (glTexParameteri and the like) needs bindTexture(), which makes `unit` active.
+    void bindTextureUnit(unsigned int unit, GLenum target, GLuint texture)
+    {
+        if (!directStateAccess || texture == 0)
+        {
+            bindTexture(unit, target, texture);
+            return;
+        }
+        int slot = targetSlot(target);
+        if (unit < MAX_UNITS && slot >= 0 && boundTextures[unit][slot] == texture)
+            return;
+        glBindTextureUnit(unit, texture);
+        GL_STATS_ADD(textureBinds, 1);
+        if (unit < MAX_UNITS && slot >= 0)
+            boundTextures[unit][slot] = texture;
+    }
+
+    // forget everything; the next bind of each kind always reaches the driver
+    void invalidate()
+    {
+        currentProgram = INVALID;
+        currentVAO = INVALID;
+        currentUnit = INVALID;
+        for (unsigned int u = 0; u < MAX_UNITS; ++u)
+            for (int t = 0; t < TARGET_SLOTS; ++t)
+                boundTextures[u][t] = INVALID;
+    }
+
+    GLuint program() const { return currentProgram; }
+    GLuint vertexArray() const { return currentVAO; }
+
+    // framebuffer the main view renders into (ToneMapper's HDR target, 0 = the window); passes that draw
+    // or read elsewhere (shadows, probes, OIT, Hi-Z) bind it back when they're done. Not touched by invalidate().
+    void setSceneFramebuffer(GLuint fbo) { sceneFbo = fbo; }
+    GLuint sceneFramebuffer() const { return sceneFbo; }
+
+    // set by GlBackend::init(); not touched by invalidate()
+    void setDirectStateAccess(bool enabled) { directStateAccess = enabled; }
+
+private:
+    static const GLuint INVALID = 0xFFFFFFFFu;
+    static const int TARGET_SLOTS = 3;
+
+    GLuint currentProgram;
+    GLuint currentVAO;
+    GLuint currentUnit;
+    GLuint sceneFbo = 0;
+    bool directStateAccess = false;
+    GLuint boundTextures[MAX_UNITS][TARGET_SLOTS];
+
+    static int targetSlot(GLenum target)
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_2D: return 0;
+        case GL_TEXTURE_CUBE_MAP: return 1;
+        case GL_TEXTURE_2D_ARRAY: return 2;
+        default: return -1; // untracked targets always bind
+        }
+    }
+};
+
+// the renderer runs on a single GL context, so one process-wide cache is enough
+inline GLStateCache &glState()
+{
+    static GLStateCache cache;
+    return cache;
+}
+
+#endif
@@ -0,0 +1,746 @@
+#ifndef GLTF_LOADER_H
+#define GLTF_LOADER_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <tiny_gltf.h>
+
+#include <json.hpp>
+#include <mesh.h>
+#include <meshopt_decoder.h>
+#include <thread_pool.h>
+#include <virtual_file_system.h>
+#include <geometry_kernels.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Helpers for the native glTF path of Model (tinygltf parses the JSON and loads scene.bin once, or
+// the .glb from its mapping; the implementation is compiled in src/tiny_gltf_impl.cpp). Everything here is geometry only,
+// materials and textures are handled by Model so both loaders share that code.
+namespace GltfLoader
+{
+    // local transform of a node: explicit matrix, or T * R * S
+    inline glm::mat4 nodeLocalMatrix(const tinygltf::Node &node)
+    {
+        if (node.matrix.size() == 16)
+        {
+            float m[16];
+            for (int i = 0; i < 16; ++i)
+                m[i] = (float)node.matrix[i];
+            return glm::make_mat4(m); // glTF is column-major like glm
+        }
+        glm::mat4 out(1.0f);
+        if (node.translation.size() == 3)
+            out = glm::translate(out, glm::vec3((float)node.translation[0], (float)node.translation[1], (float)node.translation[2]));
+        if (node.rotation.size() == 4)
+            out = out * glm::mat4_cast(glm::quat((float)node.rotation[3], (float)node.rotation[0], (float)node.rotation[1], (float)node.rotation[2]));
+        if (node.scale.size() == 3)
+            out = glm::scale(out, glm::vec3((float)node.scale[0], (float)node.scale[1], (float)node.scale[2]));
+        return out;
+    }
+
+    // bytes of one buffer: tinygltf's copy, or for a .glb's BIN chunk the file mapping it came from
+    struct BufferSpan
+    {
+        const unsigned char *data;
+        size_t size;
+    };
+    typedef std::vector<BufferSpan> BufferSpans;
+
+    // the spans of `model`'s buffers; with `binChunk` (the BIN chunk of the .glb it was parsed from, see
+    // glbChunks) the embedded buffer points there, so its copy in the model can be released
+    inline BufferSpans bufferSpans(const tinygltf::Model &model, const unsigned char *binChunk = NULL, size_t binSize = 0)
+    {
+        BufferSpans spans(model.buffers.size());
+        for (size_t i = 0; i < model.buffers.size(); ++i)
+        {
+            const tinygltf::Buffer &buffer = model.buffers[i];
+            // only the first buffer may be the BIN chunk, and only without a uri
+            if (i == 0 && binChunk && buffer.uri.empty())
+            {
+                spans[i].data = binChunk;
+                spans[i].size = binSize;
+            }
+            else
+            {
+                spans[i].data = buffer.data.empty() ? NULL : buffer.data.data();
+                spans[i].size = buffer.data.size();
+            }
+        }
+        return spans;
+    }
+
+    // count elements of `n` components of type T, `stride` bytes apart, into `out` (`components` floats per
+    // element) as v * scale, clamped at `minimum`: the normalized-integer rules, one loop per component type
+    template <typename T>
+    inline void decodeComponents(const unsigned char *base, size_t count, int stride, int n, int components, float scale, float minimum, float *out)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const unsigned char *elem = base + i * stride;
+            for (int c = 0; c < n; ++c)
+            {
+                T v;
+                memcpy(&v, elem + c * sizeof(T), sizeof(T));
+                out[i * components + c] = glm::max((float)v * scale, minimum);
+            }
+        }
+    }
+
+    // copies an attribute accessor into `out` as count * components floats (missing components are 0).
+    // Integer accessors (KHR_mesh_quantization: quantized positions, normals, tangents and UVs, dequantized by
+    // the node transform and KHR_texture_transform that loadGltf applies anyway) decode in the same pass; a
+    // tightly packed float stream is one copy
+    inline bool readFloatAccessor(const tinygltf::Model &model, const BufferSpans &buffers, int accessorIndex, int components, std::vector<float> &out)
+    {
+        if (accessorIndex < 0 || accessorIndex >= (int)model.accessors.size())
+            return false;
+        const tinygltf::Accessor &acc = model.accessors[accessorIndex];
+        out.assign(acc.count * components, 0.0f);
+        if (acc.bufferView < 0)
+            return true; // all zeros per spec (sparse data is not supported)
+        const tinygltf::BufferView &view = model.bufferViews[acc.bufferView];
+        if (view.buffer < 0 || view.buffer >= (int)buffers.size())
+            return false;
+        const BufferSpan &buffer = buffers[view.buffer];
+        int stride = acc.ByteStride(view);
+        int accComponents = tinygltf::GetNumComponentsInType((uint32_t)acc.type);
+        int componentSize = tinygltf::GetComponentSizeInBytes((uint32_t)acc.componentType);
+        if (stride <= 0 || accComponents <= 0 || componentSize <= 0)
+            return false;
+        size_t begin = view.byteOffset + acc.byteOffset;
+        if (acc.count > 0 && begin + (acc.count - 1) * stride + accComponents * componentSize > buffer.size)
+            return false;
+        if (acc.count == 0)
+            return true;
+        int n = glm::min(components, accComponents);
+        const unsigned char *base = buffer.data + begin;
+        const bool normalized = acc.normalized;
+        switch (acc.componentType)
+        {
+        case TINYGLTF_COMPONENT_TYPE_FLOAT:
+            if (n == components && stride == components * 4)
+                memcpy(&out[0], base, acc.count * stride);
+            else
+                decodeComponents<float>(base, acc.count, stride, n, components, 1.0f, -FLT_MAX, &out[0]);
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            decodeComponents<uint8_t>(base, acc.count, stride, n, components, normalized ? 1.0f / 255.0f : 1.0f, 0.0f, &out[0]);
+            break;
+        case TINYGLTF_COMPONENT_TYPE_BYTE:
+            decodeComponents<int8_t>(base, acc.count, stride, n, components, normalized ? 1.0f / 127.0f : 1.0f, normalized ? -1.0f : -FLT_MAX, &out[0]);
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            decodeComponents<uint16_t>(base, acc.count, stride, n, components, normalized ? 1.0f / 65535.0f : 1.0f, 0.0f, &out[0]);
+            break;
+        case TINYGLTF_COMPONENT_TYPE_SHORT:
+            decodeComponents<int16_t>(base, acc.count, stride, n, components, normalized ? 1.0f / 32767.0f : 1.0f, normalized ? -1.0f : -FLT_MAX, &out[0]);
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            decodeComponents<uint32_t>(base, acc.count, stride, n, components, 1.0f, 0.0f, &out[0]);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    // whether attribute accessor `accessorIndex` is stored as integers (KHR_mesh_quantization)
+    inline bool quantizedAccessor(const tinygltf::Model &model, int accessorIndex)
+    {
+        return accessorIndex >= 0 && accessorIndex < (int)model.accessors.size() &&
+               model.accessors[accessorIndex].componentType != TINYGLTF_COMPONENT_TYPE_FLOAT;
+    }
+
+    inline bool readIndexAccessor(const tinygltf::Model &model, const BufferSpans &buffers, int accessorIndex, std::vector<unsigned int> &out)
+    {
+        if (accessorIndex < 0 || accessorIndex >= (int)model.accessors.size())
+            return false;
+        const tinygltf::Accessor &acc = model.accessors[accessorIndex];
+        if (acc.bufferView < 0)
+            return false;
+        const tinygltf::BufferView &view = model.bufferViews[acc.bufferView];
+        if (view.buffer < 0 || view.buffer >= (int)buffers.size())
+            return false;
+        const BufferSpan &buffer = buffers[view.buffer];
+        int stride = acc.ByteStride(view);
+        int componentSize = tinygltf::GetComponentSizeInBytes((uint32_t)acc.componentType);
+        size_t begin = view.byteOffset + acc.byteOffset;
+        if (stride <= 0 || componentSize <= 0)
+            return false;
+        if (acc.count > 0 && begin + (acc.count - 1) * stride + componentSize > buffer.size)
+            return false;
+        const unsigned char *base = buffer.data + begin;
+        out.resize(acc.count);
+        for (size_t i = 0; i < acc.count; ++i)
+        {
+            const unsigned char *p = base + i * stride;
+            switch (acc.componentType)
+            {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: out[i] = *p; break;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: { unsigned short v; memcpy(&v, p, 2); out[i] = v; break; }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: { unsigned int v; memcpy(&v, p, 4); out[i] = v; break; }
+            default: return false;
+            }
+        }
+        return true;
+    }
+
+    // area-weighted smooth normals (what aiProcess_GenSmoothNormals gives for meshes without NORMAL)
+    inline void generateNormals(VertexStreams &vertices, const std::vector<unsigned int> &indices)
+    {
+        const std::vector<glm::vec3> &p = vertices.positions;
+        std::vector<glm::vec3> &normals = vertices.normals;
+        std::fill(normals.begin(), normals.end(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            glm::vec3 n = glm::cross(p[b] - p[a], p[c] - p[a]);
+            normals[a] += n; normals[b] += n; normals[c] += n;
+        }
+        for (size_t i = 0; i < normals.size(); ++i)
+        {
+            float l = glm::length(normals[i]);
+            normals[i] = l > 0.0f ? normals[i] / l : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    // per-vertex tangent frame from UV derivatives (for meshes without TANGENT, like aiProcess_CalcTangentSpace)
+    inline void generateTangents(VertexStreams &vertices, const std::vector<unsigned int> &indices)
+    {
+        const std::vector<glm::vec3> &p = vertices.positions;
+        const std::vector<glm::vec2> &uv = vertices.texCoords;
+        std::vector<glm::vec3> tan(vertices.size(), glm::vec3(0.0f)), bitan(vertices.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            unsigned int ia = indices[i], ib = indices[i + 1], ic = indices[i + 2];
+            glm::vec3 e1 = p[ib] - p[ia];
+            glm::vec3 e2 = p[ic] - p[ia];
+            glm::vec2 d1 = uv[ib] - uv[ia];
+            glm::vec2 d2 = uv[ic] - uv[ia];
+            float det = d1.x * d2.y - d2.x * d1.y;
+            if (std::fabs(det) < 1e-12f)
+                continue;
+            float r = 1.0f / det;
+            glm::vec3 t = (e1 * d2.y - e2 * d1.y) * r;
+            glm::vec3 b = (e2 * d1.x - e1 * d2.x) * r;
+            tan[ia] += t; tan[ib] += t; tan[ic] += t;
+            bitan[ia] += b; bitan[ib] += b; bitan[ic] += b;
+        }
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const glm::vec3 &n = vertices.normals[i];
+            glm::vec3 t = tan[i] - n * glm::dot(n, tan[i]);
+            if (glm::dot(t, t) < 1e-12f)
+                t = VertexPacking::anyTangent(n);
+            t = glm::normalize(t);
+            vertices.tangents[i] = glm::vec4(t, VertexPacking::tangentSign(n, t, bitan[i]));
+        }
+    }
+
+    // image of `texture`: its KHR_texture_basisu (KTX2) source with `basisu` (the transcoder is built in) and
+    // the extension present, else the regular source, which such files keep as a PNG/JPEG fallback (-1 if none)
+    inline int textureSource(const tinygltf::Texture &texture, bool basisu)
+    {
+        tinygltf::ExtensionMap::const_iterator it = texture.extensions.find("KHR_texture_basisu");
+        if (basisu && it != texture.extensions.end() && it->second.Has("source") && it->second.Get("source").IsInt())
+            return it->second.Get("source").GetNumberAsInt();
+        return texture.source;
+    }
+
+    // KHR_texture_transform of a texture reference, if present
+    inline bool readTextureTransform(const tinygltf::ExtensionMap &extensions, glm::vec2 &offset, glm::vec2 &scale, float &rotation)
+    {
+        tinygltf::ExtensionMap::const_iterator it = extensions.find("KHR_texture_transform");
+        if (it == extensions.end())
+            return false;
+        const tinygltf::Value &t = it->second;
+        if (t.Has("offset") && t.Get("offset").IsArray() && t.Get("offset").ArrayLen() >= 2)
+            offset = glm::vec2((float)t.Get("offset").Get(0).GetNumberAsDouble(), (float)t.Get("offset").Get(1).GetNumberAsDouble());
+        if (t.Has("scale") && t.Get("scale").IsArray() && t.Get("scale").ArrayLen() >= 2)
+            scale = glm::vec2((float)t.Get("scale").Get(0).GetNumberAsDouble(), (float)t.Get("scale").Get(1).GetNumberAsDouble());
+        if (t.Has("rotation"))
+            rotation = (float)t.Get("rotation").GetNumberAsDouble();
+        return true;
+    }
+
+    // KHR_materials_clearcoat factors of a material (false, and both untouched, if it has none). The
+    // clearcoat textures aren't read: the coat has the surface's geometric normal and uniform strength.
+    inline bool readClearcoat(const tinygltf::ExtensionMap &extensions, float &factor, float &roughness)
+    {
+        tinygltf::ExtensionMap::const_iterator it = extensions.find("KHR_materials_clearcoat");
+        if (it == extensions.end())
+            return false;
+        const tinygltf::Value &c = it->second;
+        factor = c.Has("clearcoatFactor") ? (float)c.Get("clearcoatFactor").GetNumberAsDouble() : 0.0f;
+        roughness = c.Has("clearcoatRoughnessFactor") ? (float)c.Get("clearcoatRoughnessFactor").GetNumberAsDouble() : 0.0f;
+        return true;
+    }
+
+    // KHR_materials_transmission factor of a material (false, and `factor` untouched, if it has none); the
+    // transmission texture isn't read
+    inline bool readTransmission(const tinygltf::ExtensionMap &extensions, float &factor)
+    {
+        tinygltf::ExtensionMap::const_iterator it = extensions.find("KHR_materials_transmission");
+        if (it == extensions.end())
+            return false;
+        const tinygltf::Value &t = it->second;
+        factor = t.Has("transmissionFactor") ? (float)t.Get("transmissionFactor").GetNumberAsDouble() : 0.0f;
+        return true;
+    }
+
+    // KHR_materials_specular factors of a material (false, and both untouched, if it has none); the
+    // specular textures aren't read
+    inline bool readSpecular(const tinygltf::ExtensionMap &extensions, float &factor, glm::vec3 &color)
+    {
+        tinygltf::ExtensionMap::const_iterator it = extensions.find("KHR_materials_specular");
+        if (it == extensions.end())
+            return false;
+        const tinygltf::Value &s = it->second;
+        factor = s.Has("specularFactor") ? (float)s.Get("specularFactor").GetNumberAsDouble() : 1.0f;
+        color = glm::vec3(1.0f);
+        if (s.Has("specularColorFactor") && s.Get("specularColorFactor").IsArray() && s.Get("specularColorFactor").ArrayLen() >= 3)
+            for (int c = 0; c < 3; ++c)
+                color[c] = (float)s.Get("specularColorFactor").Get(c).GetNumberAsDouble();
+        return true;
+    }
+
+    // KHR_materials_variants: the names of the file's variants, in index order (empty without the extension)
+    inline std::vector<std::string> readVariantNames(const tinygltf::Model &model)
+    {
+        std::vector<std::string> names;
+        tinygltf::ExtensionMap::const_iterator it = model.extensions.find("KHR_materials_variants");
+        if (it == model.extensions.end() || !it->second.Has("variants") || !it->second.Get("variants").IsArray())
+            return names;
+        const tinygltf::Value &variants = it->second.Get("variants");
+        for (size_t i = 0; i < variants.ArrayLen(); ++i)
+        {
+            const tinygltf::Value &v = variants.Get(i);
+            names.push_back(v.Has("name") && v.Get("name").IsString() ? v.Get("name").Get<std::string>() : "variant " + std::to_string(i));
+        }
+        return names;
+    }
+
+    // KHR_materials_variants mappings of a primitive: the material of each of the `variantCount` variants
+    // (-1 = the primitive's own). Empty if the primitive has no mappings.
+    inline std::vector<int> readVariantMappings(const tinygltf::Primitive &prim, size_t variantCount)
+    {
+        std::vector<int> materials;
+        tinygltf::ExtensionMap::const_iterator it = prim.extensions.find("KHR_materials_variants");
+        if (it == prim.extensions.end() || !it->second.Has("mappings") || !it->second.Get("mappings").IsArray())
+            return materials;
+        const tinygltf::Value &mappings = it->second.Get("mappings");
+        materials.assign(variantCount, -1);
+        for (size_t m = 0; m < mappings.ArrayLen(); ++m)
+        {
+            const tinygltf::Value &mapping = mappings.Get(m);
+            if (!mapping.Has("material") || !mapping.Has("variants") || !mapping.Get("variants").IsArray())
+                continue;
+            const int material = mapping.Get("material").GetNumberAsInt();
+            const tinygltf::Value &variants = mapping.Get("variants");
+            for (size_t v = 0; v < variants.ArrayLen(); ++v)
+            {
+                const int variant = variants.Get(v).GetNumberAsInt();
+                if (variant >= 0 && variant < (int)variantCount)
+                    materials[variant] = material;
+            }
+        }
+        return materials;
+    }
+
+    // builds the vertices/indices of one triangle primitive with `world` baked in.
+    // UVs are flipped (v = 1 - v) to match the Assimp path's aiProcess_FlipUVs. Tangents are read or
+    // generated only with `wantTangents` (the material has a normal map); otherwise the stream stays empty.
+    // Accessor data is read through `buffers` (bufferSpans of `model`).
+    inline bool loadPrimitive(const tinygltf::Model &model, const BufferSpans &buffers, const tinygltf::Primitive &prim, const glm::mat4 &world, bool wantTangents,
+                              VertexStreams &vertices, std::vector<unsigned int> &indices, std::string &error)
+    {
+        std::map<std::string, int>::const_iterator pos = prim.attributes.find("POSITION");
+        if (pos == prim.attributes.end())
+        {
+            error = "primitive has no POSITION";
+            return false;
+        }
+        std::vector<float> positions, normals, uvs, tangents;
+        if (!readFloatAccessor(model, buffers, pos->second, 3, positions))
+        {
+            error = "bad POSITION accessor";
+            return false;
+        }
+        size_t count = positions.size() / 3;
+        std::map<std::string, int>::const_iterator it = prim.attributes.find("NORMAL");
+        bool hasNormals = it != prim.attributes.end() && readFloatAccessor(model, buffers, it->second, 3, normals) && normals.size() == count * 3;
+        it = prim.attributes.find("TEXCOORD_0");
+        bool hasUVs = it != prim.attributes.end() && readFloatAccessor(model, buffers, it->second, 2, uvs) && uvs.size() == count * 2;
+        it = prim.attributes.find("TANGENT");
+        bool hasTangents = wantTangents && hasNormals && it != prim.attributes.end() && readFloatAccessor(model, buffers, it->second, 4, tangents) && tangents.size() == count * 4;
+
+        if (prim.indices >= 0)
+        {
+            if (!readIndexAccessor(model, buffers, prim.indices, indices))
+            {
+                error = "bad index accessor";
+                return false;
+            }
+        }
+        else
+        {
+            indices.resize(count);
+            for (size_t i = 0; i < count; ++i)
+                indices[i] = (unsigned int)i;
+        }
+        indices.resize(indices.size() - indices.size() % 3);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            if (indices[i] >= count)
+            {
+                error = "index out of range";
+                return false;
+            }
+        }
+
+        glm::mat3 normalMat = glm::transpose(glm::inverse(glm::mat3(world)));
+        vertices.resize(count, wantTangents);
+        if (count == 0)
+            return true;
+        // accessor streams map onto the vertex streams one to one; missing attributes stay zero
+        GeometryKernels::transformPoints(world, &positions[0], 3 * sizeof(float), &vertices.positions[0].x, sizeof(glm::vec3), count);
+        if (hasNormals)
+            GeometryKernels::transformDirections(normalMat, &normals[0], 3 * sizeof(float), &vertices.normals[0].x, sizeof(glm::vec3), count, true);
+        if (hasUVs)
+            std::memcpy(&vertices.texCoords[0], &uvs[0], count * sizeof(glm::vec2));
+        if (hasTangents)
+        {
+            // xyz transformed in place of the stream's vec4s; w keeps the handedness, flipped under a mirroring
+            // node transform (which turns cross(N, T) around but not the UV-space bitangent)
+            GeometryKernels::transformDirections(glm::mat3(world), &tangents[0], 4 * sizeof(float), &vertices.tangents[0].x, sizeof(glm::vec4), count, true);
+            const float mirror = glm::determinant(glm::mat3(world)) < 0.0f ? -1.0f : 1.0f;
+            for (size_t i = 0; i < count; ++i)
+                vertices.tangents[i].w = tangents[i * 4 + 3] < 0.0f ? -mirror : mirror;
+        }
+        if (!hasNormals)
+            generateNormals(vertices, indices);
+        // tangents are derived in glTF UV space, same as supplied TANGENT data, before the flip below
+        if (wantTangents && !hasTangents && hasUVs)
+            generateTangents(vertices, indices);
+        for (size_t i = 0; i < count; ++i)
+            vertices.texCoords[i].y = 1.0f - vertices.texCoords[i].y;
+        return true;
+    }
+
+    // JOINTS_0/WEIGHTS_0 of a skinned primitive into the skin stream of `vertices` (filled by loadPrimitive):
+    // joint j of the skin becomes palette slot `paletteBase` + j; joints past `jointCount` get no weight.
+    // False, with the stream left empty, if the primitive has neither.
+    inline bool loadSkinAttributes(const tinygltf::Model &model, const BufferSpans &buffers, const tinygltf::Primitive &prim, unsigned int paletteBase,
+                                   size_t jointCount, VertexStreams &vertices)
+    {
+        std::map<std::string, int>::const_iterator j = prim.attributes.find("JOINTS_0"), w = prim.attributes.find("WEIGHTS_0");
+        std::vector<float> joints, weights;
+        const size_t count = vertices.size();
+        if (j == prim.attributes.end() || w == prim.attributes.end() || !readFloatAccessor(model, buffers, j->second, 4, joints)
+            || !readFloatAccessor(model, buffers, w->second, 4, weights) || joints.size() != count * 4 || weights.size() != count * 4)
+            return false;
+        vertices.joints.resize(count);
+        vertices.weights.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                const size_t joint = (size_t)joints[i * 4 + k];
+                const bool valid = joint < jointCount;
+                vertices.joints[i][k] = paletteBase + (valid ? (unsigned int)joint : 0u);
+                vertices.weights[i][k] = valid ? weights[i * 4 + k] : 0.0f;
+            }
+        }
+        return true;
+    }
+
+    // reads the .gltf and its buffer files (scene.bin) through the VirtualFileSystem: one copy from the
+    // memory mapping (of the file, or of the .carpak holding it) into the tinygltf buffer, no stream
+    // buffering. Falls back to tinygltf's reader if neither has the file.
+    inline bool readWholeFileMapped(std::vector<unsigned char> *out, std::string *err, const std::string &path, void *userData)
+    {
+        FileView file;
+        if (!fileSystem().open(path, file))
+            return tinygltf::ReadWholeFile(out, err, path, userData);
+        out->assign(file.data(), file.data() + file.size());
+        return true;
+    }
+
+    inline bool fileExistsMapped(const std::string &path, void *userData)
+    {
+        return fileSystem().exists(path) || tinygltf::FileExists(path, userData);
+    }
+
+    inline bool fileSizeMapped(size_t *size, std::string *err, const std::string &path, void *userData)
+    {
+        // archive entries by their directory record, without inflating them
+        uint64_t archivedSize = 0;
+        uint32_t crc = 0;
+        if (!fileSystem().archivedEntry(path, archivedSize, crc))
+            return tinygltf::GetFileSizeInBytes(size, err, path, userData);
+        *size = (size_t)archivedSize;
+        return true;
+    }
+
+    inline tinygltf::FsCallbacks mappedFsCallbacks()
+    {
+        tinygltf::FsCallbacks fs;
+        fs.FileExists = &fileExistsMapped;
+        fs.ExpandFilePath = &tinygltf::ExpandFilePath;
+        fs.ReadWholeFile = &readWholeFileMapped;
+        fs.WriteWholeFile = &tinygltf::WriteWholeFile;
+        fs.GetFileSizeInBytes = &fileSizeMapped;
+        fs.user_data = NULL;
+        return fs;
+    }
+
+    // tinygltf image callback that keeps the image undecoded; Model loads textures itself from the URIs
+    inline bool skipImageData(tinygltf::Image *, const int, std::string *, std::string *, int, int, const unsigned char *, int, void *)
+    {
+        return true;
+    }
+
+    // bytes of the images given as data: URIs, by image index (the only images whose bytes exist nowhere
+    // but in tinygltf's base64 decode)
+    typedef std::map<int, std::shared_ptr<const std::vector<unsigned char> > > DataUriImages;
+
+    // image callback that keeps data: URI images (into the DataUriImages at `userData`) and skips the rest
+    // undecoded: external files are loaded by Model from their URIs, bufferView images from their buffer's
+    // file in place
+    inline bool keepDataUriImages(tinygltf::Image *image, const int index, std::string *, std::string *, int, int,
+                                  const unsigned char *bytes, int size, void *userData)
+    {
+        if (image->bufferView < 0 && userData && bytes && size > 0)
+            (*(DataUriImages *)userData)[index] = std::make_shared<const std::vector<unsigned char> >(bytes, bytes + size);
+        return true;
+    }
+
+    // the JSON and BIN chunks of the .glb `glb` (`size` bytes): pointers into it and their lengths; false if
+    // it isn't a .glb. `bin` stays NULL (and `binSize` 0) without a BIN chunk.
+    inline bool glbChunks(const unsigned char *glb, size_t size, const char *&json, size_t &jsonSize,
+                          const unsigned char *&bin, size_t &binSize)
+    {
+        // 12-byte header ("glTF", version, length), then chunks of (length, type, data); JSON comes first
+        bin = NULL;
+        binSize = 0;
+        if (size < 20 || std::memcmp(glb, "glTF", 4) != 0 || std::memcmp(glb + 16, "JSON", 4) != 0)
+            return false;
+        uint32_t jsonLength;
+        std::memcpy(&jsonLength, glb + 12, 4);
+        if (20 + (uint64_t)jsonLength > size)
+            return false;
+        json = (const char *)glb + 20;
+        jsonSize = jsonLength;
+        const uint64_t binHeader = 20 + (uint64_t)jsonLength;
+        if (binHeader + 8 > size || std::memcmp(glb + binHeader + 4, "BIN\0", 4) != 0)
+            return true;
+        uint32_t binLength;
+        std::memcpy(&binLength, glb + binHeader, 4);
+        if (binHeader + 8 + binLength > size)
+            return true;
+        bin = glb + binHeader + 8;
+        binSize = binLength;
+        return true;
+    }
+
+    // EXT_meshopt_compression fallback buffers hold the uncompressed geometry for loaders without the
+    // extension; gltfpack leaves them without a uri, which tinygltf can't load. The JSON `json` is rewritten
+    // with each one pointing at a 4-byte data: URI, so tinygltf neither reads nor allocates them, and their
+    // real byteLengths go to `fallbackSizes` (by buffer index, 0 = not a fallback). Empty if there are none.
+    inline std::string stubMeshoptFallbacks(const char *json, size_t size, std::vector<uint64_t> &fallbackSizes)
+    {
+        static const char EXTENSION[] = "EXT_meshopt_compression";
+        fallbackSizes.clear();
+        if (std::search(json, json + size, EXTENSION, EXTENSION + sizeof(EXTENSION) - 1) == json + size)
+            return std::string();
+        nlohmann::json document = nlohmann::json::parse(json, json + size, nullptr, false);
+        if (document.is_discarded() || !document.contains("buffers") || !document["buffers"].is_array())
+            return std::string();
+        nlohmann::json &buffers = document["buffers"];
+        bool stubbed = false;
+        fallbackSizes.assign(buffers.size(), 0);
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            nlohmann::json &buffer = buffers[i];
+            if (!buffer.is_object() || !buffer.contains("extensions") || !buffer["extensions"].is_object())
+                continue;
+            const nlohmann::json &extensions = buffer["extensions"];
+            nlohmann::json::const_iterator ext = extensions.find(EXTENSION);
+            if (ext == extensions.end() || !ext->is_object() || !ext->value("fallback", false))
+                continue;
+            fallbackSizes[i] = buffer.value("byteLength", (uint64_t)0);
+            buffer["uri"] = "data:application/octet-stream;base64,AAAAAA==";
+            buffer["byteLength"] = 4;
+            stubbed = true;
+        }
+        if (!stubbed)
+        {
+            fallbackSizes.clear();
+            return std::string();
+        }
+        return document.dump();
+    }
+
+    // a .glb of the JSON `json` and the BIN chunk `bin` (NULL: none), for handing a rewritten document to
+    // tinygltf
+    inline std::vector<unsigned char> buildGlb(const std::string &json, const unsigned char *bin, size_t binSize)
+    {
+        // chunks are 4-byte aligned: JSON padded with spaces, BIN with zeros
+        const uint32_t jsonLength = (uint32_t)((json.size() + 3) & ~(size_t)3);
+        const uint32_t binLength = (uint32_t)((binSize + 3) & ~(size_t)3);
+        const uint32_t total = 20 + jsonLength + (bin ? 8 + binLength : 0);
+        const uint32_t version = 2;
+        std::vector<unsigned char> glb(total, 0);
+        std::memcpy(&glb[0], "glTF", 4);
+        std::memcpy(&glb[4], &version, 4);
+        std::memcpy(&glb[8], &total, 4);
+        std::memcpy(&glb[12], &jsonLength, 4);
+        std::memcpy(&glb[16], "JSON", 4);
+        std::memcpy(&glb[20], json.data(), json.size());
+        std::memset(&glb[20 + json.size()], ' ', jsonLength - json.size());
+        if (bin)
+        {
+            const size_t chunk = 20 + (size_t)jsonLength;
+            std::memcpy(&glb[chunk], &binLength, 4);
+            std::memcpy(&glb[chunk + 4], "BIN\0", 4);
+            std::memcpy(&glb[chunk + 8], bin, binSize);
+        }
+        return glb;
+    }
+
+    // decodes the bufferViews compressed with EXT_meshopt_compression in parallel on the shared pool, one
+    // job per view (each stream decodes front to back), into `decoded`: a vector per buffer holding such
+    // views, sized as the JSON declares it (`fallbackSizes` from stubMeshoptFallbacks). `buffers` then
+    // points there, so the accessors read the decoded bytes like any others. Returns the number of views
+    // decoded, or -1 with `error`.
+    inline int decodeMeshoptViews(const tinygltf::Model &model, const std::vector<uint64_t> &fallbackSizes, BufferSpans &buffers,
+                                  std::vector<std::vector<unsigned char> > &decoded, std::string &error)
+    {
+        enum Mode { ATTRIBUTES, TRIANGLES, INDICES };
+        enum Filter { NONE, OCTAHEDRAL, QUATERNION, EXPONENTIAL };
+        struct Job
+        {
+            int view;
+            const unsigned char *source;
+            size_t sourceSize, count, stride;
+            Mode mode;
+            Filter filter;
+        };
+        std::vector<Job> jobs;
+        std::vector<uint64_t> targetSizes(model.buffers.size(), 0);
+        for (size_t v = 0; v < model.bufferViews.size(); ++v)
+        {
+            const tinygltf::BufferView &view = model.bufferViews[v];
+            tinygltf::ExtensionMap::const_iterator it = view.extensions.find("EXT_meshopt_compression");
+            if (it == view.extensions.end())
+                continue;
+            const tinygltf::Value &ext = it->second;
+            const int source = ext.Get("buffer").GetNumberAsInt();
+            const size_t offset = ext.Has("byteOffset") ? (size_t)ext.Get("byteOffset").GetNumberAsDouble() : 0;
+            const size_t length = (size_t)ext.Get("byteLength").GetNumberAsDouble();
+            const std::string mode = ext.Get("mode").IsString() ? ext.Get("mode").Get<std::string>() : std::string();
+            const std::string filter = ext.Get("filter").IsString() ? ext.Get("filter").Get<std::string>() : std::string("NONE");
+            Job job;
+            job.view = (int)v;
+            job.count = (size_t)ext.Get("count").GetNumberAsDouble();
+            job.stride = (size_t)ext.Get("byteStride").GetNumberAsDouble();
+            job.mode = mode == "TRIANGLES" ? TRIANGLES : mode == "INDICES" ? INDICES : ATTRIBUTES;
+            job.filter = filter == "OCTAHEDRAL" ? OCTAHEDRAL : filter == "QUATERNION" ? QUATERNION : filter == "EXPONENTIAL" ? EXPONENTIAL : NONE;
+            if ((mode != "ATTRIBUTES" && mode != "TRIANGLES" && mode != "INDICES") || (filter != "NONE" && job.filter == NONE)
+                || (job.filter == OCTAHEDRAL && job.stride != 4 && job.stride != 8) || (job.filter == QUATERNION && job.stride != 8)
+                || (job.filter == EXPONENTIAL && job.stride % 4 != 0) || (job.filter != NONE && job.mode != ATTRIBUTES))
+            {
+                error = "bufferView " + std::to_string(v) + ": unsupported EXT_meshopt_compression mode '" + mode + "' / filter '" + filter + "'";
+                return -1;
+            }
+            if (source < 0 || source >= (int)buffers.size() || offset + length > buffers[source].size || !buffers[source].data
+                || view.buffer < 0 || view.buffer >= (int)buffers.size() || job.count * job.stride > view.byteLength)
+            {
+                error = "bufferView " + std::to_string(v) + ": EXT_meshopt_compression data out of range";
+                return -1;
+            }
+            job.source = buffers[source].data + offset;
+            job.sourceSize = length;
+            const uint64_t size = (size_t)view.buffer < fallbackSizes.size() && fallbackSizes[view.buffer] ? fallbackSizes[view.buffer]
+                                                                                                             : (uint64_t)buffers[view.buffer].size;
+            if (view.byteOffset + view.byteLength > size)
+            {
+                error = "bufferView " + std::to_string(v) + " exceeds its buffer";
+                return -1;
+            }
+            targetSizes[view.buffer] = size;
+            jobs.push_back(job);
+        }
+        if (jobs.empty())
+            return 0;
+        // the compressed views' buffers get storage of their own (keeping any uncompressed views already in
+        // them); the sources were taken from the spans before
+        decoded.assign(model.buffers.size(), std::vector<unsigned char>());
+        for (size_t b = 0; b < targetSizes.size(); ++b)
+        {
+            if (!targetSizes[b])
+                continue;
+            decoded[b].assign((size_t)targetSizes[b], 0);
+            const bool fallback = b < fallbackSizes.size() && fallbackSizes[b];
+            if (!fallback && buffers[b].data)
+                std::memcpy(&decoded[b][0], buffers[b].data, std::min((size_t)targetSizes[b], buffers[b].size));
+            buffers[b].data = decoded[b].data();
+            buffers[b].size = decoded[b].size();
+        }
+        std::vector<char> failed(jobs.size(), 0);
+        ThreadPool::shared().parallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t j = begin; j < end; ++j)
+            {
+                const Job &job = jobs[j];
+                const tinygltf::BufferView &view = model.bufferViews[job.view];
+                unsigned char *target = &decoded[view.buffer][view.byteOffset];
+                bool ok;
+                if (job.mode == TRIANGLES)
+                    ok = MeshoptDecoder::decodeIndexBuffer(target, job.count, job.stride, job.source, job.sourceSize);
+                else if (job.mode == INDICES)
+                    ok = MeshoptDecoder::decodeIndexSequence(target, job.count, job.stride, job.source, job.sourceSize);
+                else
+                    ok = MeshoptDecoder::decodeVertexBuffer(target, job.count, job.stride, job.source, job.sourceSize);
+                if (ok && job.filter == OCTAHEDRAL && job.stride == 4)
+                    MeshoptDecoder::decodeFilterOctahedral((signed char *)target, job.count);
+                else if (ok && job.filter == OCTAHEDRAL)
+                    MeshoptDecoder::decodeFilterOctahedral((int16_t *)target, job.count);
+                else if (ok && job.filter == QUATERNION)
+                    MeshoptDecoder::decodeFilterQuaternion((int16_t *)target, job.count);
+                else if (ok && job.filter == EXPONENTIAL)
+                    MeshoptDecoder::decodeFilterExponential((uint32_t *)target, job.count * job.stride / 4);
+                failed[j] = !ok;
+            }
+        }, "decode meshopt");
+        for (size_t j = 0; j < jobs.size(); ++j)
+            if (failed[j])
+            {
+                error = "bufferView " + std::to_string(jobs[j].view) + ": corrupt EXT_meshopt_compression stream";
+                return -1;
+            }
+        return (int)jobs.size();
+    }
+
+    inline bool isGlbPath(const std::string &path)
+    {
+        if (path.size() < 4)
+            return false;
+        std::string ext = path.substr(path.size() - 4);
+        for (size_t i = 0; i < ext.size(); ++i)
+            ext[i] = (char)std::tolower((unsigned char)ext[i]);
+        return ext == ".glb";
+    }
+}
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef GPU_MEMORY_H
+#define GPU_MEMORY_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifndef GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX
+#define GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX 0x9048
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#endif
+#ifndef GL_TEXTURE_FREE_MEMORY_ATI
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+#endif
+
+// Registry of the GL textures and buffers the renderer allocates for models (Model geometry, draw and
+// instance buffers, material textures and texture arrays) and environments (IBL maps, the equirect source,
+// the BRDF LUT): size, internal format and owner (a model's directory, an image path, "ibl"), with running
+// totals per category. Sizes are what the driver has to allocate at least: every mip level, 6 faces for
+// cube maps, 3-channel formats padded to 4 as drivers store them, buffers at their glBufferData size.
+// Render targets and culling buffers of the passes aren't tracked (they scale with the window, not the
+// content). Where the driver reports its memory (GL_NVX_gpu_memory_info, GL_ATI_meminfo) queryDriver()
+// returns it too. VRAM_BUDGET_MB=N warns once when the tracked total first exceeds N MB.
+class GpuMemory
+{
+public:
+    enum Category { MODEL_TEXTURES, MODEL_GEOMETRY, DRAW_BUFFERS, ENVIRONMENT, CATEGORY_COUNT };
+
+    struct Totals
+    {
+        size_t bytes[CATEGORY_COUNT] = {};
+        size_t objects[CATEGORY_COUNT] = {};
+
+        size_t total() const
+        {
+            size_t sum = 0;
+            for (int c = 0; c < CATEGORY_COUNT; ++c)
+                sum += bytes[c];
+            return sum;
+        }
+    };
+
+    // what the driver says, in KB; `source` is NULL when neither extension is there
+    struct DriverInfo
+    {
+        const char *source = nullptr;
+        size_t totalKb = 0; // 0 where unknown (GL_ATI_meminfo only reports free memory)
+        size_t freeKb = 0;
+    };
+
+    GpuMemory()
+    {
+        if (const char *b = std::getenv("VRAM_BUDGET_MB"))
+            budgetBytes = (size_t)std::max(0, std::atoi(b)) << 20;
+    }
+
+    GpuMemory(const GpuMemory &) = delete;
+    GpuMemory &operator=(const GpuMemory &) = delete;
+
+    static const char *categoryName(Category c)
+    {
+        static const char *names[CATEGORY_COUNT] = {"model textures", "model geometry", "draw buffers", "environment"};
+        return names[c];
+    }
+
+    // GL thread: records texture `id` (again after it was re-specified, e.g. a placeholder replaced by the
+    // image); `layers` is 6 for cube maps, the layer count for arrays
+    void trackTexture(GLuint id, Category category, GLenum internalFormat, int width, int height, int layers, bool mipmapped, const std::string &owner)
+    {
+        track(textures, id, category, textureBytes(internalFormat, width, height, layers, mipmapped), internalFormat, owner);
+    }
+
+    // GL thread: records buffer `id` at `bytes` (again whenever glBufferData resized it)
+    void trackBuffer(GLuint id, Category category, size_t bytes, const std::string &owner)
+    {
+        track(buffers, id, category, bytes, 0, owner);
+    }
+
+    // before glDeleteTextures / glDeleteBuffers; unknown ids are ignored
+    void releaseTexture(GLuint id) { untrack(textures, id); }
+    void releaseBuffer(GLuint id) { untrack(buffers, id); }
+
+    const Totals &totals() const { return sums; }
+
+    // tracked bytes of one texture / buffer, 0 for unknown ids
+    size_t textureSize(GLuint id) const { return sizeOf(textures, id); }
+    size_t bufferSize(GLuint id) const { return sizeOf(buffers, id); }
+
+    // tracked bytes per owner, largest first
+    std::vector<std::pair<size_t, std::string> > owners() const
+    {
+        std::map<std::string, size_t> byOwner;
+        for (std::map<GLuint, Entry>::const_iterator it = textures.begin(); it != textures.end(); ++it)
+            byOwner[it->second.owner] += it->second.bytes;
+        for (std::map<GLuint, Entry>::const_iterator it = buffers.begin(); it != buffers.end(); ++it)
+            byOwner[it->second.owner] += it->second.bytes;
+        std::vector<std::pair<size_t, std::string> > sorted;
+        for (std::map<std::string, size_t>::const_iterator it = byOwner.begin(); it != byOwner.end(); ++it)
+            sorted.push_back(std::make_pair(it->second, it->first));
+        std::sort(sorted.rbegin(), sorted.rend());
+        return sorted;
+    }
+
+    // GL thread: GL_NVX_gpu_memory_info (total and free video memory) or GL_ATI_meminfo (free texture memory)
+    DriverInfo queryDriver()
+    {
+        if (extensions < 0)
+            findExtensions();
+        DriverInfo info;
+        if (extensions & NVX)
+        {
+            GLint total = 0, available = 0;
+            glGetIntegerv(GL_GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX, &total);
+            glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+            info.source = "GL_NVX_gpu_memory_info";
+            info.totalKb = (size_t)std::max(total, 0);
+            info.freeKb = (size_t)std::max(available, 0);
+        }
+        else if (extensions & ATI)
+        {
+            GLint free[4] = {0, 0, 0, 0}; // total free, largest free block, total auxiliary free, largest auxiliary block
+            glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, free);
+            info.source = "GL_ATI_meminfo";
+            info.freeKb = (size_t)std::max(free[0], 0);
+        }
+        return info;
+    }
+
+    // GL thread: totals per category, the largest owners and the driver's numbers
+    void report(std::ostream &out, size_t topOwners = 8)
+    {
+        out << "[GpuMemory] " << mb(sums.total()) << " MB tracked";
+        if (budgetBytes)
+            out << " of a " << mb(budgetBytes) << " MB budget";
+        out << "\n";
+        for (int c = 0; c < CATEGORY_COUNT; ++c)
+            out << "  " << categoryName((Category)c) << ": " << mb(sums.bytes[c]) << " MB in " << sums.objects[c] << " objects\n";
+        const std::vector<std::pair<size_t, std::string> > largest = owners();
+        for (size_t i = 0; i < largest.size() && i < topOwners; ++i)
+            out << "  " << mb(largest[i].first) << " MB  " << largest[i].second << "\n";
+        const DriverInfo driver = queryDriver();
+        if (driver.source && driver.totalKb)
+            out << "  driver (" << driver.source << "): " << (driver.totalKb - std::min(driver.freeKb, driver.totalKb)) / 1024 << " MB used of " << driver.totalKb / 1024 << " MB\n";
+        else if (driver.source)
+            out << "  driver (" << driver.source << "): " << driver.freeKb / 1024 << " MB free\n";
+    }
+
+    // GL thread, at exit once every owner released its objects: logs the textures and buffers still
+    // tracked, each a leak or a releaseGpu() that missed one. Returns how many there were.
+    size_t reportLeaks(size_t maxListed = 16) const
+    {
+        const size_t leaked = textures.size() + buffers.size();
+        if (!leaked)
+        {
+            LOG_INFO("[GpuMemory] Every tracked texture and buffer was released");
+            return 0;
+        }
+        LOG_WARN("[GpuMemory] " << leaked << " objects (" << mb(sums.total()) << " MB) still tracked at exit");
+        size_t listed = 0;
+        const std::map<GLuint, Entry> *kinds[2] = {&textures, &buffers};
+        for (int k = 0; k < 2; ++k)
+            for (std::map<GLuint, Entry>::const_iterator it = kinds[k]->begin(); it != kinds[k]->end() && listed < maxListed; ++it, ++listed)
+                LOG_WARN("  " << (k == 0 ? "texture " : "buffer ") << it->first << ": " << categoryName(it->second.category) << ", "
+                              << mb(it->second.bytes) << " MB, " << it->second.owner);
+        return leaked;
+    }
+
+    // bytes of a `width` x `height` x `layers` texture in `internalFormat`, with its full mip chain if `mipmapped`
+    static size_t textureBytes(GLenum internalFormat, int width, int height, int layers, bool mipmapped)
+    {
+        const size_t block = blockBytes(internalFormat);
+        size_t bytes = 0;
+        int w = std::max(width, 1), h = std::max(height, 1);
+        for (;;)
+        {
+            if (block)
+                bytes += (size_t)((w + 3) / 4) * ((h + 3) / 4) * block;
+            else
+                bytes += (size_t)w * h * texelBytes(internalFormat);
+            if (!mipmapped || (w == 1 && h == 1))
+                break;
+            w = std::max(w / 2, 1);
+            h = std::max(h / 2, 1);
+        }
+        return bytes * (size_t)std::max(layers, 1);
+    }
+
+    static double mb(size_t bytes) { return (double)(bytes * 10 / (1 << 20)) / 10.0; }
+
+private:
+    enum { NVX = 1, ATI = 2 };
+
+    struct Entry
+    {
+        Category category;
+        size_t bytes;
+        GLenum format; // internal format of textures, 0 for buffers
+        std::string owner;
+    };
+
+    std::map<GLuint, Entry> textures, buffers;
+    Totals sums;
+    size_t budgetBytes = 0;
+    bool budgetWarned = false;
+    int extensions = -1; // NVX | ATI once looked up
+
+    void track(std::map<GLuint, Entry> &entries, GLuint id, Category category, size_t bytes, GLenum format, const std::string &owner)
+    {
+        if (!id)
+            return;
+        // streamed buffers are re-specified every frame, mostly at the same size
+        std::map<GLuint, Entry>::const_iterator known = entries.find(id);
+        if (known != entries.end() && known->second.bytes == bytes && known->second.category == category && known->second.format == format)
+            return;
+        untrack(entries, id);
+        Entry e = {category, bytes, format, owner};
+        entries[id] = e;
+        sums.bytes[category] += bytes;
+        sums.objects[category]++;
+        if (budgetBytes && !budgetWarned && sums.total() > budgetBytes)
+        {
+            budgetWarned = true;
+            LOG_WARN("[GpuMemory] " << mb(sums.total()) << " MB tracked, over the " << mb(budgetBytes) << " MB budget (VRAM_BUDGET_MB), last: "
+                                    << mb(bytes) << " MB for " << owner);
+        }
+    }
+
+    static size_t sizeOf(const std::map<GLuint, Entry> &entries, GLuint id)
+    {
+        std::map<GLuint, Entry>::const_iterator it = entries.find(id);
+        return it == entries.end() ? 0 : it->second.bytes;
+    }
+
+    void untrack(std::map<GLuint, Entry> &entries, GLuint id)
+    {
+        std::map<GLuint, Entry>::iterator it = entries.find(id);
+        if (it == entries.end())
+            return;
+        sums.bytes[it->second.category] -= it->second.bytes;
+        sums.objects[it->second.category]--;
+        entries.erase(it);
+    }
+
+    void findExtensions()
+    {
+        extensions = 0;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char *name = (const char *)glGetStringi(GL_EXTENSIONS, i);
+            if (!name)
+                continue;
+            if (std::strcmp(name, "GL_NVX_gpu_memory_info") == 0)
+                extensions |= NVX;
+            else if (std::strcmp(name, "GL_ATI_meminfo") == 0)
+                extensions |= ATI;
+        }
+    }
+
+    // bytes per 4x4 block of the compressed formats the cooker writes, 0 for uncompressed formats
+    static size_t blockBytes(GLenum internalFormat)
+    {
+        switch (internalFormat)
+        {
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_SIGNED_RED_RGTC1:
+            return 8;
+        case GL_COMPRESSED_RG_RGTC2:
+        case GL_COMPRESSED_SIGNED_RG_RGTC2:
+        case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    // bytes per texel as stored; 3-channel formats are padded to 4 channels by current drivers
+    static size_t texelBytes(GLenum internalFormat)
+    {
+        switch (internalFormat)
+        {
+        case GL_RED: case GL_R8: return 1;
+        case GL_RG: case GL_RG8: case GL_R16F: return 2;
+        case GL_RG16F: case GL_R32F: return 4;
+        case GL_RGB16F: case GL_RGBA16F: case GL_RG32F: return 8;
+        case GL_RGB32F: case GL_RGBA32F: return 16;
+        default: return 4; // GL_RGB(8), GL_RGBA(8), GL_SRGB(8), GL_SRGB_ALPHA / GL_SRGB8_ALPHA8, ...
+        }
+    }
+};
+
+// GL thread only, like the objects it tracks
+inline GpuMemory &gpuMemory()
+{
+    static GpuMemory memory;
+    return memory;
+}
+
+#endif
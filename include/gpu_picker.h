@@ -0,0 +1,150 @@
+#ifndef GPU_PICKER_H
+#define GPU_PICKER_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+// GPU_PICKING=1: click picking from the pixels the opaque pass drew instead of a CPU ray test. The opaque
+// pass also writes a 32-bit pick ID per pixel into ToneMapper's R32UI attachment (enablePickIds(),
+// model_loading.fs PickId): the placed model's index + 1 above OBJECT_SHIFT, the mesh index below. The
+// mesh index is a per-vertex attribute (ATTRIBUTE_MESH, 2 bytes per vertex, only created for models drawn
+// while picking is on, Model::preparePicking); the placed index is a constant generic attribute
+// (ATTRIBUTE_OBJECT) set once per draw with setObject(), so no shader variant or uniform changes per model.
+// A click reads the one pixel under it into a pixel pack buffer and fences it; poll() maps it once the
+// fence has passed (a frame or two later), so a pick never waits for the GPU. Without a click nothing
+// is read back; the attachment costs a 4-byte write per opaque pixel.
+class GpuPicker
+{
+public:
+    // pick ID layout: placed model index + 1 in the high bits (0 = nothing drawn), mesh index in the low
+    static const unsigned int OBJECT_SHIFT = 16;
+    static const unsigned int MESH_MASK = (1u << OBJECT_SHIFT) - 1;
+    static const unsigned int MAX_OBJECTS = (1u << (32 - OBJECT_SHIFT)) - 1;
+    // vertex attributes of model_loading.vs (after the instance normal matrix, 8-10)
+    static const GLuint ATTRIBUTE_MESH = 11;
+    static const GLuint ATTRIBUTE_OBJECT = 12;
+
+    struct Pick
+    {
+        int placed = -1; // index into the placed models, -1 = background
+        int mesh = -1;   // mesh of that model
+    };
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("GPU_PICKING");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    GpuPicker() = default;
+    GpuPicker(const GpuPicker &) = delete;
+    GpuPicker &operator=(const GpuPicker &) = delete;
+
+    // GL thread: the one-pixel pack buffer
+    void init()
+    {
+        glGenBuffers(1, &pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), NULL, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        gpuMemory().trackBuffer(pbo, GpuMemory::DRAW_BUFFERS, sizeof(GLuint), "picking");
+        clearObject();
+        LOG_INFO("[Pick] GPU picking: mesh IDs from the opaque pass, read back at the clicked pixel");
+    }
+
+    bool ready() const { return pbo != 0; }
+    // a read is in flight
+    bool pending() const { return fence != 0; }
+
+    // GL thread, before the opaque draws of placed model `placed`: the pick ID's object part
+    void setObject(size_t placed) const
+    {
+        if (pbo)
+            glVertexAttribI4ui(ATTRIBUTE_OBJECT, placed < MAX_OBJECTS ? (GLuint)placed + 1 : 0u, 0u, 0u, 0u);
+    }
+
+    // GL thread: later draws (not placed models, e.g. the parking lot) can't be picked
+    void clearObject() const
+    {
+        if (pbo)
+            glVertexAttribI4ui(ATTRIBUTE_OBJECT, 0u, 0u, 0u, 0u);
+    }
+
+    // per-vertex mesh index (uint16, ATTRIBUTE_MESH) from its own buffer; call with the target VAO and that
+    // buffer bound
+    static void setupMeshIdFormat()
+    {
+        glEnableVertexAttribArray(ATTRIBUTE_MESH);
+        glVertexAttribIPointer(ATTRIBUTE_MESH, 1, GL_UNSIGNED_SHORT, sizeof(uint16_t), (void *)0);
+    }
+
+    // GL thread, with the scene framebuffer bound after the opaque pass: starts reading the pick ID at
+    // (`x`, `y`) of its target (GL pixel coordinates, bottom-up); false while an earlier read is in flight
+    bool read(int x, int y)
+    {
+        if (!pbo || fence)
+            return false;
+        glReadBuffer(GL_COLOR_ATTACHMENT2);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        return true;
+    }
+
+    // GL thread, once per frame: true with the result once the GPU has finished the read
+    bool poll(Pick &pick)
+    {
+        if (!fence)
+            return false;
+        const GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+            return false;
+        glDeleteSync(fence);
+        fence = 0;
+        if (status == GL_WAIT_FAILED)
+            return false;
+        GLuint id = 0;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        if (const void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT))
+        {
+            std::memcpy(&id, mapped, sizeof(GLuint));
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        pick = Pick();
+        if (id >> OBJECT_SHIFT)
+        {
+            pick.placed = (int)(id >> OBJECT_SHIFT) - 1;
+            pick.mesh = (int)(id & MESH_MASK);
+        }
+        return true;
+    }
+
+    void releaseGpu()
+    {
+        if (fence) glDeleteSync(fence);
+        if (pbo)
+        {
+            gpuMemory().releaseBuffer(pbo);
+            glDeleteBuffers(1, &pbo);
+        }
+        fence = 0;
+        pbo = 0;
+    }
+
+private:
+    GLuint pbo = 0;
+    GLsync fence = 0;
+};
+
+#endif
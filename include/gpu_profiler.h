@@ -0,0 +1,455 @@
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+#include <glad/glad.h>
+
+#include <frame_trace.h>
+#include <json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Per-pass CPU and GPU timings (PROFILE=1). Scopes are bracketed by GL_TIMESTAMP queries (glQueryCounter)
+// rather than GL_TIME_ELAPSED, since timestamps nest and don't collide with the elapsed-time queries the
+// probe and IBL budgets keep open. Queries are ring-buffered per frame and read LATENCY frames later, so
+// the CPU never waits for the GPU: a result still not available by then is dropped, not waited for.
+// Each pass keeps its last HISTORY samples, summarized as min / avg / p99. While a FrameTrace is recording,
+// every scope also lands on its timeline, on the CPU and (as executed) on the GPU.
+//
+//     GpuProfiler::Scope scope(gpuProfiler(), "opaque");
+//
+// or begin("opaque") ... end() around longer stretches. Scopes may nest; CPU-only scopes (no GL work) pass
+// gpu = false.
+//
+// PIPELINE_STATS=1 (GL 4.6) also counts what each pass sends down the pipeline: vertex and fragment shader
+// invocations and the primitives going into and coming out of clipping, averaged per frame. Only one query
+// per counter can be running, so the counters go on the passes one level below the outermost scope
+// ("frame" in the viewer), which never overlap.
+class GpuProfiler
+{
+public:
+    static const int LATENCY = 4;        // frames between issuing a frame's queries and reading them
+    static const size_t HISTORY = 240;   // samples kept per pass
+
+    // the pipeline statistics counted per pass (PIPELINE_STATS=1)
+    enum Statistic
+    {
+        VERTEX_INVOCATIONS,
+        FRAGMENT_INVOCATIONS,
+        CLIPPING_INPUT,
+        CLIPPING_OUTPUT,
+        STATISTIC_COUNT
+    };
+
+    struct Stats
+    {
+        double min = 0.0, avg = 0.0, p99 = 0.0;
+        size_t samples = 0;
+    };
+
+    // brackets one pass; a no-op while the profiler is disabled
+    class Scope
+    {
+    public:
+        Scope(GpuProfiler &profiler, const char *name, bool gpu = true)
+            : profiler(profiler)
+        {
+            profiler.begin(name, gpu);
+        }
+        ~Scope() { profiler.end(); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        GpuProfiler &profiler;
+    };
+
+    // PROFILE=1 turns it on
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("PROFILE");
+        return env && std::string(env) == "1";
+    }
+
+    void setEnabled(bool on) { active = on; }
+    bool enabled() const { return active; }
+
+    // GL thread, after the functions are loaded: PIPELINE_STATS=1 turns the counters on where the driver has
+    // them (core in GL 4.6); false if it doesn't
+    bool enablePipelineStatistics()
+    {
+        const char *env = std::getenv("PIPELINE_STATS");
+        if (!(env && std::string(env) == "1"))
+            return false;
+        statistics = GLAD_GL_VERSION_4_6 != 0;
+        return statistics;
+    }
+
+    // GL thread, at the start of every frame: collects the frame issued LATENCY frames ago and reuses its
+    // queries for the new one
+    void beginFrame()
+    {
+        if (!active)
+            return;
+        current = (current + 1) % LATENCY;
+        // GPU timestamps -> trace clock, re-measured every couple of seconds against drift
+        if (frameTrace().enabled() && frameCount % 120 == 0)
+        {
+            GLint64 gpuNs = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpuNs);
+            gpuToTraceUs = FrameTrace::clockUs() - gpuNs * 1e-3;
+        }
+        collect(frames[current]);
+        frameCount++;
+    }
+
+    // opens a scope called `name` (a literal; nested in the open one, if any)
+    void begin(const char *name, bool gpu = true)
+    {
+        if (!active)
+            return;
+        Frame &frame = frames[current];
+        Record r;
+        r.name = name;
+        r.pass = passIndex(name);
+        r.cpuBegin = nowMs();
+        if (gpu)
+        {
+            r.queryBegin = frame.query();
+            r.queryEnd = frame.query();
+            glQueryCounter(r.queryBegin, GL_TIMESTAMP);
+            if (statistics && open.size() == 1 && !counting)
+            {
+                r.statistics = frame.statisticsQueries();
+                for (int s = 0; s < STATISTIC_COUNT; ++s)
+                    glBeginQuery(statisticTarget(s), frame.statisticQueries[s][r.statistics - 1]);
+                counting = true;
+            }
+        }
+        open.push_back(frame.records.size());
+        frame.records.push_back(r);
+    }
+
+    // closes the innermost open scope
+    void end()
+    {
+        if (!active || open.empty())
+            return;
+        Record &r = frames[current].records[open.back()];
+        open.pop_back();
+        r.cpuEnd = nowMs();
+        if (r.queryEnd)
+            glQueryCounter(r.queryEnd, GL_TIMESTAMP);
+        if (r.statistics)
+        {
+            for (int s = 0; s < STATISTIC_COUNT; ++s)
+                glEndQuery(statisticTarget(s));
+            counting = false;
+        }
+    }
+
+    Stats gpuStats(const std::string &name) const { return stats(name, true); }
+    // GPU ms of the newest `name` sample collected by the last beginFrame(), -1 when that frame brought none
+    double latestGpuMs(const std::string &name) const
+    {
+        for (size_t p = 0; p < passes.size(); ++p)
+            if (passes[p].name == name)
+                return passes[p].gpuFresh ? passes[p].gpuMs[(passes[p].nextGpu + HISTORY - 1) % HISTORY] : -1.0;
+        return -1.0;
+    }
+    Stats cpuStats(const std::string &name) const { return stats(name, false); }
+    // average count of `statistic` per frame in pass `name` over its samples, 0 when there are none
+    double averageStatistic(const std::string &name, Statistic statistic) const
+    {
+        for (size_t p = 0; p < passes.size(); ++p)
+            if (passes[p].name == name)
+                return summarize(passes[p].statistics[statistic]).avg;
+        return 0.0;
+    }
+
+    // a value measured outside any scope (e.g. FramePacer's input latency), kept and reported as the CPU
+    // column of pass `name` (a literal)
+    void addMeasurement(const char *name, double ms)
+    {
+        if (!active)
+            return;
+        Pass &pass = passes[passIndex(name)];
+        addSample(pass.cpuMs, pass.nextCpu, ms);
+    }
+
+    // one line per pass, in first-use order
+    void report(std::ostream &out) const
+    {
+        out << "[Profile] " << frameCount << " frames, ms over the last " << HISTORY << " samples (min / avg / p99)" << std::endl;
+        for (size_t p = 0; p < passes.size(); ++p)
+        {
+            const Stats gpu = summarize(passes[p].gpuMs), cpu = summarize(passes[p].cpuMs);
+            out << "[Profile]   " << std::left << std::setw(14) << passes[p].name << std::right << std::fixed << std::setprecision(3)
+                << " cpu " << cpu.min << " / " << cpu.avg << " / " << cpu.p99;
+            if (gpu.samples)
+                out << "   gpu " << gpu.min << " / " << gpu.avg << " / " << gpu.p99;
+            out << std::defaultfloat;
+            if (!passes[p].statistics[VERTEX_INVOCATIONS].empty())
+            {
+                out << std::setprecision(0) << std::fixed;
+                for (int s = 0; s < STATISTIC_COUNT; ++s)
+                    out << "   " << statisticName(s) << " " << summarize(passes[p].statistics[s]).avg;
+                out << std::defaultfloat << std::setprecision(6);
+            }
+            out << std::endl;
+        }
+    }
+
+    // the same summary as JSON: {"frames": n, "passes": [{"name", "cpu": {...}, "gpu": {...}}]}
+    bool writeJson(const std::string &path) const
+    {
+        nlohmann::json root;
+        root["frames"] = frameCount;
+        root["passes"] = nlohmann::json::array();
+        for (size_t p = 0; p < passes.size(); ++p)
+        {
+            nlohmann::json pass;
+            pass["name"] = passes[p].name;
+            pass["cpu"] = toJson(summarize(passes[p].cpuMs));
+            pass["gpu"] = toJson(summarize(passes[p].gpuMs));
+            if (!passes[p].statistics[VERTEX_INVOCATIONS].empty())
+                for (int s = 0; s < STATISTIC_COUNT; ++s)
+                    pass["statistics"][statisticName(s)] = summarize(passes[p].statistics[s]).avg;
+            root["passes"].push_back(pass);
+        }
+        std::ofstream file(path.c_str());
+        if (!file)
+            return false;
+        file << root.dump(2) << std::endl;
+        return (bool)file;
+    }
+
+    // GL thread: deletes the queries (pending results are lost)
+    void releaseGpu()
+    {
+        for (int f = 0; f < LATENCY; ++f)
+        {
+            if (!frames[f].queries.empty())
+                glDeleteQueries((GLsizei)frames[f].queries.size(), &frames[f].queries[0]);
+            frames[f].queries.clear();
+            for (int s = 0; s < STATISTIC_COUNT; ++s)
+            {
+                if (!frames[f].statisticQueries[s].empty())
+                    glDeleteQueries((GLsizei)frames[f].statisticQueries[s].size(), &frames[f].statisticQueries[s][0]);
+                frames[f].statisticQueries[s].clear();
+            }
+            frames[f].usedStatistics = 0;
+            frames[f].records.clear();
+            frames[f].usedQueries = 0;
+        }
+        open.clear();
+        counting = false;
+    }
+
+private:
+    struct Pass
+    {
+        std::string name;
+        // sample rings, HISTORY entries at most; `next` is the slot the next sample overwrites
+        std::vector<double> cpuMs, gpuMs;
+        size_t nextCpu = 0, nextGpu = 0;
+        // per-frame counts (PIPELINE_STATS=1), in rings like the times
+        std::vector<double> statistics[STATISTIC_COUNT];
+        size_t nextStatistic = 0;
+        bool gpuFresh = false; // a GPU sample arrived in the last collect()
+    };
+
+    struct Record
+    {
+        const char *name = nullptr;
+        int pass = 0;
+        double cpuBegin = 0.0, cpuEnd = 0.0; // ms on the trace clock
+        GLuint queryBegin = 0, queryEnd = 0; // 0 = CPU-only scope
+        size_t statistics = 0; // 1 + index into the frame's statisticQueries, 0 = not counted
+    };
+
+    // the scopes of one frame and the query objects it owns (recycled when the frame comes round again)
+    struct Frame
+    {
+        std::vector<Record> records;
+        std::vector<GLuint> queries;
+        size_t usedQueries = 0;
+        // one query per counter and counted scope, apart from `queries`: a query object keeps the target
+        // it was first used with
+        std::vector<GLuint> statisticQueries[STATISTIC_COUNT];
+        size_t usedStatistics = 0;
+
+        GLuint query()
+        {
+            if (usedQueries == queries.size())
+            {
+                GLuint q = 0;
+                glGenQueries(1, &q);
+                queries.push_back(q);
+            }
+            return queries[usedQueries++];
+        }
+
+        // a set of counter queries; returns 1 + its index
+        size_t statisticsQueries()
+        {
+            if (usedStatistics == statisticQueries[0].size())
+                for (int s = 0; s < STATISTIC_COUNT; ++s)
+                {
+                    GLuint q = 0;
+                    glGenQueries(1, &q);
+                    statisticQueries[s].push_back(q);
+                }
+            return ++usedStatistics;
+        }
+    };
+
+    bool active = false;
+    int current = 0;
+    size_t frameCount = 0;
+    Frame frames[LATENCY];
+    std::vector<size_t> open;
+    std::vector<Pass> passes;
+    double gpuToTraceUs = 0.0;
+    bool statistics = false; // PIPELINE_STATS=1 on a GL 4.6 driver
+    bool counting = false;   // an open scope holds the counter queries
+
+    static GLenum statisticTarget(int statistic)
+    {
+        static const GLenum targets[STATISTIC_COUNT] = {GL_VERTEX_SHADER_INVOCATIONS, GL_FRAGMENT_SHADER_INVOCATIONS,
+                                                        GL_CLIPPING_INPUT_PRIMITIVES, GL_CLIPPING_OUTPUT_PRIMITIVES};
+        return targets[statistic];
+    }
+
+    static const char *statisticName(int statistic)
+    {
+        static const char *names[STATISTIC_COUNT] = {"vs", "fs", "clip in", "clip out"};
+        return names[statistic];
+    }
+
+    static double nowMs() { return FrameTrace::clockUs() * 1e-3; }
+
+    int passIndex(const char *name)
+    {
+        for (size_t p = 0; p < passes.size(); ++p)
+            if (passes[p].name == name)
+                return (int)p;
+        Pass pass;
+        pass.name = name;
+        passes.push_back(pass);
+        return (int)passes.size() - 1;
+    }
+
+    static void addSample(std::vector<double> &ring, size_t &next, double ms)
+    {
+        if (ring.size() < HISTORY)
+            ring.push_back(ms);
+        else
+            ring[next] = ms;
+        next = (next + 1) % HISTORY;
+    }
+
+    // reads the frame's finished scopes without waiting; the frame is then empty again
+    void collect(Frame &frame)
+    {
+        for (size_t p = 0; p < passes.size(); ++p)
+            passes[p].gpuFresh = false;
+        for (size_t i = 0; i < frame.records.size(); ++i)
+        {
+            const Record &r = frame.records[i];
+            // still open (a scope spanning beginFrame): its end query was never issued
+            if (r.cpuEnd < r.cpuBegin)
+                continue;
+            Pass &pass = passes[r.pass];
+            addSample(pass.cpuMs, pass.nextCpu, r.cpuEnd - r.cpuBegin);
+            FrameTrace &trace = frameTrace();
+            if (trace.enabled())
+                trace.complete(r.name, r.cpuBegin * 1e3, (r.cpuEnd - r.cpuBegin) * 1e3, FrameTrace::CPU_PROCESS, FrameTrace::threadTrack());
+            if (!r.queryEnd)
+                continue;
+            GLint available = 0;
+            glGetQueryObjectiv(r.queryEnd, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                continue;
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(r.queryBegin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(r.queryEnd, GL_QUERY_RESULT, &end);
+            addSample(pass.gpuMs, pass.nextGpu, end > begin ? (end - begin) * 1e-6 : 0.0);
+            pass.gpuFresh = true;
+            if (r.statistics)
+                collectStatistics(frame, r.statistics - 1, pass);
+            if (trace.enabled())
+                trace.complete(r.name, begin * 1e-3 + gpuToTraceUs, end > begin ? (end - begin) * 1e-3 : 0.0, FrameTrace::GPU_PROCESS, 1);
+        }
+        frame.records.clear();
+        frame.usedQueries = 0;
+        frame.usedStatistics = 0;
+    }
+
+    // the counters of one scope, all or none, without waiting
+    void collectStatistics(const Frame &frame, size_t index, Pass &pass)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(frame.statisticQueries[STATISTIC_COUNT - 1][index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+        size_t next = pass.nextStatistic;
+        for (int s = 0; s < STATISTIC_COUNT; ++s)
+        {
+            GLuint64 count = 0;
+            glGetQueryObjectui64v(frame.statisticQueries[s][index], GL_QUERY_RESULT, &count);
+            next = pass.nextStatistic;
+            addSample(pass.statistics[s], next, (double)count);
+        }
+        pass.nextStatistic = next;
+    }
+
+    static Stats summarize(const std::vector<double> &ring)
+    {
+        Stats s;
+        s.samples = ring.size();
+        if (ring.empty())
+            return s;
+        std::vector<double> sorted(ring);
+        std::sort(sorted.begin(), sorted.end());
+        s.min = sorted.front();
+        double sum = 0.0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+            sum += sorted[i];
+        s.avg = sum / sorted.size();
+        s.p99 = sorted[std::min(sorted.size() - 1, (size_t)(0.99 * sorted.size()))];
+        return s;
+    }
+
+    Stats stats(const std::string &name, bool gpu) const
+    {
+        for (size_t p = 0; p < passes.size(); ++p)
+            if (passes[p].name == name)
+                return summarize(gpu ? passes[p].gpuMs : passes[p].cpuMs);
+        return Stats();
+    }
+
+    static nlohmann::json toJson(const Stats &s)
+    {
+        nlohmann::json j;
+        j["min"] = s.min;
+        j["avg"] = s.avg;
+        j["p99"] = s.p99;
+        j["samples"] = s.samples;
+        return j;
+    }
+};
+
+// the renderer runs on a single GL context, so one process-wide profiler is enough
+inline GpuProfiler &gpuProfiler()
+{
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef GPU_SCENE_BVH_H
+#define GPU_SCENE_BVH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <gpu_memory.h>
+#include <material_overrides.h>
+#include <material_table.h>
+#include <model.h>
+#include <triangle_bvh.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// The placed models' triangle trees (TriangleBVH, built at load) as shader storage buffers, for the compute
+// passes that trace them (RayTracedReflections, PathTracer). No ray tracing hardware is involved:
+//   - every shown mesh's tree goes to the GPU as stored (TriangleBVH::appendTo: 32-byte nodes, blocks of four
+//     triangles as SoA lanes and the lanes' vertex normals), uploaded again only when the set of trees changes
+//   - each frame the placed meshes become instances (mesh-from-world matrix, the mesh's material table entry
+//     with the MaterialOverrides applied, root node) under a BVH of their world boxes, so moving a car only
+//     rebuilds that small top level
+// shaders/bvh_trace.glsl declares the buffers at the bindings below and traverses them.
+class GpuSceneBvh
+{
+public:
+    static const GLuint BINDING_MESH_NODES = 0;
+    static const GLuint BINDING_BLOCKS = 1;
+    static const GLuint BINDING_NORMALS = 2;
+    static const GLuint BINDING_SCENE_NODES = 3;
+    static const GLuint BINDING_INSTANCES = 4;
+
+    // Instance::flags
+    enum { SHADING_NORMALS = 1 };
+
+    // `owner` names the buffers in GpuMemory and the log
+    explicit GpuSceneBvh(const std::string &owner)
+        : owner(owner)
+    {
+    }
+
+    GpuSceneBvh(const GpuSceneBvh &) = delete;
+    GpuSceneBvh &operator=(const GpuSceneBvh &) = delete;
+
+    // GL thread, with compute shaders available
+    void init()
+    {
+        glGenBuffers(BUFFER_COUNT, buffers);
+    }
+
+    bool ready() const { return buffers[0] != 0; }
+
+    // once per frame: the instances are collected anew from the models added after this
+    void beginScene()
+    {
+        instances.clear();
+        instanceBounds.clear();
+        frameTrees.clear();
+    }
+
+    // the shown meshes of `model` (with triangle trees) at `worldMatrix`; blended ones only with `transparent`
+    void addModel(const Model &model, const glm::mat4 &worldMatrix, bool transparent)
+    {
+        if (!ready())
+            return;
+        model.visitTriangleBvhs([&](size_t meshIndex, const TriangleBVH &tree, const glm::mat4 &modelFromMesh) {
+            if (model.meshes[meshIndex].transparent && !transparent)
+                return;
+            const glm::mat4 worldFromMesh = worldMatrix * modelFromMesh;
+            Instance instance;
+            instance.meshFromWorld = glm::inverse(worldFromMesh);
+            instance.material = withOverride(model.meshMaterial(meshIndex));
+            instance.root = 0;
+            instance.flags = tree.hasShadingNormals() ? (unsigned int)SHADING_NORMALS : 0u;
+            instance.reserved[0] = instance.reserved[1] = 0;
+            // the tree's box through the matrix: its centre moved, its half size through the absolute matrix
+            const glm::vec3 center = glm::vec3(worldFromMesh * glm::vec4((tree.boundsMin() + tree.boundsMax()) * 0.5f, 1.0f));
+            const glm::vec3 half = (tree.boundsMax() - tree.boundsMin()) * 0.5f;
+            glm::vec3 extent(0.0f);
+            for (int c = 0; c < 3; ++c)
+                extent += glm::abs(glm::vec3(worldFromMesh[c])) * half[c];
+            instanceBounds.add(center - extent, center + extent, glm::length(extent));
+            instances.push_back(instance);
+            frameTrees.push_back(TreeKey(&tree, tree.triangleCount()));
+        });
+    }
+
+    bool empty() const { return instances.empty(); }
+    size_t instanceCount() const { return instances.size(); }
+    // world bounds of this frame's instances (undefined when empty, valid after upload())
+    glm::vec3 boundsMin() const { return instanceTree.boundsMin(); }
+    glm::vec3 boundsMax() const { return instanceTree.boundsMax(); }
+
+    // GL thread: this frame's instances and, if they changed, the trees
+    void upload()
+    {
+        if (!ready() || instances.empty())
+            return;
+        uploadGeometry();
+        uploadScene();
+    }
+
+    // binds the buffers at their BINDING_*s
+    void bind() const
+    {
+        for (GLuint b = 0; b < BUFFER_COUNT; ++b)
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, b, buffers[b]);
+    }
+
+    void releaseGpu()
+    {
+        for (GLuint &b : buffers)
+            if (b)
+            {
+                gpuMemory().releaseBuffer(b);
+                glDeleteBuffers(1, &b);
+                b = 0;
+            }
+        uploadedTrees.clear();
+        roots.clear();
+    }
+
+private:
+    // std430 Instance of bvh_trace.glsl
+    struct Instance
+    {
+        glm::mat4 meshFromWorld;
+        MaterialData material;
+        uint32_t root; // the mesh tree's root in the shared node buffer
+        uint32_t flags;
+        uint32_t reserved[2];
+    };
+    static_assert(sizeof(Instance) == 224, "Instance must match the std430 Instance in bvh_trace.glsl");
+
+    // a tree and its triangle count: a model reloaded in place (its proxy replaced) keeps the addresses
+    typedef std::pair<const TriangleBVH *, size_t> TreeKey;
+
+    enum { MESH_NODES, BLOCKS, NORMALS, SCENE_NODES, INSTANCES, BUFFER_COUNT };
+
+    std::string owner;
+    // this frame's instances (tree order after uploadScene()), their world boxes and trees
+    std::vector<Instance> instances;
+    BoundsBatch instanceBounds;
+    std::vector<TreeKey> frameTrees;
+    BVH instanceTree;
+    // the trees in the node and block buffers (sorted) and their roots there
+    std::vector<TreeKey> uploadedTrees;
+    std::unordered_map<const TriangleBVH *, uint32_t> roots;
+    GLuint buffers[BUFFER_COUNT] = {0, 0, 0, 0, 0};
+
+    // the runtime edits of the material's tag, as model_loading.fs applies them
+    static MaterialData withOverride(MaterialData m)
+    {
+        const unsigned int tag = (unsigned int)(m.layers.w >> MaterialOverrides::TAG_SHIFT) & 7u;
+        if (tag == MaterialOverrides::NONE)
+            return m;
+        const MaterialOverride &o = materialOverrides().get(tag);
+        if (o.mask.x & MaterialOverride::BASE_COLOR)
+            m.baseColorFactor = glm::vec4(glm::vec3(o.baseColor), m.baseColorFactor.a);
+        if (o.mask.x & MaterialOverride::METALLIC)
+            m.factors.x = o.factors.x;
+        if (o.mask.x & MaterialOverride::ROUGHNESS)
+            m.factors.y = o.factors.y;
+        if (o.mask.x & MaterialOverride::CLEARCOAT)
+        {
+            m.uvOffsetsMR.z = o.factors.z;
+            m.uvOffsetsMR.w = o.factors.w;
+        }
+        return m;
+    }
+
+    // the node, block and normal buffers anew when this frame's trees aren't the ones uploaded (a model
+    // loaded, unloaded or swapped for another variant)
+    void uploadGeometry()
+    {
+        std::vector<TreeKey> trees = frameTrees;
+        std::sort(trees.begin(), trees.end());
+        trees.erase(std::unique(trees.begin(), trees.end()), trees.end());
+        if (trees == uploadedTrees)
+            return;
+        uploadedTrees = trees;
+        roots.clear();
+        std::vector<uint32_t> nodeWords, blockWords, normalWords;
+        for (size_t i = 0; i < trees.size(); ++i)
+            roots[trees[i].first] = trees[i].first->appendTo(nodeWords, blockWords, normalWords);
+        upload(MESH_NODES, nodeWords, GL_STATIC_DRAW, " mesh nodes");
+        upload(BLOCKS, blockWords, GL_STATIC_DRAW, " triangles");
+        upload(NORMALS, normalWords, GL_STATIC_DRAW, " normals");
+        LOG_INFO("[GpuSceneBvh] " << owner << ": " << trees.size() << " triangle trees on the GPU, "
+                                  << (nodeWords.size() + blockWords.size() + normalWords.size()) * 4 / (1024 * 1024) << " MiB");
+    }
+
+    // the instance tree over this frame's boxes, as TriangleBVH-style nodes (leaves index the instances,
+    // which are stored in tree order), and the instances
+    void uploadScene()
+    {
+        instanceTree.build(instanceBounds);
+        std::vector<uint32_t> nodeWords;
+        nodeWords.reserve(TriangleBVH::NODE_WORDS * 2 * (instances.size() / BVH::LEAF_SIZE + 1));
+        instanceTree.visitNodes([&](const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, unsigned int right, unsigned int first, unsigned int count) {
+            // interior nodes carry the axis their box is longest on, which orders the children
+            const glm::vec3 size = boundsMax - boundsMin;
+            const uint32_t axis = size.x >= size.y && size.x >= size.z ? 0u : (size.y >= size.z ? 1u : 2u);
+            const uint32_t words[TriangleBVH::NODE_WORDS] = {
+                floatBits(boundsMin.x), floatBits(boundsMin.y), floatBits(boundsMin.z), right ? right : first,
+                floatBits(boundsMax.x), floatBits(boundsMax.y), floatBits(boundsMax.z), right ? axis : (count << 2) | 3u};
+            nodeWords.insert(nodeWords.end(), words, words + TriangleBVH::NODE_WORDS);
+        });
+        const std::vector<unsigned int> &order = instanceTree.itemOrder();
+        std::vector<Instance> sorted(order.size());
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            sorted[k] = instances[order[k]];
+            sorted[k].root = roots[frameTrees[order[k]].first];
+        }
+        upload(SCENE_NODES, nodeWords, GL_STREAM_DRAW, " instance nodes");
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[INSTANCES]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)(sorted.size() * sizeof(Instance)), &sorted[0], GL_STREAM_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        gpuMemory().trackBuffer(buffers[INSTANCES], GpuMemory::MODEL_GEOMETRY, sorted.size() * sizeof(Instance), owner + " instances");
+    }
+
+    static uint32_t floatBits(float f)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    void upload(int buffer, const std::vector<uint32_t> &words, GLenum usage, const char *what)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffers[buffer]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)(words.size() * 4), words.empty() ? NULL : &words[0], usage);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        gpuMemory().trackBuffer(buffers[buffer], GpuMemory::MODEL_GEOMETRY, words.size() * 4, owner + what);
+    }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include <async_log.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+
+// Edits picked up while the app runs (SHADER_HOT_RELOAD=1). Every HOT_RELOAD_MS (default 250) the GL
+// thread checks the modification times of every live program's shader files and of the SCENE file.
+// A changed shader relinks (it and every material variant built from it) next to the program in use and
+// replaces it between frames once linked, so the frame keeps drawing the old one meanwhile and keeps it
+// for good if the new one doesn't compile. A changed scene file hands back its lights, camera presets and
+// environment; models and their placements still need a restart.
+class HotReload
+{
+public:
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("SHADER_HOT_RELOAD");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    explicit HotReload(const std::string &sceneFile = std::string()) : sceneFile(sceneFile)
+    {
+        if (const char *ms = std::getenv("HOT_RELOAD_MS"))
+            interval = std::max(1, std::atoi(ms)) * 1e-3;
+        sceneStamp = modified(sceneFile);
+        LOG_INFO("[HotReload] Watching shaders" << (sceneFile.empty() ? "" : " and " + sceneFile) << " every "
+                 << (int)(interval * 1000.0) << " ms");
+    }
+
+    // GL thread, every frame at `now` seconds: swaps in the programs that finished linking and, once per
+    // interval, looks for changed files. True when something on screen may have changed (a program was
+    // swapped or the scene file changed: see sceneChanged()).
+    bool pump(double now)
+    {
+        bool changed = Shader::finishReloads() > 0;
+        if (now - lastPoll < interval)
+            return changed;
+        lastPoll = now;
+        Shader::reloadChanged();
+        const long long stamp = modified(sceneFile);
+        if (stamp != sceneStamp)
+        {
+            sceneStamp = stamp;
+            sceneDirty = true;
+            changed = true;
+        }
+        return changed;
+    }
+
+    // the scene file changed since the last call
+    bool sceneChanged()
+    {
+        const bool dirty = sceneDirty;
+        sceneDirty = false;
+        return dirty;
+    }
+
+private:
+    std::string sceneFile;
+    double interval = 0.25;
+    double lastPoll = -1e9;
+    long long sceneStamp = 0;
+    bool sceneDirty = false;
+
+    // modification time of `path`, 0 if there's none
+    static long long modified(const std::string &path)
+    {
+        struct stat info;
+        return !path.empty() && stat(path.c_str(), &info) == 0 ? (long long)info.st_mtime : 0;
+    }
+};
+
+#endif
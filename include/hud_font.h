@@ -0,0 +1,81 @@
+#ifndef HUD_FONT_H
+#define HUD_FONT_H
+
+// 5x7 bitmap font for the performance HUD: printable ASCII 32 (' ') to 95 ('_'), upper case only (PerfHud
+// maps lower case onto it). One byte per row, top row first; bit 4 is the leftmost column.
+namespace HudFont
+{
+    const int GLYPH_WIDTH = 5;
+    const int GLYPH_HEIGHT = 7;
+    const int FIRST = 32;
+    const int COUNT = 64;
+
+    const unsigned char ROWS[COUNT][GLYPH_HEIGHT] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+        {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, // '!'
+        {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+        {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, // '#'
+        {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // '$'
+        {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+        {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // '&'
+        {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, // '\''
+        {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+        {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+        {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, // '*'
+        {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
+        {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, // ','
+        {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // '.'
+        {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+        {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+        {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+        {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+        {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+        {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+        {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+        {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+        {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // ':'
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, // ';'
+        {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+        {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
+        {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+        {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // '@'
+        {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'A'
+        {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+        {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+        {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+        {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+        {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+        {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+        {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+        {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+        {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+        {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+        {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+        {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+        {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+        {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+        {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+        {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+        {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // 'W'
+        {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+        {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // 'Y'
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+        {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, // '['
+        {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // '\\'
+        {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ']'
+        {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, // '^'
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // '_'
+    };
+}
+
+#endif
@@ -0,0 +1,418 @@
+#ifndef IBL_BAKER_H
+#define IBL_BAKER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <atmosphere.h>
+#include <compute_shader.h>
+#include <draw_stats.h>
+#include <gl_backend.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <ibl_cache.h>
+#include <mip_chain.h>
+#include <procedural_sky.h>
+#include <shader.h>
+#include <spherical_harmonics.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// what the renderer samples for image based lighting
+struct IBLMaps
+{
+    GLuint envCubemap = 0;
+    GLuint prefilterMap = 0;      // 0 = no prefilter, sample envCubemap's mips
+    float prefilterMaxMip = 0.0f; // highest prefiltered mip (roughness 1), prefilterMaxMip in model_loading.fs
+    SHIrradiance irradianceSH;    // diffuse term, projected on the CPU by whoever produced the source
+};
+
+// bake sizes (cube faces are square)
+struct IBLBakeSettings
+{
+    unsigned int envSize = 512;
+    unsigned int prefilterSize = 128;
+    unsigned int prefilterMips = 5; // prefilter mips rendered with increasing roughness
+    bool compute = true;            // prefilter with prefilter.comp where GL 4.3 is available
+
+    // mips allocated for the prefilter cube (full chain, so glGenerateMipmap completes it)
+    unsigned int prefilterLevels() const
+    {
+        unsigned int levels = 1;
+        while ((prefilterSize >> levels) > 0)
+            ++levels;
+        return levels;
+    }
+};
+
+// GPU half of the IBL bake: equirectangular texture (or procedural sky) -> environment cube -> mip chain ->
+// GGX prefiltered cube. It owns the capture FBO, the cube VAO and the bake programs once and reuses them
+// for every bake until release(). The bake runs either in one go (bake) or step by step (begin / runStep /
+// finish) so EnvironmentLoader can spread it over frames; each step is the six env faces, the mip chain, or
+// one prefilter mip. Raster passes draw all six faces of a level at once: the cube is attached layered and
+// cubemap_layered.gs routes each triangle to every face through gl_Layer.
+class IBLBaker
+{
+public:
+    // `shaderDir` holds cubemap_layered.vs/.gs, equirectangular_to_cubemap.fs, procedural_sky.fs and
+    // prefilter.fs/.comp
+    explicit IBLBaker(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    IBLBaker(const IBLBaker &) = delete;
+    IBLBaker &operator=(const IBLBaker &) = delete;
+
+    // shader sources an EXR bake depends on (part of IBL cache keys; procedural skies aren't cached)
+    std::vector<std::string> shaderPaths() const
+    {
+        std::vector<std::string> paths;
+        paths.push_back(shaderDir + "/cubemap_layered.vs");
+        paths.push_back(shaderDir + "/cubemap_layered.gs");
+        paths.push_back(shaderDir + "/equirectangular_to_cubemap.fs");
+        paths.push_back(shaderDir + "/prefilter.fs");
+        paths.push_back(shaderDir + "/prefilter.comp");
+        return paths;
+    }
+
+    // the maps an IBL cache file stores (the BRDF LUT is embedded, see BRDFLUT)
+    static std::vector<IBLCache::Entry> cacheEntries(IBLMaps &m, const IBLBakeSettings &s)
+    {
+        std::vector<IBLCache::Entry> entries;
+        IBLCache::Entry env = {&m.envCubemap, GL_TEXTURE_CUBE_MAP, 3, s.envSize, 1, true, "environment"};
+        IBLCache::Entry prefilter = {&m.prefilterMap, GL_TEXTURE_CUBE_MAP, 3, s.prefilterSize, s.prefilterLevels(), false, "prefilter"};
+        entries.push_back(env);
+        entries.push_back(prefilter);
+        return entries;
+    }
+
+    // GL thread: bakes an RGB16F/RGB32F equirectangular `hdrTexture` (still owned by the caller) in one go.
+    // The returned maps belong to the caller; their irradianceSH is left for the caller to fill.
+    IBLMaps bake(GLuint hdrTexture, const IBLBakeSettings &s)
+    {
+        begin(hdrTexture, s);
+        return bakeAll("equirect");
+    }
+    IBLMaps bake(const ProceduralSky &sky, const IBLBakeSettings &s)
+    {
+        begin(sky, s);
+        IBLMaps m = bakeAll("procedural sky");
+        m.irradianceSH = sky.irradiance();
+        return m;
+    }
+
+    // step-wise bake: begin(), runStep(0 .. stepCount() - 1), finish(). The source must stay alive until
+    // the face steps have run.
+    void begin(GLuint hdrTexture, const IBLBakeSettings &s)
+    {
+        source = hdrTexture;
+        procedural = false;
+        start(s);
+    }
+    void begin(const ProceduralSky &sky, const IBLBakeSettings &s)
+    {
+        source = 0;
+        this->sky = sky;
+        this->sky.sunDirection = glm::normalize(sky.sunDirection);
+        procedural = true;
+        start(s);
+    }
+
+    bool baking() const { return active; }
+
+    unsigned int stepCount() const
+    {
+        return active ? 1 + 1 + settings.prefilterMips : 0;
+    }
+
+    void runStep(unsigned int s)
+    {
+        if (s == 0)
+            renderFaces();
+        else if (s == 1)
+        {
+            // envCubemap's mips feed the filtered importance sampling of the prefilter
+            glBackend().generateMipmap(maps.envCubemap, GL_TEXTURE_CUBE_MAP);
+        }
+        else
+            prefilter(s - 2);
+    }
+
+    // hands the finished maps to the caller
+    IBLMaps finish()
+    {
+        IBLMaps m = maps;
+        m.prefilterMaxMip = (float)(settings.prefilterMips - 1);
+        maps = IBLMaps();
+        active = false;
+        return m;
+    }
+
+    // drops a bake in progress and its textures
+    void abort()
+    {
+        releaseMaps(maps);
+        active = false;
+    }
+
+    // GL thread: deletes the capture FBO, the cube VAO and the programs; the next bake recreates them
+    void release()
+    {
+        abort();
+        if (cubeVAO)
+        {
+            glDeleteVertexArrays(1, &cubeVAO);
+            gpuMemory().releaseBuffer(cubeVBO);
+            glDeleteBuffers(1, &cubeVBO);
+        }
+        cubeVAO = cubeVBO = 0;
+        if (captureFBO)
+            glDeleteFramebuffers(1, &captureFBO);
+        captureFBO = 0;
+        equirectShader.reset();
+        skyShader.reset();
+        prefilterShader.reset();
+        prefilterCompute.reset();
+        glState().invalidate();
+    }
+
+    // 90 degree capture frustum and the view of GL cube face `face` from `eye` (also used by ReflectionProbes)
+    static glm::mat4 captureProjection(float nearPlane = 0.1f, float farPlane = 10.0f)
+    {
+        return glm::perspective(glm::radians(90.0f), 1.0f, nearPlane, farPlane);
+    }
+    static glm::mat4 captureView(unsigned int face, const glm::vec3 &eye = glm::vec3(0.0f))
+    {
+        static const glm::vec3 dirs[6] = {glm::vec3(1, 0, 0), glm::vec3(-1, 0, 0), glm::vec3(0, 1, 0),
+                                          glm::vec3(0, -1, 0), glm::vec3(0, 0, 1), glm::vec3(0, 0, -1)};
+        static const glm::vec3 ups[6] = {glm::vec3(0, -1, 0), glm::vec3(0, -1, 0), glm::vec3(0, 0, 1),
+                                         glm::vec3(0, 0, -1), glm::vec3(0, -1, 0), glm::vec3(0, -1, 0)};
+        return glm::lookAt(eye, eye + dirs[face], ups[face]);
+    }
+
+    static void releaseMaps(IBLMaps &m)
+    {
+        gpuMemory().releaseTexture(m.envCubemap);
+        gpuMemory().releaseTexture(m.prefilterMap);
+        if (m.envCubemap)
+            glDeleteTextures(1, &m.envCubemap);
+        if (m.prefilterMap)
+            glDeleteTextures(1, &m.prefilterMap);
+        m = IBLMaps();
+    }
+
+private:
+    std::string shaderDir;
+    IBLBakeSettings settings;
+    // bake in progress
+    bool active = false;
+    bool procedural = false;
+    bool computePrefilter = false;
+    GLuint source = 0;
+    ProceduralSky sky;
+    IBLMaps maps;
+    // shared by every bake until release()
+    std::unique_ptr<Shader> equirectShader, skyShader, prefilterShader;
+    std::unique_ptr<ComputeShader> prefilterCompute;
+    GLuint cubeVAO = 0, cubeVBO = 0, captureFBO = 0;
+
+    IBLMaps bakeAll(const char *what)
+    {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (unsigned int s = 0; s < stepCount(); ++s)
+            runStep(s);
+        IBLMaps m = finish();
+        glFinish();
+        release(); // a one-off bake keeps nothing around
+        LOG_INFO("[IBL] Baked " << what << " in "
+                 << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() << " ms");
+        return m;
+    }
+
+    void start(const IBLBakeSettings &s)
+    {
+        if (active)
+            abort();
+        settings = s;
+        active = true;
+        computePrefilter = settings.compute && ComputeShader::supported();
+        createResources();
+
+        // cubemap to render to; mips: step 1 generates them
+        maps.envCubemap = cubeMap(settings.envSize, GL_RGB16F);
+        gpuMemory().trackTexture(maps.envCubemap, GpuMemory::ENVIRONMENT, GL_RGB16F, (int)settings.envSize, (int)settings.envSize, 6, true, "ibl");
+
+        // prefilter cubemap; the compute path writes it through image stores, which have no RGB16F format
+        maps.prefilterMap = cubeMap(settings.prefilterSize, computePrefilter ? GL_RGBA16F : GL_RGB16F);
+        if (!glBackend().dsa())
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        gpuMemory().trackTexture(maps.prefilterMap, GpuMemory::ENVIRONMENT, computePrefilter ? GL_RGBA16F : GL_RGB16F, (int)settings.prefilterSize,
+                                 (int)settings.prefilterSize, 6, true, "ibl");
+    }
+
+    // a `size` cube map with clamped trilinear sampling: immutable storage for its whole mip chain with direct
+    // state access (GlBackend), otherwise level 0 of each face, left bound to GL_TEXTURE_CUBE_MAP
+    static GLuint cubeMap(unsigned int size, GLenum internalFormat)
+    {
+        const GLuint cube = glBackend().createTexture(GL_TEXTURE_CUBE_MAP);
+        if (glBackend().dsa())
+            glBackend().textureStorage2D(cube, GL_TEXTURE_CUBE_MAP, (GLsizei)MipChain::levelCount(size, size), internalFormat, size, size);
+        else
+        {
+            glState().bindTexture(0, GL_TEXTURE_CUBE_MAP, cube);
+            for (unsigned int i = 0; i < 6; ++i)
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internalFormat, size, size, 0, GL_RGB, GL_FLOAT, nullptr);
+        }
+        glBackend().textureParameter(cube, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glBackend().textureParameter(cube, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBackend().textureParameter(cube, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glBackend().textureParameter(cube, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glBackend().textureParameter(cube, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        return cube;
+    }
+
+    void createResources()
+    {
+        if (!procedural && !equirectShader)
+            equirectShader.reset(layeredShader("equirectangular_to_cubemap.fs"));
+        if (procedural && !skyShader)
+            skyShader.reset(layeredShader("procedural_sky.fs"));
+        if (computePrefilter && !prefilterCompute)
+        {
+            prefilterCompute.reset(new ComputeShader((shaderDir + "/prefilter.comp").c_str()));
+            if (!prefilterCompute->valid())
+                LOG_WARN("[IBL] prefilter.comp unusable, prefiltering with the raster path");
+        }
+        computePrefilter = computePrefilter && prefilterCompute && prefilterCompute->valid();
+        if (!computePrefilter && !prefilterShader)
+            prefilterShader.reset(layeredShader("prefilter.fs"));
+        // colour-only capture FBO: the cube is drawn from inside with nothing to occlude
+        if (!captureFBO)
+            captureFBO = glBackend().createFramebuffer();
+        if (!cubeVAO)
+        {
+            const float vertices[] = {
+                // positions
+                -1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f,
+                -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f,
+                -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f,
+                1.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 1.0f, 1.0f,
+                -1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, -1.0f,
+                -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+            cubeVAO = glBackend().createVertexArray();
+            cubeVBO = glBackend().createBuffer();
+            glBackend().bufferStorage(cubeVBO, GL_ARRAY_BUFFER, sizeof(vertices), vertices);
+            gpuMemory().trackBuffer(cubeVBO, GpuMemory::ENVIRONMENT, sizeof(vertices), "ibl");
+            if (glBackend().dsa())
+            {
+                glEnableVertexArrayAttrib(cubeVAO, 0);
+                glVertexArrayAttribFormat(cubeVAO, 0, 3, GL_FLOAT, GL_FALSE, 0);
+                glVertexArrayAttribBinding(cubeVAO, 0, 0);
+                glVertexArrayVertexBuffer(cubeVAO, 0, cubeVBO, 0, 3 * sizeof(float));
+            }
+            else
+            {
+                glBindVertexArray(cubeVAO);
+                glEnableVertexAttribArray(0);
+                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                glBindVertexArray(0);
+            }
+        }
+    }
+
+    Shader *layeredShader(const char *fragment) const
+    {
+        return new Shader((shaderDir + "/cubemap_layered.vs").c_str(), (shaderDir + "/" + fragment).c_str(), std::string(),
+                          (shaderDir + "/cubemap_layered.gs").c_str());
+    }
+
+    // capture projection and the six face views of a layered capture program (in use)
+    static void setCapture(const Shader &shader)
+    {
+        glm::mat4 views[6];
+        for (unsigned int face = 0; face < 6; ++face)
+            views[face] = captureView(face);
+        shader.setMat4("projection", captureProjection());
+        glUniformMatrix4fv(shader.location("captureViews"), 6, GL_FALSE, &views[0][0][0]);
+    }
+
+    // draws the unit cube into all six faces of `cube` at `level` with the layered program in use
+    void drawCube(GLuint cube, unsigned int level, unsigned int size)
+    {
+        glBackend().framebufferTexture(captureFBO, GL_COLOR_ATTACHMENT0, cube, (GLint)level);
+        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+        glViewport(0, 0, size, size);
+        GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+        glDisable(GL_DEPTH_TEST);
+        glBindVertexArray(cubeVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+        drawStats().count();
+        glBindVertexArray(0);
+        if (depthTest)
+            glEnable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    // convert HDR equirectangular (or render the procedural sky) to all faces of envCubemap
+    void renderFaces()
+    {
+        if (procedural)
+        {
+            atmosphere().update(sky.sunDirection);
+            skyShader->use();
+            skyShader->setVec3("sunDirection", sky.sunDirection);
+            skyShader->setFloat("sunIntensity", sky.sunIntensity);
+            skyShader->setFloat("sunPower", sky.sunPower);
+            atmosphere().apply(*skyShader, sky);
+            setCapture(*skyShader);
+            drawCube(maps.envCubemap, 0, settings.envSize);
+            return;
+        }
+        equirectShader->use();
+        equirectShader->setInt("equirectangularMap", 0);
+        setCapture(*equirectShader);
+        glState().bindTextureUnit(0, GL_TEXTURE_2D, source);
+        drawCube(maps.envCubemap, 0, settings.envSize);
+    }
+
+    // quasi Monte-Carlo GGX prefilter of one mip of envCubemap, all faces at once
+    void prefilter(unsigned int mip)
+    {
+        const unsigned int mipSize = settings.prefilterSize >> mip;
+        const float roughness = (float)mip / (float)(settings.prefilterMips - 1);
+        glState().bindTextureUnit(0, GL_TEXTURE_CUBE_MAP, maps.envCubemap);
+        if (computePrefilter)
+        {
+            // one dispatch covers all six faces; filtered importance sampling reads envCubemap's mips, so the
+            // sample count can grow with roughness (a mirror needs a single sample) instead of a fixed 1024
+            const unsigned int samples = mip == 0 ? 1u : std::min(1024u, 32u << mip);
+            prefilterCompute->use();
+            prefilterCompute->setInt("environmentMap", 0);
+            prefilterCompute->setFloat("environmentSize", (float)settings.envSize);
+            prefilterCompute->setFloat("roughness", roughness);
+            prefilterCompute->setUint("sampleCount", samples);
+            prefilterCompute->setInt("mipSize", (int)mipSize);
+            glBindImageTexture(0, maps.prefilterMap, (GLint)mip, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            glDispatchCompute((mipSize + 7) / 8, (mipSize + 7) / 8, 6);
+            glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            // later steps (and the renderer after the swap) sample or read back the prefilter
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+            return;
+        }
+        prefilterShader->use();
+        prefilterShader->setInt("environmentMap", 0);
+        prefilterShader->setFloat("roughness", roughness);
+        setCapture(*prefilterShader);
+        drawCube(maps.prefilterMap, mip, mipSize);
+    }
+};
+
+#endif
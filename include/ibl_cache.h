@@ -0,0 +1,329 @@
+#ifndef IBL_CACHE_H
+#define IBL_CACHE_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gpu_memory.h>
+#include <mapped_file.h>
+#include <spherical_harmonics.h>
+#if defined(HAS_TINYEXR)
+#include <image_writer.h>
+#include <thread_pool.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// On-disk cache of the baked IBL data (environment and prefilter cubes, diffuse SH coefficients; the BRDF
+// LUT is embedded). The first launch with an EXR bakes on the GPU and stores every map as raw half floats
+// next to the EXR; later launches upload them directly and skip the EXR decode and all bake passes.
+//
+// File layout: Header (with the SH coefficients), then per texture a TextureHeader followed by its levels
+// (faces inside each level for cube maps), tightly packed with no padding.
+namespace IBLCache
+{
+    const char MAGIC[4] = {'I', 'B', 'L', 'C'};
+    const uint32_t VERSION = 2;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint64_t sourceHash;    // hash of the EXR file
+        uint64_t paramsHash;    // hash of the bake sizes and the bake shader sources
+        uint32_t textureCount;
+        uint32_t reserved;
+        float irradianceSH[SHIrradiance::COEFFICIENTS * 3]; // SHIrradiance::c after finish()
+    };
+
+    struct TextureHeader
+    {
+        uint32_t target;        // GL_TEXTURE_CUBE_MAP or GL_TEXTURE_2D
+        uint32_t components;    // 3 = GL_RGB16F, 2 = GL_RG16F
+        uint32_t size;          // width = height of level 0
+        uint32_t levels;        // stored levels
+        uint32_t generateMips;  // 1 = rebuild the remaining levels with glGenerateMipmap after upload
+        uint32_t reserved;
+    };
+
+    // one map of the bake: the stored levels, and whether the rest of its chain is regenerated on load
+    struct Entry
+    {
+        GLuint *texture;
+        GLenum target;
+        uint32_t components;
+        uint32_t size;
+        uint32_t levels;
+        bool generateMips;
+        const char *name;   // file name part of exportExr()
+    };
+
+    inline uint64_t hashBytes(const void *data, size_t size, uint64_t h = 1469598103934665603ull)
+    {
+        // FNV-1a
+        const unsigned char *p = (const unsigned char *)data;
+        for (size_t i = 0; i < size; ++i)
+            h = (h ^ p[i]) * 1099511628211ull;
+        return h;
+    }
+
+    inline std::string cachePath(const std::string &exrPath)
+    {
+        return exrPath + ".iblcache";
+    }
+
+    // hash of a file's contents (0 if it can't be read)
+    inline uint64_t hashFile(const std::string &path)
+    {
+        MappedFile file;
+        if (!file.open(path))
+            return 0;
+        return hashBytes(file.data(), file.size());
+    }
+
+    // bake parameters: the map sizes plus the sources of every shader used by the bake
+    inline uint64_t paramsHash(const std::vector<uint32_t> &sizes, const std::vector<std::string> &shaderPaths)
+    {
+        uint64_t h = hashBytes(sizes.empty() ? NULL : &sizes[0], sizes.size() * sizeof(uint32_t));
+        for (size_t i = 0; i < shaderPaths.size(); ++i)
+        {
+            MappedFile file;
+            if (file.open(shaderPaths[i]))
+                h = hashBytes(file.data(), file.size(), h);
+        }
+        return h;
+    }
+
+    inline size_t levelBytes(const TextureHeader &t, uint32_t level)
+    {
+        size_t side = t.size >> level;
+        if (side == 0)
+            side = 1;
+        return side * side * t.components * 2; // half floats
+    }
+
+    inline GLenum faceTarget(uint32_t target, uint32_t face)
+    {
+        return target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face : GL_TEXTURE_2D;
+    }
+
+    // save()'s body: the whole file at `path`
+    inline bool writeFile(const std::string &path, uint64_t sourceHash, uint64_t paramsHash, const SHIrradiance &sh,
+                          const std::vector<Entry> &entries)
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        if (!out)
+            return false;
+        Header header;
+        std::memcpy(header.magic, MAGIC, 4);
+        header.version = VERSION;
+        header.sourceHash = sourceHash;
+        header.paramsHash = paramsHash;
+        header.textureCount = (uint32_t)entries.size();
+        header.reserved = 0;
+        std::memcpy(header.irradianceSH, &sh.c[0][0], sizeof(header.irradianceSH));
+        out.write((const char *)&header, sizeof(header));
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        std::vector<unsigned char> pixels;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const Entry &e = entries[i];
+            TextureHeader t = {(uint32_t)e.target, e.components, e.size, e.levels, e.generateMips ? 1u : 0u, 0};
+            out.write((const char *)&t, sizeof(t));
+            glBindTexture(e.target, *e.texture);
+            const uint32_t faces = e.target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+            const GLenum format = e.components == 3 ? GL_RGB : GL_RG;
+            for (uint32_t level = 0; level < e.levels; ++level)
+                for (uint32_t face = 0; face < faces; ++face)
+                {
+                    pixels.resize(levelBytes(t, level));
+                    glGetTexImage(faceTarget(t.target, face), (GLint)level, format, GL_HALF_FLOAT, &pixels[0]);
+                    out.write((const char *)&pixels[0], (std::streamsize)pixels.size());
+                }
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        return (bool)out;
+    }
+
+    // GL thread: reads the maps back and writes the cache file. Returns false if the file can't be written.
+    // The file is written under a name of its own and renamed into place, so processes baking the same
+    // environment at once (render farm workers on one node, BATCH_FARM) never map one half written.
+    inline bool save(const std::string &path, uint64_t sourceHash, uint64_t paramsHash, const SHIrradiance &sh,
+                     const std::vector<Entry> &entries)
+    {
+        const unsigned long long stamp = (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count();
+        const std::string part = path + ".part" + std::to_string(stamp);
+        if (!writeFile(part, sourceHash, paramsHash, sh, entries))
+        {
+            std::remove(part.c_str());
+            return false;
+        }
+        // Windows won't rename over a file; one another process has mapped stays (it holds the same bake)
+        if (std::rename(part.c_str(), path.c_str()) != 0 &&
+            (std::remove(path.c_str()) != 0 || std::rename(part.c_str(), path.c_str()) != 0))
+        {
+            std::remove(part.c_str());
+            std::ifstream existing(path.c_str(), std::ios::binary);
+            return (bool)existing;
+        }
+        return true;
+    }
+
+#if defined(HAS_TINYEXR)
+    // GL thread, IBL_EXPORT_EXR=1: reads every stored level of `entries` back and writes each as a half-float
+    // EXR, "<prefix>.<name>.exr" (".<name>.mipN.exr" for mip chains), cube faces stacked top to bottom in GL
+    // order (+X -X +Y -Y +Z -Z). Only the readback is on this thread; the encode and its compression
+    // (EXR_COMPRESSION) run on ThreadPool::shared(). Returns the number of files queued.
+    inline size_t exportExr(const std::string &prefix, const std::vector<Entry> &entries)
+    {
+        const int compression = ImageWriter::exrCompressionFromEnv();
+        size_t queued = 0;
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const Entry &e = entries[i];
+            const TextureHeader t = {(uint32_t)e.target, e.components, e.size, e.levels, 0, 0};
+            const uint32_t faces = e.target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+            const GLenum format = e.components == 3 ? GL_RGB : GL_RG;
+            glBindTexture(e.target, *e.texture);
+            for (uint32_t level = 0; level < e.levels; ++level)
+            {
+                const int side = (int)std::max(1u, e.size >> level);
+                const size_t faceBytes = levelBytes(t, level);
+                std::shared_ptr<std::vector<uint16_t> > pixels = std::make_shared<std::vector<uint16_t> >(faceBytes * faces / 2);
+                for (uint32_t face = 0; face < faces; ++face)
+                    glGetTexImage(faceTarget(t.target, face), (GLint)level, format, GL_HALF_FLOAT, (unsigned char *)pixels->data() + face * faceBytes);
+                const std::string path = prefix + '.' + (e.name ? e.name : std::to_string(i)) +
+                                         (e.levels > 1 ? ".mip" + std::to_string(level) : std::string()) + ".exr";
+                const int components = (int)e.components, height = side * (int)faces;
+                ThreadPool::shared().submit([pixels, path, side, height, components, compression]() {
+                    // interleaved RGB(G) to planes in EXR's channel name order (B, G, R)
+                    const size_t count = (size_t)side * height;
+                    std::vector<uint16_t> planes[3];
+                    unsigned char *planePointers[3];
+                    for (int c = 0; c < components; ++c)
+                    {
+                        planes[c].resize(count);
+                        const int source = components - 1 - c;
+                        for (size_t p = 0; p < count; ++p)
+                            planes[c][p] = (*pixels)[p * components + source];
+                        planePointers[c] = (unsigned char *)planes[c].data();
+                    }
+                    if (ImageWriter::saveExr(path, planePointers, components, TINYEXR_PIXELTYPE_HALF, side, height, compression))
+                        LOG_INFO("[IBL] Exported '" << path << "'");
+                });
+                ++queued;
+            }
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        return queued;
+    }
+#endif
+
+    // checks a mapped cache file against the expected source, parameters and texture layout (no GL, any thread)
+    inline bool validate(const MappedFile &file, const std::string &path, uint64_t sourceHash, uint64_t paramsHash,
+                         const std::vector<Entry> &entries)
+    {
+        if (file.size() < sizeof(Header))
+            return false;
+        const unsigned char *base = file.data();
+        const Header &header = *(const Header *)base;
+        if (std::memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION || header.textureCount != entries.size())
+        {
+            LOG_INFO("[IBL] '" << path << "' is not a current IBL cache, rebaking");
+            return false;
+        }
+        if (header.sourceHash != sourceHash || header.paramsHash != paramsHash)
+        {
+            LOG_INFO("[IBL] '" << path << "' is stale (EXR or bake settings changed), rebaking");
+            return false;
+        }
+        // validate the whole file before creating any texture
+        size_t offset = sizeof(Header);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (offset + sizeof(TextureHeader) > file.size())
+                return false;
+            const TextureHeader &t = *(const TextureHeader *)(base + offset);
+            const Entry &e = entries[i];
+            if (t.target != (uint32_t)e.target || t.components != e.components || t.size != e.size || t.levels != e.levels)
+                return false;
+            offset += sizeof(TextureHeader);
+            const uint32_t faces = t.target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+            for (uint32_t level = 0; level < t.levels; ++level)
+                offset += levelBytes(t, level) * faces;
+            if (offset > file.size())
+            {
+                LOG_WARN("[IBL] '" << path << "' is truncated, rebaking");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // true if `path` holds a usable cache for these inputs (no GL, any thread)
+    inline bool valid(const std::string &path, uint64_t sourceHash, uint64_t paramsHash, const std::vector<Entry> &entries)
+    {
+        MappedFile file;
+        return file.open(path) && validate(file, path, sourceHash, paramsHash, entries);
+    }
+
+    // GL thread: creates the textures of `entries` and fills `sh` from the cache file. Returns false (creating
+    // nothing) if the file is missing, truncated, or was baked from another EXR or with other parameters.
+    inline bool load(const std::string &path, uint64_t sourceHash, uint64_t paramsHash, SHIrradiance &sh,
+                     const std::vector<Entry> &entries)
+    {
+        MappedFile file;
+        if (!file.open(path) || !validate(file, path, sourceHash, paramsHash, entries))
+            return false;
+        const unsigned char *base = file.data();
+        const Header &header = *(const Header *)base;
+        size_t offset;
+        std::memcpy(&sh.c[0][0], header.irradianceSH, sizeof(header.irradianceSH));
+        offset = sizeof(Header);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            const TextureHeader &t = *(const TextureHeader *)(base + offset);
+            offset += sizeof(TextureHeader);
+            const Entry &e = entries[i];
+            glGenTextures(1, e.texture);
+            glBindTexture(e.target, *e.texture);
+            const uint32_t faces = t.target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+            const GLenum format = t.components == 3 ? GL_RGB : GL_RG;
+            const GLenum internalFormat = t.components == 3 ? GL_RGB16F : GL_RG16F;
+            for (uint32_t level = 0; level < t.levels; ++level)
+                for (uint32_t face = 0; face < faces; ++face)
+                {
+                    GLsizei side = (GLsizei)std::max(1u, t.size >> level);
+                    glTexImage2D(faceTarget(t.target, face), (GLint)level, internalFormat, side, side, 0, format, GL_HALF_FLOAT, base + offset);
+                    offset += levelBytes(t, level);
+                }
+            const bool mipmapped = t.generateMips || t.levels > 1;
+            gpuMemory().trackTexture(*e.texture, GpuMemory::ENVIRONMENT, internalFormat, (int)t.size, (int)t.size, (int)faces, mipmapped, "ibl");
+            glTexParameteri(e.target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(e.target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            if (e.target == GL_TEXTURE_CUBE_MAP)
+                glTexParameteri(e.target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            glTexParameteri(e.target, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(e.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            if (t.generateMips)
+                glGenerateMipmap(e.target);
+            else if (mipmapped)
+                glTexParameteri(e.target, GL_TEXTURE_MAX_LEVEL, (GLint)t.levels - 1);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        LOG_INFO("[IBL] Loaded baked maps from '" << path << "' (" << file.size() / (1024 * 1024) << " MiB)");
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef IDLE_RENDERER_H
+#define IDLE_RENDERER_H
+
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+// Stops redrawing a scene that isn't changing (IDLE_RENDER=1). The main loop reports after every frame
+// whether anything that shows on screen changed: the view, a placed model (the scene's placedRevision), a
+// load, an environment bake, a texture level streaming in, an animated light, a progressive still not yet
+// converged, or any window event (redrawRequested, set by the input callbacks). After IDLE_SETTLE_FRAMES
+// unchanged frames in a row (default 16, enough for TAA's history to settle on the last view) the loop stops
+// drawing and blocks in wait() instead: the last frame stays on screen, with no GPU work and no CPU spin,
+// until an event arrives. IDLE_TIMEOUT_MS (default 500) bounds each wait so the loop still notices the
+// window closing from outside. Offline runs (benchmark, batch, poster, capture sequences) never idle.
+class IdleRenderer
+{
+public:
+    IdleRenderer()
+    {
+        const char *env = std::getenv("IDLE_RENDER");
+        active = env && std::string(env) == "1";
+        if (const char *f = std::getenv("IDLE_SETTLE_FRAMES"))
+            settleFrames = std::max(1, std::atoi(f));
+        if (const char *t = std::getenv("IDLE_TIMEOUT_MS"))
+            timeoutSeconds = std::max(1, std::atoi(t)) * 1e-3;
+        if (active)
+            LOG_INFO("[Idle] Redraws stop after " << settleFrames << " unchanged frames");
+    }
+
+    bool enabled() const { return active; }
+    void disable() { active = false; }
+
+    // after every drawn frame: whether it differed from the one before, or the next one may differ
+    void endFrame(bool changed)
+    {
+        if (changed)
+        {
+            quietFrames = 0;
+            return;
+        }
+        if (++quietFrames == settleFrames && active)
+            LOG_DEBUG("[Idle] Scene unchanged, waiting for events");
+    }
+
+    // nothing changed for long enough: wait() instead of drawing
+    bool sleeping() const { return active && quietFrames >= settleFrames; }
+
+    // blocks until a window event arrives or the timeout passes (the callbacks run in here); main thread
+    void wait() const { glfwWaitEventsTimeout(timeoutSeconds); }
+    // the longest a wait lasts, for loops that wait on something else (a render thread on its snapshots)
+    double timeout() const { return timeoutSeconds; }
+
+    // an event woke the loop: draw again, settling anew
+    void wake() { quietFrames = 0; }
+
+private:
+    bool active = false;
+    int settleFrames = 16;
+    double timeoutSeconds = 0.5;
+    int quietFrames = 0;
+};
+
+#endif
@@ -0,0 +1,542 @@
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <async_log.h>
+#include <thread_pool.h>
+
+#include "stb_image_write.h"
+#if defined(HAS_MINIZ)
+#include "miniz.h"
+#endif
+#if defined(HAS_TINYEXR)
+#include "tinyexr.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+
+// Encodes captured frames (FrameCapture) from GL's bottom-up RGBA8 rows; every format writes the rows top
+// down as it goes, so the flip never needs a copy of the image.
+//  - PNG: miniz's tdefl at CAPTURE_PNG_LEVEL (0 = stored .. 10, default 6; 1 is the fast preview mode).
+//    The image is cut into CAPTURE_STRIPS horizontal strips (default: one per ThreadPool::shared() worker)
+//    that are filtered and deflated in parallel, each ending on a sync flush so the raw deflate streams
+//    concatenate into the one zlib stream PNG wants; only the Adler-32 runs over the whole image. Strips
+//    restart the match window, which costs a fraction of a percent of file size. Without miniz in the build
+//    it falls back to stbi_write_png.
+//  - QOI: lossless, no entropy coder, several times faster than any PNG level.
+//  - EXR (tinyexr builds): half floats for pipelines that grade the frames afterwards. FrameCapture hands
+//    over the linear HDR scene (writeHdr()) where there is one, else the window linearized with the tone
+//    map's 2.2 display encoding. EXR_COMPRESSION=zip (default) | piz | zips | none; tinyexr compresses the
+//    scanline blocks on all cores (TINYEXR_USE_THREAD), so only the encoder thread waits for it.
+// CAPTURE_FORMAT=png (default) | qoi | exr.
+class ImageWriter
+{
+public:
+    enum Format { PNG, QOI, EXR };
+
+    ImageWriter()
+    {
+        if (const char *f = std::getenv("CAPTURE_FORMAT"))
+        {
+            const std::string name(f);
+            if (name == "qoi")
+                format = QOI;
+#if defined(HAS_TINYEXR)
+            else if (name == "exr")
+                format = EXR;
+#endif
+            else if (name != "png")
+                LOG_WARN("[Capture] Unknown CAPTURE_FORMAT " << name << ", writing PNG");
+        }
+        if (const char *l = std::getenv("CAPTURE_PNG_LEVEL"))
+            pngLevel = std::min(10, std::max(0, std::atoi(l)));
+        if (const char *s = std::getenv("CAPTURE_STRIPS"))
+            strips = (unsigned int)std::max(1, std::atoi(s));
+#if defined(HAS_TINYEXR)
+        exrCompression = exrCompressionFromEnv();
+#endif
+    }
+
+    Format outputFormat() const { return format; }
+
+    // `path` with the extension of the output format in place of a trailing .png
+    std::string pathFor(const std::string &path) const
+    {
+        if (format == PNG || path.size() < 4 || path.compare(path.size() - 4, 4, ".png") != 0)
+            return path;
+        return path.substr(0, path.size() - 4) + (format == QOI ? ".qoi" : ".exr");
+    }
+
+    // any thread: writes `width` x `height` RGBA8 pixels whose rows run bottom-up (GL's order)
+    bool write(const std::string &path, const unsigned char *bottomUp, int width, int height) const
+    {
+        switch (format)
+        {
+        case QOI:
+            return writeQoi(path, bottomUp, width, height);
+#if defined(HAS_TINYEXR)
+        case EXR:
+            return writeExr(path, bottomUp, width, height);
+#endif
+        default:
+            return writePng(path, bottomUp, width, height);
+        }
+    }
+
+#if defined(HAS_TINYEXR)
+    // any thread, EXR only: writes `width` x `height` RGBA half floats (linear HDR, read back from a
+    // GL_RGBA16F target) whose rows run bottom-up; alpha is dropped
+    bool writeHdr(const std::string &path, const uint16_t *bottomUp, int width, int height) const
+    {
+        const size_t pixels = (size_t)width * height;
+        std::vector<uint16_t> channels[3]; // B, G, R
+        for (int c = 0; c < 3; ++c)
+            channels[c].resize(pixels);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint16_t *row = bottomUp + (size_t)(height - 1 - y) * width * 4;
+            for (int x = 0; x < width; ++x)
+                for (int c = 0; c < 3; ++c)
+                    channels[c][(size_t)y * width + x] = row[x * 4 + 2 - c];
+        }
+        unsigned char *planes[3] = {(unsigned char *)channels[0].data(), (unsigned char *)channels[1].data(), (unsigned char *)channels[2].data()};
+        return saveExr(path, planes, 3, TINYEXR_PIXELTYPE_HALF, width, height, exrCompression);
+    }
+
+    // EXR_COMPRESSION as a TINYEXR_COMPRESSIONTYPE_* (ZIP when unset or unknown)
+    static int exrCompressionFromEnv()
+    {
+        const char *env = std::getenv("EXR_COMPRESSION");
+        const std::string name = env ? env : "zip";
+        if (name == "piz")
+            return TINYEXR_COMPRESSIONTYPE_PIZ;
+        if (name == "zips")
+            return TINYEXR_COMPRESSIONTYPE_ZIPS;
+        if (name == "none")
+            return TINYEXR_COMPRESSIONTYPE_NONE;
+        if (name != "zip")
+            LOG_WARN("[EXR] Unknown EXR_COMPRESSION " << name << ", using zip");
+        return TINYEXR_COMPRESSIONTYPE_ZIP;
+    }
+
+    // writes `channels` planes (blue, green, red, in the name order EXR viewers expect; 2 planes are green,
+    // red) of `width` x `height` `pixelType` values, top row first, stored as half floats
+    static bool saveExr(const std::string &path, unsigned char **planes, int channels, int pixelType, int width, int height, int compression)
+    {
+        static const char NAMES[3] = {'B', 'G', 'R'};
+        EXRHeader header;
+        InitEXRHeader(&header);
+        EXRImage image;
+        InitEXRImage(&image);
+        image.images = planes;
+        image.num_channels = channels;
+        image.width = width;
+        image.height = height;
+        EXRChannelInfo info[3];
+        std::memset(info, 0, sizeof(info));
+        int pixelTypes[3], requested[3];
+        for (int c = 0; c < channels; ++c)
+        {
+            info[c].name[0] = NAMES[3 - channels + c];
+            pixelTypes[c] = pixelType;
+            requested[c] = TINYEXR_PIXELTYPE_HALF;
+        }
+        header.num_channels = channels;
+        header.channels = info;
+        header.pixel_types = pixelTypes;
+        header.requested_pixel_types = requested;
+        header.compression_type = compression;
+        const char *err = NULL;
+        const bool ok = SaveEXRImageToFile(&image, &header, path.c_str(), &err) == TINYEXR_SUCCESS;
+        if (!ok)
+        {
+            LOG_WARN("[EXR] " << path << ": " << (err ? err : "write failed"));
+            FreeEXRErrorMessage(err);
+        }
+        return ok;
+    }
+#endif
+
+private:
+    friend class PngStream;
+
+    Format format = PNG;
+    int pngLevel = 6;
+    unsigned int strips = 0;
+#if defined(HAS_TINYEXR)
+    int exrCompression = TINYEXR_COMPRESSIONTYPE_ZIP;
+#endif
+
+    static void putBigEndian(std::vector<unsigned char> &out, unsigned int v)
+    {
+        out.push_back((unsigned char)(v >> 24));
+        out.push_back((unsigned char)(v >> 16));
+        out.push_back((unsigned char)(v >> 8));
+        out.push_back((unsigned char)v);
+    }
+
+    static bool writeFile(const std::string &path, const void *data, size_t bytes)
+    {
+        FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+        const bool ok = std::fwrite(data, 1, bytes, file) == bytes;
+        return std::fclose(file) == 0 && ok;
+    }
+
+#if defined(HAS_MINIZ)
+    static int paeth(int a, int b, int c)
+    {
+        const int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+    }
+
+    // one filtered scanline (filter byte + bytes) of `row` over `above` (NULL for the first row)
+    static void filterRow(const unsigned char *row, const unsigned char *above, int bytes, int type, unsigned char *out)
+    {
+        out[0] = (unsigned char)type;
+        for (int i = 0; i < bytes; ++i)
+        {
+            const int a = i >= 4 ? row[i - 4] : 0, b = above ? above[i] : 0, c = above && i >= 4 ? above[i - 4] : 0;
+            int predicted = 0;
+            switch (type)
+            {
+            case 1: predicted = a; break;
+            case 2: predicted = b; break;
+            case 3: predicted = (a + b) >> 1; break;
+            case 4: predicted = paeth(a, b, c); break;
+            }
+            out[1 + i] = (unsigned char)(row[i] - predicted);
+        }
+    }
+
+    // the filtered scanline of `row` PNG's way at `level`: the filter with the smallest sum of signed
+    // residuals (libpng's heuristic), or for previews (level <= 1) Up alone (Sub on the first row), which
+    // is nearly as small and skips the search. `candidate` is scratch of bytes + 1.
+    static void filterBest(const unsigned char *row, const unsigned char *above, int bytes, int level, unsigned char *out,
+                           unsigned char *candidate)
+    {
+        if (level <= 1)
+        {
+            filterRow(row, above, bytes, above ? 2 : 1, out);
+            return;
+        }
+        long best = -1;
+        for (int type = 0; type < 5; ++type)
+        {
+            filterRow(row, above, bytes, type, candidate);
+            long cost = 0;
+            for (int i = 1; i <= bytes; ++i)
+                cost += std::abs((int)(signed char)candidate[i]);
+            if (best < 0 || cost < best)
+            {
+                best = cost;
+                std::memcpy(out, candidate, bytes + 1);
+            }
+        }
+    }
+
+    struct Strip
+    {
+        std::vector<unsigned char> filtered;
+        std::vector<unsigned char> deflated;
+    };
+
+    static mz_bool appendOutput(const void *buf, int len, void *user)
+    {
+        std::vector<unsigned char> &out = *static_cast<std::vector<unsigned char> *>(user);
+        out.insert(out.end(), (const unsigned char *)buf, (const unsigned char *)buf + len);
+        return MZ_TRUE;
+    }
+
+    // filters image rows [y0, y1) (top-down numbering) and deflates them as raw deflate blocks
+    void encodeStrip(const unsigned char *bottomUp, int width, int height, int y0, int y1, bool last, Strip &strip) const
+    {
+        const int bytes = width * 4;
+        strip.filtered.resize((size_t)(y1 - y0) * (bytes + 1));
+        std::vector<unsigned char> candidate(bytes + 1);
+        for (int y = y0; y < y1; ++y)
+        {
+            const unsigned char *row = bottomUp + (size_t)(height - 1 - y) * bytes;
+            const unsigned char *above = y > 0 ? row + bytes : NULL; // the row above is the next one in GL order
+            filterBest(row, above, bytes, pngLevel, &strip.filtered[(size_t)(y - y0) * (bytes + 1)], &candidate[0]);
+        }
+        tdefl_compressor *compressor = tdefl_compressor_alloc();
+        if (!compressor)
+            return;
+        // negative window bits: raw deflate, the zlib header and checksum are written once around all strips
+        const mz_uint flags = tdefl_create_comp_flags_from_zip_params(pngLevel, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+        strip.deflated.reserve(strip.filtered.size() / 2);
+        tdefl_init(compressor, &ImageWriter::appendOutput, &strip.deflated, (int)flags);
+        if (tdefl_compress_buffer(compressor, strip.filtered.data(), strip.filtered.size(), last ? TDEFL_FINISH : TDEFL_SYNC_FLUSH) < 0)
+            strip.deflated.clear();
+        tdefl_compressor_free(compressor);
+    }
+
+    bool writePng(const std::string &path, const unsigned char *bottomUp, int width, int height) const
+    {
+        ThreadPool &pool = ThreadPool::shared();
+        const int count = std::max(1, std::min(height, (int)(strips ? strips : pool.size())));
+        std::vector<Strip> parts(count);
+        std::vector<std::future<void> > done;
+        for (int s = 0; s < count; ++s)
+        {
+            const int y0 = height * s / count, y1 = height * (s + 1) / count;
+            Strip *strip = &parts[s];
+            const bool last = s == count - 1;
+            done.push_back(pool.submit([this, bottomUp, width, height, y0, y1, last, strip]() {
+                encodeStrip(bottomUp, width, height, y0, y1, last, *strip);
+            }));
+        }
+        for (size_t s = 0; s < done.size(); ++s)
+            done[s].get();
+
+        std::vector<unsigned char> png;
+        static const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+        png.insert(png.end(), signature, signature + 8);
+        // IHDR: 8-bit RGBA, deflate, adaptive filtering, no interlace
+        std::vector<unsigned char> header;
+        putBigEndian(header, (unsigned int)width);
+        putBigEndian(header, (unsigned int)height);
+        const unsigned char format[5] = {8, 6, 0, 0, 0};
+        header.insert(header.end(), format, format + 5);
+        appendChunk(png, "IHDR", header);
+        std::vector<unsigned char> idat;
+        idat.push_back(0x78); // zlib header: deflate, 32 KB window (the flags don't affect decoding)
+        idat.push_back(0x01);
+        mz_ulong adler = MZ_ADLER32_INIT;
+        for (int s = 0; s < count; ++s)
+        {
+            if (parts[s].deflated.empty())
+                return false;
+            idat.insert(idat.end(), parts[s].deflated.begin(), parts[s].deflated.end());
+            adler = mz_adler32(adler, parts[s].filtered.data(), parts[s].filtered.size());
+        }
+        putBigEndian(idat, (unsigned int)adler);
+        appendChunk(png, "IDAT", idat);
+        appendChunk(png, "IEND", std::vector<unsigned char>());
+        return writeFile(path, png.data(), png.size());
+    }
+
+    static void appendChunk(std::vector<unsigned char> &png, const char *type, const std::vector<unsigned char> &data)
+    {
+        putBigEndian(png, (unsigned int)data.size());
+        const size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        const mz_ulong crc = mz_crc32(MZ_CRC32_INIT, &png[start], png.size() - start);
+        putBigEndian(png, (unsigned int)crc);
+    }
+#else
+    bool writePng(const std::string &path, const unsigned char *bottomUp, int width, int height) const
+    {
+        // top row first: start at the last GL row and step backwards
+        const int stride = width * 4;
+        return stbi_write_png(path.c_str(), width, height, 4, bottomUp + (size_t)(height - 1) * stride, -stride) != 0;
+    }
+#endif
+
+    // "Quite OK Image" format (qoiformat.org), RGBA, sRGB with linear alpha
+    static bool writeQoi(const std::string &path, const unsigned char *bottomUp, int width, int height)
+    {
+        std::vector<unsigned char> out;
+        out.reserve((size_t)width * height * 2 + 22);
+        const unsigned char magic[4] = {'q', 'o', 'i', 'f'};
+        out.insert(out.end(), magic, magic + 4);
+        putBigEndian(out, (unsigned int)width);
+        putBigEndian(out, (unsigned int)height);
+        out.push_back(4); // channels
+        out.push_back(0); // sRGB
+        unsigned char index[64][4];
+        std::memset(index, 0, sizeof(index));
+        unsigned char previous[4] = {0, 0, 0, 255};
+        int run = 0;
+        const size_t pixels = (size_t)width * height;
+        for (size_t p = 0; p < pixels; ++p)
+        {
+            const size_t y = p / width, x = p % width;
+            const unsigned char *px = bottomUp + ((height - 1 - y) * width + x) * 4;
+            if (std::memcmp(px, previous, 4) == 0)
+            {
+                if (++run == 62 || p == pixels - 1)
+                {
+                    out.push_back((unsigned char)(0xc0 | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0)
+            {
+                out.push_back((unsigned char)(0xc0 | (run - 1)));
+                run = 0;
+            }
+            const int slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            if (std::memcmp(index[slot], px, 4) == 0)
+                out.push_back((unsigned char)slot);
+            else
+            {
+                std::memcpy(index[slot], px, 4);
+                if (px[3] == previous[3])
+                {
+                    const signed char dr = (signed char)(px[0] - previous[0]), dg = (signed char)(px[1] - previous[1]),
+                                      db = (signed char)(px[2] - previous[2]);
+                    const signed char drg = (signed char)(dr - dg), dbg = (signed char)(db - dg);
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                        out.push_back((unsigned char)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7)
+                    {
+                        out.push_back((unsigned char)(0x80 | (dg + 32)));
+                        out.push_back((unsigned char)((drg + 8) << 4 | (dbg + 8)));
+                    }
+                    else
+                    {
+                        out.push_back(0xfe);
+                        out.insert(out.end(), px, px + 3);
+                    }
+                }
+                else
+                {
+                    out.push_back(0xff);
+                    out.insert(out.end(), px, px + 4);
+                }
+            }
+            std::memcpy(previous, px, 4);
+        }
+        const unsigned char padding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+        out.insert(out.end(), padding, padding + 8);
+        return writeFile(path, out.data(), out.size());
+    }
+
+#if defined(HAS_TINYEXR)
+    bool writeExr(const std::string &path, const unsigned char *bottomUp, int width, int height) const
+    {
+        // linear again: the tone map's display encoding is a 2.2 power
+        float decode[256];
+        for (int v = 0; v < 256; ++v)
+            decode[v] = std::pow(v / 255.0f, 2.2f);
+        const size_t pixels = (size_t)width * height;
+        std::vector<float> channels[3]; // B, G, R
+        for (int c = 0; c < 3; ++c)
+            channels[c].resize(pixels);
+        for (int y = 0; y < height; ++y)
+        {
+            const unsigned char *row = bottomUp + (size_t)(height - 1 - y) * width * 4;
+            for (int x = 0; x < width; ++x)
+                for (int c = 0; c < 3; ++c)
+                    channels[c][(size_t)y * width + x] = decode[row[x * 4 + 2 - c]];
+        }
+        unsigned char *planes[3] = {(unsigned char *)channels[0].data(), (unsigned char *)channels[1].data(), (unsigned char *)channels[2].data()};
+        return saveExr(path, planes, 3, TINYEXR_PIXELTYPE_FLOAT, width, height, exrCompression);
+    }
+#endif
+};
+
+#if defined(HAS_MINIZ)
+// A PNG written row by row for images too large to hold (PosterRenderer): rows arrive top down, are
+// filtered against the previous one and deflated into IDAT chunks as tdefl fills its output buffer, so
+// only two rows and the compressor's window are in memory. RGBA8, one thread.
+class PngStream
+{
+public:
+    PngStream() = default;
+    PngStream(const PngStream &) = delete;
+    PngStream &operator=(const PngStream &) = delete;
+
+    ~PngStream()
+    {
+        if (file)
+            std::fclose(file);
+        if (compressor)
+            tdefl_compressor_free(compressor);
+    }
+
+    bool open(const std::string &path, int imageWidth, int imageHeight, int level)
+    {
+        file = std::fopen(path.c_str(), "wb");
+        compressor = tdefl_compressor_alloc();
+        if (!file || !compressor)
+            return false;
+        width = imageWidth;
+        height = imageHeight;
+        pngLevel = level;
+        previous.assign((size_t)width * 4, 0);
+        filtered.resize((size_t)width * 4 + 1);
+        candidate.resize(filtered.size());
+        static const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+        ok = std::fwrite(signature, 1, 8, file) == 8;
+        std::vector<unsigned char> header;
+        ImageWriter::putBigEndian(header, (unsigned int)width);
+        ImageWriter::putBigEndian(header, (unsigned int)height);
+        const unsigned char format[5] = {8, 6, 0, 0, 0};
+        header.insert(header.end(), format, format + 5);
+        writeChunk("IHDR", header.data(), header.size());
+        // positive window bits: tdefl writes the zlib header and the Adler-32 itself
+        const mz_uint flags = tdefl_create_comp_flags_from_zip_params(pngLevel, MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+        tdefl_init(compressor, &PngStream::putIdat, this, (int)flags);
+        return ok;
+    }
+
+    // the next image row, `width` RGBA8 pixels
+    void writeRow(const unsigned char *row)
+    {
+        if (!ok || rows == height)
+            return;
+        ImageWriter::filterBest(row, rows ? previous.data() : NULL, width * 4, pngLevel, filtered.data(), candidate.data());
+        std::memcpy(previous.data(), row, previous.size());
+        ++rows;
+        if (tdefl_compress_buffer(compressor, filtered.data(), filtered.size(), rows == height ? TDEFL_FINISH : TDEFL_NO_FLUSH) < 0)
+            ok = false;
+    }
+
+    // after the last row: true if the whole file was written
+    bool close()
+    {
+        if (!file)
+            return false;
+        if (rows != height)
+            ok = false;
+        writeChunk("IEND", NULL, 0);
+        ok = std::fclose(file) == 0 && ok;
+        file = NULL;
+        return ok;
+    }
+
+private:
+    FILE *file = NULL;
+    tdefl_compressor *compressor = NULL;
+    int width = 0, height = 0, rows = 0;
+    int pngLevel = 6;
+    bool ok = false;
+    std::vector<unsigned char> previous, filtered, candidate;
+
+    void writeChunk(const char *type, const unsigned char *data, size_t bytes)
+    {
+        unsigned char length[4] = {(unsigned char)(bytes >> 24), (unsigned char)(bytes >> 16), (unsigned char)(bytes >> 8),
+                                   (unsigned char)bytes};
+        mz_ulong crc = mz_crc32(MZ_CRC32_INIT, (const unsigned char *)type, 4);
+        if (bytes)
+            crc = mz_crc32(crc, data, bytes);
+        const unsigned char crcBytes[4] = {(unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8),
+                                           (unsigned char)crc};
+        ok = ok && std::fwrite(length, 1, 4, file) == 4 && std::fwrite(type, 1, 4, file) == 4 &&
+             (!bytes || std::fwrite(data, 1, bytes, file) == bytes) && std::fwrite(crcBytes, 1, 4, file) == 4;
+    }
+
+    // tdefl's output buffer is full (or the stream ended): one IDAT chunk
+    static mz_bool putIdat(const void *buf, int len, void *user)
+    {
+        PngStream &stream = *static_cast<PngStream *>(user);
+        stream.writeChunk("IDAT", (const unsigned char *)buf, (size_t)len);
+        return stream.ok ? MZ_TRUE : MZ_FALSE;
+    }
+};
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef IMPOSTORS_H
+#define IMPOSTORS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <frame_data.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <mesh.h>
+#include <model.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Octahedral impostors for the far placements of a model drawn many times over (the parking lot): where a
+// copy covers fewer than IMPOSTOR_PIXELS (default 48) pixels of screen height, one instanced quad stands in
+// for all of its meshes.
+//   - bake() renders the model once, on the GL thread after it has loaded, from IMPOSTOR_FRAMES^2 (default
+//     8 x 8) directions over the upper hemisphere, laid out on a hemi-octahedral grid of IMPOSTOR_SIZE (default
+//     128) pixel tiles. model_loading.fs (IMPOSTOR_BAKE) writes the unlit albedo into one RGBA8 atlas and the
+//     normal, the orthographic depth and the paint's coverage into another.
+//   - draw() sends one camera-facing quad per placement over its bounding sphere. shaders/impostor.fs
+//     intersects the pixel's ray with the planes of the four frames around the view direction, blends their
+//     texels, repaints them in the placement's colour, lights the result like the meshes (sun, SH irradiance,
+//     a clear dielectric reflection) and writes the surface's own depth, so impostors intersect each other
+//     and the ground like meshes.
+//   - split() hands a placement over across the last quarter of that distance: both are drawn there, the mesh
+//     (model_loading.fs, impostorFade) and the impostor (impostor.fs) each keeping the pixels the other's
+//     dither leaves, so the switch is a crossfade rather than a pop.
+// IMPOSTORS=0 keeps meshes at every distance.
+class Impostors
+{
+public:
+    // texture units of the atlases during draw(): the material slots every mesh draw binds again
+    static const unsigned int UNIT_ALBEDO = 0;
+    static const unsigned int UNIT_NORMAL_DEPTH = 1;
+
+    // `shaderDir` holds impostor.vs/.fs and model_loading.vs/.fs
+    explicit Impostors(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("IMPOSTOR_PIXELS"))
+            pixels = std::max(4.0f, (float)std::atof(env));
+        if (const char *env = std::getenv("IMPOSTOR_FRAMES"))
+            frames = std::min(std::max(2, std::atoi(env)), 16);
+        if (const char *env = std::getenv("IMPOSTOR_SIZE"))
+            tileSize = std::min(std::max(32, std::atoi(env)), 512);
+    }
+
+    Impostors(const Impostors &) = delete;
+    Impostors &operator=(const Impostors &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("IMPOSTORS");
+        return !(env && std::string(env) == "0");
+    }
+
+    // GL thread: compiles the programs and sets up the quad's instance stream
+    void init()
+    {
+        bakeShader.reset(new Shader((shaderDir + "/model_loading.vs").c_str(), (shaderDir + "/model_loading.fs").c_str(),
+                                    "#define PROBE_CAPTURE 1\n#define IMPOSTOR_BAKE 1\n"));
+        drawShader.reset(new Shader((shaderDir + "/impostor.vs").c_str(), (shaderDir + "/impostor.fs").c_str()));
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &instanceVbo);
+        glState().bindVertexArray(vao);
+        // one Mesh::InstanceTransform per quad, at the locations model_loading.vs reads them from
+        Mesh::setupInstanceFormat(vao, instanceVbo, 0);
+        glState().bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        LOG_INFO("[Impostors] " << frames << "x" << frames << " frames of " << tileSize << " px below " << pixels << " px on screen");
+    }
+
+    bool ready() const { return bakeShader && drawShader; }
+
+    // GL thread, before the view's FrameData is bound (each frame binds its own): renders the atlases of
+    // `model` the first time it is asked for a loaded one (not its cooked proxy). True once `model` has them.
+    bool bake(Model &model)
+    {
+        if (!ready() || !model.ready() || model.isProxy())
+            return false;
+        if (atlases.count(&model))
+            return atlases[&model].albedo != 0;
+        Atlas &atlas = atlases[&model];
+        const int size = frames * tileSize;
+        atlas.center = (model.boundsMin + model.boundsMax) * 0.5f;
+        atlas.radius = std::max(glm::length(model.boundsMax - model.boundsMin) * 0.5f, 1e-4f);
+        atlas.albedo = createTexture(size, "impostor albedo");
+        atlas.normalDepth = createTexture(size, "impostor normal depth");
+        GLuint depth = 0;
+        glGenRenderbuffers(1, &depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+        GLint previousFbo = 0, viewport[4];
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, atlas.albedo, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, atlas.normalDepth, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+        const GLenum buffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+        glDrawBuffers(2, buffers);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        if (complete)
+        {
+            // no coverage, no paint; the centre plane, so filtered edges fade towards nothing
+            const GLfloat noAlbedo[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            const GLfloat noNormal[4] = {0.5f, 0.5f, 0.5f, 0.0f};
+            const GLfloat far = 1.0f;
+            glDepthMask(GL_TRUE);
+            glClearBufferfv(GL_COLOR, 0, noAlbedo);
+            glClearBufferfv(GL_COLOR, 1, noNormal);
+            glClearBufferfv(GL_DEPTH, 0, &far);
+            glEnable(GL_DEPTH_TEST);
+            glDepthFunc(GL_LESS);
+            glDisable(GL_BLEND);
+            model.prepareVariants(*bakeShader);
+            const float r = atlas.radius;
+            // orthographic across the bounding sphere, so the depth is linear over its diameter
+            const glm::mat4 projection = glm::ortho(-r, r, -r, r, r, 3.0f * r);
+            for (int y = 0; y < frames; ++y)
+                for (int x = 0; x < frames; ++x)
+                {
+                    const glm::vec3 direction = frameDirection(x, y);
+                    const glm::vec3 eye = atlas.center + direction * (2.0f * r);
+                    const glm::mat4 view = glm::lookAt(eye, atlas.center, frameUp(direction));
+                    if (x == 0 && y == 0)
+                        model.selectLods(projection * view, glm::mat4(1.0f), (float)tileSize);
+                    FrameData(projection, view, eye).bind();
+                    glViewport(x * tileSize, y * tileSize, tileSize, tileSize);
+                    bakeShader->use();
+                    model.Draw(*bakeShader, glm::mat4(1.0f), eye);
+                }
+            const GLuint textures[2] = {atlas.albedo, atlas.normalDepth};
+            for (int t = 0; t < 2; ++t)
+            {
+                glBindTexture(GL_TEXTURE_2D, textures[t]);
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &depth);
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Impostors] Atlas render target incomplete, " << model.directory << " keeps its meshes");
+            releaseAtlas(atlas);
+            return false;
+        }
+        LOG_INFO("[Impostors] Baked " << frames * frames << " views of " << model.directory << " into " << size << "x" << size << " atlases");
+        return true;
+    }
+
+    // placements of one model with their looks (Mesh::instanceVariation), as split() sorts them
+    struct Placements
+    {
+        std::vector<glm::mat4> matrices;
+        std::vector<glm::uvec3> variations;
+
+        void clear()
+        {
+            matrices.clear();
+            variations.clear();
+        }
+        void push_back(const glm::mat4 &m, const glm::uvec3 &variation)
+        {
+            matrices.push_back(m);
+            variations.push_back(variation);
+        }
+    };
+
+    // sorts `placements` of `model` (baked) seen from `viewPos` into the ones drawn as meshes and the ones
+    // drawn as impostors; `projectionScale` is projection[1][1], `viewportHeight` the view's height in
+    // pixels. Placements in the hand-over band are in both. `fade` receives the band's view distances for
+    // impostorFade (mesh side) and draw() (impostor side).
+    void split(const Model &model, const Placements &placements, const glm::vec3 &viewPos, float projectionScale,
+               float viewportHeight, Placements &meshes, Placements &impostors, glm::vec2 &fade) const
+    {
+        meshes.clear();
+        impostors.clear();
+        fade = glm::vec2(0.0f);
+        std::map<const Model *, Atlas>::const_iterator it = atlases.find(&model);
+        if (it == atlases.end() || !it->second.albedo)
+        {
+            meshes = placements;
+            return;
+        }
+        const Atlas &atlas = it->second;
+        // the same model everywhere, so the band is one pair of distances per unit of scale
+        const float farUnit = atlas.radius * projectionScale * viewportHeight / pixels;
+        const float nearUnit = farUnit * 0.75f;
+        for (size_t p = 0; p < placements.matrices.size(); ++p)
+        {
+            const glm::mat4 &m = placements.matrices[p];
+            const float scale = glm::length(glm::vec3(m[0]));
+            const float distance = glm::length(glm::vec3(m * glm::vec4(atlas.center, 1.0f)) - viewPos);
+            // the fade runs per pixel, so a placement straddling either end is in both lists
+            const float reach = atlas.radius * scale;
+            if (distance - reach < farUnit * scale)
+                meshes.push_back(m, placements.variations[p]);
+            if (distance + reach > nearUnit * scale)
+                impostors.push_back(m, placements.variations[p]);
+        }
+        if (!placements.matrices.empty())
+        {
+            const float scale = glm::length(glm::vec3(placements.matrices[0][0]));
+            fade = glm::vec2(nearUnit, farUnit) * scale;
+        }
+    }
+
+    // GL thread, in the opaque pass with the view's FrameData bound: the impostors of `model` at
+    // `placements`, in their paint, crossfading with the meshes over `fade` (see split())
+    void draw(const Model &model, const Placements &placements, const glm::vec2 &fade)
+    {
+        std::map<const Model *, Atlas>::const_iterator it = atlases.find(&model);
+        if (placements.matrices.empty() || it == atlases.end() || !it->second.albedo)
+            return;
+        const Atlas &atlas = it->second;
+        static const Shader::UniformHandle uCenter = Shader::uniformHandle("boundsCenter");
+        static const Shader::UniformHandle uRadius = Shader::uniformHandle("boundsRadius");
+        static const Shader::UniformHandle uFrames = Shader::uniformHandle("frames");
+        static const Shader::UniformHandle uFade = Shader::uniformHandle("impostorFade");
+        static const Shader::UniformHandle uAlbedo = Shader::uniformHandle("impostorAlbedo");
+        static const Shader::UniformHandle uNormalDepth = Shader::uniformHandle("impostorNormalDepth");
+        static std::vector<Mesh::InstanceTransform> instances;
+        instances.clear();
+        for (size_t p = 0; p < placements.matrices.size(); ++p)
+            instances.push_back(Mesh::instanceTransform(placements.matrices[p], placements.variations[p]));
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+        glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Mesh::InstanceTransform), &instances[0], GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        drawShader->use();
+        drawShader->setVec3(uCenter, atlas.center);
+        drawShader->setFloat(uRadius, atlas.radius);
+        drawShader->setInt(uFrames, frames);
+        drawShader->setVec2(uFade, fade);
+        drawShader->setInt(uAlbedo, (int)UNIT_ALBEDO);
+        drawShader->setInt(uNormalDepth, (int)UNIT_NORMAL_DEPTH);
+        glState().bindTexture(UNIT_ALBEDO, GL_TEXTURE_2D, atlas.albedo);
+        glState().bindTexture(UNIT_NORMAL_DEPTH, GL_TEXTURE_2D, atlas.normalDepth);
+        glState().bindVertexArray(vao);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)instances.size());
+        drawStats().count();
+    }
+
+    void releaseGpu()
+    {
+        for (std::map<const Model *, Atlas>::iterator it = atlases.begin(); it != atlases.end(); ++it)
+            releaseAtlas(it->second);
+        atlases.clear();
+        bakeShader.reset();
+        drawShader.reset();
+        if (instanceVbo) glDeleteBuffers(1, &instanceVbo);
+        if (vao) glDeleteVertexArrays(1, &vao);
+        instanceVbo = vao = 0;
+        glState().invalidate();
+    }
+
+private:
+    struct Atlas
+    {
+        GLuint albedo = 0;
+        GLuint normalDepth = 0;
+        // model-space bounding sphere the frames were captured around
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+    };
+
+    std::string shaderDir;
+    float pixels = 48.0f;
+    int frames = 8;
+    int tileSize = 128;
+    std::unique_ptr<Shader> bakeShader;
+    std::unique_ptr<Shader> drawShader;
+    GLuint vao = 0;
+    GLuint instanceVbo = 0;
+    // by model; an entry without textures is a model whose bake failed
+    std::map<const Model *, Atlas> atlases;
+
+    // the view direction (towards the camera) of frame (x, y): the grid point decoded from the hemi-octahedral
+    // square, corners and edges included, so the outer frames see the model from the horizon.
+    // impostor.vs/.fs have the same mapping.
+    glm::vec3 frameDirection(int x, int y) const
+    {
+        const glm::vec2 e = glm::vec2((float)x, (float)y) / (float)(frames - 1) * 2.0f - 1.0f;
+        glm::vec3 d(0.5f * (e.x + e.y), 0.0f, 0.5f * (e.x - e.y));
+        d.y = 1.0f - std::fabs(d.x) - std::fabs(d.z);
+        return glm::normalize(d);
+    }
+    static glm::vec3 frameUp(const glm::vec3 &direction)
+    {
+        return std::fabs(direction.y) > 0.999f ? glm::vec3(0.0f, 0.0f, -1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    GLuint createTexture(int size, const char *name)
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // stop while a tile is still 8 texels wide, before the mips blend neighbouring frames
+        int levels = 0;
+        while ((tileSize >> (levels + 1)) >= 8)
+            ++levels;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        gpuMemory().trackTexture(texture, GpuMemory::MODEL_TEXTURES, GL_RGBA8, size, size, 1, true, name);
+        return texture;
+    }
+
+    static void releaseAtlas(Atlas &atlas)
+    {
+        const GLuint textures[2] = {atlas.albedo, atlas.normalDepth};
+        for (int t = 0; t < 2; ++t)
+            if (textures[t])
+            {
+                gpuMemory().releaseTexture(textures[t]);
+                glDeleteTextures(1, &textures[t]);
+            }
+        atlas.albedo = atlas.normalDepth = 0;
+    }
+};
+
+#endif
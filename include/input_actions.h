@@ -0,0 +1,269 @@
+#ifndef INPUT_ACTIONS_H
+#define INPUT_ACTIONS_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Window input as actions, consumed once per input step. The GLFW callbacks only queue what happened (key
+// presses and releases, pointer motion, wheel steps, clicks); publishInput drains the queue once per step
+// through step(), which tells processInput which actions are held and which were pressed since the last
+// step, and how far the pointer and wheel moved. Nothing polls GLFW per key: key state follows the queued
+// events, so a tap shorter than a step still counts, and the pointer moves the camera in the same step that
+// publishes it rather than inside the callback. INPUT_BINDINGS=<action>:<key>,... rebinds, where <key> is a
+// letter, digit or punctuation key as typed ("n", "[") or a GLFW key code, and a binding replaces the
+// action's default keys (see actionName() for the names). The callbacks and step() all run on the main
+// thread, so the queue needs no lock.
+class InputActions
+{
+public:
+    enum Action
+    {
+        FLY_FORWARD, // W: camera forward, or orbit in
+        FLY_BACK,    // S
+        FLY_LEFT,    // A
+        FLY_RIGHT,   // D
+        NUDGE_FORWARD, // up arrow: the camera, or the models / the car in model mode
+        NUDGE_BACK,    // down arrow
+        NUDGE_LEFT,    // left arrow
+        NUDGE_RIGHT,   // right arrow
+        NUDGE_UP,      // PageUp
+        NUDGE_DOWN,    // PageDown
+        CONTROL_HELP,  // H
+        RESET_CAR,     // R
+        CONTROL_MODE,  // M: arrows on the camera or the models
+        PROFILE_REPORT, // P
+        CAR_LOCK,       // L
+        PERF_HUD,       // O
+        CAMERA_PRESET,  // C
+        TONE_CURVE,     // T
+        MODEL_VARIANT,  // V
+        MATERIAL_VARIANT, // N
+        PAINT,            // B
+        DEBUG_VIEW,       // G
+        CULL_FREEZE,      // F
+        SUN_WEST,         // [
+        SUN_EAST,         // ]
+        SUN_UP,           // '
+        SUN_DOWN,         // ;
+        SUN_BRIGHTER,     // =
+        SUN_DIMMER,       // -
+        PART_OPTION,      // K
+        ACTION_COUNT
+    };
+
+    // what one input step got
+    struct Step
+    {
+        bool held[ACTION_COUNT];
+        bool pressed[ACTION_COUNT]; // went down since the last step (once, however often)
+        float mouseX = 0.0f, mouseY = 0.0f; // pointer motion in pixels, y up
+        float wheel = 0.0f;
+        bool pick = false; // left click
+
+        Step()
+        {
+            std::memset(held, 0, sizeof(held));
+            std::memset(pressed, 0, sizeof(pressed));
+        }
+    };
+
+    InputActions()
+    {
+        std::memset(windowKeys, 0, sizeof(windowKeys));
+        std::memset(wasHeld, 0, sizeof(wasHeld));
+        const std::pair<int, Action> defaults[] = {
+            {GLFW_KEY_W, FLY_FORWARD},
+            {GLFW_KEY_S, FLY_BACK},
+            {GLFW_KEY_A, FLY_LEFT},
+            {GLFW_KEY_D, FLY_RIGHT},
+            {GLFW_KEY_UP, NUDGE_FORWARD},
+            {GLFW_KEY_DOWN, NUDGE_BACK},
+            {GLFW_KEY_LEFT, NUDGE_LEFT},
+            {GLFW_KEY_RIGHT, NUDGE_RIGHT},
+            {GLFW_KEY_PAGE_UP, NUDGE_UP},
+            {GLFW_KEY_PAGE_DOWN, NUDGE_DOWN},
+            {GLFW_KEY_H, CONTROL_HELP},
+            {GLFW_KEY_R, RESET_CAR},
+            {GLFW_KEY_M, CONTROL_MODE},
+            {GLFW_KEY_P, PROFILE_REPORT},
+            {GLFW_KEY_L, CAR_LOCK},
+            {GLFW_KEY_O, PERF_HUD},
+            {GLFW_KEY_C, CAMERA_PRESET},
+            {GLFW_KEY_T, TONE_CURVE},
+            {GLFW_KEY_V, MODEL_VARIANT},
+            {GLFW_KEY_N, MATERIAL_VARIANT},
+            {GLFW_KEY_B, PAINT},
+            {GLFW_KEY_G, DEBUG_VIEW},
+            {GLFW_KEY_F, CULL_FREEZE},
+            {GLFW_KEY_LEFT_BRACKET, SUN_WEST},
+            {GLFW_KEY_RIGHT_BRACKET, SUN_EAST},
+            {GLFW_KEY_APOSTROPHE, SUN_UP},
+            {GLFW_KEY_SEMICOLON, SUN_DOWN},
+            {GLFW_KEY_EQUAL, SUN_BRIGHTER},
+            {GLFW_KEY_MINUS, SUN_DIMMER},
+            {GLFW_KEY_K, PART_OPTION},
+        };
+        bindings.assign(defaults, defaults + sizeof(defaults) / sizeof(defaults[0]));
+        if (const char *env = std::getenv("INPUT_BINDINGS"))
+            rebind(env);
+    }
+
+    InputActions(const InputActions &) = delete;
+    InputActions &operator=(const InputActions &) = delete;
+
+    static const char *actionName(Action action)
+    {
+        static const char *names[ACTION_COUNT] = {
+            "forward", "back",     "left",       "right", "nudge_forward", "nudge_back",    "nudge_left", "nudge_right",
+            "nudge_up", "nudge_down", "help",    "reset", "mode",          "profile",       "lock",       "hud",
+            "preset",  "tone",     "variant",    "material", "paint",      "debug_view",    "cull_freeze", "sun_west",
+            "sun_east", "sun_up",  "sun_down",   "sun_brighter", "sun_dimmer", "part"};
+        return names[action];
+    }
+
+    // the callbacks: queue what happened (`action` is GLFW's; repeats change nothing)
+    void key(int key, int action)
+    {
+        if (action != GLFW_REPEAT && key >= 0 && key <= GLFW_KEY_LAST)
+            queue.push_back(Queued(Queued::KEY, key, action == GLFW_PRESS));
+    }
+    void pointer(float xoffset, float yoffset)
+    {
+        Queued q(Queued::POINTER);
+        q.x = xoffset;
+        q.y = yoffset;
+        queue.push_back(q);
+    }
+    void wheel(float steps)
+    {
+        Queued q(Queued::WHEEL);
+        q.x = steps;
+        queue.push_back(q);
+    }
+    void click() { queue.push_back(Queued(Queued::CLICK)); }
+
+    // main thread, once per input step: drains the queue into the step's actions. `keyState(key, down)`
+    // turns a bound key's window state into the step's (adding a stream viewer's keys, or recording or
+    // replaying them); an action is pressed when one of its keys went down in the window since the last step
+    // or its held state came on.
+    template <class KeyState>
+    const Step &step(KeyState keyState)
+    {
+        current = Step();
+        bool queuedPress[ACTION_COUNT];
+        std::memset(queuedPress, 0, sizeof(queuedPress));
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            const Queued &q = queue[i];
+            if (q.kind == Queued::KEY)
+            {
+                windowKeys[q.key] = q.down;
+                if (q.down)
+                    for (size_t b = 0; b < bindings.size(); ++b)
+                        if (bindings[b].first == q.key)
+                            queuedPress[bindings[b].second] = true;
+            }
+            else if (q.kind == Queued::POINTER)
+            {
+                current.mouseX += q.x;
+                current.mouseY += q.y;
+            }
+            else if (q.kind == Queued::WHEEL)
+                current.wheel += q.x;
+            else
+                current.pick = true;
+        }
+        queue.clear();
+        for (size_t b = 0; b < bindings.size(); ++b)
+            if (keyState(bindings[b].first, windowKeys[bindings[b].first]))
+                current.held[bindings[b].second] = true;
+        for (int a = 0; a < ACTION_COUNT; ++a)
+        {
+            current.pressed[a] = queuedPress[a] || (current.held[a] && !wasHeld[a]);
+            wasHeld[a] = current.held[a];
+        }
+        return current;
+    }
+
+private:
+    struct Queued
+    {
+        enum Kind
+        {
+            KEY,
+            POINTER,
+            WHEEL,
+            CLICK
+        } kind;
+        int key = 0;
+        bool down = false;
+        float x = 0.0f, y = 0.0f;
+
+        explicit Queued(Kind kind, int key = 0, bool down = false)
+            : kind(kind), key(key), down(down)
+        {
+        }
+    };
+
+    std::vector<std::pair<int, Action>> bindings; // GLFW key, action; an action may have several keys
+    std::vector<Queued> queue;
+    bool windowKeys[GLFW_KEY_LAST + 1];
+    bool wasHeld[ACTION_COUNT];
+    Step current;
+
+    // "<action>:<key>,...": the actions named get only the keys given
+    void rebind(const std::string &spec)
+    {
+        std::vector<std::pair<int, Action>> given;
+        std::istringstream entries(spec);
+        std::string entry;
+        while (std::getline(entries, entry, ','))
+        {
+            const size_t colon = entry.rfind(':');
+            int a = 0;
+            while (colon != std::string::npos && a < ACTION_COUNT && entry.compare(0, colon, actionName((Action)a)) != 0)
+                ++a;
+            const int key = colon == std::string::npos ? -1 : parseKey(entry.substr(colon + 1));
+            if (a == ACTION_COUNT || key < 0)
+            {
+                LOG_WARN("[Input] Ignoring binding '" << entry << "' (want <action>:<key>)");
+                continue;
+            }
+            given.push_back(std::make_pair(key, (Action)a));
+        }
+        for (size_t g = 0; g < given.size(); ++g)
+            for (size_t b = 0; b < bindings.size();)
+                if (bindings[b].second == given[g].second)
+                    bindings.erase(bindings.begin() + b);
+                else
+                    ++b;
+        bindings.insert(bindings.end(), given.begin(), given.end());
+        for (size_t g = 0; g < given.size(); ++g)
+            LOG_INFO("[Input] " << actionName(given[g].second) << " on key " << given[g].first);
+    }
+
+    // a printable key as typed (GLFW's codes for those are their ASCII, letters upper case) or a key code
+    static int parseKey(const std::string &text)
+    {
+        if (text.size() == 1)
+        {
+            const char c = text[0];
+            return c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+        }
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+            return -1;
+        const int key = std::atoi(text.c_str());
+        return key <= GLFW_KEY_LAST ? key : -1;
+    }
+};
+
+#endif
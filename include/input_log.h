@@ -0,0 +1,308 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <camera.h>
+#include <engine_clock.h>
+#include <frame_trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// A session's input, recorded to play back as a reproducible performance run. INPUT_RECORD=<file> writes
+// the pointer motion, wheel steps, picks and key presses/releases with their time since the scene became
+// ready, and the camera and car offset at that moment. INPUT_REPLAY=<file> ignores the live input, puts
+// the camera back where the recording started once the scene is ready, and then steps a fixed
+// 1 / INPUT_REPLAY_FPS seconds (default 60) per input step, feeding each event in at the step its time falls
+// in. The animation clock follows the same simulated time, so every replay of a file renders the same
+// frames whatever the machine's speed, and a hitch from the recorded session can be reproduced. Replays
+// run with vsync off, without the idle renderer or a render thread, and end after the recording's last
+// moment with a log of the frame times and the worst frames (hitches). Key state is recorded where the
+// input step reads it (InputActions), so a key counts as held for whole steps; ORBIT_CAMERA's orbit and
+// dropped environments aren't recorded.
+class InputLog
+{
+public:
+    enum Kind
+    {
+        MOVE,
+        SCROLL,
+        PICK,
+        KEY
+    };
+
+    struct Event
+    {
+        double time = 0.0;
+        Kind kind = MOVE;
+        float x = 0.0f, y = 0.0f; // pointer offset; wheel steps in x
+        int key = 0;
+        bool down = false;
+    };
+
+    InputLog()
+    {
+        if (const char *env = std::getenv("INPUT_REPLAY"))
+            if (*env)
+                load(env);
+        if (const char *env = std::getenv("INPUT_RECORD"))
+            if (*env && !replay)
+            {
+                out.open(env);
+                if (out)
+                {
+                    record = true;
+                    out.precision(9);
+                    out << "car-input 1\n";
+                    recordPath = env;
+                }
+                else
+                    LOG_ERROR("[InputLog] Cannot write '" << env << "'");
+            }
+        if (const char *env = std::getenv("INPUT_REPLAY_FPS"))
+            stepSeconds = 1.0 / std::max(1.0, std::atof(env));
+    }
+
+    ~InputLog()
+    {
+        if (record && started)
+            out << (EngineClock::seconds() - startTime) << " end\n";
+    }
+
+    InputLog(const InputLog &) = delete;
+    InputLog &operator=(const InputLog &) = delete;
+
+    bool recording() const { return record; }
+    bool replaying() const { return replay; }
+    // the replay is done: leave the render loop
+    bool finished() const { return done.load(); }
+    // replay: the simulated time of the current step (0 until the scene is ready)
+    double time() const { return simulated.load(); }
+
+    // render loop, first thing every frame: `sceneReady` once nothing is loading or baking any more; a replay
+    // times its frames from the step it starts at
+    void beginFrame(bool sceneReady)
+    {
+        ready.store(sceneReady);
+        if (!replay || !started.load() || done.load())
+            return;
+        const double now = FrameTrace::clockUs() * 1e-3;
+        if (frameStart > 0.0)
+        {
+            frameMs.push_back(now - frameStart);
+            frameTimes.push_back(lastFrameTime);
+        }
+        frameStart = now;
+        lastFrameTime = simulated.load();
+        if (next >= events.size() && lastFrameTime >= endTime)
+        {
+            report();
+            done.store(true);
+        }
+    }
+
+    // main thread, once per input step before the keys are polled. Starts the recording or the replay on the
+    // first step the scene is ready (writing or restoring `camera` and `carOffset`); a replay then applies the
+    // events due by the next fixed step through `apply(event)` (pointer, wheel and picks; keys are kept here
+    // for keyDown()). Returns the step's time: `wallDelta` live, the fixed step replaying (0 before it starts).
+    template <class Apply>
+    float step(float wallDelta, Camera &camera, glm::vec3 &carOffset, Apply apply)
+    {
+        if (!record && !replay)
+            return wallDelta;
+        if (!started.load())
+        {
+            if (!ready.load())
+                return replay ? 0.0f : wallDelta;
+            start(camera, carOffset);
+            if (record)
+                return wallDelta;
+        }
+        if (record)
+            return wallDelta;
+        const double now = simulated.load() + stepSeconds;
+        simulated.store(now);
+        for (; next < events.size() && events[next].time <= now; ++next)
+        {
+            const Event &e = events[next];
+            if (e.kind == KEY)
+                keys[e.key] = e.down;
+            else
+                apply(e);
+        }
+        return (float)stepSeconds;
+    }
+
+    // the state of `key`: recorded as it changes, or the replay's (`live` is ignored then)
+    bool keyDown(int key, bool live)
+    {
+        if (replay)
+        {
+            std::map<int, bool>::const_iterator it = keys.find(key);
+            return it != keys.end() && it->second;
+        }
+        if (record && started.load())
+        {
+            bool &was = keys[key];
+            if (was != live)
+                out << stamp() << " key " << key << " " << (live ? 1 : 0) << "\n";
+            was = live;
+        }
+        return live;
+    }
+
+    // main thread, as the live input arrives
+    void recordMove(float xoffset, float yoffset)
+    {
+        if (record && started.load())
+            out << stamp() << " move " << xoffset << " " << yoffset << "\n";
+    }
+    void recordScroll(float steps)
+    {
+        if (record && started.load())
+            out << stamp() << " scroll " << steps << "\n";
+    }
+    void recordPick()
+    {
+        if (record && started.load())
+            out << stamp() << " pick\n";
+    }
+
+private:
+    bool record = false;
+    bool replay = false;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> started{false};
+    std::atomic<bool> done{false};
+    std::atomic<double> simulated{0.0};
+    double stepSeconds = 1.0 / 60.0;
+    double startTime = 0.0;
+    std::ofstream out;
+    std::string recordPath, replayPath;
+    std::map<int, bool> keys;
+
+    // replay
+    std::vector<Event> events;
+    size_t next = 0;
+    double endTime = 0.0;
+    bool hasStartPose = false;
+    glm::vec3 startPosition = glm::vec3(0.0f), startCar = glm::vec3(0.0f);
+    float startYaw = 0.0f, startPitch = 0.0f, startZoom = 45.0f;
+    std::vector<double> frameMs;
+    std::vector<double> frameTimes; // simulated time of each frame in frameMs
+    double frameStart = 0.0;
+    double lastFrameTime = 0.0;
+
+    double stamp() const { return EngineClock::seconds() - startTime; }
+
+    void start(Camera &camera, glm::vec3 &carOffset)
+    {
+        started.store(true);
+        startTime = EngineClock::seconds();
+        keys.clear();
+        if (record)
+        {
+            out << "start " << camera.Position.x << " " << camera.Position.y << " " << camera.Position.z << " " << camera.Yaw << " "
+                << camera.Pitch << " " << camera.Zoom << " " << carOffset.x << " " << carOffset.y << " " << carOffset.z << "\n";
+            LOG_INFO("[InputLog] Scene ready, recording input to " << recordPath);
+            return;
+        }
+        if (hasStartPose)
+        {
+            camera.Position = startPosition;
+            camera.Yaw = startYaw;
+            camera.Pitch = startPitch;
+            camera.Zoom = startZoom;
+            camera.ProcessMouseMovement(0.0f, 0.0f);
+            carOffset = startCar;
+        }
+        LOG_INFO("[InputLog] Scene ready, replaying " << events.size() << " events over " << endTime << " s from " << replayPath
+                                                      << " in steps of " << stepSeconds * 1000.0 << " ms");
+    }
+
+    void load(const std::string &path)
+    {
+        std::ifstream in(path.c_str());
+        std::string line;
+        if (!in || !std::getline(in, line) || line.compare(0, 11, "car-input 1") != 0)
+        {
+            LOG_ERROR("[InputLog] '" << path << "' isn't an INPUT_RECORD file, replay off");
+            return;
+        }
+        while (std::getline(in, line))
+        {
+            std::istringstream fields(line);
+            std::string first;
+            fields >> first;
+            if (first == "start")
+            {
+                fields >> startPosition.x >> startPosition.y >> startPosition.z >> startYaw >> startPitch >> startZoom >> startCar.x >>
+                    startCar.y >> startCar.z;
+                hasStartPose = !fields.fail();
+                continue;
+            }
+            Event e;
+            e.time = std::atof(first.c_str());
+            std::string kind;
+            fields >> kind;
+            endTime = std::max(endTime, e.time);
+            if (kind == "move")
+                fields >> e.x >> e.y;
+            else if (kind == "scroll")
+            {
+                e.kind = SCROLL;
+                fields >> e.x;
+            }
+            else if (kind == "pick")
+                e.kind = PICK;
+            else if (kind == "key")
+            {
+                int down = 0;
+                e.kind = KEY;
+                fields >> e.key >> down;
+                e.down = down != 0;
+            }
+            else
+                continue;
+            if (!fields.fail())
+                events.push_back(e);
+        }
+        std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.time < b.time; });
+        replay = true;
+        replayPath = path;
+    }
+
+    void report() const
+    {
+        if (frameMs.empty())
+            return;
+        std::vector<double> sorted(frameMs);
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+            sum += sorted[i];
+        LOG_INFO("[InputLog] Replay done: " << frameMs.size() << " frames, CPU frame ms avg " << sum / sorted.size() << ", p50 "
+                                            << sorted[sorted.size() / 2] << ", p99 "
+                                            << sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)] << ", max "
+                                            << sorted.back());
+        // the worst frames, by the simulated time they show, so a hitch can be found again
+        std::vector<size_t> order(frameMs.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        const size_t worst = std::min<size_t>(5, order.size());
+        std::partial_sort(order.begin(), order.begin() + worst, order.end(),
+                          [this](size_t a, size_t b) { return frameMs[a] > frameMs[b]; });
+        for (size_t i = 0; i < worst; ++i)
+            LOG_INFO("[InputLog]   frame " << order[i] << " at " << frameTimes[order[i]] << " s: " << frameMs[order[i]] << " ms");
+    }
+};
+
+#endif
@@ -0,0 +1,353 @@
+#ifndef IRRADIANCE_VOLUME_H
+#define IRRADIANCE_VOLUME_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <ibl_baker.h>
+#include <reflection_probes.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// IRRADIANCE_VOLUME=1: local diffuse light from a grid of light probes around each placed model, so a
+// cabin is lit by its windows rather than the whole sky, and the side of a car facing another picks up its
+// colour. The grid spans the model's bounds grown by a margin, in model space, IRRADIANCE_GRID cells
+// (default 8x4x8). Every cell is captured like a reflection probe (a CAPTURE_SIZE cube drawn with the probe
+// program and ReflectionProbes::DrawScene, the model itself included) and shaders/irradiance_project.fs
+// reduces the cube to one texel of two RGBA16F 3D textures:
+//   volume0: rgb = L1 band 0 of the captured geometry's light (irradiance / PI), w = share of the sky seen
+//   volume1: xyz = the band 1 direction of its luminance over band 0's, shared by the three channels
+// model_loading.fs fetches both trilinearly and lights with a * max(1 + dot(b, N), 0) plus the seen share
+// of the live environment's irradiance, fading to the plain environment at the grid's border.
+//
+// update() captures cells for as long as the CPU time spent fits the budget, at least one per call, round
+// robin over the volumes still baking. A volume is sampled once all of its cells are in and then follows its
+// model rigidly; it is baked again where its model has come to rest (SETTLE_FRAMES frames without moving),
+// the previous bake lit until the new one replaces it cell by cell.
+class IrradianceVolume
+{
+public:
+    static const int MAX_VOLUMES = 4;          // slots along the textures' depth; model_loading.fs MAX_VOLUMES
+    static const unsigned int UNIT_L0 = 19;    // volume0 and volume1 in the scene shaders (Shader::samplerUnit)
+    static const unsigned int UNIT_L1 = 30;
+    static const unsigned int CAPTURE_UNIT = 0;  // the cell's cube while it is projected (a Mesh unit)
+    static const unsigned int CAPTURE_SIZE = 16;
+    static const int SETTLE_FRAMES = 30;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle) and irradiance_project.fs
+    explicit IrradianceVolume(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("IRRADIANCE_GRID"))
+        {
+            int x = 0, y = 0, z = 0;
+            if (std::sscanf(env, "%dx%dx%d", &x, &y, &z) == 3)
+                grid = glm::clamp(glm::ivec3(x, y, z), glm::ivec3(2), glm::ivec3(32));
+        }
+    }
+
+    IrradianceVolume(const IrradianceVolume &) = delete;
+    IrradianceVolume &operator=(const IrradianceVolume &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("IRRADIANCE_VOLUME");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the projection and creates the volume textures and capture targets
+    void init()
+    {
+        projectShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/irradiance_project.fs").c_str()));
+        projectShader->use();
+        projectShader->setInt("capture", (int)CAPTURE_UNIT);
+        projectShader->setInt("captureSize", (int)CAPTURE_SIZE);
+        glGenVertexArrays(1, &emptyVao);
+
+        const int depth = grid.z * MAX_VOLUMES;
+        for (int i = 0; i < 2; ++i)
+        {
+            glGenTextures(1, &volumeTextures[i]);
+            glState().bindTexture(i == 0 ? UNIT_L0 : UNIT_L1, GL_TEXTURE_3D, volumeTextures[i]);
+            glTexImage3D(GL_TEXTURE_3D, 0, GL_RGBA16F, grid.x, grid.y, depth, 0, GL_RGBA, GL_FLOAT, nullptr);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            gpuMemory().trackTexture(volumeTextures[i], GpuMemory::ENVIRONMENT, GL_RGBA16F, grid.x, grid.y, depth, false, "irradiance volume");
+        }
+
+        glGenTextures(1, &captureCube);
+        glState().bindTexture(CAPTURE_UNIT, GL_TEXTURE_CUBE_MAP, captureCube);
+        for (unsigned int face = 0; face < 6; ++face)
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA16F, CAPTURE_SIZE, CAPTURE_SIZE, 0, GL_RGBA, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        gpuMemory().trackTexture(captureCube, GpuMemory::ENVIRONMENT, GL_RGBA16F, CAPTURE_SIZE, CAPTURE_SIZE, 6, false, "irradiance volume capture");
+
+        glGenFramebuffers(1, &captureFBO);
+        glGenRenderbuffers(1, &depthRBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, CAPTURE_SIZE, CAPTURE_SIZE);
+        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+
+        glGenFramebuffers(1, &projectFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, projectFBO);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, volumeTextures[0], 0, 0);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, volumeTextures[1], 0, 0);
+        const GLenum buffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+        glDrawBuffers(2, buffers);
+        usable = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        if (!usable)
+        {
+            LOG_WARN("[IrradianceVolume] Volume target incomplete, diffuse light stays the environment's");
+            return;
+        }
+        LOG_INFO("[IrradianceVolume] " << grid.x << "x" << grid.y << "x" << grid.z << " cells per model, up to " << MAX_VOLUMES << " models");
+    }
+
+    bool ready() const { return usable && projectShader; }
+
+    // the model placed `i`th now has world matrix `modelMatrix` and model-space bounds [boundsMin, boundsMax];
+    // called every frame for each placement (placements past MAX_VOLUMES get none). A `standIn` (a cooked
+    // proxy) is baked like any model and baked again once the full model replaces it.
+    void place(size_t i, const glm::mat4 &modelMatrix, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, bool standIn = false)
+    {
+        if (i >= (size_t)MAX_VOLUMES || i > volumes.size())
+            return;
+        if (i == volumes.size())
+            volumes.push_back(Volume());
+        Volume &v = volumes[i];
+        const glm::vec3 size = boundsMax - boundsMin;
+        const glm::vec3 margin(0.15f * std::max(size.x, std::max(size.y, size.z)));
+        v.matrix = modelMatrix;
+        if (v.boxMin != boundsMin - margin || v.boxMax != boundsMax + margin)
+        {
+            // another model (or a variant) in this slot: nothing of the last bake applies
+            v.boxMin = boundsMin - margin;
+            v.boxMax = boundsMax + margin;
+            v.ready = false;
+            start(v);
+        }
+        else if (standIn != v.standIn)
+            start(v);
+        v.standIn = standIn;
+        if (modelMatrix != v.lastMatrix)
+            v.stillFrames = 0;
+        else if (v.stillFrames <= SETTLE_FRAMES)
+            ++v.stillFrames;
+        v.lastMatrix = modelMatrix;
+        if (v.stillFrames == SETTLE_FRAMES && modelMatrix != v.bakingMatrix)
+            start(v);
+    }
+
+    // drops the volumes of placements past `count`
+    void trim(size_t count)
+    {
+        if (count < volumes.size())
+            volumes.resize(count);
+    }
+
+    // GL thread, before the main pass: captures and projects cells within `budgetMs` of CPU time, at least one
+    // per call. Leaves the scene framebuffer bound; the caller restores its viewport.
+    void update(const ReflectionProbes::DrawScene &drawScene, double budgetMs, float nearPlane, float farPlane)
+    {
+        if (!ready() || volumes.empty())
+            return;
+        if (nextVolume >= volumes.size())
+            nextVolume = 0;
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+        for (size_t n = 0; n < volumes.size();)
+        {
+            Volume &v = volumes[nextVolume];
+            if (!v.baking)
+            {
+                nextVolume = (nextVolume + 1) % volumes.size();
+                ++n;
+                continue;
+            }
+            captureCell(v, drawScene, nearPlane, farPlane);
+            if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count() > budgetMs)
+                break;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+    }
+
+    // sets the volume uniforms of `shader` (in use) and binds the volume textures
+    void apply(const Shader &shader) const
+    {
+        static const Shader::UniformHandle uVolumeCount = Shader::uniformHandle("volumeCount");
+        static const Shader::UniformHandle uVolumeGrid = Shader::uniformHandle("volumeGrid");
+        static Shader::UniformHandle uVolumeFromWorld[MAX_VOLUMES], uVolumeRotation[MAX_VOLUMES], uVolumeSlot[MAX_VOLUMES];
+        static bool interned = false;
+        if (!interned)
+        {
+            for (int i = 0; i < MAX_VOLUMES; ++i)
+            {
+                const std::string index = std::to_string(i);
+                uVolumeFromWorld[i] = Shader::uniformHandle("volumeFromWorld[" + index + "]");
+                uVolumeRotation[i] = Shader::uniformHandle("volumeRotation[" + index + "]");
+                uVolumeSlot[i] = Shader::uniformHandle("volumeSlot[" + index + "]");
+            }
+            interned = true;
+        }
+        int used = 0;
+        for (size_t i = 0; ready() && i < volumes.size(); ++i)
+        {
+            const Volume &v = volumes[i];
+            if (!v.ready)
+                continue;
+            // world to grid coordinates (cell centres at +0.5) of the box as the model is placed now
+            const glm::mat4 fromWorld = glm::scale(glm::mat4(1.0f), glm::vec3(grid) / (v.boxMax - v.boxMin)) *
+                                        glm::translate(glm::mat4(1.0f), -v.boxMin) * glm::inverse(v.matrix);
+            shader.setMat4(uVolumeFromWorld[used], fromWorld);
+            shader.setMat3(uVolumeRotation[used], rotationToModel(v.matrix));
+            shader.setInt(uVolumeSlot[used], (int)i);
+            ++used;
+        }
+        shader.setInt(uVolumeCount, used);
+        shader.setVec3(uVolumeGrid, glm::vec3(grid));
+        if (used > 0)
+        {
+            glState().bindTexture(UNIT_L0, GL_TEXTURE_3D, volumeTextures[0]);
+            glState().bindTexture(UNIT_L1, GL_TEXTURE_3D, volumeTextures[1]);
+        }
+    }
+
+    // GL thread: deletes the volumes, the capture cube and the targets
+    void releaseGpu()
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            if (volumeTextures[i])
+            {
+                gpuMemory().releaseTexture(volumeTextures[i]);
+                glDeleteTextures(1, &volumeTextures[i]);
+            }
+            volumeTextures[i] = 0;
+        }
+        if (captureCube)
+        {
+            gpuMemory().releaseTexture(captureCube);
+            glDeleteTextures(1, &captureCube);
+        }
+        captureCube = 0;
+        if (captureFBO)
+        {
+            glDeleteFramebuffers(1, &captureFBO);
+            glDeleteRenderbuffers(1, &depthRBO);
+            glDeleteFramebuffers(1, &projectFBO);
+        }
+        captureFBO = depthRBO = projectFBO = 0;
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        projectShader.reset();
+        volumes.clear();
+        usable = false;
+        glState().invalidate();
+    }
+
+private:
+    struct Volume
+    {
+        glm::vec3 boxMin = glm::vec3(0.0f), boxMax = glm::vec3(0.0f); // grid box, model space
+        glm::mat4 matrix = glm::mat4(1.0f);        // placement now
+        glm::mat4 lastMatrix = glm::mat4(1.0f);
+        int stillFrames = 0;
+        bool standIn = false;
+        glm::mat4 bakingMatrix = glm::mat4(1.0f);  // placement the cells are being (or were last) captured at
+        int nextCell = 0;
+        bool baking = false;
+        bool ready = false; // every cell captured at least once
+        std::chrono::steady_clock::time_point bakeStart;
+    };
+
+    std::string shaderDir;
+    glm::ivec3 grid = glm::ivec3(8, 4, 8);
+    std::unique_ptr<Shader> projectShader;
+    GLuint volumeTextures[2] = {0, 0};
+    GLuint captureCube = 0, captureFBO = 0, depthRBO = 0, projectFBO = 0, emptyVao = 0;
+    bool usable = false;
+    std::vector<Volume> volumes;
+    size_t nextVolume = 0;
+
+    void start(Volume &v)
+    {
+        v.bakingMatrix = v.matrix;
+        v.nextCell = 0;
+        v.baking = true;
+        v.bakeStart = std::chrono::steady_clock::now();
+    }
+
+    // world to model space for directions, scale left out (placements are rigid with uniform scale)
+    static glm::mat3 rotationToModel(const glm::mat4 &modelMatrix)
+    {
+        const glm::mat3 m(modelMatrix);
+        return glm::transpose(glm::mat3(glm::normalize(m[0]), glm::normalize(m[1]), glm::normalize(m[2])));
+    }
+
+    // captures the next cell of `v` from its centre and projects it into the cell's texels
+    void captureCell(Volume &v, const ReflectionProbes::DrawScene &drawScene, float nearPlane, float farPlane)
+    {
+        const int x = v.nextCell % grid.x, y = (v.nextCell / grid.x) % grid.y, z = v.nextCell / (grid.x * grid.y);
+        const glm::vec3 local = v.boxMin + (glm::vec3(x, y, z) + 0.5f) / glm::vec3(grid) * (v.boxMax - v.boxMin);
+        const glm::vec3 eye = glm::vec3(v.bakingMatrix * glm::vec4(local, 1.0f));
+
+        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+        glViewport(0, 0, CAPTURE_SIZE, CAPTURE_SIZE);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        // premultiplied capture as in ReflectionProbes; the owner is drawn too, it's what lights its cabin
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        for (unsigned int face = 0; face < 6; ++face)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, captureCube, 0);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            drawScene(IBLBaker::captureProjection(nearPlane, farPlane), IBLBaker::captureView(face, eye), eye, -1);
+        }
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        const int slot = (int)(&v - &volumes[0]);
+        glBindFramebuffer(GL_FRAMEBUFFER, projectFBO);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, volumeTextures[0], 0, slot * grid.z + z);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, volumeTextures[1], 0, slot * grid.z + z);
+        glViewport(x, y, 1, 1);
+        glDisable(GL_DEPTH_TEST);
+        projectShader->use();
+        projectShader->setMat3("volumeRotation", rotationToModel(v.bakingMatrix));
+        glState().bindTexture(CAPTURE_UNIT, GL_TEXTURE_CUBE_MAP, captureCube);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glEnable(GL_DEPTH_TEST);
+
+        if (++v.nextCell == grid.x * grid.y * grid.z)
+        {
+            v.baking = false;
+            if (!v.ready)
+                LOG_INFO("[IrradianceVolume] Model " << slot << " baked in "
+                         << std::chrono::duration<double>(std::chrono::steady_clock::now() - v.bakeStart).count() << " s");
+            v.ready = true;
+            nextVolume = (nextVolume + 1) % volumes.size();
+        }
+    }
+};
+
+#endif
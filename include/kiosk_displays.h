@@ -0,0 +1,300 @@
+#ifndef KIOSK_DISPLAYS_H
+#define KIOSK_DISPLAYS_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <camera.h>
+#include <frame_trace.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <thread_pool.h>
+#include <tone_mapper.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// KIOSK_DISPLAYS=N (or "all"): drives N more monitors from this process, for showroom kiosks, instead of a
+// process per display with its own copy of every model and texture. Each display gets a borderless window
+// covering its monitor (the monitors after the primary, in GLFW's order) whose context shares the main
+// one's objects: buffers, textures, programs and IBL maps exist once. Only framebuffers and vertex arrays
+// aren't shared between contexts, so the views are drawn in the main context like the other views (per
+// frame: every display's frustum culled against the scene tree side by side on the ThreadPool, then the
+// visible models drawn through the caller's DrawView into the display's own HDR target and tone mapped
+// into an RGBA8 texture at the display's resolution). present() then fences that work, and in each
+// display's context waits for the fence on the GPU and blits the texture to the window; swap() swaps them
+// right after the main window, so every display shows the same frame, paced by the main window's vsync
+// (the displays swap with interval 0). Display i looks KIOSK_YAW degrees further round than the main
+// camera, alternating right and left (1 right, 2 left, 3 twice right...); the default is the main view's
+// horizontal field of view, so three displays in a row continue one panorama. Input goes to the main
+// window; closing any display closes the viewer.
+class KioskDisplays
+{
+public:
+    struct View
+    {
+        glm::vec3 eye;
+        glm::mat4 view, projection;
+        // visible[i] for placed model i
+        std::vector<unsigned char> visible;
+    };
+
+    // draws the models visible in `view` with its camera; its target is bound, cleared, with the viewport set
+    typedef std::function<void(const View &view)> DrawView;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("KIOSK_DISPLAYS");
+        return env && *env && std::strcmp(env, "0") != 0;
+    }
+
+    KioskDisplays() {}
+    KioskDisplays(const KioskDisplays &) = delete;
+    KioskDisplays &operator=(const KioskDisplays &) = delete;
+
+    // main thread, with `mainWindow`'s context current: opens the displays' windows; false if there's no
+    // other monitor to put one on
+    bool init(GLFWwindow *mainWindow)
+    {
+        this->mainWindow = mainWindow;
+        const char *env = std::getenv("KIOSK_DISPLAYS");
+        int monitorCount = 0;
+        GLFWmonitor **monitors = glfwGetMonitors(&monitorCount);
+        const int wanted = std::strcmp(env, "all") == 0 ? monitorCount - 1 : std::atoi(env);
+        if (const char *yaw = std::getenv("KIOSK_YAW"))
+        {
+            yawStep = (float)std::atof(yaw);
+            yawSet = true;
+        }
+        glfwWindowHint(GLFW_DECORATED, GLFW_FALSE);
+        for (int m = 1; m < monitorCount && (int)displays.size() < wanted; ++m)
+        {
+            const GLFWvidmode *mode = glfwGetVideoMode(monitors[m]);
+            if (!mode)
+                continue;
+            Display d;
+            d.window = glfwCreateWindow(mode->width, mode->height, "Car Game", NULL, mainWindow);
+            if (!d.window)
+            {
+                LOG_WARN("[Kiosk] Can't open a window sharing the main context on monitor " << m);
+                continue;
+            }
+            int x = 0, y = 0;
+            glfwGetMonitorPos(monitors[m], &x, &y);
+            glfwSetWindowPos(d.window, x, y);
+            // the main window's vsync paces all of them
+            glfwMakeContextCurrent(d.window);
+            glfwSwapInterval(0);
+            glGenFramebuffers(1, &d.presentFbo);
+            displays.push_back(d);
+            LOG_INFO("[Kiosk] Display " << displays.size() << ": '" << glfwGetMonitorName(monitors[m]) << "', " << mode->width << "x"
+                                        << mode->height);
+        }
+        glfwWindowHint(GLFW_DECORATED, GLFW_TRUE);
+        glfwMakeContextCurrent(mainWindow);
+        if (displays.size() < (size_t)std::max(0, wanted))
+            LOG_WARN("[Kiosk] " << wanted << " displays wanted, " << displays.size() << " other monitors usable");
+        return !displays.empty();
+    }
+
+    bool ready() const { return !displays.empty(); }
+
+    // GL thread, after the main view: culls and draws every display's view from `camera`, whose window is
+    // `mainWidth` x `mainHeight`. The scene framebuffer is bound again afterwards, the viewport is not restored.
+    void render(const Camera &camera, const BVH &sceneTree, float farPlane, int mainWidth, int mainHeight, ToneMapper &toneMapper,
+                const DrawView &drawView)
+    {
+        if (displays.empty() || !toneMapper.ready() || mainWidth <= 0 || mainHeight <= 0)
+            return;
+        const float fovY = glm::radians(camera.Zoom);
+        // by default the main view's horizontal field of view
+        const float step = yawSet ? yawStep : glm::degrees(2.0f * std::atan(std::tan(0.5f * fovY) * mainWidth / mainHeight));
+        for (size_t i = 0; i < displays.size(); ++i)
+        {
+            Display &d = displays[i];
+            glfwGetFramebufferSize(d.window, &d.width, &d.height);
+            const int turns = (int)(i / 2 + 1);
+            Camera turned = camera;
+            turned.Yaw += (i % 2 == 0 ? 1.0f : -1.0f) * turns * step;
+            turned.ProcessMouseMovement(0.0f, 0.0f); // recomputes its vectors
+            d.view.eye = turned.Position;
+            d.view.view = turned.GetViewMatrix();
+            d.view.projection = glm::perspective(fovY, (float)std::max(1, d.width) / (float)std::max(1, d.height), 0.1f, farPlane);
+        }
+        {
+            FrameTrace::Scope trace("kiosk cull");
+            ThreadPool::shared().parallelFor(displays.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    sceneTree.cull(Frustum(displays[i].view.projection * displays[i].view.view), displays[i].view.visible);
+            }, "kiosk cull");
+        }
+        for (size_t i = 0; i < displays.size(); ++i)
+        {
+            Display &d = displays[i];
+            d.drawn = d.width > 0 && d.height > 0 && createTargets(d);
+            if (!d.drawn)
+                continue;
+            glBindFramebuffer(GL_FRAMEBUFFER, d.hdrFbo);
+            glViewport(0, 0, d.width, d.height);
+            glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            drawView(d.view);
+            glBindFramebuffer(GL_FRAMEBUFFER, d.outputFbo);
+            toneMapper.present(d.hdrTexture, 0, 0, d.width, d.height);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+    }
+
+    // GL thread, after render(): copies each display's frame to its window in the window's own context (the
+    // current one is restored)
+    void present()
+    {
+        if (displays.empty())
+            return;
+        GLFWwindow *current = glfwGetCurrentContext();
+        // the other contexts see the views once the GPU has finished them
+        GLsync drawn = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+        for (size_t i = 0; i < displays.size(); ++i)
+        {
+            Display &d = displays[i];
+            if (!d.drawn)
+                continue;
+            glfwMakeContextCurrent(d.window);
+            glWaitSync(drawn, 0, GL_TIMEOUT_IGNORED);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, d.presentFbo);
+            // (re)attached by generation: a recreated texture may get the old one's name
+            if (d.attached != d.generation)
+            {
+                glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, d.outputTexture, 0);
+                d.attached = d.generation;
+            }
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+            glBlitFramebuffer(0, 0, d.width, d.height, 0, 0, d.width, d.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            glFlush();
+        }
+        glfwMakeContextCurrent(current);
+        glDeleteSync(drawn);
+    }
+
+    // right after the main window's swap: shows the displays' frames; a display asked to close closes the viewer
+    void swap()
+    {
+        for (size_t i = 0; i < displays.size(); ++i)
+        {
+            if (displays[i].drawn)
+                glfwSwapBuffers(displays[i].window);
+            if (glfwWindowShouldClose(displays[i].window))
+                glfwSetWindowShouldClose(mainWindow, true);
+        }
+    }
+
+    // main thread, with the main context current: deletes the targets and closes the windows
+    void releaseGpu()
+    {
+        for (size_t i = 0; i < displays.size(); ++i)
+            release(displays[i]);
+        for (size_t i = 0; i < displays.size(); ++i)
+        {
+            glfwMakeContextCurrent(displays[i].window);
+            glDeleteFramebuffers(1, &displays[i].presentFbo);
+        }
+        glfwMakeContextCurrent(mainWindow);
+        for (size_t i = 0; i < displays.size(); ++i)
+            glfwDestroyWindow(displays[i].window);
+        displays.clear();
+    }
+
+private:
+    struct Display
+    {
+        GLFWwindow *window = nullptr;
+        int width = 0, height = 0; // of its framebuffer
+        View view;
+        bool drawn = false; // this frame
+        // main context: the HDR view and its tone-mapped copy (a texture, which the display's context shares)
+        GLuint hdrFbo = 0, hdrTexture = 0, depthBuffer = 0;
+        GLuint outputFbo = 0, outputTexture = 0;
+        int targetWidth = 0, targetHeight = 0;
+        unsigned int generation = 0; // of the targets
+        // the display's context: reads outputTexture
+        GLuint presentFbo = 0;
+        unsigned int attached = 0; // the generation attached to presentFbo
+    };
+
+    GLFWwindow *mainWindow = nullptr;
+    float yawStep = 0.0f;
+    bool yawSet = false; // KIOSK_YAW given
+    std::vector<Display> displays;
+
+    bool createTargets(Display &d)
+    {
+        if (d.hdrFbo && d.width == d.targetWidth && d.height == d.targetHeight)
+            return true;
+        release(d);
+        d.targetWidth = d.width;
+        d.targetHeight = d.height;
+        ++d.generation;
+        glGenTextures(1, &d.hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, d.hdrTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, d.width, d.height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glGenTextures(1, &d.outputTexture);
+        glBindTexture(GL_TEXTURE_2D, d.outputTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, d.width, d.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &d.depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, d.depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, d.width, d.height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &d.hdrFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, d.hdrFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, d.hdrTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, d.depthBuffer);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glGenFramebuffers(1, &d.outputFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, d.outputFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, d.outputTexture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Kiosk] RGBA16F view target unsupported, the display stays dark");
+            release(d);
+            return false;
+        }
+        LOG_DEBUG("[Kiosk] View targets " << d.width << "x" << d.height << ", " << (size_t)d.width * d.height * (8 + 4 + 4) / 1024 << " KB");
+        return true;
+    }
+
+    // its main-context targets (a resize, or the end)
+    static void release(Display &d)
+    {
+        if (d.hdrFbo) glDeleteFramebuffers(1, &d.hdrFbo);
+        if (d.outputFbo) glDeleteFramebuffers(1, &d.outputFbo);
+        if (d.hdrTexture) glDeleteTextures(1, &d.hdrTexture);
+        if (d.outputTexture) glDeleteTextures(1, &d.outputTexture);
+        if (d.depthBuffer) glDeleteRenderbuffers(1, &d.depthBuffer);
+        d.hdrFbo = d.outputFbo = d.hdrTexture = d.outputTexture = d.depthBuffer = 0;
+        d.targetWidth = d.targetHeight = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef LTC_LUT_H
+#define LTC_LUT_H
+
+#include <glad/glad.h>
+
+#include <gpu_memory.h>
+#include <ltc_lut_data.h>
+
+// Linearly transformed cosine LUT for the rectangular area lights (ltcLut in model_loading.fs, see
+// ClusteredLights). Like the BRDF LUT it only depends on the BRDF, so tools/ltc_fit.cpp fits it offline and
+// it is embedded as half floats.
+namespace LTCLUT
+{
+    const unsigned int SIZE = LTC_LUT_SIZE;
+    // texture unit of ltcLut in the scene shaders (Shader::samplerUnit)
+    const unsigned int UNIT = 31;
+
+    // GL thread: creates the RGBA16F 2-layer array (x = roughness, y = sqrt(1 - NdotV); layer 0 the inverse
+    // matrix terms, layer 1 the lobe's albedo and Fresnel part)
+    inline GLuint create()
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA16F, SIZE, SIZE, 2, 0, GL_RGBA, GL_HALF_FLOAT, LTC_LUT_DATA);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        gpuMemory().trackTexture(texture, GpuMemory::ENVIRONMENT, GL_RGBA16F, SIZE, SIZE, 2, false, "ltc lut");
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        return texture;
+    }
+}
+
+#endif
@@ -0,0 +1,2060 @@
+// generated by tools/ltc_fit.cpp - do not edit
+// GGX linearly transformed cosines, 64x64 RGBA half floats in 2 layers (x = roughness, y = sqrt(1 - NdotV)):
+// inverse matrix terms, then albedo and Fresnel part; 32^2 samples per distribution in the fit
+#ifndef LTC_LUT_DATA_H
+#define LTC_LUT_DATA_H
+
+#define LTC_LUT_SIZE 64
+
+static const unsigned short LTC_LUT_DATA[32768] = {
+    0x3c00,0x0000,0x0000,0x0150,0x3c00,0x0000,0x0000,0x1021,0x3c00,0x0000,0x0000,0x1821,0x3c00,0x0000,0x0000,0x1ca5,
+    0x3c00,0x0000,0x0000,0x2021,0x3c00,0x0000,0x0000,0x2273,0x3c00,0x0000,0x0000,0x24a5,0x3c00,0x0000,0x0000,0x2652,
+    0x3c00,0x0000,0x0000,0x2821,0x3c00,0x0000,0x0000,0x293a,0x3c00,0x0000,0x0000,0x2a74,0x3c00,0x0000,0x0000,0x2bcf,
+    0x3c00,0x0000,0x0000,0x2ca5,0x3c00,0x0000,0x0000,0x2d74,0x3c00,0x0000,0x0000,0x2e53,0x3c00,0x0000,0x0000,0x2f43,
+    0x3c00,0x0000,0x0000,0x3022,0x3c00,0x0000,0x0000,0x30ab,0x3c00,0x0000,0x0000,0x313c,0x3c00,0x0000,0x0000,0x31d5,
+    0x3c00,0x0000,0x0000,0x3276,0x3c00,0x0000,0x0000,0x331d,0x3c00,0x0000,0x0000,0x33be,0x3c00,0x0000,0x0000,0x3432,
+    0x3c00,0x0000,0x0000,0x3492,0x3c00,0x0000,0x0000,0x34f6,0x3c00,0x0000,0x0000,0x355e,0x3c00,0x0000,0x0000,0x35c8,
+    0x3c00,0x0000,0x0000,0x3633,0x3c00,0x0000,0x0000,0x369b,0x3c00,0x0000,0x0000,0x3703,0x3c00,0x0000,0x0000,0x3779,
+    0x3c00,0x0000,0x0000,0x37ee,0x3c00,0x0000,0x0000,0x3830,0x3c00,0x0000,0x0000,0x3866,0x3c00,0x0000,0x0000,0x38a3,
+    0x3c00,0x0000,0x0000,0x38df,0x3c00,0x0000,0x0000,0x3917,0x3c00,0x0000,0x0000,0x3951,0x3c00,0x0000,0x0000,0x398b,
+    0x3c00,0x0000,0x0000,0x39c2,0x3c00,0x0000,0x0000,0x39fb,0x3c00,0x0000,0x0000,0x3a31,0x3c00,0x0000,0x0000,0x3a66,
+    0x3c00,0x0000,0x0000,0x3a9a,0x3c00,0x0000,0x0000,0x3acb,0x3c00,0x0000,0x0000,0x3afc,0x3c00,0x0000,0x0000,0x3b2a,
+    0x3c00,0x0000,0x0000,0x3b57,0x3c00,0x0000,0x0000,0x3b81,0x3c00,0x0000,0x0000,0x3baa,0x3c00,0x0000,0x0000,0x3bd0,
+    0x3c00,0x0000,0x0000,0x3bf5,0x3c00,0x0000,0x0000,0x3c0b,0x3c00,0x0000,0x0000,0x3c1c,0x3c00,0x0000,0x0000,0x3c2b,
+    0x3c00,0x0000,0x0000,0x3c39,0x3c00,0x0000,0x0000,0x3c46,0x3c00,0x0000,0x0000,0x3c52,0x3c00,0x0000,0x0000,0x3c5e,
+    0x3c00,0x0000,0x0000,0x3c68,0x3c00,0x0000,0x0000,0x3c72,0x3c00,0x0000,0x0000,0x3c7b,0x3c00,0x0000,0x0000,0x3c83,
+    0x3bff,0x8008,0x25bf,0x014f,0x3bff,0x80be,0x25bf,0x1020,0x3bff,0x82f7,0x25bf,0x1820,0x3bff,0x86ab,0x25bf,0x1ca4,
+    0x3bff,0x89ee,0x25bf,0x2020,0x3bff,0x8ca2,0x25bf,0x2272,0x3bff,0x8eab,0x25bf,0x24a4,0x3bff,0x908a,0x25bf,0x2651,
+    0x3bff,0x91ee,0x25bf,0x2820,0x3bff,0x9381,0x25bf,0x2939,0x3bff,0x94a2,0x25bf,0x2a73,0x3bff,0x959b,0x25bf,0x2bcd,
+    0x3bff,0x96ac,0x25bf,0x2ca5,0x3bff,0x97d5,0x25bf,0x2d73,0x3bff,0x988b,0x25bf,0x2e53,0x3bff,0x9937,0x25bf,0x2f42,
+    0x3bff,0x99ef,0x25bf,0x3021,0x3bff,0x9ab3,0x25bf,0x30aa,0x3bff,0x9b83,0x25be,0x313b,0x3bff,0x9c2e,0x25bf,0x31d4,
+    0x3bff,0x9c9c,0x25be,0x3275,0x3bff,0x9cf4,0x25bd,0x331c,0x3bff,0x9ca3,0x25b6,0x33bc,0x3bff,0x9e04,0x25be,0x3432,
+    0x3bff,0x9e8b,0x25be,0x3492,0x3bff,0x9f13,0x25be,0x34f6,0x3bff,0x9f99,0x25bc,0x355d,0x3bff,0xa007,0x25ba,0x35c7,
+    0x3bff,0xa028,0x25b4,0x3632,0x3bff,0xa019,0x25a8,0x369a,0x3bff,0xa0e1,0x25b4,0x3702,0x3bff,0xa113,0x25b0,0x3778,
+    0x3bff,0xa12b,0x25a5,0x37ed,0x3bff,0xa11b,0x2595,0x382f,0x3bff,0xa161,0x258e,0x3867,0x3bff,0xa1d9,0x258f,0x38a3,
+    0x3bff,0xa1ba,0x2577,0x38de,0x3bff,0xa184,0x2559,0x3916,0x3bff,0xa23b,0x2562,0x3951,0x3bff,0xa1f0,0x253b,0x398b,
+    0x3bff,0xa1eb,0x251f,0x39c2,0x3bff,0xa233,0x2510,0x39fa,0x3bff,0xa1ac,0x24d7,0x3a31,0x3bff,0xa244,0x24d3,0x3a65,
+    0x3bff,0xa1a6,0x248e,0x3a9a,0x3bff,0xa1e2,0x2473,0x3acb,0x3bff,0xa16c,0x2437,0x3afc,0x3bff,0xa16d,0x240d,0x3b2a,
+    0x3bff,0xa104,0x2397,0x3b57,0x3c00,0xa0f4,0x2335,0x3b81,0x3c00,0xa073,0x22a6,0x3baa,0x3bff,0xa070,0x2248,0x3bd0,
+    0x3c00,0x9f7f,0x2198,0x3bf5,0x3bff,0x9fbe,0x2146,0x3c0b,0x3c00,0x9dfa,0x2085,0x3c1c,0x3c00,0x9e77,0x203e,0x3c2b,
+    0x3c00,0x9c9d,0x1eeb,0x3c39,0x3c00,0x9cfa,0x1e62,0x3c46,0x3c00,0x9a98,0x1ce4,0x3c53,0x3c00,0x9a84,0x1c1c,0x3c5e,
+    0x3c00,0x97ea,0x19bf,0x3c69,0x3c00,0x964b,0x1811,0x3c72,0x3c00,0x911a,0x135b,0x3c7b,0x3c00,0x0001,0x8001,0x3c83,
+    0x3bfc,0x800f,0x29bd,0x014f,0x3bfc,0x817b,0x29bd,0x101f,0x3bfc,0x85ec,0x29bd,0x181f,0x3bfc,0x8aaa,0x29bd,0x1ca2,
+    0x3bfc,0x8dec,0x29bd,0x201f,0x3bfc,0x90a1,0x29bd,0x2270,0x3bfc,0x92aa,0x29bd,0x24a2,0x3bfc,0x9489,0x29bd,0x264f,
+    0x3bfc,0x95ec,0x29bd,0x281f,0x3bfc,0x977f,0x29bd,0x2937,0x3bfc,0x98a1,0x29bd,0x2a70,0x3bfc,0x999a,0x29bd,0x2bca,
+    0x3bfc,0x9aaa,0x29bd,0x2ca3,0x3bfc,0x9bd3,0x29bd,0x2d71,0x3bfc,0x9c8a,0x29bd,0x2e50,0x3bfc,0x9d36,0x29bd,0x2f40,
+    0x3bfc,0x9dee,0x29bd,0x3020,0x3bfc,0x9eb2,0x29bd,0x30a8,0x3bfc,0x9f81,0x29bd,0x3139,0x3bfc,0xa02d,0x29bd,0x31d2,
+    0x3bfc,0xa09a,0x29bd,0x3273,0x3bfc,0xa0f0,0x29bc,0x3319,0x3bfc,0xa0b9,0x29b6,0x33b9,0x3bfc,0xa202,0x29bd,0x3430,
+    0x3bfc,0xa289,0x29bd,0x3490,0x3bfc,0xa311,0x29bc,0x34f4,0x3bfc,0xa396,0x29bb,0x355b,0x3bfc,0xa405,0x29b9,0x35c5,
+    0x3bfc,0xa425,0x29b3,0x362f,0x3bfc,0xa415,0x29a8,0x3697,0x3bfc,0xa4b6,0x29b0,0x3701,0x3bfc,0xa511,0x29af,0x3775,
+    0x3bfc,0xa528,0x29a4,0x37ea,0x3bfc,0xa517,0x2993,0x382e,0x3bfd,0xa564,0x298e,0x3866,0x3bfd,0xa5d6,0x298e,0x38a1,
+    0x3bfd,0xa5b6,0x2974,0x38dc,0x3bfd,0xa5b6,0x2960,0x3916,0x3bfd,0xa62c,0x295e,0x394f,0x3bfd,0xa5ed,0x2938,0x3989,
+    0x3bfd,0xa5fc,0x2921,0x39c1,0x3bfd,0xa630,0x290d,0x39f9,0x3bfd,0xa5db,0x28e0,0x3a2f,0x3bfd,0xa605,0x28c4,0x3a64,
+    0x3bfd,0xa5b6,0x2891,0x3a98,0x3bfd,0xa5b6,0x286a,0x3aca,0x3bfd,0xa577,0x2836,0x3afa,0x3bfd,0xa552,0x2805,0x3b29,
+    0x3bfe,0xa514,0x279c,0x3b56,0x3bfd,0xa4d8,0x2729,0x3b80,0x3bfe,0xa494,0x26ae,0x3ba9,0x3bfe,0xa445,0x2630,0x3bd0,
+    0x3bfe,0xa3f6,0x25b1,0x3bf4,0x3bff,0xa33d,0x252a,0x3c0b,0x3bfe,0xa29f,0x24a8,0x3c1c,0x3bff,0xa1cc,0x2418,0x3c2b,
+    0x3bff,0xa12f,0x232d,0x3c39,0x3bff,0xa04a,0x220e,0x3c46,0x3bff,0x9f64,0x2111,0x3c53,0x3c00,0x9dac,0x1fe9,0x3c5e,
+    0x3c00,0x9c5f,0x1df7,0x3c69,0x3c00,0x999b,0x1bab,0x3c72,0x3c00,0x9599,0x17b7,0x3c7b,0x3c00,0x02a7,0x82dc,0x3c83,
+    0x3bf7,0x8017,0x2c4c,0x014e,0x3bf7,0x8238,0x2c4c,0x101c,0x3bf7,0x886f,0x2c4c,0x181c,0x3bf7,0x8cfd,0x2c4c,0x1c9f,
+    0x3bf7,0x906f,0x2c4c,0x201c,0x3bf7,0x92ee,0x2c4c,0x226c,0x3bf7,0x94fd,0x2c4c,0x24a0,0x3bf7,0x96cb,0x2c4c,0x264b,
+    0x3bf7,0x9870,0x2c4c,0x281c,0x3bf7,0x999d,0x2c4c,0x2934,0x3bf7,0x9aee,0x2c4c,0x2a6c,0x3bf7,0x9c32,0x2c4c,0x2bc5,
+    0x3bf7,0x9cfe,0x2c4c,0x2ca0,0x3bf7,0x9ddc,0x2c4c,0x2d6e,0x3bf7,0x9ecc,0x2c4c,0x2e4c,0x3bf7,0x9fcd,0x2c4c,0x2f3b,
+    0x3bf7,0xa071,0x2c4c,0x301d,0x3bf7,0xa103,0x2c4c,0x30a5,0x3bf7,0xa19e,0x2c4c,0x3136,0x3bf7,0xa241,0x2c4c,0x31ce,
+    0x3bf7,0xa2e4,0x2c4c,0x326f,0x3bf7,0xa35e,0x2c4b,0x3314,0x3bf7,0xa359,0x2c48,0x33b5,0x3bf7,0xa474,0x2c4b,0x342e,
+    0x3bf7,0xa4e4,0x2c4c,0x348d,0x3bf7,0xa54b,0x2c4b,0x34f1,0x3bf7,0xa5ae,0x2c4a,0x3558,0x3bf7,0xa603,0x2c49,0x35c1,
+    0x3bf7,0xa632,0x2c45,0x362b,0x3bf7,0xa63c,0x2c3e,0x3693,0x3bf8,0xa6f6,0x2c41,0x36ff,0x3bf7,0xa794,0x2c41,0x3770,
+    0x3bf8,0xa7b5,0x2c39,0x37e5,0x3bf8,0xa7a3,0x2c2d,0x382b,0x3bf8,0xa80d,0x2c2a,0x3865,0x3bf8,0xa857,0x2c28,0x389e,
+    0x3bf8,0xa844,0x2c16,0x38d9,0x3bf9,0xa857,0x2c0a,0x3914,0x3bf9,0xa885,0x2c00,0x394d,0x3bf9,0xa877,0x2bd6,0x3986,
+    0x3bf9,0xa880,0x2bb1,0x39bf,0x3bf9,0xa889,0x2b89,0x39f6,0x3bf9,0xa879,0x2b53,0x3a2d,0x3bfa,0xa86d,0x2b1b,0x3a63,
+    0x3bfa,0xa863,0x2ae3,0x3a96,0x3bfa,0xa83c,0x2a9b,0x3ac9,0x3bfa,0xa828,0x2a57,0x3af9,0x3bfa,0xa7ed,0x2a04,0x3b28,
+    0x3bfa,0xa7aa,0x29b6,0x3b54,0x3bfb,0xa734,0x295c,0x3b7f,0x3bfb,0xa6e1,0x2905,0x3ba8,0x3bfc,0xa654,0x28a1,0x3bcf,
+    0x3bfc,0xa5fa,0x2846,0x3bf4,0x3bfd,0xa55f,0x27ba,0x3c0b,0x3bfd,0xa4f9,0x26fb,0x3c1b,0x3bfd,0xa458,0x2624,0x3c2b,
+    0x3bfe,0xa3cc,0x2563,0x3c39,0x3bfe,0xa287,0x248c,0x3c46,0x3bff,0xa18b,0x2394,0x3c53,0x3bff,0xa055,0x21f2,0x3c5e,
+    0x3bff,0x9e8c,0x2074,0x3c69,0x3c00,0x9c3e,0x1dcb,0x3c72,0x3c00,0x983f,0x19be,0x3c7b,0x3c00,0x05c6,0x8401,0x3c83,
+    0x3bef,0x801e,0x2db7,0x014d,0x3bf0,0x82f3,0x2db8,0x1018,0x3bf0,0x89e7,0x2db8,0x1818,0x3bf0,0x8ea3,0x2db8,0x1c9b,
+    0x3bf0,0x91e7,0x2db8,0x2018,0x3bf0,0x949c,0x2db8,0x2266,0x3bf0,0x96a3,0x2db8,0x249b,0x3bf0,0x9885,0x2db8,0x2645,
+    0x3bf0,0x99e7,0x2db8,0x2818,0x3bf0,0x9b78,0x2db8,0x292f,0x3bf0,0x9c9c,0x2db8,0x2a66,0x3bf0,0x9d94,0x2db8,0x2bbe,
+    0x3bf0,0x9ea4,0x2db8,0x2c9c,0x3bf0,0x9fcb,0x2db8,0x2d69,0x3bf0,0xa085,0x2db8,0x2e46,0x3bf0,0xa131,0x2db8,0x2f34,
+    0x3bf0,0xa1e8,0x2db8,0x301a,0x3bf0,0xa2ab,0x2db8,0x30a1,0x3bf0,0xa379,0x2db8,0x3131,0x3bf0,0xa428,0x2db8,0x31c9,
+    0x3bf0,0xa494,0x2db7,0x3269,0x3bf0,0xa4e0,0x2db6,0x330d,0x3bf0,0xa502,0x2db3,0x33af,0x3bf0,0xa5d1,0x2db6,0x342c,
+    0x3bf0,0xa682,0x2db7,0x3489,0x3bf0,0xa70a,0x2db7,0x34ec,0x3bf0,0xa78d,0x2db5,0x3553,0x3bf0,0xa7fc,0x2db3,0x35bc,
+    0x3bf1,0xa81b,0x2dad,0x3625,0x3bf1,0xa838,0x2da7,0x368e,0x3bf1,0xa89c,0x2da8,0x36fa,0x3bf1,0xa907,0x2da9,0x3769,
+    0x3bf1,0xa91d,0x2d9f,0x37dd,0x3bf2,0xa926,0x2d91,0x3828,0x3bf2,0xa967,0x2d8a,0x3862,0x3bf2,0xa9ad,0x2d84,0x389b,
+    0x3bf3,0xa9b7,0x2d73,0x38d5,0x3bf3,0xa9d1,0x2d61,0x3910,0x3bf3,0xa9ee,0x2d4f,0x394a,0x3bf3,0xaa06,0x2d3b,0x3982,
+    0x3bf4,0xaa00,0x2d1f,0x39bc,0x3bf5,0xa9fa,0x2d01,0x39f3,0x3bf4,0xaa03,0x2ce2,0x3a2a,0x3bf6,0xa9d9,0x2cba,0x3a60,
+    0x3bf5,0xa9d5,0x2c94,0x3a93,0x3bf6,0xa9a0,0x2c65,0x3ac6,0x3bf6,0xa981,0x2c37,0x3af7,0x3bf7,0xa94b,0x2c03,0x3b25,
+    0x3bf7,0xa913,0x2b97,0x3b53,0x3bf8,0xa8d8,0x2b27,0x3b7d,0x3bf8,0xa88c,0x2aab,0x3ba7,0x3bf8,0xa84a,0x2a31,0x3bce,
+    0x3bf9,0xa7db,0x29aa,0x3bf3,0x3bfa,0xa74f,0x292c,0x3c0b,0x3bfb,0xa67d,0x28a0,0x3c1b,0x3bfb,0xa5ee,0x281e,0x3c2a,
+    0x3bfd,0xa512,0x2722,0x3c39,0x3bfd,0xa476,0x2620,0x3c46,0x3bfe,0xa33d,0x2504,0x3c53,0x3bfe,0xa1eb,0x2403,0x3c5e,
+    0x3bff,0xa04c,0x21e5,0x3c69,0x3bff,0x9dcd,0x1fd0,0x3c72,0x3c00,0x9987,0x1bb3,0x3c7b,0x3c00,0x042b,0x001a,0x3c84,
+    0x3be6,0x8025,0x2f20,0x014b,0x3be6,0x83ad,0x2f21,0x1014,0x3be6,0x8b5b,0x2f20,0x1813,0x3be6,0x9023,0x2f20,0x1c96,
+    0x3be6,0x935b,0x2f20,0x2013,0x3be6,0x95bf,0x2f20,0x225e,0x3be6,0x9823,0x2f20,0x2496,0x3be6,0x99a2,0x2f20,0x263e,
+    0x3be6,0x9b5b,0x2f20,0x2814,0x3be6,0x9ca8,0x2f20,0x2929,0x3be6,0x9dbf,0x2f20,0x2a5f,0x3be6,0x9ef4,0x2f20,0x2bb5,
+    0x3be6,0xa023,0x2f20,0x2c96,0x3be6,0xa0db,0x2f20,0x2d62,0x3be6,0xa1a2,0x2f20,0x2e3f,0x3be6,0xa278,0x2f21,0x2f2c,
+    0x3be6,0xa35c,0x2f21,0x3015,0x3be7,0xa428,0x2f21,0x309c,0x3be7,0xa4a8,0x2f21,0x312b,0x3be7,0xa52e,0x2f21,0x31c2,
+    0x3be7,0xa5b4,0x2f20,0x3261,0x3be7,0xa606,0x2f1e,0x3303,0x3be7,0xa657,0x2f1c,0x33a8,0x3be7,0xa72f,0x2f1d,0x3429,
+    0x3be7,0xa80e,0x2f20,0x3484,0x3be7,0xa862,0x2f1f,0x34e7,0x3be7,0xa8b3,0x2f1e,0x354d,0x3be7,0xa8f7,0x2f1b,0x35b5,
+    0x3be8,0xa917,0x2f13,0x361e,0x3be8,0xa953,0x2f0e,0x3688,0x3be9,0xa9bd,0x2f0d,0x36f4,0x3be9,0xaa31,0x2f0d,0x3762,
+    0x3be9,0xaa59,0x2f01,0x37d4,0x3bea,0xaa7d,0x2ef4,0x3824,0x3bea,0xaabf,0x2ee9,0x385e,0x3beb,0xaafc,0x2ede,0x3897,
+    0x3beb,0xab30,0x2ecd,0x38d1,0x3beb,0xab47,0x2eb6,0x390c,0x3bed,0xab55,0x2e9d,0x3946,0x3bec,0xab81,0x2e85,0x397e,
+    0x3bed,0xab7c,0x2e63,0x39b7,0x3bee,0xab75,0x2e3d,0x39ef,0x3bee,0xab7a,0x2e16,0x3a26,0x3bf0,0xab56,0x2de7,0x3a5c,
+    0x3bf0,0xab39,0x2db4,0x3a90,0x3bf1,0xab16,0x2d7e,0x3ac2,0x3bf1,0xaad5,0x2d40,0x3af4,0x3bf2,0xaaa3,0x2d02,0x3b23,
+    0x3bf3,0xaa4e,0x2cbc,0x3b50,0x3bf3,0xaa0a,0x2c75,0x3b7c,0x3bf5,0xa9a9,0x2c27,0x3ba5,0x3bf5,0xa955,0x2bb8,0x3bcc,
+    0x3bf7,0xa8eb,0x2b17,0x3bf1,0x3bf7,0xa886,0x2a72,0x3c0a,0x3bf8,0xa818,0x29ca,0x3c1b,0x3bf9,0xa74a,0x2920,0x3c2a,
+    0x3bfa,0xa66c,0x2878,0x3c39,0x3bfc,0xa576,0x2796,0x3c46,0x3bfd,0xa492,0x264d,0x3c53,0x3bfe,0xa339,0x24f8,0x3c5e,
+    0x3bfe,0xa16c,0x2359,0x3c69,0x3bff,0x9f1a,0x20d8,0x3c72,0x3c00,0x9af9,0x1cc0,0x3c7b,0x3c00,0x073e,0x8625,0x3c84,
+    0x3bda,0x802d,0x3042,0x0149,0x3bdb,0x8466,0x3043,0x100e,0x3bdb,0x8c66,0x3043,0x180e,0x3bdb,0x90f2,0x3043,0x1c8f,
+    0x3bdb,0x9466,0x3043,0x200e,0x3bdb,0x96df,0x3043,0x2255,0x3bdb,0x98f3,0x3043,0x248f,0x3bdb,0x9abc,0x3043,0x2635,
+    0x3bdb,0x9c66,0x3043,0x280e,0x3bdb,0x9d91,0x3043,0x2921,0x3bdb,0x9edf,0x3043,0x2a56,0x3bdb,0xa028,0x3043,0x2baa,
+    0x3bdb,0xa0f3,0x3043,0x2c90,0x3bdb,0xa1cf,0x3043,0x2d5b,0x3bdb,0xa2bd,0x3043,0x2e36,0x3bdb,0xa3bc,0x3043,0x2f22,
+    0x3bdb,0xa467,0x3043,0x300f,0x3bdb,0xa4f8,0x3043,0x3095,0x3bdb,0xa591,0x3043,0x3124,0x3bdb,0xa632,0x3043,0x31ba,
+    0x3bdc,0xa6cf,0x3043,0x3258,0x3bdc,0xa726,0x3041,0x32f8,0x3bdc,0xa7ac,0x3040,0x339e,0x3bdc,0xa848,0x3041,0x3424,
+    0x3bdc,0xa8d9,0x3043,0x347e,0x3bdc,0xa93d,0x3042,0x34e0,0x3bdd,0xa99d,0x3041,0x3545,0x3bdd,0xa9eb,0x303f,0x35ad,
+    0x3bdd,0xaa18,0x303b,0x3615,0x3bde,0xaa6d,0x3039,0x3680,0x3bde,0xaadc,0x3037,0x36ed,0x3bdf,0xab52,0x3036,0x3759,
+    0x3bdf,0xab95,0x3031,0x37c9,0x3be0,0xabd0,0x302a,0x381f,0x3be1,0xac09,0x3023,0x3859,0x3be2,0xac25,0x301a,0x3892,
+    0x3be2,0xac4d,0x3012,0x38cc,0x3be3,0xac5c,0x3005,0x3906,0x3be5,0xac64,0x2feb,0x3940,0x3be4,0xac78,0x2fcc,0x3979,
+    0x3be7,0xac7d,0x2fa6,0x39b2,0x3be7,0xac78,0x2f79,0x39eb,0x3be9,0xac71,0x2f47,0x3a21,0x3be9,0xac6a,0x2f13,0x3a57,
+    0x3beb,0xac4e,0x2ed3,0x3a8c,0x3beb,0xac3d,0x2e93,0x3abe,0x3bee,0xac17,0x2e49,0x3af0,0x3bed,0xabeb,0x2dfd,0x3b1f,
+    0x3bef,0xab98,0x2dac,0x3b4d,0x3bef,0xab34,0x2d55,0x3b79,0x3bf1,0xaad6,0x2cfc,0x3ba2,0x3bf3,0xaa58,0x2c9c,0x3bcb,
+    0x3bf3,0xa9f0,0x2c40,0x3bf0,0x3bf5,0xa964,0x2bb3,0x3c0a,0x3bf5,0xa8ed,0x2af2,0x3c1a,0x3bf7,0xa85d,0x2a24,0x3c2a,
+    0x3bf8,0xa7b5,0x295c,0x3c38,0x3bfa,0xa68e,0x288d,0x3c46,0x3bfc,0xa57a,0x2783,0x3c52,0x3bfd,0xa458,0x25f6,0x3c5e,
+    0x3bfe,0xa27d,0x2469,0x3c69,0x3bff,0xa043,0x21d1,0x3c73,0x3c00,0x9c35,0x1db3,0x3c7c,0x3c00,0x08fd,0x87c4,0x3c84,
+    0x3bcd,0x8034,0x30f3,0x0147,0x3bce,0x851c,0x30f3,0x1007,0x3bce,0x8d1c,0x30f3,0x1807,0x3bce,0x91bf,0x30f3,0x1c88,
+    0x3bce,0x951c,0x30f3,0x2007,0x3bce,0x97fc,0x30f3,0x224b,0x3bce,0x99c0,0x30f3,0x2488,0x3bce,0x9bd3,0x30f3,0x262b,
+    0x3bce,0x9d1c,0x30f3,0x2807,0x3bce,0x9e78,0x30f3,0x2919,0x3bce,0x9ffc,0x30f3,0x2a4b,0x3bce,0xa0d5,0x30f3,0x2b9d,
+    0x3bce,0xa1c0,0x30f3,0x2c88,0x3bce,0xa2c0,0x30f3,0x2d52,0x3bce,0xa3d4,0x30f4,0x2e2c,0x3bce,0xa47e,0x30f4,0x2f16,
+    0x3bce,0xa51d,0x30f4,0x3008,0x3bce,0xa5c6,0x30f4,0x308e,0x3bce,0xa678,0x30f4,0x311b,0x3bce,0xa731,0x30f4,0x31b1,
+    0x3bcf,0xa7e4,0x30f3,0x324d,0x3bcf,0xa828,0x30f2,0x32ec,0x3bcf,0xa87f,0x30f1,0x3392,0x3bcf,0xa8f9,0x30f1,0x341f,
+    0x3bcf,0xa99a,0x30f3,0x3477,0x3bd0,0xaa15,0x30f3,0x34d7,0x3bd0,0xaa83,0x30f2,0x353c,0x3bd0,0xaad9,0x30ef,0x35a3,
+    0x3bd1,0xab1d,0x30ec,0x360b,0x3bd1,0xab83,0x30e9,0x3676,0x3bd2,0xabf9,0x30e6,0x36e3,0x3bd3,0xac36,0x30e3,0x374f,
+    0x3bd4,0xac6a,0x30df,0x37bd,0x3bd4,0xac90,0x30d8,0x3819,0x3bd5,0xacb1,0x30cf,0x3853,0x3bd7,0xacd0,0x30c5,0x388c,
+    0x3bd7,0xacfb,0x30bb,0x38c6,0x3bd9,0xad11,0x30ac,0x3900,0x3bdb,0xad1e,0x309b,0x393a,0x3bdb,0xad2d,0x3088,0x3974,
+    0x3bde,0xad39,0x3073,0x39ac,0x3bdf,0xad33,0x3059,0x39e4,0x3be2,0xad29,0x303c,0x3a1c,0x3be2,0xad21,0x301d,0x3a51,
+    0x3be6,0xad05,0x2ff2,0x3a87,0x3be6,0xace8,0x2fa2,0x3aba,0x3be9,0xacc9,0x2f51,0x3aeb,0x3bea,0xac96,0x2ef5,0x3b1c,
+    0x3beb,0xac6d,0x2e99,0x3b49,0x3bed,0xac2f,0x2e32,0x3b76,0x3bed,0xabef,0x2dca,0x3ba0,0x3bf0,0xab6a,0x2d60,0x3bc8,
+    0x3bf0,0xaade,0x2ced,0x3bee,0x3bf1,0xaa52,0x2c7d,0x3c09,0x3bf4,0xa9b2,0x2c07,0x3c1a,0x3bf4,0xa91f,0x2b28,0x3c29,
+    0x3bf6,0xa874,0x2a39,0x3c38,0x3bf8,0xa7b4,0x2952,0x3c46,0x3bfa,0xa65b,0x2862,0x3c52,0x3bfb,0xa519,0x26f4,0x3c5e,
+    0x3bfd,0xa38c,0x2529,0x3c69,0x3bfe,0xa105,0x22c7,0x3c73,0x3bff,0x9cdb,0x1e9d,0x3c7c,0x3c00,0x05ec,0x8636,0x3c84,
+    0x3bbb,0x803b,0x319f,0x0145,0x3bbe,0x85d0,0x31a1,0x0ffe,0x3bbf,0x8dd0,0x31a2,0x17fe,0x3bbe,0x928a,0x31a2,0x1c7f,
+    0x3bbe,0x95d0,0x31a2,0x1ffe,0x3bbe,0x988a,0x31a2,0x223e,0x3bbe,0x9a8a,0x31a2,0x247f,0x3bbf,0x9c73,0x31a2,0x261e,
+    0x3bbe,0x9dd0,0x31a2,0x27fe,0x3bbf,0x9f5b,0x31a2,0x290f,0x3bbf,0xa08a,0x31a2,0x2a3f,0x3bbf,0xa17f,0x31a2,0x2b8f,
+    0x3bbf,0xa28a,0x31a2,0x2c7f,0x3bbf,0xa3ad,0x31a2,0x2d47,0x3bbf,0xa473,0x31a2,0x2e20,0x3bbf,0xa51c,0x31a2,0x2f08,
+    0x3bbf,0xa5d1,0x31a2,0x3000,0x3bbf,0xa690,0x31a2,0x3085,0x3bbf,0xa75b,0x31a2,0x3111,0x3bbf,0xa817,0x31a2,0x31a5,
+    0x3bbf,0xa879,0x31a1,0x3240,0x3bc0,0xa8bf,0x31a0,0x32df,0x3bc0,0xa926,0x319f,0x3385,0x3bc0,0xa9aa,0x319f,0x3418,
+    0x3bc1,0xaa53,0x31a1,0x3470,0x3bc1,0xaae9,0x31a1,0x34ce,0x3bc1,0xab64,0x31a0,0x3532,0x3bc2,0xabc1,0x319d,0x3598,
+    0x3bc3,0xac10,0x319a,0x3600,0x3bc3,0xac4b,0x3196,0x366b,0x3bc4,0xac88,0x3193,0x36d7,0x3bc5,0xacc1,0x318f,0x3743,
+    0x3bc6,0xad02,0x318b,0x37b1,0x3bc7,0xad34,0x3184,0x3812,0x3bc9,0xad54,0x3179,0x384c,0x3bcb,0xad7a,0x316e,0x3885,
+    0x3bcb,0xada5,0x3161,0x38bf,0x3bcf,0xadc6,0x3153,0x38f8,0x3bd0,0xadd6,0x3140,0x3933,0x3bd3,0xaddf,0x3129,0x396d,
+    0x3bd5,0xadef,0x3111,0x39a5,0x3bd8,0xadec,0x30f4,0x39de,0x3bda,0xade1,0x30d3,0x3a16,0x3bdd,0xadd1,0x30af,0x3a4c,
+    0x3be0,0xadbc,0x3088,0x3a81,0x3be2,0xad94,0x305a,0x3ab5,0x3be2,0xad71,0x302a,0x3ae6,0x3be7,0xad3d,0x2fef,0x3b17,
+    0x3be6,0xad05,0x2f7f,0x3b45,0x3bea,0xaccc,0x2f10,0x3b72,0x3beb,0xac80,0x2e96,0x3b9d,0x3bec,0xac3e,0x2e1c,0x3bc5,
+    0x3bee,0xabd2,0x2d9d,0x3bec,0x3bee,0xab35,0x2d1d,0x3c08,0x3bf1,0xaa81,0x2c99,0x3c19,0x3bf2,0xa9cf,0x2c13,0x3c28,
+    0x3bf3,0xa919,0x2b1c,0x3c38,0x3bf6,0xa85f,0x2a0f,0x3c45,0x3bf8,0xa747,0x2902,0x3c52,0x3bfa,0xa5cc,0x27f1,0x3c5e,
+    0x3bfc,0xa452,0x25e3,0x3c69,0x3bfe,0xa1b2,0x23bf,0x3c73,0x3bff,0x9d91,0x1f86,0x3c7c,0x3c00,0x095c,0x86ce,0x3c85,
+    0x3bae,0x8042,0x324d,0x0142,0x3bad,0x8681,0x324d,0x0fec,0x3bae,0x8e81,0x324e,0x17ec,0x3bad,0x9351,0x324d,0x1c75,
+    0x3bad,0x9681,0x324d,0x1fec,0x3bad,0x9914,0x324d,0x2231,0x3bad,0x9b51,0x324d,0x2475,0x3bad,0x9cfa,0x324d,0x2611,
+    0x3bad,0x9e81,0x324d,0x27ec,0x3bad,0xa01d,0x324d,0x2904,0x3bad,0xa115,0x324d,0x2a31,0x3bad,0xa226,0x324d,0x2b7e,
+    0x3bad,0xa351,0x324d,0x2c75,0x3bad,0xa44b,0x324d,0x2d3c,0x3bae,0xa4fb,0x324d,0x2e12,0x3bae,0xa5b8,0x324d,0x2ef8,
+    0x3bae,0xa681,0x324d,0x2fef,0x3bae,0xa758,0x324d,0x307b,0x3bae,0xa81d,0x324d,0x3106,0x3bae,0xa892,0x324d,0x3199,
+    0x3baf,0xa8fb,0x324d,0x3232,0x3baf,0xa954,0x324c,0x32d0,0x3baf,0xa9cb,0x324b,0x3375,0x3bb0,0xaa5a,0x324b,0x3410,
+    0x3bb0,0xab08,0x324c,0x3468,0x3bb0,0xabb9,0x324d,0x34c4,0x3bb1,0xac20,0x324b,0x3526,0x3bb2,0xac53,0x3248,0x358b,
+    0x3bb3,0xac90,0x3245,0x35f3,0x3bb3,0xacd2,0x3242,0x365e,0x3bb4,0xad12,0x323e,0x36ca,0x3bb6,0xad4d,0x3239,0x3736,
+    0x3bb7,0xad97,0x3234,0x37a3,0x3bb8,0xadd5,0x322d,0x380a,0x3bbb,0xadf8,0x3221,0x3844,0x3bbd,0xae23,0x3215,0x387e,
+    0x3bbf,0xae4b,0x3206,0x38b7,0x3bc2,0xae73,0x31f7,0x38f1,0x3bc5,0xae8b,0x31e2,0x392b,0x3bc9,0xae94,0x31c9,0x3965,
+    0x3bcb,0xaea0,0x31ad,0x399e,0x3bd1,0xaea5,0x318f,0x39d6,0x3bd2,0xae95,0x3168,0x3a0e,0x3bd7,0xae82,0x3140,0x3a45,
+    0x3bd8,0xae6b,0x3113,0x3a7a,0x3bdd,0xae43,0x30e0,0x3aaf,0x3be0,0xae14,0x30ab,0x3ae1,0x3be3,0xade5,0x3072,0x3b12,
+    0x3be5,0xada0,0x3033,0x3b42,0x3be5,0xad5f,0x2fe9,0x3b6e,0x3be9,0xad10,0x2f64,0x3b99,0x3bea,0xacbc,0x2ed7,0x3bc2,
+    0x3bea,0xac67,0x2e4b,0x3be9,0x3bed,0xac06,0x2dba,0x3c07,0x3bed,0xab56,0x2d29,0x3c18,0x3bf1,0xaa85,0x2c91,0x3c28,
+    0x3bf1,0xa9be,0x2bfd,0x3c37,0x3bf4,0xa8e9,0x2acb,0x3c45,0x3bf6,0xa817,0x29a1,0x3c52,0x3bf9,0xa681,0x2873,0x3c5e,
+    0x3bfb,0xa4db,0x269a,0x3c69,0x3bfd,0xa25f,0x2457,0x3c73,0x3bff,0x9e49,0x2041,0x3c7c,0x3c00,0x0b24,0x8580,0x3c85,
+    0x3b9b,0x8049,0x32f6,0x013f,0x3b9a,0x872e,0x32f5,0x0fd9,0x3b9a,0x8f2e,0x32f5,0x17d8,0x3b9a,0x940a,0x32f5,0x1c6a,
+    0x3b9a,0x972e,0x32f5,0x1fd8,0x3b9a,0x999c,0x32f5,0x2221,0x3b9a,0x9c0a,0x32f5,0x246a,0x3b9a,0x9d7f,0x32f5,0x2602,
+    0x3b9a,0x9f2e,0x32f5,0x27d9,0x3b9a,0xa08b,0x32f5,0x28f7,0x3b9a,0xa19c,0x32f5,0x2a21,0x3b9a,0xa2ca,0x32f5,0x2b6b,
+    0x3b9a,0xa40a,0x32f5,0x2c6a,0x3b9a,0xa4be,0x32f5,0x2d2f,0x3b9a,0xa580,0x32f6,0x2e03,0x3b9b,0xa650,0x32f6,0x2ee7,
+    0x3b9b,0xa72f,0x32f6,0x2fdb,0x3b9b,0xa80e,0x32f6,0x306f,0x3b9b,0xa88b,0x32f6,0x30f9,0x3b9b,0xa90b,0x32f6,0x318b,
+    0x3b9c,0xa977,0x32f5,0x3222,0x3b9c,0xa9e8,0x32f4,0x32bf,0x3b9d,0xaa6d,0x32f4,0x3364,0x3b9d,0xab08,0x32f3,0x3407,
+    0x3b9d,0xabbd,0x32f4,0x345e,0x3b9e,0xac42,0x32f6,0x34b8,0x3b9f,0xac8a,0x32f4,0x351a,0x3ba0,0xacc6,0x32f1,0x357e,
+    0x3ba1,0xad0d,0x32ee,0x35e5,0x3ba2,0xad55,0x32ea,0x364f,0x3ba3,0xad98,0x32e5,0x36bb,0x3ba5,0xadda,0x32e0,0x3727,
+    0x3ba7,0xae28,0x32db,0x3794,0x3ba8,0xae6e,0x32d3,0x3801,0x3bac,0xae9c,0x32c8,0x383b,0x3bae,0xaec9,0x32ba,0x3875,
+    0x3bb3,0xaef0,0x32ab,0x38af,0x3bb5,0xaf1d,0x3299,0x38e8,0x3bbb,0xaf3b,0x3284,0x3922,0x3bbe,0xaf46,0x3267,0x395c,
+    0x3bc3,0xaf4e,0x3249,0x3996,0x3bc8,0xaf54,0x3227,0x39ce,0x3bcd,0xaf49,0x31fd,0x3a06,0x3bd0,0xaf31,0x31cf,0x3a3d,
+    0x3bd6,0xaf16,0x319d,0x3a74,0x3bd8,0xaef0,0x3167,0x3aa7,0x3bde,0xaeb9,0x3129,0x3adb,0x3bdd,0xae81,0x30ea,0x3b0c,
+    0x3be2,0xae3d,0x30a6,0x3b3c,0x3be6,0xadec,0x305e,0x3b69,0x3be5,0xad9e,0x3016,0x3b94,0x3be9,0xad3d,0x2f91,0x3bbe,
+    0x3be7,0xacdf,0x2ef4,0x3be6,0x3bea,0xac78,0x2e56,0x3c05,0x3bed,0xac0d,0x2db2,0x3c17,0x3bec,0xab3c,0x2d0f,0x3c27,
+    0x3bef,0xaa57,0x2c69,0x3c37,0x3bf1,0xa972,0x2b8a,0x3c45,0x3bf4,0xa885,0x2a3b,0x3c52,0x3bf7,0xa73a,0x28f0,0x3c5e,
+    0x3bfa,0xa55d,0x2753,0x3c69,0x3bfd,0xa322,0x24d5,0x3c73,0x3bff,0x9ee5,0x20ba,0x3c7d,0x3c00,0x08b1,0x8868,0x3c85,
+    0x3b77,0x804f,0x338b,0x013a,0x3b85,0x87d8,0x339a,0x0fc3,0x3b85,0x8fd8,0x339a,0x17c3,0x3b85,0x946a,0x339a,0x1c5d,
+    0x3b85,0x97d8,0x339a,0x1fc3,0x3b85,0x9a21,0x339a,0x2210,0x3b85,0x9c6a,0x339a,0x245e,0x3b85,0x9e02,0x339a,0x25f1,
+    0x3b85,0x9fd8,0x339a,0x27c3,0x3b85,0xa0f7,0x339a,0x28e9,0x3b85,0xa221,0x339a,0x2a10,0x3b85,0xa36b,0x339a,0x2b57,
+    0x3b85,0xa46a,0x339a,0x2c5e,0x3b85,0xa52e,0x339a,0x2d20,0x3b85,0xa602,0x339a,0x2df2,0x3b86,0xa6e5,0x339b,0x2ed4,
+    0x3b86,0xa7d9,0x339b,0x2fc5,0x3b86,0xa86e,0x339b,0x3063,0x3b86,0xa8f6,0x339b,0x30ec,0x3b87,0xa981,0x339b,0x317c,
+    0x3b87,0xa9f4,0x339a,0x3210,0x3b87,0xaa78,0x3399,0x32ad,0x3b88,0xab0c,0x3399,0x3351,0x3b88,0xabb2,0x3399,0x33fa,
+    0x3b89,0xac37,0x3399,0x3454,0x3b8a,0xaca0,0x339a,0x34ac,0x3b8b,0xacf1,0x3399,0x350b,0x3b8c,0xad38,0x3396,0x356f,
+    0x3b8d,0xad88,0x3393,0x35d6,0x3b8e,0xadd5,0x338f,0x363f,0x3b90,0xae19,0x338a,0x36aa,0x3b93,0xae65,0x3384,0x3716,
+    0x3b94,0xaeb5,0x337e,0x3783,0x3b98,0xaefe,0x3377,0x37f0,0x3b9b,0xaf3d,0x336d,0x3831,0x3b9f,0xaf6b,0x335d,0x386b,
+    0x3ba4,0xaf95,0x334d,0x38a5,0x3ba8,0xafc1,0x3339,0x38df,0x3baf,0xafe6,0x3323,0x3918,0x3bb4,0xaff9,0x3305,0x3953,
+    0x3bba,0xaffc,0x32e3,0x398d,0x3bbf,0xb000,0x32bc,0x39c5,0x3be9,0xb002,0x32b4,0x3a04,0x3bc9,0xafde,0x325c,0x3a35,
+    0x3bd1,0xafbf,0x3225,0x3a6c,0x3bd7,0xaf97,0x31e9,0x3aa1,0x3bd8,0xaf5e,0x31a5,0x3ad4,0x3bde,0xaf1c,0x315f,0x3b06,
+    0x3bde,0xaed6,0x3116,0x3b36,0x3be2,0xae7e,0x30c7,0x3b64,0x3be4,0xae25,0x3078,0x3b91,0x3be4,0xadc2,0x3024,0x3bbb,
+    0x3be6,0xad55,0x2f9d,0x3be3,0x3be7,0xace9,0x2eee,0x3c04,0x3bea,0xac70,0x2e40,0x3c16,0x3beb,0xabf3,0x2d8c,0x3c27,
+    0x3bec,0xaaf7,0x2cd5,0x3c36,0x3bf0,0xa9fc,0x2c22,0x3c44,0x3bf2,0xa8f7,0x2ad6,0x3c52,0x3bf5,0xa7ee,0x296c,0x3c5e,
+    0x3bf9,0xa5e5,0x2808,0x3c69,0x3bfc,0xa3c9,0x2548,0x3c74,0x3bfe,0x9fa0,0x2132,0x3c7d,0x3c00,0x0beb,0x87b4,0x3c86,
+    0x3b5f,0x8056,0x3415,0x0138,0x3b6e,0x883f,0x341e,0x0fab,0x3b6e,0x903f,0x341e,0x17ab,0x3b6e,0x94c7,0x341e,0x1c50,
+    0x3b6e,0x983f,0x341e,0x1fab,0x3b6e,0x9aa3,0x341e,0x21fe,0x3b6e,0x9cc7,0x341e,0x2450,0x3b6e,0x9e81,0x341e,0x25df,
+    0x3b6e,0xa03f,0x341e,0x27ab,0x3b6e,0xa160,0x341e,0x28da,0x3b6e,0xa2a3,0x341e,0x29fe,0x3b6e,0xa404,0x341e,0x2b40,
+    0x3b6e,0xa4c7,0x341e,0x2c51,0x3b6e,0xa59c,0x341e,0x2d11,0x3b6f,0xa681,0x341e,0x2de0,0x3b6f,0xa777,0x341e,0x2ebf,
+    0x3b6f,0xa83f,0x341e,0x2fae,0x3b6f,0xa8cb,0x341e,0x3056,0x3b70,0xa95e,0x341e,0x30dd,0x3b70,0xa9f3,0x341e,0x316b,
+    0x3b70,0xaa72,0x341e,0x31fe,0x3b71,0xab05,0x341d,0x3299,0x3b71,0xaba8,0x341d,0x333c,0x3b72,0xac2d,0x341d,0x33e4,
+    0x3b73,0xac8f,0x341d,0x3448,0x3b74,0xacfa,0x341e,0x34a0,0x3b75,0xad54,0x341d,0x34fc,0x3b76,0xada8,0x341c,0x355f,
+    0x3b77,0xadff,0x341a,0x35c5,0x3b79,0xae52,0x3418,0x362e,0x3b7c,0xae9b,0x3416,0x3698,0x3b7e,0xaeed,0x3413,0x3703,
+    0x3b81,0xaf3f,0x340f,0x3770,0x3b86,0xaf8e,0x340c,0x37dd,0x3b89,0xafda,0x3407,0x3827,0x3b9f,0xb003,0x3407,0x3860,
+    0x3b94,0xb01c,0x33ec,0x389b,0x3b99,0xb031,0x33d6,0x38d5,0x3ba2,0xb046,0x33be,0x390e,0x3ba8,0xb052,0x33a0,0x3948,
+    0x3bb0,0xb055,0x337a,0x3983,0x3bb8,0xb054,0x334f,0x39bc,0x3bc1,0xb052,0x3321,0x39f4,0x3bcb,0xb046,0x32ea,0x3a2e,
+    0x3bcd,0xb033,0x32ab,0x3a64,0x3bd7,0xb01c,0x326a,0x3a99,0x3be2,0xaffc,0x3226,0x3ac9,0x3bda,0xafb7,0x31d4,0x3aff,
+    0x3be1,0xaf6b,0x3184,0x3b30,0x3bde,0xaf0f,0x312f,0x3b5e,0x3be4,0xaeaa,0x30d6,0x3b8c,0x3be5,0xae43,0x307c,0x3bb6,
+    0x3be3,0xadcc,0x3020,0x3bde,0x3be6,0xad54,0x2f86,0x3c03,0x3be6,0xacd4,0x2ec5,0x3c15,0x3be9,0xac50,0x2e06,0x3c26,
+    0x3beb,0xab96,0x2d41,0x3c35,0x3bed,0xaa7e,0x2c7d,0x3c44,0x3bf1,0xa96c,0x2b73,0x3c52,0x3bf3,0xa84d,0x29e7,0x3c5e,
+    0x3bf8,0xa674,0x2864,0x3c69,0x3bfb,0xa439,0x25bf,0x3c74,0x3bfe,0xa02f,0x21ac,0x3c7e,0x3c00,0x0cce,0x8a10,0x3c87,
+    0x3b29,0x805c,0x3452,0x0131,0x3b56,0x8891,0x346c,0x0f92,0x3b55,0x9090,0x346c,0x1791,0x3b55,0x9522,0x346c,0x1c42,
+    0x3b55,0x9890,0x346c,0x1f91,0x3b55,0x9b22,0x346c,0x21ea,0x3b55,0x9d22,0x346c,0x2442,0x3b55,0x9efd,0x346c,0x25cb,
+    0x3b55,0xa090,0x346c,0x2792,0x3b55,0xa1c7,0x346c,0x28ca,0x3b55,0xa322,0x346c,0x29ea,0x3b56,0xa450,0x346c,0x2b28,
+    0x3b56,0xa522,0x346c,0x2c42,0x3b56,0xa607,0x346c,0x2d00,0x3b56,0xa6fd,0x346c,0x2dcd,0x3b56,0xa803,0x346c,0x2ea9,
+    0x3b56,0xa890,0x346d,0x2f94,0x3b57,0xa926,0x346d,0x3048,0x3b57,0xa9c4,0x346d,0x30cd,0x3b57,0xaa5f,0x346d,0x3159,
+    0x3b58,0xaaec,0x346c,0x31ea,0x3b59,0xab90,0x346c,0x3284,0x3b59,0xac20,0x346c,0x3325,0x3b5a,0xac7f,0x346c,0x33cb,
+    0x3b5b,0xace5,0x346c,0x343b,0x3b5c,0xad51,0x346c,0x3492,0x3b5d,0xadb7,0x346c,0x34ec,0x3b5f,0xae15,0x346b,0x354e,
+    0x3b60,0xae73,0x346a,0x35b3,0x3b62,0xaec9,0x3467,0x361b,0x3b66,0xaf1b,0x3465,0x3684,0x3b69,0xaf72,0x3462,0x36ef,
+    0x3b6c,0xafc5,0x345e,0x375b,0x3b72,0xb00d,0x345b,0x37c9,0x3b76,0xb036,0x3456,0x381c,0x3b7e,0xb053,0x344e,0x3856,
+    0x3b83,0xb06c,0x3444,0x388f,0x3b8d,0xb081,0x3439,0x38ca,0x3b94,0xb096,0x342c,0x3904,0x3ba0,0xb0a6,0x341c,0x393e,
+    0x3ba7,0xb0aa,0x3408,0x3978,0x3bb1,0xb0a9,0x33e3,0x39b2,0x3bb8,0xb0a4,0x33ad,0x39ea,0x3bc4,0xb09c,0x3375,0x3a23,
+    0x3bca,0xb085,0x3331,0x3a5b,0x3bcf,0xb06d,0x32e9,0x3a90,0x3bd7,0xb050,0x329c,0x3ac6,0x3be0,0xb026,0x324f,0x3af4,
+    0x3bdf,0xaff9,0x31f2,0x3b28,0x3be3,0xaf9f,0x3194,0x3b59,0x3bde,0xaf2f,0x3136,0x3b86,0x3be2,0xaebd,0x30d4,0x3bb1,
+    0x3be5,0xae43,0x3072,0x3bdc,0x3be3,0xadbe,0x300d,0x3c01,0x3be6,0xad39,0x2f4e,0x3c13,0x3be5,0xaca8,0x2e7f,0x3c25,
+    0x3be7,0xac17,0x2dad,0x3c34,0x3beb,0xab04,0x2cd7,0x3c44,0x3bee,0xa9d9,0x2c05,0x3c51,0x3bf2,0xa8aa,0x2a64,0x3c5e,
+    0x3bf6,0xa6f5,0x28be,0x3c6a,0x3bfa,0xa499,0x263d,0x3c74,0x3bfe,0xa07f,0x2224,0x3c7e,0x3c00,0x0c45,0x88b2,0x3c87,
+    0x3aff,0x8062,0x3492,0x012c,0x3b3b,0x88df,0x34b8,0x0f76,0x3b3a,0x90df,0x34b8,0x1776,0x3b3b,0x957b,0x34b8,0x1c32,
+    0x3b3b,0x98df,0x34b8,0x1f76,0x3b3b,0x9b9d,0x34b8,0x21d4,0x3b3b,0x9d7b,0x34b8,0x2432,0x3b3b,0x9f76,0x34b8,0x25b6,
+    0x3b3b,0xa0df,0x34b9,0x2776,0x3b3b,0xa22a,0x34b9,0x28b9,0x3b3b,0xa39d,0x34b9,0x29d5,0x3b3b,0xa49b,0x34b9,0x2b0e,
+    0x3b3b,0xa57b,0x34b9,0x2c33,0x3b3b,0xa66e,0x34b9,0x2cee,0x3b3b,0xa775,0x34b9,0x2db8,0x3b3c,0xa848,0x34b9,0x2e91,
+    0x3b3c,0xa8df,0x34b9,0x2f79,0x3b3c,0xa97f,0x34b9,0x3038,0x3b3d,0xaa26,0x34b9,0x30bb,0x3b3d,0xaac6,0x34b9,0x3145,
+    0x3b3e,0xab65,0x34b9,0x31d5,0x3b3e,0xac0b,0x34b9,0x326d,0x3b3f,0xac69,0x34b9,0x330c,0x3b40,0xacce,0x34b9,0x33b1,
+    0x3b41,0xad39,0x34b9,0x342d,0x3b42,0xada5,0x34b9,0x3484,0x3b44,0xae16,0x34b9,0x34db,0x3b46,0xae7f,0x34b8,0x353c,
+    0x3b47,0xaee3,0x34b7,0x35a0,0x3b4b,0xaf3c,0x34b5,0x3606,0x3b4e,0xaf98,0x34b2,0x366f,0x3b51,0xaff4,0x34af,0x36da,
+    0x3b57,0xb024,0x34ac,0x3746,0x3b5c,0xb051,0x34a7,0x37b3,0x3b62,0xb07c,0x34a2,0x3810,0x3b6c,0xb0a0,0x349c,0x3849,
+    0x3b71,0xb0b8,0x3491,0x3883,0x3b7d,0xb0cf,0x3486,0x38be,0x3b86,0xb0e4,0x3476,0x38f8,0x3b9c,0xb0f6,0x346a,0x3933,
+    0x3ba7,0xb0fd,0x3455,0x396c,0x3ba6,0xb0fb,0x343a,0x39a6,0x3bb2,0xb0f4,0x341e,0x39e0,0x3bb8,0xb0ea,0x33fd,0x3a17,
+    0x3bc2,0xb0d7,0x33b7,0x3a50,0x3bca,0xb0ba,0x3369,0x3a86,0x3bd3,0xb09b,0x3317,0x3abc,0x3bd8,0xb076,0x32bd,0x3af0,
+    0x3bda,0xb045,0x325d,0x3b23,0x3be1,0xb013,0x31fa,0x3b51,0x3be4,0xafb6,0x3193,0x3b81,0x3be0,0xaf37,0x312b,0x3bac,
+    0x3be2,0xaeb7,0x30c0,0x3bd6,0x3be4,0xae2a,0x3054,0x3c00,0x3be3,0xad97,0x2fd2,0x3c12,0x3be7,0xad04,0x2ef7,0x3c24,
+    0x3be5,0xac61,0x2e14,0x3c34,0x3be9,0xab90,0x2d34,0x3c43,0x3beb,0xaa43,0x2c4f,0x3c51,0x3bf0,0xa901,0x2ad9,0x3c5e,
+    0x3bf5,0xa772,0x2915,0x3c6a,0x3bf9,0xa4e5,0x26b2,0x3c75,0x3bfd,0xa0d9,0x229c,0x3c7f,0x3c00,0x0f55,0x8aa8,0x3c88,
+    0x3b22,0x8069,0x3505,0x012b,0x3b20,0x892c,0x3504,0x0f5a,0x3b1e,0x912b,0x3502,0x1759,0x3b1e,0x95d1,0x3502,0x1c22,
+    0x3b1e,0x992b,0x3502,0x1f59,0x3b1e,0x9c0a,0x3502,0x21bd,0x3b1e,0x9dd1,0x3502,0x2422,0x3b1e,0x9feb,0x3502,0x25a0,
+    0x3b1e,0xa12b,0x3502,0x2759,0x3b1e,0xa28b,0x3502,0x28a6,0x3b1f,0xa40a,0x3503,0x29be,0x3b1f,0xa4e3,0x3503,0x2af3,
+    0x3b1f,0xa5d1,0x3503,0x2c22,0x3b1f,0xa6d3,0x3503,0x2cda,0x3b1f,0xa7ea,0x3503,0x2da1,0x3b1f,0xa88b,0x3503,0x2e77,
+    0x3b20,0xa92b,0x3503,0x2f5c,0x3b20,0xa9d4,0x3503,0x3028,0x3b21,0xaa85,0x3503,0x30a9,0x3b21,0xab2a,0x3503,0x3130,
+    0x3b22,0xabd9,0x3503,0x31bf,0x3b23,0xac4c,0x3503,0x3255,0x3b23,0xacb1,0x3503,0x32f2,0x3b24,0xad1b,0x3503,0x3395,
+    0x3b26,0xad8a,0x3503,0x341e,0x3b27,0xadf6,0x3503,0x3474,0x3b29,0xae6f,0x3503,0x34cb,0x3b2b,0xaee5,0x3503,0x3528,
+    0x3b36,0xaf4d,0x3507,0x358b,0x3b31,0xafae,0x3500,0x35f1,0x3b35,0xb009,0x34fe,0x3659,0x3b39,0xb038,0x34fa,0x36c3,
+    0x3b3f,0xb065,0x34f7,0x372f,0x3b45,0xb094,0x34f3,0x379b,0x3b50,0xb0bf,0x34ef,0x3805,0x3b58,0xb0e9,0x34e8,0x383d,
+    0x3b63,0xb104,0x34dd,0x3877,0x3b6c,0xb11c,0x34d1,0x38b1,0x3b7c,0xb131,0x34c2,0x38ed,0x3b84,0xb142,0x34b0,0x3926,
+    0x3b92,0xb14d,0x349d,0x3960,0x3b9b,0xb14b,0x3481,0x399a,0x3ba8,0xb143,0x3466,0x39d4,0x3bb1,0xb137,0x3443,0x3a0c,
+    0x3bb9,0xb126,0x341f,0x3a43,0x3bc3,0xb107,0x33ec,0x3a7b,0x3bcd,0xb0e4,0x3392,0x3ab1,0x3bd2,0xb0bd,0x3332,0x3ae6,
+    0x3bda,0xb08c,0x32cc,0x3b1a,0x3bdb,0xb055,0x3260,0x3b4a,0x3be2,0xb01b,0x31f3,0x3b79,0x3be5,0xafb2,0x3183,0x3ba7,
+    0x3bdf,0xaf23,0x310f,0x3bd0,0x3be3,0xae98,0x309d,0x3bfb,0x3be2,0xadf3,0x3029,0x3c10,0x3be4,0xad58,0x2f6b,0x3c23,
+    0x3be8,0xacb0,0x2e7a,0x3c33,0x3be5,0xac05,0x2d8a,0x3c43,0x3beb,0xaabd,0x2c9c,0x3c51,0x3bee,0xa952,0x2b50,0x3c5e,
+    0x3bf3,0xa806,0x2973,0x3c6a,0x3bf8,0xa536,0x2726,0x3c75,0x3bfd,0xa13f,0x2314,0x3c7f,0x3c00,0x0f02,0x8a1f,0x3c89,
+    0x3b0a,0x806f,0x3551,0x0127,0x3b00,0x8976,0x354a,0x0f3a,0x3b01,0x9175,0x354a,0x173a,0x3b00,0x9624,0x354a,0x1c10,
+    0x3b00,0x9975,0x354a,0x1f3a,0x3b00,0x9c44,0x354a,0x21a5,0x3b00,0x9e24,0x354a,0x2410,0x3b00,0xa02e,0x354a,0x2588,
+    0x3b00,0xa175,0x354a,0x273a,0x3b00,0xa2e8,0x354a,0x2893,0x3b01,0xa443,0x354a,0x29a5,0x3b01,0xa529,0x354a,0x2ad5,
+    0x3b01,0xa623,0x354a,0x2c11,0x3b01,0xa734,0x354a,0x2cc6,0x3b01,0xa82d,0x354a,0x2d8a,0x3b01,0xa8cb,0x354b,0x2e5c,
+    0x3b02,0xa974,0x354b,0x2f3d,0x3b02,0xaa27,0x354b,0x3016,0x3b03,0xaae0,0x354b,0x3095,0x3b03,0xab8d,0x354b,0x311a,
+    0x3b04,0xac25,0x354b,0x31a7,0x3b05,0xac8b,0x354b,0x323b,0x3b06,0xacf5,0x354b,0x32d6,0x3b07,0xad65,0x354b,0x3377,
+    0x3b09,0xadd7,0x354b,0x340e,0x3b0a,0xae47,0x354b,0x3463,0x3b0c,0xaec6,0x354b,0x34b9,0x3b0f,0xaf47,0x354c,0x3513,
+    0x3b12,0xafb3,0x354a,0x3575,0x3b18,0xb00e,0x354a,0x35da,0x3b1a,0xb043,0x3546,0x3641,0x3b1f,0xb073,0x3544,0x36aa,
+    0x3b27,0xb0a4,0x3541,0x3716,0x3b2d,0xb0d3,0x353b,0x3782,0x3b39,0xb101,0x3538,0x37f1,0x3b45,0xb12d,0x3532,0x3830,
+    0x3b52,0xb14f,0x3529,0x386a,0x3b5c,0xb167,0x351b,0x38a4,0x3b69,0xb17b,0x350c,0x38df,0x3b79,0xb18c,0x34fc,0x391a,
+    0x3b85,0xb199,0x34e6,0x3953,0x3b93,0xb19a,0x34cc,0x398d,0x3b9a,0xb191,0x34ab,0x39c7,0x3ba7,0xb183,0x3489,0x3a00,
+    0x3bb3,0xb170,0x3463,0x3a38,0x3bba,0xb154,0x3436,0x3a6f,0x3bc5,0xb12d,0x3407,0x3aa7,0x3bcd,0xb102,0x33a8,0x3adb,
+    0x3bd2,0xb0d2,0x333a,0x3b0f,0x3bdc,0xb098,0x32cb,0x3b42,0x3bdb,0xb057,0x3250,0x3b71,0x3be0,0xb018,0x31d8,0x3ba1,
+    0x3be2,0xaf91,0x315a,0x3bcb,0x3be1,0xaefc,0x30e3,0x3bf8,0x3be1,0xae58,0x306a,0x3c0f,0x3be2,0xada8,0x2fdb,0x3c22,
+    0x3be1,0xacff,0x2ee3,0x3c32,0x3be5,0xac42,0x2de1,0x3c42,0x3be8,0xab23,0x2ce4,0x3c51,0x3bed,0xa9ab,0x2bc8,0x3c5e,
+    0x3bf2,0xa83f,0x29cc,0x3c6a,0x3bf8,0xa59f,0x279d,0x3c75,0x3bfc,0xa182,0x2382,0x3c80,0x3c00,0x0c19,0x8814,0x3c89,
+    0x3afa,0x8076,0x35a4,0x0123,0x3ade,0x89bc,0x358d,0x0f18,0x3ae1,0x91bc,0x358f,0x1719,0x3ae1,0x9674,0x358f,0x1bfc,
+    0x3ae1,0x99bc,0x358f,0x1f19,0x3ae1,0x9c7b,0x358f,0x218c,0x3ae1,0x9e74,0x358f,0x23fc,0x3ae1,0xa064,0x358f,0x256f,
+    0x3ae1,0xa1bc,0x358f,0x2719,0x3ae1,0xa342,0x358f,0x287e,0x3ae1,0xa47b,0x358f,0x298c,0x3ae1,0xa56c,0x358f,0x2ab6,
+    0x3ae1,0xa673,0x358f,0x2bfd,0x3ae1,0xa792,0x358f,0x2cb0,0x3ae2,0xa863,0x358f,0x2d71,0x3ae2,0xa909,0x358f,0x2e3f,
+    0x3ae2,0xa9ba,0x3590,0x2f1c,0x3ae3,0xaa76,0x3590,0x3004,0x3ae3,0xab37,0x3590,0x3081,0x3ae4,0xabee,0x3590,0x3103,
+    0x3ae5,0xac5c,0x3590,0x318e,0x3ae6,0xacc7,0x3590,0x3220,0x3ae7,0xad38,0x3590,0x32b8,0x3ae8,0xadad,0x3590,0x3357,
+    0x3aea,0xae21,0x3590,0x33fb,0x3aec,0xae96,0x3590,0x3451,0x3aee,0xaf1a,0x3591,0x34a7,0x3af1,0xafa2,0x3592,0x34fe,
+    0x3af5,0xb00a,0x3591,0x355e,0x3afa,0xb043,0x3590,0x35c2,0x3afe,0xb07a,0x358d,0x3628,0x3b06,0xb0ae,0x358c,0x3691,
+    0x3b0d,0xb0e0,0x3588,0x36fc,0x3b17,0xb111,0x3585,0x3769,0x3b23,0xb141,0x3580,0x37d6,0x3b32,0xb16e,0x357b,0x3823,
+    0x3b3f,0xb196,0x3574,0x385c,0x3b4c,0xb1b0,0x3566,0x3896,0x3b58,0xb1c5,0x3555,0x38d1,0x3b69,0xb1d6,0x3544,0x390c,
+    0x3b74,0xb1e1,0x352d,0x3946,0x3b83,0xb1e6,0x3511,0x3980,0x3b92,0xb1de,0x34f2,0x39bb,0x3b9c,0xb1ce,0x34cd,0x39f4,
+    0x3ba8,0xb1b8,0x34a5,0x3a2c,0x3bb3,0xb19d,0x3476,0x3a64,0x3bbc,0xb174,0x3443,0x3a9b,0x3bc8,0xb147,0x3410,0x3ad1,
+    0x3bcd,0xb112,0x33a8,0x3b04,0x3bd6,0xb0da,0x3333,0x3b39,0x3bdd,0xb093,0x32b3,0x3b68,0x3be1,0xb051,0x3230,0x3b9c,
+    0x3be4,0xaffe,0x31b0,0x3bc0,0x3be3,0xaf5b,0x3127,0x3bf1,0x3be0,0xaeb6,0x30a6,0x3c0d,0x3be0,0xadfc,0x3025,0x3c1f,
+    0x3bde,0xad44,0x2f45,0x3c31,0x3be2,0xac8b,0x2e39,0x3c41,0x3be6,0xab87,0x2d2c,0x3c51,0x3be9,0xaa0d,0x2c20,0x3c5e,
+    0x3bf0,0xa878,0x2a1e,0x3c6a,0x3bf6,0xa5f3,0x280b,0x3c76,0x3bfc,0xa1c5,0x23ef,0x3c80,0x3c00,0x0d97,0x8911,0x3c8a,
+    0x3a9e,0x8079,0x35b4,0x011a,0x3abf,0x8a00,0x35d0,0x0ef6,0x3abf,0x9200,0x35d1,0x16f7,0x3abf,0x96c0,0x35d1,0x1bd5,
+    0x3abf,0x9a00,0x35d1,0x1ef7,0x3abf,0x9cb0,0x35d1,0x2171,0x3abf,0x9ec0,0x35d1,0x23d5,0x3abf,0xa098,0x35d1,0x2555,
+    0x3abf,0xa200,0x35d1,0x26f7,0x3abf,0xa398,0x35d1,0x2868,0x3abf,0xa4b0,0x35d1,0x2971,0x3ac0,0xa5ac,0x35d1,0x2a96,
+    0x3ac0,0xa6c0,0x35d1,0x2bd7,0x3ac0,0xa7eb,0x35d1,0x2c9a,0x3ac0,0xa897,0x35d1,0x2d56,0x3ac1,0xa945,0x35d1,0x2e21,
+    0x3ac1,0xa9fe,0x35d2,0x2efa,0x3ac2,0xaac2,0x35d2,0x2fe1,0x3ac2,0xab87,0x35d2,0x306b,0x3ac3,0xac25,0x35d2,0x30ec,
+    0x3ac4,0xac90,0x35d2,0x3174,0x3ac5,0xad01,0x35d3,0x3203,0x3ac6,0xad77,0x35d3,0x3299,0x3ac8,0xadf1,0x35d3,0x3335,
+    0x3aca,0xae67,0x35d3,0x33d6,0x3acd,0xaee4,0x35d4,0x343e,0x3acf,0xaf6a,0x35d4,0x3493,0x3ad2,0xaff5,0x35d4,0x34e9,
+    0x3ad8,0xb03a,0x35d6,0x3547,0x3adc,0xb076,0x35d4,0x35a9,0x3ae1,0xb0af,0x35d2,0x360e,0x3aeb,0xb0e6,0x35d1,0x3677,
+    0x3af3,0xb11b,0x35ce,0x36e1,0x3b00,0xb14e,0x35cc,0x374d,0x3b0c,0xb17f,0x35c7,0x37bb,0x3b29,0xb1b0,0x35cb,0x3817,
+    0x3b28,0xb1d7,0x35bb,0x384d,0x3b39,0xb1f7,0x35b0,0x3888,0x3b45,0xb20b,0x359d,0x38c2,0x3b57,0xb21d,0x358c,0x38fe,
+    0x3b69,0xb227,0x3576,0x3938,0x3b74,0xb22c,0x3559,0x3972,0x3b83,0xb228,0x3539,0x39ad,0x3b90,0xb216,0x3511,0x39e7,
+    0x3b9e,0xb1ff,0x34e6,0x3a21,0x3bab,0xb1e3,0x34b6,0x3a58,0x3bb4,0xb1ba,0x3480,0x3a8f,0x3bbf,0xb18b,0x3448,0x3ac7,
+    0x3bc8,0xb152,0x340b,0x3af9,0x3bd1,0xb118,0x3399,0x3b2e,0x3bd5,0xb0d1,0x3310,0x3b60,0x3be5,0xb083,0x328e,0x3b8d,
+    0x3be0,0xb039,0x31fa,0x3bc0,0x3bdd,0xafbf,0x316e,0x3beb,0x3bdd,0xaf0d,0x30e3,0x3c0b,0x3bde,0xae54,0x305c,0x3c1e,
+    0x3bdf,0xad8b,0x2fa2,0x3c30,0x3bdf,0xacc6,0x2e8f,0x3c41,0x3be4,0xabf5,0x2d74,0x3c50,0x3be7,0xaa58,0x2c58,0x3c5e,
+    0x3bee,0xa8c4,0x2a7a,0x3c6b,0x3bf6,0xa642,0x2844,0x3c77,0x3bfb,0xa238,0x2438,0x3c81,0x3c00,0x0d3d,0x8a1e,0x3c8b,
+    0x3a96,0x807f,0x360a,0x0116,0x3a9d,0x8a41,0x3610,0x0ed3,0x3a9c,0x9241,0x3610,0x16d3,0x3a9c,0x9709,0x3610,0x1bad,
+    0x3a9c,0x9a41,0x3610,0x1ed3,0x3a9c,0x9ce3,0x3610,0x2155,0x3a9c,0x9f09,0x3610,0x23ad,0x3a9c,0xa0ca,0x3610,0x2539,
+    0x3a9c,0xa241,0x3610,0x26d3,0x3a9c,0xa3ea,0x3610,0x2851,0x3a9d,0xa4e3,0x3610,0x2955,0x3a9d,0xa5e9,0x3610,0x2a74,
+    0x3a9d,0xa708,0x3610,0x2bae,0x3a9d,0xa820,0x3610,0x2c82,0x3a9d,0xa8c9,0x3610,0x2d3b,0x3a9e,0xa97e,0x3610,0x2e02,
+    0x3a9e,0xaa3e,0x3611,0x2ed6,0x3a9f,0xab0a,0x3611,0x2fb9,0x3aa0,0xabd2,0x3611,0x3054,0x3aa0,0xac52,0x3612,0x30d3,
+    0x3aa1,0xacc2,0x3612,0x3158,0x3aa3,0xad38,0x3612,0x31e5,0x3aa4,0xadb3,0x3612,0x3278,0x3aa6,0xae31,0x3613,0x3312,
+    0x3aa8,0xaeaa,0x3613,0x33b1,0x3aab,0xaf2d,0x3613,0x342a,0x3aad,0xafb7,0x3614,0x347e,0x3ab1,0xb022,0x3615,0x34d4,
+    0x3ab9,0xb067,0x3617,0x352e,0x3abd,0xb0a6,0x3616,0x358f,0x3ac6,0xb0e2,0x3616,0x35f3,0x3acf,0xb11d,0x3615,0x365b,
+    0x3ad8,0xb152,0x3612,0x36c4,0x3ae7,0xb188,0x3611,0x3731,0x3af3,0xb1ba,0x360d,0x379e,0x3b05,0xb1ea,0x360a,0x3807,
+    0x3b16,0xb216,0x3604,0x383f,0x3b26,0xb23b,0x35fa,0x3879,0x3b38,0xb251,0x35ea,0x38b4,0x3b45,0xb261,0x35d3,0x38ef,
+    0x3b58,0xb26d,0x35bd,0x392b,0x3b67,0xb271,0x359f,0x3965,0x3b75,0xb26e,0x357c,0x399e,0x3b88,0xb260,0x3556,0x39db,
+    0x3b93,0xb242,0x3526,0x3a13,0x3ba0,0xb225,0x34f4,0x3a4c,0x3bac,0xb1ff,0x34be,0x3a83,0x3bb6,0xb1cd,0x3482,0x3abb,
+    0x3bc0,0xb191,0x3441,0x3aef,0x3bcb,0xb153,0x33fd,0x3b24,0x3bcf,0xb10e,0x3371,0x3b57,0x3bd9,0xb0bd,0x32de,0x3b8a,
+    0x3bdc,0xb06b,0x3249,0x3bba,0x3be0,0xb014,0x31b4,0x3be7,0x3bdd,0xaf63,0x311e,0x3c08,0x3bdd,0xaea2,0x3090,0x3c1d,
+    0x3bdf,0xadd8,0x3003,0x3c2f,0x3bde,0xad02,0x2ee0,0x3c40,0x3be1,0xac33,0x2dbe,0x3c50,0x3be7,0xaaa9,0x2c92,0x3c5e,
+    0x3bed,0xa8fd,0x2ad1,0x3c6b,0x3bf4,0xa69b,0x287e,0x3c77,0x3bfb,0xa274,0x2469,0x3c82,0x3c00,0x0c8b,0x88dc,0x3c8c,
+    0x3a6d,0x8084,0x3641,0x010f,0x3a78,0x8a7f,0x364b,0x0ead,0x3a78,0x927f,0x364b,0x16ad,0x3a78,0x974f,0x364b,0x1b83,
+    0x3a78,0x9a7f,0x364b,0x1ead,0x3a78,0x9d13,0x364b,0x2137,0x3a78,0x9f4f,0x364b,0x2383,0x3a78,0xa0f9,0x364b,0x251d,
+    0x3a78,0xa27f,0x364b,0x26ad,0x3a78,0xa41c,0x364b,0x283a,0x3a78,0xa513,0x364b,0x2938,0x3a78,0xa623,0x364c,0x2a50,
+    0x3a79,0xa74e,0x364c,0x2b84,0x3a79,0xa849,0x364c,0x2c69,0x3a79,0xa8f8,0x364c,0x2d1e,0x3a7a,0xa9b3,0x364c,0x2de1,
+    0x3a7a,0xaa7b,0x364d,0x2eb1,0x3a7b,0xab4e,0x364d,0x2f8f,0x3a7b,0xac0e,0x364d,0x303c,0x3a7c,0xac7c,0x364e,0x30b9,
+    0x3a7d,0xacf1,0x364e,0x313c,0x3a7f,0xad6d,0x364e,0x31c6,0x3a80,0xaded,0x364f,0x3256,0x3a82,0xae6d,0x364f,0x32ed,
+    0x3a85,0xaeec,0x3650,0x3389,0x3a88,0xaf74,0x3650,0x3416,0x3a8a,0xb000,0x3651,0x3468,0x3a91,0xb047,0x3653,0x34bd,
+    0x3a97,0xb091,0x3655,0x3514,0x3a9d,0xb0d4,0x3655,0x3573,0x3aa8,0xb112,0x3657,0x35d7,0x3ab1,0xb14f,0x3656,0x363e,
+    0x3abf,0xb188,0x3657,0x36a7,0x3acb,0xb1c0,0x3654,0x3713,0x3add,0xb1f4,0x3654,0x3781,0x3aeb,0xb224,0x364e,0x37ef,
+    0x3aff,0xb252,0x3649,0x3831,0x3b0f,0xb27a,0x3640,0x386a,0x3b22,0xb294,0x3630,0x38a5,0x3b37,0xb2a6,0x361d,0x38e1,
+    0x3b47,0xb2b0,0x3603,0x391c,0x3b5a,0xb2b6,0x35e5,0x3958,0x3b83,0xb2b2,0x35d8,0x3992,0x3b79,0xb2a5,0x3598,0x39cc,
+    0x3b8a,0xb288,0x356a,0x3a06,0x3b96,0xb268,0x3533,0x3a41,0x3ba2,0xb23e,0x34f8,0x3a77,0x3bb0,0xb20f,0x34bc,0x3ab0,
+    0x3bbe,0xb1d1,0x347b,0x3ae7,0x3bc4,0xb18e,0x3431,0x3b1c,0x3bc9,0xb146,0x33cd,0x3b4f,0x3bd2,0xb0f5,0x3332,0x3b81,
+    0x3bdb,0xb09b,0x3298,0x3bb1,0x3bde,0xb043,0x31fc,0x3be3,0x3bde,0xafbf,0x315c,0x3c06,0x3bdd,0xaeee,0x30c3,0x3c1b,
+    0x3bdb,0xae1f,0x3032,0x3c2e,0x3bdc,0xad40,0x2f34,0x3c3f,0x3bdf,0xac61,0x2dff,0x3c50,0x3be3,0xab08,0x2ccc,0x3c5e,
+    0x3beb,0xa938,0x2b25,0x3c6c,0x3bf3,0xa6f6,0x28bb,0x3c78,0x3bfb,0xa2cb,0x24a1,0x3c83,0x3c00,0x0f1b,0x8aea,0x3c8d,
+    0x3a68,0x808b,0x369a,0x010d,0x3a52,0x8ab9,0x3684,0x0e86,0x3a52,0x92b9,0x3684,0x1686,0x3a52,0x9791,0x3684,0x1b57,
+    0x3a52,0x9ab9,0x3684,0x1e86,0x3a52,0x9d41,0x3684,0x2119,0x3a52,0x9f90,0x3684,0x2357,0x3a52,0xa126,0x3684,0x24ff,
+    0x3a52,0xa2b9,0x3684,0x2686,0x3a52,0xa441,0x3684,0x2821,0x3a52,0xa540,0x3684,0x2919,0x3a53,0xa65a,0x3684,0x2a2b,
+    0x3a53,0xa78f,0x3684,0x2b58,0x3a53,0xa86f,0x3684,0x2c50,0x3a53,0xa924,0x3685,0x2d00,0x3a54,0xa9e6,0x3685,0x2dbf,
+    0x3a54,0xaab5,0x3686,0x2e8a,0x3a55,0xab8e,0x3686,0x2f63,0x3a56,0xac31,0x3686,0x3024,0x3a57,0xaca4,0x3687,0x309e,
+    0x3a58,0xad1e,0x3687,0x311e,0x3a59,0xad9e,0x3688,0x31a5,0x3a5b,0xae22,0x3688,0x3233,0x3a5d,0xaea5,0x3689,0x32c7,
+    0x3a60,0xaf2a,0x3689,0x3361,0x3a63,0xafb7,0x368a,0x3400,0x3a67,0xb023,0x368b,0x3452,0x3a6d,0xb06b,0x368e,0x34a6,
+    0x3a74,0xb0b7,0x3691,0x34fb,0x3a7c,0xb0fe,0x3692,0x3557,0x3a87,0xb140,0x3695,0x35ba,0x3a92,0xb180,0x3695,0x3620,
+    0x3aa1,0xb1bb,0x3697,0x3688,0x3ab0,0xb1f4,0x3697,0x36f4,0x3ac1,0xb22b,0x3695,0x3762,0x3ade,0xb25e,0x369d,0x37d3,
+    0x3ae7,0xb28c,0x368e,0x3822,0x3afd,0xb2b6,0x3688,0x385b,0x3b0c,0xb2d4,0x3675,0x3894,0x3b21,0xb2e7,0x3661,0x38d1,
+    0x3b35,0xb2f1,0x3647,0x390d,0x3b49,0xb2f7,0x362a,0x394a,0x3b5d,0xb2f3,0x3606,0x3985,0x3b74,0xb2e9,0x35e0,0x39c0,
+    0x3b7e,0xb2cd,0x35a9,0x39fa,0x3b8e,0xb2a8,0x3574,0x3a34,0x3b9c,0xb27d,0x3536,0x3a6d,0x3bab,0xb24d,0x34f5,0x3aa5,
+    0x3bb2,0xb20e,0x34ae,0x3adb,0x3bc0,0xb1c9,0x3465,0x3b12,0x3bc5,0xb17b,0x3415,0x3b45,0x3bcb,0xb12b,0x3388,0x3b79,
+    0x3bd4,0xb0ce,0x32e9,0x3baa,0x3bdc,0xb06f,0x3245,0x3bdb,0x3bdd,0xb00d,0x319d,0x3c05,0x3bd9,0xaf3c,0x30f7,0x3c19,
+    0x3bd8,0xae60,0x305d,0x3c2d,0x3bdc,0xad82,0x2f85,0x3c3f,0x3bdd,0xac92,0x2e45,0x3c4f,0x3be2,0xab53,0x2d03,0x3c5e,
+    0x3bea,0xa97d,0x2b7b,0x3c6c,0x3bf2,0xa73b,0x28ee,0x3c78,0x3bfa,0xa32d,0x24dc,0x3c84,0x3c00,0x0e15,0x8b6a,0x3c8e,
+    0x3a1c,0x808c,0x36a9,0x0101,0x3a2b,0x8af0,0x36b9,0x0e5e,0x3a2b,0x92f0,0x36b9,0x165e,0x3a2b,0x97ce,0x36b9,0x1b29,
+    0x3a2b,0x9af0,0x36b9,0x1e5e,0x3a2b,0x9d6c,0x36b9,0x20f9,0x3a2b,0x9fce,0x36b9,0x2329,0x3a2b,0xa150,0x36b9,0x24e0,
+    0x3a2b,0xa2f0,0x36b9,0x265e,0x3a2b,0xa464,0x36b9,0x2807,0x3a2b,0xa56b,0x36b9,0x28fa,0x3a2b,0xa68e,0x36b9,0x2a05,
+    0x3a2b,0xa7cd,0x36b9,0x2b2b,0x3a2c,0xa893,0x36ba,0x2c35,0x3a2c,0xa94e,0x36ba,0x2ce2,0x3a2d,0xaa16,0x36ba,0x2d9b,
+    0x3a2d,0xaaeb,0x36bb,0x2e62,0x3a2e,0xabc8,0x36bb,0x2f35,0x3a2f,0xac53,0x36bc,0x300b,0x3a30,0xacca,0x36bc,0x3082,
+    0x3a31,0xad49,0x36bd,0x30ff,0x3a33,0xadcd,0x36bd,0x3184,0x3a35,0xae54,0x36be,0x320e,0x3a37,0xaed9,0x36bf,0x329f,
+    0x3a3a,0xaf65,0x36c0,0x3336,0x3a3d,0xaff5,0x36c0,0x33d3,0x3a42,0xb043,0x36c2,0x343a,0x3a49,0xb08d,0x36c5,0x348d,
+    0x3a50,0xb0db,0x36c9,0x34e2,0x3a5b,0xb126,0x36ce,0x353a,0x3a66,0xb16b,0x36d1,0x359c,0x3a74,0xb1ad,0x36d4,0x3601,
+    0x3a82,0xb1ec,0x36d5,0x3669,0x3a93,0xb227,0x36d6,0x36d5,0x3aa4,0xb25f,0x36d5,0x3742,0x3ab9,0xb292,0x36d4,0x37b2,
+    0x3acb,0xb2c1,0x36cd,0x3811,0x3ae2,0xb2ec,0x36c6,0x384a,0x3b06,0xb311,0x36c7,0x3885,0x3b1c,0xb327,0x36b5,0x38c2,
+    0x3b26,0xb330,0x368f,0x38fd,0x3b36,0xb334,0x366a,0x393a,0x3b4b,0xb331,0x3646,0x3976,0x3b61,0xb325,0x361d,0x39b2,
+    0x3b73,0xb310,0x35eb,0x39ed,0x3b87,0xb2ea,0x35b3,0x3a29,0x3b8f,0xb2b8,0x356f,0x3a60,0x3b9f,0xb287,0x352c,0x3a99,
+    0x3bae,0xb24b,0x34e5,0x3ad1,0x3bb6,0xb201,0x3495,0x3b07,0x3bc2,0xb1b1,0x3444,0x3b3d,0x3bcc,0xb15c,0x33e4,0x3b71,
+    0x3bcd,0xb102,0x3334,0x3ba4,0x3bd6,0xb09b,0x3281,0x3bd3,0x3bda,0xb033,0x31d6,0x3c02,0x3bda,0xaf90,0x312c,0x3c17,
+    0x3bd8,0xaea2,0x308a,0x3c2b,0x3bd7,0xadb8,0x2fd3,0x3c3e,0x3bdb,0xaccb,0x2e8b,0x3c4f,0x3be0,0xaba2,0x2d38,0x3c5f,
+    0x3be7,0xa9bb,0x2bcc,0x3c6c,0x3bf1,0xa78f,0x2924,0x3c79,0x3bf9,0xa35e,0x2511,0x3c85,0x3c00,0x0d4b,0x8923,0x3c90,
+    0x39cb,0x808f,0x36ab,0x00f9,0x3a02,0x8b23,0x36eb,0x0e34,0x3a02,0x9323,0x36eb,0x1634,0x3a02,0x9804,0x36eb,0x1afa,
+    0x3a02,0x9b23,0x36eb,0x1e34,0x3a02,0x9d94,0x36eb,0x20d8,0x3a02,0xa004,0x36eb,0x22fa,0x3a02,0xa177,0x36eb,0x24c0,
+    0x3a03,0xa323,0x36eb,0x2634,0x3a03,0xa484,0x36eb,0x27da,0x3a03,0xa593,0x36eb,0x28d9,0x3a03,0xa6be,0x36eb,0x29de,
+    0x3a03,0xa803,0x36eb,0x2afc,0x3a03,0xa8b5,0x36eb,0x2c19,0x3a04,0xa975,0x36ec,0x2cc2,0x3a04,0xaa42,0x36ec,0x2d77,
+    0x3a05,0xab1d,0x36ed,0x2e38,0x3a06,0xabfc,0x36ed,0x2f06,0x3a06,0xac71,0x36ed,0x2fe1,0x3a08,0xacee,0x36ee,0x3065,
+    0x3a09,0xad70,0x36ef,0x30e0,0x3a0b,0xadf8,0x36f0,0x3161,0x3a0d,0xae82,0x36f1,0x31e8,0x3a10,0xaf0b,0x36f2,0x3276,
+    0x3a13,0xaf9c,0x36f3,0x330a,0x3a16,0xb018,0x36f4,0x33a4,0x3a1c,0xb061,0x36f6,0x3422,0x3a23,0xb0ae,0x36f9,0x3473,
+    0x3a2b,0xb0fc,0x36fd,0x34c7,0x3a37,0xb14a,0x3706,0x351e,0x3a43,0xb193,0x370a,0x357c,0x3a53,0xb1d8,0x370f,0x35e1,
+    0x3a60,0xb219,0x3710,0x3648,0x3a74,0xb256,0x3714,0x36b3,0x3a86,0xb28f,0x3712,0x371f,0x3a9a,0xb2c4,0x3710,0x378f,
+    0x3ab0,0xb2f5,0x370c,0x3800,0x3ac7,0xb320,0x3705,0x383a,0x3ae0,0xb347,0x36fb,0x3874,0x3af5,0xb35f,0x36e7,0x38af,
+    0x3b0e,0xb36e,0x36cc,0x38ed,0x3b26,0xb36f,0x36ad,0x392a,0x3b3c,0xb36d,0x3688,0x3967,0x3b56,0xb361,0x365e,0x39a4,
+    0x3b64,0xb34a,0x3627,0x39de,0x3b79,0xb328,0x35ed,0x3a1a,0x3b8b,0xb2f7,0x35ad,0x3a56,0x3b95,0xb2be,0x3563,0x3a8d,
+    0x3ba3,0xb282,0x3518,0x3ac6,0x3bb0,0xb23a,0x34c6,0x3afc,0x3bb9,0xb1e5,0x3471,0x3b33,0x3bc4,0xb18d,0x341b,0x3b68,
+    0x3bce,0xb12f,0x3384,0x3b9b,0x3bd0,0xb0c9,0x32c9,0x3bce,0x3bd8,0xb05b,0x3218,0x3bfe,0x3bd6,0xafd4,0x3161,0x3c15,
+    0x3bdb,0xaeec,0x30b3,0x3c2a,0x3bd4,0xadef,0x3010,0x3c3e,0x3bda,0xacfb,0x2ecb,0x3c4f,0x3bdd,0xabf3,0x2d70,0x3c5e,
+    0x3be5,0xa9f0,0x2c10,0x3c6d,0x3bef,0xa7eb,0x2960,0x3c7a,0x3bf9,0xa3ba,0x2549,0x3c86,0x3c00,0x0f48,0x8ab9,0x3c91,
+    0x39cf,0x8094,0x370d,0x00f4,0x39d8,0x8b53,0x3718,0x0e08,0x39d9,0x9353,0x3719,0x1609,0x39d9,0x981f,0x3719,0x1aca,
+    0x39d9,0x9b53,0x3719,0x1e09,0x39d9,0x9db9,0x3719,0x20b7,0x39d9,0xa01f,0x3719,0x22ca,0x39d9,0xa19b,0x3719,0x249f,
+    0x39d9,0xa352,0x3719,0x2609,0x39d9,0xa4a2,0x3719,0x27a3,0x39d9,0xa5b8,0x3719,0x28b7,0x39d9,0xa6eb,0x3719,0x29b5,
+    0x39d9,0xa81d,0x3719,0x2acb,0x39da,0xa8d4,0x3719,0x2bfa,0x39da,0xa999,0x371a,0x2ca1,0x39db,0xaa6c,0x371a,0x2d51,
+    0x39db,0xab4c,0x371b,0x2e0e,0x39dc,0xac17,0x371b,0x2ed6,0x39dd,0xac8f,0x371c,0x2fac,0x39de,0xad0e,0x371c,0x3047,
+    0x39e0,0xad95,0x371d,0x30bf,0x39e1,0xae20,0x371e,0x313d,0x39e4,0xaeac,0x371f,0x31c1,0x39e7,0xaf39,0x3721,0x324c,
+    0x39ea,0xafcf,0x3722,0x32dd,0x39ee,0xb033,0x3723,0x3374,0x39f5,0xb07d,0x3727,0x3408,0x39fb,0xb0cb,0x372a,0x3459,
+    0x3a05,0xb11a,0x3730,0x34ac,0x3a14,0xb16b,0x373c,0x3502,0x3a31,0xb1bd,0x3757,0x3561,0x3a2e,0xb1ff,0x3745,0x35c0,
+    0x3a41,0xb243,0x374b,0x3627,0x3a53,0xb282,0x374d,0x3690,0x3a6a,0xb2be,0x3751,0x36fe,0x3a84,0xb2f7,0x3755,0x3770,
+    0x3a96,0xb326,0x374b,0x37df,0x3aad,0xb350,0x3743,0x3828,0x3ac6,0xb378,0x3736,0x3863,0x3ae0,0xb394,0x3727,0x389e,
+    0x3afc,0xb3a8,0x3711,0x38dd,0x3b15,0xb3a9,0x36f0,0x391a,0x3b2a,0xb3a6,0x36c5,0x3958,0x3b42,0xb39a,0x3699,0x3995,
+    0x3b57,0xb383,0x3664,0x39d1,0x3b6a,0xb363,0x3627,0x3a0d,0x3b7f,0xb333,0x35e5,0x3a49,0x3b8e,0xb2f8,0x359a,0x3a83,
+    0x3b98,0xb2b6,0x3548,0x3aba,0x3ba7,0xb26e,0x34f6,0x3af1,0x3bb5,0xb21a,0x34a0,0x3b29,0x3bb9,0xb1bc,0x3441,0x3b5f,
+    0x3bc7,0xb15b,0x33d1,0x3b93,0x3bd0,0xb0f4,0x3312,0x3bc6,0x3bdf,0xb07f,0x3261,0x3bef,0x3bd9,0xb00e,0x3195,0x3c14,
+    0x3bd3,0xaf2f,0x30e3,0x3c29,0x3bd5,0xae2c,0x3034,0x3c3d,0x3bd4,0xad27,0x2f0b,0x3c4f,0x3bdc,0xac26,0x2da7,0x3c5f,
+    0x3be3,0xaa2b,0x2c38,0x3c6d,0x3bee,0xa816,0x2991,0x3c7b,0x3bf8,0xa40c,0x2581,0x3c87,0x3c00,0x0e22,0x8b60,0x3c92,
+    0x39a0,0x8098,0x3731,0x00ed,0x39ad,0x8b7f,0x3742,0x0ddd,0x39ae,0x937e,0x3743,0x15dc,0x39ae,0x9837,0x3743,0x1a98,
+    0x39ae,0x9b7e,0x3743,0x1ddc,0x39ae,0x9ddb,0x3743,0x2094,0x39ae,0xa037,0x3743,0x2298,0x39ae,0xa1bd,0x3743,0x247d,
+    0x39ae,0xa37e,0x3743,0x25dd,0x39ae,0xa4bd,0x3743,0x276b,0x39ae,0xa5da,0x3743,0x2895,0x39ae,0xa714,0x3743,0x298b,
+    0x39ae,0xa836,0x3743,0x2a9a,0x39af,0xa8f0,0x3744,0x2bc0,0x39af,0xa9ba,0x3744,0x2c7f,0x39b0,0xaa91,0x3744,0x2d2a,
+    0x39b0,0xab76,0x3745,0x2de2,0x39b1,0xac2e,0x3746,0x2ea5,0x39b2,0xaca9,0x3746,0x2f75,0x39b4,0xad2c,0x3747,0x3029,
+    0x39b5,0xadb6,0x3748,0x309d,0x39b7,0xae44,0x3749,0x3118,0x39ba,0xaed2,0x374b,0x3199,0x39bd,0xaf64,0x374c,0x3221,
+    0x39c0,0xaffd,0x374e,0x32af,0x39c5,0xb04b,0x3750,0x3343,0x39cc,0xb098,0x3754,0x33dd,0x39d4,0xb0e6,0x3758,0x343e,
+    0x39e0,0xb137,0x3762,0x3490,0x3a00,0xb190,0x3783,0x34eb,0x39fb,0xb1da,0x3774,0x353d,0x3a09,0xb223,0x3778,0x359d,
+    0x3a1e,0xb269,0x3781,0x3604,0x3a30,0xb2a9,0x3783,0x366c,0x3a48,0xb2e8,0x3788,0x36d9,0x3a60,0xb320,0x3789,0x3749,
+    0x3a79,0xb353,0x3787,0x37bb,0x3a95,0xb381,0x3781,0x3818,0x3aae,0xb3a8,0x3775,0x3852,0x3ac9,0xb3c6,0x3764,0x388d,
+    0x3ae1,0xb3dc,0x374a,0x38c9,0x3b00,0xb3e1,0x372e,0x3909,0x3b19,0xb3dc,0x3704,0x3947,0x3b2d,0xb3cd,0x36d1,0x3984,
+    0x3b47,0xb3b8,0x369d,0x39c2,0x3b5e,0xb399,0x3662,0x39ff,0x3b76,0xb36c,0x3620,0x3a3c,0x3b83,0xb32f,0x35cf,0x3a76,
+    0x3b98,0xb2ed,0x3581,0x3ab3,0x3ba4,0xb2a0,0x3528,0x3ae9,0x3bab,0xb24d,0x34cb,0x3b1f,0x3bb7,0xb1ec,0x346c,0x3b55,
+    0x3bbd,0xb186,0x340a,0x3b8b,0x3bd2,0xb119,0x3359,0x3bba,0x3bd5,0xb0ae,0x328f,0x3bf3,0x3bd4,0xb032,0x31ca,0x3c11,
+    0x3bd8,0xaf67,0x310d,0x3c28,0x3bd3,0xae6a,0x3059,0x3c3c,0x3bd8,0xad56,0x2f4a,0x3c4f,0x3bd9,0xac48,0x2dd8,0x3c5f,
+    0x3be2,0xaa69,0x2c5f,0x3c6e,0x3bed,0xa841,0x29c9,0x3c7c,0x3bf7,0xa422,0x25af,0x3c88,0x3c00,0x0bbb,0x8975,0x3c94,
+    0x397b,0x809b,0x3761,0x00e7,0x3984,0x8ba8,0x376c,0x0db0,0x3982,0x93a6,0x376a,0x15af,0x3982,0x984d,0x3769,0x1a65,
+    0x3982,0x9ba6,0x3769,0x1daf,0x3982,0x9df9,0x3769,0x2071,0x3982,0xa04d,0x3769,0x2265,0x3982,0xa1db,0x3769,0x245a,
+    0x3982,0xa3a5,0x3769,0x25af,0x3982,0xa4d6,0x3769,0x2732,0x3982,0xa5f9,0x3769,0x2871,0x3982,0xa739,0x3769,0x2961,
+    0x3982,0xa84c,0x376a,0x2a67,0x3983,0xa90a,0x376a,0x2b84,0x3983,0xa9d7,0x376a,0x2c5d,0x3984,0xaab3,0x376b,0x2d03,
+    0x3984,0xab9b,0x376b,0x2db5,0x3986,0xac43,0x376c,0x2e73,0x3987,0xacc2,0x376d,0x2f3d,0x3988,0xad47,0x376e,0x3009,
+    0x398a,0xadd4,0x376f,0x307b,0x398c,0xae64,0x3770,0x30f3,0x398f,0xaef4,0x3772,0x3171,0x3992,0xaf8b,0x3774,0x31f5,
+    0x3996,0xb013,0x3776,0x327f,0x399b,0xb060,0x3779,0x3310,0x39a2,0xb0b0,0x377d,0x33a7,0x39ab,0xb0ff,0x3783,0x3422,
+    0x39be,0xb152,0x3795,0x3475,0x39c2,0xb1a2,0x3793,0x34c6,0x39d3,0xb1f6,0x37a0,0x351d,0x39e3,0xb243,0x37a8,0x357a,
+    0x39f8,0xb28c,0x37b1,0x35df,0x3a10,0xb2cf,0x37ba,0x3649,0x3a27,0xb30f,0x37be,0x36b4,0x3a42,0xb34a,0x37c2,0x3725,
+    0x3a6b,0xb383,0x37d2,0x379c,0x3a78,0xb3ae,0x37ba,0x3806,0x3a93,0xb3d5,0x37ae,0x3841,0x3ab2,0xb3f6,0x37a1,0x387d,
+    0x3ae6,0xb409,0x37a5,0x38bc,0x3ae6,0xb409,0x3766,0x38f6,0x3b08,0xb409,0x3744,0x3937,0x3b1f,0xb401,0x370f,0x3975,
+    0x3b3b,0xb3ec,0x36d8,0x39b5,0x3b4e,0xb3cc,0x3697,0x39f1,0x3b67,0xb3a2,0x3655,0x3a2e,0x3b7d,0xb367,0x3608,0x3a6c,
+    0x3b88,0xb31e,0x35ae,0x3aa5,0x3ba5,0xb2d0,0x3560,0x3adf,0x3ba8,0xb27a,0x34f8,0x3b16,0x3bb2,0xb21d,0x3496,0x3b4c,
+    0x3bba,0xb1b2,0x3430,0x3b83,0x3bc0,0xb142,0x338e,0x3bb8,0x3bd0,0xb0d2,0x32ca,0x3bed,0x3bd3,0xb056,0x31fe,0x3c0f,
+    0x3bd1,0xafa6,0x3138,0x3c27,0x3bd2,0xae9a,0x3079,0x3c3b,0x3bd4,0xad8b,0x2f87,0x3c4e,0x3bd8,0xac6c,0x2e0a,0x3c5f,
+    0x3be1,0xaa9c,0x2c84,0x3c6e,0x3beb,0xa86c,0x29fe,0x3c7d,0x3bf7,0xa44c,0x25e4,0x3c89,0x3c00,0x0e25,0x8b03,0x3c95,
+    0x3954,0x809f,0x378a,0x00e0,0x3955,0x8bc9,0x378b,0x0d80,0x3955,0x93c9,0x378c,0x1581,0x3955,0x9861,0x378b,0x1a31,
+    0x3955,0x9bc9,0x378b,0x1d80,0x3955,0x9e15,0x378b,0x204c,0x3955,0xa061,0x378b,0x2231,0x3955,0xa1f6,0x378b,0x2437,
+    0x3955,0xa3c8,0x378b,0x2581,0x3955,0xa4ed,0x378b,0x26f7,0x3955,0xa614,0x378b,0x284d,0x3955,0xa75a,0x378c,0x2935,
+    0x3955,0xa860,0x378c,0x2a33,0x3956,0xa921,0x378c,0x2b47,0x3956,0xa9f2,0x378c,0x2c39,0x3957,0xaad1,0x378d,0x2cda,
+    0x3958,0xabbb,0x378e,0x2d87,0x3959,0xac56,0x378f,0x2e3f,0x395a,0xacd7,0x3790,0x2f03,0x395c,0xad5f,0x3791,0x2fd3,
+    0x395d,0xadee,0x3792,0x3058,0x395f,0xae81,0x3793,0x30cc,0x3962,0xaf14,0x3795,0x3147,0x3966,0xafae,0x3798,0x31c8,
+    0x396a,0xb026,0x379a,0x324f,0x3970,0xb074,0x379e,0x32dd,0x3978,0xb0c5,0x37a3,0x3371,0x3982,0xb115,0x37ab,0x3406,
+    0x398d,0xb168,0x37b3,0x3455,0x399c,0xb1bb,0x37be,0x34a8,0x39ac,0xb20f,0x37cb,0x34fd,0x39c0,0xb261,0x37da,0x3558,
+    0x39d4,0xb2ab,0x37e2,0x35bb,0x39f0,0xb2f2,0x37ef,0x3624,0x3a05,0xb333,0x37f2,0x3690,0x3a21,0xb370,0x37f6,0x3700,
+    0x3a4a,0xb3a7,0x3802,0x3774,0x3a5d,0xb3d9,0x37f4,0x37e9,0x3a7d,0xb401,0x37ec,0x3831,0x3a94,0xb410,0x37d4,0x386b,
+    0x3ac4,0xb41e,0x37d1,0x38a9,0x3ad6,0xb424,0x37a6,0x38e7,0x3b1c,0xb429,0x37af,0x392f,0x3b0c,0xb41b,0x3746,0x3965,
+    0x3b2b,0xb40f,0x3712,0x39a6,0x3b43,0xb3fc,0x36cf,0x39e4,0x3b55,0xb3cf,0x3683,0x3a20,0x3b90,0xb39b,0x3656,0x3a5f,
+    0x3b83,0xb352,0x35e1,0x3a9b,0x3b8e,0xb2ff,0x3580,0x3ad5,0x3ba0,0xb2a8,0x3523,0x3b0c,0x3bac,0xb246,0x34bc,0x3b44,
+    0x3bb3,0xb1df,0x3454,0x3b7b,0x3bc0,0xb169,0x33d5,0x3bb1,0x3bc5,0xb0f3,0x3300,0x3be7,0x3bd4,0xb079,0x3233,0x3c0c,
+    0x3bca,0xafe3,0x315f,0x3c25,0x3bd4,0xaed1,0x309d,0x3c3b,0x3bcd,0xadb3,0x2fc3,0x3c4d,0x3bd6,0xac99,0x2e3d,0x3c60,
+    0x3bdd,0xaad6,0x2cab,0x3c6f,0x3bea,0xa88d,0x2a31,0x3c7e,0x3bf6,0xa484,0x2623,0x3c8b,0x3c00,0x0e13,0x8975,0x3c97,
+    0x3932,0x80a1,0x37b9,0x00d9,0x3926,0x8be8,0x37a8,0x0d51,0x3927,0x93e8,0x37a9,0x1551,0x3927,0x9873,0x37a9,0x19fb,
+    0x3927,0x9be8,0x37a9,0x1d51,0x3927,0x9e2d,0x37a9,0x2027,0x3927,0xa072,0x37a9,0x21fb,0x3927,0xa20d,0x37a9,0x2412,
+    0x3927,0xa3e7,0x37a9,0x2551,0x3927,0xa500,0x37a9,0x26bb,0x3927,0xa62c,0x37aa,0x2828,0x3927,0xa777,0x37aa,0x2908,
+    0x3928,0xa871,0x37aa,0x29fe,0x3928,0xa935,0x37aa,0x2b09,0x3928,0xaa09,0x37ab,0x2c15,0x3929,0xaaec,0x37ab,0x2cb1,
+    0x392a,0xabd5,0x37ac,0x2d58,0x392b,0xac66,0x37ad,0x2e0a,0x392c,0xacea,0x37ae,0x2ec9,0x392e,0xad75,0x37b0,0x2f92,
+    0x3930,0xae05,0x37b1,0x3034,0x3932,0xae98,0x37b3,0x30a5,0x3935,0xaf30,0x37b5,0x311c,0x3939,0xafcd,0x37b7,0x319a,
+    0x393e,0xb035,0x37ba,0x321d,0x3945,0xb085,0x37c0,0x32a8,0x394c,0xb0d8,0x37c5,0x3339,0x3957,0xb129,0x37cd,0x33d1,
+    0x3962,0xb17c,0x37d5,0x3436,0x3973,0xb1d1,0x37e5,0x3489,0x3984,0xb226,0x37f2,0x34dd,0x3999,0xb27a,0x3801,0x3536,
+    0x39af,0xb2c9,0x3808,0x3597,0x39cf,0xb312,0x3812,0x35ff,0x39e2,0xb354,0x3811,0x366a,0x39ff,0xb393,0x3814,0x36d9,
+    0x3a1e,0xb3c9,0x3815,0x374c,0x3a3c,0xb3fd,0x3813,0x37c2,0x3a5e,0xb414,0x3810,0x381d,0x3a7f,0xb425,0x3808,0x385a,
+    0x3a9b,0xb431,0x37f5,0x3896,0x3abd,0xb43a,0x37db,0x38d5,0x3afa,0xb43e,0x37cb,0x391a,0x3afe,0xb434,0x3784,0x3956,
+    0x3b16,0xb425,0x3744,0x3995,0x3b33,0xb415,0x3705,0x39d5,0x3b4f,0xb3ff,0x36bd,0x3a15,0x3b61,0xb3c7,0x3667,0x3a51,
+    0x3b79,0xb384,0x3612,0x3a8e,0x3b8e,0xb32f,0x35b3,0x3acb,0x3ba4,0xb2d0,0x3555,0x3b02,0x3ba5,0xb26f,0x34e2,0x3b3b,
+    0x3bb3,0xb208,0x347c,0x3b75,0x3bb8,0xb193,0x340a,0x3ba9,0x3bc8,0xb113,0x333c,0x3bde,0x3bc9,0xb096,0x3261,0x3c0a,
+    0x3bd0,0xb012,0x318d,0x3c23,0x3bca,0xaf06,0x30c3,0x3c3a,0x3bd1,0xadde,0x2ff8,0x3c4d,0x3bd1,0xacbc,0x2e6f,0x3c60,
+    0x3bdc,0xab15,0x2cd1,0x3c70,0x3be9,0xa8b2,0x2a63,0x3c7f,0x3bf6,0xa49e,0x2651,0x3c8c,0x3c00,0x0b98,0x8951,0x3c99,
+    0x38f9,0x80a4,0x37c5,0x00d2,0x38f8,0x8c01,0x37c2,0x0d21,0x38f8,0x9401,0x37c3,0x1521,0x38f8,0x9881,0x37c3,0x19c5,
+    0x38f8,0x9c01,0x37c3,0x1d21,0x38f8,0x9e42,0x37c3,0x2002,0x38f8,0xa081,0x37c3,0x21c5,0x38f8,0xa222,0x37c3,0x23db,
+    0x38f8,0xa401,0x37c3,0x2521,0x38f8,0xa511,0x37c3,0x267e,0x38f8,0xa641,0x37c3,0x2803,0x38f9,0xa790,0x37c4,0x28db,
+    0x38f9,0xa880,0x37c4,0x29c8,0x38f9,0xa947,0x37c4,0x2aca,0x38fa,0xaa1d,0x37c5,0x2be1,0x38fa,0xab02,0x37c5,0x2c87,
+    0x38fc,0xabee,0x37c6,0x2d28,0x38fd,0xac75,0x37c8,0x2dd5,0x38fe,0xacfb,0x37c9,0x2e8d,0x3900,0xad87,0x37ca,0x2f50,
+    0x3902,0xae19,0x37cc,0x3010,0x3904,0xaead,0x37ce,0x307d,0x3907,0xaf47,0x37d0,0x30f1,0x390b,0xafe6,0x37d3,0x316b,
+    0x3911,0xb043,0x37d7,0x31eb,0x3918,0xb094,0x37dd,0x3272,0x391f,0xb0e7,0x37e2,0x3300,0x392a,0xb13a,0x37eb,0x3394,
+    0x3937,0xb18e,0x37f6,0x3418,0x3949,0xb1e3,0x3803,0x3469,0x395d,0xb239,0x380c,0x34bd,0x3970,0xb28e,0x3814,0x3514,
+    0x3988,0xb2e1,0x381b,0x3571,0x39a2,0xb32b,0x3822,0x35d7,0x39bf,0xb371,0x3827,0x3642,0x39dd,0xb3b1,0x382b,0x36b1,
+    0x3a00,0xb3ec,0x382f,0x3726,0x3a28,0xb411,0x3833,0x379e,0x3a47,0xb425,0x382c,0x380a,0x3a63,0xb437,0x3822,0x3847,
+    0x3a88,0xb445,0x3819,0x3886,0x3aa9,0xb44d,0x380a,0x38c4,0x3ac4,0xb44f,0x37e6,0x3903,0x3aeb,0xb44c,0x37bb,0x3946,
+    0x3b0b,0xb43e,0x3780,0x3987,0x3b25,0xb42c,0x373b,0x39c8,0x3b3c,0xb414,0x36e9,0x3a06,0x3b56,0xb3f2,0x3697,0x3a45,
+    0x3b6d,0xb3b1,0x3640,0x3a83,0x3b7f,0xb35c,0x35df,0x3abf,0x3b95,0xb300,0x3578,0x3afd,0x3b9d,0xb296,0x3509,0x3b33,
+    0x3ba9,0xb22b,0x349a,0x3b6c,0x3bb8,0xb1b9,0x342d,0x3ba4,0x3bbe,0xb139,0x336f,0x3bd9,0x3bc9,0xb0b4,0x3291,0x3c08,
+    0x3bce,0xb02d,0x31b7,0x3c22,0x3bd2,0xaf3c,0x30e2,0x3c39,0x3bcd,0xae0d,0x301c,0x3c4d,0x3bd1,0xacd6,0x2e9c,0x3c60,
+    0x3bdb,0xab52,0x2cf9,0x3c71,0x3be7,0xa8d7,0x2a97,0x3c80,0x3bf5,0xa4c6,0x267e,0x3c8e,0x3c00,0x1076,0x8c53,0x3c9b,
+    0x38c9,0x80a5,0x37da,0x00c9,0x38c7,0x8c0c,0x37d7,0x0cef,0x38c8,0x940c,0x37d8,0x14f0,0x38c8,0x988e,0x37d8,0x198e,
+    0x38c9,0x9c0c,0x37d8,0x1cf0,0x38c9,0x9e53,0x37d8,0x1fb7,0x38c9,0xa08e,0x37d8,0x218e,0x38c9,0xa233,0x37d8,0x2390,
+    0x38c9,0xa40c,0x37d9,0x24f0,0x38c9,0xa51f,0x37d9,0x2640,0x38c9,0xa652,0x37d9,0x27b9,0x38c9,0xa7a5,0x37d9,0x28ac,
+    0x38c9,0xa88c,0x37d9,0x2991,0x38ca,0xa955,0x37da,0x2a89,0x38ca,0xaa2e,0x37da,0x2b96,0x38cb,0xab14,0x37db,0x2c5c,
+    0x38cc,0xac01,0x37dc,0x2cf8,0x38ce,0xac81,0x37de,0x2d9f,0x38cf,0xad08,0x37df,0x2e50,0x38d1,0xad96,0x37e0,0x2f0d,
+    0x38d3,0xae29,0x37e2,0x2fd5,0x38d5,0xaebf,0x37e4,0x3055,0x38d9,0xaf5b,0x37e7,0x30c5,0x38dd,0xaffb,0x37ea,0x313b,
+    0x38e3,0xb04e,0x37f0,0x31b9,0x38e9,0xb0a1,0x37f5,0x323c,0x38f3,0xb0f4,0x37fd,0x32c7,0x38fe,0xb148,0x3804,0x3358,
+    0x390e,0xb19e,0x380c,0x33f2,0x391f,0xb1f3,0x3813,0x3448,0x3933,0xb24a,0x381c,0x349c,0x3948,0xb29f,0x3824,0x34f2,
+    0x3961,0xb2f4,0x382e,0x354c,0x3980,0xb342,0x3838,0x35b1,0x399b,0xb38b,0x383d,0x361b,0x39be,0xb3ce,0x3844,0x368b,
+    0x39db,0xb404,0x3843,0x36fc,0x3a01,0xb420,0x3845,0x3775,0x3a25,0xb435,0x3843,0x37ee,0x3a4a,0xb448,0x383c,0x3835,
+    0x3a6b,0xb456,0x3830,0x3873,0x3a9b,0xb45c,0x3826,0x38b0,0x3ab6,0xb463,0x3811,0x38f4,0x3ad7,0xb461,0x37f0,0x3935,
+    0x3af5,0xb454,0x37b0,0x3977,0x3b14,0xb441,0x376c,0x39b9,0x3b42,0xb42a,0x372e,0x39f9,0x3b4a,0xb40d,0x36c7,0x3a39,
+    0x3b60,0xb3d9,0x366b,0x3a78,0x3b7f,0xb38a,0x3610,0x3ab6,0x3b88,0xb32a,0x359e,0x3af2,0x3b99,0xb2be,0x3531,0x3b2b,
+    0x3ba5,0xb250,0x34bd,0x3b65,0x3baf,0xb1d8,0x3448,0x3b9c,0x3bbf,0xb15e,0x33af,0x3bd5,0x3bc4,0xb0d2,0x32c4,0x3c05,
+    0x3bd0,0xb046,0x31df,0x3c20,0x3bcd,0xaf69,0x3101,0x3c37,0x3bc9,0xae3d,0x3038,0x3c4e,0x3bd0,0xacfb,0x2ecd,0x3c60,
+    0x3bd6,0xab7d,0x2d1a,0x3c72,0x3be6,0xa8ff,0x2ac8,0x3c81,0x3bf4,0xa4f8,0x26bb,0x3c8f,0x3c00,0x1071,0x8bba,0x3c9d,
+    0x38b6,0x80a8,0x380e,0x00c4,0x3898,0x8c15,0x37e9,0x0cbe,0x3898,0x9415,0x37ea,0x14be,0x3898,0x9898,0x37e9,0x1956,
+    0x3898,0x9c15,0x37e9,0x1cbe,0x3898,0x9e61,0x37e9,0x1f69,0x3898,0xa097,0x37e9,0x2156,0x3898,0xa240,0x37e9,0x2343,
+    0x3899,0xa415,0x37e9,0x24bf,0x3899,0xa52a,0x37e9,0x2602,0x3899,0xa65f,0x37ea,0x276b,0x3899,0xa7b5,0x37ea,0x287e,
+    0x3899,0xa895,0x37ea,0x2959,0x389a,0xa960,0x37eb,0x2a48,0x389a,0xaa3b,0x37eb,0x2b4b,0x389b,0xab22,0x37ec,0x2c31,
+    0x389c,0xac09,0x37ee,0x2cc7,0x389e,0xac8a,0x37ef,0x2d68,0x389f,0xad13,0x37f0,0x2e13,0x38a1,0xada2,0x37f2,0x2ec9,
+    0x38a3,0xae34,0x37f4,0x2f8b,0x38a6,0xaecc,0x37f7,0x302c,0x38a9,0xaf6a,0x37fa,0x3099,0x38ae,0xb005,0x37fe,0x310b,
+    0x38b5,0xb057,0x3802,0x3185,0x38bc,0xb0aa,0x3805,0x3205,0x38c5,0xb0ff,0x380a,0x328c,0x38d2,0xb154,0x380f,0x331b,
+    0x38e2,0xb1aa,0x3818,0x33b2,0x38f5,0xb201,0x3821,0x3428,0x3908,0xb258,0x382a,0x347a,0x3920,0xb2ad,0x3835,0x34cf,
+    0x393a,0xb305,0x383f,0x3529,0x3956,0xb354,0x3848,0x3588,0x3976,0xb3a0,0x3850,0x35f2,0x39aa,0xb3ec,0x3863,0x3667,
+    0x39c9,0xb413,0x3864,0x36d8,0x39f0,0xb42e,0x3866,0x374f,0x3a11,0xb445,0x3860,0x37c9,0x3a38,0xb459,0x385c,0x3824,
+    0x3a57,0xb467,0x384c,0x3863,0x3a77,0xb46f,0x3839,0x38a1,0x3a9c,0xb473,0x3827,0x38e2,0x3ac1,0xb472,0x380f,0x3923,
+    0x3ae9,0xb46b,0x37ec,0x3968,0x3b05,0xb457,0x379e,0x39aa,0x3b42,0xb43f,0x376a,0x39ec,0x3b40,0xb421,0x36f8,0x3a2d,
+    0x3b54,0xb3fd,0x3695,0x3a6c,0x3b69,0xb3ad,0x3630,0x3aa9,0x3b83,0xb355,0x35c8,0x3ae9,0x3b8e,0xb2e5,0x3552,0x3b22,
+    0x3ba1,0xb274,0x34df,0x3b5e,0x3ba6,0xb1f8,0x3466,0x3b95,0x3bb6,0xb17c,0x33e3,0x3bcf,0x3bb9,0xb0f4,0x32ef,0x3c02,
+    0x3bc9,0xb061,0x3209,0x3c1e,0x3bc2,0xaf96,0x3123,0x3c37,0x3bc8,0xae63,0x304f,0x3c4d,0x3bca,0xad27,0x2efc,0x3c61,
+    0x3bd6,0xabac,0x2d3c,0x3c73,0x3be4,0xa91e,0x2af6,0x3c83,0x3bf3,0xa516,0x26eb,0x3c91,0x3c00,0x0c7a,0x887d,0x3c9f,
+    0x3868,0x80a7,0x37f7,0x00b9,0x3867,0x8c1b,0x37f5,0x0c8b,0x3868,0x941b,0x37f6,0x148c,0x3869,0x989f,0x37f8,0x191e,
+    0x3868,0x9c1b,0x37f6,0x1c8c,0x3868,0x9e6b,0x37f6,0x1f1a,0x3868,0xa09f,0x37f6,0x211d,0x3868,0xa24a,0x37f6,0x22f6,
+    0x3868,0xa41b,0x37f6,0x248c,0x3868,0xa532,0x37f6,0x25c2,0x3868,0xa669,0x37f6,0x271d,0x3868,0xa7c1,0x37f6,0x284e,
+    0x3869,0xa89c,0x37f7,0x2921,0x3869,0xa968,0x37f7,0x2a06,0x386a,0xaa44,0x37f8,0x2aff,0x386b,0xab2a,0x37f9,0x2c06,
+    0x386c,0xac0f,0x37fb,0x2c96,0x386d,0xac90,0x37fc,0x2d30,0x386f,0xad1a,0x37fd,0x2dd5,0x3870,0xadaa,0x37ff,0x2e85,
+    0x3873,0xae3c,0x3801,0x2f3f,0x3876,0xaed7,0x3802,0x3003,0x387a,0xaf75,0x3804,0x306c,0x387f,0xb00b,0x3807,0x30db,
+    0x3885,0xb05e,0x3809,0x3151,0x388d,0xb0b1,0x380d,0x31cd,0x3898,0xb106,0x3813,0x3251,0x38a6,0xb15d,0x381b,0x32de,
+    0x38b5,0xb1b3,0x3823,0x3371,0x38c9,0xb20b,0x382d,0x3407,0x38df,0xb262,0x3838,0x3458,0x38f6,0xb2b9,0x3842,0x34ac,
+    0x3913,0xb311,0x384f,0x3505,0x3941,0xb367,0x3867,0x3565,0x3953,0xb3b4,0x3864,0x35cb,0x3973,0xb3f8,0x3869,0x3638,
+    0x399f,0xb41e,0x3873,0x36ae,0x39c8,0xb43c,0x3876,0x3729,0x39e9,0xb452,0x3870,0x37a1,0x3a11,0xb466,0x386b,0x3810,
+    0x3a5c,0xb47a,0x387a,0x3855,0x3a6f,0xb47f,0x385b,0x3890,0x3a89,0xb484,0x3841,0x38d3,0x3aac,0xb482,0x3827,0x3914,
+    0x3ace,0xb47b,0x3808,0x3955,0x3af5,0xb46c,0x37d1,0x399b,0x3b19,0xb452,0x3782,0x39dd,0x3b2d,0xb433,0x3720,0x3a1d,
+    0x3b4c,0xb412,0x36c6,0x3a61,0x3b64,0xb3d1,0x365b,0x3a9f,0x3b76,0xb378,0x35eb,0x3ade,0x3b9c,0xb30e,0x3587,0x3b19,
+    0x3b94,0xb296,0x34fd,0x3b55,0x3bac,0xb218,0x348a,0x3b8f,0x3bae,0xb196,0x340a,0x3bc8,0x3bc2,0xb10f,0x332d,0x3bff,
+    0x3bd8,0xb07b,0x322a,0x3c18,0x3bc5,0xafc4,0x3143,0x3c36,0x3bc5,0xae87,0x306b,0x3c4d,0x3bc9,0xad43,0x2f27,0x3c61,
+    0x3bd6,0xabf0,0x2d62,0x3c74,0x3be1,0xa93f,0x2b26,0x3c84,0x3bf3,0xa528,0x2712,0x3c93,0x3c00,0x0c83,0x81cf,0x3ca1,
+    0x3833,0x80a8,0x37f7,0x00b1,0x3837,0x8c20,0x37ff,0x0c59,0x3837,0x941f,0x37fe,0x1459,0x3837,0x98a3,0x37fe,0x18e4,
+    0x3836,0x9c1f,0x37fd,0x1c59,0x3836,0x9e71,0x37fd,0x1ecb,0x3836,0xa0a3,0x37fd,0x20e4,0x3836,0xa24f,0x37fd,0x22a9,
+    0x3837,0xa41f,0x37fd,0x245a,0x3837,0xa537,0x37fd,0x2582,0x3837,0xa66f,0x37fe,0x26cd,0x3837,0xa7c8,0x37fe,0x281e,
+    0x3837,0xa8a1,0x37fe,0x28e8,0x3838,0xa96d,0x37ff,0x29c3,0x3838,0xaa49,0x3800,0x2ab2,0x383a,0xab2f,0x3801,0x2bb3,
+    0x383b,0xac12,0x3801,0x2c64,0x383c,0xac95,0x3802,0x2cf8,0x383e,0xad1e,0x3803,0x2d97,0x3840,0xadaf,0x3804,0x2e3f,
+    0x3842,0xae42,0x3805,0x2ef3,0x3845,0xaedc,0x3807,0x2fb2,0x384a,0xaf7b,0x3809,0x303e,0x384f,0xb00f,0x380c,0x30aa,
+    0x3855,0xb061,0x380f,0x311c,0x385e,0xb0b6,0x3814,0x3195,0x386a,0xb10b,0x381a,0x3216,0x3878,0xb163,0x3822,0x329f,
+    0x3889,0xb1b9,0x382c,0x3330,0x389c,0xb212,0x3836,0x33c9,0x38b4,0xb269,0x3843,0x3435,0x38d0,0xb2c3,0x3851,0x348a,
+    0x38ea,0xb318,0x385b,0x34e2,0x3908,0xb36f,0x3867,0x353f,0x392c,0xb3c1,0x3873,0x35a2,0x3957,0xb405,0x3880,0x3611,
+    0x3987,0xb42a,0x388e,0x3689,0x39ac,0xb446,0x388f,0x36ff,0x39cc,0xb45e,0x3887,0x3779,0x39f6,0xb473,0x3882,0x37fa,
+    0x3a29,0xb483,0x387d,0x383e,0x3a49,0xb48d,0x3869,0x3880,0x3a7d,0xb492,0x385d,0x38c2,0x3a9a,0xb492,0x383f,0x3905,
+    0x3ac1,0xb48d,0x3823,0x3949,0x3ae1,0xb47d,0x37fc,0x398a,0x3b05,0xb466,0x37ab,0x39d1,0x3b26,0xb447,0x3751,0x3a14,
+    0x3b3c,0xb422,0x36e7,0x3a54,0x3b57,0xb3f2,0x3680,0x3a95,0x3b70,0xb398,0x3612,0x3ad5,0x3b80,0xb332,0x359a,0x3b13,
+    0x3b93,0xb2bc,0x3521,0x3b4e,0x3b9b,0xb239,0x34a0,0x3b89,0x3bac,0xb1b2,0x3423,0x3bc3,0x3bb8,0xb128,0x3350,0x3bfd,
+    0x3bc5,0xb098,0x3258,0x3c1a,0x3bd4,0xafee,0x3170,0x3c2e,0x3bc7,0xaead,0x3082,0x3c4e,0x3bc9,0xad5e,0x2f4d,0x3c62,
+    0x3bd0,0xac11,0x2d85,0x3c75,0x3be1,0xa96a,0x2b59,0x3c86,0x3bf2,0xa55a,0x274c,0x3c95,0x3c00,0x121b,0x8d74,0x3ca3,
+    0x37f8,0x80a6,0x37ef,0x00a7,0x3804,0x8c20,0x37ff,0x0c25,0x3804,0x9421,0x37ff,0x1425,0x3805,0x98a5,0x3801,0x18ab,
+    0x3805,0x9c21,0x3800,0x1c26,0x3805,0x9e73,0x3800,0x1e7b,0x3805,0xa0a5,0x3800,0x20ab,0x3805,0xa252,0x3800,0x225a,
+    0x3805,0xa420,0x3800,0x2426,0x3805,0xa539,0x3800,0x2541,0x3805,0xa671,0x3800,0x267e,0x3806,0xa7cb,0x3800,0x27dc,
+    0x3806,0xa8a2,0x3801,0x28af,0x3806,0xa96f,0x3801,0x2980,0x3807,0xaa4b,0x3801,0x2a64,0x3808,0xab30,0x3802,0x2b5b,
+    0x380a,0xac13,0x3803,0x2c32,0x380b,0xac96,0x3804,0x2cc0,0x380d,0xad20,0x3805,0x2d58,0x380f,0xadb0,0x3806,0x2dfa,
+    0x3811,0xae43,0x3808,0x2ea7,0x3815,0xaede,0x3809,0x2f5e,0x3819,0xaf7c,0x380c,0x3011,0x381e,0xb010,0x380f,0x3079,
+    0x3825,0xb062,0x3812,0x30e7,0x382f,0xb0b7,0x3818,0x315d,0x383b,0xb10d,0x381f,0x31da,0x3849,0xb165,0x3827,0x3260,
+    0x385c,0xb1bc,0x3833,0x32ef,0x3872,0xb216,0x383f,0x3386,0x3893,0xb272,0x3854,0x3415,0x38a4,0xb2c8,0x385a,0x3467,
+    0x38c4,0xb320,0x3869,0x34bf,0x38e3,0xb377,0x3876,0x351b,0x3903,0xb3c8,0x387f,0x357b,0x392b,0xb40c,0x388c,0x35e7,
+    0x3955,0xb42e,0x3895,0x365b,0x3983,0xb44f,0x389b,0x36d6,0x39ab,0xb468,0x3899,0x3752,0x39d6,0xb47d,0x3895,0x37d2,
+    0x3a0d,0xb48e,0x3892,0x382b,0x3a4a,0xb49b,0x3890,0x386f,0x3a5c,0xb4a0,0x386e,0x38b2,0x3a9e,0xb4a0,0x3867,0x38f6,
+    0x3aa9,0xb499,0x3835,0x3938,0x3ae5,0xb48d,0x381e,0x397d,0x3af5,0xb478,0x37d8,0x39c1,0x3b23,0xb457,0x3786,0x3a04,
+    0x3b37,0xb435,0x3716,0x3a4a,0x3b4e,0xb40a,0x36a7,0x3a8c,0x3b65,0xb3b7,0x3635,0x3acc,0x3b7a,0xb34e,0x35bb,0x3b0b,
+    0x3b86,0xb2db,0x353c,0x3b45,0x3b9c,0xb25d,0x34c1,0x3b82,0x3ba1,0xb1cf,0x343a,0x3bbd,0x3bb5,0xb141,0x3378,0x3bf9,
+    0x3bbe,0xb0ac,0x327d,0x3c19,0x3bc2,0xb015,0x3184,0x3c35,0x3bc2,0xaedd,0x309e,0x3c4e,0x3bc4,0xad7e,0x2f7a,0x3c63,
+    0x3bd0,0xac21,0x2da3,0x3c77,0x3bdf,0xa986,0x2b87,0x3c87,0x3bf1,0xa597,0x277e,0x3c97,0x3c00,0x10f9,0x8c87,0x3ca6,
+    0x3743,0x80a5,0x3796,0x009e,0x37a6,0x8c20,0x37fe,0x0be4,0x37a6,0x9420,0x37fe,0x13e4,0x37a6,0x98a4,0x37fe,0x1870,
+    0x37a6,0x9c20,0x37fe,0x1be5,0x37a6,0x9e71,0x37fe,0x1e2b,0x37a6,0xa0a4,0x37fe,0x2071,0x37a6,0xa250,0x37fe,0x220c,
+    0x37a6,0xa41f,0x37fe,0x23e6,0x37a7,0xa537,0x37ff,0x2500,0x37a7,0xa670,0x37ff,0x262d,0x37a8,0xa7c9,0x37ff,0x277b,
+    0x37a8,0xa8a1,0x3800,0x2875,0x37a9,0xa96d,0x3800,0x293d,0x37ab,0xaa48,0x3801,0x2a16,0x37ad,0xab2d,0x3802,0x2b02,
+    0x37b0,0xac12,0x3802,0x2bff,0x37b3,0xac95,0x3803,0x2c87,0x37b6,0xad1f,0x3804,0x2d18,0x37bb,0xadad,0x3806,0x2db4,
+    0x37c0,0xae42,0x3807,0x2e5a,0x37c7,0xaedc,0x3809,0x2f0a,0x37d0,0xaf79,0x380c,0x2fc7,0x37db,0xb00e,0x380f,0x3047,
+    0x37eb,0xb061,0x3814,0x30b3,0x37fe,0xb0b6,0x381a,0x3125,0x380c,0xb10c,0x3822,0x319f,0x381c,0xb164,0x382d,0x3222,
+    0x382f,0xb1bd,0x3838,0x32ad,0x3845,0xb217,0x3846,0x3343,0x385f,0xb272,0x3854,0x33e2,0x3885,0xb2cf,0x386d,0x3447,
+    0x3899,0xb322,0x3871,0x349b,0x38bd,0xb37b,0x3882,0x34f7,0x38ed,0xb3d5,0x389a,0x355b,0x3907,0xb410,0x389b,0x35bf,
+    0x3932,0xb435,0x38a4,0x3632,0x3960,0xb455,0x38ab,0x36ac,0x398b,0xb471,0x38ab,0x3729,0x39bd,0xb488,0x38ab,0x37ad,
+    0x39ea,0xb499,0x38a2,0x3819,0x3a13,0xb4a5,0x3891,0x385b,0x3a45,0xb4ad,0x3882,0x38a2,0x3a6e,0xb4ab,0x3869,0x38e5,
+    0x3aa6,0xb4a6,0x3854,0x392b,0x3abd,0xb499,0x3826,0x396d,0x3ae3,0xb486,0x37fc,0x39b2,0x3b09,0xb46b,0x37a5,0x39f9,
+    0x3b27,0xb445,0x372c,0x3a3c,0x3b46,0xb41b,0x36d0,0x3a81,0x3b5e,0xb3d5,0x365a,0x3ac5,0x3b72,0xb36b,0x35db,0x3b03,
+    0x3b84,0xb2f4,0x355d,0x3b3f,0x3b8f,0xb27b,0x34d9,0x3b7b,0x3ba3,0xb1f0,0x3459,0x3bb9,0x3bab,0xb15c,0x33a0,0x3bf7,
+    0x3bb2,0xb0c1,0x329c,0x3c17,0x3bc0,0xb024,0x319f,0x3c35,0x3bbe,0xaf08,0x30b9,0x3c4d,0x3bc3,0xada2,0x2fa4,0x3c63,
+    0x3bce,0xac3a,0x2dc4,0x3c78,0x3bdd,0xa99f,0x2bb3,0x3c89,0x3bf0,0xa59f,0x27a7,0x3c9a,0x3c00,0x07f5,0x8040,0x3ca9,
+    0x36fd,0x80a7,0x37ab,0x0099,0x373f,0x8c1b,0x37f4,0x0b7c,0x3741,0x941c,0x37f6,0x137d,0x3742,0x98a0,0x37f7,0x1836,
+    0x3742,0x9c1c,0x37f7,0x1b7d,0x3742,0x9e6c,0x37f7,0x1dda,0x3742,0xa0a0,0x37f7,0x2037,0x3742,0xa24b,0x37f7,0x21bd,
+    0x3742,0xa41c,0x37f7,0x237f,0x3743,0xa533,0x37f8,0x24bf,0x3743,0xa66a,0x37f8,0x25dd,0x3744,0xa7c2,0x37f8,0x271a,
+    0x3744,0xa89d,0x37f9,0x283b,0x3745,0xa969,0x37fa,0x28f9,0x3747,0xaa40,0x37fb,0x29c8,0x374a,0xab27,0x37fd,0x2aa8,
+    0x374c,0xac0e,0x37ff,0x2b9a,0x374f,0xac91,0x3800,0x2c4e,0x3753,0xad1a,0x3801,0x2cd9,0x3758,0xada7,0x3803,0x2d6e,
+    0x375d,0xae3c,0x3805,0x2e0c,0x3765,0xaed5,0x3807,0x2eb6,0x376e,0xaf73,0x380a,0x2f6b,0x377a,0xb00a,0x380e,0x3016,
+    0x378b,0xb05d,0x3813,0x307e,0x379f,0xb0b2,0x381a,0x30ec,0x37ba,0xb109,0x3823,0x3163,0x37dd,0xb161,0x382f,0x31e3,
+    0x3802,0xb1bb,0x383c,0x326c,0x3818,0xb213,0x3849,0x32fe,0x3834,0xb270,0x385a,0x339b,0x3853,0xb2ca,0x386d,0x3421,
+    0x3881,0xb328,0x388a,0x347c,0x389c,0xb37e,0x3892,0x34d5,0x38bc,0xb3d3,0x389c,0x3534,0x38e3,0xb412,0x38a8,0x359a,
+    0x390f,0xb439,0x38b4,0x360a,0x3961,0xb45f,0x38d8,0x3689,0x3981,0xb479,0x38ce,0x3705,0x399b,0xb48f,0x38ba,0x3782,
+    0x39d7,0xb4a4,0x38bd,0x3807,0x39fd,0xb4af,0x38a8,0x384a,0x3a2b,0xb4b7,0x3895,0x3891,0x3a71,0xb4b7,0x388b,0x38d6,
+    0x3a86,0xb4b2,0x3860,0x391c,0x3aaf,0xb4a5,0x383d,0x3961,0x3aee,0xb493,0x3821,0x39a6,0x3afa,0xb47a,0x37cb,0x39ec,
+    0x3b21,0xb456,0x3768,0x3a31,0x3b3b,0xb426,0x36f7,0x3a6f,0x3b55,0xb3f2,0x367a,0x3ab9,0x3b78,0xb383,0x3606,0x3af9,
+    0x3b80,0xb311,0x357b,0x3b3a,0x3b8e,0xb291,0x34f4,0x3b77,0x3b9e,0xb20d,0x3471,0x3bb3,0x3ba5,0xb176,0x33c8,0x3bef,
+    0x3bb4,0xb0da,0x32c3,0x3c17,0x3bbe,0xb037,0x31bc,0x3c34,0x3bbd,0xaf1d,0x30cb,0x3c4e,0x3bc3,0xadc8,0x2fc8,0x3c65,
+    0x3bc8,0xac5a,0x2de9,0x3c79,0x3bdd,0xa9be,0x2bd7,0x3c8c,0x3bef,0xa5ae,0x27ca,0x3c9c,0x3c00,0x0e7a,0x86d9,0x3cac,
+    0x3640,0x80a4,0x3735,0x008e,0x36de,0x8c16,0x37eb,0x0b16,0x36de,0x9416,0x37eb,0x1316,0x36de,0x9899,0x37eb,0x17f9,
+    0x36de,0x9c16,0x37eb,0x1b16,0x36de,0x9e62,0x37eb,0x1d89,0x36de,0xa099,0x37eb,0x1ff9,0x36de,0xa241,0x37ec,0x216e,
+    0x36de,0xa416,0x37ec,0x2318,0x36df,0xa52b,0x37ec,0x247e,0x36df,0xa661,0x37ec,0x258d,0x36e0,0xa7b6,0x37ed,0x26b9,
+    0x36e1,0xa896,0x37ed,0x2802,0x36e2,0xa960,0x37ee,0x28b6,0x36e4,0xaa36,0x37f0,0x297a,0x36e6,0xab1b,0x37f2,0x2a4f,
+    0x36e8,0xac08,0x37f3,0x2b34,0x36eb,0xac8a,0x37f5,0x2c15,0x36ef,0xad12,0x37f8,0x2c9a,0x36f4,0xad9d,0x37fb,0x2d28,
+    0x36fb,0xae32,0x3800,0x2dbf,0x3702,0xaec9,0x3802,0x2e62,0x370c,0xaf67,0x3805,0x2f0f,0x371a,0xb004,0x380a,0x2fca,
+    0x372a,0xb057,0x3810,0x3049,0x3742,0xb0ac,0x3818,0x30b4,0x375c,0xb102,0x3821,0x3127,0x3780,0xb15b,0x382e,0x31a4,
+    0x37aa,0xb1b5,0x383d,0x322b,0x37dc,0xb20f,0x384e,0x32bb,0x380c,0xb26d,0x3862,0x3357,0x382b,0xb2c6,0x3874,0x33fb,
+    0x384a,0xb320,0x3883,0x3454,0x3870,0xb37b,0x3896,0x34b0,0x38a2,0xb3d5,0x38b1,0x3513,0x38c0,0xb413,0x38b4,0x3576,
+    0x38ea,0xb43a,0x38bf,0x35e2,0x392e,0xb461,0x38d9,0x365d,0x394f,0xb47d,0x38cf,0x36d9,0x397f,0xb497,0x38cd,0x375e,
+    0x39c0,0xb4ad,0x38d7,0x37eb,0x39f3,0xb4ba,0x38c5,0x383a,0x3a13,0xb4c0,0x38a8,0x387f,0x3a50,0xb4c1,0x3898,0x38c6,
+    0x3a76,0xb4bb,0x3874,0x390c,0x3ab2,0xb4ae,0x385a,0x3952,0x3ac2,0xb49e,0x3823,0x399a,0x3ae9,0xb485,0x37eb,0x39e0,
+    0x3b0d,0xb465,0x3785,0x3a25,0x3b38,0xb439,0x371f,0x3a69,0x3b48,0xb407,0x3698,0x3aaf,0x3b65,0xb3a3,0x361d,0x3af3,
+    0x3b7b,0xb328,0x359a,0x3b34,0x3b88,0xb2a8,0x350d,0x3b70,0x3b90,0xb21e,0x3482,0x3bad,0x3ba5,0xb191,0x33fb,0x3bed,
+    0x3bae,0xb0f4,0x32e5,0x3c15,0x3bbd,0xb04c,0x31da,0x3c34,0x3bc2,0xaf3b,0x30dd,0x3c4f,0x3bbc,0xadda,0x2ff1,0x3c66,
+    0x3bc9,0xac71,0x2e04,0x3c7b,0x3bda,0xa9f7,0x2c08,0x3c8e,0x3bee,0xa5d0,0x27f5,0x3c9f,0x3c00,0x1132,0x8c7d,0x3caf,
+    0x3664,0x80a4,0x37c0,0x0087,0x367a,0x8c0d,0x37db,0x0aaf,0x367b,0x940e,0x37dc,0x12b0,0x367a,0x988f,0x37da,0x1785,
+    0x367a,0x9c0d,0x37db,0x1aaf,0x367a,0x9e55,0x37db,0x1d39,0x367a,0xa08f,0x37db,0x1f85,0x367a,0xa234,0x37db,0x211f,
+    0x367a,0xa40d,0x37db,0x22b1,0x367b,0xa520,0x37db,0x243d,0x367b,0xa653,0x37dc,0x253c,0x367c,0xa7a6,0x37dc,0x2658,
+    0x367d,0xa88c,0x37dd,0x2790,0x367e,0xa954,0x37de,0x2872,0x3680,0xaa27,0x37e0,0x292d,0x3682,0xab0c,0x37e1,0x29f6,
+    0x3685,0xabff,0x37e3,0x2acf,0x3688,0xac80,0x37e5,0x2bba,0x368c,0xad06,0x37e8,0x2c5b,0x3691,0xad91,0x37ec,0x2ce2,
+    0x3697,0xae24,0x37f0,0x2d72,0x36a0,0xaeba,0x37f6,0x2e0e,0x36aa,0xaf57,0x37fd,0x2eb4,0x36b8,0xaff7,0x3804,0x2f68,
+    0x36c9,0xb04d,0x380a,0x3014,0x36e1,0xb0a2,0x3813,0x307c,0x3714,0xb0fc,0x382b,0x30f0,0x3725,0xb152,0x382d,0x3166,
+    0x374f,0xb1ab,0x383c,0x31e9,0x3784,0xb208,0x384f,0x3278,0x37c0,0xb265,0x3863,0x3312,0x3802,0xb2c1,0x3878,0x33b6,
+    0x3822,0xb31b,0x3889,0x3431,0x3848,0xb376,0x389c,0x348d,0x3871,0xb3ce,0x38ae,0x34ed,0x389e,0xb412,0x38c1,0x3554,
+    0x38ca,0xb43a,0x38cc,0x35bf,0x38f9,0xb460,0x38d5,0x3631,0x392d,0xb481,0x38dc,0x36b1,0x3976,0xb49e,0x38ea,0x3739,
+    0x3994,0xb4b0,0x38d7,0x37be,0x39cb,0xb4c1,0x38cc,0x3827,0x3a03,0xb4c7,0x38be,0x386c,0x3a30,0xb4cb,0x38a4,0x38b7,
+    0x3a5a,0xb4c5,0x3882,0x38fe,0x3a8a,0xb4ba,0x3860,0x3947,0x3ab6,0xb4a8,0x3838,0x398f,0x3ae7,0xb48f,0x380e,0x39d4,
+    0x3b04,0xb470,0x37aa,0x3a1c,0x3b1f,0xb448,0x3733,0x3a5f,0x3b3e,0xb417,0x36b7,0x3aa5,0x3b56,0xb3bd,0x3636,0x3aea,
+    0x3b73,0xb344,0x35b2,0x3b2e,0x3b8a,0xb2b8,0x352f,0x3b67,0x3b93,0xb233,0x349c,0x3baa,0x3ba0,0xb1a2,0x340f,0x3be9,
+    0x3bb5,0xb106,0x3316,0x3c11,0x3bba,0xb065,0x31fb,0x3c33,0x3bb8,0xaf5f,0x30f9,0x3c4f,0x3bbc,0xadf1,0x3007,0x3c68,
+    0x3bca,0xac7c,0x2e18,0x3c7d,0x3bd8,0xaa13,0x2c1d,0x3c90,0x3bee,0xa618,0x281b,0x3ca1,0x3c00,0x0e49,0x85b9,0x3cb2,
+    0x35ab,0x80a1,0x373c,0x007e,0x3618,0x8c03,0x37c7,0x0a49,0x3616,0x9402,0x37c4,0x1248,0x3617,0x9883,0x37c5,0x1711,
+    0x3616,0x9c02,0x37c5,0x1a48,0x3616,0x9e43,0x37c5,0x1ce9,0x3616,0xa082,0x37c5,0x1f12,0x3617,0xa223,0x37c5,0x20d0,
+    0x3617,0xa402,0x37c5,0x224a,0x3617,0xa512,0x37c5,0x23f7,0x3618,0xa641,0x37c6,0x24ec,0x3618,0xa790,0x37c6,0x25f7,
+    0x3619,0xa87f,0x37c7,0x271d,0x361b,0xa945,0x37c8,0x282f,0x361d,0xaa16,0x37ca,0x28df,0x361f,0xaaf8,0x37cc,0x299d,
+    0x3621,0xabe9,0x37ce,0x2a6b,0x3625,0xac73,0x37d0,0x2b48,0x3629,0xacf7,0x37d3,0x2c1c,0x362e,0xad82,0x37d8,0x2c9c,
+    0x3634,0xae12,0x37dc,0x2d26,0x363d,0xaea6,0x37e2,0x2dba,0x3649,0xaf41,0x37ec,0x2e5a,0x3657,0xafe1,0x37f6,0x2f05,
+    0x3676,0xb044,0x380a,0x2fc3,0x3685,0xb096,0x380e,0x3044,0x36a2,0xb0ed,0x3819,0x30b1,0x36ca,0xb145,0x3829,0x3128,
+    0x36fa,0xb1a0,0x383c,0x31aa,0x3730,0xb1fe,0x3850,0x3237,0x378b,0xb260,0x3876,0x32d4,0x37af,0xb2b7,0x387a,0x3370,
+    0x37f4,0xb311,0x388d,0x340d,0x3824,0xb36f,0x38a4,0x346a,0x384e,0xb3c8,0x38b7,0x34cb,0x387b,0xb40f,0x38c9,0x3531,
+    0x38ac,0xb439,0x38da,0x359e,0x38d9,0xb45f,0x38e2,0x360e,0x390d,0xb483,0x38ea,0x3688,0x3944,0xb4a0,0x38ec,0x370f,
+    0x3976,0xb4b4,0x38e4,0x3798,0x39af,0xb4c5,0x38dc,0x3813,0x39eb,0xb4d0,0x38d0,0x385c,0x3a18,0xb4d2,0x38b4,0x38a6,
+    0x3a46,0xb4cd,0x3893,0x38ef,0x3a7f,0xb4c2,0x3876,0x3939,0x3ab3,0xb4af,0x384f,0x3980,0x3acb,0xb498,0x3815,0x39ca,
+    0x3aef,0xb478,0x37c2,0x3a10,0x3b1a,0xb452,0x3757,0x3a57,0x3b36,0xb423,0x36d9,0x3a9a,0x3b59,0xb3db,0x3664,0x3ae2,
+    0x3b60,0xb35c,0x35c4,0x3b25,0x3b81,0xb2d7,0x3543,0x3b68,0x3b88,0xb245,0x34ac,0x3ba5,0x3b9f,0xb1b3,0x3422,0x3be6,
+    0x3ba8,0xb118,0x3329,0x3c13,0x3bb5,0xb078,0x3219,0x3c32,0x3bb7,0xaf90,0x3112,0x3c50,0x3bbe,0xae0f,0x3019,0x3c69,
+    0x3bc4,0xac8f,0x2e3b,0x3c7f,0x3bd7,0xaa15,0x2c29,0x3c93,0x3bed,0xa629,0x282a,0x3ca5,0x3c00,0x833a,0x0828,0x3cb5,
+    0x34aa,0x809a,0x3646,0x0073,0x35b2,0x8be8,0x37a8,0x09e2,0x35b3,0x93e8,0x37a9,0x11e2,0x35b3,0x9873,0x37aa,0x169e,
+    0x35b3,0x9be8,0x37aa,0x19e2,0x35b3,0x9e2d,0x37aa,0x1c99,0x35b3,0xa072,0x37aa,0x1e9f,0x35b4,0xa20d,0x37aa,0x2082,
+    0x35b4,0xa3e7,0x37aa,0x21e4,0x35b4,0xa500,0x37aa,0x2377,0x35b5,0xa62b,0x37ab,0x249d,0x35b5,0xa776,0x37ab,0x2597,
+    0x35b6,0xa86f,0x37ac,0x26ab,0x35b8,0xa931,0x37ae,0x27da,0x35ba,0xaa00,0x37af,0x2892,0x35bc,0xaadf,0x37b1,0x2945,
+    0x35bf,0xabcd,0x37b3,0x2a07,0x35c2,0xac63,0x37b6,0x2ad8,0x35c7,0xace5,0x37ba,0x2bbb,0x35cc,0xad6e,0x37bd,0x2c57,
+    0x35d3,0xadfc,0x37c3,0x2cda,0x35dc,0xae8f,0x37ca,0x2d67,0x35e8,0xaf28,0x37d5,0x2e00,0x35f7,0xafc5,0x37e0,0x2ea5,
+    0x360d,0xb034,0x37f4,0x2f58,0x3632,0xb08a,0x380c,0x300f,0x364a,0xb0df,0x3814,0x3078,0x3671,0xb136,0x3824,0x30eb,
+    0x36a0,0xb191,0x3837,0x3169,0x36d8,0xb1ef,0x384c,0x31f4,0x3719,0xb24d,0x3864,0x3289,0x3760,0xb2ab,0x387c,0x332a,
+    0x37af,0xb309,0x3895,0x33d8,0x380c,0xb36a,0x38b9,0x344a,0x3840,0xb3c7,0x38d5,0x34ad,0x3856,0xb40c,0x38ce,0x350f,
+    0x389b,0xb438,0x38f4,0x357f,0x38c6,0xb45f,0x38f9,0x35ef,0x38fd,0xb486,0x38fd,0x366a,0x3924,0xb4a0,0x38f8,0x36e6,
+    0x395e,0xb4b8,0x38f6,0x3773,0x3993,0xb4cb,0x38eb,0x3802,0x39cd,0xb4d6,0x38db,0x384c,0x39fe,0xb4d9,0x38c2,0x3895,
+    0x3a30,0xb4d5,0x38a2,0x38df,0x3a62,0xb4ca,0x3880,0x392b,0x3a91,0xb4b8,0x3855,0x3976,0x3abc,0xb49f,0x3824,0x39be,
+    0x3ae8,0xb481,0x37e5,0x3a09,0x3b2b,0xb45d,0x37ad,0x3a52,0x3b2a,0xb42d,0x36f4,0x3a94,0x3b3c,0xb3f0,0x3667,0x3ad6,
+    0x3b6d,0xb378,0x35f2,0x3b1d,0x3b78,0xb2ec,0x3558,0x3b5e,0x3b8a,0xb25c,0x34c4,0x3ba4,0x3b94,0xb1c4,0x3430,0x3be3,
+    0x3ba0,0xb128,0x3341,0x3c14,0x3bae,0xb082,0x322a,0x3c33,0x3bb5,0xafaf,0x3123,0x3c51,0x3bb6,0xae3e,0x302e,0x3c6a,
+    0x3bc2,0xaca7,0x2e54,0x3c81,0x3bd5,0xaa31,0x2c3c,0x3c96,0x3bec,0xa61f,0x2838,0x3ca8,0x3c00,0x0f9b,0x87a9,0x3cb9,
+    0x354c,0x809e,0x3783,0x0070,0x3551,0x8bc7,0x3789,0x097d,0x3551,0x93c7,0x3789,0x117d,0x3551,0x9860,0x3789,0x162d,
+    0x3551,0x9bc7,0x3789,0x197d,0x3551,0x9e13,0x3789,0x1c4a,0x3551,0xa060,0x378a,0x1e2d,0x3552,0xa1f4,0x378a,0x2035,
+    0x3552,0xa3c6,0x378a,0x217f,0x3552,0xa4eb,0x378a,0x22f7,0x3553,0xa611,0x378b,0x244e,0x3553,0xa756,0x378b,0x2538,
+    0x3554,0xa85d,0x378c,0x263a,0x3556,0xa91a,0x378e,0x2756,0x3558,0xa9e6,0x3790,0x2846,0x355a,0xaac2,0x3792,0x28ee,
+    0x355d,0xabac,0x3794,0x29a4,0x3560,0xac50,0x3797,0x2a6a,0x3567,0xacd1,0x379e,0x2b3f,0x356a,0xad57,0x379f,0x2c13,
+    0x3572,0xade2,0x37a5,0x2c8f,0x3585,0xae76,0x37bb,0x2d18,0x3588,0xaf0a,0x37b8,0x2da7,0x359a,0xafa6,0x37c9,0x2e45,
+    0x35b0,0xb023,0x37dd,0x2ef2,0x35cb,0xb076,0x37f5,0x2fae,0x35f0,0xb0cd,0x380b,0x303e,0x361b,0xb125,0x381f,0x30b0,
+    0x364b,0xb180,0x3833,0x312b,0x3686,0xb1de,0x384a,0x31b3,0x36d2,0xb23e,0x386a,0x3248,0x3744,0xb2a7,0x389b,0x32f2,
+    0x375a,0xb2fa,0x3893,0x3392,0x37b8,0xb35a,0x38b0,0x3425,0x380e,0xb3b9,0x38cc,0x3489,0x383b,0xb407,0x38dd,0x34ef,
+    0x3866,0xb430,0x38e7,0x355a,0x389a,0xb45a,0x38f5,0x35ce,0x38f1,0xb486,0x391c,0x364f,0x390e,0xb4a1,0x390b,0x36c4,
+    0x3940,0xb4ba,0x3902,0x374c,0x3975,0xb4cd,0x38f6,0x37dc,0x39be,0xb4db,0x38f2,0x383a,0x39e8,0xb4e0,0x38d1,0x3886,
+    0x3a1e,0xb4dc,0x38b4,0x38d0,0x3a51,0xb4d3,0x3890,0x391e,0x3a80,0xb4bf,0x3865,0x3969,0x3aad,0xb4a7,0x3832,0x39b3,
+    0x3adb,0xb486,0x37ff,0x39fd,0x3afe,0xb461,0x3788,0x3a47,0x3b30,0xb434,0x36fd,0x3a8c,0x3b3f,0xb401,0x368a,0x3ad2,
+    0x3b52,0xb38f,0x35f9,0x3b16,0x3b72,0xb30c,0x356e,0x3b5d,0x3b7d,0xb276,0x34d7,0x3b9f,0x3b88,0xb1d6,0x343e,0x3bde,
+    0x3ba2,0xb136,0x3363,0x3c13,0x3bb0,0xb08f,0x3247,0x3c34,0x3bb0,0xafbc,0x3134,0x3c52,0x3bb4,0xae50,0x303d,0x3c6d,
+    0x3bc0,0xacce,0x2e77,0x3c83,0x3bd2,0xaa5f,0x2c53,0x3c98,0x3beb,0xa62f,0x2848,0x3cac,0x3c00,0x10bd,0x89cd,0x3cbe,
+    0x34f1,0x809b,0x3766,0x0067,0x34f1,0x8ba1,0x3765,0x0919,0x34f1,0x93a1,0x3765,0x1119,0x34f0,0x984a,0x3764,0x15bc,
+    0x34f0,0x9ba1,0x3764,0x1919,0x34f0,0x9df5,0x3764,0x1bf7,0x34f0,0xa04a,0x3764,0x1dbd,0x34f1,0xa1d6,0x3764,0x1fd0,
+    0x34f1,0xa39f,0x3765,0x211b,0x34f1,0xa4d2,0x3765,0x2278,0x34f2,0xa5f3,0x3765,0x2400,0x34f2,0xa732,0x3766,0x24da,
+    0x34f3,0xa847,0x3767,0x25ca,0x34f5,0xa900,0x3769,0x26d3,0x34f7,0xa9c9,0x376b,0x27f4,0x34f9,0xaaa1,0x376d,0x2897,
+    0x34fc,0xab85,0x376f,0x2942,0x3500,0xac3a,0x3772,0x29fc,0x3504,0xacb8,0x3776,0x2ac4,0x350a,0xad3c,0x377b,0x2b9e,
+    0x3512,0xadc5,0x3783,0x2c45,0x351c,0xae53,0x378c,0x2cc5,0x3529,0xaee7,0x3797,0x2d4f,0x353b,0xaf81,0x37a9,0x2de7,
+    0x3553,0xb00f,0x37c0,0x2e8d,0x3573,0xb063,0x37e0,0x2f43,0x3598,0xb0b9,0x3802,0x3006,0x35c3,0xb110,0x3815,0x3074,
+    0x35fb,0xb16c,0x382f,0x30ee,0x362f,0xb1ca,0x3844,0x3172,0x367b,0xb22b,0x3863,0x3206,0x36be,0xb289,0x3879,0x32a3,
+    0x370a,0xb2e7,0x3891,0x334c,0x3764,0xb349,0x38ac,0x3403,0x37c2,0xb3a6,0x38c5,0x3465,0x3813,0xb401,0x38dc,0x34ce,
+    0x3847,0xb42d,0x38ef,0x353c,0x3879,0xb454,0x38fa,0x35ae,0x38b5,0xb47b,0x390a,0x3627,0x38ea,0xb49e,0x390e,0x36a7,
+    0x392a,0xb4ba,0x3912,0x372a,0x3960,0xb4d0,0x3906,0x37b9,0x399a,0xb4dd,0x38f8,0x3828,0x39d0,0xb4e3,0x38de,0x3874,
+    0x3a09,0xb4e2,0x38c1,0x38c2,0x3a3d,0xb4d9,0x389d,0x390f,0x3a85,0xb4c6,0x387f,0x395c,0x3aa3,0xb4ad,0x3845,0x39a7,
+    0x3ae1,0xb48b,0x3817,0x39ef,0x3aec,0xb467,0x379b,0x3a3d,0x3b17,0xb43b,0x3724,0x3a88,0x3b2d,0xb406,0x3695,0x3aca,
+    0x3b50,0xb39c,0x3614,0x3b12,0x3b67,0xb320,0x3583,0x3b56,0x3b74,0xb28e,0x34e9,0x3b98,0x3b8d,0xb1f0,0x3456,0x3bdf,
+    0x3b9d,0xb149,0x3381,0x3c11,0x3ba9,0xb09b,0x325c,0x3c33,0x3bb1,0xafca,0x3146,0x3c50,0x3bb8,0xae57,0x3045,0x3c6e,
+    0x3bbf,0xacd5,0x2e8b,0x3c86,0x3bd3,0xaa93,0x2c6b,0x3c9c,0x3bea,0xa69e,0x286c,0x3caf,0x3c00,0x1115,0x8c0e,0x3cc2,
+    0x3489,0x8098,0x372d,0x0060,0x3491,0x8b75,0x373a,0x08b6,0x3491,0x9375,0x373a,0x10b6,0x3490,0x9831,0x3739,0x154d,
+    0x3491,0x9b75,0x373a,0x18b6,0x3491,0x9dd3,0x373a,0x1b5d,0x3491,0xa031,0x373a,0x1d4e,0x3491,0xa1b5,0x373a,0x1f39,
+    0x3491,0xa374,0x373a,0x20b9,0x3492,0xa4b7,0x373b,0x21fc,0x3492,0xa5d1,0x373b,0x2367,0x3493,0xa708,0x373c,0x247d,
+    0x3494,0xa82d,0x373d,0x255c,0x3496,0xa8e3,0x373f,0x2653,0x3498,0xa9a8,0x3741,0x275f,0x349a,0xaa7a,0x3743,0x2842,
+    0x349d,0xab58,0x3746,0x28e2,0x34a1,0xac21,0x3749,0x2990,0x34a5,0xac9c,0x374d,0x2a4c,0x34ab,0xad1d,0x3753,0x2b19,
+    0x34b3,0xada4,0x375b,0x2bf7,0x34be,0xae2e,0x3765,0x2c75,0x34cf,0xaec1,0x3777,0x2cfa,0x34e0,0xaf58,0x3787,0x2d8a,
+    0x3502,0xaff6,0x37af,0x2e2c,0x3518,0xb04c,0x37c2,0x2eda,0x3540,0xb0a2,0x37ea,0x2f9d,0x3571,0xb0fb,0x380d,0x303b,
+    0x35a5,0xb156,0x3825,0x30b2,0x35e1,0xb1b5,0x383f,0x3135,0x3626,0xb215,0x385b,0x31c4,0x3673,0xb276,0x3878,0x3262,
+    0x36c7,0xb2d6,0x3895,0x330d,0x371f,0xb337,0x38af,0x33c3,0x3780,0xb397,0x38ca,0x3445,0x37df,0xb3ef,0x38dc,0x34ab,
+    0x3825,0xb425,0x38f2,0x351c,0x385a,0xb44d,0x3900,0x358f,0x3894,0xb476,0x390e,0x360a,0x38d4,0xb499,0x391b,0x368a,
+    0x3930,0xb4bf,0x393e,0x371a,0x394f,0xb4d0,0x3919,0x3798,0x397a,0xb4dd,0x38fd,0x3814,0x39c9,0xb4e4,0x38f5,0x3861,
+    0x3a08,0xb4e7,0x38dd,0x38b2,0x3a26,0xb4de,0x38a8,0x3900,0x3a60,0xb4cd,0x3881,0x394f,0x3a92,0xb4b6,0x3850,0x399f,
+    0x3ab5,0xb493,0x3814,0x39e9,0x3ae8,0xb470,0x37bc,0x3a38,0x3b04,0xb440,0x3732,0x3a7f,0x3b28,0xb40c,0x36b0,0x3ac7,
+    0x3b44,0xb3a6,0x3625,0x3b0d,0x3b64,0xb327,0x3597,0x3b53,0x3b74,0xb29f,0x34ff,0x3b95,0x3b96,0xb207,0x3472,0x3bd5,
+    0x3b97,0xb160,0x33a0,0x3c10,0x3ba8,0xb0ae,0x327a,0x3c33,0x3bbd,0xafd6,0x3158,0x3c4a,0x3bb2,0xae65,0x3056,0x3c71,
+    0x3bc1,0xacdc,0x2e9a,0x3c8a,0x3bd2,0xaa8b,0x2c75,0x3c9f,0x3bea,0xa6d9,0x287f,0x3cb4,0x3c00,0x903f,0x0a23,0x3cc7,
+    0x341b,0x8092,0x36e2,0x0057,0x3433,0x8b44,0x370a,0x0855,0x3433,0x9344,0x370a,0x1055,0x3433,0x9816,0x370a,0x14e0,
+    0x3433,0x9b44,0x370a,0x1855,0x3433,0x9dad,0x370a,0x1ac6,0x3433,0xa016,0x370a,0x1ce1,0x3433,0xa18f,0x370a,0x1ea5,
+    0x3433,0xa342,0x370b,0x2058,0x3434,0xa498,0x370b,0x2181,0x3434,0xa5ab,0x370b,0x22d0,0x3435,0xa6da,0x370c,0x2422,
+    0x3436,0xa811,0x370e,0x24f1,0x3438,0xa8c2,0x3710,0x25d4,0x343a,0xa982,0x3711,0x26cd,0x343c,0xaa50,0x3713,0x27dd,
+    0x343f,0xab27,0x3717,0x2884,0x3443,0xac06,0x371a,0x2925,0x3448,0xac7d,0x371f,0x29d6,0x344e,0xacfb,0x3726,0x2a96,
+    0x3457,0xad7e,0x372e,0x2b68,0x3462,0xae06,0x373a,0x2c27,0x3471,0xae95,0x374a,0x2ca5,0x3487,0xaf2a,0x3762,0x2d2f,
+    0x34a2,0xafc5,0x3781,0x2dca,0x34c3,0xb034,0x37a4,0x2e74,0x34f7,0xb08c,0x37e1,0x2f36,0x3521,0xb0e2,0x3804,0x3003,
+    0x3551,0xb13c,0x3819,0x3076,0x3591,0xb19b,0x3837,0x30f7,0x35eb,0xb202,0x3863,0x318a,0x362b,0xb25f,0x3876,0x3222,
+    0x368b,0xb2c2,0x389b,0x32cd,0x36d6,0xb323,0x38ad,0x3383,0x3749,0xb387,0x38d3,0x3426,0x37ca,0xb3e8,0x38fa,0x3491,
+    0x380f,0xb41e,0x3901,0x34fe,0x383c,0xb446,0x3905,0x3571,0x3878,0xb46f,0x3914,0x35ee,0x38b4,0xb493,0x391b,0x366f,
+    0x38ee,0xb4b1,0x391c,0x36f2,0x3927,0xb4cc,0x3914,0x377e,0x396b,0xb4e1,0x390f,0x3808,0x39a1,0xb4e9,0x38f5,0x3853,
+    0x39da,0xb4ea,0x38d8,0x38a2,0x3a27,0xb4e4,0x38c1,0x38f3,0x3a4c,0xb4d5,0x388b,0x3943,0x3a7d,0xb4bb,0x3858,0x3991,
+    0x3aac,0xb49c,0x3822,0x39e0,0x3acf,0xb472,0x37c4,0x3a2b,0x3b06,0xb446,0x3751,0x3a78,0x3b1b,0xb411,0x36be,0x3ac1,
+    0x3b3d,0xb3af,0x3636,0x3b0b,0x3b5c,0xb331,0x35a6,0x3b53,0x3b71,0xb2a2,0x3511,0x3b91,0x3b81,0xb212,0x3478,0x3bd8,
+    0x3b99,0xb177,0x33c5,0x3c0f,0x3ba7,0xb0c7,0x3293,0x3c34,0x3bb0,0xb00a,0x316f,0x3c56,0x3bb7,0xae80,0x305f,0x3c74,
+    0x3bba,0xace7,0x2eb7,0x3c8c,0x3bce,0xaa8d,0x2c7f,0x3ca3,0x3be9,0xa685,0x287a,0x3cb8,0x3c00,0x0206,0x817a,0x3ccc,
+    0x32eb,0x808b,0x3628,0x004e,0x33ad,0x8b0d,0x36d5,0x07ec,0x33ad,0x930d,0x36d5,0x0fec,0x33ad,0x97ef,0x36d5,0x1475,
+    0x33ad,0x9b0d,0x36d5,0x17ed,0x33ad,0x9d82,0x36d5,0x1a31,0x33ae,0x9fee,0x36d5,0x1c76,0x33ae,0xa165,0x36d5,0x1e14,
+    0x33ae,0xa30c,0x36d6,0x1ff2,0x33af,0xa475,0x36d6,0x210a,0x33b0,0xa580,0x36d7,0x223c,0x33b2,0xa6a6,0x36d7,0x2392,
+    0x33b5,0xa7e3,0x36d9,0x2487,0x33b8,0xa89f,0x36db,0x2558,0x33bc,0xa959,0x36dd,0x263e,0x33c0,0xaa1f,0x36df,0x2739,
+    0x33ca,0xaaf1,0x36e6,0x2827,0x33ce,0xabcf,0x36e6,0x28bd,0x33d8,0xac5c,0x36ec,0x2962,0x33e5,0xacd6,0x36f2,0x2a16,
+    0x33f7,0xad55,0x36fc,0x2adb,0x3409,0xadda,0x370b,0x2bb5,0x341a,0xae66,0x3720,0x2c52,0x3431,0xaef8,0x373b,0x2cd8,
+    0x344a,0xaf8f,0x3757,0x2d6a,0x347e,0xb01d,0x379b,0x2e16,0x3497,0xb06d,0x37ae,0x2ec7,0x34cc,0xb0c6,0x37e8,0x2f97,
+    0x3512,0xb125,0x381b,0x3040,0x3546,0xb181,0x382f,0x30bd,0x3595,0xb1e4,0x3853,0x314a,0x35f7,0xb24c,0x3881,0x31e9,
+    0x3630,0xb2a8,0x388b,0x328c,0x36b8,0xb317,0x38c6,0x334f,0x36f4,0xb370,0x38c7,0x3405,0x3769,0xb3d2,0x38e9,0x3471,
+    0x37ef,0xb419,0x390e,0x34e5,0x3830,0xb440,0x391e,0x3558,0x385b,0xb467,0x3918,0x35d3,0x3896,0xb48b,0x391d,0x3653,
+    0x38d3,0xb4ac,0x3920,0x36dc,0x3914,0xb4c6,0x391e,0x3767,0x395b,0xb4db,0x391b,0x37f4,0x398d,0xb4e9,0x3901,0x3845,
+    0x39d3,0xb4ed,0x38ed,0x3893,0x3a09,0xb4e8,0x38c7,0x38e4,0x3a37,0xb4d9,0x3896,0x3935,0x3a84,0xb4c6,0x3876,0x398a,
+    0x3a9f,0xb4a1,0x382e,0x39d4,0x3aca,0xb47b,0x37e0,0x3a24,0x3b04,0xb445,0x3779,0x3a67,0x3b23,0xb419,0x36db,0x3abf,
+    0x3b39,0xb3b9,0x3648,0x3b05,0x3b48,0xb337,0x35ab,0x3b4e,0x3b74,0xb2a5,0x3524,0x3b8d,0x3b79,0xb218,0x3480,0x3bd9,
+    0x3b8c,0xb17d,0x33d1,0x3c10,0x3b9f,0xb0da,0x32a4,0x3c35,0x3bb0,0xb024,0x3184,0x3c58,0x3bac,0xaeac,0x3074,0x3c76,
+    0x3bb6,0xad01,0x2ecd,0x3c90,0x3bd2,0xaa9d,0x2c8c,0x3ca8,0x3be8,0xa680,0x288c,0x3cbd,0x3c00,0x129b,0x8e6d,0x3cd1,
+    0x32e2,0x808b,0x3685,0x0049,0x32fa,0x8ad2,0x369b,0x0733,0x32fa,0x92d2,0x369c,0x0f33,0x32fa,0x97ab,0x369b,0x140d,
+    0x32fa,0x9ad1,0x369b,0x1733,0x32fa,0x9d53,0x369b,0x19a0,0x32fa,0x9fab,0x369b,0x1c0e,0x32fa,0xa138,0x369b,0x1d86,
+    0x32fb,0xa2d0,0x369c,0x1f39,0x32fc,0xa44f,0x369c,0x2095,0x32fd,0xa551,0x369d,0x21ac,0x32fe,0xa66d,0x369e,0x22e4,
+    0x3301,0xa7a0,0x36a0,0x2420,0x3304,0xa877,0x36a1,0x24df,0x3308,0xa92c,0x36a3,0x25b2,0x330d,0xa9ea,0x36a6,0x269a,
+    0x3313,0xaab6,0x36a9,0x2799,0x331b,0xab8c,0x36ae,0x2858,0x3326,0xac36,0x36b4,0x28f1,0x3335,0xacad,0x36bc,0x299a,
+    0x3356,0xad2b,0x36d5,0x2a56,0x3362,0xadaa,0x36d7,0x2b20,0x3386,0xae32,0x36ee,0x2c02,0x33b6,0xaec1,0x370c,0x2c81,
+    0x3407,0xaf60,0x374b,0x2d15,0x341d,0xaff9,0x375d,0x2db0,0x344b,0xb051,0x3794,0x2e63,0x3484,0xb0aa,0x37d6,0x2f2f,
+    0x34c4,0xb107,0x380e,0x3008,0x34f8,0xb162,0x3823,0x3082,0x3545,0xb1c7,0x3847,0x310e,0x3597,0xb22a,0x3869,0x31a7,
+    0x35f1,0xb290,0x388a,0x3250,0x3650,0xb2f4,0x38aa,0x3307,0x36b2,0xb356,0x38c5,0x33cc,0x371c,0xb3b8,0x38e0,0x3450,
+    0x37bc,0xb415,0x391a,0x34ce,0x3806,0xb436,0x390f,0x353a,0x3850,0xb460,0x392b,0x35ba,0x387d,0xb483,0x3922,0x363c,
+    0x38bb,0xb4a4,0x3924,0x36c5,0x38fc,0xb4bf,0x3923,0x3751,0x3947,0xb4d5,0x3923,0x37e1,0x3978,0xb4e5,0x3907,0x383b,
+    0x39b0,0xb4ec,0x38eb,0x3886,0x39f0,0xb4ec,0x38ce,0x38d6,0x3a26,0xb4de,0x38a1,0x3927,0x3a5a,0xb4c8,0x386e,0x3979,
+    0x3a9b,0xb4a7,0x383f,0x39c8,0x3acf,0xb47e,0x3804,0x3a16,0x3ae5,0xb453,0x376e,0x3a69,0x3b0a,0xb41d,0x36e4,0x3ab7,
+    0x3b25,0xb3c1,0x364f,0x3b00,0x3b43,0xb340,0x35ba,0x3b4b,0x3b5d,0xb2b3,0x3521,0x3b94,0x3b71,0xb21b,0x3488,0x3bdb,
+    0x3b88,0xb17e,0x33e1,0x3c12,0x3b9c,0xb0db,0x32b3,0x3c38,0x3ba5,0xb02b,0x3191,0x3c5c,0x3ba8,0xaed5,0x3084,0x3c7a,
+    0x3bba,0xad2d,0x2eea,0x3c94,0x3bcb,0xaae6,0x2ca6,0x3cac,0x3be7,0xa6bb,0x289d,0x3cc2,0x3c00,0x1573,0x9116,0x3cd8,
+    0x324d,0x8087,0x365e,0x0043,0x324b,0x8a90,0x365c,0x067e,0x324b,0x9290,0x365c,0x0e7e,0x324b,0x9762,0x365c,0x134e,
+    0x324b,0x9a90,0x365c,0x167f,0x324b,0x9d20,0x365c,0x1914,0x324b,0x9f62,0x365c,0x1b51,0x324c,0xa106,0x365c,0x1cfc,
+    0x324c,0xa28f,0x365d,0x1e85,0x324d,0xa426,0x365d,0x2023,0x324e,0xa51e,0x365e,0x211f,0x3250,0xa62e,0x365f,0x223b,
+    0x3253,0xa757,0x3661,0x2376,0x3255,0xa84d,0x3662,0x246a,0x3259,0xa8fa,0x3665,0x252a,0x325e,0xa9b1,0x3668,0x25ff,
+    0x3265,0xaa76,0x366b,0x26e9,0x326d,0xab43,0x3670,0x27eb,0x3278,0xac0e,0x3677,0x2883,0x3288,0xac81,0x3681,0x2920,
+    0x329c,0xacf8,0x368e,0x29ce,0x32bc,0xad77,0x36a3,0x2a91,0x32e0,0xadfb,0x36bb,0x2b69,0x332a,0xae8f,0x36f4,0x2c33,
+    0x3351,0xaf1d,0x3706,0x2cb7,0x33a4,0xafbc,0x373c,0x2d53,0x3403,0xb033,0x377a,0x2e03,0x3433,0xb08a,0x37ae,0x2ec6,
+    0x3470,0xb0e5,0x37f1,0x2fa1,0x34c0,0xb148,0x3825,0x304f,0x34fd,0xb1a7,0x383c,0x30d5,0x354f,0xb20c,0x385f,0x316c,
+    0x35a8,0xb272,0x3881,0x3213,0x3608,0xb2d8,0x38a2,0x32cb,0x3685,0xb340,0x38ce,0x3394,0x36e8,0xb3a1,0x38e3,0x3434,
+    0x3757,0xb401,0x38f9,0x34a7,0x37ed,0xb42f,0x391e,0x3523,0x382d,0xb451,0x3921,0x359a,0x3869,0xb479,0x392b,0x3623,
+    0x38a2,0xb49b,0x3926,0x36af,0x38e0,0xb4b7,0x3921,0x373c,0x3922,0xb4ce,0x3919,0x37d0,0x3963,0xb4de,0x390c,0x3832,
+    0x399f,0xb4e6,0x38f2,0x387e,0x39d8,0xb4e7,0x38d0,0x38ca,0x3a22,0xb4e0,0x38b4,0x3919,0x3a4b,0xb4ce,0x3879,0x396d,
+    0x3a84,0xb4b1,0x3845,0x39c1,0x3ab0,0xb48a,0x3805,0x3a12,0x3adb,0xb45c,0x3789,0x3a62,0x3b10,0xb422,0x3708,0x3aab,
+    0x3b23,0xb3d0,0x3665,0x3afd,0x3b3d,0xb348,0x35c7,0x3b46,0x3b59,0xb2bc,0x352f,0x3b93,0x3b6e,0xb224,0x3494,0x3bdc,
+    0x3b7f,0xb181,0x33ec,0x3c14,0x3b92,0xb0d8,0x32bb,0x3c3a,0x3ba8,0xb028,0x319b,0x3c5f,0x3bac,0xaed2,0x308b,0x3c7e,
+    0x3bb7,0xad47,0x2f02,0x3c99,0x3bc9,0xab3c,0x2cc6,0x3cb1,0x3be6,0xa747,0x28c7,0x3cc8,0x3c00,0x02ae,0x804a,0x3cde,
+    0x31a3,0x8080,0x3619,0x003b,0x31a2,0x8a4a,0x3619,0x05d0,0x31a2,0x924a,0x3618,0x0dd0,0x31a2,0x9713,0x3618,0x128a,
+    0x31a2,0x9a4a,0x3618,0x15d0,0x31a2,0x9ce9,0x3618,0x188b,0x31a2,0x9f12,0x3618,0x1a8c,0x31a2,0xa0d0,0x3618,0x1c76,
+    0x31a3,0xa249,0x3619,0x1dd7,0x31a4,0xa3f3,0x3619,0x1f69,0x31a5,0xa4e7,0x361a,0x2098,0x31a7,0xa5eb,0x361b,0x2197,
+    0x31a9,0xa708,0x361d,0x22b4,0x31ac,0xa81e,0x361e,0x23ef,0x31b0,0xa8c4,0x3621,0x24a7,0x31b5,0xa974,0x3624,0x2568,
+    0x31bc,0xaa30,0x3628,0x263e,0x31c5,0xaaf5,0x362e,0x272c,0x31d1,0xabc6,0x3636,0x2819,0x31e5,0xac51,0x3645,0x28ac,
+    0x3201,0xacc5,0x365b,0x2950,0x3216,0xad3e,0x3666,0x2a05,0x324a,0xadc2,0x368f,0x2ad6,0x3277,0xae4b,0x36ac,0x2bbd,
+    0x32c8,0xaee2,0x36e9,0x2c65,0x331b,0xaf7f,0x3722,0x2cfd,0x3366,0xb010,0x374a,0x2da2,0x33f5,0xb06c,0x37ab,0x2e69,
+    0x342b,0xb0c6,0x37da,0x2f3e,0x3482,0xb129,0x3820,0x301b,0x34cf,0xb190,0x3847,0x30a6,0x3527,0xb1f5,0x386a,0x313d,
+    0x357e,0xb25a,0x388c,0x31e0,0x35d3,0xb2bc,0x38a0,0x3293,0x363d,0xb324,0x38c4,0x335a,0x36a5,0xb387,0x38dd,0x3418,
+    0x3717,0xb3e2,0x38f3,0x3488,0x3793,0xb422,0x3909,0x3506,0x3812,0xb44c,0x3923,0x3588,0x3862,0xb472,0x393d,0x3610,
+    0x3888,0xb491,0x3925,0x3699,0x38c9,0xb4ad,0x3922,0x3729,0x3908,0xb4c3,0x3918,0x37bc,0x3952,0xb4d3,0x390f,0x3829,
+    0x398d,0xb4df,0x38f4,0x3878,0x39ce,0xb4e4,0x38da,0x38c6,0x39fd,0xb4da,0x38ac,0x3911,0x3a3d,0xb4d0,0x3884,0x3962,
+    0x3a70,0xb4b7,0x384e,0x39b4,0x3a9c,0xb490,0x380d,0x3a04,0x3ace,0xb464,0x3799,0x3a59,0x3afc,0xb42f,0x3710,0x3aab,
+    0x3b16,0xb3df,0x3675,0x3af6,0x3b4c,0xb357,0x35ed,0x3b41,0x3b4d,0xb2c5,0x353a,0x3b8e,0x3b69,0xb22e,0x34a2,0x3bde,
+    0x3b83,0xb18a,0x3406,0x3c15,0x3b99,0xb0dc,0x32d4,0x3c3c,0x3ba6,0xb025,0x31a6,0x3c62,0x3ba6,0xaec7,0x3093,0x3c82,
+    0x3bb2,0xad34,0x2f07,0x3c9e,0x3bcb,0xab1e,0x2cc4,0x3cb7,0x3be6,0xa7a0,0x28e7,0x3ccf,0x3c00,0x9809,0x12ce,0x3ce5,
+    0x30ed,0x8079,0x35ba,0x0034,0x30fe,0x89fe,0x35ce,0x0527,0x30ff,0x91fe,0x35cf,0x0d27,0x30ff,0x96be,0x35cf,0x11cd,
+    0x30ff,0x99fe,0x35cf,0x1528,0x30ff,0x9cae,0x35cf,0x1808,0x30ff,0x9ebe,0x35cf,0x19cf,0x30ff,0xa096,0x35cf,0x1beb,
+    0x3100,0xa1fd,0x35cf,0x1d2f,0x3101,0xa394,0x35d0,0x1e95,0x3102,0xa4ac,0x35d1,0x2015,0x3104,0xa5a4,0x35d2,0x20f9,
+    0x3106,0xa6b4,0x35d4,0x21f8,0x3109,0xa7da,0x35d6,0x2314,0x310d,0xa88a,0x35d9,0x2428,0x3112,0xa933,0x35dc,0x24d7,
+    0x3119,0xa9e5,0x35e1,0x259a,0x3122,0xaaa2,0x35e7,0x2674,0x312f,0xab6a,0x35f0,0x2766,0x3142,0xac1e,0x35fe,0x283b,
+    0x3165,0xac90,0x361d,0x28d6,0x3180,0xad05,0x362e,0x2981,0x31a9,0xad83,0x364d,0x2a44,0x31fa,0xae11,0x3692,0x2b2b,
+    0x3229,0xae9d,0x36ad,0x2c12,0x327d,0xaf37,0x36e9,0x2ca4,0x32de,0xafdd,0x372a,0x2d4a,0x3374,0xb04f,0x3795,0x2e13,
+    0x33cb,0xb0a3,0x37b9,0x2edc,0x342a,0xb102,0x3801,0x2fc9,0x3477,0xb165,0x3827,0x306b,0x34d0,0xb1ce,0x3851,0x3102,
+    0x3527,0xb234,0x3871,0x31a5,0x358a,0xb29d,0x3894,0x325b,0x361a,0xb30f,0x38d5,0x332c,0x367e,0xb36f,0x38e4,0x33fe,
+    0x36db,0xb3ca,0x38ed,0x346f,0x3758,0xb414,0x3903,0x34eb,0x37d9,0xb440,0x3914,0x356f,0x3830,0xb462,0x391f,0x35f1,
+    0x3876,0xb486,0x392a,0x3684,0x38b0,0xb4a2,0x3920,0x3716,0x38f6,0xb4b9,0x3918,0x37ac,0x393b,0xb4ca,0x390d,0x3823,
+    0x3978,0xb4d5,0x38f4,0x3871,0x39b7,0xb4d5,0x38d5,0x38bd,0x39f4,0xb4d4,0x38b1,0x390e,0x3a2c,0xb4c8,0x3885,0x395d,
+    0x3a6b,0xb4b3,0x3858,0x39ab,0x3a94,0xb498,0x381a,0x39fc,0x3ac0,0xb46d,0x37aa,0x3a4f,0x3aed,0xb437,0x3721,0x3aa0,
+    0x3b10,0xb3f6,0x3689,0x3af1,0x3b2f,0xb36f,0x35ee,0x3b40,0x3b5b,0xb2d2,0x3559,0x3b86,0x3b68,0xb239,0x34ae,0x3bdb,
+    0x3b7b,0xb194,0x3410,0x3c15,0x3b90,0xb0e5,0x32e1,0x3c3d,0x3b9b,0xb02c,0x31b2,0x3c65,0x3ba7,0xaec1,0x3097,0x3c86,
+    0x3bb2,0xad1f,0x2f0a,0x3ca3,0x3bca,0xaae9,0x2cc1,0x3cbe,0x3be5,0xa718,0x28cf,0x3cd6,0x3c00,0x9034,0x0c6f,0x3ced,
+    0x306c,0x8074,0x358c,0x002e,0x3063,0x89ae,0x3582,0x0487,0x3062,0x91ad,0x3580,0x0c86,0x3062,0x9663,0x3580,0x1117,
+    0x3062,0x99ad,0x3580,0x1487,0x3062,0x9c6f,0x3581,0x1713,0x3063,0x9e63,0x3581,0x191a,0x3063,0xa058,0x3581,0x1af4,
+    0x3064,0xa1ad,0x3581,0x1c8e,0x3064,0xa32d,0x3582,0x1dc9,0x3066,0xa46c,0x3583,0x1f30,0x3068,0xa557,0x3584,0x2062,
+    0x306a,0xa659,0x3586,0x2144,0x306d,0xa76f,0x3588,0x2241,0x3071,0xa84d,0x358b,0x235c,0x3076,0xa8ed,0x358f,0x244c,
+    0x307d,0xa995,0x3594,0x24fd,0x3088,0xaa49,0x359c,0x25c3,0x3095,0xab07,0x35a6,0x26a2,0x30aa,0xabd1,0x35b7,0x279e,
+    0x30c7,0xac54,0x35d1,0x285f,0x30ec,0xacc7,0x35ef,0x2902,0x311b,0xad44,0x3616,0x29bd,0x3156,0xadc9,0x3646,0x2a94,
+    0x31bc,0xae60,0x36a0,0x2b95,0x3205,0xaef6,0x36ce,0x2c56,0x3256,0xaf94,0x3700,0x2cf5,0x32db,0xb025,0x375e,0x2db1,
+    0x3349,0xb07f,0x3798,0x2e7f,0x33d7,0xb0df,0x37e7,0x2f6b,0x343a,0xb143,0x381b,0x303a,0x348d,0xb1a9,0x3840,0x30cd,
+    0x34ed,0xb214,0x386a,0x3174,0x3562,0xb282,0x389b,0x322d,0x35bb,0xb2e6,0x38ae,0x32ee,0x362f,0xb350,0x38ce,0x33c9,
+    0x36bd,0xb3b7,0x38f9,0x345a,0x373e,0xb407,0x390d,0x34d3,0x37aa,0xb434,0x3913,0x3559,0x3821,0xb45b,0x3929,0x35e3,
+    0x3858,0xb47d,0x3921,0x3671,0x3899,0xb497,0x391b,0x3703,0x38ed,0xb4b1,0x3923,0x37a2,0x392f,0xb4bf,0x3910,0x381c,
+    0x3964,0xb4ca,0x38f0,0x386d,0x39ac,0xb4cc,0x38da,0x38ba,0x39e5,0xb4ca,0x38b2,0x390d,0x3a1b,0xb4bd,0x3883,0x395c,
+    0x3a61,0xb4ac,0x385c,0x39ac,0x3a85,0xb48f,0x381b,0x39f8,0x3ab8,0xb46f,0x37bf,0x3a48,0x3ae2,0xb444,0x3738,0x3a9a,
+    0x3b0c,0xb408,0x36a3,0x3aed,0x3b2d,0xb38a,0x3604,0x3b3e,0x3b4f,0xb2f8,0x3566,0x3b8f,0x3b62,0xb253,0x34c0,0x3bdb,
+    0x3b74,0xb1a8,0x3419,0x3c17,0x3b90,0xb0ee,0x32fa,0x3c3a,0x3b9c,0xb038,0x31bc,0x3c6a,0x3ba1,0xaed5,0x30a0,0x3c8d,
+    0x3baf,0xad26,0x2f14,0x3caa,0x3bc6,0xaad6,0x2cc4,0x3cc5,0x3be4,0xa697,0x28ba,0x3cde,0x3c00,0x17d2,0x9405,0x3cf6,
+    0x2f75,0x806c,0x3514,0x0028,0x2f99,0x8957,0x352d,0x03ec,0x2f9b,0x9158,0x352d,0x0bd9,0x2f9a,0x9602,0x352d,0x106a,
+    0x2f9c,0x9958,0x352e,0x13da,0x2f9b,0x9c2c,0x352d,0x1623,0x2f9b,0x9e02,0x352e,0x186d,0x2f9c,0xa017,0x352e,0x1a09,
+    0x2f9d,0xa157,0x352e,0x1be8,0x2f9e,0xa2c1,0x352f,0x1d07,0x2fa2,0xa429,0x3530,0x1e41,0x2fa5,0xa507,0x3531,0x1fa3,
+    0x2fa9,0xa5f9,0x3533,0x2099,0x2fb0,0xa6fe,0x3536,0x2179,0x2fb7,0xa80c,0x3538,0x2274,0x2fc3,0xa8a2,0x353d,0x2390,
+    0x2fd2,0xa941,0x3543,0x2467,0x2fe8,0xa9ec,0x354c,0x251b,0x3004,0xaaa0,0x355b,0x25e8,0x301b,0xab61,0x356f,0x26d2,
+    0x3038,0xac17,0x3589,0x27de,0x3064,0xac89,0x35b2,0x288b,0x3096,0xad01,0x35de,0x293d,0x30d2,0xad84,0x3611,0x2a0b,
+    0x311d,0xae12,0x364d,0x2afa,0x3188,0xaeb0,0x36a9,0x2c0b,0x31d9,0xaf4b,0x36d9,0x2ca5,0x3261,0xb000,0x373c,0x2d5e,
+    0x32cd,0xb05a,0x3776,0x2e28,0x3359,0xb0ba,0x37c5,0x2f11,0x33f6,0xb11e,0x380b,0x300b,0x346a,0xb18c,0x384a,0x30a4,
+    0x34bd,0xb1f2,0x3866,0x3145,0x3511,0xb257,0x387d,0x31f4,0x359e,0xb2ca,0x38b9,0x32c3,0x35f8,0xb330,0x38c6,0x3397,
+    0x3693,0xb39a,0x38f9,0x3443,0x36f1,0xb3f2,0x38f9,0x34bb,0x3775,0xb425,0x390b,0x3541,0x37f4,0xb44e,0x3914,0x35cc,
+    0x384d,0xb471,0x3928,0x365f,0x3884,0xb48d,0x3919,0x36f4,0x38c9,0xb4a5,0x3912,0x3791,0x3923,0xb4b4,0x3915,0x3817,
+    0x394c,0xb4bc,0x38e8,0x3865,0x39a5,0xb4c6,0x38df,0x38bd,0x39d4,0xb4bd,0x38ad,0x390a,0x3a08,0xb4b0,0x387d,0x3959,
+    0x3a4e,0xb49e,0x3856,0x39ab,0x3a76,0xb482,0x3817,0x39f9,0x3aab,0xb464,0x37bf,0x3a4a,0x3adb,0xb43d,0x3740,0x3a9c,
+    0x3b12,0xb40e,0x36c2,0x3ae8,0x3b2c,0xb3ab,0x3620,0x3b3b,0x3b40,0xb316,0x356d,0x3b8c,0x3b58,0xb277,0x34c9,0x3bdf,
+    0x3b70,0xb1cb,0x3424,0x3c1a,0x3b88,0xb116,0x3302,0x3c47,0x3b9a,0xb04e,0x31ce,0x3c6f,0x3ba1,0xaefc,0x30ad,0x3c93,
+    0x3bad,0xad41,0x2f2b,0x3cb1,0x3bc5,0xaaf2,0x2cd1,0x3ccd,0x3be3,0xa6a2,0x28c1,0x3ce7,0x3c00,0x1a1d,0x9667,0x3d00,
+    0x2e75,0x8065,0x34cd,0x0022,0x2e81,0x88fd,0x34d6,0x035b,0x2e80,0x90fd,0x34d5,0x0ab5,0x2e80,0x959d,0x34d6,0x0f8d,
+    0x2e80,0x98fd,0x34d5,0x12b7,0x2e81,0x9bcb,0x34d5,0x1540,0x2e81,0x9d9c,0x34d6,0x1792,0x2e82,0x9fa3,0x34d6,0x192a,
+    0x2e83,0xa0fc,0x34d6,0x1ac6,0x2e85,0xa24d,0x34d7,0x1c50,0x2e88,0xa3c4,0x34d9,0x1d5f,0x2e8b,0xa4b1,0x34da,0x1e92,
+    0x2e8f,0xa593,0x34dc,0x1fed,0x2e95,0xa688,0x34de,0x20bb,0x2e9e,0xa78f,0x34e2,0x2199,0x2eaa,0xa853,0x34e7,0x2295,
+    0x2ebb,0xa8e9,0x34ee,0x23b3,0x2ed4,0xa989,0x34fb,0x247d,0x2ef7,0xaa35,0x350b,0x2538,0x2f28,0xaaec,0x3524,0x2611,
+    0x2f6c,0xabb4,0x3546,0x270e,0x2fc8,0xac48,0x3574,0x281b,0x301b,0xacc0,0x35a8,0x28c6,0x305b,0xad40,0x35e0,0x298d,
+    0x30a3,0xadc9,0x361d,0x2a72,0x3100,0xae60,0x3667,0x2b7f,0x3166,0xaf03,0x36b5,0x2c5c,0x31e6,0xafb4,0x3712,0x2d0f,
+    0x3276,0xb038,0x3773,0x2ddc,0x32e0,0xb093,0x379d,0x2eba,0x33a5,0xb0fe,0x380c,0x2fc8,0x3420,0xb163,0x382c,0x3073,
+    0x3479,0xb1cd,0x384f,0x3116,0x34f8,0xb23c,0x388a,0x31cf,0x354c,0xb2a4,0x3899,0x3291,0x35f4,0xb332,0x38ed,0x338f,
+    0x3639,0xb376,0x38d6,0x3429,0x36c7,0xb3d6,0x38f7,0x34a6,0x3759,0xb416,0x390d,0x3529,0x37cb,0xb441,0x3910,0x35ba,
+    0x3827,0xb462,0x3912,0x3649,0x3872,0xb482,0x3916,0x36e5,0x38b0,0xb498,0x3907,0x377f,0x3918,0xb4aa,0x3918,0x3811,
+    0x393c,0xb4b1,0x38e4,0x3861,0x397d,0xb4b4,0x38c7,0x38b5,0x39c2,0xb4ae,0x38a7,0x3906,0x39f6,0xb4a2,0x3876,0x3958,
+    0x3a3a,0xb48f,0x384d,0x39ab,0x3a67,0xb474,0x3812,0x39fb,0x3a99,0xb453,0x37aa,0x3a4d,0x3ada,0xb42b,0x3740,0x3a9c,
+    0x3af2,0xb3f8,0x36a5,0x3ae6,0x3b17,0xb394,0x3613,0x3b3b,0x3b3d,0xb326,0x3583,0x3b8f,0x3b61,0xb293,0x34e8,0x3bd7,
+    0x3b70,0xb1f5,0x3436,0x3c1b,0x3b86,0xb141,0x331f,0x3c4a,0x3b9b,0xb07a,0x31e8,0x3c75,0x3b9f,0xaf41,0x30c0,0x3c9a,
+    0x3bab,0xad77,0x2f47,0x3cb9,0x3bc5,0xab47,0x2ceb,0x3cd6,0x3be2,0xa714,0x28e5,0x3cf1,0x3c00,0x18e7,0x950f,0x3d0a,
+    0x2d68,0x805e,0x346c,0x001d,0x2d77,0x889e,0x3479,0x02d2,0x2d78,0x909e,0x3479,0x09a4,0x2d77,0x9531,0x3479,0x0e59,
+    0x2d78,0x989d,0x3479,0x11a5,0x2d78,0x9b36,0x3479,0x146a,0x2d78,0x9d31,0x3479,0x165f,0x2d79,0x9f10,0x3479,0x1859,
+    0x2d7a,0xa09d,0x347a,0x19b5,0x2d7c,0xa1d4,0x347b,0x1b48,0x2d7f,0xa32f,0x347c,0x1c8b,0x2d82,0xa458,0x347d,0x1d91,
+    0x2d87,0xa528,0x3480,0x1ebd,0x2d8d,0xa60b,0x3483,0x2009,0x2d96,0xa6fe,0x3486,0x20cb,0x2da3,0xa801,0x348d,0x21aa,
+    0x2dbb,0xa88e,0x349b,0x22ab,0x2dd1,0xa923,0x34a5,0x23d0,0x2df8,0xa9c5,0x34bb,0x2495,0x2e32,0xaa76,0x34db,0x255f,
+    0x2e7d,0xab37,0x3504,0x264c,0x2ed5,0xac05,0x3531,0x2763,0x2f46,0xac79,0x3569,0x2855,0x2ff7,0xacff,0x35c6,0x291d,
+    0x3039,0xad83,0x35f4,0x29f7,0x3090,0xae15,0x3634,0x2afa,0x30f3,0xaeb5,0x3685,0x2c15,0x3174,0xaf67,0x36e6,0x2cc7,
+    0x31fd,0xb011,0x3741,0x2d90,0x328a,0xb071,0x3792,0x2e73,0x331d,0xb0d5,0x37db,0x2f73,0x33cd,0xb13f,0x3818,0x304b,
+    0x343f,0xb1a6,0x383c,0x30ea,0x34ab,0xb216,0x3868,0x31a1,0x3530,0xb282,0x38a0,0x3268,0x3591,0xb2ee,0x38b1,0x3341,
+    0x3610,0xb354,0x38cf,0x3414,0x368f,0xb3bb,0x38e8,0x3494,0x370a,0xb408,0x38f4,0x3515,0x379b,0xb433,0x3907,0x35a6,
+    0x381c,0xb456,0x3917,0x3639,0x3864,0xb475,0x3918,0x36d4,0x389c,0xb48b,0x3901,0x3771,0x38e2,0xb49d,0x38f3,0x380a,
+    0x3927,0xb4a5,0x38dc,0x385c,0x396c,0xb4a9,0x38c3,0x38b2,0x39ae,0xb49e,0x389f,0x3901,0x39e9,0xb495,0x3873,0x3959,
+    0x3a28,0xb482,0x3845,0x39ae,0x3a58,0xb465,0x3809,0x39ff,0x3a8a,0xb444,0x379d,0x3a53,0x3abf,0xb41b,0x3721,0x3aa3,
+    0x3ae9,0xb3d7,0x3698,0x3af5,0x3b10,0xb36f,0x360b,0x3b47,0x3b35,0xb2ff,0x3579,0x3b98,0x3b53,0xb27f,0x34dc,0x3be8,
+    0x3b6f,0xb1f7,0x343e,0x3c1f,0x3b86,0xb162,0x333f,0x3c4c,0x3b9c,0xb0b0,0x3208,0x3c7a,0x3ba7,0xafaf,0x30d9,0x3ca0,
+    0x3bab,0xadde,0x2f7a,0x3cc1,0x3bc2,0xabf0,0x2d18,0x3cdf,0x3be2,0xa808,0x2922,0x3cfb,0x3c00,0x90b2,0x0b0d,0x3d16,
+    0x2c5e,0x8055,0x33ef,0x0017,0x2c81,0x8839,0x3417,0x0253,0x2c81,0x9039,0x3418,0x08a6,0x2c81,0x94c0,0x3418,0x0d3b,
+    0x2c81,0x9839,0x3418,0x10a7,0x2c82,0x9a99,0x3418,0x1348,0x2c82,0x9cc0,0x3418,0x1541,0x2c83,0x9e77,0x3418,0x172e,
+    0x2c84,0xa038,0x3419,0x18b8,0x2c86,0xa155,0x341a,0x1a08,0x2c88,0xa293,0x341b,0x1b89,0x2c8c,0xa3f2,0x341d,0x1ca2,
+    0x2c90,0xa4b8,0x341f,0x1da1,0x2c98,0xa588,0x3423,0x1ec6,0x2ca1,0xa666,0x3428,0x200c,0x2cb0,0xa757,0x3430,0x20cf,
+    0x2cc6,0xa82d,0x343d,0x21b3,0x2ce4,0xa8ba,0x344f,0x22be,0x2d18,0xa955,0x3471,0x23fe,0x2d4f,0xa9fc,0x3491,0x24ba,
+    0x2da0,0xaab8,0x34c0,0x259b,0x2e02,0xab87,0x34f8,0x26a6,0x2e77,0xac35,0x3535,0x27e1,0x2f00,0xacb3,0x3579,0x28ab,
+    0x2fb6,0xad3c,0x35d0,0x2988,0x3050,0xaddb,0x3642,0x2a95,0x3095,0xae6f,0x3665,0x2bb0,0x310f,0xaf1b,0x36c0,0x2c85,
+    0x318d,0xafcc,0x3708,0x2d46,0x3218,0xb048,0x3760,0x2e28,0x32b1,0xb0ad,0x37b1,0x2f27,0x3383,0xb11a,0x3814,0x3027,
+    0x3410,0xb182,0x382e,0x30c6,0x3472,0xb1ee,0x3852,0x3177,0x34e2,0xb25b,0x387b,0x323d,0x3565,0xb2c5,0x38a5,0x3313,
+    0x35d0,0xb32e,0x38b8,0x33fd,0x3656,0xb396,0x38d6,0x347e,0x36e1,0xb3f4,0x38ee,0x3505,0x3771,0xb423,0x38fe,0x3592,
+    0x37f5,0xb44a,0x3901,0x3629,0x3857,0xb467,0x3916,0x36c2,0x3888,0xb480,0x38f9,0x3764,0x38cd,0xb490,0x38eb,0x3804,
+    0x3912,0xb499,0x38d4,0x3857,0x395a,0xb49e,0x38bb,0x38af,0x39a5,0xb496,0x389e,0x3902,0x39d4,0xb487,0x3868,0x3957,
+    0x3a12,0xb472,0x3838,0x39ac,0x3a4c,0xb456,0x3803,0x3a03,0x3a7e,0xb433,0x378e,0x3a57,0x3ab0,0xb40a,0x3710,0x3aac,
+    0x3ada,0xb3b1,0x3684,0x3afd,0x3b01,0xb346,0x35f7,0x3b51,0x3b29,0xb2ce,0x3566,0x3ba3,0x3b3f,0xb24b,0x34c7,0x3bf4,
+    0x3b6a,0xb1c4,0x3434,0x3c27,0x3b7f,0xb136,0x332f,0x3c55,0x3b94,0xb096,0x3201,0x3c82,0x3ba6,0xafbf,0x30e3,0x3ca5,
+    0x3bac,0xae3c,0x2fa5,0x3cca,0x3bc6,0xac79,0x2d54,0x3cea,0x3be2,0xa8fe,0x29a3,0x3d07,0x3c00,0x9f2c,0x1a7b,0x3d23,
+    0x2b15,0x804d,0x333b,0x0013,0x2b3e,0x87a1,0x3364,0x01de,0x2b3e,0x8fa1,0x3365,0x0779,0x2b3e,0x944b,0x3364,0x0c34,
+    0x2b3e,0x97a1,0x3365,0x0f7b,0x2b3f,0x99f6,0x3365,0x11db,0x2b3f,0x9c4a,0x3365,0x143a,0x2b40,0x9dd7,0x3366,0x15c9,
+    0x2b43,0x9f9d,0x3368,0x179f,0x2b47,0xa0d0,0x336a,0x18e1,0x2b4c,0xa1f0,0x336c,0x1a1e,0x2b53,0xa32c,0x3370,0x1b8e,
+    0x2b5d,0xa443,0x3376,0x1c9c,0x2b6c,0xa4ff,0x337e,0x1d95,0x2b82,0xa5ca,0x338c,0x1eb7,0x2ba3,0xa6a5,0x33a1,0x2006,
+    0x2bd5,0xa796,0x33c4,0x20d1,0x2c17,0xa851,0x3402,0x21c7,0x2c44,0xa8e1,0x341f,0x22ea,0x2c94,0xa989,0x3458,0x2429,
+    0x2cd8,0xaa39,0x347f,0x24fa,0x2d40,0xab04,0x34bc,0x25fa,0x2dd6,0xabed,0x3518,0x2733,0x2e51,0xac6f,0x3552,0x284d,
+    0x2ee7,0xacf0,0x3594,0x291d,0x2f93,0xad84,0x35de,0x2a19,0x3036,0xae24,0x3638,0x2b40,0x30aa,0xaecf,0x368c,0x2c4a,
+    0x3129,0xaf84,0x36e0,0x2d0c,0x31ba,0xb023,0x3739,0x2dec,0x3279,0xb08b,0x37b3,0x2eee,0x330c,0xb0f3,0x37ee,0x3005,
+    0x33c2,0xb15e,0x381c,0x30a4,0x3446,0xb1ca,0x3844,0x3155,0x34c5,0xb23a,0x3878,0x321c,0x3541,0xb29b,0x389a,0x32e8,
+    0x35a3,0xb30c,0x38ac,0x33da,0x3627,0xb36f,0x38c5,0x346a,0x36ab,0xb3cf,0x38da,0x34f1,0x3754,0xb413,0x38fa,0x3580,
+    0x37c2,0xb439,0x38f2,0x3616,0x3837,0xb45b,0x3903,0x36b4,0x3875,0xb472,0x38f1,0x3754,0x38be,0xb484,0x38e2,0x37f9,
+    0x3907,0xb48f,0x38d3,0x3853,0x3942,0xb48f,0x38b0,0x38a7,0x3994,0xb489,0x3897,0x38fe,0x39c9,0xb47f,0x3865,0x3959,
+    0x3a07,0xb468,0x3835,0x39af,0x3a3d,0xb44a,0x37f8,0x3a06,0x3a74,0xb426,0x3782,0x3a5c,0x3aa2,0xb3f4,0x36ff,0x3ab2,
+    0x3acb,0xb38c,0x3673,0x3b05,0x3af9,0xb31f,0x35e6,0x3b5d,0x3b22,0xb29d,0x3558,0x3bab,0x3b38,0xb21b,0x34b7,0x3c03,
+    0x3b51,0xb18d,0x341b,0x3c31,0x3b72,0xb0f5,0x330b,0x3c60,0x3b92,0xb04e,0x31e8,0x3c8c,0x3b9a,0xaf33,0x30cd,0x3cb3,
+    0x3baf,0xadb3,0x2f73,0x3cd6,0x3bc4,0xac23,0x2d32,0x3cf6,0x3be2,0xa8f1,0x299e,0x3d14,0x3c01,0xa257,0x1e05,0x3d32,
+    0x29a3,0x8045,0x3291,0x000f,0x29a3,0x86c7,0x3291,0x0174,0x29a3,0x8ec7,0x3291,0x05d2,0x29a3,0x93a0,0x3291,0x0a8d,
+    0x29a3,0x96c6,0x3291,0x0dd4,0x29a4,0x994b,0x3292,0x1090,0x29a5,0x9b9f,0x3292,0x1299,0x29a6,0x9d30,0x3293,0x1485,
+    0x29a9,0x9ec3,0x3295,0x15f9,0x29ac,0xa047,0x3296,0x17ac,0x29b1,0xa146,0x329a,0x18d5,0x29b9,0xa25f,0x329e,0x1a00,
+    0x29c3,0xa393,0x32a5,0x1b60,0x29d4,0xa471,0x32b1,0x1c80,0x29ee,0xa527,0x32c4,0x1d79,0x2a18,0xa5f1,0x32e5,0x1ea4,
+    0x2a55,0xa6cf,0x3315,0x2007,0x2ac0,0xa7ce,0x336e,0x20ea,0x2b1c,0xa870,0x33ae,0x21f7,0x2bc3,0xa911,0x3416,0x2349,
+    0x2c3e,0xa9c3,0x3456,0x2471,0x2ca8,0xaa8a,0x3499,0x2567,0x2d0b,0xab5d,0x34c9,0x2687,0x2db9,0xac2e,0x3530,0x27f4,
+    0x2e39,0xacae,0x3564,0x28c6,0x2ef7,0xad3e,0x35bb,0x29bc,0x2fca,0xaddc,0x3611,0x2add,0x3055,0xae85,0x3663,0x2c16,
+    0x30cf,0xaf38,0x36b2,0x2cd6,0x3179,0xafff,0x372a,0x2db8,0x3201,0xb062,0x376a,0x2eb0,0x32ad,0xb0c7,0x37bc,0x2fc6,
+    0x3369,0xb134,0x3809,0x3083,0x342b,0xb1a9,0x3842,0x313b,0x3481,0xb20e,0x3852,0x31f5,0x34f8,0xb27c,0x3878,0x32cd,
+    0x3582,0xb2e9,0x38a2,0x33b8,0x360b,0xb34e,0x38c2,0x345a,0x3684,0xb3ae,0x38d0,0x34e2,0x3703,0xb3ff,0x38d7,0x356d,
+    0x3797,0xb428,0x38e5,0x3605,0x3819,0xb44a,0x38ed,0x36a3,0x385c,0xb464,0x38e3,0x3744,0x38b4,0xb47a,0x38eb,0x37f2,
+    0x38f1,0xb485,0x38c8,0x384e,0x3938,0xb48b,0x38ae,0x38a7,0x3988,0xb47f,0x3894,0x38f9,0x39bc,0xb477,0x3861,0x3958,
+    0x39f8,0xb45f,0x382f,0x39af,0x3a2e,0xb441,0x37ed,0x3a08,0x3a6b,0xb41e,0x377b,0x3a64,0x3aca,0xb3f2,0x3742,0x3aca,
+    0x3abe,0xb374,0x3663,0x3b0f,0x3af0,0xb2fa,0x35db,0x3b62,0x3b0a,0xb27d,0x353c,0x3bbe,0x3b30,0xb1f0,0x34a8,0x3c0c,
+    0x3b4c,0xb15b,0x340b,0x3c3b,0x3b6e,0xb0ba,0x32ee,0x3c6c,0x3b86,0xb00b,0x31c8,0x3c9a,0x3b93,0xae96,0x30b0,0x3cc1,
+    0x3ba7,0xad06,0x2f2f,0x3ce5,0x3bc0,0xaac9,0x2cd9,0x3d07,0x3be1,0xa6c8,0x28e7,0x3d26,0x3c00,0x11c4,0x8e73,0x3d44,
+    0x2827,0x803b,0x31a0,0x000b,0x2837,0x85e4,0x31b6,0x0116,0x2836,0x8de4,0x31b6,0x0459,0x2836,0x92a1,0x31b5,0x08e5,
+    0x2836,0x95e4,0x31b5,0x0c5b,0x2837,0x989a,0x31b6,0x0ed3,0x2838,0x9aa1,0x31b6,0x10f1,0x283a,0x9c81,0x31b8,0x12cb,
+    0x283c,0x9de1,0x31b9,0x1481,0x283f,0x9f6f,0x31bc,0x15d0,0x2845,0xa096,0x31c0,0x1760,0x284c,0xa18b,0x31c5,0x189d,
+    0x2859,0xa297,0x31cf,0x19bb,0x286d,0xa3bf,0x31e1,0x1b16,0x288e,0xa483,0x31ff,0x1c5e,0x28c1,0xa53b,0x322e,0x1d65,
+    0x290a,0xa60b,0x3271,0x1eae,0x2969,0xa6f7,0x32c3,0x2024,0x29e8,0xa802,0x332d,0x2124,0x2a95,0xa89f,0x33ba,0x2266,
+    0x2b3d,0xa949,0x3416,0x23e8,0x2c02,0xaa08,0x3454,0x24df,0x2c98,0xaaea,0x34b8,0x2608,0x2d03,0xabcc,0x34e5,0x2755,
+    0x2dac,0xac6a,0x353d,0x2878,0x2e67,0xacfb,0x3593,0x296d,0x2f2d,0xad95,0x35e2,0x2a87,0x3002,0xae3b,0x362d,0x2bd0,
+    0x307e,0xaeed,0x3681,0x2ca7,0x311b,0xafb0,0x36ee,0x2d85,0x31a2,0xb038,0x372d,0x2e79,0x3259,0xb0a2,0x3790,0x2f95,
+    0x3336,0xb110,0x3804,0x306a,0x33da,0xb17b,0x381b,0x3118,0x3459,0xb1e8,0x3841,0x31d9,0x34d9,0xb255,0x386e,0x32ae,
+    0x3542,0xb2bf,0x3882,0x3395,0x35ca,0xb329,0x38a2,0x344a,0x3651,0xb389,0x38b9,0x34d0,0x36f3,0xb3f5,0x38de,0x356c,
+    0x375a,0xb412,0x38ca,0x35ec,0x3801,0xb43a,0x38dd,0x3693,0x3845,0xb453,0x38d4,0x3733,0x388b,0xb468,0x38c6,0x37dc,
+    0x38e0,0xb477,0x38c3,0x3846,0x3920,0xb47e,0x38a2,0x389f,0x397f,0xb478,0x3892,0x38f6,0x39aa,0xb471,0x3859,0x3955,
+    0x39eb,0xb456,0x382a,0x39a7,0x3a1e,0xb43d,0x37dd,0x3a08,0x3a53,0xb417,0x3765,0x3a63,0x3a8d,0xb3d5,0x36eb,0x3ac1,
+    0x3ab5,0xb367,0x365b,0x3b18,0x3ae4,0xb2ee,0x35cf,0x3b71,0x3b0c,0xb26e,0x3536,0x3bd3,0x3b2f,0xb1dd,0x349d,0x3c19,
+    0x3b4c,0xb142,0x3403,0x3c4b,0x3b68,0xb09b,0x32d4,0x3c80,0x3b8a,0xafa2,0x31b1,0x3c9d,0x3b87,0xae28,0x3094,0x3cd7,
+    0x3b9c,0xac7a,0x2eeb,0x3cfa,0x3bbe,0xa978,0x2c8a,0x3d1b,0x3be0,0xa387,0x282d,0x3d3b,0x3bff,0x2348,0x9f6d,0x3d5a,
+    0x2607,0x8033,0x30e3,0x0008,0x25f2,0x84fa,0x30d2,0x00c4,0x25f3,0x8cfa,0x30d3,0x0312,0x25f3,0x9199,0x30d2,0x06ea,
+    0x25f4,0x94f9,0x30d2,0x0a28,0x25f4,0x97c6,0x30d2,0x0cd5,0x25f6,0x9999,0x30d3,0x0f03,0x25f9,0x9b9b,0x30d5,0x10d8,
+    0x25fe,0x9cf7,0x30d7,0x1274,0x2605,0x9e47,0x30da,0x1433,0x2610,0x9fbe,0x30de,0x1561,0x2623,0xa0af,0x30e8,0x16d3,
+    0x2643,0xa196,0x30f9,0x184f,0x2684,0xa29d,0x311e,0x1970,0x26ce,0xa3c1,0x3145,0x1adb,0x2749,0xa48a,0x3187,0x1c57,
+    0x27e7,0xa54c,0x31d8,0x1d82,0x286a,0xa633,0x3250,0x1f05,0x28f3,0xa73a,0x32cc,0x2076,0x2995,0xa833,0x3351,0x21a8,
+    0x2a2f,0xa8d7,0x33b5,0x2319,0x2b27,0xa999,0x3436,0x2478,0x2bf3,0xaa65,0x346c,0x258a,0x2c8b,0xab4f,0x34b9,0x26db,
+    0x2d2f,0xac2b,0x3513,0x283a,0x2dde,0xacb8,0x3562,0x2928,0x2e9b,0xad50,0x35ad,0x2a40,0x2f81,0xadf2,0x3603,0x2b82,
+    0x303f,0xaea5,0x365d,0x2c7f,0x30ba,0xaf5a,0x369f,0x2d53,0x316d,0xb016,0x371b,0x2e53,0x3221,0xb07a,0x3779,0x2f65,
+    0x32b4,0xb0e2,0x37a5,0x304d,0x3391,0xb150,0x3806,0x30fd,0x343d,0xb1c2,0x3837,0x31c1,0x349a,0xb229,0x3848,0x328e,
+    0x3510,0xb291,0x3866,0x3371,0x3592,0xb2f8,0x3884,0x3434,0x3622,0xb35f,0x38a3,0x34bd,0x36a9,0xb3b3,0x38b3,0x3547,
+    0x373b,0xb405,0x38c1,0x35e1,0x37e4,0xb42a,0x38d4,0x3681,0x3833,0xb443,0x38c9,0x371e,0x3879,0xb45d,0x38bf,0x37d0,
+    0x38cc,0xb465,0x38b2,0x3839,0x3907,0xb471,0x3894,0x3897,0x394e,0xb470,0x3876,0x38f3,0x3995,0xb469,0x3854,0x3950,
+    0x39e9,0xb454,0x3830,0x39a9,0x3a13,0xb43d,0x37e0,0x3a0b,0x3a50,0xb41c,0x376f,0x3a6b,0x3a89,0xb3e3,0x36f1,0x3acc,
+    0x3ab2,0xb378,0x3660,0x3b27,0x3aeb,0xb2f6,0x35df,0x3b7b,0x3b11,0xb27d,0x353d,0x3bec,0x3b2e,0xb1eb,0x349a,0x3c2a,
+    0x3b49,0xb149,0x33ed,0x3c60,0x3b60,0xb099,0x32b8,0x3c94,0x3b7d,0xaf95,0x319f,0x3cb8,0x3b84,0xadf8,0x3084,0x3ceb,
+    0x3b9d,0xac34,0x2ec0,0x3d10,0x3bbe,0xa8bd,0x2c58,0x3d33,0x3be0,0x9f79,0x275b,0x3d54,0x3bff,0x2602,0xa229,0x3d75,
+    0x239f,0x8029,0x2fb0,0x0005,0x23bc,0x8407,0x2fcd,0x0080,0x23be,0x8c08,0x2fd0,0x0200,0x23be,0x9089,0x2fd0,0x0480,
+    0x23bf,0x9408,0x2fd0,0x0803,0x23c1,0x964d,0x2fd1,0x0a51,0x23c4,0x9887,0x2fd2,0x0c9b,0x23ca,0x9a29,0x2fd5,0x0e67,
+    0x23d4,0x9c05,0x2fdb,0x1050,0x23e5,0x9d16,0x2fe4,0x11b0,0x2401,0x9e48,0x2ff5,0x136c,0x2419,0x9fa1,0x300a,0x14d0,
+    0x2446,0xa096,0x3029,0x163e,0x248f,0xa17b,0x305c,0x1811,0x2505,0xa28e,0x30ae,0x1956,0x258d,0xa3cb,0x3100,0x1afd,
+    0x265d,0xa4a6,0x317e,0x1c9b,0x2703,0xa575,0x31c6,0x1df9,0x27fa,0xa66b,0x3237,0x1fc0,0x28bb,0xa79d,0x32ea,0x210f,
+    0x2945,0xa868,0x333b,0x226f,0x2a1e,0xa91e,0x33c3,0x2416,0x2b1b,0xa9f2,0x343d,0x252d,0x2c16,0xaad7,0x348a,0x2679,
+    0x2caf,0xabd7,0x34d7,0x2804,0x2d52,0xac73,0x351d,0x28ed,0x2e09,0xad08,0x3566,0x29ff,0x2f14,0xadb2,0x35df,0x2b4b,
+    0x2fe4,0xae59,0x361a,0x2c5c,0x3083,0xaf10,0x3678,0x2d31,0x310c,0xafd5,0x36c3,0x2e26,0x31bc,0xb051,0x3724,0x2f3b,
+    0x3277,0xb0b9,0x3780,0x3038,0x3321,0xb120,0x37b9,0x30e1,0x33fe,0xb190,0x3809,0x31a2,0x3467,0xb1f5,0x3825,0x326b,
+    0x34e6,0xb264,0x384d,0x3353,0x356d,0xb2cd,0x3871,0x3425,0x35f0,0xb32e,0x388a,0x34a8,0x367d,0xb380,0x3898,0x352e,
+    0x3710,0xb3da,0x38af,0x35c8,0x378f,0xb415,0x38ad,0x3669,0x3826,0xb436,0x38c6,0x3711,0x385e,0xb44d,0x38ab,0x37b9,
+    0x38c0,0xb45a,0x38b2,0x3830,0x38f5,0xb469,0x388b,0x3890,0x3942,0xb46f,0x3876,0x38f0,0x3988,0xb465,0x384f,0x394b,
+    0x39c8,0xb457,0x3823,0x39ac,0x3a13,0xb43f,0x37ee,0x3a0e,0x3a46,0xb41e,0x376b,0x3a6d,0x3a87,0xb3f1,0x36fa,0x3ad1,
+    0x3ab1,0xb38f,0x366a,0x3b33,0x3ae4,0xb325,0x35da,0x3b9d,0x3b05,0xb2a3,0x3536,0x3c01,0x3b27,0xb215,0x349b,0x3c37,
+    0x3b47,0xb177,0x33fa,0x3c6f,0x3b65,0xb0c4,0x32cd,0x3ca5,0x3b80,0xafe6,0x31ab,0x3cce,0x3b86,0xae38,0x3090,0x3d00,
+    0x3b9f,0xac60,0x2ed4,0x3d29,0x3bbf,0xa8d8,0x2c5e,0x3d4e,0x3be1,0x9e33,0x2706,0x3d72,0x3c00,0x26be,0xa35c,0x3d94,
+    0x206b,0x801f,0x2dea,0x0003,0x206d,0x830e,0x2dec,0x0049,0x206d,0x8a1d,0x2ded,0x0124,0x206d,0x8ee0,0x2dec,0x0293,
+    0x206e,0x921c,0x2dea,0x049a,0x2071,0x94c6,0x2df0,0x074b,0x2074,0x96de,0x2df1,0x095e,0x207a,0x98ac,0x2df6,0x0b92,
+    0x2085,0x9a1a,0x2dfd,0x0d33,0x209b,0x9bbc,0x2e10,0x0f0d,0x20c7,0x9cd0,0x2e38,0x10c3,0x2125,0x9df3,0x2e93,0x127b,
+    0x2191,0x9f45,0x2eee,0x1468,0x225a,0xa075,0x2f9a,0x160f,0x2339,0xa170,0x3020,0x1828,0x2429,0xa298,0x307c,0x19ad,
+    0x24c4,0xa3f0,0x30d5,0x1bad,0x25bf,0xa4cf,0x316a,0x1d35,0x26c9,0xa5c3,0x31ed,0x1ef6,0x27ae,0xa6ca,0x3239,0x208c,
+    0x2884,0xa804,0x32c2,0x21f1,0x294e,0xa8b8,0x3350,0x23aa,0x2a37,0xa984,0x33e7,0x24e5,0x2b71,0xaa63,0x344e,0x262c,
+    0x2c49,0xab5c,0x349d,0x27b5,0x2ce7,0xac36,0x34e6,0x28c3,0x2dba,0xaccb,0x3548,0x29d6,0x2e77,0xad68,0x3589,0x2b13,
+    0x2f50,0xae0c,0x35cd,0x2c3d,0x3035,0xaec4,0x3630,0x2d13,0x30c9,0xaf7e,0x3687,0x2dff,0x315f,0xb023,0x36d1,0x2f10,
+    0x3208,0xb086,0x371d,0x301c,0x32ca,0xb0f1,0x3775,0x30c7,0x339d,0xb158,0x37c6,0x317f,0x343f,0xb1c5,0x380c,0x324e,
+    0x34b8,0xb229,0x382e,0x3329,0x353c,0xb295,0x3852,0x3410,0x35c2,0xb2f5,0x3870,0x3490,0x363b,0xb358,0x387b,0x351f,
+    0x36cb,0xb3b2,0x388d,0x35b7,0x3761,0xb402,0x389c,0x3656,0x3801,0xb423,0x38a6,0x36fa,0x3848,0xb43f,0x38a0,0x37a5,
+    0x3897,0xb458,0x3899,0x382f,0x38e4,0xb463,0x3889,0x3889,0x3929,0xb469,0x386c,0x38e6,0x3974,0xb468,0x384e,0x3948,
+    0x39be,0xb461,0x3828,0x39ad,0x3a12,0xb446,0x3800,0x3a05,0x3a3e,0xb431,0x3781,0x3a73,0x3a73,0xb40d,0x3700,0x3ad8,
+    0x3aa4,0xb3bc,0x366f,0x3b3b,0x3ada,0xb353,0x35e7,0x3ba6,0x3b08,0xb2da,0x354c,0x3c0a,0x3b29,0xb24f,0x34b0,0x3c42,
+    0x3b4d,0xb1b5,0x3410,0x3c7e,0x3b68,0xb106,0x32ee,0x3cb7,0x3b7f,0xb040,0x31cd,0x3ce9,0x3b8c,0xaecf,0x30b2,0x3d19,
+    0x3ba4,0xacfe,0x2f1a,0x3d45,0x3bc2,0xaa20,0x2cad,0x3d70,0x3be2,0xa418,0x282d,0x3d96,0x3c01,0x246f,0xa0c1,0x3dbc,
+    0x1c25,0x8015,0x2c23,0x0001,0x1bff,0x820f,0x2bfc,0x0021,0x1c00,0x881f,0x2bfc,0x0084,0x1c03,0x8ca4,0x2c00,0x012b,
+    0x1c02,0x901d,0x2bff,0x021a,0x1c06,0x926e,0x2c01,0x0361,0x1c0e,0x94a0,0x2c05,0x051a,0x1c1e,0x964d,0x2c0e,0x0776,
+    0x1c43,0x9825,0x2c26,0x0965,0x1c90,0x995a,0x2c5b,0x0bd4,0x1d20,0x9adf,0x2cba,0x0dbf,0x1e0d,0x9c6b,0x2d51,0x1045,
+    0x1f2c,0x9d9d,0x2de9,0x124c,0x203a,0x9f13,0x2e79,0x1499,0x2134,0xa078,0x2f53,0x16b5,0x2233,0xa189,0x2ff7,0x18c5,
+    0x23b8,0xa2e4,0x3080,0x1ac3,0x24a5,0xa438,0x30eb,0x1cae,0x259a,0xa51f,0x3165,0x1e60,0x26bf,0xa62c,0x31ea,0x2046,
+    0x2806,0xa75c,0x326c,0x21a3,0x28c5,0xa85d,0x32f5,0x2358,0x2998,0xa91d,0x3373,0x24b4,0x2a8c,0xa9f1,0x33fe,0x25f1,
+    0x2bb5,0xaae2,0x3451,0x2773,0x2c68,0xabdd,0x348a,0x2898,0x2d3f,0xac81,0x34f6,0x29a8,0x2df2,0xad19,0x3536,0x2ade,
+    0x2edb,0xadbc,0x358a,0x2c22,0x2fbd,0xae65,0x35cc,0x2ceb,0x306b,0xaf1b,0x3620,0x2dd3,0x3105,0xafdc,0x3674,0x2edb,
+    0x31c0,0xb054,0x36dc,0x3004,0x327d,0xb0bd,0x3732,0x30ab,0x3335,0xb126,0x3774,0x3164,0x340a,0xb192,0x37c7,0x3230,
+    0x347f,0xb1fd,0x3807,0x330f,0x34f9,0xb263,0x3827,0x33fc,0x3576,0xb2c4,0x3841,0x347e,0x3600,0xb324,0x385b,0x3508,
+    0x3695,0xb382,0x3874,0x359f,0x3726,0xb3d4,0x3882,0x363c,0x37b7,0xb40d,0x3888,0x36df,0x382a,0xb42d,0x388b,0x378c,
+    0x387e,0xb447,0x388c,0x3820,0x38c7,0xb459,0x387c,0x387c,0x3917,0xb467,0x386c,0x38df,0x3969,0xb466,0x3852,0x393b,
+    0x39a9,0xb465,0x3829,0x39a4,0x39ec,0xb456,0x37f5,0x3a06,0x3a26,0xb440,0x3783,0x3a6c,0x3a69,0xb425,0x3716,0x3ad9,
+    0x3aa0,0xb3fb,0x3690,0x3b42,0x3ad5,0xb3a2,0x3603,0x3bb3,0x3b07,0xb33a,0x3574,0x3c15,0x3b3c,0xb2b5,0x34df,0x3c4b,
+    0x3b53,0xb232,0x343a,0x3c8f,0x3b6f,0xb18f,0x3342,0x3ccc,0x3b8e,0xb0d0,0x3217,0x3d03,0x3b9d,0xaff8,0x30fa,0x3d35,
+    0x3bac,0xae31,0x2fb6,0x3d68,0x3bc6,0xac45,0x2d4b,0x3d97,0x3be4,0xa872,0x2976,0x3dc4,0x3c01,0x942c,0x0bff,0x3def,
+    0x141a,0x800b,0x2811,0x0000,0x1411,0x810a,0x2808,0x0008,0x1410,0x8428,0x2805,0x0022,0x1408,0x88a7,0x27e1,0x004d,
+    0x141a,0x8c29,0x280b,0x0091,0x142f,0x8e80,0x2818,0x00f9,0x1471,0x90be,0x2843,0x01a3,0x1518,0x92c3,0x28b3,0x02cd,
+    0x163c,0x94c6,0x295f,0x04de,0x1800,0x96b2,0x2a42,0x083a,0x1936,0x98a3,0x2b43,0x0b3a,0x1b02,0x9a5d,0x2c49,0x0e0d,
+    0x1c7c,0x9c40,0x2cd7,0x10de,0x1df1,0x9da7,0x2d99,0x13ad,0x1f94,0x9f57,0x2e47,0x15d5,0x20dc,0xa0b5,0x2f17,0x1852,
+    0x221b,0xa1f2,0x2feb,0x1a3b,0x2399,0xa366,0x3063,0x1c61,0x24aa,0xa48b,0x30d6,0x1e04,0x2587,0xa581,0x3129,0x200c,
+    0x26cd,0xa6a0,0x31b6,0x215f,0x2809,0xa7dd,0x3225,0x22fb,0x28ce,0xa8a7,0x32aa,0x2480,0x29c0,0xa978,0x3345,0x25bc,
+    0x2ac0,0xaa57,0x33c6,0x272c,0x2c02,0xab54,0x343a,0x2875,0x2ca4,0xac31,0x3481,0x2977,0x2d67,0xacc4,0x34d2,0x2aa7,
+    0x2e49,0xad65,0x3529,0x2c04,0x2f3d,0xae0e,0x357d,0x2ccc,0x303b,0xaecf,0x35e8,0x2dbd,0x30b7,0xaf79,0x3624,0x2eb1,
+    0x3156,0xb01e,0x3672,0x2fd3,0x320c,0xb082,0x36c9,0x308a,0x32cd,0xb0eb,0x3719,0x313f,0x339b,0xb150,0x3763,0x3200,
+    0x343e,0xb1b9,0x37ab,0x32d9,0x34ba,0xb223,0x37fa,0x33c6,0x3537,0xb287,0x381b,0x3461,0x35b8,0xb2e6,0x3833,0x34e7,
+    0x364d,0xb348,0x384f,0x357d,0x36d3,0xb395,0x3859,0x3611,0x376b,0xb3ed,0x3868,0x36bb,0x3807,0xb416,0x3874,0x3763,
+    0x3850,0xb435,0x386d,0x380d,0x389e,0xb44d,0x3867,0x386a,0x38ec,0xb45d,0x3858,0x38ca,0x393c,0xb468,0x3845,0x392f,
+    0x3982,0xb469,0x3823,0x3994,0x39cb,0xb466,0x37f8,0x3a00,0x3a10,0xb456,0x379f,0x3a68,0x3a50,0xb442,0x3734,0x3ad7,
+    0x3a91,0xb428,0x36be,0x3b4e,0x3ad1,0xb3fa,0x363f,0x3bb7,0x3b06,0xb3ae,0x35ad,0x3c1f,0x3b3b,0xb33c,0x351b,0x3c5b,
+    0x3b66,0xb2c4,0x347c,0x3c9f,0x3b80,0xb238,0x33bd,0x3ce4,0x3b99,0xb191,0x3290,0x3d25,0x3bad,0xb0ce,0x316b,0x3d5d,
+    0x3bc9,0xafe2,0x304c,0x3d8b,0x3bcd,0xae25,0x2e5a,0x3dcd,0x3be6,0xac34,0x2bb1,0x3e03,0x3bff,0xa844,0x24cd,0x3e36,
+    0x0068,0x8002,0x1ff2,0x0000,0x0000,0x8002,0x01c6,0x0000,0x0018,0x8021,0x0dea,0x0000,0x0053,0x8084,0x1027,0x0001,
+    0x00f5,0x8188,0x1377,0x0007,0x0258,0x83c0,0x162f,0x001c,0x0a04,0x8ac4,0x2392,0x0092,0x08e4,0x8b8c,0x1b9d,0x00de,
+    0x126c,0x91d1,0x26c0,0x0381,0x0fcf,0x9191,0x2045,0x0440,0x153e,0x95fe,0x28a7,0x09a4,0x1839,0x9949,0x2ab4,0x0e02,
+    0x1981,0x9a3a,0x2ae8,0x1032,0x1b90,0x9c44,0x2c09,0x12b7,0x1d14,0x9db7,0x2cad,0x152f,0x1ead,0x9f7b,0x2d57,0x17bc,
+    0x2051,0xa0cf,0x2e0f,0x199c,0x2184,0xa216,0x2ed4,0x1bef,0x22f6,0xa398,0x2fa7,0x1d7d,0x245c,0xa4ad,0x3046,0x1f70,
+    0x255b,0xa5ae,0x30b7,0x20f1,0x2688,0xa6d7,0x3130,0x227a,0x27ed,0xa814,0x31b4,0x242f,0x28c7,0xa8cf,0x323d,0x2552,
+    0x29af,0xa99f,0x32c4,0x26af,0x2abc,0xaa84,0x3351,0x2826,0x2bf7,0xab84,0x33ee,0x291c,0x2ca3,0xac4a,0x343d,0x2a37,
+    0x2d6b,0xacde,0x348f,0x2b82,0x2e48,0xad79,0x34dd,0x2c7b,0x2f41,0xae25,0x3533,0x2d56,0x3024,0xaed3,0x357e,0x2e48,
+    0x30bb,0xaf8d,0x35d1,0x2f5a,0x315e,0xb026,0x3620,0x3046,0x3216,0xb08b,0x3676,0x30f3,0x32d7,0xb0f1,0x36c2,0x31b0,
+    0x33b0,0xb159,0x3712,0x3281,0x3444,0xb1bb,0x3750,0x335e,0x34be,0xb222,0x3795,0x342b,0x353c,0xb283,0x37cc,0x34ad,
+    0x35c5,0xb2e6,0x3803,0x353e,0x3658,0xb33d,0x381d,0x35d2,0x36e3,0xb395,0x382c,0x3676,0x378c,0xb3e2,0x383e,0x3720,
+    0x3809,0xb411,0x383d,0x37ce,0x3853,0xb433,0x3839,0x384a,0x38b4,0xb442,0x383f,0x38a1,0x38f0,0xb45e,0x3826,0x3911,
+    0x3942,0xb469,0x3814,0x397b,0x3995,0xb46b,0x37f7,0x39e4,0x39e1,0xb46a,0x37ae,0x3a56,0x3a36,0xb456,0x3760,0x3ab9,
+    0x3a6f,0xb461,0x36f7,0x3b5f,0x3ab9,0xb44d,0x3686,0x3be6,0x3b04,0xb417,0x3608,0x3c1f,0x3b36,0xb40d,0x357b,0x3c84,
+    0x3b66,0xb3c9,0x34e9,0x3cd7,0x3b97,0xb343,0x3452,0x3d18,0x3bae,0xb2ac,0x3370,0x3d5a,0x3bb9,0xb20d,0x324f,0x3da7,
+    0x3bd4,0xb147,0x3135,0x3de2,0x3bdd,0xb076,0x3013,0x3e26,0x3bdf,0xaf1e,0x2dcc,0x3e64,0x3bf8,0xad2c,0x2a4a,0x3ea1,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,
+    0x3c00,0x0008,0x0000,0x0000,0x3c00,0x0017,0x0000,0x0000,0x3bff,0x0038,0x0000,0x0000,0x3bfe,0x007e,0x0000,0x0000,
+    0x3bfc,0x0100,0x0000,0x0000,0x3bf6,0x01bf,0x0000,0x0000,0x3bd9,0x018d,0x0000,0x0000,0x3bbe,0x0023,0x0000,0x0000,
+    0x3bbc,0x0044,0x0000,0x0000,0x3bba,0x007c,0x0000,0x0000,0x3bb6,0x00d6,0x0000,0x0000,0x3baf,0x0154,0x0000,0x0000,
+    0x3ba1,0x01d6,0x0000,0x0000,0x3b87,0x01d4,0x0000,0x0000,0x3b6a,0x010d,0x0000,0x0000,0x3b5e,0x018b,0x0000,0x0000,
+    0x3b4c,0x020b,0x0000,0x0000,0x3b32,0x0248,0x0000,0x0000,0x3b0c,0x01b5,0x0000,0x0000,0x3af7,0x0238,0x0000,0x0000,
+    0x3ad9,0x0293,0x0000,0x0000,0x3ab3,0x0272,0x0000,0x0000,0x3a91,0x0293,0x0000,0x0000,0x3a6e,0x02d9,0x0000,0x0000,
+    0x3a42,0x02a3,0x0000,0x0000,0x3a1d,0x02f0,0x0000,0x0000,0x39f2,0x0300,0x0000,0x0000,0x39c6,0x02fc,0x0000,0x0000,
+    0x399a,0x0321,0x0000,0x0000,0x396b,0x0306,0x0000,0x0000,0x393f,0x032d,0x0000,0x0000,0x390e,0x030b,0x0000,0x0000,
+    0x38e2,0x032c,0x0000,0x0000,0x38b1,0x030b,0x0000,0x0000,0x3884,0x0320,0x0000,0x0000,0x3855,0x0303,0x0000,0x0000,
+    0x3828,0x030b,0x0000,0x0000,0x37f5,0x02f1,0x0000,0x0000,0x379d,0x02ec,0x0000,0x0000,0x3747,0x02d7,0x0000,0x0000,
+    0x36f2,0x02c6,0x0000,0x0000,0x36a0,0x02b6,0x0000,0x0000,0x364f,0x029a,0x0000,0x0000,0x3603,0x0290,0x0000,0x0000,
+    0x35b7,0x026d,0x0000,0x0000,0x3571,0x0265,0x0000,0x0000,0x352a,0x023f,0x0000,0x0000,0x34e9,0x023a,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,
+    0x3c00,0x0009,0x0000,0x0000,0x3c00,0x0018,0x0000,0x0000,0x3bff,0x003a,0x0000,0x0000,0x3bfe,0x0082,0x0000,0x0000,
+    0x3bfc,0x0105,0x0000,0x0000,0x3bf6,0x01c2,0x0000,0x0000,0x3bd8,0x0167,0x0000,0x0000,0x3bbe,0x0024,0x0000,0x0000,
+    0x3bbc,0x0046,0x0000,0x0000,0x3bba,0x0080,0x0000,0x0000,0x3bb6,0x00dc,0x0000,0x0000,0x3baf,0x015a,0x0000,0x0000,
+    0x3ba1,0x01d9,0x0000,0x0000,0x3b87,0x01c8,0x0000,0x0000,0x3b6a,0x0113,0x0000,0x0000,0x3b5e,0x0192,0x0000,0x0000,
+    0x3b4c,0x0211,0x0000,0x0000,0x3b31,0x0246,0x0000,0x0000,0x3b0f,0x01e7,0x0000,0x0000,0x3af6,0x023f,0x0000,0x0000,
+    0x3ad9,0x0295,0x0000,0x0000,0x3ab3,0x0271,0x0000,0x0000,0x3a91,0x029a,0x0000,0x0000,0x3a6d,0x02da,0x0000,0x0000,
+    0x3a43,0x02c0,0x0000,0x0000,0x3a1d,0x02f5,0x0000,0x0000,0x39f1,0x02fd,0x0000,0x0000,0x39c6,0x0302,0x0000,0x0000,
+    0x399a,0x0321,0x0000,0x0000,0x396c,0x0316,0x0000,0x0000,0x393f,0x032d,0x0000,0x0000,0x390f,0x0320,0x0000,0x0000,
+    0x38e1,0x032c,0x0000,0x0000,0x38b2,0x031e,0x0000,0x0000,0x3884,0x0320,0x0000,0x0000,0x3855,0x0311,0x0000,0x0000,
+    0x3828,0x030a,0x0000,0x0000,0x37f5,0x02fa,0x0000,0x0000,0x379d,0x02eb,0x0000,0x0000,0x3746,0x02db,0x0000,0x0000,
+    0x36f2,0x02c9,0x0000,0x0000,0x36a0,0x02b7,0x0000,0x0000,0x3650,0x02a2,0x0000,0x0000,0x3603,0x0290,0x0000,0x0000,
+    0x35b8,0x0279,0x0000,0x0000,0x3571,0x0265,0x0000,0x0000,0x352b,0x024d,0x0000,0x0000,0x34e9,0x0239,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0004,0x0000,0x0000,
+    0x3c00,0x000a,0x0000,0x0000,0x3c00,0x001b,0x0000,0x0000,0x3bff,0x0040,0x0000,0x0000,0x3bfe,0x008c,0x0000,0x0000,
+    0x3bfc,0x0115,0x0000,0x0000,0x3bf5,0x01cc,0x0000,0x0000,0x3bd6,0x0119,0x0000,0x0000,0x3bbd,0x0029,0x0000,0x0000,
+    0x3bbc,0x004d,0x0000,0x0000,0x3bba,0x008b,0x0000,0x0000,0x3bb6,0x00ec,0x0000,0x0000,0x3bae,0x016d,0x0000,0x0000,
+    0x3ba0,0x01e1,0x0000,0x0000,0x3b86,0x01a0,0x0000,0x0000,0x3b6c,0x0149,0x0000,0x0000,0x3b5e,0x01a8,0x0000,0x0000,
+    0x3b4b,0x0220,0x0000,0x0000,0x3b30,0x023c,0x0000,0x0000,0x3b11,0x0218,0x0000,0x0000,0x3af6,0x0254,0x0000,0x0000,
+    0x3ad8,0x029a,0x0000,0x0000,0x3ab4,0x0291,0x0000,0x0000,0x3a90,0x02b2,0x0000,0x0000,0x3a6c,0x02dd,0x0000,0x0000,
+    0x3a44,0x02e9,0x0000,0x0000,0x3a1c,0x0302,0x0000,0x0000,0x39f2,0x0310,0x0000,0x0000,0x39c6,0x0323,0x0000,0x0000,
+    0x3999,0x0327,0x0000,0x0000,0x396c,0x0339,0x0000,0x0000,0x393e,0x0333,0x0000,0x0000,0x3910,0x0340,0x0000,0x0000,
+    0x38e0,0x0333,0x0000,0x0000,0x38b2,0x033b,0x0000,0x0000,0x3883,0x032a,0x0000,0x0000,0x3856,0x032a,0x0000,0x0000,
+    0x3828,0x0317,0x0000,0x0000,0x37f6,0x030f,0x0000,0x0000,0x379d,0x02fc,0x0000,0x0000,0x3747,0x02ec,0x0000,0x0000,
+    0x36f3,0x02da,0x0000,0x0000,0x36a0,0x02c4,0x0000,0x0000,0x3651,0x02b3,0x0000,0x0000,0x3603,0x0299,0x0000,0x0000,
+    0x35b9,0x0288,0x0000,0x0000,0x3571,0x026d,0x0000,0x0000,0x352c,0x025c,0x0000,0x0000,0x34e9,0x0240,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,
+    0x3c00,0x000d,0x0000,0x0000,0x3c00,0x0020,0x0000,0x0000,0x3bff,0x004a,0x0000,0x0000,0x3bfe,0x009e,0x0000,0x0000,
+    0x3bfc,0x0130,0x0000,0x0000,0x3bf4,0x01d7,0x0000,0x0000,0x3bd7,0x00fb,0x0000,0x0000,0x3bbf,0x003f,0x0000,0x0000,
+    0x3bbc,0x005a,0x0000,0x0000,0x3bba,0x009f,0x0000,0x0000,0x3bb5,0x0107,0x0000,0x0000,0x3bae,0x018b,0x0000,0x0000,
+    0x3b9f,0x01e9,0x0000,0x0000,0x3b86,0x0193,0x0000,0x0000,0x3b6f,0x0184,0x0000,0x0000,0x3b5d,0x01cc,0x0000,0x0000,
+    0x3b4a,0x0237,0x0000,0x0000,0x3b2f,0x0230,0x0000,0x0000,0x3b13,0x024e,0x0000,0x0000,0x3af5,0x027a,0x0000,0x0000,
+    0x3ad6,0x029e,0x0000,0x0000,0x3ab5,0x02bf,0x0000,0x0000,0x3a91,0x02e4,0x0000,0x0000,0x3a6b,0x02ec,0x0000,0x0000,
+    0x3a45,0x0319,0x0000,0x0000,0x3a1b,0x0320,0x0000,0x0000,0x39f1,0x0339,0x0000,0x0000,0x39c6,0x034b,0x0000,0x0000,
+    0x3999,0x034c,0x0000,0x0000,0x396c,0x035e,0x0000,0x0000,0x393e,0x0359,0x0000,0x0000,0x3910,0x0362,0x0000,0x0000,
+    0x38e1,0x035b,0x0000,0x0000,0x38b2,0x0358,0x0000,0x0000,0x3884,0x0350,0x0000,0x0000,0x3856,0x0343,0x0000,0x0000,
+    0x3828,0x033b,0x0000,0x0000,0x37f6,0x0329,0x0000,0x0000,0x379e,0x031b,0x0000,0x0000,0x3748,0x0307,0x0000,0x0000,
+    0x36f3,0x02f4,0x0000,0x0000,0x36a1,0x02df,0x0000,0x0000,0x3651,0x02c8,0x0000,0x0000,0x3605,0x02b4,0x0000,0x0000,
+    0x35ba,0x0299,0x0000,0x0000,0x3572,0x0286,0x0000,0x0000,0x352d,0x026a,0x0000,0x0000,0x34eb,0x0256,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0006,0x0000,0x0000,
+    0x3c00,0x0010,0x0000,0x0000,0x3c00,0x0027,0x0000,0x0000,0x3bff,0x0059,0x0000,0x0000,0x3bfe,0x00b7,0x0000,0x0000,
+    0x3bfc,0x0156,0x0000,0x0000,0x3bf2,0x01d5,0x0000,0x0000,0x3bd8,0x00ea,0x0000,0x0000,0x3bc3,0x006c,0x0000,0x0000,
+    0x3bbc,0x006d,0x0000,0x0000,0x3bb9,0x00bc,0x0000,0x0000,0x3bb5,0x012e,0x0000,0x0000,0x3bad,0x01b3,0x0000,0x0000,
+    0x3b9d,0x01ea,0x0000,0x0000,0x3b86,0x01a3,0x0000,0x0000,0x3b71,0x01c2,0x0000,0x0000,0x3b5c,0x01fd,0x0000,0x0000,
+    0x3b48,0x0251,0x0000,0x0000,0x3b2e,0x024d,0x0000,0x0000,0x3b14,0x028b,0x0000,0x0000,0x3af5,0x02b5,0x0000,0x0000,
+    0x3ad5,0x02ba,0x0000,0x0000,0x3ab5,0x02fa,0x0000,0x0000,0x3a91,0x0317,0x0000,0x0000,0x3a6a,0x031d,0x0000,0x0000,
+    0x3a45,0x0350,0x0000,0x0000,0x3a1b,0x0353,0x0000,0x0000,0x39f1,0x036e,0x0000,0x0000,0x39c6,0x0377,0x0000,0x0000,
+    0x3999,0x0388,0x0000,0x0000,0x396c,0x0389,0x0000,0x0000,0x393e,0x0395,0x0000,0x0000,0x390f,0x038c,0x0000,0x0000,
+    0x38e1,0x0392,0x0000,0x0000,0x38b2,0x0384,0x0000,0x0000,0x3884,0x0382,0x0000,0x0000,0x3856,0x0371,0x0000,0x0000,
+    0x3828,0x0365,0x0000,0x0000,0x37f7,0x0354,0x0000,0x0000,0x379f,0x0341,0x0000,0x0000,0x3748,0x032f,0x0000,0x0000,
+    0x36f4,0x0318,0x0000,0x0000,0x36a2,0x0303,0x0000,0x0000,0x3653,0x02ea,0x0000,0x0000,0x3605,0x02d3,0x0000,0x0000,
+    0x35bb,0x02ba,0x0000,0x0000,0x3573,0x02a1,0x0000,0x0000,0x352e,0x0289,0x0000,0x0000,0x34ec,0x026e,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,0x3c00,0x0009,0x0000,0x0000,
+    0x3c00,0x0016,0x0000,0x0000,0x3bff,0x0032,0x0000,0x0000,0x3bff,0x006d,0x0000,0x0000,0x3bfe,0x00da,0x0000,0x0000,
+    0x3bfb,0x0186,0x0000,0x0000,0x3bef,0x01af,0x0000,0x0000,0x3bd9,0x00dc,0x0000,0x0000,0x3bc7,0x0092,0x0000,0x0000,
+    0x3bbc,0x0088,0x0000,0x0000,0x3bb9,0x00e3,0x0000,0x0000,0x3bb4,0x0161,0x0000,0x0000,0x3bab,0x01e2,0x0000,0x0000,
+    0x3b9a,0x01d8,0x0000,0x0000,0x3b87,0x01c7,0x0000,0x0000,0x3b73,0x0207,0x0000,0x0000,0x3b5c,0x0248,0x0000,0x0000,
+    0x3b46,0x0266,0x0000,0x0000,0x3b2e,0x0285,0x0000,0x0000,0x3b14,0x02d3,0x0000,0x0000,0x3af5,0x02ef,0x0000,0x0000,
+    0x3ad4,0x02f8,0x0000,0x0000,0x3ab5,0x0340,0x0000,0x0000,0x3a90,0x034b,0x0000,0x0000,0x3a6a,0x036d,0x0000,0x0000,
+    0x3a44,0x038c,0x0000,0x0000,0x3a1b,0x03a1,0x0000,0x0000,0x39f0,0x03b4,0x0000,0x0000,0x39c5,0x03c1,0x0000,0x0000,
+    0x3999,0x03cf,0x0000,0x0000,0x396b,0x03cf,0x0000,0x0000,0x393e,0x03d7,0x0000,0x0000,0x390f,0x03d3,0x0000,0x0000,
+    0x38e1,0x03cd,0x0000,0x0000,0x38b2,0x03c8,0x0000,0x0000,0x3884,0x03ba,0x0000,0x0000,0x3856,0x03b1,0x0000,0x0000,
+    0x3829,0x039d,0x0000,0x0000,0x37f8,0x038d,0x0000,0x0000,0x37a0,0x0377,0x0000,0x0000,0x3749,0x0360,0x0000,0x0000,
+    0x36f5,0x034b,0x0000,0x0000,0x36a3,0x032f,0x0000,0x0000,0x3654,0x0318,0x0000,0x0000,0x3607,0x02fb,0x0000,0x0000,
+    0x35bd,0x02e4,0x0000,0x0000,0x3575,0x02c6,0x0000,0x0000,0x3530,0x02ad,0x0000,0x0000,0x34ee,0x0290,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,0x3c00,0x000c,0x0000,0x0000,
+    0x3c00,0x001d,0x0000,0x0000,0x3bff,0x0041,0x0000,0x0000,0x3bff,0x0088,0x0000,0x0000,0x3bfe,0x0107,0x0000,0x0000,
+    0x3bfb,0x01bd,0x0000,0x0000,0x3beb,0x015a,0x0000,0x0000,0x3bdb,0x00db,0x0000,0x0000,0x3bca,0x00b3,0x0000,0x0000,
+    0x3bbb,0x00ab,0x0000,0x0000,0x3bb9,0x0116,0x0000,0x0000,0x3bb4,0x01a2,0x0000,0x0000,0x3baa,0x0215,0x0000,0x0000,
+    0x3b98,0x01d8,0x0000,0x0000,0x3b87,0x01fd,0x0000,0x0000,0x3b74,0x0257,0x0000,0x0000,0x3b5c,0x029a,0x0000,0x0000,
+    0x3b44,0x0286,0x0000,0x0000,0x3b2e,0x02d2,0x0000,0x0000,0x3b14,0x0325,0x0000,0x0000,0x3af4,0x0329,0x0000,0x0000,
+    0x3ad4,0x0357,0x0000,0x0000,0x3ab3,0x038f,0x0000,0x0000,0x3a90,0x03a2,0x0000,0x0000,0x3a6a,0x03cf,0x0000,0x0000,
+    0x3a42,0x03d6,0x0000,0x0000,0x3a1b,0x0401,0x0000,0x0000,0x39f0,0x0406,0x0000,0x0000,0x39c5,0x041c,0x0000,0x0000,
+    0x3999,0x0420,0x0000,0x0000,0x396b,0x042c,0x0000,0x0000,0x393e,0x0427,0x0000,0x0000,0x390f,0x042c,0x0000,0x0000,
+    0x38e1,0x041f,0x0000,0x0000,0x38b3,0x0419,0x0000,0x0000,0x3884,0x0409,0x0000,0x0000,0x3856,0x03f7,0x0000,0x0000,
+    0x3829,0x03e8,0x0000,0x0000,0x37f9,0x03d0,0x0000,0x0000,0x37a1,0x03bb,0x0000,0x0000,0x374b,0x03a1,0x0000,0x0000,
+    0x36f7,0x0386,0x0000,0x0000,0x36a5,0x036c,0x0000,0x0000,0x3656,0x034d,0x0000,0x0000,0x3609,0x0333,0x0000,0x0000,
+    0x35bf,0x0312,0x0000,0x0000,0x3577,0x02f8,0x0000,0x0000,0x3532,0x02d6,0x0000,0x0000,0x34f0,0x02bd,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,0x3c00,0x0007,0x0000,0x0000,0x3c00,0x0011,0x0000,0x0000,
+    0x3c00,0x0027,0x0000,0x0000,0x3bff,0x0054,0x0000,0x0000,0x3bff,0x00ab,0x0000,0x0000,0x3bfe,0x0140,0x0000,0x0000,
+    0x3bf9,0x01f8,0x0000,0x0000,0x3be9,0x0137,0x0000,0x0000,0x3bdc,0x00e2,0x0000,0x0000,0x3bcd,0x00d3,0x0000,0x0000,
+    0x3bbd,0x00e3,0x0000,0x0000,0x3bb8,0x0158,0x0000,0x0000,0x3bb3,0x01f0,0x0000,0x0000,0x3ba8,0x0241,0x0000,0x0000,
+    0x3b97,0x0200,0x0000,0x0000,0x3b87,0x0245,0x0000,0x0000,0x3b74,0x02b3,0x0000,0x0000,0x3b5d,0x02ea,0x0000,0x0000,
+    0x3b42,0x02d4,0x0000,0x0000,0x3b2d,0x0337,0x0000,0x0000,0x3b13,0x037f,0x0000,0x0000,0x3af4,0x038c,0x0000,0x0000,
+    0x3ad4,0x03cb,0x0000,0x0000,0x3ab2,0x03e2,0x0000,0x0000,0x3a8f,0x0415,0x0000,0x0000,0x3a6a,0x043b,0x0000,0x0000,
+    0x3a42,0x0448,0x0000,0x0000,0x3a1a,0x046b,0x0000,0x0000,0x39f0,0x047a,0x0000,0x0000,0x39c4,0x0489,0x0000,0x0000,
+    0x3998,0x0491,0x0000,0x0000,0x396b,0x0496,0x0000,0x0000,0x393d,0x0494,0x0000,0x0000,0x390f,0x048c,0x0000,0x0000,
+    0x38e1,0x0488,0x0000,0x0000,0x38b3,0x0477,0x0000,0x0000,0x3885,0x046b,0x0000,0x0000,0x3857,0x0456,0x0000,0x0000,
+    0x382a,0x043f,0x0000,0x0000,0x37fa,0x0427,0x0000,0x0000,0x37a2,0x0409,0x0000,0x0000,0x374c,0x03f0,0x0000,0x0000,
+    0x36f9,0x03d0,0x0000,0x0000,0x36a7,0x03b3,0x0000,0x0000,0x3658,0x0392,0x0000,0x0000,0x360b,0x0371,0x0000,0x0000,
+    0x35c1,0x0352,0x0000,0x0000,0x357a,0x032f,0x0000,0x0000,0x3535,0x0311,0x0000,0x0000,0x34f2,0x02ed,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,
+    0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0004,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,0x3c00,0x0018,0x0000,0x0000,
+    0x3c00,0x0035,0x0000,0x0000,0x3bff,0x006e,0x0000,0x0000,0x3bff,0x00d7,0x0000,0x0000,0x3bfd,0x0186,0x0000,0x0000,
+    0x3bf8,0x0229,0x0000,0x0000,0x3be8,0x012d,0x0000,0x0000,0x3bdc,0x00f1,0x0000,0x0000,0x3bcf,0x00f8,0x0000,0x0000,
+    0x3bbf,0x012c,0x0000,0x0000,0x3bb8,0x01aa,0x0000,0x0000,0x3bb1,0x0249,0x0000,0x0000,0x3ba5,0x0258,0x0000,0x0000,
+    0x3b96,0x0240,0x0000,0x0000,0x3b87,0x02a9,0x0000,0x0000,0x3b75,0x031e,0x0000,0x0000,0x3b5c,0x032d,0x0000,0x0000,
+    0x3b42,0x034a,0x0000,0x0000,0x3b2b,0x03ae,0x0000,0x0000,0x3b11,0x03da,0x0000,0x0000,0x3af4,0x040d,0x0000,0x0000,
+    0x3ad4,0x044f,0x0000,0x0000,0x3ab0,0x0458,0x0000,0x0000,0x3a8f,0x049e,0x0000,0x0000,0x3a69,0x04ae,0x0000,0x0000,
+    0x3a42,0x04da,0x0000,0x0000,0x3a19,0x04e5,0x0000,0x0000,0x39f0,0x0506,0x0000,0x0000,0x39c4,0x0506,0x0000,0x0000,
+    0x3998,0x0519,0x0000,0x0000,0x396b,0x0514,0x0000,0x0000,0x393d,0x0516,0x0000,0x0000,0x390f,0x050c,0x0000,0x0000,
+    0x38e1,0x0500,0x0000,0x0000,0x38b3,0x04f1,0x0000,0x0000,0x3885,0x04da,0x0000,0x0000,0x3857,0x04c6,0x0000,0x0000,
+    0x382a,0x04a9,0x0000,0x0000,0x37fb,0x048c,0x0000,0x0000,0x37a4,0x046d,0x0000,0x0000,0x374e,0x0448,0x0000,0x0000,
+    0x36fb,0x042b,0x0000,0x0000,0x36a9,0x0405,0x0000,0x0000,0x365b,0x03e5,0x0000,0x0000,0x360e,0x03be,0x0000,0x0000,
+    0x35c4,0x039b,0x0000,0x0000,0x357d,0x0375,0x0000,0x0000,0x3538,0x0352,0x0000,0x0000,0x34f6,0x032d,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,
+    0x3c00,0x0003,0x0000,0x0000,0x3c00,0x0007,0x0000,0x0000,0x3c00,0x000f,0x0000,0x0000,0x3c00,0x0021,0x0000,0x0000,
+    0x3c00,0x0047,0x0000,0x0000,0x3bff,0x008f,0x0000,0x0000,0x3bff,0x0110,0x0000,0x0000,0x3bfd,0x01da,0x0000,0x0000,
+    0x3bf6,0x0234,0x0000,0x0000,0x3be7,0x012b,0x0000,0x0000,0x3bdd,0x010b,0x0000,0x0000,0x3bd1,0x012b,0x0000,0x0000,
+    0x3bc3,0x0183,0x0000,0x0000,0x3bb7,0x020f,0x0000,0x0000,0x3bb0,0x02a9,0x0000,0x0000,0x3ba2,0x0271,0x0000,0x0000,
+    0x3b96,0x02a4,0x0000,0x0000,0x3b87,0x0325,0x0000,0x0000,0x3b74,0x0393,0x0000,0x0000,0x3b5c,0x038b,0x0000,0x0000,
+    0x3b43,0x03de,0x0000,0x0000,0x3b2a,0x0436,0x0000,0x0000,0x3b10,0x0453,0x0000,0x0000,0x3af3,0x04a7,0x0000,0x0000,
+    0x3ad3,0x04dd,0x0000,0x0000,0x3ab0,0x04fe,0x0000,0x0000,0x3a8d,0x0539,0x0000,0x0000,0x3a68,0x0553,0x0000,0x0000,
+    0x3a41,0x057e,0x0000,0x0000,0x3a18,0x058a,0x0000,0x0000,0x39ef,0x05a3,0x0000,0x0000,0x39c4,0x05ad,0x0000,0x0000,
+    0x3997,0x05b1,0x0000,0x0000,0x396b,0x05b6,0x0000,0x0000,0x393d,0x05a9,0x0000,0x0000,0x390f,0x05a3,0x0000,0x0000,
+    0x38e1,0x0591,0x0000,0x0000,0x38b3,0x057e,0x0000,0x0000,0x3885,0x0565,0x0000,0x0000,0x3858,0x0544,0x0000,0x0000,
+    0x382b,0x0528,0x0000,0x0000,0x37fd,0x0504,0x0000,0x0000,0x37a6,0x04e1,0x0000,0x0000,0x3751,0x04bb,0x0000,0x0000,
+    0x36fd,0x0492,0x0000,0x0000,0x36ac,0x046d,0x0000,0x0000,0x365d,0x043f,0x0000,0x0000,0x3611,0x041a,0x0000,0x0000,
+    0x35c7,0x03ec,0x0000,0x0000,0x3580,0x03c6,0x0000,0x0000,0x353b,0x039b,0x0000,0x0000,0x34f9,0x0375,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,
+    0x3c00,0x0005,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,0x3c00,0x0016,0x0000,0x0000,0x3c00,0x002e,0x0000,0x0000,
+    0x3c00,0x005f,0x0000,0x0000,0x3bff,0x00b9,0x0000,0x0000,0x3bff,0x0157,0x0000,0x0000,0x3bfd,0x023c,0x0000,0x0000,
+    0x3bf2,0x01ef,0x0000,0x0000,0x3be7,0x0143,0x0000,0x0000,0x3bde,0x0132,0x0000,0x0000,0x3bd3,0x016f,0x0000,0x0000,
+    0x3bc5,0x01e8,0x0000,0x0000,0x3bb6,0x0288,0x0000,0x0000,0x3bae,0x0308,0x0000,0x0000,0x3ba1,0x02c2,0x0000,0x0000,
+    0x3b95,0x0322,0x0000,0x0000,0x3b86,0x03b9,0x0000,0x0000,0x3b73,0x040d,0x0000,0x0000,0x3b5c,0x041c,0x0000,0x0000,
+    0x3b43,0x048e,0x0000,0x0000,0x3b28,0x04d1,0x0000,0x0000,0x3b0e,0x0501,0x0000,0x0000,0x3af2,0x0563,0x0000,0x0000,
+    0x3ad2,0x057d,0x0000,0x0000,0x3ab0,0x05c7,0x0000,0x0000,0x3a8b,0x05e0,0x0000,0x0000,0x3a67,0x061a,0x0000,0x0000,
+    0x3a40,0x0632,0x0000,0x0000,0x3a17,0x0651,0x0000,0x0000,0x39ed,0x0658,0x0000,0x0000,0x39c3,0x066f,0x0000,0x0000,
+    0x3997,0x066b,0x0000,0x0000,0x396a,0x066e,0x0000,0x0000,0x393d,0x0662,0x0000,0x0000,0x390f,0x064f,0x0000,0x0000,
+    0x38e1,0x063f,0x0000,0x0000,0x38b3,0x061e,0x0000,0x0000,0x3886,0x0603,0x0000,0x0000,0x3859,0x05e0,0x0000,0x0000,
+    0x382c,0x05b9,0x0000,0x0000,0x37ff,0x0597,0x0000,0x0000,0x37a8,0x0566,0x0000,0x0000,0x3753,0x053d,0x0000,0x0000,
+    0x3700,0x050e,0x0000,0x0000,0x36af,0x04df,0x0000,0x0000,0x3661,0x04b2,0x0000,0x0000,0x3614,0x0480,0x0000,0x0000,
+    0x35cb,0x0454,0x0000,0x0000,0x3583,0x0422,0x0000,0x0000,0x353f,0x03f8,0x0000,0x0000,0x34fd,0x03c7,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,
+    0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0000,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,
+    0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0004,0x0000,0x0000,
+    0x3c00,0x0007,0x0000,0x0000,0x3c00,0x000f,0x0000,0x0000,0x3c00,0x001f,0x0000,0x0000,0x3c00,0x0040,0x0000,0x0000,
+    0x3bff,0x007f,0x0000,0x0000,0x3bff,0x00f0,0x0000,0x0000,0x3bfe,0x01af,0x0000,0x0000,0x3bfc,0x02a9,0x0000,0x0000,
+    0x3bf0,0x01d0,0x0000,0x0000,0x3be7,0x015e,0x0000,0x0000,0x3bde,0x0169,0x0000,0x0000,0x3bd4,0x01c6,0x0000,0x0000,
+    0x3bc7,0x0265,0x0000,0x0000,0x3bb7,0x031c,0x0000,0x0000,0x3bab,0x0356,0x0000,0x0000,0x3b9f,0x0335,0x0000,0x0000,
+    0x3b94,0x03be,0x0000,0x0000,0x3b85,0x0467,0x0000,0x0000,0x3b71,0x0482,0x0000,0x0000,0x3b5c,0x04d6,0x0000,0x0000,
+    0x3b43,0x0554,0x0000,0x0000,0x3b27,0x0578,0x0000,0x0000,0x3b0d,0x05d9,0x0000,0x0000,0x3af1,0x0631,0x0000,0x0000,
+    0x3ad1,0x065b,0x0000,0x0000,0x3aaf,0x06a6,0x0000,0x0000,0x3a8a,0x06c4,0x0000,0x0000,0x3a66,0x0702,0x0000,0x0000,
+    0x3a3f,0x0715,0x0000,0x0000,0x3a17,0x0737,0x0000,0x0000,0x39ec,0x073d,0x0000,0x0000,0x39c2,0x074a,0x0000,0x0000,
+    0x3996,0x074e,0x0000,0x0000,0x3969,0x073c,0x0000,0x0000,0x393d,0x0736,0x0000,0x0000,0x390f,0x071d,0x0000,0x0000,
+    0x38e1,0x0703,0x0000,0x0000,0x38b4,0x06e6,0x0000,0x0000,0x3886,0x06ba,0x0000,0x0000,0x3859,0x0697,0x0000,0x0000,
+    0x382d,0x0666,0x0000,0x0000,0x3800,0x0635,0x0000,0x0000,0x37ab,0x0607,0x0000,0x0000,0x3756,0x05cf,0x0000,0x0000,
+    0x3703,0x059f,0x0000,0x0000,0x36b2,0x0567,0x0000,0x0000,0x3664,0x0531,0x0000,0x0000,0x3618,0x04fa,0x0000,0x0000,
+    0x35cf,0x04c5,0x0000,0x0000,0x3588,0x048f,0x0000,0x0000,0x3543,0x045c,0x0000,0x0000,0x3501,0x0428,0x0000,0x0000,
+    0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,
+    0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,0x3c00,0x0001,0x0000,0x0000,
+    0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0004,0x0000,0x0000,0x3c00,0x0006,0x0000,0x0000,
+    0x3c00,0x000c,0x0000,0x0000,0x3c00,0x0017,0x0000,0x0000,0x3c00,0x002d,0x0000,0x0000,0x3c00,0x0058,0x0000,0x0000,
+    0x3bff,0x00a8,0x0000,0x0000,0x3bff,0x0136,0x0000,0x0000,0x3bfe,0x021c,0x0000,0x0000,0x3bfb,0x0315,0x0000,0x0000,
+    0x3bef,0x01e2,0x0000,0x0000,0x3be6,0x018a,0x0000,0x0000,0x3bde,0x01b4,0x0000,0x0000,0x3bd5,0x0237,0x0000,0x0000,
+    0x3bc9,0x02fb,0x0000,0x0000,0x3bb9,0x03c3,0x0000,0x0000,0x3ba8,0x0391,0x0000,0x0000,0x3b9e,0x03d9,0x0000,0x0000,
+    0x3b93,0x0489,0x0000,0x0000,0x3b84,0x052a,0x0000,0x0000,0x3b70,0x0531,0x0000,0x0000,0x3b5b,0x05bc,0x0000,0x0000,
+    0x3b43,0x063b,0x0000,0x0000,0x3b27,0x0660,0x0000,0x0000,0x3b0b,0x06db,0x0000,0x0000,0x3aef,0x070f,0x0000,0x0000,
+    0x3ad0,0x0769,0x0000,0x0000,0x3aae,0x07a5,0x0000,0x0000,0x3a8a,0x07de,0x0000,0x0000,0x3a64,0x07fd,0x0000,0x0000,
+    0x3a3e,0x0816,0x0000,0x0000,0x3a16,0x081b,0x0000,0x0000,0x39ec,0x0827,0x0000,0x0000,0x39c1,0x0824,0x0000,0x0000,
+    0x3996,0x0827,0x0000,0x0000,0x3969,0x081f,0x0000,0x0000,0x393c,0x0814,0x0000,0x0000,0x390f,0x080a,0x0000,0x0000,
+    0x38e2,0x07ec,0x0000,0x0000,0x38b4,0x07c3,0x0000,0x0000,0x3887,0x0795,0x0000,0x0000,0x385a,0x0760,0x0000,0x0000,
+    0x382e,0x0731,0x0000,0x0000,0x3802,0x06f6,0x0000,0x0000,0x37ad,0x06b9,0x0000,0x0000,0x3759,0x067f,0x0000,0x0000,
+    0x3706,0x063e,0x0000,0x0000,0x36b6,0x0606,0x0000,0x0000,0x3668,0x05c3,0x0000,0x0000,0x361d,0x0589,0x0000,0x0000,
+    0x35d3,0x0549,0x0000,0x0000,0x358c,0x050f,0x0000,0x0000,0x3548,0x04d2,0x0000,0x0000,0x3506,0x049a,0x0000,0x0000,
+    0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,
+    0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0002,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,0x3c00,0x0003,0x0000,0x0000,
+    0x3c00,0x0003,0x0000,0x0000,0x3c00,0x0004,0x0000,0x0000,0x3c00,0x0006,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,
+    0x3c00,0x0012,0x0000,0x0000,0x3c00,0x0022,0x0000,0x0000,0x3c00,0x0040,0x0000,0x0000,0x3c00,0x0079,0x0000,0x0000,
+    0x3bff,0x00df,0x0000,0x0000,0x3bff,0x0190,0x0000,0x0000,0x3bfe,0x02a1,0x0000,0x0000,0x3bf9,0x0364,0x0000,0x0000,
+    0x3bee,0x01ff,0x0000,0x0000,0x3be6,0x01d9,0x0000,0x0000,0x3bdf,0x0219,0x0000,0x0000,0x3bd6,0x02c7,0x0000,0x0000,
+    0x3bca,0x03b0,0x0000,0x0000,0x3bba,0x0471,0x0000,0x0000,0x3ba7,0x0415,0x0000,0x0000,0x3b9d,0x049d,0x0000,0x0000,
+    0x3b91,0x057c,0x0000,0x0000,0x3b82,0x05fa,0x0000,0x0000,0x3b6f,0x0626,0x0000,0x0000,0x3b5b,0x06cd,0x0000,0x0000,
+    0x3b42,0x0734,0x0000,0x0000,0x3b27,0x078e,0x0000,0x0000,0x3b0a,0x0802,0x0000,0x0000,0x3aed,0x081f,0x0000,0x0000,
+    0x3acf,0x0856,0x0000,0x0000,0x3aad,0x086b,0x0000,0x0000,0x3a89,0x0890,0x0000,0x0000,0x3a63,0x089f,0x0000,0x0000,
+    0x3a3d,0x08b6,0x0000,0x0000,0x3a15,0x08bd,0x0000,0x0000,0x39eb,0x08c2,0x0000,0x0000,0x39c0,0x08c4,0x0000,0x0000,
+    0x3995,0x08bc,0x0000,0x0000,0x3969,0x08b7,0x0000,0x0000,0x393c,0x08a6,0x0000,0x0000,0x390f,0x0891,0x0000,0x0000,
+    0x38e2,0x087e,0x0000,0x0000,0x38b4,0x0862,0x0000,0x0000,0x3888,0x0849,0x0000,0x0000,0x385b,0x082a,0x0000,0x0000,
+    0x382e,0x0808,0x0000,0x0000,0x3803,0x07d4,0x0000,0x0000,0x37b0,0x078a,0x0000,0x0000,0x375d,0x0747,0x0000,0x0000,
+    0x370a,0x06fd,0x0000,0x0000,0x36ba,0x06b2,0x0000,0x0000,0x366d,0x066f,0x0000,0x0000,0x3621,0x0623,0x0000,0x0000,
+    0x35d8,0x05e3,0x0000,0x0000,0x3591,0x0597,0x0000,0x0000,0x354d,0x055b,0x0000,0x0000,0x350b,0x0512,0x0000,0x0000,
+    0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,
+    0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0005,0x0000,0x0000,0x3c00,0x0006,0x0000,0x0000,
+    0x3c00,0x0007,0x0000,0x0000,0x3c00,0x0008,0x0000,0x0000,0x3c00,0x000c,0x0000,0x0000,0x3c00,0x0011,0x0000,0x0000,
+    0x3c00,0x001d,0x0000,0x0000,0x3c00,0x0032,0x0000,0x0000,0x3c00,0x005b,0x0000,0x0000,0x3bff,0x00a5,0x0000,0x0000,
+    0x3bff,0x0128,0x0000,0x0000,0x3bff,0x0201,0x0000,0x0000,0x3bfd,0x0341,0x0000,0x0000,0x3bf6,0x0359,0x0000,0x0000,
+    0x3bed,0x0244,0x0000,0x0000,0x3be6,0x023f,0x0000,0x0000,0x3bdf,0x029e,0x0000,0x0000,0x3bd7,0x037f,0x0000,0x0000,
+    0x3bcc,0x0491,0x0000,0x0000,0x3bbb,0x0517,0x0000,0x0000,0x3ba6,0x04e6,0x0000,0x0000,0x3b9c,0x05ab,0x0000,0x0000,
+    0x3b90,0x0695,0x0000,0x0000,0x3b80,0x06cc,0x0000,0x0000,0x3b6e,0x0751,0x0000,0x0000,0x3b5a,0x080c,0x0000,0x0000,
+    0x3b41,0x082a,0x0000,0x0000,0x3b26,0x0877,0x0000,0x0000,0x3b09,0x08ab,0x0000,0x0000,0x3aeb,0x08da,0x0000,0x0000,
+    0x3acd,0x0908,0x0000,0x0000,0x3aac,0x0928,0x0000,0x0000,0x3a88,0x0947,0x0000,0x0000,0x3a62,0x0961,0x0000,0x0000,
+    0x3a3b,0x096c,0x0000,0x0000,0x3a14,0x097d,0x0000,0x0000,0x39ea,0x0978,0x0000,0x0000,0x39bf,0x0979,0x0000,0x0000,
+    0x3994,0x096e,0x0000,0x0000,0x3969,0x095e,0x0000,0x0000,0x393c,0x094f,0x0000,0x0000,0x390f,0x0934,0x0000,0x0000,
+    0x38e2,0x0918,0x0000,0x0000,0x38b5,0x08fc,0x0000,0x0000,0x3888,0x08d7,0x0000,0x0000,0x385c,0x08b6,0x0000,0x0000,
+    0x3830,0x088d,0x0000,0x0000,0x3804,0x0866,0x0000,0x0000,0x37b4,0x083d,0x0000,0x0000,0x3760,0x0815,0x0000,0x0000,
+    0x370f,0x07d6,0x0000,0x0000,0x36bf,0x0784,0x0000,0x0000,0x3672,0x0730,0x0000,0x0000,0x3626,0x06dc,0x0000,0x0000,
+    0x35dd,0x068d,0x0000,0x0000,0x3596,0x063a,0x0000,0x0000,0x3553,0x05f2,0x0000,0x0000,0x3511,0x05a2,0x0000,0x0000,
+    0x3c00,0x000a,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,
+    0x3c00,0x000a,0x0000,0x0000,0x3c00,0x000a,0x0000,0x0000,0x3c00,0x000b,0x0000,0x0000,0x3c00,0x000b,0x0000,0x0000,
+    0x3c00,0x000d,0x0000,0x0000,0x3c00,0x000f,0x0000,0x0000,0x3c00,0x0014,0x0000,0x0000,0x3c00,0x001d,0x0000,0x0000,
+    0x3c00,0x002d,0x0000,0x0000,0x3c00,0x004b,0x0000,0x0000,0x3c00,0x0081,0x0000,0x0000,0x3bff,0x00e1,0x0000,0x0000,
+    0x3bff,0x0186,0x0000,0x0000,0x3bff,0x0291,0x0000,0x0000,0x3bfd,0x03fd,0x0000,0x0000,0x3bf4,0x0336,0x0000,0x0000,
+    0x3bec,0x0285,0x0000,0x0000,0x3be6,0x02c4,0x0000,0x0000,0x3bdf,0x034f,0x0000,0x0000,0x3bd8,0x0466,0x0000,0x0000,
+    0x3bcd,0x0597,0x0000,0x0000,0x3bba,0x059b,0x0000,0x0000,0x3ba7,0x05e7,0x0000,0x0000,0x3b9a,0x06ef,0x0000,0x0000,
+    0x3b8e,0x07d4,0x0000,0x0000,0x3b7e,0x0801,0x0000,0x0000,0x3b6d,0x086c,0x0000,0x0000,0x3b58,0x08c5,0x0000,0x0000,
+    0x3b40,0x08ef,0x0000,0x0000,0x3b26,0x094c,0x0000,0x0000,0x3b08,0x0970,0x0000,0x0000,0x3ae9,0x09b4,0x0000,0x0000,
+    0x3aca,0x09d4,0x0000,0x0000,0x3aaa,0x0a08,0x0000,0x0000,0x3a86,0x0a19,0x0000,0x0000,0x3a61,0x0a3e,0x0000,0x0000,
+    0x3a3a,0x0a49,0x0000,0x0000,0x3a12,0x0a4f,0x0000,0x0000,0x39e9,0x0a50,0x0000,0x0000,0x39bf,0x0a47,0x0000,0x0000,
+    0x3993,0x0a3e,0x0000,0x0000,0x3968,0x0a28,0x0000,0x0000,0x393c,0x0a0b,0x0000,0x0000,0x390f,0x09f2,0x0000,0x0000,
+    0x38e2,0x09ce,0x0000,0x0000,0x38b6,0x09a8,0x0000,0x0000,0x3889,0x097d,0x0000,0x0000,0x385d,0x0953,0x0000,0x0000,
+    0x3831,0x0923,0x0000,0x0000,0x3806,0x08fa,0x0000,0x0000,0x37b7,0x08c5,0x0000,0x0000,0x3764,0x0898,0x0000,0x0000,
+    0x3713,0x0865,0x0000,0x0000,0x36c3,0x0835,0x0000,0x0000,0x3676,0x0808,0x0000,0x0000,0x362b,0x07a8,0x0000,0x0000,
+    0x35e3,0x0757,0x0000,0x0000,0x359c,0x06f1,0x0000,0x0000,0x3559,0x06a4,0x0000,0x0000,0x3517,0x0647,0x0000,0x0000,
+    0x3c00,0x0013,0x0000,0x0000,0x3c00,0x0013,0x0000,0x0000,0x3c00,0x0013,0x0000,0x0000,0x3c00,0x0013,0x0000,0x0000,
+    0x3c00,0x0013,0x0000,0x0000,0x3c00,0x0013,0x0000,0x0000,0x3c00,0x0014,0x0000,0x0000,0x3c00,0x0015,0x0000,0x0000,
+    0x3c00,0x0018,0x0000,0x0000,0x3c00,0x001c,0x0000,0x0000,0x3c00,0x0023,0x0000,0x0000,0x3c00,0x002f,0x0000,0x0000,
+    0x3c00,0x0046,0x0000,0x0000,0x3c00,0x006f,0x0000,0x0000,0x3c00,0x00b6,0x0000,0x0000,0x3bff,0x0132,0x0000,0x0000,
+    0x3bff,0x0201,0x0000,0x0000,0x3bfe,0x0347,0x0000,0x0000,0x3bfc,0x04ce,0x0000,0x0000,0x3bf2,0x035d,0x0000,0x0000,
+    0x3bec,0x0311,0x0000,0x0000,0x3be6,0x036e,0x0000,0x0000,0x3bdf,0x0436,0x0000,0x0000,0x3bd8,0x0586,0x0000,0x0000,
+    0x3bcd,0x06bd,0x0000,0x0000,0x3bbb,0x0687,0x0000,0x0000,0x3ba9,0x0748,0x0000,0x0000,0x3b98,0x0837,0x0000,0x0000,
+    0x3b8b,0x0897,0x0000,0x0000,0x3b7c,0x08cc,0x0000,0x0000,0x3b6b,0x094e,0x0000,0x0000,0x3b56,0x098b,0x0000,0x0000,
+    0x3b3f,0x09e6,0x0000,0x0000,0x3b25,0x0a38,0x0000,0x0000,0x3b07,0x0a6b,0x0000,0x0000,0x3ae8,0x0ab5,0x0000,0x0000,
+    0x3ac8,0x0add,0x0000,0x0000,0x3aa8,0x0b0a,0x0000,0x0000,0x3a85,0x0b22,0x0000,0x0000,0x3a60,0x0b38,0x0000,0x0000,
+    0x3a39,0x0b50,0x0000,0x0000,0x3a10,0x0b4a,0x0000,0x0000,0x39e8,0x0b4e,0x0000,0x0000,0x39be,0x0b40,0x0000,0x0000,
+    0x3993,0x0b25,0x0000,0x0000,0x3967,0x0b11,0x0000,0x0000,0x393c,0x0af0,0x0000,0x0000,0x390f,0x0ac8,0x0000,0x0000,
+    0x38e2,0x0a9c,0x0000,0x0000,0x38b6,0x0a72,0x0000,0x0000,0x388a,0x0a37,0x0000,0x0000,0x385e,0x0a0e,0x0000,0x0000,
+    0x3833,0x09cf,0x0000,0x0000,0x3808,0x099e,0x0000,0x0000,0x37bb,0x0966,0x0000,0x0000,0x3768,0x0926,0x0000,0x0000,
+    0x3718,0x08f6,0x0000,0x0000,0x36c9,0x08b6,0x0000,0x0000,0x367c,0x0886,0x0000,0x0000,0x3631,0x0848,0x0000,0x0000,
+    0x35e9,0x081b,0x0000,0x0000,0x35a3,0x07c2,0x0000,0x0000,0x355f,0x076a,0x0000,0x0000,0x351e,0x06fe,0x0000,0x0000,
+    0x3c00,0x0022,0x0000,0x0000,0x3c00,0x0022,0x0000,0x0000,0x3c00,0x0022,0x0000,0x0000,0x3c00,0x0022,0x0000,0x0000,
+    0x3c00,0x0023,0x0000,0x0000,0x3c00,0x0023,0x0000,0x0000,0x3c00,0x0024,0x0000,0x0000,0x3c00,0x0026,0x0000,0x0000,
+    0x3c00,0x002a,0x0000,0x0000,0x3c00,0x0030,0x0000,0x0000,0x3c00,0x003a,0x0000,0x0000,0x3c00,0x004c,0x0000,0x0000,
+    0x3c00,0x006c,0x0000,0x0000,0x3c00,0x00a3,0x0000,0x0000,0x3bff,0x0101,0x0000,0x0000,0x3bff,0x01a0,0x0000,0x0000,
+    0x3bff,0x02a2,0x0000,0x0000,0x3bfe,0x042b,0x0000,0x0000,0x3bfb,0x059e,0x0000,0x0000,0x3bf1,0x03e6,0x0000,0x0000,
+    0x3bec,0x03cb,0x0000,0x0000,0x3be6,0x0449,0x0000,0x0000,0x3be0,0x055f,0x0000,0x0000,0x3bd8,0x06ea,0x0000,0x0000,
+    0x3bcc,0x07f7,0x0000,0x0000,0x3bbc,0x07cf,0x0000,0x0000,0x3baa,0x0876,0x0000,0x0000,0x3b97,0x0918,0x0000,0x0000,
+    0x3b89,0x0951,0x0000,0x0000,0x3b7a,0x09cb,0x0000,0x0000,0x3b69,0x0a52,0x0000,0x0000,0x3b54,0x0a8e,0x0000,0x0000,
+    0x3b3d,0x0b00,0x0000,0x0000,0x3b23,0x0b45,0x0000,0x0000,0x3b06,0x0b9f,0x0000,0x0000,0x3ae6,0x0bd2,0x0000,0x0000,
+    0x3ac6,0x0c0c,0x0000,0x0000,0x3aa6,0x0c1c,0x0000,0x0000,0x3a83,0x0c30,0x0000,0x0000,0x3a5e,0x0c38,0x0000,0x0000,
+    0x3a37,0x0c3d,0x0000,0x0000,0x3a0f,0x0c3c,0x0000,0x0000,0x39e7,0x0c35,0x0000,0x0000,0x39bd,0x0c2e,0x0000,0x0000,
+    0x3992,0x0c20,0x0000,0x0000,0x3967,0x0c0d,0x0000,0x0000,0x393b,0x0bf0,0x0000,0x0000,0x390f,0x0bc7,0x0000,0x0000,
+    0x38e3,0x0b84,0x0000,0x0000,0x38b7,0x0b5a,0x0000,0x0000,0x388b,0x0b15,0x0000,0x0000,0x385f,0x0ada,0x0000,0x0000,
+    0x3834,0x0a9b,0x0000,0x0000,0x380a,0x0a53,0x0000,0x0000,0x37bf,0x0a19,0x0000,0x0000,0x376d,0x09d2,0x0000,0x0000,
+    0x371d,0x0992,0x0000,0x0000,0x36ce,0x0952,0x0000,0x0000,0x3682,0x090f,0x0000,0x0000,0x3638,0x08d5,0x0000,0x0000,
+    0x35ef,0x0892,0x0000,0x0000,0x35aa,0x085e,0x0000,0x0000,0x3566,0x081d,0x0000,0x0000,0x3525,0x07db,0x0000,0x0000,
+    0x3c00,0x003d,0x0000,0x0000,0x3c00,0x003d,0x0000,0x0000,0x3c00,0x003d,0x0000,0x0000,0x3c00,0x003d,0x0000,0x0000,
+    0x3c00,0x003d,0x0000,0x0000,0x3c00,0x003e,0x0000,0x0000,0x3c00,0x0040,0x0000,0x0000,0x3c00,0x0043,0x0000,0x0000,
+    0x3c00,0x0048,0x0000,0x0000,0x3c00,0x0051,0x0000,0x0000,0x3c00,0x0060,0x0000,0x0000,0x3c00,0x007a,0x0000,0x0000,
+    0x3c00,0x00a5,0x0000,0x0000,0x3c00,0x00ef,0x0000,0x0000,0x3bff,0x016a,0x0000,0x0000,0x3bff,0x0234,0x0000,0x0000,
+    0x3bff,0x0375,0x0000,0x0000,0x3bfe,0x0548,0x0000,0x0000,0x3bf9,0x062e,0x0000,0x0000,0x3bf0,0x0462,0x0000,0x0000,
+    0x3beb,0x04b2,0x0000,0x0000,0x3be5,0x0562,0x0000,0x0000,0x3be0,0x06da,0x0000,0x0000,0x3bd8,0x084d,0x0000,0x0000,
+    0x3bcb,0x0893,0x0000,0x0000,0x3bbc,0x08c8,0x0000,0x0000,0x3bac,0x097a,0x0000,0x0000,0x3b98,0x0a2a,0x0000,0x0000,
+    0x3b86,0x0a61,0x0000,0x0000,0x3b78,0x0b01,0x0000,0x0000,0x3b67,0x0b86,0x0000,0x0000,0x3b52,0x0bda,0x0000,0x0000,
+    0x3b3c,0x0c2d,0x0000,0x0000,0x3b21,0x0c52,0x0000,0x0000,0x3b05,0x0c81,0x0000,0x0000,0x3ae5,0x0c99,0x0000,0x0000,
+    0x3ac4,0x0cbe,0x0000,0x0000,0x3aa3,0x0cd3,0x0000,0x0000,0x3a81,0x0cdd,0x0000,0x0000,0x3a5d,0x0ceb,0x0000,0x0000,
+    0x3a36,0x0cea,0x0000,0x0000,0x3a0e,0x0ce9,0x0000,0x0000,0x39e5,0x0ce1,0x0000,0x0000,0x39bc,0x0cd1,0x0000,0x0000,
+    0x3992,0x0cbe,0x0000,0x0000,0x3967,0x0cac,0x0000,0x0000,0x393a,0x0c88,0x0000,0x0000,0x3910,0x0c74,0x0000,0x0000,
+    0x38e3,0x0c4e,0x0000,0x0000,0x38b7,0x0c2e,0x0000,0x0000,0x388c,0x0c0a,0x0000,0x0000,0x3861,0x0bc5,0x0000,0x0000,
+    0x3836,0x0b7b,0x0000,0x0000,0x380c,0x0b2f,0x0000,0x0000,0x37c4,0x0ade,0x0000,0x0000,0x3772,0x0a96,0x0000,0x0000,
+    0x3722,0x0a43,0x0000,0x0000,0x36d5,0x09fe,0x0000,0x0000,0x3688,0x09b0,0x0000,0x0000,0x363f,0x096c,0x0000,0x0000,
+    0x35f6,0x0923,0x0000,0x0000,0x35b1,0x08e3,0x0000,0x0000,0x356e,0x089e,0x0000,0x0000,0x352d,0x0865,0x0000,0x0000,
+    0x3c00,0x0068,0x0000,0x0000,0x3c00,0x0068,0x0000,0x0000,0x3c00,0x0068,0x0000,0x0000,0x3c00,0x0069,0x0000,0x0000,
+    0x3c00,0x0069,0x0000,0x0000,0x3c00,0x006b,0x0000,0x0000,0x3c00,0x006d,0x0000,0x0000,0x3c00,0x0072,0x0000,0x0000,
+    0x3c00,0x007a,0x0000,0x0000,0x3c00,0x0087,0x0000,0x0000,0x3c00,0x009c,0x0000,0x0000,0x3c00,0x00c0,0x0000,0x0000,
+    0x3c00,0x00fb,0x0000,0x0000,0x3c00,0x015c,0x0000,0x0000,0x3bff,0x01fb,0x0000,0x0000,0x3bff,0x02fb,0x0000,0x0000,
+    0x3bff,0x0487,0x0000,0x0000,0x3bfd,0x06a9,0x0000,0x0000,0x3bf7,0x0649,0x0000,0x0000,0x3bf0,0x0575,0x0000,0x0000,
+    0x3beb,0x05d1,0x0000,0x0000,0x3be5,0x06ec,0x0000,0x0000,0x3be0,0x085d,0x0000,0x0000,0x3bd7,0x094d,0x0000,0x0000,
+    0x3bca,0x094d,0x0000,0x0000,0x3bbd,0x09da,0x0000,0x0000,0x3bad,0x0ac6,0x0000,0x0000,0x3b98,0x0b5d,0x0000,0x0000,
+    0x3b84,0x0bba,0x0000,0x0000,0x3b76,0x0c3e,0x0000,0x0000,0x3b64,0x0c72,0x0000,0x0000,0x3b50,0x0cbd,0x0000,0x0000,
+    0x3b39,0x0cef,0x0000,0x0000,0x3b20,0x0d24,0x0000,0x0000,0x3b03,0x0d51,0x0000,0x0000,0x3ae4,0x0d73,0x0000,0x0000,
+    0x3ac2,0x0d8c,0x0000,0x0000,0x3aa1,0x0dab,0x0000,0x0000,0x3a7f,0x0db3,0x0000,0x0000,0x3a5b,0x0dbd,0x0000,0x0000,
+    0x3a35,0x0dbc,0x0000,0x0000,0x3a0d,0x0db1,0x0000,0x0000,0x39e4,0x0da4,0x0000,0x0000,0x39bb,0x0d96,0x0000,0x0000,
+    0x3991,0x0d72,0x0000,0x0000,0x3966,0x0d5f,0x0000,0x0000,0x393a,0x0d38,0x0000,0x0000,0x3910,0x0d16,0x0000,0x0000,
+    0x38e4,0x0ced,0x0000,0x0000,0x38b8,0x0cc2,0x0000,0x0000,0x388d,0x0c98,0x0000,0x0000,0x3862,0x0c6c,0x0000,0x0000,
+    0x3838,0x0c3e,0x0000,0x0000,0x380e,0x0c12,0x0000,0x0000,0x37c9,0x0bc5,0x0000,0x0000,0x3778,0x0b6f,0x0000,0x0000,
+    0x3728,0x0b14,0x0000,0x0000,0x36db,0x0abd,0x0000,0x0000,0x368f,0x0a6a,0x0000,0x0000,0x3646,0x0a14,0x0000,0x0000,
+    0x35fe,0x09c8,0x0000,0x0000,0x35b9,0x0975,0x0000,0x0000,0x3576,0x0931,0x0000,0x0000,0x3535,0x08e4,0x0000,0x0000,
+    0x3c00,0x00ae,0x0000,0x0000,0x3c00,0x00ae,0x0000,0x0000,0x3c00,0x00af,0x0000,0x0000,0x3c00,0x00af,0x0000,0x0000,
+    0x3c00,0x00b0,0x0000,0x0000,0x3c00,0x00b2,0x0000,0x0000,0x3c00,0x00b6,0x0000,0x0000,0x3c00,0x00bd,0x0000,0x0000,
+    0x3c00,0x00c8,0x0000,0x0000,0x3c00,0x00da,0x0000,0x0000,0x3c00,0x00f9,0x0000,0x0000,0x3c00,0x0129,0x0000,0x0000,
+    0x3c00,0x0179,0x0000,0x0000,0x3c00,0x01f9,0x0000,0x0000,0x3bff,0x02c6,0x0000,0x0000,0x3bff,0x0408,0x0000,0x0000,
+    0x3bfe,0x05ec,0x0000,0x0000,0x3bfd,0x082a,0x0000,0x0000,0x3bf5,0x0710,0x0000,0x0000,0x3bef,0x06c0,0x0000,0x0000,
+    0x3bea,0x074f,0x0000,0x0000,0x3be5,0x0877,0x0000,0x0000,0x3be0,0x098b,0x0000,0x0000,0x3bd7,0x0a72,0x0000,0x0000,
+    0x3bc9,0x0a72,0x0000,0x0000,0x3bbd,0x0b50,0x0000,0x0000,0x3bad,0x0c29,0x0000,0x0000,0x3b99,0x0c5c,0x0000,0x0000,
+    0x3b83,0x0cba,0x0000,0x0000,0x3b73,0x0d18,0x0000,0x0000,0x3b61,0x0d55,0x0000,0x0000,0x3b4e,0x0daa,0x0000,0x0000,
+    0x3b37,0x0dd3,0x0000,0x0000,0x3b1e,0x0e21,0x0000,0x0000,0x3b02,0x0e48,0x0000,0x0000,0x3ae3,0x0e74,0x0000,0x0000,
+    0x3ac1,0x0e8f,0x0000,0x0000,0x3a9f,0x0ea3,0x0000,0x0000,0x3a7c,0x0ead,0x0000,0x0000,0x3a59,0x0ead,0x0000,0x0000,
+    0x3a33,0x0ea9,0x0000,0x0000,0x3a0c,0x0ea2,0x0000,0x0000,0x39e2,0x0e83,0x0000,0x0000,0x39b9,0x0e73,0x0000,0x0000,
+    0x3990,0x0e4e,0x0000,0x0000,0x3966,0x0e2a,0x0000,0x0000,0x393b,0x0dff,0x0000,0x0000,0x390f,0x0dd1,0x0000,0x0000,
+    0x38e4,0x0da1,0x0000,0x0000,0x38ba,0x0d70,0x0000,0x0000,0x388e,0x0d3a,0x0000,0x0000,0x3864,0x0d08,0x0000,0x0000,
+    0x383a,0x0ccf,0x0000,0x0000,0x3810,0x0c9e,0x0000,0x0000,0x37ce,0x0c67,0x0000,0x0000,0x377e,0x0c31,0x0000,0x0000,
+    0x372f,0x0bff,0x0000,0x0000,0x36e2,0x0b97,0x0000,0x0000,0x3697,0x0b38,0x0000,0x0000,0x364d,0x0ad7,0x0000,0x0000,
+    0x3607,0x0a7d,0x0000,0x0000,0x35c1,0x0a24,0x0000,0x0000,0x357f,0x09d0,0x0000,0x0000,0x353e,0x097d,0x0000,0x0000,
+    0x3c00,0x011c,0x0000,0x0000,0x3c00,0x011c,0x0000,0x0000,0x3c00,0x011c,0x0000,0x0000,0x3c00,0x011d,0x0000,0x0000,
+    0x3c00,0x011e,0x0000,0x0000,0x3c00,0x0121,0x0000,0x0000,0x3c00,0x0127,0x0000,0x0000,0x3c00,0x0131,0x0000,0x0000,
+    0x3c00,0x0141,0x0000,0x0000,0x3c00,0x015b,0x0000,0x0000,0x3c00,0x0185,0x0000,0x0000,0x3c00,0x01c7,0x0000,0x0000,
+    0x3c00,0x0231,0x0000,0x0000,0x3bff,0x02d8,0x0000,0x0000,0x3bff,0x03de,0x0000,0x0000,0x3bff,0x0570,0x0000,0x0000,
+    0x3bfe,0x07bc,0x0000,0x0000,0x3bfc,0x0923,0x0000,0x0000,0x3bf4,0x0819,0x0000,0x0000,0x3bee,0x0822,0x0000,0x0000,
+    0x3bea,0x08c0,0x0000,0x0000,0x3be5,0x09c2,0x0000,0x0000,0x3bdf,0x0b02,0x0000,0x0000,0x3bd5,0x0baf,0x0000,0x0000,
+    0x3bc9,0x0bfd,0x0000,0x0000,0x3bbd,0x0c8b,0x0000,0x0000,0x3bae,0x0d0f,0x0000,0x0000,0x3b99,0x0d48,0x0000,0x0000,
+    0x3b83,0x0dbc,0x0000,0x0000,0x3b70,0x0e10,0x0000,0x0000,0x3b5f,0x0e6a,0x0000,0x0000,0x3b4b,0x0ec7,0x0000,0x0000,
+    0x3b34,0x0eff,0x0000,0x0000,0x3b1b,0x0f3a,0x0000,0x0000,0x3b00,0x0f74,0x0000,0x0000,0x3ae0,0x0f91,0x0000,0x0000,
+    0x3ac0,0x0fba,0x0000,0x0000,0x3a9d,0x0fc6,0x0000,0x0000,0x3a79,0x0fd1,0x0000,0x0000,0x3a56,0x0fd3,0x0000,0x0000,
+    0x3a31,0x0fbe,0x0000,0x0000,0x3a0a,0x0fb2,0x0000,0x0000,0x39e2,0x0f93,0x0000,0x0000,0x39b8,0x0f6f,0x0000,0x0000,
+    0x398f,0x0f46,0x0000,0x0000,0x3965,0x0f14,0x0000,0x0000,0x393b,0x0ee3,0x0000,0x0000,0x3910,0x0eaa,0x0000,0x0000,
+    0x38e5,0x0e6d,0x0000,0x0000,0x38bb,0x0e37,0x0000,0x0000,0x3890,0x0df3,0x0000,0x0000,0x3866,0x0db8,0x0000,0x0000,
+    0x383c,0x0d7a,0x0000,0x0000,0x3812,0x0d38,0x0000,0x0000,0x37d4,0x0cfd,0x0000,0x0000,0x3784,0x0cbc,0x0000,0x0000,
+    0x3736,0x0c84,0x0000,0x0000,0x36e9,0x0c49,0x0000,0x0000,0x369f,0x0c10,0x0000,0x0000,0x3656,0x0bb4,0x0000,0x0000,
+    0x360f,0x0b48,0x0000,0x0000,0x35cb,0x0ae6,0x0000,0x0000,0x3588,0x0a81,0x0000,0x0000,0x3548,0x0a2a,0x0000,0x0000,
+    0x3c00,0x01c4,0x0000,0x0000,0x3c00,0x01c4,0x0000,0x0000,0x3c00,0x01c5,0x0000,0x0000,0x3c00,0x01c5,0x0000,0x0000,
+    0x3c00,0x01c7,0x0000,0x0000,0x3c00,0x01cc,0x0000,0x0000,0x3c00,0x01d4,0x0000,0x0000,0x3c00,0x01e2,0x0000,0x0000,
+    0x3c00,0x01f8,0x0000,0x0000,0x3c00,0x021c,0x0000,0x0000,0x3c00,0x0256,0x0000,0x0000,0x3c00,0x02af,0x0000,0x0000,
+    0x3c00,0x033b,0x0000,0x0000,0x3bff,0x0413,0x0000,0x0000,0x3bff,0x055f,0x0000,0x0000,0x3bff,0x0752,0x0000,0x0000,
+    0x3bfe,0x090b,0x0000,0x0000,0x3bfb,0x0a26,0x0000,0x0000,0x3bf3,0x091a,0x0000,0x0000,0x3bee,0x094a,0x0000,0x0000,
+    0x3bea,0x0a2b,0x0000,0x0000,0x3be5,0x0b6a,0x0000,0x0000,0x3bdf,0x0c67,0x0000,0x0000,0x3bd4,0x0c8a,0x0000,0x0000,
+    0x3bc9,0x0cf9,0x0000,0x0000,0x3bbd,0x0d9a,0x0000,0x0000,0x3bad,0x0e14,0x0000,0x0000,0x3b9a,0x0e6f,0x0000,0x0000,
+    0x3b84,0x0f02,0x0000,0x0000,0x3b6d,0x0f46,0x0000,0x0000,0x3b5c,0x0fc0,0x0000,0x0000,0x3b48,0x1007,0x0000,0x0000,
+    0x3b32,0x1033,0x0000,0x0000,0x3b18,0x104a,0x0000,0x0000,0x3afd,0x106d,0x0000,0x0000,0x3ade,0x107c,0x0000,0x0000,
+    0x3abe,0x108c,0x0000,0x0000,0x3a9b,0x1093,0x0000,0x0000,0x3a77,0x1092,0x0000,0x0000,0x3a53,0x108f,0x0000,0x0000,
+    0x3a2f,0x1087,0x0000,0x0000,0x3a08,0x1074,0x0000,0x0000,0x39e1,0x1064,0x0000,0x0000,0x39b7,0x104a,0x0000,0x0000,
+    0x398e,0x1032,0x0000,0x0000,0x3965,0x1013,0x0000,0x0000,0x393b,0x0fe2,0x0000,0x0000,0x3910,0x0fa7,0x0000,0x0000,
+    0x38e5,0x0f5a,0x0000,0x0000,0x38bc,0x0f13,0x0000,0x0000,0x3892,0x0ece,0x0000,0x0000,0x3867,0x0e7e,0x0000,0x0000,
+    0x383e,0x0e38,0x0000,0x0000,0x3815,0x0dec,0x0000,0x0000,0x37da,0x0da2,0x0000,0x0000,0x378a,0x0d5f,0x0000,0x0000,
+    0x373d,0x0d17,0x0000,0x0000,0x36f1,0x0cd7,0x0000,0x0000,0x36a7,0x0c93,0x0000,0x0000,0x365f,0x0c56,0x0000,0x0000,
+    0x3618,0x0c18,0x0000,0x0000,0x35d4,0x0bbe,0x0000,0x0000,0x3592,0x0b4e,0x0000,0x0000,0x3551,0x0ae6,0x0000,0x0000,
+    0x3c00,0x02c2,0x0000,0x0000,0x3c00,0x02c2,0x0000,0x0000,0x3c00,0x02c2,0x0000,0x0000,0x3c00,0x02c3,0x0000,0x0000,
+    0x3c00,0x02c6,0x0000,0x0000,0x3c00,0x02cc,0x0000,0x0000,0x3c00,0x02d7,0x0000,0x0000,0x3c00,0x02ea,0x0000,0x0000,
+    0x3c00,0x030a,0x0000,0x0000,0x3c00,0x033b,0x0000,0x0000,0x3c00,0x0388,0x0000,0x0000,0x3c00,0x03ff,0x0000,0x0000,
+    0x3c00,0x04b6,0x0000,0x0000,0x3bff,0x05cc,0x0000,0x0000,0x3bff,0x076f,0x0000,0x0000,0x3bff,0x08eb,0x0000,0x0000,
+    0x3bfe,0x0a8e,0x0000,0x0000,0x3bf8,0x0aea,0x0000,0x0000,0x3bf2,0x0a37,0x0000,0x0000,0x3bee,0x0ae4,0x0000,0x0000,
+    0x3bea,0x0c01,0x0000,0x0000,0x3be5,0x0cc2,0x0000,0x0000,0x3bde,0x0d7a,0x0000,0x0000,0x3bd3,0x0d93,0x0000,0x0000,
+    0x3bc9,0x0e31,0x0000,0x0000,0x3bbd,0x0ef2,0x0000,0x0000,0x3bac,0x0f46,0x0000,0x0000,0x3b9a,0x0fea,0x0000,0x0000,
+    0x3b84,0x103e,0x0000,0x0000,0x3b6c,0x106b,0x0000,0x0000,0x3b59,0x10a8,0x0000,0x0000,0x3b45,0x10d2,0x0000,0x0000,
+    0x3b2f,0x1104,0x0000,0x0000,0x3b16,0x1120,0x0000,0x0000,0x3afa,0x113b,0x0000,0x0000,0x3adc,0x114d,0x0000,0x0000,
+    0x3abc,0x1158,0x0000,0x0000,0x3a99,0x115c,0x0000,0x0000,0x3a75,0x115f,0x0000,0x0000,0x3a50,0x114c,0x0000,0x0000,
+    0x3a2d,0x1146,0x0000,0x0000,0x3a06,0x1129,0x0000,0x0000,0x39df,0x1118,0x0000,0x0000,0x39b6,0x10f5,0x0000,0x0000,
+    0x398d,0x10d3,0x0000,0x0000,0x3964,0x10b2,0x0000,0x0000,0x393b,0x1087,0x0000,0x0000,0x3911,0x105f,0x0000,0x0000,
+    0x38e7,0x1037,0x0000,0x0000,0x38bd,0x100a,0x0000,0x0000,0x3893,0x0fbb,0x0000,0x0000,0x386a,0x0f67,0x0000,0x0000,
+    0x3841,0x0f0c,0x0000,0x0000,0x3818,0x0eba,0x0000,0x0000,0x37e1,0x0e64,0x0000,0x0000,0x3792,0x0e10,0x0000,0x0000,
+    0x3745,0x0dc1,0x0000,0x0000,0x36fa,0x0d71,0x0000,0x0000,0x36b0,0x0d29,0x0000,0x0000,0x3668,0x0cdf,0x0000,0x0000,
+    0x3622,0x0c9c,0x0000,0x0000,0x35de,0x0c59,0x0000,0x0000,0x359c,0x0c1b,0x0000,0x0000,0x355c,0x0bbb,0x0000,0x0000,
+    0x3c00,0x0438,0x0000,0x0000,0x3c00,0x0438,0x0000,0x0000,0x3c00,0x0438,0x0000,0x0000,0x3c00,0x043a,0x0000,0x0000,
+    0x3c00,0x043e,0x0000,0x0000,0x3c00,0x0446,0x0000,0x0000,0x3c00,0x0456,0x0000,0x0000,0x3c00,0x0470,0x0000,0x0000,
+    0x3c00,0x049b,0x0000,0x0000,0x3c00,0x04de,0x0000,0x0000,0x3c00,0x0545,0x0000,0x0000,0x3c00,0x05e1,0x0000,0x0000,
+    0x3bff,0x06ce,0x0000,0x0000,0x3bff,0x0818,0x0000,0x0000,0x3bff,0x091e,0x0000,0x0000,0x3bfe,0x0a96,0x0000,0x0000,
+    0x3bfd,0x0c3f,0x0000,0x0000,0x3bf6,0x0c05,0x0000,0x0000,0x3bf1,0x0c04,0x0000,0x0000,0x3bed,0x0c7a,0x0000,0x0000,
+    0x3be9,0x0d2f,0x0000,0x0000,0x3be4,0x0e17,0x0000,0x0000,0x3bdc,0x0eb9,0x0000,0x0000,0x3bd2,0x0ee9,0x0000,0x0000,
+    0x3bc9,0x0fcb,0x0000,0x0000,0x3bbc,0x1048,0x0000,0x0000,0x3bab,0x1077,0x0000,0x0000,0x3b99,0x10d4,0x0000,0x0000,
+    0x3b83,0x1114,0x0000,0x0000,0x3b6c,0x115c,0x0000,0x0000,0x3b55,0x1197,0x0000,0x0000,0x3b41,0x11c5,0x0000,0x0000,
+    0x3b2b,0x11f2,0x0000,0x0000,0x3b12,0x1218,0x0000,0x0000,0x3af7,0x1230,0x0000,0x0000,0x3ada,0x1243,0x0000,0x0000,
+    0x3aba,0x1251,0x0000,0x0000,0x3a97,0x1246,0x0000,0x0000,0x3a74,0x124a,0x0000,0x0000,0x3a4e,0x122e,0x0000,0x0000,
+    0x3a2a,0x1224,0x0000,0x0000,0x3a04,0x11fe,0x0000,0x0000,0x39de,0x11e1,0x0000,0x0000,0x39b6,0x11bd,0x0000,0x0000,
+    0x398c,0x118f,0x0000,0x0000,0x3963,0x1162,0x0000,0x0000,0x393b,0x1136,0x0000,0x0000,0x3912,0x1103,0x0000,0x0000,
+    0x38e8,0x10cd,0x0000,0x0000,0x38be,0x109d,0x0000,0x0000,0x3895,0x1068,0x0000,0x0000,0x386c,0x1033,0x0000,0x0000,
+    0x3844,0x1003,0x0000,0x0000,0x381b,0x0f9b,0x0000,0x0000,0x37e7,0x0f3f,0x0000,0x0000,0x379a,0x0edc,0x0000,0x0000,
+    0x374d,0x0e81,0x0000,0x0000,0x3703,0x0e27,0x0000,0x0000,0x36ba,0x0dd1,0x0000,0x0000,0x3672,0x0d7e,0x0000,0x0000,
+    0x362d,0x0d2f,0x0000,0x0000,0x35e9,0x0ce3,0x0000,0x0000,0x35a7,0x0c9c,0x0000,0x0000,0x3568,0x0c58,0x0000,0x0000,
+    0x3c00,0x0658,0x0000,0x0000,0x3c00,0x0659,0x0000,0x0000,0x3c00,0x0659,0x0000,0x0000,0x3c00,0x065b,0x0000,0x0000,
+    0x3c00,0x0660,0x0000,0x0000,0x3c00,0x066c,0x0000,0x0000,0x3c00,0x0681,0x0000,0x0000,0x3c00,0x06a4,0x0000,0x0000,
+    0x3c00,0x06de,0x0000,0x0000,0x3c00,0x0737,0x0000,0x0000,0x3c00,0x07bf,0x0000,0x0000,0x3c00,0x0846,0x0000,0x0000,
+    0x3bff,0x08de,0x0000,0x0000,0x3bff,0x09be,0x0000,0x0000,0x3bff,0x0b03,0x0000,0x0000,0x3bfe,0x0c66,0x0000,0x0000,
+    0x3bfd,0x0d75,0x0000,0x0000,0x3bf5,0x0cfe,0x0000,0x0000,0x3bf1,0x0d36,0x0000,0x0000,0x3bed,0x0dcc,0x0000,0x0000,
+    0x3be9,0x0eb4,0x0000,0x0000,0x3be4,0x0fc0,0x0000,0x0000,0x3bdb,0x100e,0x0000,0x0000,0x3bd1,0x105e,0x0000,0x0000,
+    0x3bc8,0x10df,0x0000,0x0000,0x3bbb,0x1138,0x0000,0x0000,0x3baa,0x117d,0x0000,0x0000,0x3b99,0x11e5,0x0000,0x0000,
+    0x3b84,0x1226,0x0000,0x0000,0x3b6c,0x127f,0x0000,0x0000,0x3b52,0x12b8,0x0000,0x0000,0x3b3d,0x12f2,0x0000,0x0000,
+    0x3b27,0x131e,0x0000,0x0000,0x3b0f,0x133e,0x0000,0x0000,0x3af4,0x135b,0x0000,0x0000,0x3ad7,0x1362,0x0000,0x0000,
+    0x3ab7,0x136e,0x0000,0x0000,0x3a95,0x1363,0x0000,0x0000,0x3a72,0x135a,0x0000,0x0000,0x3a4c,0x1339,0x0000,0x0000,
+    0x3a27,0x1321,0x0000,0x0000,0x3a02,0x12fa,0x0000,0x0000,0x39dc,0x12ce,0x0000,0x0000,0x39b5,0x129b,0x0000,0x0000,
+    0x398c,0x126b,0x0000,0x0000,0x3963,0x1232,0x0000,0x0000,0x393a,0x11f4,0x0000,0x0000,0x3912,0x11bd,0x0000,0x0000,
+    0x38e9,0x117f,0x0000,0x0000,0x38c0,0x113f,0x0000,0x0000,0x3897,0x1107,0x0000,0x0000,0x386e,0x10c7,0x0000,0x0000,
+    0x3846,0x108b,0x0000,0x0000,0x381f,0x1053,0x0000,0x0000,0x37ee,0x1017,0x0000,0x0000,0x37a2,0x0fc5,0x0000,0x0000,
+    0x3756,0x0f56,0x0000,0x0000,0x370c,0x0ef3,0x0000,0x0000,0x36c4,0x0e8c,0x0000,0x0000,0x367d,0x0e33,0x0000,0x0000,
+    0x3637,0x0dd2,0x0000,0x0000,0x35f4,0x0d82,0x0000,0x0000,0x35b3,0x0d2a,0x0000,0x0000,0x3574,0x0ce2,0x0000,0x0000,
+    0x3c00,0x08b2,0x0000,0x0000,0x3c00,0x08b2,0x0000,0x0000,0x3c00,0x08b3,0x0000,0x0000,0x3c00,0x08b4,0x0000,0x0000,
+    0x3c00,0x08b8,0x0000,0x0000,0x3c00,0x08bf,0x0000,0x0000,0x3c00,0x08cd,0x0000,0x0000,0x3c00,0x08e5,0x0000,0x0000,
+    0x3c00,0x090b,0x0000,0x0000,0x3c00,0x0946,0x0000,0x0000,0x3c00,0x099f,0x0000,0x0000,0x3c00,0x0a23,0x0000,0x0000,
+    0x3bff,0x0ae5,0x0000,0x0000,0x3bff,0x0bfe,0x0000,0x0000,0x3bff,0x0cc8,0x0000,0x0000,0x3bfe,0x0ddb,0x0000,0x0000,
+    0x3bfc,0x0eeb,0x0000,0x0000,0x3bf4,0x0e4f,0x0000,0x0000,0x3bf0,0x0eb7,0x0000,0x0000,0x3bec,0x0f7a,0x0000,0x0000,
+    0x3be8,0x1051,0x0000,0x0000,0x3be3,0x10e5,0x0000,0x0000,0x3bd9,0x1106,0x0000,0x0000,0x3bd0,0x117a,0x0000,0x0000,
+    0x3bc7,0x120a,0x0000,0x0000,0x3bb9,0x1257,0x0000,0x0000,0x3baa,0x12ce,0x0000,0x0000,0x3b98,0x132d,0x0000,0x0000,
+    0x3b83,0x1383,0x0000,0x0000,0x3b6b,0x13cd,0x0000,0x0000,0x3b51,0x140f,0x0000,0x0000,0x3b39,0x1426,0x0000,0x0000,
+    0x3b24,0x1441,0x0000,0x0000,0x3b0b,0x144d,0x0000,0x0000,0x3af1,0x145b,0x0000,0x0000,0x3ad3,0x1460,0x0000,0x0000,
+    0x3ab4,0x145c,0x0000,0x0000,0x3a93,0x1457,0x0000,0x0000,0x3a6f,0x144a,0x0000,0x0000,0x3a4b,0x143a,0x0000,0x0000,
+    0x3a25,0x1424,0x0000,0x0000,0x39ff,0x1409,0x0000,0x0000,0x39da,0x13e3,0x0000,0x0000,0x39b4,0x13a3,0x0000,0x0000,
+    0x398c,0x135d,0x0000,0x0000,0x3963,0x1320,0x0000,0x0000,0x393a,0x12d8,0x0000,0x0000,0x3912,0x128d,0x0000,0x0000,
+    0x38ea,0x1248,0x0000,0x0000,0x38c2,0x1200,0x0000,0x0000,0x3899,0x11b5,0x0000,0x0000,0x3871,0x1170,0x0000,0x0000,
+    0x384a,0x1129,0x0000,0x0000,0x3822,0x10e3,0x0000,0x0000,0x37f7,0x10a5,0x0000,0x0000,0x37aa,0x1061,0x0000,0x0000,
+    0x3760,0x1027,0x0000,0x0000,0x3716,0x0fd2,0x0000,0x0000,0x36ce,0x0f64,0x0000,0x0000,0x3688,0x0ef6,0x0000,0x0000,
+    0x3643,0x0e8d,0x0000,0x0000,0x3601,0x0e30,0x0000,0x0000,0x35bf,0x0dcf,0x0000,0x0000,0x3581,0x0d7c,0x0000,0x0000,
+    0x3c00,0x0ada,0x0000,0x0000,0x3c00,0x0ada,0x0000,0x0000,0x3c00,0x0ada,0x0000,0x0000,0x3c00,0x0adc,0x0000,0x0000,
+    0x3c00,0x0ae1,0x0000,0x0000,0x3c00,0x0aeb,0x0000,0x0000,0x3c00,0x0afd,0x0000,0x0000,0x3c00,0x0b1d,0x0000,0x0000,
+    0x3c00,0x0b4f,0x0000,0x0000,0x3c00,0x0b9c,0x0000,0x0000,0x3c00,0x0c07,0x0000,0x0000,0x3c00,0x0c5c,0x0000,0x0000,
+    0x3bff,0x0cd6,0x0000,0x0000,0x3bff,0x0d85,0x0000,0x0000,0x3bff,0x0e7b,0x0000,0x0000,0x3bfe,0x0fc3,0x0000,0x0000,
+    0x3bfa,0x1043,0x0000,0x0000,0x3bf3,0x1013,0x0000,0x0000,0x3bef,0x104a,0x0000,0x0000,0x3beb,0x10d0,0x0000,0x0000,
+    0x3be8,0x118a,0x0000,0x0000,0x3be2,0x1220,0x0000,0x0000,0x3bd8,0x124c,0x0000,0x0000,0x3bcf,0x12e4,0x0000,0x0000,
+    0x3bc5,0x1377,0x0000,0x0000,0x3bb7,0x13cf,0x0000,0x0000,0x3ba9,0x1430,0x0000,0x0000,0x3b97,0x1459,0x0000,0x0000,
+    0x3b82,0x1495,0x0000,0x0000,0x3b6a,0x14b3,0x0000,0x0000,0x3b50,0x14e0,0x0000,0x0000,0x3b35,0x14f7,0x0000,0x0000,
+    0x3b1f,0x1514,0x0000,0x0000,0x3b07,0x1522,0x0000,0x0000,0x3aec,0x1524,0x0000,0x0000,0x3ad0,0x152b,0x0000,0x0000,
+    0x3ab1,0x151c,0x0000,0x0000,0x3a90,0x1519,0x0000,0x0000,0x3a6d,0x1500,0x0000,0x0000,0x3a49,0x14eb,0x0000,0x0000,
+    0x3a23,0x14d3,0x0000,0x0000,0x39fd,0x14ae,0x0000,0x0000,0x39d8,0x148b,0x0000,0x0000,0x39b3,0x1469,0x0000,0x0000,
+    0x398b,0x143f,0x0000,0x0000,0x3964,0x1415,0x0000,0x0000,0x393b,0x13d6,0x0000,0x0000,0x3913,0x1383,0x0000,0x0000,
+    0x38ec,0x132a,0x0000,0x0000,0x38c4,0x12d4,0x0000,0x0000,0x389c,0x1282,0x0000,0x0000,0x3874,0x1229,0x0000,0x0000,
+    0x384d,0x11de,0x0000,0x0000,0x3826,0x118b,0x0000,0x0000,0x3800,0x1140,0x0000,0x0000,0x37b4,0x10f7,0x0000,0x0000,
+    0x376a,0x10ac,0x0000,0x0000,0x3721,0x106d,0x0000,0x0000,0x36d9,0x1028,0x0000,0x0000,0x3694,0x0fdb,0x0000,0x0000,
+    0x3650,0x0f63,0x0000,0x0000,0x360d,0x0ef4,0x0000,0x0000,0x35cc,0x0e8a,0x0000,0x0000,0x358e,0x0e26,0x0000,0x0000,
+    0x3c00,0x0ced,0x0000,0x0000,0x3c00,0x0ced,0x0000,0x0000,0x3c00,0x0cee,0x0000,0x0000,0x3c00,0x0cef,0x0000,0x0000,
+    0x3c00,0x0cf2,0x0000,0x0000,0x3c00,0x0cf9,0x0000,0x0000,0x3c00,0x0d05,0x0000,0x0000,0x3c00,0x0d19,0x0000,0x0000,
+    0x3c00,0x0d3a,0x0000,0x0000,0x3c00,0x0d6b,0x0000,0x0000,0x3c00,0x0db5,0x0000,0x0000,0x3bff,0x0e20,0x0000,0x0000,
+    0x3bff,0x0eb9,0x0000,0x0000,0x3bff,0x0f92,0x0000,0x0000,0x3bfe,0x105e,0x0000,0x0000,0x3bfd,0x111f,0x0000,0x0000,
+    0x3bf8,0x112d,0x0000,0x0000,0x3bf2,0x112d,0x0000,0x0000,0x3bef,0x11a5,0x0000,0x0000,0x3beb,0x1248,0x0000,0x0000,
+    0x3be7,0x1313,0x0000,0x0000,0x3be0,0x138e,0x0000,0x0000,0x3bd7,0x13f4,0x0000,0x0000,0x3bcf,0x1458,0x0000,0x0000,
+    0x3bc4,0x1499,0x0000,0x0000,0x3bb6,0x14cd,0x0000,0x0000,0x3ba8,0x1521,0x0000,0x0000,0x3b95,0x154d,0x0000,0x0000,
+    0x3b81,0x1591,0x0000,0x0000,0x3b6a,0x15b5,0x0000,0x0000,0x3b50,0x15de,0x0000,0x0000,0x3b33,0x15f9,0x0000,0x0000,
+    0x3b1b,0x160a,0x0000,0x0000,0x3b02,0x1618,0x0000,0x0000,0x3ae8,0x1617,0x0000,0x0000,0x3acc,0x1619,0x0000,0x0000,
+    0x3aad,0x1600,0x0000,0x0000,0x3a8d,0x15f9,0x0000,0x0000,0x3a6b,0x15dc,0x0000,0x0000,0x3a47,0x15b9,0x0000,0x0000,
+    0x3a22,0x1595,0x0000,0x0000,0x39fc,0x156e,0x0000,0x0000,0x39d6,0x1542,0x0000,0x0000,0x39b1,0x1512,0x0000,0x0000,
+    0x398b,0x14e1,0x0000,0x0000,0x3964,0x14b1,0x0000,0x0000,0x393c,0x147d,0x0000,0x0000,0x3914,0x1448,0x0000,0x0000,
+    0x38ed,0x1418,0x0000,0x0000,0x38c6,0x13c5,0x0000,0x0000,0x389e,0x1364,0x0000,0x0000,0x3877,0x1304,0x0000,0x0000,
+    0x3850,0x12a4,0x0000,0x0000,0x382a,0x124c,0x0000,0x0000,0x3805,0x11ee,0x0000,0x0000,0x37bf,0x119e,0x0000,0x0000,
+    0x3774,0x1148,0x0000,0x0000,0x372d,0x10fe,0x0000,0x0000,0x36e6,0x10b0,0x0000,0x0000,0x36a0,0x106d,0x0000,0x0000,
+    0x365d,0x1026,0x0000,0x0000,0x361b,0x0fd3,0x0000,0x0000,0x35db,0x0f59,0x0000,0x0000,0x359c,0x0ee8,0x0000,0x0000,
+    0x3c00,0x0f00,0x0000,0x0000,0x3c00,0x0f00,0x0000,0x0000,0x3c00,0x0f00,0x0000,0x0000,0x3c00,0x0f01,0x0000,0x0000,
+    0x3c00,0x0f05,0x0000,0x0000,0x3c00,0x0f0e,0x0000,0x0000,0x3c00,0x0f1e,0x0000,0x0000,0x3c00,0x0f38,0x0000,0x0000,
+    0x3c00,0x0f62,0x0000,0x0000,0x3c00,0x0fa2,0x0000,0x0000,0x3c00,0x0fff,0x0000,0x0000,0x3bff,0x1043,0x0000,0x0000,
+    0x3bff,0x10a2,0x0000,0x0000,0x3bff,0x1127,0x0000,0x0000,0x3bfe,0x11db,0x0000,0x0000,0x3bfd,0x12b6,0x0000,0x0000,
+    0x3bf6,0x1296,0x0000,0x0000,0x3bf2,0x12cd,0x0000,0x0000,0x3bee,0x1365,0x0000,0x0000,0x3beb,0x1415,0x0000,0x0000,
+    0x3be6,0x147e,0x0000,0x0000,0x3bde,0x14af,0x0000,0x0000,0x3bd6,0x1507,0x0000,0x0000,0x3bcd,0x156f,0x0000,0x0000,
+    0x3bc2,0x15a8,0x0000,0x0000,0x3bb4,0x15fa,0x0000,0x0000,0x3ba6,0x1643,0x0000,0x0000,0x3b94,0x167b,0x0000,0x0000,
+    0x3b80,0x16b2,0x0000,0x0000,0x3b69,0x16e6,0x0000,0x0000,0x3b4e,0x1708,0x0000,0x0000,0x3b31,0x1723,0x0000,0x0000,
+    0x3b16,0x1737,0x0000,0x0000,0x3afe,0x173a,0x0000,0x0000,0x3ae4,0x1737,0x0000,0x0000,0x3ac8,0x172f,0x0000,0x0000,
+    0x3aaa,0x1713,0x0000,0x0000,0x3a8a,0x16f9,0x0000,0x0000,0x3a68,0x16d3,0x0000,0x0000,0x3a45,0x16ac,0x0000,0x0000,
+    0x3a20,0x167b,0x0000,0x0000,0x39fa,0x1645,0x0000,0x0000,0x39d4,0x1610,0x0000,0x0000,0x39af,0x15d9,0x0000,0x0000,
+    0x398a,0x159c,0x0000,0x0000,0x3964,0x155e,0x0000,0x0000,0x393d,0x1525,0x0000,0x0000,0x3915,0x14e5,0x0000,0x0000,
+    0x38ee,0x14aa,0x0000,0x0000,0x38c8,0x146e,0x0000,0x0000,0x38a1,0x1435,0x0000,0x0000,0x387b,0x13f4,0x0000,0x0000,
+    0x3855,0x1389,0x0000,0x0000,0x382e,0x131d,0x0000,0x0000,0x3809,0x12bb,0x0000,0x0000,0x37c9,0x1255,0x0000,0x0000,
+    0x3780,0x11fc,0x0000,0x0000,0x3738,0x119c,0x0000,0x0000,0x36f3,0x114e,0x0000,0x0000,0x36ae,0x10f7,0x0000,0x0000,
+    0x366b,0x10af,0x0000,0x0000,0x3629,0x1064,0x0000,0x0000,0x35e9,0x1021,0x0000,0x0000,0x35ab,0x0fc1,0x0000,0x0000,
+    0x3c00,0x10e9,0x0000,0x0000,0x3c00,0x10e9,0x0000,0x0000,0x3c00,0x10ea,0x0000,0x0000,0x3c00,0x10ea,0x0000,0x0000,
+    0x3c00,0x10ed,0x0000,0x0000,0x3c00,0x10f3,0x0000,0x0000,0x3c00,0x10fd,0x0000,0x0000,0x3c00,0x110e,0x0000,0x0000,
+    0x3c00,0x1128,0x0000,0x0000,0x3c00,0x1150,0x0000,0x0000,0x3c00,0x118b,0x0000,0x0000,0x3bff,0x11df,0x0000,0x0000,
+    0x3bff,0x1254,0x0000,0x0000,0x3bff,0x12f6,0x0000,0x0000,0x3bfe,0x13ce,0x0000,0x0000,0x3bfc,0x145c,0x0000,0x0000,
+    0x3bf5,0x1430,0x0000,0x0000,0x3bf1,0x1473,0x0000,0x0000,0x3bee,0x14d1,0x0000,0x0000,0x3bea,0x1548,0x0000,0x0000,
+    0x3be4,0x15b2,0x0000,0x0000,0x3bdd,0x15ec,0x0000,0x0000,0x3bd5,0x164e,0x0000,0x0000,0x3bcb,0x16bc,0x0000,0x0000,
+    0x3bc0,0x1706,0x0000,0x0000,0x3bb3,0x1762,0x0000,0x0000,0x3ba4,0x17a2,0x0000,0x0000,0x3b92,0x17f0,0x0000,0x0000,
+    0x3b7e,0x180f,0x0000,0x0000,0x3b67,0x1829,0x0000,0x0000,0x3b4d,0x183b,0x0000,0x0000,0x3b30,0x1842,0x0000,0x0000,
+    0x3b13,0x184d,0x0000,0x0000,0x3af8,0x1846,0x0000,0x0000,0x3adf,0x1846,0x0000,0x0000,0x3ac3,0x1836,0x0000,0x0000,
+    0x3aa5,0x1828,0x0000,0x0000,0x3a87,0x1816,0x0000,0x0000,0x3a65,0x17f4,0x0000,0x0000,0x3a42,0x17bc,0x0000,0x0000,
+    0x3a1e,0x1786,0x0000,0x0000,0x39f9,0x1744,0x0000,0x0000,0x39d3,0x16fd,0x0000,0x0000,0x39ae,0x16b8,0x0000,0x0000,
+    0x3989,0x1672,0x0000,0x0000,0x3964,0x1628,0x0000,0x0000,0x393e,0x15e0,0x0000,0x0000,0x3917,0x1596,0x0000,0x0000,
+    0x38f0,0x1552,0x0000,0x0000,0x38ca,0x150a,0x0000,0x0000,0x38a4,0x14c6,0x0000,0x0000,0x387f,0x1486,0x0000,0x0000,
+    0x3859,0x1444,0x0000,0x0000,0x3833,0x1408,0x0000,0x0000,0x380e,0x1397,0x0000,0x0000,0x37d4,0x132a,0x0000,0x0000,
+    0x378d,0x12bb,0x0000,0x0000,0x3745,0x1259,0x0000,0x0000,0x3700,0x11f5,0x0000,0x0000,0x36bc,0x119b,0x0000,0x0000,
+    0x367a,0x1146,0x0000,0x0000,0x3638,0x10f0,0x0000,0x0000,0x35f9,0x10a6,0x0000,0x0000,0x35bb,0x105c,0x0000,0x0000,
+    0x3c00,0x12d1,0x0000,0x0000,0x3c00,0x12d1,0x0000,0x0000,0x3c00,0x12d1,0x0000,0x0000,0x3c00,0x12d3,0x0000,0x0000,
+    0x3c00,0x12d6,0x0000,0x0000,0x3c00,0x12dd,0x0000,0x0000,0x3c00,0x12ea,0x0000,0x0000,0x3c00,0x12ff,0x0000,0x0000,
+    0x3c00,0x1321,0x0000,0x0000,0x3c00,0x1353,0x0000,0x0000,0x3c00,0x139c,0x0000,0x0000,0x3bff,0x1402,0x0000,0x0000,
+    0x3bff,0x144a,0x0000,0x0000,0x3bfe,0x14ac,0x0000,0x0000,0x3bfe,0x152b,0x0000,0x0000,0x3bfb,0x1591,0x0000,0x0000,
+    0x3bf4,0x1579,0x0000,0x0000,0x3bf1,0x15c5,0x0000,0x0000,0x3bed,0x163d,0x0000,0x0000,0x3bea,0x16cb,0x0000,0x0000,
+    0x3be3,0x1722,0x0000,0x0000,0x3bdb,0x1776,0x0000,0x0000,0x3bd4,0x17f7,0x0000,0x0000,0x3bc9,0x1827,0x0000,0x0000,
+    0x3bbe,0x1858,0x0000,0x0000,0x3bb1,0x1889,0x0000,0x0000,0x3ba1,0x18ad,0x0000,0x0000,0x3b90,0x18d4,0x0000,0x0000,
+    0x3b7c,0x18ed,0x0000,0x0000,0x3b64,0x1901,0x0000,0x0000,0x3b4b,0x1912,0x0000,0x0000,0x3b2f,0x1916,0x0000,0x0000,
+    0x3b11,0x191e,0x0000,0x0000,0x3af3,0x190d,0x0000,0x0000,0x3ada,0x190c,0x0000,0x0000,0x3abe,0x18f7,0x0000,0x0000,
+    0x3aa1,0x18dc,0x0000,0x0000,0x3a83,0x18c3,0x0000,0x0000,0x3a62,0x18a5,0x0000,0x0000,0x3a40,0x1880,0x0000,0x0000,
+    0x3a1d,0x185a,0x0000,0x0000,0x39f8,0x1832,0x0000,0x0000,0x39d2,0x1807,0x0000,0x0000,0x39ad,0x17bb,0x0000,0x0000,
+    0x3988,0x1765,0x0000,0x0000,0x3964,0x170a,0x0000,0x0000,0x393f,0x16b9,0x0000,0x0000,0x3919,0x1662,0x0000,0x0000,
+    0x38f3,0x160c,0x0000,0x0000,0x38cd,0x15bd,0x0000,0x0000,0x38a7,0x156d,0x0000,0x0000,0x3882,0x151f,0x0000,0x0000,
+    0x385d,0x14d8,0x0000,0x0000,0x3838,0x148e,0x0000,0x0000,0x3814,0x144d,0x0000,0x0000,0x37df,0x140a,0x0000,0x0000,
+    0x379a,0x139b,0x0000,0x0000,0x3753,0x1328,0x0000,0x0000,0x370e,0x12b7,0x0000,0x0000,0x36cb,0x1254,0x0000,0x0000,
+    0x3689,0x11eb,0x0000,0x0000,0x3649,0x1192,0x0000,0x0000,0x3609,0x1137,0x0000,0x0000,0x35cc,0x10e7,0x0000,0x0000,
+    0x3c00,0x14af,0x0000,0x0000,0x3c00,0x14af,0x0000,0x0000,0x3c00,0x14af,0x0000,0x0000,0x3c00,0x14b0,0x0000,0x0000,
+    0x3c00,0x14b2,0x0000,0x0000,0x3c00,0x14b6,0x0000,0x0000,0x3c00,0x14be,0x0000,0x0000,0x3c00,0x14cb,0x0000,0x0000,
+    0x3c00,0x14e0,0x0000,0x0000,0x3c00,0x1500,0x0000,0x0000,0x3bff,0x152d,0x0000,0x0000,0x3bff,0x156c,0x0000,0x0000,
+    0x3bff,0x15c3,0x0000,0x0000,0x3bfe,0x1639,0x0000,0x0000,0x3bfd,0x16ce,0x0000,0x0000,0x3bf8,0x16f9,0x0000,0x0000,
+    0x3bf3,0x1714,0x0000,0x0000,0x3bef,0x176b,0x0000,0x0000,0x3bed,0x1804,0x0000,0x0000,0x3be9,0x1858,0x0000,0x0000,
+    0x3be1,0x1875,0x0000,0x0000,0x3bda,0x18b9,0x0000,0x0000,0x3bd2,0x18ff,0x0000,0x0000,0x3bc7,0x1926,0x0000,0x0000,
+    0x3bbc,0x1962,0x0000,0x0000,0x3baf,0x198f,0x0000,0x0000,0x3b9f,0x19b4,0x0000,0x0000,0x3b8e,0x19d8,0x0000,0x0000,
+    0x3b79,0x19f6,0x0000,0x0000,0x3b63,0x1a08,0x0000,0x0000,0x3b49,0x1a11,0x0000,0x0000,0x3b2c,0x1a14,0x0000,0x0000,
+    0x3b0f,0x1a13,0x0000,0x0000,0x3af0,0x1a01,0x0000,0x0000,0x3ad4,0x19ed,0x0000,0x0000,0x3ab9,0x19d4,0x0000,0x0000,
+    0x3a9c,0x19b5,0x0000,0x0000,0x3a7e,0x1990,0x0000,0x0000,0x3a5e,0x1964,0x0000,0x0000,0x3a3c,0x1937,0x0000,0x0000,
+    0x3a1b,0x190a,0x0000,0x0000,0x39f7,0x18d8,0x0000,0x0000,0x39d2,0x18a4,0x0000,0x0000,0x39ad,0x186e,0x0000,0x0000,
+    0x3988,0x183e,0x0000,0x0000,0x3964,0x1809,0x0000,0x0000,0x3940,0x17a9,0x0000,0x0000,0x391b,0x1746,0x0000,0x0000,
+    0x38f6,0x16e7,0x0000,0x0000,0x38d0,0x1682,0x0000,0x0000,0x38ab,0x162b,0x0000,0x0000,0x3886,0x15cf,0x0000,0x0000,
+    0x3862,0x157a,0x0000,0x0000,0x383e,0x152a,0x0000,0x0000,0x381a,0x14db,0x0000,0x0000,0x37ec,0x1491,0x0000,0x0000,
+    0x37a6,0x144c,0x0000,0x0000,0x3762,0x1408,0x0000,0x0000,0x371e,0x1396,0x0000,0x0000,0x36db,0x1319,0x0000,0x0000,
+    0x369a,0x12ac,0x0000,0x0000,0x365a,0x1243,0x0000,0x0000,0x361b,0x11dd,0x0000,0x0000,0x35de,0x1182,0x0000,0x0000,
+    0x3c00,0x165f,0x0000,0x0000,0x3c00,0x165f,0x0000,0x0000,0x3c00,0x165f,0x0000,0x0000,0x3c00,0x1660,0x0000,0x0000,
+    0x3c00,0x1662,0x0000,0x0000,0x3c00,0x1668,0x0000,0x0000,0x3c00,0x1672,0x0000,0x0000,0x3c00,0x1682,0x0000,0x0000,
+    0x3c00,0x169c,0x0000,0x0000,0x3c00,0x16c3,0x0000,0x0000,0x3bff,0x16fa,0x0000,0x0000,0x3bff,0x1747,0x0000,0x0000,
+    0x3bff,0x17b0,0x0000,0x0000,0x3bfe,0x181e,0x0000,0x0000,0x3bfd,0x1873,0x0000,0x0000,0x3bf7,0x1874,0x0000,0x0000,
+    0x3bf2,0x188e,0x0000,0x0000,0x3bef,0x18d0,0x0000,0x0000,0x3beb,0x1922,0x0000,0x0000,0x3be7,0x1981,0x0000,0x0000,
+    0x3bdf,0x19a2,0x0000,0x0000,0x3bd8,0x19ef,0x0000,0x0000,0x3bd0,0x1a36,0x0000,0x0000,0x3bc5,0x1a6a,0x0000,0x0000,
+    0x3bb9,0x1aa1,0x0000,0x0000,0x3bac,0x1ad4,0x0000,0x0000,0x3b9c,0x1af9,0x0000,0x0000,0x3b8b,0x1b1e,0x0000,0x0000,
+    0x3b76,0x1b2d,0x0000,0x0000,0x3b61,0x1b43,0x0000,0x0000,0x3b46,0x1b3f,0x0000,0x0000,0x3b2b,0x1b42,0x0000,0x0000,
+    0x3b0d,0x1b2b,0x0000,0x0000,0x3aee,0x1b1d,0x0000,0x0000,0x3acf,0x1afe,0x0000,0x0000,0x3ab4,0x1ad4,0x0000,0x0000,
+    0x3a97,0x1aa7,0x0000,0x0000,0x3a7a,0x1a7b,0x0000,0x0000,0x3a5b,0x1a46,0x0000,0x0000,0x3a3a,0x1a0b,0x0000,0x0000,
+    0x3a19,0x19d1,0x0000,0x0000,0x39f6,0x1993,0x0000,0x0000,0x39d1,0x1957,0x0000,0x0000,0x39ad,0x1919,0x0000,0x0000,
+    0x3989,0x18d9,0x0000,0x0000,0x3964,0x189d,0x0000,0x0000,0x3940,0x1861,0x0000,0x0000,0x391d,0x1824,0x0000,0x0000,
+    0x38f9,0x17d7,0x0000,0x0000,0x38d4,0x176a,0x0000,0x0000,0x38af,0x16fb,0x0000,0x0000,0x388b,0x1697,0x0000,0x0000,
+    0x3867,0x1633,0x0000,0x0000,0x3844,0x15d6,0x0000,0x0000,0x3821,0x157d,0x0000,0x0000,0x37fb,0x1529,0x0000,0x0000,
+    0x37b5,0x14d7,0x0000,0x0000,0x3771,0x148e,0x0000,0x0000,0x372f,0x1443,0x0000,0x0000,0x36ec,0x1400,0x0000,0x0000,
+    0x36ab,0x1386,0x0000,0x0000,0x366c,0x1307,0x0000,0x0000,0x362e,0x129d,0x0000,0x0000,0x35f1,0x122f,0x0000,0x0000,
+    0x3c00,0x184b,0x0000,0x0000,0x3c00,0x184b,0x0000,0x0000,0x3c00,0x184b,0x0000,0x0000,0x3c00,0x184c,0x0000,0x0000,
+    0x3c00,0x184d,0x0000,0x0000,0x3c00,0x1851,0x0000,0x0000,0x3c00,0x1857,0x0000,0x0000,0x3c00,0x1861,0x0000,0x0000,
+    0x3c00,0x1871,0x0000,0x0000,0x3c00,0x1888,0x0000,0x0000,0x3bff,0x18aa,0x0000,0x0000,0x3bff,0x18d8,0x0000,0x0000,
+    0x3bff,0x1917,0x0000,0x0000,0x3bfe,0x1969,0x0000,0x0000,0x3bfc,0x19c5,0x0000,0x0000,0x3bf5,0x19b4,0x0000,0x0000,
+    0x3bf2,0x19ea,0x0000,0x0000,0x3bef,0x1a39,0x0000,0x0000,0x3beb,0x1a96,0x0000,0x0000,0x3be5,0x1ae9,0x0000,0x0000,
+    0x3bde,0x1b17,0x0000,0x0000,0x3bd7,0x1b73,0x0000,0x0000,0x3bcd,0x1ba7,0x0000,0x0000,0x3bc3,0x1bf4,0x0000,0x0000,
+    0x3bb7,0x1c11,0x0000,0x0000,0x3ba9,0x1c2e,0x0000,0x0000,0x3b99,0x1c3c,0x0000,0x0000,0x3b88,0x1c4e,0x0000,0x0000,
+    0x3b73,0x1c54,0x0000,0x0000,0x3b5d,0x1c5a,0x0000,0x0000,0x3b44,0x1c54,0x0000,0x0000,0x3b29,0x1c52,0x0000,0x0000,
+    0x3b0a,0x1c40,0x0000,0x0000,0x3aeb,0x1c30,0x0000,0x0000,0x3acb,0x1c1b,0x0000,0x0000,0x3aae,0x1c01,0x0000,0x0000,
+    0x3a92,0x1bc9,0x0000,0x0000,0x3a75,0x1b89,0x0000,0x0000,0x3a57,0x1b46,0x0000,0x0000,0x3a37,0x1afc,0x0000,0x0000,
+    0x3a16,0x1ab8,0x0000,0x0000,0x39f5,0x1a6e,0x0000,0x0000,0x39d1,0x1a20,0x0000,0x0000,0x39ad,0x19d6,0x0000,0x0000,
+    0x3989,0x198e,0x0000,0x0000,0x3965,0x1944,0x0000,0x0000,0x3941,0x18fc,0x0000,0x0000,0x391f,0x18b8,0x0000,0x0000,
+    0x38fc,0x1876,0x0000,0x0000,0x38d8,0x1833,0x0000,0x0000,0x38b4,0x17f0,0x0000,0x0000,0x3890,0x1774,0x0000,0x0000,
+    0x386d,0x1706,0x0000,0x0000,0x384a,0x1699,0x0000,0x0000,0x3827,0x1633,0x0000,0x0000,0x3805,0x15d2,0x0000,0x0000,
+    0x37c5,0x1578,0x0000,0x0000,0x3781,0x151e,0x0000,0x0000,0x373f,0x14ce,0x0000,0x0000,0x36ff,0x1483,0x0000,0x0000,
+    0x36be,0x1439,0x0000,0x0000,0x367f,0x13eb,0x0000,0x0000,0x3642,0x1370,0x0000,0x0000,0x3605,0x12f3,0x0000,0x0000,
+    0x3c00,0x19bc,0x0000,0x0000,0x3c00,0x19bc,0x0000,0x0000,0x3c00,0x19bd,0x0000,0x0000,0x3c00,0x19bd,0x0000,0x0000,
+    0x3c00,0x19bf,0x0000,0x0000,0x3c00,0x19c3,0x0000,0x0000,0x3c00,0x19cb,0x0000,0x0000,0x3c00,0x19d7,0x0000,0x0000,
+    0x3c00,0x19ea,0x0000,0x0000,0x3c00,0x1a07,0x0000,0x0000,0x3bff,0x1a2f,0x0000,0x0000,0x3bff,0x1a67,0x0000,0x0000,
+    0x3bfe,0x1ab1,0x0000,0x0000,0x3bfe,0x1b11,0x0000,0x0000,0x3bfb,0x1b65,0x0000,0x0000,0x3bf5,0x1b5a,0x0000,0x0000,
+    0x3bf1,0x1ba0,0x0000,0x0000,0x3bee,0x1c00,0x0000,0x0000,0x3bea,0x1c34,0x0000,0x0000,0x3be3,0x1c50,0x0000,0x0000,
+    0x3bdd,0x1c7b,0x0000,0x0000,0x3bd5,0x1ca9,0x0000,0x0000,0x3bcb,0x1cc2,0x0000,0x0000,0x3bc1,0x1cec,0x0000,0x0000,
+    0x3bb4,0x1cff,0x0000,0x0000,0x3ba6,0x1d1a,0x0000,0x0000,0x3b95,0x1d28,0x0000,0x0000,0x3b84,0x1d32,0x0000,0x0000,
+    0x3b70,0x1d38,0x0000,0x0000,0x3b5a,0x1d35,0x0000,0x0000,0x3b41,0x1d2d,0x0000,0x0000,0x3b26,0x1d1c,0x0000,0x0000,
+    0x3b08,0x1d08,0x0000,0x0000,0x3ae9,0x1cf1,0x0000,0x0000,0x3ac9,0x1cd2,0x0000,0x0000,0x3aa8,0x1cae,0x0000,0x0000,
+    0x3a8d,0x1c89,0x0000,0x0000,0x3a70,0x1c61,0x0000,0x0000,0x3a52,0x1c38,0x0000,0x0000,0x3a34,0x1c0b,0x0000,0x0000,
+    0x3a13,0x1bba,0x0000,0x0000,0x39f3,0x1b65,0x0000,0x0000,0x39d1,0x1b0a,0x0000,0x0000,0x39ad,0x1aaf,0x0000,0x0000,
+    0x398b,0x1a58,0x0000,0x0000,0x3967,0x1a03,0x0000,0x0000,0x3943,0x19b0,0x0000,0x0000,0x3920,0x195c,0x0000,0x0000,
+    0x38ff,0x1911,0x0000,0x0000,0x38dc,0x18c6,0x0000,0x0000,0x38b9,0x187c,0x0000,0x0000,0x3896,0x183b,0x0000,0x0000,
+    0x3873,0x17ed,0x0000,0x0000,0x3850,0x1779,0x0000,0x0000,0x382e,0x16fe,0x0000,0x0000,0x380d,0x1694,0x0000,0x0000,
+    0x37d6,0x162a,0x0000,0x0000,0x3793,0x15c6,0x0000,0x0000,0x3751,0x156e,0x0000,0x0000,0x3711,0x1512,0x0000,0x0000,
+    0x36d2,0x14c3,0x0000,0x0000,0x3693,0x1476,0x0000,0x0000,0x3656,0x142d,0x0000,0x0000,0x361a,0x13d4,0x0000,0x0000,
+    0x3c00,0x1b9a,0x0000,0x0000,0x3c00,0x1b9a,0x0000,0x0000,0x3c00,0x1b9a,0x0000,0x0000,0x3c00,0x1b9b,0x0000,0x0000,
+    0x3c00,0x1b9e,0x0000,0x0000,0x3c00,0x1ba3,0x0000,0x0000,0x3c00,0x1bac,0x0000,0x0000,0x3c00,0x1bbb,0x0000,0x0000,
+    0x3c00,0x1bd2,0x0000,0x0000,0x3bff,0x1bf4,0x0000,0x0000,0x3bff,0x1c12,0x0000,0x0000,0x3bff,0x1c33,0x0000,0x0000,
+    0x3bfe,0x1c5e,0x0000,0x0000,0x3bfd,0x1c95,0x0000,0x0000,0x3bf9,0x1caa,0x0000,0x0000,0x3bf4,0x1cb9,0x0000,0x0000,
+    0x3bf0,0x1ce1,0x0000,0x0000,0x3bee,0x1d1c,0x0000,0x0000,0x3be9,0x1d52,0x0000,0x0000,0x3be1,0x1d69,0x0000,0x0000,
+    0x3bdb,0x1d9f,0x0000,0x0000,0x3bd2,0x1dc8,0x0000,0x0000,0x3bc9,0x1de8,0x0000,0x0000,0x3bbe,0x1e09,0x0000,0x0000,
+    0x3bb1,0x1e24,0x0000,0x0000,0x3ba3,0x1e35,0x0000,0x0000,0x3b92,0x1e43,0x0000,0x0000,0x3b80,0x1e44,0x0000,0x0000,
+    0x3b6c,0x1e45,0x0000,0x0000,0x3b55,0x1e31,0x0000,0x0000,0x3b3e,0x1e2d,0x0000,0x0000,0x3b22,0x1e10,0x0000,0x0000,
+    0x3b05,0x1ded,0x0000,0x0000,0x3ae6,0x1dcd,0x0000,0x0000,0x3ac6,0x1da6,0x0000,0x0000,0x3aa5,0x1d77,0x0000,0x0000,
+    0x3a87,0x1d47,0x0000,0x0000,0x3a6b,0x1d16,0x0000,0x0000,0x3a4d,0x1cde,0x0000,0x0000,0x3a30,0x1cab,0x0000,0x0000,
+    0x3a11,0x1c74,0x0000,0x0000,0x39f1,0x1c3e,0x0000,0x0000,0x39d0,0x1c08,0x0000,0x0000,0x39ae,0x1ba7,0x0000,0x0000,
+    0x398c,0x1b3f,0x0000,0x0000,0x396a,0x1ad9,0x0000,0x0000,0x3947,0x1a79,0x0000,0x0000,0x3923,0x1a19,0x0000,0x0000,
+    0x3902,0x19bf,0x0000,0x0000,0x38e0,0x1969,0x0000,0x0000,0x38be,0x1917,0x0000,0x0000,0x389c,0x18c7,0x0000,0x0000,
+    0x387a,0x187f,0x0000,0x0000,0x3858,0x1835,0x0000,0x0000,0x3836,0x17ec,0x0000,0x0000,0x3814,0x1767,0x0000,0x0000,
+    0x37e8,0x16f5,0x0000,0x0000,0x37a6,0x1685,0x0000,0x0000,0x3765,0x161a,0x0000,0x0000,0x3725,0x15b7,0x0000,0x0000,
+    0x36e6,0x155d,0x0000,0x0000,0x36a9,0x1503,0x0000,0x0000,0x366c,0x14b4,0x0000,0x0000,0x3631,0x1468,0x0000,0x0000,
+    0x3c00,0x1d00,0x0000,0x0000,0x3c00,0x1d00,0x0000,0x0000,0x3c00,0x1d00,0x0000,0x0000,0x3c00,0x1d00,0x0000,0x0000,
+    0x3c00,0x1d02,0x0000,0x0000,0x3c00,0x1d05,0x0000,0x0000,0x3c00,0x1d0a,0x0000,0x0000,0x3c00,0x1d13,0x0000,0x0000,
+    0x3c00,0x1d21,0x0000,0x0000,0x3bff,0x1d35,0x0000,0x0000,0x3bff,0x1d52,0x0000,0x0000,0x3bff,0x1d78,0x0000,0x0000,
+    0x3bfe,0x1dab,0x0000,0x0000,0x3bfd,0x1de9,0x0000,0x0000,0x3bf7,0x1dec,0x0000,0x0000,0x3bf2,0x1e01,0x0000,0x0000,
+    0x3bef,0x1e35,0x0000,0x0000,0x3bed,0x1e7c,0x0000,0x0000,0x3be7,0x1ead,0x0000,0x0000,0x3bdf,0x1ec4,0x0000,0x0000,
+    0x3bd9,0x1f05,0x0000,0x0000,0x3bcf,0x1f20,0x0000,0x0000,0x3bc6,0x1f50,0x0000,0x0000,0x3bba,0x1f63,0x0000,0x0000,
+    0x3bad,0x1f7f,0x0000,0x0000,0x3b9f,0x1f89,0x0000,0x0000,0x3b8e,0x1f90,0x0000,0x0000,0x3b7c,0x1f8f,0x0000,0x0000,
+    0x3b68,0x1f83,0x0000,0x0000,0x3b51,0x1f68,0x0000,0x0000,0x3b3a,0x1f50,0x0000,0x0000,0x3b1f,0x1f2b,0x0000,0x0000,
+    0x3b02,0x1efe,0x0000,0x0000,0x3ae4,0x1ed1,0x0000,0x0000,0x3ac4,0x1e9a,0x0000,0x0000,0x3aa2,0x1e5e,0x0000,0x0000,
+    0x3a82,0x1e1f,0x0000,0x0000,0x3a66,0x1de5,0x0000,0x0000,0x3a49,0x1da1,0x0000,0x0000,0x3a2c,0x1d60,0x0000,0x0000,
+    0x3a0e,0x1d1e,0x0000,0x0000,0x39f0,0x1cde,0x0000,0x0000,0x39d0,0x1c9e,0x0000,0x0000,0x39af,0x1c5f,0x0000,0x0000,
+    0x398d,0x1c22,0x0000,0x0000,0x396c,0x1bcc,0x0000,0x0000,0x394a,0x1b5c,0x0000,0x0000,0x3927,0x1aee,0x0000,0x0000,
+    0x3905,0x1a84,0x0000,0x0000,0x38e5,0x1a23,0x0000,0x0000,0x38c4,0x19c1,0x0000,0x0000,0x38a3,0x1969,0x0000,0x0000,
+    0x3881,0x1912,0x0000,0x0000,0x3860,0x18c4,0x0000,0x0000,0x383f,0x1876,0x0000,0x0000,0x381d,0x182f,0x0000,0x0000,
+    0x37f9,0x17d7,0x0000,0x0000,0x37ba,0x1757,0x0000,0x0000,0x377a,0x16de,0x0000,0x0000,0x373b,0x1674,0x0000,0x0000,
+    0x36fc,0x1607,0x0000,0x0000,0x36c0,0x15a7,0x0000,0x0000,0x3684,0x154b,0x0000,0x0000,0x3649,0x14f5,0x0000,0x0000,
+    0x3c00,0x1e87,0x0000,0x0000,0x3c00,0x1e87,0x0000,0x0000,0x3c00,0x1e87,0x0000,0x0000,0x3c00,0x1e88,0x0000,0x0000,
+    0x3c00,0x1e89,0x0000,0x0000,0x3c00,0x1e8d,0x0000,0x0000,0x3c00,0x1e93,0x0000,0x0000,0x3c00,0x1e9e,0x0000,0x0000,
+    0x3c00,0x1eae,0x0000,0x0000,0x3bff,0x1ec6,0x0000,0x0000,0x3bff,0x1ee7,0x0000,0x0000,0x3bff,0x1f14,0x0000,0x0000,
+    0x3bfe,0x1f4f,0x0000,0x0000,0x3bfc,0x1f90,0x0000,0x0000,0x3bf5,0x1f85,0x0000,0x0000,0x3bf2,0x1fae,0x0000,0x0000,
+    0x3bef,0x1fe9,0x0000,0x0000,0x3beb,0x2015,0x0000,0x0000,0x3be5,0x202a,0x0000,0x0000,0x3bde,0x2040,0x0000,0x0000,
+    0x3bd7,0x205f,0x0000,0x0000,0x3bcd,0x2069,0x0000,0x0000,0x3bc3,0x2080,0x0000,0x0000,0x3bb7,0x208a,0x0000,0x0000,
+    0x3ba9,0x208f,0x0000,0x0000,0x3b9b,0x2093,0x0000,0x0000,0x3b8a,0x208f,0x0000,0x0000,0x3b78,0x208a,0x0000,0x0000,
+    0x3b63,0x2078,0x0000,0x0000,0x3b4d,0x206b,0x0000,0x0000,0x3b35,0x2057,0x0000,0x0000,0x3b1b,0x203a,0x0000,0x0000,
+    0x3afe,0x201b,0x0000,0x0000,0x3ae1,0x1ffa,0x0000,0x0000,0x3ac1,0x1fb5,0x0000,0x0000,0x3aa1,0x1f6a,0x0000,0x0000,
+    0x3a80,0x1f1b,0x0000,0x0000,0x3a61,0x1ecf,0x0000,0x0000,0x3a45,0x1e80,0x0000,0x0000,0x3a28,0x1e30,0x0000,0x0000,
+    0x3a0b,0x1de0,0x0000,0x0000,0x39ee,0x1d93,0x0000,0x0000,0x39cf,0x1d47,0x0000,0x0000,0x39b0,0x1cfd,0x0000,0x0000,
+    0x398f,0x1cb5,0x0000,0x0000,0x396e,0x1c70,0x0000,0x0000,0x394e,0x1c2d,0x0000,0x0000,0x392c,0x1bdf,0x0000,0x0000,
+    0x390a,0x1b64,0x0000,0x0000,0x38e9,0x1af1,0x0000,0x0000,0x38c9,0x1a86,0x0000,0x0000,0x38a9,0x1a1c,0x0000,0x0000,
+    0x3889,0x19bc,0x0000,0x0000,0x3868,0x195f,0x0000,0x0000,0x3848,0x1909,0x0000,0x0000,0x3827,0x18b9,0x0000,0x0000,
+    0x3806,0x186a,0x0000,0x0000,0x37ce,0x1823,0x0000,0x0000,0x3790,0x17c2,0x0000,0x0000,0x3752,0x1741,0x0000,0x0000,
+    0x3715,0x16cb,0x0000,0x0000,0x36d8,0x165e,0x0000,0x0000,0x369c,0x15f3,0x0000,0x0000,0x3663,0x1597,0x0000,0x0000,
+    0x3c00,0x203b,0x0000,0x0000,0x3c00,0x203b,0x0000,0x0000,0x3c00,0x203b,0x0000,0x0000,0x3c00,0x203c,0x0000,0x0000,
+    0x3c00,0x203d,0x0000,0x0000,0x3c00,0x203f,0x0000,0x0000,0x3c00,0x2043,0x0000,0x0000,0x3c00,0x2049,0x0000,0x0000,
+    0x3c00,0x2052,0x0000,0x0000,0x3bff,0x2060,0x0000,0x0000,0x3bff,0x2073,0x0000,0x0000,0x3bfe,0x208d,0x0000,0x0000,
+    0x3bfe,0x20af,0x0000,0x0000,0x3bfb,0x20cb,0x0000,0x0000,0x3bf5,0x20c7,0x0000,0x0000,0x3bf1,0x20e1,0x0000,0x0000,
+    0x3bee,0x2103,0x0000,0x0000,0x3bea,0x2122,0x0000,0x0000,0x3be3,0x2135,0x0000,0x0000,0x3bdc,0x214e,0x0000,0x0000,
+    0x3bd4,0x2164,0x0000,0x0000,0x3bca,0x2171,0x0000,0x0000,0x3bbf,0x217e,0x0000,0x0000,0x3bb4,0x218b,0x0000,0x0000,
+    0x3ba5,0x2189,0x0000,0x0000,0x3b96,0x2186,0x0000,0x0000,0x3b85,0x217d,0x0000,0x0000,0x3b72,0x2171,0x0000,0x0000,
+    0x3b5d,0x2154,0x0000,0x0000,0x3b48,0x213d,0x0000,0x0000,0x3b30,0x211f,0x0000,0x0000,0x3b17,0x20fa,0x0000,0x0000,
+    0x3afa,0x20d1,0x0000,0x0000,0x3ade,0x20aa,0x0000,0x0000,0x3abf,0x207d,0x0000,0x0000,0x3a9f,0x204d,0x0000,0x0000,
+    0x3a7e,0x201d,0x0000,0x0000,0x3a5e,0x1fdc,0x0000,0x0000,0x3a40,0x1f7c,0x0000,0x0000,0x3a24,0x1f1b,0x0000,0x0000,
+    0x3a08,0x1ebc,0x0000,0x0000,0x39ec,0x1e60,0x0000,0x0000,0x39cf,0x1e06,0x0000,0x0000,0x39b0,0x1db0,0x0000,0x0000,
+    0x3991,0x1d5b,0x0000,0x0000,0x3972,0x1d0b,0x0000,0x0000,0x3952,0x1cbf,0x0000,0x0000,0x3932,0x1c75,0x0000,0x0000,
+    0x3910,0x1c30,0x0000,0x0000,0x38f0,0x1bde,0x0000,0x0000,0x38cf,0x1b5d,0x0000,0x0000,0x38b0,0x1aea,0x0000,0x0000,
+    0x3891,0x1a79,0x0000,0x0000,0x3871,0x1a10,0x0000,0x0000,0x3851,0x19af,0x0000,0x0000,0x3831,0x1951,0x0000,0x0000,
+    0x3812,0x18fb,0x0000,0x0000,0x37e4,0x18ab,0x0000,0x0000,0x37a6,0x185d,0x0000,0x0000,0x376a,0x1816,0x0000,0x0000,
+    0x372e,0x17a8,0x0000,0x0000,0x36f2,0x1728,0x0000,0x0000,0x36b7,0x16b6,0x0000,0x0000,0x367d,0x1648,0x0000,0x0000,
+    0x3c00,0x2173,0x0000,0x0000,0x3c00,0x2173,0x0000,0x0000,0x3c00,0x2174,0x0000,0x0000,0x3c00,0x2174,0x0000,0x0000,
+    0x3c00,0x2175,0x0000,0x0000,0x3c00,0x2177,0x0000,0x0000,0x3c00,0x217c,0x0000,0x0000,0x3c00,0x2183,0x0000,0x0000,
+    0x3c00,0x218e,0x0000,0x0000,0x3bff,0x219e,0x0000,0x0000,0x3bff,0x21b4,0x0000,0x0000,0x3bfe,0x21d2,0x0000,0x0000,
+    0x3bfd,0x21f7,0x0000,0x0000,0x3bf8,0x2201,0x0000,0x0000,0x3bf4,0x220b,0x0000,0x0000,0x3bf1,0x2228,0x0000,0x0000,
+    0x3bee,0x2250,0x0000,0x0000,0x3be7,0x2266,0x0000,0x0000,0x3be1,0x227b,0x0000,0x0000,0x3bda,0x2295,0x0000,0x0000,
+    0x3bd1,0x22a4,0x0000,0x0000,0x3bc7,0x22b4,0x0000,0x0000,0x3bbc,0x22b7,0x0000,0x0000,0x3baf,0x22bd,0x0000,0x0000,
+    0x3ba0,0x22b6,0x0000,0x0000,0x3b91,0x22a7,0x0000,0x0000,0x3b80,0x2298,0x0000,0x0000,0x3b6c,0x227a,0x0000,0x0000,
+    0x3b58,0x2258,0x0000,0x0000,0x3b43,0x2236,0x0000,0x0000,0x3b2b,0x220b,0x0000,0x0000,0x3b11,0x21d8,0x0000,0x0000,
+    0x3af6,0x21a3,0x0000,0x0000,0x3ada,0x216e,0x0000,0x0000,0x3abd,0x2138,0x0000,0x0000,0x3a9d,0x20fc,0x0000,0x0000,
+    0x3a7d,0x20c1,0x0000,0x0000,0x3a5c,0x2086,0x0000,0x0000,0x3a3e,0x204d,0x0000,0x0000,0x3a20,0x2014,0x0000,0x0000,
+    0x3a05,0x1fb5,0x0000,0x0000,0x39ea,0x1f49,0x0000,0x0000,0x39ce,0x1edd,0x0000,0x0000,0x39b1,0x1e7a,0x0000,0x0000,
+    0x3993,0x1e18,0x0000,0x0000,0x3975,0x1dba,0x0000,0x0000,0x3956,0x1d61,0x0000,0x0000,0x3937,0x1d0e,0x0000,0x0000,
+    0x3917,0x1cbd,0x0000,0x0000,0x38f7,0x1c72,0x0000,0x0000,0x38d7,0x1c2b,0x0000,0x0000,0x38b7,0x1bcd,0x0000,0x0000,
+    0x3899,0x1b50,0x0000,0x0000,0x387a,0x1ada,0x0000,0x0000,0x385b,0x1a66,0x0000,0x0000,0x383d,0x1a01,0x0000,0x0000,
+    0x381d,0x199e,0x0000,0x0000,0x37fd,0x1942,0x0000,0x0000,0x37bf,0x18ea,0x0000,0x0000,0x3782,0x189c,0x0000,0x0000,
+    0x3748,0x184e,0x0000,0x0000,0x370e,0x180a,0x0000,0x0000,0x36d3,0x178d,0x0000,0x0000,0x369a,0x1711,0x0000,0x0000,
+    0x3c00,0x22fa,0x0000,0x0000,0x3c00,0x22fa,0x0000,0x0000,0x3c00,0x22fa,0x0000,0x0000,0x3c00,0x22fb,0x0000,0x0000,
+    0x3c00,0x22fc,0x0000,0x0000,0x3c00,0x22ff,0x0000,0x0000,0x3c00,0x2304,0x0000,0x0000,0x3c00,0x230c,0x0000,0x0000,
+    0x3bff,0x2319,0x0000,0x0000,0x3bff,0x232b,0x0000,0x0000,0x3bff,0x2344,0x0000,0x0000,0x3bfe,0x2365,0x0000,0x0000,
+    0x3bfd,0x238d,0x0000,0x0000,0x3bf7,0x238b,0x0000,0x0000,0x3bf2,0x2398,0x0000,0x0000,0x3bef,0x23b9,0x0000,0x0000,
+    0x3bec,0x23e7,0x0000,0x0000,0x3be5,0x23f0,0x0000,0x0000,0x3bdf,0x2407,0x0000,0x0000,0x3bd7,0x2410,0x0000,0x0000,
+    0x3bce,0x2416,0x0000,0x0000,0x3bc3,0x2417,0x0000,0x0000,0x3bb8,0x2419,0x0000,0x0000,0x3bab,0x2415,0x0000,0x0000,
+    0x3b9b,0x240b,0x0000,0x0000,0x3b8b,0x23fb,0x0000,0x0000,0x3b7b,0x23e6,0x0000,0x0000,0x3b66,0x23b8,0x0000,0x0000,
+    0x3b52,0x2384,0x0000,0x0000,0x3b3d,0x2354,0x0000,0x0000,0x3b25,0x231a,0x0000,0x0000,0x3b0c,0x22d9,0x0000,0x0000,
+    0x3af2,0x2296,0x0000,0x0000,0x3ad6,0x2251,0x0000,0x0000,0x3aba,0x220c,0x0000,0x0000,0x3a9b,0x21c3,0x0000,0x0000,
+    0x3a7b,0x217c,0x0000,0x0000,0x3a5c,0x2134,0x0000,0x0000,0x3a3d,0x20f0,0x0000,0x0000,0x3a1e,0x20ab,0x0000,0x0000,
+    0x3a02,0x2067,0x0000,0x0000,0x39e8,0x2028,0x0000,0x0000,0x39cd,0x1fd4,0x0000,0x0000,0x39b2,0x1f5d,0x0000,0x0000,
+    0x3996,0x1eec,0x0000,0x0000,0x3979,0x1e81,0x0000,0x0000,0x395b,0x1e19,0x0000,0x0000,0x393d,0x1db9,0x0000,0x0000,
+    0x391e,0x1d5d,0x0000,0x0000,0x3900,0x1d07,0x0000,0x0000,0x38e0,0x1cb4,0x0000,0x0000,0x38c0,0x1c68,0x0000,0x0000,
+    0x38a2,0x1c20,0x0000,0x0000,0x3884,0x1bb9,0x0000,0x0000,0x3866,0x1b3c,0x0000,0x0000,0x3848,0x1ac3,0x0000,0x0000,
+    0x382a,0x1a54,0x0000,0x0000,0x380c,0x19ed,0x0000,0x0000,0x37db,0x198c,0x0000,0x0000,0x379f,0x1931,0x0000,0x0000,
+    0x3763,0x18db,0x0000,0x0000,0x372a,0x188c,0x0000,0x0000,0x36f2,0x1840,0x0000,0x0000,0x36b9,0x17fc,0x0000,0x0000,
+    0x3c00,0x2470,0x0000,0x0000,0x3c00,0x2471,0x0000,0x0000,0x3c00,0x2471,0x0000,0x0000,0x3c00,0x2471,0x0000,0x0000,
+    0x3c00,0x2472,0x0000,0x0000,0x3c00,0x2473,0x0000,0x0000,0x3c00,0x2476,0x0000,0x0000,0x3c00,0x247b,0x0000,0x0000,
+    0x3bff,0x2482,0x0000,0x0000,0x3bff,0x248c,0x0000,0x0000,0x3bfe,0x249a,0x0000,0x0000,0x3bfe,0x24ad,0x0000,0x0000,
+    0x3bfc,0x24c0,0x0000,0x0000,0x3bf5,0x24b8,0x0000,0x0000,0x3bf2,0x24c5,0x0000,0x0000,0x3bef,0x24d7,0x0000,0x0000,
+    0x3bea,0x24e8,0x0000,0x0000,0x3be3,0x24ee,0x0000,0x0000,0x3bdc,0x24f8,0x0000,0x0000,0x3bd4,0x24fd,0x0000,0x0000,
+    0x3bcb,0x2504,0x0000,0x0000,0x3bbf,0x24fc,0x0000,0x0000,0x3bb3,0x24f9,0x0000,0x0000,0x3ba6,0x24f1,0x0000,0x0000,
+    0x3b95,0x24dc,0x0000,0x0000,0x3b85,0x24ca,0x0000,0x0000,0x3b74,0x24b2,0x0000,0x0000,0x3b60,0x2494,0x0000,0x0000,
+    0x3b4b,0x2472,0x0000,0x0000,0x3b36,0x2450,0x0000,0x0000,0x3b1f,0x242a,0x0000,0x0000,0x3b06,0x23ff,0x0000,0x0000,
+    0x3aec,0x23a8,0x0000,0x0000,0x3ad3,0x2356,0x0000,0x0000,0x3ab6,0x22ff,0x0000,0x0000,0x3a99,0x22a7,0x0000,0x0000,
+    0x3a7b,0x224f,0x0000,0x0000,0x3a5c,0x21f8,0x0000,0x0000,0x3a3d,0x21a6,0x0000,0x0000,0x3a1f,0x2156,0x0000,0x0000,
+    0x3a01,0x2107,0x0000,0x0000,0x39e6,0x20bc,0x0000,0x0000,0x39cc,0x2073,0x0000,0x0000,0x39b3,0x202e,0x0000,0x0000,
+    0x3998,0x1fdb,0x0000,0x0000,0x397c,0x1f5f,0x0000,0x0000,0x3960,0x1ee7,0x0000,0x0000,0x3943,0x1e79,0x0000,0x0000,
+    0x3926,0x1e11,0x0000,0x0000,0x3908,0x1dac,0x0000,0x0000,0x38ea,0x1d51,0x0000,0x0000,0x38cb,0x1cfa,0x0000,0x0000,
+    0x38ac,0x1ca7,0x0000,0x0000,0x388e,0x1c5c,0x0000,0x0000,0x3871,0x1c13,0x0000,0x0000,0x3854,0x1ba0,0x0000,0x0000,
+    0x3836,0x1b24,0x0000,0x0000,0x3819,0x1aae,0x0000,0x0000,0x37f8,0x1a40,0x0000,0x0000,0x37bd,0x19d9,0x0000,0x0000,
+    0x3783,0x197a,0x0000,0x0000,0x3748,0x191e,0x0000,0x0000,0x3710,0x18cf,0x0000,0x0000,0x36da,0x1881,0x0000,0x0000,
+    0x3c00,0x259e,0x0000,0x0000,0x3c00,0x259e,0x0000,0x0000,0x3c00,0x259e,0x0000,0x0000,0x3c00,0x259e,0x0000,0x0000,
+    0x3c00,0x259f,0x0000,0x0000,0x3c00,0x25a1,0x0000,0x0000,0x3c00,0x25a4,0x0000,0x0000,0x3c00,0x25a9,0x0000,0x0000,
+    0x3bff,0x25b1,0x0000,0x0000,0x3bff,0x25bd,0x0000,0x0000,0x3bfe,0x25cc,0x0000,0x0000,0x3bfd,0x25e0,0x0000,0x0000,
+    0x3bfa,0x25eb,0x0000,0x0000,0x3bf4,0x25e8,0x0000,0x0000,0x3bf1,0x25f6,0x0000,0x0000,0x3bee,0x2609,0x0000,0x0000,
+    0x3be7,0x260c,0x0000,0x0000,0x3be1,0x2618,0x0000,0x0000,0x3bd9,0x261b,0x0000,0x0000,0x3bd1,0x261c,0x0000,0x0000,
+    0x3bc7,0x261c,0x0000,0x0000,0x3bba,0x260f,0x0000,0x0000,0x3bae,0x2602,0x0000,0x0000,0x3ba0,0x25f2,0x0000,0x0000,
+    0x3b8e,0x25cf,0x0000,0x0000,0x3b7f,0x25b9,0x0000,0x0000,0x3b6d,0x2596,0x0000,0x0000,0x3b59,0x256a,0x0000,0x0000,
+    0x3b44,0x253d,0x0000,0x0000,0x3b2f,0x250f,0x0000,0x0000,0x3b19,0x24dd,0x0000,0x0000,0x3b00,0x24a9,0x0000,0x0000,
+    0x3ae7,0x2472,0x0000,0x0000,0x3ace,0x243e,0x0000,0x0000,0x3ab3,0x2408,0x0000,0x0000,0x3a97,0x23a7,0x0000,0x0000,
+    0x3a7a,0x233e,0x0000,0x0000,0x3a5c,0x22d6,0x0000,0x0000,0x3a3f,0x2276,0x0000,0x0000,0x3a21,0x2217,0x0000,0x0000,
+    0x3a03,0x21ba,0x0000,0x0000,0x39e6,0x2162,0x0000,0x0000,0x39cc,0x210e,0x0000,0x0000,0x39b3,0x20be,0x0000,0x0000,
+    0x399a,0x2073,0x0000,0x0000,0x3980,0x202c,0x0000,0x0000,0x3965,0x1fd0,0x0000,0x0000,0x394a,0x1f51,0x0000,0x0000,
+    0x392e,0x1ed8,0x0000,0x0000,0x3911,0x1e6b,0x0000,0x0000,0x38f4,0x1dff,0x0000,0x0000,0x38d7,0x1d9d,0x0000,0x0000,
+    0x38b9,0x1d42,0x0000,0x0000,0x389b,0x1ce8,0x0000,0x0000,0x387d,0x1c99,0x0000,0x0000,0x3860,0x1c4e,0x0000,0x0000,
+    0x3844,0x1c06,0x0000,0x0000,0x3827,0x1b86,0x0000,0x0000,0x380b,0x1b0c,0x0000,0x0000,0x37dd,0x1a98,0x0000,0x0000,
+    0x37a3,0x1a2c,0x0000,0x0000,0x376b,0x19ca,0x0000,0x0000,0x3732,0x196d,0x0000,0x0000,0x36fa,0x190f,0x0000,0x0000,
+    0x3c00,0x2712,0x0000,0x0000,0x3c00,0x2712,0x0000,0x0000,0x3c00,0x2712,0x0000,0x0000,0x3c00,0x2712,0x0000,0x0000,
+    0x3c00,0x2713,0x0000,0x0000,0x3c00,0x2715,0x0000,0x0000,0x3c00,0x2719,0x0000,0x0000,0x3c00,0x271e,0x0000,0x0000,
+    0x3bff,0x2727,0x0000,0x0000,0x3bff,0x2733,0x0000,0x0000,0x3bfe,0x2744,0x0000,0x0000,0x3bfd,0x2759,0x0000,0x0000,
+    0x3bf7,0x2754,0x0000,0x0000,0x3bf3,0x2757,0x0000,0x0000,0x3bf0,0x2766,0x0000,0x0000,0x3bed,0x277b,0x0000,0x0000,
+    0x3be5,0x2775,0x0000,0x0000,0x3bdf,0x2781,0x0000,0x0000,0x3bd6,0x2779,0x0000,0x0000,0x3bcd,0x2777,0x0000,0x0000,
+    0x3bc2,0x276a,0x0000,0x0000,0x3bb5,0x2754,0x0000,0x0000,0x3ba9,0x2740,0x0000,0x0000,0x3b9a,0x2721,0x0000,0x0000,
+    0x3b88,0x26f5,0x0000,0x0000,0x3b77,0x26cb,0x0000,0x0000,0x3b65,0x2699,0x0000,0x0000,0x3b51,0x2661,0x0000,0x0000,
+    0x3b3c,0x2626,0x0000,0x0000,0x3b28,0x25eb,0x0000,0x0000,0x3b12,0x25ac,0x0000,0x0000,0x3afa,0x2569,0x0000,0x0000,
+    0x3ae1,0x2526,0x0000,0x0000,0x3ac9,0x24e5,0x0000,0x0000,0x3ab0,0x24a4,0x0000,0x0000,0x3a95,0x2465,0x0000,0x0000,
+    0x3a79,0x2427,0x0000,0x0000,0x3a5d,0x23d0,0x0000,0x0000,0x3a40,0x235e,0x0000,0x0000,0x3a24,0x22ee,0x0000,0x0000,
+    0x3a06,0x2284,0x0000,0x0000,0x39ea,0x221e,0x0000,0x0000,0x39ce,0x21bd,0x0000,0x0000,0x39b4,0x215f,0x0000,0x0000,
+    0x399d,0x210a,0x0000,0x0000,0x3985,0x20b8,0x0000,0x0000,0x396b,0x206a,0x0000,0x0000,0x3950,0x2022,0x0000,0x0000,
+    0x3936,0x1fbe,0x0000,0x0000,0x391b,0x1f3a,0x0000,0x0000,0x38ff,0x1ec5,0x0000,0x0000,0x38e3,0x1e55,0x0000,0x0000,
+    0x38c6,0x1deb,0x0000,0x0000,0x38a9,0x1d8a,0x0000,0x0000,0x388b,0x1d2f,0x0000,0x0000,0x386f,0x1cd9,0x0000,0x0000,
+    0x3852,0x1c89,0x0000,0x0000,0x3836,0x1c3e,0x0000,0x0000,0x381b,0x1bf3,0x0000,0x0000,0x37fe,0x1b6f,0x0000,0x0000,
+    0x37c7,0x1afb,0x0000,0x0000,0x378f,0x1a86,0x0000,0x0000,0x3757,0x1a18,0x0000,0x0000,0x3720,0x19b9,0x0000,0x0000,
+    0x3c00,0x286d,0x0000,0x0000,0x3c00,0x286d,0x0000,0x0000,0x3c00,0x286d,0x0000,0x0000,0x3c00,0x286d,0x0000,0x0000,
+    0x3c00,0x286e,0x0000,0x0000,0x3c00,0x286f,0x0000,0x0000,0x3c00,0x2871,0x0000,0x0000,0x3c00,0x2874,0x0000,0x0000,
+    0x3bff,0x2878,0x0000,0x0000,0x3bff,0x287f,0x0000,0x0000,0x3bfe,0x2888,0x0000,0x0000,0x3bfc,0x2892,0x0000,0x0000,
+    0x3bf6,0x288a,0x0000,0x0000,0x3bf2,0x288d,0x0000,0x0000,0x3bef,0x2894,0x0000,0x0000,0x3bea,0x2899,0x0000,0x0000,
+    0x3be3,0x2895,0x0000,0x0000,0x3bdc,0x2896,0x0000,0x0000,0x3bd3,0x288f,0x0000,0x0000,0x3bc9,0x2889,0x0000,0x0000,
+    0x3bbd,0x287c,0x0000,0x0000,0x3bb0,0x286a,0x0000,0x0000,0x3ba3,0x285a,0x0000,0x0000,0x3b92,0x283e,0x0000,0x0000,
+    0x3b81,0x2824,0x0000,0x0000,0x3b6f,0x2806,0x0000,0x0000,0x3b5d,0x27c9,0x0000,0x0000,0x3b49,0x277f,0x0000,0x0000,
+    0x3b34,0x2734,0x0000,0x0000,0x3b1f,0x26e4,0x0000,0x0000,0x3b0a,0x2696,0x0000,0x0000,0x3af4,0x2643,0x0000,0x0000,
+    0x3adc,0x25f2,0x0000,0x0000,0x3ac4,0x25a3,0x0000,0x0000,0x3aad,0x2555,0x0000,0x0000,0x3a94,0x2509,0x0000,0x0000,
+    0x3a79,0x24be,0x0000,0x0000,0x3a5e,0x2475,0x0000,0x0000,0x3a43,0x2431,0x0000,0x0000,0x3a27,0x23e1,0x0000,0x0000,
+    0x3a0b,0x2366,0x0000,0x0000,0x39ef,0x22ee,0x0000,0x0000,0x39d3,0x2280,0x0000,0x0000,0x39b8,0x2215,0x0000,0x0000,
+    0x399f,0x21b1,0x0000,0x0000,0x3989,0x2155,0x0000,0x0000,0x3971,0x20fd,0x0000,0x0000,0x3958,0x20ab,0x0000,0x0000,
+    0x393e,0x205c,0x0000,0x0000,0x3925,0x2015,0x0000,0x0000,0x390a,0x1fa1,0x0000,0x0000,0x38ef,0x1f23,0x0000,0x0000,
+    0x38d4,0x1eae,0x0000,0x0000,0x38b8,0x1e40,0x0000,0x0000,0x389c,0x1dd8,0x0000,0x0000,0x387e,0x1d76,0x0000,0x0000,
+    0x3863,0x1d1f,0x0000,0x0000,0x3847,0x1cca,0x0000,0x0000,0x382b,0x1c7c,0x0000,0x0000,0x3810,0x1c34,0x0000,0x0000,
+    0x37ea,0x1bdb,0x0000,0x0000,0x37b5,0x1b59,0x0000,0x0000,0x377f,0x1ae8,0x0000,0x0000,0x3749,0x1a7a,0x0000,0x0000,
+    0x3c00,0x2983,0x0000,0x0000,0x3c00,0x2983,0x0000,0x0000,0x3c00,0x2983,0x0000,0x0000,0x3c00,0x2984,0x0000,0x0000,
+    0x3c00,0x2984,0x0000,0x0000,0x3c00,0x2985,0x0000,0x0000,0x3c00,0x2987,0x0000,0x0000,0x3bff,0x298b,0x0000,0x0000,
+    0x3bff,0x298f,0x0000,0x0000,0x3bfe,0x2996,0x0000,0x0000,0x3bfe,0x299f,0x0000,0x0000,0x3bfb,0x29a5,0x0000,0x0000,
+    0x3bf5,0x299c,0x0000,0x0000,0x3bf1,0x29a0,0x0000,0x0000,0x3bee,0x29a5,0x0000,0x0000,0x3be6,0x299d,0x0000,0x0000,
+    0x3be1,0x299e,0x0000,0x0000,0x3bd8,0x2994,0x0000,0x0000,0x3bcf,0x2989,0x0000,0x0000,0x3bc4,0x297b,0x0000,0x0000,
+    0x3bb7,0x2965,0x0000,0x0000,0x3ba9,0x294d,0x0000,0x0000,0x3b9b,0x2932,0x0000,0x0000,0x3b8a,0x290e,0x0000,0x0000,
+    0x3b79,0x28e9,0x0000,0x0000,0x3b66,0x28be,0x0000,0x0000,0x3b54,0x2892,0x0000,0x0000,0x3b40,0x2862,0x0000,0x0000,
+    0x3b2c,0x2833,0x0000,0x0000,0x3b17,0x2801,0x0000,0x0000,0x3b02,0x27a0,0x0000,0x0000,0x3aed,0x273a,0x0000,0x0000,
+    0x3ad7,0x26d9,0x0000,0x0000,0x3ac0,0x2677,0x0000,0x0000,0x3aa9,0x2619,0x0000,0x0000,0x3a92,0x25c0,0x0000,0x0000,
+    0x3a79,0x2569,0x0000,0x0000,0x3a5f,0x2514,0x0000,0x0000,0x3a46,0x24c4,0x0000,0x0000,0x3a2c,0x2478,0x0000,0x0000,
+    0x3a11,0x2432,0x0000,0x0000,0x39f6,0x23d9,0x0000,0x0000,0x39db,0x235b,0x0000,0x0000,0x39c0,0x22e1,0x0000,0x0000,
+    0x39a5,0x226e,0x0000,0x0000,0x398d,0x2204,0x0000,0x0000,0x3977,0x21a2,0x0000,0x0000,0x3960,0x2143,0x0000,0x0000,
+    0x3948,0x20ed,0x0000,0x0000,0x392f,0x2099,0x0000,0x0000,0x3916,0x204e,0x0000,0x0000,0x38fc,0x2007,0x0000,0x0000,
+    0x38e2,0x1f87,0x0000,0x0000,0x38c7,0x1f0b,0x0000,0x0000,0x38ac,0x1e97,0x0000,0x0000,0x3891,0x1e2b,0x0000,0x0000,
+    0x3875,0x1dc4,0x0000,0x0000,0x3859,0x1d69,0x0000,0x0000,0x383e,0x1d0f,0x0000,0x0000,0x3823,0x1cbc,0x0000,0x0000,
+    0x3808,0x1c6f,0x0000,0x0000,0x37dc,0x1c2b,0x0000,0x0000,0x37a8,0x1bd0,0x0000,0x0000,0x3774,0x1b55,0x0000,0x0000,
+    0x3c00,0x2ad6,0x0000,0x0000,0x3c00,0x2ad6,0x0000,0x0000,0x3c00,0x2ad6,0x0000,0x0000,0x3c00,0x2ad6,0x0000,0x0000,
+    0x3c00,0x2ad7,0x0000,0x0000,0x3c00,0x2ad8,0x0000,0x0000,0x3c00,0x2ada,0x0000,0x0000,0x3bff,0x2add,0x0000,0x0000,
+    0x3bff,0x2ae2,0x0000,0x0000,0x3bfe,0x2ae9,0x0000,0x0000,0x3bfd,0x2af2,0x0000,0x0000,0x3bf8,0x2aeb,0x0000,0x0000,
+    0x3bf3,0x2ae6,0x0000,0x0000,0x3bf0,0x2ae8,0x0000,0x0000,0x3bec,0x2aeb,0x0000,0x0000,0x3be4,0x2add,0x0000,0x0000,
+    0x3bde,0x2ad7,0x0000,0x0000,0x3bd4,0x2ac4,0x0000,0x0000,0x3bca,0x2ab3,0x0000,0x0000,0x3bbf,0x2a9b,0x0000,0x0000,
+    0x3bb0,0x2a78,0x0000,0x0000,0x3ba2,0x2a57,0x0000,0x0000,0x3b92,0x2a2a,0x0000,0x0000,0x3b82,0x29fc,0x0000,0x0000,
+    0x3b70,0x29ca,0x0000,0x0000,0x3b5c,0x2992,0x0000,0x0000,0x3b4a,0x2958,0x0000,0x0000,0x3b36,0x291d,0x0000,0x0000,
+    0x3b23,0x28e0,0x0000,0x0000,0x3b0e,0x28a3,0x0000,0x0000,0x3afa,0x2865,0x0000,0x0000,0x3ae6,0x2828,0x0000,0x0000,
+    0x3ad1,0x27da,0x0000,0x0000,0x3abc,0x2767,0x0000,0x0000,0x3aa5,0x26f7,0x0000,0x0000,0x3a90,0x268e,0x0000,0x0000,
+    0x3a7a,0x2627,0x0000,0x0000,0x3a62,0x25c5,0x0000,0x0000,0x3a49,0x2568,0x0000,0x0000,0x3a31,0x2511,0x0000,0x0000,
+    0x3a18,0x24be,0x0000,0x0000,0x39fe,0x2470,0x0000,0x0000,0x39e4,0x2428,0x0000,0x0000,0x39ca,0x23c5,0x0000,0x0000,
+    0x39af,0x2342,0x0000,0x0000,0x3996,0x22ca,0x0000,0x0000,0x397d,0x2258,0x0000,0x0000,0x3968,0x21f0,0x0000,0x0000,
+    0x3952,0x218c,0x0000,0x0000,0x393a,0x2130,0x0000,0x0000,0x3922,0x20da,0x0000,0x0000,0x390a,0x2089,0x0000,0x0000,
+    0x38f1,0x203e,0x0000,0x0000,0x38d8,0x1ff0,0x0000,0x0000,0x38be,0x1f6f,0x0000,0x0000,0x38a3,0x1ef6,0x0000,0x0000,
+    0x3889,0x1e84,0x0000,0x0000,0x386e,0x1e18,0x0000,0x0000,0x3852,0x1db4,0x0000,0x0000,0x3838,0x1d5b,0x0000,0x0000,
+    0x381d,0x1d06,0x0000,0x0000,0x3803,0x1cb7,0x0000,0x0000,0x37d3,0x1c6a,0x0000,0x0000,0x37a0,0x1c25,0x0000,0x0000,
+    0x3c00,0x2c38,0x0000,0x0000,0x3c00,0x2c38,0x0000,0x0000,0x3c00,0x2c38,0x0000,0x0000,0x3c00,0x2c38,0x0000,0x0000,
+    0x3c00,0x2c38,0x0000,0x0000,0x3c00,0x2c39,0x0000,0x0000,0x3c00,0x2c3a,0x0000,0x0000,0x3bff,0x2c3c,0x0000,0x0000,
+    0x3bff,0x2c3e,0x0000,0x0000,0x3bfe,0x2c41,0x0000,0x0000,0x3bfc,0x2c45,0x0000,0x0000,0x3bf6,0x2c3d,0x0000,0x0000,
+    0x3bf2,0x2c3a,0x0000,0x0000,0x3bee,0x2c3a,0x0000,0x0000,0x3be8,0x2c34,0x0000,0x0000,0x3be2,0x2c2e,0x0000,0x0000,
+    0x3bd9,0x2c24,0x0000,0x0000,0x3bcf,0x2c16,0x0000,0x0000,0x3bc5,0x2c08,0x0000,0x0000,0x3bb7,0x2be9,0x0000,0x0000,
+    0x3ba9,0x2bba,0x0000,0x0000,0x3b9a,0x2b87,0x0000,0x0000,0x3b89,0x2b4d,0x0000,0x0000,0x3b78,0x2b10,0x0000,0x0000,
+    0x3b65,0x2acd,0x0000,0x0000,0x3b52,0x2a84,0x0000,0x0000,0x3b3f,0x2a3a,0x0000,0x0000,0x3b2c,0x29ee,0x0000,0x0000,
+    0x3b19,0x29a4,0x0000,0x0000,0x3b06,0x2959,0x0000,0x0000,0x3af1,0x290d,0x0000,0x0000,0x3ade,0x28c4,0x0000,0x0000,
+    0x3acb,0x287e,0x0000,0x0000,0x3ab7,0x2839,0x0000,0x0000,0x3aa4,0x27f0,0x0000,0x0000,0x3a8f,0x2773,0x0000,0x0000,
+    0x3a7a,0x26fb,0x0000,0x0000,0x3a65,0x268b,0x0000,0x0000,0x3a4e,0x261f,0x0000,0x0000,0x3a37,0x25bb,0x0000,0x0000,
+    0x3a1f,0x255c,0x0000,0x0000,0x3a08,0x2503,0x0000,0x0000,0x39ef,0x24af,0x0000,0x0000,0x39d6,0x2462,0x0000,0x0000,
+    0x39bd,0x2418,0x0000,0x0000,0x39a3,0x23a7,0x0000,0x0000,0x398a,0x2327,0x0000,0x0000,0x3971,0x22af,0x0000,0x0000,
+    0x395b,0x2242,0x0000,0x0000,0x3946,0x21d9,0x0000,0x0000,0x392f,0x2177,0x0000,0x0000,0x3918,0x211d,0x0000,0x0000,
+    0x3900,0x20c9,0x0000,0x0000,0x38e8,0x207b,0x0000,0x0000,0x38d0,0x2031,0x0000,0x0000,0x38b7,0x1fda,0x0000,0x0000,
+    0x389d,0x1f58,0x0000,0x0000,0x3883,0x1ee3,0x0000,0x0000,0x3869,0x1e76,0x0000,0x0000,0x384f,0x1e10,0x0000,0x0000,
+    0x3835,0x1daf,0x0000,0x0000,0x381b,0x1d54,0x0000,0x0000,0x3801,0x1d00,0x0000,0x0000,0x37cf,0x1cae,0x0000,0x0000,
+    0x3c00,0x2d2f,0x0000,0x0000,0x3c00,0x2d2f,0x0000,0x0000,0x3c00,0x2d2f,0x0000,0x0000,0x3c00,0x2d2f,0x0000,0x0000,
+    0x3c00,0x2d30,0x0000,0x0000,0x3c00,0x2d30,0x0000,0x0000,0x3c00,0x2d31,0x0000,0x0000,0x3bff,0x2d33,0x0000,0x0000,
+    0x3bff,0x2d35,0x0000,0x0000,0x3bfe,0x2d37,0x0000,0x0000,0x3bfb,0x2d38,0x0000,0x0000,0x3bf4,0x2d2d,0x0000,0x0000,
+    0x3bf1,0x2d2a,0x0000,0x0000,0x3bed,0x2d26,0x0000,0x0000,0x3be5,0x2d18,0x0000,0x0000,0x3bde,0x2d10,0x0000,0x0000,
+    0x3bd5,0x2cff,0x0000,0x0000,0x3bca,0x2ceb,0x0000,0x0000,0x3bbe,0x2cd5,0x0000,0x0000,0x3bb0,0x2cb8,0x0000,0x0000,
+    0x3ba0,0x2c98,0x0000,0x0000,0x3b90,0x2c74,0x0000,0x0000,0x3b7f,0x2c4e,0x0000,0x0000,0x3b6d,0x2c25,0x0000,0x0000,
+    0x3b5a,0x2bf3,0x0000,0x0000,0x3b46,0x2b93,0x0000,0x0000,0x3b33,0x2b38,0x0000,0x0000,0x3b21,0x2ada,0x0000,0x0000,
+    0x3b0f,0x2a7f,0x0000,0x0000,0x3afc,0x2a24,0x0000,0x0000,0x3aea,0x29ca,0x0000,0x0000,0x3ad7,0x2972,0x0000,0x0000,
+    0x3ac6,0x291f,0x0000,0x0000,0x3ab4,0x28ce,0x0000,0x0000,0x3aa2,0x2882,0x0000,0x0000,0x3a8f,0x2839,0x0000,0x0000,
+    0x3a7b,0x27e8,0x0000,0x0000,0x3a68,0x2767,0x0000,0x0000,0x3a54,0x26eb,0x0000,0x0000,0x3a3f,0x2678,0x0000,0x0000,
+    0x3a28,0x260c,0x0000,0x0000,0x3a12,0x25a6,0x0000,0x0000,0x39fb,0x2548,0x0000,0x0000,0x39e4,0x24f0,0x0000,0x0000,
+    0x39cb,0x249e,0x0000,0x0000,0x39b3,0x244f,0x0000,0x0000,0x399a,0x2408,0x0000,0x0000,0x3981,0x2387,0x0000,0x0000,
+    0x3969,0x230a,0x0000,0x0000,0x3952,0x2296,0x0000,0x0000,0x393d,0x222a,0x0000,0x0000,0x3927,0x21c4,0x0000,0x0000,
+    0x3911,0x2166,0x0000,0x0000,0x38fa,0x210d,0x0000,0x0000,0x38e3,0x20ba,0x0000,0x0000,0x38cb,0x206d,0x0000,0x0000,
+    0x38b3,0x2028,0x0000,0x0000,0x389b,0x1fcc,0x0000,0x0000,0x3881,0x1f50,0x0000,0x0000,0x3868,0x1ed8,0x0000,0x0000,
+    0x384f,0x1e6e,0x0000,0x0000,0x3835,0x1e06,0x0000,0x0000,0x381c,0x1da9,0x0000,0x0000,0x3803,0x1d52,0x0000,0x0000,
+    0x3c00,0x2e58,0x0000,0x0000,0x3c00,0x2e58,0x0000,0x0000,0x3c00,0x2e58,0x0000,0x0000,0x3c00,0x2e59,0x0000,0x0000,
+    0x3c00,0x2e59,0x0000,0x0000,0x3c00,0x2e59,0x0000,0x0000,0x3bff,0x2e5a,0x0000,0x0000,0x3bff,0x2e5b,0x0000,0x0000,
+    0x3bfe,0x2e5c,0x0000,0x0000,0x3bfd,0x2e5e,0x0000,0x0000,0x3bf7,0x2e53,0x0000,0x0000,0x3bf2,0x2e4a,0x0000,0x0000,
+    0x3bef,0x2e44,0x0000,0x0000,0x3bea,0x2e3b,0x0000,0x0000,0x3be2,0x2e2b,0x0000,0x0000,0x3bda,0x2e18,0x0000,0x0000,
+    0x3bce,0x2dfe,0x0000,0x0000,0x3bc4,0x2de4,0x0000,0x0000,0x3bb6,0x2dc1,0x0000,0x0000,0x3ba7,0x2d9b,0x0000,0x0000,
+    0x3b96,0x2d6d,0x0000,0x0000,0x3b85,0x2d3d,0x0000,0x0000,0x3b73,0x2d0c,0x0000,0x0000,0x3b61,0x2cd7,0x0000,0x0000,
+    0x3b4e,0x2c9e,0x0000,0x0000,0x3b3a,0x2c64,0x0000,0x0000,0x3b27,0x2c2a,0x0000,0x0000,0x3b16,0x2be3,0x0000,0x0000,
+    0x3b04,0x2b75,0x0000,0x0000,0x3af3,0x2b07,0x0000,0x0000,0x3ae2,0x2a9b,0x0000,0x0000,0x3ad1,0x2a34,0x0000,0x0000,
+    0x3ac0,0x29d1,0x0000,0x0000,0x3ab0,0x2973,0x0000,0x0000,0x3aa0,0x291b,0x0000,0x0000,0x3a90,0x28c7,0x0000,0x0000,
+    0x3a7e,0x2878,0x0000,0x0000,0x3a6c,0x282e,0x0000,0x0000,0x3a5a,0x27ce,0x0000,0x0000,0x3a47,0x274b,0x0000,0x0000,
+    0x3a33,0x26d0,0x0000,0x0000,0x3a1e,0x265d,0x0000,0x0000,0x3a08,0x25f1,0x0000,0x0000,0x39f3,0x258e,0x0000,0x0000,
+    0x39dc,0x2531,0x0000,0x0000,0x39c5,0x24db,0x0000,0x0000,0x39ad,0x2489,0x0000,0x0000,0x3995,0x243d,0x0000,0x0000,
+    0x397c,0x23ed,0x0000,0x0000,0x3964,0x236b,0x0000,0x0000,0x394d,0x22f1,0x0000,0x0000,0x3937,0x2280,0x0000,0x0000,
+    0x3922,0x2215,0x0000,0x0000,0x390d,0x21b2,0x0000,0x0000,0x38f7,0x2158,0x0000,0x0000,0x38e0,0x2103,0x0000,0x0000,
+    0x38c9,0x20b2,0x0000,0x0000,0x38b2,0x2067,0x0000,0x0000,0x389b,0x2021,0x0000,0x0000,0x3883,0x1fc1,0x0000,0x0000,
+    0x386a,0x1f47,0x0000,0x0000,0x3852,0x1ed8,0x0000,0x0000,0x3839,0x1e6e,0x0000,0x0000,0x3820,0x1e0c,0x0000,0x0000,
+    0x3c00,0x2fbc,0x0000,0x0000,0x3c00,0x2fbc,0x0000,0x0000,0x3c00,0x2fbc,0x0000,0x0000,0x3c00,0x2fbc,0x0000,0x0000,
+    0x3c00,0x2fbc,0x0000,0x0000,0x3c00,0x2fbd,0x0000,0x0000,0x3bff,0x2fbd,0x0000,0x0000,0x3bff,0x2fbd,0x0000,0x0000,
+    0x3bfe,0x2fbe,0x0000,0x0000,0x3bfc,0x2fbd,0x0000,0x0000,0x3bf5,0x2faa,0x0000,0x0000,0x3bf2,0x2fa2,0x0000,0x0000,
+    0x3bee,0x2f98,0x0000,0x0000,0x3be5,0x2f81,0x0000,0x0000,0x3bde,0x2f6d,0x0000,0x0000,0x3bd4,0x2f50,0x0000,0x0000,
+    0x3bc8,0x2f2a,0x0000,0x0000,0x3bbc,0x2f03,0x0000,0x0000,0x3bad,0x2ed3,0x0000,0x0000,0x3b9c,0x2e9e,0x0000,0x0000,
+    0x3b8a,0x2e61,0x0000,0x0000,0x3b78,0x2e23,0x0000,0x0000,0x3b66,0x2de2,0x0000,0x0000,0x3b53,0x2d9f,0x0000,0x0000,
+    0x3b40,0x2d58,0x0000,0x0000,0x3b2d,0x2d10,0x0000,0x0000,0x3b1a,0x2cc7,0x0000,0x0000,0x3b0a,0x2c84,0x0000,0x0000,
+    0x3afa,0x2c42,0x0000,0x0000,0x3aea,0x2c01,0x0000,0x0000,0x3ada,0x2b83,0x0000,0x0000,0x3acb,0x2b0a,0x0000,0x0000,
+    0x3abc,0x2a97,0x0000,0x0000,0x3aae,0x2a29,0x0000,0x0000,0x3a9f,0x29c3,0x0000,0x0000,0x3a91,0x2963,0x0000,0x0000,
+    0x3a82,0x290a,0x0000,0x0000,0x3a72,0x28b5,0x0000,0x0000,0x3a61,0x2865,0x0000,0x0000,0x3a50,0x281a,0x0000,0x0000,
+    0x3a3f,0x27ab,0x0000,0x0000,0x3a2c,0x272a,0x0000,0x0000,0x3a18,0x26af,0x0000,0x0000,0x3a02,0x263f,0x0000,0x0000,
+    0x39ee,0x25d7,0x0000,0x0000,0x39d9,0x2576,0x0000,0x0000,0x39c2,0x251a,0x0000,0x0000,0x39ab,0x24c7,0x0000,0x0000,
+    0x3994,0x2477,0x0000,0x0000,0x397c,0x242d,0x0000,0x0000,0x3964,0x23d2,0x0000,0x0000,0x394d,0x2352,0x0000,0x0000,
+    0x3935,0x22de,0x0000,0x0000,0x3920,0x2271,0x0000,0x0000,0x390b,0x220a,0x0000,0x0000,0x38f6,0x21a9,0x0000,0x0000,
+    0x38e1,0x214f,0x0000,0x0000,0x38ca,0x20fb,0x0000,0x0000,0x38b4,0x20ac,0x0000,0x0000,0x389e,0x2066,0x0000,0x0000,
+    0x3887,0x2022,0x0000,0x0000,0x3870,0x1fc7,0x0000,0x0000,0x3858,0x1f52,0x0000,0x0000,0x3841,0x1ee5,0x0000,0x0000,
+    0x3c00,0x30b2,0x0000,0x0000,0x3c00,0x30b2,0x0000,0x0000,0x3c00,0x30b2,0x0000,0x0000,0x3c00,0x30b2,0x0000,0x0000,
+    0x3c00,0x30b2,0x0000,0x0000,0x3c00,0x30b2,0x0000,0x0000,0x3bff,0x30b2,0x0000,0x0000,0x3bff,0x30b2,0x0000,0x0000,
+    0x3bfe,0x30b1,0x0000,0x0000,0x3bfa,0x30ad,0x0000,0x0000,0x3bf4,0x30a3,0x0000,0x0000,0x3bf0,0x309c,0x0000,0x0000,
+    0x3bea,0x3091,0x0000,0x0000,0x3be2,0x3082,0x0000,0x0000,0x3bd9,0x3071,0x0000,0x0000,0x3bcd,0x305b,0x0000,0x0000,
+    0x3bc1,0x3043,0x0000,0x0000,0x3bb1,0x3026,0x0000,0x0000,0x3ba2,0x3007,0x0000,0x0000,0x3b8f,0x2fc4,0x0000,0x0000,
+    0x3b7c,0x2f75,0x0000,0x0000,0x3b6a,0x2f25,0x0000,0x0000,0x3b58,0x2ed3,0x0000,0x0000,0x3b44,0x2e7c,0x0000,0x0000,
+    0x3b32,0x2e25,0x0000,0x0000,0x3b1f,0x2dcd,0x0000,0x0000,0x3b0d,0x2d77,0x0000,0x0000,0x3afe,0x2d26,0x0000,0x0000,
+    0x3aef,0x2cd7,0x0000,0x0000,0x3ae1,0x2c8a,0x0000,0x0000,0x3ad4,0x2c41,0x0000,0x0000,0x3ac7,0x2bf6,0x0000,0x0000,
+    0x3ab9,0x2b71,0x0000,0x0000,0x3aac,0x2af3,0x0000,0x0000,0x3aa0,0x2a7d,0x0000,0x0000,0x3a94,0x2a10,0x0000,0x0000,
+    0x3a87,0x29ab,0x0000,0x0000,0x3a7a,0x294b,0x0000,0x0000,0x3a6b,0x28f1,0x0000,0x0000,0x3a5b,0x289c,0x0000,0x0000,
+    0x3a4b,0x284e,0x0000,0x0000,0x3a3b,0x2806,0x0000,0x0000,0x3a29,0x2784,0x0000,0x0000,0x3a16,0x2704,0x0000,0x0000,
+    0x3a02,0x268f,0x0000,0x0000,0x39ee,0x2623,0x0000,0x0000,0x39d9,0x25bd,0x0000,0x0000,0x39c4,0x2560,0x0000,0x0000,
+    0x39ae,0x2507,0x0000,0x0000,0x3996,0x24b5,0x0000,0x0000,0x3980,0x2469,0x0000,0x0000,0x3969,0x2422,0x0000,0x0000,
+    0x3951,0x23c0,0x0000,0x0000,0x393a,0x2344,0x0000,0x0000,0x3923,0x22d1,0x0000,0x0000,0x390d,0x2266,0x0000,0x0000,
+    0x38f9,0x2203,0x0000,0x0000,0x38e5,0x21a6,0x0000,0x0000,0x38d0,0x2150,0x0000,0x0000,0x38ba,0x20ff,0x0000,0x0000,
+    0x38a4,0x20b3,0x0000,0x0000,0x388f,0x206d,0x0000,0x0000,0x3879,0x202d,0x0000,0x0000,0x3863,0x1fdd,0x0000,0x0000,
+    0x3c00,0x31af,0x0000,0x0000,0x3c00,0x31af,0x0000,0x0000,0x3c00,0x31af,0x0000,0x0000,0x3c00,0x31af,0x0000,0x0000,
+    0x3c00,0x31ae,0x0000,0x0000,0x3c00,0x31ae,0x0000,0x0000,0x3bff,0x31ad,0x0000,0x0000,0x3bfe,0x31ac,0x0000,0x0000,
+    0x3bfd,0x31aa,0x0000,0x0000,0x3bf7,0x319f,0x0000,0x0000,0x3bf2,0x3194,0x0000,0x0000,0x3bee,0x318a,0x0000,0x0000,
+    0x3be5,0x3178,0x0000,0x0000,0x3bdd,0x3164,0x0000,0x0000,0x3bd2,0x314b,0x0000,0x0000,0x3bc5,0x312c,0x0000,0x0000,
+    0x3bb6,0x310a,0x0000,0x0000,0x3ba7,0x30e4,0x0000,0x0000,0x3b94,0x30b8,0x0000,0x0000,0x3b80,0x3087,0x0000,0x0000,
+    0x3b6d,0x3055,0x0000,0x0000,0x3b5a,0x3023,0x0000,0x0000,0x3b47,0x2fdb,0x0000,0x0000,0x3b34,0x2f71,0x0000,0x0000,
+    0x3b22,0x2f07,0x0000,0x0000,0x3b11,0x2e9d,0x0000,0x0000,0x3b00,0x2e37,0x0000,0x0000,0x3af2,0x2dd6,0x0000,0x0000,
+    0x3ae5,0x2d79,0x0000,0x0000,0x3ad9,0x2d20,0x0000,0x0000,0x3ace,0x2ccc,0x0000,0x0000,0x3ac3,0x2c7c,0x0000,0x0000,
+    0x3ab8,0x2c30,0x0000,0x0000,0x3aad,0x2bd2,0x0000,0x0000,0x3aa2,0x2b4b,0x0000,0x0000,0x3a98,0x2ace,0x0000,0x0000,
+    0x3a8d,0x2a5b,0x0000,0x0000,0x3a82,0x29f0,0x0000,0x0000,0x3a76,0x298c,0x0000,0x0000,0x3a68,0x292d,0x0000,0x0000,
+    0x3a5a,0x28d5,0x0000,0x0000,0x3a4a,0x2883,0x0000,0x0000,0x3a3b,0x2838,0x0000,0x0000,0x3a2a,0x27e3,0x0000,0x0000,
+    0x3a19,0x275f,0x0000,0x0000,0x3a06,0x26e5,0x0000,0x0000,0x39f2,0x2673,0x0000,0x0000,0x39de,0x260a,0x0000,0x0000,
+    0x39ca,0x25a9,0x0000,0x0000,0x39b5,0x254f,0x0000,0x0000,0x399f,0x24fa,0x0000,0x0000,0x3988,0x24a9,0x0000,0x0000,
+    0x3972,0x245f,0x0000,0x0000,0x395b,0x241b,0x0000,0x0000,0x3944,0x23b7,0x0000,0x0000,0x392d,0x233f,0x0000,0x0000,
+    0x3917,0x22d2,0x0000,0x0000,0x3901,0x226a,0x0000,0x0000,0x38ec,0x220a,0x0000,0x0000,0x38d8,0x21b1,0x0000,0x0000,
+    0x38c4,0x215d,0x0000,0x0000,0x38b0,0x210d,0x0000,0x0000,0x389a,0x20c3,0x0000,0x0000,0x3886,0x207d,0x0000,0x0000,
+    0x3c00,0x32da,0x0000,0x0000,0x3c00,0x32da,0x0000,0x0000,0x3c00,0x32da,0x0000,0x0000,0x3c00,0x32d9,0x0000,0x0000,
+    0x3c00,0x32d9,0x0000,0x0000,0x3bff,0x32d8,0x0000,0x0000,0x3bff,0x32d7,0x0000,0x0000,0x3bfe,0x32d5,0x0000,0x0000,
+    0x3bfc,0x32d0,0x0000,0x0000,0x3bf4,0x32bf,0x0000,0x0000,0x3bf0,0x32b2,0x0000,0x0000,0x3be9,0x329f,0x0000,0x0000,
+    0x3be1,0x3287,0x0000,0x0000,0x3bd7,0x326a,0x0000,0x0000,0x3bc8,0x3244,0x0000,0x0000,0x3bba,0x321b,0x0000,0x0000,
+    0x3baa,0x31ec,0x0000,0x0000,0x3b98,0x31b8,0x0000,0x0000,0x3b84,0x317d,0x0000,0x0000,0x3b6f,0x313e,0x0000,0x0000,
+    0x3b5b,0x3100,0x0000,0x0000,0x3b48,0x30bf,0x0000,0x0000,0x3b35,0x307e,0x0000,0x0000,0x3b23,0x303e,0x0000,0x0000,
+    0x3b12,0x2ffc,0x0000,0x0000,0x3b02,0x2f7e,0x0000,0x0000,0x3af4,0x2f08,0x0000,0x0000,0x3ae8,0x2e95,0x0000,0x0000,
+    0x3add,0x2e2a,0x0000,0x0000,0x3ad3,0x2dc4,0x0000,0x0000,0x3aca,0x2d64,0x0000,0x0000,0x3ac1,0x2d09,0x0000,0x0000,
+    0x3ab9,0x2cb3,0x0000,0x0000,0x3ab0,0x2c63,0x0000,0x0000,0x3aa7,0x2c17,0x0000,0x0000,0x3a9e,0x2ba1,0x0000,0x0000,
+    0x3a95,0x2b1f,0x0000,0x0000,0x3a8c,0x2aa6,0x0000,0x0000,0x3a82,0x2a36,0x0000,0x0000,0x3a77,0x29cd,0x0000,0x0000,
+    0x3a6b,0x296b,0x0000,0x0000,0x3a5e,0x2910,0x0000,0x0000,0x3a4f,0x28bc,0x0000,0x0000,0x3a40,0x286d,0x0000,0x0000,
+    0x3a30,0x2823,0x0000,0x0000,0x3a20,0x27c0,0x0000,0x0000,0x3a0f,0x2742,0x0000,0x0000,0x39fc,0x26cc,0x0000,0x0000,
+    0x39e9,0x265f,0x0000,0x0000,0x39d4,0x25f9,0x0000,0x0000,0x39c1,0x259c,0x0000,0x0000,0x39ac,0x2544,0x0000,0x0000,
+    0x3997,0x24f2,0x0000,0x0000,0x3981,0x24a6,0x0000,0x0000,0x396a,0x245f,0x0000,0x0000,0x3954,0x241d,0x0000,0x0000,
+    0x393e,0x23bf,0x0000,0x0000,0x3927,0x234d,0x0000,0x0000,0x3911,0x22e1,0x0000,0x0000,0x38fb,0x227a,0x0000,0x0000,
+    0x38e6,0x221c,0x0000,0x0000,0x38d2,0x21c3,0x0000,0x0000,0x38bf,0x2170,0x0000,0x0000,0x38ab,0x2122,0x0000,0x0000,
+    0x3c00,0x341d,0x0000,0x0000,0x3c00,0x341d,0x0000,0x0000,0x3c00,0x341d,0x0000,0x0000,0x3c00,0x341d,0x0000,0x0000,
+    0x3c00,0x341d,0x0000,0x0000,0x3bff,0x341c,0x0000,0x0000,0x3bff,0x341b,0x0000,0x0000,0x3bfd,0x3419,0x0000,0x0000,
+    0x3bf7,0x3411,0x0000,0x0000,0x3bf2,0x3409,0x0000,0x0000,0x3bed,0x33ff,0x0000,0x0000,0x3be3,0x33e0,0x0000,0x0000,
+    0x3bda,0x33bf,0x0000,0x0000,0x3bcd,0x3394,0x0000,0x0000,0x3bbe,0x3362,0x0000,0x0000,0x3bac,0x3328,0x0000,0x0000,
+    0x3b9a,0x32e9,0x0000,0x0000,0x3b85,0x32a2,0x0000,0x0000,0x3b6f,0x3255,0x0000,0x0000,0x3b5b,0x3208,0x0000,0x0000,
+    0x3b47,0x31b8,0x0000,0x0000,0x3b33,0x3169,0x0000,0x0000,0x3b22,0x311a,0x0000,0x0000,0x3b11,0x30cd,0x0000,0x0000,
+    0x3b02,0x3082,0x0000,0x0000,0x3af5,0x3039,0x0000,0x0000,0x3ae9,0x2fe7,0x0000,0x0000,0x3ade,0x2f63,0x0000,0x0000,
+    0x3ad6,0x2ee8,0x0000,0x0000,0x3acf,0x2e75,0x0000,0x0000,0x3ac8,0x2e08,0x0000,0x0000,0x3ac2,0x2da2,0x0000,0x0000,
+    0x3abc,0x2d42,0x0000,0x0000,0x3ab5,0x2ce8,0x0000,0x0000,0x3aaf,0x2c94,0x0000,0x0000,0x3aa8,0x2c45,0x0000,0x0000,
+    0x3aa0,0x2bf7,0x0000,0x0000,0x3a98,0x2b6e,0x0000,0x0000,0x3a90,0x2af2,0x0000,0x0000,0x3a87,0x2a7e,0x0000,0x0000,
+    0x3a7d,0x2a11,0x0000,0x0000,0x3a72,0x29ac,0x0000,0x0000,0x3a66,0x294e,0x0000,0x0000,0x3a59,0x28f8,0x0000,0x0000,
+    0x3a4b,0x28a7,0x0000,0x0000,0x3a3b,0x285b,0x0000,0x0000,0x3a2c,0x2814,0x0000,0x0000,0x3a1b,0x27a7,0x0000,0x0000,
+    0x3a0a,0x272d,0x0000,0x0000,0x39f8,0x26bb,0x0000,0x0000,0x39e6,0x2655,0x0000,0x0000,0x39d2,0x25f4,0x0000,0x0000,
+    0x39be,0x259a,0x0000,0x0000,0x39ab,0x2546,0x0000,0x0000,0x3996,0x24f7,0x0000,0x0000,0x3981,0x24ad,0x0000,0x0000,
+    0x396b,0x2468,0x0000,0x0000,0x3955,0x2426,0x0000,0x0000,0x3940,0x23d4,0x0000,0x0000,0x392a,0x2364,0x0000,0x0000,
+    0x3914,0x22f9,0x0000,0x0000,0x38fe,0x2296,0x0000,0x0000,0x38e9,0x2238,0x0000,0x0000,0x38d4,0x21e2,0x0000,0x0000,
+    0x3c00,0x34ed,0x0000,0x0000,0x3c00,0x34ed,0x0000,0x0000,0x3c00,0x34ed,0x0000,0x0000,0x3c00,0x34ed,0x0000,0x0000,
+    0x3c00,0x34ed,0x0000,0x0000,0x3bff,0x34eb,0x0000,0x0000,0x3bfe,0x34e9,0x0000,0x0000,0x3bfc,0x34e5,0x0000,0x0000,
+    0x3bf4,0x34d9,0x0000,0x0000,0x3bef,0x34cf,0x0000,0x0000,0x3be7,0x34bf,0x0000,0x0000,0x3bdd,0x34aa,0x0000,0x0000,
+    0x3bd0,0x3492,0x0000,0x0000,0x3bc0,0x3473,0x0000,0x0000,0x3bae,0x3450,0x0000,0x0000,0x3b9b,0x342a,0x0000,0x0000,
+    0x3b85,0x33fe,0x0000,0x0000,0x3b6e,0x33a0,0x0000,0x0000,0x3b58,0x333f,0x0000,0x0000,0x3b43,0x32df,0x0000,0x0000,
+    0x3b30,0x327e,0x0000,0x0000,0x3b1e,0x321e,0x0000,0x0000,0x3b0e,0x31c0,0x0000,0x0000,0x3aff,0x3165,0x0000,0x0000,
+    0x3af3,0x310e,0x0000,0x0000,0x3ae9,0x30bb,0x0000,0x0000,0x3ae0,0x306c,0x0000,0x0000,0x3ad8,0x3021,0x0000,0x0000,
+    0x3ad2,0x2fb5,0x0000,0x0000,0x3acd,0x2f33,0x0000,0x0000,0x3ac9,0x2eb9,0x0000,0x0000,0x3ac5,0x2e47,0x0000,0x0000,
+    0x3ac1,0x2ddd,0x0000,0x0000,0x3abd,0x2d79,0x0000,0x0000,0x3ab9,0x2d1c,0x0000,0x0000,0x3ab4,0x2cc5,0x0000,0x0000,
+    0x3aaf,0x2c73,0x0000,0x0000,0x3aa8,0x2c27,0x0000,0x0000,0x3aa1,0x2bc3,0x0000,0x0000,0x3a99,0x2b40,0x0000,0x0000,
+    0x3a91,0x2ac9,0x0000,0x0000,0x3a88,0x2a5a,0x0000,0x0000,0x3a7e,0x29f3,0x0000,0x0000,0x3a73,0x2992,0x0000,0x0000,
+    0x3a67,0x2939,0x0000,0x0000,0x3a5a,0x28e6,0x0000,0x0000,0x3a4c,0x2898,0x0000,0x0000,0x3a3d,0x2850,0x0000,0x0000,
+    0x3a2d,0x280d,0x0000,0x0000,0x3a1e,0x279d,0x0000,0x0000,0x3a0d,0x2728,0x0000,0x0000,0x39fc,0x26bd,0x0000,0x0000,
+    0x39ea,0x2658,0x0000,0x0000,0x39d8,0x25fa,0x0000,0x0000,0x39c4,0x25a2,0x0000,0x0000,0x39b1,0x2550,0x0000,0x0000,
+    0x399d,0x2503,0x0000,0x0000,0x398a,0x24bc,0x0000,0x0000,0x3975,0x2478,0x0000,0x0000,0x3960,0x2439,0x0000,0x0000,
+    0x394b,0x23fc,0x0000,0x0000,0x3936,0x238e,0x0000,0x0000,0x3922,0x2327,0x0000,0x0000,0x390d,0x22c7,0x0000,0x0000,
+    0x3c00,0x35e2,0x0000,0x0000,0x3c00,0x35e2,0x0000,0x0000,0x3c00,0x35e1,0x0000,0x0000,0x3c00,0x35e1,0x0000,0x0000,
+    0x3c00,0x35e0,0x0000,0x0000,0x3bff,0x35de,0x0000,0x0000,0x3bfd,0x35db,0x0000,0x0000,0x3bf7,0x35d0,0x0000,0x0000,
+    0x3bf1,0x35c3,0x0000,0x0000,0x3bea,0x35b2,0x0000,0x0000,0x3be0,0x359b,0x0000,0x0000,0x3bd3,0x357e,0x0000,0x0000,
+    0x3bc2,0x3559,0x0000,0x0000,0x3bae,0x352f,0x0000,0x0000,0x3b9a,0x3500,0x0000,0x0000,0x3b83,0x34cb,0x0000,0x0000,
+    0x3b6a,0x3492,0x0000,0x0000,0x3b53,0x3457,0x0000,0x0000,0x3b3d,0x341b,0x0000,0x0000,0x3b29,0x33c0,0x0000,0x0000,
+    0x3b17,0x334b,0x0000,0x0000,0x3b08,0x32db,0x0000,0x0000,0x3afb,0x326d,0x0000,0x0000,0x3af0,0x3204,0x0000,0x0000,
+    0x3ae7,0x31a2,0x0000,0x0000,0x3ae0,0x3144,0x0000,0x0000,0x3ada,0x30eb,0x0000,0x0000,0x3ad6,0x3098,0x0000,0x0000,
+    0x3ad3,0x3049,0x0000,0x0000,0x3ad0,0x3000,0x0000,0x0000,0x3ace,0x2f79,0x0000,0x0000,0x3acd,0x2efb,0x0000,0x0000,
+    0x3acb,0x2e85,0x0000,0x0000,0x3ac9,0x2e17,0x0000,0x0000,0x3ac6,0x2db0,0x0000,0x0000,0x3ac3,0x2d50,0x0000,0x0000,
+    0x3ac0,0x2cf7,0x0000,0x0000,0x3abb,0x2ca4,0x0000,0x0000,0x3ab6,0x2c56,0x0000,0x0000,0x3ab0,0x2c0f,0x0000,0x0000,
+    0x3aa9,0x2b97,0x0000,0x0000,0x3aa1,0x2b1b,0x0000,0x0000,0x3a98,0x2aa9,0x0000,0x0000,0x3a8f,0x2a3f,0x0000,0x0000,
+    0x3a85,0x29dc,0x0000,0x0000,0x3a7b,0x2982,0x0000,0x0000,0x3a6f,0x292d,0x0000,0x0000,0x3a62,0x28de,0x0000,0x0000,
+    0x3a55,0x2893,0x0000,0x0000,0x3a47,0x284f,0x0000,0x0000,0x3a38,0x280e,0x0000,0x0000,0x3a28,0x27a2,0x0000,0x0000,
+    0x3a18,0x2732,0x0000,0x0000,0x3a08,0x26c9,0x0000,0x0000,0x39f7,0x2667,0x0000,0x0000,0x39e6,0x260b,0x0000,0x0000,
+    0x39d4,0x25b7,0x0000,0x0000,0x39c2,0x2568,0x0000,0x0000,0x39af,0x251f,0x0000,0x0000,0x399c,0x24da,0x0000,0x0000,
+    0x3989,0x249a,0x0000,0x0000,0x3977,0x245d,0x0000,0x0000,0x3963,0x2424,0x0000,0x0000,0x3950,0x23db,0x0000,0x0000,
+    0x3c00,0x3700,0x0000,0x0000,0x3c00,0x3700,0x0000,0x0000,0x3c00,0x36ff,0x0000,0x0000,0x3c00,0x36ff,0x0000,0x0000,
+    0x3bff,0x36fd,0x0000,0x0000,0x3bfe,0x36fa,0x0000,0x0000,0x3bfc,0x36f4,0x0000,0x0000,0x3bf3,0x36e2,0x0000,0x0000,
+    0x3bed,0x36d1,0x0000,0x0000,0x3be1,0x36b6,0x0000,0x0000,0x3bd4,0x3694,0x0000,0x0000,0x3bc2,0x3668,0x0000,0x0000,
+    0x3bac,0x3634,0x0000,0x0000,0x3b96,0x35fa,0x0000,0x0000,0x3b7d,0x35b9,0x0000,0x0000,0x3b63,0x3572,0x0000,0x0000,
+    0x3b4a,0x352a,0x0000,0x0000,0x3b33,0x34e0,0x0000,0x0000,0x3b1f,0x3499,0x0000,0x0000,0x3b0e,0x3453,0x0000,0x0000,
+    0x3b00,0x340f,0x0000,0x0000,0x3af4,0x339c,0x0000,0x0000,0x3aeb,0x3320,0x0000,0x0000,0x3ae4,0x32ab,0x0000,0x0000,
+    0x3ae0,0x323c,0x0000,0x0000,0x3add,0x31d4,0x0000,0x0000,0x3adb,0x3172,0x0000,0x0000,0x3ad9,0x3116,0x0000,0x0000,
+    0x3ad9,0x30c0,0x0000,0x0000,0x3ad8,0x306f,0x0000,0x0000,0x3ad8,0x3024,0x0000,0x0000,0x3ad8,0x2fbc,0x0000,0x0000,
+    0x3ad9,0x2f3b,0x0000,0x0000,0x3ad8,0x2ec2,0x0000,0x0000,0x3ad8,0x2e52,0x0000,0x0000,0x3ad6,0x2de9,0x0000,0x0000,
+    0x3ad4,0x2d88,0x0000,0x0000,0x3ad1,0x2d2c,0x0000,0x0000,0x3acd,0x2cd8,0x0000,0x0000,0x3ac9,0x2c89,0x0000,0x0000,
+    0x3ac3,0x2c40,0x0000,0x0000,0x3abd,0x2bf8,0x0000,0x0000,0x3ab6,0x2b7a,0x0000,0x0000,0x3aae,0x2b05,0x0000,0x0000,
+    0x3aa6,0x2a97,0x0000,0x0000,0x3a9c,0x2a30,0x0000,0x0000,0x3a92,0x29d2,0x0000,0x0000,0x3a88,0x297b,0x0000,0x0000,
+    0x3a7d,0x292b,0x0000,0x0000,0x3a72,0x28de,0x0000,0x0000,0x3a65,0x2898,0x0000,0x0000,0x3a58,0x2856,0x0000,0x0000,
+    0x3a4b,0x2819,0x0000,0x0000,0x3a3c,0x27be,0x0000,0x0000,0x3a2d,0x2752,0x0000,0x0000,0x3a1e,0x26ee,0x0000,0x0000,
+    0x3a0e,0x2690,0x0000,0x0000,0x39ff,0x2639,0x0000,0x0000,0x39ef,0x25e7,0x0000,0x0000,0x39de,0x259a,0x0000,0x0000,
+    0x39ce,0x2552,0x0000,0x0000,0x39bd,0x2510,0x0000,0x0000,0x39ac,0x24d1,0x0000,0x0000,0x399a,0x2496,0x0000,0x0000,
+    0x3c00,0x3827,0x0000,0x0000,0x3c00,0x3827,0x0000,0x0000,0x3c00,0x3827,0x0000,0x0000,0x3c00,0x3826,0x0000,0x0000,
+    0x3bff,0x3825,0x0000,0x0000,0x3bfd,0x3822,0x0000,0x0000,0x3bf5,0x3819,0x0000,0x0000,0x3bee,0x3810,0x0000,0x0000,
+    0x3be2,0x3800,0x0000,0x0000,0x3bd4,0x37d9,0x0000,0x0000,0x3bbf,0x37a3,0x0000,0x0000,0x3ba8,0x3763,0x0000,0x0000,
+    0x3b8d,0x371a,0x0000,0x0000,0x3b71,0x36c8,0x0000,0x0000,0x3b55,0x3671,0x0000,0x0000,0x3b3b,0x3618,0x0000,0x0000,
+    0x3b23,0x35bf,0x0000,0x0000,0x3b10,0x3569,0x0000,0x0000,0x3b01,0x3515,0x0000,0x0000,0x3af5,0x34c5,0x0000,0x0000,
+    0x3aec,0x3479,0x0000,0x0000,0x3ae6,0x3430,0x0000,0x0000,0x3ae3,0x33d8,0x0000,0x0000,0x3ae1,0x3357,0x0000,0x0000,
+    0x3ae0,0x32de,0x0000,0x0000,0x3ae1,0x326c,0x0000,0x0000,0x3ae2,0x3201,0x0000,0x0000,0x3ae4,0x319d,0x0000,0x0000,
+    0x3ae6,0x313f,0x0000,0x0000,0x3ae8,0x30e7,0x0000,0x0000,0x3ae9,0x3095,0x0000,0x0000,0x3aeb,0x3048,0x0000,0x0000,
+    0x3aec,0x3000,0x0000,0x0000,0x3aec,0x2f7c,0x0000,0x0000,0x3aed,0x2f02,0x0000,0x0000,0x3aed,0x2e90,0x0000,0x0000,
+    0x3aec,0x2e26,0x0000,0x0000,0x3aea,0x2dc3,0x0000,0x0000,0x3ae8,0x2d67,0x0000,0x0000,0x3ae5,0x2d12,0x0000,0x0000,
+    0x3ae1,0x2cc2,0x0000,0x0000,0x3adc,0x2c78,0x0000,0x0000,0x3ad7,0x2c32,0x0000,0x0000,0x3ad0,0x2be3,0x0000,0x0000,
+    0x3aca,0x2b6c,0x0000,0x0000,0x3ac2,0x2afc,0x0000,0x0000,0x3aba,0x2a95,0x0000,0x0000,0x3ab2,0x2a34,0x0000,0x0000,
+    0x3aa8,0x29d9,0x0000,0x0000,0x3a9e,0x2985,0x0000,0x0000,0x3a94,0x2938,0x0000,0x0000,0x3a8a,0x28f1,0x0000,0x0000,
+    0x3a7f,0x28ae,0x0000,0x0000,0x3a74,0x2870,0x0000,0x0000,0x3a68,0x2835,0x0000,0x0000,0x3a5c,0x27fd,0x0000,0x0000,
+    0x3a4f,0x2797,0x0000,0x0000,0x3a42,0x2737,0x0000,0x0000,0x3a34,0x26dc,0x0000,0x0000,0x3a26,0x2687,0x0000,0x0000,
+    0x3a18,0x2637,0x0000,0x0000,0x3a09,0x25eb,0x0000,0x0000,0x39fa,0x25a4,0x0000,0x0000,0x39eb,0x2562,0x0000,0x0000,
+    0x3c00,0x38e9,0x0000,0x0000,0x3c00,0x38e9,0x0000,0x0000,0x3c00,0x38e9,0x0000,0x0000,0x3bff,0x38e8,0x0000,0x0000,
+    0x3bfe,0x38e6,0x0000,0x0000,0x3bf7,0x38de,0x0000,0x0000,0x3bef,0x38d3,0x0000,0x0000,0x3be2,0x38c0,0x0000,0x0000,
+    0x3bd0,0x38a7,0x0000,0x0000,0x3bb7,0x3885,0x0000,0x0000,0x3b9b,0x385d,0x0000,0x0000,0x3b7b,0x382d,0x0000,0x0000,
+    0x3b5b,0x37f3,0x0000,0x0000,0x3b3d,0x3787,0x0000,0x0000,0x3b22,0x371b,0x0000,0x0000,0x3b0d,0x36b1,0x0000,0x0000,
+    0x3afd,0x364c,0x0000,0x0000,0x3af2,0x35eb,0x0000,0x0000,0x3aea,0x358e,0x0000,0x0000,0x3ae6,0x3536,0x0000,0x0000,
+    0x3ae4,0x34e3,0x0000,0x0000,0x3ae5,0x3495,0x0000,0x0000,0x3ae7,0x344b,0x0000,0x0000,0x3aea,0x3405,0x0000,0x0000,
+    0x3aed,0x3388,0x0000,0x0000,0x3af1,0x330d,0x0000,0x0000,0x3af4,0x3299,0x0000,0x0000,0x3af8,0x322c,0x0000,0x0000,
+    0x3afc,0x31c7,0x0000,0x0000,0x3aff,0x3167,0x0000,0x0000,0x3b01,0x310f,0x0000,0x0000,0x3b04,0x30bb,0x0000,0x0000,
+    0x3b05,0x306e,0x0000,0x0000,0x3b07,0x3026,0x0000,0x0000,0x3b07,0x2fc5,0x0000,0x0000,0x3b07,0x2f48,0x0000,0x0000,
+    0x3b07,0x2ed3,0x0000,0x0000,0x3b06,0x2e68,0x0000,0x0000,0x3b05,0x2e04,0x0000,0x0000,0x3b03,0x2da7,0x0000,0x0000,
+    0x3b00,0x2d51,0x0000,0x0000,0x3afd,0x2d01,0x0000,0x0000,0x3afa,0x2cb7,0x0000,0x0000,0x3af5,0x2c71,0x0000,0x0000,
+    0x3af0,0x2c31,0x0000,0x0000,0x3aeb,0x2be9,0x0000,0x0000,0x3ae5,0x2b78,0x0000,0x0000,0x3adf,0x2b0f,0x0000,0x0000,
+    0x3ad8,0x2aae,0x0000,0x0000,0x3ad0,0x2a54,0x0000,0x0000,0x3ac9,0x29ff,0x0000,0x0000,0x3ac0,0x29b0,0x0000,0x0000,
+    0x3ab8,0x2965,0x0000,0x0000,0x3aae,0x291f,0x0000,0x0000,0x3aa5,0x28dd,0x0000,0x0000,0x3a9b,0x28a1,0x0000,0x0000,
+    0x3a91,0x2867,0x0000,0x0000,0x3a87,0x2832,0x0000,0x0000,0x3a7c,0x2801,0x0000,0x0000,0x3a72,0x27a5,0x0000,0x0000,
+    0x3a67,0x274e,0x0000,0x0000,0x3a5c,0x26fd,0x0000,0x0000,0x3a51,0x26af,0x0000,0x0000,0x3a45,0x2666,0x0000,0x0000,
+    0x3c00,0x39cb,0x0000,0x0000,0x3c00,0x39cb,0x0000,0x0000,0x3c00,0x39cb,0x0000,0x0000,0x3bff,0x39c9,0x0000,0x0000,
+    0x3bf8,0x39c1,0x0000,0x0000,0x3bee,0x39b3,0x0000,0x0000,0x3bdc,0x399b,0x0000,0x0000,0x3bc4,0x3979,0x0000,0x0000,
+    0x3ba2,0x394a,0x0000,0x0000,0x3b7c,0x3912,0x0000,0x0000,0x3b55,0x38d3,0x0000,0x0000,0x3b32,0x3892,0x0000,0x0000,
+    0x3b15,0x3850,0x0000,0x0000,0x3b00,0x3812,0x0000,0x0000,0x3af2,0x37ac,0x0000,0x0000,0x3aea,0x373b,0x0000,0x0000,
+    0x3ae7,0x36ce,0x0000,0x0000,0x3ae7,0x3668,0x0000,0x0000,0x3aea,0x3606,0x0000,0x0000,0x3aee,0x35aa,0x0000,0x0000,
+    0x3af3,0x3552,0x0000,0x0000,0x3af8,0x34fe,0x0000,0x0000,0x3afe,0x34af,0x0000,0x0000,0x3b04,0x3464,0x0000,0x0000,
+    0x3b09,0x341e,0x0000,0x0000,0x3b0e,0x33b7,0x0000,0x0000,0x3b13,0x333b,0x0000,0x0000,0x3b17,0x32c6,0x0000,0x0000,
+    0x3b1b,0x3259,0x0000,0x0000,0x3b1e,0x31f2,0x0000,0x0000,0x3b21,0x3192,0x0000,0x0000,0x3b23,0x3138,0x0000,0x0000,
+    0x3b25,0x30e5,0x0000,0x0000,0x3b27,0x3097,0x0000,0x0000,0x3b27,0x304f,0x0000,0x0000,0x3b28,0x300c,0x0000,0x0000,
+    0x3b28,0x2f9a,0x0000,0x0000,0x3b28,0x2f26,0x0000,0x0000,0x3b27,0x2eb9,0x0000,0x0000,0x3b26,0x2e55,0x0000,0x0000,
+    0x3b24,0x2df7,0x0000,0x0000,0x3b22,0x2d9f,0x0000,0x0000,0x3b1f,0x2d4e,0x0000,0x0000,0x3b1d,0x2d04,0x0000,0x0000,
+    0x3b1a,0x2cbe,0x0000,0x0000,0x3b16,0x2c7e,0x0000,0x0000,0x3b12,0x2c41,0x0000,0x0000,0x3b0e,0x2c09,0x0000,0x0000,
+    0x3b0a,0x2ba9,0x0000,0x0000,0x3b05,0x2b47,0x0000,0x0000,0x3aff,0x2aeb,0x0000,0x0000,0x3afa,0x2a96,0x0000,0x0000,
+    0x3af4,0x2a45,0x0000,0x0000,0x3aee,0x29f9,0x0000,0x0000,0x3ae7,0x29b2,0x0000,0x0000,0x3ae1,0x2970,0x0000,0x0000,
+    0x3ada,0x2932,0x0000,0x0000,0x3ad3,0x28f8,0x0000,0x0000,0x3acc,0x28c2,0x0000,0x0000,0x3ac4,0x288e,0x0000,0x0000,
+    0x3abc,0x285e,0x0000,0x0000,0x3ab4,0x2830,0x0000,0x0000,0x3aac,0x2804,0x0000,0x0000,0x3aa4,0x27b6,0x0000,0x0000,
+    0x3c00,0x3ad1,0x0000,0x0000,0x3c00,0x3ad1,0x0000,0x0000,0x3bff,0x3ad0,0x0000,0x0000,0x3bf5,0x3ac4,0x0000,0x0000,
+    0x3be4,0x3aaf,0x0000,0x0000,0x3bc2,0x3a84,0x0000,0x0000,0x3b91,0x3a45,0x0000,0x0000,0x3b5a,0x39f8,0x0000,0x0000,
+    0x3b2a,0x39a8,0x0000,0x0000,0x3b07,0x395b,0x0000,0x0000,0x3af2,0x3915,0x0000,0x0000,0x3ae9,0x38d3,0x0000,0x0000,
+    0x3ae8,0x3895,0x0000,0x0000,0x3aec,0x3858,0x0000,0x0000,0x3af3,0x381e,0x0000,0x0000,0x3afb,0x37ca,0x0000,0x0000,
+    0x3b04,0x375b,0x0000,0x0000,0x3b0c,0x36f0,0x0000,0x0000,0x3b14,0x368a,0x0000,0x0000,0x3b1c,0x3627,0x0000,0x0000,
+    0x3b23,0x35c9,0x0000,0x0000,0x3b29,0x356f,0x0000,0x0000,0x3b2e,0x351a,0x0000,0x0000,0x3b33,0x34ca,0x0000,0x0000,
+    0x3b37,0x347e,0x0000,0x0000,0x3b3b,0x3437,0x0000,0x0000,0x3b3f,0x33e9,0x0000,0x0000,0x3b42,0x336c,0x0000,0x0000,
+    0x3b44,0x32f7,0x0000,0x0000,0x3b47,0x3289,0x0000,0x0000,0x3b49,0x3223,0x0000,0x0000,0x3b4a,0x31c3,0x0000,0x0000,
+    0x3b4c,0x316a,0x0000,0x0000,0x3b4d,0x3117,0x0000,0x0000,0x3b4d,0x30ca,0x0000,0x0000,0x3b4e,0x3082,0x0000,0x0000,
+    0x3b4e,0x303f,0x0000,0x0000,0x3b4e,0x3001,0x0000,0x0000,0x3b4e,0x2f8e,0x0000,0x0000,0x3b4d,0x2f21,0x0000,0x0000,
+    0x3b4d,0x2ebd,0x0000,0x0000,0x3b4c,0x2e5f,0x0000,0x0000,0x3b4a,0x2e08,0x0000,0x0000,0x3b49,0x2db7,0x0000,0x0000,
+    0x3b47,0x2d6c,0x0000,0x0000,0x3b46,0x2d25,0x0000,0x0000,0x3b43,0x2ce4,0x0000,0x0000,0x3b41,0x2ca7,0x0000,0x0000,
+    0x3b3f,0x2c6d,0x0000,0x0000,0x3b3c,0x2c38,0x0000,0x0000,0x3b39,0x2c06,0x0000,0x0000,0x3b37,0x2baf,0x0000,0x0000,
+    0x3b33,0x2b58,0x0000,0x0000,0x3b30,0x2b06,0x0000,0x0000,0x3b2d,0x2ab9,0x0000,0x0000,0x3b29,0x2a71,0x0000,0x0000,
+    0x3b26,0x2a2e,0x0000,0x0000,0x3b22,0x29ef,0x0000,0x0000,0x3b1e,0x29b5,0x0000,0x0000,0x3b1a,0x297f,0x0000,0x0000,
+    0x3b16,0x294c,0x0000,0x0000,0x3b12,0x291c,0x0000,0x0000,0x3b0e,0x28ef,0x0000,0x0000,0x3b0a,0x28c4,0x0000,0x0000,
+    0x3c00,0x3bf7,0x0000,0x0000,0x3b81,0x3b78,0x0000,0x0000,0x3aeb,0x3ad6,0x0000,0x0000,0x3b1c,0x3aec,0x0000,0x0000,
+    0x3b3f,0x3ae9,0x0000,0x0000,0x3b52,0x3ace,0x0000,0x0000,0x3b5e,0x3aa2,0x0000,0x0000,0x3b65,0x3a6c,0x0000,0x0000,
+    0x3b69,0x3a2d,0x0000,0x0000,0x3b6c,0x39ea,0x0000,0x0000,0x3b6e,0x39a4,0x0000,0x0000,0x3b70,0x395c,0x0000,0x0000,
+    0x3b71,0x3914,0x0000,0x0000,0x3b72,0x38ce,0x0000,0x0000,0x3b73,0x3889,0x0000,0x0000,0x3b74,0x3847,0x0000,0x0000,
+    0x3b74,0x3807,0x0000,0x0000,0x3b75,0x3795,0x0000,0x0000,0x3b75,0x3721,0x0000,0x0000,0x3b75,0x36b4,0x0000,0x0000,
+    0x3b75,0x364d,0x0000,0x0000,0x3b76,0x35eb,0x0000,0x0000,0x3b76,0x358f,0x0000,0x0000,0x3b76,0x3539,0x0000,0x0000,
+    0x3b76,0x34e7,0x0000,0x0000,0x3b76,0x349b,0x0000,0x0000,0x3b76,0x3453,0x0000,0x0000,0x3b76,0x3410,0x0000,0x0000,
+    0x3b77,0x33a3,0x0000,0x0000,0x3b77,0x332d,0x0000,0x0000,0x3b77,0x32c0,0x0000,0x0000,0x3b77,0x325a,0x0000,0x0000,
+    0x3b77,0x31fa,0x0000,0x0000,0x3b77,0x31a2,0x0000,0x0000,0x3b77,0x314f,0x0000,0x0000,0x3b77,0x3102,0x0000,0x0000,
+    0x3b77,0x30ba,0x0000,0x0000,0x3b77,0x3077,0x0000,0x0000,0x3b77,0x3039,0x0000,0x0000,0x3b77,0x2fff,0x0000,0x0000,
+    0x3b77,0x2f94,0x0000,0x0000,0x3b77,0x2f30,0x0000,0x0000,0x3b77,0x2ed4,0x0000,0x0000,0x3b77,0x2e7d,0x0000,0x0000,
+    0x3b77,0x2e2d,0x0000,0x0000,0x3b77,0x2de2,0x0000,0x0000,0x3b77,0x2d9d,0x0000,0x0000,0x3b76,0x2d5c,0x0000,0x0000,
+    0x3b76,0x2d20,0x0000,0x0000,0x3b76,0x2ce8,0x0000,0x0000,0x3b76,0x2cb4,0x0000,0x0000,0x3b76,0x2c84,0x0000,0x0000,
+    0x3b76,0x2c56,0x0000,0x0000,0x3b76,0x2c2c,0x0000,0x0000,0x3b76,0x2c05,0x0000,0x0000,0x3b76,0x2bc0,0x0000,0x0000,
+    0x3b76,0x2b7c,0x0000,0x0000,0x3b76,0x2b3c,0x0000,0x0000,0x3b76,0x2b00,0x0000,0x0000,0x3b76,0x2ac8,0x0000,0x0000,
+    0x3b75,0x2a94,0x0000,0x0000,0x3b75,0x2a63,0x0000,0x0000,0x3b75,0x2a35,0x0000,0x0000,0x3b75,0x2a0a,0x0000,0x0000,
+};
+
+#endif
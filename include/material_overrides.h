@@ -0,0 +1,149 @@
+#ifndef MATERIAL_OVERRIDES_H
+#define MATERIAL_OVERRIDES_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <gpu_memory.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// One entry of the `MaterialOverrides` uniform block in model_loading.fs (std140: every member is a 16-byte
+// slot): what replaces the authored factors of the materials carrying its tag. Only the members named in
+// `mask` apply; the authored alpha always stays.
+struct MaterialOverride
+{
+    enum { BASE_COLOR = 1, METALLIC = 2, ROUGHNESS = 4, CLEARCOAT = 8 };
+
+    glm::vec4 baseColor = glm::vec4(1.0f); // rgb
+    // x = metallic, y = roughness, z = clearcoat factor, w = clearcoat roughness (the coat only shows on
+    // materials authored with one: uncoated ones are drawn by shader variants without the lobe)
+    glm::vec4 factors = glm::vec4(0.0f);
+    glm::ivec4 mask = glm::ivec4(0);
+
+    bool operator==(const MaterialOverride &o) const { return std::memcmp(this, &o, sizeof(MaterialOverride)) == 0; }
+    bool operator!=(const MaterialOverride &o) const { return !(*this == o); }
+};
+static_assert(sizeof(MaterialOverride) == 3 * 16, "MaterialOverride must match the std140 layout in model_loading.fs");
+
+// Runtime material edits (the paint colour, metallic and roughness a customer picks) without touching any
+// model: materials are tagged at import (Mesh::materialTag, and from TAG_SHIFT in MaterialData::layers.w),
+// and the shader applies the override of their tag from this small uniform block, bound once for every
+// program at BINDING. set() uploads one 48-byte entry, and only when it changed.
+//
+// A material is tagged PAINT when its name contains one of PAINT_MATERIALS (comma separated, case
+// insensitive, default "paint"); in a file where no name matches, clearcoated materials without a base
+// colour texture are taken as the paint instead.
+class MaterialOverrides
+{
+public:
+    // tags (0 = untagged); entry tag - 1 of the block holds each one's override
+    enum Tag { NONE = 0, PAINT = 1 };
+    // matches the block in model_loading.fs
+    static const unsigned int MAX_TAGS = 4;
+    // bits of MaterialData::layers.w holding the tag (above the occlusion strength)
+    static const int TAG_SHIFT = 16;
+    // uniform buffer binding point of the `MaterialOverrides` block (see Shader::uniformBlockBinding)
+    static const GLuint BINDING = 5;
+
+    MaterialOverrides() : entries(MAX_TAGS) {}
+
+    MaterialOverrides(const MaterialOverrides &) = delete;
+    MaterialOverrides &operator=(const MaterialOverrides &) = delete;
+
+    // GL thread, once the context exists: creates the block with nothing overridden and binds it (the
+    // binding is global state, so every program sees it from then on)
+    void bind()
+    {
+        if (!ubo)
+        {
+            glGenBuffers(1, &ubo);
+            glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+            glBufferData(GL_UNIFORM_BUFFER, entries.size() * sizeof(MaterialOverride), &entries[0], GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            gpuMemory().trackBuffer(ubo, GpuMemory::DRAW_BUFFERS, entries.size() * sizeof(MaterialOverride), "material overrides");
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, ubo);
+    }
+
+    // GL thread: what the materials tagged `tag` draw with from now on; false (nothing uploaded) if it is
+    // what they already have
+    bool set(unsigned int tag, const MaterialOverride &o)
+    {
+        if (tag == NONE || tag > MAX_TAGS || entries[tag - 1] == o)
+            return false;
+        entries[tag - 1] = o;
+        if (ubo)
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+            glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)((tag - 1) * sizeof(MaterialOverride)), sizeof(MaterialOverride), &entries[tag - 1]);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        return true;
+    }
+
+    // GL thread: back to the authored materials
+    bool clear(unsigned int tag) { return set(tag, MaterialOverride()); }
+
+    const MaterialOverride &get(unsigned int tag) const { return entries[std::min(std::max(tag, 1u), MAX_TAGS) - 1]; }
+
+    void releaseGpu()
+    {
+        if (ubo)
+        {
+            gpuMemory().releaseBuffer(ubo);
+            glDeleteBuffers(1, &ubo);
+        }
+        ubo = 0;
+    }
+
+    // the tag a material named `name` gets by name alone (PAINT_MATERIALS)
+    static unsigned int tagOf(const std::string &name)
+    {
+        std::string lower(name);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        const std::vector<std::string> &paint = paintNames();
+        for (size_t i = 0; i < paint.size(); ++i)
+            if (lower.find(paint[i]) != std::string::npos)
+                return PAINT;
+        return NONE;
+    }
+
+private:
+    std::vector<MaterialOverride> entries;
+    GLuint ubo = 0;
+
+    static const std::vector<std::string> &paintNames()
+    {
+        static const std::vector<std::string> names = []() {
+            std::vector<std::string> out;
+            const char *env = std::getenv("PAINT_MATERIALS");
+            std::string list = env && *env ? env : "paint";
+            std::transform(list.begin(), list.end(), list.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            size_t start = 0;
+            while (start <= list.size())
+            {
+                const size_t comma = std::min(list.find(',', start), list.size());
+                if (comma > start)
+                    out.push_back(list.substr(start, comma - start));
+                start = comma + 1;
+            }
+            return out;
+        }();
+        return names;
+    }
+};
+
+// process-wide, like the binding point it owns
+inline MaterialOverrides &materialOverrides()
+{
+    static MaterialOverrides overrides;
+    return overrides;
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <gpu_memory.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// One entry of the `Materials` uniform block in model_loading.fs (std140: every member is a 16-byte slot).
+struct MaterialData
+{
+    // bits of `layers.w`: slots whose UV transform isn't the identity (the shader skips the others), and
+    // from OCCLUSION_SHIFT up the occlusion strength in 1/255 steps when the metallicRoughness texture
+    // carries occlusion in R (ORM packing; 0 = none)
+    enum { UV_DIFFUSE = 1, UV_NORMAL = 2, UV_METALLIC_ROUGHNESS = 4, OCCLUSION_SHIFT = 8 };
+
+    glm::vec4 baseColorFactor = glm::vec4(1.0f);
+    // x = metallic, y = roughness, z = alpha test cutoff (0 = none), w = 1 if alpha blends (else opaque)
+    glm::vec4 factors = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+    // layer of the diffuse / normal / metallicRoughness texture in its bound array (-1 = none), w = UV_* bits
+    glm::ivec4 layers = glm::ivec4(-1, -1, -1, 0);
+    // KHR_texture_transform per slot, precomputed as uv' = offset + M * uv (M = Texture::uvMatrix, column-major)
+    glm::vec4 diffuseUV = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec4 normalUV = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec4 metallicRoughnessUV = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+    // xy = diffuse offset, zw = normal offset
+    glm::vec4 uvOffsets = glm::vec4(0.0f);
+    // xy = metallicRoughness offset, z = clearcoat factor (0 = no coat), w = clearcoat roughness
+    glm::vec4 uvOffsetsMR = glm::vec4(0.0f);
+    // xyz = KHR_materials_specular colour * factor (dielectric F0 = 0.04 * xyz), w = KHR_materials_transmission
+    // factor (0 = opaque behind the surface)
+    glm::vec4 specularTransmission = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+};
+static_assert(sizeof(MaterialData) == 9 * 16, "MaterialData must match the std140 layout in model_loading.fs");
+
+// Per-model table of distinct materials, uploaded once into a uniform buffer. Draws pick their entry
+// through a per-vertex material index, so a multi-draw can span many materials.
+class MaterialTable
+{
+public:
+    // matches MAX_MATERIALS in model_loading.fs (112 * 144 bytes fits the 16 KiB minimum block size)
+    static const unsigned int MAX_MATERIALS = 112;
+    // uniform buffer binding point of the `Materials` block (see Shader::uniformBlockBinding)
+    static const GLuint BINDING = 0;
+
+    MaterialTable() {}
+    ~MaterialTable() { release(); }
+
+    MaterialTable(const MaterialTable &) = delete;
+    MaterialTable &operator=(const MaterialTable &) = delete;
+
+    // index of `m`, adding it if no identical entry exists
+    unsigned int add(const MaterialData &m)
+    {
+        std::string key((const char *)&m, sizeof(MaterialData));
+        std::map<std::string, unsigned int>::const_iterator it = lookup.find(key);
+        if (it != lookup.end())
+            return it->second;
+        unsigned int index = (unsigned int)entries.size();
+        entries.push_back(m);
+        lookup[key] = index;
+        return index;
+    }
+
+    size_t size() const { return entries.size(); }
+    const MaterialData &entry(size_t i) const { return entries[i]; }
+    bool fits() const { return entries.size() <= MAX_MATERIALS; }
+
+    // GL thread: creates the uniform buffer (a full MAX_MATERIALS block, as the shader declares it)
+    void upload()
+    {
+        if (!ubo)
+            glGenBuffers(1, &ubo);
+        std::vector<MaterialData> block(MAX_MATERIALS);
+        std::copy(entries.begin(), entries.begin() + std::min(entries.size(), block.size()), block.begin());
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferData(GL_UNIFORM_BUFFER, block.size() * sizeof(MaterialData), &block[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(ubo, GpuMemory::DRAW_BUFFERS, block.size() * sizeof(MaterialData), "material table");
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    bool ready() const { return ubo != 0; }
+
+    void bind() const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, ubo);
+    }
+
+    void release()
+    {
+        if (ubo)
+        {
+            gpuMemory().releaseBuffer(ubo);
+            glDeleteBuffers(1, &ubo);
+        }
+        ubo = 0;
+        entries.clear();
+        lookup.clear();
+    }
+
+private:
+    std::vector<MaterialData> entries;
+    std::map<std::string, unsigned int> lookup;
+    GLuint ubo = 0;
+};
+
+#endif
@@ -5,296 +5,886 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
+#include <async_log.h>
 #include <shader.h>
+#include <render_debug.h>
+#include <draw_stats.h>
+#include <gl_backend.h>
+#include <gl_state.h>
+#include <geometry_kernels.h>
+#include <vertex_format.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 using namespace std;
 
-#define MAX_BONE_INFLUENCE 4
-
-struct Vertex {
-    // position
-    glm::vec3 Position;
-    // normal
-    glm::vec3 Normal;
-    // texCoords
-    glm::vec2 TexCoords;
-    // tangent
-    glm::vec3 Tangent;
-    // bitangent
-    glm::vec3 Bitangent;
-	//bone indexes which will influence this vertex
-	int m_BoneIDs[MAX_BONE_INFLUENCE];
-	//weights from each bone
-	float m_Weights[MAX_BONE_INFLUENCE];
+// load-time vertices (full precision, CPU side only; the GPU gets PackedVertex), one array per attribute.
+// Every import pass reads one or two attributes (bounds, welding, cache and overdraw order, meshlets and
+// simplification only positions), so each walks a dense stream instead of striding over whole vertices;
+// the attributes only come together when Model::uploadGeometry packs them.
+struct VertexStreams {
+    vector<glm::vec3> positions;
+    vector<glm::vec3> normals;
+    vector<glm::vec2> texCoords;
+    // xyz: tangent, w: handedness (+-1, glTF TANGENT convention); bitangent = cross(normal, tangent) * w.
+    // Empty for meshes whose material has no normal map: nothing samples their tangent frame
+    vector<glm::vec4> tangents;
+    // skinned meshes (glTF JOINTS_0/WEIGHTS_0): four palette slots per vertex (NodeAnimation) and their
+    // weights. Empty for everything else
+    vector<glm::uvec4> joints;
+    vector<glm::vec4> weights;
+
+    size_t size() const { return positions.size(); }
+    bool empty() const { return positions.empty(); }
+
+    bool hasTangents() const { return !tangents.empty(); }
+    bool hasSkin() const { return !joints.empty(); }
+
+    // new vertices are zero; without `withTangents` the tangent stream stays empty
+    void resize(size_t count, bool withTangents = true)
+    {
+        positions.resize(count, glm::vec3(0.0f));
+        normals.resize(count, glm::vec3(0.0f));
+        texCoords.resize(count, glm::vec2(0.0f));
+        if (withTangents)
+            tangents.resize(count, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        else
+            tangents.clear();
+        joints.clear();
+        weights.clear();
+    }
+
+    // vertex k becomes vertex source[k] (source may drop or repeat vertices)
+    void gather(const vector<unsigned int> &source)
+    {
+        gatherStream(positions, source);
+        gatherStream(normals, source);
+        gatherStream(texCoords, source);
+        if (hasTangents())
+            gatherStream(tangents, source);
+        if (hasSkin()) {
+            gatherStream(joints, source);
+            gatherStream(weights, source);
+        }
+    }
+
+    // appends `o`'s vertices (both with or both without tangents and skin)
+    void append(const VertexStreams &o)
+    {
+        positions.insert(positions.end(), o.positions.begin(), o.positions.end());
+        normals.insert(normals.end(), o.normals.begin(), o.normals.end());
+        texCoords.insert(texCoords.end(), o.texCoords.begin(), o.texCoords.end());
+        tangents.insert(tangents.end(), o.tangents.begin(), o.tangents.end());
+        joints.insert(joints.end(), o.joints.begin(), o.joints.end());
+        weights.insert(weights.end(), o.weights.begin(), o.weights.end());
+    }
+
+    // frees the memory (clear() alone keeps it)
+    void release()
+    {
+        VertexStreams().swap(*this);
+    }
+
+    void swap(VertexStreams &o)
+    {
+        positions.swap(o.positions);
+        normals.swap(o.normals);
+        texCoords.swap(o.texCoords);
+        tangents.swap(o.tangents);
+        joints.swap(o.joints);
+        weights.swap(o.weights);
+    }
+
+private:
+    template <class T>
+    static void gatherStream(vector<T> &stream, const vector<unsigned int> &source)
+    {
+        vector<T> gathered(source.size());
+        for (size_t k = 0; k < source.size(); ++k)
+            gathered[k] = stream[source[k]];
+        stream.swap(gathered);
+    }
+};
+
+// GPU vertex, 20 bytes instead of 56 (88 with the unused bone slots it replaced). Decoded in model_loading.vs.
+// Skinned meshes add their joints and weights as a second stream (SkinVertex) rather than growing this
+// struct for every vertex.
+struct PackedVertex {
+    // xyz: unorm16 position inside the owning model's AABB; w: bitangent sign in bit 15 (set = +1), baked
+    // ambient occlusion in bits 0-14 (unorm15, 32767 = unoccluded; only car_cook bakes it)
+    uint16_t Position[4];
+    // xy: octahedral normal, zw: octahedral tangent (snorm16)
+    int16_t NormalTangent[4];
+    // half-float texCoords
+    uint16_t TexCoords[2];
+};
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex must stay tightly packed");
+
+// second vertex stream of models with skinned meshes (attributes 13/14 of model_loading.vs): four palette
+// slots and their unorm8 weights (summing to 255). Zero for the model's unskinned vertices
+struct SkinVertex {
+    uint8_t Joints[4];
+    uint8_t Weights[4];
+};
+static_assert(sizeof(SkinVertex) == 8, "SkinVertex must stay tightly packed");
+
+// the GPU streams as VertexFormats (model_loading.vs declares the locations). Their binding points on the
+// direct state access path are each numbered after the format's first attribute, so a glVertexAttribPointer
+// for another attribute of the same VAO never rebinds one of them.
+
+// quantized position + bitangent sign, octahedral normal + tangent, texture coords
+struct PackedVertexFormat
+{
+    typedef PackedVertex Vertex;
+    static const GLuint BINDING = 0;
+    static const GLuint DIVISOR = 0;
+    static const int COUNT = 3;
+    static const VertexAttribute *attributes()
+    {
+        static const VertexAttribute table[COUNT] = {
+            {0, 4, GL_UNSIGNED_SHORT, GL_TRUE, false, offsetof(PackedVertex, Position)},
+            {1, 4, GL_SHORT, GL_TRUE, false, offsetof(PackedVertex, NormalTangent)},
+            {2, 2, GL_HALF_FLOAT, GL_FALSE, false, offsetof(PackedVertex, TexCoords)}};
+        return table;
+    }
+};
+
+// the position (and ambient occlusion) alone: the depth pre-pass and the visibility buffer fetch 8 of
+// the 20 bytes per vertex
+struct PackedPositionFormat
+{
+    typedef PackedVertex Vertex;
+    static const GLuint BINDING = 0;
+    static const GLuint DIVISOR = 0;
+    static const int COUNT = 1;
+    static const VertexAttribute *attributes() { return PackedVertexFormat::attributes(); }
 };
 
+// per-vertex MaterialTable index (or, for the visibility buffer, mesh index)
+struct MaterialIndexFormat
+{
+    typedef uint16_t Vertex;
+    static const GLuint BINDING = 3;
+    static const GLuint DIVISOR = 0;
+    static const int COUNT = 1;
+    static const VertexAttribute *attributes()
+    {
+        static const VertexAttribute table[COUNT] = {{3, 1, GL_UNSIGNED_SHORT, GL_FALSE, true, 0}};
+        return table;
+    }
+};
+
+// joints and weights of skinned models
+struct SkinVertexFormat
+{
+    typedef SkinVertex Vertex;
+    static const GLuint BINDING = 13;
+    static const GLuint DIVISOR = 0;
+    static const int COUNT = 2;
+    static const VertexAttribute *attributes()
+    {
+        static const VertexAttribute table[COUNT] = {
+            {13, 4, GL_UNSIGNED_BYTE, GL_FALSE, true, offsetof(SkinVertex, Joints)},
+            {14, 4, GL_UNSIGNED_BYTE, GL_TRUE, false, offsetof(SkinVertex, Weights)}};
+        return table;
+    }
+};
+
+namespace VertexPacking
+{
+    // octahedral mapping of a unit vector onto [-1,1]^2
+    inline glm::vec2 octEncode(glm::vec3 n)
+    {
+        n /= (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z));
+        glm::vec2 p(n.x, n.y);
+        if (n.z < 0.0f)
+        {
+            p = glm::vec2((1.0f - std::fabs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                          (1.0f - std::fabs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return p;
+    }
+    inline int16_t snorm16(float v)
+    {
+        v = glm::clamp(v, -1.0f, 1.0f);
+        return (int16_t)std::floor(v * 32767.0f + 0.5f);
+    }
+    // a unit normal as PackedVertex stores it, octahedral snorm16 x in the low half and y in the high one
+    inline uint32_t packNormal(const glm::vec3 &n)
+    {
+        const glm::vec2 o = octEncode(n);
+        return (uint32_t)(uint16_t)snorm16(o.x) | (uint32_t)(uint16_t)snorm16(o.y) << 16;
+    }
+    inline uint16_t unorm16(float v)
+    {
+        return (uint16_t)std::floor(glm::clamp(v, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+    // handedness of a tangent frame, as the w of a glTF tangent: -1 when the bitangent is mirrored
+    // against cross(n, t)
+    inline float tangentSign(const glm::vec3 &n, const glm::vec3 &t, const glm::vec3 &b)
+    {
+        return glm::dot(glm::cross(n, t), b) < 0.0f ? -1.0f : 1.0f;
+    }
+    // any unit vector perpendicular to n (for meshes without UVs or a normal map, which get no tangents)
+    inline glm::vec3 anyTangent(const glm::vec3 &n)
+    {
+        glm::vec3 axis = std::fabs(n.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        return glm::normalize(glm::cross(axis, n));
+    }
+    inline bool usable(const glm::vec3 &v)
+    {
+        float l = glm::dot(v, v);
+        return l > 1e-12f && l == l;
+    }
+
+    // extent used to quantize positions inside [boundsMin, boundsMax]; flat axes keep a non-zero scale
+    // so packing doesn't divide by zero
+    inline glm::vec3 quantizationExtent(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+        glm::vec3 extent = boundsMax - boundsMin;
+        for (int c = 0; c < 3; ++c)
+            if (extent[c] <= 0.0f)
+                extent[c] = 1.0f;
+        return extent;
+    }
+
+    // packs vertex `i` of `v`; positions are stored relative to `boundsMin` in units of `boundsExtent`, with
+    // `occlusion` (1 = open) beside the handedness
+    inline PackedVertex pack(const VertexStreams &v, size_t i, const glm::vec3 &boundsMin, const glm::vec3 &boundsExtent,
+                             float occlusion = 1.0f)
+    {
+        PackedVertex p;
+        // meshes without a tangent stream get an arbitrary frame around the normal (they have no normal map)
+        const glm::vec4 tangent = v.hasTangents() ? v.tangents[i] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        const glm::vec3 &position = v.positions[i], &normal = v.normals[i], tangentXyz(tangent);
+        glm::vec3 q = (position - boundsMin) / boundsExtent;
+        p.Position[0] = unorm16(q.x);
+        p.Position[1] = unorm16(q.y);
+        p.Position[2] = unorm16(q.z);
+        glm::vec3 n = usable(normal) ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+        // Gram-Schmidt so the shader can rebuild the bitangent from cross(N, T)
+        glm::vec3 t = usable(tangentXyz) ? tangentXyz - n * glm::dot(n, tangentXyz) : glm::vec3(0.0f);
+        t = usable(t) ? glm::normalize(t) : anyTangent(n);
+        p.Position[3] = (uint16_t)((tangent.w < 0.0f ? 0 : 0x8000) | (int)std::floor(glm::clamp(occlusion, 0.0f, 1.0f) * 32767.0f + 0.5f));
+        glm::vec2 on = octEncode(n), ot = octEncode(t);
+        p.NormalTangent[0] = snorm16(on.x);
+        p.NormalTangent[1] = snorm16(on.y);
+        p.NormalTangent[2] = snorm16(ot.x);
+        p.NormalTangent[3] = snorm16(ot.y);
+        p.TexCoords[0] = (uint16_t)glm::packHalf1x16(v.texCoords[i].x);
+        p.TexCoords[1] = (uint16_t)glm::packHalf1x16(v.texCoords[i].y);
+        return p;
+    }
+
+    // skin stream of vertex `i` of `v` (zero without one): weights renormalized to 255 in unorm8, the
+    // rounding remainder going to the heaviest joint
+    inline SkinVertex packSkin(const VertexStreams &v, size_t i)
+    {
+        SkinVertex s;
+        std::memset(&s, 0, sizeof(s));
+        if (!v.hasSkin())
+            return s;
+        const glm::vec4 w = glm::max(v.weights[i], glm::vec4(0.0f));
+        const float sum = w.x + w.y + w.z + w.w;
+        int total = 0, heaviest = 0;
+        for (int k = 0; k < 4; ++k) {
+            s.Joints[k] = (uint8_t)std::min(v.joints[i][k], 255u);
+            s.Weights[k] = (uint8_t)(sum > 0.0f ? (int)std::floor(w[k] / sum * 255.0f + 0.5f) : (k == 0 ? 255 : 0));
+            total += s.Weights[k];
+            if (w[k] > w[heaviest])
+                heaviest = k;
+        }
+        s.Weights[heaviest] = (uint8_t)glm::clamp((int)s.Weights[heaviest] + 255 - total, 0, 255);
+        return s;
+    }
+}
+
 struct Texture {
+    // what the texture feeds in the material. The first BOUND_SLOTS are the ones Mesh binds (and their
+    // values are its texture units); the others are imported but not sampled.
+    enum Slot : unsigned char {
+        DIFFUSE,
+        NORMAL,
+        METALLIC_ROUGHNESS,
+        SPECULAR,
+        HEIGHT,
+        OTHER
+    };
+    static const int BOUND_SLOTS = 3;
+
     unsigned int id;
-    string type;
+    Slot slot = OTHER;
     string path;
     // UV transform from glTF KHR_texture_transform (offset, scale, rotation)
     glm::vec2 uvOffset = glm::vec2(0.0f, 0.0f);
     glm::vec2 uvScale = glm::vec2(1.0f, 1.0f);
     float uvRotation = 0.0f;
+
+    // uvOffset + R(uvRotation) * (uvScale * uv) folded into a 2x2 matrix, packed column-major into a vec4
+    // (xy = first column) so shaders apply it without sin/cos
+    glm::vec4 uvMatrix() const
+    {
+        float c = std::cos(uvRotation), s = std::sin(uvRotation);
+        return glm::vec4(c * uvScale.x, -s * uvScale.x, s * uvScale.y, c * uvScale.y);
+    }
+    bool hasUVTransform() const
+    {
+        return uvOffset != glm::vec2(0.0f) || uvScale != glm::vec2(1.0f) || uvRotation != 0.0f;
+    }
+
+    // the shader's sampler prefix of a slot, also the name cooked files store
+    static const char *slotName(Slot slot)
+    {
+        static const char *const names[] = {"texture_diffuse", "texture_normal", "texture_metallicRoughness", "texture_specular", "texture_height", "texture_other"};
+        return names[slot];
+    }
+    static Slot slotFromName(const string &name)
+    {
+        for (int s = DIFFUSE; s < OTHER; ++s)
+            if (name == slotName((Slot)s))
+                return (Slot)s;
+        return OTHER;
+    }
 };
 
 class Mesh {
 public:
     // mesh Data
-    vector<Vertex>       vertices;
+    VertexStreams        vertices;
     vector<unsigned int> indices;
     vector<Texture>      textures;
-    unsigned int VAO;
-    // whether this mesh should be treated as transparent (draw in second pass)
+    // geometry lives in the owning Model's shared buffers: VAO of that buffer plus this mesh's range in it
+    unsigned int VAO = 0;
+    int baseVertex = 0;
+    unsigned int firstIndex = 0;
+    unsigned int indexCount = 0;
+    // bytes per index in the shared element buffer: 2 when every mesh of the model has at most 65536
+    // vertices (indices are relative to baseVertex), else 4
+    unsigned int indexSize = 4;
+    // simplified index ranges in the shared index buffer (same vertices), finest first; lods[0] is the full
+    // mesh (firstIndex/indexCount). `error` bounds how far the level strays from the full mesh (model units).
+    struct Lod
+    {
+        unsigned int firstIndex;
+        unsigned int indexCount;
+        float error;
+    };
+    vector<Lod> lods;
+    // CPU indices of lods[1..] until uploaded (built by Model at import, freed with the vertices)
+    vector<vector<unsigned int>> lodIndices;
+    vector<float> lodErrors;
+    // clusters of at most 64 vertices / 124 triangles partitioning the full index list (opaque meshes), for
+    // per-cluster culling. `firstIndex` is relative to the mesh's firstIndex, `sphere` bounds the cluster
+    // (xyz centre, w radius) and `cone` holds the axis of its normal cone (xyz) and the cutoff used by the
+    // back-face test (w; 1 = never culled). Kept after releaseCpuGeometry (they are small).
+    struct Meshlet
+    {
+        unsigned int firstIndex;
+        unsigned int indexCount;
+        glm::vec4 sphere;
+        glm::vec4 cone;
+    };
+    vector<Meshlet> meshlets;
+    // model-from-mesh transforms of a mesh that several scene nodes reference (vertices then stay in the
+    // mesh's own space and it is drawn instanced); empty for meshes baked into model space. The bounds and
+    // centroid below cover all instances. `firstInstance` is the mesh's first matrix in the owning Model's
+    // instance buffer (0 = the identity shared by every non-instanced mesh).
+    vector<glm::mat4> instances;
+    unsigned int firstInstance = 0;
+    // scene node of each instance (Model's TransformHierarchy, -1 = fixed), and the mesh-space bounds the
+    // instance bounds are rebuilt from when a node moves
+    vector<int> instanceNodes;
+    glm::vec3 localBoundsMin = glm::vec3(0.0f);
+    glm::vec3 localBoundsMax = glm::vec3(0.0f);
+    glm::vec3 localCentroid = glm::vec3(0.0f);
+    // skinned meshes: the owning Model's NodeAnimation skin (-1 = not skinned). The vertices are in bind
+    // pose and the local bounds above hold its AABB, which the bounds are rebuilt from as the joints move.
+    // Set through setSkin().
+    int skin = -1;
+    // glTF alphaMode: OPAQUE ignores alpha, MASK discards below alphaCutoff and is opaque otherwise, BLEND
+    // is drawn blended in the transparent pass (`transparent`). Set through setAlphaMode().
+    enum AlphaMode { ALPHA_OPAQUE = 0, ALPHA_MASK = 1, ALPHA_BLEND = 2 };
+    AlphaMode alphaMode = ALPHA_OPAQUE;
+    float alphaCutoff = 0.5f;
+    // whether this mesh should be treated as transparent (draw in second pass); alphaMode == ALPHA_BLEND
     bool transparent = false;
+    // transparent, but order independent (glass, lamp covers): with OIT=1 it's composited through
+    // WeightedOIT instead of being sorted
+    bool weightedBlend = false;
 
     // baseColorFactor (r,g,b,a) applied to sampled baseColor
     glm::vec4 baseColorFactor = glm::vec4(1.0f);
     // metallic / roughness factors (per-mesh defaults; may be overridden by textures)
     float metallicFactor = 1.0f;
     float roughnessFactor = 1.0f;
-    // centroid of mesh in model space (computed at load time)
+    // KHR_materials_clearcoat strength (0 = no coat) and roughness of the coat lobe. Set through setClearcoat().
+    float clearcoatFactor = 0.0f;
+    float clearcoatRoughnessFactor = 0.0f;
+    // KHR_materials_transmission: share of the diffuse lobe replaced by the scene behind the surface (0 =
+    // none). Set through setTransmission().
+    float transmissionFactor = 0.0f;
+    // KHR_materials_specular: scales the dielectric reflectance (F0 = 0.04 * colour * factor)
+    float specularFactor = 1.0f;
+    glm::vec3 specularColorFactor = glm::vec3(1.0f);
+    // glTF occlusionTexture packed into the metallicRoughness texture's R channel (ORM): its strength, 0 when
+    // there's none or it's a texture of its own (not sampled)
+    float occlusionStrength = 0.0f;
+    // KHR_materials_variants: the glTF material of each of the owning Model's material variants (-1 = this
+    // mesh's own); empty if the mesh's primitive has no mappings
+    vector<int> variantMaterials;
+    // MaterialOverrides tag of the material (0 = none): runtime paint edits apply to it
+    unsigned int materialTag = 0;
+    // MeshRegions::Region of the mesh (0 = exterior), from its node and mesh names
+    unsigned int region = 0;
+    // hierarchy node of the configurable part (CONFIG_PARTS) the mesh belongs to, -1 = none: Model::setPartVisible()
+    // shows and hides those meshes as one
+    int partNode = -1;
+    // centroid and AABB of mesh in model space plus vertex count (computed at load time, valid after
+    // releaseCpuGeometry())
     glm::vec3 centroid = glm::vec3(0.0f);
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    // radius of the bounding sphere around the AABB centre (frustum culling uses both bounds)
+    float boundingRadius = 0.0f;
+    unsigned int vertexCount = 0;
+    // UV units per model unit over the mesh's surface (sqrt of UV area / surface area), 0 without UVs;
+    // with a texture's width and the projection scale it gives the finest mip level the view needs
+    float uvDensity = 0.0f;
 
     // constructor
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, glm::vec4 baseColorFactor = glm::vec4(1.0f), bool transparent = false, float metallicFactor = 1.0f, float roughnessFactor = 1.0f)
+    Mesh(VertexStreams vertices, vector<unsigned int> indices, vector<Texture> textures, glm::vec4 baseColorFactor = glm::vec4(1.0f), bool transparent = false, float metallicFactor = 1.0f, float roughnessFactor = 1.0f)
+        : vertices(std::move(vertices)), indices(std::move(indices)), textures(std::move(textures)),
+          alphaMode(transparent ? ALPHA_BLEND : ALPHA_OPAQUE), transparent(transparent), baseColorFactor(baseColorFactor), metallicFactor(metallicFactor), roughnessFactor(roughnessFactor)
     {
-        this->vertices = vertices;
-        this->indices = indices;
-        this->textures = textures;
-        this->baseColorFactor = baseColorFactor;
-        this->transparent = transparent;
-        this->metallicFactor = metallicFactor;
-        this->roughnessFactor = roughnessFactor;
-
-        // now that we have all the required data, set the vertex buffers and its attribute pointers.
-        setupMesh();
+        this->indexCount = static_cast<unsigned int>(this->indices.size());
+        computeBounds();
+        computeUvDensity();
+        // GPU upload happens in Model::uploadGeometry, which packs every mesh into one buffer pair
+        resolveMaterialKey();
     }
 
-    // render the mesh
+    // move-only: the vertex/index vectors can be large and must never be copied by accident.
+    // (GL buffers belong to the owning Model; a Mesh only references them.)
+    Mesh(const Mesh &) = delete;
+    Mesh &operator=(const Mesh &) = delete;
+    Mesh(Mesh &&) = default;
+    Mesh &operator=(Mesh &&) = default;
+
+    // render the mesh (material + geometry). Model::Draw calls the two halves separately so that
+    // consecutive meshes sharing a material skip the material setup.
     void Draw(Shader &shader) 
     {
         // Ensure shader program is active before setting uniforms
         shader.use();
-        // local helper to check GL errors immediately and print context
-        auto localGlCheck = [&](const char *where) {
-            GLenum e = glGetError();
-            if (e != GL_NO_ERROR) {
-                GLint curProg = 0; glGetIntegerv(GL_CURRENT_PROGRAM, &curProg);
-                GLint vao = 0; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
-                GLint ebo = 0; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ebo);
-                GLint activeTex = 0; glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTex);
-                GLint maxTex = 0; glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTex);
-                std::cerr << "[Mesh Debug][GL ERROR] 0x" << std::hex << e << std::dec << " at " << where << "\n";
-                std::cerr << "  shader.ID=" << shader.ID << " GL_CURRENT_PROGRAM=" << curProg << "\n";
-                std::cerr << "  VAO=" << vao << " EBO=" << ebo << " ACTIVE_TEXTURE=0x" << std::hex << activeTex << std::dec << " MAX_TEX=" << maxTex << "\n";
-                int inspect = std::min(maxTex, 8);
-                for (int u = 0; u < inspect; ++u) {
-                    GLenum unit = GL_TEXTURE0 + u;
-                    glActiveTexture(unit);
-                    GLint bound2D = 0; glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound2D);
-                    std::cerr << "    Unit " << u << " bound2D=" << bound2D << "\n";
-                }
-                // restore active texture
-                glActiveTexture(activeTex);
-            }
-        };
-        // check immediately after using program
-        localGlCheck("after shader.use()");
-        // debug: print current program id
-        static bool printedMeshDebug = false;
-        // throttle GL error prints to avoid log floods that can hang the host
-        static int mesh_gl_error_prints = 0;
-        const int MESH_GL_ERROR_PRINT_LIMIT = 50;
-        GLint curProg = 0;
-        glGetIntegerv(GL_CURRENT_PROGRAM, &curProg);
-        // Print pairing of shader.ID and current program once for diagnosis
-        if (!printedMeshDebug) {
-            std::cout << "[Mesh Debug] shader.ID=" << shader.ID << " GL_CURRENT_PROGRAM=" << curProg << std::endl;
+        bindMaterial(shader);
+        drawGeometry(shader);
+    }
+
+    // frees the CPU copies of vertices/indices once they live in GPU buffers; bounds and counts stay valid
+    void releaseCpuGeometry()
+    {
+        vertices.release();
+        vector<unsigned int>().swap(indices);
+        vector<vector<unsigned int>>().swap(lodIndices);
+    }
+    bool hasCpuGeometry() const { return !vertices.empty(); }
+
+    // before the upload: takes `other`'s triangles (same material, same space) into this mesh. The bounds
+    // cover both; the texture streaming density keeps the finer of the two.
+    void appendGeometry(Mesh &&other)
+    {
+        const unsigned int base = static_cast<unsigned int>(vertices.size());
+        vertices.append(other.vertices);
+        indices.reserve(indices.size() + other.indices.size());
+        for (size_t i = 0; i < other.indices.size(); ++i)
+            indices.push_back(base + other.indices[i]);
+        indexCount = static_cast<unsigned int>(indices.size());
+        const float density = std::max(uvDensity, other.uvDensity);
+        computeBounds();
+        uvDensity = density;
+        other.releaseCpuGeometry();
+    }
+
+    // rewrites every Texture::id through `map` (loader tickets -> GL names) and refreshes materialKey()
+    template <class F>
+    void remapTextureIds(F map)
+    {
+        for (size_t i = 0; i < textures.size(); ++i)
+            textures[i].id = map(textures[i].id);
+        resolveMaterialKey();
+    }
+
+    // GL ids of the textures actually sampled by Draw (diffuse, normal, metallicRoughness), resolved
+    // once at load (0 = none). Used as the sort key for the draw list.
+    struct MaterialKey
+    {
+        unsigned int diffuse, normal, metallicRoughness;
+        bool operator==(const MaterialKey &o) const { return diffuse == o.diffuse && normal == o.normal && metallicRoughness == o.metallicRoughness; }
+        bool operator<(const MaterialKey &o) const
+        {
+            if (diffuse != o.diffuse) return diffuse < o.diffuse;
+            if (normal != o.normal) return normal < o.normal;
+            return metallicRoughness < o.metallicRoughness;
+        }
+    };
+    const MaterialKey &materialKey() const { return matKey; }
+    // switches the alpha handling (and with it the shader variant and the pass the mesh is drawn in)
+    void setAlphaMode(AlphaMode mode, float cutoff = 0.5f)
+    {
+        alphaMode = mode;
+        alphaCutoff = cutoff;
+        transparent = mode == ALPHA_BLEND;
+        resolveMaterialKey();
+    }
+    // coats the material (factor > 0) with a clear dielectric layer, its own shader variant
+    void setClearcoat(float factor, float roughness)
+    {
+        clearcoatFactor = factor;
+        clearcoatRoughnessFactor = roughness;
+        resolveMaterialKey();
+    }
+    void setTransmission(float factor)
+    {
+        transmissionFactor = factor;
+        resolveMaterialKey();
+    }
+    // skins the mesh with palette slots from its skin stream (the SKINNED variant)
+    void setSkin(int index)
+    {
+        skin = index;
+        resolveMaterialKey();
+    }
+    void setSpecular(float factor, const glm::vec3 &color)
+    {
+        specularFactor = factor;
+        specularColorFactor = color;
+    }
+    // Shader::Feature bits of the model_loading variant that draws this mesh
+    unsigned int shaderFeatures() const { return features; }
+    bool sameMaterial(const Mesh &o) const
+    {
+        return matKey == o.matKey && baseColorFactor == o.baseColorFactor && metallicFactor == o.metallicFactor && roughnessFactor == o.roughnessFactor
+            && alphaMode == o.alphaMode && alphaCutoff == o.alphaCutoff
+            && clearcoatFactor == o.clearcoatFactor && clearcoatRoughnessFactor == o.clearcoatRoughnessFactor
+            && transmissionFactor == o.transmissionFactor && specularFactor == o.specularFactor
+            && specularColorFactor == o.specularColorFactor && occlusionStrength == o.occlusionStrength
+            && sameUVTransform(boundTexture(Texture::DIFFUSE), o.boundTexture(Texture::DIFFUSE))
+            && sameUVTransform(boundTexture(Texture::NORMAL), o.boundTexture(Texture::NORMAL))
+            && sameUVTransform(boundTexture(Texture::METALLIC_ROUGHNESS), o.boundTexture(Texture::METALLIC_ROUGHNESS));
+    }
+    // texture bound to one of the first Texture::BOUND_SLOTS slots (NULL = none)
+    const Texture *boundTexture(Texture::Slot slot) const { return slots[slot] == NO_TEXTURE ? 0 : &textures[slots[slot]]; }
+    const Texture *diffuseTexture() const { return boundTexture(Texture::DIFFUSE); }
+    const Texture *normalTexture() const { return boundTexture(Texture::NORMAL); }
+    const Texture *metallicRoughnessTexture() const { return boundTexture(Texture::METALLIC_ROUGHNESS); }
+    unsigned int vertexArray() const { return VAO; }
+    // byte offset of this mesh's first index in the shared element buffer
+    const void *indexOffset() const { return (const void *)(size_t)(firstIndex * indexSize); }
+    GLenum indexType() const { return indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+
+    // attribute layout of PackedVertex in `vao`, reading `buffer` from byte `base` (the model's vertices
+    // in a GeometryArena range). The bind path leaves `vao` bound, and `buffer` as the array buffer.
+    static void setupVertexFormat(GLuint vao, GLuint buffer, size_t base = 0)
+    {
+        VertexFormats::setup<PackedVertexFormat>(vao, buffer, base);
+    }
+
+    // per-vertex MaterialTable index (uint16, attribute 3) of `vao` from `buffer`
+    static void setupMaterialIndexFormat(GLuint vao, GLuint buffer)
+    {
+        VertexFormats::setup<MaterialIndexFormat>(vao, buffer);
+    }
+
+    // attribute layout of SkinVertex (joints at 13, weights at 14) of `vao` from the skin stream `buffer`
+    static void setupSkinFormat(GLuint vao, GLuint buffer)
+    {
+        VertexFormats::setup<SkinVertexFormat>(vao, buffer);
+    }
+
+    // inverse-transpose of the upper 3x3 of `m`: transforms normals/tangents under `m`, also when it scales
+    // non-uniformly. Computed on the CPU once per draw or instance, never per vertex.
+    static glm::mat3 normalMatrix(const glm::mat4 &m)
+    {
+        return glm::transpose(glm::inverse(glm::mat3(m)));
+    }
+
+    // one entry of an instance buffer: the transform, its normal matrix and the instance's look
+    // (instanceVariation(); zero = as authored)
+    struct InstanceTransform
+    {
+        glm::mat4 world;
+        glm::mat3 normal;
+        glm::uvec3 variation;
+    };
+    static_assert(sizeof(InstanceTransform) == 28 * 4, "InstanceTransform must match the placement stride in scene_cull.comp");
+
+    static InstanceTransform instanceTransform(const glm::mat4 &m, const glm::uvec3 &variation = glm::uvec3(0))
+    {
+        InstanceTransform t = {m, normalMatrix(m), variation};
+        return t;
+    }
+
+    // per-instance look of one copy in a fleet, as model_loading.fs unpacks it: `paint` (linear RGB) replaces
+    // the base colour of the materials tagged `tag` (MaterialOverrides::PAINT, 0 = keep the authored one),
+    // `dirt` (0-1) dulls every material of the copy in a pattern picked by `seed`
+    static glm::uvec3 instanceVariation(const glm::vec3 &paint, unsigned int tag, float dirt, unsigned int seed)
+    {
+        const glm::uvec3 rgb = glm::uvec3(glm::clamp(paint, 0.0f, 1.0f) * 255.0f + 0.5f);
+        const unsigned int dirtByte = (unsigned int)(glm::clamp(dirt, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return glm::uvec3(rgb.r | (rgb.g << 8) | (rgb.b << 16) | (dirtByte << 24), tag, seed);
+    }
+
+    // per-instance model-from-mesh matrix (mat4 in attributes 4-7, a column each), its normal matrix (mat3
+    // in 8-10) and its variation (uvec3 in 15)
+    struct InstanceFormat
+    {
+        typedef InstanceTransform Vertex;
+        static const GLuint BINDING = 4;
+        static const GLuint DIVISOR = 1;
+        static const int COUNT = 8;
+        static const VertexAttribute *attributes()
+        {
+            static const VertexAttribute table[COUNT] = {
+                {4, 4, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, world)},
+                {5, 4, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, world) + sizeof(glm::vec4)},
+                {6, 4, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, world) + 2 * sizeof(glm::vec4)},
+                {7, 4, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, world) + 3 * sizeof(glm::vec4)},
+                {8, 3, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, normal)},
+                {9, 3, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, normal) + sizeof(glm::vec3)},
+                {10, 3, GL_FLOAT, GL_FALSE, false, offsetof(InstanceTransform, normal) + 2 * sizeof(glm::vec3)},
+                {15, 3, GL_UNSIGNED_INT, GL_FALSE, true, offsetof(InstanceTransform, variation)}};
+            return table;
+        }
+    };
+
+    // the InstanceFormat of `vao`, one InstanceTransform per instance, starting at entry `first` of `buffer`.
+    // The bind path leaves `vao` bound, and `buffer` as the array buffer.
+    static void setupInstanceFormat(GLuint vao, GLuint buffer, size_t first)
+    {
+        VertexFormats::setup<InstanceFormat>(vao, buffer, first * sizeof(InstanceTransform));
+    }
+
+    // points the instance attributes of `vao` (set up by setupInstanceFormat) at entry `first` of `buffer`:
+    // one call that binds nothing on the direct state access path, all eight attributes again on the bind path
+    static void bindInstanceBuffer(GLuint vao, GLuint buffer, size_t first)
+    {
+        VertexFormats::rebind<InstanceFormat>(vao, buffer, first * sizeof(InstanceTransform));
+    }
+
+    // texture units of the diffuse / normal / metallicRoughness slots (the samplers are pointed at them at
+    // link, Shader::samplerUnit)
+    static const int UNIT_DIFFUSE = Texture::DIFFUSE;
+    static const int UNIT_NORMAL = Texture::NORMAL;
+    static const int UNIT_MR = Texture::METALLIC_ROUGHNESS;
+
+    // binds only the slot textures; material-table draws read factors and UV transforms from the table
+    void bindTextures() const
+    {
+        for (int s = 0; s < Texture::BOUND_SLOTS; ++s)
+            if (slots[s] != NO_TEXTURE)
+                glState().bindTextureUnit(s, GL_TEXTURE_2D, textures[slots[s]].id);
+    }
+
+    // binds this mesh's textures and uploads its material uniforms; expects `shader` to be in use
+    void bindMaterial(Shader &shader)
+    {
+        const Uniforms &u = uniforms();
+        // check immediately after using program (compiled out below RENDER_DEBUG_LEVEL 2)
+        RenderDebug::checkDraw("after shader.use()", shader.ID);
+        // one-time draw diagnostics, only in full debug builds
+        if (!printedMeshDebug()) {
+            GLint curProg = 0;
+            glGetIntegerv(GL_CURRENT_PROGRAM, &curProg);
+            LOG_DEBUG("[Mesh Debug] shader.ID=" << shader.ID << " GL_CURRENT_PROGRAM=" << curProg);
             GLint maxTexUnits = 0;
             glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTexUnits);
-            std::cout << "[Mesh Debug] GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS=" << maxTexUnits << std::endl;
+            LOG_DEBUG("[Mesh Debug] GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS=" << maxTexUnits);
+            for (unsigned int i = 0; i < textures.size(); i++)
+                LOG_DEBUG("[Mesh Debug] Consider texture idx=" << i << " type=" << Texture::slotName(textures[i].slot) << " path=" << textures[i].path << " id=" << textures[i].id);
         }
-        // bind appropriate textures
-    unsigned int diffuseNr  = 1;
-        unsigned int specularNr = 1;
-        unsigned int normalNr   = 1;
-        unsigned int heightNr   = 1;
-        bool hasDiffuse = false;
-        bool hasNormalMap = false;
-        bool hasMetallicRoughness = false;
-        // We'll bind the first diffuse -> unit 0, normal -> unit 1, metallicRoughness -> unit 2, height -> unit 3
-        const int UNIT_DIFFUSE = 0;
-        const int UNIT_NORMAL = 1;
-        const int UNIT_MR = 2;
-        const int UNIT_HEIGHT = 3;
-    GLint maxTexUnits = 0;
-    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTexUnits);
-        for(unsigned int i = 0; i < textures.size(); i++)
+        // the slot textures: diffuse -> unit 0, normal -> unit 1, metallicRoughness -> unit 2, each with its
+        // UV transform and presence flag
+        for (int s = 0; s < Texture::BOUND_SLOTS; ++s)
         {
-            const Texture &T = textures[i];
-            if (!printedMeshDebug)
-            {
-                std::cout << "[Mesh Debug] Consider texture idx=" << i << " type=" << T.type << " path=" << T.path << " id=" << T.id << std::endl;
-            }
-            if (T.type == "texture_diffuse" && !hasDiffuse)
-            {
-                hasDiffuse = true;
-                glActiveTexture(GL_TEXTURE0 + UNIT_DIFFUSE);
-                glBindTexture(GL_TEXTURE_2D, T.id);
-                glUniform1i(glGetUniformLocation(shader.ID, "texture_diffuse1"), UNIT_DIFFUSE);
-                localGlCheck("after set texture_diffuse1 uniform");
-                GLint loc_uv = glGetUniformLocation(shader.ID, "texture_diffuse1_uv");
-                if (loc_uv != -1) glUniform4f(loc_uv, T.uvOffset.x, T.uvOffset.y, T.uvScale.x, T.uvScale.y);
-                GLint loc_rot = glGetUniformLocation(shader.ID, "texture_diffuse1_rot");
-                if (loc_rot != -1) glUniform1f(loc_rot, T.uvRotation);
-            }
-            else if (T.type == "texture_normal" && !hasNormalMap)
+            const bool bound = slots[s] != NO_TEXTURE;
+            if (bound)
             {
-                hasNormalMap = true;
-                glActiveTexture(GL_TEXTURE0 + UNIT_NORMAL);
-                glBindTexture(GL_TEXTURE_2D, T.id);
-                glUniform1i(glGetUniformLocation(shader.ID, "texture_normal1"), UNIT_NORMAL);
-                localGlCheck("after set texture_normal1 uniform");
-                GLint loc_uv = glGetUniformLocation(shader.ID, "texture_normal1_uv");
-                if (loc_uv != -1) glUniform4f(loc_uv, T.uvOffset.x, T.uvOffset.y, T.uvScale.x, T.uvScale.y);
-                GLint loc_rot = glGetUniformLocation(shader.ID, "texture_normal1_rot");
-                if (loc_rot != -1) glUniform1f(loc_rot, T.uvRotation);
+                const Texture &T = textures[slots[s]];
+                glState().bindTextureUnit(s, GL_TEXTURE_2D, T.id);
+                RenderDebug::checkDraw("after bind slot texture", shader.ID, T.path.c_str());
+                shader.setVec4(u.slotUV[s], T.uvMatrix());
+                shader.setVec2(u.slotOffset[s], T.uvOffset);
             }
-            else if (T.type == "texture_metallicRoughness" && !hasMetallicRoughness)
-            {
-                hasMetallicRoughness = true;
-                glActiveTexture(GL_TEXTURE0 + UNIT_MR);
-                glBindTexture(GL_TEXTURE_2D, T.id);
-                glUniform1i(glGetUniformLocation(shader.ID, "texture_metallicRoughness1"), UNIT_MR);
-                localGlCheck("after set texture_metallicRoughness1 uniform");
-                GLint loc_uv = glGetUniformLocation(shader.ID, "texture_metallicRoughness1_uv");
-                if (loc_uv != -1) glUniform4f(loc_uv, T.uvOffset.x, T.uvOffset.y, T.uvScale.x, T.uvScale.y);
-                GLint loc_rot = glGetUniformLocation(shader.ID, "texture_metallicRoughness1_rot");
-                if (loc_rot != -1) glUniform1f(loc_rot, T.uvRotation);
-            }
-            else
-            {
-                // ignore other textures for now (specular, height, additional diffs)
-            }
-            localGlCheck((std::string("after handling texture ") + T.path).c_str());
-        }
-        // If no diffuse texture was found, bind the first available texture as a fallback
-        if(!hasDiffuse && textures.size() > 0)
-        {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, textures[0].id);
-            glUniform1i(glGetUniformLocation(shader.ID, "texture_diffuse1"), 0);
-            // set uv for fallback
-            GLint loc_uv = glGetUniformLocation(shader.ID, "texture_diffuse1_uv");
-            if (loc_uv != -1) glUniform4f(loc_uv, textures[0].uvOffset.x, textures[0].uvOffset.y, textures[0].uvScale.x, textures[0].uvScale.y);
-            GLint loc_rot = glGetUniformLocation(shader.ID, "texture_diffuse1_rot");
-            if (loc_rot != -1) glUniform1f(loc_rot, textures[0].uvRotation);
-            hasDiffuse = true;
+            shader.setBool(u.hasSlot[s], bound);
         }
 
-        // set presence flags for shader
-        GLint loc_hasBase = glGetUniformLocation(shader.ID, "hasBaseColor");
-        if (loc_hasBase != -1) glUniform1i(loc_hasBase, hasDiffuse ? 1 : 0);
-        GLint loc_hasNormal = glGetUniformLocation(shader.ID, "hasNormalMap");
-        if (loc_hasNormal != -1) glUniform1i(loc_hasNormal, hasNormalMap ? 1 : 0);
-        GLint loc_hasMR = glGetUniformLocation(shader.ID, "hasMetallicRoughness");
-        if (loc_hasMR != -1) glUniform1i(loc_hasMR, hasMetallicRoughness ? 1 : 0);
-
-    // set metallic/roughness factors
-    GLint loc_metal = glGetUniformLocation(shader.ID, "metallicFactor");
-    if (loc_metal != -1) glUniform1f(loc_metal, metallicFactor);
-    GLint loc_rough = glGetUniformLocation(shader.ID, "roughnessFactor");
-    if (loc_rough != -1) glUniform1f(loc_rough, roughnessFactor);
+        // set metallic/roughness factors
+        shader.setFloat(u.metallicFactor, metallicFactor);
+        shader.setFloat(u.roughnessFactor, roughnessFactor);
 
         // set baseColorFactor uniform
-        GLint loc_baseColorFactor = glGetUniformLocation(shader.ID, "baseColorFactor");
-        if (loc_baseColorFactor != -1) {
-            glUniform4f(loc_baseColorFactor, baseColorFactor.r, baseColorFactor.g, baseColorFactor.b, baseColorFactor.a);
-        }
+        shader.setVec4(u.baseColorFactor, baseColorFactor);
+        // alpha test threshold (0 = none) and whether alpha is kept for blending
+        shader.setFloat(u.alphaCutoff, alphaMode == ALPHA_MASK ? alphaCutoff : 0.0f);
+        shader.setBool(u.alphaBlend, alphaMode == ALPHA_BLEND);
+        shader.setFloat(u.clearcoatFactor, clearcoatFactor);
+        shader.setFloat(u.clearcoatRoughnessFactor, clearcoatRoughnessFactor);
+        shader.setFloat(u.transmissionFactor, transmissionFactor);
+        shader.setVec3(u.specularColorFactor, specularColorFactor * specularFactor);
+        shader.setFloat(u.occlusionStrength, occlusionStrength);
+        shader.setInt(u.materialTag, (int)materialTag);
+    }
 
-        // draw mesh
-        if (!printedMeshDebug)
+    // issues the indexed draw of level `lod` (0 = full mesh); the VAO stays bound (the state cache skips
+    // the rebind for the next mesh)
+    // `instanceCount` > 1 or a non-zero `baseInstance` (GL 4.2) draw instanced, with the per-instance
+    // matrices (attributes 4-7) starting at `baseInstance`
+    void drawGeometry(Shader &shader, unsigned int lod = 0, GLsizei instanceCount = 1, GLuint baseInstance = 0)
+    {
+        if (!printedMeshDebug())
         {
-            std::cout << "[Mesh Debug] About to draw VAO=" << VAO << " indicesCount=" << indices.size() << " EBO bound=" << (EBO != 0) << std::endl;
+            LOG_DEBUG("[Mesh Debug] About to draw VAO=" << VAO << " indicesCount=" << indexCount << " firstIndex=" << firstIndex << " baseVertex=" << baseVertex);
             GLboolean isVAO = glIsVertexArray(VAO);
-            std::cout << "[Mesh Debug] glIsVertexArray(VAO)=" << (isVAO ? "true" : "false") << std::endl;
+            LOG_DEBUG("[Mesh Debug] glIsVertexArray(VAO)=" << (isVAO ? "true" : "false"));
             GLint errBefore = glGetError();
-            std::cout << "[Mesh Debug] glGetError before draw: 0x" << std::hex << errBefore << std::dec << std::endl;
-        }
-        glBindVertexArray(VAO);
-        localGlCheck("after glBindVertexArray(VAO)");
-        // Safety: explicitly bind the EBO before draw in case VAO state wasn't restored properly.
-        if (EBO != 0) {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            localGlCheck("after explicit glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO)");
-        } else {
-            std::cerr << "[Mesh Debug] Warning: mesh EBO is 0 for VAO=" << VAO << "\n";
+            LOG_DEBUG("[Mesh Debug] glGetError before draw: 0x" << std::hex << errBefore << std::dec);
         }
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
-        localGlCheck("after glDrawElements");
-        if (!printedMeshDebug)
+        // the VAO records the EBO binding, so binding the VAO is enough
+        glState().bindVertexArray(VAO);
+        RenderDebug::checkDraw("after glBindVertexArray(VAO)", shader.ID);
+        const unsigned int count = lod < lods.size() ? lods[lod].indexCount : indexCount;
+        const unsigned int first = lod < lods.size() ? lods[lod].firstIndex : firstIndex;
+        const void *offset = (const void *)(size_t)(first * indexSize);
+        if (baseInstance != 0)
+            glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, count, indexType(), offset, instanceCount, baseVertex, baseInstance);
+        else if (instanceCount != 1)
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, count, indexType(), offset, instanceCount, baseVertex);
+        else
+            glDrawElementsBaseVertex(GL_TRIANGLES, count, indexType(), offset, baseVertex);
+        drawStats().count();
+        GL_STATS_ADD(primitives, (size_t)(count / 3) * instanceCount);
+        RenderDebug::checkDraw("after glDrawElements", shader.ID);
+        if (!printedMeshDebug())
         {
             GLint errAfter = glGetError();
-            std::cout << "[Mesh Debug] glGetError after draw: 0x" << std::hex << errAfter << std::dec << std::endl;
-            printedMeshDebug = true;
+            LOG_DEBUG("[Mesh Debug] glGetError after draw: 0x" << std::hex << errAfter << std::dec);
+            printedMeshDebug() = true;
         }
-        glBindVertexArray(0);
-
-        // always good practice to set everything back to defaults once configured.
-        glActiveTexture(GL_TEXTURE0);
     }
 
 private:
-    // render data 
-    unsigned int VBO, EBO;
-
-    // initializes all the buffer objects/arrays
-    void setupMesh()
-    {
-        // create buffers/arrays
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-
-        glBindVertexArray(VAO);
-        // load data into vertex buffers
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        // A great thing about structs is that their memory layout is sequential for all its items.
-        // The effect is that we can simply pass a pointer to the struct and it translates perfectly to a glm::vec3/2 array which
-        // again translates to 3/2 floats which translates to a byte array.
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);  
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-        // set the vertex attribute pointers
-        // vertex Positions
-        glEnableVertexAttribArray(0);	
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-        // vertex normals
-        glEnableVertexAttribArray(1);	
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-        // vertex texture coords
-        glEnableVertexAttribArray(2);	
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-        // vertex tangent
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
-        // vertex bitangent
-        glEnableVertexAttribArray(4);
-        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
-		// ids
-		glEnableVertexAttribArray(5);
-		glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex), (void*)offsetof(Vertex, m_BoneIDs));
-
-		// weights
-		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Weights));
-        glBindVertexArray(0);
+    void computeBounds()
+    {
+        vertexCount = static_cast<unsigned int>(vertices.size());
+        if (vertices.empty())
+            return;
+        const float *positions = &vertices.positions[0].x;
+        glm::vec3 sum;
+        GeometryKernels::boundsAndSum(positions, sizeof(glm::vec3), vertices.size(), boundsMin, boundsMax, sum);
+        centroid = sum / (float)vertices.size();
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        boundingRadius = std::sqrt(GeometryKernels::maxDistance2(positions, sizeof(glm::vec3), vertices.size(), center));
+    }
+
+    void computeUvDensity()
+    {
+        double surface = 0.0, uvArea = 0.0;
+        const vector<glm::vec3> &p = vertices.positions;
+        const vector<glm::vec2> &uv = vertices.texCoords;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+        {
+            const unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            if (a >= p.size() || b >= p.size() || c >= p.size())
+                continue;
+            surface += 0.5 * glm::length(glm::cross(p[b] - p[a], p[c] - p[a]));
+            const glm::vec2 du = uv[b] - uv[a], dv = uv[c] - uv[a];
+            uvArea += 0.5 * std::fabs(du.x * dv.y - du.y * dv.x);
+        }
+        uvDensity = surface > 0.0 ? (float)std::sqrt(uvArea / surface) : 0.0f;
+    }
+
+    static const unsigned int NO_TEXTURE = 0xFFFFFFFFu;
+    // per Texture::Slot, index into `textures` of the texture bound by bindMaterial (NO_TEXTURE = none)
+    unsigned int slots[Texture::BOUND_SLOTS];
+    MaterialKey matKey;
+    unsigned int features = 0;
+
+    static bool &printedMeshDebug()
+    {
+        static bool printed = (RenderDebug::Level < 2);
+        return printed;
+    }
+
+    static bool sameUVTransform(const Texture *a, const Texture *b)
+    {
+        if (!a || !b)
+            return a == b;
+        return a->uvOffset == b->uvOffset && a->uvScale == b->uvScale && a->uvRotation == b->uvRotation;
+    }
+
+    // classify textures once: first diffuse, first normal, first metallicRoughness. If no diffuse
+    // texture exists the first texture of any type is used as a fallback, as before.
+    void resolveMaterialKey()
+    {
+        for (int s = 0; s < Texture::BOUND_SLOTS; ++s)
+            slots[s] = NO_TEXTURE;
+        for (unsigned int i = 0; i < textures.size(); i++)
+        {
+            const Texture::Slot s = textures[i].slot;
+            if (s < Texture::BOUND_SLOTS && slots[s] == NO_TEXTURE)
+                slots[s] = i;
+        }
+        if (slots[Texture::DIFFUSE] == NO_TEXTURE && !textures.empty())
+            slots[Texture::DIFFUSE] = 0;
+        const Texture *diffuse = diffuseTexture(), *normal = normalTexture(), *metallicRoughness = metallicRoughnessTexture();
+        matKey.diffuse = diffuse ? diffuse->id : 0;
+        matKey.normal = normal ? normal->id : 0;
+        matKey.metallicRoughness = metallicRoughness ? metallicRoughness->id : 0;
+        features = 0;
+        if (diffuse) features |= Shader::HAS_BASE_COLOR;
+        if (normal) features |= Shader::HAS_NORMAL_MAP;
+        if (metallicRoughness) features |= Shader::HAS_MR;
+        for (int s = 0; s < Texture::BOUND_SLOTS; ++s)
+            if (slots[s] != NO_TEXTURE && textures[slots[s]].hasUVTransform())
+                features |= Shader::HAS_UV_TRANSFORM;
+        if (alphaMode == ALPHA_MASK)
+            features |= Shader::ALPHA_MASK;
+        if (clearcoatFactor > 0.0f)
+            features |= Shader::CLEARCOAT;
+        if (transmissionFactor > 0.0f)
+            features |= Shader::TRANSMISSION;
+        if (skin >= 0)
+            features |= Shader::SKINNED;
+    }
+
+    // uniform handles used by Draw, interned once for all meshes; the slot arrays are indexed by Texture::Slot
+    struct Uniforms
+    {
+        Shader::UniformHandle slotUV[Texture::BOUND_SLOTS], slotOffset[Texture::BOUND_SLOTS], hasSlot[Texture::BOUND_SLOTS];
+        Shader::UniformHandle metallicFactor, roughnessFactor, baseColorFactor;
+        Shader::UniformHandle alphaCutoff, alphaBlend;
+        Shader::UniformHandle clearcoatFactor, clearcoatRoughnessFactor, transmissionFactor;
+        Shader::UniformHandle specularColorFactor, occlusionStrength, materialTag;
+    };
+    static const Uniforms &uniforms()
+    {
+        static const Uniforms u = {
+            {Shader::uniformHandle("texture_diffuse1_uv"), Shader::uniformHandle("texture_normal1_uv"), Shader::uniformHandle("texture_metallicRoughness1_uv")},
+            {Shader::uniformHandle("texture_diffuse1_offset"), Shader::uniformHandle("texture_normal1_offset"), Shader::uniformHandle("texture_metallicRoughness1_offset")},
+            {Shader::uniformHandle("hasBaseColor"), Shader::uniformHandle("hasNormalMap"), Shader::uniformHandle("hasMetallicRoughness")},
+            Shader::uniformHandle("metallicFactor"), Shader::uniformHandle("roughnessFactor"), Shader::uniformHandle("baseColorFactor"),
+            Shader::uniformHandle("alphaCutoff"), Shader::uniformHandle("alphaBlend"),
+            Shader::uniformHandle("clearcoatFactor"), Shader::uniformHandle("clearcoatRoughnessFactor"),
+            Shader::uniformHandle("transmissionFactor"),
+            Shader::uniformHandle("specularColorFactor"), Shader::uniformHandle("occlusionStrength"), Shader::uniformHandle("materialTag")};
+        return u;
     }
 };
 #endif
@@ -0,0 +1,448 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <glm/glm.hpp>
+
+#include <mesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Import-time reordering of indexed triangle lists for the GPU:
+//   weldVertices         - merges the vertices an exporter split but that are identical in every stream,
+//                          through a hash table over their attributes
+//   optimizeVertexCache  - Tipsify (Sander, Nehab & Barczak 2007): triangle order with good reuse in the
+//                          post-transform vertex cache, in one linear pass
+//   optimizeOverdraw     - reorders the clusters Tipsify produced so outward-facing parts of the mesh are
+//                          drawn first and early depth rejects more of the rest, within a bound on the cache
+//                          misses that costs
+//   optimizeTriangleOrder - both of the above, keeping the source order when they don't lower its ACMR
+//   optimizeVertexFetch  - renumbers vertices in first-use order, so the vertex fetches walk memory forward
+// None of these change what is drawn, only the order of triangles and vertices. buildMeshlets then splits
+// the optimized list into GPU-cullable clusters.
+namespace MeshOptimizer
+{
+    // cache size the orders are tuned for; small enough to hold on every GPU generation
+    static const unsigned int CACHE_SIZE = 16;
+
+    // average cache misses per triangle of `indices` in a FIFO cache of `cacheSize` entries (0.5 is the
+    // ideal for a regular grid, 3 the worst case)
+    inline float acmr(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize = CACHE_SIZE)
+    {
+        if (indices.size() < 3)
+            return 0.0f;
+        // a vertex is cached while fewer than cacheSize misses happened since it was loaded
+        std::vector<unsigned int> loadedAt(vertexCount, 0);
+        unsigned int misses = 0;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            const unsigned int v = indices[i];
+            if (loadedAt[v] == 0 || misses - (loadedAt[v] - 1) >= cacheSize)
+            {
+                misses++;
+                loadedAt[v] = misses;
+            }
+        }
+        return (float)misses / (float)(indices.size() / 3);
+    }
+
+    // Tipsify: grows the order from a fanning vertex, moving to the neighbour that will still be in the cache
+    // and has the most triangles left, and restarts from recently used vertices at dead ends. Returns the
+    // reordered triangles; `clusters` receives the first triangle of each run that began at a dead end
+    // (cache contents unrelated to the previous run), the natural split points for optimizeOverdraw.
+    inline std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount,
+                                                         std::vector<unsigned int> *clusters = 0, unsigned int cacheSize = CACHE_SIZE)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        std::vector<unsigned int> result;
+        result.reserve(triangleCount * 3);
+        if (clusters)
+            clusters->clear();
+        if (triangleCount == 0 || vertexCount == 0)
+            return result;
+        // triangles around each vertex (CSR) and how many of them are not emitted yet
+        std::vector<unsigned int> adjacencyStart(vertexCount + 1, 0), adjacency(triangleCount * 3);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+            adjacencyStart[indices[i] + 1]++;
+        for (size_t v = 0; v < vertexCount; ++v)
+            adjacencyStart[v + 1] += adjacencyStart[v];
+        std::vector<unsigned int> live(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+            live[v] = adjacencyStart[v + 1] - adjacencyStart[v];
+        {
+            std::vector<unsigned int> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+                adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+        }
+        std::vector<unsigned char> emitted(triangleCount, 0);
+        // time stamp of each vertex's last cache load (0 = never)
+        std::vector<unsigned int> cacheTime(vertexCount, 0);
+        std::vector<unsigned int> deadEnd, candidates;
+        unsigned int time = cacheSize + 1;
+        size_t scan = 0;
+        int fanning = indices[0];
+        bool restarted = true;
+        while (fanning >= 0)
+        {
+            if (restarted && clusters)
+                clusters->push_back((unsigned int)(result.size() / 3));
+            candidates.clear();
+            for (unsigned int a = adjacencyStart[fanning]; a < adjacencyStart[fanning + 1]; ++a)
+            {
+                const unsigned int t = adjacency[a];
+                if (emitted[t])
+                    continue;
+                emitted[t] = 1;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const unsigned int v = indices[t * 3 + k];
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (time - cacheTime[v] > cacheSize)
+                        cacheTime[v] = time++;
+                }
+            }
+            // next fanning vertex: the candidate that stays cached longest while its fan is emitted
+            int best = -1, bestPriority = -1;
+            for (size_t c = 0; c < candidates.size(); ++c)
+            {
+                const unsigned int v = candidates[c];
+                if (live[v] == 0)
+                    continue;
+                int priority = 0;
+                if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                    priority = (int)(time - cacheTime[v]);
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    best = (int)v;
+                }
+            }
+            restarted = best < 0;
+            if (best < 0)
+            {
+                // dead end: most recently used vertex with triangles left, else the next one in input order
+                while (!deadEnd.empty() && best < 0)
+                {
+                    const unsigned int v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0)
+                        best = (int)v;
+                }
+                while (best < 0 && scan < vertexCount)
+                {
+                    if (live[scan] > 0)
+                        best = (int)scan;
+                    scan++;
+                }
+            }
+            fanning = best;
+        }
+        return result;
+    }
+
+    // how much optimizeOverdraw may raise the ACMR of the Tipsify order (Sander et al.'s lambda)
+    static const float OVERDRAW_THRESHOLD = 1.05f;
+
+    // reorders the clusters of a Tipsify order (see optimizeVertexCache) by how likely they are to occlude
+    // the rest of the mesh: the dot product of the cluster's offset from the mesh centre with its average
+    // normal. Outward-facing clusters on the hull go first. Triangles inside a cluster keep their order.
+    // As in the reference algorithm, the dead-end clusters are first split further wherever a run's own
+    // ACMR (from a cold cache) has come down to `threshold` times the whole order's, so every seam costs
+    // at most that; if the sorted order still ends up above `threshold` times the input's ACMR, the input
+    // is returned unchanged.
+    inline std::vector<unsigned int> optimizeOverdraw(const std::vector<unsigned int> &indices, const std::vector<glm::vec3> &positions,
+                                                      const std::vector<unsigned int> &clusters, float threshold = OVERDRAW_THRESHOLD,
+                                                      unsigned int cacheSize = CACHE_SIZE)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (clusters.empty() || triangleCount == 0)
+            return indices;
+        // area-weighted mesh centre
+        glm::vec3 meshCentre(0.0f);
+        float meshArea = 0.0f;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const glm::vec3 &p0 = positions[indices[t * 3]], &p1 = positions[indices[t * 3 + 1]], &p2 = positions[indices[t * 3 + 2]];
+            float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+            meshCentre += (p0 + p1 + p2) * (area / 3.0f);
+            meshArea += area;
+        }
+        if (meshArea <= 0.0f)
+            return indices;
+        meshCentre /= meshArea;
+
+        // soft cluster boundaries: within each dead-end cluster, a run ends once its misses per triangle
+        // (counted from an empty cache) are within the threshold
+        const float inputAcmr = acmr(indices, positions.size(), cacheSize);
+        std::vector<unsigned int> starts;
+        std::vector<unsigned int> loadedAt(positions.size(), 0);
+        for (size_t c = 0; c < clusters.size(); ++c)
+        {
+            const unsigned int end = (unsigned int)(c + 1 < clusters.size() ? clusters[c + 1] : triangleCount);
+            unsigned int runStart = clusters[c], misses = 0, epoch = 0;
+            starts.push_back(runStart);
+            for (unsigned int t = clusters[c]; t < end; ++t)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    const unsigned int v = indices[t * 3 + k];
+                    // loadedAt counts misses since the run started (offset by epoch); 0 = not this run
+                    if (loadedAt[v] <= epoch || misses - (loadedAt[v] - epoch - 1) >= cacheSize)
+                    {
+                        misses++;
+                        loadedAt[v] = epoch + misses;
+                    }
+                }
+                const unsigned int runTriangles = t + 1 - runStart;
+                if (t + 1 < end && (float)misses <= threshold * inputAcmr * (float)runTriangles)
+                {
+                    runStart = t + 1;
+                    starts.push_back(runStart);
+                    epoch += misses;
+                    misses = 0;
+                }
+            }
+        }
+        if (starts.size() < 2)
+            return indices;
+
+        struct Cluster
+        {
+            unsigned int first, count;
+            float potential;
+        };
+        std::vector<Cluster> sorted(starts.size());
+        for (size_t c = 0; c < starts.size(); ++c)
+        {
+            Cluster &cluster = sorted[c];
+            cluster.first = starts[c];
+            cluster.count = (unsigned int)((c + 1 < starts.size() ? starts[c + 1] : triangleCount) - starts[c]);
+            glm::vec3 centre(0.0f), normal(0.0f);
+            float area = 0.0f;
+            for (unsigned int t = cluster.first; t < cluster.first + cluster.count; ++t)
+            {
+                const glm::vec3 &p0 = positions[indices[t * 3]], &p1 = positions[indices[t * 3 + 1]], &p2 = positions[indices[t * 3 + 2]];
+                glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+                float a = glm::length(n);
+                centre += (p0 + p1 + p2) * (a / 3.0f);
+                normal += n;
+                area += a;
+            }
+            cluster.potential = area > 0.0f ? glm::dot(centre / area - meshCentre, normal / area) : 0.0f;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster &a, const Cluster &b) { return a.potential > b.potential; });
+        std::vector<unsigned int> result;
+        result.reserve(indices.size());
+        for (size_t c = 0; c < sorted.size(); ++c)
+            result.insert(result.end(), indices.begin() + sorted[c].first * 3, indices.begin() + (sorted[c].first + sorted[c].count) * 3);
+        if (acmr(result, positions.size(), cacheSize) > threshold * inputAcmr)
+            return indices;
+        return result;
+    }
+
+    // Tipsify, then the overdraw cluster sort; an already well ordered mesh can come out with more misses
+    // than it went in with, and then keeps its source order
+    inline void optimizeTriangleOrder(std::vector<unsigned int> &indices, const std::vector<glm::vec3> &positions)
+    {
+        std::vector<unsigned int> clusters;
+        std::vector<unsigned int> result = optimizeVertexCache(indices, positions.size(), &clusters);
+        result = optimizeOverdraw(result, positions, clusters);
+        if (acmr(result, positions.size()) < acmr(indices, positions.size()))
+            indices.swap(result);
+    }
+
+    // bounding sphere and normal cone of the triangles [first, first + count) (see Mesh::Meshlet)
+    inline Mesh::Meshlet meshletBounds(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices, size_t first, size_t count)
+    {
+        Mesh::Meshlet meshlet = {(unsigned int)first, (unsigned int)count, glm::vec4(0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)};
+        glm::vec3 bMin(std::numeric_limits<float>::max()), bMax(-std::numeric_limits<float>::max());
+        for (size_t i = first; i < first + count; ++i)
+        {
+            bMin = glm::min(bMin, positions[indices[i]]);
+            bMax = glm::max(bMax, positions[indices[i]]);
+        }
+        const glm::vec3 centre = (bMin + bMax) * 0.5f;
+        float radius = 0.0f;
+        for (size_t i = first; i < first + count; ++i)
+            radius = std::max(radius, glm::length(positions[indices[i]] - centre));
+        meshlet.sphere = glm::vec4(centre, radius);
+        // cone around the average face normal; the cutoff is sin of its half angle, so a cluster is back
+        // facing when the view direction to every point of its sphere lies outside the widened cone
+        std::vector<glm::vec3> normals;
+        normals.reserve(count / 3);
+        glm::vec3 axis(0.0f);
+        for (size_t t = first; t + 2 < first + count; t += 3)
+        {
+            const glm::vec3 &p0 = positions[indices[t]], &p1 = positions[indices[t + 1]], &p2 = positions[indices[t + 2]];
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float len = glm::length(n);
+            if (len <= 0.0f)
+                continue;
+            normals.push_back(n / len);
+            axis += normals.back();
+        }
+        const float axisLength = glm::length(axis);
+        if (normals.empty() || axisLength <= 0.0f)
+            return meshlet;
+        axis /= axisLength;
+        float minDot = 1.0f;
+        for (size_t n = 0; n < normals.size(); ++n)
+            minDot = std::min(minDot, glm::dot(normals[n], axis));
+        // wider than ~84 degrees: some triangle always faces the camera
+        if (minDot <= 0.1f)
+            meshlet.cone = glm::vec4(axis, 1.0f);
+        else
+            meshlet.cone = glm::vec4(axis, std::sqrt(1.0f - minDot * minDot));
+        return meshlet;
+    }
+
+    // splits `indices` into consecutive runs of at most `maxVertices` distinct vertices and `maxTriangles`
+    // triangles. Run on a Tipsify order, consecutive triangles are neighbours, so the runs are compact
+    // patches of the surface.
+    inline std::vector<Mesh::Meshlet> buildMeshlets(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices,
+                                                    unsigned int maxVertices = 64, unsigned int maxTriangles = 124)
+    {
+        std::vector<Mesh::Meshlet> meshlets;
+        // meshlet number + 1 that last used each vertex
+        std::vector<unsigned int> usedBy(positions.size(), 0);
+        size_t first = 0;
+        unsigned int vertexCount = 0;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            unsigned int added = 0;
+            for (int k = 0; k < 3; ++k)
+                added += usedBy[indices[t + k]] != meshlets.size() + 1;
+            if (vertexCount + added > maxVertices || (t - first) / 3 + 1 > maxTriangles)
+            {
+                meshlets.push_back(meshletBounds(positions, indices, first, t - first));
+                first = t;
+                vertexCount = 0;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int &use = usedBy[indices[t + k]];
+                if (use != meshlets.size() + 1)
+                {
+                    use = (unsigned int)meshlets.size() + 1;
+                    vertexCount++;
+                }
+            }
+        }
+        if (indices.size() / 3 * 3 > first)
+            meshlets.push_back(meshletBounds(positions, indices, first, indices.size() / 3 * 3 - first));
+        return meshlets;
+    }
+
+    // FNV-1a over the bytes of one vertex's attributes
+    inline uint32_t vertexHash(const VertexStreams &vertices, size_t v)
+    {
+        uint32_t h = 2166136261u;
+        auto mix = [&h](const void *data, size_t size) {
+            const unsigned char *bytes = (const unsigned char *)data;
+            for (size_t i = 0; i < size; ++i)
+                h = (h ^ bytes[i]) * 16777619u;
+        };
+        mix(&vertices.positions[v], sizeof(glm::vec3));
+        mix(&vertices.normals[v], sizeof(glm::vec3));
+        mix(&vertices.texCoords[v], sizeof(glm::vec2));
+        if (vertices.hasTangents())
+            mix(&vertices.tangents[v], sizeof(glm::vec4));
+        if (vertices.hasSkin())
+        {
+            mix(&vertices.joints[v], sizeof(glm::uvec4));
+            mix(&vertices.weights[v], sizeof(glm::vec4));
+        }
+        return h;
+    }
+
+    // vertices `a` and `b` are the same bit for bit in every stream
+    inline bool sameVertex(const VertexStreams &vertices, size_t a, size_t b)
+    {
+        bool same = std::memcmp(&vertices.positions[a], &vertices.positions[b], sizeof(glm::vec3)) == 0 &&
+                    std::memcmp(&vertices.normals[a], &vertices.normals[b], sizeof(glm::vec3)) == 0 &&
+                    std::memcmp(&vertices.texCoords[a], &vertices.texCoords[b], sizeof(glm::vec2)) == 0;
+        if (same && vertices.hasTangents())
+            same = std::memcmp(&vertices.tangents[a], &vertices.tangents[b], sizeof(glm::vec4)) == 0;
+        if (same && vertices.hasSkin())
+            same = std::memcmp(&vertices.joints[a], &vertices.joints[b], sizeof(glm::uvec4)) == 0 &&
+                   std::memcmp(&vertices.weights[a], &vertices.weights[b], sizeof(glm::vec4)) == 0;
+        return same;
+    }
+
+    // keeps the first of every set of identical vertices (position, normal, UV, tangent and skin all equal)
+    // and points `indices` at it; returns how many vertices went. Exact matches only, so nothing drawn
+    // changes: exporters duplicate vertices per face or per primitive, and each copy costs a vertex shader
+    // run the post-transform cache can't save.
+    inline size_t weldVertices(VertexStreams &vertices, std::vector<unsigned int> &indices)
+    {
+        const size_t count = vertices.size();
+        if (count < 2)
+            return 0;
+        size_t capacity = 1;
+        while (capacity < count * 2)
+            capacity <<= 1;
+        const unsigned int empty = ~0u;
+        // open addressing: the slot holds the welded vertex's new index, `source` its original one
+        std::vector<unsigned int> table(capacity, empty);
+        std::vector<unsigned int> remap(count);
+        std::vector<unsigned int> source;
+        source.reserve(count);
+        for (size_t v = 0; v < count; ++v)
+        {
+            size_t h = vertexHash(vertices, v) & (capacity - 1);
+            for (;;)
+            {
+                const unsigned int slot = table[h];
+                if (slot == empty)
+                {
+                    table[h] = remap[v] = (unsigned int)source.size();
+                    source.push_back((unsigned int)v);
+                    break;
+                }
+                if (sameVertex(vertices, source[slot], v))
+                {
+                    remap[v] = slot;
+                    break;
+                }
+                h = (h + 1) & (capacity - 1);
+            }
+        }
+        if (source.size() == count)
+            return 0;
+        for (size_t i = 0; i < indices.size(); ++i)
+            indices[i] = remap[indices[i]];
+        vertices.gather(source);
+        return count - source.size();
+    }
+
+    // renumbers `vertices` in the order `indices` first reference them and rewrites `indices` to match.
+    // Vertices no triangle uses are dropped. The new order is worked out on the indices alone, then every
+    // stream is gathered through it once.
+    inline void optimizeVertexFetch(VertexStreams &vertices, std::vector<unsigned int> &indices)
+    {
+        const unsigned int unused = ~0u;
+        std::vector<unsigned int> remap(vertices.size(), unused);
+        std::vector<unsigned int> source;
+        source.reserve(vertices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            unsigned int &slot = remap[indices[i]];
+            if (slot == unused)
+            {
+                slot = (unsigned int)source.size();
+                source.push_back(indices[i]);
+            }
+            indices[i] = slot;
+        }
+        vertices.gather(source);
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef MESH_REGIONS_H
+#define MESH_REGIONS_H
+
+#include <glm/glm.hpp>
+#include <json.hpp>
+
+#include <async_log.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// LAZY_REGIONS=1: the parts of a car the usual views never show - the cabin and the underside - load only
+// when the camera gets to them. Meshes are tagged at import (Mesh::region) from the names of their node,
+// the nodes above it and the mesh itself, nearest first: the first name with a keyword of a region puts
+// the mesh in it, and meshes without one are exterior. The textures only non-exterior meshes use are
+// requested deferred (TextureLoader) and show their placeholder until Model::requestRegions() finds the
+// camera near the region; the exterior's load as before, so the car is complete from outside first.
+//
+// REGION_MAP=<file.json> gives the keywords of a model set, {"interior": [...], "underside": [...],
+// "exterior": [...]} (case-insensitive substrings); they're tried before the built-in ones, and an
+// "exterior" match keeps a part (a visible exhaust tip under an "underbody" group, say) loading up front.
+class MeshRegions
+{
+public:
+    enum Region { EXTERIOR = 0, INTERIOR = 1, UNDERSIDE = 2, COUNT = 3 };
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("LAZY_REGIONS");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    static const char *name(unsigned int region)
+    {
+        static const char *names[COUNT] = {"exterior", "interior", "underside"};
+        return region < COUNT ? names[region] : "?";
+    }
+
+    // the region of a mesh whose names, nearest first, are `names`
+    static unsigned int classify(const std::vector<std::string> &names)
+    {
+        const Keywords &k = keywords();
+        for (size_t n = 0; n < names.size(); ++n)
+        {
+            std::string lower(names[n]);
+            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            for (unsigned int r = 0; r < COUNT; ++r)
+                if (matches(lower, k.authored[r]))
+                    return r;
+            for (unsigned int r = INTERIOR; r < COUNT; ++r)
+                if (matches(lower, k.builtIn[r]))
+                    return r;
+        }
+        return EXTERIOR;
+    }
+
+    // whether a camera at `eye` (model space, y up) is close enough to a region with bounds [regionMin,
+    // regionMax] to need it: within the cabin's box grown by a quarter of the car's largest extent, or under
+    // the car's lowest tenth inside that margin of its footprint
+    static bool near(unsigned int region, const glm::vec3 &eye, const glm::vec3 &regionMin, const glm::vec3 &regionMax,
+                     const glm::vec3 &modelMin, const glm::vec3 &modelMax)
+    {
+        const glm::vec3 size = modelMax - modelMin;
+        const float margin = 0.25f * std::max(size.x, std::max(size.y, size.z));
+        if (region == INTERIOR)
+            return glm::all(glm::greaterThanEqual(eye, regionMin - glm::vec3(margin))) &&
+                   glm::all(glm::lessThanEqual(eye, regionMax + glm::vec3(margin)));
+        if (region == UNDERSIDE)
+            return eye.y < modelMin.y + 0.1f * size.y && eye.x >= modelMin.x - margin && eye.x <= modelMax.x + margin &&
+                   eye.z >= modelMin.z - margin && eye.z <= modelMax.z + margin;
+        return true;
+    }
+
+private:
+    struct Keywords
+    {
+        std::vector<std::string> authored[COUNT];
+        std::vector<std::string> builtIn[COUNT];
+    };
+
+    static bool matches(const std::string &lower, const std::vector<std::string> &words)
+    {
+        for (size_t i = 0; i < words.size(); ++i)
+            if (lower.find(words[i]) != std::string::npos)
+                return true;
+        return false;
+    }
+
+    static const Keywords &keywords()
+    {
+        static const Keywords k = []() {
+            Keywords out;
+            static const char *interior[] = {"interior", "cabin", "seat", "dashboard", "steering", "carpet", "pedal", "console",
+                                             "headliner", "gauge", "shifter", "gearknob", "door_card", "doorcard", "leather"};
+            static const char *underside[] = {"undercarriage", "underbody", "underside", "chassis", "subframe", "suspension",
+                                              "driveshaft", "axle", "muffler", "floorpan", "fuel_tank"};
+            out.builtIn[INTERIOR].assign(interior, interior + sizeof(interior) / sizeof(interior[0]));
+            out.builtIn[UNDERSIDE].assign(underside, underside + sizeof(underside) / sizeof(underside[0]));
+            const char *env = std::getenv("REGION_MAP");
+            if (!env || !*env)
+                return out;
+            try
+            {
+                std::ifstream in(env);
+                if (!in)
+                {
+                    LOG_ERROR("[MeshRegions] Can't open region map " << env);
+                    return out;
+                }
+                const nlohmann::json map = nlohmann::json::parse(in);
+                for (unsigned int r = 0; r < COUNT; ++r)
+                {
+                    if (!map.contains(name(r)))
+                        continue;
+                    const nlohmann::json &words = map[name(r)];
+                    for (size_t i = 0; i < words.size(); ++i)
+                    {
+                        std::string word = words[i].get<std::string>();
+                        std::transform(word.begin(), word.end(), word.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+                        if (!word.empty())
+                            out.authored[r].push_back(word);
+                    }
+                }
+                LOG_INFO("[MeshRegions] Region map " << env << ": " << out.authored[INTERIOR].size() << " interior, "
+                         << out.authored[UNDERSIDE].size() << " underside, " << out.authored[EXTERIOR].size() << " exterior keywords");
+            }
+            catch (const std::exception &e)
+            {
+                LOG_ERROR("[MeshRegions] Bad region map " << env << ": " << e.what());
+            }
+            return out;
+        }();
+        return k;
+    }
+};
+
+#endif
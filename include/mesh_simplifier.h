@@ -0,0 +1,234 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <glm/glm.hpp>
+
+#include <mesh.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// Quadric edge-collapse simplification (Garland & Heckbert) of an indexed triangle list, used to build the
+// mesh LODs at import. Collapses are half-edge: a vertex moves onto a neighbour, so every LOD indexes the
+// original vertex buffer and only adds indices. Vertices on open borders and on attribute seams (one
+// position shared by several vertices, e.g. a UV seam or a hard normal) are locked, which keeps
+// silhouettes, UV islands and the mesh border in place. Material boundaries coincide with mesh
+// boundaries here (one mesh per material), so they are borders too.
+namespace MeshSimplifier
+{
+    // symmetric 4x4 error quadric of a set of planes, upper triangle
+    struct Quadric
+    {
+        double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+        static Quadric zero()
+        {
+            Quadric q;
+            std::memset(&q, 0, sizeof(q));
+            return q;
+        }
+
+        static Quadric plane(const glm::dvec3 &n, double d)
+        {
+            Quadric q = {n.x * n.x, n.x * n.y, n.x * n.z, n.x * d, n.y * n.y, n.y * n.z, n.y * d, n.z * n.z, n.z * d, d * d};
+            return q;
+        }
+
+        void add(const Quadric &o)
+        {
+            a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad; b2 += o.b2;
+            bc += o.bc; bd += o.bd; c2 += o.c2; cd += o.cd; d2 += o.d2;
+        }
+
+        // sum of squared distances of p to the planes
+        double error(const glm::vec3 &p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            double e = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                     + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+                     + c2 * z * z + 2.0 * cd * z + d2;
+            return e > 0.0 ? e : 0.0;
+        }
+    };
+
+    struct PositionHash
+    {
+        size_t operator()(const glm::vec3 &p) const
+        {
+            uint32_t bits[3];
+            std::memcpy(bits, &p[0], sizeof(bits));
+            return (size_t)(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+        }
+    };
+
+    // simplifies `indices` (triangles over the vertex `positions`) towards `targetIndexCount` indices without moving any
+    // surface by more than roughly `maxError` (model units). Returns the new index list; `resultError` is
+    // the largest error actually introduced. Returns the input unchanged if nothing can be collapsed.
+    inline std::vector<unsigned int> simplify(const std::vector<glm::vec3> &positions, const std::vector<unsigned int> &indices,
+                                              size_t targetIndexCount, float maxError, float &resultError)
+    {
+        resultError = 0.0f;
+        const size_t vertexCount = positions.size();
+        std::vector<unsigned int> result(indices);
+        if (vertexCount == 0 || result.size() <= targetIndexCount)
+            return result;
+
+        // weld by position: attribute seams are several vertices at one position
+        std::vector<unsigned int> weld(vertexCount);
+        std::vector<unsigned int> groupSize(vertexCount, 0);
+        {
+            std::unordered_map<glm::vec3, unsigned int, PositionHash> firstAt;
+            firstAt.reserve(vertexCount);
+            for (unsigned int v = 0; v < vertexCount; ++v)
+            {
+                std::pair<std::unordered_map<glm::vec3, unsigned int, PositionHash>::iterator, bool> it = firstAt.insert(std::make_pair(positions[v], v));
+                weld[v] = it.first->second;
+                groupSize[weld[v]]++;
+            }
+        }
+        // lock seams, open borders and non-manifold edges (an edge of 1 or more than 2 triangles)
+        std::vector<unsigned char> locked(vertexCount, 0);
+        {
+            std::unordered_map<uint64_t, unsigned int> edgeUse;
+            edgeUse.reserve(result.size());
+            for (size_t t = 0; t + 2 < result.size(); t += 3)
+                for (int e = 0; e < 3; ++e)
+                {
+                    unsigned int a = weld[result[t + e]], b = weld[result[t + (e + 1) % 3]];
+                    uint64_t key = a < b ? ((uint64_t)a << 32 | b) : ((uint64_t)b << 32 | a);
+                    edgeUse[key]++;
+                }
+            for (std::unordered_map<uint64_t, unsigned int>::const_iterator it = edgeUse.begin(); it != edgeUse.end(); ++it)
+                if (it->second != 2)
+                {
+                    locked[(unsigned int)(it->first >> 32)] = 1;
+                    locked[(unsigned int)(it->first & 0xFFFFFFFFu)] = 1;
+                }
+            for (unsigned int v = 0; v < vertexCount; ++v)
+                if (groupSize[weld[v]] > 1)
+                    locked[weld[v]] = 1;
+        }
+        // plane quadrics per welded vertex
+        std::vector<Quadric> quadrics(vertexCount, Quadric::zero());
+        for (size_t t = 0; t + 2 < result.size(); t += 3)
+        {
+            const glm::vec3 &p0 = positions[result[t]];
+            const glm::vec3 &p1 = positions[result[t + 1]];
+            const glm::vec3 &p2 = positions[result[t + 2]];
+            glm::dvec3 n = glm::cross(glm::dvec3(p1 - p0), glm::dvec3(p2 - p0));
+            double len = glm::length(n);
+            if (len <= 0.0)
+                continue;
+            n /= len;
+            Quadric q = Quadric::plane(n, -glm::dot(n, glm::dvec3(p0)));
+            for (int c = 0; c < 3; ++c)
+                quadrics[weld[result[t + c]]].add(q);
+        }
+
+        struct Collapse
+        {
+            unsigned int from, to;
+            double cost;
+            bool operator<(const Collapse &o) const { return cost < o.cost; }
+        };
+        const double maxCost = (double)maxError * maxError;
+        std::vector<unsigned int> redirect(vertexCount);
+        std::vector<unsigned char> touched(vertexCount);
+        std::vector<unsigned int> adjacencyStart(vertexCount + 1), adjacency;
+        std::vector<Collapse> collapses;
+        while (result.size() > targetIndexCount)
+        {
+            // triangles around each vertex (CSR)
+            std::fill(adjacencyStart.begin(), adjacencyStart.end(), 0u);
+            for (size_t i = 0; i < result.size(); ++i)
+                adjacencyStart[result[i] + 1]++;
+            for (size_t v = 0; v < vertexCount; ++v)
+                adjacencyStart[v + 1] += adjacencyStart[v];
+            adjacency.resize(result.size());
+            {
+                std::vector<unsigned int> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i)
+                    adjacency[fill[result[i]]++] = (unsigned int)(i / 3);
+            }
+            // every edge in both directions, moving an unlocked vertex onto its neighbour
+            collapses.clear();
+            for (size_t t = 0; t + 2 < result.size(); t += 3)
+                for (int e = 0; e < 3; ++e)
+                {
+                    unsigned int u = result[t + e], v = result[t + (e + 1) % 3];
+                    if (locked[weld[u]])
+                        continue;
+                    Quadric q = quadrics[weld[u]];
+                    q.add(quadrics[weld[v]]);
+                    Collapse c = {u, v, q.error(positions[v])};
+                    if (c.cost <= maxCost)
+                        collapses.push_back(c);
+                }
+            if (collapses.empty())
+                break;
+            std::sort(collapses.begin(), collapses.end());
+            // each collapse removes about two triangles; stop the pass once the target is in reach
+            const size_t wantedCollapses = (result.size() - targetIndexCount) / 6 + 1;
+            std::fill(touched.begin(), touched.end(), 0);
+            for (unsigned int v = 0; v < vertexCount; ++v)
+                redirect[v] = v;
+            size_t applied = 0;
+            for (size_t c = 0; c < collapses.size() && applied < wantedCollapses; ++c)
+            {
+                const unsigned int u = collapses[c].from, v = collapses[c].to;
+                if (touched[u] || touched[v])
+                    continue;
+                // reject collapses that flip a surviving triangle around u
+                const glm::vec3 &target = positions[v];
+                bool flips = false;
+                for (unsigned int a = adjacencyStart[u]; a < adjacencyStart[u + 1] && !flips; ++a)
+                {
+                    const unsigned int *tri = &result[adjacency[a] * 3];
+                    if (weld[tri[0]] == weld[v] || weld[tri[1]] == weld[v] || weld[tri[2]] == weld[v])
+                        continue;
+                    glm::vec3 p[3], moved[3];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        p[k] = positions[tri[k]];
+                        moved[k] = tri[k] == u ? target : p[k];
+                    }
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                    flips = glm::dot(before, after) <= 0.0f;
+                }
+                if (flips)
+                    continue;
+                redirect[u] = v;
+                quadrics[weld[v]].add(quadrics[weld[u]]);
+                resultError = std::max(resultError, (float)std::sqrt(collapses[c].cost));
+                // the neighbourhood changed; its other collapses wait for the next pass
+                for (unsigned int a = adjacencyStart[u]; a < adjacencyStart[u + 1]; ++a)
+                    for (int k = 0; k < 3; ++k)
+                        touched[result[adjacency[a] * 3 + k]] = 1;
+                touched[v] = 1;
+                applied++;
+            }
+            if (applied == 0)
+                break;
+            // apply and drop triangles that became degenerate (two corners at one position)
+            size_t out = 0;
+            for (size_t t = 0; t + 2 < result.size(); t += 3)
+            {
+                unsigned int a = redirect[result[t]], b = redirect[result[t + 1]], c = redirect[result[t + 2]];
+                if (weld[a] == weld[b] || weld[b] == weld[c] || weld[a] == weld[c])
+                    continue;
+                result[out++] = a;
+                result[out++] = b;
+                result[out++] = c;
+            }
+            result.resize(out);
+        }
+        return result;
+    }
+}
+
+#endif
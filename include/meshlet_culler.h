@@ -0,0 +1,171 @@
+#ifndef MESHLET_CULLER_H
+#define MESHLET_CULLER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <frustum.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// MESHLET_CULLING=1: culls the opaque meshes of a model per cluster (Mesh::meshlets) instead of per mesh. A
+// compute pre-pass (shaders/meshlet_cull.comp) tests every cluster's bounding sphere against the frustum
+// and its normal cone against the eye, and writes the surviving index ranges as compacted indirect draws,
+// one region of the command buffer per material bucket. The buckets are then drawn with the regular
+// shaders through glMultiDrawElementsIndirectCount (GL 4.6), or on GL 4.3 over the whole region, whose
+// unused commands are cleared to zero triangles. Needs compute shaders; without them Model draws as usual.
+class MeshletCuller
+{
+public:
+    // std430 mirror of meshlet_cull.comp's Meshlet
+    struct GpuMeshlet
+    {
+        glm::vec4 sphere;
+        glm::vec4 cone;
+        GLuint firstIndex;
+        GLuint indexCount;
+        GLint baseVertex;
+        GLuint slot;
+    };
+
+    enum SlotMode { SKIP = 0, MESHLETS = 1, WHOLE = 2 };
+
+    // per opaque draw, refreshed every cull: how to draw it and where its bucket's commands start
+    struct Slot
+    {
+        GLuint mode;
+        GLuint count;
+        GLuint firstIndex;
+        GLuint bucket;
+        GLuint commandBase;
+    };
+
+    // GPU state of one model
+    struct Target
+    {
+        unsigned int meshletCount = 0;
+        unsigned int slotCount = 0;
+        unsigned int bucketCount = 0;
+        unsigned int commandCount = 0;
+        GLuint meshletBuffer = 0;
+        GLuint slotBuffer = 0;
+        GLuint commandBuffer = 0;
+        // one draw count per bucket (GL_PARAMETER_BUFFER on GL 4.6)
+        GLuint countBuffer = 0;
+
+        bool ready() const { return meshletCount != 0; }
+
+        void release()
+        {
+            GLuint buffers[4] = {meshletBuffer, slotBuffer, commandBuffer, countBuffer};
+            for (int b = 0; b < 4; ++b)
+                if (buffers[b])
+                    glDeleteBuffers(1, &buffers[b]);
+            meshletBuffer = slotBuffer = commandBuffer = countBuffer = 0;
+            meshletCount = slotCount = bucketCount = commandCount = 0;
+        }
+    };
+
+    // `shaderDir` holds meshlet_cull.comp
+    explicit MeshletCuller(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    MeshletCuller(const MeshletCuller &) = delete;
+    MeshletCuller &operator=(const MeshletCuller &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("MESHLET_CULLING");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the cull program (needs GL 4.3)
+    void init()
+    {
+        if (ComputeShader::supported())
+            program.reset(new ComputeShader((shaderDir + "/meshlet_cull.comp").c_str()));
+        if (ready())
+            LOG_INFO("[Meshlets] Cluster culling on the GPU, draws " << (drawCountSupported() ? "counted with glMultiDrawElementsIndirectCount" : "padded with empty commands"));
+        else
+            LOG_INFO("[Meshlets] Cluster culling needs compute shaders (GL 4.3), drawing whole meshes");
+    }
+
+    bool ready() const { return program && program->valid(); }
+
+    // the GPU can source the draw count from the count buffer
+    static bool drawCountSupported() { return GLAD_GL_VERSION_4_6 != 0; }
+
+    // uploads the clusters of a model whose opaque draws form `slotCount` slots in `bucketCount` buckets
+    // covering `commandCount` commands (every cluster of a bucket could survive)
+    void prepare(Target &target, const std::vector<GpuMeshlet> &meshlets, unsigned int slotCount, unsigned int bucketCount, unsigned int commandCount)
+    {
+        target.release();
+        if (meshlets.empty())
+            return;
+        target.meshletCount = (unsigned int)meshlets.size();
+        target.slotCount = slotCount;
+        target.bucketCount = bucketCount;
+        target.commandCount = commandCount;
+        glGenBuffers(1, &target.meshletBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.meshletBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, meshlets.size() * sizeof(GpuMeshlet), &meshlets[0], GL_STATIC_DRAW);
+        glGenBuffers(1, &target.slotBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.slotBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, slotCount * sizeof(Slot), NULL, GL_DYNAMIC_DRAW);
+        glGenBuffers(1, &target.commandBuffer);
+        glGenBuffers(1, &target.countBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    // GL thread, before the model's opaque draws: culls the clusters for `clipFromModel` (projection * view *
+    // model) and the model-space `eye`, with `slots` (one per opaque draw) deciding each draw's mode
+    void cull(Target &target, const std::vector<Slot> &slots, const glm::mat4 &clipFromModel, const glm::vec3 &eye)
+    {
+        if (!ready() || !target.ready() || slots.size() != target.slotCount)
+            return;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.slotBuffer);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, slots.size() * sizeof(Slot), &slots[0]);
+        // orphaned, since an earlier pass may still read them, then zeroed: counts start at 0 and, without
+        // a GPU draw count, the unused commands draw nothing
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.countBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, target.bucketCount * sizeof(GLuint), NULL, GL_STREAM_DRAW);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.commandBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, target.commandCount * 5 * sizeof(GLuint), NULL, GL_STREAM_DRAW);
+        if (!drawCountSupported())
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        const Frustum frustum(clipFromModel);
+        program->use();
+        program->setVec4v("frustumPlanes", frustum.planes, 6);
+        program->setVec3("eye", eye);
+        program->setUint("meshletCount", target.meshletCount);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, target.meshletBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, target.slotBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, target.commandBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, target.countBuffer);
+        glDispatchCompute((target.meshletCount + 63) / 64, 1, 1);
+        // consumed as indirect commands and draw counts
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+    }
+
+    void releaseGpu()
+    {
+        program.reset();
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    std::unique_ptr<ComputeShader> program;
+};
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef MESHOPT_DECODER_H
+#define MESHOPT_DECODER_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Decoders of the EXT_meshopt_compression bitstreams (the format meshoptimizer's encoders and gltfpack -c
+// write), as the extension specifies them:
+//   decodeVertexBuffer  - ATTRIBUTES: per-byte deltas between consecutive elements, zigzag-coded and packed
+//                         in groups of 16 at 0, 2, 4 or 8 bits
+//   decodeIndexBuffer   - TRIANGLES: triangle lists coded against a FIFO of recent edges and vertices
+//   decodeIndexSequence - INDICES: other index data, delta-coded against the last two indices
+// followed, for ATTRIBUTES, by the view's filter (decodeFilterOctahedral / Quaternion / Exponential), which
+// turns the compact encodings of normals, rotations and floats back into what the accessors describe.
+// Everything is scalar and bounds-checked: a stream that doesn't fit its view is rejected, never read past.
+namespace MeshoptDecoder
+{
+    inline unsigned char unzigzag8(unsigned char v)
+    {
+        return (unsigned char)(-(int)(v & 1) ^ (v >> 1));
+    }
+
+    // LEB128-style: 7 bits per byte, low first, at most 5 bytes; false if the stream ends inside it
+    inline bool readVByte(const unsigned char *&data, const unsigned char *end, unsigned int &out)
+    {
+        out = 0;
+        for (unsigned int shift = 0; shift < 35; shift += 7)
+        {
+            if (data >= end)
+                return false;
+            const unsigned char group = *data++;
+            out |= (unsigned int)(group & 127) << shift;
+            if (group < 128)
+                return true;
+        }
+        return true;
+    }
+
+    // one 16-byte group at 0, 2, 4 or 8 bits per value (`bitsLog2` 0..3); 2- and 4-bit values that are all
+    // ones escape to a literal byte after the packed ones. Null if the stream ends inside the group.
+    inline const unsigned char *decodeBytesGroup(const unsigned char *data, const unsigned char *end, unsigned char *out, int bitsLog2)
+    {
+        if (bitsLog2 == 0)
+        {
+            std::memset(out, 0, 16);
+            return data;
+        }
+        if (bitsLog2 == 3)
+        {
+            if (end - data < 16)
+                return NULL;
+            std::memcpy(out, data, 16);
+            return data + 16;
+        }
+        const int bits = bitsLog2 == 1 ? 2 : 4;
+        const unsigned int escape = (1u << bits) - 1;
+        const int packedBytes = bits * 16 / 8;
+        if (end - data < packedBytes)
+            return NULL;
+        const unsigned char *literal = data + packedBytes;
+        for (int i = 0; i < 16; ++i)
+        {
+            // most significant bits first
+            const int bit = i * bits;
+            const unsigned int value = (data[bit / 8] >> (8 - bits - bit % 8)) & escape;
+            if (value == escape)
+            {
+                if (literal >= end)
+                    return NULL;
+                out[i] = *literal++;
+            }
+            else
+                out[i] = (unsigned char)value;
+        }
+        return literal;
+    }
+
+    // `size` (a multiple of 16) bytes of one byte lane: the 2-bit group modes, then the groups
+    inline const unsigned char *decodeBytes(const unsigned char *data, const unsigned char *end, unsigned char *out, size_t size)
+    {
+        const size_t groups = size / 16;
+        const size_t headerSize = (groups + 3) / 4;
+        if ((size_t)(end - data) < headerSize)
+            return NULL;
+        const unsigned char *header = data;
+        data += headerSize;
+        for (size_t g = 0; g < groups && data; ++g)
+            data = decodeBytesGroup(data, end, out + g * 16, (header[g / 4] >> ((g % 4) * 2)) & 3);
+        return data;
+    }
+
+    // ATTRIBUTES: `count` elements of `stride` bytes (a multiple of 4, at most 256) into `out`
+    inline bool decodeVertexBuffer(unsigned char *out, size_t count, size_t stride, const unsigned char *data, size_t size)
+    {
+        // header 0xA0 (version 0), blocks, then a tail holding the first element, zero-padded in front to
+        // at least 32 bytes
+        const size_t tailSize = stride < 32 ? 32 : stride;
+        if (stride == 0 || stride > 256 || stride % 4 != 0 || size < 1 + tailSize || data[0] != 0xA0)
+            return false;
+        const unsigned char *end = data + size;
+        const unsigned char *tail = end - tailSize;
+        unsigned char last[256];
+        std::memcpy(last, end - stride, stride);
+        // elements per block: what fits 8 KB, in whole groups of 16, at most 256
+        size_t blockSize = (8192 / stride) & ~(size_t)15;
+        if (blockSize > 256)
+            blockSize = 256;
+        unsigned char lane[256];
+        const unsigned char *p = data + 1;
+        for (size_t first = 0; first < count; first += blockSize)
+        {
+            const size_t elements = count - first < blockSize ? count - first : blockSize;
+            const size_t aligned = (elements + 15) & ~(size_t)15;
+            unsigned char *block = out + first * stride;
+            for (size_t k = 0; k < stride; ++k)
+            {
+                p = decodeBytes(p, tail, lane, aligned);
+                if (!p)
+                    return false;
+                unsigned char previous = last[k];
+                for (size_t i = 0; i < elements; ++i)
+                {
+                    previous = (unsigned char)(previous + unzigzag8(lane[i]));
+                    block[i * stride + k] = previous;
+                }
+            }
+            std::memcpy(last, block + (elements - 1) * stride, stride);
+        }
+        return p == tail;
+    }
+
+    inline void writeIndex(unsigned char *out, size_t i, size_t indexSize, unsigned int value)
+    {
+        if (indexSize == 2)
+        {
+            const uint16_t v = (uint16_t)value;
+            std::memcpy(out + i * 2, &v, 2);
+        }
+        else
+            std::memcpy(out + i * 4, &value, 4);
+    }
+
+    // TRIANGLES: `count` (a multiple of 3) indices of `indexSize` (2 or 4) bytes into `out`
+    inline bool decodeIndexBuffer(unsigned char *out, size_t count, size_t indexSize, const unsigned char *data, size_t size)
+    {
+        // header 0xE0 | version, one code byte per triangle, the extra bytes some codes need, and a 16-byte
+        // table of the common extra bytes at the end
+        if (count % 3 != 0 || (indexSize != 2 && indexSize != 4) || size < 1 + count / 3 + 16 || (data[0] & 0xF0) != 0xE0)
+            return false;
+        const int version = data[0] & 0x0F;
+        if (version > 1)
+            return false;
+        // version 1 codes vertex FIFO hits 13 and 14 as the last free index -1 / +1 instead
+        const int fifoLimit = version >= 1 ? 13 : 15;
+        unsigned int edges[16][2], vertices[16];
+        std::memset(edges, 0xFF, sizeof(edges));
+        std::memset(vertices, 0xFF, sizeof(vertices));
+        unsigned int edgeOffset = 0, vertexOffset = 0;
+        unsigned int next = 0, last = 0;
+        const unsigned char *code = data + 1;
+        const unsigned char *p = code + count / 3;
+        const unsigned char *table = data + size - 16;
+
+        struct Fifo
+        {
+            static void pushVertex(unsigned int *fifo, unsigned int &offset, unsigned int v, bool push = true)
+            {
+                fifo[offset] = v;
+                offset = (offset + (push ? 1 : 0)) & 15;
+            }
+            static void pushEdge(unsigned int (*fifo)[2], unsigned int &offset, unsigned int a, unsigned int b)
+            {
+                fifo[offset][0] = a;
+                fifo[offset][1] = b;
+                offset = (offset + 1) & 15;
+            }
+            static bool readFree(const unsigned char *&p, const unsigned char *end, unsigned int &last, unsigned int &out)
+            {
+                unsigned int v;
+                if (!readVByte(p, end, v))
+                    return false;
+                last += (v >> 1) ^ (0u - (v & 1));
+                out = last;
+                return true;
+            }
+        };
+
+        for (size_t i = 0; i < count; i += 3)
+        {
+            if (p > table)
+                return false;
+            const unsigned char triangle = *code++;
+            unsigned int a, b, c;
+            if (triangle < 0xF0)
+            {
+                // an edge from the FIFO plus one vertex: next new, a FIFO hit or a free index
+                const unsigned int *edge = edges[(edgeOffset - 1 - (triangle >> 4)) & 15];
+                a = edge[0];
+                b = edge[1];
+                const int fec = triangle & 15;
+                if (fec < fifoLimit)
+                {
+                    c = fec == 0 ? next++ : vertices[(vertexOffset - 1 - fec) & 15];
+                    Fifo::pushVertex(vertices, vertexOffset, c, fec == 0);
+                }
+                else
+                {
+                    if (fec != 15)
+                        c = last = last + (fec == 13 ? (unsigned int)-1 : 1u);
+                    else if (!Fifo::readFree(p, table, last, c))
+                        return false;
+                    Fifo::pushVertex(vertices, vertexOffset, c);
+                }
+                Fifo::pushEdge(edges, edgeOffset, c, b);
+                Fifo::pushEdge(edges, edgeOffset, a, c);
+            }
+            else
+            {
+                // no shared edge: the first vertex is new (or free), the other two come from the code's
+                // extra byte, out of the table or the stream
+                int fea, feb, fec;
+                if (triangle < 0xFE)
+                {
+                    const unsigned char extra = table[triangle & 15];
+                    fea = 0;
+                    feb = extra >> 4;
+                    fec = extra & 15;
+                }
+                else
+                {
+                    if (p >= table)
+                        return false;
+                    const unsigned char extra = *p++;
+                    if (extra == 0)
+                        next = 0;
+                    fea = triangle == 0xFE ? 0 : 15;
+                    feb = extra >> 4;
+                    fec = extra & 15;
+                }
+                a = fea == 0 ? next++ : 0;
+                b = feb == 0 ? next++ : vertices[(vertexOffset - feb) & 15];
+                c = fec == 0 ? next++ : vertices[(vertexOffset - fec) & 15];
+                if (fea == 15 && !Fifo::readFree(p, table, last, a))
+                    return false;
+                if (feb == 15 && !Fifo::readFree(p, table, last, b))
+                    return false;
+                if (fec == 15 && !Fifo::readFree(p, table, last, c))
+                    return false;
+                Fifo::pushVertex(vertices, vertexOffset, a);
+                Fifo::pushVertex(vertices, vertexOffset, b, feb == 0 || feb == 15);
+                Fifo::pushVertex(vertices, vertexOffset, c, fec == 0 || fec == 15);
+                Fifo::pushEdge(edges, edgeOffset, b, a);
+                Fifo::pushEdge(edges, edgeOffset, c, b);
+                Fifo::pushEdge(edges, edgeOffset, a, c);
+            }
+            writeIndex(out, i, indexSize, a);
+            writeIndex(out, i + 1, indexSize, b);
+            writeIndex(out, i + 2, indexSize, c);
+        }
+        return p == table;
+    }
+
+    // INDICES: `count` indices of `indexSize` (2 or 4) bytes into `out`
+    inline bool decodeIndexSequence(unsigned char *out, size_t count, size_t indexSize, const unsigned char *data, size_t size)
+    {
+        // header 0xD0 | version, one varint per index (the low bit picks one of two baselines, the rest
+        // is the zigzag delta against it), a 4-byte tail
+        if ((indexSize != 2 && indexSize != 4) || size < 1 + count + 4 || (data[0] & 0xF0) != 0xD0 || (data[0] & 0x0F) > 1)
+            return false;
+        const unsigned char *p = data + 1;
+        const unsigned char *end = data + size - 4;
+        unsigned int last[2] = {0, 0};
+        for (size_t i = 0; i < count; ++i)
+        {
+            unsigned int v;
+            if (p >= end || !readVByte(p, end, v))
+                return false;
+            const unsigned int baseline = v & 1;
+            v >>= 1;
+            last[baseline] += (v >> 1) ^ (0u - (v & 1));
+            writeIndex(out, i, indexSize, last[baseline]);
+        }
+        return p == end;
+    }
+
+    inline int roundToInt(float v)
+    {
+        return (int)(v + (v >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    // OCTAHEDRAL: 4 signed components (8- or 16-bit) per element, x and y on the octahedron and the third
+    // holding the scale; rewritten as the unit vector at that scale. The fourth component is left alone.
+    template <typename T>
+    inline void decodeFilterOctahedral(T *data, size_t count)
+    {
+        const float scale = (float)((1 << (sizeof(T) * 8 - 1)) - 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            T *v = data + i * 4;
+            float x = (float)v[0], y = (float)v[1];
+            float z = (float)v[2] - std::fabs(x) - std::fabs(y);
+            // fold the lower hemisphere back out
+            const float t = z < 0.0f ? z : 0.0f;
+            x -= x >= 0.0f ? t : -t;
+            y -= y >= 0.0f ? t : -t;
+            const float length = std::sqrt(x * x + y * y + z * z);
+            const float s = length > 0.0f ? scale / length : 0.0f;
+            v[0] = (T)roundToInt(x * s);
+            v[1] = (T)roundToInt(y * s);
+            v[2] = (T)roundToInt(z * s);
+        }
+    }
+
+    // QUATERNION: 4 x int16 per element, the three smallest components and (in the low 2 bits of the
+    // fourth) the index of the largest, which is rebuilt from the unit length
+    inline void decodeFilterQuaternion(int16_t *data, size_t count)
+    {
+        const float scale = 1.0f / std::sqrt(2.0f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            int16_t *q = data + i * 4;
+            const int range = q[3] | 3;
+            const float s = scale / (float)range;
+            const float x = q[0] * s, y = q[1] * s, z = q[2] * s;
+            const float ww = 1.0f - x * x - y * y - z * z;
+            const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+            const int largest = q[3] & 3;
+            const int16_t xs = (int16_t)roundToInt(x * 32767.0f), ys = (int16_t)roundToInt(y * 32767.0f);
+            const int16_t zs = (int16_t)roundToInt(z * 32767.0f), ws = (int16_t)roundToInt(w * 32767.0f);
+            q[(largest + 1) & 3] = xs;
+            q[(largest + 2) & 3] = ys;
+            q[(largest + 3) & 3] = zs;
+            q[largest] = ws;
+        }
+    }
+
+    // EXPONENTIAL: 32-bit values of a 24-bit signed mantissa and an 8-bit signed exponent, rewritten as the
+    // floats mantissa * 2^exponent
+    inline void decodeFilterExponential(uint32_t *data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int32_t mantissa = (int32_t)(data[i] << 8) >> 8;
+            const int32_t exponent = (int32_t)data[i] >> 24;
+            const float value = std::ldexp((float)mantissa, exponent);
+            std::memcpy(&data[i], &value, 4);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef MIP_CHAIN_H
+#define MIP_CHAIN_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// CPU mip chains of 8-bit images, shared by the runtime texture decode (buildMipChain) and car_cook. Each
+// level is a 2x2 box filter of the one above: sRGB colour channels are averaged as linear values (what
+// glGenerateMipmap is meant to do for sRGB formats, and not every driver does), alpha and data channels
+// as they are, and normal maps are renormalized after averaging so the shorter vectors of rough regions
+// don't darken the lighting of distant levels.
+namespace MipChain
+{
+    inline float srgbToLinear(float c) { return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f); }
+    inline float linearToSrgb(float c) { return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f; }
+
+    // levels of a full chain down to 1x1
+    inline uint32_t levelCount(uint32_t w, uint32_t h)
+    {
+        uint32_t levels = 1;
+        while (w > 1 || h > 1)
+        {
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+            ++levels;
+        }
+        return levels;
+    }
+
+    // bytes of all `levels` levels of a `w` x `h` image, tightly packed
+    inline size_t chainBytes(uint32_t w, uint32_t h, uint32_t components, uint32_t levels)
+    {
+        size_t bytes = 0;
+        for (uint32_t l = 0; l < levels; ++l)
+        {
+            bytes += (size_t)w * h * components;
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+        }
+        return bytes;
+    }
+
+    // 2x2 box filter of `src` (w x h) into the next level at `dst`; odd edges reuse the last row/column.
+    // `gamma`: RGB is sRGB encoded; `normalMap`: RGB is a tangent-space normal, renormalized
+    inline void downsample(const unsigned char *src, uint32_t w, uint32_t h, uint32_t components, bool gamma, bool normalMap, unsigned char *dst)
+    {
+        static const struct LinearTable
+        {
+            float value[256];
+            LinearTable()
+            {
+                for (int i = 0; i < 256; ++i)
+                    value[i] = srgbToLinear(i / 255.0f);
+            }
+        } toLinear;
+        normalMap = normalMap && components >= 3;
+        const uint32_t dw = w > 1 ? w / 2 : 1, dh = h > 1 ? h / 2 : 1;
+        for (uint32_t y = 0; y < dh; ++y)
+        {
+            const uint32_t y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+            for (uint32_t x = 0; x < dw; ++x)
+            {
+                const uint32_t x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+                const unsigned char *p[4] = {
+                    &src[((size_t)y0 * w + x0) * components], &src[((size_t)y0 * w + x1) * components],
+                    &src[((size_t)y1 * w + x0) * components], &src[((size_t)y1 * w + x1) * components]};
+                unsigned char *out = &dst[((size_t)y * dw + x) * components];
+                float v[4];
+                for (uint32_t c = 0; c < components; ++c)
+                {
+                    // alpha stays linear in sRGB_ALPHA textures; of two channels the second is alpha
+                    const bool color = gamma && c < 3 && (components != 2 || c == 0);
+                    float sum = 0.0f;
+                    for (int k = 0; k < 4; ++k)
+                        sum += color ? toLinear.value[p[k][c]] : p[k][c] / 255.0f;
+                    v[c] = sum * 0.25f;
+                    if (color)
+                        v[c] = linearToSrgb(v[c]);
+                }
+                if (normalMap)
+                {
+                    glm::vec3 n = glm::vec3(v[0], v[1], v[2]) * 2.0f - 1.0f;
+                    const float length = glm::length(n);
+                    n = length > 1e-4f ? n / length : glm::vec3(0.0f, 0.0f, 1.0f);
+                    v[0] = n.x * 0.5f + 0.5f;
+                    v[1] = n.y * 0.5f + 0.5f;
+                    v[2] = n.z * 0.5f + 0.5f;
+                }
+                for (uint32_t c = 0; c < components; ++c)
+                    out[c] = (unsigned char)std::floor(glm::clamp(v[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    // fills levels 1..levels-1 of the chain at `chain`, whose level 0 (w x h) is already in place
+    inline void build(unsigned char *chain, uint32_t w, uint32_t h, uint32_t components, uint32_t levels, bool gamma, bool normalMap)
+    {
+        unsigned char *level = chain;
+        for (uint32_t l = 1; l < levels; ++l)
+        {
+            unsigned char *next = level + (size_t)w * h * components;
+            downsample(level, w, h, components, gamma, normalMap, next);
+            level = next;
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+        }
+    }
+}
+
+#endif
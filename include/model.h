@@ -5,21 +5,61 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <stb_image.h>
 #include <json.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <async_log.h>
 #include <mesh.h>
+#include <geometry_kernels.h>
+#include <material_table.h>
+#include <material_overrides.h>
+#include <gltf_loader.h>
+#include <cooked_format.h>
+#include <mapped_file.h>
+#include <virtual_file_system.h>
+#include <texture_loader.h>
 #include <shader.h>
+#include <gl_backend.h>
+#include <gl_state.h>
+#include <render_debug.h>
+#include <bvh.h>
+#include <triangle_bvh.h>
+#include <occlusion_culler.h>
+#include <meshlet_culler.h>
+#include <scene_culler.h>
+#include <visibility_buffer.h>
+#include <gpu_picker.h>
+#include <mesh_simplifier.h>
+#include <mesh_optimizer.h>
+#include <transform_hierarchy.h>
+#include <node_animation.h>
+#include <transparent_queue.h>
+#include <frame_trace.h>
+#include <startup_timings.h>
+#include <draw_stats.h>
+#include <gpu_memory.h>
+#include <geometry_arena.h>
+#include <texture_streamer.h>
+#include <mesh_regions.h>
+#include <frame_ring_buffer.h>
+#include <frame_arena.h>
 
 #include <string>
 #include <fstream>
 #include <sstream>
-#include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
 using namespace std;
 
 unsigned int TextureFromFile(const char *path, const string &directory, bool gamma = false);
@@ -32,44 +72,2657 @@ public:
     vector<Mesh>    meshes;
     string directory;
     bool gammaCorrection;
+    // model-space AABB over all meshes and total vertex count (valid even when CPU geometry is released)
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    // box the vertex positions are quantized against: the model bounds, unless instanced meshes keep
+    // vertices in their own space outside them
+    glm::vec3 quantizationMin = glm::vec3(0.0f);
+    glm::vec3 quantizationMax = glm::vec3(0.0f);
+    size_t vertexCount = 0;
 
-    // constructor, expects a filepath to a 3D model.
-    Model(string const &path, bool gamma = false) : gammaCorrection(gamma)
+    // empty model; fill it with importFromFile() + uploadToGpu() (ModelLoader does this asynchronously)
+    Model() : gammaCorrection(false) {}
+
+    // constructor, expects a filepath to a 3D model. Loads synchronously.
+    // Mesh vertices/indices are freed after GPU upload unless keepCpuData is set (picking, physics, ...).
+    Model(string const &path, bool gamma = false, bool keepCpuData = false) : gammaCorrection(gamma)
+    {
+        importFromFile(path, keepCpuData);
+        uploadToGpu();
+        textureLoader.finish();
+    }
+
+    // CPU half of loading: parses the file and builds the meshes. Makes no GL calls, so it can run on a
+    // worker thread; texture decodes are queued on the pool and Texture::id holds TextureLoader tickets
+    // until uploadToGpu().
+    void importFromFile(string const &path, bool keepCpuData = false)
+    {
+        FrameTrace::Scope trace("import model", path);
+        StartupTimings::Scope startup("import");
+        keepCpu = keepCpuData;
+        cacheStats = CacheStats();
+        lazyRegions = MeshRegions::enabledByEnv();
+        for (unsigned int r = 0; r < MeshRegions::COUNT; ++r)
+            regions[r] = RegionTextures();
+        loadModel(path);
+        const size_t importedMeshes = meshes.size();
+        const size_t importedVertices = cpuVertexCount();
+        mergeStaticMeshes();
+        processMeshGeometry();
+        computeBounds();
+        if (TriangleBVH::enabledByEnv())
+            buildTriangleBvhs();
+        if (importedMeshes)
+            LOG_INFO("[Model] Import: " << importedMeshes << " meshes -> " << meshes.size() << " (same-material static meshes merged), "
+                     << importedVertices << " vertices -> " << cpuVertexCount() << " (" << cacheStats.welded << " welded)");
+        if (cacheStats.triangles)
+            LOG_INFO("[Model] Vertex cache: ACMR " << cacheStats.missesBefore / cacheStats.triangles << " -> "
+                     << cacheStats.missesAfter / cacheStats.triangles << " over " << cacheStats.triangles << " triangles (FIFO "
+                     << MeshOptimizer::CACHE_SIZE << ")");
+    }
+
+    // GL half of loading: creates the textures (placeholders until their images arrive), patches the
+    // real texture names into the meshes and uploads the geometry. The model is drawable afterwards.
+    void uploadToGpu()
+    {
+        FrameTrace::Scope trace("upload model");
+        armRegions();
+        textureLoader.createTextures();
+        const TextureLoader &tl = textureLoader;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            meshes[i].remapTextureIds([&tl](unsigned int ticket) { return tl.textureId(ticket); });
+        for (size_t i = 0; i < textures_loaded.size(); ++i)
+            textures_loaded[i].id = tl.textureId(textures_loaded[i].id);
+        // image decodes keep running on the worker pool while the geometry is packed and uploaded
+        uploadGeometry();
+        buildMaterialTable([](const Texture &t) { return t.id ? 0 : -1; }, directory);
+        buildDrawList();
+        if (!keepCpu)
+            for (size_t i = 0; i < meshes.size(); ++i)
+                meshes[i].releaseCpuGeometry();
+        glState().invalidate();
+    }
+
+    // GL thread: uploads texture images whose decode has finished, for at most budgetMs.
+    // Returns true once every texture has its real image.
+    bool streamTextures(double budgetMs)
+    {
+        return textureLoader.uploadReady(budgetMs);
+    }
+
+    // GL thread, once per frame with LAZY_REGIONS=1: starts loading the deferred textures of the regions a
+    // camera at `eye` (model space) has come near (MeshRegions::near) and uploads the decoded ones for at
+    // most budgetMs. Loaded regions stay loaded.
+    void requestRegions(const glm::vec3 &eye, double budgetMs)
+    {
+        if (!regionsArmed)
+            return;
+        for (unsigned int r = MeshRegions::INTERIOR; r < MeshRegions::COUNT; ++r) {
+            RegionTextures &region = regions[r];
+            if (region.loaded || region.tickets.empty() || !MeshRegions::near(r, eye, region.boundsMin, region.boundsMax, boundsMin, boundsMax))
+                continue;
+            region.loaded = true;
+            regionsStreaming = true;
+            LOG_INFO("[Model] Camera near the " << MeshRegions::name(r) << ", loading its " << textureLoader.load(region.tickets) << " textures");
+        }
+        if (regionsStreaming)
+            regionsStreaming = !textureLoader.uploadReady(budgetMs);
+    }
+
+    // GL thread: loads a file written by car_cook. The vertex/index sections are uploaded straight from
+    // the memory mapping and the textures come with their full mip chain, so nothing is parsed, packed or
+    // decoded (with TEXTURE_STREAMING=1 only the small levels; the TextureStreamer keeps the mapping open
+    // to read the rest from). The file may also be a stored entry of a .carpak (VirtualFileSystem), mapped
+    // in place the same way. Returns false (leaving the model empty) if the file is missing, truncated, from another
+    // format version or older than its source model; callers then import the source as usual.
+    // With `proxy` only the file's low-detail proxy (CookedFormat) is loaded, false if it has none; the
+    // model is then isProxy() until the caller releases it (releaseGpu) and loads the whole file over it.
+    bool loadCooked(string const &path, string const &sourcePath = string(), bool proxy = false)
+    {
+        FrameTrace::Scope trace("load cooked", path);
+        StartupTimings::Scope startup("import");
+        FileView file;
+        if (!fileSystem().open(path, file))
+            return false;
+        const unsigned char *base = file.data();
+        const CookedFormat::Header &cooked = *(const CookedFormat::Header *)base;
+        if (file.size() < sizeof(CookedFormat::Header) || std::memcmp(cooked.magic, CookedFormat::MAGIC, 4) != 0) {
+            LOG_INFO("[Model] '" << path << "' is not a cooked model");
+            return false;
+        }
+        if (cooked.version != CookedFormat::VERSION || cooked.vertexStride != sizeof(PackedVertex)) {
+            LOG_INFO("[Model] '" << path << "' has cooked version " << cooked.version << " (expected " << CookedFormat::VERSION << "), re-run car_cook");
+            return false;
+        }
+        if (cooked.fileSize != file.size()) {
+            LOG_WARN("[Model] '" << path << "' is truncated (" << file.size() << " of " << cooked.fileSize << " bytes)");
+            return false;
+        }
+        if (proxy) {
+            const CookedFormat::Header &inner = *(const CookedFormat::Header *)(base + cooked.proxyOffset);
+            if (!cooked.proxySize || cooked.proxyOffset + cooked.proxySize > file.size() || cooked.proxySize < sizeof(CookedFormat::Header)
+                || std::memcmp(inner.magic, CookedFormat::MAGIC, 4) != 0 || inner.fileSize != cooked.proxySize)
+                return false;
+        }
+        if (!sourcePath.empty()) {
+            // a missing source is fine (deployments may ship only the cooked file)
+            FileView source;
+            if (fileSystem().open(sourcePath, source) && CookedFormat::hashBytes(source.data(), source.size()) != cooked.sourceHash) {
+                LOG_INFO("[Model] '" << path << "' is stale (" << sourcePath << " changed since it was cooked)");
+                return false;
+            }
+        }
+        if (proxy)
+            base += cooked.proxyOffset;
+        const CookedFormat::Header &header = *(const CookedFormat::Header *)base;
+        const CookedFormat::Mesh *cookedMeshes = (const CookedFormat::Mesh *)(base + header.meshOffset);
+        const CookedFormat::MeshLod *cookedLods = (const CookedFormat::MeshLod *)(base + header.meshLodOffset);
+        const CookedFormat::Meshlet *cookedMeshlets = (const CookedFormat::Meshlet *)(base + header.meshletOffset);
+        const CookedFormat::Instance *cookedInstances = (const CookedFormat::Instance *)(base + header.instanceOffset);
+        const CookedFormat::Node *cookedNodes = (const CookedFormat::Node *)(base + header.nodeOffset);
+        const CookedFormat::MeshTexture *meshTextures = (const CookedFormat::MeshTexture *)(base + header.meshTextureOffset);
+        const CookedFormat::Texture *cookedTex = (const CookedFormat::Texture *)(base + header.textureOffset);
+        const char *strings = (const char *)(base + header.stringOffset);
+
+        for (uint32_t t = 0; t < header.textureCount; ++t) {
+            if (cookedTex[t].encoding == CookedFormat::BC7 && !bptcSupported()) {
+                LOG_WARN("[Model] '" << path << "' uses BC7 textures but the driver has no BPTC support (cook with --uncompressed)");
+                return false;
+            }
+        }
+
+        directory = path.substr(0, path.find_last_of('/'));
+        // geometry straight from the mapping into the shared buffers
+        boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+        boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+        vertexCount = (size_t)header.vertexCount;
+        quantizationMin = glm::vec3(header.quantizationMin[0], header.quantizationMin[1], header.quantizationMin[2]);
+        quantizationMax = glm::vec3(header.quantizationMax[0], header.quantizationMax[1], header.quantizationMax[2]);
+        geometry.positionOffset = quantizationMin;
+        geometry.positionScale = VertexPacking::quantizationExtent(quantizationMin, quantizationMax);
+        glGenVertexArrays(1, &geometry.vao);
+        glState().bindVertexArray(geometry.vao);
+        geometry.indexSize = header.indexSize == 2 ? 2 : 4;
+        allocateGeometry((size_t)header.vertexCount, (size_t)header.indexCount);
+        if (header.vertexCount)
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)geometry.vertexBytes(), (GLsizeiptr)(header.vertexCount * sizeof(PackedVertex)), base + header.vertexOffset);
+        if (header.indexCount)
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)geometry.indexBytes(), (GLsizeiptr)(header.indexCount * geometry.indexSize), base + header.indexOffset);
+        Mesh::setupVertexFormat(geometry.vao, geometry.vbo, geometry.vertexBytes());
+        glState().bindVertexArray(0);
+        // the cooked index offsets are relative to the model's own index data
+        const unsigned int indexBase = (unsigned int)geometry.indices.offset;
+
+        nodes.clear();
+        for (uint32_t n = 0; n < header.nodeCount; ++n)
+            nodes.add(cookedNodes[n].parent, glm::make_mat4(cookedNodes[n].local), string(strings + cookedNodes[n].nameOffset, cookedNodes[n].nameLength));
+
+        // meshes; Texture::id holds the cooked texture index until the GL textures exist
+        meshes.clear();
+        meshes.reserve(header.meshCount);
+        for (uint32_t i = 0; i < header.meshCount; ++i) {
+            const CookedFormat::Mesh &cm = cookedMeshes[i];
+            vector<Texture> textures;
+            for (uint32_t k = 0; k < cm.textureCount; ++k) {
+                const CookedFormat::MeshTexture &mt = meshTextures[cm.firstTexture + k];
+                Texture tex;
+                tex.id = mt.texture;
+                tex.slot = Texture::slotFromName(string(strings + mt.typeOffset, mt.typeLength));
+                if (mt.texture < header.textureCount)
+                    tex.path.assign(strings + cookedTex[mt.texture].pathOffset, cookedTex[mt.texture].pathLength);
+                tex.uvOffset = glm::vec2(mt.uvOffset[0], mt.uvOffset[1]);
+                tex.uvScale = glm::vec2(mt.uvScale[0], mt.uvScale[1]);
+                tex.uvRotation = mt.uvRotation;
+                textures.push_back(tex);
+            }
+            glm::vec4 factor(cm.baseColorFactor[0], cm.baseColorFactor[1], cm.baseColorFactor[2], cm.baseColorFactor[3]);
+            Mesh mesh(VertexStreams(), vector<unsigned int>(), std::move(textures), factor, cm.transparent != 0, cm.metallicFactor, cm.roughnessFactor);
+            mesh.setAlphaMode((Mesh::AlphaMode)cm.alphaMode, cm.alphaCutoff);
+            mesh.setClearcoat(cm.clearcoatFactor, cm.clearcoatRoughnessFactor);
+            mesh.setTransmission(cm.transmissionFactor);
+            mesh.setSpecular(cm.specularFactor, glm::vec3(cm.specularColorFactor[0], cm.specularColorFactor[1], cm.specularColorFactor[2]));
+            mesh.occlusionStrength = cm.occlusionStrength;
+            mesh.materialTag = cm.materialTag;
+            mesh.partNode = cm.partNode;
+            mesh.weightedBlend = cm.transparent == 2;
+            mesh.centroid = glm::vec3(cm.centroid[0], cm.centroid[1], cm.centroid[2]);
+            mesh.boundsMin = glm::vec3(cm.boundsMin[0], cm.boundsMin[1], cm.boundsMin[2]);
+            mesh.boundsMax = glm::vec3(cm.boundsMax[0], cm.boundsMax[1], cm.boundsMax[2]);
+            mesh.localCentroid = glm::vec3(cm.localCentroid[0], cm.localCentroid[1], cm.localCentroid[2]);
+            mesh.localBoundsMin = glm::vec3(cm.localBoundsMin[0], cm.localBoundsMin[1], cm.localBoundsMin[2]);
+            mesh.localBoundsMax = glm::vec3(cm.localBoundsMax[0], cm.localBoundsMax[1], cm.localBoundsMax[2]);
+            mesh.uvDensity = cm.uvDensity;
+            // the cooked format has no sphere; the AABB's circumscribed one is still a valid bound
+            mesh.boundingRadius = glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f;
+            mesh.vertexCount = cm.vertexCount;
+            mesh.VAO = geometry.vao;
+            mesh.baseVertex = cm.baseVertex;
+            mesh.firstIndex = indexBase + cm.firstIndex;
+            mesh.indexCount = cm.indexCount;
+            mesh.indexSize = geometry.indexSize;
+            Mesh::Lod full = {mesh.firstIndex, cm.indexCount, 0.0f};
+            mesh.lods.push_back(full);
+            for (uint32_t l = 0; l < cm.lodCount && cm.firstLod + l < header.meshLodCount; ++l) {
+                const CookedFormat::MeshLod &cl = cookedLods[cm.firstLod + l];
+                Mesh::Lod lod = {indexBase + cl.firstIndex, cl.indexCount, cl.error};
+                mesh.lods.push_back(lod);
+            }
+            for (uint32_t k = 0; k < cm.instanceCount && cm.firstInstance + k < header.instanceCount; ++k) {
+                const CookedFormat::Instance &ci = cookedInstances[cm.firstInstance + k];
+                mesh.instances.push_back(glm::make_mat4(ci.matrix));
+                mesh.instanceNodes.push_back(ci.node < (int32_t)header.nodeCount ? ci.node : -1);
+            }
+            for (uint32_t c = 0; c < cm.meshletCount && cm.firstMeshlet + c < header.meshletCount; ++c) {
+                const CookedFormat::Meshlet &cl = cookedMeshlets[cm.firstMeshlet + c];
+                Mesh::Meshlet meshlet = {cl.firstIndex, cl.indexCount, glm::vec4(cl.sphere[0], cl.sphere[1], cl.sphere[2], cl.sphere[3]),
+                                         glm::vec4(cl.cone[0], cl.cone[1], cl.cone[2], cl.cone[3])};
+                mesh.meshlets.push_back(meshlet);
+            }
+            meshes.push_back(std::move(mesh));
+        }
+
+        // textures: every level was mipped (and block-compressed) offline, so this is one upload per level.
+        // TEXTURE_ARRAYS=1 packs them into arrays drawn through the material table instead
+        uint64_t textureBytes = 0;
+        const char *arraysEnv = std::getenv("TEXTURE_ARRAYS");
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (!(arraysEnv && std::string(arraysEnv) == "1" && uploadCookedArrays(base, header, cookedTex, path, textureBytes))) {
+            uploadCookedTextures(base, header, cookedTex, path, textureBytes,
+                                 TextureStreamer::enabledByEnv() && !proxy ? file.mapping() : std::shared_ptr<const MappedFile>());
+            buildMaterialTable([](const Texture &t) { return t.id ? 0 : -1; }, path);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        uploadInstances();
+        buildDrawList();
+        if (TriangleBVH::enabledByEnv())
+            buildCookedTriangleBvhs(base, header);
+        glState().invalidate();
+        proxyLoaded = proxy;
+        LOG_INFO("[Model] Loaded cooked " << (proxy ? "proxy of '" : "'") << path << "': " << meshes.size() << " meshes, " << header.textureCount << " textures ("
+                 << textureBytes / (1024 * 1024) << " MiB), vertices="
+                 << header.vertexCount << " indices=" << header.indexCount);
+        return true;
+    }
+
+    // nearest mesh the model-space ray origin + t * dir hits, or -1: exactly with the triangle trees
+    // (raycast()), else at box level (the CPU vertices are released after upload)
+    int pickMesh(const glm::vec3 &origin, const glm::vec3 &dir, float &t) const
+    {
+        if (!hasTriangleBvhs())
+            return meshTree.raycast(origin, dir, t, [this](unsigned int i, float tBox) { return meshHiddenAt(i) ? -1.0f : tBox; });
+        RayHit hit;
+        if (!raycast(Ray(origin, dir), hit))
+            return -1;
+        t = hit.t;
+        return hit.mesh;
+    }
+
+    // a model-space ray for raycast(): origin + t * direction, 0 < t < tMax (direction needn't be unit length;
+    // t is in its units)
+    struct Ray
+    {
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float tMax;
+
+        Ray(const glm::vec3 &origin = glm::vec3(0.0f), const glm::vec3 &direction = glm::vec3(0.0f, 0.0f, -1.0f), float tMax = FLT_MAX)
+            : origin(origin), direction(direction), tMax(tMax)
+        {
+        }
+    };
+
+    // exact hit of raycast(), in model space
+    struct RayHit
+    {
+        int mesh = -1;
+        // instance of an instanced mesh (Mesh::instances), -1 for meshes baked into model space
+        int instance = -1;
+        // triangle of the mesh's full index list (first index / 3)
+        unsigned int triangle = 0;
+        float t = FLT_MAX;
+        glm::vec3 position = glm::vec3(0.0f);
+        // unit geometric normal (triangle winding)
+        glm::vec3 normal = glm::vec3(0.0f);
+
+        bool valid() const { return mesh >= 0; }
+    };
+
+    // per-mesh triangle trees for raycast() (TRIANGLE_PICKING=1 builds them at load, or buildTriangleBvhs())
+    bool hasTriangleBvhs() const { return !triangleTrees.empty(); }
+
+    // nearest triangle along `ray`: the mesh tree picks the candidate meshes nearest first, their triangle
+    // trees (per instance, in the mesh's own space) give the exact hit. False without a hit or without the
+    // triangle trees.
+    bool raycast(const Ray &ray, RayHit &hit) const
+    {
+        hit = RayHit();
+        if (!hasTriangleBvhs())
+            return false;
+        TriangleBVH::Hit nearest;
+        nearest.t = ray.tMax;
+        float tBoxes;
+        meshTree.raycast(ray.origin, ray.direction, tBoxes, [&](unsigned int i, float) {
+            int instance = -1;
+            if (meshHiddenAt(i) || !raycastMesh(i, ray.origin, ray.direction, nearest, instance))
+                return -1.0f;
+            hit.mesh = (int)i;
+            hit.instance = instance;
+            return nearest.t;
+        });
+        if (!hit.valid())
+            return false;
+        completeHit(ray, nearest, hit);
+        return true;
+    }
+
+    // raycast() for `count` rays, TriangleBVH::WIDTH at a time as packets through every mesh's tree, so
+    // coherent rays (a grid over part of the view, samples around a point) share their traversal. Returns
+    // the number of rays that hit.
+    size_t raycast(const Ray *rays, size_t count, RayHit *hits) const
+    {
+        const unsigned int WIDTH = TriangleBVH::WIDTH;
+        size_t hitCount = 0;
+        for (size_t first = 0; first < count; first += WIDTH) {
+            const unsigned int lanes = (unsigned int)std::min<size_t>(WIDTH, count - first);
+            TriangleBVH::Hit nearest[WIDTH];
+            for (unsigned int l = 0; l < lanes; ++l) {
+                hits[first + l] = RayHit();
+                nearest[l].t = rays[first + l].tMax;
+            }
+            for (size_t i = 0; i < triangleTrees.size(); ++i) {
+                if (triangleTrees[i].empty() || meshHiddenAt(i))
+                    continue;
+                const Mesh &m = meshes[i];
+                const size_t instanceCount = m.instances.empty() ? 1 : m.instances.size();
+                for (size_t k = 0; k < instanceCount; ++k) {
+                    const glm::mat4 toMesh = m.instances.empty() ? glm::mat4(1.0f) : glm::inverse(m.instances[k]);
+                    TriangleBVH::RayPacket packet;
+                    for (unsigned int l = 0; l < lanes; ++l)
+                        packet.set(l, glm::vec3(toMesh * glm::vec4(rays[first + l].origin, 1.0f)), glm::vec3(toMesh * glm::vec4(rays[first + l].direction, 0.0f)));
+                    const unsigned int updated = triangleTrees[i].raycast(packet, nearest);
+                    for (unsigned int l = 0; l < lanes; ++l)
+                        if (updated & (1u << l)) {
+                            hits[first + l].mesh = (int)i;
+                            hits[first + l].instance = m.instances.empty() ? -1 : (int)k;
+                        }
+                }
+            }
+            for (unsigned int l = 0; l < lanes; ++l)
+                if (hits[first + l].valid()) {
+                    completeHit(rays[first + l], nearest[l], hits[first + l]);
+                    ++hitCount;
+                }
+        }
+        return hitCount;
+    }
+
+    // the triangle trees of the shown meshes, for traversals outside the model (GpuSceneBvh): visit(meshIndex,
+    // tree, modelFromMesh) once per mesh, or per instance of an instanced one
+    template <class Visit>
+    void visitTriangleBvhs(Visit visit) const
+    {
+        for (size_t i = 0; i < triangleTrees.size(); ++i) {
+            const Mesh &m = meshes[i];
+            if (triangleTrees[i].empty() || meshHiddenAt(i))
+                continue;
+            if (m.instances.empty())
+                visit(i, triangleTrees[i], glm::mat4(1.0f));
+            for (size_t k = 0; k < m.instances.size(); ++k)
+                visit(i, triangleTrees[i], m.instances[k]);
+        }
+    }
+
+    // the material mesh `i` draws with: its material table entry (the selected variant's), else its own
+    // factors. The texture layers are only meaningful with the model's texture arrays bound.
+    MaterialData meshMaterial(size_t i) const
+    {
+        if (i < meshTableEntries.size() && meshTableEntries[i] < materials.size())
+            return materials.entry(meshTableEntries[i]);
+        MaterialData d = materialFactors(meshes[i]);
+        d.layers.w |= (int)meshes[i].materialTag << MaterialOverrides::TAG_SHIFT;
+        return d;
+    }
+
+    // builds the triangle trees of raycast() from the CPU geometry, one mesh per job, largest first (import
+    // keeps the geometry until uploadToGpu(), keepCpuData for good); meshes without it get an empty tree
+    void buildTriangleBvhs()
+    {
+        FrameTrace::Scope trace("triangle BVHs");
+        StartupTimings::Scope startup("raycast BVH");
+        triangleTrees.assign(meshes.size(), TriangleBVH());
+        const vector<unsigned int> order = meshesBySize([this](size_t i) { return meshes[i].indices.size(); });
+        const bool shadingNormals = TriangleBVH::tracedOnGpu();
+        ThreadPool::shared().parallelFor(order.size(), 1, [this, &order, shadingNormals](size_t begin, size_t end) {
+            vector<uint32_t> normals;
+            for (size_t k = begin; k < end; ++k) {
+                const Mesh &m = meshes[order[k]];
+                if (!m.hasCpuGeometry() || m.indices.empty())
+                    continue;
+                normals.clear();
+                if (shadingNormals && m.vertices.normals.size() == m.vertices.size())
+                    for (const glm::vec3 &n : m.vertices.normals)
+                        normals.push_back(VertexPacking::packNormal(VertexPacking::usable(n) ? glm::normalize(n) : glm::vec3(0.0f, 0.0f, 1.0f)));
+                triangleTrees[order[k]].build(&m.vertices.positions[0], m.vertices.size(), &m.indices[0], m.indices.size(),
+                                              normals.empty() ? NULL : &normals[0]);
+            }
+        }, "triangle BVH");
+        logTriangleBvhs();
+    }
+
+    // geometry is on the GPU (textures may still be placeholders)
+    bool ready() const { return geometry.vao != 0; }
+
+    // what's on the GPU is the cooked file's low-detail proxy (loadCooked), not the model itself
+    bool isProxy() const { return proxyLoaded; }
+
+    // whether the cooked file at `path` carries a proxy, without loading anything
+    static bool cookedProxyIn(string const &path)
+    {
+        FileView file;
+        if (!fileSystem().open(path, file) || file.size() < sizeof(CookedFormat::Header))
+            return false;
+        const CookedFormat::Header &header = *(const CookedFormat::Header *)file.data();
+        return std::memcmp(header.magic, CookedFormat::MAGIC, 4) == 0 && header.version == CookedFormat::VERSION && header.proxySize != 0;
+    }
+
+    // GL thread: bytes of GPU memory the model holds (geometry range, draw and instance buffers, textures).
+    // Textures shared with other models through the TextureCache count for each of them.
+    size_t gpuBytes() const
+    {
+        size_t bytes = geometry.vertices.count * sizeof(PackedVertex) + geometry.indices.count * geometry.indexSize;
+        const GLuint buffers[] = {geometry.indirectBuffer, geometry.visibleIndirectBuffer, geometry.instanceVbo, geometry.placementVbo,
+                                  geometry.placementCommands, geometry.skinVbo, materialVbo, pickMeshVbo};
+        for (size_t i = 0; i < sizeof(buffers) / sizeof(buffers[0]); ++i)
+            bytes += gpuMemory().bufferSize(buffers[i]);
+        for (size_t i = 0; i < cookedTextures.size(); ++i)
+            bytes += gpuMemory().textureSize(cookedTextures[i]);
+        for (size_t i = 0; i < textureArrays.size(); ++i)
+            bytes += gpuMemory().textureSize(textureArrays[i]);
+        for (unsigned int t = 0; t < textureLoader.textureCount(); ++t)
+            bytes += gpuMemory().textureSize(textureLoader.textureId(t));
+        return bytes;
+    }
+
+    // bytes of CPU memory the model holds beyond the Model itself: meshes, raycast BVHs and the CPU
+    // geometry of keepCpu models
+    size_t cpuBytes() const
+    {
+        size_t bytes = meshes.capacity() * sizeof(Mesh);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            bytes += m.vertices.size() * (2 * sizeof(glm::vec3) + sizeof(glm::vec2) + sizeof(glm::vec4)) + m.indices.capacity() * sizeof(unsigned int);
+            bytes += m.meshlets.capacity() * sizeof(Mesh::Meshlet) + m.instances.capacity() * sizeof(glm::mat4) + m.lods.capacity() * sizeof(Mesh::Lod);
+        }
+        for (size_t i = 0; i < triangleTrees.size(); ++i)
+            bytes += triangleTrees[i].memoryBytes();
+        return bytes;
+    }
+
+    // submits the variants of `shader` this model's meshes draw with, so they compile before the first draw
+    void prepareVariants(Shader &shader) const
+    {
+        if (!shaderVariants())
+            return;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            shader.prepareVariant(meshes[i].shaderFeatures());
+    }
+
+    // scene nodes of the source file, parents first. Meshes only follow their nodes when they were
+    // loaded with their transforms kept (NODE_TRANSFORMS=1, or instanced meshes); baked meshes are fixed.
+    const TransformHierarchy &nodeHierarchy() const { return nodes; }
+    int findNode(const string &name) const { return nodes.find(name); }
+
+    // moves a node relative to its parent (e.g. a door on its hinge); applied by updateNodeTransforms().
+    // Not between animate() and updateNodeTransforms(), while the animation job owns the hierarchy.
+    void setNodeTransform(int node, const glm::mat4 &local) { nodes.setLocal(node, local); }
+
+    // ANIMATION=1 (glTF models with animations): starts evaluating the clips at `seconds` on the job
+    // system; updateNodeTransforms() picks the result up. Call early in the frame so the job overlaps
+    // the GL thread's other work.
+    void animate(double seconds)
+    {
+        if (ready())
+            animation.start(nodes, seconds);
+    }
+    bool animated() const { return !animation.empty(); }
+
+    // the model matrix this model was drawn with in the previous frame's main view; the following draws'
+    // motion vectors (Object::previousModel) start from it. Until it is set they only carry camera motion.
+    void setPreviousModelMatrix(const glm::mat4 &previous)
+    {
+        previousModelMatrix = previous;
+        hasPreviousModel = true;
+    }
+
+    // GL thread, once per frame before culling: refreshes the world matrices below moved nodes in one pass
+    // and rewrites only the instance matrices (and bounds) of the meshes they carry. Returns true if the
+    // model's bounds changed.
+    bool updateNodeTransforms()
+    {
+        if (!ready())
+            return false;
+        // an animation job has run the hierarchy's update() already
+        const size_t changedNodes = animation.running() ? animation.finish() : nodes.update();
+        if (changedNodes == 0)
+            return false;
+        bool moved = refreshSkinnedBounds();
+        glBindBuffer(GL_ARRAY_BUFFER, geometry.instanceVbo);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &m = meshes[i];
+            bool changed = false;
+            for (size_t k = 0; k < m.instanceNodes.size(); ++k) {
+                if (!nodes.changedSinceUpdate(m.instanceNodes[k]))
+                    continue;
+                m.instances[k] = nodes.world(m.instanceNodes[k]);
+                changed = true;
+            }
+            if (!changed)
+                continue;
+            FrameVector<Mesh::InstanceTransform> transforms;
+            transforms.reserve(m.instances.size());
+            for (size_t k = 0; k < m.instances.size(); ++k)
+                transforms.push_back(Mesh::instanceTransform(m.instances[k]));
+            glBufferSubData(GL_ARRAY_BUFFER, m.firstInstance * sizeof(Mesh::InstanceTransform), transforms.size() * sizeof(Mesh::InstanceTransform), &transforms[0]);
+            refreshInstanceBounds(m);
+            moved = true;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (!moved)
+            return false;
+        BoundsBatch meshBounds;
+        boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            meshBounds.add(meshes[i].boundsMin, meshes[i].boundsMax, meshes[i].boundingRadius);
+            boundsMin = glm::min(boundsMin, meshes[i].boundsMin);
+            boundsMax = glm::max(boundsMax, meshes[i].boundsMax);
+        }
+        meshTree.refit(meshBounds);
+        return true;
+    }
+
+    // loader state after importFromFile(), for offline tools: Texture::id of each mesh is a ticket here
+    const TextureLoader &pendingTextures() const { return textureLoader; }
+
+    // the model owns its GL buffers, so it can't be copied
+    Model(const Model &) = delete;
+    Model &operator=(const Model &) = delete;
+
+    ~Model()
+    {
+        releaseGpu();
+        for (size_t i = 0; i < embeddedImages.size(); ++i)
+            fileSystem().unmount(embeddedImages[i]);
+    }
+
+    // deletes the shared geometry buffers and drops the model's texture references; call before the GL context goes away (glfwTerminate)
+    // when the model outlives it. Safe to call more than once.
+    void releaseGpu()
+    {
+        const GLuint tracked[] = {geometry.indirectBuffer, geometry.visibleIndirectBuffer, geometry.instanceVbo, geometry.placementVbo,
+                                  geometry.placementCommands, geometry.skinVbo, materialVbo, pickMeshVbo};
+        for (size_t i = 0; i < sizeof(tracked) / sizeof(tracked[0]); ++i)
+            gpuMemory().releaseBuffer(tracked[i]);
+        for (size_t i = 0; i < streamedTextures.size(); ++i)
+            textureStreamer().remove(streamedTextures[i]);
+        streamedTextures.clear();
+        streamedUses.clear();
+        for (size_t i = 0; i < cookedTextures.size(); ++i)
+            gpuMemory().releaseTexture(cookedTextures[i]);
+        for (size_t i = 0; i < textureArrays.size(); ++i)
+            gpuMemory().releaseTexture(textureArrays[i]);
+        if (geometry.indirectBuffer) glDeleteBuffers(1, &geometry.indirectBuffer);
+        if (geometry.visibleIndirectBuffer) glDeleteBuffers(1, &geometry.visibleIndirectBuffer);
+        if (geometry.instanceVbo) glDeleteBuffers(1, &geometry.instanceVbo);
+        if (geometry.placementVbo) glDeleteBuffers(1, &geometry.placementVbo);
+        if (geometry.placementCommands) glDeleteBuffers(1, &geometry.placementCommands);
+        geometry.instanceVbo = geometry.placementVbo = geometry.placementCommands = 0;
+        occlusion.release();
+        meshletTarget.release();
+        sceneTarget.release();
+        visibilityTarget.release();
+        geometry.visibleIndirectBuffer = 0;
+        geometryArena().free(geometry.indices);
+        geometryArena().free(geometry.vertices);
+        if (geometry.skinVbo) glDeleteBuffers(1, &geometry.skinVbo);
+        geometry.skinVbo = 0;
+        if (geometry.vao) glDeleteVertexArrays(1, &geometry.vao);
+        if (geometry.depthVao) glDeleteVertexArrays(1, &geometry.depthVao);
+        geometry.indirectBuffer = geometry.ebo = geometry.vbo = geometry.vao = geometry.depthVao = 0;
+        if (materialVbo) glDeleteBuffers(1, &materialVbo);
+        materialVbo = 0;
+        if (pickMeshVbo) glDeleteBuffers(1, &pickMeshVbo);
+        pickMeshVbo = 0;
+        pickUnsupported = false;
+        materials.release();
+        variantEntries.clear();
+        meshTableEntries.clear();
+        textureLoader.release();
+        if (!cookedTextures.empty())
+            glDeleteTextures((GLsizei)cookedTextures.size(), &cookedTextures[0]);
+        cookedTextures.clear();
+        if (!textureArrays.empty())
+            glDeleteTextures((GLsizei)textureArrays.size(), &textureArrays[0]);
+        textureArrays.clear();
+        proxyLoaded = false;
+        glState().invalidate();
+    }
+
+    // draws the model: opaque first, then transparent (simple two-pass for correct blending)
+    // Accepts the current model matrix (world transform) and the camera position for sorting transparent meshes.
+    // All meshes share one VAO; opaque meshes are grouped into material buckets and each bucket is a
+    // single multi-draw (indirect when GL 4.3 is available). Factors and UV transforms come from the
+    // model's material table, so a bucket only binds its textures (or texture arrays). Each bucket is drawn
+    // with the shader variant specialised for its material features (SHADER_VARIANTS=0 keeps the runtime
+    // branches of the base shader); per-frame uniforms set on `shader` carry over to the variants.
+    // With `viewProjection` (projection * view of the pass) meshes whose bounds lie outside the frustum are
+    // skipped; FRUSTUM_CULLING=0 draws everything. With a ready `meshletCuller` as well, the opaque meshes
+    // are culled per cluster on the GPU (see MeshletCuller). With `transparentQueue` the transparent meshes
+    // are only queued (as `queueSource`), for the caller to draw scene-wide with drawQueuedTransparent().
+    void Draw(Shader &shader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos, const glm::mat4 *viewProjection = nullptr,
+              MeshletCuller *meshletCuller = nullptr, TransparentQueue *transparentQueue = nullptr, unsigned int queueSource = 0)
+    {
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        const bool cull = viewProjection && frustumCulling();
+        if (cull)
+        {
+            meshTree.cull(Frustum(*viewProjection * modelMatrix), meshVisible);
+            countCulled();
+        }
+        if (viewProjection && meshletCuller && meshletCuller->ready() && geometry.indirectBuffer) {
+            drawMeshlets(shader, *meshletCuller, *viewProjection * modelMatrix, glm::vec3(glm::inverse(modelMatrix) * glm::vec4(cameraPos, 1.0f)));
+            drawInstancedMeshes(shader, cull, 1);
+            drawTransparent(shader, modelMatrix, cameraPos, cull, 1, transparentQueue, queueSource);
+            shader.use();
+            return;
+        }
+        // only the visible opaque draws when anything was culled, else the static lists
+        drawOpaque(shader, cull && compactVisibleDraws() ? visibleDrawList() : staticDrawList());
+        drawInstancedMeshes(shader, cull, 1);
+        drawTransparent(shader, modelMatrix, cameraPos, cull, 1, transparentQueue, queueSource);
+        // callers keep setting uniforms on `shader` after Draw
+        shader.use();
+    }
+
+    // draws the model once per entry of `placements` (world matrices) with hardware instancing: every
+    // opaque bucket is still one multi-draw and every instanced mesh one draw, whatever the placement count.
+    // No per-mesh culling (callers cull the placements); transparent meshes sort by the first placement.
+    // The model matrix is the identity, the placements take its place. `variations` (one per placement, see
+    // Mesh::instanceVariation) give each copy its own paint and dirt within the same draws.
+    void DrawInstances(Shader &shader, const std::vector<glm::mat4> &placements, const glm::vec3 &cameraPos,
+                       const std::vector<glm::uvec3> *variations = nullptr)
+    {
+        if (placements.empty() || !beginDraw(shader, glm::mat4(1.0f)))
+            return;
+        const GLsizei count = (GLsizei)placements.size();
+        // matrices: the placements (instances of every non-instanced mesh), then placement x own transform
+        // for each instanced mesh
+        static std::vector<Mesh::InstanceTransform> matrices;
+        matrices.clear();
+        const glm::uvec3 authored(0);
+        for (size_t p = 0; p < placements.size(); ++p)
+            matrices.push_back(Mesh::instanceTransform(placements[p], variations ? (*variations)[p] : authored));
+        placementBase.assign(meshes.size(), 0);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            if (m.instances.empty())
+                continue;
+            placementBase[i] = (unsigned int)matrices.size();
+            for (size_t p = 0; p < placements.size(); ++p)
+                for (size_t k = 0; k < m.instances.size(); ++k)
+                    matrices.push_back(Mesh::instanceTransform(placements[p] * m.instances[k], variations ? (*variations)[p] : authored));
+        }
+        if (!geometry.placementVbo)
+            geometry.placementVbo = glBackend().createBuffer();
+        glBackend().bufferData(geometry.placementVbo, GL_ARRAY_BUFFER, matrices.size() * sizeof(Mesh::InstanceTransform), &matrices[0], GL_STREAM_DRAW);
+        gpuMemory().trackBuffer(geometry.placementVbo, GpuMemory::DRAW_BUFFERS, matrices.size() * sizeof(Mesh::InstanceTransform), directory);
+        glState().bindVertexArray(geometry.vao);
+        Mesh::bindInstanceBuffer(geometry.vao, geometry.placementVbo, 0);
+        DrawList list = staticDrawList();
+        list.instances = count;
+        if (geometry.indirectBuffer) {
+            placementCommands = drawCommands;
+            for (size_t k = 0; k < placementCommands.size(); ++k)
+                placementCommands[k].instanceCount = (GLuint)count;
+            if (!geometry.placementCommands)
+                glGenBuffers(1, &geometry.placementCommands);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometry.placementCommands);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, placementCommands.size() * sizeof(DrawElementsIndirectCommand), &placementCommands[0], GL_STREAM_DRAW);
+            gpuMemory().trackBuffer(geometry.placementCommands, GpuMemory::DRAW_BUFFERS, placementCommands.size() * sizeof(DrawElementsIndirectCommand), directory);
+            list.indirectBuffer = geometry.placementCommands;
+        }
+        if (!opaqueOrder.empty())
+            drawOpaque(shader, list);
+        drawInstancedMeshes(shader, false, count);
+        drawTransparent(shader, placements[0], cameraPos, false, count);
+        Mesh::bindInstanceBuffer(geometry.vao, geometry.instanceVbo, 0);
+        shader.use();
+    }
+
+    // draws entries [begin, end) of a sorted scene-wide queue, all queued by this model's Draw() or
+    // drawOcclusionPass() this frame with `modelMatrix` (also set as the shader's model matrix by the caller)
+    void drawQueuedTransparent(Shader &shader, const glm::mat4 &modelMatrix, const TransparentQueue &queue, size_t begin, size_t end)
+    {
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        drawTransparentRange(shader, queue, begin, end, 1);
+        shader.use();
+    }
+
+    // GPU_DRIVEN=1 opaque pass of every placement of the model at once (see SceneCuller): `placements` are
+    // their world matrices, uploaded again only when `revision` changes; the GPU culls each draw of each
+    // placement against `viewProjection` and every bucket is one multi-draw. The placements are the instance
+    // transforms and the model matrix is the identity, so the caller sets an identity previous model matrix
+    // (motion vectors carry the camera's motion). The instanced and transparent meshes go through
+    // drawUnbatched(), per placement.
+    void drawGpuDriven(Shader &shader, SceneCuller &culler, const std::vector<glm::mat4> &placements, unsigned int revision,
+                       const glm::mat4 &viewProjection)
+    {
+        if (placements.empty() || !geometry.indirectBuffer || !beginDraw(shader, glm::mat4(1.0f)) || opaqueOrder.empty())
+            return;
+        if (!sceneTarget.ready())
+            prepareSceneDraws(culler);
+        culler.place(sceneTarget, placements, revision, directory);
+        if (sceneOrder.size() != opaqueOrder.size() * placements.size())
+            buildSceneRegions((unsigned int)placements.size());
+        culler.cull(sceneTarget, geometry.indirectBuffer, viewProjection);
+        // the cull ran its own program
+        shader.use();
+        glState().bindVertexArray(geometry.vao);
+        Mesh::bindInstanceBuffer(geometry.vao, sceneTarget.placementBuffer, 0);
+        DrawList list = {&sceneOrder, &sceneBuckets, 0, 0, 0, sceneTarget.commandBuffer,
+                         SceneCuller::drawCountSupported() ? sceneTarget.countBuffer : 0, 1};
+        drawOpaque(shader, list);
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+        Mesh::bindInstanceBuffer(geometry.vao, geometry.instanceVbo, 0);
+        shader.use();
+    }
+
+    // GPU_DRIVEN=1 companion of drawGpuDriven() for one placement: the instanced meshes and the transparent
+    // ones (queued with `transparentQueue` as in Draw), culled on the CPU like Draw does
+    void drawUnbatched(Shader &shader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos, const glm::mat4 &viewProjection,
+                       TransparentQueue *transparentQueue = nullptr, unsigned int queueSource = 0)
+    {
+        if (!ready())
+            return;
+        if (opaqueOrder.size() + transparentMeshes.size() + weightedOrder.size() + instancedMeshes.size() != meshes.size())
+            buildDrawList();
+        if (instancedMeshes.empty() && transparentMeshes.empty() && (transparentQueue || weightedOrder.empty()))
+            return;
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        const bool cull = frustumCulling();
+        if (cull)
+            meshTree.cull(Frustum(viewProjection * modelMatrix), meshVisible);
+        drawInstancedMeshes(shader, cull, 1);
+        drawTransparent(shader, modelMatrix, cameraPos, cull, 1, transparentQueue, queueSource);
+        shader.use();
+    }
+
+    // OIT=1: weighted blended order-independent transparency for the meshes that allow it
+    static bool weightedBlendEnabled()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("OIT");
+            return env && std::string(env) == "1";
+        }();
+        return enabled;
+    }
+
+    // OIT=1: the weighted blended transparent meshes (Mesh::weightedBlend), which Draw() and
+    // drawOcclusionPass() leave out when they queue. Batched like the opaque buckets, unsorted; the caller
+    // sets the blending (WeightedOIT::begin).
+    void drawWeightedTransparent(Shader &shader, const glm::mat4 &modelMatrix)
+    {
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        drawWeightedList(shader, 1);
+        shader.use();
+    }
+
+    // whether any mesh is KHR_materials_transmission glass, which needs the frame's RefractionCopy
+    bool hasTransmission() const
+    {
+        for (size_t i = 0; i < meshes.size(); ++i)
+            if (meshes[i].transmissionFactor > 0.0f)
+                return true;
+        return false;
+    }
+
+    // KHR_materials_variants names of the file (paint and trim options), and the one drawn (-1 = none: the
+    // default materials)
+    const vector<string> &materialVariants() const { return materialVariantNames; }
+    int materialVariant() const { return activeMaterialVariant; }
+
+    // GL thread: draws every mesh with the material `variant` maps it to (-1 = the default materials). All
+    // variant materials are in the material table from the start, so this only rewrites the per-vertex
+    // material indices of the meshes whose entry changes: no texture or geometry upload, no new shader
+    // variant. Textures, alpha mode and shader features stay those of each mesh's own material. False if
+    // there's no such variant or the model draws without the table.
+    bool selectMaterialVariant(int variant)
+    {
+        if (variant < -1 || variant >= (int)materialVariantNames.size() || variantEntries.empty() || !materials.ready())
+            return false;
+        const size_t stride = materialVariantNames.size() + 1;
+        vector<uint16_t> fill;
+        glBindBuffer(GL_ARRAY_BUFFER, materialVbo);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const uint16_t entry = variantEntries[i * stride + (size_t)(variant + 1)];
+            if (entry == meshTableEntries[i] || meshes[i].vertexCount == 0)
+                continue;
+            fill.assign(meshes[i].vertexCount, entry);
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)((size_t)std::max(meshes[i].baseVertex, 0) * sizeof(uint16_t)),
+                            (GLsizeiptr)(fill.size() * sizeof(uint16_t)), &fill[0]);
+            meshTableEntries[i] = entry;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        activeMaterialVariant = variant;
+        return true;
+    }
+
+    // configurable parts (CONFIG_PARTS: wheel styles, light bars, spoilers): the names of the hierarchy nodes
+    // whose meshes show and hide as one, in order of first mesh
+    vector<string> parts() const
+    {
+        vector<string> out;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            if (meshes[i].partNode >= 0 && std::find(out.begin(), out.end(), nodes.name(meshes[i].partNode)) == out.end())
+                out.push_back(nodes.name(meshes[i].partNode));
+        return out;
+    }
+
+    // whether any mesh of part `part` is shown
+    bool partVisible(const string &part) const
+    {
+        for (size_t i = 0; i < meshes.size(); ++i)
+            if (meshes[i].partNode >= 0 && nodes.name(meshes[i].partNode) == part && !meshHiddenAt(i))
+                return true;
+        return false;
+    }
+
+    // GL thread: shows or hides the meshes of part `part` (a parts() name) in every pass and placement. A
+    // hidden opaque mesh keeps its draw slot with a zero index count - in the multi-draw arrays, the model's
+    // indirect commands (which the GPU_DRIVEN cull pass reads and skips), the Hi-Z command lists and the
+    // meshlet slots - so a toggle rewrites one 20-byte command per mesh and no draw list, bucket or tree is
+    // rebuilt; the instanced and transparent loops and picking skip hidden meshes. Returns how many meshes
+    // changed.
+    size_t setPartVisible(const string &part, bool visible)
+    {
+        size_t changed = 0;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            if (meshes[i].partNode >= 0 && nodes.name(meshes[i].partNode) == part && setMeshHidden(i, !visible))
+                ++changed;
+        return changed;
+    }
+
+    // DECALS: the premultiplied decals over this model's paint, laid out in the paint's UVs (DecalCompositor
+    // owns the texture; 0 = none). Every draw binds it, so each pass and placement shows them for one lookup.
+    void setDecalTexture(GLuint texture) { decalTexture = texture; }
+
+    // GL thread: the meshes tagged `tag` (MaterialOverrides) with `shader`, already in use, in model space at
+    // full detail and without culling, for passes that rasterize them in their own UV layout rather than on
+    // screen (DecalCompositor). Hidden parts are drawn too.
+    void drawTagged(Shader &shader, unsigned int tag)
+    {
+        if (!ready())
+            return;
+        bindObjectData(glm::mat4(1.0f));
+        glState().bindVertexArray(geometry.vao);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &m = meshes[i];
+            if (m.materialTag != tag)
+                continue;
+            const GLsizei count = (GLsizei)std::max<size_t>(1, m.instances.size());
+            if (m.firstInstance == 0 || GLAD_GL_VERSION_4_2) {
+                m.drawGeometry(shader, 0, count, m.firstInstance);
+                continue;
+            }
+            Mesh::bindInstanceBuffer(geometry.vao, geometry.instanceVbo, m.firstInstance);
+            glState().bindVertexArray(geometry.vao);
+            m.drawGeometry(shader, 0, count, 0);
+            Mesh::bindInstanceBuffer(geometry.vao, geometry.instanceVbo, 0);
+        }
+    }
+
+    // DEPTH_PREPASS=1: lays down the depth of the opaque buckets (alpha tested and skinned ones excluded) with
+    // `depthShader` (depth_prepass.vs/.fs; the caller sets view and projection), bucket by
+    // bucket front to back, reading only the positions. The colour pass that follows with GL_LEQUAL then
+    // runs the PBR shader once per pixel. Meshes are culled against `viewProjection` like in Draw().
+    void drawDepthPrepass(Shader &depthShader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos, const glm::mat4 &viewProjection)
+    {
+        if (!ready())
+            return;
+        if (opaqueOrder.size() + transparentMeshes.size() + weightedOrder.size() + instancedMeshes.size() != meshes.size())
+            buildDrawList();
+        depthShader.use();
+        bindObjectData(modelMatrix);
+        const bool cull = frustumCulling();
+        if (cull)
+            meshTree.cull(Frustum(viewProjection * modelMatrix), meshVisible);
+        const DrawList list = cull && compactVisibleDraws() ? visibleDrawList() : staticDrawList();
+        // nearest mesh box of each bucket, in model space
+        const glm::vec3 eye = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(cameraPos, 1.0f));
+        depthBucketOrder.clear();
+        for (unsigned int b = 0; b < list.buckets->size(); ++b) {
+            const DrawBucket &bucket = (*list.buckets)[b];
+            if (bucket.features & (Shader::ALPHA_MASK | Shader::SKINNED))
+                continue;
+            float nearest = std::numeric_limits<float>::max();
+            for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k) {
+                const Mesh &m = meshes[(*list.order)[k]];
+                const glm::vec3 d = glm::max(glm::max(m.boundsMin - eye, eye - m.boundsMax), glm::vec3(0.0f));
+                nearest = std::min(nearest, glm::dot(d, d));
+            }
+            depthBucketOrder.push_back(std::make_pair(nearest, b));
+        }
+        std::sort(depthBucketOrder.begin(), depthBucketOrder.end());
+        if (!geometry.depthVao)
+            createDepthVao();
+        glState().bindVertexArray(geometry.depthVao);
+        if (list.indirectBuffer)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list.indirectBuffer);
+        const GLenum indexType = geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        for (size_t o = 0; o < depthBucketOrder.size(); ++o) {
+            const DrawBucket &bucket = (*list.buckets)[depthBucketOrder[o].second];
+            if (list.indirectBuffer)
+                glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (const void *)(bucket.first * sizeof(DrawElementsIndirectCommand)), (GLsizei)bucket.count, 0);
+            else
+                glMultiDrawElementsBaseVertex(GL_TRIANGLES, &(*list.counts)[bucket.first], indexType, &(*list.offsets)[bucket.first], (GLsizei)bucket.count, &(*list.baseVertices)[bucket.first]);
+            drawStats().count(bucket.count);
+            GL_STATS_ADD(primitives, bucketPrimitives(list, bucket));
+        }
+        RenderDebug::checkDraw("after depth pre-pass", depthShader.ID);
+        glState().bindVertexArray(geometry.vao);
+    }
+
+    // GPU_PICKING=1, before the model's first opaque draw: the per-vertex mesh indices the pick IDs are
+    // written from (GpuPicker::ATTRIBUTE_MESH of the shared VAO). Models with more meshes than the ID holds
+    // draw without them and pick as mesh 0.
+    void preparePicking()
+    {
+        if (pickMeshVbo || pickUnsupported || !geometry.vao)
+            return;
+        pickUnsupported = true;
+        if (meshes.size() > GpuPicker::MESH_MASK + 1) {
+            LOG_INFO("[Pick] '" << directory << "' has " << meshes.size() << " meshes, more than the pick ID holds");
+            return;
+        }
+        const std::vector<uint16_t> vertexMeshes = vertexMeshIndices();
+        if (vertexMeshes.empty())
+            return;
+        glGenBuffers(1, &pickMeshVbo);
+        glState().bindVertexArray(geometry.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, pickMeshVbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(vertexMeshes.size() * sizeof(uint16_t)), &vertexMeshes[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(pickMeshVbo, GpuMemory::MODEL_GEOMETRY, vertexMeshes.size() * sizeof(uint16_t), directory);
+        GpuPicker::setupMeshIdFormat();
+        glState().bindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        pickUnsupported = false;
+    }
+
+    // VISIBILITY_BUFFER=1 replacement for Draw in the main view (see VisibilityBuffer): the opaque buckets
+    // the resolve can shade are rasterized into `target`'s ID target, each under a stencil key of its own;
+    // the rest (alpha tested, transmissive and skinned buckets, buckets past the last key, instanced
+    // meshes) draws forward with `shader` as in Draw, and the transparent meshes are queued. Models the ID
+    // pass can't cover draw entirely forward.
+    void drawVisibility(Shader &shader, VisibilityBuffer &target, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos,
+                        const glm::mat4 &viewProjection, TransparentQueue &transparentQueue, unsigned int queueSource)
+    {
+        if (!target.isActive() || !prepareVisibility(target)) {
+            Draw(shader, modelMatrix, cameraPos, &viewProjection, nullptr, &transparentQueue, queueSource);
+            return;
+        }
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        const bool cull = frustumCulling();
+        if (cull) {
+            meshTree.cull(Frustum(viewProjection * modelMatrix), meshVisible);
+            countCulled();
+        }
+        const DrawList list = cull && compactVisibleDraws() ? visibleDrawList() : staticDrawList();
+        updateVisibilityRanges(target);
+        const glm::mat4 clip = viewProjection * modelMatrix;
+        const glm::mat4 previous = hasPreviousModel ? previousModelMatrix : modelMatrix;
+        forwardBuckets.clear();
+        target.bindIds();
+        target.shader().use();
+        glState().bindVertexArray(visibilityTarget.vao);
+        if (list.indirectBuffer)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list.indirectBuffer);
+        const GLenum indexType = geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        for (size_t b = 0; b < list.buckets->size(); ++b) {
+            const DrawBucket &bucket = (*list.buckets)[b];
+            unsigned int key = 0;
+            if (!(bucket.features & (Shader::ALPHA_MASK | Shader::TRANSMISSION | Shader::SKINNED))) {
+                glm::vec3 bmin(std::numeric_limits<float>::max()), bmax(-std::numeric_limits<float>::max());
+                for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k) {
+                    bmin = glm::min(bmin, meshes[(*list.order)[k]].boundsMin);
+                    bmax = glm::max(bmax, meshes[(*list.order)[k]].boundsMax);
+                }
+                key = target.addKey(this, (*list.order)[bucket.first], bucket.features, modelMatrix, previous, clip, bmin, bmax);
+            }
+            if (!key) {
+                forwardBuckets.push_back(bucket);
+                continue;
+            }
+            if (list.indirectBuffer)
+                glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (const void *)(bucket.first * sizeof(DrawElementsIndirectCommand)), (GLsizei)bucket.count, 0);
+            else
+                glMultiDrawElementsBaseVertex(GL_TRIANGLES, &(*list.counts)[bucket.first], indexType, &(*list.offsets)[bucket.first], (GLsizei)bucket.count, &(*list.baseVertices)[bucket.first]);
+            drawStats().count(bucket.count);
+            GL_STATS_ADD(primitives, bucketPrimitives(list, bucket));
+        }
+        RenderDebug::checkDraw("after visibility pass", target.shader().ID);
+        target.bindScene();
+        glState().bindVertexArray(geometry.vao);
+        DrawList forward = list;
+        forward.buckets = &forwardBuckets;
+        drawOpaque(shader, forward);
+        drawInstancedMeshes(shader, cull, 1);
+        drawTransparent(shader, modelMatrix, cameraPos, cull, 1, &transparentQueue, queueSource);
+        shader.use();
+    }
+
+    // VISIBILITY_BUFFER=1, between VisibilityBuffer::beginResolve() and endResolve(): shades the pixels of
+    // this model's keys with `shader` (model_loading.fs compiled with VISIBILITY_RESOLVE, over the
+    // fullscreen triangle of oit_resolve.vs), in the variant and with the textures of each key's bucket
+    void resolveVisibility(Shader &shader, VisibilityBuffer &target)
+    {
+        if (!visibilityTarget.ready())
+            return;
+        const std::vector<VisibilityBuffer::Key> &keys = target.frameKeys();
+        bool bound = false;
+        for (size_t k = 0; k < keys.size(); ++k) {
+            const VisibilityBuffer::Key &key = keys[k];
+            if (key.owner != this)
+                continue;
+            if (!bound) {
+                static const Shader::UniformHandle uUseMaterialTable = Shader::uniformHandle("useMaterialTable");
+                static const Shader::UniformHandle uUseTextureArrays = Shader::uniformHandle("useTextureArrays");
+                static const Shader::UniformHandle uVisibilityVertexBase = Shader::uniformHandle("visibilityVertexBase");
+                shader.use();
+                shader.setBool(uUseMaterialTable, true);
+                shader.setBool(uUseTextureArrays, !textureArrays.empty());
+                shader.setInt(uVisibilityVertexBase, visibilityTarget.vertexBase);
+                materials.bind();
+                target.bindTarget(visibilityTarget);
+                bound = true;
+            }
+            if (shaderVariants())
+                shader.useVariant(key.features);
+            bindTableTextures(meshes[key.mesh]);
+            setPreviousModelMatrix(key.previousModel);
+            bindObjectData(key.model);
+            target.resolveKey(k);
+        }
+        if (bound)
+            shader.use();
+    }
+
+    enum OcclusionPass { OCCLUSION_FIRST_PASS, OCCLUSION_SECOND_PASS };
+
+    // OCCLUSION_CULLING=1 replacement for Draw (see OcclusionCuller for the frame structure). The first pass
+    // draws the opaque meshes visible last frame; the second, after cullOcclusion(), the ones that became
+    // visible plus the transparent meshes (queued instead with `transparentQueue`, see Draw). Frustum
+    // culling is part of the occlusion test.
+    void drawOcclusionPass(Shader &shader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos, const glm::mat4 &viewProjection,
+                           OcclusionCuller &culler, OcclusionPass pass, TransparentQueue *transparentQueue = nullptr, unsigned int queueSource = 0)
+    {
+        if (!beginDraw(shader, modelMatrix))
+            return;
+        if (!occlusion.ready() || occlusion.hiZ != culler.hiZ())
+            prepareOcclusion(culler);
+        const bool gpuCulled = culler.hiZ() && occlusion.ready();
+        // the CPU frustum test feeds the query path's first pass and the instanced and transparent meshes
+        meshTree.cull(Frustum(viewProjection * modelMatrix), meshVisible);
+        if (gpuCulled) {
+            // the GPU wrote the instance counts; the buckets stay as built
+            DrawList list = staticDrawList();
+            list.indirectBuffer = pass == OCCLUSION_FIRST_PASS ? occlusion.firstPassCommands : occlusion.secondPassCommands;
+            drawOpaque(shader, list);
+        } else if (pass == OCCLUSION_FIRST_PASS) {
+            // query results arrive a frame late, so everything visible is drawn in the first pass
+            for (size_t k = 0; k < opaqueOrder.size() && k < occlusion.visible.size(); ++k)
+                meshVisible[opaqueOrder[k]] &= occlusion.visible[k];
+            drawOpaque(shader, compactVisibleDraws() ? visibleDrawList() : staticDrawList());
+        }
+        if (pass == OCCLUSION_FIRST_PASS)
+            countCulled();
+        // instanced meshes aren't occlusion tested; they go with the first pass so they occlude too
+        if (pass == OCCLUSION_FIRST_PASS)
+            drawInstancedMeshes(shader, true, 1);
+        if (pass == OCCLUSION_SECOND_PASS)
+            drawTransparent(shader, modelMatrix, cameraPos, true, 1, transparentQueue, queueSource);
+        shader.use();
+    }
+
+    // between the passes, once culler.buildPyramid() ran: tests this model's opaque draws
+    void cullOcclusion(OcclusionCuller &culler, const glm::mat4 &viewProjection, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos)
+    {
+        if (!ready() || !occlusion.ready())
+            return;
+        const glm::vec3 eye = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(cameraPos, 1.0f));
+        culler.cull(occlusion, viewProjection * modelMatrix, eye);
+    }
+
+    // once per frame, before the passes: picks each mesh's LOD for the main view from its projected error.
+    // A level's error (model units) times the projection scale at the mesh's depth gives its size in pixels;
+    // the coarsest level under LOD_ERROR_PIXELS wins. To keep meshes from flickering between two levels, a
+    // coarser level must be under 3/4 of the threshold before it is taken. The draw arguments of changed
+    // meshes are patched in place, so culling and the occlusion lists keep working on the same slots.
+    // The levels are picked on the job system (large scenes have thousands of meshes), the patching after.
+    void selectLods(const glm::mat4 &viewProjection, const glm::mat4 &modelMatrix, float viewportHeight)
+    {
+        if (!ready() || meshLod.size() != meshes.size())
+            return;
+        const glm::mat4 clip = viewProjection * modelMatrix;
+        // w of a model-space point, and pixels per model unit at w = 1 (vertical projection scale)
+        const glm::vec4 wRow(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+        const float pixelsPerUnit = glm::length(glm::vec3(clip[0][1], clip[1][1], clip[2][1])) * viewportHeight * 0.5f;
+        const float threshold = lodErrorPixels();
+        lodChoice.resize(meshes.size());
+        ThreadPool::shared().parallelFor(meshes.size(), LOD_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const Mesh &m = meshes[i];
+                if (m.lods.size() < 2) {
+                    lodChoice[i] = meshLod[i];
+                    continue;
+                }
+                const glm::vec3 centre = (m.boundsMin + m.boundsMax) * 0.5f;
+                // the nearest point of the bounding sphere, so a mesh close to the camera never coarsens
+                const float w = glm::dot(wRow, glm::vec4(centre, 1.0f)) - m.boundingRadius * glm::length(glm::vec3(wRow));
+                unsigned int lod = 0;
+                if (meshLodsEnabled() && w > 0.0f) {
+                    const float scale = pixelsPerUnit / w;
+                    lod = meshLod[i];
+                    while (lod > 0 && m.lods[lod].error * scale > threshold)
+                        lod--;
+                    while (lod + 1 < m.lods.size() && m.lods[lod + 1].error * scale <= threshold * 0.75f)
+                        lod++;
+                }
+                lodChoice[i] = lod;
+            }
+        }, "select LODs");
+        bool changed = false;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            const unsigned int lod = lodChoice[i];
+            if (lod == meshLod[i])
+                continue;
+            meshLod[i] = lod;
+            if (drawSlot[i] < 0)
+                continue;
+            const unsigned int k = (unsigned int)drawSlot[i];
+            const Mesh::Lod &range = m.lods[lod];
+            const GLuint count = meshHiddenAt(i) ? 0 : range.indexCount;
+            drawCounts[k] = (GLsizei)count;
+            drawOffsets[k] = (const void *)(size_t)(range.firstIndex * geometry.indexSize);
+            drawCommands[k].count = count;
+            drawCommands[k].firstIndex = range.firstIndex;
+            if (occlusion.ready() && occlusion.hiZ)
+                occlusion.setDrawRange(k, range.firstIndex, count);
+            changed = true;
+        }
+        if (changed && geometry.indirectBuffer) {
+            // orphaned: last frame's passes may still read the old commands
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometry.indirectBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, drawCommands.size() * sizeof(DrawElementsIndirectCommand), &drawCommands[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+    }
+
+    // the level selectLods() last picked for mesh `i` (0 = full detail)
+    unsigned int meshLodLevel(size_t i) const { return i < meshLod.size() ? meshLod[i] : 0; }
+    // the hierarchy the draws cull the meshes with (model space, items indexed like `meshes`)
+    const BVH &meshHierarchy() const { return meshTree; }
+
+    // once per frame with selectLods(), for TEXTURE_STREAMING=1 cooked models: tells the TextureStreamer how
+    // finely the main view samples each streamed texture. A mesh covers Mesh::uvDensity * uv scale UV units
+    // per model unit and pixelsPerUnit / w pixels per model unit at the nearest point of its bounds; meshes
+    // culled last frame ask for nothing.
+    void requestTextureLevels(const glm::mat4 &viewProjection, const glm::mat4 &modelMatrix, float viewportHeight) const
+    {
+        if (streamedUses.empty())
+            return;
+        const glm::mat4 clip = viewProjection * modelMatrix;
+        const glm::vec4 wRow(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+        const float pixelsPerUnit = glm::length(glm::vec3(clip[0][1], clip[1][1], clip[2][1])) * viewportHeight * 0.5f;
+        for (size_t k = 0; k < streamedUses.size(); ++k) {
+            const TextureUse &use = streamedUses[k];
+            if (meshVisible.size() == meshes.size() && !meshVisible[use.mesh])
+                continue;
+            const Mesh &m = meshes[use.mesh];
+            const glm::vec3 centre = (m.boundsMin + m.boundsMax) * 0.5f;
+            const float w = glm::dot(wRow, glm::vec4(centre, 1.0f)) - m.boundingRadius * glm::length(glm::vec3(wRow));
+            textureStreamer().request(use.handle, w > 0.0f && pixelsPerUnit > 0.0f ? m.uvDensity * use.uvScale * w / pixelsPerUnit : 0.0f);
+        }
+    }
+    
+private:
+    // queues texture decodes during loadModel; uploaded by uploadToGpu()/streamTextures()
+    TextureLoader textureLoader;
+    // LAZY_REGIONS=1 (MeshRegions): the region of the mesh being built, and per region the tickets of the
+    // textures only its meshes use (deferred), its meshes' bounds and whether requestRegions() loaded them
+    struct RegionTextures
+    {
+        vector<unsigned int> tickets;
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+        bool loaded = false;
+    };
+    bool lazyRegions = false;
+    unsigned int buildRegion = MeshRegions::EXTERIOR;
+    RegionTextures regions[MeshRegions::COUNT];
+    bool regionsArmed = false;
+    bool regionsStreaming = false;
+    bool keepCpu = false;
+    // textures owned by a loadCooked() model (they bypass TextureCache)
+    vector<unsigned int> cookedTextures;
+    // TEXTURE_STREAMING=1: TextureStreamer handles of the cooked textures with levels left to stream (-1
+    // for the others; the streamer keeps the cooked file mapped) and which mesh samples which of them at
+    // what uv scale
+    vector<int> streamedTextures;
+    struct TextureUse
+    {
+        unsigned int mesh;
+        int handle;
+        float uvScale;
+    };
+    vector<TextureUse> streamedUses;
+    // distinct materials of the model and the per-vertex index into them (attribute 3); empty if the
+    // model has more than MaterialTable::MAX_MATERIALS, which then uses per-mesh uniforms
+    MaterialTable materials;
+    GLuint materialVbo = 0;
+    // KHR_materials_variants with the table: each mesh's entry for its own material then every variant
+    // (materialVariantNames.size() + 1 per mesh, empty without variants), and the entry each mesh's
+    // vertices hold now
+    vector<uint16_t> variantEntries;
+    vector<uint16_t> meshTableEntries;
+    int activeMaterialVariant = -1;
+    // GPU_PICKING=1: mesh index per vertex (preparePicking); unsupported once it found too many meshes
+    GLuint pickMeshVbo = 0;
+    bool pickUnsupported = false;
+    // TEXTURE_ARRAYS=1 cooked models: GL_TEXTURE_2D_ARRAYs of same-sized textures the table indexes into,
+    // on these units (Shader::samplerUnit)
+    vector<unsigned int> textureArrays;
+    static const int UNIT_DIFFUSE_ARRAY = 3;
+    static const int UNIT_NORMAL_ARRAY = 4;
+    static const int UNIT_METALLIC_ROUGHNESS_ARRAY = 5;
+    // loadCooked() loaded the file's proxy
+    bool proxyLoaded = false;
+    // setDecalTexture(), on the tone map's exposure unit, which the scene shaders don't otherwise sample
+    GLuint decalTexture = 0;
+    static const int UNIT_PAINT_DECALS = 18;
+
+    // GL formats of a cooked texture
+    static bool rawEncoding(uint32_t encoding)
+    {
+        return encoding == CookedFormat::RAW8 || encoding == CookedFormat::RG8_GB;
+    }
+    static void cookedFormats(const CookedFormat::Texture &ct, GLenum &format, GLenum &internalFormat)
+    {
+        imageFormats((int)ct.components, ct.gamma != 0, format, internalFormat);
+        if (ct.encoding == CookedFormat::BC4) internalFormat = GL_COMPRESSED_RED_RGTC1;
+        else if (ct.encoding == CookedFormat::BC5 || ct.encoding == CookedFormat::BC5_GB) internalFormat = GL_COMPRESSED_RG_RGTC2;
+        else if (ct.encoding == CookedFormat::BC7) internalFormat = ct.gamma ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        else if (ct.encoding == CookedFormat::RG8_GB) { format = GL_RG; internalFormat = GL_RG8; }
+    }
+    // sampler state of the texture bound to `target` on the active unit
+    static void cookedSamplerState(GLenum target, const CookedFormat::Texture &ct)
+    {
+        if (ct.encoding == CookedFormat::BC5_GB || ct.encoding == CookedFormat::RG8_GB) {
+            // stored RG = source GB; the shader samples .g (roughness) and .b (metallic)
+            const GLint swizzle[4] = {GL_ONE, GL_RED, GL_GREEN, GL_ONE};
+            glTexParameteriv(target, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, ct.levels > 0 ? (GLint)ct.levels - 1 : 0);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    // one GL_TEXTURE_2D per cooked texture; patches the names into the meshes. With `streamFrom` (the
+    // mapping `base` points into) only the levels up to TextureStreamer::RESIDENT_SIZE are uploaded and the
+    // rest is left to the streamer
+    void uploadCookedTextures(const unsigned char *base, const CookedFormat::Header &header, const CookedFormat::Texture *cookedTex,
+                              const string &path, uint64_t &textureBytes, const std::shared_ptr<const MappedFile> &streamFrom)
+    {
+        cookedTextures.resize(header.textureCount);
+        streamedTextures.assign(header.textureCount, -1);
+        if (header.textureCount)
+            glGenTextures((GLsizei)header.textureCount, &cookedTextures[0]);
+        for (uint32_t t = 0; t < header.textureCount; ++t) {
+            const CookedFormat::Texture &ct = cookedTex[t];
+            GLenum format, internalFormat;
+            cookedFormats(ct, format, internalFormat);
+            glState().bindTexture(0, GL_TEXTURE_2D, cookedTextures[t]);
+            uint32_t first = 0;
+            while (streamFrom && first + 1 < ct.levels && std::max(ct.width >> first, ct.height >> first) > TextureStreamer::RESIDENT_SIZE)
+                first++;
+            vector<TextureStreamer::Level> levels;
+            uint64_t offset = ct.dataOffset;
+            for (uint32_t level = 0; level < ct.levels; ++level) {
+                GLsizei w = (GLsizei)std::max(1u, ct.width >> level), h = (GLsizei)std::max(1u, ct.height >> level);
+                GLsizei size = (GLsizei)CookedFormat::levelSize(ct, level);
+                const TextureStreamer::Level data = {base + offset, (size_t)size};
+                levels.push_back(data);
+                offset += (uint64_t)size;
+                if (level < first)
+                    continue;
+                if (rawEncoding(ct.encoding))
+                    glTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat, w, h, 0, format, GL_UNSIGNED_BYTE, data.data);
+                else
+                    glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, internalFormat, w, h, 0, size, data.data);
+                textureBytes += (uint64_t)size;
+            }
+            gpuMemory().trackTexture(cookedTextures[t], GpuMemory::MODEL_TEXTURES, internalFormat, (int)std::max(1u, ct.width >> first),
+                                     (int)std::max(1u, ct.height >> first), 1, first + 1 < ct.levels, directory);
+            cookedSamplerState(GL_TEXTURE_2D, ct);
+            if (first > 0) {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)first);
+                streamedTextures[t] = textureStreamer().add(cookedTextures[t], internalFormat, format, !rawEncoding(ct.encoding), (int)ct.width, (int)ct.height,
+                                                            levels, (int)first, streamFrom, directory);
+            }
+            RenderDebug::checkDraw("after cooked texture upload", 0, path.c_str());
+        }
+        if (streamFrom) {
+            for (size_t i = 0; i < meshes.size(); ++i)
+                for (size_t k = 0; k < meshes[i].textures.size(); ++k) {
+                    const Texture &tex = meshes[i].textures[k];
+                    if (tex.id < streamedTextures.size() && streamedTextures[tex.id] >= 0) {
+                        TextureUse use = {(unsigned int)i, streamedTextures[tex.id], std::max(std::fabs(tex.uvScale.x), std::fabs(tex.uvScale.y))};
+                        streamedUses.push_back(use);
+                    }
+                }
+        }
+        const vector<unsigned int> &names = cookedTextures;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            meshes[i].remapTextureIds([&names](unsigned int t) { return t < names.size() ? names[t] : 0u; });
+    }
+
+    // packs the cooked textures into GL_TEXTURE_2D_ARRAYs (one per encoding, colour space and size) and
+    // builds the material table over their layers. Buckets then only differ by the arrays they sample, so
+    // a car is a handful of multi-draws. Returns false, creating no textures, if the materials or layers
+    // don't fit; the caller then uploads plain textures.
+    bool uploadCookedArrays(const unsigned char *base, const CookedFormat::Header &header, const CookedFormat::Texture *cookedTex,
+                            const string &path, uint64_t &textureBytes)
+    {
+        std::map<std::vector<uint32_t>, unsigned int> groupIndex;
+        vector<vector<uint32_t> > groups;
+        vector<unsigned int> groupOf(header.textureCount), layerOf(header.textureCount);
+        for (uint32_t t = 0; t < header.textureCount; ++t) {
+            const CookedFormat::Texture &ct = cookedTex[t];
+            uint32_t k[6] = {ct.encoding, ct.gamma, ct.components, ct.width, ct.height, ct.levels};
+            std::vector<uint32_t> key(k, k + 6);
+            std::map<std::vector<uint32_t>, unsigned int>::iterator it = groupIndex.find(key);
+            if (it == groupIndex.end()) {
+                it = groupIndex.insert(std::make_pair(key, (unsigned int)groups.size())).first;
+                groups.push_back(vector<uint32_t>());
+            }
+            groupOf[t] = it->second;
+            layerOf[t] = (unsigned int)groups[it->second].size();
+            groups[it->second].push_back(t);
+        }
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if ((GLint)groups[g].size() > maxLayers) {
+                LOG_INFO("[Model] '" << path << "' needs " << groups[g].size() << " array layers (max " << maxLayers << "), using plain textures");
+                return false;
+            }
+        }
+
+        // Texture::id is still the cooked texture index here
+        const uint32_t textureCount = header.textureCount;
+        if (!buildMaterialTable([&](const Texture &t) { return t.id < textureCount ? (int)layerOf[t.id] : -1; }, path))
+            return false;
+
+        textureArrays.resize(groups.size());
+        if (!groups.empty())
+            glGenTextures((GLsizei)groups.size(), &textureArrays[0]);
+        for (size_t g = 0; g < groups.size(); ++g) {
+            const CookedFormat::Texture &first = cookedTex[groups[g][0]];
+            const GLsizei layers = (GLsizei)groups[g].size();
+            GLenum format, internalFormat;
+            cookedFormats(first, format, internalFormat);
+            glState().bindTexture(0, GL_TEXTURE_2D_ARRAY, textureArrays[g]);
+            // allocate every level, then fill layer by layer straight from the mapping
+            for (uint32_t level = 0; level < first.levels; ++level) {
+                GLsizei w = (GLsizei)std::max(1u, first.width >> level), h = (GLsizei)std::max(1u, first.height >> level);
+                GLsizei size = (GLsizei)CookedFormat::levelSize(first, level);
+                if (rawEncoding(first.encoding))
+                    glTexImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, internalFormat, w, h, layers, 0, format, GL_UNSIGNED_BYTE, NULL);
+                else
+                    glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, internalFormat, w, h, layers, 0, size * layers, NULL);
+            }
+            for (GLsizei layer = 0; layer < layers; ++layer) {
+                const CookedFormat::Texture &ct = cookedTex[groups[g][layer]];
+                uint64_t offset = ct.dataOffset;
+                for (uint32_t level = 0; level < ct.levels; ++level) {
+                    GLsizei w = (GLsizei)std::max(1u, ct.width >> level), h = (GLsizei)std::max(1u, ct.height >> level);
+                    GLsizei size = (GLsizei)CookedFormat::levelSize(ct, level);
+                    if (rawEncoding(ct.encoding))
+                        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, 0, 0, layer, w, h, 1, format, GL_UNSIGNED_BYTE, base + offset);
+                    else
+                        glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, (GLint)level, 0, 0, layer, w, h, 1, internalFormat, size, base + offset);
+                    offset += (uint64_t)size;
+                }
+                textureBytes += ct.dataSize;
+            }
+            gpuMemory().trackTexture(textureArrays[g], GpuMemory::MODEL_TEXTURES, internalFormat, (int)first.width, (int)first.height, (int)layers, first.levels > 1, directory);
+            cookedSamplerState(GL_TEXTURE_2D_ARRAY, first);
+            RenderDebug::checkDraw("after cooked texture array upload", 0, path.c_str());
+        }
+
+        const vector<unsigned int> &arrays = textureArrays;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            meshes[i].remapTextureIds([&](unsigned int t) { return t < groupOf.size() ? arrays[groupOf[t]] : 0u; });
+        LOG_INFO("[Model] Texture arrays: " << header.textureCount << " textures in " << groups.size() << " arrays");
+        return true;
+    }
+
+    // the factor part of mesh `m`'s table entry (no textures, UV transforms or tag)
+    static MaterialData materialFactors(const Mesh &m)
+    {
+        MaterialData d;
+        d.baseColorFactor = m.baseColorFactor;
+        d.factors = glm::vec4(m.metallicFactor, m.roughnessFactor, m.alphaMode == Mesh::ALPHA_MASK ? m.alphaCutoff : 0.0f,
+                              m.alphaMode == Mesh::ALPHA_BLEND ? 1.0f : 0.0f);
+        d.uvOffsetsMR.z = m.clearcoatFactor;
+        d.uvOffsetsMR.w = m.clearcoatRoughnessFactor;
+        d.specularTransmission = glm::vec4(m.specularColorFactor * m.specularFactor, m.transmissionFactor);
+        return d;
+    }
+
+    // one table entry per distinct material: factors, UV transforms and `layerOf(slot texture)` (the array
+    // layer, 0 for plain textures, -1 = don't sample). Uploads the table and the per-vertex material index
+    // into the model's VAO. Returns false, leaving the table empty, if the model has too many materials.
+    template <class LayerFn>
+    bool buildMaterialTable(LayerFn layerOf, const string &name)
+    {
+        vector<uint16_t> meshMaterial(meshes.size());
+        variantEntries.assign(materialVariantNames.empty() ? 0 : meshes.size() * (materialVariantNames.size() + 1), 0);
+        size_t totalVertices = 0;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            MaterialData d = materialFactors(m);
+            const Texture *slot[3] = {m.diffuseTexture(), m.normalTexture(), m.metallicRoughnessTexture()};
+            glm::vec4 *uv[3] = {&d.diffuseUV, &d.normalUV, &d.metallicRoughnessUV};
+            float *offset[3] = {&d.uvOffsets.x, &d.uvOffsets.z, &d.uvOffsetsMR.x};
+            for (int k = 0; k < 3; ++k) {
+                if (!slot[k] || layerOf(*slot[k]) < 0)
+                    continue;
+                d.layers[k] = layerOf(*slot[k]);
+                if (!slot[k]->hasUVTransform())
+                    continue;
+                d.layers.w |= 1 << k;
+                *uv[k] = slot[k]->uvMatrix();
+                offset[k][0] = slot[k]->uvOffset.x;
+                offset[k][1] = slot[k]->uvOffset.y;
+            }
+            if (d.layers.z >= 0 && m.occlusionStrength > 0.0f)
+                d.layers.w |= (int)(glm::clamp(m.occlusionStrength, 0.0f, 1.0f) * 255.0f + 0.5f) << MaterialData::OCCLUSION_SHIFT;
+            d.layers.w |= (int)m.materialTag << MaterialOverrides::TAG_SHIFT;
+            meshMaterial[i] = (uint16_t)materials.add(d);
+            // every variant's material goes into the table too: its factors over this mesh's textures and
+            // alpha handling (selectMaterialVariant() only repoints the per-vertex indices)
+            if (!materialVariantNames.empty()) {
+                const size_t stride = materialVariantNames.size() + 1;
+                variantEntries[i * stride] = meshMaterial[i];
+                for (size_t v = 0; v + 1 < stride; ++v) {
+                    MaterialData vd = d;
+                    const int mi = v < m.variantMaterials.size() ? m.variantMaterials[v] : -1;
+                    variantEntries[i * stride + v + 1] = applyMaterialFactors(vd, mi) ? (uint16_t)materials.add(vd) : meshMaterial[i];
+                }
+            }
+            totalVertices = std::max(totalVertices, (size_t)std::max(m.baseVertex, 0) + m.vertexCount);
+        }
+        if (!materials.fits()) {
+            LOG_INFO("[Model] '" << name << "' has " << materials.size() << " materials (max " << MaterialTable::MAX_MATERIALS << "), using per-mesh material uniforms"
+                     << (materialVariantNames.empty() ? "" : " (material variants need the table: not selectable)"));
+            materials.release();
+            variantEntries.clear();
+            return false;
+        }
+        meshTableEntries = meshMaterial;
+        activeMaterialVariant = -1;
+        // material index per vertex: every mesh owns its vertex range in the shared buffer
+        vector<uint16_t> vertexMaterial(totalVertices, 0);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            size_t begin = (size_t)std::max(meshes[i].baseVertex, 0);
+            std::fill(vertexMaterial.begin() + begin, vertexMaterial.begin() + begin + meshes[i].vertexCount, meshMaterial[i]);
+        }
+        if (!materialVbo)
+            glGenBuffers(1, &materialVbo);
+        glState().bindVertexArray(geometry.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, materialVbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(vertexMaterial.size() * sizeof(uint16_t)), vertexMaterial.empty() ? NULL : &vertexMaterial[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(materialVbo, GpuMemory::MODEL_GEOMETRY, vertexMaterial.size() * sizeof(uint16_t), directory);
+        Mesh::setupMaterialIndexFormat(geometry.vao, materialVbo);
+        glState().bindVertexArray(0);
+        materials.upload();
+        LOG_INFO("[Model] Material table: " << materials.size() << " materials for " << meshes.size() << " meshes");
+        return true;
+    }
+
+    // the factors of glTF material `mi` over `d` (base colour, metallic / roughness, clearcoat, specular,
+    // transmission); false, `d` untouched, if there's no such material
+    bool applyMaterialFactors(MaterialData &d, int mi) const
+    {
+        if (mi < 0 || mi >= (int)materialBaseColorFactors.size())
+            return false;
+        d.baseColorFactor = materialBaseColorFactors[mi];
+        d.factors.x = materialMetallicFactors[mi];
+        d.factors.y = materialRoughnessFactors[mi];
+        d.uvOffsetsMR.z = materialClearcoats[mi].x;
+        d.uvOffsetsMR.w = materialClearcoats[mi].y;
+        d.specularTransmission = glm::vec4(glm::vec3(materialSpeculars[mi]) * materialSpeculars[mi].a, materialTransmissions[mi]);
+        return true;
+    }
+
+    // binds what a material-table draw of `m` samples: its bucket's arrays (MaterialKey holds array
+    // names in that mode) or its plain textures
+    void bindTableTextures(const Mesh &m) const
+    {
+        if (textureArrays.empty()) {
+            m.bindTextures();
+            return;
+        }
+        const Mesh::MaterialKey &key = m.materialKey();
+        glState().bindTextureUnit(UNIT_DIFFUSE_ARRAY, GL_TEXTURE_2D_ARRAY, key.diffuse);
+        glState().bindTextureUnit(UNIT_NORMAL_ARRAY, GL_TEXTURE_2D_ARRAY, key.normal);
+        glState().bindTextureUnit(UNIT_METALLIC_ROUGHNESS_ARRAY, GL_TEXTURE_2D_ARRAY, key.metallicRoughness);
+    }
+
+    // GL 4.3 indirect draw record (layout fixed by the spec)
+    struct DrawElementsIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    // one vertex/index buffer pair and VAO holding every mesh of the model (one per vertex format)
+    struct GeometryBuffer
+    {
+        GLuint vao = 0;
+        // the model's ranges of the GeometryArena pages vbo and ebo: the VAO's vertex attributes start at
+        // the vertex range, mesh and LOD firstIndex values already count from the start of the page
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        GeometryArena::Range vertices;
+        GeometryArena::Range indices;
+        // positions and instance matrices only, for the depth pre-pass (created on first use)
+        GLuint depthVao = 0;
+        // DrawElementsIndirectCommand per opaqueOrder entry (0 when GL 4.3 is unavailable)
+        GLuint indirectBuffer = 0;
+        // per-draw compacted commands of the meshes that survived frustum culling (streamed)
+        GLuint visibleIndirectBuffer = 0;
+        // per-instance matrices: the identity (every non-instanced mesh draws instance 0) followed by the
+        // transforms of each instanced mesh
+        GLuint instanceVbo = 0;
+        // SkinVertex per vertex (attributes 13/14), only for models with skinned meshes
+        GLuint skinVbo = 0;
+        // DrawInstances(): matrices and opaque commands for the current set of placements (streamed)
+        GLuint placementVbo = 0;
+        GLuint placementCommands = 0;
+        // bytes per index (2 = GL_UNSIGNED_SHORT), the same for every mesh so one multi-draw covers a bucket
+        unsigned int indexSize = 4;
+        // model-space position = positionOffset + unorm16 position * positionScale
+        glm::vec3 positionOffset = glm::vec3(0.0f);
+        glm::vec3 positionScale = glm::vec3(1.0f);
+
+        size_t vertexBytes() const { return vertices.offset * sizeof(PackedVertex); }
+        size_t indexBytes() const { return indices.offset * indexSize; }
+    };
+    GeometryBuffer geometry;
+
+    // contiguous range of opaqueOrder whose meshes share a material
+    struct DrawBucket
+    {
+        unsigned int first;
+        unsigned int count;
+        // Shader::Feature bits shared by the bucket's meshes
+        unsigned int features;
+    };
+
+    // SHADER_VARIANTS=0 draws every mesh with the runtime-branching base shader
+    static bool shaderVariants()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("SHADER_VARIANTS");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // FRUSTUM_CULLING=0 submits every mesh regardless of the view
+    static bool frustumCulling()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("FRUSTUM_CULLING");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // MESH_OPTIMIZE=0 keeps the triangle and vertex order of the source file
+    static bool meshOptimizeEnabled()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("MESH_OPTIMIZE");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // cache misses of the imported meshes before/after optimizeMesh, for the import log
+    struct CacheStats
+    {
+        double missesBefore = 0.0;
+        double missesAfter = 0.0;
+        size_t triangles = 0;
+        // identical vertices merged (MeshOptimizer::weldVertices)
+        size_t welded = 0;
+    };
+    CacheStats cacheStats;
+
+    // MESH_MERGE=0 keeps every imported mesh a draw of its own
+    static bool meshMergeEnabled()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("MESH_MERGE");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // MESH_LODS=0 imports full detail only (and selectLods() keeps every mesh at LOD 0)
+    // CONFIG_PARTS=<keywords> (comma separated, case insensitive): a node whose name contains one is a
+    // configurable part, and the meshes below it (setPartVisible) are neither merged nor instanced with
+    // meshes outside it
+    static const vector<string> &configPartNames()
+    {
+        static const vector<string> names = []() {
+            vector<string> out;
+            const char *env = std::getenv("CONFIG_PARTS");
+            string list = env ? env : "";
+            std::transform(list.begin(), list.end(), list.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            size_t start = 0;
+            while (start <= list.size()) {
+                const size_t comma = std::min(list.find(',', start), list.size());
+                if (comma > start)
+                    out.push_back(list.substr(start, comma - start));
+                start = comma + 1;
+            }
+            return out;
+        }();
+        return names;
+    }
+
+    // the part (configPartNames) hierarchy node `node` belongs to: its outermost ancestor, itself included,
+    // with a part keyword in its name, so an option group toggles whole; -1 if none
+    int partNodeOf(int node) const
+    {
+        const vector<string> &keywords = configPartNames();
+        int part = -1;
+        for (int n = node; n >= 0 && !keywords.empty(); n = nodes.parent(n)) {
+            string lower = nodes.name(n);
+            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            for (size_t k = 0; k < keywords.size(); ++k)
+                if (lower.find(keywords[k]) != string::npos) {
+                    part = n;
+                    break;
+                }
+        }
+        return part;
+    }
+
+    bool meshHiddenAt(size_t i) const { return i < meshHidden.size() && meshHidden[i]; }
+
+    // index count mesh `i` draws with: its current LOD's, or none while hidden
+    GLuint shownIndexCount(size_t i) const
+    {
+        const Mesh &m = meshes[i];
+        if (meshHiddenAt(i))
+            return 0;
+        return m.lods.size() > meshLod[i] && meshLod[i] > 0 ? m.lods[meshLod[i]].indexCount : m.indexCount;
+    }
+
+    // GL thread: setPartVisible() for one mesh; false if it already was
+    bool setMeshHidden(size_t i, bool hidden)
+    {
+        meshHidden.resize(meshes.size(), 0);
+        if (meshHidden[i] == (unsigned char)hidden)
+            return false;
+        meshHidden[i] = hidden;
+        if (drawSlot.size() == meshes.size() && drawSlot[i] >= 0) {
+            const unsigned int k = (unsigned int)drawSlot[i];
+            const GLuint count = shownIndexCount(i);
+            drawCounts[k] = (GLsizei)count;
+            drawCommands[k].count = count;
+            if (geometry.indirectBuffer) {
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometry.indirectBuffer);
+                glBufferSubData(GL_DRAW_INDIRECT_BUFFER, (GLintptr)(k * sizeof(DrawElementsIndirectCommand)), sizeof(DrawElementsIndirectCommand), &drawCommands[k]);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            }
+            if (occlusion.ready() && occlusion.hiZ)
+                occlusion.setDrawRange(k, drawCommands[k].firstIndex, count);
+        }
+        const std::vector<unsigned int>::const_iterator w = std::find(weightedOrder.begin(), weightedOrder.end(), (unsigned int)i);
+        if (w != weightedOrder.end())
+            weightedCounts[w - weightedOrder.begin()] = hidden ? 0 : (GLsizei)meshes[i].indexCount;
+        return true;
+    }
+
+    // MESH_INSTANCING=0 bakes every node's copy of a shared mesh instead of drawing it instanced
+    static bool meshInstancingEnabled()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("MESH_INSTANCING");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // NODE_TRANSFORMS=1 keeps every mesh in its node's space (drawn through the instance path) so nodes
+    // can move at runtime; by default unshared meshes are baked into model space
+    static bool keepNodeTransforms()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("NODE_TRANSFORMS");
+            return env && std::string(env) == "1";
+        }();
+        return enabled;
+    }
+
+    static bool meshLodsEnabled()
+    {
+        static const bool enabled = []() {
+            const char *env = std::getenv("MESH_LODS");
+            return !(env && std::string(env) == "0");
+        }();
+        return enabled;
+    }
+
+    // largest tolerated LOD error on screen, in pixels (LOD_ERROR_PIXELS, default 1)
+    static float lodErrorPixels()
+    {
+        static const float pixels = []() {
+            const char *env = std::getenv("LOD_ERROR_PIXELS");
+            float v = env ? (float)std::atof(env) : 0.0f;
+            return v > 0.0f ? v : 1.0f;
+        }();
+        return pixels;
+    }
+
+    // opaque mesh indices sorted by material; built once since the mesh set is static after load
+    std::vector<unsigned int> opaqueOrder;
+    std::vector<DrawBucket> opaqueBuckets;
+    std::vector<unsigned int> transparentMeshes;
+    // OIT=1: transparent meshes drawn weighted blended, bucketed like the opaque ones (full detail, no
+    // indirect commands)
+    std::vector<unsigned int> weightedOrder;
+    std::vector<DrawBucket> weightedBuckets;
+    std::vector<GLsizei> weightedCounts;
+    std::vector<const void *> weightedOffsets;
+    std::vector<GLint> weightedBaseVertices;
+    // opaque meshes drawn instanced (Mesh::instances), one draw each after the buckets
+    std::vector<unsigned int> instancedMeshes;
+    // DrawInstances(): each instanced mesh's first matrix in geometry.placementVbo, indexed like `meshes`
+    std::vector<unsigned int> placementBase;
+    std::vector<DrawElementsIndirectCommand> placementCommands;
+    // glMultiDrawElementsBaseVertex arguments, parallel to opaqueOrder
+    std::vector<GLsizei> drawCounts;
+    std::vector<const void *> drawOffsets;
+    std::vector<GLint> drawBaseVertices;
+    std::vector<DrawElementsIndirectCommand> drawCommands;
+    // current LOD per mesh, and each opaque mesh's slot in the lists above (-1 for transparent meshes)
+    std::vector<unsigned int> meshLod;
+    std::vector<int> drawSlot;
+    // selectLods() scratch: the level each mesh picks this frame; meshes per job (fewer run inline)
+    std::vector<unsigned int> lodChoice;
+    static const size_t LOD_GRAIN = 512;
+    // see setPreviousModelMatrix()
+    glm::mat4 previousModelMatrix = glm::mat4(1.0f);
+    bool hasPreviousModel = false;
+    // hierarchy over the model-space bounds of the meshes (items indexed like `meshes`) and the result
+    // of the last cull
+    BVH meshTree;
+    // triangles of each mesh in its own space, for raycast(); empty unless built
+    vector<TriangleBVH> triangleTrees;
+    // scene nodes, parents first; instanced meshes name theirs in Mesh::instanceNodes
+    TransformHierarchy nodes;
+    // ANIMATION=1: the glTF clips moving `nodes` and the skins of the skinned meshes; bindBones() keeps
+    // the palette's frame ring range for the epoch it was written in
+    NodeAnimation animation;
+    mutable FrameRingBuffer::Range bonesRange = FrameRingBuffer::Range();
+    mutable uint64_t bonesEpoch = 0;
+    // transparent order of draws that aren't queued scene-wide (probe faces, DrawInstances); kept across
+    // frames so sorting doesn't allocate
+    TransparentQueue localTransparent;
+    std::vector<unsigned char> meshVisible;
+    // per mesh: hidden with its configurable part (setPartVisible); kept across draw list rebuilds
+    std::vector<unsigned char> meshHidden;
+    // the draw list above restricted to visible meshes, rebuilt by compactVisibleDraws()
+    std::vector<unsigned int> visibleOrder;
+    std::vector<DrawBucket> visibleBuckets;
+    std::vector<GLsizei> visibleCounts;
+    std::vector<const void *> visibleOffsets;
+    std::vector<GLint> visibleBaseVertices;
+    std::vector<DrawElementsIndirectCommand> visibleCommands;
+    // compactVisibleDraws() scratch: the opaque draws in chunks of at most RECORD_GRAIN, none straddling
+    // a bucket, and where each chunk's region of the lists above starts (one past the end for the last).
+    // Lists shorter than two chunks are recorded inline: copying a draw costs nanoseconds, a pool round
+    // trip microseconds.
+    struct RecordChunk
+    {
+        unsigned int first, end; // opaqueOrder range
+        unsigned int bucket;
+    };
+    std::vector<RecordChunk> recordChunks;
+    std::vector<unsigned int> visibleRegions;
+    static const unsigned int RECORD_GRAIN = 2048;
+    // drawDepthPrepass(): (squared distance of the nearest mesh, bucket) of the buckets it draws
+    std::vector<std::pair<float, unsigned int> > depthBucketOrder;
+
+    // per-draw occlusion state (OCCLUSION_CULLING=1), indexed like opaqueOrder
+    OcclusionCuller::Target occlusion;
+    // MESHLET_CULLING=1 state: GPU buffers, a slot per opaqueOrder entry and the command region of each
+    // opaque bucket (`meshletOrder` maps every command to its bucket's first mesh, for the material)
+    MeshletCuller::Target meshletTarget;
+    std::vector<MeshletCuller::Slot> meshletSlots;
+    std::vector<DrawBucket> meshletBuckets;
+    std::vector<unsigned int> meshletOrder;
+    // GPU_DRIVEN=1: the opaque draws and placements on the GPU, and the command regions of the buckets for
+    // the current placement count (`sceneOrder` maps every command to its bucket's first mesh, for the material)
+    SceneCuller::Target sceneTarget;
+    std::vector<DrawBucket> sceneBuckets;
+    std::vector<unsigned int> sceneOrder;
+    // VISIBILITY_BUFFER=1: the ID pass VAO and resolve buffer textures, the meshes' current index ranges
+    // and the buckets of the last drawVisibility() left to the forward pass
+    VisibilityBuffer::Target visibilityTarget;
+    std::vector<glm::ivec2> visibilityRanges;
+    std::vector<DrawBucket> forwardBuckets;
+
+    // first drawVisibility(): the per-vertex mesh indices and buffer textures, if the model fits the ID
+    // layout (mesh count, triangles per mesh) and draws through the material table
+    bool prepareVisibility(VisibilityBuffer &target)
+    {
+        if (visibilityTarget.ready())
+            return true;
+        if (visibilityTarget.unsupported || !materials.ready() || !materialVbo)
+            return false;
+        visibilityTarget.unsupported = true;
+        if (meshes.size() > VisibilityBuffer::MAX_MESHES)
+            return false;
+        size_t indexTotal = 0;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            if (m.indexCount / 3 >= (1u << VisibilityBuffer::PRIMITIVE_BITS))
+                return false;
+            indexTotal = std::max(indexTotal, (size_t)m.firstIndex + m.indexCount);
+            for (size_t l = 0; l < m.lods.size(); ++l)
+                indexTotal = std::max(indexTotal, (size_t)m.lods[l].firstIndex + m.lods[l].indexCount);
+        }
+        const std::vector<uint16_t> vertexMeshes = vertexMeshIndices();
+        if (!target.prepare(visibilityTarget, geometry.vbo, geometry.vertices.offset, geometry.ebo, geometry.indexSize, indexTotal,
+                            geometry.instanceVbo, materialVbo, vertexMeshes, directory))
+            return false;
+        LOG_INFO("[VisBuffer] " << directory << ": " << meshes.size() << " meshes resolved from the ID target");
+        return true;
+    }
+
+    // the index of the mesh owning each vertex of the shared buffer (every mesh owns its vertex range)
+    std::vector<uint16_t> vertexMeshIndices() const
+    {
+        size_t vertexTotal = 0;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            vertexTotal = std::max(vertexTotal, (size_t)std::max(meshes[i].baseVertex, 0) + meshes[i].vertexCount);
+        std::vector<uint16_t> vertexMeshes(vertexTotal, 0);
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const size_t begin = (size_t)std::max(meshes[i].baseVertex, 0);
+            std::fill(vertexMeshes.begin() + begin, vertexMeshes.begin() + begin + meshes[i].vertexCount, (uint16_t)i);
+        }
+        return vertexMeshes;
+    }
+
+    // the index range each mesh draws at its current LOD, for the resolve's vertex fetch
+    void updateVisibilityRanges(VisibilityBuffer &target)
+    {
+        visibilityRanges.resize(meshes.size());
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            const unsigned int first = i < meshLod.size() && meshLod[i] < m.lods.size() ? m.lods[meshLod[i]].firstIndex : m.firstIndex;
+            visibilityRanges[i] = glm::ivec2((int)first, visibilityTarget.vertexBase + m.baseVertex);
+        }
+        target.updateRanges(visibilityTarget, visibilityRanges, directory);
+    }
+
+    void prepareOcclusion(OcclusionCuller &culler)
+    {
+        std::vector<glm::vec3> boundsMin(opaqueOrder.size()), boundsMax(opaqueOrder.size());
+        for (size_t k = 0; k < opaqueOrder.size(); ++k) {
+            boundsMin[k] = meshes[opaqueOrder[k]].boundsMin;
+            boundsMax[k] = meshes[opaqueOrder[k]].boundsMax;
+        }
+        // the Hi-Z path needs the indirect command buffer (GL 4.3) as the template of its command lists
+        if (culler.hiZ() && !geometry.indirectBuffer)
+            return;
+        if (!boundsMin.empty())
+            culler.prepare(occlusion, &boundsMin[0], &boundsMax[0], (unsigned int)boundsMin.size(), geometry.indirectBuffer);
+    }
+
+    // arguments of one opaque submission: buckets over `order` and the parallel multi-draw arrays
+    struct DrawList
+    {
+        const std::vector<unsigned int> *order;
+        const std::vector<DrawBucket> *buckets;
+        const std::vector<GLsizei> *counts;
+        const std::vector<const void *> *offsets;
+        const std::vector<GLint> *baseVertices;
+        GLuint indirectBuffer;
+        // per-bucket draw counts written by the GPU (GL 4.6), 0 if bucket.count is exact
+        GLuint countBuffer;
+        // instances of every draw when drawn without indirect commands (DrawInstances on GL < 4.3)
+        GLsizei instances;
+    };
+
+    DrawList staticDrawList() const
+    {
+        DrawList list = {&opaqueOrder, &opaqueBuckets, &drawCounts, &drawOffsets, &drawBaseVertices, geometry.indirectBuffer, 0, 1};
+        return list;
+    }
+
+    // triangles `bucket` of `list` submits (GL_STATS): its draws' index counts times the instances
+    static size_t bucketPrimitives(const DrawList &list, const DrawBucket &bucket)
+    {
+        // GPU-compacted lists: the triangles are only known on the GPU
+        if (!list.counts)
+            return 0;
+        size_t indices = 0;
+        for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k)
+            indices += (size_t)(*list.counts)[k];
+        return indices / 3 * (size_t)list.instances;
+    }
+
+    DrawList visibleDrawList() const
+    {
+        DrawList list = {&visibleOrder, &visibleBuckets, &visibleCounts, &visibleOffsets, &visibleBaseVertices, geometry.visibleIndirectBuffer, 0, 1};
+        return list;
+    }
+
+    // binds the model-wide state for a draw; false if the model isn't on the GPU yet
+    // std140 `Object` block of model_loading.vs and depth_prepass.vs: the per-draw matrices and the
+    // dequantization of PackedVertex positions, one frame ring write per draw (every shader variant reads
+    // it from the same binding point)
+    struct ObjectData
+    {
+        glm::mat4 model;
+        glm::vec4 normalMatrix[3]; // mat3 columns, each padded to a vec4
+        glm::vec4 positionOffset;
+        glm::vec4 positionScale;
+        glm::mat4 previousModel; // last frame's model matrix, for motion vectors
+    };
+    static_assert(sizeof(ObjectData) == 208, "ObjectData must match the std140 Object block in model_loading.vs");
+    // uniform buffer binding point of the `Object` block (see Shader::uniformBlockBinding)
+    static const GLuint OBJECT_BINDING = 1;
+
+    void bindObjectData(const glm::mat4 &modelMatrix) const
+    {
+        ObjectData object;
+        object.model = modelMatrix;
+        // normal matrix of the model matrix, once per draw instead of an inverse per vertex
+        const glm::mat3 normal = Mesh::normalMatrix(modelMatrix);
+        for (int c = 0; c < 3; ++c)
+            object.normalMatrix[c] = glm::vec4(normal[c], 0.0f);
+        object.positionOffset = glm::vec4(geometry.positionOffset, 0.0f);
+        object.positionScale = glm::vec4(geometry.positionScale, 0.0f);
+        object.previousModel = hasPreviousModel ? previousModelMatrix : modelMatrix;
+        frameRing().bindUniform(OBJECT_BINDING, object);
+        if (animation.hasSkins())
+            bindBones();
+    }
+
+    // the joint palette of the skinned meshes (`Bones` block of the SKINNED variants), written once per
+    // frame ring epoch and shared by all of the model's draws in it
+    void bindBones() const
+    {
+        if (bonesEpoch != frameRing().epoch() || !bonesRange.buffer) {
+            bonesRange = frameRing().write(&animation.palette()[0], NodeAnimation::MAX_JOINTS * sizeof(glm::mat4));
+            bonesEpoch = frameRing().epoch();
+        }
+        glBindBufferRange(GL_UNIFORM_BUFFER, NodeAnimation::BINDING, bonesRange.buffer, bonesRange.offset, bonesRange.size);
+    }
+
+    bool beginDraw(Shader &shader, const glm::mat4 &modelMatrix)
+    {
+        if (!ready())
+            return false;
+        if (opaqueOrder.size() + transparentMeshes.size() + weightedOrder.size() + instancedMeshes.size() != meshes.size())
+            buildDrawList();
+        shader.use();
+        bindObjectData(modelMatrix);
+        // the sampler units are fixed at link (the array samplers get their own: samplers of different
+        // types may not share one)
+        static const Shader::UniformHandle uUseMaterialTable = Shader::uniformHandle("useMaterialTable");
+        static const Shader::UniformHandle uUseTextureArrays = Shader::uniformHandle("useTextureArrays");
+        shader.setBool(uUseMaterialTable, materials.ready());
+        shader.setBool(uUseTextureArrays, !textureArrays.empty());
+        if (materials.ready())
+            materials.bind();
+        static const Shader::UniformHandle uHasPaintDecals = Shader::uniformHandle("hasPaintDecals");
+        shader.setBool(uHasPaintDecals, decalTexture != 0);
+        if (decalTexture)
+            glState().bindTexture(UNIT_PAINT_DECALS, GL_TEXTURE_2D, decalTexture);
+        glState().bindVertexArray(geometry.vao);
+        return true;
+    }
+
+    // one multi-draw per material bucket of `list`
+    void drawOpaque(Shader &shader, const DrawList &list)
+    {
+        const bool tableDraw = materials.ready();
+        const bool useVariants = shaderVariants();
+        if (list.indirectBuffer)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, list.indirectBuffer);
+        if (list.countBuffer)
+            glBindBuffer(GL_PARAMETER_BUFFER, list.countBuffer);
+        for (size_t b = 0; b < list.buckets->size(); ++b) {
+            const DrawBucket &bucket = (*list.buckets)[b];
+            Shader &sh = useVariants ? shader.useVariant(bucket.features) : shader;
+            if (tableDraw)
+                bindTableTextures(meshes[(*list.order)[bucket.first]]);
+            else
+                meshes[(*list.order)[bucket.first]].bindMaterial(sh);
+            if (list.countBuffer)
+                glMultiDrawElementsIndirectCount(GL_TRIANGLES, geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (const void *)(bucket.first * sizeof(DrawElementsIndirectCommand)),
+                                                 (GLintptr)(b * sizeof(GLuint)), (GLsizei)bucket.count, 0);
+            else if (list.indirectBuffer)
+                glMultiDrawElementsIndirect(GL_TRIANGLES, geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (const void *)(bucket.first * sizeof(DrawElementsIndirectCommand)), (GLsizei)bucket.count, 0);
+            else if (list.instances != 1)
+                for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k) {
+                    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (*list.counts)[k], geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                                                      (*list.offsets)[k], list.instances, (*list.baseVertices)[k]);
+                    drawStats().count();
+                }
+            else
+                glMultiDrawElementsBaseVertex(GL_TRIANGLES, &(*list.counts)[bucket.first], geometry.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, &(*list.offsets)[bucket.first], (GLsizei)bucket.count, &(*list.baseVertices)[bucket.first]);
+            if (list.countBuffer || list.indirectBuffer || list.instances == 1)
+                drawStats().count(bucket.count); // the instanced fallback counted its draws itself
+            GL_STATS_ADD(primitives, bucketPrimitives(list, bucket));
+            RenderDebug::checkDraw("after opaque bucket multi-draw", sh.ID);
+        }
+    }
+
+    // MESHLET_CULLING=1 opaque pass: refreshes the per-draw modes (culled mesh, clusters, or a whole coarser
+    // LOD), lets the GPU cull and compact the clusters and draws the buckets from its command regions
+    void drawMeshlets(Shader &shader, MeshletCuller &culler, const glm::mat4 &clipFromModel, const glm::vec3 &eye)
+    {
+        if (!meshletTarget.ready())
+            prepareMeshlets(culler);
+        for (size_t k = 0; k < opaqueOrder.size(); ++k) {
+            const unsigned int i = opaqueOrder[k];
+            MeshletCuller::Slot &slot = meshletSlots[k];
+            slot.mode = !meshVisible[i] || meshHiddenAt(i) ? MeshletCuller::SKIP : (meshLod[i] == 0 ? MeshletCuller::MESHLETS : MeshletCuller::WHOLE);
+            slot.count = drawCommands[k].count;
+            slot.firstIndex = drawCommands[k].firstIndex;
+        }
+        culler.cull(meshletTarget, meshletSlots, clipFromModel, eye);
+        DrawList list = {&meshletOrder, &meshletBuckets, 0, 0, 0, meshletTarget.commandBuffer,
+                         MeshletCuller::drawCountSupported() ? meshletTarget.countBuffer : 0, 1};
+        drawOpaque(shader, list);
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+    }
+
+    // uploads the clusters of the opaque draws; each bucket's commands get a region as large as its cluster
+    // count. Meshes without clusters (cooked before meshlets existed) count as one cluster.
+    void prepareMeshlets(MeshletCuller &culler)
+    {
+        std::vector<MeshletCuller::GpuMeshlet> gpuMeshlets;
+        meshletSlots.assign(opaqueOrder.size(), MeshletCuller::Slot());
+        meshletBuckets.clear();
+        meshletOrder.clear();
+        for (unsigned int b = 0; b < opaqueBuckets.size(); ++b) {
+            const DrawBucket &bucket = opaqueBuckets[b];
+            DrawBucket region = {(unsigned int)meshletOrder.size(), 0, bucket.features};
+            for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k) {
+                const Mesh &m = meshes[opaqueOrder[k]];
+                MeshletCuller::Slot slot = {MeshletCuller::MESHLETS, m.indexCount, m.firstIndex, b, region.first};
+                meshletSlots[k] = slot;
+                if (m.meshlets.empty()) {
+                    const glm::vec3 centre = (m.boundsMin + m.boundsMax) * 0.5f;
+                    MeshletCuller::GpuMeshlet whole = {glm::vec4(centre, m.boundingRadius), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+                                                       m.firstIndex, m.indexCount, m.baseVertex, k};
+                    gpuMeshlets.push_back(whole);
+                    region.count++;
+                }
+                for (size_t c = 0; c < m.meshlets.size(); ++c) {
+                    const Mesh::Meshlet &ml = m.meshlets[c];
+                    MeshletCuller::GpuMeshlet g = {ml.sphere, ml.cone, m.firstIndex + ml.firstIndex, ml.indexCount, m.baseVertex, k};
+                    gpuMeshlets.push_back(g);
+                    region.count++;
+                }
+            }
+            // drawOpaque binds the bucket's material from meshes[order[first]]
+            meshletOrder.resize(meshletOrder.size() + region.count, opaqueOrder[bucket.first]);
+            meshletBuckets.push_back(region);
+        }
+        culler.prepare(meshletTarget, gpuMeshlets, (unsigned int)meshletSlots.size(), (unsigned int)meshletBuckets.size(), (unsigned int)meshletOrder.size());
+        LOG_INFO("[Meshlets] " << gpuMeshlets.size() << " clusters in " << meshletBuckets.size() << " buckets");
+    }
+
+    // uploads the box and bucket of every opaque draw for SceneCuller
+    void prepareSceneDraws(SceneCuller &culler)
+    {
+        std::vector<SceneCuller::GpuDraw> draws(opaqueOrder.size());
+        for (unsigned int b = 0; b < opaqueBuckets.size(); ++b) {
+            const DrawBucket &bucket = opaqueBuckets[b];
+            for (unsigned int k = bucket.first; k < bucket.first + bucket.count; ++k) {
+                const Mesh &m = meshes[opaqueOrder[k]];
+                SceneCuller::GpuDraw d = {glm::vec4(m.boundsMin, 1.0f), glm::vec4(m.boundsMax, 1.0f), b, bucket.first, {0, 0}};
+                draws[k] = d;
+            }
+        }
+        culler.prepare(sceneTarget, draws, (unsigned int)opaqueBuckets.size(), directory);
+        sceneOrder.clear();
+        LOG_INFO("[GpuDriven] " << draws.size() << " opaque draws in " << opaqueBuckets.size() << " buckets for '" << directory << "'");
+    }
+
+    // command regions of the buckets with `placements` placements: every draw of a bucket, once per placement
+    void buildSceneRegions(unsigned int placements)
+    {
+        sceneBuckets.clear();
+        sceneOrder.clear();
+        for (unsigned int b = 0; b < opaqueBuckets.size(); ++b) {
+            const DrawBucket &bucket = opaqueBuckets[b];
+            DrawBucket region = {bucket.first * placements, bucket.count * placements, bucket.features};
+            // drawOpaque binds the bucket's material from meshes[order[first]]
+            sceneOrder.resize(sceneOrder.size() + region.count, opaqueOrder[bucket.first]);
+            sceneBuckets.push_back(region);
+        }
+    }
+
+    // sorted back to front by squared distance of the world-space centroids; with `culled`, meshes cleared
+    // in meshVisible are skipped. `placements` > 1 (DrawInstances) draws every mesh once per placement,
+    // sorted by the first one. With `queue` the meshes are only added to it, as `source`.
+    void drawTransparent(Shader &shader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos, bool culled, GLsizei placements = 1,
+                         TransparentQueue *queue = nullptr, unsigned int source = 0)
+    {
+        TransparentQueue &target = queue ? *queue : localTransparent;
+        if (!queue)
+            localTransparent.begin();
+        for (size_t k = 0; k < transparentMeshes.size(); ++k) {
+            const unsigned int i = transparentMeshes[k];
+            if ((culled && !meshVisible[i]) || meshHiddenAt(i))
+                continue;
+            const glm::vec3 toMesh = glm::vec3(modelMatrix * glm::vec4(meshes[i].centroid, 1.0f)) - cameraPos;
+            target.add(source, i, glm::dot(toMesh, toMesh));
+        }
+        if (queue)
+            return;
+        localTransparent.sort(cameraPos, 0, 0.0f);
+        drawTransparentRange(shader, localTransparent, 0, localTransparent.size(), placements);
+        // no weighted blend targets here: the weighted meshes go on top, blended as usual
+        drawWeightedList(shader, placements);
+    }
+
+    // the weighted list with depth writes off; `placements` as in drawTransparent
+    void drawWeightedList(Shader &shader, GLsizei placements)
+    {
+        if (weightedOrder.empty())
+            return;
+        glEnable(GL_BLEND);
+        glDepthMask(GL_FALSE);
+        DrawList list = {&weightedOrder, &weightedBuckets, &weightedCounts, &weightedOffsets, &weightedBaseVertices, 0, 0, placements};
+        drawOpaque(shader, list);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+    }
+
+    // draws queue entries [begin, end) (all this model's meshes) with depth writes off so blending works;
+    // blending is only on here, the opaque (and alpha tested) draws don't pay for it
+    void drawTransparentRange(Shader &shader, const TransparentQueue &queue, size_t begin, size_t end, GLsizei placements)
+    {
+        const bool tableDraw = materials.ready();
+        const bool useVariants = shaderVariants();
+        glEnable(GL_BLEND);
+        glDepthMask(GL_FALSE);
+        const Mesh *prev = 0;
+        for (size_t k = begin; k < end; ++k) {
+            const unsigned int i = queue[k].item;
+            Mesh &m = meshes[i];
+            const bool newVariant = useVariants && (!prev || m.shaderFeatures() != prev->shaderFeatures());
+            Shader &sh = useVariants ? shader.useVariant(m.shaderFeatures()) : shader;
+            if (tableDraw)
+                bindTableTextures(m);
+            else if (!prev || newVariant || !m.sameMaterial(*prev))
+                m.bindMaterial(sh);
+            drawMeshInstances(sh, i, placements);
+            prev = &m;
+        }
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+    }
+
+    // the opaque instanced meshes, one instanced draw each; see drawTransparent for `culled`/`placements`
+    void drawInstancedMeshes(Shader &shader, bool culled, GLsizei placements)
+    {
+        const bool tableDraw = materials.ready();
+        const bool useVariants = shaderVariants();
+        for (size_t k = 0; k < instancedMeshes.size(); ++k) {
+            const unsigned int i = instancedMeshes[k];
+            if ((culled && !meshVisible[i]) || meshHiddenAt(i))
+                continue;
+            Mesh &m = meshes[i];
+            Shader &sh = useVariants ? shader.useVariant(m.shaderFeatures()) : shader;
+            if (tableDraw)
+                bindTableTextures(m);
+            else
+                m.bindMaterial(sh);
+            drawMeshInstances(sh, i, placements);
+        }
+    }
+
+    // all instances of mesh `i` at its current LOD: its own transforms, times `placements` when drawn from
+    // DrawInstances(). Without base instances (GL < 4.2) the instance attributes are re-pointed instead.
+    void drawMeshInstances(Shader &sh, unsigned int i, GLsizei placements)
+    {
+        Mesh &m = meshes[i];
+        const GLsizei count = placements * (GLsizei)std::max<size_t>(1, m.instances.size());
+        const GLuint base = placements == 1 ? m.firstInstance : (m.instances.empty() ? 0 : placementBase[i]);
+        if (base == 0 || GLAD_GL_VERSION_4_2) {
+            m.drawGeometry(sh, meshLod[i], count, base);
+            return;
+        }
+        const GLuint buffer = placements == 1 ? geometry.instanceVbo : geometry.placementVbo;
+        Mesh::bindInstanceBuffer(geometry.vao, buffer, base);
+        glState().bindVertexArray(geometry.vao);
+        m.drawGeometry(sh, meshLod[i], count, 0);
+        Mesh::bindInstanceBuffer(geometry.vao, buffer, 0);
+    }
+
+    // adds this view's culling result (meshVisible) to the frame's DrawStats
+    void countCulled() const
+    {
+        size_t skipped = 0;
+        for (size_t i = 0; i < meshVisible.size(); ++i)
+            skipped += !meshVisible[i];
+        drawStats().countCulled(meshVisible.size(), skipped);
+    }
+
+    // gathers the opaque draws of the meshes marked in meshVisible, keeping the bucket split (empty buckets
+    // are dropped) and streaming the indirect commands. Returns false when nothing was culled, in which
+    // case the static draw list is used as is. Large lists are recorded in parallel on the pool, in chunks
+    // of draws: each chunk counts its visible draws, and after a prefix sum over the counts fills its own
+    // region of the lists.
+    bool compactVisibleDraws()
+    {
+        recordChunks.clear();
+        for (size_t b = 0; b < opaqueBuckets.size(); ++b) {
+            const DrawBucket &bucket = opaqueBuckets[b];
+            for (unsigned int k = bucket.first; k < bucket.first + bucket.count; k += RECORD_GRAIN) {
+                RecordChunk chunk = {k, std::min(k + RECORD_GRAIN, bucket.first + bucket.count), (unsigned int)b};
+                recordChunks.push_back(chunk);
+            }
+        }
+        const size_t chunks = recordChunks.size();
+        const size_t grain = opaqueOrder.size() >= 2 * RECORD_GRAIN ? 1 : chunks;
+        visibleRegions.assign(chunks + 1, 0);
+        ThreadPool::shared().parallelFor(chunks, grain, [this](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                unsigned int kept = 0;
+                for (unsigned int k = recordChunks[c].first; k < recordChunks[c].end; ++k)
+                    kept += meshVisible[opaqueOrder[k]];
+                visibleRegions[c + 1] = kept;
+            }
+        }, "count visible draws");
+        for (size_t c = 0; c < chunks; ++c)
+            visibleRegions[c + 1] += visibleRegions[c];
+        const size_t visible = visibleRegions[chunks];
+        if (visible == opaqueOrder.size())
+            return false;
+        visibleOrder.resize(visible);
+        visibleCounts.resize(visible);
+        visibleOffsets.resize(visible);
+        visibleBaseVertices.resize(visible);
+        visibleCommands.resize(geometry.indirectBuffer ? visible : 0);
+        ThreadPool::shared().parallelFor(chunks, grain, [this](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                unsigned int out = visibleRegions[c];
+                for (unsigned int k = recordChunks[c].first; k < recordChunks[c].end; ++k) {
+                    if (!meshVisible[opaqueOrder[k]])
+                        continue;
+                    visibleOrder[out] = opaqueOrder[k];
+                    visibleCounts[out] = drawCounts[k];
+                    visibleOffsets[out] = drawOffsets[k];
+                    visibleBaseVertices[out] = drawBaseVertices[k];
+                    if (geometry.indirectBuffer)
+                        visibleCommands[out] = drawCommands[k];
+                    ++out;
+                }
+            }
+        }, "record visible draws");
+        // a bucket's region runs from its first chunk's start to its last chunk's end
+        visibleBuckets.clear();
+        for (size_t c = 0; c < chunks;) {
+            size_t last = c;
+            while (last + 1 < chunks && recordChunks[last + 1].bucket == recordChunks[c].bucket)
+                ++last;
+            DrawBucket kept = {visibleRegions[c], visibleRegions[last + 1] - visibleRegions[c], opaqueBuckets[recordChunks[c].bucket].features};
+            if (kept.count)
+                visibleBuckets.push_back(kept);
+            c = last + 1;
+        }
+        if (geometry.indirectBuffer && !visibleCommands.empty()) {
+            if (!geometry.visibleIndirectBuffer)
+                glGenBuffers(1, &geometry.visibleIndirectBuffer);
+            // orphan first: the previous pass (e.g. a probe face) may still be reading the old commands
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometry.visibleIndirectBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, drawCommands.size() * sizeof(DrawElementsIndirectCommand), NULL, GL_STREAM_DRAW);
+            gpuMemory().trackBuffer(geometry.visibleIndirectBuffer, GpuMemory::DRAW_BUFFERS, drawCommands.size() * sizeof(DrawElementsIndirectCommand), directory);
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, visibleCommands.size() * sizeof(DrawElementsIndirectCommand), &visibleCommands[0]);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+        return true;
+    }
+
+    // model AABB and vertex count from the per-mesh bounds; the quantization box also covers the
+    // untransformed vertices of instanced meshes
+    void computeBounds()
+    {
+        glm::vec3 bmin(std::numeric_limits<float>::max()), bmax(-std::numeric_limits<float>::max());
+        glm::vec3 qmin = bmin, qmax = bmax;
+        vertexCount = 0;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            if (meshes[i].vertexCount == 0)
+                continue;
+            vertexCount += meshes[i].vertexCount;
+            bmin = glm::min(bmin, meshes[i].boundsMin);
+            bmax = glm::max(bmax, meshes[i].boundsMax);
+            if (meshes[i].skin >= 0) {
+                // bind pose, where the vertices are
+                qmin = glm::min(qmin, meshes[i].localBoundsMin);
+                qmax = glm::max(qmax, meshes[i].localBoundsMax);
+            } else if (meshes[i].instances.empty()) {
+                qmin = glm::min(qmin, meshes[i].boundsMin);
+                qmax = glm::max(qmax, meshes[i].boundsMax);
+            } else {
+                const vector<glm::vec3> &positions = meshes[i].vertices.positions;
+                for (size_t v = 0; v < positions.size(); ++v) {
+                    qmin = glm::min(qmin, positions[v]);
+                    qmax = glm::max(qmax, positions[v]);
+                }
+            }
+        }
+        if (vertexCount > 0) {
+            boundsMin = bmin;
+            boundsMax = bmax;
+            quantizationMin = qmin;
+            quantizationMax = qmax;
+        }
+    }
+
+    // creates the instance buffer (identity, then every instanced mesh's transforms, each with its normal
+    // matrix) and points attributes 4-10 of the shared VAO at it
+    void uploadInstances()
+    {
+        std::vector<Mesh::InstanceTransform> matrices(1, Mesh::instanceTransform(glm::mat4(1.0f)));
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &m = meshes[i];
+            m.firstInstance = 0;
+            if (m.instances.empty())
+                continue;
+            m.firstInstance = (unsigned int)matrices.size();
+            for (size_t k = 0; k < m.instances.size(); ++k)
+                matrices.push_back(Mesh::instanceTransform(m.instances[k]));
+        }
+        if (!geometry.instanceVbo)
+            geometry.instanceVbo = glBackend().createBuffer();
+        glBackend().bufferData(geometry.instanceVbo, GL_ARRAY_BUFFER, matrices.size() * sizeof(Mesh::InstanceTransform), &matrices[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(geometry.instanceVbo, GpuMemory::DRAW_BUFFERS, matrices.size() * sizeof(Mesh::InstanceTransform), directory);
+        Mesh::setupInstanceFormat(geometry.vao, geometry.instanceVbo, 0);
+        glState().bindVertexArray(0);
+        if (matrices.size() > 1)
+            LOG_INFO("[Model] Instancing: " << matrices.size() - 1 << " instances of " << instancedMeshCount() << " meshes");
+    }
+
+    // position stream (attribute 0) of the shared vertex buffer plus the instance matrices, over the same
+    // index buffer: the depth pre-pass fetches 8 of the 20 bytes per vertex
+    void createDepthVao()
+    {
+        glGenVertexArrays(1, &geometry.depthVao);
+        // bound before the direct state access calls: a glGenVertexArrays name is only a VAO once bound
+        glState().bindVertexArray(geometry.depthVao);
+        VertexFormats::setup<PackedPositionFormat>(geometry.depthVao, geometry.vbo, geometry.vertexBytes());
+        glState().bindVertexArray(geometry.depthVao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.ebo);
+        Mesh::setupInstanceFormat(geometry.depthVao, geometry.instanceVbo, 0);
+        glState().bindVertexArray(0);
+    }
+
+    size_t instancedMeshCount() const
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            n += !meshes[i].instances.empty();
+        return n;
+    }
+
+    // the model's vertex and index ranges (geometry.indexSize set) from the GeometryArena, bound as the
+    // array buffer and, with the model's VAO bound, its element buffer
+    void allocateGeometry(size_t vertexCount, size_t indexCount)
+    {
+        geometry.vertices = geometryArena().allocate(GeometryArena::VERTICES, vertexCount, GL_ARRAY_BUFFER, directory);
+        geometry.indices = geometryArena().allocate(GeometryArena::indexKind(geometry.indexSize), indexCount, GL_ELEMENT_ARRAY_BUFFER, directory);
+        geometry.vbo = geometry.vertices.buffer;
+        geometry.ebo = geometry.indices.buffer;
+    }
+
+    // packs all mesh vertices/indices into one range of the arena's VBO/EBO pages (written mesh by mesh
+    // as PackedVertex) and points every mesh at its range
+    void uploadGeometry()
+    {
+        FrameTrace::Scope trace("upload geometry");
+        size_t totalVertices = 0, totalIndices = 0;
+        bool shortIndices = true;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            totalVertices += meshes[i].vertices.size();
+            shortIndices = shortIndices && meshes[i].vertices.size() <= 65536;
+            totalIndices += meshes[i].indices.size();
+            for (size_t l = 0; l < meshes[i].lodIndices.size(); ++l)
+                totalIndices += meshes[i].lodIndices[l].size();
+        }
+        if (totalVertices > 0) {
+            geometry.positionOffset = quantizationMin;
+            geometry.positionScale = VertexPacking::quantizationExtent(quantizationMin, quantizationMax);
+        }
+        glGenVertexArrays(1, &geometry.vao);
+        glState().bindVertexArray(geometry.vao);
+        // indices are relative to each mesh's baseVertex, so small meshes fit 16 bits in any model size
+        geometry.indexSize = shortIndices ? 2 : 4;
+        allocateGeometry(totalVertices, totalIndices);
+        // pack/copy straight into mapped buffer memory (no staging vector, no glBufferSubData copy); only
+        // the model's ranges are invalidated, other models may share the pages. If the driver refuses the
+        // mapping, fall back to staging + glBufferSubData.
+        const GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        PackedVertex *vertexDst = totalVertices ? (PackedVertex *)glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)geometry.vertexBytes(), totalVertices * sizeof(PackedVertex), mapFlags) : NULL;
+        unsigned char *indexDst = totalIndices ? (unsigned char *)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)geometry.indexBytes(), totalIndices * geometry.indexSize, mapFlags) : NULL;
+        const size_t indexBase = geometry.indices.offset;
+        size_t vertexCursor = 0, indexCursor = 0;
+        std::vector<PackedVertex> packed;
+        std::vector<unsigned short> narrowed;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &m = meshes[i];
+            PackedVertex *out = vertexDst;
+            if (out) {
+                out += vertexCursor;
+            } else {
+                packed.resize(m.vertices.size());
+                out = packed.empty() ? NULL : &packed[0];
+            }
+            for (size_t v = 0; v < m.vertices.size(); ++v)
+                out[v] = VertexPacking::pack(m.vertices, v, geometry.positionOffset, geometry.positionScale);
+            if (!vertexDst && !packed.empty())
+                glBufferSubData(GL_ARRAY_BUFFER, geometry.vertexBytes() + vertexCursor * sizeof(PackedVertex), packed.size() * sizeof(PackedVertex), &packed[0]);
+            m.VAO = geometry.vao;
+            m.baseVertex = (int)vertexCursor;
+            m.firstIndex = (unsigned int)(indexBase + indexCursor);
+            m.indexCount = (unsigned int)m.indices.size();
+            m.indexSize = geometry.indexSize;
+            m.lods.clear();
+            // the full index list, then its simplified levels right behind it
+            for (size_t l = 0; l <= m.lodIndices.size(); ++l) {
+                const vector<unsigned int> &src = l == 0 ? m.indices : m.lodIndices[l - 1];
+                if (!src.empty()) {
+                    const void *data = &src[0];
+                    if (shortIndices) {
+                        narrowed.assign(src.begin(), src.end());
+                        data = &narrowed[0];
+                    }
+                    const size_t bytes = src.size() * geometry.indexSize;
+                    if (indexDst)
+                        memcpy(indexDst + indexCursor * geometry.indexSize, data, bytes);
+                    else
+                        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, geometry.indexBytes() + indexCursor * geometry.indexSize, bytes, data);
+                }
+                Mesh::Lod lod = {(unsigned int)(indexBase + indexCursor), (unsigned int)src.size(), l == 0 ? 0.0f : m.lodErrors[l - 1]};
+                m.lods.push_back(lod);
+                indexCursor += src.size();
+            }
+            vertexCursor += m.vertices.size();
+        }
+        bool uploaded = true;
+        if (vertexDst && !glUnmapBuffer(GL_ARRAY_BUFFER)) uploaded = false;
+        if (indexDst && !glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER)) uploaded = false;
+        // GL_FALSE from glUnmapBuffer means the store was lost (display mode change etc.); rare enough to just report
+        if (!uploaded)
+            LOG_WARN("[Model] Geometry buffer contents lost during upload (glUnmapBuffer failed)");
+        Mesh::setupVertexFormat(geometry.vao, geometry.vbo, geometry.vertexBytes());
+        uploadSkinStream(totalVertices);
+        glState().bindVertexArray(0);
+        uploadInstances();
+        LOG_INFO("[Model] Packed " << meshes.size() << " meshes into one buffer range: vertices=" << totalVertices << " indices=" << totalIndices
+                 << (shortIndices ? " (16-bit)" : "")
+                 << " (" << (totalVertices * sizeof(PackedVertex)) / 1024 << " KiB vertex data)");
+    }
+
+    // second vertex stream of a model with skinned meshes, parallel to the packed vertices (zero for the
+    // unskinned ones, which never read it), in the shared VAO
+    void uploadSkinStream(size_t totalVertices)
     {
-        loadModel(path);
+        bool skinned = false;
+        for (size_t i = 0; i < meshes.size() && !skinned; ++i)
+            skinned = meshes[i].skin >= 0 && meshes[i].vertices.hasSkin();
+        if (!skinned)
+            return;
+        std::vector<SkinVertex> stream;
+        stream.reserve(totalVertices);
+        for (size_t i = 0; i < meshes.size(); ++i)
+            for (size_t v = 0; v < meshes[i].vertices.size(); ++v)
+                stream.push_back(VertexPacking::packSkin(meshes[i].vertices, v));
+        geometry.skinVbo = glBackend().createBuffer();
+        glBackend().bufferStorage(geometry.skinVbo, GL_ARRAY_BUFFER, stream.size() * sizeof(SkinVertex), &stream[0]);
+        gpuMemory().trackBuffer(geometry.skinVbo, GpuMemory::MODEL_GEOMETRY, stream.size() * sizeof(SkinVertex), directory);
+        Mesh::setupSkinFormat(geometry.vao, geometry.skinVbo);
     }
 
-    // draws the model: opaque first, then transparent (simple two-pass for correct blending)
-    // Accepts the current model matrix (world transform) and the camera position for sorting transparent meshes.
-    void Draw(Shader &shader, const glm::mat4 &modelMatrix, const glm::vec3 &cameraPos)
+    // sorts `order` by shader variant and material, splits it into buckets of identical material state and
+    // records the multi-draw arguments of each mesh (and its indirect command, with `commands`)
+    void buildBuckets(std::vector<unsigned int> &order, std::vector<DrawBucket> &buckets, std::vector<GLsizei> &counts,
+                      std::vector<const void *> &offsets, std::vector<GLint> &baseVertices, std::vector<DrawElementsIndirectCommand> *commands)
     {
-        // first draw opaque meshes
-        for (unsigned int i = 0; i < meshes.size(); ++i) {
-            if (!meshes[i].transparent)
-                meshes[i].Draw(shader);
-        }
-        // collect transparent meshes and sort back-to-front based on camera distance
-        struct TransparentEntry { size_t idx; float dist; };
-        std::vector<TransparentEntry> transparentList;
-        for (size_t i = 0; i < meshes.size(); ++i) {
-            if (meshes[i].transparent) {
-                // world-space centroid
-                glm::vec4 wc = modelMatrix * glm::vec4(meshes[i].centroid, 1.0f);
-                float d = glm::length(glm::vec3(wc) - cameraPos);
-                transparentList.push_back({i, d});
+        // sorted by shader variant first, so each variant's program is bound once per model
+        const vector<Mesh> &ms = meshes;
+        const bool byVariant = shaderVariants();
+        std::stable_sort(order.begin(), order.end(), [&ms, byVariant](unsigned int a, unsigned int b) {
+            if (byVariant && ms[a].shaderFeatures() != ms[b].shaderFeatures())
+                return ms[a].shaderFeatures() < ms[b].shaderFeatures();
+            return ms[a].materialKey() < ms[b].materialKey();
+        });
+        buckets.clear();
+        counts.resize(order.size());
+        offsets.resize(order.size());
+        baseVertices.resize(order.size());
+        if (commands)
+            commands->resize(order.size());
+        for (unsigned int k = 0; k < order.size(); ++k) {
+            const Mesh &m = meshes[order[k]];
+            // with a material table only the bound arrays split buckets; the rest is looked up per vertex
+            const Mesh &head = meshes[order[buckets.empty() ? 0 : buckets.back().first]];
+            const bool sameVariant = !byVariant || m.shaderFeatures() == head.shaderFeatures();
+            if (buckets.empty() || !sameVariant || !(materials.ready() ? m.materialKey() == head.materialKey() : m.sameMaterial(head))) {
+                DrawBucket bucket = {k, 0, m.shaderFeatures()};
+                buckets.push_back(bucket);
+            }
+            buckets.back().count++;
+            counts[k] = (GLsizei)m.indexCount;
+            offsets[k] = m.indexOffset();
+            baseVertices[k] = m.baseVertex;
+            if (commands) {
+                DrawElementsIndirectCommand cmd = {m.indexCount, 1, m.firstIndex, m.baseVertex, 0};
+                (*commands)[k] = cmd;
             }
         }
-        // sort descending (furthest first)
-        std::sort(transparentList.begin(), transparentList.end(), [](const TransparentEntry &a, const TransparentEntry &b){ return a.dist > b.dist; });
-        // then draw transparent meshes (disable depth writes so blending works)
-        glDepthMask(GL_FALSE);
-        for (auto &e : transparentList) {
-            meshes[e.idx].Draw(shader);
+    }
+
+    void buildDrawList()
+    {
+        opaqueOrder.clear();
+        transparentMeshes.clear();
+        weightedOrder.clear();
+        instancedMeshes.clear();
+        const bool weighted = weightedBlendEnabled();
+        for (unsigned int i = 0; i < meshes.size(); ++i) {
+            // instanced glass keeps the sorted path, which handles instances
+            if (meshes[i].transparent && weighted && meshes[i].weightedBlend && meshes[i].instances.empty())
+                weightedOrder.push_back(i);
+            else if (meshes[i].transparent)
+                transparentMeshes.push_back(i);
+            else if (!meshes[i].instances.empty())
+                instancedMeshes.push_back(i);
+            else
+                opaqueOrder.push_back(i);
         }
-        glDepthMask(GL_TRUE);
+        buildBuckets(opaqueOrder, opaqueBuckets, drawCounts, drawOffsets, drawBaseVertices, &drawCommands);
+        buildBuckets(weightedOrder, weightedBuckets, weightedCounts, weightedOffsets, weightedBaseVertices, 0);
+        // hidden parts keep their slots, drawing nothing
+        meshHidden.resize(meshes.size(), 0);
+        for (size_t k = 0; k < opaqueOrder.size(); ++k)
+            if (meshHidden[opaqueOrder[k]])
+                drawCounts[k] = (GLsizei)(drawCommands[k].count = 0);
+        for (size_t k = 0; k < weightedOrder.size(); ++k)
+            if (meshHidden[weightedOrder[k]])
+                weightedCounts[k] = 0;
+        if (GLAD_GL_VERSION_4_3 && !drawCommands.empty()) {
+            if (!geometry.indirectBuffer)
+                glGenBuffers(1, &geometry.indirectBuffer);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, geometry.indirectBuffer);
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, drawCommands.size() * sizeof(DrawElementsIndirectCommand), &drawCommands[0], GL_STATIC_DRAW);
+            gpuMemory().trackBuffer(geometry.indirectBuffer, GpuMemory::DRAW_BUFFERS, drawCommands.size() * sizeof(DrawElementsIndirectCommand), directory);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+        BoundsBatch meshBounds;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            meshBounds.add(meshes[i].boundsMin, meshes[i].boundsMax, meshes[i].boundingRadius);
+        meshTree.build(meshBounds);
+        meshVisible.assign(meshes.size(), 1);
+        meshLod.assign(meshes.size(), 0);
+        meshletTarget.release();
+        drawSlot.assign(meshes.size(), -1);
+        for (unsigned int k = 0; k < opaqueOrder.size(); ++k)
+            drawSlot[opaqueOrder[k]] = (int)k;
+        LOG_INFO("[Model] Draw list: " << opaqueOrder.size() << " opaque meshes in " << opaqueBuckets.size() << " material buckets, "
+                 << instancedMeshes.size() << " instanced, " << transparentMeshes.size() << " transparent"
+                 << (weighted ? ", " + std::to_string(weightedOrder.size()) + " weighted blended" : std::string()));
     }
-    
-private:
+
     struct UVTransform {
         glm::vec2 offset = glm::vec2(0.0f);
         glm::vec2 scale = glm::vec2(1.0f);
@@ -78,8 +2731,14 @@ private:
 
     // per-image transforms parsed from glTF (indexed by image index)
     std::vector<UVTransform> imageTransforms;
-    // images URIs from the glTF (indexed by image index)
+    // images URIs from the glTF (indexed by image index); embedded images get the name they're mounted under
     std::vector<std::string> imageUris;
+    // VirtualFileSystem paths of the embedded images this model mounted, unmounted with the model
+    std::vector<std::string> embeddedImages;
+    // a KHR_texture_basisu texture had no image this build can decode (warned once per model)
+    bool basisuWarned = false;
+    // Assimp material texture path -> index in textures_loaded
+    std::unordered_map<std::string, size_t> loadedTextureIndex;
     // per-material references to image indices
     struct MatRefs { int baseColor = -1; int normal = -1; int metallicRoughness = -1; };
     std::vector<MatRefs> materialImageRefs;
@@ -88,16 +2747,77 @@ private:
     // per-material metallic/roughness factors from glTF
     std::vector<float> materialMetallicFactors;
     std::vector<float> materialRoughnessFactors;
+    // per-material glTF alphaMode (Mesh::AlphaMode) and alphaCutoff
+    std::vector<int> materialAlphaModes;
+    std::vector<float> materialAlphaCutoffs;
+    // per-material KHR_materials_clearcoat factor and roughness (factor 0 = none)
+    std::vector<glm::vec2> materialClearcoats;
+    // per-material KHR_materials_transmission factor (0 = none)
+    std::vector<float> materialTransmissions;
+    // per-material KHR_materials_specular colour (rgb) and factor (a)
+    std::vector<glm::vec4> materialSpeculars;
+    // per-material occlusionTexture strength when it's the metallicRoughness texture (ORM), else 0
+    std::vector<float> materialPackedOcclusions;
+    // KHR_materials_variants names (native glTF path); Mesh::variantMaterials index them
+    std::vector<std::string> materialVariantNames;
+    // per-material MaterialOverrides tag (see tagMaterials)
+    std::vector<unsigned int> materialTags;
+
+    // tags the glTF materials named `names` for MaterialOverrides: by name, or (no name matching) the
+    // clearcoated ones without a base colour texture, which is how car paint is usually authored
+    void tagMaterials(const std::vector<std::string> &names)
+    {
+        materialTags.assign(names.size(), MaterialOverrides::NONE);
+        bool named = false;
+        for (size_t mi = 0; mi < names.size(); ++mi) {
+            materialTags[mi] = MaterialOverrides::tagOf(names[mi]);
+            named = named || materialTags[mi] != MaterialOverrides::NONE;
+        }
+        for (size_t mi = 0; !named && mi < names.size() && mi < materialClearcoats.size(); ++mi)
+            if (materialClearcoats[mi].x > 0.0f && materialImageRefs[mi].baseColor < 0)
+                materialTags[mi] = MaterialOverrides::PAINT;
+        const size_t paint = (size_t)std::count(materialTags.begin(), materialTags.end(), (unsigned int)MaterialOverrides::PAINT);
+        if (paint)
+            LOG_INFO("[Model] " << paint << " paint materials" << (named ? "" : " (clearcoated, untextured)"));
+    }
+
+    static Mesh::AlphaMode parseAlphaMode(const std::string &mode)
+    {
+        if (mode == "MASK") return Mesh::ALPHA_MASK;
+        if (mode == "BLEND") return Mesh::ALPHA_BLEND;
+        return Mesh::ALPHA_OPAQUE;
+    }
     // loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
     void loadModel(string const &path)
     {
+        FrameTrace::Scope trace("load model", path);
+        nodes.clear();
+        // glTF goes through the native tinygltf path (one parse, geometry straight from the .bin);
+        // MODEL_LOADER=assimp forces Assimp, which is also the fallback if the native load fails
+        if (useNativeGltf(path)) {
+            if (loadGltf(path))
+                return;
+            LOG_WARN("[Model] Native glTF load failed, falling back to Assimp: " << path);
+            meshes.clear();
+            nodes.clear();
+            imageUris.clear(); imageTransforms.clear(); materialImageRefs.clear();
+            materialBaseColorFactors.clear(); materialMetallicFactors.clear(); materialRoughnessFactors.clear();
+            materialAlphaModes.clear(); materialAlphaCutoffs.clear(); materialClearcoats.clear(); materialTransmissions.clear();
+            materialSpeculars.clear(); materialPackedOcclusions.clear(); materialVariantNames.clear(); materialTags.clear();
+        }
         // read file via ASSIMP
         Assimp::Importer importer;
-        const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+        // no aiProcess_GenSmoothNormals / aiProcess_CalcTangentSpace: those run over the whole scene, while
+        // convertMesh() only generates normals for meshes without them and tangents for normal-mapped ones.
+        // No aiProcess_JoinIdenticalVertices either (it would weld before those normals are generated and
+        // smooth faceted meshes; optimizeMesh welds afterwards), nor aiProcess_OptimizeMeshes /
+        // aiProcess_OptimizeGraph, which flatten the node hierarchy animation and instancing follow
+        // (mergeStaticMeshes merges only what's baked)
+        const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
         // check for errors
         if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
         {
-            cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
+            LOG_ERROR("ERROR::ASSIMP:: " << importer.GetErrorString());
             return;
         }
         // retrieve the directory path of the filepath
@@ -105,10 +2825,24 @@ private:
 
         // Try to parse the glTF JSON to extract image URIs and KHR_texture_transform info
         try {
-            std::ifstream in(path);
-            if (in.good()) {
+            // the text of a .gltf, or the JSON chunk of a .glb, parsed from the mapping
+            FileView document;
+            const char *json = NULL;
+            size_t jsonSize = 0;
+            if (fileSystem().open(path, document)) {
+                const unsigned char *bin = NULL;
+                size_t binSize = 0;
+                if (!GltfLoader::glbChunks(document.data(), document.size(), json, jsonSize, bin, binSize)) {
+                    json = (const char *)document.data();
+                    jsonSize = document.size();
+                }
+            }
+            if (json) {
                 nlohmann::json j;
-                in >> j;
+                {
+                    StartupTimings::Scope startup("glTF JSON");
+                    j = nlohmann::json::parse(json, json + jsonSize);
+                }
                 // images
                 if (j.contains("images") && j["images"].is_array()) {
                     for (auto &img : j["images"]) {
@@ -126,8 +2860,36 @@ private:
                     materialBaseColorFactors.resize(j["materials"].size(), glm::vec4(1.0f));
                     materialMetallicFactors.resize(j["materials"].size(), 1.0f);
                     materialRoughnessFactors.resize(j["materials"].size(), 1.0f);
+                    materialAlphaModes.resize(j["materials"].size(), Mesh::ALPHA_OPAQUE);
+                    materialAlphaCutoffs.resize(j["materials"].size(), 0.5f);
+                    materialClearcoats.resize(j["materials"].size(), glm::vec2(0.0f));
+                    materialTransmissions.resize(j["materials"].size(), 0.0f);
+                    materialSpeculars.resize(j["materials"].size(), glm::vec4(1.0f));
+                    materialPackedOcclusions.resize(j["materials"].size(), 0.0f);
                     for (size_t mi = 0; mi < j["materials"].size(); ++mi) {
                         auto &mat = j["materials"][mi];
+                        if (mat.contains("alphaMode") && mat["alphaMode"].is_string())
+                            materialAlphaModes[mi] = parseAlphaMode(mat["alphaMode"].get<std::string>());
+                        if (mat.contains("alphaCutoff") && mat["alphaCutoff"].is_number())
+                            materialAlphaCutoffs[mi] = mat["alphaCutoff"].get<float>();
+                        if (mat.contains("extensions") && mat["extensions"].contains("KHR_materials_clearcoat")) {
+                            auto &c = mat["extensions"]["KHR_materials_clearcoat"];
+                            materialClearcoats[mi] = glm::vec2(c.value("clearcoatFactor", 0.0f), c.value("clearcoatRoughnessFactor", 0.0f));
+                        }
+                        if (mat.contains("extensions") && mat["extensions"].contains("KHR_materials_transmission"))
+                            materialTransmissions[mi] = mat["extensions"]["KHR_materials_transmission"].value("transmissionFactor", 0.0f);
+                        if (mat.contains("extensions") && mat["extensions"].contains("KHR_materials_specular")) {
+                            auto &s = mat["extensions"]["KHR_materials_specular"];
+                            materialSpeculars[mi].a = s.value("specularFactor", 1.0f);
+                            if (s.contains("specularColorFactor") && s["specularColorFactor"].is_array() && s["specularColorFactor"].size() >= 3)
+                                for (int c = 0; c < 3; ++c)
+                                    materialSpeculars[mi][c] = s["specularColorFactor"][c].get<float>();
+                        }
+                        // occlusion sharing the metallicRoughness texture (ORM) comes with its fetch
+                        if (mat.contains("occlusionTexture") && mat["occlusionTexture"].contains("index") && mat.contains("pbrMetallicRoughness")
+                            && mat["pbrMetallicRoughness"].contains("metallicRoughnessTexture")
+                            && mat["pbrMetallicRoughness"]["metallicRoughnessTexture"].value("index", -1) == mat["occlusionTexture"]["index"].get<int>())
+                            materialPackedOcclusions[mi] = mat["occlusionTexture"].value("strength", 1.0f);
                         // baseColorFactor
                         if (mat.contains("pbrMetallicRoughness") && mat["pbrMetallicRoughness"].contains("baseColorFactor")) {
                             auto &f = mat["pbrMetallicRoughness"]["baseColorFactor"];
@@ -195,14 +2957,639 @@ private:
                             }
                         }
                     }
+                    std::vector<std::string> names;
+                    for (size_t mi = 0; mi < j["materials"].size(); ++mi)
+                        names.push_back(j["materials"][mi].value("name", std::string()));
+                    tagMaterials(names);
                 }
             }
         } catch (...) {
             // Ignore JSON parsing errors; loader will still proceed using Assimp's data
         }
+        prefetchMaterialImages();
+
+        // process ASSIMP's root node recursively (one Mesh per node reference, so reserve for all of them)
+        meshes.reserve(meshes.size() + countMeshInstances(scene->mRootNode));
+        vector<NodeMesh> refs;
+        processNode(scene->mRootNode, -1, refs);
+        dedupeMeshRefs(refs, [scene](const NodeMesh &ref, vector<unsigned char> &key) {
+            const aiMesh *mesh = scene->mMeshes[ref.mesh];
+            const unsigned int header[4] = {mesh->mMaterialIndex, mesh->mNumVertices, mesh->HasNormals() ? 1u : 0u, mesh->mTextureCoords[0] ? 1u : 0u};
+            appendKey(key, header, sizeof(header));
+            if (mesh->mNumVertices == 0)
+                return true;
+            appendKey(key, mesh->mVertices, mesh->mNumVertices * sizeof(aiVector3D));
+            if (mesh->HasNormals())
+                appendKey(key, mesh->mNormals, mesh->mNumVertices * sizeof(aiVector3D));
+            if (mesh->mTextureCoords[0])
+                appendKey(key, mesh->mTextureCoords[0], mesh->mNumVertices * sizeof(aiVector3D));
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                const aiFace &face = mesh->mFaces[f];
+                appendKey(key, &face.mNumIndices, sizeof(face.mNumIndices));
+                appendKey(key, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+            }
+            return true;
+        });
+        buildNodeMeshes(refs, [this, scene](const NodeMesh &ref, const glm::mat4 &transform, MeshGeometry &geometry) {
+            const aiMesh *mesh = scene->mMeshes[ref.mesh];
+            return convertMesh(mesh, transform, hasNormalMap(scene->mMaterials[mesh->mMaterialIndex], (int)mesh->mMaterialIndex), geometry);
+        }, [&](const NodeMesh &ref, MeshGeometry &&geometry) {
+            buildRegion = regionOf(ref.node, scene->mMeshes[ref.mesh]->mName.C_Str());
+            meshes.push_back(processMesh(scene->mMeshes[ref.mesh], scene, std::move(geometry)));
+            meshes.back().region = buildRegion;
+            meshes.back().partNode = ref.part;
+            buildRegion = MeshRegions::EXTERIOR;
+        });
+    }
+
+    static bool useNativeGltf(const string &path)
+    {
+        const char *loader = std::getenv("MODEL_LOADER");
+        if (loader && std::string(loader) == "assimp")
+            return false;
+        string ext = path.substr(path.find_last_of('.') + 1);
+        for (auto &c : ext) c = (char)std::tolower(c);
+        return ext == "gltf" || ext == "glb";
+    }
+
+    // native glTF loader: tinygltf parses the document and reads the buffers once; materials fill the same
+    // tables the Assimp path builds from its JSON side-parse, so buildMesh is shared
+    bool loadGltf(string const &path)
+    {
+        FrameTrace::Scope trace("parse glTF", path);
+        tinygltf::TinyGLTF loader;
+        // textures are loaded by TextureLoader from the image URIs; don't decode them here (data: URIs are
+        // kept undecoded, having no file to be read from later)
+        GltfLoader::DataUriImages dataUriImages;
+        loader.SetImageLoader(GltfLoader::keepDataUriImages, &dataUriImages);
+        loader.SetFsCallbacks(GltfLoader::mappedFsCallbacks());
+        tinygltf::Model gltf;
+        std::string err, warn;
+        // the file is read once, from its mapping: tinygltf parses the JSON (a .glb's JSON chunk), the
+        // geometry reads a .glb's BIN chunk in place and embedded images are mounted as ranges of the file
+        FileView file;
+        const char *json = NULL;
+        size_t jsonSize = 0;
+        const unsigned char *binChunk = NULL;
+        size_t binSize = 0;
+        const bool binary = GltfLoader::isGlbPath(path);
+        if (!fileSystem().open(path, file) || (binary && !GltfLoader::glbChunks(file.data(), file.size(), json, jsonSize, binChunk, binSize))) {
+            LOG_ERROR("ERROR::GLTF:: cannot read '" << path << "'" << (binary ? " as a .glb" : ""));
+            return false;
+        }
+        if (!binary) {
+            json = (const char *)file.data();
+            jsonSize = file.size();
+        }
+        // meshopt-compressed files keep the uncompressed fallback out of tinygltf's reach (see
+        // stubMeshoptFallbacks); a .glb is then rebuilt around the rewritten JSON, copying its small BIN chunk
+        std::vector<uint64_t> fallbackSizes;
+        const std::string stubbedJson = GltfLoader::stubMeshoptFallbacks(json, jsonSize, fallbackSizes);
+        const size_t slash = path.find_last_of("/\\");
+        const string baseDir = slash == string::npos ? string() : path.substr(0, slash);
+        bool ok;
+        {
+            StartupTimings::Scope startup("glTF JSON");
+            if (binary && !stubbedJson.empty()) {
+                const std::vector<unsigned char> glb = GltfLoader::buildGlb(stubbedJson, binChunk, binSize);
+                ok = loader.LoadBinaryFromMemory(&gltf, &err, &warn, glb.data(), (unsigned int)glb.size(), baseDir);
+            } else if (binary)
+                ok = loader.LoadBinaryFromMemory(&gltf, &err, &warn, file.data(), (unsigned int)file.size(), baseDir);
+            else if (!stubbedJson.empty())
+                ok = loader.LoadASCIIFromString(&gltf, &err, &warn, stubbedJson.data(), (unsigned int)stubbedJson.size(), baseDir);
+            else
+                ok = loader.LoadASCIIFromString(&gltf, &err, &warn, json, (unsigned int)jsonSize, baseDir);
+        }
+        if (!warn.empty())
+            LOG_WARN("WARNING::GLTF:: " << warn);
+        if (ok && std::find(gltf.extensionsRequired.begin(), gltf.extensionsRequired.end(), "KHR_draco_mesh_compression") != gltf.extensionsRequired.end()) {
+            err = "KHR_draco_mesh_compression is not supported (re-export with EXT_meshopt_compression, e.g. gltfpack -cc)";
+            ok = false;
+        }
+        if (!ok) {
+            LOG_ERROR("ERROR::GLTF:: " << err);
+            return false;
+        }
+        directory = path.substr(0, path.find_last_of('/'));
+        // tinygltf copies the BIN chunk into the first buffer; the accessors read the mapping instead, so
+        // that copy goes right away
+        GltfLoader::BufferSpans buffers = GltfLoader::bufferSpans(gltf, binChunk, binSize);
+        if (binChunk && !gltf.buffers.empty() && gltf.buffers[0].uri.empty())
+            std::vector<unsigned char>().swap(gltf.buffers[0].data);
+        std::vector<std::vector<unsigned char> > decodedBuffers;
+        const int decodedViews = GltfLoader::decodeMeshoptViews(gltf, fallbackSizes, buffers, decodedBuffers, err);
+        if (decodedViews < 0) {
+            LOG_ERROR("ERROR::GLTF:: " << err);
+            return false;
+        }
+        if (decodedViews > 0)
+            LOG_INFO("[Model] Decoded " << decodedViews << " meshopt-compressed buffer views");
+        // KHR_mesh_quantization: integer attributes decode straight into the vertex streams (readFloatAccessor),
+        // which pack to PackedVertex like any others. UVs are stored as half floats there, so unnormalized
+        // integer ones (dequantized only by a texture transform) would lose their precision
+        if (std::find(gltf.extensionsUsed.begin(), gltf.extensionsUsed.end(), "KHR_mesh_quantization") != gltf.extensionsUsed.end()) {
+            size_t quantized = 0, wideUVs = 0;
+            for (size_t m = 0; m < gltf.meshes.size(); ++m)
+                for (size_t p = 0; p < gltf.meshes[m].primitives.size(); ++p)
+                    for (std::map<std::string, int>::const_iterator a = gltf.meshes[m].primitives[p].attributes.begin();
+                         a != gltf.meshes[m].primitives[p].attributes.end(); ++a) {
+                        if (!GltfLoader::quantizedAccessor(gltf, a->second))
+                            continue;
+                        ++quantized;
+                        const tinygltf::Accessor &acc = gltf.accessors[a->second];
+                        if (a->first == "TEXCOORD_0" && !acc.normalized && acc.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+                            ++wideUVs;
+                    }
+            LOG_INFO("[Model] KHR_mesh_quantization: " << quantized << " quantized attribute streams");
+            if (wideUVs)
+                LOG_WARN("[Model] " << wideUVs << " primitives have unnormalized 16-bit UVs, which lose precision as half floats "
+                         "(re-export with normalized UVs, e.g. gltfpack's default)");
+        }
+
+        // images and materials
+        for (size_t i = 0; i < gltf.images.size(); ++i) {
+            imageUris.push_back(gltf.images[i].uri);
+            imageTransforms.push_back(UVTransform());
+        }
+        mountEmbeddedImages(gltf, path, binChunk ? (uint64_t)(binChunk - file.data()) : 0, dataUriImages);
+        materialImageRefs.resize(gltf.materials.size());
+        materialBaseColorFactors.resize(gltf.materials.size(), glm::vec4(1.0f));
+        materialMetallicFactors.resize(gltf.materials.size(), 1.0f);
+        materialRoughnessFactors.resize(gltf.materials.size(), 1.0f);
+        materialAlphaModes.resize(gltf.materials.size(), Mesh::ALPHA_OPAQUE);
+        materialAlphaCutoffs.resize(gltf.materials.size(), 0.5f);
+        materialClearcoats.resize(gltf.materials.size(), glm::vec2(0.0f));
+        materialTransmissions.resize(gltf.materials.size(), 0.0f);
+        materialSpeculars.resize(gltf.materials.size(), glm::vec4(1.0f));
+        materialPackedOcclusions.resize(gltf.materials.size(), 0.0f);
+        for (size_t mi = 0; mi < gltf.materials.size(); ++mi) {
+            const tinygltf::Material &mat = gltf.materials[mi];
+            materialAlphaModes[mi] = parseAlphaMode(mat.alphaMode);
+            materialAlphaCutoffs[mi] = (float)mat.alphaCutoff;
+            GltfLoader::readClearcoat(mat.extensions, materialClearcoats[mi].x, materialClearcoats[mi].y);
+            GltfLoader::readTransmission(mat.extensions, materialTransmissions[mi]);
+            glm::vec3 specularColor(1.0f);
+            if (GltfLoader::readSpecular(mat.extensions, materialSpeculars[mi].a, specularColor))
+                materialSpeculars[mi] = glm::vec4(specularColor, materialSpeculars[mi].a);
+            const tinygltf::PbrMetallicRoughness &pbr = mat.pbrMetallicRoughness;
+            if (pbr.baseColorFactor.size() >= 4)
+                materialBaseColorFactors[mi] = glm::vec4((float)pbr.baseColorFactor[0], (float)pbr.baseColorFactor[1], (float)pbr.baseColorFactor[2], (float)pbr.baseColorFactor[3]);
+            materialMetallicFactors[mi] = (float)pbr.metallicFactor;
+            materialRoughnessFactors[mi] = (float)pbr.roughnessFactor;
+            materialImageRefs[mi].baseColor = gltfImageIndex(gltf, pbr.baseColorTexture.index, pbr.baseColorTexture.extensions);
+            materialImageRefs[mi].metallicRoughness = gltfImageIndex(gltf, pbr.metallicRoughnessTexture.index, pbr.metallicRoughnessTexture.extensions);
+            materialImageRefs[mi].normal = gltfImageIndex(gltf, mat.normalTexture.index, mat.normalTexture.extensions);
+            // occlusion sharing the metallicRoughness texture (same texture and UV set: ORM) comes with its
+            // fetch; an occlusion texture of its own would cost another one and isn't sampled
+            if (mat.occlusionTexture.index >= 0 && mat.occlusionTexture.index == pbr.metallicRoughnessTexture.index
+                && mat.occlusionTexture.texCoord == pbr.metallicRoughnessTexture.texCoord)
+                materialPackedOcclusions[mi] = (float)mat.occlusionTexture.strength;
+        }
+        std::vector<std::string> materialNames;
+        for (size_t mi = 0; mi < gltf.materials.size(); ++mi)
+            materialNames.push_back(gltf.materials[mi].name);
+        tagMaterials(materialNames);
+
+        prefetchMaterialImages();
+        materialVariantNames = GltfLoader::readVariantNames(gltf);
+        if (!materialVariantNames.empty())
+            LOG_INFO("[Model] " << materialVariantNames.size() << " material variants (KHR_materials_variants)");
+
+        // geometry: walk the default scene, one Mesh per triangle primitive
+        int sceneIndex = gltf.defaultScene >= 0 ? gltf.defaultScene : 0;
+        if (sceneIndex >= (int)gltf.scenes.size()) {
+            LOG_ERROR("ERROR::GLTF:: no scene in " << path);
+            return false;
+        }
+        const tinygltf::Scene &scene = gltf.scenes[sceneIndex];
+        size_t primitiveCount = 0;
+        for (size_t i = 0; i < scene.nodes.size(); ++i)
+            primitiveCount += countGltfPrimitives(gltf, scene.nodes[i]);
+        meshes.reserve(meshes.size() + primitiveCount);
+        vector<NodeMesh> refs;
+        vector<int> nodeIds(gltf.nodes.size(), -1);
+        for (size_t i = 0; i < scene.nodes.size(); ++i)
+            processGltfNode(gltf, scene.nodes[i], -1, refs, nodeIds);
+        // ANIMATION=1: meshes below animated nodes stay in node space (drawn instanced) to follow them;
+        // skinned meshes are baked in bind pose and blended on the GPU (their node transform doesn't apply)
+        if (NodeAnimation::enabledByEnv()) {
+            animation.load(gltf, buffers, nodeIds, nodes);
+            if (animation.hasSkins() && !shaderVariants())
+                LOG_WARN("[Anim] SHADER_VARIANTS=0: skinned meshes are drawn in bind pose");
+        }
+        const vector<unsigned char> moving = animation.movingNodes(nodes);
+        for (size_t r = 0; r < refs.size(); ++r) {
+            refs[r].moving = moving[refs[r].node] != 0;
+            if (refs[r].skin >= 0 && (refs[r].skin >= (int)animation.skinList().size() || animation.skinList()[refs[r].skin].paletteBase == NodeAnimation::NO_PALETTE))
+                refs[r].skin = -1;
+            if (refs[r].skin >= 0)
+                refs[r].transform = glm::mat4(1.0f);
+        }
+        const size_t variantCount = materialVariantNames.size();
+        dedupeMeshRefs(refs, [&gltf, &buffers, variantCount](const NodeMesh &ref, vector<unsigned char> &key) {
+            // the accessors loadPrimitive() reads, decoded, so copies in different layouts still match
+            static const char *const attributes[] = {"POSITION", "NORMAL", "TEXCOORD_0", "TANGENT"};
+            static const int components[] = {3, 3, 2, 4};
+            const tinygltf::Primitive &prim = gltf.meshes[ref.mesh].primitives[ref.primitive];
+            appendKey(key, &prim.material, sizeof(prim.material));
+            const vector<int> variants = GltfLoader::readVariantMappings(prim, variantCount);
+            const uint64_t mapped = variants.size();
+            appendKey(key, &mapped, sizeof(mapped));
+            if (!variants.empty())
+                appendKey(key, &variants[0], variants.size() * sizeof(int));
+            vector<float> values;
+            for (int a = 0; a < 4; ++a) {
+                std::map<std::string, int>::const_iterator it = prim.attributes.find(attributes[a]);
+                values.clear();
+                if (it != prim.attributes.end() && !GltfLoader::readFloatAccessor(gltf, buffers, it->second, components[a], values))
+                    return false;
+                const uint64_t count = values.size();
+                appendKey(key, &count, sizeof(count));
+                if (!values.empty())
+                    appendKey(key, &values[0], values.size() * sizeof(float));
+            }
+            vector<unsigned int> indices;
+            if (prim.indices >= 0 && !GltfLoader::readIndexAccessor(gltf, buffers, prim.indices, indices))
+                return false;
+            const uint64_t count = prim.indices >= 0 ? indices.size() : ~0ull;
+            appendKey(key, &count, sizeof(count));
+            if (!indices.empty())
+                appendKey(key, &indices[0], indices.size() * sizeof(unsigned int));
+            return true;
+        });
+        buildNodeMeshes(refs, [this, &gltf, &buffers](const NodeMesh &ref, const glm::mat4 &transform, MeshGeometry &geometry) {
+            const tinygltf::Mesh &mesh = gltf.meshes[ref.mesh];
+            const tinygltf::Primitive &prim = mesh.primitives[ref.primitive];
+            std::string error;
+            if (!GltfLoader::loadPrimitive(gltf, buffers, prim, transform, hasNormalMap(NULL, prim.material), geometry.vertices, geometry.indices, error)) {
+                LOG_WARN("[Model] Skipping primitive in mesh '" << mesh.name << "': " << error);
+                return false;
+            }
+            if (ref.skin >= 0) {
+                const NodeAnimation::Skin &skin = animation.skinList()[ref.skin];
+                GltfLoader::loadSkinAttributes(gltf, buffers, prim, skin.paletteBase, skin.joints.size(), geometry.vertices);
+            }
+            return true;
+        }, [&](const NodeMesh &ref, MeshGeometry &&geometry) {
+            const tinygltf::Mesh &mesh = gltf.meshes[ref.mesh];
+            const tinygltf::Primitive &prim = mesh.primitives[ref.primitive];
+            LOG_DEBUG("[Model] Processing mesh '" << mesh.name << "' (materialIndex=" << prim.material << ")");
+            const bool skinned = geometry.vertices.hasSkin();
+            buildRegion = regionOf(ref.node, mesh.name);
+            meshes.push_back(buildMesh(std::move(geometry.vertices), std::move(geometry.indices), vector<Texture>(), prim.material));
+            meshes.back().variantMaterials = GltfLoader::readVariantMappings(prim, materialVariantNames.size());
+            meshes.back().region = buildRegion;
+            meshes.back().partNode = ref.part;
+            buildRegion = MeshRegions::EXTERIOR;
+            if (skinned) {
+                Mesh &m = meshes.back();
+                m.localBoundsMin = m.boundsMin;
+                m.localBoundsMax = m.boundsMax;
+                m.localCentroid = m.centroid;
+                m.setSkin(ref.skin);
+            }
+        });
+        refreshSkinnedBounds();
+        return true;
+    }
+
+    // image index referenced by a texture slot (-1 = none); records its KHR_texture_transform
+    // gives the images without a file of their own (in a bufferView, or a data: URI) a VirtualFileSystem path
+    // next to the model, "<model file>#image<N>", so TextureLoader requests, caches and decodes them like
+    // any other: bufferView images as a range of the file their buffer lives in (the .glb's BIN chunk or a
+    // .bin), read in place from its mapping; data: URIs as the bytes tinygltf decoded. `binOffset` is the
+    // file offset of a .glb's BIN chunk (0 for a .gltf).
+    void mountEmbeddedImages(const tinygltf::Model &gltf, const string &path, uint64_t binOffset, const GltfLoader::DataUriImages &dataUriImages)
+    {
+        const string file = path.substr(path.find_last_of('/') + 1);
+        for (size_t i = 0; i < gltf.images.size(); ++i) {
+            if (!imageUris[i].empty())
+                continue;
+            const tinygltf::Image &image = gltf.images[i];
+            const string name = file + "#image" + std::to_string(i);
+            const string mountPath = this->directory + '/' + name;
+            if (image.bufferView >= 0 && image.bufferView < (int)gltf.bufferViews.size()) {
+                const tinygltf::BufferView &view = gltf.bufferViews[image.bufferView];
+                const tinygltf::Buffer &buffer = gltf.buffers[view.buffer];
+                std::string bufferFile;
+                if (buffer.uri.empty()) {
+                    if (!binOffset)
+                        continue;
+                    fileSystem().mountRange(mountPath, path, binOffset + view.byteOffset, view.byteLength);
+                } else if (!buffer.uri.empty() && !tinygltf::IsDataURI(buffer.uri) && tinygltf::URIDecode(buffer.uri, &bufferFile, NULL)) {
+                    fileSystem().mountRange(mountPath, this->directory + '/' + bufferFile, view.byteOffset, view.byteLength);
+                } else if (view.byteOffset + view.byteLength <= buffer.data.size()) {
+                    // a data: URI buffer exists only decoded; the image is copied out of it
+                    fileSystem().mountMemory(mountPath, std::make_shared<const vector<unsigned char> >(
+                        buffer.data.begin() + view.byteOffset, buffer.data.begin() + view.byteOffset + view.byteLength));
+                } else
+                    continue;
+            } else {
+                GltfLoader::DataUriImages::const_iterator it = dataUriImages.find((int)i);
+                if (it == dataUriImages.end())
+                    continue;
+                fileSystem().mountMemory(mountPath, it->second);
+            }
+            imageUris[i] = name;
+            embeddedImages.push_back(mountPath);
+        }
+    }
+
+    int gltfImageIndex(const tinygltf::Model &gltf, int textureIndex, const tinygltf::ExtensionMap &extensions)
+    {
+        if (textureIndex < 0 || textureIndex >= (int)gltf.textures.size())
+            return -1;
+        const tinygltf::Texture &texture = gltf.textures[textureIndex];
+        int image = GltfLoader::textureSource(texture, ktx2Supported());
+        if (image < 0 && texture.extensions.count("KHR_texture_basisu") && !basisuWarned) {
+            LOG_WARN("[Model] KHR_texture_basisu textures without a fallback image need the Basis Universal transcoder (HAS_BASISU)");
+            basisuWarned = true;
+        }
+        if (image < 0 || image >= (int)imageTransforms.size())
+            return -1;
+        UVTransform ut;
+        if (GltfLoader::readTextureTransform(extensions, ut.offset, ut.scale, ut.rotation))
+            imageTransforms[image] = ut;
+        return image;
+    }
+
+    static size_t countGltfPrimitives(const tinygltf::Model &gltf, int nodeIndex)
+    {
+        if (nodeIndex < 0 || nodeIndex >= (int)gltf.nodes.size())
+            return 0;
+        const tinygltf::Node &node = gltf.nodes[nodeIndex];
+        size_t n = 0;
+        if (node.mesh >= 0 && node.mesh < (int)gltf.meshes.size())
+            n += gltf.meshes[node.mesh].primitives.size();
+        for (size_t i = 0; i < node.children.size(); ++i)
+            n += countGltfPrimitives(gltf, node.children[i]);
+        return n;
+    }
+
+    // one mesh (or glTF primitive) referenced by a node, with the node's world transform
+    struct NodeMesh
+    {
+        int mesh;
+        int primitive;
+        int node;
+        glm::mat4 transform;
+        // glTF skin of the node (-1 = none); whether the node, or one above it, is animated
+        int skin;
+        bool moving;
+        // hierarchy node of the configurable part the node belongs to (partNodeOf), -1 = none
+        int part;
+    };
+
+    // what groups references to one mesh: the same source mesh (primitive) in the same configurable part
+    typedef std::pair<std::pair<int, int>, int> RefKey;
+    static RefKey refKey(const NodeMesh &ref) { return std::make_pair(std::make_pair(ref.mesh, ref.primitive), ref.part); }
+
+    // one mesh's converted vertices and indices, between the two halves of buildNodeMeshes()
+    struct MeshGeometry
+    {
+        VertexStreams vertices;
+        vector<unsigned int> indices;
+        bool valid = false;
+    };
+
+    // collects the triangle primitives below `nodeIndex` with their world transforms; `nodeIds` maps the
+    // glTF nodes visited to their hierarchy nodes
+    void processGltfNode(const tinygltf::Model &gltf, int nodeIndex, int parentNode, vector<NodeMesh> &refs, vector<int> &nodeIds)
+    {
+        if (nodeIndex < 0 || nodeIndex >= (int)gltf.nodes.size() || nodeIds[nodeIndex] >= 0)
+            return;
+        const tinygltf::Node &node = gltf.nodes[nodeIndex];
+        const int self = nodes.add(parentNode, GltfLoader::nodeLocalMatrix(node), node.name);
+        nodeIds[nodeIndex] = self;
+        const glm::mat4 nodeTransform = nodes.world(self);
+        if (node.mesh >= 0 && node.mesh < (int)gltf.meshes.size()) {
+            const tinygltf::Mesh &mesh = gltf.meshes[node.mesh];
+            for (size_t p = 0; p < mesh.primitives.size(); ++p) {
+                const tinygltf::Primitive &prim = mesh.primitives[p];
+                if (prim.mode != TINYGLTF_MODE_TRIANGLES && prim.mode != -1) {
+                    LOG_WARN("[Model] Skipping non-triangle primitive in mesh '" << mesh.name << "' (mode=" << prim.mode << ")");
+                    continue;
+                }
+                NodeMesh ref = {node.mesh, (int)p, self, nodeTransform, node.skin, false, partNodeOf(self)};
+                refs.push_back(ref);
+            }
+        }
+        for (size_t i = 0; i < node.children.size(); ++i)
+            processGltfNode(gltf, node.children[i], self, refs, nodeIds);
+    }
+
+    // appends `size` bytes at `data` to a content key (dedupeMeshRefs)
+    static void appendKey(vector<unsigned char> &key, const void *data, size_t size)
+    {
+        const unsigned char *bytes = (const unsigned char *)data;
+        key.insert(key.end(), bytes, bytes + size);
+    }
+
+    // content-hash deduplication of the scene's mesh data: `source(ref, key)` appends everything that
+    // decides the mesh built for `ref` (source vertices, indices, material) to `key`, or returns false to
+    // leave it alone. Distinct meshes (or primitives) with equal keys are pointed at the first of them, so
+    // buildNodeMeshes() converts and uploads that geometry once and draws every copy - the wheels, lug nuts
+    // and mirrored parts exported as separate meshes - as an instance with its node transform. Keys are
+    // hashed on the job system; equal hashes are compared byte for byte before two meshes are joined.
+    // Skinned meshes (always baked) stay as they are, and so does everything with MESH_INSTANCING=0.
+    template <typename Source>
+    void dedupeMeshRefs(vector<NodeMesh> &refs, Source source)
+    {
+        if (!meshInstancingEnabled() || refs.size() < 2)
+            return;
+        // the distinct meshes in order of first use; any skinned reference keeps its mesh out
+        std::map<RefKey, size_t> indexOf;
+        vector<size_t> firstRef;
+        vector<unsigned char> skinned;
+        for (size_t r = 0; r < refs.size(); ++r) {
+            std::pair<std::map<RefKey, size_t>::iterator, bool> it = indexOf.insert(std::make_pair(refKey(refs[r]), firstRef.size()));
+            if (it.second) {
+                firstRef.push_back(r);
+                skinned.push_back(0);
+            }
+            if (refs[r].skin >= 0)
+                skinned[it.first->second] = 1;
+        }
+        if (firstRef.size() < 2)
+            return;
+        struct Key
+        {
+            uint64_t hash;
+            size_t size;
+            bool valid;
+        };
+        vector<Key> keys(firstRef.size());
+        ThreadPool::shared().parallelFor(firstRef.size(), 4, [&](size_t begin, size_t end) {
+            vector<unsigned char> bytes;
+            for (size_t i = begin; i < end; ++i) {
+                bytes.clear();
+                keys[i].valid = !skinned[i] && source(refs[firstRef[i]], bytes);
+                // never shared across configurable parts
+                appendKey(bytes, &refs[firstRef[i]].part, sizeof(int));
+                keys[i].size = bytes.size();
+                keys[i].hash = keys[i].valid ? CookedFormat::hashBytes(bytes.empty() ? NULL : &bytes[0], bytes.size()) : 0;
+            }
+        }, "hash meshes");
+        // each mesh's first identical predecessor (or itself)
+        std::multimap<uint64_t, size_t> byHash;
+        vector<size_t> target(firstRef.size());
+        vector<unsigned char> a, b;
+        size_t shared = 0;
+        for (size_t i = 0; i < firstRef.size(); ++i) {
+            target[i] = i;
+            if (!keys[i].valid)
+                continue;
+            typedef std::multimap<uint64_t, size_t>::const_iterator Iter;
+            std::pair<Iter, Iter> range = byHash.equal_range(keys[i].hash);
+            for (Iter it = range.first; it != range.second && target[i] == i; ++it) {
+                const size_t j = it->second;
+                if (keys[j].size != keys[i].size)
+                    continue;
+                a.clear();
+                b.clear();
+                if (refs[firstRef[j]].part == refs[firstRef[i]].part && source(refs[firstRef[j]], a) && source(refs[firstRef[i]], b) && a == b)
+                    target[i] = j;
+            }
+            if (target[i] == i)
+                byHash.insert(std::make_pair(keys[i].hash, i));
+            else
+                ++shared;
+        }
+        if (!shared)
+            return;
+        for (size_t r = 0; r < refs.size(); ++r) {
+            const NodeMesh &first = refs[firstRef[target[indexOf[refKey(refs[r])]]]];
+            refs[r].mesh = first.mesh;
+            refs[r].primitive = first.primitive;
+        }
+        LOG_INFO("[Model] Dedup: " << shared << " of " << firstRef.size() << " meshes repeat another's data, drawn as its instances");
+    }
+
+    // builds the meshes referenced by the scene nodes in two halves: `convert(ref, transform, geometry)` fills
+    // in one mesh's vertices and indices (false skips it) and runs for all of them at once on the job system,
+    // so it may only read the parsed file; `finish(ref, geometry)` then appends the Mesh, one after another
+    // in node order (materials, texture requests). Meshes referenced by several nodes are built once in their
+    // own space and drawn instanced with the node transforms (MESH_INSTANCING=0 bakes a copy per node
+    // instead); NODE_TRANSFORMS=1 keeps every mesh in its own space that way, following its node, and so do
+    // the meshes below animated nodes (ANIMATION=1). Skinned meshes are always baked, in bind pose.
+    template <typename Convert, typename Finish>
+    void buildNodeMeshes(const vector<NodeMesh> &refs, Convert convert, Finish finish)
+    {
+        // references grouped per mesh, in order of first use
+        std::map<RefKey, size_t> groupOf;
+        vector<vector<size_t> > groups;
+        for (size_t r = 0; r < refs.size(); ++r) {
+            std::pair<std::map<RefKey, size_t>::iterator, bool> it = groupOf.insert(std::make_pair(refKey(refs[r]), groups.size()));
+            if (it.second)
+                groups.push_back(vector<size_t>());
+            groups[it.first->second].push_back(r);
+        }
+        // the meshes to build, in order: a baked copy per reference, or one instanced mesh per group
+        struct Item
+        {
+            size_t ref;
+            glm::mat4 transform;
+            int group; // instanced: the group whose transforms it takes, otherwise -1
+        };
+        vector<Item> items;
+        items.reserve(refs.size());
+        for (size_t g = 0; g < groups.size(); ++g) {
+            const vector<size_t> &group = groups[g];
+            // skinned meshes are always baked (in bind pose); meshes on animated nodes always follow them
+            bool moving = false, skinned = false;
+            for (size_t k = 0; k < group.size(); ++k) {
+                moving = moving || refs[group[k]].moving;
+                skinned = skinned || refs[group[k]].skin >= 0;
+            }
+            if (skinned || (!keepNodeTransforms() && !moving && (group.size() < 2 || !meshInstancingEnabled()))) {
+                for (size_t k = 0; k < group.size(); ++k)
+                    items.push_back(Item{group[k], refs[group[k]].transform, -1});
+            } else {
+                items.push_back(Item{group[0], glm::mat4(1.0f), (int)g});
+            }
+        }
+        vector<MeshGeometry> geometry(items.size());
+        ThreadPool::shared().parallelFor(items.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                geometry[i].valid = convert(refs[items[i].ref], items[i].transform, geometry[i]);
+        }, "convert meshes");
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t before = meshes.size();
+            if (geometry[i].valid)
+                finish(refs[items[i].ref], std::move(geometry[i]));
+            if (items[i].group < 0 || meshes.size() == before)
+                continue;
+            const vector<size_t> &group = groups[items[i].group];
+            vector<glm::mat4> transforms;
+            vector<int> nodeIds;
+            for (size_t k = 0; k < group.size(); ++k) {
+                transforms.push_back(refs[group[k]].transform);
+                nodeIds.push_back(refs[group[k]].node);
+            }
+            setInstances(meshes.back(), transforms, nodeIds);
+        }
+    }
+
+    // makes `mesh` (built in its own space) an instanced mesh following `nodeIds`; its bounds become the
+    // union over `transforms`
+    static void setInstances(Mesh &mesh, const vector<glm::mat4> &transforms, const vector<int> &nodeIds)
+    {
+        mesh.instances = transforms;
+        mesh.instanceNodes = nodeIds;
+        mesh.localBoundsMin = mesh.boundsMin;
+        mesh.localBoundsMax = mesh.boundsMax;
+        mesh.localCentroid = mesh.centroid;
+        refreshInstanceBounds(mesh);
+    }
+
+    // model-space bounds of the skinned meshes: their bind-pose box under every palette slot of their skin
+    // (a blend of those slots keeps each vertex inside the union). False if the model has none.
+    bool refreshSkinnedBounds()
+    {
+        if (!animation.hasSkins())
+            return false;
+        const vector<glm::mat4> &palette = animation.palette();
+        bool any = false;
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &mesh = meshes[i];
+            if (mesh.skin < 0)
+                continue;
+            const NodeAnimation::Skin &skin = animation.skinList()[mesh.skin];
+            for (size_t j = 0; j < skin.joints.size(); ++j) {
+                glm::vec3 jointMin, jointMax;
+                GeometryKernels::transformBounds(palette[skin.paletteBase + j], mesh.localBoundsMin, mesh.localBoundsMax, jointMin, jointMax);
+                mesh.boundsMin = j == 0 ? jointMin : glm::min(mesh.boundsMin, jointMin);
+                mesh.boundsMax = j == 0 ? jointMax : glm::max(mesh.boundsMax, jointMax);
+            }
+            mesh.centroid = 0.5f * (mesh.boundsMin + mesh.boundsMax);
+            mesh.boundingRadius = 0.5f * glm::length(mesh.boundsMax - mesh.boundsMin);
+            any = true;
+        }
+        return any;
+    }
+
+    // model-space bounds of an instanced mesh from its local bounds under every instance matrix
+    static void refreshInstanceBounds(Mesh &mesh)
+    {
+        glm::vec3 centroid(0.0f);
+        for (size_t k = 0; k < mesh.instances.size(); ++k) {
+            glm::vec3 instanceMin, instanceMax;
+            GeometryKernels::transformBounds(mesh.instances[k], mesh.localBoundsMin, mesh.localBoundsMax, instanceMin, instanceMax);
+            mesh.boundsMin = k == 0 ? instanceMin : glm::min(mesh.boundsMin, instanceMin);
+            mesh.boundsMax = k == 0 ? instanceMax : glm::max(mesh.boundsMax, instanceMax);
+            centroid += glm::vec3(mesh.instances[k] * glm::vec4(mesh.localCentroid, 1.0f));
+        }
+        mesh.centroid = centroid / (float)mesh.instances.size();
+        mesh.boundingRadius = 0.5f * glm::length(mesh.boundsMax - mesh.boundsMin);
+    }
 
-        // process ASSIMP's root node recursively
-        processNode(scene->mRootNode, scene, glm::mat4(1.0f));
+    // number of meshes processNode will create below `node` (a mesh referenced by several nodes counts once per node)
+    static size_t countMeshInstances(const aiNode *node)
+    {
+        size_t n = node->mNumMeshes;
+        for (unsigned int i = 0; i < node->mNumChildren; i++)
+            n += countMeshInstances(node->mChildren[i]);
+        return n;
     }
 
     // processes a node in a recursive fashion. Processes each individual mesh located at the node and repeats this process on its children nodes (if any).
@@ -217,79 +3604,66 @@ private:
         return out;
     }
 
-    // processes a node in a recursive fashion. Applies the node transform to child meshes.
-    void processNode(aiNode *node, const aiScene *scene, const glm::mat4 &parentTransform)
+    // processes a node in a recursive fashion. Collects the node's meshes with its world transform.
+    void processNode(aiNode *node, int parentNode, vector<NodeMesh> &refs)
     {
-        // compute this node's transform (Assimp stores transforms as column-major 4x4)
-        glm::mat4 nodeTransform = parentTransform * aiMatToGlm(node->mTransformation);
+        // this node's transform (Assimp stores transforms as column-major 4x4) under its parent's
+        const int self = nodes.add(parentNode, aiMatToGlm(node->mTransformation), node->mName.C_Str());
+        const glm::mat4 nodeTransform = nodes.world(self);
 
-        // process each mesh located at the current node
+        // reference each mesh located at the current node
         for(unsigned int i = 0; i < node->mNumMeshes; i++)
         {
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            meshes.push_back(processMesh(mesh, scene, nodeTransform));
+            NodeMesh ref = {(int)node->mMeshes[i], 0, self, nodeTransform, -1, false, partNodeOf(self)};
+            refs.push_back(ref);
         }
         // after we've processed all of the meshes (if any) we then recursively process each of the children nodes
         for(unsigned int i = 0; i < node->mNumChildren; i++)
         {
-            processNode(node->mChildren[i], scene, nodeTransform);
+            processNode(node->mChildren[i], self, refs);
         }
     }
 
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene, const glm::mat4 &nodeTransform)
+    // whether a material samples a normal map, the only reason to import a tangent frame: a glTF normalTexture
+    // (materialImageRefs) or, for the Assimp path, a height/normals texture (processMesh() loads HEIGHT ones
+    // as normal maps). `material` may be NULL. Reads only state filled before the meshes are built.
+    bool hasNormalMap(const aiMaterial *material, int materialIndex) const
+    {
+        if (materialIndex >= 0 && materialIndex < (int)materialImageRefs.size() && materialImageRefs[materialIndex].normal >= 0)
+            return true;
+        return material && (material->GetTextureCount(aiTextureType_HEIGHT) > 0 || material->GetTextureCount(aiTextureType_NORMALS) > 0);
+    }
+
+    // the geometry half of processMesh(): vertices under `nodeTransform` and the face indices, into buffers
+    // sized up front. Touches nothing but `out`, so buildNodeMeshes() runs it on the job system. Normals are
+    // generated only for meshes without them, tangents only with `wantTangents`.
+    static bool convertMesh(const aiMesh *mesh, const glm::mat4 &nodeTransform, bool wantTangents, MeshGeometry &out)
     {
         // data to fill
-        vector<Vertex> vertices;
-        vector<unsigned int> indices;
-        vector<Texture> textures;
+        VertexStreams &vertices = out.vertices;
+        vector<unsigned int> &indices = out.indices;
+        wantTangents = wantTangents && mesh->mTextureCoords[0];
+        vertices.resize(mesh->mNumVertices, wantTangents);
+        indices.reserve((size_t)mesh->mNumFaces * 3);
 
-        // walk through each of the mesh's vertices
-        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+        // normals take the inverse-transpose of the node transform (3x3), once per mesh
+        const glm::mat3 normalMat = glm::transpose(glm::inverse(glm::mat3(nodeTransform)));
+        const size_t count = mesh->mNumVertices;
+        if (count > 0)
         {
-            Vertex vertex;
-            glm::vec3 vector; // we declare a placeholder vector since assimp uses its own vector class that doesn't directly convert to glm's vec3 class so we transfer the data to this placeholder glm::vec3 first.
-            // positions (apply node transform)
-            vector.x = mesh->mVertices[i].x;
-            vector.y = mesh->mVertices[i].y;
-            vector.z = mesh->mVertices[i].z;
-            glm::vec4 transformedPos = nodeTransform * glm::vec4(vector, 1.0f);
-            vertex.Position = glm::vec3(transformedPos);
-            // normals
-            // prepare a normal matrix for transforming normals/tangents/bitangents
-            glm::mat3 normalMat = glm::mat3(1.0f);
+            // positions (apply node transform) and directions, a whole stream at a time
+            static_assert(sizeof(aiVector3D) == 3 * sizeof(float), "Assimp built with double precision");
+            GeometryKernels::transformPoints(nodeTransform, &mesh->mVertices[0].x, sizeof(aiVector3D), &vertices.positions[0].x, sizeof(glm::vec3), count);
             if (mesh->HasNormals())
-            {
-                vector.x = mesh->mNormals[i].x;
-                vector.y = mesh->mNormals[i].y;
-                vector.z = mesh->mNormals[i].z;
-                // normal should be transformed by inverse-transpose of the model matrix (3x3)
-                normalMat = glm::transpose(glm::inverse(glm::mat3(nodeTransform)));
-                vertex.Normal = glm::normalize(normalMat * vector);
-            }
-            // texture coordinates
-            if(mesh->mTextureCoords[0]) // does the mesh contain texture coordinates?
-            {
-                glm::vec2 vec;
-                // a vertex can contain up to 8 different texture coordinates. We thus make the assumption that we won't 
-                // use models where a vertex can have multiple texture coordinates so we always take the first set (0).
-                vec.x = mesh->mTextureCoords[0][i].x; 
-                vec.y = mesh->mTextureCoords[0][i].y;
-                vertex.TexCoords = vec;
-                // tangent
-                vector.x = mesh->mTangents[i].x;
-                vector.y = mesh->mTangents[i].y;
-                vector.z = mesh->mTangents[i].z;
-                vertex.Tangent = glm::normalize(normalMat * vector);
-                // bitangent
-                vector.x = mesh->mBitangents[i].x;
-                vector.y = mesh->mBitangents[i].y;
-                vector.z = mesh->mBitangents[i].z;
-                vertex.Bitangent = glm::normalize(normalMat * vector);
-            }
-            else
-                vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-
-            vertices.push_back(vertex);
+                GeometryKernels::transformDirections(normalMat, &mesh->mNormals[0].x, sizeof(aiVector3D), &vertices.normals[0].x, sizeof(glm::vec3), count, true);
+        }
+        // texture coordinates (left zero by resize() without them)
+        if(mesh->mTextureCoords[0]) // does the mesh contain texture coordinates?
+        {
+            // a vertex can contain up to 8 different texture coordinates. We thus make the assumption that we won't 
+            // use models where a vertex can have multiple texture coordinates so we always take the first set (0).
+            for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+                vertices.texCoords[i] = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
         }
         // now wak through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
         for(unsigned int i = 0; i < mesh->mNumFaces; i++)
@@ -299,10 +3673,80 @@ private:
             for(unsigned int j = 0; j < face.mNumIndices; j++)
                 indices.push_back(face.mIndices[j]);        
         }
+        // what aiProcess_GenSmoothNormals / aiProcess_CalcTangentSpace did for every mesh, now only where needed.
+        // Normals come out of the transformed positions, so they're already in model space. Tangents come out
+        // of the flipped UVs, which turns the bitangent around: w is negated back to glTF UV space, same as
+        // the native path's frames
+        if (count > 0 && !mesh->HasNormals())
+            GltfLoader::generateNormals(vertices, indices);
+        if (count > 0 && wantTangents)
+        {
+            GltfLoader::generateTangents(vertices, indices);
+            for (size_t i = 0; i < count; ++i)
+                vertices.tangents[i].w = -vertices.tangents[i].w;
+        }
+        return true;
+    }
+
+    // the material half, serially in mesh order: texture requests and buildMesh()
+    // LAZY_REGIONS=1: the region of a mesh at hierarchy node `node` from the node's, the mesh's and then the
+    // ancestors' names (exterior otherwise)
+    unsigned int regionOf(int node, const string &meshName) const
+    {
+        if (!lazyRegions || node < 0)
+            return MeshRegions::EXTERIOR;
+        vector<string> names(1, nodes.name(node));
+        names.push_back(meshName);
+        for (int n = nodes.parent(node); n >= 0; n = nodes.parent(n))
+            names.push_back(nodes.name(n));
+        return MeshRegions::classify(names);
+    }
+
+    // textureLoader.request() for the mesh being built: deferred for a cabin or underside mesh, and undeferred
+    // again when an exterior mesh asks for the same image
+    unsigned int requestTexture(const string &path, bool gamma, TexturePlaceholder placeholder = TexturePlaceholder::White)
+    {
+        const bool deferred = buildRegion != MeshRegions::EXTERIOR;
+        const unsigned int ticket = textureLoader.request(path, gamma, placeholder, deferred);
+        if (deferred)
+            regions[buildRegion].tickets.push_back(ticket);
+        return ticket;
+    }
+
+    // GL thread, before the tickets become texture names: keeps each region's still deferred tickets and
+    // gathers its meshes' bounds for requestRegions()
+    void armRegions()
+    {
+        if (!lazyRegions)
+            return;
+        size_t meshCount[MeshRegions::COUNT] = {0, 0, 0};
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            const Mesh &m = meshes[i];
+            RegionTextures &region = regions[m.region];
+            region.boundsMin = meshCount[m.region] ? glm::min(region.boundsMin, m.boundsMin) : m.boundsMin;
+            region.boundsMax = meshCount[m.region] ? glm::max(region.boundsMax, m.boundsMax) : m.boundsMax;
+            ++meshCount[m.region];
+        }
+        for (unsigned int r = MeshRegions::INTERIOR; r < MeshRegions::COUNT; ++r) {
+            vector<unsigned int> &tickets = regions[r].tickets;
+            std::sort(tickets.begin(), tickets.end());
+            tickets.erase(std::unique(tickets.begin(), tickets.end()), tickets.end());
+            const TextureLoader &tl = textureLoader;
+            tickets.erase(std::remove_if(tickets.begin(), tickets.end(), [&tl](unsigned int t) { return !tl.deferred(t); }), tickets.end());
+        }
+        regionsArmed = true;
+        LOG_INFO("[Model] Lazy regions: " << meshCount[MeshRegions::INTERIOR] << " interior meshes (" << regions[MeshRegions::INTERIOR].tickets.size()
+                 << " textures deferred), " << meshCount[MeshRegions::UNDERSIDE] << " underside meshes ("
+                 << regions[MeshRegions::UNDERSIDE].tickets.size() << " textures deferred)");
+    }
+
+    Mesh processMesh(aiMesh *mesh, const aiScene *scene, MeshGeometry &&geometry)
+    {
+        vector<Texture> textures;
     // process materials
     aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];    
     // Debug: print mesh and material info to help trace texture bindings
-    std::cout << "[Model] Processing mesh '" << mesh->mName.C_Str() << "' (materialIndex=" << mesh->mMaterialIndex << ")" << std::endl;
+    LOG_DEBUG("[Model] Processing mesh '" << mesh->mName.C_Str() << "' (materialIndex=" << mesh->mMaterialIndex << ")");
         // we assume a convention for sampler names in the shaders. Each diffuse texture should be named
         // as 'texture_diffuseN' where N is a sequential number ranging from 1 to MAX_SAMPLER_NUMBER. 
         // Same applies to other texture as the following list summarizes:
@@ -311,26 +3755,47 @@ private:
         // normal: texture_normalN
 
     // 1. diffuse maps
-    vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
+    vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, Texture::DIFFUSE);
     textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
         // 2. specular maps
-        vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
+        vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, Texture::SPECULAR);
         textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
         // 3. normal maps
-        std::vector<Texture> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
+        std::vector<Texture> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, Texture::NORMAL);
         textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
         // 4. height maps
-        std::vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
+        std::vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, Texture::HEIGHT);
         textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
         
+        return buildMesh(std::move(geometry.vertices), std::move(geometry.indices), std::move(textures), (int)mesh->mMaterialIndex);
+    }
+
+    // starts reading the glTF material textures (VirtualFileSystem::prefetch): buildMesh requests them one
+    // mesh at a time, after each mesh's geometry work, which the reads then overlap
+    void prefetchMaterialImages() const
+    {
+        vector<string> paths;
+        for (size_t m = 0; m < materialImageRefs.size(); ++m) {
+            const int refs[3] = {materialImageRefs[m].baseColor, materialImageRefs[m].normal, materialImageRefs[m].metallicRoughness};
+            for (int r = 0; r < 3; ++r)
+                if (refs[r] >= 0 && refs[r] < (int)imageUris.size() && !imageUris[refs[r]].empty() && imageUris[refs[r]].compare(0, 5, "data:") != 0)
+                    paths.push_back(this->directory + '/' + imageUris[refs[r]]);
+        }
+        TextureCache::instance().prefetch(paths);
+    }
+
+    // finishes a mesh from either loader: loads the glTF material textures (baseColor/normal/metallicRoughness),
+    // applies the material factors and classifies transparency. `materialIndex` indexes the glTF materials (-1 = none).
+    Mesh buildMesh(VertexStreams &&vertices, vector<unsigned int> &&indices, vector<Texture> &&textures, int materialIndex)
+    {
         // Also, ensure textures specified directly in glTF JSON (baseColor/normal/metallicRoughness) are loaded
         glm::vec4 bcFactor = glm::vec4(1.0f);
-        if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)materialBaseColorFactors.size()) {
-            bcFactor = materialBaseColorFactors[mesh->mMaterialIndex];
+        if (materialIndex >= 0 && materialIndex < (int)materialBaseColorFactors.size()) {
+            bcFactor = materialBaseColorFactors[materialIndex];
         }
 
-        if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)materialImageRefs.size()) {
-            MatRefs refs = materialImageRefs[mesh->mMaterialIndex];
+        if (materialIndex >= 0 && materialIndex < (int)materialImageRefs.size()) {
+            MatRefs refs = materialImageRefs[materialIndex];
             // baseColor
             if (refs.baseColor >= 0 && refs.baseColor < (int)imageUris.size()) {
                 std::string uri = imageUris[refs.baseColor];
@@ -339,8 +3804,8 @@ private:
                 if (!found && !uri.empty()) {
                     Texture tex;
                     // baseColor should be gamma-correct
-                    tex.id = TextureFromFile(uri.c_str(), this->directory, true);
-                    tex.type = "texture_diffuse";
+                    tex.id = requestTexture(this->directory + '/' + uri, true);
+                    tex.slot = Texture::DIFFUSE;
                     tex.path = uri;
                     // apply image transform if any
                     if (refs.baseColor >= 0 && refs.baseColor < (int)imageTransforms.size()) {
@@ -359,8 +3824,8 @@ private:
                 if (!found && !uri.empty()) {
                     Texture tex;
                     // normal maps are linear
-                    tex.id = TextureFromFile(uri.c_str(), this->directory, false);
-                    tex.type = "texture_normal";
+                    tex.id = requestTexture(this->directory + '/' + uri, false, TexturePlaceholder::FlatNormal);
+                    tex.slot = Texture::NORMAL;
                     tex.path = uri;
                     if (refs.normal >= 0 && refs.normal < (int)imageTransforms.size()) {
                         tex.uvOffset = imageTransforms[refs.normal].offset;
@@ -378,8 +3843,8 @@ private:
                 if (!found && !uri.empty()) {
                     Texture tex;
                     // metallicRoughness texture is linear (channels are numeric)
-                    tex.id = TextureFromFile(uri.c_str(), this->directory, false);
-                    tex.type = "texture_metallicRoughness";
+                    tex.id = requestTexture(this->directory + '/' + uri, false);
+                    tex.slot = Texture::METALLIC_ROUGHNESS;
                     tex.path = uri;
                     if (refs.metallicRoughness >= 0 && refs.metallicRoughness < (int)imageTransforms.size()) {
                         tex.uvOffset = imageTransforms[refs.metallicRoughness].offset;
@@ -391,38 +3856,278 @@ private:
             }
         }
 
-            // Heuristic: consider mesh transparent if baseColorFactor alpha < 1 or any texture path suggests glass or alpha
-            bool isTransparent = false;
-            if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)materialBaseColorFactors.size()) {
-                if (materialBaseColorFactors[mesh->mMaterialIndex].a < 0.999f) isTransparent = true;
-            }
-            // check texture filenames for keywords like 'glass' or 'alpha'
-            for (auto &t : textures) {
-                std::string p = t.path;
-                // lower-case check
-                for (auto &c : p) c = (char)std::tolower(c);
-                if (p.find("glass") != std::string::npos || p.find("alpha") != std::string::npos || p.find("transp") != std::string::npos) {
-                    isTransparent = true;
-                    break;
-                }
+            // glTF alphaMode (OPAQUE when the material doesn't say, or the file isn't glTF)
+            Mesh::AlphaMode alphaMode = Mesh::ALPHA_OPAQUE;
+            float alphaCutoff = 0.5f;
+            if (materialIndex >= 0 && materialIndex < (int)materialAlphaModes.size()) {
+                alphaMode = (Mesh::AlphaMode)materialAlphaModes[materialIndex];
+                alphaCutoff = materialAlphaCutoffs[materialIndex];
             }
+            const bool isTransparent = alphaMode == Mesh::ALPHA_BLEND;
+            // blended with a uniform tint (factor alpha, or no texture to carry alpha) composites order
+            // independently; alpha from the base colour texture alone (decals) keeps the sorted path
+            bool hasBaseColorTexture = false;
+            for (auto &t : textures)
+                hasBaseColorTexture = hasBaseColorTexture || t.slot == Texture::DIFFUSE;
+            const bool isWeighted = bcFactor.a < 0.999f || !hasBaseColorTexture;
 
-            // compute centroid
-            glm::vec3 centroid(0.0f);
-            for (const auto &v : vertices) centroid += v.Position;
-            if (!vertices.empty()) centroid /= (float)vertices.size();
             float matMetal = 1.0f;
             float matRough = 1.0f;
-            if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)materialMetallicFactors.size()) matMetal = materialMetallicFactors[mesh->mMaterialIndex];
-            if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)materialRoughnessFactors.size()) matRough = materialRoughnessFactors[mesh->mMaterialIndex];
-            Mesh m = Mesh(vertices, indices, textures, bcFactor, isTransparent, matMetal, matRough);
-            m.centroid = centroid;
-            return m;
+            if (materialIndex >= 0 && materialIndex < (int)materialMetallicFactors.size()) matMetal = materialMetallicFactors[materialIndex];
+            if (materialIndex >= 0 && materialIndex < (int)materialRoughnessFactors.size()) matRough = materialRoughnessFactors[materialIndex];
+            // centroid/bounds are computed by the Mesh constructor; optimization, clusters and LODs follow
+            // for all meshes at once in processMeshGeometry()
+            Mesh built(std::move(vertices), std::move(indices), std::move(textures), bcFactor, isTransparent, matMetal, matRough);
+            built.setAlphaMode(alphaMode, alphaCutoff);
+            if (materialIndex >= 0 && materialIndex < (int)materialClearcoats.size())
+                built.setClearcoat(materialClearcoats[materialIndex].x, materialClearcoats[materialIndex].y);
+            if (materialIndex >= 0 && materialIndex < (int)materialTransmissions.size())
+                built.setTransmission(materialTransmissions[materialIndex]);
+            if (materialIndex >= 0 && materialIndex < (int)materialSpeculars.size())
+                built.setSpecular(materialSpeculars[materialIndex].a, glm::vec3(materialSpeculars[materialIndex]));
+            if (materialIndex >= 0 && materialIndex < (int)materialPackedOcclusions.size() && built.metallicRoughnessTexture())
+                built.occlusionStrength = materialPackedOcclusions[materialIndex];
+            if (materialIndex >= 0 && materialIndex < (int)materialTags.size())
+                built.materialTag = materialTags[materialIndex];
+            built.weightedBlend = isTransparent && isWeighted;
+            return built;
+    }
+
+    // mesh indices ordered by `size(i)`, largest first, so the biggest jobs of a parallelFor start first
+    template <class SizeFn>
+    vector<unsigned int> meshesBySize(SizeFn size) const
+    {
+        vector<unsigned int> order(meshes.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = (unsigned int)i;
+        std::stable_sort(order.begin(), order.end(), [&size](unsigned int a, unsigned int b) { return size(a) > size(b); });
+        return order;
+    }
+
+    // buildTriangleBvhs() for a cooked model: positions decoded from the mapped PackedVertex section (the
+    // quantized positions the GPU draws) and indices read in place
+    void buildCookedTriangleBvhs(const unsigned char *base, const CookedFormat::Header &header)
+    {
+        FrameTrace::Scope trace("triangle BVHs");
+        StartupTimings::Scope startup("raycast BVH");
+        triangleTrees.assign(meshes.size(), TriangleBVH());
+        const PackedVertex *packed = (const PackedVertex *)(base + header.vertexOffset);
+        const unsigned char *indexData = base + header.indexOffset;
+        // mesh firstIndex values count from the start of the arena page, the cooked indices from the model's
+        const size_t indexBase = geometry.indices.offset;
+        const vector<unsigned int> order = meshesBySize([this](size_t i) { return (size_t)meshes[i].indexCount; });
+        const bool shadingNormals = TriangleBVH::tracedOnGpu();
+        ThreadPool::shared().parallelFor(order.size(), 1, [&](size_t begin, size_t end) {
+            vector<glm::vec3> positions;
+            vector<uint32_t> normals;
+            for (size_t k = begin; k < end; ++k) {
+                const Mesh &m = meshes[order[k]];
+                if (m.baseVertex < 0 || (uint64_t)m.baseVertex + m.vertexCount > header.vertexCount ||
+                    m.firstIndex < indexBase || (uint64_t)(m.firstIndex - indexBase) + m.indexCount > header.indexCount || m.indexCount < 3)
+                    continue;
+                positions.resize(m.vertexCount);
+                for (unsigned int v = 0; v < m.vertexCount; ++v) {
+                    const uint16_t *p = packed[m.baseVertex + v].Position;
+                    positions[v] = geometry.positionOffset + glm::vec3(p[0], p[1], p[2]) * (1.0f / 65535.0f) * geometry.positionScale;
+                }
+                // the cooked normals are packed already
+                normals.clear();
+                if (shadingNormals)
+                    for (unsigned int v = 0; v < m.vertexCount; ++v) {
+                        const int16_t *n = packed[m.baseVertex + v].NormalTangent;
+                        normals.push_back((uint32_t)(uint16_t)n[0] | (uint32_t)(uint16_t)n[1] << 16);
+                    }
+                const uint32_t *packedNormals = normals.empty() ? NULL : &normals[0];
+                if (geometry.indexSize == 2)
+                    triangleTrees[order[k]].build(&positions[0], positions.size(), (const uint16_t *)indexData + (m.firstIndex - indexBase), m.indexCount,
+                                                  packedNormals);
+                else
+                    triangleTrees[order[k]].build(&positions[0], positions.size(), (const uint32_t *)indexData + (m.firstIndex - indexBase), m.indexCount,
+                                                  packedNormals);
+            }
+        }, "triangle BVH");
+        logTriangleBvhs();
+    }
+
+    void logTriangleBvhs() const
+    {
+        size_t triangles = 0, bytes = 0;
+        for (size_t i = 0; i < triangleTrees.size(); ++i) {
+            triangles += triangleTrees[i].triangleCount();
+            bytes += triangleTrees[i].memoryBytes();
+        }
+        LOG_INFO("[Model] Triangle BVHs: " << triangles << " triangles in " << triangleTrees.size() << " meshes, "
+                 << bytes / (1024 * 1024) << " MiB");
+    }
+
+    // mesh `i`'s tree (once per instance, with the ray taken into the mesh's space) against the nearest hit
+    // so far; true if it found a nearer one, on `instance` (-1 for a baked mesh)
+    bool raycastMesh(unsigned int i, const glm::vec3 &origin, const glm::vec3 &dir, TriangleBVH::Hit &nearest, int &instance) const
+    {
+        if (i >= triangleTrees.size() || triangleTrees[i].empty())
+            return false;
+        const Mesh &m = meshes[i];
+        if (m.instances.empty())
+            return triangleTrees[i].raycast(origin, dir, nearest);
+        bool found = false;
+        for (size_t k = 0; k < m.instances.size(); ++k) {
+            const glm::mat4 toMesh = glm::inverse(m.instances[k]);
+            if (triangleTrees[i].raycast(glm::vec3(toMesh * glm::vec4(origin, 1.0f)), glm::vec3(toMesh * glm::vec4(dir, 0.0f)), nearest)) {
+                instance = (int)k;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // fills the model-space position and normal of `hit` (mesh and instance set) from its tree hit
+    void completeHit(const Ray &ray, const TriangleBVH::Hit &nearest, RayHit &hit) const
+    {
+        hit.triangle = nearest.triangle;
+        hit.t = nearest.t;
+        hit.position = ray.origin + nearest.t * ray.direction;
+        hit.normal = nearest.normal;
+        if (hit.instance >= 0)
+            hit.normal = glm::normalize(Mesh::normalMatrix(meshes[hit.mesh].instances[hit.instance]) * nearest.normal);
+    }
+
+    // the per-mesh geometry work of an import, by far its largest CPU cost, spread over the job system: every
+    // mesh is optimized, clustered and simplified on its own, in place
+    void processMeshGeometry()
+    {
+        FrameTrace::Scope trace("process meshes");
+        vector<CacheStats> stats(meshes.size());
+        ThreadPool::shared().parallelFor(meshes.size(), 1, [this, &stats](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Mesh &m = meshes[i];
+                optimizeMesh(m.vertices, m.indices, stats[i]);
+                // transparent meshes are drawn one by one, sorted, and never reach the cluster path
+                if (!m.transparent)
+                    m.meshlets = MeshOptimizer::buildMeshlets(m.vertices.positions, m.indices);
+                generateLods(m);
+            }
+        }, "mesh geometry");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            cacheStats.missesBefore += stats[i].missesBefore;
+            cacheStats.missesAfter += stats[i].missesAfter;
+            cacheStats.triangles += stats[i].triangles;
+            cacheStats.welded += stats[i].welded;
+        }
+    }
+
+    // vertices of the meshes' CPU geometry, for the import log
+    size_t cpuVertexCount() const
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < meshes.size(); ++i)
+            n += meshes[i].vertices.size();
+        return n;
+    }
+
+    // MESH_MERGE=0 skips this. Exporters split a car into a mesh per node and per primitive, many of them
+    // with the same material (164 meshes for 47 materials is usual). Meshes baked into model space (not
+    // instanced, skinned or blended, whose sort order is per mesh) that share a material all draw the same
+    // way, so each is appended to the first earlier one it matches and the count of draws drops to about
+    // the count of materials. A merged mesh stays within 65536 vertices, keeping 16-bit indices possible;
+    // clusters (buildMeshlets) still cull its parts separately.
+    void mergeStaticMeshes()
+    {
+        if (!meshMergeEnabled() || meshes.size() < 2)
+            return;
+        FrameTrace::Scope trace("merge meshes");
+        vector<Mesh> merged;
+        merged.reserve(meshes.size());
+        vector<size_t> targets; // mergeable meshes kept so far, by index into `merged`
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            Mesh &m = meshes[i];
+            const bool mergeable = m.instances.empty() && m.skin < 0 && !m.transparent && m.hasCpuGeometry();
+            if (mergeable) {
+                bool taken = false;
+                for (size_t k = 0; k < targets.size() && !taken; ++k) {
+                    Mesh &target = merged[targets[k]];
+                    if (target.vertices.size() + m.vertices.size() <= 65536 && sameMaterial(target, m)) {
+                        target.appendGeometry(std::move(m));
+                        taken = true;
+                    }
+                }
+                if (taken)
+                    continue;
+                targets.push_back(merged.size());
+            }
+            merged.push_back(std::move(m));
+        }
+        meshes.swap(merged);
+    }
+
+    // whether two meshes draw with the same material: bound textures (and their UV transforms), factors,
+    // alpha handling and shader features, and the same vertex streams
+    static bool sameMaterial(const Mesh &a, const Mesh &b)
+    {
+        const Texture *ta[3] = {a.diffuseTexture(), a.normalTexture(), a.metallicRoughnessTexture()};
+        const Texture *tb[3] = {b.diffuseTexture(), b.normalTexture(), b.metallicRoughnessTexture()};
+        for (int t = 0; t < 3; ++t) {
+            if (!ta[t] != !tb[t])
+                return false;
+            if (ta[t] && (ta[t]->id != tb[t]->id || ta[t]->uvOffset != tb[t]->uvOffset || ta[t]->uvScale != tb[t]->uvScale ||
+                          ta[t]->uvRotation != tb[t]->uvRotation))
+                return false;
+        }
+        return a.shaderFeatures() == b.shaderFeatures() && a.alphaMode == b.alphaMode && a.alphaCutoff == b.alphaCutoff &&
+               a.baseColorFactor == b.baseColorFactor && a.metallicFactor == b.metallicFactor && a.roughnessFactor == b.roughnessFactor &&
+               a.clearcoatFactor == b.clearcoatFactor && a.clearcoatRoughnessFactor == b.clearcoatRoughnessFactor &&
+               a.transmissionFactor == b.transmissionFactor && a.specularFactor == b.specularFactor &&
+               a.specularColorFactor == b.specularColorFactor && a.occlusionStrength == b.occlusionStrength &&
+               a.weightedBlend == b.weightedBlend && a.vertices.hasTangents() == b.vertices.hasTangents() &&
+               a.vertices.hasSkin() == b.vertices.hasSkin() && a.variantMaterials == b.variantMaterials && a.materialTag == b.materialTag &&
+               a.region == b.region && a.partNode == b.partNode;
+    }
+
+    // MESH_OPTIMIZE=0 skips this. Welds identical vertices, reorders the triangles for the post-transform cache (then hull-first
+    // clusters against overdraw) and the vertices for fetch locality, before anything indexes them.
+    static void optimizeMesh(VertexStreams &vertices, vector<unsigned int> &indices, CacheStats &stats)
+    {
+        if (!meshOptimizeEnabled() || indices.size() < 3 || vertices.empty())
+            return;
+        FrameTrace::Scope trace("optimize mesh");
+        stats.welded += MeshOptimizer::weldVertices(vertices, indices);
+        stats.missesBefore += MeshOptimizer::acmr(indices, vertices.size()) * (indices.size() / 3);
+        MeshOptimizer::optimizeTriangleOrder(indices, vertices.positions);
+        MeshOptimizer::optimizeVertexFetch(vertices, indices);
+        stats.missesAfter += MeshOptimizer::acmr(indices, vertices.size()) * (indices.size() / 3);
+        stats.triangles += indices.size() / 3;
+    }
+
+    // MESH_LODS=0 skips this. Up to three coarser index lists per mesh, each about half the previous one,
+    // with an error budget relative to the mesh size; the chain stops once a level no longer pays for its
+    // indices. Errors accumulate along the chain since each level simplifies the previous one.
+    static void generateLods(Mesh &mesh)
+    {
+        if (!meshLodsEnabled() || mesh.indices.size() < 3 * 64)
+            return;
+        FrameTrace::Scope trace("generate LODs");
+        // an instanced mesh's bounds span its instances by now; the vertices are in its own space
+        const float size = mesh.instances.empty() ? glm::length(mesh.boundsMax - mesh.boundsMin) : glm::length(mesh.localBoundsMax - mesh.localBoundsMin);
+        const float relativeError[3] = {0.01f, 0.03f, 0.08f};
+        const vector<unsigned int> *previous = &mesh.indices;
+        float error = 0.0f;
+        for (int l = 0; l < 3; ++l) {
+            float levelError = 0.0f;
+            const size_t target = previous->size() / 6 * 3;
+            vector<unsigned int> lod = MeshSimplifier::simplify(mesh.vertices.positions, *previous, target, relativeError[l] * size, levelError);
+            if (lod.empty() || lod.size() > previous->size() * 9 / 10)
+                break;
+            error += levelError;
+            if (meshOptimizeEnabled())
+                lod = MeshOptimizer::optimizeVertexCache(lod, mesh.vertices.size());
+            mesh.lodIndices.push_back(std::move(lod));
+            mesh.lodErrors.push_back(error);
+            previous = &mesh.lodIndices.back();
+        }
     }
 
     // checks all material textures of a given type and loads the textures if they're not loaded yet.
     // the required info is returned as a Texture struct.
-    vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName)
+    vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, Texture::Slot slot)
     {
         vector<Texture> textures;
         for(unsigned int i = 0; i < mat->GetTextureCount(type); i++)
@@ -430,28 +4135,31 @@ private:
             aiString str;
             mat->GetTexture(type, i, &str);
             // Debug: report that Assimp returned a texture entry for this material/type
-            std::cout << "[Model]  Mat texture: type=" << typeName << " uri=" << str.C_Str() << std::endl;
+            LOG_DEBUG("[Model]  Mat texture: type=" << Texture::slotName(slot) << " uri=" << str.C_Str());
             // check if texture was loaded before and if so, continue to next iteration: skip loading a new texture
-            bool skip = false;
-            for(unsigned int j = 0; j < textures_loaded.size(); j++)
+            std::unordered_map<string, size_t>::const_iterator loaded = loadedTextureIndex.find(str.C_Str());
+            if(loaded != loadedTextureIndex.end())
             {
-                if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-                {
-                    textures.push_back(textures_loaded[j]);
-                    std::cout << "[Model]   -> Reusing previously loaded texture: " << str.C_Str() << std::endl;
-                    skip = true; // a texture with the same filepath has already been loaded, continue to next one. (optimization)
-                    break;
-                }
+                // a texture with the same filepath has already been loaded, continue to next one. (optimization)
+                textures.push_back(textures_loaded[loaded->second]);
+                // same ticket; undefers it for an exterior mesh, or adds it to this mesh's region
+                const Texture::Slot first = textures_loaded[loaded->second].slot;
+                if (lazyRegions)
+                    requestTexture(this->directory + '/' + str.C_Str(), first == Texture::DIFFUSE,
+                                   first == Texture::NORMAL ? TexturePlaceholder::FlatNormal : TexturePlaceholder::White);
+                LOG_DEBUG("[Model]   -> Reusing previously loaded texture: " << str.C_Str());
             }
-            if(!skip)
+            else
             {   // if texture hasn't been loaded already, load it
                 Texture texture;
                 // treat diffuse / baseColor as gamma (sRGB) textures
-                bool isGamma = (typeName == "texture_diffuse");
-                texture.id = TextureFromFile(str.C_Str(), this->directory, isGamma);
-                texture.type = typeName;
+                bool isGamma = (slot == Texture::DIFFUSE);
+                texture.id = requestTexture(this->directory + '/' + str.C_Str(), isGamma,
+                                            slot == Texture::NORMAL ? TexturePlaceholder::FlatNormal : TexturePlaceholder::White);
+                texture.slot = slot;
                 texture.path = str.C_Str();
                 textures.push_back(texture);
+                loadedTextureIndex[texture.path] = textures_loaded.size();
                 textures_loaded.push_back(texture);  // store it as texture loaded for entire model, to ensure we won't unnecessary load duplicate textures.
             }
         }
@@ -460,67 +4168,18 @@ private:
 };
 
 
+// synchronous load (decode + upload on the calling GL thread); Model batches through TextureLoader instead
 unsigned int TextureFromFile(const char *path, const string &directory, bool gamma)
 {
+    FrameTrace::Scope trace("TextureFromFile", path);
     string filename = string(path);
     filename = directory + '/' + filename;
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-
-    // Quick GL sanity check immediately after generation
-    {
-        GLenum e = glGetError();
-        if (e != GL_NO_ERROR) {
-            std::cerr << "[TextureFromFile][GL ERROR] after glGenTextures for '" << path << "' : 0x" << std::hex << e << std::dec << std::endl;
-        }
-    }
-
-    int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-    if (data)
-    {
-        std::cout << "[TextureFromFile] loading '" << filename << "' -> " << width << "x" << height << " comps=" << nrComponents << " -> id=" << textureID << std::endl;
-        GLenum format = GL_RGB;
-        GLenum internalFormat = GL_RGB;
-        if (nrComponents == 1) {
-            format = GL_RED;
-            internalFormat = GL_RED;
-        }
-        else if (nrComponents == 3) {
-            format = GL_RGB;
-            internalFormat = gamma ? GL_SRGB : GL_RGB;
-        }
-        else if (nrComponents == 4) {
-            format = GL_RGBA;
-            internalFormat = gamma ? GL_SRGB_ALPHA : GL_RGBA;
-        }
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        {
-            GLenum e = glGetError();
-            if (e != GL_NO_ERROR) std::cerr << "[TextureFromFile][GL ERROR] after glBindTexture for '" << path << "' : 0x" << std::hex << e << std::dec << std::endl;
-        }
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        {
-            GLenum e = glGetError();
-            if (e != GL_NO_ERROR) std::cerr << "[TextureFromFile][GL ERROR] after glTexImage2D for '" << path << "' : 0x" << std::hex << e << std::dec << std::endl;
-        }
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-    }
-    else
-    {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
-    }
+    unsigned int textureID = glBackend().createTexture(GL_TEXTURE_2D);
 
+    DecodedImage img = decodeImageFile(filename);
+    buildMipChain(img, gamma, false);
+    uploadDecodedImage(textureID, img, gamma, filename);
     return textureID;
 }
 #endif
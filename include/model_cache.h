@@ -0,0 +1,188 @@
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <async_log.h>
+#include <gpu_memory.h>
+#include <model.h>
+#include <model_loader.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Models a configurator browses through (the "variants" of a scene model, V steps through them), kept
+// resident after they are switched away from so that switching back is instant. Every switch marks its
+// model most recently used; once the cached models hold more than MODEL_CACHE_VRAM_MB (default 1024) of
+// GPU memory or MODEL_CACHE_RAM_MB (default 512) of CPU memory, trim() unloads the least recently used
+// ones that aren't shown or still loading (the scene's own models are not cached, they stay loaded). A
+// model is unloaded whole: releaseGpu() hands its geometry range back to the GeometryArena and its
+// textures back to the TextureCache (deleted there unless another model still uses them). Hits, misses
+// and evictions are counted for report().
+//
+// prefetch() gets the model likely to be asked for next ready ahead of time: it imports (and decodes the
+// textures of) the model on idle workers and keeps it in CPU memory; promote() uploads it once the GPU
+// memory of the cached models plus its geometry fits the VRAM budget, or acquire() when it is asked for.
+class ModelCache
+{
+public:
+    struct Stats
+    {
+        size_t hits = 0;      // acquire() found the model resident
+        size_t misses = 0;    // acquire() had to load it
+        size_t evictions = 0; // models trim() unloaded
+        size_t prefetches = 0;   // models prefetch() started loading
+        size_t prefetchHits = 0; // acquire() hits on a prefetched model
+        size_t resident = 0;
+        size_t gpuBytes = 0;
+        size_t cpuBytes = 0;
+    };
+
+    ModelCache()
+    {
+        if (const char *vram = std::getenv("MODEL_CACHE_VRAM_MB"))
+            gpuBudget = (size_t)std::max(0, std::atoi(vram)) << 20;
+        if (const char *ram = std::getenv("MODEL_CACHE_RAM_MB"))
+            cpuBudget = (size_t)std::max(0, std::atoi(ram)) << 20;
+    }
+
+    ModelCache(const ModelCache &) = delete;
+    ModelCache &operator=(const ModelCache &) = delete;
+
+    // GL thread: the model of `path`, most recently used from now on; a miss starts loading it through
+    // `loader` (it is drawable once ready()). The loader has to be destroyed first: it waits for its imports.
+    Model &acquire(const std::string &path, ModelLoader &loader)
+    {
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+            if (it->path == path)
+            {
+                entries.splice(entries.begin(), entries, it);
+                stats.hits++;
+                if (it->prefetched)
+                    stats.prefetchHits++;
+                it->prefetched = false;
+                loader.promote(*it->model);
+                LOG_INFO("[ModelCache] Hit: '" << path << "'" << (it->model->ready() ? "" : " (still loading)"));
+                return *it->model;
+            }
+        entries.push_front(Entry());
+        entries.front().path = path;
+        entries.front().model.reset(new Model());
+        stats.misses++;
+        LOG_INFO("[ModelCache] Miss: loading '" << path << "'");
+        loader.load(*entries.front().model, path);
+        return *entries.front().model;
+    }
+
+    // GL thread: starts loading `path` in the background unless it is cached already. It goes in as the
+    // least recently used model, so it is the first one unloaded if it is never asked for.
+    void prefetch(const std::string &path, ModelLoader &loader)
+    {
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+            if (it->path == path)
+                return;
+        entries.push_back(Entry());
+        entries.back().path = path;
+        entries.back().model.reset(new Model());
+        entries.back().prefetched = true;
+        stats.prefetches++;
+        LOG_INFO("[ModelCache] Prefetching '" << path << "'");
+        loader.prefetch(*entries.back().model, path);
+    }
+
+    // GL thread, once per frame: uploads prefetched models whose import is done, if their geometry fits in
+    // what the budget leaves (the others stay in CPU memory until acquire() asks for them)
+    void promote(ModelLoader &loader)
+    {
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (!loader.prefetched(*it->model))
+                continue;
+            size_t gpu = 0, cpu = 0;
+            measure(gpu, cpu);
+            // the held model's packed vertices and indices are about what its upload adds
+            const size_t estimate = it->model->cpuBytes();
+            if (gpu + estimate > gpuBudget)
+                continue;
+            loader.promote(*it->model);
+        }
+    }
+
+    // GL thread, after a switch: unloads least recently used models, never one of `inUse` (drawn or about
+    // to be) or one still loading, until the resident ones fit both budgets
+    void trim(const std::vector<Model *> &inUse, ModelLoader &loader)
+    {
+        size_t gpu = 0, cpu = 0;
+        measure(gpu, cpu);
+        for (std::list<Entry>::iterator it = entries.end(); it != entries.begin() && (gpu > gpuBudget || cpu > cpuBudget);)
+        {
+            --it;
+            Model &model = *it->model;
+            if (std::find(inUse.begin(), inUse.end(), &model) != inUse.end() || loader.loading(model))
+                continue;
+            const size_t modelGpu = model.gpuBytes(), modelCpu = model.cpuBytes();
+            LOG_INFO("[ModelCache] Evicting '" << it->path << "' (" << GpuMemory::mb(modelGpu) << " MB GPU, " << GpuMemory::mb(modelCpu)
+                     << " MB CPU), over the " << GpuMemory::mb(gpuBudget) << " MB GPU / " << GpuMemory::mb(cpuBudget) << " MB CPU budget");
+            gpu -= std::min(gpu, modelGpu);
+            cpu -= std::min(cpu, modelCpu);
+            model.releaseGpu();
+            loader.forget(model);
+            it = entries.erase(it);
+            stats.evictions++;
+        }
+    }
+
+    Stats current() const
+    {
+        Stats s = stats;
+        s.resident = entries.size();
+        measure(s.gpuBytes, s.cpuBytes);
+        return s;
+    }
+
+    void report(std::ostream &out) const
+    {
+        const Stats s = current();
+        const size_t lookups = s.hits + s.misses;
+        out << "[ModelCache] " << s.resident << " models resident (" << GpuMemory::mb(s.gpuBytes) << " MB GPU, " << GpuMemory::mb(s.cpuBytes)
+            << " MB CPU), " << s.hits << " hits / " << s.misses << " misses (" << (lookups ? 100 * s.hits / lookups : 0) << "% hit rate), "
+            << s.evictions << " evicted, " << s.prefetchHits << " of " << s.prefetches << " prefetches used\n";
+    }
+
+    // GL thread: releases the GL objects of every cached model (call before the context goes away)
+    void releaseGpu()
+    {
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+            it->model->releaseGpu();
+    }
+
+private:
+    struct Entry
+    {
+        std::string path;
+        std::unique_ptr<Model> model;
+        bool prefetched = false; // by prefetch(), not acquire()d since
+    };
+
+    // most recently used first
+    std::list<Entry> entries;
+    size_t gpuBudget = (size_t)1024 << 20;
+    size_t cpuBudget = (size_t)512 << 20;
+    Stats stats;
+
+    void measure(size_t &gpu, size_t &cpu) const
+    {
+        gpu = cpu = 0;
+        for (std::list<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            gpu += it->model->gpuBytes();
+            cpu += it->model->cpuBytes();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef MODEL_LOADER_H
+#define MODEL_LOADER_H
+
+#include <async_log.h>
+#include <cooked_format.h>
+#include <model.h>
+#include <virtual_file_system.h>
+#include <thread_pool.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <string>
+#include <vector>
+
+// Streams models in without blocking the render loop. load() returns immediately and imports the file
+// on the worker pool; pump() (called once per frame on the GL thread) uploads the geometry of finished
+// imports, which makes them drawable with placeholder textures, then swaps in decoded textures within
+// a per-frame time budget. prefetch() does the CPU half only, at background priority, and holds the
+// model there until promote() lets pump() upload it.
+// A cooked file with a proxy (car_cook writes one at its front) shows that first: load() uploads only the
+// proxy, a worker reads the rest of the file into the page cache, and pump() then swaps the whole model
+// in. COOKED_PROXY=0 loads the whole file right away.
+class ModelLoader
+{
+public:
+    explicit ModelLoader(ThreadPool &pool = ThreadPool::shared()) : pool(pool) {}
+
+    // waits for outstanding imports so no worker touches a Model after this returns
+    ~ModelLoader()
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].import.valid())
+                jobs[i].import.wait();
+    }
+
+    ModelLoader(const ModelLoader &) = delete;
+    ModelLoader &operator=(const ModelLoader &) = delete;
+
+    // starts importing `path` into the (empty) `model`, which must outlive the load.
+    // GL thread: an up-to-date `<path>.cooked` from car_cook is loaded right here instead (USE_COOKED=0 skips it);
+    // CPU data can't be kept that way, so keepCpuData always imports the source.
+    void load(Model &model, const std::string &path, bool keepCpuData = false)
+    {
+        Job job;
+        job.model = &model;
+        job.path = path;
+        job.start = std::chrono::steady_clock::now();
+        const char *useCooked = std::getenv("USE_COOKED");
+        const bool cooked = !keepCpuData && !(useCooked && std::string(useCooked) == "0");
+        const std::string cookedPath = CookedFormat::cookedPath(path);
+        const char *useProxy = std::getenv("COOKED_PROXY");
+        if (cooked && !(useProxy && std::string(useProxy) == "0") && Model::cookedProxyIn(cookedPath) && model.loadCooked(cookedPath, path, true))
+        {
+            job.state = Job::Proxy;
+            job.import = pool.submitBackground([cookedPath]() { touchPages(cookedPath); });
+            LOG_INFO("[ModelLoader] '" << path << "' proxy drawable after " << elapsedMs(job.start) << " ms");
+            jobs.push_back(std::move(job));
+            return;
+        }
+        if (cooked && model.loadCooked(cookedPath, path))
+        {
+            job.state = Job::Done;
+            LOG_INFO("[ModelLoader] '" << path << "' loaded from cooked data in " << elapsedMs(job.start) << " ms");
+            jobs.push_back(std::move(job));
+            return;
+        }
+        job.import = pool.submit([&model, path, keepCpuData]() { model.importFromFile(path, keepCpuData); });
+        jobs.push_back(std::move(job));
+    }
+
+    // starts importing `path` into the (empty) `model` on whichever workers are idle; its textures decode
+    // too, but nothing goes to the GPU before promote(). A cooked model is only read through once (it
+    // uploads straight from the file, on the GL thread, when promoted).
+    void prefetch(Model &model, const std::string &path)
+    {
+        Job job;
+        job.model = &model;
+        job.path = path;
+        job.held = true;
+        job.start = std::chrono::steady_clock::now();
+        const char *useCooked = std::getenv("USE_COOKED");
+        FileView cooked;
+        if (!(useCooked && std::string(useCooked) == "0") && fileSystem().open(CookedFormat::cookedPath(path), cooked))
+        {
+            job.cooked = true;
+            const std::string cookedPath = CookedFormat::cookedPath(path);
+            job.import = pool.submitBackground([cookedPath]() { touchPages(cookedPath); });
+        }
+        else
+            job.import = pool.submitBackground([&model, path]() { model.importFromFile(path); });
+        jobs.push_back(std::move(job));
+    }
+
+    // lets pump() upload a prefetch()ed `model` (right away if its import is done); no-op otherwise
+    void promote(const Model &model)
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].model == &model && jobs[i].held)
+            {
+                jobs[i].held = false;
+                LOG_INFO("[ModelLoader] '" << jobs[i].path << "' promoted " << (jobs[i].state == Job::Imported ? "after its prefetch" : "while prefetching"));
+            }
+    }
+
+    // `model` was prefetch()ed, its CPU half is done and it waits for promote()
+    bool prefetched(const Model &model) const
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].model == &model && jobs[i].held && jobs[i].state == Job::Imported)
+                return true;
+        return false;
+    }
+
+    // GL thread: finishes completed imports and streams textures for up to budgetMs
+    // (budgetMs < 0 blocks until every queued model is fully loaded)
+    void pump(double budgetMs = 4.0)
+    {
+        bool block = budgetMs < 0.0;
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            Job &job = jobs[i];
+            if (job.state == Job::Proxy)
+            {
+                if (!block && job.import.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    continue;
+                job.import.get();
+                // the proxy goes and the whole file comes in its place, under the same Model (the source's
+                // hash was checked when the proxy loaded)
+                job.model->releaseGpu();
+                if (job.model->loadCooked(CookedFormat::cookedPath(job.path)))
+                {
+                    job.state = Job::Done;
+                    LOG_INFO("[ModelLoader] '" << job.path << "' replaced its proxy " << elapsedMs(job.start) << " ms after loading started");
+                    continue;
+                }
+                Model *model = job.model;
+                const std::string path = job.path;
+                job.import = pool.submit([model, path]() { model->importFromFile(path); });
+                job.state = Job::Importing;
+                continue;
+            }
+            if (job.state == Job::Importing)
+            {
+                if (!block && job.import.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    continue;
+                try
+                {
+                    job.import.get();
+                }
+                catch (const std::exception &e)
+                {
+                    LOG_WARN("[ModelLoader] Import of '" << job.path << "' failed: " << e.what());
+                    job.state = Job::Done;
+                    continue;
+                }
+                job.state = Job::Imported;
+                if (job.held)
+                    LOG_INFO("[ModelLoader] '" << job.path << "' prefetched after " << elapsedMs(job.start) << " ms");
+            }
+            if (job.state == Job::Imported)
+            {
+                if (job.held)
+                    continue;
+                if (job.cooked)
+                {
+                    job.cooked = false;
+                    if (job.model->loadCooked(CookedFormat::cookedPath(job.path), job.path))
+                    {
+                        job.state = Job::Done;
+                        LOG_INFO("[ModelLoader] '" << job.path << "' loaded from cooked data " << elapsedMs(job.start) << " ms after its prefetch started");
+                        continue;
+                    }
+                    // stale or unreadable: import the source like load() would
+                    Model *model = job.model;
+                    const std::string path = job.path;
+                    job.import = pool.submit([model, path]() { model->importFromFile(path); });
+                    job.state = Job::Importing;
+                    continue;
+                }
+                job.model->uploadToGpu();
+                job.state = Job::Streaming;
+                LOG_INFO("[ModelLoader] '" << job.path << "' drawable after " << elapsedMs(job.start) << " ms ("
+                         << job.model->meshes.size() << " meshes, textures streaming)");
+            }
+            if (job.state == Job::Streaming)
+            {
+                double left = block ? -1.0 : budgetMs - elapsedMs(frameStart);
+                if (!block && left <= 0.0)
+                    return;
+                if (job.model->streamTextures(left))
+                {
+                    job.state = Job::Done;
+                    LOG_INFO("[ModelLoader] '" << job.path << "' fully loaded after " << elapsedMs(job.start) << " ms");
+                }
+            }
+        }
+    }
+
+    // queued models by state, for the HUD
+    struct Progress
+    {
+        size_t total = 0;
+        size_t importing = 0;
+        size_t streaming = 0;
+    };
+
+    Progress progress() const
+    {
+        Progress p;
+        p.total = jobs.size();
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            p.importing += jobs[i].state == Job::Importing;
+            p.streaming += jobs[i].state == Job::Streaming || jobs[i].state == Job::Proxy;
+        }
+        return p;
+    }
+
+    // `model`'s import is still running (false once it is drawable, or failed)
+    bool importing(const Model &model) const
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].model == &model && jobs[i].state == Job::Importing)
+                return true;
+        return false;
+    }
+
+    // `model` is queued and not fully loaded yet (importing, or its textures still streaming)
+    bool loading(const Model &model) const
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].model == &model && jobs[i].state != Job::Done)
+                return true;
+        return false;
+    }
+
+    // drops the finished jobs of `model`, before it is destroyed (ModelCache eviction)
+    void forget(const Model &model)
+    {
+        for (size_t i = 0; i < jobs.size();)
+            if (jobs[i].model == &model && jobs[i].state == Job::Done)
+                jobs.erase(jobs.begin() + i);
+            else
+                ++i;
+    }
+
+    // nothing left to import or upload (prefetches waiting for promote() don't count)
+    bool idle() const
+    {
+        for (size_t i = 0; i < jobs.size(); ++i)
+            if (jobs[i].state != Job::Done && !(jobs[i].held && jobs[i].state == Job::Imported))
+                return false;
+        return true;
+    }
+
+private:
+    struct Job
+    {
+        // Imported: the CPU half is done, uploadToGpu() comes next (unless held). Proxy: the cooked proxy is
+        // drawn while the file is read ahead, loadCooked() of the whole file comes next
+        enum State { Proxy, Importing, Imported, Streaming, Done };
+        Model *model = 0;
+        std::string path;
+        State state = Importing;
+        bool held = false;   // prefetch() not promoted yet
+        bool cooked = false; // prefetch() of a cooked model: loadCooked() once promoted
+        std::future<void> import;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // reads one byte per page of `path`, so it is in the page cache by the time the GL thread maps it
+    static void touchPages(const std::string &path)
+    {
+        FileView file;
+        if (!fileSystem().open(path, file))
+            return;
+        volatile unsigned char sum = 0;
+        for (size_t i = 0; i < file.size(); i += 4096)
+            sum += file.data()[i];
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    ThreadPool &pool;
+    std::vector<Job> jobs;
+};
+
+#endif
@@ -0,0 +1,496 @@
+#ifndef NODE_ANIMATION_H
+#define NODE_ANIMATION_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <geometry_kernels.h>
+#include <gltf_loader.h>
+#include <thread_pool.h>
+#include <transform_hierarchy.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// ANIMATION=1: plays the glTF animations of a model (doors opening, wheels turning) and skins its skinned
+// meshes. Channels move the local transforms of their target nodes in the model's TransformHierarchy, so
+// the meshes below them follow like any moved node (Model keeps such meshes in node space, drawn through
+// the instance path). Skins turn into one matrix palette per model: palette slot paletteBase + j holds
+// world(joint j) * inverseBind(j), and a skinned mesh's vertices (baked in bind pose, model space) blend
+// up to four slots in model_loading.vs (SKINNED variant, `Bones` block at BINDING). ANIMATION=<name> plays
+// only the clip of that name; every clip loops on its own duration.
+// Channels are stored as parallel arrays over all clips (ChannelTable), their key times once per distinct
+// sampler input (the channels of a clip usually share one) and their values quantized to unorm16 over
+// each channel's range: 8 bytes per key instead of 16. Each channel keeps the key it sampled last, so the
+// search for the next frame's key usually advances by a step or none.
+// A frame's evaluation runs on the ThreadPool: start() queues the model into the frame's AnimationBatch,
+// whose one job evaluates every queued model side by side (sampling the channels, updating its hierarchy
+// and computing the palette with SSE); finish() waits for it on the GL thread before the moved nodes are
+// uploaded. The hierarchy must not be touched in between.
+class NodeAnimation
+{
+public:
+    // uniform buffer binding point of the `Bones` block (see Shader::uniformBlockBinding)
+    static const GLuint BINDING = 3;
+    // palette slots of a model; the block is MAX_JOINTS mat4s (16 KB, the smallest GL_MAX_UNIFORM_BLOCK_SIZE)
+    static const unsigned int MAX_JOINTS = 256;
+    static const unsigned int NO_PALETTE = ~0u;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("ANIMATION");
+        return env && *env && std::strcmp(env, "0") != 0;
+    }
+
+    // ANIMATION=<name>: the one clip to play (empty = all of them)
+    static std::string clipFromEnv()
+    {
+        const char *env = std::getenv("ANIMATION");
+        return env && std::strcmp(env, "1") != 0 && std::strcmp(env, "0") != 0 ? std::string(env) : std::string();
+    }
+
+    NodeAnimation() = default;
+    NodeAnimation(const NodeAnimation &) = delete;
+    NodeAnimation &operator=(const NodeAnimation &) = delete;
+    // a frame in flight writes into the owner's hierarchy
+    inline ~NodeAnimation();
+
+    enum Path { TRANSLATION, ROTATION, SCALE };
+    enum Interpolation { STEP, LINEAR, CUBICSPLINE };
+
+    // the channels of every clip, clip by clip, one array per field: a sampler driving one property of one
+    // node. Values are (x, y, z, w) quaternions for rotations; CUBICSPLINE keys hold three values each
+    // (in-tangent, value, out-tangent).
+    struct ChannelTable
+    {
+        std::vector<uint32_t> target;     // index into `targets`
+        std::vector<uint8_t> path;        // Path
+        std::vector<uint8_t> interpolation; // Interpolation
+        std::vector<uint32_t> firstTime;  // into keyTimes
+        std::vector<uint32_t> timeCount;
+        std::vector<uint32_t> firstValue; // into keyValues, in keys of 4 components
+        // value = offset + unorm16 * scale, per component
+        std::vector<glm::vec4> offset;
+        std::vector<glm::vec4> scale;
+        // key found by the last sample; clips play forward, so the search usually starts right there
+        std::vector<uint32_t> cursor;
+
+        size_t size() const { return target.size(); }
+    };
+
+    struct Clip
+    {
+        std::string name;
+        float duration = 0.0f;
+        uint32_t firstChannel = 0;
+        uint32_t channelCount = 0;
+    };
+
+    struct Skin
+    {
+        std::vector<int> joints; // hierarchy nodes
+        std::vector<glm::mat4> inverseBind;
+        // first palette slot, NO_PALETTE when the palette is full (its meshes stay in bind pose)
+        unsigned int paletteBase = NO_PALETTE;
+    };
+
+    bool empty() const { return clips.empty() && skins.empty(); }
+    bool hasSkins() const { return paletteSize > 0; }
+    const std::vector<Skin> &skinList() const { return skins; }
+    // MAX_JOINTS matrices (identity past the used slots), as of the last finish()
+    const std::vector<glm::mat4> &palette() const { return bones; }
+
+    // reads the animations and skins of `gltf`; `nodeIds` maps its nodes to `nodes` (-1 = not in the
+    // scene). Channels on nodes outside the scene or given as a matrix are dropped (glTF only animates TRS).
+    void load(const tinygltf::Model &gltf, const GltfLoader::BufferSpans &buffers, const std::vector<int> &nodeIds, const TransformHierarchy &nodes)
+    {
+        const std::string only = clipFromEnv();
+        std::vector<int> targetOf(nodes.size(), -1);
+        // sampler input accessor -> (first key time, count)
+        std::map<int, std::pair<uint32_t, uint32_t> > timeTracks;
+        std::vector<float> times, values;
+        for (size_t a = 0; a < gltf.animations.size(); ++a) {
+            const tinygltf::Animation &anim = gltf.animations[a];
+            if (!only.empty() && anim.name != only)
+                continue;
+            Clip clip;
+            clip.name = anim.name;
+            clip.firstChannel = (uint32_t)channels.size();
+            for (size_t c = 0; c < anim.channels.size(); ++c) {
+                const tinygltf::AnimationChannel &ac = anim.channels[c];
+                if (ac.target_node < 0 || ac.target_node >= (int)nodeIds.size() || nodeIds[ac.target_node] < 0)
+                    continue;
+                if (ac.sampler < 0 || ac.sampler >= (int)anim.samplers.size() || gltf.nodes[ac.target_node].matrix.size() == 16)
+                    continue;
+                Path path;
+                if (ac.target_path == "translation") path = TRANSLATION;
+                else if (ac.target_path == "rotation") path = ROTATION;
+                else if (ac.target_path == "scale") path = SCALE;
+                else continue; // morph target weights
+                const tinygltf::AnimationSampler &sampler = anim.samplers[ac.sampler];
+                const Interpolation interpolation = sampler.interpolation == "STEP" ? STEP : sampler.interpolation == "CUBICSPLINE" ? CUBICSPLINE : LINEAR;
+                std::map<int, std::pair<uint32_t, uint32_t> >::iterator track = timeTracks.find(sampler.input);
+                if (track == timeTracks.end()) {
+                    if (!GltfLoader::readFloatAccessor(gltf, buffers, sampler.input, 1, times) || times.empty())
+                        continue;
+                    track = timeTracks.insert(std::make_pair(sampler.input, std::make_pair((uint32_t)keyTimes.size(), (uint32_t)times.size()))).first;
+                    keyTimes.insert(keyTimes.end(), times.begin(), times.end());
+                }
+                const int components = path == ROTATION ? 4 : 3;
+                const uint32_t timeCount = track->second.second;
+                const size_t perKey = interpolation == CUBICSPLINE ? 3 : 1;
+                if (!GltfLoader::readFloatAccessor(gltf, buffers, sampler.output, 4, values) || values.size() / 4 != timeCount * perKey)
+                    continue;
+                const int node = nodeIds[ac.target_node];
+                if (targetOf[node] < 0) {
+                    targetOf[node] = (int)targets.size();
+                    targets.push_back(restPose(gltf.nodes[ac.target_node], node));
+                }
+                channels.target.push_back((uint32_t)targetOf[node]);
+                channels.path.push_back((uint8_t)path);
+                channels.interpolation.push_back((uint8_t)interpolation);
+                channels.firstTime.push_back(track->second.first);
+                channels.timeCount.push_back(timeCount);
+                channels.cursor.push_back(0);
+                quantizeValues(values, components);
+                clip.duration = std::max(clip.duration, keyTimes[track->second.first + timeCount - 1]);
+            }
+            clip.channelCount = (uint32_t)channels.size() - clip.firstChannel;
+            if (clip.channelCount)
+                clips.push_back(clip);
+        }
+        pose = targets;
+
+        for (size_t s = 0; s < gltf.skins.size(); ++s) {
+            const tinygltf::Skin &gs = gltf.skins[s];
+            Skin skin;
+            std::vector<float> matrices;
+            if (gs.inverseBindMatrices >= 0)
+                GltfLoader::readFloatAccessor(gltf, buffers, gs.inverseBindMatrices, 16, matrices);
+            for (size_t j = 0; j < gs.joints.size(); ++j) {
+                const int joint = gs.joints[j] >= 0 && gs.joints[j] < (int)nodeIds.size() ? nodeIds[gs.joints[j]] : -1;
+                skin.joints.push_back(joint);
+                glm::mat4 inverseBind(1.0f);
+                if (matrices.size() >= (j + 1) * 16)
+                    std::memcpy(&inverseBind[0][0], &matrices[j * 16], sizeof(glm::mat4));
+                skin.inverseBind.push_back(inverseBind);
+            }
+            if (paletteSize + skin.joints.size() <= MAX_JOINTS) {
+                skin.paletteBase = paletteSize;
+                paletteSize += (unsigned int)skin.joints.size();
+            } else {
+                LOG_WARN("[Anim] skin " << s << " has no room left in the " << MAX_JOINTS << "-joint palette; its meshes stay in bind pose");
+            }
+            skins.push_back(std::move(skin));
+        }
+        bones.assign(MAX_JOINTS, glm::mat4(1.0f));
+        computePalette(nodes);
+        if (!empty())
+            LOG_INFO("[Anim] " << clips.size() << " clips (" << channels.size() << " channels over " << targets.size() << " nodes, "
+                     << (keyTimes.size() * sizeof(float) + keyValues.size() * sizeof(uint16_t)) / 1024 << " KB of keys), "
+                     << skins.size() << " skins (" << paletteSize << " palette joints)");
+    }
+
+    // hierarchy nodes moved by a channel, or below one, indexed like `nodes` (parents come first)
+    std::vector<unsigned char> movingNodes(const TransformHierarchy &nodes) const
+    {
+        std::vector<unsigned char> moving(nodes.size(), 0);
+        for (size_t t = 0; t < targets.size(); ++t)
+            moving[targets[t].node] = 1;
+        for (size_t i = 0; i < nodes.size(); ++i)
+            if (nodes.parent((int)i) >= 0 && moving[nodes.parent((int)i)])
+                moving[i] = 1;
+        return moving;
+    }
+
+    // GL thread: queues the clips at `seconds` into the frame's AnimationBatch, evaluated into `nodes` on
+    // the ThreadPool once it starts; ignored while a frame is still queued or in flight (a model placed
+    // twice)
+    inline void start(TransformHierarchy &nodes, double seconds);
+
+    bool running() const { return stage != IDLE; }
+
+    // GL thread: waits for the batch holding this model (starting it if nobody has); returns how many
+    // world matrices it changed (the hierarchy's update() already ran, changedSinceUpdate() tells which)
+    inline size_t finish();
+
+    // the job's part for one model: sample, move the nodes, update the hierarchy, rebuild the palette
+    void evaluate()
+    {
+        changedNodes = 0;
+        if (!hierarchy)
+            return;
+        TransformHierarchy &nodes = *hierarchy;
+        pose = targets;
+        for (size_t a = 0; a < clips.size(); ++a) {
+            const Clip &clip = clips[a];
+            const float t = clip.duration > 0.0f ? (float)std::fmod(time, (double)clip.duration) : 0.0f;
+            for (uint32_t c = clip.firstChannel; c < clip.firstChannel + clip.channelCount; ++c) {
+                const glm::vec4 v = sample(c, t);
+                Target &p = pose[channels.target[c]];
+                if (channels.path[c] == TRANSLATION) p.translation = glm::vec3(v);
+                else if (channels.path[c] == ROTATION) p.rotation = toQuat(v);
+                else p.scale = glm::vec3(v);
+            }
+        }
+        for (size_t i = 0; i < pose.size(); ++i) {
+            const Target &p = pose[i];
+            glm::mat4 local = glm::mat4_cast(glm::normalize(p.rotation));
+            local[0] *= p.scale.x;
+            local[1] *= p.scale.y;
+            local[2] *= p.scale.z;
+            local[3] = glm::vec4(p.translation, 1.0f);
+            nodes.setLocal(p.node, local);
+        }
+        changedNodes = nodes.update();
+        if (changedNodes)
+            computePalette(nodes);
+    }
+
+    // joint matrix world * inverseBind, four columns of four lanes
+    static void jointMatrix(const glm::mat4 &world, const glm::mat4 &inverseBind, glm::mat4 &out)
+    {
+#if defined(GEOMETRY_KERNELS_SSE2)
+        const __m128 c0 = _mm_loadu_ps(&world[0][0]), c1 = _mm_loadu_ps(&world[1][0]);
+        const __m128 c2 = _mm_loadu_ps(&world[2][0]), c3 = _mm_loadu_ps(&world[3][0]);
+        for (int c = 0; c < 4; ++c) {
+            const float *b = &inverseBind[c][0];
+            const __m128 lo = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(b[0])), _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+            const __m128 hi = _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(b[2])), _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+            _mm_storeu_ps(&out[c][0], _mm_add_ps(lo, hi));
+        }
+#else
+        out = world * inverseBind;
+#endif
+    }
+
+private:
+    // an animated node's rest transform, overwritten per property by its channels
+    struct Target
+    {
+        int node;
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+    };
+
+    std::vector<Clip> clips;
+    ChannelTable channels;
+    std::vector<float> keyTimes;
+    std::vector<uint16_t> keyValues;
+    std::vector<Target> targets;
+    // evaluate() scratch: the targets' poses this frame
+    std::vector<Target> pose;
+    std::vector<Skin> skins;
+    std::vector<glm::mat4> bones;
+    unsigned int paletteSize = 0;
+    friend class AnimationBatch;
+    // start()'s frame: QUEUED until its batch's job is collected, DONE until finish() returns changedNodes
+    enum Stage { IDLE, QUEUED, DONE };
+    Stage stage = IDLE;
+    TransformHierarchy *hierarchy = nullptr;
+    double time = 0.0;
+    size_t changedNodes = 0;
+
+    // appends a channel's keys (4 floats each) as unorm16 over their range, per component
+    void quantizeValues(const std::vector<float> &values, int components)
+    {
+        const size_t keys = values.size() / 4;
+        glm::vec4 lo(FLT_MAX), hi(-FLT_MAX);
+        for (size_t k = 0; k < keys; ++k)
+            for (int i = 0; i < components; ++i) {
+                lo[i] = std::min(lo[i], values[k * 4 + i]);
+                hi[i] = std::max(hi[i], values[k * 4 + i]);
+            }
+        glm::vec4 scale(0.0f);
+        for (int i = 0; i < 4; ++i) {
+            if (i >= components)
+                lo[i] = hi[i] = 0.0f;
+            scale[i] = (hi[i] - lo[i]) / 65535.0f;
+        }
+        channels.firstValue.push_back((uint32_t)(keyValues.size() / 4));
+        channels.offset.push_back(lo);
+        channels.scale.push_back(scale);
+        for (size_t k = 0; k < keys; ++k)
+            for (int i = 0; i < 4; ++i)
+                keyValues.push_back(scale[i] > 0.0f ? (uint16_t)std::floor((values[k * 4 + i] - lo[i]) / scale[i] + 0.5f) : (uint16_t)0);
+    }
+
+    glm::vec4 value(uint32_t c, size_t key) const
+    {
+        const uint16_t *q = &keyValues[(channels.firstValue[c] + key) * 4];
+        return channels.offset[c] + channels.scale[c] * glm::vec4(q[0], q[1], q[2], q[3]);
+    }
+
+    static Target restPose(const tinygltf::Node &n, int node)
+    {
+        Target t = {node, glm::vec3(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f)};
+        if (n.translation.size() == 3)
+            t.translation = glm::vec3((float)n.translation[0], (float)n.translation[1], (float)n.translation[2]);
+        if (n.rotation.size() == 4)
+            t.rotation = glm::quat((float)n.rotation[3], (float)n.rotation[0], (float)n.rotation[1], (float)n.rotation[2]);
+        if (n.scale.size() == 3)
+            t.scale = glm::vec3((float)n.scale[0], (float)n.scale[1], (float)n.scale[2]);
+        return t;
+    }
+
+    static glm::quat toQuat(const glm::vec4 &v) { return glm::quat(v.w, v.x, v.y, v.z); }
+
+    // value of channel `c` at `t` (clamped to its keys)
+    glm::vec4 sample(uint32_t c, float t)
+    {
+        const float *times = &keyTimes[channels.firstTime[c]];
+        const uint32_t keys = channels.timeCount[c];
+        const Interpolation interpolation = (Interpolation)channels.interpolation[c];
+        const size_t stride = interpolation == CUBICSPLINE ? 3 : 1;
+        const size_t valueAt = interpolation == CUBICSPLINE ? 1 : 0;
+        if (keys == 1 || t <= times[0])
+            return value(c, valueAt);
+        if (t >= times[keys - 1])
+            return value(c, (keys - 1) * stride + valueAt);
+        uint32_t &cursor = channels.cursor[c];
+        if (cursor + 1 >= keys || times[cursor] > t)
+            cursor = 0;
+        while (times[cursor + 1] <= t)
+            cursor++;
+        const size_t k = cursor;
+        const glm::vec4 v0 = value(c, k * stride + valueAt), v1 = value(c, (k + 1) * stride + valueAt);
+        if (interpolation == STEP)
+            return v0;
+        const float dt = times[k + 1] - times[k];
+        const float s = dt > 0.0f ? (t - times[k]) / dt : 0.0f;
+        if (interpolation == CUBICSPLINE) {
+            // Hermite spline through the keys with their out/in tangents scaled by the key interval
+            const float s2 = s * s, s3 = s2 * s;
+            return (2.0f * s3 - 3.0f * s2 + 1.0f) * v0 + (s3 - 2.0f * s2 + s) * dt * value(c, k * 3 + 2)
+                 + (-2.0f * s3 + 3.0f * s2) * v1 + (s3 - s2) * dt * value(c, (k + 1) * 3);
+        }
+        if (channels.path[c] == ROTATION) {
+            const glm::quat q = glm::slerp(glm::normalize(toQuat(v0)), glm::normalize(toQuat(v1)), s);
+            return glm::vec4(q.x, q.y, q.z, q.w);
+        }
+        return glm::mix(v0, v1, s);
+    }
+
+    // palette slots from the current world matrices; large rigs split across the pool
+    void computePalette(const TransformHierarchy &nodes)
+    {
+        for (size_t s = 0; s < skins.size(); ++s) {
+            const Skin &skin = skins[s];
+            if (skin.paletteBase == NO_PALETTE)
+                continue;
+            ThreadPool::shared().parallelFor(skin.joints.size(), 64, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j) {
+                    const glm::mat4 &world = skin.joints[j] >= 0 ? nodes.world(skin.joints[j]) : glm::mat4(1.0f);
+                    jointMatrix(world, skin.inverseBind[j], bones[skin.paletteBase + j]);
+                }
+            }, "joint palette");
+        }
+    }
+};
+
+// The animated models of a frame, evaluated by one ThreadPool job: NodeAnimation::start() adds a model,
+// start() (main loop, after every model's animate()) hands the queue to the job, which spreads the
+// models over the pool; wait() collects it. A model finishing before anyone started its batch starts it
+// itself, so a forgotten start() only costs the overlap with the GL thread. GL thread only.
+class AnimationBatch
+{
+public:
+    AnimationBatch() = default;
+    AnimationBatch(const AnimationBatch &) = delete;
+    AnimationBatch &operator=(const AnimationBatch &) = delete;
+
+    void add(NodeAnimation *animation) { queued.push_back(animation); }
+
+    // submits the queued models; no-op while the previous batch is still in flight
+    void start()
+    {
+        if (queued.empty() || job.valid())
+            return;
+        running.swap(queued);
+        queued.clear();
+        job = ThreadPool::shared().submit([this]() {
+            FrameTrace::Scope trace("animate", std::to_string(running.size()) + " models");
+            ThreadPool::shared().parallelFor(running.size(), 1, [this](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    running[i]->evaluate();
+            }, "animate models");
+        });
+    }
+
+    // waits for the job in flight; its models' results are ready for their finish()
+    void wait()
+    {
+        if (!job.valid())
+            return;
+        job.get();
+        for (size_t i = 0; i < running.size(); ++i)
+            running[i]->stage = NodeAnimation::DONE;
+        running.clear();
+    }
+
+    // a model going away: out of the queue, or out of the job once it is done
+    void forget(NodeAnimation *animation)
+    {
+        queued.erase(std::remove(queued.begin(), queued.end(), animation), queued.end());
+        if (std::find(running.begin(), running.end(), animation) != running.end())
+            wait();
+    }
+
+private:
+    std::vector<NodeAnimation *> queued;
+    std::vector<NodeAnimation *> running;
+    std::future<void> job;
+};
+
+// the process's one batch, like the ThreadPool it runs on
+inline AnimationBatch &animationBatch()
+{
+    static AnimationBatch batch;
+    return batch;
+}
+
+inline NodeAnimation::~NodeAnimation()
+{
+    if (stage == QUEUED)
+        animationBatch().forget(this);
+}
+
+inline void NodeAnimation::start(TransformHierarchy &nodes, double seconds)
+{
+    if (clips.empty() || stage != IDLE)
+        return;
+    stage = QUEUED;
+    hierarchy = &nodes;
+    time = seconds;
+    animationBatch().add(this);
+}
+
+inline size_t NodeAnimation::finish()
+{
+    AnimationBatch &batch = animationBatch();
+    if (stage == QUEUED)
+        batch.wait();
+    if (stage == QUEUED) {
+        // queued after the running batch started, or nobody started it
+        batch.start();
+        batch.wait();
+    }
+    if (stage != DONE)
+        return 0;
+    stage = IDLE;
+    return changedNodes;
+}
+
+#endif
@@ -0,0 +1,377 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <draw_stats.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Two-phase occlusion culling of the models' opaque draws (OCCLUSION_CULLING=1). Per frame:
+//   1. every model draws the set that was visible last frame (Model::drawOcclusionPass, first pass)
+//   2. buildPyramid() turns the resulting depth buffer into a Hi-Z pyramid (farthest depth per texel)
+//   3. every model tests all of its draw boxes against it (Model::cullOcclusion), which writes the
+//      instance counts of two indirect command lists on the GPU: the draws visible now but skipped by
+//      step 1, and next frame's first pass
+//   4. every model draws those newly visible meshes plus its transparent ones (second pass)
+// Occluders are therefore never missing from the pyramid and nothing pops in late. This needs compute
+// shaders and multi-draw indirect (GL 4.3). Older drivers issue one GL_ANY_SAMPLES_PASSED query per draw
+// box instead, read back a frame later, so there meshes coming out of occlusion show up one frame late.
+class OcclusionCuller
+{
+public:
+    // texture unit of the depth copy / pyramid while the passes run (0..12 are taken by the materials and IBL)
+    static const unsigned int UNIT = 13;
+
+    // per-model state, indexed like the model's opaque draw list
+    struct Target
+    {
+        unsigned int drawCount = 0;
+        // which path the target was prepared for (the Hi-Z path can be abandoned after the first frame)
+        bool hiZ = false;
+        // Hi-Z path: box per draw (vec4 min, vec4 max) and the two command lists the cull pass writes
+        GLuint boundsBuffer = 0;
+        GLuint firstPassCommands = 0;
+        GLuint secondPassCommands = 0;
+        // query path: one query per draw, issued when no result is pending, and the last result
+        std::vector<glm::vec3> boundsMin, boundsMax;
+        std::vector<GLuint> queries;
+        std::vector<unsigned char> pending;
+        std::vector<unsigned char> visible;
+
+        bool ready() const { return drawCount != 0; }
+
+        // Hi-Z path: points draw `k` of both command lists at another index range (a LOD switch). The
+        // instance counts the cull pass owns are left alone.
+        void setDrawRange(unsigned int k, GLuint firstIndex, GLuint count)
+        {
+            const GLintptr base = (GLintptr)k * 5 * sizeof(GLuint);
+            const GLuint lists[2] = {firstPassCommands, secondPassCommands};
+            for (int l = 0; l < 2; ++l)
+            {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, lists[l]);
+                glBufferSubData(GL_COPY_WRITE_BUFFER, base, sizeof(GLuint), &count);
+                glBufferSubData(GL_COPY_WRITE_BUFFER, base + 2 * sizeof(GLuint), sizeof(GLuint), &firstIndex);
+            }
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        void release()
+        {
+            if (boundsBuffer) glDeleteBuffers(1, &boundsBuffer);
+            if (firstPassCommands) glDeleteBuffers(1, &firstPassCommands);
+            if (secondPassCommands) glDeleteBuffers(1, &secondPassCommands);
+            boundsBuffer = firstPassCommands = secondPassCommands = 0;
+            if (!queries.empty())
+                glDeleteQueries((GLsizei)queries.size(), &queries[0]);
+            queries.clear();
+            pending.clear();
+            visible.clear();
+            boundsMin.clear();
+            boundsMax.clear();
+            drawCount = 0;
+        }
+    };
+
+    // `shaderDir` holds hiz_reduce.comp, hiz_cull.comp and occlusion_box.vs/.fs
+    explicit OcclusionCuller(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    OcclusionCuller(const OcclusionCuller &) = delete;
+    OcclusionCuller &operator=(const OcclusionCuller &) = delete;
+
+    // OCCLUSION_CULLING=1 turns the two-phase mode on
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("OCCLUSION_CULLING");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the programs of the path this driver supports
+    void init()
+    {
+        useHiZ = ComputeShader::supported();
+        if (useHiZ)
+        {
+            reduceProgram.reset(new ComputeShader((shaderDir + "/hiz_reduce.comp").c_str()));
+            cullProgram.reset(new ComputeShader((shaderDir + "/hiz_cull.comp").c_str()));
+            useHiZ = reduceProgram->valid() && cullProgram->valid();
+        }
+        if (!useHiZ)
+            createQueryResources();
+        LOG_INFO("[Occlusion] Two-phase culling with " << (useHiZ ? "a Hi-Z pyramid (compute)" : "occlusion queries"));
+    }
+
+    // true when the culled draws come from the GPU-written command lists of Target
+    bool hiZ() const { return useHiZ; }
+
+    // sets up `target` for a model with `count` opaque draws; `commands` holds their DrawElementsIndirectCommands
+    // (all instanceCount 1) on the Hi-Z path. Everything starts out visible.
+    void prepare(Target &target, const glm::vec3 *boundsMin, const glm::vec3 *boundsMax, unsigned int count, GLuint commands)
+    {
+        target.release();
+        if (count == 0)
+            return;
+        target.drawCount = count;
+        target.hiZ = useHiZ;
+        target.boundsMin.assign(boundsMin, boundsMin + count);
+        target.boundsMax.assign(boundsMax, boundsMax + count);
+        if (useHiZ)
+        {
+            std::vector<glm::vec4> bounds(2 * count);
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                bounds[2 * i] = glm::vec4(boundsMin[i], 1.0f);
+                bounds[2 * i + 1] = glm::vec4(boundsMax[i], 1.0f);
+            }
+            glGenBuffers(1, &target.boundsBuffer);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.boundsBuffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, bounds.size() * sizeof(glm::vec4), &bounds[0], GL_STATIC_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+            // 5 uints per DrawElementsIndirectCommand
+            const GLsizeiptr bytes = (GLsizeiptr)count * 5 * sizeof(GLuint);
+            glBindBuffer(GL_COPY_READ_BUFFER, commands);
+            GLuint *lists[2] = {&target.firstPassCommands, &target.secondPassCommands};
+            for (int l = 0; l < 2; ++l)
+            {
+                glGenBuffers(1, lists[l]);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, *lists[l]);
+                glBufferData(GL_COPY_WRITE_BUFFER, bytes, NULL, GL_DYNAMIC_COPY);
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, bytes);
+            }
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        else
+        {
+            target.queries.resize(count);
+            glGenQueries((GLsizei)count, &target.queries[0]);
+            target.pending.assign(count, 0);
+        }
+        target.visible.assign(count, 1);
+    }
+
+    // GL thread, after every model's first pass: copies the default framebuffer's depth (width x height)
+    // and reduces it to the Hi-Z pyramid. No-op on the query path.
+    void buildPyramid(int width, int height)
+    {
+        if (!useHiZ || width <= 0 || height <= 0)
+            return;
+        createPyramid(width, height);
+        if (!blitChecked)
+            while (glGetError() != GL_NO_ERROR)
+            {
+            }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, glState().sceneFramebuffer());
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthFbo);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        if (!blitChecked)
+        {
+            // the blit needs the depth copy to match the scene's depth format; give up on Hi-Z otherwise
+            blitChecked = true;
+            if (glGetError() != GL_NO_ERROR)
+            {
+                LOG_WARN("[Occlusion] Can't copy the scene depth buffer (format mismatch), using occlusion queries");
+                useHiZ = false;
+                createQueryResources();
+                return;
+            }
+        }
+        reduceProgram->use();
+        reduceProgram->setInt("source", (int)UNIT);
+        int srcW = width, srcH = height;
+        for (int level = 0; level < pyramidLevels; ++level)
+        {
+            const int dstW = level == 0 ? width : std::max(1, srcW / 2);
+            const int dstH = level == 0 ? height : std::max(1, srcH / 2);
+            if (level == 0)
+                glState().bindTexture(UNIT, GL_TEXTURE_2D, depthTexture);
+            else
+                glState().bindTexture(UNIT, GL_TEXTURE_2D, pyramid);
+            reduceProgram->setInt("sourceLevel", level == 0 ? 0 : level - 1);
+            reduceProgram->setIvec2("sourceSize", srcW, srcH);
+            reduceProgram->setIvec2("destinationSize", dstW, dstH);
+            reduceProgram->setInt("copyLevel", level == 0 ? 1 : 0);
+            glBindImageTexture(0, pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            glDispatchCompute((GLuint)(dstW + 7) / 8, (GLuint)(dstH + 7) / 8, 1);
+            // the next level fetches this one
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+            srcW = dstW;
+            srcH = dstH;
+        }
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    }
+
+    // GL thread, after buildPyramid(): tests the draws of `target` for a model drawn with
+    // `clipFromModel` (projection * view * model); `eye` is the camera position in model space
+    void cull(Target &target, const glm::mat4 &clipFromModel, const glm::vec3 &eye)
+    {
+        if (!target.ready() || target.hiZ != useHiZ)
+            return;
+        if (useHiZ)
+        {
+            cullProgram->use();
+            cullProgram->setMat4("clipFromModel", clipFromModel);
+            cullProgram->setInt("hiZ", (int)UNIT);
+            cullProgram->setVec2("hiZSize", glm::vec2((float)pyramidWidth, (float)pyramidHeight));
+            cullProgram->setFloat("hiZMaxLevel", (float)(pyramidLevels - 1));
+            cullProgram->setUint("drawCount", target.drawCount);
+            glState().bindTexture(UNIT, GL_TEXTURE_2D, pyramid);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, target.boundsBuffer);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, target.firstPassCommands);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, target.secondPassCommands);
+            glDispatchCompute((target.drawCount + 63) / 64, 1, 1);
+            // the second pass (and next frame's first) read the commands as indirect arguments
+            glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+            return;
+        }
+        // query path: collect finished results, then re-test the boxes without a query in flight
+        const Frustum frustum(clipFromModel);
+        boxShader->use();
+        boxShader->setMat4("clipFromModel", clipFromModel);
+        glState().bindVertexArray(boxVao);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+        for (unsigned int i = 0; i < target.drawCount; ++i)
+        {
+            if (target.pending[i])
+            {
+                GLuint available = 0;
+                glGetQueryObjectuiv(target.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    continue;
+                GLuint samples = 0;
+                glGetQueryObjectuiv(target.queries[i], GL_QUERY_RESULT, &samples);
+                target.visible[i] = samples != 0;
+                target.pending[i] = 0;
+            }
+            const glm::vec3 &bMin = target.boundsMin[i];
+            const glm::vec3 &bMax = target.boundsMax[i];
+            // outside the view, or the eye is inside (the box would be clipped away): draw it when it matters
+            const glm::vec3 margin = (bMax - bMin) * 0.05f;
+            if (frustum.classify(bMin, bMax) == Frustum::OUTSIDE ||
+                (glm::all(glm::greaterThanEqual(eye, bMin - margin)) && glm::all(glm::lessThanEqual(eye, bMax + margin))))
+            {
+                target.visible[i] = 1;
+                continue;
+            }
+            boxShader->setVec3("boxMin", bMin);
+            boxShader->setVec3("boxMax", bMax);
+            glBeginQuery(GL_ANY_SAMPLES_PASSED, target.queries[i]);
+            glDrawArrays(GL_TRIANGLES, 0, 36);
+            glEndQuery(GL_ANY_SAMPLES_PASSED);
+            drawStats().count();
+            target.pending[i] = 1;
+        }
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+    }
+
+    void releaseGpu()
+    {
+        reduceProgram.reset();
+        cullProgram.reset();
+        boxShader.reset();
+        if (boxVbo) glDeleteBuffers(1, &boxVbo);
+        if (boxVao) glDeleteVertexArrays(1, &boxVao);
+        boxVbo = boxVao = 0;
+        releasePyramid();
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    bool useHiZ = false;
+    bool blitChecked = false;
+    std::unique_ptr<ComputeShader> reduceProgram;
+    std::unique_ptr<ComputeShader> cullProgram;
+    // window-sized depth copy and the R32F max-depth pyramid built from it
+    GLuint depthTexture = 0;
+    GLuint depthFbo = 0;
+    GLuint pyramid = 0;
+    int pyramidWidth = 0, pyramidHeight = 0, pyramidLevels = 0;
+    // query path: unit cube drawn scaled to each box
+    std::unique_ptr<Shader> boxShader;
+    GLuint boxVao = 0, boxVbo = 0;
+
+    void createPyramid(int width, int height)
+    {
+        if (pyramid && width == pyramidWidth && height == pyramidHeight)
+            return;
+        releasePyramid();
+        pyramidWidth = width;
+        pyramidHeight = height;
+        pyramidLevels = 1 + (int)std::floor(std::log2((float)std::max(width, height)));
+        glGenTextures(1, &depthTexture);
+        glBindTexture(GL_TEXTURE_2D, depthTexture);
+        // GLFW's default framebuffer is 24-bit depth + 8-bit stencil; blits need the same format
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        glGenFramebuffers(1, &depthFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, depthFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glGenTextures(1, &pyramid);
+        glBindTexture(GL_TEXTURE_2D, pyramid);
+        glTexStorage2D(GL_TEXTURE_2D, pyramidLevels, GL_R32F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releasePyramid()
+    {
+        if (depthFbo) glDeleteFramebuffers(1, &depthFbo);
+        if (depthTexture) glDeleteTextures(1, &depthTexture);
+        if (pyramid) glDeleteTextures(1, &pyramid);
+        depthFbo = depthTexture = pyramid = 0;
+        pyramidWidth = pyramidHeight = pyramidLevels = 0;
+    }
+
+    void createQueryResources()
+    {
+        if (boxVao)
+            return;
+        boxShader.reset(new Shader((shaderDir + "/occlusion_box.vs").c_str(), (shaderDir + "/occlusion_box.fs").c_str()));
+        // 12 triangles of the unit cube
+        static const float corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}};
+        static const int faces[36] = {0, 2, 1, 1, 2, 3, 4, 5, 6, 5, 7, 6, 0, 1, 4, 1, 5, 4,
+                                      2, 6, 3, 3, 6, 7, 0, 4, 2, 2, 4, 6, 1, 3, 5, 3, 7, 5};
+        float vertices[36 * 3];
+        for (int v = 0; v < 36; ++v)
+            for (int c = 0; c < 3; ++c)
+                vertices[v * 3 + c] = corners[faces[v]][c];
+        glGenVertexArrays(1, &boxVao);
+        glGenBuffers(1, &boxVbo);
+        glState().bindVertexArray(boxVao);
+        glBindBuffer(GL_ARRAY_BUFFER, boxVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
+        glState().bindVertexArray(0);
+    }
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef ORBIT_CAMERA_H
+#define ORBIT_CAMERA_H
+
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <camera.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// ORBIT_CAMERA=1: the view orbits the focused placed model (the first one placed, then whichever a click
+// picks) instead of flying. Mouse and A/D (arrows) turn it around the model, W/S and the wheel move it in
+// and out, PageUp/PageDown tilt it; ORBIT_CAMERA=turntable also spins it slowly on its own. Input only
+// moves goals: yaw, pitch, distance and the orbit center each follow theirs through a critically damped
+// spring stepped at a fixed TICKS_PER_SECOND, and the pose is interpolated between the last two ticks, so
+// the motion is the same at any frame rate and mouse events no longer jolt the view between frames. Once
+// every spring is within a hair of its goal the pose snaps onto it and settled() turns true: the view
+// matrix stops changing at once instead of creeping for seconds, which lets STILL start accumulating and
+// IDLE_RENDER go to sleep (and keeps them awake while it glides).
+class OrbitCamera
+{
+public:
+    static const int TICKS_PER_SECOND = 120;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("ORBIT_CAMERA");
+        return env && (std::strcmp(env, "1") == 0 || std::strcmp(env, "turntable") == 0);
+    }
+
+    OrbitCamera()
+    {
+        const char *env = std::getenv("ORBIT_CAMERA");
+        enabled = enabledByEnv();
+        spin = env && std::strcmp(env, "turntable") == 0 ? 15.0f : 0.0f;
+    }
+
+    bool active() const { return enabled && focused; }
+    // nothing moving: the pose sits on its goals (always true while inactive)
+    bool settled() const { return !active() || (isSettled && spin == 0.0f); }
+
+    // orbits the box `boundsMin`-`boundsMax` (world space), far enough for a vertical field of view of
+    // `fovDegrees` to take it all in; glides there unless this is the first focus
+    void focus(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax, float fovDegrees)
+    {
+        if (!enabled)
+            return;
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        radius = std::max(0.5f * glm::length(boundsMax - boundsMin), 0.01f);
+        const float fit = radius / std::sin(glm::radians(std::max(fovDegrees, 1.0f)) * 0.5f);
+        for (int i = 0; i < 3; ++i)
+            state[CENTER_X + i].goal = center[i];
+        state[DISTANCE].goal = fit * 1.1f;
+        if (!focused)
+        {
+            state[YAW].goal = 45.0f;
+            state[PITCH].goal = 15.0f;
+            for (int i = 0; i < COUNT; ++i)
+                state[i].snap();
+            previous = currentPose();
+            focused = true;
+            LOG_INFO("[Orbit] orbiting (" << center.x << ", " << center.y << ", " << center.z << "), radius " << radius
+                     << (spin != 0.0f ? ", turntable" : ""));
+        }
+        isSettled = false;
+    }
+
+    // mouse motion in pixels (y up) or key steps in degrees
+    void orbit(float yawDegrees, float pitchDegrees)
+    {
+        if (!active() || (yawDegrees == 0.0f && pitchDegrees == 0.0f))
+            return;
+        state[YAW].goal += yawDegrees;
+        state[PITCH].goal = glm::clamp(state[PITCH].goal + pitchDegrees, -85.0f, 85.0f);
+        isSettled = false;
+    }
+
+    // wheel steps (or fractions of one for held keys): positive moves in
+    void zoom(float steps)
+    {
+        if (!active() || steps == 0.0f)
+            return;
+        state[DISTANCE].goal = glm::clamp(state[DISTANCE].goal * std::pow(0.85f, steps), radius * 0.6f, radius * 40.0f);
+        isSettled = false;
+    }
+
+    // advances the springs by `seconds` of fixed ticks and places `camera` on the interpolated pose; true
+    // when the camera moved
+    bool update(float seconds, Camera &camera)
+    {
+        if (!active())
+            return false;
+        const float tick = 1.0f / TICKS_PER_SECOND;
+        // a stall (loading, a breakpoint) doesn't fast-forward the glide
+        accumulator = std::min(accumulator + std::max(seconds, 0.0f), 0.25f);
+        while (accumulator >= tick && !(isSettled && spin == 0.0f))
+        {
+            previous = currentPose();
+            step(tick);
+            accumulator -= tick;
+        }
+        if (isSettled && spin == 0.0f)
+        {
+            accumulator = 0.0f;
+            previous = currentPose();
+        }
+        const Pose pose = previous.mix(currentPose(), accumulator / tick);
+        const glm::vec3 position = pose.center + pose.distance * direction(pose.yaw, pose.pitch);
+        if (placed && position == camera.Position && pose.center == lookedAt)
+            return false;
+        camera.Position = position;
+        camera.LookAt(pose.center);
+        lookedAt = pose.center;
+        placed = true;
+        return true;
+    }
+
+private:
+    // one damped parameter chasing its goal
+    struct Spring
+    {
+        float value = 0.0f, velocity = 0.0f, goal = 0.0f;
+
+        void snap()
+        {
+            value = goal;
+            velocity = 0.0f;
+        }
+
+        // exact step of x'' = -w^2 x - 2w x' towards the goal (no overshoot, stable for any dt)
+        void step(float dt, float omega)
+        {
+            const float x = value - goal;
+            const float j = velocity + omega * x;
+            const float e = std::exp(-omega * dt);
+            value = goal + (x + j * dt) * e;
+            velocity = (velocity - omega * j * dt) * e;
+        }
+    };
+
+    struct Pose
+    {
+        glm::vec3 center;
+        float yaw, pitch, distance;
+
+        Pose mix(const Pose &next, float t) const
+        {
+            Pose p;
+            p.center = glm::mix(center, next.center, t);
+            p.yaw = yaw + (next.yaw - yaw) * t;
+            p.pitch = pitch + (next.pitch - pitch) * t;
+            p.distance = distance + (next.distance - distance) * t;
+            return p;
+        }
+    };
+
+    enum { YAW, PITCH, DISTANCE, CENTER_X, CENTER_Y, CENTER_Z, COUNT };
+
+    // ~90% of the way in a quarter second
+    static float omega() { return 9.0f; }
+
+    static glm::vec3 direction(float yawDegrees, float pitchDegrees)
+    {
+        const float yaw = glm::radians(yawDegrees), pitch = glm::radians(pitchDegrees);
+        return glm::vec3(std::cos(pitch) * std::sin(yaw), std::sin(pitch), std::cos(pitch) * std::cos(yaw));
+    }
+
+    Pose currentPose() const
+    {
+        Pose p;
+        p.center = glm::vec3(state[CENTER_X].value, state[CENTER_Y].value, state[CENTER_Z].value);
+        p.yaw = state[YAW].value;
+        p.pitch = state[PITCH].value;
+        p.distance = state[DISTANCE].value;
+        return p;
+    }
+
+    void step(float dt)
+    {
+        state[YAW].goal += spin * dt;
+        bool resting = true;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            state[i].step(dt, omega());
+            // angles in degrees; lengths relative to the model's size
+            const float scale = i == YAW || i == PITCH ? 1.0f : radius;
+            if (std::fabs(state[i].value - state[i].goal) > 1e-3f * scale || std::fabs(state[i].velocity) > 1e-2f * scale)
+                resting = false;
+        }
+        if (resting && spin == 0.0f)
+        {
+            for (int i = 0; i < COUNT; ++i)
+                state[i].snap();
+            isSettled = true;
+        }
+    }
+
+    bool enabled = false;
+    bool focused = false;
+    bool isSettled = true;
+    float spin = 0.0f; // turntable degrees per second
+    float radius = 1.0f;
+    float accumulator = 0.0f;
+    Spring state[COUNT];
+    Pose previous = Pose();
+    // the last pose update() gave the camera
+    glm::vec3 lookedAt = glm::vec3(0.0f);
+    bool placed = false;
+};
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef PATH_TRACER_H
+#define PATH_TRACER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <gl_state.h>
+#include <gpu_scene_bvh.h>
+#include <model.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// Reference renderer for final images (PATH_TRACE=1): a progressive path tracer in compute shaders over the
+// same scene, so hero shots come from the loaded assets instead of an export to an offline renderer.
+//   - the shown meshes, blended ones included, go to the GPU as a GpuSceneBvh, with their material table
+//     entries (the selected variant and MaterialOverrides such as the picked paint)
+//   - shaders/path_trace.comp traces PATH_TRACE_SPP (default 4) paths per pixel and frame, up to
+//     PATH_TRACE_BOUNCES (default 6) bounces, through the glTF metallic-roughness model with specular colour,
+//     clear coat and thin-walled transmission, lit by the environment cube map (the EXR / HDR the IBL was
+//     baked from, unfiltered) and the sun, and folds them into a float32 mean until PATH_TRACE_SAMPLES
+//     (default 256) are in. Light after the first bounce is clamped to PATH_TRACE_CLAMP (default 20) against
+//     fireflies from small bright spots of the environment, which paths only find by chance.
+//   - PATH_TRACE_DENOISE=1 filters the mean with an edge-avoiding a-trous filter guided by the first
+//     surfaces' albedo, normal and distance (shaders/path_denoise.comp), for previews at low sample counts
+// Like STILL=1 it only runs while the view and scene hold still, the ordinary raster frame showing while
+// they move; its image then replaces the frame in the tone map (and EXR captures). Batch shots and poster
+// tiles restart it and render until it converged (requiredFrames()). Materials use their factors only:
+// textures live in per-model arrays that one pass can't sample across models, and the clustered local
+// lights aren't traced. Needs compute shaders (GL 4.3) and the triangle trees, which PATH_TRACE=1 has the
+// models build at load.
+class PathTracer
+{
+public:
+    // the environment cube map during render(): the unit main rebinds the prefiltered map on every frame
+    static const unsigned int UNIT_ENVIRONMENT = 11;
+    // the denoiser's inputs, the same units as TemporalAA::resolve()
+    static const unsigned int UNIT_COLOR = 17;
+    static const unsigned int UNIT_ALBEDO = 18;
+    static const unsigned int UNIT_NORMAL = 19;
+
+    // `shaderDir` holds path_trace.comp, path_denoise.comp and bvh_trace.glsl
+    explicit PathTracer(const std::string &shaderDir)
+        : shaderDir(shaderDir), sceneBvh("path tracer")
+    {
+        if (const char *env = std::getenv("PATH_TRACE_SAMPLES"))
+            maxSamples = (unsigned int)std::max(1, std::atoi(env));
+        if (const char *env = std::getenv("PATH_TRACE_SPP"))
+            samplesPerFrame = (unsigned int)std::max(1, std::atoi(env));
+        if (const char *env = std::getenv("PATH_TRACE_BOUNCES"))
+            maxBounces = std::max(1, std::atoi(env));
+        if (const char *env = std::getenv("PATH_TRACE_CLAMP"))
+            maxIndirect = std::max(0.01f, (float)std::atof(env));
+        const char *denoise = std::getenv("PATH_TRACE_DENOISE");
+        denoising = denoise && std::strcmp(denoise, "1") == 0;
+    }
+
+    PathTracer(const PathTracer &) = delete;
+    PathTracer &operator=(const PathTracer &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("PATH_TRACE");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    // GL thread: compiles the passes where compute shaders exist
+    void init()
+    {
+        if (!ComputeShader::supported())
+        {
+            LOG_INFO("[PathTracer] Needs compute shaders (GL 4.3), no path tracing");
+            return;
+        }
+        const std::string library = shaderDir + "/bvh_trace.glsl";
+        program.reset(new ComputeShader((shaderDir + "/path_trace.comp").c_str(), library.c_str()));
+        if (!program->valid())
+        {
+            program.reset();
+            return;
+        }
+        if (denoising)
+        {
+            denoiser.reset(new ComputeShader((shaderDir + "/path_denoise.comp").c_str()));
+            if (!denoiser->valid())
+                denoiser.reset();
+        }
+        sceneBvh.init();
+        LOG_INFO("[PathTracer] " << maxSamples << " samples per pixel, " << samplesPerFrame << " per frame, " << maxBounces << " bounces"
+                                 << (denoiser ? ", denoised" : ""));
+    }
+
+    bool ready() const { return (bool)program; }
+
+    // frames a batch shot or poster tile needs for a converged image: the ordinary first frame after the cut,
+    // the one that finds the view still, then the samples
+    int requiredFrames() const { return 2 + (int)((maxSamples + samplesPerFrame - 1) / samplesPerFrame); }
+
+    // once per frame before render(): the instances are collected anew from the models added after this
+    void beginScene() { sceneBvh.beginScene(); }
+
+    // the shown meshes of `model` (with triangle trees) at `worldMatrix`
+    void addModel(const Model &model, const glm::mat4 &worldMatrix)
+    {
+        if (ready())
+            sceneBvh.addModel(model, worldMatrix, true);
+    }
+
+    // once per frame before the scene renders, as StillAccumulator::update(): `viewProjection` unjittered,
+    // `sceneStill` when no model, light or environment changed since the last frame. Returns whether this
+    // frame traces.
+    bool update(const glm::mat4 &viewProjection, bool sceneStill)
+    {
+        if (!ready())
+            return false;
+        const bool still = sceneStill && hasView && viewProjection == lastViewProjection;
+        lastViewProjection = viewProjection;
+        hasView = true;
+        if (!still)
+        {
+            if (samples > 0)
+                LOG_DEBUG("[PathTracer] View changed after " << samples << " samples");
+            samples = 0;
+        }
+        tracingFrame = still;
+        return tracingFrame;
+    }
+
+    // restarts the image (camera cuts); the next frame is an ordinary one again
+    void reset()
+    {
+        hasView = false;
+        samples = 0;
+        tracingFrame = false;
+    }
+
+    // this frame traces (after the models were added): the view holds still and there is something to trace
+    bool tracing() const { return tracingFrame && !sceneBvh.empty(); }
+    bool converged() const { return samples >= maxSamples; }
+    unsigned int sampleCount() const { return samples; }
+
+    // GL thread, after the scene: traces this frame's samples for `viewProjection` (unjittered; a poster
+    // tile's slice) from `cameraPosition`, lit by `environment` (cube map) and the sun along `sunDirection`,
+    // and returns the image (`width` x `height`, valid until the next call), or 0 when nothing traces.
+    // Past PATH_TRACE_SAMPLES the image is returned as is.
+    GLuint render(int width, int height, const glm::mat4 &viewProjection, const glm::vec3 &cameraPosition, const glm::vec3 &sunDirection,
+                  GLuint environment)
+    {
+        if (!tracingFrame || sceneBvh.empty() || !environment || width <= 0 || height <= 0)
+            return 0;
+        createTargets(width, height);
+        if (converged())
+            return output;
+        sceneBvh.upload();
+        const unsigned int count = std::min(samplesPerFrame, maxSamples - samples);
+        program->use();
+        program->setInt("environmentMap", (int)UNIT_ENVIRONMENT);
+        program->setMat4("inverseViewProjection", glm::inverse(viewProjection));
+        program->setVec3("cameraPosition", cameraPosition);
+        program->setVec3("sunDirection", sunDirection);
+        program->setUint("sampleIndex", samples);
+        program->setUint("samplesThisFrame", count);
+        program->setInt("maxBounces", maxBounces);
+        program->setFloat("maxIndirect", maxIndirect);
+        glState().bindTexture(UNIT_ENVIRONMENT, GL_TEXTURE_CUBE_MAP, environment);
+        sceneBvh.bind();
+        glBindImageTexture(0, accumulation, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA32F);
+        glBindImageTexture(1, guides[0], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
+        glBindImageTexture(2, guides[1], 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
+        glDispatchCompute((GLuint)(width + 7) / 8, (GLuint)(height + 7) / 8, 1);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        for (GLuint unit = 0; unit < 3; ++unit)
+            glBindImageTexture(unit, 0, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA16F);
+        samples += count;
+        output = denoiser ? denoise(width, height) : accumulation;
+        if (converged())
+            LOG_INFO("[PathTracer] Converged at " << samples << " samples");
+        return output;
+    }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        sceneBvh.releaseGpu();
+        program.reset();
+        denoiser.reset();
+        tracingFrame = false;
+        glState().invalidate();
+    }
+
+private:
+    // a-trous passes: taps 1, 2, 4, 8 and 16 texels apart
+    static const int DENOISE_PASSES = 5;
+
+    std::string shaderDir;
+    GpuSceneBvh sceneBvh;
+    std::unique_ptr<ComputeShader> program, denoiser;
+    unsigned int maxSamples = 256;
+    unsigned int samplesPerFrame = 4;
+    int maxBounces = 6;
+    float maxIndirect = 20.0f;
+    bool denoising = false;
+    unsigned int samples = 0;
+    bool tracingFrame = false;
+    bool hasView = false;
+    glm::mat4 lastViewProjection = glm::mat4(1.0f);
+    // float32 mean (a half-float one would stop moving at hundreds of samples), the guides' means (albedo;
+    // normal and distance), the denoiser's ping-pong targets and what render() returned last
+    GLuint accumulation = 0;
+    GLuint guides[2] = {0, 0};
+    GLuint filtered[2] = {0, 0};
+    GLuint output = 0;
+    int targetWidth = 0, targetHeight = 0;
+
+    GLuint denoise(int width, int height)
+    {
+        denoiser->use();
+        denoiser->setInt("colorMap", (int)UNIT_COLOR);
+        denoiser->setInt("albedoMap", (int)UNIT_ALBEDO);
+        denoiser->setInt("normalMap", (int)UNIT_NORMAL);
+        denoiser->setFloat("normalPhi", 64.0f);
+        denoiser->setFloat("distancePhi", 0.02f);
+        glState().bindTexture(UNIT_ALBEDO, GL_TEXTURE_2D, guides[0]);
+        glState().bindTexture(UNIT_NORMAL, GL_TEXTURE_2D, guides[1]);
+        // the colour tolerance shrinks with the noise (1 / sqrt(samples)) and with each wider pass
+        float colorPhi = 4.0f / std::sqrt((float)samples);
+        GLuint source = accumulation;
+        for (int pass = 0; pass < DENOISE_PASSES; ++pass)
+        {
+            const GLuint target = filtered[pass & 1];
+            denoiser->setInt("stepWidth", 1 << pass);
+            denoiser->setInt("demodulate", pass == 0 ? 1 : 0);
+            denoiser->setInt("remodulate", pass == DENOISE_PASSES - 1 ? 1 : 0);
+            denoiser->setFloat("colorPhi", colorPhi);
+            glState().bindTexture(UNIT_COLOR, GL_TEXTURE_2D, source);
+            glBindImageTexture(0, target, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+            glDispatchCompute((GLuint)(width + 7) / 8, (GLuint)(height + 7) / 8, 1);
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+            source = target;
+            colorPhi *= 0.5f;
+        }
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        return source;
+    }
+
+    static GLuint createTarget(GLenum format, int width, int height)
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+        // linear: the tone map stretches it over the window under dynamic resolution
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    void createTargets(int width, int height)
+    {
+        if (accumulation && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        samples = 0;
+        accumulation = createTarget(GL_RGBA32F, width, height);
+        guides[0] = createTarget(GL_RGBA16F, width, height);
+        guides[1] = createTarget(GL_RGBA16F, width, height);
+        if (denoiser)
+        {
+            filtered[0] = createTarget(GL_RGBA16F, width, height);
+            filtered[1] = createTarget(GL_RGBA16F, width, height);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTargets()
+    {
+        GLuint *textures[] = {&accumulation, &guides[0], &guides[1], &filtered[0], &filtered[1]};
+        for (GLuint *t : textures)
+            if (*t)
+            {
+                glDeleteTextures(1, t);
+                *t = 0;
+            }
+        output = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
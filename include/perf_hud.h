@@ -0,0 +1,406 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <frame_trace.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <hud_font.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// In-app performance overlay (O toggles it, PERF_HUD=1 starts with it on). Top left: frame rate, CPU and
+// GPU frame time with graphs of the last HISTORY frames (the line marks 16.7 ms), draw calls, triangles,
+// state changes (GL_STATS builds), culled meshes, video memory (GpuMemory and the driver) and loader progress. The numbers are averaged over a quarter second so they
+// stay readable; the graphs move every frame.
+// Everything is quads of one small RGBA atlas (the 5x7 font plus a few solid palette texels the bars and
+// the panel sample), streamed into one buffer and drawn with debug_quad.vs in a single glDrawArrays.
+// No GL work at all while hidden. The GPU time and triangle count come from their own GL_TIMESTAMP and
+// GL_PRIMITIVES_GENERATED queries, read LATENCY frames later without waiting (late results are dropped);
+// the primitives query can't overlap Benchmark's, so the caller keeps the HUD off in benchmark runs.
+class PerfHud
+{
+public:
+    static const int HISTORY = 120; // frames in the graphs
+    static const int LATENCY = 4;   // frames between issuing a frame's queries and reading them
+
+    // what the caller knows about loading this frame
+    struct Status
+    {
+        size_t models = 0;          // models queued with the loader
+        size_t importing = 0;       // of those, still importing on the workers
+        size_t streaming = 0;       // drawable, textures still streaming
+        bool environmentBusy = false; // an environment decoding or baking
+        std::vector<std::string> extra; // lines of the debug modes (CullDebug::hudLines)
+    };
+
+    // `shaderDir` holds debug_quad.vs and hud_text.fs
+    explicit PerfHud(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        const char *env = std::getenv("PERF_HUD");
+        shown = env && std::string(env) == "1";
+    }
+
+    PerfHud(const PerfHud &) = delete;
+    PerfHud &operator=(const PerfHud &) = delete;
+
+    bool visible() const { return shown; }
+
+    void toggle()
+    {
+        shown = !shown;
+        // the graphs restart, the queries of the time it was hidden are long stale
+        frameStart = -1.0;
+        history = 0;
+        for (int k = 0; k < LATENCY; ++k)
+            slots[k].pending = false;
+        LOG_INFO("[HUD] " << (shown ? "ON" : "OFF"));
+    }
+
+    // GL thread, first thing every frame
+    void beginFrame()
+    {
+        if (!shown)
+            return;
+        const double now = FrameTrace::clockUs() * 1e-3;
+        frameMs = frameStart >= 0.0 ? now - frameStart : 0.0;
+        frameStart = now;
+        drawStats().reset();
+        if (!ensureGpu())
+            return;
+        Slot &slot = slots[frameIndex % LATENCY];
+        collect(slot);
+        glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+        glBeginQuery(GL_PRIMITIVES_GENERATED, slot.queries[2]);
+        inFrame = true;
+    }
+
+    // GL thread, after the scene, into the window framebuffer (`width` x `height` pixels)
+    void draw(int width, int height, const Status &status)
+    {
+        // the frame's queries close even when O hid the HUD since beginFrame()
+        if (!inFrame)
+            return;
+        inFrame = false;
+        Slot &slot = slots[frameIndex % LATENCY];
+        glEndQuery(GL_PRIMITIVES_GENERATED);
+        if (!shown || width <= 0 || height <= 0)
+            return;
+        const double cpuMs = FrameTrace::clockUs() * 1e-3 - frameStart;
+        const DrawStats frameStats = drawStats();
+        record(cpuMs, frameStats);
+        if (lineCount == 0 || FrameTrace::clockUs() * 1e-3 - windowStart >= REFRESH_MS)
+            refreshText(status);
+
+        build(width, height);
+        GLint polygonMode[2] = {GL_FILL, GL_FILL};
+        glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, width, height);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        shader->use();
+        static const Shader::UniformHandle uAtlas = Shader::uniformHandle("atlas");
+        shader->setInt(uAtlas, 0);
+        glState().bindTexture(0, GL_TEXTURE_2D, atlas);
+        glState().bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        // orphan and refill: the driver hands out fresh storage instead of waiting on last frame's draw
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(float), vertices.data());
+        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / FLOATS_PER_VERTEX));
+        drawStats().count();
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glPolygonMode(GL_FRONT_AND_BACK, (GLenum)polygonMode[0]);
+
+        glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+        slot.pending = true;
+        frameIndex++;
+    }
+
+    // GL thread: deletes the atlas, buffers and queries
+    void releaseGpu()
+    {
+        if (!gpuReady)
+            return;
+        glDeleteTextures(1, &atlas);
+        glDeleteBuffers(1, &vbo);
+        glDeleteVertexArrays(1, &vao);
+        for (int k = 0; k < LATENCY; ++k)
+            glDeleteQueries(3, slots[k].queries);
+        shader.reset();
+        atlas = vbo = vao = 0;
+        gpuReady = false;
+        glState().invalidate();
+    }
+
+private:
+    static const int FLOATS_PER_VERTEX = 4; // debug_quad.vs: vec2 aPos, vec2 aTexCoords (clip space)
+    static const int CELL_W = HudFont::GLYPH_WIDTH + 1, CELL_H = HudFont::GLYPH_HEIGHT + 1;
+    static const int ATLAS_COLUMNS = 16;
+    static const int ATLAS_W = ATLAS_COLUMNS * CELL_W;
+    static const int GLYPH_ROWS = HudFont::COUNT / ATLAS_COLUMNS;
+    static const int PALETTE_Y = GLYPH_ROWS * CELL_H; // one row of 8x8 solid swatches under the glyphs
+    static const int SWATCH = 8;
+    static const int ATLAS_H = PALETTE_Y + SWATCH;
+    static const int MAX_LINES = 12;
+    static const int LINE_CHARS = 48;
+    static const int GRAPH_HEIGHT = 32; // unscaled pixels; the top is 2 x BUDGET_MS
+    static constexpr double REFRESH_MS = 250.0;
+    static constexpr double BUDGET_MS = 1000.0 / 60.0;
+
+    enum Color { PANEL, CPU_BAR, GPU_BAR, OVER_BUDGET, BUDGET_LINE, GRAPH_BACK, COLOR_COUNT };
+
+    // one frame's queries in flight: begin / end timestamps, primitives generated
+    struct Slot
+    {
+        GLuint queries[3] = {0, 0, 0};
+        bool pending = false;
+    };
+
+    std::string shaderDir;
+    bool shown = false;
+    bool gpuReady = false;
+    bool inFrame = false; // between beginFrame() and draw(), the primitives query open
+    std::unique_ptr<Shader> shader;
+    GLuint atlas = 0, vao = 0, vbo = 0;
+    Slot slots[LATENCY];
+    unsigned long long frameIndex = 0;
+
+    double frameStart = -1.0, frameMs = 0.0;
+    // graphs: ring of the last HISTORY frames, `history` of them filled
+    double cpuHistory[HISTORY] = {}, gpuHistory[HISTORY] = {};
+    int historyHead = 0, history = 0;
+    double lastGpuMs = 0.0, lastPrimitives = 0.0;
+    // sums over the current text window
+    double windowStart = 0.0;
+    double sumFrame = 0.0, sumCpu = 0.0, sumGpu = 0.0, sumCalls = 0.0, sumDraws = 0.0, sumPrimitives = 0.0;
+    double sumMeshes = 0.0, sumCulled = 0.0;
+    double sumSubmitted = 0.0, sumProgramBinds = 0.0, sumTextureBinds = 0.0, sumVaoBinds = 0.0, sumUniforms = 0.0;
+    int windowFrames = 0, windowGpuFrames = 0;
+
+    char lines[MAX_LINES][LINE_CHARS + 1] = {};
+    int lineCount = 0;
+    std::vector<float> vertices;
+
+    // GL thread, first use only: the shader, atlas, buffer and queries
+    bool ensureGpu()
+    {
+        if (gpuReady)
+            return true;
+        shader.reset(new Shader((shaderDir + "/debug_quad.vs").c_str(), (shaderDir + "/hud_text.fs").c_str()));
+        glGenTextures(1, &atlas);
+        std::vector<unsigned char> texels(ATLAS_W * ATLAS_H * 4, 0);
+        for (int c = 0; c < HudFont::COUNT; ++c)
+            for (int y = 0; y < HudFont::GLYPH_HEIGHT; ++y)
+                for (int x = 0; x < HudFont::GLYPH_WIDTH; ++x)
+                {
+                    if (!(HudFont::ROWS[c][y] & (0x10 >> x)))
+                        continue;
+                    unsigned char *t = &texels[4 * ((c / ATLAS_COLUMNS * CELL_H + y) * ATLAS_W + c % ATLAS_COLUMNS * CELL_W + x)];
+                    t[0] = t[1] = t[2] = t[3] = 255;
+                }
+        static const unsigned char palette[COLOR_COUNT][4] = {
+            {0, 0, 0, 170},       // PANEL
+            {90, 210, 100, 255},  // CPU_BAR
+            {240, 160, 50, 255},  // GPU_BAR
+            {235, 60, 50, 255},   // OVER_BUDGET
+            {255, 255, 255, 140}, // BUDGET_LINE
+            {255, 255, 255, 28},  // GRAPH_BACK
+        };
+        for (int c = 0; c < COLOR_COUNT; ++c)
+            for (int y = 0; y < SWATCH; ++y)
+                for (int x = 0; x < SWATCH; ++x)
+                    std::memcpy(&texels[4 * ((PALETTE_Y + y) * ATLAS_W + c * SWATCH + x)], palette[c], 4);
+        glBindTexture(GL_TEXTURE_2D, atlas);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, ATLAS_W, ATLAS_H, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glState().invalidate();
+
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        glState().bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void *)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void *)(2 * sizeof(float)));
+        for (int k = 0; k < LATENCY; ++k)
+            glGenQueries(3, slots[k].queries);
+
+        gpuReady = true;
+        windowStart = FrameTrace::clockUs() * 1e-3;
+        return true;
+    }
+
+    // reads a slot issued LATENCY frames ago if the GPU is done with it; never waits
+    void collect(Slot &slot)
+    {
+        if (!slot.pending)
+            return;
+        slot.pending = false;
+        GLint ready = 0;
+        glGetQueryObjectiv(slot.queries[1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready)
+            return;
+        GLuint64 begin = 0, end = 0, primitives = 0;
+        glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &end);
+        glGetQueryObjectui64v(slot.queries[2], GL_QUERY_RESULT, &primitives);
+        lastGpuMs = end > begin ? (end - begin) * 1e-6 : 0.0;
+        lastPrimitives = (double)primitives;
+        sumGpu += lastGpuMs;
+        sumPrimitives += lastPrimitives;
+        windowGpuFrames++;
+        gpuHistory[historyHead] = lastGpuMs; // lands LATENCY frames behind the CPU bar, close enough for a graph
+    }
+
+    void record(double cpuMs, const DrawStats &stats)
+    {
+        cpuHistory[historyHead] = cpuMs;
+        historyHead = (historyHead + 1) % HISTORY;
+        history = std::min(history + 1, HISTORY);
+        sumFrame += frameMs;
+        sumCpu += cpuMs;
+        sumCalls += (double)stats.calls;
+        sumDraws += (double)stats.draws;
+        sumMeshes += (double)stats.meshes;
+        sumCulled += (double)stats.culled;
+        sumSubmitted += (double)stats.primitives;
+        sumProgramBinds += (double)stats.programBinds;
+        sumTextureBinds += (double)stats.textureBinds;
+        sumVaoBinds += (double)stats.vaoBinds;
+        sumUniforms += (double)stats.uniformUploads;
+        windowFrames++;
+    }
+
+    void refreshText(const Status &status)
+    {
+        const double n = std::max(windowFrames, 1), g = std::max(windowGpuFrames, 1);
+        const double frame = sumFrame / n;
+        lineCount = 0;
+        line("FPS %.0f  FRAME %.2f MS", frame > 0.0 ? 1000.0 / frame : 0.0, frame);
+        line("CPU %.2f MS", sumCpu / n);
+        line("GPU %.2f MS", windowGpuFrames ? sumGpu / g : 0.0);
+        line("DRAWS %.0f CALLS %.0f", sumDraws / n, sumCalls / n);
+        line("TRIS %.2fM  CULLED %.0f/%.0f MESHES", sumPrimitives / g * 1e-6, sumCulled / n, sumMeshes / n);
+#if GL_STATS
+        line("BINDS PROG %.0f TEX %.0f VAO %.0f  UNIF %.0f", sumProgramBinds / n, sumTextureBinds / n, sumVaoBinds / n, sumUniforms / n);
+        line("SUBMITTED %.2fM TRIS", sumSubmitted / n * 1e-6);
+#endif
+        const GpuMemory::Totals &memory = gpuMemory().totals();
+        line("VRAM %.0f MB  TEX %.0f GEO %.0f BUF %.0f ENV %.0f", GpuMemory::mb(memory.total()), GpuMemory::mb(memory.bytes[GpuMemory::MODEL_TEXTURES]),
+             GpuMemory::mb(memory.bytes[GpuMemory::MODEL_GEOMETRY]), GpuMemory::mb(memory.bytes[GpuMemory::DRAW_BUFFERS]),
+             GpuMemory::mb(memory.bytes[GpuMemory::ENVIRONMENT]));
+        const GpuMemory::DriverInfo driver = gpuMemory().queryDriver();
+        if (driver.totalKb)
+            line("DRIVER %u/%u MB USED", (unsigned)((driver.totalKb - std::min(driver.freeKb, driver.totalKb)) / 1024), (unsigned)(driver.totalKb / 1024));
+        else if (driver.source)
+            line("DRIVER %u MB FREE", (unsigned)(driver.freeKb / 1024));
+        if (status.importing + status.streaming == 0 && !status.environmentBusy)
+            line("LOADED %u MODELS", (unsigned)status.models);
+        else
+            line("LOADING %u/%u  IMPORT %u STREAM %u%s", (unsigned)(status.models - status.importing - status.streaming),
+                 (unsigned)status.models, (unsigned)status.importing, (unsigned)status.streaming, status.environmentBusy ? " ENV" : "");
+        for (size_t i = 0; i < status.extra.size(); ++i)
+            line("%s", status.extra[i].c_str());
+        windowStart = FrameTrace::clockUs() * 1e-3;
+        sumFrame = sumCpu = sumGpu = sumCalls = sumDraws = sumPrimitives = sumMeshes = sumCulled = 0.0;
+        sumSubmitted = sumProgramBinds = sumTextureBinds = sumVaoBinds = sumUniforms = 0.0;
+        windowFrames = windowGpuFrames = 0;
+    }
+
+    template <typename... Args>
+    void line(const char *format, Args... args)
+    {
+        if (lineCount < MAX_LINES)
+            std::snprintf(lines[lineCount++], LINE_CHARS + 1, format, args...);
+    }
+
+    // the panel: text lines, then the CPU and GPU graphs
+    void build(int width, int height)
+    {
+        vertices.clear();
+        const int scale = std::max(1, height / 540);
+        const int margin = 8, pad = 4 * scale, lineH = CELL_H * scale + scale;
+        const int graphW = HISTORY * scale, graphH = GRAPH_HEIGHT * scale;
+        const int textW = LINE_CHARS * CELL_W * scale;
+        const int panelW = std::max(textW, graphW) + 2 * pad;
+        const int panelH = lineCount * lineH + 2 * (graphH + pad) + 2 * pad;
+        solid(width, height, margin, margin, panelW, panelH, PANEL);
+
+        int y = margin + pad;
+        for (int l = 0; l < lineCount; ++l, y += lineH)
+            text(width, height, margin + pad, y, scale, lines[l]);
+        graph(width, height, margin + pad, y + pad, scale, graphH, cpuHistory, CPU_BAR);
+        graph(width, height, margin + pad, y + 2 * pad + graphH, scale, graphH, gpuHistory, GPU_BAR);
+    }
+
+    void text(int width, int height, int x, int y, int scale, const char *s)
+    {
+        for (; *s; ++s, x += CELL_W * scale)
+        {
+            int c = (unsigned char)*s;
+            if (c >= 'a' && c <= 'z')
+                c -= 'a' - 'A';
+            c -= HudFont::FIRST;
+            if (c <= 0 || c >= HudFont::COUNT) // spaces and anything the font lacks stay empty
+                continue;
+            const int tx = c % ATLAS_COLUMNS * CELL_W, ty = c / ATLAS_COLUMNS * CELL_H;
+            quad(width, height, x, y, HudFont::GLYPH_WIDTH * scale, HudFont::GLYPH_HEIGHT * scale,
+                 (float)tx / ATLAS_W, (float)ty / ATLAS_H, (float)(tx + HudFont::GLYPH_WIDTH) / ATLAS_W,
+                 (float)(ty + HudFont::GLYPH_HEIGHT) / ATLAS_H);
+        }
+    }
+
+    // oldest frame left; bar height in ms, 2 x BUDGET_MS at the top
+    void graph(int width, int height, int x, int y, int scale, int graphH, const double *samples, Color color)
+    {
+        solid(width, height, x, y, HISTORY * scale, graphH, GRAPH_BACK);
+        for (int i = 0; i < history; ++i)
+        {
+            const double ms = samples[(historyHead - history + i + HISTORY) % HISTORY];
+            const int h = std::min(graphH, (int)(ms / (2.0 * BUDGET_MS) * graphH + 0.5));
+            if (h > 0)
+                solid(width, height, x + (HISTORY - history + i) * scale, y + graphH - h, scale, h, ms > BUDGET_MS ? OVER_BUDGET : color);
+        }
+        solid(width, height, x, y + graphH / 2, HISTORY * scale, std::max(1, scale / 2), BUDGET_LINE);
+    }
+
+    void solid(int width, int height, int x, int y, int w, int h, Color color)
+    {
+        const float u = (color * SWATCH + SWATCH * 0.5f) / ATLAS_W, v = (PALETTE_Y + SWATCH * 0.5f) / ATLAS_H;
+        quad(width, height, x, y, w, h, u, v, u, v);
+    }
+
+    // pixel rectangle (origin top left) -> two clip-space triangles, counter-clockwise like the debug quad
+    void quad(int width, int height, int x, int y, int w, int h, float u0, float v0, float u1, float v1)
+    {
+        const float x0 = 2.0f * x / width - 1.0f, x1 = 2.0f * (x + w) / width - 1.0f;
+        const float y0 = 1.0f - 2.0f * y / height, y1 = 1.0f - 2.0f * (y + h) / height;
+        const float corners[6][4] = {
+            {x0, y0, u0, v0}, {x0, y1, u0, v1}, {x1, y1, u1, v1},
+            {x0, y0, u0, v0}, {x1, y1, u1, v1}, {x1, y0, u1, v0},
+        };
+        vertices.insert(vertices.end(), &corners[0][0], &corners[0][0] + 6 * FLOATS_PER_VERTEX);
+    }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef POSTER_RENDERER_H
+#define POSTER_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <image_writer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Print-size stills beyond GL_MAX_RENDERBUFFER_SIZE and GPU memory (POSTER=<width>x<height>). The image is
+// cut into POSTER_TILE (default 2048) pixel squares. Each tile renders through an off-centre slice of the
+// camera's frustum (tileProjection(): the full projection rescaled so the tile's part of NDC fills the
+// frame) into one reusable tile-sized framebuffer; edge tiles render whole and are cropped on readback.
+// A row of tiles is read into a band buffer and streamed into POSTER_OUTPUT (poster.png) through PngStream
+// top row first, so memory holds one band (image width x tile height), never the image. Each tile renders
+// POSTER_SETTLE frames (default 1; shadows and the TAA history restart per tile) and the app exits after
+// the last one. PNG only: tinyexr's tiled EXR writer needs every tile in memory at once.
+class PosterRenderer
+{
+public:
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("POSTER");
+        return env && *env;
+    }
+
+    PosterRenderer()
+    {
+        if (!enabledByEnv())
+            return;
+        if (std::sscanf(std::getenv("POSTER"), "%dx%d", &imageWidth, &imageHeight) != 2 || imageWidth <= 0 || imageHeight <= 0)
+        {
+            LOG_ERROR("[Poster] POSTER wants <width>x<height>, e.g. 16384x9216");
+            return;
+        }
+#if !defined(HAS_MINIZ)
+        LOG_ERROR("[Poster] Needs miniz in the build for the streaming PNG writer");
+        return;
+#endif
+        if (const char *t = std::getenv("POSTER_TILE"))
+            tile = std::max(64, std::atoi(t));
+        if (const char *s = std::getenv("POSTER_SETTLE"))
+            settleFrames = std::max(1, std::atoi(s));
+        if (const char *o = std::getenv("POSTER_OUTPUT"))
+            path = o;
+        if (const char *l = std::getenv("CAPTURE_PNG_LEVEL"))
+            pngLevel = std::min(10, std::max(0, std::atoi(l)));
+        columns = (imageWidth + tile - 1) / tile;
+        rows = (imageHeight + tile - 1) / tile;
+        active = true;
+        LOG_INFO("[Poster] " << imageWidth << "x" << imageHeight << " in " << columns << "x" << rows << " tiles of " << tile
+                             << " px to " << path);
+    }
+
+    PosterRenderer(const PosterRenderer &) = delete;
+    PosterRenderer &operator=(const PosterRenderer &) = delete;
+
+    bool enabled() const { return active; }
+    bool finished() const { return phase == DONE; }
+
+    // GL thread, first thing every frame; `sceneReady` once nothing is loading or baking any more
+    void beginFrame(bool sceneReady)
+    {
+        if (!active || phase == DONE)
+            return;
+        tileStart = false;
+        if (phase == LOADING)
+        {
+            if (!sceneReady)
+                return;
+            GLint maxSize = 0;
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+            if (tile > maxSize)
+            {
+                LOG_WARN("[Poster] POSTER_TILE " << tile << " above GL_MAX_TEXTURE_SIZE, using " << maxSize);
+                tile = maxSize;
+                columns = (imageWidth + tile - 1) / tile;
+                rows = (imageHeight + tile - 1) / tile;
+            }
+#if defined(HAS_MINIZ)
+            if (!png.open(path, imageWidth, imageHeight, pngLevel))
+            {
+                LOG_ERROR("[Poster] Can't write " << path);
+                phase = DONE;
+                return;
+            }
+#endif
+            band.assign((size_t)imageWidth * tile * 4, 0);
+            phase = RENDER;
+            index = 0;
+            frame = 0;
+            tileStart = true;
+        }
+        else if (frame == settleFrames)
+        {
+            frame = 0;
+            if (++index == columns * rows)
+            {
+                finish();
+                return;
+            }
+            tileStart = true;
+        }
+    }
+
+    void endFrame()
+    {
+        if (active && phase == RENDER)
+            ++frame;
+    }
+
+    bool rendering() const { return active && phase == RENDER; }
+    // the first frame of a tile: a camera cut for temporal effects
+    bool tileStarted() const { return tileStart; }
+    // the frame to read back into the band
+    bool capturing() const { return rendering() && frame + 1 == settleFrames; }
+
+    // tiles render at least `frames` frames whatever POSTER_SETTLE asks (PathTracer must converge first)
+    void requireFrames(int frames)
+    {
+        if (active && settleFrames < frames)
+            LOG_INFO("[Poster] " << frames << " frames per tile (instead of " << settleFrames << ")");
+        settleFrames = std::max(settleFrames, frames);
+    }
+
+    // every tile renders at the full tile size, edge tiles included
+    int tileSize() const { return tile; }
+    float aspect() const { return (float)imageWidth / (float)imageHeight; }
+
+    // the current tile's slice of `projection` (the whole poster's, at aspect()): tile x covers NDC
+    // [x0, x1] of the full frame, which the slice stretches to [-1, 1]; rows count from the top
+    glm::mat4 tileProjection(const glm::mat4 &projection) const
+    {
+        const int column = index % columns, row = index / columns;
+        const float x0 = -1.0f + 2.0f * column * tile / imageWidth, x1 = -1.0f + 2.0f * (column + 1) * tile / imageWidth;
+        const float y1 = 1.0f - 2.0f * row * tile / imageHeight, y0 = 1.0f - 2.0f * (row + 1) * tile / imageHeight;
+        glm::mat4 slice(1.0f);
+        slice[0][0] = 2.0f / (x1 - x0);
+        slice[1][1] = 2.0f / (y1 - y0);
+        slice[3][0] = -(x1 + x0) / (x1 - x0);
+        slice[3][1] = -(y1 + y0) / (y1 - y0);
+        return slice * projection;
+    }
+
+    // GL thread: the tile framebuffer the frame resolves into
+    GLuint outputFramebuffer()
+    {
+        if (fbo)
+            return fbo;
+        glGenTextures(1, &colorTexture);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, tile, tile, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return fbo;
+    }
+
+    // GL thread, on capturing() frames after the resolve into outputFramebuffer(): copies the tile's
+    // visible part into the band, and streams the band out after its last tile. The read is synchronous;
+    // one stall per tile is noise next to rendering at poster sizes.
+    void readTile()
+    {
+        const int column = index % columns, row = index / columns;
+        const int visibleWidth = std::min(tile, imageWidth - column * tile);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glPixelStorei(GL_PACK_ROW_LENGTH, imageWidth);
+        // band rows stay in GL order (bottom-up within the band)
+        glReadPixels(0, 0, visibleWidth, tile, GL_RGBA, GL_UNSIGNED_BYTE, &band[(size_t)column * tile * 4]);
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        if (column + 1 < columns)
+            return;
+#if defined(HAS_MINIZ)
+        // tile row `row` holds image rows row * tile .. ; the ones past the bottom edge are dropped
+        const int visibleRows = std::min(tile, imageHeight - row * tile);
+        for (int y = 0; y < visibleRows; ++y)
+            png.writeRow(&band[(size_t)(tile - 1 - y) * imageWidth * 4]);
+#endif
+        LOG_INFO("[Poster] Tile row " << row + 1 << "/" << rows << " written");
+    }
+
+    void releaseGpu()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorTexture) glDeleteTextures(1, &colorTexture);
+        fbo = colorTexture = 0;
+    }
+
+private:
+    enum Phase { LOADING, RENDER, DONE };
+
+    bool active = false;
+    Phase phase = LOADING;
+    int imageWidth = 0, imageHeight = 0;
+    int tile = 2048;
+    int settleFrames = 1;
+    int pngLevel = 6;
+    std::string path = "poster.png";
+    int columns = 0, rows = 0;
+    int index = 0; // current tile, row-major from the top left
+    int frame = 0;
+    bool tileStart = false;
+    std::vector<unsigned char> band;
+#if defined(HAS_MINIZ)
+    PngStream png;
+#endif
+    GLuint fbo = 0, colorTexture = 0;
+
+    void finish()
+    {
+        phase = DONE;
+#if defined(HAS_MINIZ)
+        if (png.close())
+            LOG_INFO("[Poster] Saved " << path);
+        else
+            LOG_ERROR("[Poster] Failed writing " << path);
+#endif
+        std::vector<unsigned char>().swap(band);
+    }
+};
+
+#endif
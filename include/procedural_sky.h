@@ -0,0 +1,86 @@
+#ifndef PROCEDURAL_SKY_H
+#define PROCEDURAL_SKY_H
+
+#include <glm/glm.hpp>
+
+#include <atmosphere_model.h>
+#include <spherical_harmonics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// HDR sky used when no EXR is available: by default a physically based atmosphere (AtmosphereModel, read
+// on the GPU from Atmosphere's LUTs) whose colour follows the sun from noon to dusk, with SKY_MODEL=gradient
+// the old vertical gradient plus a sun lobe. The cube faces are rendered on the GPU by
+// shaders/procedural_sky.fs (see EnvironmentLoader::loadProcedural) and go through the same mip +
+// prefilter bake as an EXR; radiance() is its CPU twin for the diffuse SH projection.
+struct ProceduralSky
+{
+    glm::vec3 sunDirection = glm::normalize(glm::vec3(0.5f, 0.8f, 0.3f));
+    float sunIntensity = 6.0f;
+    float sunPower = 64.0f; // gradient: lobe exponent, higher = smaller sun
+    bool atmosphere = atmosphereByEnv();
+
+    static bool atmosphereByEnv()
+    {
+        const char *env = std::getenv("SKY_MODEL");
+        return !(env && std::strcmp(env, "gradient") == 0);
+    }
+
+    // keep in sync with procedural_sky.fs. The atmosphere's sun disk is left out: it is far smaller than
+    // the SH can resolve, and the shaders' directional sun light already lights the diffuse term with it.
+    glm::vec3 radiance(const glm::vec3 &dir) const
+    {
+        if (atmosphere)
+            return AtmosphereModel::skyRadiance(dir, sunDirection) * (sunIntensity * AtmosphereModel::ILLUMINANCE_SCALE);
+        float t = glm::clamp(dir.y * 0.5f + 0.5f, 0.0f, 1.0f);
+        glm::vec3 sky = glm::mix(glm::vec3(0.02f), glm::vec3(0.6f, 0.7f, 0.9f), t);
+        float sun = std::pow(glm::max(glm::dot(dir, sunDirection), 0.0f), sunPower) * sunIntensity;
+        return sky + glm::vec3(sun);
+    }
+
+    // diffuse SH of the sky, integrated over `faceSize`^2 texels per cube face (finished, shader-ready).
+    // The sky is smooth and the SH band-limited, so a coarse grid matches the rendered faces; the
+    // atmosphere, marched per texel, uses at most 32^2.
+    SHIrradiance irradiance(int faceSize = 64) const
+    {
+        if (atmosphere)
+            faceSize = std::min(faceSize, 32);
+        SHIrradiance sh;
+        for (int face = 0; face < 6; ++face)
+            for (int y = 0; y < faceSize; ++y)
+                for (int x = 0; x < faceSize; ++x)
+                {
+                    float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+                    float v = 2.0f * (y + 0.5f) / faceSize - 1.0f;
+                    glm::vec3 dir = glm::normalize(cubeDirection(face, u, v));
+                    sh.add(dir, radiance(dir), SHIrradiance::cubeTexelSolidAngle(x, y, faceSize));
+                }
+        sh.finish();
+        return sh;
+    }
+
+    // direction through (u, v) in [-1, 1]^2 of GL cube face `face`
+    static glm::vec3 cubeDirection(int face, float u, float v)
+    {
+        switch (face)
+        {
+        case 0:
+            return glm::vec3(1.0f, -v, -u); // +X
+        case 1:
+            return glm::vec3(-1.0f, -v, u); // -X
+        case 2:
+            return glm::vec3(u, 1.0f, v); // +Y
+        case 3:
+            return glm::vec3(u, -1.0f, -v); // -Y
+        case 4:
+            return glm::vec3(u, -v, 1.0f); // +Z
+        default:
+            return glm::vec3(-u, -v, -1.0f); // -Z
+        }
+    }
+};
+
+#endif
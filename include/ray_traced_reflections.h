@@ -0,0 +1,254 @@
+#ifndef RAY_TRACED_REFLECTIONS_H
+#define RAY_TRACED_REFLECTIONS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <gl_state.h>
+#include <gpu_scene_bvh.h>
+#include <model.h>
+#include <screen_space_reflections.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// RT_REFLECTIONS=1: glossy reflections traced through the triangle trees (TriangleBVH, built at load as for
+// TRIANGLE_PICKING) in a compute pass, so the paint reflects what is off screen or hidden too, which SSR
+// can't:
+//   - the shown opaque meshes go to the GPU as a GpuSceneBvh (the trees once, the placed instances with their
+//     materials each frame)
+//   - shaders/rt_reflections.comp, at half resolution over a copy of the opaque depth, finds each pixel's
+//     surface with a short ray around its depth and, where its material is at most RT_ROUGHNESS (default
+//     0.3) rough, traces one ray from its GGX lobe up to RT_DISTANCE (world units, default 20). Hits are lit
+//     by the environment from their material factors (no textures, direct lights or shadows); misses leave
+//     the environment and probes to the scene shader.
+//   - the result is blended into last frame's where this pixel's surface was on screen then (RT_HISTORY,
+//     default 0.9, is the history's share), so the lobe converges over a few frames
+// It takes the place of SSR (the same texture unit and the scene shader's reflection hook) and needs what
+// SSR needs (the HDR target, the opaque depth first) and compute shaders (GL 4.3).
+class RayTracedReflections
+{
+public:
+    // texture unit of the traced radiance in the scene shaders (reflectionHits); the pass itself reads the
+    // two depth copies on it and the next one
+    static const unsigned int UNIT = ScreenSpaceReflections::UNIT_HITS;
+    static const unsigned int UNIT_PREVIOUS_DEPTH = ScreenSpaceReflections::UNIT_HISTORY;
+    // the prefiltered environment main binds for the scene shaders
+    static const unsigned int UNIT_ENVIRONMENT = 11;
+
+    // `shaderDir` holds rt_reflections.comp and bvh_trace.glsl
+    explicit RayTracedReflections(const std::string &shaderDir)
+        : shaderDir(shaderDir), sceneBvh("rt reflection")
+    {
+        if (const char *env = std::getenv("RT_DISTANCE"))
+            maxDistance = std::max(0.1f, (float)std::atof(env));
+        if (const char *env = std::getenv("RT_ROUGHNESS"))
+            maxRoughness = glm::clamp((float)std::atof(env), 0.01f, 1.0f);
+        if (const char *env = std::getenv("RT_HISTORY"))
+            historyWeight = glm::clamp((float)std::atof(env), 0.0f, 0.98f);
+    }
+
+    RayTracedReflections(const RayTracedReflections &) = delete;
+    RayTracedReflections &operator=(const RayTracedReflections &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("RT_REFLECTIONS");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the pass where compute shaders exist
+    void init()
+    {
+        if (!ComputeShader::supported())
+        {
+            LOG_INFO("[RTReflections] Needs compute shaders (GL 4.3), no ray-traced reflections");
+            return;
+        }
+        program.reset(new ComputeShader((shaderDir + "/rt_reflections.comp").c_str(), (shaderDir + "/bvh_trace.glsl").c_str()));
+        if (!program->valid())
+        {
+            program.reset();
+            return;
+        }
+        sceneBvh.init();
+        usable = true;
+        LOG_INFO("[RTReflections] Half-resolution BVH reflections up to roughness " << maxRoughness << ", rays up to " << maxDistance);
+    }
+
+    bool ready() const { return usable && program; }
+
+    // once per frame before trace(): the instances are collected anew from the models added after this
+    void beginScene() { sceneBvh.beginScene(); }
+
+    // the shown opaque meshes of `model` (with triangle trees) at `worldMatrix`
+    void addModel(const Model &model, const glm::mat4 &worldMatrix)
+    {
+        if (ready())
+            sceneBvh.addModel(model, worldMatrix, false);
+    }
+
+    // GL thread, with the scene framebuffer (ToneMapper's HDR target, `width` x `height`) holding the opaque
+    // depth: traces this frame's rays for `viewProjection` from `cameraPosition` and blends them with last
+    // frame's, seen through the unjittered `previousViewProjection`. `prefilterMaxMip` is the last mip of the
+    // prefiltered environment bound on UNIT_ENVIRONMENT. The scene framebuffer and its viewport are bound
+    // again afterwards. False (no traced reflections this frame) with nothing to trace or unusable targets.
+    bool trace(int width, int height, const glm::mat4 &viewProjection, const glm::mat4 &previousViewProjection, const glm::vec3 &cameraPosition,
+               float prefilterMaxMip)
+    {
+        traced = false;
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!ready() || sceneBvh.empty() || !scene || width <= 0 || height <= 0)
+            return false;
+        createTargets(std::max(1, width / 2), std::max(1, height / 2));
+        if (!usable)
+            return false;
+        sceneBvh.upload();
+
+        const int current = frame & 1, previous = current ^ 1;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthFbo[current]);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, targetWidth, targetHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+
+        program->use();
+        program->setInt("depthMap", (int)UNIT);
+        program->setInt("previousDepthMap", (int)UNIT_PREVIOUS_DEPTH);
+        program->setInt("prefilteredMap", (int)UNIT_ENVIRONMENT);
+        program->setFloat("prefilterMaxMip", prefilterMaxMip);
+        program->setMat4("inverseViewProjection", glm::inverse(viewProjection));
+        program->setMat4("previousViewProjection", previousViewProjection);
+        program->setMat4("inversePreviousViewProjection", glm::inverse(previousViewProjection));
+        program->setVec3("cameraPosition", cameraPosition);
+        program->setFloat("maxDistance", maxDistance);
+        program->setFloat("maxRoughness", maxRoughness);
+        program->setFloat("historyWeight", historyValid ? historyWeight : 0.0f);
+        program->setUint("frameIndex", frame);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, depthTexture[current]);
+        glState().bindTexture(UNIT_PREVIOUS_DEPTH, GL_TEXTURE_2D, depthTexture[previous]);
+        sceneBvh.bind();
+        glBindImageTexture(0, radianceTexture[current], 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        glBindImageTexture(1, radianceTexture[previous], 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA16F);
+        glDispatchCompute((GLuint)(targetWidth + 7) / 8, (GLuint)(targetHeight + 7) / 8, 1);
+        // the scene shaders fetch the result
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA16F);
+        glBindImageTexture(1, 0, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA16F);
+
+        glViewport(0, 0, width, height);
+        result = radianceTexture[current];
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, result);
+        historyValid = true;
+        ++frame;
+        traced = true;
+        return true;
+    }
+
+    // points `shader` (the scene shader or its visibility resolve, already in use) at this frame's traced
+    // radiance, or tells it there is none
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uTracedReflections = Shader::uniformHandle("tracedReflections");
+        static const Shader::UniformHandle uReflectionMaxRoughness = Shader::uniformHandle("reflectionMaxRoughness");
+        shader.setBool(uTracedReflections, traced);
+        if (!traced)
+            return;
+        shader.setFloat(uReflectionMaxRoughness, maxRoughness);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, result);
+    }
+
+    // the next frame's view has nothing to do with this one (a camera cut): its rays start over
+    void resetHistory() { historyValid = false; }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        sceneBvh.releaseGpu();
+        program.reset();
+        traced = false;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    float maxDistance = 20.0f;
+    float maxRoughness = 0.3f;
+    float historyWeight = 0.9f;
+    bool usable = false;
+    bool traced = false;
+    bool historyValid = false;
+    unsigned int frame = 0;
+    std::unique_ptr<ComputeShader> program;
+    GpuSceneBvh sceneBvh;
+    // half-size depth copies and RGBA16F radiance (premultiplied by the hit rate), this frame's and last
+    GLuint depthFbo[2] = {0, 0}, depthTexture[2] = {0, 0}, radianceTexture[2] = {0, 0};
+    GLuint result = 0;
+    int targetWidth = 0, targetHeight = 0;
+
+    void createTargets(int width, int height)
+    {
+        if (depthFbo[0] && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        historyValid = false;
+        glGenTextures(2, depthTexture);
+        glGenTextures(2, radianceTexture);
+        glGenFramebuffers(2, depthFbo);
+        bool complete = true;
+        for (int i = 0; i < 2; ++i)
+        {
+            // the depth copies match the scene's 24/8 format, which the blit requires
+            glBindTexture(GL_TEXTURE_2D, depthTexture[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+            setSampling();
+            glBindTexture(GL_TEXTURE_2D, radianceTexture[i]);
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+            setSampling();
+            glBindFramebuffer(GL_FRAMEBUFFER, depthFbo[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture[i], 0);
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+            complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (!complete)
+        {
+            LOG_WARN("[RTReflections] Half-size depth copy unsupported, no ray-traced reflections");
+            usable = false;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    static void setSampling()
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    void releaseTargets()
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            if (depthFbo[i]) glDeleteFramebuffers(1, &depthFbo[i]);
+            if (depthTexture[i]) glDeleteTextures(1, &depthTexture[i]);
+            if (radianceTexture[i]) glDeleteTextures(1, &radianceTexture[i]);
+            depthFbo[i] = depthTexture[i] = radianceTexture[i] = 0;
+        }
+        result = 0;
+        targetWidth = targetHeight = 0;
+        historyValid = false;
+    }
+};
+
+#endif
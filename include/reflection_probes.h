@@ -0,0 +1,280 @@
+#ifndef REFLECTION_PROBES_H
+#define REFLECTION_PROBES_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <gl_state.h>
+#include <ibl_baker.h>
+#include <shader.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Local reflection probes, so the cars reflect each other and not only the distant prefilterMap.
+// Each probe is a small RGBA16F cube captured from a world position with the scene's own draw code,
+// using the IBL bake's face orientation (IBLBaker::captureView). Captures are linear HDR and premultiplied:
+// alpha is coverage, so where a probe saw no geometry the distant environment shows through.
+// model_loading.fs blends up to MAX_PROBES of them by distance with box-projected (parallax-corrected)
+// lookups.
+//
+// update() re-captures one cube face at a time, round robin over all probes, for as long as the measured
+// GPU cost fits the budget. Frame cost therefore stays flat whatever the probe count; more probes just
+// refresh less often. A probe is sampled once all of its faces have been captured.
+class ReflectionProbes
+{
+public:
+    static const int MAX_PROBES = 4;          // probeMap0..3 in model_loading.fs
+    static const unsigned int FIRST_UNIT = 6; // texture units FIRST_UNIT .. FIRST_UNIT + MAX_PROBES - 1
+
+    // draws the scene for a capture from `eye`, leaving out the model tagged `owner` (the probe sits inside it)
+    typedef std::function<void(const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye, int owner)> DrawScene;
+
+    explicit ReflectionProbes(unsigned int size = 64)
+        : size(size)
+    {
+    }
+
+    ReflectionProbes(const ReflectionProbes &) = delete;
+    ReflectionProbes &operator=(const ReflectionProbes &) = delete;
+
+    // adds a probe at `position` that affects fragments within `radius` and projects its lookups onto the
+    // box [boxMin, boxMax] (world space). Returns its index, or -1 once MAX_PROBES exist.
+    int add(const glm::vec3 &position, float radius, const glm::vec3 &boxMin, const glm::vec3 &boxMax, int owner = -1)
+    {
+        if (probes.size() >= (size_t)MAX_PROBES)
+            return -1;
+        Probe p;
+        p.position = position;
+        p.radius = radius;
+        p.boxMin = boxMin;
+        p.boxMax = boxMax;
+        p.owner = owner;
+        probes.push_back(p);
+        return (int)probes.size() - 1;
+    }
+
+    // moves probe `i` (e.g. with its car); the next captures see the new position
+    void place(int i, const glm::vec3 &position, const glm::vec3 &boxMin, const glm::vec3 &boxMax)
+    {
+        probes[i].position = position;
+        probes[i].boxMin = boxMin;
+        probes[i].boxMax = boxMax;
+    }
+
+    size_t count() const { return probes.size(); }
+
+    // GL thread, before the main pass: captures probe faces within `budgetMs` of GPU (and CPU) time, at
+    // least one per call. Leaves the default framebuffer bound; the caller restores its viewport.
+    void update(const DrawScene &drawScene, double budgetMs, float nearPlane, float farPlane)
+    {
+        if (probes.empty())
+            return;
+        collectTimings();
+        createResources();
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+        const size_t faces = probes.size() * 6;
+        double gpuMs = 0.0;
+        for (size_t n = 0; n < faces; ++n)
+        {
+            const double cost = faceCostMs >= 0.0 ? faceCostMs : budgetMs;
+            if (n > 0 && (gpuMs + cost > budgetMs || elapsedMs(frameStart) > budgetMs))
+                break;
+            captureFace(drawScene, nearPlane, farPlane);
+            gpuMs += cost;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+    }
+
+    // sets the probe uniforms of `shader` (in use) and binds the probe cubes. probeMap0..3 have their units
+    // from link (Shader::samplerUnit), so they never alias a 2D texture unit even without probes.
+    void apply(const Shader &shader) const
+    {
+        static const Shader::UniformHandle uProbeCount = Shader::uniformHandle("probeCount");
+        static const Shader::UniformHandle uProbeMaxMip = Shader::uniformHandle("probeMaxMip");
+        static Shader::UniformHandle uProbeSphere[MAX_PROBES], uProbeBoxMin[MAX_PROBES], uProbeBoxMax[MAX_PROBES];
+        static bool interned = false;
+        if (!interned)
+        {
+            for (int i = 0; i < MAX_PROBES; ++i)
+            {
+                const std::string index = std::to_string(i);
+                uProbeSphere[i] = Shader::uniformHandle("probeSpheres[" + index + "]");
+                uProbeBoxMin[i] = Shader::uniformHandle("probeBoxMin[" + index + "]");
+                uProbeBoxMax[i] = Shader::uniformHandle("probeBoxMax[" + index + "]");
+            }
+            interned = true;
+        }
+        int used = 0;
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            const Probe &p = probes[i];
+            if (!p.ready)
+                continue;
+            shader.setVec4(uProbeSphere[used], glm::vec4(p.capturedPosition, p.radius));
+            shader.setVec3(uProbeBoxMin[used], p.capturedBoxMin);
+            shader.setVec3(uProbeBoxMax[used], p.capturedBoxMax);
+            glState().bindTexture(FIRST_UNIT + used, GL_TEXTURE_CUBE_MAP, p.cube);
+            ++used;
+        }
+        shader.setInt(uProbeCount, used);
+        shader.setFloat(uProbeMaxMip, (float)(levels() - 1));
+    }
+
+    // GL thread: deletes the probe cubes, the capture FBO and pending timer queries
+    void releaseGpu()
+    {
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            if (probes[i].cube)
+                glDeleteTextures(1, &probes[i].cube);
+            probes[i].cube = 0;
+            probes[i].ready = false;
+        }
+        if (captureFBO)
+        {
+            glDeleteFramebuffers(1, &captureFBO);
+            glDeleteRenderbuffers(1, &depthRBO);
+        }
+        captureFBO = depthRBO = 0;
+        for (size_t i = 0; i < timings.size(); ++i)
+            glDeleteQueries(1, &timings[i]);
+        timings.clear();
+    }
+
+private:
+    struct Probe
+    {
+        glm::vec3 position;
+        float radius = 0.0f;
+        glm::vec3 boxMin, boxMax;
+        int owner = -1;
+        GLuint cube = 0;
+        bool ready = false; // every face captured at least once
+        // placement the current cube was captured with (the position may move mid-refresh)
+        glm::vec3 capturedPosition, capturedBoxMin, capturedBoxMax;
+        glm::vec3 capturingPosition, capturingBoxMin, capturingBoxMax;
+    };
+
+    unsigned int size;
+    std::vector<Probe> probes;
+    // round robin cursor: next probe and face to capture
+    size_t nextProbe = 0;
+    unsigned int nextFace = 0;
+    GLuint captureFBO = 0, depthRBO = 0;
+    // measured GPU ms of one face capture (-1 = not measured yet) and queries whose result isn't read yet
+    double faceCostMs = -1.0;
+    std::vector<GLuint> timings;
+
+    static double elapsedMs(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
+    unsigned int levels() const
+    {
+        unsigned int n = 1;
+        while ((size >> n) > 0)
+            ++n;
+        return n;
+    }
+
+    void createResources()
+    {
+        if (!captureFBO)
+        {
+            glGenFramebuffers(1, &captureFBO);
+            glGenRenderbuffers(1, &depthRBO);
+            glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+            glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            if (probes[i].cube)
+                continue;
+            glGenTextures(1, &probes[i].cube);
+            glState().bindTexture(FIRST_UNIT, GL_TEXTURE_CUBE_MAP, probes[i].cube);
+            for (unsigned int face = 0; face < 6; ++face)
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA16F, size, size, 0, GL_RGBA, GL_FLOAT, nullptr);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        }
+    }
+
+    // renders the next face of the round robin; after a probe's last face its mips are rebuilt (rough
+    // reflections read them) and the new capture becomes the one that's sampled
+    void captureFace(const DrawScene &drawScene, float nearPlane, float farPlane)
+    {
+        Probe &p = probes[nextProbe];
+        if (nextFace == 0)
+        {
+            p.capturingPosition = p.position;
+            p.capturingBoxMin = p.boxMin;
+            p.capturingBoxMax = p.boxMax;
+        }
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        glBeginQuery(GL_TIME_ELAPSED, query);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + nextFace, p.cube, 0);
+        glViewport(0, 0, size, size);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // the capture shader writes premultiplied colour, so coverage accumulates in alpha
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        drawScene(IBLBaker::captureProjection(nearPlane, farPlane), IBLBaker::captureView(nextFace, p.capturingPosition), p.capturingPosition, p.owner);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        if (nextFace == 5)
+        {
+            glState().bindTexture(FIRST_UNIT, GL_TEXTURE_CUBE_MAP, p.cube);
+            glState().activeTexture(FIRST_UNIT);
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+            p.capturedPosition = p.capturingPosition;
+            p.capturedBoxMin = p.capturingBoxMin;
+            p.capturedBoxMax = p.capturingBoxMax;
+            p.ready = true;
+        }
+
+        glEndQuery(GL_TIME_ELAPSED);
+        timings.push_back(query);
+        if (++nextFace == 6)
+        {
+            nextFace = 0;
+            nextProbe = (nextProbe + 1) % probes.size();
+        }
+    }
+
+    // reads back finished timer queries without waiting for the GPU
+    void collectTimings()
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < timings.size(); ++i)
+        {
+            GLint available = 0;
+            glGetQueryObjectiv(timings[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+            {
+                timings[kept++] = timings[i];
+                continue;
+            }
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(timings[i], GL_QUERY_RESULT, &ns);
+            glDeleteQueries(1, &timings[i]);
+            double ms = ns / 1.0e6;
+            faceCostMs = faceCostMs < 0.0 ? ms : 0.9 * faceCostMs + 0.1 * ms;
+        }
+        timings.resize(kept);
+    }
+};
+
+#endif
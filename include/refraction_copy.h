@@ -0,0 +1,139 @@
+#ifndef REFRACTION_COPY_H
+#define REFRACTION_COPY_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+// KHR_materials_transmission: what transmissive surfaces (car glass) see through. Once per frame, after
+// the opaque pass and before anything transparent draws, capture() copies the scene colour into a
+// half-size RGBA16F texture and builds its mip chain, so the transparent pass reads the opaque scene behind
+// each fragment (thin-walled: straight through, no offset) with the LOD growing with roughness. Every
+// transmissive mesh of the frame shares the one copy. TRANSMISSION=0 turns it off: the glass then sees the
+// prefiltered environment, as probe captures always do.
+class RefractionCopy
+{
+public:
+    // texture unit of the copy in the scene shaders (Shader::samplerUnit)
+    static const unsigned int UNIT = 20;
+
+    RefractionCopy() {}
+    RefractionCopy(const RefractionCopy &) = delete;
+    RefractionCopy &operator=(const RefractionCopy &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("TRANSMISSION");
+        return !(env && std::string(env) == "0");
+    }
+
+    // GL thread, with the scene framebuffer (ToneMapper's HDR target) bound and `width` x `height` drawn:
+    // copies it and builds the mips. The scene framebuffer is bound again afterwards. False (no copy this
+    // frame) without an HDR target or when the copy can't be made.
+    bool capture(int width, int height)
+    {
+        captured = false;
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!usable || !scene || width <= 0 || height <= 0)
+            return false;
+        sceneWidth = width;
+        sceneHeight = height;
+        createTarget(std::max(1, width / 2), std::max(1, height / 2));
+        if (!usable)
+            return false;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, targetWidth, targetHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, texture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        captured = true;
+        return true;
+    }
+
+    // no copy this frame: the glass drawn next sees the environment
+    void skip() { captured = false; }
+
+    // points `shader` (the scene shader or its OIT variant, already in use) at this frame's copy, or tells
+    // it there's none
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uTransmissionCopy = Shader::uniformHandle("transmissionCopy");
+        static const Shader::UniformHandle uTransmissionMaxMip = Shader::uniformHandle("transmissionMaxMip");
+        static const Shader::UniformHandle uTransmissionTexel = Shader::uniformHandle("transmissionTexel");
+        shader.setBool(uTransmissionCopy, captured);
+        if (!captured)
+            return;
+        shader.setFloat(uTransmissionMaxMip, (float)(mipLevels - 1));
+        // gl_FragCoord of the scene's pixels to the copy's UVs
+        shader.setVec2(uTransmissionTexel, glm::vec2(1.0f / sceneWidth, 1.0f / sceneHeight));
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, texture);
+    }
+
+    void releaseGpu()
+    {
+        releaseTarget();
+        captured = false;
+        glState().invalidate();
+    }
+
+private:
+    bool usable = true;
+    bool captured = false;
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int targetWidth = 0, targetHeight = 0;
+    int sceneWidth = 1, sceneHeight = 1;
+    int mipLevels = 0;
+
+    void createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return;
+        releaseTarget();
+        targetWidth = width;
+        targetHeight = height;
+        mipLevels = 1;
+        while ((std::max(width, height) >> mipLevels) > 0)
+            ++mipLevels;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        for (int level = 0; level < mipLevels; ++level)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA16F, std::max(1, width >> level), std::max(1, height >> level), 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[Transmission] Float render targets unsupported, glass sees the environment only");
+            usable = false;
+        }
+        else
+            LOG_DEBUG("[Transmission] Refraction copy " << width << "x" << height << ", " << mipLevels << " mips");
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (texture) glDeleteTextures(1, &texture);
+        fbo = texture = 0;
+        targetWidth = targetHeight = mipLevels = 0;
+    }
+};
+
+#endif
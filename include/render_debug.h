@@ -0,0 +1,115 @@
+#ifndef RENDER_DEBUG_H
+#define RENDER_DEBUG_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+
+#include <algorithm>
+
+// Compile-time render debug level:
+//   0 = release: no synchronous GL queries (glGetError/glGetIntegerv) anywhere on the draw path
+//   1 = asynchronous GL debug-output callback (GL 4.3 contexts) reports errors as they happen
+//   2 = everything from 1 plus synchronous per-draw glGetError checks with a state dump, and one-time draw logs
+// Set it from CMake with -DRENDER_DEBUG_LEVEL=<n>.
+#ifndef RENDER_DEBUG_LEVEL
+#define RENDER_DEBUG_LEVEL 0
+#endif
+
+namespace RenderDebug
+{
+    const int Level = RENDER_DEBUG_LEVEL;
+
+    // prints the GL bindings most useful for diagnosing INVALID_OPERATION (program, VAO, EBO, texture units)
+    inline void dumpState(const char *where, GLenum err, unsigned int program)
+    {
+        GLint curProg = 0; glGetIntegerv(GL_CURRENT_PROGRAM, &curProg);
+        GLint vao = 0; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+        GLint ebo = 0; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ebo);
+        GLint activeTex = 0; glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTex);
+        GLint maxTex = 0; glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTex);
+        LOG_ERROR("[Render Debug][GL ERROR] 0x" << std::hex << err << std::dec << " at " << where);
+        LOG_ERROR("  shader.ID=" << program << " GL_CURRENT_PROGRAM=" << curProg);
+        LOG_ERROR("  VAO=" << vao << " EBO=" << ebo << " ACTIVE_TEXTURE=0x" << std::hex << activeTex << std::dec << " MAX_TEX=" << maxTex);
+        int inspect = std::min(maxTex, 8);
+        for (int u = 0; u < inspect; ++u)
+        {
+            glActiveTexture(GL_TEXTURE0 + u);
+            GLint bound2D = 0; glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound2D);
+            LOG_ERROR("    Unit " << u << " bound2D=" << bound2D);
+        }
+        // restore active texture
+        glActiveTexture(activeTex);
+    }
+
+    // per-draw synchronous check; the disabled specialisation is empty so release builds emit no code
+    template <bool Enabled>
+    struct DrawCheck
+    {
+        static void run(const char *, const char *, unsigned int) {}
+    };
+    template <>
+    struct DrawCheck<true>
+    {
+        static void run(const char *where, const char *detail, unsigned int program)
+        {
+            GLenum e = glGetError();
+            if (e == GL_NO_ERROR)
+                return;
+            if (detail)
+                LOG_ERROR("[Render Debug] (" << detail << ")");
+            dumpState(where, e, program);
+        }
+    };
+
+    // call sites pass string literals plus an optional detail pointer so no strings are built when disabled
+    inline void checkDraw(const char *where, unsigned int program, const char *detail = 0)
+    {
+        DrawCheck<(RENDER_DEBUG_LEVEL >= 2)>::run(where, detail, program);
+    }
+
+    inline void APIENTRY messageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, const void *userParam)
+    {
+        (void)source; (void)length; (void)userParam;
+        // skip the driver's informational chatter (buffer placement hints etc.)
+        if (severity == GL_DEBUG_SEVERITY_NOTIFICATION)
+            return;
+        const char *kind = "OTHER";
+        switch (type)
+        {
+        case GL_DEBUG_TYPE_ERROR: kind = "ERROR"; break;
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: kind = "DEPRECATED"; break;
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: kind = "UNDEFINED"; break;
+        case GL_DEBUG_TYPE_PORTABILITY: kind = "PORTABILITY"; break;
+        case GL_DEBUG_TYPE_PERFORMANCE: kind = "PERFORMANCE"; break;
+        }
+        // may fire on a driver thread; the logger takes any thread
+        if (type == GL_DEBUG_TYPE_ERROR)
+            LOG_ERROR("[GL Debug][" << kind << "] id=" << id << ": " << message);
+        else
+            LOG_WARN("[GL Debug][" << kind << "] id=" << id << ": " << message);
+    }
+
+    // installs the debug-output callback when the context supports it (GL 4.3; the
+    // generated loader has no extensions, so a KHR_debug-only context goes without).
+    // At level 2 output is synchronous so the callback fires inside the offending call.
+    inline bool installMessageCallback()
+    {
+        if (Level < 1)
+            return false;
+        if (!GLAD_GL_VERSION_4_3 || glDebugMessageCallback == NULL)
+        {
+            LOG_WARN("[Render Debug] GL debug output unavailable (needs GL 4.3).");
+            return false;
+        }
+        glEnable(GL_DEBUG_OUTPUT);
+        if (Level >= 2)
+            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        glDebugMessageCallback(messageCallback, NULL);
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+        LOG_INFO("[Render Debug] GL debug output callback installed (RENDER_DEBUG_LEVEL=" << Level << ").");
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,714 @@
+#ifndef RENDER_FARM_H
+#define RENDER_FARM_H
+
+#include <async_log.h>
+#include <json.hpp>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A batch job (BatchRenderer) spread over machines. car_farm (tools/car_farm.cpp) is the coordinator: it
+// expands the job's shots, cuts them into chunks of a few shots and hands the chunks to whichever worker
+// asks next. A worker is the viewer started with BATCH_FARM=<host>:<port> instead of BATCH_JOB: it loads
+// its scene (the same SCENE and models as everyone else's) and the startup environment once, then renders
+// chunk after chunk like a small BATCH_JOB, writes the images locally (BATCH_FARM_DIR, default farm_) and
+// sends them back, where the coordinator saves them under the job's output prefix. Environments bake once
+// per worker and come from the IBL cache after that, so a catalogue render runs at about one machine's
+// speed per worker.
+// The protocol is a line per message over one TCP connection per worker, with byte counts ahead of
+// payloads:
+//   worker:      hello <name>                       once, after connecting
+//   worker:      next                               asks for a chunk
+//   coordinator: chunk <id> <bytes> + job JSON      a job with the chunk's shots and no "output"
+//                wait <ms>                          nothing to hand out now (chunks in flight may fail)
+//                done                               every chunk is in: the worker leaves
+//   worker:      result <id> <files> <failed>       then per image: file <bytes> <name> + its bytes
+//   coordinator: ok
+// A chunk whose worker disconnects, goes quiet for longer than the chunk timeout or reports failed images
+// is handed out again, up to the retry limit.
+namespace farm
+{
+#ifdef _WIN32
+    typedef SOCKET Socket;
+    static const Socket INVALID = INVALID_SOCKET;
+    inline void closeSocket(Socket s) { if (s != INVALID) closesocket(s); }
+#else
+    typedef int Socket;
+    static const Socket INVALID = -1;
+    inline void closeSocket(Socket s) { if (s != INVALID) ::close(s); }
+#endif
+
+    // Winsock wants starting once per process (a no-op elsewhere)
+    inline bool startNetwork()
+    {
+#ifdef _WIN32
+        static const bool started = []() {
+            WSADATA wsa;
+            return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+        }();
+        return started;
+#else
+        return true;
+#endif
+    }
+
+    // recv and send give up after `seconds` (0: never)
+    inline void setTimeout(Socket s, int seconds)
+    {
+#ifdef _WIN32
+        const DWORD ms = (DWORD)seconds * 1000;
+        setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char *)&ms, sizeof(ms));
+        setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char *)&ms, sizeof(ms));
+#else
+        timeval tv;
+        tv.tv_sec = seconds;
+        tv.tv_usec = 0;
+        setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char *)&tv, sizeof(tv));
+        setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char *)&tv, sizeof(tv));
+#endif
+    }
+
+    inline bool sendAll(Socket s, const char *data, size_t size)
+    {
+#ifdef MSG_NOSIGNAL
+        const int flags = MSG_NOSIGNAL; // a closed peer is an error return, not SIGPIPE
+#else
+        const int flags = 0;
+#endif
+        while (size > 0)
+        {
+            const int put = (int)::send(s, data, (int)std::min<size_t>(size, 1 << 20), flags);
+            if (put <= 0)
+                return false;
+            data += put;
+            size -= (size_t)put;
+        }
+        return true;
+    }
+
+    inline bool sendLine(Socket s, const std::string &line)
+    {
+        const std::string out = line + "\n";
+        return sendAll(s, out.data(), out.size());
+    }
+
+    inline bool receiveExact(Socket s, char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            const int got = (int)::recv(s, data, (int)std::min<size_t>(size, 1 << 20), 0);
+            if (got <= 0)
+                return false;
+            data += got;
+            size -= (size_t)got;
+        }
+        return true;
+    }
+
+    // a line without its newline; false when the connection closed or timed out first. Messages are a few
+    // dozen bytes, so a byte at a time keeps the payload after the line in the socket for receiveExact.
+    inline bool receiveLine(Socket s, std::string &line)
+    {
+        line.clear();
+        char c = 0;
+        while (line.size() < 4096)
+        {
+            if (::recv(s, &c, 1, 0) != 1)
+                return false;
+            if (c == '\n')
+                return true;
+            line += c;
+        }
+        return false;
+    }
+
+    // "host:port" to a connected socket (INVALID on failure)
+    inline Socket connectTo(const std::string &address)
+    {
+        const size_t colon = address.rfind(':');
+        if (colon == std::string::npos || !startNetwork())
+            return INVALID;
+        const std::string host = address.substr(0, colon), port = address.substr(colon + 1);
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *found = NULL;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &found) != 0 || !found)
+            return INVALID;
+        Socket s = socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+        if (s != INVALID && connect(s, found->ai_addr, (int)found->ai_addrlen) != 0)
+        {
+            closeSocket(s);
+            s = INVALID;
+        }
+        freeaddrinfo(found);
+        return s;
+    }
+
+    inline std::string hostName()
+    {
+        char name[256] = {0};
+        if (!startNetwork() || gethostname(name, sizeof(name) - 1) != 0 || !name[0])
+            return "worker";
+        return name;
+    }
+
+    inline bool readFile(const std::string &path, std::string &bytes)
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        if (!in)
+            return false;
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // an image name from a worker: a file name of its own, nothing that climbs out of the output prefix
+    inline bool safeName(const std::string &name)
+    {
+        return !name.empty() && name.find_first_of("/\\:") == std::string::npos && name.find("..") == std::string::npos;
+    }
+}
+
+// The viewer's side (BATCH_FARM=<host>:<port>): a thread talks to the coordinator while the render loop
+// renders. The render loop takes a chunk with takeChunk() whenever one has arrived and hands its images
+// back with submit() once they're on disk; finished() turns true when the coordinator has no more work (or
+// can't be reached), and the loop leaves.
+class FarmWorker
+{
+public:
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("BATCH_FARM");
+        return env && *env;
+    }
+
+    explicit FarmWorker(const std::string &address)
+        : address(address), name(workerName())
+    {
+        worker = std::thread(&FarmWorker::run, this);
+    }
+
+    ~FarmWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    FarmWorker(const FarmWorker &) = delete;
+    FarmWorker &operator=(const FarmWorker &) = delete;
+
+    // GL thread: moves an arrived chunk's job into `job` (false if none is waiting)
+    bool takeChunk(nlohmann::json &job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state != ARRIVED)
+            return false;
+        job.swap(chunkJob);
+        state = RENDERING;
+        return true;
+    }
+
+    // GL thread, once the taken chunk's images are written: `paths` start with `prefix`, and the rest of
+    // each is the name the coordinator saves it under. Files that aren't there count as failed.
+    void submit(const std::vector<std::string> &paths, const std::string &prefix)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.clear();
+            for (size_t i = 0; i < paths.size(); ++i)
+                results.push_back(paths[i].compare(0, prefix.size(), prefix) == 0 ? std::make_pair(paths[i], paths[i].substr(prefix.size()))
+                                                                                   : std::make_pair(paths[i], paths[i]));
+            state = SUBMITTED;
+        }
+        changed.notify_all();
+    }
+
+    bool finished() const { return done.load(); }
+
+private:
+    enum State { ASKING, ARRIVED, RENDERING, SUBMITTED };
+
+    const std::string address;
+    const std::string name;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool stopping = false;
+    State state = ASKING;
+    nlohmann::json chunkJob;
+    int chunkId = -1;
+    std::vector<std::pair<std::string, std::string>> results; // local path, name
+    std::atomic<bool> done{false};
+    farm::Socket socket = farm::INVALID;
+
+    // BATCH_FARM_NAME names the worker in the coordinator's log (default: the host's name)
+    static std::string workerName()
+    {
+        const char *env = std::getenv("BATCH_FARM_NAME");
+        return env && *env ? std::string(env) : farm::hostName();
+    }
+
+    // sleeps `ms`, or less when stopping; false when stopping
+    bool pause(int ms)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait_for(lock, std::chrono::milliseconds(ms), [this]() { return stopping; });
+        return !stopping;
+    }
+
+    // tries for about a minute, so workers may start before the coordinator
+    bool connect()
+    {
+        farm::closeSocket(socket);
+        for (int attempt = 0; attempt < 60; ++attempt)
+        {
+            socket = farm::connectTo(address);
+            // the coordinator answers at once; only a hung one is quiet for long
+            if (socket != farm::INVALID)
+                farm::setTimeout(socket, 120);
+            if (socket != farm::INVALID && farm::sendLine(socket, "hello " + name))
+            {
+                LOG_INFO("[Farm] Connected to " << address << " as " << name);
+                return true;
+            }
+            farm::closeSocket(socket);
+            socket = farm::INVALID;
+            if (!pause(1000))
+                return false;
+        }
+        LOG_ERROR("[Farm] Can't reach the coordinator at " << address);
+        return false;
+    }
+
+    void run()
+    {
+        bool connected = connect();
+        while (connected)
+        {
+            if (!farm::sendLine(socket, "next") || !receiveWork())
+            {
+                if (done.load())
+                    break;
+                LOG_WARN("[Farm] Lost the coordinator, reconnecting");
+                connected = connect();
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (state == ASKING)
+                    continue;
+                changed.wait(lock, [this]() { return stopping || state == SUBMITTED; });
+                if (stopping)
+                    break;
+            }
+            // a chunk the coordinator has given away again in the meantime is dropped on its side
+            if (!upload())
+            {
+                LOG_WARN("[Farm] Upload of chunk " << chunkId << " failed, reconnecting");
+                connected = connect();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            state = ASKING;
+        }
+        farm::closeSocket(socket);
+        socket = farm::INVALID;
+        done.store(true);
+    }
+
+    // the reply to "next": a chunk (now ARRIVED), a pause, or the end
+    bool receiveWork()
+    {
+        std::string line;
+        if (!farm::receiveLine(socket, line))
+            return false;
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "chunk")
+        {
+            size_t bytes = 0;
+            fields >> chunkId >> bytes;
+            std::string text(bytes, '\0');
+            if (fields.fail() || !farm::receiveExact(socket, &text[0], bytes))
+                return false;
+            nlohmann::json job = nlohmann::json::parse(text, nullptr, false);
+            if (job.is_discarded())
+                return false;
+            LOG_INFO("[Farm] Chunk " << chunkId << ": " << job["shots"].size() << " shots");
+            std::lock_guard<std::mutex> lock(mutex);
+            chunkJob.swap(job);
+            state = ARRIVED;
+            return true;
+        }
+        if (kind == "wait")
+        {
+            int ms = 1000;
+            fields >> ms;
+            pause(std::max(10, std::min(ms, 10000)));
+            return true;
+        }
+        if (kind == "done")
+            LOG_INFO("[Farm] The coordinator has no more work");
+        done.store(kind == "done");
+        return false;
+    }
+
+    bool upload()
+    {
+        std::vector<std::pair<std::string, std::string>> files;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            files.swap(results);
+        }
+        std::vector<std::string> bytes(files.size());
+        int failed = 0, sent = 0;
+        for (size_t i = 0; i < files.size(); ++i)
+            if (!farm::readFile(files[i].first, bytes[i]) || bytes[i].empty())
+                ++failed;
+        std::ostringstream header;
+        header << "result " << chunkId << " " << files.size() - failed << " " << failed;
+        if (!farm::sendLine(socket, header.str()))
+            return false;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            if (bytes[i].empty())
+                continue;
+            std::ostringstream line;
+            line << "file " << bytes[i].size() << " " << files[i].second;
+            if (!farm::sendLine(socket, line.str()) || !farm::sendAll(socket, bytes[i].data(), bytes[i].size()))
+                return false;
+            ++sent;
+        }
+        std::string reply;
+        if (!farm::receiveLine(socket, reply) || reply != "ok")
+            return false;
+        for (size_t i = 0; i < files.size(); ++i)
+            if (!bytes[i].empty())
+                std::remove(files[i].first.c_str());
+        LOG_INFO("[Farm] Chunk " << chunkId << " uploaded: " << sent << " images" << (failed ? ", " : "")
+                                 << (failed ? std::to_string(failed) + " failed" : std::string()));
+        return true;
+    }
+};
+
+// The coordinator's side (car_farm): listens on `port`, serves chunks of `job` to the workers that connect
+// (a thread each) and saves what they send back under the job's output prefix; run() returns once every
+// chunk is in or out of retries.
+class FarmCoordinator
+{
+public:
+    struct Options
+    {
+        int port = 7420;
+        int chunkShots = 8;      // shots per chunk
+        int retries = 2;         // hand-outs of a chunk after the first
+        int chunkTimeout = 600;  // seconds a worker may go quiet with a chunk
+    };
+
+    // `shots` are the job's expanded shots (BatchRenderer::shotEntries), each with its name
+    FarmCoordinator(const nlohmann::json &job, const std::vector<nlohmann::json> &shots, const Options &options)
+        : options(options)
+    {
+        prefix = job.value("output", std::string("batch_"));
+        nlohmann::json base = job;
+        base.erase("output");
+        base.erase("shots");
+        base.erase("turntable");
+        const size_t per = (size_t)std::max(1, options.chunkShots);
+        for (size_t first = 0; first < shots.size(); first += per)
+        {
+            Chunk chunk;
+            nlohmann::json part = base;
+            part["shots"] = nlohmann::json::array();
+            for (size_t i = first; i < std::min(shots.size(), first + per); ++i)
+                part["shots"].push_back(shots[i]);
+            chunk.shots = (int)part["shots"].size();
+            chunk.job = part.dump();
+            chunks.push_back(chunk);
+        }
+        totalShots = (int)shots.size();
+    }
+
+    ~FarmCoordinator() { farm::closeSocket(listener); }
+
+    FarmCoordinator(const FarmCoordinator &) = delete;
+    FarmCoordinator &operator=(const FarmCoordinator &) = delete;
+
+    // starts listening on the port (run() does if this wasn't called); false if it can't be opened
+    bool open()
+    {
+        return listener != farm::INVALID || listen();
+    }
+
+    // blocks until the job is done; false if chunks failed for good (or the port can't be opened)
+    bool run()
+    {
+        if (!open())
+            return false;
+        started = std::chrono::steady_clock::now();
+        LOG_INFO("[Farm] " << totalShots << " shots in " << chunks.size() << " chunks of up to " << options.chunkShots
+                           << ", waiting for workers on port " << options.port);
+        std::vector<std::thread> threads;
+        while (!complete())
+        {
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(listener, &readable);
+            timeval tv;
+            tv.tv_sec = 0;
+            tv.tv_usec = 200000;
+            if (select((int)listener + 1, &readable, NULL, NULL, &tv) <= 0)
+                continue;
+            const farm::Socket client = accept(listener, NULL, NULL);
+            if (client != farm::INVALID)
+                threads.push_back(std::thread(&FarmCoordinator::serve, this, client));
+        }
+        // latecomers are turned away; the others are told "done" on their next ask and hang up
+        farm::closeSocket(listener);
+        listener = farm::INVALID;
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        int failedChunks = 0;
+        for (size_t i = 0; i < chunks.size(); ++i)
+            failedChunks += chunks[i].state == FAILED ? 1 : 0;
+        LOG_INFO("[Farm] Done in " << elapsed() << " s: " << imagesSaved << " images saved, " << failedChunks << " of " << chunks.size()
+                                   << " chunks failed");
+        return failedChunks == 0;
+    }
+
+private:
+    enum ChunkState { PENDING, ASSIGNED, DONE, FAILED };
+
+    struct Chunk
+    {
+        std::string job;
+        int shots = 0;
+        ChunkState state = PENDING;
+        int attempts = 0;
+        std::string worker;
+    };
+
+    const Options options;
+    std::string prefix;
+    std::vector<Chunk> chunks;
+    int totalShots = 0;
+    farm::Socket listener = farm::INVALID;
+    std::mutex mutex;
+    int workers = 0;
+    int imagesSaved = 0;
+    int shotsDone = 0;
+    std::chrono::steady_clock::time_point started;
+
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    bool listen()
+    {
+        if (!farm::startNetwork())
+            return false;
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (listener == farm::INVALID)
+            return false;
+        int yes = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char *)&yes, sizeof(yes));
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons((unsigned short)options.port);
+        if (bind(listener, (sockaddr *)&address, sizeof(address)) != 0 || ::listen(listener, 16) != 0)
+        {
+            LOG_ERROR("[Farm] Can't listen on port " << options.port);
+            return false;
+        }
+        return true;
+    }
+
+    bool complete()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < chunks.size(); ++i)
+            if (chunks[i].state == PENDING || chunks[i].state == ASSIGNED)
+                return false;
+        return true;
+    }
+
+    // mutex held: a chunk back to the queue, or out for good once its retries are spent
+    void giveBack(int id, const char *why)
+    {
+        Chunk &chunk = chunks[id];
+        if (chunk.state != ASSIGNED)
+            return;
+        chunk.state = chunk.attempts > options.retries ? FAILED : PENDING;
+        LOG_WARN("[Farm] Chunk " << id << " " << why << " on " << chunk.worker
+                                 << (chunk.state == FAILED ? ", out of retries" : ", handing it out again"));
+    }
+
+    // one worker's connection, until it leaves or the job is done
+    void serve(farm::Socket s)
+    {
+        farm::setTimeout(s, std::max(1, options.chunkTimeout));
+        std::string line, name = "?";
+        if (farm::receiveLine(s, line) && line.compare(0, 6, "hello ") == 0)
+            name = line.substr(6);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++workers;
+            LOG_INFO("[Farm] Worker " << name << " joined (" << workers << " connected)");
+        }
+        int held = -1; // the chunk this worker has
+        while (farm::receiveLine(s, line))
+        {
+            std::istringstream fields(line);
+            std::string kind;
+            fields >> kind;
+            if (kind == "next")
+            {
+                std::string reply;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (held >= 0)
+                        giveBack(held, "was dropped");
+                    held = -1;
+                    bool inFlight = false;
+                    for (size_t i = 0; i < chunks.size() && held < 0; ++i)
+                    {
+                        inFlight = inFlight || chunks[i].state == ASSIGNED;
+                        if (chunks[i].state == PENDING)
+                            held = (int)i;
+                    }
+                    if (held >= 0)
+                    {
+                        Chunk &chunk = chunks[held];
+                        chunk.state = ASSIGNED;
+                        chunk.worker = name;
+                        ++chunk.attempts;
+                        std::ostringstream header;
+                        header << "chunk " << held << " " << chunk.job.size() << "\n";
+                        reply = header.str() + chunk.job;
+                    }
+                    else
+                        reply = inFlight ? "wait 1000\n" : "done\n";
+                }
+                if (!farm::sendAll(s, reply.data(), reply.size()))
+                    break;
+            }
+            else if (kind == "result")
+            {
+                int id = -1, files = 0, failed = 0;
+                fields >> id >> files >> failed;
+                if (fields.fail() || !receiveResult(s, id, files, failed, name) || !farm::sendLine(s, "ok"))
+                    break;
+                held = -1;
+            }
+            else
+                break;
+        }
+        farm::closeSocket(s);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (held >= 0)
+            giveBack(held, "lost its worker");
+        --workers;
+        LOG_INFO("[Farm] Worker " << name << " left (" << workers << " connected)");
+    }
+
+    // saves a chunk's `files` images; the chunk is done when nothing failed and it still was this worker's
+    bool receiveResult(farm::Socket s, int id, int files, int failed, const std::string &worker)
+    {
+        std::vector<std::pair<std::string, std::string>> images;
+        for (int i = 0; i < files; ++i)
+        {
+            std::string line, kind, name;
+            size_t bytes = 0;
+            if (!farm::receiveLine(s, line))
+                return false;
+            std::istringstream fields(line);
+            fields >> kind >> bytes;
+            std::getline(fields >> std::ws, name);
+            if (kind != "file" || fields.fail() || bytes > ((size_t)1 << 31))
+                return false;
+            std::string data(bytes, '\0');
+            if (bytes && !farm::receiveExact(s, &data[0], bytes))
+                return false;
+            images.push_back(std::make_pair(name, std::string()));
+            images.back().second.swap(data);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (id < 0 || id >= (int)chunks.size() || chunks[id].state != ASSIGNED || chunks[id].worker != worker)
+            return true; // handed out again meanwhile (or finished by someone else): not ours to save
+        int saved = 0;
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            const std::string path = prefix + images[i].first;
+            std::ofstream out;
+            if (farm::safeName(images[i].first))
+                out.open(path.c_str(), std::ios::binary);
+            if (out && out.write(images[i].second.data(), images[i].second.size()))
+                ++saved;
+            else
+            {
+                LOG_WARN("[Farm] Can't save " << path);
+                ++failed;
+            }
+        }
+        if (failed > 0 || (int)images.size() < chunks[id].shots)
+        {
+            giveBack(id, "came back with failed images");
+            return true;
+        }
+        chunks[id].state = DONE;
+        shotsDone += chunks[id].shots;
+        imagesSaved += saved;
+        size_t doneChunks = 0;
+        for (size_t i = 0; i < chunks.size(); ++i)
+            doneChunks += chunks[i].state == DONE ? 1 : 0;
+        const double seconds = elapsed();
+        const double left = shotsDone > 0 ? seconds * (totalShots - shotsDone) / shotsDone : 0.0;
+        LOG_INFO("[Farm] Chunk " << id << " from " << worker << ": " << doneChunks << "/" << chunks.size() << " chunks, " << shotsDone << "/"
+                                 << totalShots << " shots, " << workers << " workers, ~" << (int)left << " s left");
+        return true;
+    }
+};
+
+#endif
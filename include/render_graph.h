@@ -0,0 +1,429 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <gpu_profiler.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// A frame's passes as a graph (the post chain so far: AutoExposure, Bloom, ToneMapper). Each frame the
+// caller declares its resources and passes again, and which resources every pass reads and writes;
+// execute() then
+//   - culls the passes nothing needs: a pass survives if it writes an imported resource (the window, a
+//     texture that outlives the frame) or something a surviving pass reads,
+//   - orders the rest by their dependencies (a read waits for the write before it, a write for the reads
+//     and the write before it; independent passes keep the order they were declared in),
+//   - backs every transient texture with a texture of the pool for exactly the passes between its first
+//     and last use, so transients whose uses don't overlap share one texture, and
+//   - runs them, each in a GpuProfiler scope of its name.
+// The pool and the framebuffers over its textures persist across frames: once a frame's set of
+// transients has been seen, later frames create no textures and no framebuffers. Textures the pool
+// hasn't handed out for a few seconds' worth of frames (a resize leaves the old sizes behind) are deleted.
+//
+//     RenderGraph::Resource level = graph.createTexture("bloom level", desc);
+//     RenderGraph::Pass pass = graph.addPass("bloom down", [&](RenderGraph &g) { draw into g.framebuffer(level); });
+//     graph.read(pass, hdr);
+//     graph.write(pass, level);
+//     graph.execute(&profiler);
+class RenderGraph
+{
+public:
+    typedef int Resource;
+    typedef int Pass;
+    static const int NONE = -1;
+    // frames a pool texture may sit unused before it is deleted
+    static const unsigned int POOL_FRAMES = 240;
+
+    // a transient's texture; textures of equal descriptions are interchangeable, so they alias
+    struct TextureDesc
+    {
+        int width = 0, height = 0;
+        GLenum internalFormat = GL_RGBA16F;
+        GLenum format = GL_RGBA;
+        GLenum type = GL_HALF_FLOAT;
+        GLint filter = GL_LINEAR;
+
+        TextureDesc() {}
+        TextureDesc(int width, int height, GLenum internalFormat, GLenum format, GLenum type, GLint filter = GL_LINEAR)
+            : width(width), height(height), internalFormat(internalFormat), format(format), type(type), filter(filter)
+        {
+        }
+
+        bool operator==(const TextureDesc &o) const
+        {
+            return width == o.width && height == o.height && internalFormat == o.internalFormat && format == o.format &&
+                   type == o.type && filter == o.filter;
+        }
+    };
+
+    // counts of the last execute()
+    struct Stats
+    {
+        size_t passes = 0;     // run
+        size_t culled = 0;     // declared but not needed
+        size_t transients = 0; // transient textures used
+        size_t textures = 0;   // pool textures backing them (fewer = aliased)
+        size_t poolTextures = 0;
+        size_t poolBytes = 0;
+    };
+
+    typedef std::function<void(RenderGraph &)> Execute;
+
+    RenderGraph() {}
+    RenderGraph(const RenderGraph &) = delete;
+    RenderGraph &operator=(const RenderGraph &) = delete;
+
+    // GL thread, at the start of each frame's declarations: forgets the last frame's passes and resources
+    void reset()
+    {
+        passes.clear();
+        resources.clear();
+    }
+
+    // a texture that lives only within this frame, backed by the pool
+    Resource createTexture(const char *name, const TextureDesc &desc)
+    {
+        ResourceNode r;
+        r.name = name;
+        r.desc = desc;
+        r.transient = true;
+        resources.push_back(r);
+        return (Resource)resources.size() - 1;
+    }
+
+    // a texture (or 0: the window) owned outside the graph; passes writing it are what the frame is for.
+    // Its name may still be unknown (setTexture()).
+    Resource importTexture(const char *name, GLuint texture = 0)
+    {
+        ResourceNode r;
+        r.name = name;
+        r.texture = texture;
+        resources.push_back(r);
+        return (Resource)resources.size() - 1;
+    }
+
+    // an imported resource's texture, for one that a pass only learns as it runs (AutoExposure's texel)
+    void setTexture(Resource resource, GLuint texture) { resources[resource].texture = texture; }
+
+    // `name` (a literal) labels it in the profiler
+    Pass addPass(const char *name, Execute fn)
+    {
+        PassNode p;
+        p.name = name;
+        p.fn = std::move(fn);
+        passes.push_back(p);
+        return (Pass)passes.size() - 1;
+    }
+
+    // declarations, in the order the pass accesses them (NONE is ignored)
+    void read(Pass pass, Resource resource)
+    {
+        if (resource != NONE)
+            passes[pass].accesses.push_back(Access(resource, false));
+    }
+    void write(Pass pass, Resource resource)
+    {
+        if (resource != NONE)
+            passes[pass].accesses.push_back(Access(resource, true));
+    }
+
+    // while a pass runs: the texture behind `resource` (0 for a culled or not yet known one)
+    GLuint texture(Resource resource) const { return resource == NONE ? 0 : resources[resource].texture; }
+    const TextureDesc &desc(Resource resource) const { return resources[resource].desc; }
+
+    // while a pass runs: a framebuffer with `resource`'s texture as its colour attachment, made once per
+    // pool texture
+    GLuint framebuffer(Resource resource)
+    {
+        const GLuint t = texture(resource);
+        if (!t)
+            return 0;
+        std::map<GLuint, GLuint>::const_iterator it = framebuffers.find(t);
+        if (it != framebuffers.end())
+            return it->second;
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            LOG_WARN("[RenderGraph] '" << resources[resource].name << "' can't be rendered to");
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+        framebuffers[t] = fbo;
+        return fbo;
+    }
+
+    // GL thread: culls, orders, assigns the transients their pool textures and runs the passes
+    void execute(GpuProfiler *profiler = nullptr)
+    {
+        ++frame;
+        stats = Stats();
+        const std::vector<int> order = compile();
+        stats.culled = passes.size() - order.size();
+        assignTextures(order);
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            PassNode &p = passes[order[k]];
+            if (profiler)
+            {
+                GpuProfiler::Scope scope(*profiler, p.name);
+                p.fn(*this);
+            }
+            else
+                p.fn(*this);
+        }
+        stats.passes = order.size();
+        trimPool();
+        stats.poolTextures = pool.size();
+        for (size_t i = 0; i < pool.size(); ++i)
+            stats.poolBytes += pool[i].bytes;
+        if (pool.size() > loggedPool)
+        {
+            loggedPool = pool.size();
+            LOG_INFO("[RenderGraph] " << stats.passes << " passes (" << stats.culled << " culled), " << stats.transients
+                     << " transient textures on " << stats.textures << ", pool " << pool.size() << " textures, "
+                     << (stats.poolBytes >> 10) << " KB");
+        }
+    }
+
+    const Stats &lastStats() const { return stats; }
+
+    void releaseGpu()
+    {
+        for (std::map<GLuint, GLuint>::iterator it = framebuffers.begin(); it != framebuffers.end(); ++it)
+            glDeleteFramebuffers(1, &it->second);
+        framebuffers.clear();
+        for (size_t i = 0; i < pool.size(); ++i)
+            glDeleteTextures(1, &pool[i].texture);
+        pool.clear();
+        loggedPool = 0;
+        reset();
+        glState().invalidate();
+    }
+
+private:
+    struct Access
+    {
+        Resource resource;
+        bool write;
+        Access(Resource resource, bool write) : resource(resource), write(write) {}
+    };
+
+    struct PassNode
+    {
+        const char *name = "pass";
+        Execute fn;
+        std::vector<Access> accesses;
+    };
+
+    struct ResourceNode
+    {
+        std::string name;
+        TextureDesc desc;
+        bool transient = false;
+        GLuint texture = 0;
+    };
+
+    struct PoolTexture
+    {
+        TextureDesc desc;
+        GLuint texture = 0;
+        size_t bytes = 0;
+        unsigned long long lastUsed = 0;
+        bool busy = false; // backing a transient right now (during assignTextures())
+    };
+
+    std::vector<PassNode> passes;
+    std::vector<ResourceNode> resources;
+    std::vector<PoolTexture> pool;
+    std::map<GLuint, GLuint> framebuffers; // pool texture -> its framebuffer
+    unsigned long long frame = 0;
+    size_t loggedPool = 0;
+    Stats stats;
+
+    // the passes to run, in order
+    std::vector<int> compile() const
+    {
+        const size_t n = passes.size();
+        std::vector<std::vector<int> > dependencies(n);
+        std::vector<int> lastWriter(resources.size(), NONE);
+        std::vector<std::vector<int> > readersSince(resources.size());
+        for (size_t p = 0; p < n; ++p)
+        {
+            for (size_t a = 0; a < passes[p].accesses.size(); ++a)
+            {
+                const Access &access = passes[p].accesses[a];
+                const Resource r = access.resource;
+                if (lastWriter[r] != NONE && lastWriter[r] != (int)p)
+                    dependencies[p].push_back(lastWriter[r]);
+                if (!access.write)
+                {
+                    readersSince[r].push_back((int)p);
+                    continue;
+                }
+                for (size_t k = 0; k < readersSince[r].size(); ++k)
+                    if (readersSince[r][k] != (int)p)
+                        dependencies[p].push_back(readersSince[r][k]);
+                readersSince[r].clear();
+                lastWriter[r] = (int)p;
+            }
+        }
+        // what the frame is for, and everything it depends on
+        std::vector<char> needed(n, 0);
+        std::vector<int> stack;
+        for (size_t p = 0; p < n; ++p)
+            for (size_t a = 0; a < passes[p].accesses.size(); ++a)
+                if (passes[p].accesses[a].write && !resources[passes[p].accesses[a].resource].transient && !needed[p])
+                {
+                    needed[p] = 1;
+                    stack.push_back((int)p);
+                }
+        while (!stack.empty())
+        {
+            const int p = stack.back();
+            stack.pop_back();
+            for (size_t k = 0; k < dependencies[p].size(); ++k)
+                if (!needed[dependencies[p][k]])
+                {
+                    needed[dependencies[p][k]] = 1;
+                    stack.push_back(dependencies[p][k]);
+                }
+        }
+        // Kahn's algorithm, the earliest declared ready pass first
+        std::vector<int> waiting(n, 0);
+        std::vector<std::vector<int> > dependents(n);
+        for (size_t p = 0; p < n; ++p)
+        {
+            if (!needed[p])
+                continue;
+            std::vector<int> deps = dependencies[p];
+            std::sort(deps.begin(), deps.end());
+            deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+            waiting[p] = (int)deps.size();
+            for (size_t k = 0; k < deps.size(); ++k)
+                dependents[deps[k]].push_back((int)p);
+        }
+        std::vector<int> ready, order;
+        for (size_t p = 0; p < n; ++p)
+            if (needed[p] && waiting[p] == 0)
+                ready.push_back((int)p);
+        while (!ready.empty())
+        {
+            std::vector<int>::iterator first = std::min_element(ready.begin(), ready.end());
+            const int p = *first;
+            ready.erase(first);
+            order.push_back(p);
+            for (size_t k = 0; k < dependents[p].size(); ++k)
+                if (--waiting[dependents[p][k]] == 0)
+                    ready.push_back(dependents[p][k]);
+        }
+        return order;
+    }
+
+    // each transient gets a pool texture of its description from its first use to its last
+    void assignTextures(const std::vector<int> &order)
+    {
+        std::vector<int> first(resources.size(), NONE), last(resources.size(), NONE);
+        for (size_t k = 0; k < order.size(); ++k)
+            for (size_t a = 0; a < passes[order[k]].accesses.size(); ++a)
+            {
+                const Resource r = passes[order[k]].accesses[a].resource;
+                if (first[r] == NONE)
+                    first[r] = (int)k;
+                last[r] = (int)k;
+            }
+        std::vector<int> backing(resources.size(), NONE);
+        for (size_t i = 0; i < pool.size(); ++i)
+            pool[i].busy = false;
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            for (size_t r = 0; r < resources.size(); ++r)
+                if (resources[r].transient && first[r] == (int)k)
+                {
+                    backing[r] = acquire(resources[r].desc);
+                    resources[r].texture = pool[backing[r]].texture;
+                    ++stats.transients;
+                }
+            // released after the pass: a transient starting in it can't take the texture of one ending there
+            for (size_t r = 0; r < resources.size(); ++r)
+                if (resources[r].transient && last[r] == (int)k)
+                    pool[backing[r]].busy = false;
+        }
+        std::vector<char> used(pool.size(), 0);
+        for (size_t r = 0; r < resources.size(); ++r)
+            if (backing[r] != NONE && !used[backing[r]])
+            {
+                used[backing[r]] = 1;
+                ++stats.textures;
+            }
+    }
+
+    // a free pool texture of `desc`, created if there is none
+    int acquire(const TextureDesc &desc)
+    {
+        for (size_t i = 0; i < pool.size(); ++i)
+            if (!pool[i].busy && pool[i].desc == desc)
+            {
+                pool[i].busy = true;
+                pool[i].lastUsed = frame;
+                return (int)i;
+            }
+        PoolTexture t;
+        t.desc = desc;
+        t.lastUsed = frame;
+        t.busy = true;
+        glGenTextures(1, &t.texture);
+        glBindTexture(GL_TEXTURE_2D, t.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, desc.internalFormat, desc.width, desc.height, 0, desc.format, desc.type, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glState().invalidate();
+        t.bytes = (size_t)desc.width * (size_t)desc.height * bytesPerTexel(desc.internalFormat);
+        pool.push_back(t);
+        return (int)pool.size() - 1;
+    }
+
+    void trimPool()
+    {
+        for (size_t i = pool.size(); i-- > 0;)
+        {
+            if (frame - pool[i].lastUsed <= POOL_FRAMES)
+                continue;
+            std::map<GLuint, GLuint>::iterator it = framebuffers.find(pool[i].texture);
+            if (it != framebuffers.end())
+            {
+                glDeleteFramebuffers(1, &it->second);
+                framebuffers.erase(it);
+            }
+            glDeleteTextures(1, &pool[i].texture);
+            pool.erase(pool.begin() + (std::ptrdiff_t)i);
+        }
+        loggedPool = std::min(loggedPool, pool.size());
+    }
+
+    static size_t bytesPerTexel(GLenum internalFormat)
+    {
+        switch (internalFormat)
+        {
+        case GL_R8: return 1;
+        case GL_RG8: case GL_R16F: return 2;
+        case GL_RGBA8: case GL_R11F_G11F_B10F: case GL_RG16F: case GL_R32F: return 4;
+        case GL_RGBA16F: case GL_RG32F: return 8;
+        case GL_RGBA32F: return 16;
+        default: return 4;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef SCENE_CULLER_H
+#define SCENE_CULLER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <compute_shader.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <mesh.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// GPU_DRIVEN=1: the opaque pass of every model placed in the scene is culled and compacted on the GPU. Each
+// model keeps its opaque draws (model-space box, material bucket) and the world transforms of all its
+// placements in buffers that only change when the model does or something moves. A compute pass
+// (shaders/scene_cull.comp) tests every draw of every placement against the view frustum and appends the
+// survivors to their bucket's region of a command buffer, with the placement as base instance (the
+// vertex shader's instance transform). The model then draws one glMultiDrawElementsIndirectCount per
+// material bucket (GL 4.6; on GL 4.3 the whole region, whose unused commands are cleared to zero
+// triangles), so the CPU cost of a model is a dispatch and a draw per bucket whatever its mesh and
+// placement counts. Draw ranges come from the model's own command buffer, so LOD switches carry over.
+// Needs compute shaders; without them the models draw as usual.
+class SceneCuller
+{
+public:
+    // std430 mirror of scene_cull.comp's Draw
+    struct GpuDraw
+    {
+        glm::vec4 boundsMin;
+        glm::vec4 boundsMax;
+        GLuint bucket;
+        GLuint bucketFirst; // first draw of the bucket: its commands start at bucketFirst * placements
+        GLuint pad[2];
+    };
+
+    // GPU state of one model
+    struct Target
+    {
+        unsigned int drawCount = 0;
+        unsigned int bucketCount = 0;
+        unsigned int placementCount = 0;
+        unsigned int revision = 0; // of the placements last uploaded
+        GLuint drawBuffer = 0;
+        GLuint placementBuffer = 0; // Mesh::InstanceTransform per placement; also the instance attributes
+        GLuint commandBuffer = 0;
+        // one draw count per bucket (GL_PARAMETER_BUFFER on GL 4.6)
+        GLuint countBuffer = 0;
+
+        bool ready() const { return drawCount != 0; }
+
+        void release()
+        {
+            gpuMemory().releaseBuffer(drawBuffer);
+            gpuMemory().releaseBuffer(placementBuffer);
+            gpuMemory().releaseBuffer(commandBuffer);
+            GLuint buffers[4] = {drawBuffer, placementBuffer, commandBuffer, countBuffer};
+            for (int b = 0; b < 4; ++b)
+                if (buffers[b])
+                    glDeleteBuffers(1, &buffers[b]);
+            drawBuffer = placementBuffer = commandBuffer = countBuffer = 0;
+            drawCount = bucketCount = placementCount = revision = 0;
+        }
+    };
+
+    // `shaderDir` holds scene_cull.comp
+    explicit SceneCuller(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    SceneCuller(const SceneCuller &) = delete;
+    SceneCuller &operator=(const SceneCuller &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("GPU_DRIVEN");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the cull program (needs GL 4.3)
+    void init()
+    {
+        if (ComputeShader::supported())
+            program.reset(new ComputeShader((shaderDir + "/scene_cull.comp").c_str()));
+        if (ready())
+            LOG_INFO("[GpuDriven] Opaque draws culled on the GPU, " << (drawCountSupported() ? "counted with glMultiDrawElementsIndirectCount" : "padded with empty commands"));
+        else
+            LOG_INFO("[GpuDriven] Needs compute shaders (GL 4.3), drawing models as usual");
+    }
+
+    bool ready() const { return program && program->valid(); }
+
+    // the GPU can source the draw count from the count buffer
+    static bool drawCountSupported() { return GLAD_GL_VERSION_4_6 != 0; }
+
+    // uploads the opaque draws of a model, in `bucketCount` buckets
+    void prepare(Target &target, const std::vector<GpuDraw> &draws, unsigned int bucketCount, const std::string &owner)
+    {
+        target.release();
+        if (draws.empty())
+            return;
+        target.drawCount = (unsigned int)draws.size();
+        target.bucketCount = bucketCount;
+        glGenBuffers(1, &target.drawBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.drawBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, draws.size() * sizeof(GpuDraw), &draws[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(target.drawBuffer, GpuMemory::DRAW_BUFFERS, draws.size() * sizeof(GpuDraw), owner);
+        glGenBuffers(1, &target.placementBuffer);
+        glGenBuffers(1, &target.commandBuffer);
+        glGenBuffers(1, &target.countBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    // the world transforms of the model's placements; re-uploaded only when `revision` differs from the last
+    void place(Target &target, const std::vector<glm::mat4> &placements, unsigned int revision, const std::string &owner)
+    {
+        if (!target.ready() || (revision == target.revision && placements.size() == target.placementCount))
+            return;
+        target.revision = revision;
+        target.placementCount = (unsigned int)placements.size();
+        if (placements.empty())
+            return;
+        std::vector<Mesh::InstanceTransform> transforms(placements.size());
+        for (size_t p = 0; p < placements.size(); ++p)
+            transforms[p] = Mesh::instanceTransform(placements[p]);
+        glBindBuffer(GL_ARRAY_BUFFER, target.placementBuffer);
+        glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(Mesh::InstanceTransform), &transforms[0], GL_DYNAMIC_DRAW);
+        gpuMemory().trackBuffer(target.placementBuffer, GpuMemory::DRAW_BUFFERS, transforms.size() * sizeof(Mesh::InstanceTransform), owner);
+        // every draw of a bucket could survive in every placement
+        const size_t commandBytes = (size_t)target.drawCount * target.placementCount * 5 * sizeof(GLuint);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, target.commandBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commandBytes, NULL, GL_STREAM_DRAW);
+        gpuMemory().trackBuffer(target.commandBuffer, GpuMemory::DRAW_BUFFERS, commandBytes, owner);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    // GL thread, before the model's opaque draws: culls its draws in every placement against
+    // `viewProjection`, taking the index ranges from `sourceCommands` (the model's DrawElementsIndirectCommands)
+    void cull(Target &target, GLuint sourceCommands, const glm::mat4 &viewProjection)
+    {
+        if (!ready() || !target.ready() || target.placementCount == 0)
+            return;
+        // orphaned, since an earlier pass may still read them, then zeroed: counts start at 0 and, without
+        // a GPU draw count, the unused commands draw nothing
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.countBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, target.bucketCount * sizeof(GLuint), NULL, GL_STREAM_DRAW);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, target.commandBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)target.drawCount * target.placementCount * 5 * sizeof(GLuint), NULL, GL_STREAM_DRAW);
+        if (!drawCountSupported())
+            glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        const Frustum frustum(viewProjection);
+        program->use();
+        program->setVec4v("frustumPlanes", frustum.planes, 6);
+        program->setUint("drawCount", target.drawCount);
+        program->setUint("placementCount", target.placementCount);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, target.drawBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, sourceCommands);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, target.placementBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, target.commandBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, target.countBuffer);
+        glDispatchCompute((target.drawCount * target.placementCount + 63) / 64, 1, 1);
+        // consumed as indirect commands and draw counts
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+    }
+
+    void releaseGpu()
+    {
+        program.reset();
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    std::unique_ptr<ComputeShader> program;
+};
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef SCENE_DESCRIPTION_H
+#define SCENE_DESCRIPTION_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <camera.h>
+#include <clustered_lights.h>
+#include <json.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// What the app shows: the models and where they stand, the environment, fixed lights and camera presets.
+// SCENE=<scene.json> reads it from a file; without it the built-in showroom loads (the Raptor at the
+// origin, the Shelby 3 units to +X with the PARKING_LOT copies, river_alcove_1k.exr).
+//
+//     {"root": "assets",
+//      "environment": "studio.exr",
+//      "models": [{"path": "ford_raptor/scene.gltf", "position": [0, 0, 0], "rotation": [0, 90, 0], "scale": 1,
+//                  "instances": [[6, 0, 0], [-6, 0, 0]]},
+//                 {"path": "shelby/scene.gltf", "position": [3, 0, 0], "movable": true, "parking_lot": true,
+//                  "variants": ["shelby_gt500/scene.gltf", "shelby_convertible/scene.gltf"]}],
+//      "lights": [{"position": [0, 4, 0], "color": [1, 0.9, 0.8], "intensity": 10, "radius": 8},
+//                 {"position": [2, 3, 2], "direction": [-1, -1, -1], "inner": 20, "outer": 30},
+//                 {"position": [0, 3, 0], "direction": [0, -1, 0], "size": [1, 3], "up": [0, 0, 1], "intensity": 4}],
+//      "cameras": [{"name": "front", "position": [0, 1.2, 6], "target": [0, 0.6, 0], "fov": 40},
+//                  {"name": "side", "position": [8, 1.5, 0], "yaw": 180, "pitch": -5}],
+//      "paints": [{"name": "rosso", "color": [0.55, 0.02, 0.02], "metallic": 0.6, "roughness": 0.25}]}
+//
+// Paths are relative to "root", itself relative to the scene file (default: the file's directory). A
+// model is centred on its bounds, rotated (degrees, XYZ) and scaled about that centre, then moved to
+// `position` and, with "ground" (default on, as the built-in scene), down by half its height; "movable"
+// ones follow the model controls. Every entry of "instances" places it once more the same way. Entries
+// naming the same path share one import (and its textures) and only add placements. "variants" are other
+// models a configurator shows in the same placements: V steps the first model that has them through its
+// path and its variants, keeping the recently shown ones loaded (ModelCache). The environment is
+// an .exr or "procedural" (EXR_PATH still overrides it). Lights with "outer" (degrees) are spots, lights
+// with a "size" (width, height) rectangular area lights facing "direction", their height along "up". The first
+// camera is where the view starts (unless AUTO_FRAME=1 frames the scene); C steps through them. B steps
+// the paint materials (MaterialOverrides) through "paints" (a few stock ones without it) and back to the
+// authored paint; a paint leaves out what it doesn't name.
+class SceneDescription
+{
+public:
+    struct Placement
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 rotation = glm::vec3(0.0f);
+        float scale = 1.0f;
+        bool ground = true;
+        bool movable = false; // follows the model controls (M, L, arrows)
+    };
+
+    struct ModelEntry
+    {
+        std::string path;        // resolved
+        bool parkingLot = false; // PARKING_LOT copies are parked behind its first placement
+        std::vector<Placement> placements; // of every entry naming the path: "position", then "instances"
+        std::vector<std::string> variants; // resolved; V swaps them in for `path` in its placements (ModelCache)
+    };
+
+    struct CameraPreset
+    {
+        std::string name;
+        glm::vec3 position = glm::vec3(0.0f, 0.0f, 2.0f);
+        float yaw = YAW, pitch = PITCH, fov = ZOOM;
+    };
+
+    struct Paint
+    {
+        std::string name;
+        glm::vec3 color = glm::vec3(-1.0f); // linear; negative = the authored one
+        float metallic = -1.0f;             // negative = the authored one
+        float roughness = -1.0f;
+    };
+
+    std::vector<ModelEntry> models; // one per distinct path, in order of first mention
+    std::string environment;        // resolved .exr path, "procedural", or empty for the default
+    std::vector<ClusteredLights::Light> lights;
+    std::vector<CameraPreset> cameras;
+    std::vector<Paint> paints;
+    std::string file; // SCENE's file, empty for the built-in scene
+
+    // SCENE's file, or the built-in showroom under `defaultRoot`; false (and the built-in scene) when the
+    // file can't be read
+    bool load(const std::string &defaultRoot)
+    {
+        const char *env = std::getenv("SCENE");
+        if (!env || !*env)
+        {
+            builtIn(defaultRoot);
+            return true;
+        }
+        const std::string path = env;
+        if (!read(path))
+        {
+            builtIn(defaultRoot);
+            return false;
+        }
+        size_t placements = 0;
+        for (size_t i = 0; i < models.size(); ++i)
+            placements += models[i].placements.size();
+        LOG_INFO("[Scene] " << path << ": " << models.size() << " models, " << placements << " placements, " << lights.size()
+                 << " lights, " << cameras.size() << " cameras");
+        return true;
+    }
+
+    // replaces this description by `path`'s; false (and this unchanged) when it can't be read or parsed
+    bool read(const std::string &path)
+    {
+        try
+        {
+            std::ifstream in(path.c_str());
+            if (!in)
+            {
+                LOG_ERROR("[Scene] Can't open scene file " << path);
+                return false;
+            }
+            nlohmann::json scene = nlohmann::json::parse(in);
+            SceneDescription fresh;
+            fresh.parse(scene, directoryOf(path));
+            fresh.file = path;
+            *this = fresh;
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR("[Scene] Bad scene file " << path << ": " << e.what());
+            return false;
+        }
+        return true;
+    }
+
+    // world matrix of placement `p` of a model whose bounds are [boundsMin, boundsMax]
+    static glm::mat4 placementMatrix(const Placement &p, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        glm::vec3 worldPos = p.position;
+        if (p.ground)
+            worldPos.y -= (boundsMax.y - boundsMin.y) * 0.5f;
+        // move model so its bbox center is at origin, then rotate and scale, then translate to world position
+        glm::mat4 mm = glm::translate(glm::mat4(1.0f), worldPos);
+        mm = glm::rotate(mm, glm::radians(p.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+        mm = glm::rotate(mm, glm::radians(p.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+        mm = glm::rotate(mm, glm::radians(p.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+        mm = glm::scale(mm, glm::vec3(p.scale));
+        return glm::translate(mm, -center);
+    }
+
+    // puts `camera` at `preset`
+    static void applyCamera(const CameraPreset &preset, Camera &camera)
+    {
+        camera.Position = preset.position;
+        camera.Yaw = preset.yaw;
+        camera.Pitch = preset.pitch;
+        camera.Zoom = preset.fov;
+        camera.ProcessMouseMovement(0.0f, 0.0f);
+    }
+
+private:
+    void builtIn(const std::string &root)
+    {
+        *this = SceneDescription();
+        ModelEntry raptor;
+        raptor.path = root + "/ford_raptor/scene.gltf";
+        raptor.placements.push_back(Placement());
+        models.push_back(raptor);
+        ModelEntry shelby;
+        shelby.path = root + "/models/2024_ford_shelby_super_snake_s650/scene.gltf";
+        shelby.parkingLot = true;
+        Placement side;
+        side.position = glm::vec3(3.0f, 0.0f, 0.0f);
+        shelby.placements.push_back(side);
+        models.push_back(shelby);
+        environment = root + "/river_alcove_1k.exr";
+        paints = stockPaints();
+    }
+
+    static std::vector<Paint> stockPaints()
+    {
+        static const struct { const char *name; float r, g, b, metallic, roughness; } stock[] = {
+            {"racing red", 0.50f, 0.02f, 0.02f, 0.3f, 0.25f},
+            {"pearl white", 0.80f, 0.80f, 0.78f, 0.2f, 0.2f},
+            {"midnight blue", 0.01f, 0.03f, 0.12f, 0.7f, 0.3f},
+            {"gloss black", 0.01f, 0.01f, 0.01f, 0.0f, 0.1f},
+            {"satin silver", 0.55f, 0.56f, 0.58f, 0.9f, 0.45f}};
+        std::vector<Paint> out;
+        for (size_t i = 0; i < sizeof(stock) / sizeof(stock[0]); ++i)
+        {
+            Paint p;
+            p.name = stock[i].name;
+            p.color = glm::vec3(stock[i].r, stock[i].g, stock[i].b);
+            p.metallic = stock[i].metallic;
+            p.roughness = stock[i].roughness;
+            out.push_back(p);
+        }
+        return out;
+    }
+
+    static std::string directoryOf(const std::string &path)
+    {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+    }
+
+    static bool absolute(const std::string &path)
+    {
+        return !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+    }
+
+    static std::string resolve(const std::string &root, const std::string &path)
+    {
+        return absolute(path) ? path : root + "/" + path;
+    }
+
+    static glm::vec3 vec3Of(const nlohmann::json &j)
+    {
+        return glm::vec3(j.at(0).get<float>(), j.at(1).get<float>(), j.at(2).get<float>());
+    }
+
+    void parse(const nlohmann::json &scene, const std::string &sceneDir)
+    {
+        const std::string root = scene.contains("root") ? resolve(sceneDir, scene["root"].get<std::string>()) : sceneDir;
+        if (scene.contains("environment"))
+        {
+            const std::string env = scene["environment"].get<std::string>();
+            environment = env == "procedural" ? env : resolve(root, env);
+        }
+        if (scene.contains("models"))
+        {
+            for (const nlohmann::json &e : scene["models"])
+            {
+                const std::string path = resolve(root, e.at("path").get<std::string>());
+                // a path listed again adds placements to the first entry (one import, shared textures)
+                ModelEntry *m = NULL;
+                for (size_t i = 0; i < models.size(); ++i)
+                    if (models[i].path == path)
+                        m = &models[i];
+                if (!m)
+                {
+                    models.push_back(ModelEntry());
+                    m = &models.back();
+                    m->path = path;
+                }
+                else
+                    LOG_DEBUG("[Scene] '" << path << "' listed again, placed from the same import");
+                m->parkingLot = m->parkingLot || e.value("parking_lot", false);
+                Placement p;
+                if (e.contains("position"))
+                    p.position = vec3Of(e["position"]);
+                if (e.contains("rotation"))
+                    p.rotation = vec3Of(e["rotation"]);
+                p.scale = e.value("scale", p.scale);
+                p.ground = e.value("ground", p.ground);
+                p.movable = e.value("movable", p.movable);
+                m->placements.push_back(p);
+                if (e.contains("variants"))
+                    for (const nlohmann::json &v : e["variants"])
+                        m->variants.push_back(resolve(root, v.get<std::string>()));
+                if (e.contains("instances"))
+                    for (const nlohmann::json &at : e["instances"])
+                    {
+                        Placement copy = p;
+                        copy.position = vec3Of(at);
+                        m->placements.push_back(copy);
+                    }
+            }
+        }
+        if (scene.contains("lights"))
+        {
+            for (const nlohmann::json &e : scene["lights"])
+            {
+                if (lights.size() == (size_t)ClusteredLights::MAX_LIGHTS)
+                {
+                    LOG_WARN("[Scene] More than " << ClusteredLights::MAX_LIGHTS << " lights, ignoring the rest");
+                    break;
+                }
+                ClusteredLights::Light light;
+                light.position = vec3Of(e.at("position"));
+                if (e.contains("color"))
+                    light.color = vec3Of(e["color"]);
+                light.intensity = e.value("intensity", light.intensity);
+                light.radius = e.value("radius", light.radius);
+                if (e.contains("outer"))
+                {
+                    const float outer = e["outer"].get<float>();
+                    light.direction = e.contains("direction") ? vec3Of(e["direction"]) : light.direction;
+                    light.cosOuter = std::cos(glm::radians(outer));
+                    light.cosInner = std::cos(glm::radians(e.value("inner", outer * 0.75f)));
+                }
+                else if (e.contains("size"))
+                {
+                    light.direction = e.contains("direction") ? vec3Of(e["direction"]) : light.direction;
+                    light.size = glm::vec2(e["size"][0].get<float>(), e["size"][1].get<float>());
+                    light.up = e.contains("up") ? vec3Of(e["up"]) : light.up;
+                }
+                lights.push_back(light);
+            }
+        }
+        if (scene.contains("cameras"))
+        {
+            for (const nlohmann::json &e : scene["cameras"])
+            {
+                CameraPreset c;
+                c.name = e.value("name", "camera " + std::to_string(cameras.size() + 1));
+                if (e.contains("position"))
+                    c.position = vec3Of(e["position"]);
+                c.fov = e.value("fov", c.fov);
+                if (e.contains("target"))
+                {
+                    const glm::vec3 dir = glm::normalize(vec3Of(e["target"]) - c.position);
+                    c.yaw = glm::degrees(std::atan2(dir.z, dir.x));
+                    c.pitch = glm::degrees(std::asin(glm::clamp(dir.y, -1.0f, 1.0f)));
+                }
+                else
+                {
+                    c.yaw = e.value("yaw", c.yaw);
+                    c.pitch = e.value("pitch", c.pitch);
+                }
+                cameras.push_back(c);
+            }
+        }
+        if (scene.contains("paints"))
+        {
+            for (const nlohmann::json &e : scene["paints"])
+            {
+                Paint p;
+                p.name = e.value("name", "paint " + std::to_string(paints.size() + 1));
+                if (e.contains("color"))
+                    p.color = vec3Of(e["color"]);
+                p.metallic = e.value("metallic", p.metallic);
+                p.roughness = e.value("roughness", p.roughness);
+                paints.push_back(p);
+            }
+        }
+        else
+            paints = stockPaints();
+    }
+};
+
+#endif
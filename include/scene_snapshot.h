@@ -0,0 +1,223 @@
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+#include <glm/glm.hpp>
+
+#include <camera.h>
+#include <procedural_sky.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One-shot requests from input to the renderer (key presses, clicks, drops). They queue in SnapshotExchange
+// until the renderer takes a snapshot, so none is lost when the renderer skips snapshots.
+struct InputEvents
+{
+    bool pick = false;           // left click: pick the mesh under the crosshair
+    bool hudToggle = false;      // O
+    bool toneCurveCycle = false; // T
+    bool variantCycle = false;   // V: the next model variant (SceneDescription::ModelEntry::variants)
+    bool materialVariantCycle = false; // N: the focused model's next KHR_materials_variants variant
+    bool paintCycle = false;     // B: the next paint (MaterialOverrides)
+    bool partCycle = false;      // K: the focused model's next configurable part hidden (Model::setPartVisible)
+    bool debugViewCycle = false; // G: the next debug view (DebugViews)
+    bool cullFreeze = false;     // F, with CULL_DEBUG: freeze / release the culling camera
+    bool profileReport = false;  // P, with PROFILE=1
+    bool skyChanged = false;     // the sun moved (SceneSnapshot::sky)
+    bool redraw = false;         // any window event (IdleRenderer)
+    std::vector<std::string> droppedEnvironments;
+
+    bool empty() const
+    {
+        return !pick && !hudToggle && !toneCurveCycle && !variantCycle && !materialVariantCycle && !paintCycle && !partCycle && !debugViewCycle && !cullFreeze && !profileReport && !skyChanged && !redraw && droppedEnvironments.empty();
+    }
+
+    void merge(const InputEvents &later)
+    {
+        pick = pick || later.pick;
+        hudToggle = hudToggle || later.hudToggle;
+        toneCurveCycle = toneCurveCycle || later.toneCurveCycle;
+        variantCycle = variantCycle || later.variantCycle;
+        materialVariantCycle = materialVariantCycle || later.materialVariantCycle;
+        paintCycle = paintCycle || later.paintCycle;
+        partCycle = partCycle || later.partCycle;
+        debugViewCycle = debugViewCycle || later.debugViewCycle;
+        cullFreeze = cullFreeze || later.cullFreeze;
+        profileReport = profileReport || later.profileReport;
+        skyChanged = skyChanged || later.skyChanged;
+        redraw = redraw || later.redraw;
+        droppedEnvironments.insert(droppedEnvironments.end(), later.droppedEnvironments.begin(), later.droppedEnvironments.end());
+    }
+};
+
+// Everything the renderer reads of input and simulation, copied whole once per frame: the renderer never
+// looks at the input side's state directly, so the two can run on different threads (RENDER_THREAD=1)
+struct SceneSnapshot
+{
+    Camera camera;
+    glm::vec3 carOffset = glm::vec3(0.0f);
+    ProceduralSky sky;
+    bool showModelControlHelp = false;
+    int framebufferWidth = 0, framebufferHeight = 0;
+    unsigned int cameraGeneration = 0; // SnapshotExchange::overrideCamera() calls the camera has seen
+    std::vector<glm::mat4> vehicles;   // VEHICLE_SIM: body frames of the cars, the player's first
+    bool cameraSettled = true;         // ORBIT_CAMERA's glide has come to rest (OrbitCamera::settled)
+
+    // the same view and scene (the events aside)
+    bool sameState(const SceneSnapshot &o) const
+    {
+        return camera.Position == o.camera.Position && camera.Front == o.camera.Front && camera.Up == o.camera.Up &&
+               camera.Zoom == o.camera.Zoom && carOffset == o.carOffset && sky.sunDirection == o.sky.sunDirection &&
+               sky.sunIntensity == o.sky.sunIntensity && showModelControlHelp == o.showModelControlHelp &&
+               framebufferWidth == o.framebufferWidth && framebufferHeight == o.framebufferHeight &&
+               cameraGeneration == o.cameraGeneration && cameraSettled == o.cameraSettled && vehicles == o.vehicles;
+    }
+};
+
+// Triple buffer of SceneSnapshots between input (producer) and renderer (consumer). The producer fills
+// back() and publish()es it; the consumer take()s the newest published one into front(), which stays its
+// own until the next take() (no copy under the lock, and neither side ever waits for the other's frame).
+// Snapshots the consumer didn't get to are simply replaced; the events they carried stay queued.
+// The renderer places the camera itself now and then (AUTO_FRAME): overrideCamera() hands that pose back
+// to the producer, and front()'s camera only counts once a snapshot built on it arrives (cameraCurrent()).
+class SnapshotExchange
+{
+public:
+    // producer: the slot to fill before publish()
+    SceneSnapshot &back() { return slots[backIndex]; }
+
+    // producer: hands back() to the consumer with `events` (cleared) queued. Skipped when neither the
+    // state nor the events changed since the last publish; returns whether it published.
+    bool publish(InputEvents &events)
+    {
+        SceneSnapshot &slot = slots[backIndex];
+        slot.cameraGeneration = producerGeneration;
+        if (havePublished && events.empty() && slot.sameState(lastPublished))
+            return false;
+        lastPublished = slot;
+        havePublished = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(backIndex, readyIndex);
+            fresh = true;
+            queued.merge(events);
+        }
+        events = InputEvents();
+        published.notify_one();
+        return true;
+    }
+
+    // consumer: moves the newest snapshot to front() and the queued events into `events`; false (and
+    // nothing moved) when nothing was published since the last take
+    bool take(InputEvents &events)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!fresh)
+            return false;
+        std::swap(frontIndex, readyIndex);
+        fresh = false;
+        events = queued;
+        queued = InputEvents();
+        return true;
+    }
+
+    const SceneSnapshot &front() const { return slots[frontIndex]; }
+
+    // consumer: blocks until something is published (true), the timeout passes or stop() is called
+    bool waitForPublish(double seconds)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        waiting = true;
+        published.wait_for(lock, std::chrono::duration<double>(seconds), [this]() { return fresh || stopped; });
+        waiting = false;
+        return fresh;
+    }
+
+    // producer: whether the consumer is blocked in waitForPublish() (the producer can poll more slowly)
+    bool consumerWaiting() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return waiting;
+    }
+
+    // wakes a waiting consumer for good (shutdown)
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        published.notify_all();
+    }
+
+    // consumer: the renderer moved the camera to `camera`; input continues from there
+    void overrideCamera(const Camera &camera)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        overrideCameraValue = camera;
+        ++overrideGeneration;
+    }
+
+    // producer, before stepping input: replaces `camera` with a pending override; true if there was one
+    bool takeCameraOverride(Camera &camera)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (producerGeneration == overrideGeneration)
+            return false;
+        camera = overrideCameraValue;
+        producerGeneration = overrideGeneration;
+        return true;
+    }
+
+    // consumer: ORBIT_CAMERA should orbit the world box `boundsMin`-`boundsMax` from now on
+    void focusOrbit(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        focusMin = boundsMin;
+        focusMax = boundsMax;
+        focusPending = true;
+    }
+
+    // producer, before stepping input: the box of a pending focusOrbit(); true if there was one
+    bool takeOrbitFocus(glm::vec3 &boundsMin, glm::vec3 &boundsMax)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!focusPending)
+            return false;
+        boundsMin = focusMin;
+        boundsMax = focusMax;
+        focusPending = false;
+        return true;
+    }
+
+    // consumer: front()'s camera already includes the last override (older snapshots would undo it)
+    bool cameraCurrent() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return slots[frontIndex].cameraGeneration == overrideGeneration;
+    }
+
+private:
+    SceneSnapshot slots[3];
+    int backIndex = 0, readyIndex = 1, frontIndex = 2;
+    bool fresh = false;
+    InputEvents queued;
+    // producer only
+    SceneSnapshot lastPublished;
+    bool havePublished = false;
+    unsigned int producerGeneration = 0;
+
+    mutable std::mutex mutex;
+    std::condition_variable published;
+    bool waiting = false;
+    bool stopped = false;
+    Camera overrideCameraValue;
+    unsigned int overrideGeneration = 0;
+    glm::vec3 focusMin = glm::vec3(0.0f), focusMax = glm::vec3(0.0f);
+    bool focusPending = false;
+};
+
+#endif
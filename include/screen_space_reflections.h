@@ -0,0 +1,330 @@
+#ifndef SCREEN_SPACE_REFLECTIONS_H
+#define SCREEN_SPACE_REFLECTIONS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// SSR=1: screen-space reflections of the opaque scene in the specular IBL, so the glossy paint shows the
+// ground and the other cars instead of only the prefiltered environment. trace() runs where the ambient
+// occlusion does (after the depth pre-pass, or before the visibility buffer's resolve), at half resolution:
+//   1. the scene depth is blitted (nearest) into a half-size depth texture and reduced into a pyramid of
+//      the nearest depth per cell (shaders/ssr_hiz.fs)
+//   2. shaders/ssr_trace.fs walks each pixel's mirror ray (normal from the depth) through the pyramid and
+//      stores where the hit was on the previous frame's screen, a confidence and the ray length
+// The colour comes from the previous frame: captureHistory(), at the end of the frame, copies the lit HDR
+// scene into a half-size mipmapped texture, so reflections reuse last frame's shading (reflections of
+// reflections included) instead of shading anything twice. The scene shader reads it at the hit with the
+// mip widened by its roughness (a cone over the ray length) and falls back to the environment where the
+// ray missed or left the screen. SSR_DISTANCE (world units, default 10) is the longest ray.
+class ScreenSpaceReflections
+{
+public:
+    // texture units of the hits and of last frame's colour in the scene shaders (Shader::samplerUnit); the
+    // passes use the first for their one input
+    static const unsigned int UNIT_HITS = 27;
+    static const unsigned int UNIT_HISTORY = 28;
+    // the pyramid stops at 1/32 of the half-size depth: coarser cells only skip empty sky
+    static const int MAX_HIZ_LEVELS = 6;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle), ssr_hiz.fs and ssr_trace.fs
+    explicit ScreenSpaceReflections(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("SSR_DISTANCE"))
+            maxDistance = std::max(0.1f, (float)std::atof(env));
+    }
+
+    ScreenSpaceReflections(const ScreenSpaceReflections &) = delete;
+    ScreenSpaceReflections &operator=(const ScreenSpaceReflections &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("SSR");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the passes
+    void init()
+    {
+        hizShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/ssr_hiz.fs").c_str()));
+        traceShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/ssr_trace.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[SSR] Half-resolution Hi-Z reflections, rays up to " << maxDistance);
+    }
+
+    // false before init() or once the targets turned out unusable
+    bool ready() const { return usable && hizShader && traceShader; }
+
+    // GL thread, with the scene framebuffer (ToneMapper's HDR target, `width` x `height`) holding the opaque
+    // depth: traces this frame's rays for the view's `projection` and `view`, reprojected with last frame's
+    // unjittered `previousViewProjection` (the one captureHistory() saw). The scene framebuffer and its
+    // viewport are bound again afterwards. False (no reflections this frame) without a history to read or
+    // when the targets can't be used.
+    bool trace(int width, int height, const glm::mat4 &projection, const glm::mat4 &view, const glm::mat4 &previousViewProjection)
+    {
+        traced = false;
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!ready() || !historyValid || !scene || width <= 0 || height <= 0)
+            return false;
+        createTargets(std::max(1, width / 2), std::max(1, height / 2));
+        if (!usable)
+            return false;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, depthFbo);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, targetWidth, targetHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glDisable(GL_DEPTH_TEST);
+        glState().bindVertexArray(emptyVao);
+
+        // the pyramid, a level at a time; each pass only has the level above in reach, so the level it
+        // renders into is never sampled
+        glBindFramebuffer(GL_FRAMEBUFFER, hizFbo);
+        hizShader->use();
+        hizShader->setInt("source", (int)UNIT_HITS);
+        for (int level = 0; level < hizLevels; ++level)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, hizTexture, level);
+            glViewport(0, 0, std::max(1, targetWidth >> level), std::max(1, targetHeight >> level));
+            hizShader->setBool("reduce", level > 0);
+            if (level == 0)
+                glState().bindTexture(UNIT_HITS, GL_TEXTURE_2D, depthTexture);
+            else
+            {
+                glState().bindTexture(UNIT_HITS, GL_TEXTURE_2D, hizTexture);
+                glState().activeTexture(UNIT_HITS);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+            }
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+            drawStats().count();
+        }
+        glState().bindTexture(UNIT_HITS, GL_TEXTURE_2D, hizTexture);
+        glState().activeTexture(UNIT_HITS);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, hizLevels - 1);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, hitFbo);
+        glViewport(0, 0, targetWidth, targetHeight);
+        traceShader->use();
+        traceShader->setInt("hiZ", (int)UNIT_HITS);
+        traceShader->setInt("hiZLevels", hizLevels);
+        traceShader->setMat4("projection", projection);
+        traceShader->setMat4("inverseProjection", glm::inverse(projection));
+        traceShader->setMat4("inverseView", glm::inverse(view));
+        traceShader->setMat4("previousViewProjection", previousViewProjection);
+        // glm::perspective: near = P[3][2] / (P[2][2] - 1)
+        traceShader->setFloat("nearPlane", projection[3][2] / (projection[2][2] - 1.0f));
+        traceShader->setFloat("maxDistance", maxDistance);
+        traceShader->setFloat("thickness", thickness);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+        glViewport(0, 0, width, height);
+        glEnable(GL_DEPTH_TEST);
+        glState().bindTexture(UNIT_HITS, GL_TEXTURE_2D, hitTexture);
+        glState().bindTexture(UNIT_HISTORY, GL_TEXTURE_2D, historyTexture);
+        // history pixels per world unit at view depth 1, for the cone's footprint
+        pixelScale = projection[1][1] * 0.5f * (float)historyHeight;
+        traced = true;
+        return true;
+    }
+
+    // points `shader` (the scene shader or its visibility resolve, already in use) at this frame's hits and
+    // last frame's colour, or tells it there are none
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uScreenReflections = Shader::uniformHandle("screenReflections");
+        static const Shader::UniformHandle uReflectionMaxMip = Shader::uniformHandle("reflectionMaxMip");
+        static const Shader::UniformHandle uReflectionPixelScale = Shader::uniformHandle("reflectionPixelScale");
+        shader.setBool(uScreenReflections, traced);
+        if (!traced)
+            return;
+        shader.setFloat(uReflectionMaxMip, (float)(historyMips - 1));
+        shader.setFloat(uReflectionPixelScale, pixelScale);
+        glState().bindTexture(UNIT_HITS, GL_TEXTURE_2D, hitTexture);
+        glState().bindTexture(UNIT_HISTORY, GL_TEXTURE_2D, historyTexture);
+    }
+
+    // GL thread, at the end of the frame with the scene framebuffer (`width` x `height`) fully lit: keeps it
+    // for the next frame's reflections. The scene framebuffer is bound again afterwards.
+    void captureHistory(int width, int height)
+    {
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!ready() || !scene || width <= 0 || height <= 0)
+            return;
+        createHistory(std::max(1, width / 2), std::max(1, height / 2));
+        historyValid = historyFbo != 0;
+        if (!historyValid)
+            return;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, historyFbo);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, historyWidth, historyHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+        glState().bindTexture(UNIT_HISTORY, GL_TEXTURE_2D, historyTexture);
+        glState().activeTexture(UNIT_HISTORY);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    // the next frame's view has nothing to do with this one (a camera cut): no reflections until a new
+    // history exists
+    void resetHistory() { historyValid = false; }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        releaseHistory();
+        hizShader.reset();
+        traceShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        traced = false;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    float maxDistance = 10.0f;
+    // how far behind the depth buffer a ray still counts as hitting it, world units
+    float thickness = 0.3f;
+    bool usable = false;
+    bool traced = false;
+    bool historyValid = false;
+    float pixelScale = 1.0f;
+    std::unique_ptr<Shader> hizShader;
+    std::unique_ptr<Shader> traceShader;
+    // the passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    // half-size depth copy, its R32F nearest-depth pyramid and the RGBA16F hits
+    GLuint depthFbo = 0, depthTexture = 0;
+    GLuint hizFbo = 0, hizTexture = 0;
+    GLuint hitFbo = 0, hitTexture = 0;
+    int hizLevels = 0;
+    int targetWidth = 0, targetHeight = 0;
+    // last frame's lit scene, half size with mips
+    GLuint historyFbo = 0, historyTexture = 0;
+    int historyMips = 0;
+    int historyWidth = 0, historyHeight = 0;
+
+    static void setSampling(GLint minFilter, GLint magFilter)
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    void createTargets(int width, int height)
+    {
+        if (depthFbo && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        hizLevels = 1;
+        while (hizLevels < MAX_HIZ_LEVELS && (std::max(width, height) >> hizLevels) > 0)
+            ++hizLevels;
+        glGenTextures(1, &depthTexture);
+        glGenTextures(1, &hizTexture);
+        glGenTextures(1, &hitTexture);
+        glGenFramebuffers(1, &depthFbo);
+        glGenFramebuffers(1, &hizFbo);
+        glGenFramebuffers(1, &hitFbo);
+
+        // the depth copy matches the scene's 24/8 format, which the blit requires
+        glBindTexture(GL_TEXTURE_2D, depthTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+        setSampling(GL_NEAREST, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, hizTexture);
+        for (int level = 0; level < hizLevels; ++level)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_R32F, std::max(1, width >> level), std::max(1, height >> level), 0, GL_RED, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, hizLevels - 1);
+        setSampling(GL_NEAREST_MIPMAP_NEAREST, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, hitTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        setSampling(GL_NEAREST, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, depthFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, hizFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, hizTexture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, hitFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, hitTexture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        if (!complete)
+        {
+            LOG_WARN("[SSR] Half-size depth copy or float targets unsupported, no screen-space reflections");
+            usable = false;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void createHistory(int width, int height)
+    {
+        if (historyFbo && width == historyWidth && height == historyHeight)
+            return;
+        releaseHistory();
+        historyWidth = width;
+        historyHeight = height;
+        historyMips = 1;
+        while ((std::max(width, height) >> historyMips) > 0)
+            ++historyMips;
+        glGenTextures(1, &historyTexture);
+        glBindTexture(GL_TEXTURE_2D, historyTexture);
+        for (int level = 0; level < historyMips; ++level)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA16F, std::max(1, width >> level), std::max(1, height >> level), 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        setSampling(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &historyFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, historyFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyTexture, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[SSR] Float render targets unsupported, no screen-space reflections");
+            usable = false;
+            releaseHistory();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+    }
+
+    void releaseTargets()
+    {
+        if (depthFbo) glDeleteFramebuffers(1, &depthFbo);
+        if (hizFbo) glDeleteFramebuffers(1, &hizFbo);
+        if (hitFbo) glDeleteFramebuffers(1, &hitFbo);
+        if (depthTexture) glDeleteTextures(1, &depthTexture);
+        if (hizTexture) glDeleteTextures(1, &hizTexture);
+        if (hitTexture) glDeleteTextures(1, &hitTexture);
+        depthFbo = hizFbo = hitFbo = depthTexture = hizTexture = hitTexture = 0;
+        targetWidth = targetHeight = hizLevels = 0;
+    }
+
+    void releaseHistory()
+    {
+        if (historyFbo) glDeleteFramebuffers(1, &historyFbo);
+        if (historyTexture) glDeleteTextures(1, &historyTexture);
+        historyFbo = historyTexture = 0;
+        historyWidth = historyHeight = historyMips = 0;
+        historyValid = false;
+    }
+};
+
+#endif
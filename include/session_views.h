@@ -0,0 +1,340 @@
+#ifndef SESSION_VIEWS_H
+#define SESSION_VIEWS_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <camera.h>
+#include <engine_clock.h>
+#include <frame_capture.h>
+#include <frame_streamer.h>
+#include <frame_trace.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <thread_pool.h>
+#include <tone_mapper.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// STREAM_SESSIONS=1 (with STREAM_PORT): every streaming session gets a view of its own, for configurator
+// users who each look around on their own. The models' buffers and textures, the materials, the IBL maps
+// and the programs are the ones the window draws with, loaded once; a session owns only its camera (placed
+// where the window's was when it joined, steered by its browser's keys, drags and wheel), an HDR target,
+// an RGBA8 copy of it tone mapped, and an encoder (a FrameCapture of its own: pixel buffer ring and JPEG
+// thread), a few MB each. Per frame render() picks sessions round-robin, after the one served last, within
+// the frame's budget: at most STREAM_SESSIONS_PER_FRAME sessions (default 2) besides the window, each at
+// most STREAM_SESSION_FPS times a second (default 30), and none whose last frame is still being read or
+// encoded (a slow encoder or link lowers its own rate, not the others'). A session whose camera hasn't moved
+// in a scene that hasn't changed gets a frame a second only. The picked views are culled against the scene
+// tree side by side on the ThreadPool and drawn through the caller's DrawView like the thumbnail views
+// (the probe program: no shadows, screen-space passes or TAA). STREAM_SCALE sizes the views as it does the
+// shared stream.
+class SessionViews
+{
+public:
+    struct View
+    {
+        int id = 0;
+        Camera camera;
+        // this frame's camera
+        glm::vec3 eye;
+        glm::mat4 view, projection;
+        // cull(): visible[i] for placed model i
+        std::vector<unsigned char> visible;
+    };
+
+    // draws the models visible in `view` with its camera; its target is bound, cleared, with the viewport set
+    typedef std::function<void(const View &view)> DrawView;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("STREAM_SESSIONS");
+        return FrameStreamer::enabledByEnv() && env && std::string(env) == "1";
+    }
+
+    explicit SessionViews(FrameStreamer &streamer)
+        : streamer(streamer)
+    {
+        if (const char *env = std::getenv("STREAM_SESSIONS_PER_FRAME"))
+            perFrame = std::max(1, std::atoi(env));
+        if (const char *env = std::getenv("STREAM_SESSION_FPS"))
+            interval = 1.0 / std::max(1.0, std::atof(env));
+    }
+
+    SessionViews(const SessionViews &) = delete;
+    SessionViews &operator=(const SessionViews &) = delete;
+
+    bool enabled() const { return streamer.sessionViews(); }
+
+    // render thread, once per frame: opens views for new sessions (starting from `start`), closes those of
+    // sessions that left, and moves each camera by its session's input over `deltaTime`
+    void update(const Camera &start, float deltaTime)
+    {
+        if (!enabled())
+            return;
+        streamer.takeSessionInput(inputs);
+        for (size_t i = 0; i < sessions.size();)
+        {
+            bool open = false;
+            for (size_t k = 0; k < inputs.size() && !open; ++k)
+                open = inputs[k].id == sessions[i]->view.id;
+            if (open)
+            {
+                ++i;
+                continue;
+            }
+            close(*sessions[i]);
+            sessions.erase(sessions.begin() + i);
+            LOG_DEBUG("[Sessions] " << sessions.size() << " views open");
+        }
+        for (size_t k = 0; k < inputs.size(); ++k)
+        {
+            Session *session = find(inputs[k].id);
+            if (!session)
+            {
+                sessions.push_back(std::unique_ptr<Session>(new Session()));
+                session = sessions.back().get();
+                session->view.id = inputs[k].id;
+                session->view.camera = start;
+                session->encoder.reset(new FrameCapture(1));
+                LOG_INFO("[Sessions] View " << inputs[k].id << " opened, " << sessions.size() << " views");
+            }
+            steer(*session, inputs[k].input, deltaTime);
+        }
+    }
+
+    // render thread, after the window's frame: renders and starts reading the sessions due this frame, the
+    // window's `windowWidth` x `windowHeight` scaled by STREAM_SCALE; `sceneChanged` when the scene may look
+    // different from the last frames (models moved, loads, bakes). The scene framebuffer is bound again
+    // afterwards, the viewport is not restored.
+    void render(const BVH &sceneTree, float farPlane, bool sceneChanged, int windowWidth, int windowHeight, ToneMapper &toneMapper,
+                const DrawView &drawView)
+    {
+        if (!enabled() || sessions.empty() || !toneMapper.ready())
+            return;
+        const double now = EngineClock::seconds();
+        const int width = std::max(2, (int)(windowWidth * streamer.frameScale()) & ~1);
+        const int height = std::max(2, (int)(windowHeight * streamer.frameScale()) & ~1);
+        // round-robin from the one after the last served, within the frame's budget
+        due.clear();
+        size_t last = cursor;
+        for (size_t k = 0; k < sessions.size() && (int)due.size() < perFrame; ++k)
+        {
+            const size_t index = (cursor + k) % sessions.size();
+            Session &s = *sessions[index];
+            // a read that never came back (a lost device) doesn't stop the session for good
+            if ((s.encoding.load() && now - s.lastFrame < 1.0) || now - s.lastFrame < interval)
+                continue;
+            if (s.rendered && !s.moved && !sceneChanged && now - s.lastFrame < 1.0)
+                continue;
+            due.push_back(&s);
+            last = index;
+        }
+        if (due.empty())
+            return;
+        cursor = (last + 1) % sessions.size();
+        for (size_t i = 0; i < due.size(); ++i)
+        {
+            View &v = due[i]->view;
+            v.eye = v.camera.Position;
+            v.view = v.camera.GetViewMatrix();
+            v.projection = glm::perspective(glm::radians(v.camera.Zoom), (float)width / (float)height, 0.1f, farPlane);
+        }
+        {
+            FrameTrace::Scope trace("session cull");
+            ThreadPool::shared().parallelFor(due.size(), 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    sceneTree.cull(Frustum(due[i]->view.projection * due[i]->view.view), due[i]->view.visible);
+            }, "session cull");
+        }
+        for (size_t i = 0; i < due.size(); ++i)
+        {
+            Session &s = *due[i];
+            if (!createTargets(s, width, height))
+                continue;
+            glBindFramebuffer(GL_FRAMEBUFFER, s.hdrFbo);
+            glViewport(0, 0, width, height);
+            glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            drawView(s.view);
+            glBindFramebuffer(GL_FRAMEBUFFER, s.outputFbo);
+            toneMapper.present(s.hdrTexture, 0, 0, width, height);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, s.outputFbo);
+            s.encoding = true;
+            s.rendered = true;
+            s.moved = false;
+            s.lastFrame = now;
+            Session *session = &s;
+            FrameStreamer *out = &streamer;
+            s.encoder->capture(width, height, [session, out, now](const unsigned char *pixels, int w, int h) {
+                out->sendFrame(session->view.id, pixels, w, h, now);
+                session->encoding = false;
+            });
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glState().invalidate();
+    }
+
+    // GL thread, once per frame: passes the sessions' finished reads to their encoders
+    void poll()
+    {
+        for (size_t i = 0; i < sessions.size(); ++i)
+            sessions[i]->encoder->poll();
+    }
+
+    // a session is steering or has a frame on its way (an idle loop should keep turning)
+    bool busy() const
+    {
+        for (size_t i = 0; i < sessions.size(); ++i)
+            if (sessions[i]->encoding.load() || sessions[i]->steering)
+                return true;
+        return false;
+    }
+
+    size_t count() const { return sessions.size(); }
+
+    void releaseGpu()
+    {
+        for (size_t i = 0; i < sessions.size(); ++i)
+            close(*sessions[i]);
+        sessions.clear();
+        cursor = 0;
+    }
+
+private:
+    struct Session
+    {
+        View view;
+        std::unique_ptr<FrameCapture> encoder;
+        // its own targets: the HDR scene and the tone-mapped RGBA8 copy that's read
+        GLuint hdrFbo = 0, hdrTexture = 0, depthBuffer = 0;
+        GLuint outputFbo = 0, outputBuffer = 0;
+        int width = 0, height = 0;
+        // a frame is being read or encoded (set on the GL thread, cleared on the encoder's)
+        std::atomic<bool> encoding{false};
+        bool rendered = false; // has had a frame
+        bool moved = false;    // its camera moved since its last frame
+        bool steering = false; // keys held
+        double lastFrame = -1.0e9;
+    };
+
+    FrameStreamer &streamer;
+    int perFrame = 2;
+    double interval = 1.0 / 30.0;
+    std::vector<std::unique_ptr<Session>> sessions;
+    std::vector<FrameStreamer::SessionInput> inputs;
+    std::vector<Session *> due;
+    size_t cursor = 0;
+
+    Session *find(int id)
+    {
+        for (size_t i = 0; i < sessions.size(); ++i)
+            if (sessions[i]->view.id == id)
+                return sessions[i].get();
+        return NULL;
+    }
+
+    // the window's camera controls: WASD and the arrows move, PageUp/PageDown rise and sink, drags turn,
+    // the wheel zooms
+    static void steer(Session &s, const FrameStreamer::RemoteInput &in, float deltaTime)
+    {
+        Camera &camera = s.view.camera;
+        const glm::vec3 position = camera.Position;
+        const float yaw = camera.Yaw, pitch = camera.Pitch, zoom = camera.Zoom;
+        if (in.held(GLFW_KEY_W) || in.held(GLFW_KEY_UP))
+            camera.ProcessKeyboard(FORWARD, deltaTime);
+        if (in.held(GLFW_KEY_S) || in.held(GLFW_KEY_DOWN))
+            camera.ProcessKeyboard(BACKWARD, deltaTime);
+        if (in.held(GLFW_KEY_A) || in.held(GLFW_KEY_LEFT))
+            camera.ProcessKeyboard(LEFT, deltaTime);
+        if (in.held(GLFW_KEY_D) || in.held(GLFW_KEY_RIGHT))
+            camera.ProcessKeyboard(RIGHT, deltaTime);
+        if (in.held(GLFW_KEY_PAGE_UP))
+            camera.Position.y += 3.0f * deltaTime;
+        if (in.held(GLFW_KEY_PAGE_DOWN))
+            camera.Position.y -= 3.0f * deltaTime;
+        if (in.mouseX != 0.0f || in.mouseY != 0.0f)
+            camera.ProcessMouseMovement(in.mouseX, in.mouseY);
+        if (in.wheel != 0.0f)
+            camera.ProcessMouseScroll(in.wheel);
+        s.steering = !in.keys.empty();
+        if (camera.Position != position || camera.Yaw != yaw || camera.Pitch != pitch || camera.Zoom != zoom)
+            s.moved = true;
+    }
+
+    bool createTargets(Session &s, int width, int height)
+    {
+        if (s.hdrFbo && width == s.width && height == s.height)
+            return true;
+        release(s);
+        s.width = width;
+        s.height = height;
+        glGenTextures(1, &s.hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, s.hdrTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &s.depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, s.depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glGenRenderbuffers(1, &s.outputBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, s.outputBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &s.hdrFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, s.hdrFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s.hdrTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, s.depthBuffer);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glGenFramebuffers(1, &s.outputFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, s.outputFbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, s.outputBuffer);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Sessions] RGBA16F view target unsupported, view " << s.view.id << " gets no frames");
+            release(s);
+            return false;
+        }
+        LOG_DEBUG("[Sessions] View " << s.view.id << " targets " << width << "x" << height << ", "
+                  << (size_t)width * height * (8 + 4 + 4) / 1024 << " KB");
+        return true;
+    }
+
+    // its targets (a resize, or leaving)
+    static void release(Session &s)
+    {
+        if (s.hdrFbo) glDeleteFramebuffers(1, &s.hdrFbo);
+        if (s.outputFbo) glDeleteFramebuffers(1, &s.outputFbo);
+        if (s.hdrTexture) glDeleteTextures(1, &s.hdrTexture);
+        if (s.depthBuffer) glDeleteRenderbuffers(1, &s.depthBuffer);
+        if (s.outputBuffer) glDeleteRenderbuffers(1, &s.outputBuffer);
+        s.hdrFbo = s.outputFbo = s.hdrTexture = s.depthBuffer = s.outputBuffer = 0;
+        s.width = s.height = 0;
+    }
+
+    // a session leaving: its reads done and encoded (the streamer drops them), its buffers gone
+    static void close(Session &s)
+    {
+        s.encoder->finish();
+        s.encoder->releaseGpu();
+        release(s);
+    }
+};
+
+#endif
@@ -4,140 +4,933 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <startup_timings.h>
+#include <virtual_file_system.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <fstream>
 #include <sstream>
-#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (not in the generated loader)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 class Shader
 {
 public:
+    // process-wide id for a uniform name. Handles are interned once (usually into a static) and are valid
+    // for every Shader; resolving one to a GL location is an array index into the shader's location table.
+    struct UniformHandle
+    {
+        int id;
+    };
+
+    // compile-time material features of a model_loading variant (see useVariant); each becomes a
+    // `#define NAME 0/1` after the #version line
+    enum Feature
+    {
+        HAS_BASE_COLOR = 1,
+        HAS_NORMAL_MAP = 2,
+        HAS_MR = 4,
+        HAS_UV_TRANSFORM = 8,
+        ALPHA_MASK = 16,
+        CLEARCOAT = 32, // KHR_materials_clearcoat: a second specular lobe over the base
+        TRANSMISSION = 64, // KHR_materials_transmission: sees the opaque scene through (RefractionCopy)
+        SKINNED = 128, // blends its positions from the `Bones` palette (NodeAnimation)
+        FEATURE_BITS = 8
+    };
+
     unsigned int ID;
-    // constructor generates the shader on the fly
+    // constructor generates the shader on the fly; `defines` (e.g. "#define FOO 1\n") is inserted after the
+    // #version line of every stage. An optional geometry stage (e.g. layered cubemap capture) goes between
+    // them. Shaders built from identical sources share one program (and its uniform state); linked
+    // programs are cached on disk as driver binaries (see binaryCachePath).
+    // Compiling is two-phase: the constructor only submits the stages and the link, so shaders created
+    // together compile side by side (on the driver's threads with GL_KHR_parallel_shader_compile) while
+    // models load. The link is checked, and the uniforms reflected, on first use (use(), a uniform
+    // location) or by finishCompiles() once the driver reports it done, whichever comes first.
     // ------------------------------------------------------------------------
-    Shader(const char *vertexPath, const char *fragmentPath)
+    Shader(const char *vertexPath, const char *fragmentPath, const std::string &defines = std::string(), const char *geometryPath = nullptr)
+        : vertexPath(vertexPath), fragmentPath(fragmentPath), geometryPath(geometryPath ? geometryPath : ""), defines(defines)
     {
-        // 1. retrieve the vertex/fragment source code from filePath
+        StartupTimings::Scope startup("shaders");
+        // 1. retrieve the vertex/fragment (and geometry) source code from filePath
         std::string vertexCode;
         std::string fragmentCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        // ensure ifstream objects can throw exceptions:
-        vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        try
-        {
-            // open files
-            vShaderFile.open(vertexPath);
-            fShaderFile.open(fragmentPath);
-            std::stringstream vShaderStream, fShaderStream;
-            // read file's buffer contents into streams
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            // close file handlers
-            vShaderFile.close();
-            fShaderFile.close();
-            // convert stream into string
-            vertexCode = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-        }
-        catch (std::ifstream::failure &e)
-        {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
-        }
-        const char *vShaderCode = vertexCode.c_str();
-        const char *fShaderCode = fragmentCode.c_str();
-        // 2. compile shaders
-        unsigned int vertex, fragment;
-        // vertex shader
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
-        // fragment Shader
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
-        // shader Program
-        ID = glCreateProgram();
-        glAttachShader(ID, vertex);
-        glAttachShader(ID, fragment);
-        glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
-        // delete the shaders as they're linked into our program now and no longer necessary
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        std::string geometryCode;
+        readSources(vertexCode, fragmentCode, geometryCode);
+        // identical sources (same files and defines) share one program
+        const uint64_t key = sourceKey(vertexCode, fragmentCode, geometryCode);
+        std::weak_ptr<ProgramState> &shared = livePrograms()[key];
+        state = shared.lock();
+        if (state)
+        {
+            ID = state->id;
+            state->users.push_back(this);
+            LOG_DEBUG("[Shader] Reusing program " << ID << " for " << fragmentPath);
+            return;
+        }
+        state = std::make_shared<ProgramState>();
+        state->key = key;
+        state->users.push_back(this);
+        shared = state;
+        // 2. a binary cached by an earlier run (same sources and driver) skips compiling and linking
+        if (!loadProgramBinary(binaryCachePath(key), key))
+        {
+            state->compiling = startLink(vertexCode, fragmentCode, geometryCode);
+            state->compiling.key = key;
+            ID = state->compiling.program;
+            state->id = ID;
+            return;
+        }
+        state->id = ID;
+        // 3. reflect all active uniforms once so setters never ask the driver for locations
+        reflectUniforms();
+        bindUniformBlocks();
+        bindSamplerUnits();
+    }
+    ~Shader()
+    {
+        std::vector<Shader *> &users = state->users;
+        users.erase(std::remove(users.begin(), users.end(), this), users.end());
+    }
+    // variants belong to the shared program state, so shaders can't be copied
+    Shader(const Shader &) = delete;
+    Shader &operator=(const Shader &) = delete;
+    // activates the variant of this shader compiled with `features` (Feature bits, compiled on first use)
+    // and replays into it every uniform set on this shader through a UniformHandle since its last use, so
+    // callers keep setting per-frame state on the base shader only. Returns the variant, now in use.
+    // ------------------------------------------------------------------------
+    Shader &useVariant(unsigned int features)
+    {
+        std::unique_ptr<Shader> &v = state->variants[features];
+        if (!v)
+        {
+            v.reset(new Shader(vertexPath.c_str(), fragmentPath.c_str(), defines + featureDefines(features),
+                               geometryPath.empty() ? nullptr : geometryPath.c_str()));
+            LOG_DEBUG("[Shader] Compiled variant 0x" << std::hex << features << std::dec << " of " << fragmentPath);
+        }
+        v->use();
+        v->inherit(*this);
+        return *v;
+    }
+    // submits the variant with `features` for compiling without using it, so it's linked (or close to it)
+    // by the time a material needs it
+    void prepareVariant(unsigned int features)
+    {
+        std::unique_ptr<Shader> &v = state->variants[features];
+        if (!v)
+            v.reset(new Shader(vertexPath.c_str(), fragmentPath.c_str(), defines + featureDefines(features),
+                               geometryPath.empty() ? nullptr : geometryPath.c_str()));
+    }
+    static std::string featureDefines(unsigned int features)
+    {
+        static const char *names[FEATURE_BITS] = {"HAS_BASE_COLOR", "HAS_NORMAL_MAP", "HAS_MR", "HAS_UV_TRANSFORM", "ALPHA_MASK", "CLEARCOAT", "TRANSMISSION", "SKINNED"};
+        std::string out = "#define MATERIAL_VARIANT 1\n";
+        for (int i = 0; i < FEATURE_BITS; ++i)
+            out += std::string("#define ") + names[i] + ((features & (1u << i)) ? " 1\n" : " 0\n");
+        return out;
+    }
+    // fixed binding point of a uniform block by name (-1 = not a renderer-managed block); buffers are
+    // bound to these points with glBindBufferBase, so no per-program setup is needed at draw time
+    // ------------------------------------------------------------------------
+    static GLint uniformBlockBinding(const std::string &name)
+    {
+        if (name == "Materials")
+            return 0;
+        if (name == "Object")
+            return 1;
+        if (name == "FrameData")
+            return 2;
+        if (name == "Bones")
+            return 3;
+        if (name == "Stereo")
+            return 4;
+        if (name == "MaterialOverrides")
+            return 5;
+        return -1;
+    }
+    // fixed texture unit of a sampler uniform by name (-1 = set by its user); the scene shaders' samplers
+    // get their units once at link, their textures are bound to the same units by Mesh (0-2), Model (3-5),
+    // ReflectionProbes (6-9), ClusteredLights (10, 14, 15), main (11, 12, 31), ShadowCascades (13) and
+    // RefractionCopy (20); the post passes' own samplers share units where they never run together
+    // (TemporalAA's currentColor and historyColor with the tone map's bloomColor and exposureMap), and
+    // VirtualTexture's livery (16, 17), Model's paint decals (18) and IrradianceVolume (19, with 30) take four
+    // of theirs in the scene shaders
+    // ------------------------------------------------------------------------
+    static GLint samplerUnit(const std::string &name)
+    {
+        static const struct { const char *name; GLint unit; } units[] = {
+            {"texture_diffuse1", 0}, {"texture_normal1", 1}, {"texture_metallicRoughness1", 2},
+            {"diffuseArray", 3}, {"normalArray", 4}, {"metallicRoughnessArray", 5},
+            {"probeMap0", 6}, {"probeMap1", 7}, {"probeMap2", 8}, {"probeMap3", 9},
+            {"lightData", 10}, {"prefilteredMap", 11}, {"brdfLUT", 12}, {"shadowMap", 13},
+            {"clusterRanges", 14}, {"clusterIndices", 15}, {"hdrColor", 16},
+            {"currentColor", 17}, {"bloomColor", 17}, {"historyColor", 18}, {"exposureMap", 18},
+            {"velocityMap", 19},
+            {"transmissionMap", 20}, {"visibilityIds", 21}, {"visibilityVertices", 22},
+            {"visibilityIndices", 23}, {"visibilityRanges", 24}, {"visibilityMaterials", 25},
+            {"ambientOcclusionMap", 26}, {"reflectionHits", 27},
+            {"reflectionHistory", 28}, {"shadingRateMap", 29}, {"liveryPageTable", 16}, {"liveryCache", 17},
+            {"paintDecals", 18}, {"irradianceVolume0", 19}, {"irradianceVolume1", 30},
+            {"ltcLut", 31}};
+        for (size_t i = 0; i < sizeof(units) / sizeof(units[0]); ++i)
+            if (name == units[i].name)
+                return units[i].unit;
+        return -1;
+    }
+    // hot reload (SHADER_HOT_RELOAD, see HotReload), GL thread. Starts relinking every live program (base
+    // shaders and their variants alike) whose source files changed since the last call; the first call only
+    // records the files' times. The new program links next to the one in use, in the background where the
+    // driver has GL_KHR_parallel_shader_compile, and finishReloads() swaps it in once linked.
+    // ------------------------------------------------------------------------
+    static void reloadChanged()
+    {
+        std::map<uint64_t, std::weak_ptr<ProgramState> > &programs = livePrograms();
+        for (std::map<uint64_t, std::weak_ptr<ProgramState> >::iterator it = programs.begin(); it != programs.end(); ++it)
+        {
+            std::shared_ptr<ProgramState> s = it->second.lock();
+            if (!s || s->users.empty() || s->pending.program || s->compiling.program || it->first != s->key)
+                continue;
+            const Shader &owner = *s->users.front();
+            const uint64_t stamp = owner.sourceStamp();
+            const bool first = s->stamp == 0;
+            if (stamp == s->stamp)
+                continue;
+            s->stamp = stamp;
+            if (!first)
+                owner.startReload();
+        }
+    }
+    // swaps in the programs startReload() linked, once the driver is done with them; a program that fails
+    // to compile or link is dropped and the one in use stays. Returns how many were swapped.
+    // ------------------------------------------------------------------------
+    // completes the first link of every program the driver has finished compiling, without waiting on the
+    // others; call once in a while (every frame) so first uses find them ready. Returns how many completed.
+    // ------------------------------------------------------------------------
+    static int finishCompiles()
+    {
+        std::vector<std::shared_ptr<ProgramState> > compiled;
+        std::map<uint64_t, std::weak_ptr<ProgramState> > &programs = livePrograms();
+        for (std::map<uint64_t, std::weak_ptr<ProgramState> >::iterator it = programs.begin(); it != programs.end(); ++it)
+        {
+            std::shared_ptr<ProgramState> s = it->second.lock();
+            if (s && s->compiling.program && !s->users.empty() && linkCompleted(s->compiling))
+                compiled.push_back(s);
+        }
+        for (size_t i = 0; i < compiled.size(); ++i)
+            compiled[i]->users.front()->completeLink();
+        return (int)compiled.size();
+    }
+    // whether the first link is checked, or done and can be without waiting
+    bool ready() const
+    {
+        return !state->compiling.program || linkCompleted(state->compiling);
+    }
+    static int finishReloads()
+    {
+        std::vector<std::shared_ptr<ProgramState> > linked;
+        std::map<uint64_t, std::weak_ptr<ProgramState> > &programs = livePrograms();
+        for (std::map<uint64_t, std::weak_ptr<ProgramState> >::iterator it = programs.begin(); it != programs.end(); ++it)
+        {
+            std::shared_ptr<ProgramState> s = it->second.lock();
+            if (s && s->pending.program && it->first == s->key && linkCompleted(s->pending))
+                linked.push_back(s);
+        }
+        int swapped = 0;
+        for (size_t i = 0; i < linked.size(); ++i)
+            if (!linked[i]->users.empty() && linked[i]->users.front()->swapReloaded())
+                ++swapped;
+        return swapped;
+    }
+    // interns a uniform name and returns its handle (cheap to call once, store the result)
+    // ------------------------------------------------------------------------
+    static UniformHandle uniformHandle(const std::string &name)
+    {
+        std::map<std::string, int> &ids = handleIds();
+        std::map<std::string, int>::iterator it = ids.find(name);
+        if (it != ids.end())
+        {
+            UniformHandle h = {it->second};
+            return h;
+        }
+        int id = (int)handleNames().size();
+        handleNames().push_back(name);
+        ids[name] = id;
+        UniformHandle h = {id};
+        return h;
+    }
+    // location of a uniform in this program (-1 if not active)
+    // ------------------------------------------------------------------------
+    GLint location(UniformHandle h) const
+    {
+        if (state->compiling.program)
+            completeLink();
+        if (h.id >= (int)state->handleLocations.size())
+            resolveHandles();
+        return state->handleLocations[h.id];
+    }
+    GLint location(const std::string &name) const
+    {
+        if (state->compiling.program)
+            completeLink();
+        std::map<std::string, GLint>::const_iterator it = state->uniformTable.find(name);
+        return it != state->uniformTable.end() ? it->second : -1;
+    }
+    bool hasUniform(UniformHandle h) const
+    {
+        return location(h) != -1;
     }
     // activate the shader
     // ------------------------------------------------------------------------
     void use() const
     {
-        glUseProgram(ID);
+        if (state->compiling.program)
+            completeLink();
+        glState().useProgram(ID);
     }
     // utility uniform functions
     // ------------------------------------------------------------------------
     void setBool(const std::string &name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        glUniform1i(location(name), (int)value);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setInt(const std::string &name, int value) const
     {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1i(location(name), value);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setFloat(const std::string &name, float value) const
     {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1f(location(name), value);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setVec2(const std::string &name, const glm::vec2 &value) const
     {
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        glUniform2fv(location(name), 1, &value[0]);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     void setVec2(const std::string &name, float x, float y) const
     {
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+        glUniform2f(location(name), x, y);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setVec3(const std::string &name, const glm::vec3 &value) const
     {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        glUniform3fv(location(name), 1, &value[0]);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     void setVec3(const std::string &name, float x, float y, float z) const
     {
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+        glUniform3f(location(name), x, y, z);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setVec4(const std::string &name, const glm::vec4 &value) const
     {
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        glUniform4fv(location(name), 1, &value[0]);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     void setVec4(const std::string &name, float x, float y, float z, float w) const
     {
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+        glUniform4f(location(name), x, y, z, w);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setMat2(const std::string &name, const glm::mat2 &mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix2fv(location(name), 1, GL_FALSE, &mat[0][0]);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setMat3(const std::string &name, const glm::mat3 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix3fv(location(name), 1, GL_FALSE, &mat[0][0]);
+        GL_STATS_ADD(uniformUploads, 1);
     }
     // ------------------------------------------------------------------------
     void setMat4(const std::string &name, const glm::mat4 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix4fv(location(name), 1, GL_FALSE, &mat[0][0]);
+        GL_STATS_ADD(uniformUploads, 1);
+    }
+
+    // handle-based setters: no string work, inactive uniforms are skipped
+    // ------------------------------------------------------------------------
+    void setBool(UniformHandle h, bool value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform1i(loc, (int)value); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::INT, (int)value, 0, 0);
+    }
+    void setInt(UniformHandle h, int value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform1i(loc, value); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::INT, value, 0, 0);
+    }
+    void setFloat(UniformHandle h, float value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform1f(loc, value); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::FLOAT, 0, &value, 1);
+    }
+    void setVec2(UniformHandle h, const glm::vec2 &value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform2fv(loc, 1, &value[0]); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::VEC2, 0, &value[0], 2);
+    }
+    void setVec3(UniformHandle h, const glm::vec3 &value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform3fv(loc, 1, &value[0]); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::VEC3, 0, &value[0], 3);
+    }
+    void setVec4(UniformHandle h, const glm::vec4 &value) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniform4fv(loc, 1, &value[0]); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::VEC4, 0, &value[0], 4);
+    }
+    void setVec4(UniformHandle h, float x, float y, float z, float w) const
+    {
+        setVec4(h, glm::vec4(x, y, z, w));
+    }
+    void setMat3(UniformHandle h, const glm::mat3 &mat) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniformMatrix3fv(loc, 1, GL_FALSE, &mat[0][0]); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::MAT3, 0, &mat[0][0], 9);
+    }
+    void setMat4(UniformHandle h, const glm::mat4 &mat) const
+    {
+        GLint loc = location(h);
+        if (loc != -1) { glUniformMatrix4fv(loc, 1, GL_FALSE, &mat[0][0]); GL_STATS_ADD(uniformUploads, 1); }
+        store(h, StoredUniform::MAT4, 0, &mat[0][0], 16);
     }
 
 private:
+    // last value set through each UniformHandle (indexed by handle id), for replay into variants.
+    // `revision` orders the writes; 0 = never set
+    struct StoredUniform
+    {
+        enum Kind { INT, FLOAT, VEC2, VEC3, VEC4, MAT3, MAT4 };
+        Kind kind;
+        int i;
+        float f[16];
+        unsigned long revision;
+    };
+    // a program startReload() is linking: the stages stay attached until linkCompleted() reports it done
+    struct PendingLink
+    {
+        GLuint program = 0;
+        GLuint stages[3] = {0, 0, 0};
+        uint64_t key = 0; // source hash of the new sources
+    };
+    // everything tied to one linked program, shared by every Shader built from the same sources
+    struct ProgramState
+    {
+        GLuint id = 0;
+        uint64_t key = 0;   // source hash it's registered under in livePrograms()
+        uint64_t stamp = 0; // modification times of its source files at the last reloadChanged(), 0 = not yet
+        PendingLink compiling; // the first link, until completeLink() checks it
+        PendingLink pending;   // a hot reload's link, until swapReloaded()
+        // every Shader using the program (their IDs follow a reload); the first one's files and defines rebuild it
+        std::vector<Shader *> users;
+        // name -> location of every active uniform, filled at link time
+        std::map<std::string, GLint> uniformTable;
+        // handle id -> location, grown lazily when new handles are interned after link
+        std::vector<GLint> handleLocations;
+        std::vector<StoredUniform> stored;
+        unsigned long revision = 0;
+        // (variant) revision of the base program already replayed by inherit()
+        unsigned long inheritedRevision = 0;
+        std::map<unsigned int, std::unique_ptr<Shader> > variants;
+    };
+
+    // sources and defines this program was built from (variants are rebuilt from them)
+    std::string vertexPath, fragmentPath, geometryPath, defines;
+    std::shared_ptr<ProgramState> state;
+
+    // programs alive in this process, by source hash
+    static std::map<uint64_t, std::weak_ptr<ProgramState> > &livePrograms()
+    {
+        static std::map<uint64_t, std::weak_ptr<ProgramState> > programs;
+        return programs;
+    }
+
+    void store(UniformHandle h, StoredUniform::Kind kind, int i, const float *f, int count) const
+    {
+        std::vector<StoredUniform> &stored = state->stored;
+        if (h.id >= (int)stored.size())
+        {
+            StoredUniform unset = {StoredUniform::INT, 0, {0}, 0};
+            stored.resize(h.id + 1, unset);
+        }
+        StoredUniform &u = stored[h.id];
+        u.kind = kind;
+        u.i = i;
+        for (int k = 0; k < count; ++k)
+            u.f[k] = f[k];
+        u.revision = ++state->revision;
+    }
+    // applies the base's uniform writes newer than the last inherit(); expects this program to be in use
+    void inherit(const Shader &base)
+    {
+        const ProgramState &from = *base.state;
+        if (state->inheritedRevision == from.revision)
+            return;
+        for (size_t id = 0; id < from.stored.size(); ++id)
+        {
+            const StoredUniform &u = from.stored[id];
+            if (u.revision <= state->inheritedRevision)
+                continue;
+            UniformHandle h = {(int)id};
+            upload(location(h), u);
+        }
+        state->inheritedRevision = from.revision;
+    }
+    // sets `u` at `loc` in the program in use (-1 = inactive, skipped)
+    static void upload(GLint loc, const StoredUniform &u)
+    {
+        if (loc == -1)
+            return;
+        switch (u.kind)
+        {
+        case StoredUniform::INT: glUniform1i(loc, u.i); break;
+        case StoredUniform::FLOAT: glUniform1f(loc, u.f[0]); break;
+        case StoredUniform::VEC2: glUniform2fv(loc, 1, u.f); break;
+        case StoredUniform::VEC3: glUniform3fv(loc, 1, u.f); break;
+        case StoredUniform::VEC4: glUniform4fv(loc, 1, u.f); break;
+        case StoredUniform::MAT3: glUniformMatrix3fv(loc, 1, GL_FALSE, u.f); break;
+        case StoredUniform::MAT4: glUniformMatrix4fv(loc, 1, GL_FALSE, u.f); break;
+        }
+        GL_STATS_ADD(uniformUploads, 1);
+    }
+    // reads the stages through the VirtualFileSystem with the defines injected; false (and a log) if one
+    // can't be read
+    bool readSources(std::string &vertexCode, std::string &fragmentCode, std::string &geometryCode) const
+    {
+        if (!readSource(vertexPath, vertexCode) || !readSource(fragmentPath, fragmentCode))
+            return false;
+        if (!geometryPath.empty() && !readSource(geometryPath, geometryCode))
+            return false;
+        vertexCode = injectDefines(vertexCode, defines);
+        fragmentCode = injectDefines(fragmentCode, defines);
+        if (!geometryPath.empty())
+            geometryCode = injectDefines(geometryCode, defines);
+        return true;
+    }
+    static bool readSource(const std::string &path, std::string &code)
+    {
+        FileView file;
+        if (!fileSystem().open(path, file))
+        {
+            LOG_ERROR("ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << path);
+            return false;
+        }
+        code.assign((const char *)file.data(), file.size());
+        return true;
+    }
+    static uint64_t sourceKey(const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode)
+    {
+        std::string sources = vertexCode + '\0' + fragmentCode;
+        if (!geometryCode.empty())
+            sources += '\0' + geometryCode;
+        return hashString(sources, 1469598103934665603ull);
+    }
+    static std::string injectDefines(const std::string &code, const std::string &defines)
+    {
+        if (defines.empty())
+            return code;
+        if (code.compare(0, 8, "#version") != 0)
+            return defines + "#line 1\n" + code;
+        // #version must stay the first line; #line keeps compile errors pointing at the source file's lines
+        size_t lineEnd = code.find('\n');
+        if (lineEnd == std::string::npos)
+            return code + "\n" + defines;
+        return code.substr(0, lineEnd + 1) + defines + "#line 2\n" + code.substr(lineEnd + 1);
+    }
+
+    static std::map<std::string, int> &handleIds()
+    {
+        static std::map<std::string, int> ids;
+        return ids;
+    }
+    static std::vector<std::string> &handleNames()
+    {
+        static std::vector<std::string> names;
+        return names;
+    }
+
+    // query every active uniform of the linked program into uniformTable
+    // ------------------------------------------------------------------------
+    void reflectUniforms() const
+    {
+        std::map<std::string, GLint> &uniformTable = state->uniformTable;
+        uniformTable.clear();
+        state->handleLocations.clear();
+        GLint count = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        GLint maxLen = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLen);
+        std::vector<GLchar> nameBuf(maxLen > 0 ? maxLen : 1);
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei len = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, (GLuint)i, (GLsizei)nameBuf.size(), &len, &size, &type, nameBuf.data());
+            std::string name(nameBuf.data(), len);
+            GLint loc = glGetUniformLocation(ID, name.c_str());
+            if (loc == -1)
+                continue; // uniform block members have no location
+            uniformTable[name] = loc;
+            // arrays are reported as "name[0]"; also register the bare name and every element, so
+            // handles such as "lights[2]" resolve too
+            size_t bracket = name.find('[');
+            if (bracket != std::string::npos)
+            {
+                const std::string base = name.substr(0, bracket);
+                uniformTable[base] = loc;
+                for (GLint e = 1; e < size; ++e)
+                {
+                    const std::string element = base + "[" + std::to_string(e) + "]";
+                    GLint elementLoc = glGetUniformLocation(ID, element.c_str());
+                    if (elementLoc != -1)
+                        uniformTable[element] = elementLoc;
+                }
+            }
+        }
+    }
+    void bindUniformBlocks() const
+    {
+        GLint count = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLchar name[256];
+            GLsizei len = 0;
+            glGetActiveUniformBlockName(ID, (GLuint)i, (GLsizei)sizeof(name), &len, name);
+            GLint binding = uniformBlockBinding(std::string(name, len));
+            if (binding >= 0)
+                glUniformBlockBinding(ID, (GLuint)i, (GLuint)binding);
+        }
+    }
+    // leaves the program in use
+    void bindSamplerUnits() const
+    {
+        bool used = false;
+        for (std::map<std::string, GLint>::const_iterator it = state->uniformTable.begin(); it != state->uniformTable.end(); ++it)
+        {
+            const GLint unit = samplerUnit(it->first);
+            if (unit < 0)
+                continue;
+            if (!used)
+                use();
+            used = true;
+            glUniform1i(it->second, unit);
+        }
+    }
+    void resolveHandles() const
+    {
+        const std::vector<std::string> &names = handleNames();
+        for (size_t i = state->handleLocations.size(); i < names.size(); ++i)
+            state->handleLocations.push_back(location(names[i]));
+    }
+
+    // second phase of the constructor: checks the first link (waiting for it if the driver is still at
+    // it), caches the binary and reflects the uniforms
+    void completeLink() const
+    {
+        StartupTimings::Scope startup("shaders");
+        PendingLink link = state->compiling;
+        state->compiling = PendingLink();
+        if (finishLink(link))
+            saveProgramBinary(binaryCachePath(link.key), link.key);
+        reflectUniforms();
+        bindUniformBlocks();
+        bindSamplerUnits();
+    }
+
+    // compiles the stages and links them into a new program without asking for the result; with parallel
+    // shader compile the driver does both on its own threads and the call returns right away
+    static PendingLink startLink(const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode)
+    {
+        static const GLenum types[3] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER};
+        const std::string *code[3] = {&vertexCode, &fragmentCode, &geometryCode};
+        PendingLink link;
+        // shader Program
+        link.program = glCreateProgram();
+        if (programBinarySupported())
+            glProgramParameteri(link.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        // vertex, fragment and (optional) geometry shader
+        for (int i = 0; i < 3; ++i)
+        {
+            if (code[i]->empty())
+                continue;
+            const char *source = code[i]->c_str();
+            link.stages[i] = glCreateShader(types[i]);
+            glShaderSource(link.stages[i], 1, &source, NULL);
+            glCompileShader(link.stages[i]);
+            glAttachShader(link.program, link.stages[i]);
+        }
+        glLinkProgram(link.program);
+        return link;
+    }
+    // whether the driver is done linking `link` (asking for the link status before that would block)
+    static bool linkCompleted(const PendingLink &link)
+    {
+        if (!parallelCompileSupported())
+            return true;
+        GLint done = GL_FALSE;
+        glGetProgramiv(link.program, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
+    // logs the errors of every stage and of the link, then deletes the stages (the program keeps its code)
+    static bool finishLink(PendingLink &link)
+    {
+        static const char *names[3] = {"VERTEX", "FRAGMENT", "GEOMETRY"};
+        bool ok = true;
+        for (int i = 0; i < 3; ++i)
+            if (link.stages[i])
+                ok = checkCompileErrors(link.stages[i], names[i]) && ok;
+        ok = checkCompileErrors(link.program, "PROGRAM") && ok;
+        // delete the shaders as they're linked into our program now and no longer necessary
+        for (int i = 0; i < 3; ++i)
+            if (link.stages[i])
+                glDeleteShader(link.stages[i]);
+        return ok;
+    }
+    static bool parallelCompileSupported()
+    {
+        static const bool supported = []() {
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count; ++i)
+            {
+                const char *ext = (const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+                if (ext && (std::strcmp(ext, "GL_KHR_parallel_shader_compile") == 0 || std::strcmp(ext, "GL_ARB_parallel_shader_compile") == 0))
+                    return true;
+            }
+            return false;
+        }();
+        return supported;
+    }
+
+    // modification times of the source files, hashed; a file that can't be read counts as time 0
+    uint64_t sourceStamp() const
+    {
+        const std::string *paths[3] = {&vertexPath, &fragmentPath, &geometryPath};
+        uint64_t h = 1469598103934665603ull;
+        for (int i = 0; i < 3; ++i)
+        {
+            struct stat info;
+            const long long mtime = !paths[i]->empty() && stat(paths[i]->c_str(), &info) == 0 ? (long long)info.st_mtime : 0;
+            h = hashString(std::to_string(mtime), h);
+        }
+        return h ? h : 1;
+    }
+    // rereads the sources and starts linking them next to the program in use; sources that read the same
+    // (a file saved unchanged) are left alone
+    void startReload() const
+    {
+        std::string vertexCode, fragmentCode, geometryCode;
+        if (!readSources(vertexCode, fragmentCode, geometryCode))
+            return;
+        const uint64_t key = sourceKey(vertexCode, fragmentCode, geometryCode);
+        if (key == state->key)
+            return;
+        state->pending = startLink(vertexCode, fragmentCode, geometryCode);
+        state->pending.key = key;
+        LOG_INFO("[Shader] " << fragmentPath << (defines.empty() ? "" : " (variant)") << " changed, relinking"
+                 << (parallelCompileSupported() ? " in the background" : ""));
+    }
+    // replaces the program in use by the linked pending one: every user's ID, uniforms reflected anew and
+    // the values set through handles replayed (uniforms set by name come back when their owner sets them
+    // again); variants replay the base's from scratch on their next use
+    bool swapReloaded()
+    {
+        PendingLink link = state->pending;
+        state->pending = PendingLink();
+        if (!finishLink(link))
+        {
+            glDeleteProgram(link.program);
+            LOG_WARN("[Shader] Reload of " << fragmentPath << " failed, keeping program " << ID);
+            return false;
+        }
+        const GLuint old = state->id;
+        state->id = link.program;
+        for (size_t i = 0; i < state->users.size(); ++i)
+            state->users[i]->ID = link.program;
+        // the old name may come back from glCreateProgram: the cached binding must not match it
+        glState().invalidate();
+        glDeleteProgram(old);
+        std::map<uint64_t, std::weak_ptr<ProgramState> > &programs = livePrograms();
+        programs.erase(state->key);
+        state->key = link.key;
+        programs[link.key] = state;
+        saveProgramBinary(binaryCachePath(link.key), link.key);
+        reflectUniforms();
+        bindUniformBlocks();
+        use();
+        bindSamplerUnits();
+        for (size_t id = 0; id < state->stored.size(); ++id)
+        {
+            const StoredUniform &u = state->stored[id];
+            if (u.revision == 0)
+                continue;
+            UniformHandle h = {(int)id};
+            upload(location(h), u);
+        }
+        state->inheritedRevision = 0;
+        LOG_INFO("[Shader] Reloaded " << fragmentPath << (defines.empty() ? "" : " (variant)") << " as program " << ID);
+        return true;
+    }
+
+    // program binaries: GL 4.1 core (ARB_get_program_binary) with at least one binary format
+    // ------------------------------------------------------------------------
+    struct BinaryHeader
+    {
+        char magic[4];          // "SPRG"
+        uint32_t format;        // glGetProgramBinary format
+        uint64_t sourceHash;    // hash of both (define-injected) stages
+        uint64_t driverHash;    // hash of GL_VENDOR / GL_RENDERER / GL_VERSION
+        uint32_t length;
+        uint32_t reserved;
+    };
+    static bool programBinarySupported()
+    {
+        static const bool supported = []() {
+            if (!GLAD_GL_VERSION_4_1)
+                return false;
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            return formats > 0;
+        }();
+        return supported;
+    }
+    static uint64_t hashString(const std::string &s, uint64_t h)
+    {
+        // FNV-1a
+        for (size_t i = 0; i < s.size(); ++i)
+            h = (h ^ (unsigned char)s[i]) * 1099511628211ull;
+        return h;
+    }
+    static uint64_t driverHash()
+    {
+        uint64_t h = 1469598103934665603ull;
+        const GLenum names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+        for (int i = 0; i < 3; ++i)
+        {
+            const GLubyte *str = glGetString(names[i]);
+            h = hashString(str ? std::string((const char *)str) : std::string(), h);
+        }
+        return h;
+    }
+    // cache file of a source hash; SHADER_CACHE=<dir> overrides the directory (default: a cache/ folder
+    // next to the fragment shader), SHADER_CACHE=0 disables the cache. Empty = no caching.
+    std::string binaryCachePath(uint64_t key) const
+    {
+        if (!programBinarySupported())
+            return std::string();
+        std::string dir;
+        if (const char *env = std::getenv("SHADER_CACHE"))
+        {
+            if (std::string(env) == "0")
+                return std::string();
+            dir = env;
+        }
+        else
+        {
+            size_t slash = fragmentPath.find_last_of("/\\");
+            dir = (slash == std::string::npos ? std::string(".") : fragmentPath.substr(0, slash)) + "/cache";
+        }
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+        return dir + "/" + name;
+    }
+    bool loadProgramBinary(const std::string &file, uint64_t key)
+    {
+        if (file.empty())
+            return false;
+        std::ifstream in(file.c_str(), std::ios::binary);
+        BinaryHeader header;
+        if (!in || !in.read((char *)&header, sizeof(header)) || std::string(header.magic, 4) != "SPRG" || header.sourceHash != key)
+            return false;
+        if (header.driverHash != driverHash())
+        {
+            LOG_INFO("[Shader] Driver changed since " << file << " was cached, recompiling " << fragmentPath);
+            return false;
+        }
+        std::vector<char> data(header.length);
+        if (data.empty() || !in.read(&data[0], (std::streamsize)data.size()))
+            return false;
+        ID = glCreateProgram();
+        glProgramBinary(ID, (GLenum)header.format, &data[0], (GLsizei)data.size());
+        GLint linked = 0;
+        glGetProgramiv(ID, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            // the driver may reject its own binaries (e.g. after an update that kept the version string)
+            LOG_WARN("[Shader] Cached binary " << file << " rejected, recompiling " << fragmentPath);
+            glDeleteProgram(ID);
+            ID = 0;
+            return false;
+        }
+        LOG_INFO("[Shader] Loaded " << fragmentPath << " from program binary cache");
+        return true;
+    }
+    void saveProgramBinary(const std::string &file, uint64_t key) const
+    {
+        if (file.empty())
+            return;
+        GLint linked = 0, length = 0;
+        glGetProgramiv(ID, GL_LINK_STATUS, &linked);
+        glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (!linked || length <= 0)
+            return;
+        std::vector<char> data((size_t)length);
+        GLenum format = 0;
+        glGetProgramBinary(ID, length, &length, &format, &data[0]);
+        BinaryHeader header = {{'S', 'P', 'R', 'G'}, (uint32_t)format, key, driverHash(), (uint32_t)length, 0};
+        std::ofstream out(file.c_str(), std::ios::binary);
+        out.write((const char *)&header, sizeof(header));
+        out.write(&data[0], length);
+        if (!out)
+            LOG_WARN("[Shader] Could not write program binary cache " << file);
+    }
+
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
-    void checkCompileErrors(GLuint shader, std::string type)
+    static bool checkCompileErrors(GLuint shader, std::string type)
     {
         GLint success;
         GLchar infoLog[1024];
@@ -147,8 +940,8 @@ private:
             if (!success)
             {
                 glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n"
-                          << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+                LOG_ERROR("ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n"
+                          << infoLog << "\n -- --------------------------------------------------- -- ");
             }
         }
         else
@@ -157,10 +950,11 @@ private:
             if (!success)
             {
                 glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-                std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n"
-                          << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+                LOG_ERROR("ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n"
+                          << infoLog << "\n -- --------------------------------------------------- -- ");
             }
         }
+        return success != 0;
     }
 };
 #endif
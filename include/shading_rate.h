@@ -0,0 +1,232 @@
+#ifndef SHADING_RATE_H
+#define SHADING_RATE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// VRS=1: variable-rate shading of the opaque forward pass. A rate image with one texel per TILE x TILE
+// pixels picks, per tile, full rate, half rate (a checkerboard of 2x2 quads) or quarter rate (one quad of
+// every 2x2 quads). The scene shader looks its tile up after the alpha test; in a skipped quad it writes
+// depth, motion and pick ID and returns before any lighting, so whole quads skip the Cook-Torrance, shadow,
+// cluster and IBL work. reconstruct() then fills the skipped quads from the shaded ones two pixels away,
+// along whichever direction (horizontal, vertical, diagonal) has the closer pair of colours, so edges
+// aren't smeared across. classify() builds the next frame's rate image from this frame's resolved image:
+// tiles outside a central fovea (VRS_FOVEA, the full-rate radius as a fraction of the half diagonal,
+// default 0.45) and tiles with little log-luminance variance drop rate, highlights and edges (the car
+// paint's reflections) stay at full rate. With TAA the pattern's phase turns every frame, so the history
+// sees every pixel shaded. Blended surfaces, probe captures and the visibility buffer's resolve always
+// shade at full rate.
+class ShadingRate
+{
+public:
+    // pixels per rate image texel; must match shading_rate.fs, shading_reconstruct.fs and model_loading.fs
+    static const int TILE = 16;
+    // texture units (Shader::samplerUnit): the rate image in the scene shaders and the reconstruction's inputs
+    static const unsigned int UNIT = 29;
+    static const unsigned int UNIT_COPY = 30;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle), shading_rate.fs and shading_reconstruct.fs
+    explicit ShadingRate(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("VRS_FOVEA"))
+            fovea = std::max(0.0f, (float)std::atof(env));
+    }
+
+    ShadingRate(const ShadingRate &) = delete;
+    ShadingRate &operator=(const ShadingRate &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("VRS");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the two passes
+    void init()
+    {
+        classifyShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/shading_rate.fs").c_str()));
+        reconstructShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/shading_reconstruct.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[VRS] Variable-rate shading in " << TILE << "x" << TILE << " tiles, full-rate fovea " << fovea);
+    }
+
+    bool ready() const { return usable && classifyShader && reconstructShader; }
+
+    // per frame, before the opaque pass: whether this frame shades coarsely (there is a rate image for a
+    // `width` x `height` scene) and, with `temporal` (TAA on), the next phase of the pattern
+    bool begin(int width, int height, bool temporal)
+    {
+        active = ready() && classified && width == sceneWidth && height == sceneHeight;
+        if (active && temporal)
+            phase = (phase + 1) & 3;
+        else if (!temporal)
+            phase = 0;
+        return active;
+    }
+
+    // no coarse shading this frame (STILL accumulating: the mean needs every pixel shaded)
+    void skip() { active = false; }
+
+    bool shadingCoarsely() const { return active; }
+
+    // points `shader` (the scene shader, already in use) at the rate image, or tells it to shade every pixel
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uCoarseShading = Shader::uniformHandle("coarseShading");
+        static const Shader::UniformHandle uShadingPhase = Shader::uniformHandle("shadingPhase");
+        shader.setBool(uCoarseShading, active);
+        if (!active)
+            return;
+        shader.setInt(uShadingPhase, phase);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, rateTexture);
+    }
+
+    // GL thread, after the opaque pass with the scene framebuffer bound (its colour only being written):
+    // fills the quads apply() let skip. The scene framebuffer is bound again afterwards.
+    void reconstruct()
+    {
+        const GLuint scene = glState().sceneFramebuffer();
+        if (!active || !scene)
+            return;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, scene);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, copyFbo);
+        glBlitFramebuffer(0, 0, sceneWidth, sceneHeight, 0, 0, sceneWidth, sceneHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, scene);
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        reconstructShader->use();
+        reconstructShader->setInt("sceneCopy", (int)UNIT_COPY);
+        reconstructShader->setInt("shadingRateMap", (int)UNIT);
+        reconstructShader->setInt("shadingPhase", phase);
+        glState().bindTexture(UNIT_COPY, GL_TEXTURE_2D, copyTexture);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D, rateTexture);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glDepthMask(GL_TRUE);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    // GL thread, before the tone map: next frame's rate image from `resolved` (this frame's linear image of
+    // the `width` x `height` scene). The scene framebuffer and its viewport are bound again afterwards.
+    void classify(GLuint resolved, int width, int height)
+    {
+        classified = false;
+        if (!ready() || !resolved || width <= 0 || height <= 0)
+            return;
+        createTargets(width, height);
+        if (!usable)
+            return;
+        glBindFramebuffer(GL_FRAMEBUFFER, rateFbo);
+        glViewport(0, 0, rateWidth, rateHeight);
+        glDisable(GL_DEPTH_TEST);
+        classifyShader->use();
+        classifyShader->setInt("sceneColor", (int)UNIT_COPY);
+        classifyShader->setFloat("fovea", fovea);
+        glState().bindTexture(UNIT_COPY, GL_TEXTURE_2D, resolved);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glEnable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glViewport(0, 0, width, height);
+        classified = true;
+    }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        classifyShader.reset();
+        reconstructShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        active = classified = false;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    float fovea = 0.45f;
+    bool usable = false;
+    // classify() left a rate image for the next frame / this frame shades coarsely
+    bool classified = false;
+    bool active = false;
+    int phase = 0;
+    std::unique_ptr<Shader> classifyShader;
+    std::unique_ptr<Shader> reconstructShader;
+    // the passes draw a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    // R8 rate image (0 full, 0.5 half, 1 quarter rate) and the full-size RGBA16F copy reconstruct() reads
+    GLuint rateFbo = 0, rateTexture = 0;
+    GLuint copyFbo = 0, copyTexture = 0;
+    int sceneWidth = 0, sceneHeight = 0;
+    int rateWidth = 0, rateHeight = 0;
+
+    void createTargets(int width, int height)
+    {
+        if (rateFbo && width == sceneWidth && height == sceneHeight)
+            return;
+        releaseTargets();
+        sceneWidth = width;
+        sceneHeight = height;
+        rateWidth = (width + TILE - 1) / TILE;
+        rateHeight = (height + TILE - 1) / TILE;
+        glGenTextures(1, &rateTexture);
+        glBindTexture(GL_TEXTURE_2D, rateTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, rateWidth, rateHeight, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glGenTextures(1, &copyTexture);
+        glBindTexture(GL_TEXTURE_2D, copyTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &rateFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, rateFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rateTexture, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glGenFramebuffers(1, &copyFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, copyFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, copyTexture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        if (!complete)
+        {
+            LOG_WARN("[VRS] R8 rate image or RGBA16F copy unsupported, shading every pixel");
+            usable = false;
+        }
+        else
+            LOG_DEBUG("[VRS] Rate image " << rateWidth << "x" << rateHeight << " for " << width << "x" << height);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTargets()
+    {
+        if (rateFbo) glDeleteFramebuffers(1, &rateFbo);
+        if (copyFbo) glDeleteFramebuffers(1, &copyFbo);
+        if (rateTexture) glDeleteTextures(1, &rateTexture);
+        if (copyTexture) glDeleteTextures(1, &copyTexture);
+        rateFbo = copyFbo = rateTexture = copyTexture = 0;
+        sceneWidth = sceneHeight = rateWidth = rateHeight = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,318 @@
+#ifndef SHADOW_CASCADES_H
+#define SHADOW_CASCADES_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Cascaded shadow maps for the sun. The view frustum, cut where the scene ends, is split into CASCADES
+// depth ranges; each gets an orthographic light projection fitted tightly to the placed-model boxes it
+// sees (the box of every model clipped to the slice, in light space) and rendered into one layer of a
+// depth array texture with the position-only depth pass. model_loading.fs picks the cascade by view
+// depth and filters it with hardware PCF.
+//
+// The fitted bounds are snapped outwards to a grid of 1/64 of the scene's light-space extent, so small
+// camera moves leave them unchanged, and each cascade remembers what it was drawn from: light direction,
+// bounds and the boxes of the models inside. update() only re-renders a cascade when one of those changed,
+// so for a static showroom, once a slice covers the whole scene, its cascade is drawn once and reused.
+class ShadowCascades
+{
+public:
+    static const int CASCADES = 3;             // mirrored by MAX_CASCADES in model_loading.fs
+    static const unsigned int UNIT = 13;       // 2D array target; the occlusion culler's 2D texture shares it
+    static const int GRID_STEPS = 64;          // snapping grid across the scene's light-space extent
+
+    // draws the shadow casters for one cascade (depth only, program not yet bound)
+    typedef std::function<void(const glm::mat4 &projection, const glm::mat4 &view)> DrawCasters;
+
+    explicit ShadowCascades(int size = 2048)
+        : size(size)
+    {
+    }
+
+    ShadowCascades(const ShadowCascades &) = delete;
+    ShadowCascades &operator=(const ShadowCascades &) = delete;
+
+    // SHADOWS=0 turns them off
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("SHADOWS");
+        return !(env && std::string(env) == "0");
+    }
+
+    // GL thread, before the main pass. `sunDirection` points towards the sun; `view`, `fovY` (radians),
+    // `aspect` and the planes describe the camera; `casters` are the world boxes of the placed models.
+    // Re-renders the cascades whose inputs changed and leaves the default framebuffer bound; the caller
+    // restores its viewport. Returns how many cascades were drawn.
+    int update(const glm::vec3 &sunDirection, const glm::mat4 &view, float fovY, float aspect, float nearPlane, float farPlane,
+               const std::vector<std::pair<glm::vec3, glm::vec3> > &casters, const DrawCasters &drawCasters)
+    {
+        active = 0;
+        if (casters.empty() || sunDirection.y <= 0.0f)
+            return 0;
+        createResources();
+        if (!framebuffer)
+            return 0;
+
+        const glm::vec3 toSun = glm::normalize(sunDirection);
+        const glm::vec3 up = std::abs(toSun.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), -toSun, up);
+
+        // light-space boxes of the casters and of the whole scene
+        lightBoxes.clear();
+        glm::vec3 sceneMin(1e30f), sceneMax(-1e30f);
+        for (size_t i = 0; i < casters.size(); ++i)
+        {
+            std::pair<glm::vec3, glm::vec3> box = transformBox(lightView, casters[i].first, casters[i].second);
+            lightBoxes.push_back(box);
+            sceneMin = glm::min(sceneMin, box.first);
+            sceneMax = glm::max(sceneMax, box.second);
+        }
+        const glm::vec2 grid = glm::max(glm::vec2(sceneMax - sceneMin) / (float)GRID_STEPS, glm::vec2(1e-3f));
+
+        // the view frustum ends at the far side of the scene
+        const glm::mat4 inverseView = glm::inverse(view);
+        float sceneFar = nearPlane;
+        for (size_t i = 0; i < casters.size(); ++i)
+            for (int k = 0; k < 8; ++k)
+            {
+                const glm::vec3 corner(k & 1 ? casters[i].second.x : casters[i].first.x, k & 2 ? casters[i].second.y : casters[i].first.y,
+                                       k & 4 ? casters[i].second.z : casters[i].first.z);
+                sceneFar = std::max(sceneFar, -(view * glm::vec4(corner, 1.0f)).z);
+            }
+        const float shadowFar = std::min(farPlane, sceneFar);
+        if (shadowFar <= nearPlane)
+            return 0;
+
+        // practical split scheme: mostly logarithmic, blended with uniform splits
+        const float tanY = std::tan(fovY * 0.5f), tanX = tanY * aspect;
+        int drawn = 0;
+        float sliceNear = nearPlane;
+        for (int c = 0; c < CASCADES; ++c)
+        {
+            const float t = (float)(c + 1) / CASCADES;
+            const float sliceFar = c == CASCADES - 1 ? shadowFar
+                                                     : glm::mix(nearPlane + (shadowFar - nearPlane) * t, nearPlane * std::pow(shadowFar / nearPlane, t), 0.75f);
+            splits[c] = sliceFar;
+            // light-space box of the slice
+            glm::vec3 sliceMin(1e30f), sliceMax(-1e30f);
+            for (int k = 0; k < 8; ++k)
+            {
+                const float d = k & 4 ? sliceFar : sliceNear;
+                const glm::vec4 corner = inverseView * glm::vec4((k & 1 ? tanX : -tanX) * d, (k & 2 ? tanY : -tanY) * d, -d, 1.0f);
+                const glm::vec3 p = glm::vec3(lightView * corner);
+                sliceMin = glm::min(sliceMin, p);
+                sliceMax = glm::max(sliceMax, p);
+            }
+            sliceNear = sliceFar;
+            // tight fit: the union of the caster boxes clipped to the slice (in x and y; every caster
+            // between the slice and the sun must stay inside the depth range)
+            glm::vec2 fitMin(1e30f), fitMax(-1e30f);
+            for (size_t i = 0; i < lightBoxes.size(); ++i)
+            {
+                const glm::vec2 lo = glm::max(glm::vec2(lightBoxes[i].first), glm::vec2(sliceMin));
+                const glm::vec2 hi = glm::min(glm::vec2(lightBoxes[i].second), glm::vec2(sliceMax));
+                if (lo.x > hi.x || lo.y > hi.y || lightBoxes[i].second.z < sliceMin.z)
+                    continue;
+                fitMin = glm::min(fitMin, lo);
+                fitMax = glm::max(fitMax, hi);
+            }
+            Cascade &cascade = cascades[c];
+            if (fitMin.x > fitMax.x)
+            {
+                // nothing to shadow in this slice
+                cascade.empty = true;
+                cascade.signature.clear();
+                continue;
+            }
+            cascade.empty = false;
+            fitMin = glm::floor((fitMin - glm::vec2(sceneMin)) / grid) * grid + glm::vec2(sceneMin);
+            fitMax = glm::ceil((fitMax - glm::vec2(sceneMin)) / grid) * grid + glm::vec2(sceneMin);
+            fitMax = glm::max(fitMax, fitMin + grid);
+            const float margin = 0.01f * (sceneMax.z - sceneMin.z) + 0.01f;
+            const glm::mat4 projection = glm::ortho(fitMin.x, fitMax.x, fitMin.y, fitMax.y, -(sceneMax.z + margin), -(sceneMin.z - margin));
+            cascade.worldToShadow = biasMatrix() * projection * lightView;
+            // world size of one shadow texel, for the normal offset in the shader
+            cascade.texelSize = std::max(fitMax.x - fitMin.x, fitMax.y - fitMin.y) / size;
+
+            // what the cascade is drawn from; unchanged = the cached layer is still right
+            signature.clear();
+            push(toSun);
+            signature.push_back(fitMin.x);
+            signature.push_back(fitMin.y);
+            signature.push_back(fitMax.x);
+            signature.push_back(fitMax.y);
+            signature.push_back(sceneMin.z);
+            signature.push_back(sceneMax.z);
+            for (size_t i = 0; i < lightBoxes.size(); ++i)
+                if (lightBoxes[i].first.x <= fitMax.x && lightBoxes[i].second.x >= fitMin.x &&
+                    lightBoxes[i].first.y <= fitMax.y && lightBoxes[i].second.y >= fitMin.y)
+                {
+                    push(casters[i].first);
+                    push(casters[i].second);
+                }
+            if (signature == cascade.signature)
+                continue;
+            cascade.signature = signature;
+            renderCascade(c, projection, lightView, drawCasters);
+            ++drawn;
+        }
+        active = CASCADES;
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        return drawn;
+    }
+
+    // sets the shadow uniforms of `shader` (in use) and binds the depth array. shadowMap has its unit from
+    // link (Shader::samplerUnit), so it never aliases a 2D texture unit even without shadows.
+    void apply(const Shader &shader) const
+    {
+        static const Shader::UniformHandle uCount = Shader::uniformHandle("shadowCascadeCount");
+        static const Shader::UniformHandle uSplits = Shader::uniformHandle("shadowSplits");
+        static const Shader::UniformHandle uTexels = Shader::uniformHandle("shadowTexelSizes");
+        static Shader::UniformHandle uMatrices[CASCADES];
+        static bool interned = false;
+        if (!interned)
+        {
+            for (int c = 0; c < CASCADES; ++c)
+                uMatrices[c] = Shader::uniformHandle("shadowMatrices[" + std::to_string(c) + "]");
+            interned = true;
+        }
+        shader.setInt(uCount, active);
+        if (!active)
+            return;
+        glm::vec4 splitDepths(0.0f), texels(0.0f);
+        for (int c = 0; c < CASCADES; ++c)
+        {
+            splitDepths[c] = splits[c];
+            // 0 = nothing to shadow in the slice (its layer isn't drawn), the shader reads it as lit
+            texels[c] = cascades[c].empty ? 0.0f : cascades[c].texelSize;
+            shader.setMat4(uMatrices[c], cascades[c].worldToShadow);
+        }
+        shader.setVec4(uSplits, splitDepths);
+        shader.setVec4(uTexels, texels);
+        glState().bindTexture(UNIT, GL_TEXTURE_2D_ARRAY, depthArray);
+    }
+
+    // drops the cached layers (e.g. after a context-wide state change); the next update() redraws them
+    void invalidate()
+    {
+        for (int c = 0; c < CASCADES; ++c)
+            cascades[c].signature.clear();
+    }
+
+    void releaseGpu()
+    {
+        if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+        if (depthArray) glDeleteTextures(1, &depthArray);
+        framebuffer = depthArray = 0;
+        active = 0;
+        invalidate();
+        glState().invalidate();
+    }
+
+private:
+    struct Cascade
+    {
+        glm::mat4 worldToShadow = glm::mat4(1.0f);
+        float texelSize = 0.0f;
+        bool empty = true;
+        std::vector<float> signature;
+    };
+
+    int size;
+    int active = 0;
+    GLuint framebuffer = 0;
+    GLuint depthArray = 0;
+    bool created = false;
+    Cascade cascades[CASCADES];
+    float splits[CASCADES] = {};
+    std::vector<std::pair<glm::vec3, glm::vec3> > lightBoxes;
+    std::vector<float> signature;
+
+    void push(const glm::vec3 &v)
+    {
+        signature.push_back(v.x);
+        signature.push_back(v.y);
+        signature.push_back(v.z);
+    }
+
+    // clip space [-1, 1] to shadow texture space [0, 1]
+    static glm::mat4 biasMatrix()
+    {
+        return glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.5f)), glm::vec3(0.5f));
+    }
+
+    static std::pair<glm::vec3, glm::vec3> transformBox(const glm::mat4 &m, const glm::vec3 &bmin, const glm::vec3 &bmax)
+    {
+        glm::vec3 lo(1e30f), hi(-1e30f);
+        for (int k = 0; k < 8; ++k)
+        {
+            const glm::vec3 p = glm::vec3(m * glm::vec4(k & 1 ? bmax.x : bmin.x, k & 2 ? bmax.y : bmin.y, k & 4 ? bmax.z : bmin.z, 1.0f));
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+        return std::make_pair(lo, hi);
+    }
+
+    void renderCascade(int c, const glm::mat4 &projection, const glm::mat4 &lightView, const DrawCasters &drawCasters)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0, c);
+        glViewport(0, 0, size, size);
+        glClear(GL_DEPTH_BUFFER_BIT);
+        // slope-scaled bias against acne; the shader adds a normal offset on top
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+        drawCasters(projection, lightView);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+    }
+
+    void createResources()
+    {
+        if (created)
+            return;
+        created = true;
+        glGenTextures(1, &depthArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, depthArray);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, size, size, CASCADES, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+        // linear + compare = 2x2 PCF per tap in hardware
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[Shadows] Depth array framebuffer incomplete, shadows off");
+            glDeleteFramebuffers(1, &framebuffer);
+            glDeleteTextures(1, &depthArray);
+            framebuffer = depthArray = 0;
+        }
+        else
+            LOG_INFO("[Shadows] " << CASCADES << " cascades of " << size << "x" << size << ", re-rendered only when their contents change");
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+};
+
+#endif
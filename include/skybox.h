@@ -0,0 +1,127 @@
+#ifndef SKYBOX_H
+#define SKYBOX_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <atmosphere.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <procedural_sky.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// The environment as the backdrop, so what the car reflects is what is behind it. draw() runs once per
+// frame after the opaque surfaces (and before anything transparent, so the glass and the refraction copy
+// see it): one fullscreen triangle at the far plane, depth tested with GL_LEQUAL against the opaque depth
+// and not writing it, so only the pixels no surface covered run shaders/skybox.fs. It samples envCubemap
+// (the EXR's faces, or the procedural sky's) at mip SKYBOX_BLUR (default 0; 2-4 give a soft studio-like
+// backdrop for the cost of a few texels). A procedural sky is drawn by drawSky() instead, straight from
+// shaders/procedural_sky.fs (the atmosphere's sky-view LUT, see Atmosphere), so the backdrop follows the sun
+// the frame it moves and keeps the sun's disk sharp. SKYBOX=0 keeps the flat grey clear colour instead.
+class Skybox
+{
+public:
+    // texture unit of the environment during draw() (the last GlState tracks)
+    static const unsigned int UNIT = 31;
+
+    // `shaderDir` holds skybox.vs/.fs
+    explicit Skybox(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("SKYBOX_BLUR"))
+            lod = std::max(0.0f, (float)std::atof(env));
+    }
+
+    Skybox(const Skybox &) = delete;
+    Skybox &operator=(const Skybox &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("SKYBOX");
+        return !(env && std::string(env) == "0");
+    }
+
+    // GL thread: compiles the program
+    void init()
+    {
+        shader.reset(new Shader((shaderDir + "/skybox.vs").c_str(), (shaderDir + "/skybox.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        if (lod > 0.0f)
+            LOG_INFO("[Skybox] Environment backdrop at mip " << lod);
+    }
+
+    bool ready() const { return shader != nullptr; }
+
+    // GL thread, with the scene framebuffer bound, its opaque depth in place and the default GL_LESS depth
+    // test: fills the uncovered pixels with `envCubemap` as seen through `projection` * `view`. Leaves the
+    // depth state as it found it.
+    void draw(const glm::mat4 &projection, const glm::mat4 &view, GLuint envCubemap)
+    {
+        if (!ready() || !envCubemap)
+            return;
+        // directions only: the view without its translation
+        const glm::mat4 rotation = glm::mat4(glm::mat3(view));
+        shader->use();
+        shader->setMat4("inverseViewProjection", glm::inverse(projection * rotation));
+        shader->setInt("environmentMap", (int)UNIT);
+        shader->setFloat("lod", lod);
+        glState().bindTexture(UNIT, GL_TEXTURE_CUBE_MAP, envCubemap);
+        glState().bindVertexArray(emptyVao);
+        glDepthFunc(GL_LEQUAL);
+        glDepthMask(GL_FALSE);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+    }
+
+    // as draw(), with `sky` evaluated per pixel rather than read from its baked cube
+    void drawSky(const glm::mat4 &projection, const glm::mat4 &view, const ProceduralSky &sky)
+    {
+        if (!ready())
+            return;
+        if (!skyShader)
+            skyShader.reset(new Shader((shaderDir + "/skybox.vs").c_str(), (shaderDir + "/procedural_sky.fs").c_str()));
+        atmosphere().update(sky.sunDirection);
+        const glm::mat4 rotation = glm::mat4(glm::mat3(view));
+        skyShader->use();
+        skyShader->setMat4("inverseViewProjection", glm::inverse(projection * rotation));
+        skyShader->setVec3("sunDirection", glm::normalize(sky.sunDirection));
+        skyShader->setFloat("sunIntensity", sky.sunIntensity);
+        skyShader->setFloat("sunPower", sky.sunPower);
+        atmosphere().apply(*skyShader, sky);
+        glState().bindVertexArray(emptyVao);
+        glDepthFunc(GL_LEQUAL);
+        glDepthMask(GL_FALSE);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+    }
+
+    void releaseGpu()
+    {
+        shader.reset();
+        skyShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    std::unique_ptr<Shader> shader;
+    // skybox.vs with procedural_sky.fs, compiled by the first drawSky()
+    std::unique_ptr<Shader> skyShader;
+    // draw() builds the triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    float lod = 0.0f;
+};
+
+#endif
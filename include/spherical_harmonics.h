@@ -0,0 +1,132 @@
+#ifndef SPHERICAL_HARMONICS_H
+#define SPHERICAL_HARMONICS_H
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <vector>
+
+// Diffuse IBL as an L2 spherical-harmonics projection of the environment (Ramamoorthi & Hanrahan 2001):
+// 9 RGB coefficients replace the convolved irradiance cubemap, and model_loading.fs evaluates them per
+// fragment (IrradianceSH) instead of sampling a cube.
+//
+// Usage: add() every environment texel (or projectEquirect for a whole lat-long image), then finish().
+// After finish() the coefficients are the cosine-convolved irradiance divided by PI, with the basis
+// constants folded in, so the shader only evaluates the bare polynomials:
+//   1, y, z, x, xy, yz, 3z^2 - 1, xz, x^2 - y^2
+class SHIrradiance
+{
+public:
+    static const int COEFFICIENTS = 9;
+
+    // per coefficient RGB; radiance projection until finish(), shader-ready irradiance afterwards
+    glm::vec3 c[COEFFICIENTS];
+
+    SHIrradiance()
+    {
+        for (int i = 0; i < COEFFICIENTS; ++i)
+            c[i] = glm::vec3(0.0f);
+    }
+
+    // accumulate radiance arriving from unit direction `dir` over `solidAngle` steradians
+    void add(const glm::vec3 &dir, const glm::vec3 &radiance, float solidAngle)
+    {
+        float b[COEFFICIENTS];
+        basis(dir, b);
+        for (int i = 0; i < COEFFICIENTS; ++i)
+            c[i] += radiance * (b[i] * solidAngle);
+    }
+
+    // project an equirectangular image laid out as equirectangular_to_cubemap.fs samples it:
+    // u = atan(z, x) / 2PI + 0.5, v = asin(y) / PI + 0.5, row 0 at v = 0. `channels` floats per texel (>= 3).
+    void projectEquirect(const float *pixels, int width, int height, int channels)
+    {
+        std::vector<float> cosPhi, sinPhi;
+        equirectAzimuth(width, cosPhi, sinPhi);
+        for (int y = 0; y < height; ++y)
+            addEquirectRow(pixels + (size_t)y * width * channels, channels, y, width, height, &cosPhi[0], &sinPhi[0]);
+    }
+
+    // per-column azimuth terms of a `width` texel equirectangular row, shared by every row
+    static void equirectAzimuth(int width, std::vector<float> &cosPhi, std::vector<float> &sinPhi)
+    {
+        const float PI = 3.14159265359f;
+        cosPhi.resize(width);
+        sinPhi.resize(width);
+        for (int x = 0; x < width; ++x)
+        {
+            float phi = ((x + 0.5f) / width - 0.5f) * 2.0f * PI;
+            cosPhi[x] = std::cos(phi);
+            sinPhi[x] = std::sin(phi);
+        }
+    }
+
+    // accumulate row `y` of a width x height equirectangular image (see projectEquirect), so callers that
+    // convert or decode row by row can project on the fly; rows may come in any order
+    void addEquirectRow(const float *row, int channels, int y, int width, int height, const float *cosPhi, const float *sinPhi)
+    {
+        const float PI = 3.14159265359f;
+        const float texelArea = (2.0f * PI / width) * (PI / height);
+        float latitude = ((y + 0.5f) / height - 0.5f) * PI;
+        float cosLat = std::cos(latitude), sinLat = std::sin(latitude);
+        float solidAngle = texelArea * cosLat;
+        for (int x = 0; x < width; ++x)
+        {
+            const float *p = row + (size_t)x * channels;
+            add(glm::vec3(cosLat * cosPhi[x], sinLat, cosLat * sinPhi[x]), glm::vec3(p[0], p[1], p[2]), solidAngle);
+        }
+    }
+
+    // sums a projection of other texels of the same environment (e.g. another thread's rows)
+    void merge(const SHIrradiance &other)
+    {
+        for (int i = 0; i < COEFFICIENTS; ++i)
+            c[i] += other.c[i];
+    }
+
+    // solid angle of texel (x, y) of a size x size cube face spanning [-1, 1]^2
+    static float cubeTexelSolidAngle(int x, int y, int size)
+    {
+        float u = 2.0f * (x + 0.5f) / size - 1.0f;
+        float v = 2.0f * (y + 0.5f) / size - 1.0f;
+        float d = 1.0f + u * u + v * v;
+        return (4.0f / (size * size)) / (d * std::sqrt(d));
+    }
+
+    // radiance projection -> irradiance / PI: cosine lobe convolution (A0 = PI, A1 = 2PI/3, A2 = PI/4)
+    // times the basis normalisation constants
+    void finish()
+    {
+        const float scale[COEFFICIENTS] = {
+            0.282095f * 1.0f,                                                   // A0 / PI
+            0.488603f * (2.0f / 3.0f), 0.488603f * (2.0f / 3.0f), 0.488603f * (2.0f / 3.0f), // A1 / PI
+            1.092548f * 0.25f, 1.092548f * 0.25f, 0.315392f * 0.25f, 1.092548f * 0.25f, 0.546274f * 0.25f}; // A2 / PI
+        for (int i = 0; i < COEFFICIENTS; ++i)
+            c[i] *= scale[i];
+    }
+
+    // one colour channel as the mat3 uniforms of model_loading.fs (column i / 3, row i % 3 = coefficient i)
+    glm::mat3 channel(int rgb) const
+    {
+        glm::mat3 m;
+        for (int i = 0; i < COEFFICIENTS; ++i)
+            m[i / 3][i % 3] = c[i][rgb];
+        return m;
+    }
+
+private:
+    static void basis(const glm::vec3 &d, float b[COEFFICIENTS])
+    {
+        b[0] = 0.282095f;
+        b[1] = 0.488603f * d.y;
+        b[2] = 0.488603f * d.z;
+        b[3] = 0.488603f * d.x;
+        b[4] = 1.092548f * d.x * d.y;
+        b[5] = 1.092548f * d.y * d.z;
+        b[6] = 0.315392f * (3.0f * d.z * d.z - 1.0f);
+        b[7] = 1.092548f * d.x * d.z;
+        b[8] = 0.546274f * (d.x * d.x - d.y * d.y);
+    }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef STARTUP_TIMINGS_H
+#define STARTUP_TIMINGS_H
+
+#include <engine_clock.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Where startup time goes, stage by stage (glTF JSON, import, textures, shaders, IBL): each stage's busy
+// time summed over every thread that worked on it, and its span on the EngineClock (first start to last
+// end, since process start). Stages overlap on the loader, the workers and the GL thread, so busy times
+// can add up to more than the total. main reports them once everything queued at startup is loaded and
+// baked; recording stops there, so later reloads and dropped files don't count.
+//
+//     StartupTimings::Scope startup("textures");
+class StartupTimings;
+inline StartupTimings &startupTimings();
+
+class StartupTimings
+{
+public:
+    // adds the time from construction to destruction on the calling thread to `stage` (a literal)
+    class Scope
+    {
+    public:
+        explicit Scope(const char *stage) : stage(stage), begin(EngineClock::ticks()) {}
+        ~Scope() { startupTimings().record(stage, begin, EngineClock::ticks()); }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        const char *stage;
+        EngineClock::Ticks begin;
+    };
+
+    void record(const char *stage, EngineClock::Ticks begin, EngineClock::Ticks end)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (done)
+            return;
+        Stage *s = nullptr;
+        for (size_t i = 0; i < stages.size() && !s; ++i)
+            if (stages[i].name == stage)
+                s = &stages[i];
+        if (!s)
+        {
+            stages.push_back(Stage());
+            s = &stages.back();
+            s->name = stage;
+            s->first = begin;
+            s->last = end;
+        }
+        s->busy += end - begin;
+        s->first = std::min(s->first, begin);
+        s->last = std::max(s->last, end);
+        ++s->scopes;
+    }
+
+    // the total since process start and the stages in order of their first start; ends recording
+    void report(std::ostream &out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        std::vector<Stage> sorted(stages);
+        std::sort(sorted.begin(), sorted.end(), [](const Stage &a, const Stage &b) { return a.first < b.first; });
+        out << std::fixed << std::setprecision(1) << "[Startup] Loaded " << EngineClock::ms() << " ms after process start";
+        for (size_t i = 0; i < sorted.size(); ++i)
+            out << "\n  " << std::left << std::setw(10) << sorted[i].name << std::right << " busy " << std::setw(8)
+                << EngineClock::toMs(sorted[i].busy) << " ms in " << sorted[i].scopes << " scopes, " << EngineClock::toMs(sorted[i].first)
+                << " - " << EngineClock::toMs(sorted[i].last) << " ms";
+    }
+
+private:
+    struct Stage
+    {
+        std::string name;
+        EngineClock::Ticks busy = 0, first = 0, last = 0;
+        size_t scopes = 0;
+    };
+
+    std::mutex mutex;
+    std::vector<Stage> stages;
+    bool done = false;
+};
+
+inline StartupTimings &startupTimings()
+{
+    static StartupTimings timings;
+    return timings;
+}
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef STEREO_RENDERER_H
+#define STEREO_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <frame_ring_buffer.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// STEREO=1: both eyes of a headset-style stereo pair in one pass. The scene draws once, with a variant of
+// the scene program (model_loading.vs/.fs with STEREO defined, plus model_stereo.gs) whose geometry stage
+// emits every triangle into both layers of a two-layer RGBA16F target, each through its eye's
+// view-projection (the `Stereo` block at BINDING). Culling, LOD selection and the draw submission happen
+// once, against a frustum that holds both eyes (the centre eye's, its apex moved back until its sides
+// pass through both eyes), so a stereo frame costs the vertex work twice and everything on the CPU once.
+// The eyes sit STEREO_IPD apart (default 0.064 scene units) along the camera's right axis with parallel
+// axes and the camera's field of view, each half as wide as the window. resolve() copies the layers side
+// by side into one texture, which ToneMapper::resolve presents like the mono image. Shading uses the
+// centre eye (specular highlights don't shift between the eyes), with the sun shadows and reflection
+// probes of the mono view and without the screen-space passes, TAA or clustered lights.
+class StereoRenderer
+{
+public:
+    // uniform buffer binding point of the `Stereo` block (see Shader::uniformBlockBinding)
+    static const GLuint BINDING = 4;
+
+    // std140 `Stereo` block of model_stereo.gs
+    struct EyeData
+    {
+        glm::mat4 viewProjection[2];
+    };
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("STEREO");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    // `shaderDir` holds model_loading.vs/.fs and model_stereo.gs
+    explicit StereoRenderer(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("STEREO_IPD"))
+            ipd = std::max(0.0f, (float)std::atof(env));
+    }
+
+    StereoRenderer(const StereoRenderer &) = delete;
+    StereoRenderer &operator=(const StereoRenderer &) = delete;
+
+    // GL thread: compiles the stereo scene program (its material variants follow on demand)
+    void init()
+    {
+        program.reset(new Shader((shaderDir + "/model_loading.vs").c_str(), (shaderDir + "/model_loading.fs").c_str(), "#define STEREO 1\n",
+                                 (shaderDir + "/model_stereo.gs").c_str()));
+        LOG_INFO("[Stereo] Single-pass stereo, IPD " << ipd << ", both eyes from one geometry-stage draw per mesh");
+    }
+
+    bool ready() const { return (bool)program; }
+    Shader &shader() { return *program; }
+
+    // per frame, before begin(): the eyes around a camera at `position` looking along `front` (unit `right`
+    // and `up`), `fovY` radians over each eye's `aspect`; writes their matrices into the frame ring
+    void setup(const glm::vec3 &position, const glm::vec3 &front, const glm::vec3 &up, const glm::vec3 &right, float fovY, float aspect,
+               float nearPlane, float farPlane)
+    {
+        const glm::mat4 projection = glm::perspective(fovY, aspect, nearPlane, farPlane);
+        EyeData eyes;
+        for (int e = 0; e < 2; ++e)
+        {
+            const glm::vec3 eye = position + right * (e == 0 ? -0.5f : 0.5f) * ipd;
+            eyes.viewProjection[e] = projection * glm::lookAt(eye, eye + front, up);
+        }
+        frameRing().bindUniform(BINDING, eyes);
+        // the combined frustum: same angles, apex behind the centre eye where its sides meet both eyes'
+        const float tanHalfX = std::tan(fovY * 0.5f) * aspect;
+        const float back = tanHalfX > 0.0f ? 0.5f * ipd / tanHalfX : 0.0f;
+        const glm::vec3 apex = position - front * back;
+        cullMatrix = glm::perspective(fovY, aspect, nearPlane + back, farPlane + back) * glm::lookAt(apex, apex + front, up);
+    }
+
+    // view-projection holding both eyes (culling, LOD selection, texture levels)
+    const glm::mat4 &cullViewProjection() const { return cullMatrix; }
+
+    // GL thread: binds the layered target (re-created at `eyeWidth` x `eyeHeight`) with both layers cleared
+    // to `clear` (linear) and the viewport set; false (and stereo off) when the driver can't make it
+    bool begin(int eyeWidth, int eyeHeight, const glm::vec4 &clear)
+    {
+        if (!createTarget(std::max(eyeWidth, 1), std::max(eyeHeight, 1)))
+            return false;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, targetWidth, targetHeight);
+        glClearColor(clear.r, clear.g, clear.b, clear.a);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        return true;
+    }
+
+    // GL thread, after the scene: both eyes side by side in one linear texture (left eye left), for the
+    // tone map; the scene framebuffer is bound again
+    GLuint resolve()
+    {
+        if (!fbo)
+            return 0;
+        for (int e = 0; e < 2; ++e)
+        {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
+            glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, eyeArray, 0, e);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pairFbo);
+            glBlitFramebuffer(0, 0, targetWidth, targetHeight, e * targetWidth, 0, (e + 1) * targetWidth, targetHeight, GL_COLOR_BUFFER_BIT,
+                              GL_NEAREST);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        return pairTexture;
+    }
+
+    void releaseGpu()
+    {
+        releaseTarget();
+        program.reset();
+    }
+
+private:
+    std::string shaderDir;
+    float ipd = 0.064f;
+    std::unique_ptr<Shader> program;
+    glm::mat4 cullMatrix = glm::mat4(1.0f);
+    // layered scene target (one layer per eye) and the side-by-side copy
+    GLuint fbo = 0;
+    GLuint eyeArray = 0;
+    GLuint depthArray = 0;
+    GLuint readFbo = 0;
+    GLuint pairFbo = 0;
+    GLuint pairTexture = 0;
+    int targetWidth = 0, targetHeight = 0;
+
+    bool createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return true;
+        releaseTarget();
+        targetWidth = width;
+        targetHeight = height;
+        glGenTextures(1, &eyeArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, eyeArray);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA16F, width, height, 2, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glGenTextures(1, &depthArray);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, depthArray);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH24_STENCIL8, width, height, 2, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        glGenTextures(1, &pairTexture);
+        glBindTexture(GL_TEXTURE_2D, pairTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width * 2, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // layered attachments: gl_Layer picks the eye
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, eyeArray, 0);
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, depthArray, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glGenFramebuffers(1, &readFbo);
+        glGenFramebuffers(1, &pairFbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, pairFbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pairTexture, 0);
+        complete = complete && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Stereo] layered RGBA16F target unsupported, stereo off");
+            releaseGpu();
+            return false;
+        }
+        return true;
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (readFbo) glDeleteFramebuffers(1, &readFbo);
+        if (pairFbo) glDeleteFramebuffers(1, &pairFbo);
+        if (eyeArray) glDeleteTextures(1, &eyeArray);
+        if (depthArray) glDeleteTextures(1, &depthArray);
+        if (pairTexture) glDeleteTextures(1, &pairTexture);
+        fbo = readFbo = pairFbo = eyeArray = depthArray = pairTexture = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
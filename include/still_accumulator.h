@@ -0,0 +1,222 @@
+#ifndef STILL_ACCUMULATOR_H
+#define STILL_ACCUMULATOR_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// Progressive refinement while nothing moves (STILL=1). Once the camera, the placed models and the
+// environment have held still for a frame, every frame renders with a new sub-pixel jitter (a long
+// Halton(2,3) sequence, where TemporalAA cycles through eight) and a new seed for the stochastic IBL
+// lookups in model_loading.fs (FrameData::iblSeed), and accumulate() folds it into a float32 running mean
+// of all frames since the view settled, which the tone map presents instead of the frame itself. The
+// image converges towards the supersampled, smoothly filtered result over STILL_SAMPLES frames (default
+// 256) and then holds. Any change restarts the mean; while the view moves nothing here runs beyond one
+// matrix comparison, so interaction costs what it did (with TAA, when on, doing the anti-aliasing).
+class StillAccumulator
+{
+public:
+    // texture units during accumulate(), the same names and units as TemporalAA::resolve()
+    static const unsigned int UNIT_CURRENT = 17;
+    static const unsigned int UNIT_HISTORY = 18;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle) and still_accumulate.fs
+    explicit StillAccumulator(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *n = std::getenv("STILL_SAMPLES"))
+            maxSamples = (unsigned int)std::max(1, std::atoi(n));
+    }
+
+    StillAccumulator(const StillAccumulator &) = delete;
+    StillAccumulator &operator=(const StillAccumulator &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("STILL");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    // GL thread: compiles the accumulation program
+    void init()
+    {
+        shader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/still_accumulate.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        LOG_INFO("[Still] Accumulating up to " << maxSamples << " samples while the view holds still");
+    }
+
+    bool ready() const { return (bool)shader; }
+
+    // once per frame before the scene renders: `viewProjection` unjittered, `sceneStill` when no model,
+    // light or environment changed since the last frame. Returns whether this frame accumulates.
+    bool update(const glm::mat4 &viewProjection, bool sceneStill)
+    {
+        if (!ready())
+            return false;
+        const bool still = sceneStill && hasView && viewProjection == lastViewProjection;
+        lastViewProjection = viewProjection;
+        hasView = true;
+        if (!still)
+        {
+            if (samples > 0)
+                LOG_DEBUG("[Still] View changed after " << samples << " samples");
+            samples = 0;
+        }
+        // the first frame after a change is the ordinary one: it can't tell a pause from the next move
+        accumulatingFrame = still;
+        return accumulatingFrame;
+    }
+
+    // restarts the mean (camera cuts, resizes); the next frame is an ordinary one again
+    void reset()
+    {
+        hasView = false;
+        samples = 0;
+        accumulatingFrame = false;
+    }
+
+    bool accumulating() const { return accumulatingFrame; }
+    bool converged() const { return samples >= maxSamples; }
+    unsigned int sampleCount() const { return samples; }
+
+    // `projection` offset by this sample's sub-pixel jitter for a `width` x `height` target (as
+    // TemporalAA::jitterProjection); unchanged when not accumulating
+    glm::mat4 jitterProjection(const glm::mat4 &projection, int width, int height) const
+    {
+        if (!accumulatingFrame)
+            return projection;
+        glm::mat4 jittered = projection;
+        // index 0 is the pixel corner; the first sample is offset as much as any
+        const unsigned int index = samples % SEQUENCE_LENGTH + 1;
+        jittered[2][0] += 2.0f * (halton(index, 2) - 0.5f) / (float)width;
+        jittered[2][1] += 2.0f * (halton(index, 3) - 0.5f) / (float)height;
+        return jittered;
+    }
+
+    // FrameData::iblSeed of this frame: 0 keeps the IBL lookups deterministic
+    float iblSeed() const
+    {
+        return accumulatingFrame ? (float)(samples % SEQUENCE_LENGTH + 1) : 0.0f;
+    }
+
+    // GL thread, after the scene: folds `sceneColor` into the running mean and returns the mean's texture
+    // (valid until the next call); past STILL_SAMPLES the mean is returned as is. The scene framebuffer is
+    // bound again afterwards.
+    GLuint accumulate(GLuint sceneColor, int width, int height)
+    {
+        if (!accumulatingFrame || !sceneColor || width <= 0 || height <= 0)
+            return sceneColor;
+        createTargets(width, height);
+        if (converged())
+            return targets[current];
+        static const Shader::UniformHandle uWeight = Shader::uniformHandle("currentWeight");
+        const unsigned int write = current ^ 1u;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[write]);
+        glViewport(0, 0, width, height);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        shader->use();
+        // mean_n = mean_(n-1) + (x_n - mean_(n-1)) / n; 1 for the first sample drops the old contents
+        shader->setFloat(uWeight, 1.0f / (float)(samples + 1));
+        glState().bindTexture(UNIT_CURRENT, GL_TEXTURE_2D, sceneColor);
+        glState().bindTexture(UNIT_HISTORY, GL_TEXTURE_2D, targets[current]);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glEnable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        current = write;
+        if (++samples == maxSamples)
+            LOG_INFO("[Still] Converged at " << samples << " samples");
+        return targets[current];
+    }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        shader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    // jitter/seed period; long enough that the mean of a converged image has no visible pattern
+    static const unsigned int SEQUENCE_LENGTH = 1024;
+
+    std::string shaderDir;
+    std::unique_ptr<Shader> shader;
+    GLuint emptyVao = 0;
+    // float32: at hundreds of samples a half-float mean would stop moving (1/n below its precision)
+    GLuint targets[2] = {0, 0};
+    GLuint fbos[2] = {0, 0};
+    unsigned int current = 0; // targets[current] holds the mean so far
+    int targetWidth = 0, targetHeight = 0;
+    unsigned int maxSamples = 256;
+    unsigned int samples = 0;
+    bool accumulatingFrame = false;
+    bool hasView = false;
+    glm::mat4 lastViewProjection = glm::mat4(1.0f);
+
+    static float halton(unsigned int index, unsigned int base)
+    {
+        float result = 0.0f;
+        float fraction = 1.0f / (float)base;
+        while (index > 0)
+        {
+            result += fraction * (float)(index % base);
+            index /= base;
+            fraction /= (float)base;
+        }
+        return result;
+    }
+
+    void createTargets(int width, int height)
+    {
+        if (targets[0] && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        glGenTextures(2, targets);
+        glGenFramebuffers(2, fbos);
+        for (int i = 0; i < 2; ++i)
+        {
+            glBindTexture(GL_TEXTURE_2D, targets[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+            // linear: the tone map stretches it over the window under dynamic resolution
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbos[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, targets[i], 0);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+        // a new size starts a new mean
+        samples = 0;
+    }
+
+    void releaseTargets()
+    {
+        if (fbos[0]) glDeleteFramebuffers(2, fbos);
+        if (targets[0]) glDeleteTextures(2, targets);
+        fbos[0] = fbos[1] = targets[0] = targets[1] = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef TEMPORAL_AA_H
+#define TEMPORAL_AA_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// Temporal anti-aliasing over the linear HDR target (ToneMapper). Each frame the projection is offset by
+// a sub-pixel Halton(2,3) jitter, so over eight frames every pixel sees eight sample positions; resolve()
+// reprojects last frame's accumulated image with the opaque pass's motion vectors, clips it to the
+// neighbourhood of the current pixel (which is what rejects disocclusions and stale shading instead of
+// ghosting them) and blends in 10% of the new frame. The output feeds the tone-map pass. The history is
+// two ping-ponged RGBA16F textures, thrown away on resize and on reset() (camera cuts).
+// TAA=1 enables it.
+class TemporalAA
+{
+public:
+    // texture units during resolve() (the program's samplers are set at link, see Shader::samplerUnit)
+    static const unsigned int UNIT_CURRENT = 17;
+    static const unsigned int UNIT_HISTORY = 18;
+    static const unsigned int UNIT_VELOCITY = 19;
+    static const unsigned int SAMPLE_COUNT = 8;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle) and taa_resolve.fs
+    explicit TemporalAA(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    TemporalAA(const TemporalAA &) = delete;
+    TemporalAA &operator=(const TemporalAA &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("TAA");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    // GL thread: compiles the resolve program
+    void init()
+    {
+        shader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/taa_resolve.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        LOG_INFO("[TAA] " << SAMPLE_COUNT << "-sample Halton jitter, neighbourhood-clipped history");
+    }
+
+    bool ready() const { return (bool)shader; }
+
+    // camera cut: the next resolve() starts from the current frame alone
+    void reset() { historyValid = false; }
+
+    // sub-pixel offset of this frame's samples, in pixels within [-0.5, 0.5)
+    glm::vec2 jitter() const
+    {
+        const unsigned int index = frameIndex % SAMPLE_COUNT + 1; // Halton index 0 is the pixel corner
+        return glm::vec2(halton(index, 2) - 0.5f, halton(index, 3) - 0.5f);
+    }
+
+    // `projection` with jitter() applied for a `width` x `height` target; the offset is in clip space, so
+    // it lands on every depth the same number of pixels
+    glm::mat4 jitterProjection(const glm::mat4 &projection, int width, int height) const
+    {
+        glm::mat4 jittered = projection;
+        const glm::vec2 offset = jitter();
+        jittered[2][0] += 2.0f * offset.x / (float)width;
+        jittered[2][1] += 2.0f * offset.y / (float)height;
+        return jittered;
+    }
+
+    // GL thread, after the scene: accumulates `sceneColor` (with `velocity`, current minus previous NDC / 2)
+    // into the history and returns the anti-aliased texture, valid until the next resolve(); the scene
+    // framebuffer is bound again afterwards
+    GLuint resolve(GLuint sceneColor, GLuint velocity, int width, int height)
+    {
+        if (!ready() || !sceneColor || !velocity || width <= 0 || height <= 0)
+            return sceneColor;
+        createHistory(width, height);
+        static const Shader::UniformHandle uHistoryWeight = Shader::uniformHandle("historyWeight");
+        const unsigned int write = current ^ 1u;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbos[write]);
+        glViewport(0, 0, width, height);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        shader->use();
+        // 0 keeps the current frame alone (first frame, after a cut or resize)
+        shader->setFloat(uHistoryWeight, historyValid ? 0.9f : 0.0f);
+        glState().bindTexture(UNIT_CURRENT, GL_TEXTURE_2D, sceneColor);
+        glState().bindTexture(UNIT_HISTORY, GL_TEXTURE_2D, history[current]);
+        glState().bindTexture(UNIT_VELOCITY, GL_TEXTURE_2D, velocity);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glEnable(GL_DEPTH_TEST);
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        current = write;
+        historyValid = true;
+        ++frameIndex;
+        return history[current];
+    }
+
+    void releaseGpu()
+    {
+        releaseHistory();
+        shader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    std::unique_ptr<Shader> shader;
+    // resolve() draws a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    GLuint history[2] = {0, 0};
+    GLuint fbos[2] = {0, 0};
+    unsigned int current = 0; // history[current] holds last frame's result
+    bool historyValid = false;
+    unsigned int frameIndex = 0;
+    int historyWidth = 0, historyHeight = 0;
+
+    static float halton(unsigned int index, unsigned int base)
+    {
+        float result = 0.0f;
+        float fraction = 1.0f / (float)base;
+        while (index > 0)
+        {
+            result += fraction * (float)(index % base);
+            index /= base;
+            fraction /= (float)base;
+        }
+        return result;
+    }
+
+    void createHistory(int width, int height)
+    {
+        if (history[0] && width == historyWidth && height == historyHeight)
+            return;
+        releaseHistory();
+        historyWidth = width;
+        historyHeight = height;
+        glGenTextures(2, history);
+        glGenFramebuffers(2, fbos);
+        for (int i = 0; i < 2; ++i)
+        {
+            glBindTexture(GL_TEXTURE_2D, history[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+            // bilinear: the reprojected history sample falls between texels
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbos[i]);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, history[i], 0);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+        historyValid = false;
+    }
+
+    void releaseHistory()
+    {
+        if (fbos[0]) glDeleteFramebuffers(2, fbos);
+        if (history[0]) glDeleteTextures(2, history);
+        fbos[0] = fbos[1] = history[0] = history[1] = 0;
+        historyWidth = historyHeight = 0;
+        historyValid = false;
+    }
+};
+
+#endif
@@ -0,0 +1,453 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <glad/glad.h>
+#include <stb_image.h>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <gpu_memory.h>
+#include <mip_chain.h>
+#include <startup_timings.h>
+#include <thread_pool.h>
+#include <virtual_file_system.h>
+
+#if defined(HAS_BASISU)
+#include <basisu_transcoder.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// decoded 8-bit image as returned by stbi_load (pixels == NULL on failure). With levels > 1 (buildMipChain)
+// the smaller mip levels follow level 0 in the same allocation, tightly packed; stbi_image_free frees all.
+struct DecodedImage
+{
+    unsigned char *pixels = NULL;
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    int levels = 1;
+    // a KTX2 image transcoded to a block format (decodeKtx2): its GL internal format and bytes per 4x4 block.
+    // `pixels` then holds the blocks of every level, largest first
+    GLenum compressedFormat = 0;
+    int blockBytes = 0;
+};
+
+// bytes of mip `level` of `img` in its `pixels`
+inline size_t decodedLevelBytes(const DecodedImage &img, int level)
+{
+    const size_t w = (size_t)std::max(1, img.width >> level), h = (size_t)std::max(1, img.height >> level);
+    if (img.compressedFormat)
+        return ((w + 3) / 4) * ((h + 3) / 4) * (size_t)img.blockBytes;
+    return w * h * (size_t)img.components;
+}
+
+// gray+alpha texels (stb_image's 2 components) spread to RGBA in place, growing the decode's own allocation:
+// there is no sRGB two-channel format, and the cook and the upload only take 1, 3 or 4 channels
+inline void expandGrayAlpha(DecodedImage &img)
+{
+    if (!img.pixels || img.components != 2)
+        return;
+    const size_t count = (size_t)img.width * img.height;
+    unsigned char *pixels = (unsigned char *)std::realloc(img.pixels, count * 4);
+    if (!pixels)
+    {
+        stbi_image_free(img.pixels);
+        img = DecodedImage();
+        return;
+    }
+    // back to front, so no texel is overwritten before it is read
+    for (size_t i = count; i-- > 0;)
+    {
+        const unsigned char gray = pixels[i * 2], alpha = pixels[i * 2 + 1];
+        pixels[i * 4] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = gray;
+        pixels[i * 4 + 3] = alpha;
+    }
+    img.pixels = pixels;
+    img.components = 4;
+}
+
+inline DecodedImage decodeImageMemory(const unsigned char *bytes, size_t size)
+{
+    DecodedImage img;
+    if (size)
+        img.pixels = stbi_load_from_memory(bytes, (int)size, &img.width, &img.height, &img.components, 0);
+    expandGrayAlpha(img);
+    return img;
+}
+
+// through the VirtualFileSystem, so images inside a .carpak decode (and inflate) on the calling thread
+inline DecodedImage decodeImageFile(const std::string &filename)
+{
+    FrameTrace::Scope trace("decode image", filename);
+    StartupTimings::Scope startup("textures");
+    FileView file;
+    fileSystem().open(filename, file);
+    return decodeImageMemory(file.data(), file.size());
+}
+
+// true if every texel of `img` is within `tolerance` of the first one (per channel); its value goes to `texel`.
+// Solid-colour images are common in exported car models (a 72-byte PNG per paint colour).
+inline bool constantImage(const DecodedImage &img, unsigned char texel[4], int tolerance = 0)
+{
+    if (!img.pixels || img.compressedFormat || img.components < 1 || img.components > 4)
+        return false;
+    const int comps = img.components;
+    const size_t count = (size_t)img.width * img.height;
+    const unsigned char *p = img.pixels;
+    for (size_t i = 1; i < count; ++i)
+        for (int c = 0; c < comps; ++c)
+            if (std::abs((int)p[i * comps + c] - (int)p[c]) > tolerance)
+                return false;
+    texel[0] = texel[1] = texel[2] = p[0];
+    texel[3] = 255;
+    for (int c = 0; c < comps; ++c)
+        texel[c] = p[c];
+    return true;
+}
+
+// worker thread, after the decode: grows `img` to its full mip chain (MipChain, filtered in linear space
+// with `gamma`, renormalized as a `normalMap`), so the upload needs no glGenerateMipmap. Solid-colour images
+// stay single level; defineTextureImage() uploads those as one texel anyway.
+inline void buildMipChain(DecodedImage &img, bool gamma, bool normalMap)
+{
+    unsigned char texel[4];
+    if (!img.pixels || img.components < 1 || img.components > 4 || img.width * img.height <= 1 || constantImage(img, texel))
+        return;
+    FrameTrace::Scope trace("mip chain");
+    const uint32_t levels = MipChain::levelCount((uint32_t)img.width, (uint32_t)img.height);
+    // stb_image allocates with malloc, so the chain extends the decode's own buffer
+    unsigned char *chain = (unsigned char *)std::realloc(img.pixels, MipChain::chainBytes((uint32_t)img.width, (uint32_t)img.height, (uint32_t)img.components, levels));
+    if (!chain)
+        return;
+    img.pixels = chain;
+    MipChain::build(chain, (uint32_t)img.width, (uint32_t)img.height, (uint32_t)img.components, levels, gamma, normalMap);
+    img.levels = (int)levels;
+}
+
+// KTX2 container (the images of KHR_texture_basisu)
+inline bool isKtx2(const unsigned char *bytes, size_t size)
+{
+    static const unsigned char identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+    return size >= sizeof(identifier) && std::memcmp(bytes, identifier, sizeof(identifier)) == 0;
+}
+
+// whether KTX2 images decode at all (the Basis Universal transcoder is built in, HAS_BASISU)
+inline bool ktx2Supported()
+{
+#if defined(HAS_BASISU)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// whether decodeKtx2 transcodes colour data to BC7; set on the GL thread (bptcSupported) before models load
+inline std::atomic<bool> &ktx2ToBc7()
+{
+    static std::atomic<bool> enabled(false);
+    return enabled;
+}
+
+// worker thread: transcodes a KTX2 file (UASTC or ETC1S, KHR_texture_basisu) with every level it carries,
+// so the texture stays block compressed on the GPU: normal maps to BC5 (X and Y, as toktx --normal_mode
+// stores them; the shaders rebuild Z), everything else to BC7 where the driver has it, RGBA8 otherwise (with
+// a CPU mip chain if the file has a single level). Needs the Basis Universal transcoder (HAS_BASISU);
+// without it the image fails like an undecodable one and the texture keeps its placeholder.
+inline DecodedImage decodeKtx2(const unsigned char *bytes, size_t size, bool gamma, bool normalMap)
+{
+    DecodedImage img;
+#if defined(HAS_BASISU)
+    FrameTrace::Scope trace("transcode ktx2");
+    static std::once_flag initialized;
+    std::call_once(initialized, []() { basist::basisu_transcoder_init(); });
+    basist::ktx2_transcoder ktx2;
+    if (!ktx2.init(bytes, (uint32_t)size) || !ktx2.start_transcoding())
+        return img;
+    basist::transcoder_texture_format format = basist::transcoder_texture_format::cTFRGBA32;
+    img.components = 4;
+    if (normalMap)
+    {
+        format = basist::transcoder_texture_format::cTFBC5_RG;
+        img.compressedFormat = GL_COMPRESSED_RG_RGTC2;
+        img.components = 2;
+    }
+    else if (ktx2ToBc7())
+    {
+        format = basist::transcoder_texture_format::cTFBC7_RGBA;
+        img.compressedFormat = gamma ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    img.blockBytes = img.compressedFormat ? 16 : 0;
+    img.width = (int)ktx2.get_width();
+    img.height = (int)ktx2.get_height();
+    const int fileLevels = std::max(1, (int)ktx2.get_levels());
+    img.levels = !img.compressedFormat && fileLevels == 1 ? (int)MipChain::levelCount((uint32_t)img.width, (uint32_t)img.height) : fileLevels;
+    size_t total = 0;
+    for (int l = 0; l < img.levels; ++l)
+        total += decodedLevelBytes(img, l);
+    img.pixels = (unsigned char *)std::malloc(total);
+    if (!img.pixels)
+        return DecodedImage();
+    size_t offset = 0;
+    for (int l = 0; l < fileLevels; ++l)
+    {
+        // the output size counts blocks, or pixels for RGBA32
+        const size_t levelBytes = decodedLevelBytes(img, l);
+        const uint32_t units = (uint32_t)(levelBytes / (img.compressedFormat ? (size_t)img.blockBytes : 4));
+        if (!ktx2.transcode_image_level((uint32_t)l, 0, 0, img.pixels + offset, units, format))
+        {
+            std::free(img.pixels);
+            return DecodedImage();
+        }
+        offset += levelBytes;
+    }
+    if (img.levels > fileLevels)
+        MipChain::build(img.pixels, (uint32_t)img.width, (uint32_t)img.height, 4, (uint32_t)img.levels, gamma, false);
+#else
+    (void)bytes;
+    (void)size;
+    (void)gamma;
+    (void)normalMap;
+#endif
+    return img;
+}
+
+// worker thread: decodes a texture's file, KTX2 through decodeKtx2 and anything else through stb_image
+// with its CPU mip chain
+inline DecodedImage decodeTexture(const unsigned char *bytes, size_t size, bool gamma, bool normalMap)
+{
+    if (isKtx2(bytes, size))
+        return decodeKtx2(bytes, size, gamma, normalMap);
+    DecodedImage img = decodeImageMemory(bytes, size);
+    buildMipChain(img, gamma, normalMap);
+    return img;
+}
+
+// pixel transfer format and internal format for an 8-bit image with `components` channels. Two channels
+// are RG8 (gray+alpha reaches the upload as RGBA, expandGrayAlpha; linear only, there is no sRGB RG format),
+// so the bytes the transfer reads always match decodedLevelBytes
+inline void imageFormats(int components, bool gamma, GLenum &format, GLenum &internalFormat)
+{
+    format = GL_RGB;
+    internalFormat = GL_RGB;
+    if (components == 1) {
+        format = GL_RED;
+        internalFormat = GL_RED;
+    }
+    else if (components == 2) {
+        format = GL_RG;
+        internalFormat = GL_RG8;
+    }
+    else if (components == 3) {
+        format = GL_RGB;
+        internalFormat = gamma ? GL_SRGB : GL_RGB;
+    }
+    else if (components == 4) {
+        format = GL_RGBA;
+        internalFormat = gamma ? GL_SRGB_ALPHA : GL_RGBA;
+    }
+}
+
+// what a texture shows until its real image is uploaded
+enum class TexturePlaceholder
+{
+    White,     // neutral for base color / metallicRoughness (the material factors take over)
+    FlatNormal // (0.5, 0.5, 1) tangent-space normal
+};
+
+// One image shared by every mesh/model that references it. id/uploaded/uploading are only touched on the
+// GL thread.
+struct CachedTexture
+{
+    std::string path;
+    bool gamma = false;
+    uint64_t contentHash = 0;
+    TexturePlaceholder placeholder = TexturePlaceholder::White;
+    std::shared_future<DecodedImage> image;
+    unsigned int id = 0;
+    bool uploaded = false;
+    bool uploading = false; // queued on the UploadThread
+    int refs = 0; // guarded by the cache mutex
+};
+
+// Process-wide texture cache. Images are keyed by canonical path and by a hash of the file contents,
+// so the same file reached through different paths, byte-identical copies under different names and
+// images shared between models all decode once and cost one GPU allocation. Entries are reference
+// counted; the GL texture is deleted when the last user releases it.
+class TextureCache
+{
+public:
+    static TextureCache &instance()
+    {
+        static TextureCache cache;
+        return cache;
+    }
+
+    // any thread: returns the (referenced) entry for `filename`, queueing its decode on `pool` if new
+    std::shared_ptr<CachedTexture> acquire(const std::string &filename, bool gamma, TexturePlaceholder placeholder, ThreadPool &pool)
+    {
+        std::string path = canonicalPath(filename);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::map<Key, std::shared_ptr<CachedTexture> >::iterator it = byPath.find(Key(path, gamma));
+            if (it != byPath.end())
+            {
+                it->second->refs++;
+                return it->second;
+            }
+        }
+        // read + hash outside the lock; the decode then runs from the bytes already in memory. Archive
+        // entries are hashed by their size and CRC from the zip directory instead, and opened by the decode
+        // job, so deflated ones inflate on the pool rather than one after another here.
+        std::shared_ptr<FileView> bytes = std::make_shared<FileView>();
+        uint64_t archivedSize = 0;
+        uint32_t archivedCrc = 0;
+        const bool archived = fileSystem().archivedEntry(path, archivedSize, archivedCrc);
+        uint64_t hash;
+        if (archived)
+            hash = hashBytes((const unsigned char *)&archivedCrc, sizeof(archivedCrc), archivedSize);
+        else
+        {
+            fileSystem().open(path, *bytes);
+            hash = hashBytes(bytes->data(), bytes->size(), bytes->size());
+        }
+        const bool hashed = archived || !bytes->empty();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        // another thread may have added the same path meanwhile
+        std::map<Key, std::shared_ptr<CachedTexture> >::iterator it = byPath.find(Key(path, gamma));
+        if (it != byPath.end())
+        {
+            it->second->refs++;
+            return it->second;
+        }
+        if (hashed)
+        {
+            std::map<HashKey, std::shared_ptr<CachedTexture> >::iterator h = byHash.find(HashKey(hash, gamma));
+            if (h != byHash.end())
+            {
+                LOG_DEBUG("[TextureCache] '" << path << "' is identical to '" << h->second->path << "', sharing texture");
+                h->second->refs++;
+                byPath[Key(path, gamma)] = h->second;
+                return h->second;
+            }
+        }
+        std::shared_ptr<CachedTexture> entry = std::make_shared<CachedTexture>();
+        entry->path = path;
+        entry->gamma = gamma;
+        entry->contentHash = hash;
+        entry->placeholder = placeholder;
+        entry->refs = 1;
+        const bool normalMap = placeholder == TexturePlaceholder::FlatNormal;
+        if (bytes->empty())
+            entry->image = decodeFile(path, gamma, normalMap, pool);
+        else
+            entry->image = pool.submit([bytes, gamma, normalMap]() { return decodeTexture(bytes->data(), bytes->size(), gamma, normalMap); }).share();
+        byPath[Key(path, gamma)] = entry;
+        if (hashed)
+            byHash[HashKey(hash, gamma)] = entry;
+        return entry;
+    }
+
+    // any thread: queues the read and decode of `path` on `pool`, outside the cache (TextureLoader's deferred
+    // textures, which start decoding long after their entry was made)
+    static std::shared_future<DecodedImage> decodeFile(const std::string &path, bool gamma, bool normalMap, ThreadPool &pool)
+    {
+        return pool.submit([path, gamma, normalMap]() {
+            FrameTrace::Scope trace("decode image", path);
+            StartupTimings::Scope startup("textures");
+            FileView file;
+            fileSystem().open(path, file);
+            return decodeTexture(file.data(), file.size(), gamma, normalMap);
+        }).share();
+    }
+
+    // any thread: starts reading the files of `filenames` that aren't cached yet (VirtualFileSystem::prefetch),
+    // for a loader that knows its images before it gets to acquire() them
+    void prefetch(const std::vector<std::string> &filenames)
+    {
+        std::vector<std::string> paths;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < filenames.size(); ++i)
+            {
+                std::string path = canonicalPath(filenames[i]);
+                if (!byPath.count(Key(path, false)) && !byPath.count(Key(path, true)))
+                    paths.push_back(path);
+            }
+        }
+        fileSystem().prefetch(paths);
+    }
+
+    // GL thread: drops one reference; deletes the GL texture with the last one
+    void release(const std::shared_ptr<CachedTexture> &entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--entry->refs > 0)
+            return;
+        for (std::map<Key, std::shared_ptr<CachedTexture> >::iterator it = byPath.begin(); it != byPath.end();)
+        {
+            if (it->second == entry)
+                byPath.erase(it++);
+            else
+                ++it;
+        }
+        std::map<HashKey, std::shared_ptr<CachedTexture> >::iterator h = byHash.find(HashKey(entry->contentHash, entry->gamma));
+        if (h != byHash.end() && h->second == entry)
+            byHash.erase(h);
+        if (entry->id)
+        {
+            gpuMemory().releaseTexture(entry->id);
+            glDeleteTextures(1, &entry->id);
+        }
+        entry->id = 0;
+        if (!entry->uploaded)
+        {
+            // decode still owns its pixels
+            DecodedImage img = entry->image.get();
+            stbi_image_free(img.pixels);
+            entry->uploaded = true;
+        }
+    }
+
+    // lexical normalisation: '\\' -> '/', drops "." and duplicate separators, resolves ".."
+    static std::string canonicalPath(const std::string &path)
+    {
+        return VirtualFileSystem::canonicalPath(path);
+    }
+
+private:
+    typedef std::pair<std::string, bool> Key;
+    typedef std::pair<uint64_t, bool> HashKey;
+
+    std::mutex mutex;
+    std::map<Key, std::shared_ptr<CachedTexture> > byPath;
+    std::map<HashKey, std::shared_ptr<CachedTexture> > byHash;
+
+    // 64-bit FNV-1a over the bytes, with `length` (the file size) folded in
+    static uint64_t hashBytes(const unsigned char *bytes, size_t size, uint64_t length)
+    {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            h ^= bytes[i];
+            h *= 1099511628211ull;
+        }
+        h ^= length;
+        h *= 1099511628211ull;
+        return h;
+    }
+};
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+#include <stb_image.h>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <thread_pool.h>
+#include <render_debug.h>
+#include <gl_backend.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <startup_timings.h>
+#include <texture_cache.h>
+#include <upload_thread.h>
+
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// BPTC (BC7) is core only from GL 4.2; on the 3.3 context it needs GL_ARB_texture_compression_bptc
+inline bool bptcSupported()
+{
+    static int supported = -1;
+    if (supported < 0)
+    {
+        supported = GLAD_GL_VERSION_4_2 ? 1 : 0;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count && !supported; ++i)
+        {
+            const char *ext = (const char *)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (ext && std::strcmp(ext, "GL_ARB_texture_compression_bptc") == 0)
+                supported = 1;
+        }
+    }
+    return supported == 1;
+}
+
+// uploads a decoded image into texture `textureID` (with mipmaps) and frees the pixels.
+// `gamma` selects an sRGB internal format for color data.
+inline void uploadDecodedImage(unsigned int textureID, DecodedImage &img, bool gamma, const std::string &name)
+{
+    if (!img.pixels)
+    {
+        LOG_WARN("Texture failed to load at path: " << name);
+        return;
+    }
+    FrameTrace::Scope trace("upload texture", name);
+    StartupTimings::Scope startup("textures");
+    LOG_DEBUG("[TextureFromFile] loading '" << name << "' -> " << img.width << "x" << img.height << " comps=" << img.components << " -> id=" << textureID);
+    if (!glBackend().dsa())
+        glState().bindTexture(0, GL_TEXTURE_2D, textureID);
+    const TextureDefinition def = defineTextureImage(textureID, img, gamma, 0, name);
+    gpuMemory().trackTexture(textureID, GpuMemory::MODEL_TEXTURES, def.internalFormat, def.width, def.height, 1, def.mipmapped, name);
+    RenderDebug::checkDraw("after glTexImage2D", 0, name.c_str());
+
+    stbi_image_free(img.pixels);
+    img.pixels = NULL;
+}
+
+// Per-model front end of TextureCache. request() is safe on a loader thread: it looks the image up in
+// the process-wide cache (queueing its decode on the worker pool if it's new) and returns a ticket.
+// On the GL thread, createTextures() makes a texture name per new image (filled with a 1x1 placeholder
+// so it can be sampled right away) and uploadReady() swaps in decoded images as they complete, within a
+// time budget; with the UploadThread running it only hands them over and picks up finished uploads.
+// Images already uploaded for another model are reused as-is.
+//
+// A deferred request (MeshRegions: textures only the cabin or the underside use) gets its texture name and
+// placeholder like any other but isn't read or decoded until load() asks for it; the image then arrives
+// through uploadReady() into the same texture, so the meshes holding its name need no patching. Deferred
+// images stay private to this loader; requesting one again undeferred before createTextures() turns it
+// into an ordinary cache entry.
+class TextureLoader
+{
+public:
+    explicit TextureLoader(ThreadPool &pool = ThreadPool::shared()) : pool(pool) {}
+
+    ~TextureLoader()
+    {
+        release();
+    }
+
+    TextureLoader(const TextureLoader &) = delete;
+    TextureLoader &operator=(const TextureLoader &) = delete;
+
+    // no GL calls; returns a ticket for textureId() once createTextures() ran
+    unsigned int request(const std::string &filename, bool gamma, TexturePlaceholder placeholder = TexturePlaceholder::White,
+                         bool deferred = false)
+    {
+        std::pair<std::string, bool> key(filename, gamma);
+        std::map<std::pair<std::string, bool>, unsigned int>::const_iterator it = requested.find(key);
+        if (it != requested.end())
+        {
+            const unsigned int t = it->second;
+            if (!deferred && waiting[t] && !entries[t]->id)
+            {
+                entries[t] = TextureCache::instance().acquire(filename, gamma, entries[t]->placeholder, pool);
+                waiting[t] = 0;
+            }
+            return t;
+        }
+        if (entries.empty())
+            batchStart = std::chrono::steady_clock::now();
+        if (deferred)
+        {
+            // nothing to upload until load()
+            std::shared_ptr<CachedTexture> entry = std::make_shared<CachedTexture>();
+            entry->path = TextureCache::canonicalPath(filename);
+            entry->gamma = gamma;
+            entry->placeholder = placeholder;
+            entry->refs = 1;
+            entry->uploaded = true;
+            unsigned int ticket = (unsigned int)entries.size();
+            requested[key] = ticket;
+            entries.push_back(entry);
+            waiting.push_back(1);
+            return ticket;
+        }
+        std::shared_ptr<CachedTexture> entry = TextureCache::instance().acquire(filename, gamma, placeholder, pool);
+        // a different path may resolve to an image this model already holds (same content)
+        for (unsigned int t = 0; t < entries.size(); ++t)
+        {
+            if (entries[t] == entry)
+            {
+                TextureCache::instance().release(entry);
+                requested[key] = t;
+                return t;
+            }
+        }
+        unsigned int ticket = (unsigned int)entries.size();
+        requested[key] = ticket;
+        entries.push_back(entry);
+        waiting.push_back(0);
+        return ticket;
+    }
+
+    // whether `ticket` is a deferred request load() hasn't started yet
+    bool deferred(unsigned int ticket) const { return ticket < waiting.size() && waiting[ticket]; }
+
+    // GL thread: starts decoding the deferred images among `tickets` (uploadReady() swaps them in); returns
+    // how many were started
+    size_t load(const std::vector<unsigned int> &tickets)
+    {
+        size_t started = 0;
+        for (size_t i = 0; i < tickets.size(); ++i)
+        {
+            const unsigned int t = tickets[i];
+            if (!deferred(t))
+                continue;
+            CachedTexture &e = *entries[t];
+            e.image = TextureCache::decodeFile(e.path, e.gamma, e.placeholder == TexturePlaceholder::FlatNormal, pool);
+            e.uploaded = false;
+            waiting[t] = 0;
+            ++started;
+        }
+        return started;
+    }
+
+    // GL thread: creates the texture names (with placeholder contents) for all images that don't have one yet
+    void createTextures()
+    {
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            CachedTexture &e = *entries[i];
+            if (e.id)
+                continue;
+            glGenTextures(1, &e.id);
+            const unsigned char white[4] = {255, 255, 255, 255};
+            const unsigned char flatNormal[4] = {128, 128, 255, 255};
+            glState().bindTexture(0, GL_TEXTURE_2D, e.id);
+            glTexImage2D(GL_TEXTURE_2D, 0, e.gamma ? GL_SRGB_ALPHA : GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         e.placeholder == TexturePlaceholder::FlatNormal ? flatNormal : white);
+            gpuMemory().trackTexture(e.id, GpuMemory::MODEL_TEXTURES, GL_RGBA8, 1, 1, 1, false, e.path);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        }
+    }
+
+    unsigned int textureId(unsigned int ticket) const { return ticket < entries.size() ? entries[ticket]->id : 0; }
+    unsigned int textureCount() const { return (unsigned int)entries.size(); }
+
+    // cache entry behind a ticket (NULL if unknown); lets offline tools read the decoded image
+    std::shared_ptr<CachedTexture> entry(unsigned int ticket) const { return ticket < entries.size() ? entries[ticket] : std::shared_ptr<CachedTexture>(); }
+
+    // GL thread: uploads decoded images that are ready, stopping once `budgetMs` is spent
+    // (budgetMs < 0 waits for and uploads everything). Returns true when nothing is left.
+    bool uploadReady(double budgetMs)
+    {
+        createTextures();
+        UploadThread &uploader = uploadThread();
+        if (uploader.running())
+        {
+            // blocking loads upload here, after whatever the thread still has
+            if (budgetMs < 0.0)
+                uploader.finish();
+            else
+                uploader.collect();
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool done = true;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            CachedTexture &e = *entries[i];
+            if (e.uploaded)
+                continue;
+            if (e.uploading)
+            {
+                done = false;
+                continue;
+            }
+            if (budgetMs >= 0.0)
+            {
+                if (e.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                {
+                    done = false;
+                    continue;
+                }
+                if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() > budgetMs)
+                    return false;
+            }
+            DecodedImage img = e.image.get();
+            if (budgetMs >= 0.0 && uploader.running() && img.pixels)
+            {
+                uploader.submit(entries[i], img);
+                done = false;
+                continue;
+            }
+            uploadDecodedImage(e.id, img, e.gamma, e.path);
+            e.uploaded = true;
+        }
+        if (!done)
+            return false;
+        if (!reported && !entries.empty())
+        {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStart).count();
+            LOG_INFO("[TextureLoader] " << entries.size() << " textures ready (decoded on " << pool.size() << " threads) after " << ms << " ms");
+            reported = true;
+        }
+        return true;
+    }
+
+    // GL thread: blocks until every requested texture is uploaded
+    void finish()
+    {
+        uploadReady(-1.0);
+    }
+
+    // GL thread: drops this model's references; images nobody else uses are deleted
+    void release()
+    {
+        // the upload thread must be done writing textures that may be deleted here
+        for (size_t i = 0; i < entries.size(); ++i)
+            if (entries[i]->uploading)
+            {
+                uploadThread().finish();
+                break;
+            }
+        for (size_t i = 0; i < entries.size(); ++i)
+            TextureCache::instance().release(entries[i]);
+        entries.clear();
+        waiting.clear();
+        requested.clear();
+    }
+
+private:
+    ThreadPool &pool;
+    std::vector<std::shared_ptr<CachedTexture> > entries;
+    std::vector<unsigned char> waiting; // per ticket: deferred, not loaded yet
+    std::map<std::pair<std::string, bool>, unsigned int> requested;
+    bool reported = false;
+    std::chrono::steady_clock::time_point batchStart;
+};
+
+#endif
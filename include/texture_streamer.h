@@ -0,0 +1,325 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <mapped_file.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Mip residency of cooked textures (TEXTURE_STREAMING=1). A cooked model uploads only the small levels of
+// each texture (RESIDENT_SIZE pixels and below) at load and points GL_TEXTURE_BASE_LEVEL at the finest one
+// on the GPU, so sampling never reaches a missing level. Every frame Model::requestTextureLevels() reports
+// the finest level each visible mesh needs (texture size * Mesh::uvDensity * uv scale against the mesh's
+// pixels per model unit at its nearest point) and update() streams the missing levels in one at a time,
+// coarse to fine: a pool worker copies the level out of the cooked file's mapping into a mapped pixel
+// unpack buffer (so the page faults happen off the GL thread) and a later frame sources glTexImage2D from
+// that buffer. Copies of at most TEXTURE_STREAM_KB (default 4096) start per frame. Once the streamed
+// levels pass TEXTURE_POOL_MB (default 256), levels finer than what the view needs are dropped again,
+// least recently needed first.
+class TextureStreamer
+{
+public:
+    // levels at most this many pixels on their longer side are uploaded at load and never dropped
+    static const unsigned int RESIDENT_SIZE = 64;
+
+    // one mip level inside the mapping
+    struct Level
+    {
+        const unsigned char *data;
+        size_t size;
+    };
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("TEXTURE_STREAMING");
+        return env && std::string(env) == "1";
+    }
+
+    TextureStreamer()
+    {
+        if (const char *kb = std::getenv("TEXTURE_STREAM_KB"))
+            frameBudget = (size_t)std::max(1, std::atoi(kb)) << 10;
+        if (const char *mb = std::getenv("TEXTURE_POOL_MB"))
+            poolBudget = (size_t)std::max(1, std::atoi(mb)) << 20;
+    }
+
+    TextureStreamer(const TextureStreamer &) = delete;
+    TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+    ~TextureStreamer()
+    {
+        // the jobs write into buffers of this streamer; the GL objects go with the context
+        for (size_t i = 0; i < entries.size(); ++i)
+            if (entries[i].copy.valid())
+                entries[i].copy.wait();
+    }
+
+    // GL thread: registers texture `id` (bound nowhere in particular) whose levels [residentLevel, levels.size())
+    // are uploaded; `source` keeps the mapping the levels point into alive. Returns the handle for request()
+    int add(GLuint id, GLenum internalFormat, GLenum format, bool compressed, int width, int height, const std::vector<Level> &levels,
+            int residentLevel, const std::shared_ptr<const MappedFile> &source, const std::string &owner)
+    {
+        size_t slot = 0;
+        while (slot < entries.size() && entries[slot].id)
+            ++slot;
+        if (slot == entries.size())
+            entries.push_back(Entry());
+        Entry &e = entries[slot];
+        e = Entry();
+        e.id = id;
+        e.internalFormat = internalFormat;
+        e.format = format;
+        e.compressed = compressed;
+        e.width = width;
+        e.height = height;
+        e.levels = levels;
+        e.startLevel = e.resident = e.wanted = residentLevel;
+        e.source = source;
+        e.owner = owner;
+        return (int)slot;
+    }
+
+    // GL thread: forgets `handle`, before its texture is deleted
+    void remove(int handle)
+    {
+        if (handle < 0 || (size_t)handle >= entries.size() || !entries[handle].id)
+            return;
+        Entry &e = entries[handle];
+        if (e.copy.valid())
+        {
+            e.copy.wait();
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, e.buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            freeBuffers.push_back(e.buffer);
+            poolBytes -= e.levels[e.resident - 1].size;
+        }
+        for (int l = e.resident; l < e.startLevel; ++l)
+            poolBytes -= e.levels[l].size;
+        entries[handle] = Entry();
+    }
+
+    // during the frame, before update(): the view samples `handle` at `uvPerPixel` UV units per screen pixel
+    // (0 when the texture is magnified or the camera is inside the mesh's bounds)
+    void request(int handle, float uvPerPixel)
+    {
+        if (handle < 0 || (size_t)handle >= entries.size() || !entries[handle].id)
+            return;
+        Entry &e = entries[handle];
+        const float texelsPerPixel = (float)std::max(e.width, e.height) * uvPerPixel;
+        int level = texelsPerPixel > 1.0f ? (int)std::floor(std::log2(texelsPerPixel)) : 0;
+        level = std::min(level, e.startLevel);
+        if (e.neededFrame != frame || level < e.wanted)
+            e.wanted = level;
+        e.neededFrame = frame;
+    }
+
+    // GL thread, once per frame after the requests: uploads the levels whose copies finished, drops levels
+    // over the pool budget and starts the next copies
+    void update()
+    {
+        levelsChanged = false;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            Entry &e = entries[i];
+            if (e.copy.valid() && e.copy.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                finishUpload(e);
+        }
+        while (poolBytes > poolBudget && evictOne())
+        {
+        }
+        size_t started = 0;
+        for (;;)
+        {
+            Entry *next = nullptr;
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                Entry &e = entries[i];
+                if (!e.id || e.copy.valid() || need(e) >= e.resident)
+                    continue;
+                // the largest shortfall first
+                if (!next || e.resident - need(e) > next->resident - need(*next))
+                    next = &e;
+            }
+            if (!next)
+                break;
+            const size_t bytes = next->levels[next->resident - 1].size;
+            if (started && started + bytes > frameBudget)
+                break;
+            while (poolBytes + bytes > poolBudget && evictOne())
+            {
+            }
+            if (poolBytes + bytes > poolBudget)
+                break;
+            startCopy(*next);
+            started += bytes;
+        }
+        ++frame;
+    }
+
+    // GL thread: deletes the unpack buffers; call before the GL context goes away
+    void releaseGpu()
+    {
+        for (size_t i = 0; i < entries.size(); ++i)
+            remove((int)i);
+        if (!freeBuffers.empty())
+            glDeleteBuffers((GLsizei)freeBuffers.size(), &freeBuffers[0]);
+        freeBuffers.clear();
+    }
+
+    // bytes of the levels streamed in (and being streamed in) above the ones uploaded at load
+    size_t streamedBytes() const { return poolBytes; }
+
+    // the last update() uploaded, dropped or started a level, or a copy is still running: the next frames
+    // may look different (IdleRenderer). A need the pool budget blocks doesn't count.
+    bool busy() const
+    {
+        if (levelsChanged)
+            return true;
+        for (size_t i = 0; i < entries.size(); ++i)
+            if (entries[i].copy.valid())
+                return true;
+        return false;
+    }
+
+private:
+    struct Entry
+    {
+        GLuint id = 0;
+        GLenum internalFormat = 0, format = 0;
+        bool compressed = false;
+        int width = 0, height = 0;
+        std::vector<Level> levels;
+        int startLevel = 0;   // finest level uploaded at load
+        int resident = 0;     // finest level on the GPU (GL_TEXTURE_BASE_LEVEL)
+        int wanted = 0;       // finest level asked for in neededFrame
+        unsigned long long neededFrame = 0;
+        std::shared_ptr<const MappedFile> source;
+        std::string owner;
+        // level resident - 1 on its way: the worker's copy into `buffer`
+        std::future<void> copy;
+        GLuint buffer = 0;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<GLuint> freeBuffers;
+    size_t frameBudget = 4096 << 10;
+    size_t poolBudget = (size_t)256 << 20;
+    size_t poolBytes = 0;
+    unsigned long long frame = 1;
+    bool mapWarned = false;
+    bool levelsChanged = false;
+
+    // finest level the view needs now: nothing beyond the load-time levels once it wasn't asked for this frame
+    int need(const Entry &e) const { return e.neededFrame == frame ? e.wanted : e.startLevel; }
+
+    void startCopy(Entry &e)
+    {
+        const Level level = e.levels[e.resident - 1];
+        if (freeBuffers.empty())
+        {
+            GLuint buffer = 0;
+            glGenBuffers(1, &buffer);
+            freeBuffers.push_back(buffer);
+        }
+        e.buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, e.buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)level.size, NULL, GL_STREAM_DRAW);
+        void *target = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)level.size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (!target)
+        {
+            freeBuffers.push_back(e.buffer);
+            e.buffer = 0;
+            if (!mapWarned)
+                LOG_WARN("[TextureStreamer] could not map an unpack buffer for " << e.owner << ", retrying next frame");
+            mapWarned = true;
+            return;
+        }
+        poolBytes += level.size;
+        levelsChanged = true;
+        e.copy = ThreadPool::shared().submit([target, level]() { std::memcpy(target, level.data, level.size); });
+    }
+
+    void finishUpload(Entry &e)
+    {
+        e.copy.get();
+        const GLint level = e.resident - 1;
+        const GLsizei w = std::max(1, e.width >> level), h = std::max(1, e.height >> level);
+        glState().bindTexture(0, GL_TEXTURE_2D, e.id);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, e.buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (e.compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, e.internalFormat, w, h, 0, (GLsizei)e.levels[level].size, (const void *)0);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, e.internalFormat, w, h, 0, e.format, GL_UNSIGNED_BYTE, (const void *)0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+        freeBuffers.push_back(e.buffer);
+        e.buffer = 0;
+        e.resident = level;
+        levelsChanged = true;
+        track(e);
+    }
+
+    // drops the finest level of the least recently needed texture holding more than the view needs
+    bool evictOne()
+    {
+        Entry *victim = nullptr;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            Entry &e = entries[i];
+            if (!e.id || e.copy.valid() || e.resident >= need(e))
+                continue;
+            if (!victim || e.neededFrame < victim->neededFrame)
+                victim = &e;
+        }
+        if (!victim)
+            return false;
+        const GLint level = victim->resident;
+        glState().bindTexture(0, GL_TEXTURE_2D, victim->id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+        // below the base level the image only has to exist; an empty one frees the storage
+        if (victim->compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, victim->internalFormat, 0, 0, 0, 0, NULL);
+        else
+            glTexImage2D(GL_TEXTURE_2D, level, victim->internalFormat, 0, 0, 0, victim->format, GL_UNSIGNED_BYTE, NULL);
+        poolBytes -= victim->levels[level].size;
+        victim->resident = level + 1;
+        levelsChanged = true;
+        track(*victim);
+        LOG_DEBUG("[TextureStreamer] dropped level " << level << " of " << victim->owner << " (" << GpuMemory::mb(poolBytes) << " MB streamed)");
+        return true;
+    }
+
+    void track(const Entry &e)
+    {
+        gpuMemory().trackTexture(e.id, GpuMemory::MODEL_TEXTURES, e.internalFormat, std::max(1, e.width >> e.resident), std::max(1, e.height >> e.resident),
+                                 1, e.resident + 1 < (int)e.levels.size(), e.owner);
+    }
+};
+
+// GL thread only; shared by every cooked model
+inline TextureStreamer &textureStreamer()
+{
+    static TextureStreamer streamer;
+    return streamer;
+}
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <frame_trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// The engine's job system: a fixed set of workers for CPU work (image decoding, mesh processing, per-mesh
+// loops of the renderer). Jobs must not touch GL; results come back through std::future (submit()), are
+// written in place (parallelFor()) or hand over to dependent jobs (TaskGraph).
+//
+// Every worker owns a deque. A job submitted from a worker goes to the back of its own deque and that
+// worker takes its newest job first (what it just produced is still in its cache); jobs submitted from
+// other threads go to a shared queue. A worker out of both steals the oldest job of another worker, so
+// a burst of jobs produced on one thread spreads over all of them without a central queue they all
+// contend on. Background jobs (submitBackground()) wait in a queue of their own that a worker only turns
+// to when there is nothing else to run or steal. JOB_WORKERS=N overrides the worker count (default: one per hardware thread but one, which
+// the GL thread keeps). With TRACE_CAPTURE every worker has its own named track, and parallelFor() chunks
+// and TaskGraph tasks show on it under their names.
+class ThreadPool
+{
+public:
+    typedef std::function<void()> Job;
+
+    // counters since start, for the profiler report
+    struct Stats
+    {
+        size_t executed = 0; // jobs run, by workers or by threads helping
+        size_t stolen = 0;   // of those, taken from another worker's deque
+    };
+
+    // 0 = one worker per hardware thread, keeping one core for the GL thread
+    explicit ThreadPool(unsigned int workers = 0)
+    {
+        if (workers == 0)
+        {
+            unsigned int hw = std::thread::hardware_concurrency();
+            workers = hw > 1 ? hw - 1 : 1;
+        }
+        for (unsigned int i = 0; i < workers; ++i)
+            queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+        for (unsigned int i = 0; i < workers; ++i)
+            threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    template <class F>
+    std::future<typename std::result_of<F()>::type> submit(F job)
+    {
+        typedef typename std::result_of<F()>::type Result;
+        std::shared_ptr<std::packaged_task<Result()> > task = std::make_shared<std::packaged_task<Result()> >(job);
+        std::future<Result> result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    // like submit(), for work nobody waits on yet (prefetching): it runs only on a worker that has nothing
+    // else to do, never on a thread helping out through runPending(). The jobs it submits run as usual.
+    template <class F>
+    std::future<typename std::result_of<F()>::type> submitBackground(F job)
+    {
+        typedef typename std::result_of<F()>::type Result;
+        std::shared_ptr<std::packaged_task<Result()> > task = std::make_shared<std::packaged_task<Result()> >(job);
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            background.push_back([task]() { (*task)(); });
+            pending.fetch_add(1); // under the mutex, like enqueue(): no worker can be about to sleep
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    // runs fn(begin, end) over [0, count) in chunks of at least `grain` items and returns once all are done.
+    // The calling thread works through chunks too, so a loop too short to split (or a pool of one) costs
+    // no more than calling fn(0, count); it may be called from a job. Chunks are claimed one at a time,
+    // which balances uneven items; fn must not throw.
+    template <class F>
+    void parallelFor(size_t count, size_t grain, F fn, const char *name = "parallel for")
+    {
+        if (count == 0)
+            return;
+        grain = std::max<size_t>(1, grain);
+        // a few chunks per thread: enough to balance, few enough that claiming them stays noise
+        const size_t maxChunks = (threads.size() + 1) * 4;
+        const size_t chunks = std::min((count + grain - 1) / grain, maxChunks);
+        if (chunks <= 1 || threads.empty())
+        {
+            FrameTrace::Scope trace(name);
+            fn((size_t)0, count);
+            return;
+        }
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+        // helpers that start after the loop finished find no chunk left; the state outlives them
+        std::shared_ptr<ForState> state = std::make_shared<ForState>();
+        const F *body = &fn;
+        std::function<void()> drain = [state, body, count, chunks, chunkSize, name]() {
+            for (;;)
+            {
+                const size_t c = state->next.fetch_add(1);
+                if (c >= chunks)
+                    return;
+                {
+                    FrameTrace::Scope trace(name);
+                    const size_t begin = c * chunkSize;
+                    (*body)(begin, std::min(count, begin + chunkSize));
+                }
+                state->done.fetch_add(1);
+            }
+        };
+        const size_t helpers = std::min(chunks - 1, threads.size());
+        for (size_t i = 0; i < helpers; ++i)
+            enqueue(drain);
+        drain();
+        // the chunks left are running on workers: they are short, so wait here rather than pick up
+        // unrelated (possibly long) jobs on what may be the GL thread
+        while (state->done.load() < chunks)
+            std::this_thread::yield();
+    }
+
+    // runs one queued job on the calling thread, if there is one; for threads that wait on jobs
+    bool runPending()
+    {
+        Job job;
+        if (!take(workerIndex(), job, false))
+            return false;
+        job();
+        return true;
+    }
+
+    unsigned int size() const { return (unsigned int)threads.size(); }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.executed = executed.load();
+        s.stolen = stolen.load();
+        return s;
+    }
+
+    // process-wide pool shared by the loaders and the renderer
+    static ThreadPool &shared()
+    {
+        static ThreadPool pool(workersFromEnv());
+        return pool;
+    }
+
+private:
+    friend class TaskGraph;
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    struct ForState
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkerQueue> > queues; // one per worker, same index
+    std::deque<Job> injected;                          // jobs from threads outside the pool
+    std::deque<Job> background;                        // submitBackground(), oldest first
+    std::atomic<size_t> pending{0};                    // queued jobs not yet taken
+    std::atomic<size_t> executed{0};
+    std::atomic<size_t> stolen{0};
+    std::mutex mutex; // guards `injected`, `background` and the sleep
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static unsigned int workersFromEnv()
+    {
+        const char *env = std::getenv("JOB_WORKERS");
+        const int n = env ? std::atoi(env) : 0;
+        return n > 0 ? (unsigned int)n : 0u;
+    }
+
+    // the calling thread's worker index in this pool, -1 outside it
+    int workerIndex() const
+    {
+        const Worker &self = currentWorker();
+        return self.pool == this ? self.index : -1;
+    }
+
+    struct Worker
+    {
+        const ThreadPool *pool;
+        int index;
+    };
+
+    static Worker &currentWorker()
+    {
+        static thread_local Worker worker = {nullptr, -1};
+        return worker;
+    }
+
+    void enqueue(Job job)
+    {
+        const int self = workerIndex();
+        if (self >= 0)
+        {
+            std::lock_guard<std::mutex> lock(queues[self]->mutex);
+            queues[self]->jobs.push_back(std::move(job));
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            injected.push_back(std::move(job));
+        }
+        pending.fetch_add(1);
+        // a worker between checking `pending` and sleeping holds the mutex: taking it here means the
+        // notify can't fall into that gap
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        wake.notify_one();
+    }
+
+    // own deque newest first, then the shared queue, then the oldest job of another worker, then (workers
+    // only) the oldest background job
+    bool take(int self, Job &job, bool backgroundToo = true)
+    {
+        if (pending.load() == 0)
+            return false;
+        if (self >= 0 && popBack(*queues[self], job))
+            return true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!injected.empty())
+            {
+                job = std::move(injected.front());
+                injected.pop_front();
+                pending.fetch_sub(1);
+                executed.fetch_add(1);
+                return true;
+            }
+        }
+        const size_t n = queues.size();
+        for (size_t k = 1; k <= n; ++k)
+        {
+            const size_t victim = (size_t)(self + (int)k) % n;
+            if ((int)victim == self)
+                continue;
+            WorkerQueue &q = *queues[victim];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.jobs.empty())
+                continue;
+            job = std::move(q.jobs.front());
+            q.jobs.pop_front();
+            pending.fetch_sub(1);
+            executed.fetch_add(1);
+            stolen.fetch_add(1);
+            return true;
+        }
+        if (backgroundToo && self >= 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!background.empty())
+            {
+                job = std::move(background.front());
+                background.pop_front();
+                pending.fetch_sub(1);
+                executed.fetch_add(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool popBack(WorkerQueue &q, Job &job)
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.jobs.empty())
+            return false;
+        job = std::move(q.jobs.back());
+        q.jobs.pop_back();
+        pending.fetch_sub(1);
+        executed.fetch_add(1);
+        return true;
+    }
+
+    void workerLoop(unsigned int index)
+    {
+        Worker &self = currentWorker();
+        self.pool = this;
+        self.index = (int)index;
+        frameTrace().nameThread("job worker " + std::to_string(index + 1));
+        for (;;)
+        {
+            Job job;
+            if (take((int)index, job))
+            {
+                job();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || pending.load() > 0; });
+            if (stopping && pending.load() == 0)
+                return;
+        }
+    }
+};
+
+// A batch of jobs with dependencies, run to completion by run(): a task starts once every task it was
+// made to follow (precede()) has finished, on whichever worker finished the last of them. The graph has to
+// be acyclic. Tasks must not touch GL or throw.
+//
+//     TaskGraph graph;
+//     TaskGraph::Task a = graph.add([&]() { decode(); }, "decode");
+//     TaskGraph::Task b = graph.add([&]() { build(); }, "build");
+//     graph.precede(a, b);
+//     graph.run();
+class TaskGraph
+{
+public:
+    typedef size_t Task;
+
+    // `name` (a literal) labels the task on the trace
+    Task add(std::function<void()> fn, const char *name = "task")
+    {
+        nodes.push_back(std::unique_ptr<Node>(new Node()));
+        nodes.back()->fn = std::move(fn);
+        nodes.back()->name = name;
+        return nodes.size() - 1;
+    }
+
+    // `after` starts only once `before` has finished
+    void precede(Task before, Task after)
+    {
+        nodes[before]->successors.push_back(after);
+        nodes[after]->predecessors++;
+    }
+
+    size_t size() const { return nodes.size(); }
+
+    // runs every task and returns once all have finished; the calling thread runs queued jobs meanwhile,
+    // so a job may run a graph of its own. The graph can run again afterwards.
+    void run(ThreadPool &pool = ThreadPool::shared())
+    {
+        if (nodes.empty())
+            return;
+        remaining.store(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i)
+            nodes[i]->unfinished.store(nodes[i]->predecessors);
+        for (size_t i = 0; i < nodes.size(); ++i)
+            if (nodes[i]->predecessors == 0)
+                schedule(pool, i);
+        while (remaining.load() > 0)
+            if (!pool.runPending())
+                std::this_thread::yield();
+    }
+
+private:
+    struct Node
+    {
+        std::function<void()> fn;
+        const char *name = "task";
+        std::vector<Task> successors;
+        int predecessors = 0;
+        std::atomic<int> unfinished{0};
+    };
+
+    std::vector<std::unique_ptr<Node> > nodes;
+    std::atomic<size_t> remaining{0};
+
+    void schedule(ThreadPool &pool, Task task)
+    {
+        pool.enqueue([this, &pool, task]() {
+            Node &node = *nodes[task];
+            {
+                FrameTrace::Scope trace(node.name);
+                node.fn();
+            }
+            for (size_t k = 0; k < node.successors.size(); ++k)
+                if (nodes[node.successors[k]]->unfinished.fetch_sub(1) == 1)
+                    schedule(pool, node.successors[k]);
+            // last: run() may return (and the graph go away) as soon as this reaches 0
+            remaining.fetch_sub(1);
+        });
+    }
+};
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef TONE_MAPPER_H
+#define TONE_MAPPER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// Linear HDR scene colour with one tone-mapping pass. begin() binds an RGBA16F target (with a
+// 24/8 depth-stencil buffer like the window's, so the OIT and Hi-Z depth blits still match) as the scene
+// framebuffer; the scene shaders write linear radiance into it, so sorted glass and the OIT resolve blend
+// linear values. resolve() then maps it to the window in a single fullscreen pass: exposure, the curve,
+// display encoding, once per pixel however much overdraw the scene had. The target may be smaller than the
+// window (DynamicResolution); resolve() stretches it over the window bilinearly. The HDR image stays in the target
+// for post effects that run before resolve() (TemporalAA, which also gets an RG16F motion vector
+// attachment written by the opaque pass, see enableMotionVectors()). GpuPicker reads an R32UI pick ID
+// attachment the opaque pass writes next to them (enablePickIds()). Bloom's result is added in the same
+// pass (setBloom()), and AutoExposure's measured exposure scales the scene before the curve
+// (setAutoExposure()).
+// TONEMAP=aces (default) | reinhard | agx picks the curve (T cycles it at runtime), EXPOSURE (default 1)
+// scales the scene before it.
+class ToneMapper
+{
+public:
+    enum Curve { REINHARD, ACES, AGX, CURVE_COUNT };
+
+    // texture units of the HDR target, the bloom and the measured exposure during resolve() (the tonemap
+    // program's samplers are set at link)
+    static const unsigned int UNIT_HDR = 16;
+    static const unsigned int UNIT_BLOOM = 17;
+    static const unsigned int UNIT_EXPOSURE = 18;
+
+    // `shaderDir` holds oit_resolve.vs (the fullscreen triangle) and tonemap.fs
+    explicit ToneMapper(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("TONEMAP"))
+        {
+            for (int c = 0; c < CURVE_COUNT; ++c)
+                if (std::string(env) == curveName((Curve)c))
+                    activeCurve = (Curve)c;
+        }
+        if (const char *env = std::getenv("EXPOSURE"))
+            exposureScale = (float)std::atof(env);
+    }
+
+    ToneMapper(const ToneMapper &) = delete;
+    ToneMapper &operator=(const ToneMapper &) = delete;
+
+    static const char *curveName(Curve curve)
+    {
+        static const char *const names[CURVE_COUNT] = {"reinhard", "aces", "agx"};
+        return names[curve];
+    }
+
+    // GL thread: compiles the tone-mapping program
+    void init()
+    {
+        shader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/tonemap.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[ToneMap] HDR scene target, " << curveName(activeCurve) << " curve, exposure " << exposureScale);
+    }
+
+    // false before init() or once the target turned out unusable (the scene then draws into the window)
+    bool ready() const { return usable && shader; }
+
+    // adds the RG16F motion vector attachment (cleared to zero motion in begin(), written only between
+    // writeMotionVectors(true) and (false)); takes effect when the target is next created
+    void enableMotionVectors()
+    {
+        if (motionVectors)
+            return;
+        motionVectors = true;
+        releaseTarget();
+    }
+
+    // adds the R32UI pick ID attachment (COLOR_ATTACHMENT2, cleared to 0 = nothing in begin() and written
+    // alongside the motion vectors); takes effect when the target is next created
+    void enablePickIds()
+    {
+        if (pickIds)
+            return;
+        pickIds = true;
+        releaseTarget();
+    }
+
+    // GL thread, with the scene framebuffer bound: routes fragment outputs 1 and 2 (model_loading.fs Velocity
+    // and ObjectId) to the motion vector and pick ID attachments, for the passes whose surfaces should own
+    // their pixels' motion and pick
+    void writeMotionVectors(bool write)
+    {
+        if (!fbo || (!velocityTexture && !pickTexture))
+            return;
+        const GLenum buffers[3] = {GL_COLOR_ATTACHMENT0, velocityTexture ? (GLenum)GL_COLOR_ATTACHMENT1 : (GLenum)GL_NONE,
+                                   GL_COLOR_ATTACHMENT2};
+        glDrawBuffers(!write ? 1 : pickTexture ? 3 : 2, buffers);
+    }
+
+    // the HDR colour and motion vector targets of this frame (0 before begin())
+    GLuint colorTarget() const { return colorTexture; }
+    GLuint motionTarget() const { return velocityTexture; }
+    GLuint pickTarget() const { return pickTexture; }
+    // its depth-stencil renderbuffer, shared by VisibilityBuffer's ID target
+    GLuint depthTarget() const { return depthBuffer; }
+    int width() const { return targetWidth; }
+    int height() const { return targetHeight; }
+
+    Curve curve() const { return activeCurve; }
+    void setCurve(Curve curve) { activeCurve = curve; }
+    float exposure() const { return exposureScale; }
+    void setExposure(float exposure) { exposureScale = exposure; }
+
+    // GL thread, before the main view's clear: binds the HDR target (re-created when the size changed) and
+    // makes it the scene framebuffer the other passes return to
+    void begin(int width, int height)
+    {
+        if (ready() && width > 0 && height > 0)
+            createTarget(width, height);
+        const GLuint target = ready() ? fbo : 0;
+        glState().setSceneFramebuffer(target);
+        glBindFramebuffer(GL_FRAMEBUFFER, target);
+        if (target && (velocityTexture || pickTexture))
+        {
+            // the clears address draw buffers 1 and 2, which are the attachments only while routed there
+            writeMotionVectors(true);
+            const GLfloat zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            const GLuint nothing[4] = {0, 0, 0, 0};
+            if (velocityTexture)
+                glClearBufferfv(GL_COLOR, 1, zero);
+            if (pickTexture)
+                glClearBufferuiv(GL_COLOR, 2, nothing);
+            writeMotionVectors(false);
+        }
+    }
+
+    // GL thread: `texture` (Bloom::build) times `strength` is added to the scene by the next resolve() only
+    void setBloom(GLuint texture, float strength)
+    {
+        bloomTexture = texture;
+        bloomStrength = texture ? strength : 0.0f;
+    }
+
+    // GL thread: the one-texel exposure (AutoExposure::update) every draw multiplies EXPOSURE by from now
+    // on, 0 = the fixed exposure alone
+    void setAutoExposure(GLuint texture) { autoExposureTexture = texture; }
+
+    // where resolve() writes: the window (0, the default) or an offscreen framebuffer (BatchRenderer)
+    void setOutputFramebuffer(GLuint framebuffer) { output = framebuffer; }
+
+    // GL thread, after the scene: tone maps `source` (the HDR target itself when 0, else a texture such as
+    // TemporalAA's output) over the whole `windowWidth` x `windowHeight` output, which is the scene
+    // framebuffer again afterwards (for the HUD and frame captures)
+    void resolve(int windowWidth, int windowHeight, GLuint source = 0)
+    {
+        glState().setSceneFramebuffer(output);
+        glBindFramebuffer(GL_FRAMEBUFFER, output);
+        const GLuint bloom = bloomTexture;
+        const float strength = bloomStrength;
+        setBloom(0, 0.0f);
+        if (!ready() || !fbo)
+            return;
+        draw(source ? source : colorTexture, 0, 0, windowWidth, windowHeight, bloom, strength);
+    }
+
+    // GL thread, after resolve(): tone maps all of the linear texture `source` into the `width` x `height`
+    // rectangle at (`x`, `y`) of the output (GL pixels, bottom-up) with the same exposure and curve, without
+    // bloom (ViewAtlas thumbnails); the viewport is left on that rectangle
+    void present(GLuint source, int x, int y, int width, int height)
+    {
+        if (ready() && source && width > 0 && height > 0)
+            draw(source, x, y, width, height, 0, 0.0f);
+    }
+
+    void releaseGpu()
+    {
+        releaseTarget();
+        shader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().setSceneFramebuffer(0);
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    bool usable = false;
+    bool motionVectors = false;
+    bool pickIds = false;
+    GLuint output = 0;
+    Curve activeCurve = ACES;
+    float exposureScale = 1.0f;
+    GLuint bloomTexture = 0;
+    float bloomStrength = 0.0f;
+    GLuint autoExposureTexture = 0;
+    std::unique_ptr<Shader> shader;
+    // resolve() draws a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    GLuint fbo = 0;
+    GLuint colorTexture = 0;
+    GLuint velocityTexture = 0;
+    GLuint pickTexture = 0;
+    GLuint depthBuffer = 0;
+    int targetWidth = 0, targetHeight = 0;
+
+    void draw(GLuint source, int x, int y, int width, int height, GLuint bloom, float strength)
+    {
+        static const Shader::UniformHandle uExposure = Shader::uniformHandle("exposure");
+        static const Shader::UniformHandle uCurve = Shader::uniformHandle("curve");
+        static const Shader::UniformHandle uOutputOrigin = Shader::uniformHandle("outputOrigin");
+        static const Shader::UniformHandle uOutputSize = Shader::uniformHandle("outputSize");
+        static const Shader::UniformHandle uBloomStrength = Shader::uniformHandle("bloomStrength");
+        static const Shader::UniformHandle uAutoExposure = Shader::uniformHandle("autoExposure");
+        glViewport(x, y, width, height);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        shader->use();
+        shader->setFloat(uExposure, exposureScale);
+        shader->setInt(uCurve, (int)activeCurve);
+        shader->setVec2(uOutputOrigin, glm::vec2((float)x, (float)y));
+        shader->setVec2(uOutputSize, glm::vec2((float)width, (float)height));
+        shader->setFloat(uBloomStrength, bloom ? strength : 0.0f);
+        glState().bindTexture(UNIT_HDR, GL_TEXTURE_2D, source);
+        if (bloom)
+            glState().bindTexture(UNIT_BLOOM, GL_TEXTURE_2D, bloom);
+        shader->setBool(uAutoExposure, autoExposureTexture != 0);
+        if (autoExposureTexture)
+            glState().bindTexture(UNIT_EXPOSURE, GL_TEXTURE_2D, autoExposureTexture);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    void createTarget(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return;
+        releaseTarget();
+        targetWidth = width;
+        targetHeight = height;
+        glGenTextures(1, &colorTexture);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        // bilinear for the upscale in resolve(); the passes reading it per texel use texelFetch
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        if (motionVectors)
+        {
+            glGenTextures(1, &velocityTexture);
+            glBindTexture(GL_TEXTURE_2D, velocityTexture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_HALF_FLOAT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        if (pickIds)
+        {
+            glGenTextures(1, &pickTexture);
+            glBindTexture(GL_TEXTURE_2D, pickTexture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // GLFW's default framebuffer is 24-bit depth + 8-bit stencil; the OIT and Hi-Z copies use the same format
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        if (velocityTexture)
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, velocityTexture, 0);
+        if (pickTexture)
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, pickTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[ToneMap] RGBA16F render target unsupported, drawing the scene into the window without tone mapping");
+            usable = false;
+            releaseTarget();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorTexture) glDeleteTextures(1, &colorTexture);
+        if (velocityTexture) glDeleteTextures(1, &velocityTexture);
+        if (pickTexture) glDeleteTextures(1, &pickTexture);
+        if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+        fbo = colorTexture = velocityTexture = pickTexture = depthBuffer = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef TRANSFORM_HIERARCHY_H
+#define TRANSFORM_HIERARCHY_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Scene node transforms of a model, flattened: nodes are stored parents first (topological order) with
+// the index of their parent, so world matrices are refreshed in one linear pass over contiguous arrays.
+// setLocal() only marks a node dirty; update() recomputes the dirty nodes and everything below them.
+class TransformHierarchy
+{
+public:
+    // appends a node under `parent` (-1 = root), which must already exist; returns its index
+    int add(int parent, const glm::mat4 &local, const std::string &name = std::string())
+    {
+        const int index = (int)parents.size();
+        parents.push_back(parent < index ? parent : -1);
+        locals.push_back(local);
+        worlds.push_back(parents.back() >= 0 ? worlds[parents.back()] * local : local);
+        names.push_back(name);
+        dirty.push_back(0);
+        changed.push_back(0);
+        return index;
+    }
+
+    void clear()
+    {
+        parents.clear();
+        locals.clear();
+        worlds.clear();
+        names.clear();
+        dirty.clear();
+        changed.clear();
+        dirtyCount = 0;
+    }
+
+    size_t size() const { return parents.size(); }
+    int parent(int node) const { return parents[node]; }
+    const std::string &name(int node) const { return names[node]; }
+    const glm::mat4 &local(int node) const { return locals[node]; }
+    // model-from-node matrix as of the last update()
+    const glm::mat4 &world(int node) const { return worlds[node]; }
+
+    // first node called `name`, or -1
+    int find(const std::string &name) const
+    {
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == name)
+                return (int)i;
+        return -1;
+    }
+
+    void setLocal(int node, const glm::mat4 &local)
+    {
+        if (node < 0 || node >= (int)locals.size())
+            return;
+        locals[node] = local;
+        if (!dirty[node])
+            dirtyCount++;
+        dirty[node] = 1;
+    }
+
+    // recomputes the world matrices of dirty nodes and their descendants; returns how many changed
+    // (see changedSinceUpdate). Free when nothing was touched since the last call.
+    size_t update()
+    {
+        if (dirtyCount == 0)
+        {
+            if (lastChanged != 0)
+                std::fill(changed.begin(), changed.end(), 0);
+            lastChanged = 0;
+            return 0;
+        }
+        size_t count = 0;
+        for (size_t i = 0; i < parents.size(); ++i)
+        {
+            const int p = parents[i];
+            changed[i] = dirty[i] || (p >= 0 && changed[p]);
+            dirty[i] = 0;
+            if (!changed[i])
+                continue;
+            worlds[i] = p >= 0 ? worlds[p] * locals[i] : locals[i];
+            count++;
+        }
+        dirtyCount = 0;
+        lastChanged = count;
+        return count;
+    }
+
+    // whether the last update() changed this node's world matrix
+    bool changedSinceUpdate(int node) const { return node >= 0 && node < (int)changed.size() && changed[node]; }
+
+private:
+    std::vector<int> parents;
+    std::vector<glm::mat4> locals;
+    std::vector<glm::mat4> worlds;
+    std::vector<std::string> names;
+    std::vector<unsigned char> dirty;
+    std::vector<unsigned char> changed;
+    size_t dirtyCount = 0;
+    size_t lastChanged = 0;
+};
+
+#endif
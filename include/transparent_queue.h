@@ -0,0 +1,106 @@
+#ifndef TRANSPARENT_QUEUE_H
+#define TRANSPARENT_QUEUE_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Back-to-front queue of transparent draws, shared by everything drawn in one pass so blended surfaces of
+// different models interleave correctly. Entries are keyed by their squared distance to the eye (no sqrt)
+// and ordered with an LSD radix sort on the key's float bits, which are monotonic for non-negative floats.
+// The buffers persist across frames, so a steady scene allocates nothing; and when the same entries come
+// back with the eye and the scene (almost) unchanged, last frame's order is reused without sorting.
+class TransparentQueue
+{
+public:
+    struct Entry
+    {
+        uint32_t key;    // ~bits(distance^2): ascending keys draw furthest first
+        uint32_t source; // caller's draw source (e.g. placed model index)
+        uint32_t item;   // caller's item within the source (e.g. mesh index)
+    };
+
+    // starts collecting a new frame's entries
+    void begin()
+    {
+        entries.clear();
+        signature = 14695981039346656037ull;
+    }
+
+    void add(uint32_t source, uint32_t item, float distanceSquared)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &distanceSquared, sizeof(bits));
+        Entry e = {~bits, source, item};
+        entries.push_back(e);
+        signature = (signature ^ source) * 1099511628211ull;
+        signature = (signature ^ item) * 1099511628211ull;
+    }
+
+    // orders the entries back to front. The previous order is kept if the same entries were collected,
+    // `revision` (bumped by the caller whenever objects move) is unchanged and the eye moved less than
+    // `resortDistance`. Returns true if it sorted.
+    bool sort(const glm::vec3 &eye, unsigned int revision, float resortDistance)
+    {
+        const bool reuse = !order.empty() && order.size() == entries.size() && signature == sortedSignature &&
+                           revision == sortedRevision && glm::dot(eye - sortedEye, eye - sortedEye) < resortDistance * resortDistance;
+        if (reuse)
+            return false;
+        radixSort();
+        sortedSignature = signature;
+        sortedRevision = revision;
+        sortedEye = eye;
+        return true;
+    }
+
+    size_t size() const { return order.size(); }
+    bool empty() const { return order.empty(); }
+    // k-th entry back to front (after sort())
+    const Entry &operator[](size_t k) const { return entries[order[k]]; }
+
+private:
+    // four 8-bit passes over the keys, skipping passes where every key has the same digit
+    void radixSort()
+    {
+        const size_t n = entries.size();
+        order.resize(n);
+        scratch.resize(n);
+        for (size_t i = 0; i < n; ++i)
+            order[i] = (uint32_t)i;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            size_t counts[256];
+            std::memset(counts, 0, sizeof(counts));
+            for (size_t i = 0; i < n; ++i)
+                counts[(entries[i].key >> shift) & 0xFF]++;
+            if (n == 0 || counts[(entries[0].key >> shift) & 0xFF] == n)
+                continue;
+            size_t sum = 0;
+            for (int d = 0; d < 256; ++d)
+            {
+                const size_t c = counts[d];
+                counts[d] = sum;
+                sum += c;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint32_t e = order[i];
+                scratch[counts[(entries[e].key >> shift) & 0xFF]++] = e;
+            }
+            order.swap(scratch);
+        }
+    }
+
+    std::vector<Entry> entries;
+    // indices into entries, back to front
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> scratch;
+    uint64_t signature = 0;
+    uint64_t sortedSignature = 0;
+    unsigned int sortedRevision = 0;
+    glm::vec3 sortedEye = glm::vec3(0.0f);
+};
+
+#endif
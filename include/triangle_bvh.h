@@ -0,0 +1,579 @@
+#ifndef TRIANGLE_BVH_H
+#define TRIANGLE_BVH_H
+
+#include <glm/glm.hpp>
+
+#include <geometry_kernels.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+// Bounding volume hierarchy over the triangles of one mesh, for exact ray hits (Model::raycast: picking,
+// measuring). Built with binned SAH splits whose leaf cost counts blocks of WIDTH triangles, since that is
+// how leaves are tested: the triangles of a leaf are stored as SoA blocks (first vertex and both edges,
+// WIDTH lanes each; padding lanes are degenerate and never hit), and one Moller-Trumbore test covers a block
+// with SSE. Nodes are stored depth first (left child = node + 1) with the split axis, so traversal visits
+// the nearer child first. Besides single rays, raycast() takes packets of WIDTH rays that traverse together
+// (one SSE slab test for all of them per node), for coherent batches such as a grid of rays from a view.
+// TRIANGLE_PICKING=1 builds the trees at load (Model), as do RT_REFLECTIONS=1 and PATH_TRACE=1, which trace
+// them on the GPU (GpuSceneBvh) and have the trees keep the vertex normals of each lane for smooth shading;
+// about 60 bytes per triangle, 72 with the normals.
+class TriangleBVH
+{
+public:
+    static const unsigned int WIDTH = 4;
+    // triangles per leaf at most; SAH stops splitting earlier when a split doesn't pay for itself
+    static const unsigned int MAX_LEAF_TRIANGLES = 4 * WIDTH;
+    static const unsigned int BINS = 16;
+    static const unsigned int NO_TRIANGLE = ~0u;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("TRIANGLE_PICKING");
+        return (env && std::strcmp(env, "1") == 0) || tracedOnGpu();
+    }
+
+    // a GPU traversal shades its hits (RT_REFLECTIONS, PATH_TRACE): the trees should keep shading normals
+    static bool tracedOnGpu()
+    {
+        const char *reflections = std::getenv("RT_REFLECTIONS");
+        const char *pathTrace = std::getenv("PATH_TRACE");
+        return (reflections && std::strcmp(reflections, "1") == 0) || (pathTrace && std::strcmp(pathTrace, "1") == 0);
+    }
+
+    // nearest hit so far: raycast() only reports hits nearer than `t`, so one Hit can collect the nearest
+    // over several trees (or instances of one)
+    struct Hit
+    {
+        float t = FLT_MAX;
+        // index of the triangle in the mesh's index list (first index / 3)
+        unsigned int triangle = NO_TRIANGLE;
+        // barycentrics of the hit: position = v0 + u * (v1 - v0) + v * (v2 - v0)
+        float u = 0.0f, v = 0.0f;
+        // unit geometric normal of the triangle (winding order v0 v1 v2), in the tree's space
+        glm::vec3 normal = glm::vec3(0.0f);
+
+        bool valid() const { return triangle != NO_TRIANGLE; }
+    };
+
+    // WIDTH rays as SoA lanes; lanes not set are inactive
+    struct RayPacket
+    {
+        float ox[WIDTH], oy[WIDTH], oz[WIDTH];
+        float dx[WIDTH], dy[WIDTH], dz[WIDTH];
+        unsigned int active = 0; // lane bit mask
+
+        RayPacket()
+        {
+            for (unsigned int l = 0; l < WIDTH; ++l)
+                ox[l] = oy[l] = oz[l] = dx[l] = dy[l] = dz[l] = 0.0f;
+        }
+
+        void set(unsigned int lane, const glm::vec3 &origin, const glm::vec3 &dir)
+        {
+            ox[lane] = origin.x;
+            oy[lane] = origin.y;
+            oz[lane] = origin.z;
+            dx[lane] = dir.x;
+            dy[lane] = dir.y;
+            dz[lane] = dir.z;
+            active |= 1u << lane;
+        }
+        glm::vec3 origin(unsigned int lane) const { return glm::vec3(ox[lane], oy[lane], oz[lane]); }
+        glm::vec3 direction(unsigned int lane) const { return glm::vec3(dx[lane], dy[lane], dz[lane]); }
+    };
+
+    // `indexCount` / 3 triangles over `positions` (indices must be < `vertexCount`; triangles reaching past
+    // it are dropped). With `packedNormals` (per vertex, octahedral snorm16 x in the low and y in the high
+    // half, as PackedVertex stores them) each lane keeps its three vertex normals. Replaces any previous tree.
+    template <class Index>
+    void build(const glm::vec3 *positions, size_t vertexCount, const Index *indices, size_t indexCount, const uint32_t *packedNormals = NULL)
+    {
+        nodes.clear();
+        blocks.clear();
+        normals.clear();
+        triangles = 0;
+        std::vector<BuildTriangle> source;
+        source.reserve(indexCount / 3);
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            if ((size_t)indices[i] >= vertexCount || (size_t)indices[i + 1] >= vertexCount || (size_t)indices[i + 2] >= vertexCount)
+                continue;
+            BuildTriangle t;
+            t.v[0] = positions[indices[i]];
+            t.v[1] = positions[indices[i + 1]];
+            t.v[2] = positions[indices[i + 2]];
+            for (int k = 0; k < 3; ++k)
+                t.normal[k] = packedNormals ? packedNormals[indices[i + k]] : 0u;
+            t.boundsMin = glm::min(t.v[0], glm::min(t.v[1], t.v[2]));
+            t.boundsMax = glm::max(t.v[0], glm::max(t.v[1], t.v[2]));
+            t.centroid = (t.boundsMin + t.boundsMax) * 0.5f;
+            t.index = (unsigned int)(i / 3);
+            source.push_back(t);
+        }
+        if (source.empty())
+            return;
+        triangles = source.size();
+        std::vector<unsigned int> order(source.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = (unsigned int)i;
+        nodes.reserve(2 * (source.size() / WIDTH + 1));
+        blocks.reserve(source.size() / WIDTH + 1);
+        keepNormals = packedNormals != NULL;
+        if (keepNormals)
+            normals.reserve((source.size() / WIDTH + 1) * NORMAL_WORDS);
+        buildNode(source, order, 0, (unsigned int)order.size(), 0);
+        // leaves with partly filled blocks overrun the estimates above
+        nodes.shrink_to_fit();
+        blocks.shrink_to_fit();
+        normals.shrink_to_fit();
+    }
+
+    bool empty() const { return nodes.empty(); }
+    size_t triangleCount() const { return triangles; }
+    bool hasShadingNormals() const { return !normals.empty(); }
+    size_t memoryBytes() const { return nodes.capacity() * sizeof(Node) + blocks.capacity() * sizeof(Block) + normals.capacity() * 4; }
+    glm::vec3 boundsMin() const { return nodes[0].boundsMin; }
+    glm::vec3 boundsMax() const { return nodes[0].boundsMax; }
+
+    // nearest triangle along origin + t * dir with 0 < t < hit.t; true if it updated `hit`
+    bool raycast(const glm::vec3 &origin, const glm::vec3 &dir, Hit &hit) const
+    {
+        if (nodes.empty())
+            return false;
+        const glm::vec3 invDir = 1.0f / dir;
+        const float before = hit.t;
+        unsigned int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const unsigned int index = stack[--top];
+            const Node &node = nodes[index];
+            if (!rayBox(origin, invDir, node.boundsMin, node.boundsMax, hit.t))
+                continue;
+            if (node.isLeaf())
+            {
+                for (unsigned int b = node.index; b < node.index + node.blockCount(); ++b)
+                    intersectBlock(blocks[b], origin, dir, hit);
+                continue;
+            }
+            // nearer child on top
+            const bool rightFirst = dir[node.axis()] < 0.0f;
+            stack[top++] = rightFirst ? index + 1 : node.index;
+            stack[top++] = rightFirst ? node.index : index + 1;
+        }
+        return hit.t < before;
+    }
+
+    // the packet's active rays, each against its own hits[lane] as in the single ray raycast(); returns the
+    // lanes whose hit was updated. The rays descend together and a node is skipped once none of them enters
+    // it, so the packet should be coherent (neighbouring pixels, a small cone).
+    unsigned int raycast(const RayPacket &packet, Hit hits[WIDTH]) const
+    {
+        unsigned int updated = 0;
+        if (nodes.empty() || !packet.active)
+            return updated;
+#if defined(GEOMETRY_KERNELS_SSE2)
+        float before[WIDTH], limit[WIDTH];
+        for (unsigned int l = 0; l < WIDTH; ++l)
+        {
+            before[l] = hits[l].t;
+            limit[l] = packet.active & (1u << l) ? hits[l].t : -FLT_MAX;
+        }
+        const __m128 ox = _mm_loadu_ps(packet.ox), oy = _mm_loadu_ps(packet.oy), oz = _mm_loadu_ps(packet.oz);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 ix = _mm_div_ps(one, _mm_loadu_ps(packet.dx));
+        const __m128 iy = _mm_div_ps(one, _mm_loadu_ps(packet.dy));
+        const __m128 iz = _mm_div_ps(one, _mm_loadu_ps(packet.dz));
+        // children are ordered by the first active ray
+        unsigned int lead = 0;
+        while (!(packet.active & (1u << lead)))
+            ++lead;
+        const glm::vec3 leadDir = packet.direction(lead);
+        unsigned int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const unsigned int index = stack[--top];
+            const Node &node = nodes[index];
+            const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.x), ox), ix);
+            const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.x), ox), ix);
+            const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.y), oy), iy);
+            const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.y), oy), iy);
+            const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMin.z), oz), iz);
+            const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.boundsMax.z), oz), iz);
+            __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)), _mm_max_ps(_mm_min_ps(t0z, t1z), _mm_setzero_ps()));
+            __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)), _mm_max_ps(t0z, t1z));
+            tFar = _mm_min_ps(tFar, _mm_loadu_ps(limit));
+            const unsigned int entered = (unsigned int)_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) & packet.active;
+            if (!entered)
+                continue;
+            if (node.isLeaf())
+            {
+                for (unsigned int l = 0; l < WIDTH; ++l)
+                {
+                    if (!(entered & (1u << l)))
+                        continue;
+                    const glm::vec3 origin = packet.origin(l), dir = packet.direction(l);
+                    for (unsigned int b = node.index; b < node.index + node.blockCount(); ++b)
+                        intersectBlock(blocks[b], origin, dir, hits[l]);
+                    limit[l] = hits[l].t;
+                }
+                continue;
+            }
+            const bool rightFirst = leadDir[node.axis()] < 0.0f;
+            stack[top++] = rightFirst ? index + 1 : node.index;
+            stack[top++] = rightFirst ? node.index : index + 1;
+        }
+        for (unsigned int l = 0; l < WIDTH; ++l)
+            if (hits[l].t < before[l])
+                updated |= 1u << l;
+#else
+        for (unsigned int l = 0; l < WIDTH; ++l)
+            if ((packet.active & (1u << l)) && raycast(packet.origin(l), packet.direction(l), hits[l]))
+                updated |= 1u << l;
+#endif
+        return updated;
+    }
+
+    // words of a node, of a block and of a block's shading normals as appendTo() writes them
+    static const unsigned int NODE_WORDS = 8;
+    static const unsigned int BLOCK_WORDS = 40;
+    static const unsigned int NORMAL_WORDS = 3 * WIDTH;
+
+    // appends the tree as stored to flat arrays shared by several trees, for a traversal elsewhere (the GPU's,
+    // GpuSceneBvh): a node is its bounds minimum, index, bounds maximum and meta, a block its v0, e1 and e2
+    // lanes and then its triangle indices, with the right children and first blocks offset by what the arrays
+    // already held. Per block, `normalWords` gets the packed normals of vertex 0, 1 and 2 of each lane (lane
+    // minor; zeros without hasShadingNormals()), so a block index addresses both. Returns the root's node
+    // index (its first word / NODE_WORDS).
+    uint32_t appendTo(std::vector<uint32_t> &nodeWords, std::vector<uint32_t> &blockWords, std::vector<uint32_t> &normalWords) const
+    {
+        static_assert(sizeof(Node) == NODE_WORDS * 4 && sizeof(Block) == BLOCK_WORDS * 4, "appendTo() copies nodes and blocks as words");
+        const uint32_t nodeBase = (uint32_t)(nodeWords.size() / NODE_WORDS);
+        const uint32_t blockBase = (uint32_t)(blockWords.size() / BLOCK_WORDS);
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            Node node = nodes[i];
+            node.index += node.isLeaf() ? blockBase : nodeBase;
+            const uint32_t *words = (const uint32_t *)&node;
+            nodeWords.insert(nodeWords.end(), words, words + NODE_WORDS);
+        }
+        if (!blocks.empty())
+        {
+            const uint32_t *words = (const uint32_t *)&blocks[0];
+            blockWords.insert(blockWords.end(), words, words + blocks.size() * BLOCK_WORDS);
+        }
+        if (normals.empty())
+            normalWords.resize(normalWords.size() + blocks.size() * NORMAL_WORDS, 0u);
+        else
+            normalWords.insert(normalWords.end(), normals.begin(), normals.end());
+        return nodeBase;
+    }
+
+private:
+    // traversal depth is bounded by the build: SAH splits down to MAX_SAH_DEPTH, median splits below
+    static const unsigned int MAX_SAH_DEPTH = 64;
+    static const int STACK_SIZE = 128;
+
+    struct Node
+    {
+        glm::vec3 boundsMin;
+        // leaf: first block; interior: right child
+        uint32_t index;
+        glm::vec3 boundsMax;
+        // leaf: triangle count << 2 | 3; interior: split axis
+        uint32_t meta;
+
+        bool isLeaf() const { return (meta & 3u) == 3u; }
+        int axis() const { return (int)(meta & 3u); }
+        unsigned int blockCount() const { return ((meta >> 2) + WIDTH - 1) / WIDTH; }
+    };
+
+    // WIDTH triangles as SoA lanes: first vertex, edges to the second and third, and their triangle index
+    struct Block
+    {
+        float v0[3][WIDTH];
+        float e1[3][WIDTH];
+        float e2[3][WIDTH];
+        uint32_t triangle[WIDTH];
+    };
+
+    struct BuildTriangle
+    {
+        glm::vec3 v[3];
+        glm::vec3 boundsMin, boundsMax, centroid;
+        unsigned int index;
+        uint32_t normal[3];
+    };
+
+    struct Bin
+    {
+        glm::vec3 boundsMin = glm::vec3(FLT_MAX), boundsMax = glm::vec3(-FLT_MAX);
+        unsigned int count = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Block> blocks;
+    // NORMAL_WORDS per block when built with normals, else empty
+    std::vector<uint32_t> normals;
+    bool keepNormals = false;
+    size_t triangles = 0;
+
+    static float halfArea(const glm::vec3 &bmin, const glm::vec3 &bmax)
+    {
+        const glm::vec3 e = glm::max(bmax - bmin, glm::vec3(0.0f));
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    static unsigned int blocksFor(unsigned int count) { return (count + WIDTH - 1) / WIDTH; }
+
+    void buildNode(const std::vector<BuildTriangle> &source, std::vector<unsigned int> &order, unsigned int first, unsigned int count,
+                   unsigned int depth)
+    {
+        const unsigned int index = (unsigned int)nodes.size();
+        nodes.push_back(Node());
+        glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX), cmin(FLT_MAX), cmax(-FLT_MAX);
+        for (unsigned int k = first; k < first + count; ++k)
+        {
+            const BuildTriangle &t = source[order[k]];
+            bmin = glm::min(bmin, t.boundsMin);
+            bmax = glm::max(bmax, t.boundsMax);
+            cmin = glm::min(cmin, t.centroid);
+            cmax = glm::max(cmax, t.centroid);
+        }
+        nodes[index].boundsMin = bmin;
+        nodes[index].boundsMax = bmax;
+        if (count <= WIDTH)
+        {
+            makeLeaf(source, order, first, count, index);
+            return;
+        }
+
+        // binned SAH over the centroids; the cost of a side is its area times the blocks it needs
+        const glm::vec3 extent = cmax - cmin;
+        int bestAxis = -1;
+        unsigned int bestSplit = 0;
+        float bestCost = FLT_MAX;
+        if (depth < MAX_SAH_DEPTH)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (!(extent[axis] > 0.0f))
+                    continue;
+                Bin bins[BINS];
+                const float scale = (float)BINS / extent[axis];
+                for (unsigned int k = first; k < first + count; ++k)
+                {
+                    const BuildTriangle &t = source[order[k]];
+                    Bin &bin = bins[binOf(t.centroid[axis], cmin[axis], scale)];
+                    bin.boundsMin = glm::min(bin.boundsMin, t.boundsMin);
+                    bin.boundsMax = glm::max(bin.boundsMax, t.boundsMax);
+                    ++bin.count;
+                }
+                // right-to-left sweep first, then evaluate each plane on the way left to right
+                float rightCost[BINS];
+                glm::vec3 rmin(FLT_MAX), rmax(-FLT_MAX);
+                unsigned int rcount = 0;
+                for (unsigned int b = BINS - 1; b > 0; --b)
+                {
+                    rmin = glm::min(rmin, bins[b].boundsMin);
+                    rmax = glm::max(rmax, bins[b].boundsMax);
+                    rcount += bins[b].count;
+                    rightCost[b] = rcount ? halfArea(rmin, rmax) * (float)blocksFor(rcount) : 0.0f;
+                }
+                glm::vec3 lmin(FLT_MAX), lmax(-FLT_MAX);
+                unsigned int lcount = 0;
+                for (unsigned int b = 0; b + 1 < BINS; ++b)
+                {
+                    lmin = glm::min(lmin, bins[b].boundsMin);
+                    lmax = glm::max(lmax, bins[b].boundsMax);
+                    lcount += bins[b].count;
+                    if (lcount == 0 || lcount == count)
+                        continue;
+                    const float cost = halfArea(lmin, lmax) * (float)blocksFor(lcount) + rightCost[b + 1];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = b + 1;
+                    }
+                }
+            }
+            // a node visit costs about as much as a block test
+            const float area = halfArea(bmin, bmax);
+            const float leafCost = area * (float)blocksFor(count);
+            if (count <= MAX_LEAF_TRIANGLES && (bestAxis < 0 || leafCost <= area + bestCost))
+            {
+                makeLeaf(source, order, first, count, index);
+                return;
+            }
+        }
+
+        unsigned int half;
+        int axis;
+        if (bestAxis >= 0)
+        {
+            axis = bestAxis;
+            const float scale = (float)BINS / extent[axis];
+            const float base = cmin[axis];
+            unsigned int *mid = std::partition(&order[first], &order[first] + count, [&](unsigned int t) {
+                return binOf(source[t].centroid[axis], base, scale) < bestSplit;
+            });
+            half = (unsigned int)(mid - &order[first]);
+        }
+        else
+        {
+            // no usable plane (all centroids on one point) or past the SAH depth: median along the widest axis
+            axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            half = count / 2;
+            std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                             [&](unsigned int a, unsigned int b) { return source[a].centroid[axis] < source[b].centroid[axis]; });
+        }
+        nodes[index].meta = (uint32_t)axis;
+        buildNode(source, order, first, half, depth + 1);
+        nodes[index].index = (uint32_t)nodes.size();
+        buildNode(source, order, first + half, count - half, depth + 1);
+    }
+
+    static unsigned int binOf(float centroid, float base, float scale)
+    {
+        const int b = (int)((centroid - base) * scale);
+        return (unsigned int)std::min(std::max(b, 0), (int)BINS - 1);
+    }
+
+    void makeLeaf(const std::vector<BuildTriangle> &source, const std::vector<unsigned int> &order, unsigned int first, unsigned int count,
+                  unsigned int index)
+    {
+        nodes[index].index = (uint32_t)blocks.size();
+        nodes[index].meta = (uint32_t)(count << 2) | 3u;
+        for (unsigned int k = 0; k < count; k += WIDTH)
+        {
+            Block block;
+            std::memset(&block, 0, sizeof(block));
+            uint32_t blockNormals[NORMAL_WORDS] = {};
+            for (unsigned int l = 0; l < WIDTH; ++l)
+            {
+                block.triangle[l] = NO_TRIANGLE;
+                if (k + l >= count)
+                    continue;
+                const BuildTriangle &t = source[order[first + k + l]];
+                const glm::vec3 e1 = t.v[1] - t.v[0], e2 = t.v[2] - t.v[0];
+                for (int c = 0; c < 3; ++c)
+                {
+                    block.v0[c][l] = t.v[0][c];
+                    block.e1[c][l] = e1[c];
+                    block.e2[c][l] = e2[c];
+                }
+                block.triangle[l] = t.index;
+                for (int v = 0; v < 3; ++v)
+                    blockNormals[v * WIDTH + l] = t.normal[v];
+            }
+            blocks.push_back(block);
+            if (keepNormals)
+                normals.insert(normals.end(), blockNormals, blockNormals + NORMAL_WORDS);
+        }
+    }
+
+    // slab test against the hit so far; tEnter is clamped to 0 when the origin lies inside the box
+    static bool rayBox(const glm::vec3 &origin, const glm::vec3 &invDir, const glm::vec3 &boxMin, const glm::vec3 &boxMax, float tMax)
+    {
+        const glm::vec3 t0 = (boxMin - origin) * invDir;
+        const glm::vec3 t1 = (boxMax - origin) * invDir;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+        const float tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float tExit = std::min(std::min(std::min(tFar.x, tFar.y), tFar.z), tMax);
+        return tEnter <= tExit;
+    }
+
+    // Moller-Trumbore against the WIDTH triangles of a block (both windings), keeping the nearest in `hit`
+    static void intersectBlock(const Block &block, const glm::vec3 &origin, const glm::vec3 &dir, Hit &hit)
+    {
+        int lane = -1;
+#if defined(GEOMETRY_KERNELS_SSE2)
+        const __m128 e1x = _mm_loadu_ps(block.e1[0]), e1y = _mm_loadu_ps(block.e1[1]), e1z = _mm_loadu_ps(block.e1[2]);
+        const __m128 e2x = _mm_loadu_ps(block.e2[0]), e2y = _mm_loadu_ps(block.e2[1]), e2z = _mm_loadu_ps(block.e2[2]);
+        const __m128 dx = _mm_set1_ps(dir.x), dy = _mm_set1_ps(dir.y), dz = _mm_set1_ps(dir.z);
+        // p = dir x e2, det = e1 . p
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+        const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+        // s = origin - v0, u = (s . p) / det
+        const __m128 sx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_loadu_ps(block.v0[0]));
+        const __m128 sy = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_loadu_ps(block.v0[1]));
+        const __m128 sz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_loadu_ps(block.v0[2]));
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+        // q = s x e1, v = (dir . q) / det, t = (e2 . q) / det
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+        const __m128 zero = _mm_setzero_ps();
+        __m128 mask = _mm_cmpgt_ps(absDet, _mm_set1_ps(1e-12f));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+        mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+        mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+        mask = _mm_and_ps(mask, _mm_cmpgt_ps(t, zero));
+        mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(hit.t)));
+        const int bits = _mm_movemask_ps(mask);
+        if (!bits)
+            return;
+        float ts[WIDTH], us[WIDTH], vs[WIDTH];
+        _mm_storeu_ps(ts, t);
+        _mm_storeu_ps(us, u);
+        _mm_storeu_ps(vs, v);
+        for (unsigned int l = 0; l < WIDTH; ++l)
+            if ((bits & (1 << l)) && ts[l] < hit.t)
+            {
+                hit.t = ts[l];
+                hit.u = us[l];
+                hit.v = vs[l];
+                lane = (int)l;
+            }
+#else
+        for (unsigned int l = 0; l < WIDTH; ++l)
+        {
+            const glm::vec3 e1(block.e1[0][l], block.e1[1][l], block.e1[2][l]);
+            const glm::vec3 e2(block.e2[0][l], block.e2[1][l], block.e2[2][l]);
+            const glm::vec3 p = glm::cross(dir, e2);
+            const float det = glm::dot(e1, p);
+            if (!(std::fabs(det) > 1e-12f))
+                continue;
+            const float invDet = 1.0f / det;
+            const glm::vec3 s = origin - glm::vec3(block.v0[0][l], block.v0[1][l], block.v0[2][l]);
+            const float u = glm::dot(s, p) * invDet;
+            const glm::vec3 q = glm::cross(s, e1);
+            const float v = glm::dot(dir, q) * invDet;
+            const float t = glm::dot(e2, q) * invDet;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f && t < hit.t)
+            {
+                hit.t = t;
+                hit.u = u;
+                hit.v = v;
+                lane = (int)l;
+            }
+        }
+#endif
+        if (lane < 0)
+            return;
+        hit.triangle = block.triangle[lane];
+        const glm::vec3 e1(block.e1[0][lane], block.e1[1][lane], block.e1[2][lane]);
+        const glm::vec3 e2(block.e2[0][lane], block.e2[1][lane], block.e2[2][lane]);
+        hit.normal = glm::normalize(glm::cross(e1, e2));
+    }
+};
+
+#endif
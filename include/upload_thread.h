@@ -0,0 +1,375 @@
+#ifndef UPLOAD_THREAD_H
+#define UPLOAD_THREAD_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <stb_image.h>
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <gl_backend.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <startup_timings.h>
+#include <mip_chain.h>
+#include <texture_cache.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// what defineTextureImage() allocated, for GpuMemory
+struct TextureDefinition
+{
+    GLenum internalFormat = GL_RGBA8;
+    int width = 1, height = 1;
+    bool mipmapped = false;
+};
+
+// immutable texture storage is core from GL 4.2; on the 3.3 context textures are defined level by level
+inline bool textureStorageSupported()
+{
+    return GLAD_GL_VERSION_4_2 && glTexStorage2D != NULL;
+}
+
+// the sized internal format glTexStorage2D needs for one of imageFormats()' formats
+inline GLenum sizedImageFormat(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_RED: return GL_R8;
+    case GL_RGB: return GL_RGB8;
+    case GL_RGBA: return GL_RGBA8;
+    case GL_SRGB: return GL_SRGB8;
+    case GL_SRGB_ALPHA: return GL_SRGB8_ALPHA8;
+    default: return internalFormat;
+    }
+}
+
+// any context: fills `texture` from `img` (mip chain, repeat, trilinear); by name with direct state access
+// (GlBackend), otherwise it has to be the one bound to GL_TEXTURE_2D. The
+// storage is allocated once for every level (glTexStorage2D where supported) and each level of the CPU-built
+// chain (buildMipChain) is uploaded into it; an image without one falls back to glGenerateMipmap. With
+// `unpackBuffer` the whole chain is staged through that buffer (orphaned and mapped for each image), so the
+// driver copies from memory it owns instead of blocking on the caller's. A solid-colour image becomes a
+// single texel. The pixels stay with the caller.
+inline TextureDefinition defineTextureImage(GLuint texture, const DecodedImage &img, bool gamma, GLuint unpackBuffer, const std::string &name)
+{
+    GLenum format, internalFormat;
+    imageFormats(img.components, gamma, format, internalFormat);
+    const bool direct = glBackend().dsa();
+    const bool storage = direct || textureStorageSupported();
+    if (storage)
+        internalFormat = sizedImageFormat(internalFormat);
+    TextureDefinition def;
+    def.internalFormat = internalFormat;
+    // rows of 1/2/3-channel images aren't 4-byte aligned in general
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // a solid-colour image samples the same at every size: store a single texel instead of a mip chain
+    unsigned char texel[4];
+    if (img.levels <= 1 && img.width * img.height > 1 && constantImage(img, texel))
+    {
+        LOG_DEBUG("[TextureFromFile] '" << name << "' is a solid colour, uploading 1x1");
+        if (direct)
+        {
+            glTextureStorage2D(texture, 1, internalFormat, 1, 1);
+            glTextureSubImage2D(texture, 0, 0, 0, 1, 1, format, GL_UNSIGNED_BYTE, texel);
+        }
+        else if (storage)
+        {
+            glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, 1, 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, format, GL_UNSIGNED_BYTE, texel);
+        }
+        else
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, 1, 1, 0, format, GL_UNSIGNED_BYTE, texel);
+    }
+    else
+    {
+        const uint32_t levels = (uint32_t)std::max(1, img.levels);
+        size_t size = 0;
+        for (uint32_t l = 0; l < levels; ++l)
+            size += decodedLevelBytes(img, (int)l);
+        void *staged = NULL;
+        if (unpackBuffer)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpackBuffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, NULL, GL_STREAM_DRAW);
+            staged = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (staged)
+            {
+                std::memcpy(staged, img.pixels, size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            else
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        // a transcoded KTX2 image brings its own block format and levels, which may stop short of 1x1
+        const GLenum compressed = img.compressedFormat;
+        if (compressed)
+            def.internalFormat = compressed;
+        const GLsizei storageLevels = compressed ? (GLsizei)levels : (GLsizei)MipChain::levelCount((uint32_t)img.width, (uint32_t)img.height);
+        if (direct)
+            glTextureStorage2D(texture, storageLevels, def.internalFormat, img.width, img.height);
+        else if (storage)
+            glTexStorage2D(GL_TEXTURE_2D, storageLevels, def.internalFormat, img.width, img.height);
+        // staged: the pointers are offsets into the unpack buffer
+        size_t offset = 0;
+        GLsizei w = img.width, h = img.height;
+        for (uint32_t l = 0; l < levels; ++l)
+        {
+            const void *data = staged ? (const void *)(uintptr_t)offset : (const void *)(img.pixels + offset);
+            const size_t bytes = decodedLevelBytes(img, (int)l);
+            if (compressed && direct)
+                glCompressedTextureSubImage2D(texture, (GLint)l, 0, 0, w, h, compressed, (GLsizei)bytes, data);
+            else if (direct)
+                glTextureSubImage2D(texture, (GLint)l, 0, 0, w, h, format, GL_UNSIGNED_BYTE, data);
+            else if (compressed && storage)
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, (GLint)l, 0, 0, w, h, compressed, (GLsizei)bytes, data);
+            else if (compressed)
+                glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)l, compressed, w, h, 0, (GLsizei)bytes, data);
+            else if (storage)
+                glTexSubImage2D(GL_TEXTURE_2D, (GLint)l, 0, 0, w, h, format, GL_UNSIGNED_BYTE, data);
+            else
+                glTexImage2D(GL_TEXTURE_2D, (GLint)l, internalFormat, w, h, 0, format, GL_UNSIGNED_BYTE, data);
+            offset += bytes;
+            w = std::max(1, w / 2);
+            h = std::max(1, h / 2);
+        }
+        if (staged)
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        // a compressed chain ends where the file's does; with no CPU chain (TextureFromFile, or the chain's
+        // allocation failed) the driver builds one
+        if (compressed && direct)
+            glTextureParameteri(texture, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+        else if (compressed)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+        else if (levels == 1 && direct)
+            glGenerateTextureMipmap(texture);
+        else if (levels == 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+        def.width = img.width;
+        def.height = img.height;
+        def.mipmapped = !compressed || levels > 1;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // an uncompressed two-channel image is gray+alpha (RG8): gray to RGB, the second channel to alpha
+    if (img.components == 2 && !img.compressedFormat)
+    {
+        const GLint swizzle[4] = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+        if (direct)
+            glTextureParameteriv(texture, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        else
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
+    const GLenum names[4] = {GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER};
+    const GLint values[4] = {GL_REPEAT, GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR};
+    for (int i = 0; i < 4; ++i)
+    {
+        if (direct)
+            glTextureParameteri(texture, names[i], values[i]);
+        else
+            glTexParameteri(GL_TEXTURE_2D, names[i], values[i]);
+    }
+    return def;
+}
+
+// Texture uploads on their own thread and GL context (UPLOAD_THREAD=1), so the texture definitions of a
+// streaming model never land in a frame. The context is a hidden 1x1 window sharing the main context's
+// objects. TextureLoader hands it decoded images for the texture names it made
+// (holding placeholders until then); the thread stages each through a pixel unpack buffer, defines the
+// texture with its mip chain and sets a fence. The GL thread keeps drawing the placeholder until collect()
+// sees the fence signalled, then marks the texture uploaded and drops its cached bindings: GL makes
+// another context's changes visible to a context once it has waited on them and binds the object anew.
+// Geometry stays on the GL thread: vertex arrays aren't shared between contexts, and a model's buffers
+// go up in a single call per buffer already.
+class UploadThread
+{
+public:
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("UPLOAD_THREAD");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    UploadThread() {}
+    UploadThread(const UploadThread &) = delete;
+    UploadThread &operator=(const UploadThread &) = delete;
+
+    // main thread, with `share` created and its context current (GLFW makes windows on the main thread
+    // only): creates the upload context with the context hints still set for `share` and starts the thread
+    bool start(GLFWwindow *share)
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        context = glfwCreateWindow(1, 1, "upload", NULL, share);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        if (!context)
+        {
+            LOG_WARN("[Upload] No shared context, uploading on the GL thread");
+            return false;
+        }
+        worker = std::thread(&UploadThread::run, this);
+        LOG_INFO("[Upload] Textures upload on a shared context");
+        return true;
+    }
+
+    bool running() const { return context != NULL; }
+
+    // GL thread: queues `image` for `entry` (whose texture name exists); the upload thread frees the pixels
+    void submit(const std::shared_ptr<CachedTexture> &entry, const DecodedImage &image)
+    {
+        entry->uploading = true;
+        ++outstanding;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requests.push_back(Request{entry, image});
+        }
+        wake.notify_one();
+    }
+
+    // GL thread, every frame: completes the uploads whose fence has signalled
+    void collect() { complete(false); }
+
+    // GL thread: blocks until everything submitted is complete
+    void finish()
+    {
+        while (outstanding > 0)
+        {
+            complete(true);
+            if (outstanding > 0)
+                std::this_thread::yield();
+        }
+    }
+
+    // main thread, with a context current: completes what's queued, then ends the thread and its context
+    void stop()
+    {
+        if (!context)
+            return;
+        finish();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        glfwDestroyWindow(context);
+        context = NULL;
+    }
+
+private:
+    struct Request
+    {
+        std::shared_ptr<CachedTexture> entry;
+        DecodedImage image;
+    };
+
+    struct Result
+    {
+        std::shared_ptr<CachedTexture> entry;
+        GLsync fence;
+        TextureDefinition def;
+    };
+
+    GLFWwindow *context = NULL;
+    std::thread worker;
+    size_t outstanding = 0; // GL thread only
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Request> requests;
+    std::vector<Result> finished;
+    bool stopping = false;
+
+    void run()
+    {
+        glfwMakeContextCurrent(context);
+        frameTrace().nameThread("upload thread");
+        GLuint staging = 0;
+        glGenBuffers(1, &staging);
+        for (;;)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this]() { return stopping || !requests.empty(); });
+                if (requests.empty())
+                    break;
+                request = requests.front();
+                requests.pop_front();
+            }
+            Result result;
+            {
+                FrameTrace::Scope trace("upload texture", request.entry->path);
+                StartupTimings::Scope startup("textures");
+                // this context has no glState(): bind directly, unless the definition goes by name
+                if (!glBackend().dsa())
+                    glBindTexture(GL_TEXTURE_2D, request.entry->id);
+                result.def = defineTextureImage(request.entry->id, request.image, request.entry->gamma, staging, request.entry->path);
+                if (!glBackend().dsa())
+                    glBindTexture(GL_TEXTURE_2D, 0);
+                result.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                // the fence has to reach the GPU for the GL thread to see it signal
+                glFlush();
+            }
+            stbi_image_free(request.image.pixels);
+            result.entry = request.entry;
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(result);
+        }
+        glDeleteBuffers(1, &staging);
+        glfwMakeContextCurrent(NULL);
+    }
+
+    // hands over finished uploads; `wait` blocks on their fences instead of skipping unsignalled ones
+    void complete(bool wait)
+    {
+        std::vector<Result> done;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.swap(finished);
+        }
+        std::vector<Result> later;
+        bool any = false;
+        for (size_t i = 0; i < done.size(); ++i)
+        {
+            Result &r = done[i];
+            const GLenum status = glClientWaitSync(r.fence, 0, wait ? 1000000000ull : 0);
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                later.push_back(r);
+                continue;
+            }
+            glDeleteSync(r.fence);
+            if (r.entry->id)
+                gpuMemory().trackTexture(r.entry->id, GpuMemory::MODEL_TEXTURES, r.def.internalFormat, r.def.width, r.def.height, 1, r.def.mipmapped, r.entry->path);
+            r.entry->uploading = false;
+            r.entry->uploaded = true;
+            --outstanding;
+            any = true;
+        }
+        if (!later.empty())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.insert(finished.begin(), later.begin(), later.end());
+        }
+        // the next bind of each texture is a real glBindTexture, which picks up the upload context's data
+        if (any)
+            glState().invalidate();
+    }
+};
+
+inline UploadThread &uploadThread()
+{
+    static UploadThread thread;
+    return thread;
+}
+
+#endif
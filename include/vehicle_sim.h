@@ -0,0 +1,476 @@
+#ifndef VEHICLE_SIM_H
+#define VEHICLE_SIM_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <frame_trace.h>
+#include <frustum.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Fixed-timestep vehicle physics (VEHICLE_SIM=1): the movable car and AI_CARS (default 12) AI cars as rigid
+// boxes on four raycast wheels, stepped at VEHICLE_HZ (default 120) on the input thread, apart from the
+// frame rate. Each step casts every wheel of every car down its strut in one batch spread over the job
+// system (parallelFor), against the static scene: a BVH over the fixed placements' world boxes, as the
+// renderer's scene tree has them, and the ground plane the player's car stood on. A second batch then
+// integrates the cars one per item: spring-damper suspension along the strut, a simplified magic-formula
+// tire (lateral force from the slip angle, drive and brake along the wheel, both inside the friction
+// circle of the wheel's load), and a rear-wheel-drive drivetrain with an engine torque curve and an
+// automatic gearbox (holding the brake at a standstill reverses). poses() interpolates between the last
+// two steps, so the cars move smoothly at any frame rate, and a frame that falls far behind drops steps
+// rather than spiral.
+//
+// The cars collide with the scene through their wheels only: no body contacts, and none between cars. The
+// AI ones drive laps around the scene at speeds of their own.
+class VehicleSim
+{
+public:
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("VEHICLE_SIM");
+        return env && std::strcmp(env, "1") == 0;
+    }
+
+    // the static scene the wheels stand on
+    struct World
+    {
+        float groundHeight = 0.0f;
+        // world boxes of the fixed placements, and the tree over them
+        BoundsBatch boxes;
+        BVH tree;
+    };
+
+    // one car's pedals and wheel: throttle and brake 0..1, steer -1 (left) .. 1 (right)
+    struct Controls
+    {
+        float throttle = 0.0f;
+        float brake = 0.0f;
+        float steer = 0.0f;
+    };
+
+    VehicleSim()
+    {
+        const char *hz = std::getenv("VEHICLE_HZ");
+        step = 1.0f / std::min(std::max(hz ? (float)std::atof(hz) : 120.0f, 30.0f), 1000.0f);
+        const char *ai = std::getenv("AI_CARS");
+        aiCars = std::min(std::max(ai ? std::atoi(ai) : 12, 0), 256);
+    }
+
+    VehicleSim(const VehicleSim &) = delete;
+    VehicleSim &operator=(const VehicleSim &) = delete;
+
+    // any thread (the renderer, once the scene is placed): (re)starts the simulation on `world` with the
+    // player's car at `spawn` (body frame: origin at the centre of its box, +z forward, +y up) and box half
+    // extents `halfExtents` in that frame, plus AI_CARS more of the same size on a loop around the scene.
+    // The input thread picks it up at its next update().
+    void start(const std::shared_ptr<const World> &world, const glm::mat4 &spawn, const glm::vec3 &halfExtents)
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending.reset(new Start());
+        pending->world = world;
+        pending->spawn = spawn;
+        pending->halfExtents = halfExtents;
+    }
+
+    // input thread from here on
+    bool running() const { return !vehicles.empty(); }
+    size_t size() const { return vehicles.size(); }
+
+    // puts the player's car back where it started, at rest
+    void resetPlayer()
+    {
+        if (running())
+            place(vehicles[0], spawnPosition, spawnOrientation);
+    }
+
+    // steps the simulation up to `deltaTime` later, the player's car driven by `player`
+    void update(float deltaTime, const Controls &player)
+    {
+        takePending();
+        if (!running())
+            return;
+        vehicles[0].target = player;
+        // a frame that took longer than this (a load, a breakpoint) doesn't have to be caught up
+        accumulator += std::min(deltaTime, 0.25f);
+        int steps = 0;
+        while (accumulator >= step && steps < MAX_STEPS_PER_UPDATE)
+        {
+            stepAll();
+            accumulator -= step;
+            ++steps;
+        }
+        if (steps == MAX_STEPS_PER_UPDATE)
+            accumulator = std::min(accumulator, step);
+    }
+
+    // body frames of the cars (the player's first) between the last two steps, for the renderer
+    void poses(std::vector<glm::mat4> &out) const
+    {
+        out.resize(vehicles.size());
+        const float alpha = step > 0.0f ? glm::clamp(accumulator / step, 0.0f, 1.0f) : 1.0f;
+        for (size_t i = 0; i < vehicles.size(); ++i)
+        {
+            const Vehicle &v = vehicles[i];
+            glm::mat4 m = glm::mat4_cast(glm::slerp(v.previousOrientation, v.orientation, alpha));
+            m[3] = glm::vec4(glm::mix(v.previousPosition, v.position, alpha), 1.0f);
+            out[i] = m;
+        }
+    }
+
+private:
+    static const int WHEELS = 4;
+    // steps one update() runs at most before it lets the simulation fall behind
+    static const int MAX_STEPS_PER_UPDATE = 8;
+
+    struct Start
+    {
+        std::shared_ptr<const World> world;
+        glm::mat4 spawn;
+        glm::vec3 halfExtents;
+    };
+
+    // shared by every car (they all take the player's size)
+    struct Params
+    {
+        float mass = 1500.0f;
+        glm::vec3 inverseInertia = glm::vec3(1.0f); // body axes
+        glm::vec3 mounts[WHEELS];                   // strut tops, body space (front left, front right, rear left, rear right)
+        float wheelRadius = 0.33f;
+        float restLength = 0.3f;                    // strut travel
+        float stiffness = 0.0f, damping = 0.0f;
+        float maxSteer = 0.6f;                      // radians at standstill
+        float grip = 1.0f;                          // friction coefficient
+        float maxBrakeForce = 12000.0f;             // per wheel
+    };
+
+    struct Vehicle
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 velocity = glm::vec3(0.0f);
+        glm::vec3 angularVelocity = glm::vec3(0.0f);
+        glm::vec3 previousPosition = glm::vec3(0.0f);
+        glm::quat previousOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        // what the driver asks for, and the controls as they follow it
+        Controls target, controls;
+        float compression[WHEELS] = {0.0f, 0.0f, 0.0f, 0.0f};
+        int gear = 0;
+        float rpm = 0.0f;
+        // AI drivers: the loop's radius they keep to and their cruising speed (m/s); the player has none
+        bool ai = false;
+        float laneRadius = 0.0f;
+        float cruise = 0.0f;
+    };
+
+    // one wheel's ray result: distance down the strut (FLT_MAX = in the air) and the surface normal
+    struct WheelHit
+    {
+        float t = FLT_MAX;
+        glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    };
+
+    float step = 1.0f / 120.0f;
+    float accumulator = 0.0f;
+    int aiCars = 12;
+    Params params;
+    std::vector<Vehicle> vehicles;
+    std::vector<WheelHit> hits; // WHEELS per car, reused across steps
+    std::shared_ptr<const World> world;
+    glm::vec3 spawnPosition = glm::vec3(0.0f);
+    glm::quat spawnOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec2 trackCenter = glm::vec2(0.0f);
+
+    std::mutex pendingMutex;
+    std::unique_ptr<Start> pending;
+
+    // drivetrain: gear ratios, final drive, engine torque peak (Nm) and its rpm range
+    static float gearRatio(int gear)
+    {
+        static const float ratios[] = {3.5f, 2.2f, 1.5f, 1.15f, 0.9f, 0.75f};
+        return ratios[gear];
+    }
+    static const int GEARS = 6;
+    static float finalDrive() { return 3.6f; }
+    static float idleRpm() { return 900.0f; }
+    static float redlineRpm() { return 6500.0f; }
+    static float engineTorque(float rpm)
+    {
+        // flat-topped curve: full torque around 4000 rpm, falling off towards idle and the redline, where
+        // the limiter cuts it (the top speed)
+        if (rpm >= redlineRpm())
+            return 0.0f;
+        const float x = glm::clamp((rpm - 4000.0f) / (redlineRpm() - idleRpm()), -1.0f, 1.0f);
+        return 450.0f * (1.0f - 0.6f * x * x);
+    }
+
+    void takePending()
+    {
+        std::unique_ptr<Start> start;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            start.swap(pending);
+        }
+        if (!start)
+            return;
+        world = start->world;
+        setUp(start->halfExtents);
+        spawnPosition = glm::vec3(start->spawn[3]);
+        spawnOrientation = glm::normalize(glm::quat_cast(glm::mat3(start->spawn)));
+        vehicles.assign(1 + (size_t)aiCars, Vehicle());
+        place(vehicles[0], spawnPosition, spawnOrientation);
+        spawnTraffic(start->halfExtents);
+        hits.assign(vehicles.size() * WHEELS, WheelHit());
+        accumulator = 0.0f;
+        LOG_INFO("[VehicleSim] " << vehicles.size() << " cars at " << (int)std::lround(1.0f / step) << " Hz ("
+                 << aiCars << " AI), " << (world ? world->boxes.size() : 0) << " static boxes");
+    }
+
+    void setUp(const glm::vec3 &h)
+    {
+        Params &p = params;
+        p.inverseInertia = 3.0f / (p.mass * glm::vec3(h.y * h.y + h.z * h.z, h.x * h.x + h.z * h.z, h.x * h.x + h.y * h.y));
+        p.wheelRadius = 0.45f * h.y;
+        p.restLength = 0.4f * h.y;
+        // half the travel used at rest, so the body's bottom settles on the ground
+        p.stiffness = p.mass * 9.81f / (WHEELS * 0.5f * p.restLength);
+        p.damping = 2.0f * 0.35f * std::sqrt(p.stiffness * p.mass / WHEELS);
+        const float mountY = -h.y + p.wheelRadius + 0.5f * p.restLength;
+        p.mounts[0] = glm::vec3(0.8f * h.x, mountY, 0.65f * h.z);
+        p.mounts[1] = glm::vec3(-0.8f * h.x, mountY, 0.65f * h.z);
+        p.mounts[2] = glm::vec3(0.8f * h.x, mountY, -0.65f * h.z);
+        p.mounts[3] = glm::vec3(-0.8f * h.x, mountY, -0.65f * h.z);
+    }
+
+    void place(Vehicle &v, const glm::vec3 &position, const glm::quat &orientation) const
+    {
+        v.position = v.previousPosition = position;
+        v.orientation = v.previousOrientation = orientation;
+        v.velocity = v.angularVelocity = glm::vec3(0.0f);
+        v.controls = Controls();
+        v.gear = 0;
+        v.rpm = idleRpm();
+        for (int w = 0; w < WHEELS; ++w)
+            v.compression[w] = 0.5f * params.restLength;
+    }
+
+    // AI cars on two lanes of a loop around everything static, evenly spaced, counter-clockwise
+    void spawnTraffic(const glm::vec3 &h)
+    {
+        glm::vec2 lo(spawnPosition.x, spawnPosition.z), hi = lo;
+        if (world && !world->tree.empty())
+        {
+            lo = glm::min(lo, glm::vec2(world->tree.boundsMin().x, world->tree.boundsMin().z));
+            hi = glm::max(hi, glm::vec2(world->tree.boundsMax().x, world->tree.boundsMax().z));
+        }
+        trackCenter = (lo + hi) * 0.5f;
+        const float radius = glm::length(hi - lo) * 0.5f + 6.0f * h.z;
+        const float height = spawnPosition.y;
+        unsigned int seed = 12345u;
+        for (int k = 0; k < aiCars; ++k)
+        {
+            Vehicle &v = vehicles[1 + k];
+            const float angle = 6.2831853f * (float)k / (float)std::max(aiCars, 1);
+            v.ai = true;
+            v.laneRadius = radius + ((k & 1) ? 3.0f * h.x : 0.0f);
+            seed = seed * 1664525u + 1013904223u;
+            v.cruise = 8.0f + 8.0f * (float)(seed >> 8) / 16777216.0f;
+            const glm::vec3 position(trackCenter.x + v.laneRadius * std::cos(angle), height, trackCenter.y + v.laneRadius * std::sin(angle));
+            // body +z along the loop's tangent
+            place(v, position, glm::angleAxis(-angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+    }
+
+    void stepAll()
+    {
+        FrameTrace::Scope trace("vehicle step");
+        for (size_t i = 0; i < vehicles.size(); ++i)
+        {
+            Vehicle &v = vehicles[i];
+            v.previousPosition = v.position;
+            v.previousOrientation = v.orientation;
+            if (v.ai)
+                drive(v);
+        }
+        // every wheel of every car in one batch, then every car
+        ThreadPool &pool = ThreadPool::shared();
+        pool.parallelFor(hits.size(), 64, [this](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k)
+                castWheel(vehicles[k / WHEELS], (int)(k % WHEELS), hits[k]);
+        }, "wheel raycasts");
+        pool.parallelFor(vehicles.size(), 4, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                integrate(vehicles[i], &hits[i * WHEELS]);
+        }, "vehicle dynamics");
+    }
+
+    // AI: pure pursuit of a point ahead on its lane, throttle and brake towards its cruising speed
+    void drive(Vehicle &v) const
+    {
+        const glm::vec2 p = glm::vec2(v.position.x, v.position.z) - trackCenter;
+        const float speed = glm::length(v.velocity);
+        const float ahead = std::atan2(p.y, p.x) + (6.0f + 0.5f * speed) / std::max(v.laneRadius, 1.0f);
+        const glm::vec3 target(trackCenter.x + v.laneRadius * std::cos(ahead), v.position.y,
+                               trackCenter.y + v.laneRadius * std::sin(ahead));
+        const glm::vec3 local = glm::inverse(v.orientation) * (target - v.position);
+        v.target.steer = glm::clamp(-std::atan2(local.x, local.z) / params.maxSteer, -1.0f, 1.0f);
+        v.target.throttle = glm::clamp((v.cruise - speed) * 0.5f, 0.0f, 1.0f);
+        v.target.brake = glm::clamp((speed - v.cruise) * 0.3f, 0.0f, 1.0f);
+    }
+
+    // wheel `w` of `v` down its strut, nearest of the ground plane and the static boxes
+    void castWheel(const Vehicle &v, int w, WheelHit &hit) const
+    {
+        hit = WheelHit();
+        const glm::vec3 origin = v.position + v.orientation * params.mounts[w];
+        const glm::vec3 dir = v.orientation * glm::vec3(0.0f, -1.0f, 0.0f);
+        const float reach = params.restLength + params.wheelRadius;
+        if (!world)
+            return;
+        if (dir.y < -1e-4f)
+        {
+            const float t = (world->groundHeight - origin.y) / dir.y;
+            if (t >= 0.0f && t <= reach)
+            {
+                hit.t = t;
+                hit.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+        }
+        if (world->tree.empty())
+            return;
+        const glm::vec3 invDir = 1.0f / dir;
+        float tTree = 0.0f;
+        world->tree.raycast(origin, dir, tTree, [&](unsigned int i, float) {
+            // the face the ray enters through; a strut starting inside a box doesn't stand on it
+            const glm::vec3 boxMin = world->boxes.boundsMin(i), boxMax = world->boxes.boundsMax(i);
+            const glm::vec3 t0 = (boxMin - origin) * invDir, t1 = (boxMax - origin) * invDir;
+            const glm::vec3 tNear = glm::min(t0, t1);
+            const int axis = tNear.x > tNear.y ? (tNear.x > tNear.z ? 0 : 2) : (tNear.y > tNear.z ? 1 : 2);
+            const float t = tNear[axis];
+            if (t <= 0.0f || t > reach || t >= hit.t)
+                return -1.0f;
+            hit.t = t;
+            hit.normal = glm::vec3(0.0f);
+            hit.normal[axis] = dir[axis] > 0.0f ? -1.0f : 1.0f;
+            return t;
+        });
+    }
+
+    void integrate(Vehicle &v, const WheelHit *wheelHits) const
+    {
+        const Params &p = params;
+        const float dt = step;
+        // the driver's inputs reach the car at a finite rate: pedals in 0.2 s, full lock in 0.4 s
+        v.controls.throttle += glm::clamp(v.target.throttle - v.controls.throttle, -5.0f * dt, 5.0f * dt);
+        v.controls.brake += glm::clamp(v.target.brake - v.controls.brake, -5.0f * dt, 5.0f * dt);
+        v.controls.steer += glm::clamp(v.target.steer - v.controls.steer, -2.5f * dt, 2.5f * dt);
+
+        const glm::mat3 R = glm::mat3_cast(v.orientation);
+        const glm::vec3 up = R[1], forward = R[2];
+        const float forwardSpeed = glm::dot(v.velocity, forward);
+        // less lock at speed; positive steer turns right (towards body -x)
+        const float steerAngle = -v.controls.steer * p.maxSteer / (1.0f + std::fabs(forwardSpeed) / 20.0f);
+
+        // drivetrain: engine speed from the rear wheels, automatic shifts, torque shared by the rear wheels
+        const float wheelRpm = std::fabs(forwardSpeed) / p.wheelRadius * 9.5493f;
+        v.rpm = std::max(idleRpm(), wheelRpm * gearRatio(v.gear) * finalDrive());
+        if (v.rpm > 5800.0f && v.gear + 1 < GEARS)
+            ++v.gear;
+        else if (v.gear > 0 && wheelRpm * gearRatio(v.gear - 1) * finalDrive() < 4200.0f)
+            --v.gear;
+        // the brake held at a standstill (and no throttle) backs up in a reverse ratio of 3.2
+        const bool reversing = v.controls.brake > 0.0f && v.controls.throttle == 0.0f && forwardSpeed < 0.5f;
+        const float reverseRpm = std::max(idleRpm(), wheelRpm * 3.2f * finalDrive());
+        const float driveForce = reversing ? -v.controls.brake * engineTorque(reverseRpm) * 3.2f * finalDrive() * 0.85f / p.wheelRadius
+                                           : v.controls.throttle * engineTorque(v.rpm) * gearRatio(v.gear) * finalDrive() * 0.85f / p.wheelRadius;
+        const float brake = reversing ? 0.0f : v.controls.brake;
+
+        glm::vec3 force(0.0f, -9.81f * p.mass, 0.0f);
+        glm::vec3 torque(0.0f);
+        for (int w = 0; w < WHEELS; ++w)
+        {
+            const WheelHit &hit = wheelHits[w];
+            if (hit.t == FLT_MAX)
+            {
+                v.compression[w] = 0.0f;
+                continue;
+            }
+            const float compression = std::min(p.restLength + p.wheelRadius - hit.t, p.restLength);
+            const float compressionSpeed = (compression - v.compression[w]) / dt;
+            v.compression[w] = compression;
+            const float load = std::max(0.0f, p.stiffness * compression + p.damping * compressionSpeed);
+            const glm::vec3 contact = v.position + R * p.mounts[w] - up * hit.t;
+            const glm::vec3 arm = contact - v.position;
+            const glm::vec3 contactVelocity = v.velocity + glm::cross(v.angularVelocity, arm);
+
+            // the wheel's heading on the surface
+            const bool front = w < 2;
+            glm::vec3 heading = front ? R * glm::vec3(std::sin(steerAngle), 0.0f, std::cos(steerAngle)) : forward;
+            heading -= hit.normal * glm::dot(heading, hit.normal);
+            if (glm::dot(heading, heading) < 1e-8f)
+                continue;
+            heading = glm::normalize(heading);
+            const glm::vec3 side = glm::cross(hit.normal, heading);
+            const float longitudinal = glm::dot(contactVelocity, heading);
+            const float lateral = glm::dot(contactVelocity, side);
+
+            // tire: lateral force from the slip angle (Pacejka's shape, B = 10, C = 1.3); drive and brake
+            // along the wheel; together no more than the grip of its load
+            const float maxForce = p.grip * load;
+            const float slipAngle = std::atan2(lateral, std::max(std::fabs(longitudinal), 0.5f));
+            float fy = -maxForce * std::sin(1.3f * std::atan(10.0f * slipAngle));
+            float fx = front ? 0.0f : 0.5f * driveForce;
+            // brakes stop the wheel, never push it backwards; rolling resistance likewise. ABS keeps them
+            // short of locking, so a braking car still steers.
+            const float stopForce = std::fabs(longitudinal) * p.mass / (WHEELS * dt);
+            const float resist = std::min(brake * std::min(p.maxBrakeForce, 0.9f * maxForce) + 0.015f * load, stopForce);
+            fx -= longitudinal > 0.0f ? resist : -resist;
+            const float total = std::sqrt(fx * fx + fy * fy);
+            if (total > maxForce && total > 0.0f)
+            {
+                fx *= maxForce / total;
+                fy *= maxForce / total;
+            }
+            const glm::vec3 f = up * load + heading * fx + side * fy;
+            force += f;
+            torque += glm::cross(arm, f);
+        }
+        // air drag
+        force -= 0.4f * glm::length(v.velocity) * v.velocity;
+
+        // semi-implicit Euler; the inertia tensor is diagonal in the body's axes
+        v.velocity += force / p.mass * dt;
+        const glm::vec3 bodyTorque = glm::transpose(R) * torque;
+        v.angularVelocity += R * (p.inverseInertia * bodyTorque) * dt;
+        v.angularVelocity *= 1.0f - 0.5f * dt; // a little damping keeps resting cars still
+        v.position += v.velocity * dt;
+        const glm::quat spin(0.0f, v.angularVelocity.x, v.angularVelocity.y, v.angularVelocity.z);
+        v.orientation = glm::normalize(v.orientation + spin * v.orientation * (0.5f * dt));
+
+        // fell off the world (off the loop, through a gap): back where it started
+        if (world && v.position.y < world->groundHeight - 50.0f)
+        {
+            if (v.ai)
+            {
+                const float angle = std::atan2(v.position.z - trackCenter.y, v.position.x - trackCenter.x);
+                place(v, glm::vec3(trackCenter.x + v.laneRadius * std::cos(angle), spawnPosition.y,
+                                   trackCenter.y + v.laneRadius * std::sin(angle)),
+                      glm::angleAxis(-angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+            }
+            else
+                place(v, spawnPosition, spawnOrientation);
+        }
+    }
+};
+
+#endif
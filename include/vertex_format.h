@@ -0,0 +1,81 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <glad/glad.h>
+
+#include <gl_backend.h>
+#include <gl_state.h>
+
+#include <cstddef>
+
+// one attribute of a vertex format: the shader location it feeds and how its bytes sit in the vertex
+struct VertexAttribute
+{
+    GLuint location;
+    GLint size;           // components
+    GLenum type;          // component type in the buffer
+    GLboolean normalized; // fixed-point components read as [0,1] / [-1,1] floats
+    bool integer;         // read as uint/uvecN in the shader (glVertexAttribIPointer), never converted
+    GLuint offset;        // bytes into the vertex
+};
+
+// Vertex formats as types. A format is a struct naming its vertex (Vertex), the vertex buffer binding
+// point it uses on the direct state access path (BINDING), its divisor (DIVISOR: 0 per vertex, 1 per
+// instance) and its attribute table (attributes(), COUNT entries; a constant-initialized static, so the
+// loops below unroll over constants). The formats live next to their structs (mesh.h); a new packed
+// layout is a struct and a table, and every VAO that reads it goes through setup<Format>().
+namespace VertexFormats
+{
+    // the attributes of `Format` in `vao`, reading `buffer` from byte `base`. The bind path leaves `vao`
+    // bound, and `buffer` as the array buffer.
+    template <class Format>
+    void setup(GLuint vao, GLuint buffer, size_t base = 0)
+    {
+        const VertexAttribute *attributes = Format::attributes();
+        const GLsizei stride = (GLsizei)sizeof(typename Format::Vertex);
+        if (glBackend().dsa())
+        {
+            for (int i = 0; i < Format::COUNT; ++i)
+            {
+                const VertexAttribute &a = attributes[i];
+                glEnableVertexArrayAttrib(vao, a.location);
+                if (a.integer)
+                    glVertexArrayAttribIFormat(vao, a.location, a.size, a.type, a.offset);
+                else
+                    glVertexArrayAttribFormat(vao, a.location, a.size, a.type, a.normalized, a.offset);
+                glVertexArrayAttribBinding(vao, a.location, Format::BINDING);
+            }
+            if (Format::DIVISOR != 0)
+                glVertexArrayBindingDivisor(vao, Format::BINDING, Format::DIVISOR);
+            glVertexArrayVertexBuffer(vao, Format::BINDING, buffer, (GLintptr)base, stride);
+            return;
+        }
+        glState().bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        for (int i = 0; i < Format::COUNT; ++i)
+        {
+            const VertexAttribute &a = attributes[i];
+            const void *pointer = (const void *)(base + a.offset);
+            glEnableVertexAttribArray(a.location);
+            if (a.integer)
+                glVertexAttribIPointer(a.location, a.size, a.type, stride, pointer);
+            else
+                glVertexAttribPointer(a.location, a.size, a.type, a.normalized, stride, pointer);
+            if (Format::DIVISOR != 0)
+                glVertexAttribDivisor(a.location, Format::DIVISOR);
+        }
+    }
+
+    // points the attributes of `Format` in `vao` (set up by setup()) at byte `base` of `buffer`: one call
+    // that binds nothing on the direct state access path, every attribute again on the bind path
+    template <class Format>
+    void rebind(GLuint vao, GLuint buffer, size_t base)
+    {
+        if (glBackend().dsa())
+            glVertexArrayVertexBuffer(vao, Format::BINDING, buffer, (GLintptr)base, (GLsizei)sizeof(typename Format::Vertex));
+        else
+            setup<Format>(vao, buffer, base);
+    }
+}
+
+#endif
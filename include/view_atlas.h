@@ -0,0 +1,237 @@
+#ifndef VIEW_ATLAS_H
+#define VIEW_ATLAS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <async_log.h>
+#include <bvh.h>
+#include <frame_trace.h>
+#include <frustum.h>
+#include <gl_state.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// THUMBNAIL_VIEWS=front,side,top (or 1 for those three): extra views of the focused model next to the main
+// one, for the configurator. Each View is a camera (framing the focus box from its direction), a tile of
+// one shared HDR atlas and flags. Per frame, cull() tests the scene tree against every view's frustum at
+// once on the ThreadPool (BVH::cull is const), and render() binds the atlas, clears it once and draws the
+// visible models of each view into its tile through the caller's DrawView: the same programs, material and
+// geometry buffers as the main view, one FrameData write per view, and none of the main view's per-frame
+// work (LOD selection, texture streaming requests, sorting, shadows, SSAO/SSR, TAA) repeated, so the
+// thumbnails cost a fraction of the main view each. The atlas is tone mapped into a strip along the bottom
+// of the window (ToneMapper::present). THUMBNAIL_SIZE is a tile's edge in pixels (default 256).
+class ViewAtlas
+{
+public:
+    enum Flags
+    {
+        ORTHOGRAPHIC = 1, // parallel projection (the blueprint views), else a 35 degree perspective
+    };
+
+    struct View
+    {
+        std::string name;
+        glm::vec3 direction; // from the focus towards the eye
+        glm::vec3 up;
+        unsigned int flags;
+        // this frame's camera and tile (atlas pixels)
+        glm::vec3 eye;
+        glm::mat4 view, projection;
+        int tileX, tileY;
+        // cull(): visible[i] for placed model i
+        std::vector<unsigned char> visible;
+    };
+
+    // draws the models visible in `view` with its camera; the atlas is bound with the tile as the viewport
+    typedef std::function<void(const View &view)> DrawView;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("THUMBNAIL_VIEWS");
+        return env && *env && std::strcmp(env, "0") != 0;
+    }
+
+    ViewAtlas()
+    {
+        if (const char *env = std::getenv("THUMBNAIL_SIZE"))
+            tileSize = std::max(32, std::min(1024, std::atoi(env)));
+        const char *env = std::getenv("THUMBNAIL_VIEWS");
+        std::string list = env && std::strcmp(env, "1") != 0 ? env : "front,side,top";
+        std::stringstream names(list);
+        std::string name;
+        while (std::getline(names, name, ','))
+        {
+            View v;
+            if (!preset(name, v))
+            {
+                LOG_WARN("[Views] unknown view '" << name << "' (front, back, side, left, top, three_quarter)");
+                continue;
+            }
+            v.tileX = (int)views.size() * tileSize;
+            v.tileY = 0;
+            views.push_back(v);
+        }
+    }
+
+    ViewAtlas(const ViewAtlas &) = delete;
+    ViewAtlas &operator=(const ViewAtlas &) = delete;
+
+    // GL thread: the atlas, one row of tiles
+    void init()
+    {
+        if (views.empty())
+            return;
+        width = (int)views.size() * tileSize;
+        height = tileSize;
+        glGenTextures(1, &colorTexture);
+        glBindTexture(GL_TEXTURE_2D, colorTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glState().invalidate();
+        if (!complete)
+        {
+            LOG_WARN("[Views] RGBA16F atlas unsupported, no thumbnail views");
+            releaseGpu();
+            return;
+        }
+        std::string names;
+        for (size_t i = 0; i < views.size(); ++i)
+            names += (i ? ", " : "") + views[i].name;
+        LOG_INFO("[Views] " << views.size() << " thumbnail views (" << names << ") in a " << width << "x" << height << " atlas");
+    }
+
+    bool ready() const { return fbo != 0; }
+    const std::vector<View> &list() const { return views; }
+
+    // places every view's camera around the world box `boundsMin`-`boundsMax`
+    void frame(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        const float radius = std::max(0.5f * glm::length(boundsMax - boundsMin), 0.01f);
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            View &v = views[i];
+            // far enough out for a 35 degree cone to hold the bounding sphere
+            const float distance = radius / std::sin(glm::radians(35.0f) * 0.5f) * 1.05f;
+            v.eye = center + glm::normalize(v.direction) * distance;
+            v.view = glm::lookAt(v.eye, center, v.up);
+            const float nearPlane = std::max(distance - radius * 1.5f, distance * 0.01f);
+            const float farPlane = distance + radius * 1.5f;
+            if (v.flags & ORTHOGRAPHIC)
+                v.projection = glm::ortho(-radius, radius, -radius, radius, nearPlane, farPlane);
+            else
+                v.projection = glm::perspective(glm::radians(35.0f), 1.0f, nearPlane, farPlane);
+        }
+    }
+
+    // every view's visible set, the views side by side on the ThreadPool
+    void cull(const BVH &sceneTree)
+    {
+        FrameTrace::Scope trace("view cull");
+        ThreadPool::shared().parallelFor(views.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                sceneTree.cull(Frustum(views[i].projection * views[i].view), views[i].visible);
+        }, "view cull");
+    }
+
+    // GL thread: clears the atlas and draws each view into its tile; the scene framebuffer is bound again
+    // afterwards
+    void render(const DrawView &drawView)
+    {
+        if (!fbo)
+            return;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, width, height);
+        glClearColor(0.08f, 0.08f, 0.09f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            glViewport(views[i].tileX, views[i].tileY, tileSize, tileSize);
+            drawView(views[i]);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+    }
+
+    // where the atlas goes in a `windowWidth` x `windowHeight` window: a strip at the bottom left, its tiles
+    // at most a fifth of the window wide
+    void placement(int windowWidth, int windowHeight, int &x, int &y, int &w, int &h) const
+    {
+        const int tile = std::min(tileSize, std::min(windowWidth / 5, windowHeight / 3));
+        const int margin = std::max(tile / 16, 4);
+        x = margin;
+        y = margin;
+        w = tile * (int)views.size();
+        h = tile;
+    }
+
+    GLuint texture() const { return colorTexture; }
+
+    void releaseGpu()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorTexture) glDeleteTextures(1, &colorTexture);
+        if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+        fbo = colorTexture = depthBuffer = 0;
+    }
+
+private:
+    std::vector<View> views;
+    int tileSize = 256;
+    int width = 0, height = 0;
+    GLuint fbo = 0;
+    GLuint colorTexture = 0;
+    GLuint depthBuffer = 0;
+
+    static bool preset(const std::string &name, View &v)
+    {
+        v.name = name;
+        v.up = glm::vec3(0.0f, 1.0f, 0.0f);
+        v.flags = ORTHOGRAPHIC;
+        // front looks from +Z, side from +X
+        if (name == "front") v.direction = glm::vec3(0.0f, 0.0f, 1.0f);
+        else if (name == "back") v.direction = glm::vec3(0.0f, 0.0f, -1.0f);
+        else if (name == "side") v.direction = glm::vec3(1.0f, 0.0f, 0.0f);
+        else if (name == "left") v.direction = glm::vec3(-1.0f, 0.0f, 0.0f);
+        else if (name == "top")
+        {
+            v.direction = glm::vec3(0.0f, 1.0f, 0.0f);
+            v.up = glm::vec3(0.0f, 0.0f, -1.0f);
+        }
+        else if (name == "three_quarter")
+        {
+            v.direction = glm::vec3(1.0f, 0.5f, 1.0f);
+            v.flags = 0;
+        }
+        else
+            return false;
+        v.eye = glm::vec3(0.0f);
+        v.view = v.projection = glm::mat4(1.0f);
+        v.tileX = v.tileY = 0;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,579 @@
+#ifndef VIRTUAL_FILE_SYSTEM_H
+#define VIRTUAL_FILE_SYSTEM_H
+
+#include <async_log.h>
+#include <frame_trace.h>
+#include <mapped_file.h>
+
+#if defined(HAS_MINIZ)
+#include "miniz.h"
+#endif
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+// The bytes of one file as handed out by VirtualFileSystem: a range of a memory mapping (a loose file, or
+// a stored entry of a .carpak archive), a buffer of its own (a deflated entry, inflated on open) or a
+// memory-mounted buffer, possibly narrowed to a mounted range. Not copyable, since data() may point into the owned buffer.
+class FileView
+{
+public:
+    FileView() {}
+    FileView(const FileView &) = delete;
+    FileView &operator=(const FileView &) = delete;
+
+    const unsigned char *data() const { return bytes; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    // the mapping data() points into, for callers that keep reading it later (TextureStreamer); null when
+    // the bytes are owned by this view
+    const std::shared_ptr<const MappedFile> &mapping() const { return mapped; }
+
+    void reset()
+    {
+        mapped.reset();
+        memory.reset();
+        std::vector<unsigned char>().swap(owned);
+        bytes = 0;
+        length = 0;
+    }
+
+private:
+    friend class VirtualFileSystem;
+
+    std::shared_ptr<const MappedFile> mapped;
+    std::shared_ptr<const std::vector<unsigned char> > memory;
+    std::vector<unsigned char> owned;
+    const unsigned char *bytes = 0;
+    size_t length = 0;
+
+    // moves `from`'s contents here; a moved vector keeps its buffer, so data() stays valid
+    void take(FileView &from)
+    {
+        reset();
+        mapped.swap(from.mapped);
+        memory.swap(from.memory);
+        owned.swap(from.owned);
+        bytes = from.bytes;
+        length = from.length;
+        from.reset();
+    }
+};
+
+// One lookup for every asset read, over four kinds of source, tried in this order:
+//   - file mounts: a buffer registered under a path (mountMemory), or a byte range of another file
+//     (mountRange: images embedded in a .glb or a .bin, read in place)
+//   - directory mounts: a path prefix redirected to a directory (mountDirectory), most specific first
+//   - loose files at the path itself
+//   - .carpak archives: a plain zip of a model directory (tools/car_pak); `<dir>.carpak` stands in for
+//     `<dir>/...` and is mounted by the first lookup below that directory (each ancestor is probed once),
+//     or explicitly with mountArchive. Loose files win, so an unpacked file overrides the shipped one.
+// An archive is memory-mapped whole and its central directory read once (miniz_zip); after that, entries
+// are opened without miniz state or a lock: stored entries (car_pak stores geometry, cooked models and
+// images, 4 KB aligned) come back as a view into the archive's mapping, deflated ones are inflated with
+// tinfl into the view's own buffer. Without miniz (HAS_MINIZ) archives aren't seen.
+//
+// Reads can be issued ahead: readAsync()/prefetch() queue them on two I/O threads, which open the file and
+// fault its pages in (or inflate it), so loaders that know their files up front (a model's textures, the
+// environment EXR) overlap the disk with their own parsing and decoding. A prefetched file is handed to the
+// next open() of its path. Thread-safe; paths are compared after canonicalPath().
+class VirtualFileSystem
+{
+public:
+    typedef std::shared_ptr<FileView> SharedView;
+
+    static const unsigned int IO_THREADS = 2;
+    // prefetched files waiting for their open(); further prefetches are dropped rather than pile up
+    static const size_t MAX_PREFETCHED = 256;
+
+    static const char *archiveExtension() { return ".carpak"; }
+
+    VirtualFileSystem()
+    {
+        for (unsigned int i = 0; i < IO_THREADS; ++i)
+            ioThreads.push_back(std::thread(&VirtualFileSystem::ioLoop, this, i));
+    }
+
+    ~VirtualFileSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(ioMutex);
+            stopping = true;
+        }
+        ioWake.notify_all();
+        for (size_t i = 0; i < ioThreads.size(); ++i)
+            ioThreads[i].join();
+    }
+
+    VirtualFileSystem(const VirtualFileSystem &) = delete;
+    VirtualFileSystem &operator=(const VirtualFileSystem &) = delete;
+
+    // any thread: the contents of `path`; false (and an empty view) if no source has it or the archive
+    // entry is damaged. Takes over a prefetch of the path, waiting for it if it's still reading.
+    bool open(const std::string &path, FileView &out)
+    {
+        out.reset();
+        std::shared_future<SharedView> ahead;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::map<std::string, std::shared_future<SharedView> >::iterator it = prefetched.find(canonicalPath(path));
+            if (it != prefetched.end())
+            {
+                ahead = it->second;
+                prefetched.erase(it);
+            }
+        }
+        if (ahead.valid())
+        {
+            SharedView view = ahead.get();
+            if (!view)
+                return false;
+            out.take(*view);
+            return true;
+        }
+        return load(path, out);
+    }
+
+    // any thread: queues a read of `path` on the I/O threads; the view is null if no source has it
+    std::shared_future<SharedView> readAsync(const std::string &path)
+    {
+        std::shared_ptr<std::promise<SharedView> > done = std::make_shared<std::promise<SharedView> >();
+        std::shared_future<SharedView> result = done->get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(ioMutex);
+            IoRequest request = {path, done};
+            ioQueue.push_back(request);
+        }
+        ioWake.notify_one();
+        return result;
+    }
+
+    // any thread: starts reading each of `paths` for the open() that will follow
+    void prefetch(const std::vector<std::string> &paths)
+    {
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            std::string key = canonicalPath(paths[i]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (prefetched.size() >= MAX_PREFETCHED || prefetched.count(key))
+                    continue;
+            }
+            std::shared_future<SharedView> read = readAsync(paths[i]);
+            std::lock_guard<std::mutex> lock(mutex);
+            prefetched.insert(std::make_pair(key, read));
+        }
+    }
+
+    bool exists(const std::string &path)
+    {
+        std::string key = canonicalPath(path);
+        Resolved resolved;
+        resolve(key, resolved);
+        if (resolved.mounted)
+            return true;
+        for (size_t i = 0; i < resolved.files.size(); ++i)
+            if (fileExists(resolved.files[i]))
+                return true;
+        Located entry;
+        return fileExists(path) || find(key, entry);
+    }
+
+    // any thread: size and CRC-32 of `path` if it comes from an archive, from the central directory without
+    // touching the data; false if it's mounted, a loose file or unknown
+    bool archivedEntry(const std::string &path, uint64_t &size, uint32_t &crc)
+    {
+        std::string key = canonicalPath(path);
+        Resolved resolved;
+        resolve(key, resolved);
+        if (resolved.mounted || fileExists(path))
+            return false;
+        for (size_t i = 0; i < resolved.files.size(); ++i)
+            if (fileExists(resolved.files[i]))
+                return false;
+        Located entry;
+        if (!find(key, entry))
+            return false;
+        size = entry.entry.size;
+        crc = entry.entry.crc;
+        return true;
+    }
+
+    // mounts `archive` so that its entry "a/b.png" is found as `prefix` + "/a/b.png"; false if it can't be
+    // read (or archives aren't compiled in)
+    bool mountArchive(const std::string &archive, const std::string &prefix)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return mountLocked(archive, canonicalPath(prefix));
+    }
+
+    // paths below `prefix` are looked up below `directory` first
+    void mountDirectory(const std::string &directory, const std::string &prefix)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        directories.insert(std::make_pair(canonicalPath(prefix), canonicalPath(directory)));
+    }
+
+    // `path` reads as `bytes` (which stay shared, not copied) until unmounted
+    void mountMemory(const std::string &path, const std::shared_ptr<const std::vector<unsigned char> > &bytes)
+    {
+        Mounted file;
+        file.memory = bytes;
+        std::lock_guard<std::mutex> lock(mutex);
+        mounted[canonicalPath(path)] = file;
+    }
+
+    // `path` reads as `size` bytes at `offset` of `source` (looked up here as well), without a copy when
+    // the source is mapped; the read fails if the source is shorter
+    void mountRange(const std::string &path, const std::string &source, uint64_t offset, uint64_t size)
+    {
+        Mounted file;
+        file.source = source;
+        file.offset = offset;
+        file.size = size;
+        std::lock_guard<std::mutex> lock(mutex);
+        mounted[canonicalPath(path)] = file;
+    }
+
+    // drops a memory or range mount
+    void unmount(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        mounted.erase(canonicalPath(path));
+    }
+
+    // lexical normalisation: '\\' -> '/', drops "." and duplicate separators, resolves ".."
+    static std::string canonicalPath(const std::string &path)
+    {
+        std::string p = path;
+        for (size_t i = 0; i < p.size(); ++i)
+            if (p[i] == '\\')
+                p[i] = '/';
+        bool absolute = !p.empty() && p[0] == '/';
+        std::vector<std::string> parts;
+        size_t start = 0;
+        while (start <= p.size())
+        {
+            size_t end = p.find('/', start);
+            if (end == std::string::npos)
+                end = p.size();
+            std::string part = p.substr(start, end - start);
+            if (part == "..")
+            {
+                if (!parts.empty() && parts.back() != "..")
+                    parts.pop_back();
+                else if (!absolute)
+                    parts.push_back(part);
+            }
+            else if (!part.empty() && part != ".")
+                parts.push_back(part);
+            start = end + 1;
+        }
+        std::string out = absolute ? "/" : "";
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            if (i)
+                out += '/';
+            out += parts[i];
+        }
+        return out;
+    }
+
+private:
+    // zip compression methods
+    enum { METHOD_STORED = 0, METHOD_DEFLATED = 8 };
+
+    struct Entry
+    {
+        uint64_t headerOffset; // of the local header; the data follows its name and extra field
+        uint64_t compressedSize;
+        uint64_t size;
+        uint32_t crc;
+        uint16_t method;
+    };
+    struct Located
+    {
+        std::shared_ptr<const MappedFile> archive;
+        Entry entry;
+    };
+    // a memory mount, or a range of another file
+    struct Mounted
+    {
+        std::shared_ptr<const std::vector<unsigned char> > memory;
+        std::string source;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+    // what the mounts make of a path: a mounted file, or the directory-mounted files to try in order
+    struct Resolved
+    {
+        bool mounted = false;
+        Mounted file;
+        std::vector<std::string> files;
+    };
+    struct IoRequest
+    {
+        std::string path;
+        std::shared_ptr<std::promise<SharedView> > done;
+    };
+
+    std::mutex mutex;
+    std::map<std::string, Located> entries;
+    std::set<std::string> probed;
+    // prefix -> directory; reverse order so longer (more specific) prefixes come first among equal starts
+    std::multimap<std::string, std::string, std::greater<std::string> > directories;
+    std::map<std::string, Mounted> mounted;
+    std::map<std::string, std::shared_future<SharedView> > prefetched;
+
+    std::vector<std::thread> ioThreads;
+    std::mutex ioMutex;
+    std::condition_variable ioWake;
+    std::deque<IoRequest> ioQueue;
+    bool stopping = false;
+
+    static bool fileExists(const std::string &path)
+    {
+#ifdef _WIN32
+        DWORD attributes = GetFileAttributesA(path.c_str());
+        return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+        struct stat st;
+        return ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+#endif
+    }
+
+    void resolve(const std::string &key, Resolved &out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, Mounted>::const_iterator m = mounted.find(key);
+        if (m != mounted.end())
+        {
+            out.mounted = true;
+            out.file = m->second;
+            return;
+        }
+        for (std::multimap<std::string, std::string, std::greater<std::string> >::const_iterator d = directories.begin(); d != directories.end(); ++d)
+        {
+            const std::string &prefix = d->first;
+            if (prefix.empty())
+                out.files.push_back(d->second + '/' + key);
+            else if (key.size() > prefix.size() && key.compare(0, prefix.size(), prefix) == 0 && key[prefix.size()] == '/')
+                out.files.push_back(d->second + key.substr(prefix.size()));
+        }
+    }
+
+    static bool mapFile(const std::string &path, FileView &out)
+    {
+        std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+        if (!file->open(path))
+            return false;
+        out.bytes = file->data();
+        out.length = file->size();
+        out.mapped = file;
+        return true;
+    }
+
+    // open() without the prefetch hand-over
+    bool load(const std::string &path, FileView &out)
+    {
+        std::string key = canonicalPath(path);
+        Resolved resolved;
+        resolve(key, resolved);
+        if (resolved.mounted && resolved.file.memory)
+        {
+            out.memory = resolved.file.memory;
+            out.bytes = out.memory->empty() ? 0 : &(*out.memory)[0];
+            out.length = out.memory->size();
+            return true;
+        }
+        if (resolved.mounted)
+        {
+            // the view keeps whatever holds the source (its mapping, or its inflated buffer) and is narrowed
+            if (!load(resolved.file.source, out) || resolved.file.offset + resolved.file.size > out.length)
+            {
+                out.reset();
+                return false;
+            }
+            out.bytes += resolved.file.offset;
+            out.length = (size_t)resolved.file.size;
+            return true;
+        }
+        for (size_t i = 0; i < resolved.files.size(); ++i)
+            if (mapFile(resolved.files[i], out))
+                return true;
+        if (mapFile(path, out))
+            return true;
+        Located entry;
+        if (!find(key, entry))
+            return false;
+        return read(entry, out);
+    }
+
+    void ioLoop(unsigned int index)
+    {
+        frameTrace().nameThread("io reader " + std::to_string(index + 1));
+        for (;;)
+        {
+            IoRequest request;
+            {
+                std::unique_lock<std::mutex> lock(ioMutex);
+                ioWake.wait(lock, [this]() { return stopping || !ioQueue.empty(); });
+                if (stopping)
+                    break;
+                request = ioQueue.front();
+                ioQueue.pop_front();
+            }
+            FrameTrace::Scope trace("read file", request.path);
+            SharedView view = std::make_shared<FileView>();
+            if (!load(request.path, *view))
+                view.reset();
+            else if (view->mapping())
+            {
+                // fault the pages in here, so the reader finds them resident
+                volatile unsigned char sink = 0;
+                for (size_t offset = 0; offset < view->size(); offset += 4096)
+                    sink ^= view->data()[offset];
+                (void)sink;
+            }
+            request.done->set_value(view);
+        }
+        // queued reads nobody will serve resolve empty, so waiters don't hang
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (size_t i = 0; i < ioQueue.size(); ++i)
+            ioQueue[i].done->set_value(SharedView());
+        ioQueue.clear();
+    }
+
+    bool find(const std::string &path, Located &out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // mount `<dir>.carpak` for every ancestor directory not looked at yet, innermost first
+        for (size_t slash = path.find_last_of('/'); slash != std::string::npos && slash > 0; slash = path.find_last_of('/', slash - 1))
+        {
+            std::string dir = path.substr(0, slash);
+            if (probed.insert(dir).second)
+                mountLocked(dir + archiveExtension(), dir);
+        }
+        std::map<std::string, Located>::const_iterator it = entries.find(path);
+        if (it == entries.end())
+            return false;
+        out = it->second;
+        return true;
+    }
+
+#if defined(HAS_MINIZ)
+    bool mountLocked(const std::string &archivePath, const std::string &prefix)
+    {
+        std::shared_ptr<MappedFile> archive = std::make_shared<MappedFile>();
+        if (!archive->open(archivePath))
+            return false;
+        mz_zip_archive zip;
+        std::memset(&zip, 0, sizeof(zip));
+        if (!mz_zip_reader_init_mem(&zip, archive->data(), archive->size(), 0))
+        {
+            LOG_WARN("[CarPak] '" << archivePath << "' is not a zip archive: " << mz_zip_get_error_string(mz_zip_get_last_error(&zip)));
+            return false;
+        }
+        const mz_uint count = mz_zip_reader_get_num_files(&zip);
+        size_t added = 0, deflated = 0;
+        for (mz_uint i = 0; i < count; ++i)
+        {
+            mz_zip_archive_file_stat stat;
+            if (!mz_zip_reader_file_stat(&zip, i, &stat) || stat.m_is_directory)
+                continue;
+            if (!stat.m_is_supported || stat.m_is_encrypted || (stat.m_method != METHOD_STORED && stat.m_method != METHOD_DEFLATED))
+            {
+                LOG_WARN("[CarPak] '" << archivePath << "': skipping '" << stat.m_filename << "' (unsupported compression or encryption)");
+                continue;
+            }
+            Located located;
+            located.archive = archive;
+            located.entry.headerOffset = stat.m_local_header_ofs;
+            located.entry.compressedSize = stat.m_comp_size;
+            located.entry.size = stat.m_uncomp_size;
+            located.entry.crc = stat.m_crc32;
+            located.entry.method = stat.m_method;
+            // an earlier mount (a nested directory's own archive) keeps its entries
+            if (entries.insert(std::make_pair(canonicalPath(prefix + '/' + stat.m_filename), located)).second)
+            {
+                ++added;
+                if (stat.m_method == METHOD_DEFLATED)
+                    ++deflated;
+            }
+        }
+        mz_zip_reader_end(&zip);
+        LOG_INFO("[CarPak] Mounted '" << archivePath << "' at '" << prefix << "': " << added << " files (" << deflated << " deflated)");
+        return true;
+    }
+
+    static bool read(const Located &located, FileView &out)
+    {
+        const MappedFile &archive = *located.archive;
+        const Entry &entry = located.entry;
+        // local header: signature, ..., name length at 26, extra length at 28, 30 bytes in all
+        const uint64_t LOCAL_HEADER_SIZE = 30;
+        if (entry.headerOffset + LOCAL_HEADER_SIZE > archive.size())
+            return false;
+        const unsigned char *header = archive.data() + entry.headerOffset;
+        if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4)
+            return false;
+        const uint64_t nameLength = (uint64_t)header[26] | ((uint64_t)header[27] << 8);
+        const uint64_t extraLength = (uint64_t)header[28] | ((uint64_t)header[29] << 8);
+        const uint64_t dataOffset = entry.headerOffset + LOCAL_HEADER_SIZE + nameLength + extraLength;
+        if (dataOffset + entry.compressedSize > archive.size())
+            return false;
+        const unsigned char *data = archive.data() + dataOffset;
+        if (entry.method == METHOD_STORED)
+        {
+            if (entry.compressedSize != entry.size)
+                return false;
+            // zero-copy; the archive's integrity is the caller's format check (cooked headers, image decoders)
+            out.bytes = data;
+            out.length = (size_t)entry.size;
+            out.mapped = located.archive;
+            return true;
+        }
+        out.owned.resize((size_t)entry.size);
+        if (entry.size)
+        {
+            size_t written = tinfl_decompress_mem_to_mem(&out.owned[0], out.owned.size(), data, (size_t)entry.compressedSize, 0);
+            if (written != out.owned.size() || (uint32_t)mz_crc32(MZ_CRC32_INIT, &out.owned[0], out.owned.size()) != entry.crc)
+            {
+                out.reset();
+                return false;
+            }
+            out.bytes = &out.owned[0];
+        }
+        out.length = out.owned.size();
+        return true;
+    }
+#else
+    bool mountLocked(const std::string &, const std::string &) { return false; }
+    static bool read(const Located &, FileView &) { return false; }
+#endif
+};
+
+inline VirtualFileSystem &fileSystem()
+{
+    static VirtualFileSystem vfs;
+    return vfs;
+}
+
+#endif
@@ -0,0 +1,507 @@
+#ifndef VIRTUAL_TEXTURE_H
+#define VIRTUAL_TEXTURE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <cooked_format.h>
+#include <frame_data.h>
+#include <frame_trace.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <mapped_file.h>
+#include <shader.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// LIVERY=<image>: a livery far larger than a texture the car could keep resident (16K and up), painted over
+// the paint materials (MaterialOverrides::PAINT) through their first UV set, blended by its alpha. The image
+// is cooked once into a page file (car_cook --livery <image>, CookedFormat::LiveryHeader) of 128-texel pages
+// per mip level; only the pages the view needs are in VRAM, in a cache atlas of fixed size (VT_CACHE_MB,
+// default 32) that evicts the least recently needed ones. Which pages are needed comes from a feedback
+// pass: the visible models drawn again at 1/VT_FEEDBACK_SCALE (default 8) of the scene's resolution, the
+// paint writing the page and level it samples, read back through a pixel buffer a frame or more later
+// without stalling. Missing pages are copied out of the mapped page file on the worker pool and uploaded
+// at most VT_UPLOADS (default 8) a frame. The page table, one texel per page and a mip level per livery
+// level, points each page at its own cache slot or at the nearest coarser page that is resident; the
+// coarsest level (one page) is loaded up front and never evicted, so a new view is blurry for a few
+// frames at worst, never missing.
+class VirtualTexture
+{
+public:
+    // texture units (Shader::samplerUnit): the post passes' hdrColor/currentColor units, which the scene shader
+    // doesn't otherwise use
+    static const unsigned int UNIT_PAGE_TABLE = 16;
+    static const unsigned int UNIT_CACHE = 17;
+
+    // `shaderDir` holds model_loading.vs/.fs
+    explicit VirtualTexture(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+        if (const char *env = std::getenv("VT_CACHE_MB"))
+            cacheMb = std::max(1, std::atoi(env));
+        if (const char *env = std::getenv("VT_FEEDBACK_SCALE"))
+            feedbackScale = std::min(std::max(1, std::atoi(env)), 32);
+        if (const char *env = std::getenv("VT_UPLOADS"))
+            maxUploads = std::max(1, std::atoi(env));
+    }
+
+    VirtualTexture(const VirtualTexture &) = delete;
+    VirtualTexture &operator=(const VirtualTexture &) = delete;
+
+    ~VirtualTexture() { waitForLoads(); }
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("LIVERY");
+        return env && *env;
+    }
+
+    // GL thread: maps the page file of LIVERY, creates the page table and cache and loads the coarsest page
+    void init()
+    {
+        const std::string image = std::getenv("LIVERY") ? std::getenv("LIVERY") : "";
+        const std::string path = CookedFormat::liveryPath(image);
+        if (!file.open(path))
+        {
+            LOG_ERROR("[VirtualTexture] No page file " << path << " (cook it with car_cook --livery " << image << ")");
+            return;
+        }
+        if (file.size() < sizeof(CookedFormat::LiveryHeader))
+        {
+            LOG_ERROR("[VirtualTexture] " << path << " is truncated");
+            file.close();
+            return;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        const uint64_t expected = header.pageOffset + (uint64_t)header.pageCount * header.pageBytes;
+        if (std::memcmp(header.magic, CookedFormat::LIVERY_MAGIC, 4) != 0 || header.version != CookedFormat::LIVERY_VERSION ||
+            header.pageSize != CookedFormat::LIVERY_PAGE || header.border != CookedFormat::LIVERY_BORDER ||
+            header.levels != CookedFormat::liveryLevels(header.width, header.height) || header.levels > 16 ||
+            CookedFormat::liveryPages(header.width, 0) > 256 || CookedFormat::liveryPages(header.height, 0) > 256 ||
+            header.pageBytes != (uint64_t)TILE * TILE * 4 || file.size() < expected)
+        {
+            LOG_ERROR("[VirtualTexture] " << path << " is not a page file of this version (re-run car_cook --livery " << image << ")");
+            file.close();
+            return;
+        }
+        uint32_t first = 0;
+        for (uint32_t l = 0; l < header.levels; ++l)
+        {
+            firstPage.push_back(first);
+            first += pagesX(l) * pagesY(l);
+            table.push_back(std::vector<uint32_t>((size_t)pagesX(l) * pagesY(l), 0));
+        }
+        if (first != header.pageCount)
+        {
+            LOG_ERROR("[VirtualTexture] " << path << " holds " << header.pageCount << " pages, its levels " << first);
+            file.close();
+            return;
+        }
+
+        // as many slots as fit the budget, a square of at most 255 per side (the page table's bytes) and the
+        // largest texture the driver takes
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        const size_t budgetSlots = (size_t)cacheMb * 1024 * 1024 / header.pageBytes;
+        slotsPerSide = std::max(1, std::min((int)std::sqrt((double)budgetSlots), std::min(255, (int)maxSize / TILE)));
+        slots.assign((size_t)slotsPerSide * slotsPerSide, Slot());
+
+        glGenTextures(1, &cache);
+        glState().bindTexture(UNIT_CACHE, GL_TEXTURE_2D, cache);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, slotsPerSide * TILE, slotsPerSide * TILE, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        gpuMemory().trackTexture(cache, GpuMemory::MODEL_TEXTURES, GL_SRGB8_ALPHA8, slotsPerSide * TILE, slotsPerSide * TILE, 1, false,
+                                 "livery page cache");
+
+        glGenTextures(1, &pageTable);
+        glState().bindTexture(UNIT_PAGE_TABLE, GL_TEXTURE_2D, pageTable);
+        for (uint32_t l = 0; l < header.levels; ++l)
+            glTexImage2D(GL_TEXTURE_2D, (GLint)l, GL_RGBA8, (GLsizei)pagesX(l), (GLsizei)pagesY(l), 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)header.levels - 1);
+        gpuMemory().trackTexture(pageTable, GpuMemory::MODEL_TEXTURES, GL_RGBA8, (int)pagesX(0), (int)pagesY(0), 1, true, "livery page table");
+
+        // the coarsest page, resident for good: every table entry falls back to it
+        const uint32_t coarsest = key(header.levels - 1, 0, 0);
+        upload(coarsest, pageBytes(coarsest));
+        slots[resident[coarsest]].pinned = true;
+        uploadTable();
+
+        feedbackShader.reset(new Shader((shaderDir + "/model_loading.vs").c_str(), (shaderDir + "/model_loading.fs").c_str(),
+                                        "#define PROBE_CAPTURE 1\n#define VT_FEEDBACK 1\n"));
+        glGenBuffers(1, &pbo);
+        LOG_INFO("[VirtualTexture] " << image << ": " << header.width << "x" << header.height << ", " << header.levels << " levels, "
+                 << header.pageCount << " pages; cache of " << slots.size() << " pages ("
+                 << (slots.size() * header.pageBytes) / (1024 * 1024) << " MB), feedback at 1/" << feedbackScale);
+    }
+
+    bool ready() const { return cache && pageTable && feedbackShader; }
+
+    // points `shader` (a scene shader, already in use) at the livery, or tells it there is none
+    void apply(Shader &shader) const
+    {
+        static const Shader::UniformHandle uVirtualLivery = Shader::uniformHandle("virtualLivery");
+        static const Shader::UniformHandle uLiverySize = Shader::uniformHandle("liverySize");
+        static const Shader::UniformHandle uLiveryLodBias = Shader::uniformHandle("liveryLodBias");
+        shader.setBool(uVirtualLivery, ready());
+        if (!ready())
+            return;
+        shader.setVec3(uLiverySize, glm::vec3((float)header.width, (float)header.height, (float)(header.levels - 1)));
+        shader.setFloat(uLiveryLodBias, 0.0f);
+        glState().bindTexture(UNIT_PAGE_TABLE, GL_TEXTURE_2D, pageTable);
+        glState().bindTexture(UNIT_CACHE, GL_TEXTURE_2D, cache);
+    }
+
+    // draws the visible models with the shader it is given (already in use; FrameData is bound)
+    typedef std::function<void(Shader &)> DrawScene;
+
+    // GL thread, before the view's FrameData is bound (this binds its own): renders the page requests of the
+    // view at 1/feedbackScale of `width` x `height` and starts reading them back, unless the last read is
+    // still in flight
+    void feedback(const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye, int width, int height, const DrawScene &draw)
+    {
+        if (!ready() || fence || width <= 0 || height <= 0)
+            return;
+        const int w = std::max(1, width / feedbackScale), h = std::max(1, height / feedbackScale);
+        if (w != feedbackWidth || h != feedbackHeight)
+            createTarget(w, h);
+        if (!fbo)
+            return;
+        GLint previousFbo = 0, viewport[4], depthFunc = GL_LESS;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glViewport(0, 0, w, h);
+        const GLfloat none[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        const GLfloat far = 1.0f;
+        glDepthMask(GL_TRUE);
+        glClearBufferfv(GL_COLOR, 0, none);
+        glClearBufferfv(GL_DEPTH, 0, &far);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        FrameData(projection, view, eye).bind();
+        feedbackShader->use();
+        apply(*feedbackShader);
+        // a feedback pixel covers feedbackScale^2 scene pixels: ask for the level the scene will sample
+        feedbackShader->setFloat("liveryLodBias", -std::log2((float)feedbackScale));
+        draw(*feedbackShader);
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glDepthFunc((GLenum)depthFunc);
+        glState().invalidate();
+    }
+
+    // GL thread, once per frame: takes in a finished feedback read, starts loading the pages it asks for and
+    // uploads the ones that have been read, refreshing the page table if any came in
+    void update()
+    {
+        if (!ready())
+            return;
+        readFeedback();
+        startLoads();
+        finishLoads();
+    }
+
+    void releaseGpu()
+    {
+        waitForLoads();
+        if (fence) glDeleteSync(fence);
+        fence = 0;
+        releaseTarget();
+        if (pbo) glDeleteBuffers(1, &pbo);
+        pbo = 0;
+        const GLuint textures[2] = {cache, pageTable};
+        for (int t = 0; t < 2; ++t)
+            if (textures[t])
+            {
+                gpuMemory().releaseTexture(textures[t]);
+                glDeleteTextures(1, &textures[t]);
+            }
+        cache = pageTable = 0;
+        feedbackShader.reset();
+        glState().invalidate();
+    }
+
+private:
+    // a cached page with its border
+    static const int TILE = (int)(CookedFormat::LIVERY_PAGE + 2 * CookedFormat::LIVERY_BORDER);
+
+    struct Slot
+    {
+        uint32_t page = NO_PAGE;
+        uint64_t lastWanted = 0; // feedback read the page was last asked for in
+        bool pinned = false;
+    };
+    static const uint32_t NO_PAGE = 0xffffffffu;
+
+    std::string shaderDir;
+    int cacheMb = 32;
+    int feedbackScale = 8;
+    int maxUploads = 8;
+
+    MappedFile file;
+    CookedFormat::LiveryHeader header = CookedFormat::LiveryHeader();
+    std::vector<uint32_t> firstPage;                 // page file index of each level's first page
+    std::vector<std::vector<uint32_t> > table;       // page table texels per level (RGBA8: slot x, y, level)
+    GLuint pageTable = 0;
+    GLuint cache = 0;
+    int slotsPerSide = 0;
+    std::vector<Slot> slots;
+    std::unordered_map<uint32_t, int> resident;      // page key -> slot
+    std::map<uint32_t, std::future<std::vector<unsigned char> > > loading;
+    std::vector<uint32_t> wanted;                    // pages of the last feedback read, coarsest first
+    uint64_t reads = 0;
+
+    std::unique_ptr<Shader> feedbackShader;
+    GLuint fbo = 0, colorTarget = 0, depthTarget = 0, pbo = 0;
+    GLsync fence = 0;
+    int feedbackWidth = 0, feedbackHeight = 0;
+
+    uint32_t pagesX(uint32_t level) const { return CookedFormat::liveryPages(header.width, level); }
+    uint32_t pagesY(uint32_t level) const { return CookedFormat::liveryPages(header.height, level); }
+
+    // level in the high bits, so sorting by key descending puts coarser pages first
+    static uint32_t key(uint32_t level, uint32_t x, uint32_t y) { return (level << 16) | (y << 8) | x; }
+    static uint32_t keyLevel(uint32_t k) { return k >> 16; }
+    static uint32_t keyY(uint32_t k) { return (k >> 8) & 255u; }
+    static uint32_t keyX(uint32_t k) { return k & 255u; }
+
+    const unsigned char *pageBytes(uint32_t k) const
+    {
+        const uint32_t l = keyLevel(k);
+        const uint64_t index = firstPage[l] + (uint64_t)keyY(k) * pagesX(l) + keyX(k);
+        return file.data() + header.pageOffset + index * header.pageBytes;
+    }
+
+    void createTarget(int w, int h)
+    {
+        releaseTarget();
+        glGenTextures(1, &colorTarget);
+        glBindTexture(GL_TEXTURE_2D, colorTarget);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenRenderbuffers(1, &depthTarget);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthTarget);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, w, h);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        GLint previousFbo = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFbo);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTarget, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthTarget);
+        const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFbo);
+        glState().invalidate();
+        feedbackWidth = w;
+        feedbackHeight = h;
+        if (!complete)
+        {
+            LOG_WARN("[VirtualTexture] Feedback target incomplete, the livery stays at its resident pages");
+            releaseTarget();
+            return;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)w * h * 4, NULL, GL_STREAM_READ);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (colorTarget) glDeleteTextures(1, &colorTarget);
+        if (depthTarget) glDeleteRenderbuffers(1, &depthTarget);
+        fbo = colorTarget = depthTarget = 0;
+    }
+
+    // the pages of a finished feedback read and their coarser ancestors, which stay cached so the table has
+    // something close to fall back to
+    void readFeedback()
+    {
+        if (!fence)
+            return;
+        const GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED)
+            return;
+        glDeleteSync(fence);
+        fence = 0;
+        if (status == GL_WAIT_FAILED)
+            return;
+        FrameTrace::Scope trace("livery feedback");
+        ++reads;
+        wanted.clear();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+        const size_t count = (size_t)feedbackWidth * feedbackHeight;
+        if (const unsigned char *texels = (const unsigned char *)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)count * 4, GL_MAP_READ_BIT))
+        {
+            uint32_t last = NO_PAGE;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const unsigned char *t = texels + i * 4;
+                if (!t[3] || t[2] >= header.levels)
+                    continue;
+                const uint32_t k = key(t[2], t[0], t[1]);
+                if (k != last)
+                    wanted.push_back(k);
+                last = k;
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        const size_t direct = wanted.size();
+        for (size_t i = 0; i < direct; ++i)
+        {
+            uint32_t l = keyLevel(wanted[i]), x = keyX(wanted[i]), y = keyY(wanted[i]);
+            while (++l < header.levels)
+                wanted.push_back(key(l, x >>= 1, y >>= 1));
+        }
+        std::sort(wanted.begin(), wanted.end(), [](uint32_t a, uint32_t b) { return a > b; });
+        wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+        for (size_t i = 0; i < wanted.size(); ++i)
+        {
+            const uint32_t l = keyLevel(wanted[i]);
+            if (keyX(wanted[i]) >= pagesX(l) || keyY(wanted[i]) >= pagesY(l))
+                continue;
+            std::unordered_map<uint32_t, int>::const_iterator it = resident.find(wanted[i]);
+            if (it != resident.end())
+                slots[it->second].lastWanted = reads;
+        }
+    }
+
+    // reads of the wanted pages that aren't cached, coarsest first, a few frames' uploads in flight at most
+    void startLoads()
+    {
+        for (size_t i = 0; i < wanted.size() && loading.size() < (size_t)maxUploads * 2; ++i)
+        {
+            const uint32_t k = wanted[i];
+            const uint32_t l = keyLevel(k);
+            if (keyX(k) >= pagesX(l) || keyY(k) >= pagesY(l) || resident.count(k) || loading.count(k))
+                continue;
+            const unsigned char *page = pageBytes(k);
+            const size_t size = (size_t)header.pageBytes;
+            // copying out of the mapping is where the page file is actually read
+            loading[k] = ThreadPool::shared().submit([page, size]() {
+                FrameTrace::Scope trace("read livery page");
+                return std::vector<unsigned char>(page, page + size);
+            });
+        }
+    }
+
+    void finishLoads()
+    {
+        int uploads = 0;
+        bool changed = false;
+        for (std::map<uint32_t, std::future<std::vector<unsigned char> > >::iterator it = loading.begin(); it != loading.end() && uploads < maxUploads;)
+        {
+            if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++it;
+                continue;
+            }
+            const std::vector<unsigned char> bytes = it->second.get();
+            if (upload(it->first, bytes.data()))
+            {
+                ++uploads;
+                changed = true;
+            }
+            loading.erase(it++);
+        }
+        if (changed)
+            uploadTable();
+    }
+
+    // puts page `k` in a free slot or the least recently wanted one not wanted by the last read; false when
+    // every slot holds a page the view still needs (the table keeps pointing at coarser ones)
+    bool upload(uint32_t k, const unsigned char *bytes)
+    {
+        int best = -1;
+        for (size_t s = 0; s < slots.size(); ++s)
+        {
+            if (slots[s].page == NO_PAGE)
+            {
+                best = (int)s;
+                break;
+            }
+            if (slots[s].pinned || slots[s].lastWanted >= reads)
+                continue;
+            if (best < 0 || slots[s].lastWanted < slots[best].lastWanted)
+                best = (int)s;
+        }
+        if (best < 0)
+            return false;
+        Slot &slot = slots[best];
+        if (slot.page != NO_PAGE)
+            resident.erase(slot.page);
+        slot.page = k;
+        slot.lastWanted = reads;
+        resident[k] = best;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glState().bindTexture(UNIT_CACHE, GL_TEXTURE_2D, cache);
+        glState().activeTexture(UNIT_CACHE);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (best % slotsPerSide) * TILE, (best / slotsPerSide) * TILE, TILE, TILE, GL_RGBA, GL_UNSIGNED_BYTE, bytes);
+        return true;
+    }
+
+    // every entry: its own page's slot when resident, else its parent's entry, coarsest level first
+    void uploadTable()
+    {
+        for (uint32_t l = header.levels; l-- > 0;)
+        {
+            const uint32_t w = pagesX(l), h = pagesY(l);
+            for (uint32_t y = 0; y < h; ++y)
+                for (uint32_t x = 0; x < w; ++x)
+                {
+                    std::unordered_map<uint32_t, int>::const_iterator it = resident.find(key(l, x, y));
+                    uint32_t &entry = table[l][(size_t)y * w + x];
+                    if (it != resident.end())
+                        entry = (uint32_t)(it->second % slotsPerSide) | (uint32_t)(it->second / slotsPerSide) << 8 | l << 16 | 0xff000000u;
+                    else if (l + 1 < header.levels)
+                        entry = table[l + 1][(size_t)std::min(y >> 1, pagesY(l + 1) - 1) * pagesX(l + 1) + std::min(x >> 1, pagesX(l + 1) - 1)];
+                }
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glState().bindTexture(UNIT_PAGE_TABLE, GL_TEXTURE_2D, pageTable);
+        glState().activeTexture(UNIT_PAGE_TABLE);
+        for (uint32_t l = 0; l < header.levels; ++l)
+            glTexSubImage2D(GL_TEXTURE_2D, (GLint)l, 0, 0, (GLsizei)pagesX(l), (GLsizei)pagesY(l), GL_RGBA, GL_UNSIGNED_BYTE, table[l].data());
+    }
+
+    void waitForLoads()
+    {
+        for (std::map<uint32_t, std::future<std::vector<unsigned char> > >::iterator it = loading.begin(); it != loading.end(); ++it)
+            it->second.wait();
+        loading.clear();
+    }
+};
+
+#endif
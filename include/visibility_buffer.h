@@ -0,0 +1,375 @@
+#ifndef VISIBILITY_BUFFER_H
+#define VISIBILITY_BUFFER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <gpu_memory.h>
+#include <mesh.h>
+#include <shader.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// VISIBILITY_BUFFER=1: the opaque pass of scenes with many small meshes shades every pixel once. The
+// main view's opaque material buckets are first rasterized into a 32-bit ID target (mesh index <<
+// PRIMITIVE_BITS | gl_PrimitiveID, shaders/visibility.vs/.fs) over the scene's depth buffer, so the
+// vertex work is positions only. Then a fullscreen pass per bucket (model_loading.fs compiled with
+// VISIBILITY_RESOLVE) reads the ID of its pixel, fetches the triangle's three vertices from the model's
+// shared vertex and index buffers (buffer textures), rebuilds the interpolated attributes with
+// perspective-correct barycentrics and shades with the bucket's material table entry and textures.
+// Textures are bound per bucket, not bindless, so each resolve draw has to be limited to its bucket's
+// pixels: every (placement, bucket) gets an 8-bit stencil key written with the IDs, and its resolve
+// draw tests the stencil for that key inside the bucket's projected bounds. Buckets past the 255 keys,
+// alpha tested, transmissive and skinned buckets and instanced meshes draw forward as usual, clearing the
+// stencil where they win the depth test; so do models without a material table or with more meshes or
+// triangles than the ID bits hold.
+class VisibilityBuffer
+{
+public:
+    // ID layout: the primitive within the mesh's draw in the low bits, the mesh index above
+    static const unsigned int PRIMITIVE_BITS = 22;
+    static const unsigned int MAX_MESHES = 1u << (32 - PRIMITIVE_BITS);
+    static const GLuint EMPTY_ID = 0xffffffffu;
+    // stencil keys 1..255 (0 = nothing to resolve)
+    static const unsigned int MAX_KEYS = 255;
+    // texture units of the resolve pass (see Shader::samplerUnit)
+    static const unsigned int UNIT_IDS = 21;
+    static const unsigned int UNIT_VERTICES = 22;
+    static const unsigned int UNIT_INDICES = 23;
+    static const unsigned int UNIT_RANGES = 24;
+    static const unsigned int UNIT_MATERIALS = 25;
+
+    // GPU state of one model: the ID pass VAO and the buffer textures its resolve reads
+    struct Target
+    {
+        GLuint vao = 0;
+        // mesh index of every vertex (uint16), attribute 3 of the ID pass
+        GLuint meshVbo = 0;
+        // per mesh: first index of the LOD drawn this frame and base vertex in the vertex buffer (RG32I)
+        GLuint rangeBuffer = 0;
+        // vertex buffer as R32UI (5 words per PackedVertex), index buffer, ranges, per-vertex material
+        GLuint textures[4] = {0, 0, 0, 0};
+        // the ranges last uploaded, to re-upload when a LOD changes
+        std::vector<glm::ivec2> ranges;
+        // first vertex of the model in the vertex buffer (a GeometryArena page): the resolve subtracts it
+        // again for the per-vertex material, which is the model's own
+        GLint vertexBase = 0;
+        // prepare() was tried and the model can't use the ID pass
+        bool unsupported = false;
+
+        bool ready() const { return vao != 0; }
+
+        void release()
+        {
+            gpuMemory().releaseBuffer(meshVbo);
+            gpuMemory().releaseBuffer(rangeBuffer);
+            if (vao) glDeleteVertexArrays(1, &vao);
+            if (meshVbo) glDeleteBuffers(1, &meshVbo);
+            if (rangeBuffer) glDeleteBuffers(1, &rangeBuffer);
+            if (textures[0]) glDeleteTextures(4, textures);
+            vao = meshVbo = rangeBuffer = 0;
+            for (int t = 0; t < 4; ++t)
+                textures[t] = 0;
+            ranges.clear();
+            vertexBase = 0;
+            unsupported = false;
+        }
+    };
+
+    // one (placement, bucket) of the ID pass, resolved with the stencil key index + 1
+    struct Key
+    {
+        const void *owner;
+        // a mesh of the bucket (whose textures it binds) and the bucket's Shader::Feature bits
+        unsigned int mesh;
+        unsigned int features;
+        glm::mat4 model;
+        glm::mat4 previousModel;
+        // pixels covered by the bucket's bounds: x, y, width, height
+        glm::ivec4 scissor;
+    };
+
+    // `shaderDir` holds visibility.vs/.fs
+    explicit VisibilityBuffer(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    VisibilityBuffer(const VisibilityBuffer &) = delete;
+    VisibilityBuffer &operator=(const VisibilityBuffer &) = delete;
+
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("VISIBILITY_BUFFER");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the ID pass program
+    void init()
+    {
+        idShader.reset(new Shader((shaderDir + "/visibility.vs").c_str(), (shaderDir + "/visibility.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxBufferTexels);
+        usable = true;
+        LOG_INFO("[VisBuffer] Opaque buckets rasterized to IDs and shaded in one fullscreen pass each");
+    }
+
+    // false before init() or once the ID target turned out unusable (everything then draws forward)
+    bool ready() const { return usable && idShader; }
+
+    // the ID pass program (the caller's FrameData and the model's Object block feed it)
+    Shader &shader() { return *idShader; }
+
+    // GL thread, once per model before its first ID pass: the VAO over the model's shared buffers
+    // (positions and instance matrices like the depth pre-pass, plus `vertexMeshes`) and the buffer
+    // textures. The model's vertices start at `vertexBase` of `vbo`, `indexCount` counts from the start
+    // of `ebo`. False if the buffers don't fit the texel limit of buffer textures.
+    bool prepare(Target &target, GLuint vbo, size_t vertexBase, GLuint ebo, unsigned int indexSize, size_t indexCount, GLuint instanceVbo,
+                 GLuint materialVbo, const std::vector<uint16_t> &vertexMeshes, const std::string &owner)
+    {
+        target.release();
+        const size_t vertexWords = (vertexBase + vertexMeshes.size()) * (sizeof(PackedVertex) / sizeof(GLuint));
+        if (vertexMeshes.empty() || vertexWords > (size_t)maxBufferTexels || indexCount > (size_t)maxBufferTexels)
+        {
+            target.unsupported = true;
+            return false;
+        }
+        glGenBuffers(1, &target.meshVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, target.meshVbo);
+        glBufferData(GL_ARRAY_BUFFER, vertexMeshes.size() * sizeof(uint16_t), &vertexMeshes[0], GL_STATIC_DRAW);
+        gpuMemory().trackBuffer(target.meshVbo, GpuMemory::MODEL_GEOMETRY, vertexMeshes.size() * sizeof(uint16_t), owner);
+        glGenVertexArrays(1, &target.vao);
+        // bound before the direct state access calls: a glGenVertexArrays name is only a VAO once bound
+        glState().bindVertexArray(target.vao);
+        VertexFormats::setup<PackedPositionFormat>(target.vao, vbo, vertexBase * sizeof(PackedVertex));
+        VertexFormats::setup<MaterialIndexFormat>(target.vao, target.meshVbo);
+        glState().bindVertexArray(target.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        Mesh::setupInstanceFormat(target.vao, instanceVbo, 0);
+        glState().bindVertexArray(0);
+        glGenBuffers(1, &target.rangeBuffer);
+        glGenTextures(4, target.textures);
+        const GLuint buffers[4] = {vbo, ebo, target.rangeBuffer, materialVbo};
+        const GLenum formats[4] = {GL_R32UI, indexSize == 2 ? (GLenum)GL_R16UI : (GLenum)GL_R32UI, GL_RG32I, GL_R16UI};
+        for (int t = 0; t < 4; ++t)
+        {
+            glBindTexture(GL_TEXTURE_BUFFER, target.textures[t]);
+            glTexBuffer(GL_TEXTURE_BUFFER, formats[t], buffers[t]);
+        }
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glState().invalidate();
+        target.vertexBase = (GLint)vertexBase;
+        return true;
+    }
+
+    // the meshes' current index ranges (first index of the LOD drawn, base vertex); uploads on change
+    void updateRanges(Target &target, const std::vector<glm::ivec2> &ranges, const std::string &owner)
+    {
+        if (ranges == target.ranges)
+            return;
+        target.ranges = ranges;
+        glBindBuffer(GL_TEXTURE_BUFFER, target.rangeBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, ranges.size() * sizeof(glm::ivec2), &ranges[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        gpuMemory().trackBuffer(target.rangeBuffer, GpuMemory::DRAW_BUFFERS, ranges.size() * sizeof(glm::ivec2), owner);
+    }
+
+    // GL thread, after the main view's clear: (re)creates the ID target over `depthStencil`
+    // (ToneMapper::depthTarget, `width` x `height`), clears the IDs and the stencil keys and starts writing
+    // keys where the depth test passes. The scene framebuffer is bound again on return, with key 0 for
+    // forward draws. False if the target can't be used.
+    bool begin(int width, int height, GLuint depthStencil)
+    {
+        keys.clear();
+        if (!ready() || width <= 0 || height <= 0 || !depthStencil)
+            return false;
+        createTarget(width, height, depthStencil);
+        if (!usable)
+            return false;
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        const GLuint empty[4] = {EMPTY_ID, EMPTY_ID, EMPTY_ID, EMPTY_ID};
+        const GLint zero = 0;
+        glClearBufferuiv(GL_COLOR, 0, empty);
+        glClearBufferiv(GL_STENCIL, 0, &zero);
+        glEnable(GL_STENCIL_TEST);
+        glStencilMask(0xff);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        bindScene();
+        active = true;
+        return true;
+    }
+
+    // between begin() and resolve(): whether this frame uses the ID pass
+    bool isActive() const { return active; }
+
+    // the ID pass of a model; the forward draws of the same model follow with bindScene()
+    void bindIds() const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+
+    // back to the scene framebuffer for forward draws, which clear the key of the pixels they cover
+    void bindScene() const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glStencilFunc(GL_ALWAYS, 0, 0xff);
+    }
+
+    // a new stencil key for a bucket covering `boundsMin`..`boundsMax` (model space) under `clip`
+    // (viewProjection * model), set as the reference of the following ID draws; 0 once all are taken
+    unsigned int addKey(const void *owner, unsigned int mesh, unsigned int features, const glm::mat4 &model, const glm::mat4 &previousModel,
+                        const glm::mat4 &clip, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+    {
+        if (keys.size() >= MAX_KEYS)
+            return 0;
+        Key key = {owner, mesh, features, model, previousModel, screenRect(clip, boundsMin, boundsMax)};
+        if (key.scissor.z <= 0 || key.scissor.w <= 0)
+            return 0;
+        keys.push_back(key);
+        const unsigned int ref = (unsigned int)keys.size();
+        glStencilFunc(GL_ALWAYS, (GLint)ref, 0xff);
+        return ref;
+    }
+
+    const std::vector<Key> &frameKeys() const { return keys; }
+
+    // GL thread, after the opaque draws: the state of the resolve draws (scene framebuffer, ID texture,
+    // stencil equal to the key, no depth test or writes). The models then call resolveKey() per key of theirs.
+    void beginResolve()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_SCISSOR_TEST);
+        glState().bindTexture(UNIT_IDS, GL_TEXTURE_2D, idTexture);
+    }
+
+    // binds a model's buffer textures for its resolve draws (buffer textures aren't tracked by the state cache)
+    void bindTarget(const Target &target) const
+    {
+        const unsigned int units[4] = {UNIT_VERTICES, UNIT_INDICES, UNIT_RANGES, UNIT_MATERIALS};
+        for (int t = 0; t < 4; ++t)
+        {
+            glState().activeTexture(units[t]);
+            glBindTexture(GL_TEXTURE_BUFFER, target.textures[t]);
+        }
+    }
+
+    // the fullscreen triangle of key `k` (index into frameKeys()), with the program, material and Object
+    // block of its bucket in place
+    void resolveKey(size_t k)
+    {
+        const Key &key = keys[k];
+        glStencilFunc(GL_EQUAL, (GLint)(k + 1), 0xff);
+        glScissor(key.scissor.x, key.scissor.y, key.scissor.z, key.scissor.w);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+    }
+
+    // GL thread, after the resolve draws: the default state back
+    void endResolve()
+    {
+        glDisable(GL_SCISSOR_TEST);
+        glDisable(GL_STENCIL_TEST);
+        glStencilFunc(GL_ALWAYS, 0, 0xff);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+        active = false;
+    }
+
+    void releaseGpu()
+    {
+        releaseTarget();
+        idShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    bool usable = false;
+    bool active = false;
+    std::unique_ptr<Shader> idShader;
+    // the resolve draws a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    GLint maxBufferTexels = 0;
+    // R32UI IDs over the scene's depth-stencil buffer (not owned)
+    GLuint fbo = 0;
+    GLuint idTexture = 0;
+    GLuint attachedDepth = 0;
+    int targetWidth = 0, targetHeight = 0;
+    std::vector<Key> keys;
+
+    // pixel rectangle of the box's projection, the whole target when it crosses the camera plane
+    glm::ivec4 screenRect(const glm::mat4 &clip, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) const
+    {
+        glm::vec2 lo(1.0f), hi(-1.0f);
+        for (int c = 0; c < 8; ++c)
+        {
+            const glm::vec3 corner((c & 1) ? boundsMax.x : boundsMin.x, (c & 2) ? boundsMax.y : boundsMin.y, (c & 4) ? boundsMax.z : boundsMin.z);
+            const glm::vec4 p = clip * glm::vec4(corner, 1.0f);
+            if (p.w <= 1e-6f)
+                return glm::ivec4(0, 0, targetWidth, targetHeight);
+            const glm::vec2 ndc = glm::vec2(p) / p.w;
+            lo = glm::min(lo, ndc);
+            hi = glm::max(hi, ndc);
+        }
+        lo = glm::clamp(lo, glm::vec2(-1.0f), glm::vec2(1.0f));
+        hi = glm::clamp(hi, glm::vec2(-1.0f), glm::vec2(1.0f));
+        const glm::vec2 size((float)targetWidth, (float)targetHeight);
+        const glm::ivec2 x0 = glm::ivec2(glm::floor((lo * 0.5f + 0.5f) * size));
+        const glm::ivec2 x1 = glm::ivec2(glm::ceil((hi * 0.5f + 0.5f) * size));
+        return glm::ivec4(x0, x1 - x0);
+    }
+
+    void createTarget(int width, int height, GLuint depthStencil)
+    {
+        if (fbo && width == targetWidth && height == targetHeight && depthStencil == attachedDepth)
+            return;
+        releaseTarget();
+        targetWidth = width;
+        targetHeight = height;
+        attachedDepth = depthStencil;
+        glGenTextures(1, &idTexture);
+        glBindTexture(GL_TEXTURE_2D, idTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, width, height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, idTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthStencil);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[VisBuffer] R32UI ID target unsupported, drawing the opaque pass forward");
+            usable = false;
+            releaseTarget();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTarget()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (idTexture) glDeleteTextures(1, &idTexture);
+        fbo = idTexture = attachedDepth = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
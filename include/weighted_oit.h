@@ -0,0 +1,194 @@
+#ifndef WEIGHTED_OIT_H
+#define WEIGHTED_OIT_H
+
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <draw_stats.h>
+#include <gl_state.h>
+#include <shader.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+// Weighted blended order-independent transparency (OIT=1) for the meshes marked Mesh::weightedBlend.
+// Per frame, after the opaque and sorted transparent draws:
+//   1. begin() copies the scene depth (glState().sceneFramebuffer()) into the OIT framebuffer and clears its two targets
+//   2. the models draw their weighted meshes (Model::drawWeightedTransparent) with the OIT_ACCUM variant of
+//      the scene shader, which writes depth-weighted premultiplied colour to the accumulation target and
+//      -log(1 - alpha) to the revealage target; both blend additively, so no sorting is needed
+//   3. resolve() composites the weighted average colour over the scene with coverage
+//      1 - exp(-sum) = 1 - prod(1 - alpha)
+// Storing the log of the revealage keeps one glBlendFunc for both targets (per-target blending is GL 4.0).
+class WeightedOIT
+{
+public:
+    // texture units of the two targets during resolve() (13 is the occlusion culler's)
+    static const unsigned int UNIT_ACCUM = 14;
+    static const unsigned int UNIT_REVEALAGE = 15;
+
+    // `shaderDir` holds oit_resolve.vs/.fs
+    explicit WeightedOIT(const std::string &shaderDir)
+        : shaderDir(shaderDir)
+    {
+    }
+
+    WeightedOIT(const WeightedOIT &) = delete;
+    WeightedOIT &operator=(const WeightedOIT &) = delete;
+
+    // OIT=1 turns it on; Model::weightedBlendEnabled() reads the same variable
+    static bool enabledByEnv()
+    {
+        const char *env = std::getenv("OIT");
+        return env && std::string(env) == "1";
+    }
+
+    // GL thread: compiles the resolve program
+    void init()
+    {
+        resolveShader.reset(new Shader((shaderDir + "/oit_resolve.vs").c_str(), (shaderDir + "/oit_resolve.fs").c_str()));
+        glGenVertexArrays(1, &emptyVao);
+        usable = true;
+        LOG_INFO("[OIT] Weighted blended transparency for glass and lamp covers");
+    }
+
+    // false before init() or once the targets turned out unusable (the weighted meshes then blend unsorted)
+    bool ready() const { return usable && resolveShader; }
+
+    // GL thread: binds the OIT framebuffer (window-sized, `width` x `height`) with the scene's depth and
+    // the blend function of the accumulation pass (the weighted draws enable blending themselves). False
+    // if the targets can't be used.
+    bool begin(int width, int height)
+    {
+        if (!ready() || width <= 0 || height <= 0)
+            return false;
+        createTargets(width, height);
+        if (!usable)
+            return false;
+        if (!blitChecked)
+            while (glGetError() != GL_NO_ERROR)
+            {
+            }
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, glState().sceneFramebuffer());
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        if (!blitChecked)
+        {
+            // the blit needs the copy to match the scene's depth format
+            blitChecked = true;
+            if (glGetError() != GL_NO_ERROR)
+            {
+                LOG_WARN("[OIT] Can't copy the scene depth buffer (format mismatch), blending unsorted");
+                glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+                usable = false;
+                return false;
+            }
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        const GLfloat zero[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 0, zero);
+        glClearBufferfv(GL_COLOR, 1, zero);
+        glDepthMask(GL_FALSE);
+        glBlendFunc(GL_ONE, GL_ONE);
+        return true;
+    }
+
+    // GL thread, after the weighted draws: back to the scene framebuffer and the default blending, then one
+    // fullscreen pass compositing the targets
+    void resolve()
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, glState().sceneFramebuffer());
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        resolveShader->use();
+        resolveShader->setInt("accumulation", (int)UNIT_ACCUM);
+        resolveShader->setInt("revealage", (int)UNIT_REVEALAGE);
+        glState().bindTexture(UNIT_ACCUM, GL_TEXTURE_2D, accumTexture);
+        glState().bindTexture(UNIT_REVEALAGE, GL_TEXTURE_2D, revealageTexture);
+        glState().bindVertexArray(emptyVao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        drawStats().count();
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+    }
+
+    void releaseGpu()
+    {
+        releaseTargets();
+        resolveShader.reset();
+        if (emptyVao) glDeleteVertexArrays(1, &emptyVao);
+        emptyVao = 0;
+        glState().invalidate();
+    }
+
+private:
+    std::string shaderDir;
+    bool usable = false;
+    bool blitChecked = false;
+    std::unique_ptr<Shader> resolveShader;
+    // resolve() draws a fullscreen triangle from gl_VertexID; core profiles still need a VAO bound
+    GLuint emptyVao = 0;
+    // RGBA16F sum of weighted premultiplied colour (alpha: sum of weights), R16F sum of -log(1 - alpha)
+    // and a depth copy of the window for testing against the opaque scene
+    GLuint fbo = 0;
+    GLuint accumTexture = 0;
+    GLuint revealageTexture = 0;
+    GLuint depthBuffer = 0;
+    int targetWidth = 0, targetHeight = 0;
+
+    void createTargets(int width, int height)
+    {
+        if (fbo && width == targetWidth && height == targetHeight)
+            return;
+        releaseTargets();
+        targetWidth = width;
+        targetHeight = height;
+        GLuint *textures[2] = {&accumTexture, &revealageTexture};
+        const GLenum formats[2] = {GL_RGBA16F, GL_R16F};
+        const GLenum layouts[2] = {GL_RGBA, GL_RED};
+        for (int t = 0; t < 2; ++t)
+        {
+            glGenTextures(1, textures[t]);
+            glBindTexture(GL_TEXTURE_2D, *textures[t]);
+            glTexImage2D(GL_TEXTURE_2D, 0, formats[t], width, height, 0, layouts[t], GL_HALF_FLOAT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        // GLFW's default framebuffer is 24-bit depth + 8-bit stencil; blits need the same format
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumTexture, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, revealageTexture, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+        const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+        glDrawBuffers(2, drawBuffers);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            LOG_WARN("[OIT] Float render targets unsupported, blending unsorted");
+            usable = false;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // the binds above went around the state cache
+        glState().invalidate();
+    }
+
+    void releaseTargets()
+    {
+        if (fbo) glDeleteFramebuffers(1, &fbo);
+        if (accumTexture) glDeleteTextures(1, &accumTexture);
+        if (revealageTexture) glDeleteTextures(1, &revealageTexture);
+        if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+        fbo = accumTexture = revealageTexture = depthBuffer = 0;
+        targetWidth = targetHeight = 0;
+    }
+};
+
+#endif
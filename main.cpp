@@ -5,15 +5,85 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <async_log.h>
+#include <atmosphere.h>
+#include <engine_clock.h>
+#include <startup_timings.h>
 #include <shader.h>
 #include <camera.h>
+#include <orbit_camera.h>
 #include <model.h>
+#include <model_loader.h>
+#include <model_cache.h>
+#include <render_debug.h>
+#include <debug_views.h>
+#include <cull_debug.h>
+#include <render_graph.h>
+#include <gl_backend.h>
+#include <brdf_lut.h>
+#include <ltc_lut.h>
+#include <environment_loader.h>
+#include <reflection_probes.h>
+#include <irradiance_volume.h>
+#include <clustered_lights.h>
+#include <shadow_cascades.h>
+#include <gpu_profiler.h>
+#include <idle_renderer.h>
+#include <benchmark.h>
+#include <batch_renderer.h>
+#include <poster_renderer.h>
+#include <perf_hud.h>
+#include <frame_data.h>
+#include <frame_arena.h>
+#include <weighted_oit.h>
+#include <visibility_buffer.h>
+#include <gpu_picker.h>
+#include <gl_handle.h>
+#include <ambient_occlusion.h>
+#include <screen_space_reflections.h>
+#include <ray_traced_reflections.h>
+#include <shading_rate.h>
+#include <refraction_copy.h>
+#include <skybox.h>
+#include <impostors.h>
+#include <virtual_texture.h>
+#include <decal_compositor.h>
+#include <bloom.h>
+#include <auto_exposure.h>
+#include <still_accumulator.h>
+#include <path_tracer.h>
+#include <stereo_renderer.h>
+#include <view_atlas.h>
+#include <temporal_aa.h>
+#include <tone_mapper.h>
+#include <dynamic_resolution.h>
+#include <frame_capture.h>
+#include <frame_share.h>
+#include <frame_streamer.h>
+#include <session_views.h>
+#include <frame_pacer.h>
+#include <scene_snapshot.h>
+#include <scene_description.h>
+#include <hot_reload.h>
+#include <upload_thread.h>
+#include <bvh.h>
+#include <gl_capture.h>
+#include <input_actions.h>
+#include <input_log.h>
+#include <kiosk_displays.h>
+#include <vehicle_sim.h>
+#include <chrono>
+#include <atomic>
+#include <deque>
 #include <string>
+#include <thread>
 
 #include <iostream>
 #include <cstdio>
 #include <algorithm>
+#include <cctype>
 #include <cfloat>
+#include <cmath>
 #include <cstdlib>
 #include "stb_image_write.h"
 
@@ -24,92 +94,103 @@
 void framebuffer_size_callback(GLFWwindow *window, int width, int height);
 void mouse_callback(GLFWwindow *window, double xpos, double ypos);
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
-void processInput(GLFWwindow *window);
+void drop_callback(GLFWwindow *window, int count, const char **paths);
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods);
+void window_refresh_callback(GLFWwindow *window);
+void processInput(const InputActions::Step &step);
+void publishInput(GLFWwindow *window);
 
 const std::string currDir = "pat/to/your/project"; // <-- set this to your project path
 
-static void glCheck(const char *where)
-{
-    GLenum err;
-    bool ok = true;
-    while ((err = glGetError()) != GL_NO_ERROR)
-    {
-        fprintf(stderr, "GL error at %s: 0x%X\n", where, err);
-        // Extra diagnostics to aid debugging of INVALID_OPERATION (0x502)
-        GLint curProg = 0;
-        glGetIntegerv(GL_CURRENT_PROGRAM, &curProg);
-        fprintf(stderr, "  GL_CURRENT_PROGRAM = %d\n", curProg);
-        GLint vao = 0;
-        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
-        fprintf(stderr, "  GL_VERTEX_ARRAY_BINDING = %d\n", vao);
-        GLint ebo = 0;
-        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ebo);
-        fprintf(stderr, "  GL_ELEMENT_ARRAY_BUFFER_BINDING = %d\n", ebo);
-        GLint activeTex = 0;
-        glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTex);
-        GLint maxTexUnits = 0;
-        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTexUnits);
-        fprintf(stderr, "  GL_ACTIVE_TEXTURE = 0x%X, MAX_COMBINED_TEXTURE_IMAGE_UNITS = %d\n", activeTex, maxTexUnits);
-        // Print bindings for the first few texture units to avoid huge output
-        int inspectUnits = std::min(maxTexUnits, 8);
-        for (int u = 0; u < inspectUnits; ++u)
-        {
-            GLenum unit = GL_TEXTURE0 + u;
-            glActiveTexture(unit);
-            GLint bound2D = 0;
-            glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound2D);
-            fprintf(stderr, "    Unit %d (GL_TEXTURE0+%d) bound 2D=%d\n", u, u, bound2D);
-        }
-        // restore active texture
-        glActiveTexture(activeTex);
-        ok = false;
-    }
-    if (ok)
-    {
-        printf("GL OK: %s\n", where);
-    }
-    else
-    {
-        // If the user set SINGLE_ERROR_DUMP=1, stop the process after the first dump to avoid huge logs
-        const char *sed = std::getenv("SINGLE_ERROR_DUMP");
-        if (sed && std::string(sed) == "1")
-        {
-            std::cerr << "SINGLE_ERROR_DUMP=1: exiting after first GL error dump to avoid log flood." << std::endl;
-            // flush stdout/stderr and exit so user can capture this single block
-            fflush(stdout);
-            fflush(stderr);
-            exit(1);
-        }
-    }
-}
-
 // settings
 const unsigned int SCR_WIDTH = 2000;
 const unsigned int SCR_HEIGHT = 1000;
 
-// camera
+// camera: the renderer's, copied from input.camera once per frame (takeSnapshot in main)
 Camera camera(glm::vec3(0.0f, 0.0f, 2.0f));
 float lastX = SCR_WIDTH / 2.0f;
 float lastY = SCR_HEIGHT / 2.0f;
 bool firstMouse = true;
 
-// per-model offsets (so we can place/move the second model independently)
+// per-model offsets (so we can place/move the second model independently); the renderer's copy of input.carOffset
 glm::vec3 carOffset = glm::vec3(3.0f, 0.0f, 0.0f);
-// toggle to display brief help for model controls
+// VEHICLE_SIM: where the simulation has driven the movable models since they were placed (identity without it)
+glm::mat4 carPose = glm::mat4(1.0f);
+// toggle to display brief help for model controls (input's; the renderer reads SceneSnapshot::showModelControlHelp)
 bool showModelControlHelp = true;
-// control mode: false = camera control (arrow keys move camera), true = model control (arrow keys move CarModel)
+// control mode: false = camera control (arrow keys move camera), true = model control (arrow keys move the movable models)
 bool controlModeModel = false;
 // lock models in place by default so camera movement won't accidentally move them
 bool carLocked = true;
 
 // timing
+// .exr files dropped on the window, loaded as the new environment by the render loop
+std::vector<std::string> droppedEnvironments;
+// fallback sky when no EXR is loaded; [ ] turn the sun, ; ' lower/raise it, - = dim/brighten it (input.sky,
+// copied here when it changes). Active is the renderer's, read by input too.
+ProceduralSky proceduralSky;
+std::atomic<bool> proceduralSkyActive(false);
+bool proceduralSkyChanged = false;
+// left click picks the mesh under the crosshair (the cursor is captured, so the pick ray is the view axis)
+bool pickRequested = false;
+// the last pick's surface point with TRIANGLE_PICKING=1 (exact hits), which the next pick measures from
+glm::vec3 lastPickPoint;
+bool hasLastPickPoint = false;
+// O shows / hides the performance HUD (PerfHud)
+bool hudToggleRequested = false;
+// T: next tone-mapping curve
+bool toneCurveCycleRequested = false;
+// V: next variant of the scene's configurator model (SceneDescription::ModelEntry::variants)
+bool variantCycleRequested = false;
+// N: next KHR_materials_variants variant (paint, trim) of the focused model
+bool materialVariantCycleRequested = false;
+// B: next paint of the scene's palette on the paint materials (MaterialOverrides)
+bool paintCycleRequested = false;
+// K: hide the focused model's next configurable part (CONFIG_PARTS)
+bool partCycleRequested = false;
+// G: next debug view (DebugViews)
+bool debugViewCycleRequested = false;
+// F: freeze / release the culling camera (CullDebug)
+bool cullFreezeRequested = false;
+// any window event since the last frame: wakes an idle loop (IDLE_RENDER)
+bool redrawRequested = false;
+// C steps input's camera through the scene's camera presets (SceneDescription)
+std::vector<SceneDescription::CameraPreset> cameraPresets;
+
 float deltaTime = 0.0f;
-float lastFrame = 0.0f;
+double lastFrame = 0.0; // EngineClock seconds (or the benchmark's / batch job's simulated time)
+
+// input and simulation: the GLFW callbacks and processInput write only this (on the main thread) and the
+// renderer sees it through SceneSnapshot, so RENDER_THREAD=1 can run the renderer on a thread of its own.
+// The request flags above are the renderer's, set from the InputEvents that come with a snapshot.
+struct InputState
+{
+    Camera camera = Camera(glm::vec3(0.0f, 0.0f, 2.0f));
+    glm::vec3 carOffset = glm::vec3(3.0f, 0.0f, 0.0f);
+    ProceduralSky sky;
+    OrbitCamera orbit; // ORBIT_CAMERA: drives `camera` once the renderer names a model to orbit
+    VehicleSim::Controls drive; // VEHICLE_SIM: the player's car, from the arrows in model mode
+    InputEvents events; // since the last publish
+    FrameStreamer::RemoteInput remote; // STREAM_PORT: keys held and pointer motion from the browsers
+    InputActions actions; // the window's keys, pointer, wheel and clicks since the last step
+    float deltaTime = 0.0f;
+    double lastTime = -1.0;
+};
+InputState input;
+SnapshotExchange snapshots;
+// VEHICLE_SIM=1: the player's and the AI cars' physics, stepped with input (started by the renderer)
+VehicleSim vehicleSim;
+// INPUT_RECORD=<file> / INPUT_REPLAY=<file>: the session's input, written out or played back at a fixed step
+InputLog inputLog;
+FrameStreamer streamer;
+FrameShare frameShare;
 
 int main()
 {
     // glfw: initialize and configure
     // ------------------------------
+    EngineClock::start(); // startup timings count from here
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
@@ -118,31 +199,64 @@ int main()
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
+    // debug builds ask for a debug context so the GL debug-output callback receives messages
+    if (RenderDebug::Level >= 1)
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
+    // BATCH_JOB=<job.json> renders the job's shots offscreen and exits; the window stays hidden. BATCH_FARM
+    // does the same for the chunks of a job car_farm hands out
+    BatchRenderer batch;
+    // POSTER=<width>x<height> renders one still of any size in tiles, streamed to a PNG, and exits
+    PosterRenderer poster;
+    if (batch.enabled() || poster.enabled())
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     // glfw window creation
     // --------------------
     GLFWwindow *window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Car Game", NULL, NULL);
     if (window == NULL)
     {
-        std::cout << "Failed to create GLFW window" << std::endl;
+        LOG_ERROR("Failed to create GLFW window");
         glfwTerminate();
         return -1;
     }
     glfwMakeContextCurrent(window);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetScrollCallback(window, scroll_callback);
-
-    // tell GLFW to capture our mouse
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    // BENCHMARK=1 flies a scripted camera path with vsync off and exits; mouse input would change the frames
+    Benchmark benchmark;
+    // VSYNC, MAX_FRAMES_IN_FLIGHT and FPS_CAP; the offline modes swap unthrottled
+    FramePacer pacer;
+    pacer.applySwapInterval(benchmark.enabled() || batch.enabled() || poster.enabled() || inputLog.replaying());
+    if (!benchmark.enabled() && !batch.enabled() && !poster.enabled())
+    {
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+        glfwSetDropCallback(window, drop_callback);
+        glfwSetMouseButtonCallback(window, mouse_button_callback);
+        // the callbacks queue their input for the next input step (InputActions)
+        glfwSetKeyCallback(window, key_callback);
+        glfwSetWindowRefreshCallback(window, window_refresh_callback);
+
+        // tell GLFW to capture our mouse
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    }
 
     // glad: load all OpenGL function pointers
     // ---------------------------------------
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
-        std::cout << "Failed to initialize GLAD" << std::endl;
+        LOG_ERROR("Failed to initialize GLAD");
         return -1;
     }
+    RenderDebug::installMessageCallback();
+    // GL 4.5: textures, buffers and vertex layouts are created and edited by name (GL_DSA=0: bind to edit)
+    glBackend().init();
+    // TRACE_CAPTURE: label this thread's track; loader and decode threads show by number
+    frameTrace().nameThread("GL thread");
+    // KHR_texture_basisu: the decode workers transcode colour to BC7 where the driver samples it
+    ktx2ToBc7() = bptcSupported();
+    // UPLOAD_THREAD=1: model textures upload on a second context sharing this one
+    if (UploadThread::enabledByEnv())
+        uploadThread().start(window);
 
     // Quick EXR-only probe mode: if the user set EXR_DUMP_ONLY=1, attempt to load the EXR
     // and print the result, then exit. This lets us capture tinyexr diagnostics without
@@ -158,14 +272,14 @@ int main()
                 exrPath = std::string(envPath);
             if (exrPath.empty())
                 exrPath = currDir + "/river_alcove_1k.exr";
-            std::cout << "[EXR_DUMP_ONLY] EXR path: '" << exrPath << "'" << std::endl;
+            LOG_INFO("[EXR_DUMP_ONLY] EXR path: '" << exrPath << "'");
             const char *err = nullptr;
             float *img = nullptr;
             int w = 0, h = 0;
             int ret = LoadEXR(&img, &w, &h, exrPath.c_str(), &err);
             if (ret == TINYEXR_SUCCESS && img != nullptr)
             {
-                std::cout << "[EXR_DUMP_ONLY] LoadEXR succeeded: " << w << "x" << h << " (RGBA float)" << std::endl;
+                LOG_INFO("[EXR_DUMP_ONLY] LoadEXR succeeded: " << w << "x" << h << " (RGBA float)");
                 free(img);
                 // exit after reporting
                 return 0;
@@ -174,12 +288,12 @@ int main()
             {
                 if (err)
                 {
-                    std::cerr << "[EXR_DUMP_ONLY] tinyexr load error: " << err << std::endl;
+                    LOG_WARN("[EXR_DUMP_ONLY] tinyexr load error: " << err);
                     FreeEXRErrorMessage(err);
                 }
                 else
                 {
-                    std::cerr << "[EXR_DUMP_ONLY] LoadEXR failed (unknown error)" << std::endl;
+                    LOG_WARN("[EXR_DUMP_ONLY] LoadEXR failed (unknown error)");
                 }
                 return 1;
             }
@@ -195,207 +309,362 @@ int main()
     // configure global opengl state
     // -----------------------------
     glEnable(GL_DEPTH_TEST);
-    // enable alpha blending for glTF materials that use alpha mode=BLEND (e.g., glass)
-    glEnable(GL_BLEND);
+    // alpha blending for glTF materials with alphaMode BLEND (e.g., glass); the transparent passes enable
+    // it around their draws, everything else is drawn without
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // build and compile shaders
     // -------------------------
+    // one program for every scene model: the material and model uniforms are set per draw anyway
     Shader ourShader((currDir + "/shaders/model_loading.vs").c_str(), (currDir + "/shaders/model_loading.fs").c_str());
-    // Secondary shader instance for the second model (uses the same shader source files
-    // but kept as a separate variable so we can tweak uniforms or behavior independently).
-    Shader carShader((currDir + "/shaders/model_loading.vs").c_str(), (currDir + "/shaders/model_loading.fs").c_str());
+    // reflection probe captures: the same shader writing linear, premultiplied HDR without sampling probes
+    Shader probeShader((currDir + "/shaders/model_loading.vs").c_str(), (currDir + "/shaders/model_loading.fs").c_str(), "#define PROBE_CAPTURE 1\n");
+    // DEPTH_PREPASS=1: positions only, drawn before the opaque colour pass (Model::drawDepthPrepass)
+    Shader depthShader((currDir + "/shaders/depth_prepass.vs").c_str(), (currDir + "/shaders/depth_prepass.fs").c_str());
+    // OIT=1: the same shader writing the weighted blended transparency targets (WeightedOIT)
+    Shader oitShader((currDir + "/shaders/model_loading.vs").c_str(), (currDir + "/shaders/model_loading.fs").c_str(), "#define OIT_ACCUM 1\n");
+    // VISIBILITY_BUFFER=1: the same shader shading the visibility buffer's IDs over a fullscreen triangle
+    Shader visibilityResolveShader((currDir + "/shaders/oit_resolve.vs").c_str(), (currDir + "/shaders/model_loading.fs").c_str(), "#define VISIBILITY_RESOLVE 1\n");
+    // STEREO=1: the same shader drawing both eyes at once through model_stereo.gs (StereoRenderer)
+    StereoRenderer stereo(currDir + "/shaders");
 
     // load models
     // -----------
-    // FileSystem helper is not present in this project; use the literal path instead
-    Model ourModel(currDir + "/ford_raptor/scene.gltf");
-    Model CarModel(currDir + "/models/2024_ford_shelby_super_snake_s650/scene.gltf");
-
-    std::cout << "Loaded Model objects (ourModel and CarModel constructed)." << std::endl;
-
-    // Print a concise summary so the user can quickly confirm the model loaded
+    // SCENE=<scene.json> says which (SceneDescription; the built-in showroom otherwise). Every model imports
+    // on the worker pool at once while the render loop is already running, and is placed as soon as its
+    // geometry is on the GPU; its textures stream in over the next frames, decoded once however many models
+    // share them (TextureCache). ASYNC_LOAD=0 blocks here until everything is loaded, as before.
+    SceneDescription sceneDescription;
+    sceneDescription.load(currDir);
+    cameraPresets = sceneDescription.cameras;
+    // one Model per distinct path (deque: the loader holds on to them while they import)
+    std::deque<Model> sceneModels;
+    // the variants V browses through, loaded on first use (declared first: the loader waits for its imports)
+    ModelCache modelCache;
+    ModelLoader modelLoader;
+    for (size_t i = 0; i < sceneDescription.models.size(); ++i)
     {
-        size_t meshCount = ourModel.meshes.size();
-        size_t texCount = ourModel.textures_loaded.size();
-        size_t totalVerts = 0;
-        for (const auto &m : ourModel.meshes)
-            totalVerts += m.vertices.size();
-        std::cout << "Model summary: meshes=" << meshCount << " totalVertices=" << totalVerts << " texturesLoaded=" << texCount << std::endl;
-        if (meshCount == 0)
-        {
-            std::cout << "WARNING: Model has 0 meshes. Nothing will render." << std::endl;
-        }
+        sceneModels.emplace_back();
+        modelLoader.load(sceneModels.back(), sceneDescription.models[i].path);
     }
-
-    // Compute bounding box for the second model (CarModel) so we can place it independently
-    glm::vec3 carBBoxMin(FLT_MAX), carBBoxMax(-FLT_MAX);
-    for (const auto &mesh : CarModel.meshes)
+    // PARKING_LOT copies follow this one
+    Model *parkingModel = NULL;
+    for (size_t i = 0; i < sceneDescription.models.size() && !parkingModel; ++i)
+        if (sceneDescription.models[i].parkingLot)
+            parkingModel = &sceneModels[i];
+    if (const char *al = std::getenv("ASYNC_LOAD"))
     {
-        for (const auto &v : mesh.vertices)
+        if (std::string(al) == "0")
         {
-            carBBoxMin.x = std::min(carBBoxMin.x, v.Position.x);
-            carBBoxMin.y = std::min(carBBoxMin.y, v.Position.y);
-            carBBoxMin.z = std::min(carBBoxMin.z, v.Position.z);
-            carBBoxMax.x = std::max(carBBoxMax.x, v.Position.x);
-            carBBoxMax.y = std::max(carBBoxMax.y, v.Position.y);
-            carBBoxMax.z = std::max(carBBoxMax.z, v.Position.z);
+            while (!modelLoader.idle())
+                modelLoader.pump(-1.0);
+            LOG_INFO("Loaded " << sceneModels.size() << " scene models.");
         }
     }
-    glm::vec3 carBBoxCenter = (carBBoxMin + carBBoxMax) * 0.5f;
-    glm::vec3 carBBoxSize = carBBoxMax - carBBoxMin;
-    float carBBoxDiag = glm::length(carBBoxSize);
-    std::cout << "CarModel AABB: min=" << carBBoxMin.x << "," << carBBoxMin.y << "," << carBBoxMin.z
-              << " max=" << carBBoxMax.x << "," << carBBoxMax.y << "," << carBBoxMax.z
-              << " center=" << carBBoxCenter.x << "," << carBBoxCenter.y << "," << carBBoxCenter.z
-              << " size=" << carBBoxSize.x << "," << carBBoxSize.y << "," << carBBoxSize.z
-              << " diag=" << carBBoxDiag << std::endl;
-
-    std::cout << "Finished CarModel bbox compute." << std::endl;
 
     // Small helper to place multiple models with fixed model matrices so they don't move relative to world
     struct PlacedModel
     {
         Model *model;
+        // the scene model entry and placement it came from (a variant switch swaps `model` in place)
+        size_t sceneModel = 0;
+        SceneDescription::Placement placement;
         glm::vec3 bboxMin;
         glm::vec3 bboxMax;
         // baseModelMatrix is the static transform computed at placement time. At draw-time
         // we may left-multiply a translation (for example `carOffset`) when the model is movable.
         glm::mat4 baseModelMatrix;
-        bool movable = false; // whether to apply runtime offset (carOffset) at draw time
+        bool movable = false; // whether to apply runtime offset (carOffset, carPose) at draw time
+        // draw-time matrix and world AABB, cached until the transform or the local bounds change
+        glm::mat4 worldMatrix = glm::mat4(1.0f);
+        glm::vec3 worldMin = glm::vec3(0.0f);
+        glm::vec3 worldMax = glm::vec3(0.0f);
+        glm::vec3 appliedOffset = glm::vec3(0.0f);
+        glm::mat4 appliedPose = glm::mat4(1.0f);
+        bool dirty = true;
+        // worldMatrix as the previous frame's main view drew it (motion vectors for TAA)
+        glm::mat4 previousMatrix = glm::mat4(1.0f);
+        bool drawnBefore = false;
     };
 
     std::vector<PlacedModel> placedModels;
+    // the distinct models of placedModels (a scene model or the variant shown in its place), in scene order
+    std::vector<Model *> drawnModels;
+    // hierarchy over the world bounds of the placed models, for culling, picking and AUTO_FRAME. Each Model
+    // keeps its own tree over its meshes (model space), so the scene tree only changes when models move.
+    BVH sceneTree;
+    // bumped whenever a placed model's cached world matrix or bounds change
+    unsigned int placedRevision = 0;
+
+    // recomputes the cached world matrix and AABB of `pm` (movable ones follow `carOffset` and `carPose`)
+    auto updatePlaced = [&](PlacedModel &pm)
+    {
+        pm.appliedOffset = pm.movable ? carOffset : glm::vec3(0.0f);
+        pm.appliedPose = pm.movable ? carPose : glm::mat4(1.0f);
+        pm.worldMatrix = pm.movable ? carPose * glm::translate(glm::mat4(1.0f), carOffset) * pm.baseModelMatrix : pm.baseModelMatrix;
+        GeometryKernels::transformBounds(pm.worldMatrix, pm.bboxMin, pm.bboxMax, pm.worldMin, pm.worldMax);
+        pm.dirty = false;
+        placedRevision++;
+    };
+
+    // draw-time model matrix of a placed model (cached, see refitSceneTree)
+    auto placedMatrix = [&](const PlacedModel &pm) -> const glm::mat4 &
+    {
+        return pm.worldMatrix;
+    };
 
-    // helper lambda: center model by its bbox center, apply scale, then translate to worldPos
-    // `movable` indicates whether a runtime `carOffset` should be applied at draw-time.
-    auto placeModel = [&](Model &m, const glm::vec3 &bboxMinLocal, const glm::vec3 &bboxMaxLocal, const glm::vec3 &worldPos, float scale = 1.0f, bool movable = false)
+    // the cached world-space AABBs of the placed models, in placement order
+    auto placedWorldBounds = [&]() -> BoundsBatch
+    {
+        BoundsBatch bounds;
+        for (const auto &pm : placedModels)
+            bounds.add(pm.worldMin, pm.worldMax, glm::length(pm.worldMax - pm.worldMin) * 0.5f);
+        return bounds;
+    };
+    auto rebuildSceneTree = [&]()
+    {
+        sceneTree.build(placedWorldBounds());
+    };
+    // GL thread, once per frame: models whose nodes moved refresh their local bounds, and placed models whose
+    // transform (carOffset for movable ones) or bounds changed recompute their cache; their boxes are then
+    // refit into the existing hierarchy
+    auto refitSceneTree = [&]()
+    {
+        bool changed = false;
+        for (auto &pm : placedModels)
+        {
+            if (pm.model->updateNodeTransforms())
+            {
+                pm.bboxMin = pm.model->boundsMin;
+                pm.bboxMax = pm.model->boundsMax;
+                pm.dirty = true;
+            }
+            if (pm.dirty || (pm.movable && (pm.appliedOffset != carOffset || pm.appliedPose != carPose)))
+            {
+                updatePlaced(pm);
+                changed = true;
+            }
+        }
+        if (changed)
+            sceneTree.refit(placedWorldBounds());
+    };
+
+    // helper lambda: places `m` as the scene's `placement` says (SceneDescription::placementMatrix).
+    // `movable` placements get the runtime `carOffset` applied at draw-time.
+    auto placeModel = [&](size_t sceneModel, Model &m, const SceneDescription::Placement &placement)
     {
-        glm::vec3 center = (bboxMinLocal + bboxMaxLocal) * 0.5f;
-        glm::mat4 mm = glm::mat4(1.0f);
-        // move model so its bbox center is at origin, then scale, then translate to world position
-        mm = glm::translate(mm, worldPos);
-        mm = glm::scale(mm, glm::vec3(scale));
-        mm = glm::translate(mm, -center);
         PlacedModel pm;
         pm.model = &m;
-        pm.bboxMin = bboxMinLocal;
-        pm.bboxMax = bboxMaxLocal;
-        pm.baseModelMatrix = mm;
-        pm.movable = movable;
+        pm.sceneModel = sceneModel;
+        pm.placement = placement;
+        pm.bboxMin = m.boundsMin;
+        pm.bboxMax = m.boundsMax;
+        pm.baseModelMatrix = SceneDescription::placementMatrix(placement, m.boundsMin, m.boundsMax);
+        pm.movable = placement.movable;
+        updatePlaced(pm);
         placedModels.push_back(pm);
     };
 
-    // place the main model and secondary car later (after we compute the model bbox)
+    // AUTO_FRAME=1: once every model is placed, frame the combined world bounds (the scene tree's root)
+    auto frameScene = [&]()
+    {
+        const char *af = std::getenv("AUTO_FRAME");
+        if (!af || std::string(af) != "1" || sceneTree.empty())
+            return;
+        glm::vec3 combinedMin = sceneTree.boundsMin(), combinedMax = sceneTree.boundsMax();
+        glm::vec3 combinedCenter = (combinedMin + combinedMax) * 0.5f;
+        glm::vec3 combinedSize = combinedMax - combinedMin;
+        float combinedDiag = glm::length(combinedSize);
+        // position camera to look at combined center from +Z with some offset based on diagonal
+        float dist = combinedDiag * 0.8f;
+        if (dist < 5.0f)
+            dist = 5.0f;
+        camera.Position = combinedCenter + glm::vec3(0.0f, combinedSize.y * 0.3f, dist);
+        camera.Yaw = -90.0f;
+        camera.Pitch = -10.0f;
+        camera.ProcessMouseMovement(0.0f, 0.0f);
+        // input moves on from here
+        snapshots.overrideCamera(camera);
+        LOG_INFO("AUTO_FRAME applied to all placed models: camera.Position=" << camera.Position.x << "," << camera.Position.y << "," << camera.Position.z);
+    };
 
-    // If AUTO_FRAME=1 we will compute a combined world-space AABB for all placed models and position the camera to frame them
-    if (const char *af = std::getenv("AUTO_FRAME"))
+    // summary, bounding box and placements of scene model `index`. Runs once, when it becomes drawable.
+    auto placeSceneModel = [&](size_t index)
     {
-        if (std::string(af) == "1")
+        Model &m = sceneModels[index];
+        // Print a concise summary so the user can quickly confirm the model loaded
+        LOG_INFO("Model summary: '" << sceneDescription.models[index].path << "' meshes=" << m.meshes.size()
+                 << " totalVertices=" << m.vertexCount << " texturesLoaded=" << m.textures_loaded.size());
+        if (m.meshes.empty())
         {
-            // compute combined AABB by transforming bbox corners of each placed model
-            glm::vec3 combinedMin(FLT_MAX), combinedMax(-FLT_MAX);
-            for (const auto &pm : placedModels)
-            {
-                // 8 corners of local bbox
-                glm::vec3 corners[8] = {
-                    {pm.bboxMin.x, pm.bboxMin.y, pm.bboxMin.z},
-                    {pm.bboxMax.x, pm.bboxMin.y, pm.bboxMin.z},
-                    {pm.bboxMin.x, pm.bboxMax.y, pm.bboxMin.z},
-                    {pm.bboxMax.x, pm.bboxMax.y, pm.bboxMin.z},
-                    {pm.bboxMin.x, pm.bboxMin.y, pm.bboxMax.z},
-                    {pm.bboxMax.x, pm.bboxMin.y, pm.bboxMax.z},
-                    {pm.bboxMin.x, pm.bboxMax.y, pm.bboxMax.z},
-                    {pm.bboxMax.x, pm.bboxMax.y, pm.bboxMax.z}};
-                for (int i = 0; i < 8; ++i)
-                {
-                    glm::vec4 wc = pm.baseModelMatrix * glm::vec4(corners[i], 1.0f);
-                    combinedMin.x = std::min(combinedMin.x, wc.x);
-                    combinedMin.y = std::min(combinedMin.y, wc.y);
-                    combinedMin.z = std::min(combinedMin.z, wc.z);
-                    combinedMax.x = std::max(combinedMax.x, wc.x);
-                    combinedMax.y = std::max(combinedMax.y, wc.y);
-                    combinedMax.z = std::max(combinedMax.z, wc.z);
-                }
-            }
-            glm::vec3 combinedCenter = (combinedMin + combinedMax) * 0.5f;
-            glm::vec3 combinedSize = combinedMax - combinedMin;
-            float combinedDiag = glm::length(combinedSize);
-            // position camera to look at combined center from +Z with some offset based on diagonal
-            float dist = combinedDiag * 0.8f;
-            if (dist < 5.0f)
-                dist = 5.0f;
-            camera.Position = combinedCenter + glm::vec3(0.0f, combinedSize.y * 0.3f, dist);
-            camera.Yaw = -90.0f;
-            camera.Pitch = -10.0f;
-            camera.ProcessMouseMovement(0.0f, 0.0f);
-            std::cout << "AUTO_FRAME applied to all placed models: camera.Position=" << camera.Position.x << "," << camera.Position.y << "," << camera.Position.z << std::endl;
+            LOG_WARN("WARNING: Model has 0 meshes. Nothing will render.");
         }
-    }
-
-    // Compute axis-aligned bounding box of loaded model in model space (after per-node transforms baked into vertices)
-    glm::vec3 bboxMin(FLT_MAX), bboxMax(-FLT_MAX);
-    for (const auto &mesh : ourModel.meshes)
+        // axis-aligned bounding box in model space (bounds are computed at load; the CPU vertex copies are
+        // already released)
+        const glm::vec3 size = m.boundsMax - m.boundsMin;
+        LOG_INFO("Model AABB: min=" << m.boundsMin.x << "," << m.boundsMin.y << "," << m.boundsMin.z
+                 << " max=" << m.boundsMax.x << "," << m.boundsMax.y << "," << m.boundsMax.z
+                 << " size=" << size.x << "," << size.y << "," << size.z << " diag=" << glm::length(size));
+        // its material variants compile on the driver's threads; the first draw finds them ready, or close to it
+        m.prepareVariants(ourShader);
+        m.prepareVariants(probeShader);
+        if (stereo.ready())
+            m.prepareVariants(stereo.shader());
+        const std::vector<SceneDescription::Placement> &placements = sceneDescription.models[index].placements;
+        for (size_t k = 0; k < placements.size(); ++k)
+            placeModel(index, m, placements[k]);
+        drawnModels.push_back(&m);
+        rebuildSceneTree();
+    };
+    // VEHICLE_SIM: the first movable placement becomes the player's car, its body frame at the centre of its
+    // world box with +z along the box's longer side; the fixed placements are what the wheels stand on
+    glm::mat4 vehicleSpawn(1.0f);
+    size_t vehiclePlaced = 0;
+    bool vehicleSimStarted = false;
+    auto startVehicleSim = [&]()
     {
-        for (const auto &v : mesh.vertices)
+        if (vehicleSimStarted || !VehicleSim::enabledByEnv())
+            return;
+        vehiclePlaced = placedModels.size();
+        for (size_t i = 0; i < placedModels.size() && vehiclePlaced == placedModels.size(); ++i)
+            if (placedModels[i].movable)
+                vehiclePlaced = i;
+        if (vehiclePlaced == placedModels.size())
         {
-            bboxMin.x = std::min(bboxMin.x, v.Position.x);
-            bboxMin.y = std::min(bboxMin.y, v.Position.y);
-            bboxMin.z = std::min(bboxMin.z, v.Position.z);
-            bboxMax.x = std::max(bboxMax.x, v.Position.x);
-            bboxMax.y = std::max(bboxMax.y, v.Position.y);
-            bboxMax.z = std::max(bboxMax.z, v.Position.z);
+            LOG_WARN("[VehicleSim] No movable model in the scene to drive");
+            return;
         }
-    }
-    glm::vec3 bboxCenter = (bboxMin + bboxMax) * 0.5f;
-    glm::vec3 bboxSize = bboxMax - bboxMin;
-    float bboxDiag = glm::length(bboxSize);
-    std::cout << "Model AABB: min=" << bboxMin.x << "," << bboxMin.y << "," << bboxMin.z
-              << " max=" << bboxMax.x << "," << bboxMax.y << "," << bboxMax.z
-              << " center=" << bboxCenter.x << "," << bboxCenter.y << "," << bboxCenter.z
-              << " size=" << bboxSize.x << "," << bboxSize.y << "," << bboxSize.z
-              << " diag=" << bboxDiag << std::endl;
-
-    std::cout << "Finished ourModel bbox compute." << std::endl;
-
-    // Now place the main model at world origin (on ground) and the car to the +X side
-    // Place the main model at world origin (on ground).
-    placeModel(ourModel, bboxMin, bboxMax, glm::vec3(0.0f, -bboxSize.y * 0.5f, 0.0f));
-    // Place the car to the +X side and keep it stationary by default (movable=false).
-    // The car can still be made movable later by toggling a control if desired.
-    placeModel(CarModel, carBBoxMin, carBBoxMax, glm::vec3(3.0f, -carBBoxSize.y * 0.5f, 0.0f), 1.0f, false);
-
-    // Optional auto-framing: if AUTO_FRAME=1, move camera back so whole model fits in view.
-    if (const char *af = std::getenv("AUTO_FRAME"))
+        const PlacedModel &car = placedModels[vehiclePlaced];
+        std::shared_ptr<VehicleSim::World> world = std::make_shared<VehicleSim::World>();
+        world->groundHeight = car.worldMin.y;
+        for (const auto &pm : placedModels)
+            if (!pm.movable)
+                world->boxes.add(pm.worldMin, pm.worldMax, glm::length(pm.worldMax - pm.worldMin) * 0.5f);
+        world->tree.build(world->boxes);
+        const glm::vec3 half = (car.worldMax - car.worldMin) * 0.5f;
+        const bool alongX = half.x > half.z;
+        vehicleSpawn = alongX ? glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)) : glm::mat4(1.0f);
+        vehicleSpawn[3] = glm::vec4((car.worldMin + car.worldMax) * 0.5f, 1.0f);
+        vehicleSim.start(world, vehicleSpawn, alongX ? glm::vec3(half.z, half.y, half.x) : half);
+        vehicleSimStarted = true;
+    };
+    // scene models placed so far; they are placed in scene order, so a model's placedModels indices (probes,
+    // the transparent queue) don't depend on which import happens to finish first
+    size_t scenePlaced = 0;
+    // the placed model ORBIT_CAMERA and THUMBNAIL_VIEWS look at: the first one, then the last one picked
+    size_t focusedModel = 0;
+    bool orbitFocused = false;
+    // places whichever models became drawable since the last call; one that failed to import is skipped
+    auto placeReadyModels = [&]()
     {
-        if (std::string(af) == "1")
+        const size_t before = scenePlaced;
+        for (; scenePlaced < sceneModels.size(); ++scenePlaced)
         {
-            // Position camera on +Z axis looking at center, distance based on diagonal.
-            float dist = bboxDiag * 0.8f; // heuristic
-            if (dist < 5.0f)
-                dist = 5.0f; // minimum reasonable distance
-            camera.Position = bboxCenter + glm::vec3(0.0f, bboxSize.y * 0.3f, dist);
-            camera.Yaw = -90.0f;   // keep looking down -Z
-            camera.Pitch = -10.0f; // slight downward tilt
-            // Recompute internal camera vectors
-            // (hack: trigger mouse movement updateCameraVectors via small offsets)
-            camera.ProcessMouseMovement(0.0f, 0.0f);
-            std::cout << "AUTO_FRAME applied: camera.Position=" << camera.Position.x << "," << camera.Position.y << "," << camera.Position.z << std::endl;
+            if (sceneModels[scenePlaced].ready())
+                placeSceneModel(scenePlaced);
+            else if (modelLoader.importing(sceneModels[scenePlaced]))
+                break;
+            else
+                LOG_WARN("[Scene] '" << sceneDescription.models[scenePlaced].path << "' didn't load, not placed");
         }
-    }
-
-    // Wireframe debug if WIREFRAME=1
-    if (const char *wf = std::getenv("WIREFRAME"))
+        if (scenePlaced == sceneModels.size() && before < scenePlaced)
+        {
+            frameScene();
+            startVehicleSim();
+        }
+        // ORBIT_CAMERA starts out around the first model placed
+        if (!orbitFocused && !placedModels.empty())
+        {
+            snapshots.focusOrbit(placedModels[0].worldMin, placedModels[0].worldMax);
+            orbitFocused = true;
+        }
+    };
+    placeReadyModels();
+
+    // V: the first scene model with "variants" steps through its own path, then each variant. The variant
+    // loads (or is found resident in the modelCache) while the current one stays on screen; once it is
+    // drawable it takes over all of the model's placements, and the cache unloads what no longer fits.
+    size_t variantModel = sceneDescription.models.size();
+    for (size_t i = 0; i < sceneDescription.models.size() && variantModel == sceneDescription.models.size(); ++i)
+        if (!sceneDescription.models[i].variants.empty())
+            variantModel = i;
+    size_t variantShown = 0, variantNext = 0; // 0 is the scene model itself
+    Model *variantPending = NULL;
+    // the variant V shows next is prefetched while this one is on screen (VARIANT_PREFETCH=0: loaded on V)
+    const char *variantPrefetchEnv = std::getenv("VARIANT_PREFETCH");
+    const bool variantPrefetch = !(variantPrefetchEnv && std::string(variantPrefetchEnv) == "0");
+    bool variantPrefetched = false;
+    auto prefetchNextVariant = [&]()
+    {
+        variantPrefetched = true;
+        const std::vector<std::string> &variants = sceneDescription.models[variantModel].variants;
+        const size_t next = (variantShown + 1) % (variants.size() + 1);
+        if (variantPrefetch && next > 0)
+            modelCache.prefetch(variants[next - 1], modelLoader);
+    };
+    auto cycleVariant = [&]()
     {
-        if (std::string(wf) == "1")
+        if (variantModel >= scenePlaced)
         {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            std::cout << "Wireframe mode enabled (WIREFRAME=1)." << std::endl;
+            LOG_INFO("[Variants] " << (variantModel == sceneDescription.models.size() ? "No scene model has variants" : "Not placed yet"));
+            return;
         }
-    }
+        const std::vector<std::string> &variants = sceneDescription.models[variantModel].variants;
+        variantNext = ((variantPending ? variantNext : variantShown) + 1) % (variants.size() + 1);
+        variantPending = variantNext == 0 ? &sceneModels[variantModel] : &modelCache.acquire(variants[variantNext - 1], modelLoader);
+    };
+    // GL thread, once per frame: puts the pending variant in place once it is drawable; true when it did
+    auto showPendingVariant = [&]() -> bool
+    {
+        if (!variantPending)
+            return false;
+        const std::string &path = variantNext == 0 ? sceneDescription.models[variantModel].path
+                                                   : sceneDescription.models[variantModel].variants[variantNext - 1];
+        Model &m = *variantPending;
+        if (!m.ready())
+        {
+            if (!modelLoader.loading(m))
+            {
+                LOG_WARN("[Variants] '" << path << "' didn't load, staying on the current model");
+                variantPending = NULL;
+            }
+            return false;
+        }
+        m.prepareVariants(ourShader);
+        m.prepareVariants(probeShader);
+        if (stereo.ready())
+            m.prepareVariants(stereo.shader());
+        Model *shown = NULL;
+        for (auto &pm : placedModels)
+        {
+            if (pm.sceneModel != variantModel)
+                continue;
+            shown = pm.model;
+            pm.model = &m;
+            pm.bboxMin = m.boundsMin;
+            pm.bboxMax = m.boundsMax;
+            pm.baseModelMatrix = SceneDescription::placementMatrix(pm.placement, m.boundsMin, m.boundsMax);
+            pm.drawnBefore = false; // no motion vectors from the other model's matrix
+            updatePlaced(pm);
+        }
+        std::replace(drawnModels.begin(), drawnModels.end(), shown, &m);
+        if (parkingModel == shown)
+            parkingModel = &m;
+        rebuildSceneTree();
+        variantShown = variantNext;
+        variantPending = NULL;
+        variantPrefetched = false;
+        LOG_INFO("[Variants] Showing '" << path << "' (" << m.meshes.size() << " meshes)");
+        modelCache.trim(drawnModels, modelLoader);
+        std::ostringstream report;
+        modelCache.report(report);
+        LOG_INFO(report.str());
+        return true;
+    };
 
     // --- Debug textured-quad helper (used when DEBUG_TEXTURE=1 is set) ---
-    unsigned int debugQuadVAO = 0, debugQuadVBO = 0;
+    GlVertexArray debugQuadVAO;
+    GlBuffer debugQuadVBO;
     Shader debugQuadShader((currDir + "/shaders/debug_quad.vs").c_str(), (currDir + "/shaders/debug_flat.fs").c_str());
     {
         // positions (clip space) + texcoords
@@ -408,10 +677,10 @@ int main()
             -1.0f, 1.0f, 0.0f, 1.0f,
             1.0f, -1.0f, 1.0f, 0.0f,
             1.0f, 1.0f, 1.0f, 1.0f};
-        glGenVertexArrays(1, &debugQuadVAO);
-        glGenBuffers(1, &debugQuadVBO);
-        glBindVertexArray(debugQuadVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, debugQuadVBO);
+        debugQuadVAO = GlVertexArray::create();
+        debugQuadVBO = GlBuffer::create();
+        glBindVertexArray(debugQuadVAO.get());
+        glBindBuffer(GL_ARRAY_BUFFER, debugQuadVBO.get());
         glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
@@ -422,7 +691,27 @@ int main()
 
     // flag to print a single draw-time message
     bool printedDrawMessage = false;
-    bool debugCaptured = false;
+    // DEBUG_CAPTURE=1 saves the first frame to frame_debug.png and exits; CAPTURE_SEQUENCE=<prefix> records
+    // every frame to <prefix>_00000.png, ... (CAPTURE_FRAMES=N stops after N). Both read the window
+    // asynchronously and encode on CAPTURE_THREADS (default 2) background threads.
+    const char *debugCaptureEnv = std::getenv("DEBUG_CAPTURE");
+    const bool debugCapture = debugCaptureEnv && std::string(debugCaptureEnv) == "1";
+    const char *sequenceEnv = std::getenv("CAPTURE_SEQUENCE");
+    const std::string capturePrefix = sequenceEnv ? sequenceEnv : "";
+    int captureFrames = 0;
+    if (const char *cf = std::getenv("CAPTURE_FRAMES"))
+        captureFrames = std::max(0, std::atoi(cf));
+    int capturedFrames = 0;
+    std::unique_ptr<FrameCapture> frameCapture;
+    if (debugCapture || !capturePrefix.empty() || batch.enabled())
+    {
+        unsigned int encoders = 2;
+        if (const char *ct = std::getenv("CAPTURE_THREADS"))
+            encoders = (unsigned int)std::max(1, std::atoi(ct));
+        frameCapture.reset(new FrameCapture(encoders));
+        if (!capturePrefix.empty())
+            LOG_INFO("[Capture] Recording frames to " << capturePrefix << "_NNNNN.png on " << encoders << " encoder threads");
+    }
 
     // Optional pause before entering the render loop to inspect initialization.
     // Set PAUSE_BEFORE_RENDER=1 in the environment to enable.
@@ -430,24 +719,25 @@ int main()
     {
         if (std::string(pbr) == "1")
         {
-            std::cout << "PAUSE_BEFORE_RENDER=1 set. Initialization complete. Press Enter to continue to the render loop..." << std::endl;
+            LOG_INFO("PAUSE_BEFORE_RENDER=1 set. Initialization complete. Press Enter to continue to the render loop...");
+            asyncLog().flush();
             std::cin.get();
         }
     }
 
-    // --- Procedural HDR environment cubemap (used as a sample HDR for IBL) ---
-    unsigned int envCubemap;
-    unsigned int irradianceMap = 0;
-    unsigned int prefilterMap = 0;
-    unsigned int brdfLUTTexture = 0;
-    const int envSize = 128;
-    glGenTextures(1, &envCubemap);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-    printf("Created and bound envCubemap (tex id=%u)\n", envCubemap);
-    glCheck("glBindTexture envCubemap");
-    // If the user provided an EXR path as argv[1] and tinyexr is available (HAS_TINYEXR),
-    // load the equirectangular EXR and convert to cubemap. Otherwise fall back to the
-    // procedural HDR generation below.
+    // --- HDR environment for IBL: an EXR baked by the EnvironmentLoader, or a procedural sky ---
+    // environment-independent, so it is embedded and ready in both the EXR and the procedural path
+    GlTexture brdfLUTTexture(BRDFLUT::create());
+    // the area lights' linearly transformed cosines, likewise
+    GlTexture ltcLUTTexture(LTCLUT::create());
+    // the paint edits block every model program reads (nothing overridden until B)
+    materialOverrides().bind();
+    // loads further environments at runtime too (drop an .exr on the window), baking them across frames
+    EnvironmentLoader environment(currDir + "/shaders");
+    const char *iblBudgetEnv = std::getenv("IBL_BUDGET_MS");
+    const double iblBudgetMs = iblBudgetEnv ? std::atof(iblBudgetEnv) : 2.0;
+    // If the user provided an EXR path and tinyexr is available (HAS_TINYEXR), load the equirectangular
+    // EXR and bake it to cubemaps. Otherwise fall back to the procedural HDR generation below.
 // Attempt EXR loading if tinyexr is available and user hasn't disabled EXR via EXR_DISABLE env var
 #if defined(HAS_TINYEXR)
     bool exrLoaded = false;
@@ -456,296 +746,31 @@ int main()
     bool exrDisabled = (envDisable != nullptr && std::string(envDisable) == "1");
     if (exrDisabled)
     {
-        std::cout << "EXR loading disabled via EXR_DISABLE=1; using procedural HDR fallback." << std::endl;
+        LOG_INFO("EXR loading disabled via EXR_DISABLE=1; using procedural HDR fallback.");
+    }
+    else if (sceneDescription.environment == "procedural" && !std::getenv("EXR_PATH"))
+    {
+        LOG_INFO("Scene asks for the procedural sky.");
     }
     else
     {
-        std::cout << "tinyexr support compiled in; attempting to load EXR if present." << std::endl;
+        LOG_INFO("tinyexr support compiled in; attempting to load EXR if present.");
         char *envPath = std::getenv("EXR_PATH");
         if (envPath != nullptr)
         {
             exrPath = std::string(envPath);
         }
         if (exrPath.empty())
-            exrPath = currDir + "/river_alcove_1k.exr";
-        std::cout << "EXR path: '" << exrPath << "'" << std::endl;
-        if (!exrPath.empty())
-        {
-            const char *err = nullptr;
-            int ret = 0;
-            float *img = nullptr;
-            int w = 0, h = 0;
-            ret = LoadEXR(&img, &w, &h, exrPath.c_str(), &err);
-            if (ret == TINYEXR_SUCCESS && img != nullptr)
-            {
-                // img is RGBA floats (w*h*4). We'll upload it as an HDR equirectangular texture
-                // and perform GPU-based equirect->cubemap + irradiance + prefilter + BRDF LUT.
-                unsigned int hdrTexture;
-                glGenTextures(1, &hdrTexture);
-                glBindTexture(GL_TEXTURE_2D, hdrTexture);
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, w, h, 0, GL_RGBA, GL_FLOAT, img);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-                // create capture FBO
-                unsigned int captureFBO, captureRBO;
-                glGenFramebuffers(1, &captureFBO);
-                glGenRenderbuffers(1, &captureRBO);
-                glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-                glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-                glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-                glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, captureRBO);
-
-                // create cubemap to render to
-                const unsigned int envSizeGPU = 512;
-                glGenTextures(1, &envCubemap);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-                for (unsigned int i = 0; i < 6; ++i)
-                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, envSizeGPU, envSizeGPU, 0, GL_RGB, GL_FLOAT, nullptr);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-                // set up capture projection and views
-                glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
-                glm::mat4 captureViews[] = {
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f)),
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f)),
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
-                    glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, -1.0f, 0.0f))};
-
-                // load capture shaders
-                Shader equirectToCubemapShader((currDir + "/shaders/cubemap.vs").c_str(), (currDir + "/shaders/equirectangular_to_cubemap.fs").c_str());
-                Shader irradianceShader((currDir + "/shaders/cubemap.vs").c_str(), (currDir + "/shaders/irradiance_convolution.fs").c_str());
-                Shader prefilterShader((currDir + "/shaders/cubemap.vs").c_str(), (currDir + "/shaders/prefilter.fs").c_str());
-                Shader brdfShader((currDir + "/shaders/brdf.vs").c_str(), (currDir + "/shaders/brdf.fs").c_str());
-                // create cube VAO/VBO helper (renderCube)
-                unsigned int cubeVAO = 0, cubeVBO = 0;
-                {
-                    float vertices[] = {
-                        // positions
-                        -1.0f, -1.0f, -1.0f,
-                        1.0f, -1.0f, -1.0f,
-                        1.0f, 1.0f, -1.0f,
-                        1.0f, 1.0f, -1.0f,
-                        -1.0f, 1.0f, -1.0f,
-                        -1.0f, -1.0f, -1.0f,
-
-                        -1.0f, -1.0f, 1.0f,
-                        1.0f, -1.0f, 1.0f,
-                        1.0f, 1.0f, 1.0f,
-                        1.0f, 1.0f, 1.0f,
-                        -1.0f, 1.0f, 1.0f,
-                        -1.0f, -1.0f, 1.0f,
-
-                        -1.0f, 1.0f, 1.0f,
-                        -1.0f, 1.0f, -1.0f,
-                        -1.0f, -1.0f, -1.0f,
-                        -1.0f, -1.0f, -1.0f,
-                        -1.0f, -1.0f, 1.0f,
-                        -1.0f, 1.0f, 1.0f,
-
-                        1.0f, 1.0f, 1.0f,
-                        1.0f, 1.0f, -1.0f,
-                        1.0f, -1.0f, -1.0f,
-                        1.0f, -1.0f, -1.0f,
-                        1.0f, -1.0f, 1.0f,
-                        1.0f, 1.0f, 1.0f,
-
-                        -1.0f, -1.0f, -1.0f,
-                        1.0f, -1.0f, -1.0f,
-                        1.0f, -1.0f, 1.0f,
-                        1.0f, -1.0f, 1.0f,
-                        -1.0f, -1.0f, 1.0f,
-                        -1.0f, -1.0f, -1.0f,
-
-                        -1.0f, 1.0f, -1.0f,
-                        1.0f, 1.0f, -1.0f,
-                        1.0f, 1.0f, 1.0f,
-                        1.0f, 1.0f, 1.0f,
-                        -1.0f, 1.0f, 1.0f,
-                        -1.0f, 1.0f, -1.0f};
-                    glGenVertexArrays(1, &cubeVAO);
-                    glGenBuffers(1, &cubeVBO);
-                    glBindVertexArray(cubeVAO);
-                    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-                    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-                    glEnableVertexAttribArray(0);
-                    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
-                    glBindBuffer(GL_ARRAY_BUFFER, 0);
-                    glBindVertexArray(0);
-                }
-
-                // create a 2D BRDF LUT texture
-                glGenTextures(1, &brdfLUTTexture);
-                glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, 512, 512, 0, GL_RG, GL_FLOAT, 0);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-                // render BRDF LUT
-                glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-                glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-                glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 512, 512);
-                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdfLUTTexture, 0);
-                glViewport(0, 0, 512, 512);
-                brdfShader.use();
-                // render fullscreen quad (we'll create a simple quad VAO)
-                unsigned int quadVAO = 0, quadVBO = 0;
-                {
-                    float quadVertices[] = {
-                        // positions   // texCoords
-                        -1.0f, 1.0f, 0.0f, 1.0f,
-                        -1.0f, -1.0f, 0.0f, 0.0f,
-                        1.0f, -1.0f, 1.0f, 0.0f,
-
-                        -1.0f, 1.0f, 0.0f, 1.0f,
-                        1.0f, -1.0f, 1.0f, 0.0f,
-                        1.0f, 1.0f, 1.0f, 1.0f};
-                    glGenVertexArrays(1, &quadVAO);
-                    glGenBuffers(1, &quadVBO);
-                    glBindVertexArray(quadVAO);
-                    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
-                    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-                    glEnableVertexAttribArray(0);
-                    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
-                    glEnableVertexAttribArray(1);
-                    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
-                }
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-                glBindVertexArray(quadVAO);
-                glDrawArrays(GL_TRIANGLES, 0, 6);
-                glBindVertexArray(0);
-
-                // create irradiance map
-                glGenTextures(1, &irradianceMap);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
-                const unsigned int irradianceSize = 32;
-                for (unsigned int i = 0; i < 6; ++i)
-                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, irradianceSize, irradianceSize, 0, GL_RGB, GL_FLOAT, nullptr);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-                // convert HDR equirectangular to cubemap (render to envCubemap)
-                equirectToCubemapShader.use();
-                equirectToCubemapShader.setInt("equirectangularMap", 0);
-                equirectToCubemapShader.setMat4("projection", captureProjection);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, hdrTexture);
-
-                glViewport(0, 0, envSizeGPU, envSizeGPU);
-                glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-                for (unsigned int i = 0; i < 6; ++i)
-                {
-                    equirectToCubemapShader.setMat4("view", captureViews[i]);
-                    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, envCubemap, 0);
-                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-                    glBindVertexArray(cubeVAO);
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
-                }
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-                // then generate mipmaps for the cubemap so OpenGL can sample it at different roughness levels
-                glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-
-                // create prefilter cubemap
-                glGenTextures(1, &prefilterMap);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
-                const unsigned int prefilterSize = 128;
-                for (unsigned int i = 0; i < 6; ++i)
-                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, prefilterSize, prefilterSize, 0, GL_RGB, GL_FLOAT, nullptr);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                // generate mipmaps for the prefilter map
-                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-
-                // run a quasi Monte-Carlo simulation on the environment map to create a prefilter (per mip)
-                prefilterShader.use();
-                prefilterShader.setInt("environmentMap", 0);
-                prefilterShader.setMat4("projection", captureProjection);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-
-                glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-                unsigned int maxMipLevels = 5;
-                for (unsigned int mip = 0; mip < maxMipLevels; ++mip)
-                {
-                    unsigned int mipWidth = prefilterSize * std::pow(0.5, mip);
-                    unsigned int mipHeight = mipWidth;
-                    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-                    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-                    glViewport(0, 0, mipWidth, mipHeight);
-
-                    float roughness = (float)mip / (float)(maxMipLevels - 1);
-                    prefilterShader.setFloat("roughness", roughness);
-                    for (unsigned int i = 0; i < 6; ++i)
-                    {
-                        prefilterShader.setMat4("view", captureViews[i]);
-                        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, prefilterMap, mip);
-                        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-                        glBindVertexArray(cubeVAO);
-                        glDrawArrays(GL_TRIANGLES, 0, 36);
-                    }
-                }
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-                // create irradiance by convoluting the environment map
-                irradianceShader.use();
-                irradianceShader.setInt("environmentMap", 0);
-                irradianceShader.setMat4("projection", captureProjection);
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-
-                glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-                glViewport(0, 0, irradianceSize, irradianceSize);
-                for (unsigned int i = 0; i < 6; ++i)
-                {
-                    irradianceShader.setMat4("view", captureViews[i]);
-                    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, irradianceMap, 0);
-                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-                    glBindVertexArray(cubeVAO);
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
-                }
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-                // bind generated textures to known units for later use
-                // we'll set uniforms in the main render loop
-                // free CPU image
-                free(img);
-                exrLoaded = true;
-                std::cout << "EXR loaded and GPU IBL maps generated." << std::endl;
-            }
-            else
-            {
-                if (err)
-                {
-                    fprintf(stderr, "tinyexr load error: %s\n", err);
-                    FreeEXRErrorMessage(err);
-                }
-                else
-                {
-                    std::cout << "tinyexr: LoadEXR returned failure." << std::endl;
-                }
-            }
-        }
+            exrPath = sceneDescription.environment.empty() ? currDir + "/river_alcove_1k.exr" : sceneDescription.environment;
+        LOG_INFO("EXR path: '" << exrPath << "'");
+        // the first environment is needed before the first frame: decode and bake it to completion
+        environment.load(exrPath);
+        exrLoaded = environment.pump(-1.0);
+        if (exrLoaded)
+            LOG_INFO("EXR loaded and GPU IBL maps generated.");
     }
 #else
-    std::cout << "tinyexr not compiled in. Using procedural HDR fallback." << std::endl;
+    LOG_INFO("tinyexr not compiled in. Using procedural HDR fallback.");
 #endif
     // Decide whether to use the procedural HDR fallback (true) or the loaded EXR cubemap (false)
     bool useProcedural = true;
@@ -754,423 +779,1988 @@ int main()
 #else
     useProcedural = true;
 #endif
+    // the atmosphere's fixed LUTs, for the procedural sky now or once it comes back at runtime
+    if (proceduralSky.atmosphere)
+        atmosphere().init(currDir + "/shaders");
     if (useProcedural)
     {
-        // generate HDR-like data per face
-        glm::vec3 sunDir = glm::normalize(glm::vec3(0.5f, 0.8f, 0.3f));
-        float sunIntensity = 6.0f;
-        float sunPower = 64.0f;
-        for (unsigned int face = 0; face < 6; ++face)
+        // rendered on the GPU and prefiltered like an EXR; the sun can be moved at runtime (see processInput)
+        environment.loadProcedural(proceduralSky);
+        environment.pump(-1.0);
+        LOG_INFO("Procedural sky baked to IBL maps.");
+    }
+    proceduralSkyActive = useProcedural;
+
+    // camera and environment of one view for every scene shader: one FrameData block per view (the
+    // sampler units of the IBL maps and the rest are fixed at link, see Shader::samplerUnit)
+    auto makeFrameData = [&](const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye) -> FrameData
+    {
+        const EnvironmentLoader::Maps &ibl = environment.current();
+        FrameData frame(projection, view, eye);
+        frame.setEnvironment(ibl.irradianceSH, ibl.prefilterMaxMip, proceduralSky.sunDirection);
+        return frame;
+    };
+    auto bindFrameData = [&](const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye)
+    {
+        makeFrameData(projection, view, eye).bind();
+    };
+
+    // OCCLUSION_CULLING=1: two-phase occlusion culling of the placed models' opaque meshes (Hi-Z compute on
+    // GL 4.3, occlusion queries otherwise)
+    OcclusionCuller occlusion(currDir + "/shaders");
+    const bool occlusionCulling = OcclusionCuller::enabledByEnv();
+    if (occlusionCulling)
+        occlusion.init();
+    // DEPTH_PREPASS=1: depth of the opaque meshes first, front to back, so the PBR shader runs once per
+    // pixel in the colour pass (GL_LEQUAL). Off by default: it pays off when overdraw, not vertex work,
+    // dominates. Occlusion culling already draws its own depth first and skips it. SSAO=1, SSR=1 and
+    // RT_REFLECTIONS=1 turn it on too (they need the depth before the shading) unless the visibility buffer
+    // provides that depth.
+    const char *prepassEnv = std::getenv("DEPTH_PREPASS");
+    const bool screenSpaceEffects = AmbientOcclusion::enabledByEnv() || ScreenSpaceReflections::enabledByEnv() ||
+                                    RayTracedReflections::enabledByEnv();
+    const bool depthPrepass = ((prepassEnv && std::string(prepassEnv) == "1") || (screenSpaceEffects && !VisibilityBuffer::enabledByEnv())) &&
+                              !occlusionCulling;
+    if (depthPrepass)
+        LOG_INFO("[Render] Depth pre-pass on");
+    // MESHLET_CULLING=1: per-cluster frustum/back-face culling of the main pass on the GPU (GL 4.3)
+    MeshletCuller meshletCuller(currDir + "/shaders");
+    if (MeshletCuller::enabledByEnv())
+        meshletCuller.init();
+    // GPU_DRIVEN=1: the main pass's opaque draws of every scene model, all placements at once, culled and
+    // compacted on the GPU (GL 4.3). Occlusion culling and the depth pre-pass keep their own paths.
+    SceneCuller sceneCuller(currDir + "/shaders");
+    if (SceneCuller::enabledByEnv() && !occlusionCulling && !depthPrepass)
+        sceneCuller.init();
+    const bool gpuDriven = sceneCuller.ready();
+    // transparent meshes of all placed models, sorted together so glass of different cars interleaves
+    // correctly. The order is reused while nothing moved and the camera stayed within a few centimetres.
+    TransparentQueue transparentQueue;
+    const float transparentResortDistance = 0.05f;
+    // OIT=1: glass and lamp covers (Mesh::weightedBlend) skip the queue and blend order independently
+    WeightedOIT weightedOIT(currDir + "/shaders");
+    if (WeightedOIT::enabledByEnv())
+        weightedOIT.init();
+    // KHR_materials_transmission glass sees a mipmapped copy of the opaque scene, taken once per frame
+    // (TRANSMISSION=0: the environment instead)
+    RefractionCopy refractionCopy;
+    const bool transmissionEnabled = RefractionCopy::enabledByEnv();
+    // the environment behind the opaque scene, drawn only where nothing covers it (SKYBOX=0: flat grey,
+    // SKYBOX_BLUR: a softer mip)
+    Skybox skybox(currDir + "/shaders");
+    if (Skybox::enabledByEnv())
+        skybox.init();
+    // the scene renders in linear HDR and is tone mapped into the window in one pass (TONEMAP, EXPOSURE)
+    ToneMapper toneMapper(currDir + "/shaders");
+    toneMapper.init();
+    // glow of the HDR highlights, from half resolution down and added by the tone map (BLOOM=0 turns it off)
+    Bloom bloom(currDir + "/shaders");
+    if (Bloom::enabledByEnv() && toneMapper.ready())
+        bloom.init();
+    // AUTO_EXPOSURE=1: the exposure follows the scene's measured luminance, adapting over a second or so
+    AutoExposure autoExposure(currDir + "/shaders");
+    if (AutoExposure::enabledByEnv() && toneMapper.ready() && !batch.enabled() && !poster.enabled())
+        autoExposure.init();
+    // DEBUG_VIEW=<name> (or G): what the frame costs per pixel, drawn over the scene
+    DebugViews debugViews(currDir + "/shaders");
+    if (toneMapper.ready() && !batch.enabled() && !poster.enabled())
+        debugViews.init();
+    // CULL_DEBUG=1 (or =nodes): the culling's decisions as boxes over the scene, F freezes the culling camera
+    CullDebug cullDebug(currDir + "/shaders");
+    if (CullDebug::enabledByEnv() && !batch.enabled() && !poster.enabled())
+        cullDebug.init();
+    // the post chain's passes and transient textures, declared again each frame
+    RenderGraph renderGraph;
+    // TAA=1: jittered projection, motion vectors from the opaque pass and a history resolve before the tone map
+    TemporalAA temporalAA(currDir + "/shaders");
+    if (TemporalAA::enabledByEnv() && toneMapper.ready())
+    {
+        temporalAA.init();
+        toneMapper.enableMotionVectors();
+    }
+    // VISIBILITY_BUFFER=1: the main view's opaque buckets rasterized to triangle IDs over the HDR target's
+    // depth-stencil buffer, then shaded once per pixel. Occlusion culling, the depth pre-pass and GPU_DRIVEN
+    // keep their own opaque passes.
+    VisibilityBuffer visibilityBuffer(currDir + "/shaders");
+    if (VisibilityBuffer::enabledByEnv() && toneMapper.ready() && !occlusionCulling && !depthPrepass && !gpuDriven)
+        visibilityBuffer.init();
+    // SSAO=1: half-resolution ambient occlusion of the diffuse IBL, from the opaque depth of the depth
+    // pre-pass or the visibility buffer
+    AmbientOcclusion ambientOcclusion(currDir + "/shaders");
+    if (AmbientOcclusion::enabledByEnv())
+    {
+        if (toneMapper.ready() && (depthPrepass || visibilityBuffer.ready()))
+            ambientOcclusion.init();
+        else
+            LOG_INFO("[SSAO] Needs the HDR target and the depth pre-pass or the visibility buffer (not with OCCLUSION_CULLING or GPU_DRIVEN)");
+    }
+    // SSR=1: half-resolution Hi-Z reflections in the specular IBL, traced in the same opaque depth and
+    // coloured from the previous frame
+    // RT_REFLECTIONS=1: the same from the triangle BVHs in a compute pass (GL 4.3), off-screen geometry
+    // included; it takes SSR's place
+    RayTracedReflections tracedReflections(currDir + "/shaders");
+    if (RayTracedReflections::enabledByEnv())
+    {
+        if (toneMapper.ready() && (depthPrepass || visibilityBuffer.ready()))
+            tracedReflections.init();
+        else
+            LOG_INFO("[RTReflections] Needs the HDR target and the depth pre-pass or the visibility buffer (not with OCCLUSION_CULLING or GPU_DRIVEN)");
+    }
+    ScreenSpaceReflections screenReflections(currDir + "/shaders");
+    if (ScreenSpaceReflections::enabledByEnv() && !tracedReflections.ready())
+    {
+        if (toneMapper.ready() && (depthPrepass || visibilityBuffer.ready()))
+            screenReflections.init();
+        else
+            LOG_INFO("[SSR] Needs the HDR target and the depth pre-pass or the visibility buffer (not with OCCLUSION_CULLING or GPU_DRIVEN)");
+    }
+    // VRS=1: flat and peripheral tiles of the opaque forward pass shade at half or quarter rate
+    ShadingRate shadingRate(currDir + "/shaders");
+    if (ShadingRate::enabledByEnv())
+    {
+        if (toneMapper.ready() && !visibilityBuffer.ready())
+            shadingRate.init();
+        else
+            LOG_INFO("[VRS] Needs the HDR target and the forward opaque pass (not with VISIBILITY_BUFFER)");
+    }
+    // GPU_PICKING=1: clicks read the mesh ID the opaque pass wrote under the crosshair instead of ray testing
+    // the meshes on the CPU; the visibility buffer and GPU_DRIVEN draw without per-placement IDs
+    GpuPicker gpuPicker;
+    if (GpuPicker::enabledByEnv())
+    {
+        if (toneMapper.ready() && !visibilityBuffer.ready() && !gpuDriven)
         {
-            std::vector<float> data(envSize * envSize * 3);
-            for (int y = 0; y < envSize; ++y)
-            {
-                for (int x = 0; x < envSize; ++x)
-                {
-                    // normalized device coords in [-1,1]
-                    float u = (2.0f * (x + 0.5f) / envSize) - 1.0f;
-                    float v = (2.0f * (y + 0.5f) / envSize) - 1.0f;
-                    glm::vec3 dir;
-                    switch (face)
-                    {
-                    case 0:
-                        dir = glm::vec3(1.0f, -v, -u);
-                        break; // +X
-                    case 1:
-                        dir = glm::vec3(-1.0f, -v, u);
-                        break; // -X
-                    case 2:
-                        dir = glm::vec3(u, 1.0f, v);
-                        break; // +Y
-                    case 3:
-                        dir = glm::vec3(u, -1.0f, -v);
-                        break; // -Y
-                    case 4:
-                        dir = glm::vec3(u, -v, 1.0f);
-                        break; // +Z
-                    case 5:
-                        dir = glm::vec3(-u, -v, -1.0f);
-                        break; // -Z
-                    }
-                    dir = glm::normalize(dir);
-                    // sky gradient
-                    float t = glm::clamp(dir.y * 0.5f + 0.5f, 0.0f, 1.0f);
-                    glm::vec3 sky = glm::mix(glm::vec3(0.02f), glm::vec3(0.6f, 0.7f, 0.9f), t);
-                    // sun spot
-                    float sun = pow(glm::max(glm::dot(dir, sunDir), 0.0f), sunPower) * sunIntensity;
-                    glm::vec3 color = sky + glm::vec3(sun);
-                    int idx = (y * envSize + x) * 3;
-                    data[idx + 0] = color.r;
-                    data[idx + 1] = color.g;
-                    data[idx + 2] = color.b;
-                }
-            }
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB16F, envSize, envSize, 0, GL_RGB, GL_FLOAT, data.data());
-            printf("Procedural -> uploaded cubemap face %u\n", face);
-            glCheck("glTexImage2D procedural face");
+            gpuPicker.init();
+            toneMapper.enablePickIds();
         }
-
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-        // generate mipmaps to approximate prefiltered environment
-        glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-        printf("Generated mipmaps for envCubemap\n");
-        glCheck("glGenerateMipmap envCubemap");
-
-        // end of cubemap setup; fall-through to the render loop below
+        else
+            LOG_INFO("[Pick] GPU picking needs the HDR target (not with VISIBILITY_BUFFER or GPU_DRIVEN), picking on the CPU");
     }
+    // STILL=1: while nothing moves, jittered frames with stochastic IBL accumulate into a converging mean
+    StillAccumulator still(currDir + "/shaders");
+    if (StillAccumulator::enabledByEnv() && toneMapper.ready())
+        still.init();
+    unsigned int stillRevision = 0;
+    // PATH_TRACE=1: while nothing moves, a progressive path traced image of the scene replaces the frame
+    PathTracer pathTracer(currDir + "/shaders");
+    if (PathTracer::enabledByEnv() && toneMapper.ready())
+    {
+        pathTracer.init();
+        if (pathTracer.ready())
+        {
+            batch.requireFrames(pathTracer.requiredFrames());
+            poster.requireFrames(pathTracer.requiredFrames());
+        }
+    }
+    // THUMBNAIL_VIEWS=front,side,top: the focused model from fixed views in an atlas strip (interactive runs)
+    ViewAtlas thumbnailViews;
+    if (ViewAtlas::enabledByEnv() && toneMapper.ready() && !benchmark.enabled() && !batch.enabled() && !poster.enabled())
+        thumbnailViews.init();
+    // STEREO=1: both eyes side by side in one pass (interactive and benchmark runs)
+    if (StereoRenderer::enabledByEnv() && toneMapper.ready() && !batch.enabled() && !poster.enabled())
+        stereo.init();
+    // STREAM_PORT=<port>: the window streamed to browsers, which steer it too (interactive runs)
+    if (FrameStreamer::enabledByEnv() && !benchmark.enabled() && !batch.enabled() && !poster.enabled())
+        streamer.start();
+    // KIOSK_DISPLAYS=N: more monitors driven from this process, their windows sharing the main context's objects
+    KioskDisplays kiosk;
+    if (KioskDisplays::enabledByEnv() && toneMapper.ready() && !benchmark.enabled() && !batch.enabled() && !poster.enabled())
+        kiosk.init(window);
+    // FRAME_SHARE=<name>: every frame handed to other processes (a Spout texture, or shared memory)
+    if (FrameShare::enabledByEnv() && !benchmark.enabled() && !batch.enabled() && !poster.enabled())
+        frameShare.init();
+    // STREAM_SESSIONS=1: a view of its own per session, from the shared models, materials and IBL maps
+    SessionViews sessionViews(streamer);
+    // IDLE_RENDER=1: stop drawing while nothing changes; offline runs render every frame they're asked for
+    IdleRenderer idleRenderer;
+    if (benchmark.enabled() || batch.enabled() || poster.enabled() || inputLog.replaying() || !capturePrefix.empty())
+        idleRenderer.disable();
+    // RENDER_THREAD=1: the render loop runs on a thread of its own with the GL context, while the main thread
+    // only handles window events and input; interactive runs only (the offline modes place the camera
+    // themselves, and DEBUG_CAPTURE leaves the loop after its first frame)
+    const char *renderThreadEnv = std::getenv("RENDER_THREAD");
+    const bool renderThread = renderThreadEnv && std::string(renderThreadEnv) == "1" && !benchmark.enabled() && !batch.enabled() &&
+                              !poster.enabled() && !inputLog.replaying() && !debugCapture;
+    // DYNAMIC_RES=1: the HDR target follows the GPU frame time (GpuProfiler's "frame" scope) and the tone
+    // map stretches it over the window
+    DynamicResolution dynamicResolution;
+    // last frame's unjittered view-projection of the main view (motion vectors)
+    glm::mat4 previousViewProjection(1.0f);
+    bool hasPreviousView = false;
+    // performance overlay, off in benchmark runs (their GL_PRIMITIVES_GENERATED query would overlap its own)
+    PerfHud hud(currDir + "/shaders");
+    // PARKING_LOT=N: N more copies of the scene's parking_lot model parked in a grid behind it, one instanced
+    // draw per bucket (Model::DrawInstances)
+    int parkingLot = 0;
+    if (const char *pl = std::getenv("PARKING_LOT"))
+        parkingLot = std::max(0, std::atoi(pl));
+    // the far copies drawn as octahedral impostors, baked from the model once it has loaded
+    Impostors impostors(currDir + "/shaders");
+    if (parkingLot > 0 && parkingModel && Impostors::enabledByEnv())
+        impostors.init();
+    // LIVERY=<image>: a livery paged in from its cooked page file over the paint, at a fixed VRAM cost
+    VirtualTexture livery(currDir + "/shaders");
+    if (VirtualTexture::enabledByEnv())
+        livery.init();
+    // DECALS=<file.json>: decals composited into a paint texture per model, again whenever the file changes
+    DecalCompositor decals(currDir + "/shaders");
+    if (DecalCompositor::enabledByEnv())
+        decals.init();
+    // each copy gets its own paint (on the PAINT-tagged materials), dirt and seed (Mesh::instanceVariation);
+    // PARKING_VARIETY=0 parks them all as authored
+    const char *pv = std::getenv("PARKING_VARIETY");
+    const bool parkingVariety = !(pv && std::atoi(pv) == 0);
+
+    // SHOWROOM_LIGHTS=N: N local lights (every third a spot) circling above the placed models, shaded
+    // through the clustered light grid
+    ClusteredLights clusteredLights;
+    int showroomLights = 0;
+    if (const char *sl = std::getenv("SHOWROOM_LIGHTS"))
+        showroomLights = std::min(std::max(0, std::atoi(sl)), ClusteredLights::MAX_LIGHTS);
+    // SOFTBOXES=N: N rectangular area lights in a row above the placed models, facing down
+    int softboxes = 0;
+    if (const char *sb = std::getenv("SOFTBOXES"))
+        softboxes = std::min(std::max(0, std::atoi(sb)), 16);
+
+    // cascaded shadow maps for the sun (SHADOWS=0 disables them); cascades holding only static models are
+    // drawn once and reused until something inside them or the sun moves
+    ShadowCascades shadows;
+    const bool shadowsEnabled = ShadowCascades::enabledByEnv();
+    std::vector<std::pair<glm::vec3, glm::vec3> > shadowCasters;
+    // the casters of one cascade: the placed models in the light's frustum, position-only like the pre-pass
+    ShadowCascades::DrawCasters drawShadowCasters = [&](const glm::mat4 &projection, const glm::mat4 &view)
+    {
+        const glm::mat4 viewProjection = projection * view;
+        const glm::vec3 lightEye = sceneTree.boundsMax() + proceduralSky.sunDirection * 1000.0f;
+        bindFrameData(projection, view, lightEye);
+        depthShader.use();
+        FrameVector<unsigned char> visible;
+        sceneTree.cull(Frustum(viewProjection), visible);
+        for (size_t i = 0; i < placedModels.size(); ++i)
+        {
+            if (!visible[i])
+                continue;
+            placedModels[i].model->drawDepthPrepass(depthShader, placedMatrix(placedModels[i]), lightEye, viewProjection);
+        }
+    };
 
-    // render loop
-    // -----------
-    // bool screenshotTaken = false;
-    // int _debugFrameCount = 0;
-    while (!glfwWindowShouldClose(window))
+    // local reflection probes, one at the centre of each placed model so the cars reflect each other.
+    // REFLECTION_PROBES=0 disables them; PROBE_BUDGET_MS is the per-frame capture budget (default 1).
+    ReflectionProbes probes;
+    const char *probesEnv = std::getenv("REFLECTION_PROBES");
+    const bool probesEnabled = !(probesEnv && std::string(probesEnv) == "0");
+    const char *probeBudgetEnv = std::getenv("PROBE_BUDGET_MS");
+    const double probeBudgetMs = probeBudgetEnv ? std::atof(probeBudgetEnv) : 1.0;
+    // draws every placed model but the probe's own into a probe face
+    ReflectionProbes::DrawScene drawProbeScene = [&](const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye, int owner)
     {
-        static bool entered = false;
-        if (!entered)
+        bindFrameData(projection, view, eye);
+        probeShader.use();
+        const glm::mat4 viewProjection = projection * view;
+        FrameVector<unsigned char> visible;
+        sceneTree.cull(Frustum(viewProjection), visible);
+        for (size_t i = 0; i < placedModels.size(); ++i)
         {
-            std::cout << "Entering render loop." << std::endl;
-            entered = true;
+            if ((int)i == owner || !visible[i])
+                continue;
+            glm::mat4 finalModel = placedMatrix(placedModels[i]);
+            placedModels[i].model->Draw(probeShader, finalModel, eye, &viewProjection);
         }
-        // per-frame time logic
-        // --------------------
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
-
-        // input
-        // -----
-        processInput(window);
-
-        // render
-        // ------
-        glClearColor(0.8f, 0.8f, 0.8f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        // Ensure the viewport matches the actual framebuffer size (some earlier FBO/code may have changed it)
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-
-        // view/projection transformations
-        // Adjust far plane dynamically if AUTO_FRAME enabled and model is large
-        float farPlane = 100.0f;
-        if (bboxDiag > 90.0f)
-            farPlane = bboxDiag * 2.0f;
-        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, farPlane);
-        glm::mat4 view = camera.GetViewMatrix();
-
-        // set per-shader uniforms while the respective shader is bound (avoids setting uniforms
-        // on the wrong currently-bound program).
-        ourShader.use();
-        ourShader.setInt("irradianceMap", 10);
-        ourShader.setInt("prefilteredMap", 11);
-        ourShader.setInt("brdfLUT", 12);
-        ourShader.setFloat("prefilterMaxMip", std::log2((float)128));
-        ourShader.setMat4("projection", projection);
-        ourShader.setMat4("view", view);
-        ourShader.setVec3("viewPos", camera.Position);
-
-        carShader.use();
-        carShader.setInt("irradianceMap", 10);
-        carShader.setInt("prefilteredMap", 11);
-        carShader.setInt("brdfLUT", 12);
-        carShader.setFloat("prefilterMaxMip", std::log2((float)128));
-        carShader.setMat4("projection", projection);
-        carShader.setMat4("view", view);
-        carShader.setVec3("viewPos", camera.Position);
-
-        // bind IBL textures once (bindings are global state)
-        glActiveTexture(GL_TEXTURE0 + 10);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap ? irradianceMap : envCubemap);
-        glActiveTexture(GL_TEXTURE0 + 11);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap ? prefilterMap : envCubemap);
-        glActiveTexture(GL_TEXTURE0 + 12);
-        glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
-
-        // render the loaded model
-        glm::mat4 model = glm::mat4(1.0f);
-        // Center model around origin based on computed bbox so it's in front of camera
-        model = glm::translate(model, -bboxCenter + glm::vec3(0.0f, -bboxSize.y * 0.5f, 0.0f));
-        // render the loaded model
-        glm::mat4 carmodel = glm::mat4(1.0f);
-    // Center carmodel around its own bbox center so it's placed correctly in world space
-    // (previously this used the main model's `bboxCenter` which mis-centered the car).
-    carmodel = glm::translate(carmodel, -carBBoxCenter + glm::vec3(5.0f, -carBBoxSize.y * 0.5f, 0.0f));
-
-        // If model extremely large, scale it down for visibility (heuristic)
-        if (bboxDiag > 200.0f)
+    };
+    // IRRADIANCE_VOLUME=1: a grid of light probes around each placed model for the diffuse light, captured
+    // with the same scene draw; IRRADIANCE_BUDGET_MS is the per-frame capture budget (default 1)
+    IrradianceVolume irradianceVolume(currDir + "/shaders");
+    if (IrradianceVolume::enabledByEnv())
+        irradianceVolume.init();
+    const char *irradianceBudgetEnv = std::getenv("IRRADIANCE_BUDGET_MS");
+    const double irradianceBudgetMs = irradianceBudgetEnv ? std::atof(irradianceBudgetEnv) : 1.0;
+
+    // draws the placed models a thumbnail view sees, with the probe program (no shadows, clustered lights
+    // or screen-space passes) and the main view's detail levels
+    auto drawProbeView = [&](const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &eye, const std::vector<unsigned char> &visible)
+    {
+        bindFrameData(projection, view, eye);
+        probeShader.use();
+        const glm::mat4 viewProjection = projection * view;
+        for (size_t i = 0; i < placedModels.size() && i < visible.size(); ++i)
         {
-            float scaleFactor = 200.0f / bboxDiag;
-            model = glm::scale(model, glm::vec3(scaleFactor));
-            carmodel = glm::scale(carmodel, glm::vec3(scaleFactor));
+            if (visible[i])
+                placedModels[i].model->Draw(probeShader, placedMatrix(placedModels[i]), eye, &viewProjection);
         }
-        else
+    };
+    ViewAtlas::DrawView drawThumbnailView = [&](const ViewAtlas::View &view)
+    {
+        drawProbeView(view.projection, view.view, view.eye, view.visible);
+    };
+    // STREAM_SESSIONS: a session's own view, the same way
+    SessionViews::DrawView drawSessionView = [&](const SessionViews::View &view)
+    {
+        drawProbeView(view.projection, view.view, view.eye, view.visible);
+    };
+    // KIOSK_DISPLAYS: a display's view, the same way
+    KioskDisplays::DrawView drawKioskView = [&](const KioskDisplays::View &view)
+    {
+        drawProbeView(view.projection, view.view, view.eye, view.visible);
+    };
+
+    // the IBL setup above bound programs, VAOs and textures directly; resync the state cache
+    glState().invalidate();
+
+    // PROFILE=1: CPU/GPU time per pass; P prints the summary, PROFILE_JSON=<file> saves it on exit.
+    // TRACE_CAPTURE=1 (or =<file>) also times the passes, for the timeline written on exit.
+    GpuProfiler &profiler = gpuProfiler();
+    const bool profileSummary = GpuProfiler::enabledByEnv();
+    profiler.setEnabled(profileSummary || frameTrace().enabled() || dynamicResolution.enabled());
+    if (profileSummary)
+        LOG_INFO("[Profile] Timing passes, press P for the summary");
+    if (profiler.enabled() && profiler.enablePipelineStatistics())
+        LOG_INFO("[Profile] Counting shader invocations and primitives per pass");
+    if (frameTrace().enabled())
+        LOG_INFO("[Trace] Recording a timeline to " << frameTrace().outputPath() << " (written on exit)");
+    // writes the summary / timeline out, on either way out of the render loop
+    auto saveProfiles = [&]()
+    {
+        if (profileSummary)
+        {
+            std::ostringstream report;
+            profiler.report(report);
+            LOG_INFO(report.str());
+            if (const char *pj = std::getenv("PROFILE_JSON"))
+            {
+                if (profiler.writeJson(pj))
+                    LOG_INFO("[Profile] Saved summary to " << pj);
+                else
+                    LOG_WARN("[Profile] Can't write " << pj);
+            }
+        }
+        if (frameTrace().enabled())
         {
-            model = glm::scale(model, glm::vec3(1.0f));
-            carmodel = glm::scale(carmodel, glm::vec3(1.0f));
+            if (frameTrace().write())
+                LOG_INFO("[Trace] Saved " << frameTrace().size() << " events to " << frameTrace().outputPath());
+            else
+                LOG_WARN("[Trace] Can't write " << frameTrace().outputPath());
         }
-        // Set default model matrices for heuristics (not strictly required when using placedModels)
-        ourShader.setMat4("model", model);
-        carShader.setMat4("model", carmodel);
+    };
 
-        // Debug: print once that we're about to draw
-        if (!printedDrawMessage)
+    // the renderer's copy of input: the newest snapshot's camera, car and sun, and the events queued with it
+    int windowWidth = SCR_WIDTH, windowHeight = SCR_HEIGHT;
+    // ORBIT_CAMERA's glide has come to rest: STILL waits for it, IDLE_RENDER stays awake until then
+    bool cameraSettled = true;
+    // VEHICLE_SIM: the cars' body frames, the player's first (its model follows through carPose)
+    std::vector<glm::mat4> vehiclePoses;
+    auto takeSnapshot = [&]()
+    {
+        InputEvents events;
+        if (!snapshots.take(events))
+            return;
+        const SceneSnapshot &snapshot = snapshots.front();
+        // a snapshot from before AUTO_FRAME placed the camera would put it back
+        if (snapshots.cameraCurrent())
+            camera = snapshot.camera;
+        cameraSettled = snapshot.cameraSettled;
+        carOffset = snapshot.carOffset;
+        vehiclePoses = snapshot.vehicles;
+        carPose = vehiclePoses.empty() ? glm::mat4(1.0f) : vehiclePoses[0] * glm::inverse(vehicleSpawn);
+        if (snapshot.framebufferWidth > 0 && snapshot.framebufferHeight > 0)
+        {
+            windowWidth = snapshot.framebufferWidth;
+            windowHeight = snapshot.framebufferHeight;
+        }
+        if (events.skyChanged)
         {
-            std::cout << "[render debug] Drawing placed models..." << std::endl;
-            printedDrawMessage = true;
+            proceduralSky.sunDirection = snapshot.sky.sunDirection;
+            proceduralSky.sunIntensity = snapshot.sky.sunIntensity;
+            proceduralSkyChanged = true;
         }
+        pickRequested = pickRequested || events.pick;
+        hudToggleRequested = hudToggleRequested || events.hudToggle;
+        toneCurveCycleRequested = toneCurveCycleRequested || events.toneCurveCycle;
+        variantCycleRequested = variantCycleRequested || events.variantCycle;
+        materialVariantCycleRequested = materialVariantCycleRequested || events.materialVariantCycle;
+        paintCycleRequested = paintCycleRequested || events.paintCycle;
+        partCycleRequested = partCycleRequested || events.partCycle;
+        debugViewCycleRequested = debugViewCycleRequested || events.debugViewCycle;
+        cullFreezeRequested = cullFreezeRequested || events.cullFreeze;
+        redrawRequested = redrawRequested || events.redraw;
+        droppedEnvironments.insert(droppedEnvironments.end(), events.droppedEnvironments.begin(), events.droppedEnvironments.end());
+        if (events.profileReport)
+        {
+            std::ostringstream report;
+            profiler.report(report);
+            LOG_INFO(report.str());
+            const ThreadPool::Stats jobs = ThreadPool::shared().stats();
+            LOG_INFO("[Jobs] " << ThreadPool::shared().size() << " workers, " << jobs.executed << " jobs run, " << jobs.stolen << " stolen");
+        }
+    };
+    // the view starts at the scene's first camera preset (AUTO_FRAME places it itself)
+    const char *autoFrameEnv = std::getenv("AUTO_FRAME");
+    if (!cameraPresets.empty() && !(autoFrameEnv && std::string(autoFrameEnv) == "1"))
+        SceneDescription::applyCamera(cameraPresets[0], camera);
+    input.camera = camera;
+    input.sky = proceduralSky;
+
+    // SHADER_HOT_RELOAD: shader edits relink in the background, scene file edits apply between frames
+    std::unique_ptr<HotReload> hotReload;
+    if (HotReload::enabledByEnv() && !benchmark.enabled() && !batch.enabled() && !poster.enabled())
+        hotReload.reset(new HotReload(sceneDescription.file));
+    // the edited scene file's lights, camera presets and environment; the current ones stay if it doesn't parse
+    auto applySceneEdits = [&]()
+    {
+        SceneDescription edited;
+        if (!edited.read(sceneDescription.file))
+            return;
+        bool modelsChanged = edited.models.size() != sceneDescription.models.size();
+        for (size_t i = 0; i < edited.models.size() && !modelsChanged; ++i)
+            modelsChanged = edited.models[i].path != sceneDescription.models[i].path ||
+                            edited.models[i].placements.size() != sceneDescription.models[i].placements.size();
+        if (modelsChanged)
+            LOG_INFO("[HotReload] Model changes in " << sceneDescription.file << " apply on restart");
+        sceneDescription.lights = edited.lights;
+        // no local lights left: nothing rebuilds the clusters, so empty them here
+        if (sceneDescription.lights.empty())
+            clusteredLights.clear();
+        // processInput steps through the presets on the main thread, which a render thread doesn't own
+        if (!renderThread)
+            cameraPresets = edited.cameras;
+        if (edited.environment != sceneDescription.environment && !std::getenv("EXR_PATH"))
+        {
+            if (edited.environment == "procedural")
+            {
+                proceduralSkyActive = true;
+                proceduralSkyChanged = true;
+            }
+            else if (!edited.environment.empty())
+                droppedEnvironments.push_back(edited.environment);
+            sceneDescription.environment = edited.environment;
+        }
+        LOG_INFO("[HotReload] " << sceneDescription.file << ": " << sceneDescription.lights.size() << " lights, "
+                 << edited.cameras.size() << " cameras");
+    };
 
-        // Draw all placed models using their stored baseModelMatrix. If a model is marked
-        // movable, apply the runtime `carOffset` (left-multiplied so it translates in world space).
-        if (!placedModels.empty())
+    // render loop
+    // -----------
+    // bool screenshotTaken = false;
+    // int _debugFrameCount = 0;
+    auto renderLoop = [&]()
+    {
+        while (!glfwWindowShouldClose(window))
         {
-            for (const auto &pm : placedModels)
+            static bool entered = false;
+            if (!entered)
+            {
+                LOG_INFO("Entering render loop.");
+                entered = true;
+            }
+            // checked before the idle wait, which returns here at least every IDLE_TIMEOUT_MS
+            if (hotReload && hotReload->pump(EngineClock::seconds()))
+            {
+                if (hotReload->sceneChanged())
+                    applySceneEdits();
+                redrawRequested = true;
+                idleRenderer.wake();
+            }
+            // IDLE_RENDER: an unchanged scene isn't drawn again; block for events, keeping the last frame up
+            if (idleRenderer.sleeping())
+            {
+                // the main thread's callbacks feed input.events; a render thread hears of them as a new snapshot
+                bool woken = false;
+                if (renderThread)
+                    woken = snapshots.waitForPublish(idleRenderer.timeout());
+                else
+                {
+                    idleRenderer.wait();
+                    woken = input.events.redraw || streamer.inputPending();
+                }
+                if (!woken)
+                    continue;
+                idleRenderer.wake();
+            }
+            // geometry pages emptied by unloaded models go back to the driver while nothing is loading
+            geometryArena().collect(modelLoader.idle());
+            // VRAM per category and owner once everything queued is loaded and baked
+            static bool memoryReported = false;
+            if (!memoryReported && modelLoader.idle() && !environment.busy() && !placedModels.empty())
+            {
+                std::ostringstream report;
+                gpuMemory().report(report);
+                geometryArena().report(report);
+                modelCache.report(report);
+                LOG_INFO(report.str());
+                memoryReported = true;
+                std::ostringstream startup;
+                startupTimings().report(startup);
+                LOG_INFO(startup.str());
+            }
+            // BENCHMARK: starts measuring once everything is loaded and baked, leaves after the last measured frame
+            benchmark.beginFrame(modelLoader.idle() && !environment.busy() && !placedModels.empty());
+            if (benchmark.finished())
+            {
+                benchmark.write();
+                break;
+            }
+            // INPUT_RECORD / INPUT_REPLAY: the same readiness starts the recording or the replay; a replay
+            // leaves after the recording's last event
+            inputLog.beginFrame(modelLoader.idle() && !environment.busy() && !placedModels.empty());
+            if (inputLog.finished())
+                break;
+            // BATCH_JOB: the same readiness, then one shot after the other; leaves after the last capture
+            batch.beginFrame(modelLoader.idle() && !environment.busy() && !placedModels.empty());
+            if (batch.finished())
+                break;
+            // POSTER: the same again, then one tile after the other from the camera's startup pose
+            poster.beginFrame(modelLoader.idle() && !environment.busy() && !placedModels.empty());
+            if (poster.finished())
+                break;
+            if (!benchmark.enabled())
+                hud.beginFrame();
+            profiler.beginFrame();
+            if (frameCapture)
+                frameCapture->poll();
+            streamer.poll();
+            frameShare.poll();
+            sessionViews.poll();
+            frameRing().beginFrame();
+            frameArena().reset();
+            // GL_CAPTURE: the chosen frame's calls go to the capture file from here to the swap
+            glCapture().beginFrame();
+            profiler.begin("frame");
+            // finish model imports / stream textures (bounded per frame), then place newly drawable models
+            modelLoader.pump();
+            placeReadyModels();
+            // LAZY_REGIONS=1: the cabin and underside textures of the models the camera has come near
+            static const bool lazyRegions = MeshRegions::enabledByEnv();
+            if (lazyRegions)
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    placedModels[i].model->requestRegions(glm::vec3(glm::inverse(placedMatrix(placedModels[i])) * glm::vec4(camera.Position, 1.0f)), 2.0);
+            if (variantCycleRequested)
+            {
+                cycleVariant();
+                variantCycleRequested = false;
+            }
+            // a variant taking over changes what casts into cascades whose bounds may not have moved
+            if (showPendingVariant())
+                shadows.invalidate();
+            if (!variantPrefetched && variantModel < scenePlaced && !variantPending)
+                prefetchNextVariant();
+            // the focused model's next material variant: its table already holds them all, so this only
+            // repoints per-vertex material indices (every placement of that model follows)
+            if (materialVariantCycleRequested && focusedModel < placedModels.size())
+            {
+                Model &m = *placedModels[focusedModel].model;
+                const int count = (int)m.materialVariants().size();
+                const int next = (m.materialVariant() + 2) % (count + 1) - 1;
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                if (count == 0)
+                    LOG_INFO("[MaterialVariants] The focused model has no KHR_materials_variants");
+                else if (!m.selectMaterialVariant(next))
+                    LOG_INFO("[MaterialVariants] The focused model draws without the material table, variants can't be selected");
+                else
+                    LOG_INFO("[MaterialVariants] " << (next < 0 ? std::string("Default materials") : "'" + m.materialVariants()[next] + "'") << " in "
+                             << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms");
+                materialVariantCycleRequested = false;
+            }
+            // the next paint: one 48-byte override the shaders apply to every paint-tagged material
+            if (paintCycleRequested)
+            {
+                static size_t paintIndex = 0; // 0 = the authored paint
+                paintIndex = (paintIndex + 1) % (sceneDescription.paints.size() + 1);
+                MaterialOverride paint;
+                if (paintIndex > 0)
+                {
+                    const SceneDescription::Paint &p = sceneDescription.paints[paintIndex - 1];
+                    if (p.color.r >= 0.0f)
+                    {
+                        paint.baseColor = glm::vec4(p.color, 1.0f);
+                        paint.mask.x |= MaterialOverride::BASE_COLOR;
+                    }
+                    if (p.metallic >= 0.0f)
+                    {
+                        paint.factors.x = p.metallic;
+                        paint.mask.x |= MaterialOverride::METALLIC;
+                    }
+                    if (p.roughness >= 0.0f)
+                    {
+                        paint.factors.y = p.roughness;
+                        paint.mask.x |= MaterialOverride::ROUGHNESS;
+                    }
+                }
+                materialOverrides().set(MaterialOverrides::PAINT, paint);
+                LOG_INFO("[Paint] " << (paintIndex > 0 ? "'" + sceneDescription.paints[paintIndex - 1].name + "'" : std::string("Authored paint")));
+                paintCycleRequested = false;
+            }
+            // the focused model with all its configurable parts, then without each one in turn: a command
+            // rewrite per mesh, no draw list rebuilt (every placement of that model follows)
+            if (partCycleRequested && focusedModel < placedModels.size())
+            {
+                Model &m = *placedModels[focusedModel].model;
+                const std::vector<std::string> parts = m.parts();
+                static int hiddenPart = -1; // -1 = all shown
+                const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                if (parts.empty())
+                    LOG_INFO("[Parts] The focused model has no configurable parts (CONFIG_PARTS)");
+                else
+                {
+                    hiddenPart = hiddenPart + 1 < (int)parts.size() ? hiddenPart + 1 : -1;
+                    size_t changed = 0;
+                    for (size_t p = 0; p < parts.size(); ++p)
+                        changed += m.setPartVisible(parts[p], (int)p != hiddenPart);
+                    LOG_INFO("[Parts] " << (hiddenPart < 0 ? std::string("All parts shown") : "'" + parts[hiddenPart] + "' hidden") << ", " << changed
+                             << " meshes toggled in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms");
+                }
+                partCycleRequested = false;
+            }
+            modelCache.promote(modelLoader);
+            // programs the driver finished compiling meanwhile are checked now rather than at their first draw
+            Shader::finishCompiles();
+            // environments dropped on the window decode in the background and bake within IBL_BUDGET_MS per frame
+            const std::string batchEnvironment = batch.takeEnvironmentRequest();
+            if (!batchEnvironment.empty())
+                droppedEnvironments.push_back(batchEnvironment);
+            for (size_t i = 0; i < droppedEnvironments.size(); ++i)
+                environment.load(droppedEnvironments[i]);
+            if (!droppedEnvironments.empty())
+                proceduralSkyActive = false;
+            droppedEnvironments.clear();
+            // sun edits re-bake the procedural sky, the newest one replacing any still queued
+            if (proceduralSkyActive && proceduralSkyChanged)
+                environment.loadProcedural(proceduralSky);
+            proceduralSkyChanged = false;
+            profiler.begin("ibl bake");
+            environment.pump(iblBudgetMs);
+            profiler.end();
+            const EnvironmentLoader::Maps &ibl = environment.current();
+
+            // input is read as late as it can be: after the frame pacing wait, just before the camera moves; the
+            // loading and baking above doesn't depend on it
+            pacer.waitForFrame(profiler);
+            if (!renderThread)
+                glfwPollEvents();
+            pacer.markInput();
+
+            // per-frame time logic
+            // --------------------
+            // benchmark runs step a fixed 1/60 s per frame so animations repeat exactly
+            const double currentFrame = benchmark.enabled()    ? benchmark.time()
+                                        : batch.enabled()      ? batch.time()
+                                        : inputLog.replaying() ? inputLog.time()
+                                                               : EngineClock::seconds();
+            deltaTime = static_cast<float>(currentFrame - lastFrame);
+            lastFrame = currentFrame;
+            // ANIMATION=1: the clips of every model evaluate as one batch on the job system meanwhile;
+            // refitSceneTree() picks them up
+            for (auto &pm : placedModels)
+                pm.model->animate(currentFrame);
+            animationBatch().start();
+
+            // input
+            // -----
+            if (batch.enabled())
+            {
+                if (!sceneTree.empty())
+                    batch.placeCamera(camera, sceneTree.boundsMin(), sceneTree.boundsMax());
+                // a new shot is a camera cut
+                if (batch.shotStarted())
+                {
+                    temporalAA.reset();
+                    still.reset();
+                    pathTracer.reset();
+                    screenReflections.resetHistory();
+                    tracedReflections.resetHistory();
+                    hasPreviousView = false;
+                }
+            }
+            else if (poster.enabled())
+            {
+                // tiles are separate views of the frame: no history may leak from one into the next
+                if (poster.tileStarted())
+                {
+                    temporalAA.reset();
+                    still.reset();
+                    pathTracer.reset();
+                    screenReflections.resetHistory();
+                    tracedReflections.resetHistory();
+                    hasPreviousView = false;
+                }
+            }
+            else if (!benchmark.enabled())
+            {
+                // interactive: input steps here, or on the main thread as it pleases with a render thread
+                if (!renderThread)
+                    publishInput(window);
+                takeSnapshot();
+            }
+            else
+            {
+                if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+                    glfwSetWindowShouldClose(window, true);
+                if (!sceneTree.empty())
+                    benchmark.placeCamera(camera, sceneTree.boundsMin(), sceneTree.boundsMax());
+            }
+            refitSceneTree();
+            GpuPicker::Pick gpuPick;
+            if (gpuPicker.poll(gpuPick))
+            {
+                if (gpuPick.placed < 0 || gpuPick.placed >= (int)placedModels.size())
+                    LOG_INFO("[Pick] nothing under the crosshair");
+                else
+                {
+                    LOG_INFO("[Pick] placed model " << gpuPick.placed << " mesh " << gpuPick.mesh);
+                    focusedModel = (size_t)gpuPick.placed;
+                    snapshots.focusOrbit(placedModels[focusedModel].worldMin, placedModels[focusedModel].worldMax);
+                }
+            }
+            // with GPU_PICKING=1's pick target the opaque pass reads the pick instead
+            if (pickRequested && !toneMapper.pickTarget())
+            {
+                // nearest placed model whose meshes the view ray hits (mesh boxes, in each model's space)
+                FrameVector<int> pickedMesh(placedModels.size(), -1);
+                float t = 0.0f;
+                int picked = sceneTree.raycast(camera.Position, camera.Front, t, [&](unsigned int i, float) {
+                    glm::mat4 toModel = glm::inverse(placedMatrix(placedModels[i]));
+                    glm::vec3 origin = glm::vec3(toModel * glm::vec4(camera.Position, 1.0f));
+                    glm::vec3 dir = glm::vec3(toModel * glm::vec4(camera.Front, 0.0f));
+                    float tMesh = -1.0f;
+                    pickedMesh[i] = placedModels[i].model->pickMesh(origin, dir, tMesh);
+                    return pickedMesh[i] < 0 ? -1.0f : tMesh;
+                });
+                if (picked >= 0)
+                {
+                    focusedModel = (size_t)picked;
+                    snapshots.focusOrbit(placedModels[focusedModel].worldMin, placedModels[focusedModel].worldMax);
+                }
+                if (picked < 0)
+                    LOG_INFO("[Pick] nothing under the crosshair");
+                else if (!placedModels[picked].model->hasTriangleBvhs())
+                    LOG_INFO("[Pick] placed model " << picked << " mesh " << pickedMesh[picked] << " at distance " << t);
+                else
+                {
+                    // a triangle hit: the world point, and how far it is from the previous one
+                    const glm::vec3 point = camera.Position + t * camera.Front;
+                    std::ostringstream measure;
+                    if (hasLastPickPoint)
+                        measure << ", " << glm::length(point - lastPickPoint) << " from the last point";
+                    LOG_INFO("[Pick] placed model " << picked << " mesh " << pickedMesh[picked] << " at (" << point.x << ", " << point.y << ", "
+                             << point.z << "), distance " << t << measure.str());
+                    lastPickPoint = point;
+                    hasLastPickPoint = true;
+                }
+                pickRequested = false;
+            }
+
+            // render
+            // ------
+            // Ensure the viewport matches the actual framebuffer size (some earlier FBO/code may have changed it)
+            int display_w = windowWidth, display_h = windowHeight;
+            if (!renderThread)
+                glfwGetFramebufferSize(window, &display_w, &display_h);
+            // batch shots render at their own size, into their own framebuffer
+            if (batch.enabled())
+            {
+                display_w = batch.width();
+                display_h = batch.height();
+                toneMapper.setOutputFramebuffer(batch.outputFramebuffer());
+            }
+            // poster tiles too, all at the tile size; the aspect (and shadow fit) is the whole poster's
+            else if (poster.enabled())
+            {
+                display_w = display_h = poster.tileSize();
+                toneMapper.setOutputFramebuffer(poster.outputFramebuffer());
+            }
+            const float aspect = batch.enabled() ? (float)display_w / (float)display_h
+                                 : poster.enabled() ? poster.aspect()
+                                                    : (float)SCR_WIDTH / (float)SCR_HEIGHT;
+            // the scene's own size: smaller than the window while dynamic resolution scales it down (only with
+            // the HDR target, which the tone map upscales; without it the scene draws into the window)
+            dynamicResolution.update(profiler.latestGpuMs("frame"));
+            const bool scaledScene = dynamicResolution.enabled() && toneMapper.ready() && !batch.enabled() && !poster.enabled();
+            const int scene_w = scaledScene ? dynamicResolution.scaled(display_w) : display_w;
+            const int scene_h = scaledScene ? dynamicResolution.scaled(display_h) : display_h;
+            glViewport(0, 0, scene_w, scene_h);
+            // into the HDR target; the background is linear (about the old 0.8 grey once tone mapped), where the
+            // skybox doesn't cover it
+            if (toneCurveCycleRequested)
+            {
+                toneMapper.setCurve((ToneMapper::Curve)((toneMapper.curve() + 1) % ToneMapper::CURVE_COUNT));
+                LOG_INFO("[ToneMap] " << ToneMapper::curveName(toneMapper.curve()) << " curve");
+                toneCurveCycleRequested = false;
+            }
+            toneMapper.begin(scene_w, scene_h);
+            if ((batch.enabled() || poster.enabled()) && !toneMapper.ready())
+            {
+                LOG_ERROR((batch.enabled() ? "[Batch]" : "[Poster]") << " Offscreen rendering needs the HDR scene target, which this GL can't create");
+                break;
+            }
+            glClearColor(0.6f, 0.6f, 0.6f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            // view/projection transformations
+            // Adjust far plane dynamically for large scenes
+            float farPlane = 100.0f;
+            const float sceneDiag = sceneTree.empty() ? 0.0f : glm::length(sceneTree.boundsMax() - sceneTree.boundsMin());
+            if (sceneDiag > 90.0f)
+                farPlane = sceneDiag * 2.0f;
+            glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), aspect, 0.1f, farPlane);
+            // a poster tile sees its slice of the full frustum
+            if (poster.rendering())
+                projection = poster.tileProjection(projection);
+            glm::mat4 view = camera.GetViewMatrix();
+            // motion vectors compare unjittered positions; everything else (culling, shadows) sees the jitter
+            const glm::mat4 unjitteredViewProjection = projection * view;
+            // a still view refines with the accumulator's own jitter; TAA starts over once it moves again
+            const bool sceneStill = placedRevision == stillRevision && modelLoader.idle() && !environment.busy() && cameraSettled;
+            stillRevision = placedRevision;
+            const bool pathTracing = pathTracer.update(unjitteredViewProjection, sceneStill);
+            if (still.update(unjitteredViewProjection, sceneStill))
+            {
+                projection = still.jitterProjection(projection, scene_w, scene_h);
+                temporalAA.reset();
+            }
+            else if (temporalAA.ready())
+                projection = temporalAA.jitterProjection(projection, scene_w, scene_h);
+            if (!hasPreviousView)
+                previousViewProjection = unjitteredViewProjection;
+
+            // bind IBL textures once (bindings are global state; the cache skips them after the first frame)
+            glState().bindTexture(11, GL_TEXTURE_CUBE_MAP, ibl.prefilterMap ? ibl.prefilterMap : ibl.envCubemap);
+            glState().bindTexture(12, GL_TEXTURE_2D, brdfLUTTexture.get());
+            glState().bindTexture(LTCLUT::UNIT, GL_TEXTURE_2D_ARRAY, ltcLUTTexture.get());
+
+            // reflection probes follow their models; the parallax box is the scene's bounds plus a margin
+            if (probesEnabled && !placedModels.empty())
+            {
+                const glm::vec3 sceneMin = sceneTree.boundsMin(), sceneMax = sceneTree.boundsMax();
+                const glm::vec3 margin = (sceneMax - sceneMin) * 0.25f;
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                {
+                    glm::vec3 center = (placedModels[i].worldMin + placedModels[i].worldMax) * 0.5f;
+                    glm::vec3 size = placedModels[i].worldMax - placedModels[i].worldMin;
+                    if (i < probes.count())
+                        probes.place((int)i, center, sceneMin - margin, sceneMax + margin);
+                    else if (i == probes.count())
+                        probes.add(center, glm::length(size) * 0.6f, sceneMin - margin, sceneMax + margin, (int)i);
+                }
+                GpuProfiler::Scope scope(profiler, "probe capture");
+                probes.update(drawProbeScene, probeBudgetMs, 0.05f, farPlane);
+                glViewport(0, 0, scene_w, scene_h);
+            }
+            // irradiance volumes follow their models and are baked again where they come to rest
+            if (irradianceVolume.ready() && !placedModels.empty())
+            {
+                irradianceVolume.trim(placedModels.size());
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                {
+                    const Model &model = *placedModels[i].model;
+                    irradianceVolume.place(i, placedMatrix(placedModels[i]), model.boundsMin, model.boundsMax, model.isProxy());
+                }
+                GpuProfiler::Scope scope(profiler, "irradiance volume");
+                irradianceVolume.update(drawProbeScene, irradianceBudgetMs, 0.05f, farPlane);
+                glViewport(0, 0, scene_w, scene_h);
+            }
+            // the traced reflections' and the path tracer's instances, where the models are this frame
+            if (tracedReflections.ready())
+            {
+                tracedReflections.beginScene();
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    tracedReflections.addModel(*placedModels[i].model, placedMatrix(placedModels[i]));
+            }
+            if (pathTracing)
             {
-                Shader *sh = (&CarModel == pm.model) ? &carShader : &ourShader;
-                sh->use();
-                glm::mat4 finalModel = pm.baseModelMatrix;
-                if (pm.movable)
+                pathTracer.beginScene();
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    pathTracer.addModel(*placedModels[i].model, placedMatrix(placedModels[i]));
+            }
+            // sun shadows: cascades whose contents or bounds changed are re-rendered, the others reused
+            if (shadowsEnabled && !placedModels.empty())
+            {
+                GpuProfiler::Scope scope(profiler, "shadows");
+                shadowCasters.clear();
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    shadowCasters.push_back(std::make_pair(placedModels[i].worldMin, placedModels[i].worldMax));
+                if (shadows.update(proceduralSky.sunDirection, view, glm::radians(camera.Zoom), aspect, 0.1f, farPlane,
+                                   shadowCasters, drawShadowCasters) > 0)
+                    glViewport(0, 0, scene_w, scene_h);
+            }
+            // local lights for this view: the scene's fixed ones and the circling showroom lights, rebuilt every
+            // frame, then binned into the clusters of the view grid
+            if ((showroomLights > 0 || softboxes > 0 || !sceneDescription.lights.empty()) && !placedModels.empty())
+            {
+                const glm::vec3 sceneMin = sceneTree.boundsMin(), sceneMax = sceneTree.boundsMax();
+                const glm::vec3 centre = (sceneMin + sceneMax) * 0.5f, extent = sceneMax - sceneMin;
+                const float ring = 0.6f * std::max(extent.x, extent.z);
+                static const glm::vec3 palette[4] = {glm::vec3(1.0f, 0.85f, 0.7f), glm::vec3(0.6f, 0.75f, 1.0f), glm::vec3(1.0f, 0.5f, 0.4f), glm::vec3(0.7f, 1.0f, 0.7f)};
+                clusteredLights.clear();
+                for (size_t k = 0; k < sceneDescription.lights.size(); ++k)
+                    clusteredLights.add(sceneDescription.lights[k]);
+                for (int k = 0; k < showroomLights; ++k)
+                {
+                    const float angle = 6.2831853f * k / showroomLights + (float)std::fmod(currentFrame * 0.2, 6.283185307179586);
+                    ClusteredLights::Light light;
+                    light.position = centre + glm::vec3(std::cos(angle) * ring, 0.5f * extent.y + 1.0f, std::sin(angle) * ring);
+                    light.radius = 0.5f * ring + 2.0f;
+                    light.color = palette[k % 4];
+                    light.intensity = 8.0f;
+                    if (k % 3 == 0)
+                    {
+                        light.direction = centre - light.position;
+                        light.cosInner = std::cos(glm::radians(20.0f));
+                        light.cosOuter = std::cos(glm::radians(30.0f));
+                        light.radius *= 2.0f;
+                    }
+                    clusteredLights.add(light);
+                }
+                // softboxes: a row of strips across X, each as long as the scene is deep
+                for (int k = 0; k < softboxes; ++k)
                 {
-                    finalModel = glm::translate(glm::mat4(1.0f), carOffset) * finalModel;
+                    ClusteredLights::Light light;
+                    light.position = glm::vec3(sceneMin.x + extent.x * (k + 0.5f) / softboxes, sceneMax.y + 1.5f, centre.z);
+                    light.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+                    light.size = glm::vec2(std::max(0.5f, 0.5f * extent.x / softboxes), std::max(2.0f, 0.8f * extent.z));
+                    light.up = glm::vec3(0.0f, 0.0f, 1.0f);
+                    light.radius = 2.0f * (extent.y + 1.5f) + glm::length(light.size);
+                    light.color = glm::vec3(1.0f, 0.97f, 0.92f);
+                    light.intensity = 4.0f;
+                    clusteredLights.add(light);
                 }
-                sh->setMat4("model", finalModel);
-                pm.model->Draw(*sh, finalModel, camera.Position);
+                clusteredLights.update(view, projection, 0.1f, farPlane, scene_w, scene_h);
             }
-            // restore default shader state
+            // VRS: last frame's rate image, its pattern turning under TAA
+            if (still.accumulating())
+                shadingRate.skip();
+            else
+                shadingRate.begin(scene_w, scene_h, temporalAA.ready());
             ourShader.use();
-            ourShader.setMat4("model", model);
-        }
-        else
-        {
-            // fallback to direct draws if no placedModels present
-            ourModel.Draw(ourShader, model, camera.Position);
-            glm::mat4 carModelMat = glm::translate(glm::mat4(1.0f), -carBBoxCenter + glm::vec3(0.0f, -carBBoxSize.y * 0.5f, 0.0f) + carOffset);
-            if (carBBoxDiag > 200.0f)
+            probes.apply(ourShader);
+            irradianceVolume.apply(ourShader);
+            clusteredLights.apply(ourShader);
+            shadows.apply(ourShader);
+            shadingRate.apply(ourShader);
+            livery.apply(ourShader);
+            if (weightedOIT.ready())
             {
-                float scaleFactor = 200.0f / carBBoxDiag;
-                carModelMat = glm::scale(carModelMat, glm::vec3(scaleFactor));
+                oitShader.use();
+                probes.apply(oitShader);
+                irradianceVolume.apply(oitShader);
+                clusteredLights.apply(oitShader);
+                shadows.apply(oitShader);
+            }
+            if (visibilityBuffer.ready())
+            {
+                visibilityResolveShader.use();
+                probes.apply(visibilityResolveShader);
+                irradianceVolume.apply(visibilityResolveShader);
+                clusteredLights.apply(visibilityResolveShader);
+                shadows.apply(visibilityResolveShader);
+                livery.apply(visibilityResolveShader);
             }
-            ourShader.setMat4("model", carModelMat);
-            CarModel.Draw(ourShader, carModelMat, camera.Position);
-            ourShader.setMat4("model", model);
-        }
 
-        // Check GL errors and optionally capture the framebuffer once for offline inspection
-        // glCheck("after model draw");
-        // Print model-control help periodically (user can disable by setting showModelControlHelp=false)
-        if (showModelControlHelp)
-        {
-            static float lastHelpPrint = 0.0f;
-            float t = glfwGetTime();
-            if (t - lastHelpPrint > 3.0f)
+            // Debug: print once that we're about to draw
+            if (!printedDrawMessage)
             {
-                std::cout << "Model controls: Arrow keys move CarModel on X/Z, PageUp/PageDown move Y, R resets car offset." << std::endl;
-                lastHelpPrint = t;
+                LOG_DEBUG("[render debug] Drawing placed models...");
+                printedDrawMessage = true;
             }
-        }
 
-        // Debug: print placed models' world-space origin positions (throttled)
-        {
-            static float lastModelPrint = 0.0f;
-            float t = glfwGetTime();
-            const float modelPrintInterval = 0.5f; // seconds
-            if (t - lastModelPrint > modelPrintInterval)
+            // Draw all placed models using their stored baseModelMatrix. If a model is marked
+            // movable, apply the runtime `carOffset` (left-multiplied so it translates in world space).
+            const glm::mat4 viewProjection = projection * view;
+            // CULL_DEBUG: frustum culling and detail levels may keep a frozen view while this one moves on
+            if (cullFreezeRequested)
+            {
+                if (cullDebug.ready())
+                    cullDebug.toggleFreeze(viewProjection);
+                cullFreezeRequested = false;
+            }
+            const glm::mat4 cullViewProjection = cullDebug.cullViewProjection(viewProjection);
+            // the parking lot's impostor atlases, through FrameData of their own
+            if (impostors.ready() && parkingLot > 0 && parkingModel)
+                impostors.bake(*parkingModel);
+            decals.update(drawnModels, EngineClock::seconds());
+            // visible placed models (culled below; still last frame's here)
+            static std::vector<unsigned char> placedVisible;
+            // the livery pages this view asks for, from last frame's visible models at a fraction of the size
+            if (livery.ready() && !stereo.ready())
+            {
+                livery.update();
+                livery.feedback(projection, view, camera.Position, scene_w, scene_h, [&](Shader &shader) {
+                    for (size_t i = 0; i < placedModels.size() && i < placedVisible.size(); ++i)
+                        if (placedVisible[i])
+                            placedModels[i].model->Draw(shader, placedMatrix(placedModels[i]), camera.Position, &viewProjection);
+                });
+            }
+            // the main view's FrameData (shadow cascades and probe faces bound their own above)
+            FrameData mainFrame = makeFrameData(projection, view, camera.Position);
+            mainFrame.setMotion(unjitteredViewProjection, previousViewProjection);
+            mainFrame.setIblSeed(still.iblSeed());
+            mainFrame.bind();
+            // whole models first; the visible ones cull their meshes against the same frustum (the debug views
+            // draw the same set after the tone map)
+            if (!placedModels.empty() && !stereo.ready())
             {
-                lastModelPrint = t;
-                if (!placedModels.empty())
+                sceneTree.cull(Frustum(cullViewProjection), placedVisible);
+                // detail levels for this view (probe captures reuse them next frame)
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    if (placedVisible[i])
+                    {
+                        placedModels[i].model->selectLods(cullViewProjection, placedMatrix(placedModels[i]), (float)display_h);
+                        placedModels[i].model->requestTextureLevels(viewProjection, placedMatrix(placedModels[i]), (float)display_h);
+                    }
+                    else
+                        drawStats().countCulled(placedModels[i].model->meshes.size(), placedModels[i].model->meshes.size());
+                // and the texture levels they need (TEXTURE_STREAMING=1)
+                textureStreamer().update();
+                transparentQueue.begin();
+                profiler.begin("opaque");
+                // the opaque surfaces own their pixels' motion; the rest of the frame keeps its colour output only
+                toneMapper.writeMotionVectors(true);
+                if (depthPrepass)
                 {
-                    std::vector<glm::vec3> worldPositions;
-                    worldPositions.reserve(placedModels.size());
+                    depthShader.use();
+                    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
                     for (size_t i = 0; i < placedModels.size(); ++i)
                     {
-                        const auto &pm = placedModels[i];
-                        glm::mat4 finalModel = pm.baseModelMatrix;
-                        if (pm.movable)
-                            finalModel = glm::translate(glm::mat4(1.0f), carOffset) * finalModel;
-                        glm::vec4 wp = finalModel * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-                        glm::vec3 worldPos = glm::vec3(wp);
-                        worldPositions.push_back(worldPos);
-                        std::cout << "[ModelPos] placedModels[" << i << "] ptr=" << pm.model << " movable=" << (pm.movable ? "YES" : "NO")
-                                  << " worldPos=" << worldPos.x << "," << worldPos.y << "," << worldPos.z << std::endl;
+                        if (!placedVisible[i])
+                            continue;
+                        placedModels[i].model->drawDepthPrepass(depthShader, placedMatrix(placedModels[i]), camera.Position, cullViewProjection);
+                    }
+                    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                    // pre-pass depths pass with equality; meshes it skipped (alpha tested, instanced) still write
+                    glDepthFunc(GL_LEQUAL);
+                    if (ambientOcclusion.ready())
+                    {
+                        GpuProfiler::Scope scope(profiler, "ssao");
+                        ambientOcclusion.compute(scene_w, scene_h, projection);
+                        ourShader.use();
+                        ambientOcclusion.apply(ourShader);
+                    }
+                    if (screenReflections.ready())
+                    {
+                        GpuProfiler::Scope scope(profiler, "ssr");
+                        screenReflections.trace(scene_w, scene_h, projection, view, previousViewProjection);
+                        ourShader.use();
+                        screenReflections.apply(ourShader);
+                    }
+                    if (tracedReflections.ready())
+                    {
+                        GpuProfiler::Scope scope(profiler, "rt reflections");
+                        tracedReflections.trace(scene_w, scene_h, projection * view, previousViewProjection, camera.Position, ibl.prefilterMaxMip);
+                        ourShader.use();
+                        tracedReflections.apply(ourShader);
+                    }
+                }
+                // VISIBILITY_BUFFER=1: IDs of the opaque buckets now, their shading after the last opaque draw
+                const bool visibilityPass = visibilityBuffer.ready() && visibilityBuffer.begin(scene_w, scene_h, toneMapper.depthTarget());
+                // with occlusion culling: last frame's visible set, Hi-Z + test, then the newly visible meshes
+                for (int pass = 0; pass < (occlusionCulling ? 2 : 1); ++pass)
+                {
+                    if (pass == 1)
+                    {
+                        occlusion.buildPyramid(scene_w, scene_h);
+                        for (size_t i = 0; i < placedModels.size(); ++i)
+                            if (placedVisible[i])
+                                placedModels[i].model->cullOcclusion(occlusion, viewProjection, placedMatrix(placedModels[i]), camera.Position);
+                    }
+                    // GPU_DRIVEN: each drawn model's opaque draws in all of its placements, a dispatch and a
+                    // multi-draw per bucket; the loop below only adds the instanced and transparent meshes
+                    for (size_t s = 0; gpuDriven && s < drawnModels.size(); ++s)
+                    {
+                        static std::vector<glm::mat4> placements;
+                        placements.clear();
+                        for (size_t i = 0; i < placedModels.size(); ++i)
+                            if (placedModels[i].model == drawnModels[s])
+                                placements.push_back(placedMatrix(placedModels[i]));
+                        ourShader.use();
+                        drawnModels[s]->setPreviousModelMatrix(glm::mat4(1.0f));
+                        drawnModels[s]->drawGpuDriven(ourShader, sceneCuller, placements, placedRevision, cullViewProjection);
                     }
-                    // pairwise check: are any two models effectively at the same world position?
-                    const float sameEps = 1e-3f; // distance threshold
-                    bool anySame = false;
-                    for (size_t a = 0; a < worldPositions.size(); ++a)
+                    for (size_t i = 0; i < placedModels.size(); ++i)
                     {
-                        for (size_t b = a + 1; b < worldPositions.size(); ++b)
+                        if (!placedVisible[i])
+                            continue;
+                        const PlacedModel &pm = placedModels[i];
+                        ourShader.use();
+                        if (gpuPicker.ready())
                         {
-                            float d = glm::length(worldPositions[a] - worldPositions[b]);
-                            if (d <= sameEps)
-                            {
-                                std::cout << "[ModelPos] placedModels[" << a << "] and placedModels[" << b << "] are at the SAME world location (d=" << d << ")" << std::endl;
-                                anySame = true;
-                            }
+                            pm.model->preparePicking();
+                            gpuPicker.setObject(i);
                         }
+                        glm::mat4 finalModel = placedMatrix(pm);
+                        // several placed models may share a Model, so its previous matrix is set per draw
+                        pm.model->setPreviousModelMatrix(pm.drawnBefore ? pm.previousMatrix : finalModel);
+                        if (occlusionCulling)
+                            pm.model->drawOcclusionPass(ourShader, finalModel, camera.Position, viewProjection, occlusion,
+                                                        pass == 0 ? Model::OCCLUSION_FIRST_PASS : Model::OCCLUSION_SECOND_PASS,
+                                                        &transparentQueue, (unsigned int)i);
+                        else if (visibilityPass)
+                            pm.model->drawVisibility(ourShader, visibilityBuffer, finalModel, camera.Position, cullViewProjection, transparentQueue, (unsigned int)i);
+                        else if (gpuDriven)
+                            pm.model->drawUnbatched(ourShader, finalModel, camera.Position, cullViewProjection, &transparentQueue, (unsigned int)i);
+                        else
+                            pm.model->Draw(ourShader, finalModel, camera.Position, &cullViewProjection, &meshletCuller, &transparentQueue, (unsigned int)i);
                     }
-                    if (!anySame)
-                        std::cout << "[ModelPos] All placed models are at different world locations." << std::endl;
                 }
-                else
+                gpuPicker.clearObject();
+                if (depthPrepass)
+                    glDepthFunc(GL_LESS);
+                // parking lot: the grid follows the scene's parking_lot model; each copy is culled as a whole
+                for (size_t i = 0; parkingLot > 0 && parkingModel && i < placedModels.size(); ++i)
+                {
+                    if (placedModels[i].model != parkingModel)
+                        continue;
+                    const glm::mat4 carMatrix = placedMatrix(placedModels[i]);
+                    const glm::vec3 size = placedModels[i].bboxMax - placedModels[i].bboxMin;
+                    const float scale = glm::length(glm::vec3(carMatrix[0]));
+                    const int columns = (int)std::ceil(std::sqrt((float)parkingLot));
+                    // common car colours, linear RGB
+                    static const glm::vec3 palette[] = {
+                        glm::vec3(0.80f, 0.80f, 0.78f), glm::vec3(0.02f, 0.02f, 0.02f), glm::vec3(0.30f, 0.31f, 0.32f),
+                        glm::vec3(0.55f, 0.56f, 0.57f), glm::vec3(0.45f, 0.02f, 0.02f), glm::vec3(0.02f, 0.06f, 0.25f),
+                        glm::vec3(0.05f, 0.16f, 0.08f), glm::vec3(0.60f, 0.45f, 0.25f), glm::vec3(0.70f, 0.30f, 0.02f)};
+                    static Impostors::Placements parked;
+                    parked.clear();
+                    for (int k = 0; k < parkingLot; ++k)
+                    {
+                        glm::vec3 offset((k % columns - (columns - 1) * 0.5f) * size.x * 1.3f, 0.0f, (k / columns + 1) * size.z * 1.2f);
+                        glm::mat4 m = glm::translate(glm::mat4(1.0f), offset * scale) * carMatrix;
+                        if (Frustum(cullViewProjection * m).classify(parkingModel->boundsMin, parkingModel->boundsMax) == Frustum::OUTSIDE)
+                            continue;
+                        // stable per copy, whatever the camera culls
+                        unsigned int seed = (unsigned int)k * 2654435761u;
+                        seed ^= seed >> 16;
+                        const glm::uvec3 variation = parkingVariety
+                            ? Mesh::instanceVariation(palette[seed % (sizeof(palette) / sizeof(palette[0]))], MaterialOverrides::PAINT,
+                                                      0.6f * (float)((seed >> 8) & 255u) / 255.0f, seed)
+                            : glm::uvec3(0u);
+                        parked.push_back(m, variation);
+                    }
+                    // the far ones as impostors, crossfading with their meshes across the hand-over band
+                    static Impostors::Placements parkedMeshes, parkedImpostors;
+                    glm::vec2 impostorFade(0.0f);
+                    impostors.split(*parkingModel, parked, camera.Position, projection[1][1], (float)display_h, parkedMeshes, parkedImpostors, impostorFade);
+                    static const Shader::UniformHandle uImpostorFade = Shader::uniformHandle("impostorFade");
+                    ourShader.use();
+                    ourShader.setVec2(uImpostorFade, impostorFade);
+                    // placements go in the instance matrices; their motion vectors carry the camera's motion only
+                    parkingModel->setPreviousModelMatrix(glm::mat4(1.0f));
+                    parkingModel->DrawInstances(ourShader, parkedMeshes.matrices, camera.Position, &parkedMeshes.variations);
+                    ourShader.setVec2(uImpostorFade, glm::vec2(0.0f));
+                    impostors.draw(*parkingModel, parkedImpostors, impostorFade);
+                    break;
+                }
+                // VEHICLE_SIM's AI cars: the player's model again, one instanced draw per bucket, each in a paint
+                // of its own
+                if (vehiclePoses.size() > 1 && vehiclePlaced < placedModels.size())
                 {
-                    // If fallback drawing is used, print main model and car fallback positions
-                    glm::vec4 mainWP = model * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-                    glm::vec4 carWP = carmodel * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-                    std::cout << "[ModelPos] (fallback) mainModel worldPos=" << mainWP.x << "," << mainWP.y << "," << mainWP.z << std::endl;
-                    std::cout << "[ModelPos] (fallback) carModel worldPos=" << carWP.x << "," << carWP.y << "," << carWP.z << std::endl;
-                    float d = glm::length(glm::vec3(mainWP) - glm::vec3(carWP));
-                    if (d <= 1e-3f)
-                        std::cout << "[ModelPos] (fallback) mainModel and carModel are at the SAME world location (d=" << d << ")" << std::endl;
+                    const PlacedModel &car = placedModels[vehiclePlaced];
+                    // from the car's model space to its body frame as it was spawned
+                    const glm::mat4 bodyFromModel = glm::inverse(vehicleSpawn) * glm::translate(glm::mat4(1.0f), carOffset) * car.baseModelMatrix;
+                    static Impostors::Placements traffic;
+                    traffic.clear();
+                    for (size_t k = 1; k < vehiclePoses.size(); ++k)
+                    {
+                        const glm::mat4 m = vehiclePoses[k] * bodyFromModel;
+                        if (Frustum(cullViewProjection * m).classify(car.model->boundsMin, car.model->boundsMax) == Frustum::OUTSIDE)
+                            continue;
+                        unsigned int seed = (unsigned int)k * 2246822519u;
+                        seed ^= seed >> 15;
+                        const glm::vec3 paint(((seed >> 4) & 255u) / 255.0f, ((seed >> 12) & 255u) / 255.0f, ((seed >> 20) & 255u) / 255.0f);
+                        traffic.push_back(m, Mesh::instanceVariation(paint * paint, MaterialOverrides::PAINT, 0.2f * ((seed >> 28) & 15u) / 15.0f, seed));
+                    }
+                    // like the parking lot, their motion vectors carry the camera's motion only
+                    ourShader.use();
+                    car.model->setPreviousModelMatrix(glm::mat4(1.0f));
+                    car.model->DrawInstances(ourShader, traffic.matrices, camera.Position, &traffic.variations);
+                }
+                if (visibilityPass)
+                {
+                    GpuProfiler::Scope scope(profiler, "visibility resolve");
+                    if (ambientOcclusion.ready())
+                    {
+                        GpuProfiler::Scope ssaoScope(profiler, "ssao");
+                        ambientOcclusion.compute(scene_w, scene_h, projection);
+                        visibilityResolveShader.use();
+                        ambientOcclusion.apply(visibilityResolveShader);
+                    }
+                    if (screenReflections.ready())
+                    {
+                        GpuProfiler::Scope ssrScope(profiler, "ssr");
+                        screenReflections.trace(scene_w, scene_h, projection, view, previousViewProjection);
+                        visibilityResolveShader.use();
+                        screenReflections.apply(visibilityResolveShader);
+                    }
+                    if (tracedReflections.ready())
+                    {
+                        GpuProfiler::Scope rtScope(profiler, "rt reflections");
+                        tracedReflections.trace(scene_w, scene_h, projection * view, previousViewProjection, camera.Position, ibl.prefilterMaxMip);
+                        visibilityResolveShader.use();
+                        tracedReflections.apply(visibilityResolveShader);
+                    }
+                    visibilityBuffer.beginResolve();
+                    for (size_t s = 0; s < drawnModels.size(); ++s)
+                        drawnModels[s]->resolveVisibility(visibilityResolveShader, visibilityBuffer);
+                    visibilityBuffer.endResolve();
+                }
+                toneMapper.writeMotionVectors(false);
+                // VRS: the skipped quads from their shaded neighbours, before the transparent surfaces go over them
+                if (shadingRate.shadingCoarsely())
+                {
+                    GpuProfiler::Scope scope(profiler, "vrs reconstruct");
+                    shadingRate.reconstruct();
+                }
+                if (skybox.ready())
+                {
+                    GpuProfiler::Scope scope(profiler, "skybox");
+                    if (proceduralSkyActive)
+                        skybox.drawSky(projection, view, proceduralSky);
                     else
-                        std::cout << "[ModelPos] (fallback) mainModel and carModel are at different world locations (d=" << d << ")" << std::endl;
+                        skybox.draw(projection, view, ibl.envCubemap);
                 }
-            }
-        }
-        if (!debugCaptured)
-        {
-            if (const char *dc = std::getenv("DEBUG_CAPTURE"))
-            {
-                if (std::string(dc) == "1")
+                // the pixel under the crosshair (the cursor is captured), mapped by poll() once the GPU is done
+                if (pickRequested && toneMapper.pickTarget() && gpuPicker.read(scene_w / 2, scene_h / 2))
+                    pickRequested = false;
+                profiler.end();
+                // the opaque scene behind the glass, when some visible model has transmissive meshes
+                bool transmissionVisible = false;
+                for (size_t i = 0; transmissionEnabled && i < placedModels.size() && !transmissionVisible; ++i)
+                    transmissionVisible = placedVisible[i] && placedModels[i].model->hasTransmission();
+                if (transmissionVisible)
+                {
+                    GpuProfiler::Scope scope(profiler, "refraction copy");
+                    refractionCopy.capture(scene_w, scene_h);
+                }
+                else
+                    refractionCopy.skip();
+                ourShader.use();
+                refractionCopy.apply(ourShader);
+                if (weightedOIT.ready())
+                {
+                    oitShader.use();
+                    refractionCopy.apply(oitShader);
+                }
+                // then every placed model's transparent meshes, back to front across models
+                profiler.begin("transparent");
+                transparentQueue.sort(camera.Position, placedRevision, transparentResortDistance);
+                for (size_t k = 0; k < transparentQueue.size();)
                 {
-                    glFinish();
-                    int w = SCR_WIDTH;
-                    int h = SCR_HEIGHT;
-                    std::vector<unsigned char> pixels(w * h * 4);
-                    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-                    // flip vertically
-                    std::vector<unsigned char> flipped(w * h * 4);
-                    for (int y = 0; y < h; ++y)
+                    const unsigned int source = transparentQueue[k].source;
+                    size_t end = k + 1;
+                    while (end < transparentQueue.size() && transparentQueue[end].source == source)
+                        ++end;
+                    const PlacedModel &pm = placedModels[source];
+                    ourShader.use();
+                    pm.model->drawQueuedTransparent(ourShader, placedMatrix(pm), transparentQueue, k, end);
+                    k = end;
+                }
+                // and the weighted blended ones in any order, resolved over the frame in one pass (blended
+                // unsorted on top when the OIT targets are unavailable)
+                if (Model::weightedBlendEnabled())
+                {
+                    const bool oit = weightedOIT.begin(scene_w, scene_h);
+                    for (size_t i = 0; i < placedModels.size(); ++i)
                     {
-                        memcpy(&flipped[y * w * 4], &pixels[(h - 1 - y) * w * 4], w * 4);
+                        if (!placedVisible[i])
+                            continue;
+                        const PlacedModel &pm = placedModels[i];
+                        Shader *sh = oit ? &oitShader : &ourShader;
+                        sh->use();
+                        pm.model->drawWeightedTransparent(*sh, placedMatrix(pm));
                     }
-                    const char *outPath = "frame_debug.png";
-                    if (stbi_write_png(outPath, w, h, 4, flipped.data(), w * 4))
+                    if (oit)
+                        weightedOIT.resolve();
+                }
+                profiler.end();
+                // restore default shader state
+                ourShader.use();
+            }
+            else if (!placedModels.empty())
+            {
+                // STEREO: one cull, one set of detail levels and one draw per mesh for both eyes; the geometry
+                // stage sends each triangle to both layers
+                GpuProfiler::Scope scope(profiler, "stereo");
+                const int eyeWidth = std::max(display_w / 2, 1);
+                stereo.setup(camera.Position, camera.Front, camera.Up, camera.Right, glm::radians(camera.Zoom),
+                             (float)eyeWidth / (float)std::max(display_h, 1), 0.1f, farPlane);
+                const glm::mat4 &stereoViewProjection = stereo.cullViewProjection();
+                static std::vector<unsigned char> stereoVisible;
+                sceneTree.cull(Frustum(stereoViewProjection), stereoVisible);
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    if (stereoVisible[i])
                     {
-                        std::cout << "Saved framebuffer to: " << outPath << std::endl;
+                        placedModels[i].model->selectLods(stereoViewProjection, placedMatrix(placedModels[i]), (float)display_h);
+                        placedModels[i].model->requestTextureLevels(stereoViewProjection, placedMatrix(placedModels[i]), (float)display_h);
                     }
                     else
+                        drawStats().countCulled(placedModels[i].model->meshes.size(), placedModels[i].model->meshes.size());
+                textureStreamer().update();
+                if (stereo.begin(eyeWidth, display_h, glm::vec4(0.6f, 0.6f, 0.6f, 1.0f)))
+                {
+                    Shader &stereoShader = stereo.shader();
+                    stereoShader.use();
+                    probes.apply(stereoShader);
+                    irradianceVolume.apply(stereoShader);
+                    shadows.apply(stereoShader);
+                    for (size_t i = 0; i < placedModels.size(); ++i)
                     {
-                        std::cerr << "Failed to save framebuffer to: " << outPath << std::endl;
+                        if (!stereoVisible[i])
+                            continue;
+                        const glm::mat4 finalModel = placedMatrix(placedModels[i]);
+                        placedModels[i].model->setPreviousModelMatrix(finalModel);
+                        placedModels[i].model->Draw(stereoShader, finalModel, camera.Position, &stereoViewProjection);
                     }
-                    // optionally exit after capture so you can inspect the file
-                    std::cout << "DEBUG_CAPTURE done; exiting." << std::endl;
-                    debugCaptured = true;
-                    // terminate loop and program
-                    glfwSwapBuffers(window);
-                    glfwPollEvents();
-                    glfwTerminate();
-                    return 0;
+                }
+                ourShader.use();
+            }
+
+            // Print model-control help periodically (user can disable by setting showModelControlHelp=false);
+            // benchmark runs ignore input, and their frames are meant to allocate nothing
+            if (snapshots.front().showModelControlHelp && !benchmark.enabled())
+            {
+                static double lastHelpPrint = 0.0;
+                const double t = EngineClock::seconds();
+                if (t - lastHelpPrint > 3.0)
+                {
+                    LOG_INFO("Model controls: Arrow keys move CarModel on X/Z, PageUp/PageDown move Y, R resets car offset.");
+                    lastHelpPrint = t;
                 }
             }
-        }
 
-        // -------------------------------------------------------------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            // Debug: print placed models' world-space origin positions (throttled, and only after they changed)
+            {
+                static double lastModelPrint = 0.0;
+                static unsigned int printedRevision = ~0u;
+                const double t = EngineClock::seconds();
+                const double modelPrintInterval = 0.5; // seconds
+                if (t - lastModelPrint > modelPrintInterval && !placedModels.empty() && printedRevision != placedRevision)
+                {
+                    lastModelPrint = t;
+                    printedRevision = placedRevision;
+                    if (!placedModels.empty())
+                    {
+                        FrameVector<glm::vec3> worldPositions;
+                        worldPositions.reserve(placedModels.size());
+                        for (size_t i = 0; i < placedModels.size(); ++i)
+                        {
+                            const auto &pm = placedModels[i];
+                            glm::vec3 worldPos = glm::vec3(pm.worldMatrix[3]);
+                            worldPositions.push_back(worldPos);
+                            LOG_DEBUG("[ModelPos] placedModels[" << i << "] ptr=" << pm.model << " movable=" << (pm.movable ? "YES" : "NO")
+                                      << " worldPos=" << worldPos.x << "," << worldPos.y << "," << worldPos.z);
+                        }
+                        // pairwise check: are any two models effectively at the same world position?
+                        const float sameEps = 1e-3f; // distance threshold
+                        bool anySame = false;
+                        for (size_t a = 0; a < worldPositions.size(); ++a)
+                        {
+                            for (size_t b = a + 1; b < worldPositions.size(); ++b)
+                            {
+                                float d = glm::length(worldPositions[a] - worldPositions[b]);
+                                if (d <= sameEps)
+                                {
+                                    LOG_DEBUG("[ModelPos] placedModels[" << a << "] and placedModels[" << b << "] are at the SAME world location (d=" << d << ")");
+                                    anySame = true;
+                                }
+                            }
+                        }
+                        if (!anySame)
+                            LOG_DEBUG("[ModelPos] All placed models are at different world locations.");
+                    }
+                }
+            }
+            // the lit scene, before any resolve, is what next frame's reflections see
+            if (screenReflections.ready())
+            {
+                GpuProfiler::Scope scope(profiler, "ssr history");
+                screenReflections.captureHistory(scene_w, scene_h);
+            }
+            // the HDR scene into the window: exposure, curve and display encoding once per pixel. `resolved` is
+            // the linear image that went in (the path tracer's, TAA's or the still accumulation's output, else
+            // the HDR target), which EXR captures store
+            GLuint resolved = 0;
+            {
+                if (pathTracer.tracing())
+                {
+                    GpuProfiler::Scope pathScope(profiler, "path trace");
+                    resolved = pathTracer.render(toneMapper.width(), toneMapper.height(), unjitteredViewProjection, camera.Position,
+                                                 proceduralSky.sunDirection, ibl.envCubemap);
+                }
+                else if (stereo.ready())
+                    resolved = stereo.resolve();
+                else if (still.accumulating())
+                {
+                    GpuProfiler::Scope stillScope(profiler, "still");
+                    resolved = still.accumulate(toneMapper.colorTarget(), toneMapper.width(), toneMapper.height());
+                }
+                else if (temporalAA.ready())
+                {
+                    GpuProfiler::Scope taaScope(profiler, "taa");
+                    resolved = temporalAA.resolve(toneMapper.colorTarget(), toneMapper.motionTarget(), toneMapper.width(), toneMapper.height());
+                }
+                // VRS: next frame's rate image from this frame's
+                if (shadingRate.ready() && !stereo.ready())
+                {
+                    GpuProfiler::Scope vrsScope(profiler, "vrs classify");
+                    shadingRate.classify(resolved ? resolved : toneMapper.colorTarget(), toneMapper.width(), toneMapper.height());
+                }
+                // the post chain as a RenderGraph: it orders the passes, culls what the tone map doesn't read
+                // and keeps the bloom's levels in its pool
+                renderGraph.reset();
+                const GLuint hdrTexture = resolved ? resolved : toneMapper.colorTarget();
+                const RenderGraph::Resource hdr = renderGraph.importTexture("hdr", hdrTexture);
+                const RenderGraph::Resource window = renderGraph.importTexture("window");
+                RenderGraph::Resource exposure = RenderGraph::NONE;
+                if (autoExposure.ready())
+                {
+                    exposure = renderGraph.importTexture("exposure");
+                    const RenderGraph::Pass pass = renderGraph.addPass("auto exposure", [&, hdrTexture, exposure](RenderGraph &g) {
+                        g.setTexture(exposure, autoExposure.update(hdrTexture, toneMapper.width(), toneMapper.height(), deltaTime));
+                    });
+                    renderGraph.read(pass, hdr);
+                    renderGraph.write(pass, exposure);
+                }
+                const RenderGraph::Resource glow = bloom.addPasses(renderGraph, hdr, toneMapper.width(), toneMapper.height(), exposure);
+                // no bloom on poster tiles (each would glow only from its own pixels, with seams between them) or
+                // across the stereo eyes: the tone map doesn't read it, so the graph culls its passes
+                const bool withBloom = glow != RenderGraph::NONE && !poster.rendering() && !stereo.ready();
+                const RenderGraph::Pass toneMap = renderGraph.addPass("tone map", [&, exposure, glow, withBloom](RenderGraph &g) {
+                    toneMapper.setAutoExposure(g.texture(exposure));
+                    if (withBloom)
+                        toneMapper.setBloom(g.texture(glow), bloom.strength());
+                    toneMapper.resolve(display_w, display_h, resolved);
+                });
+                renderGraph.read(toneMap, hdr);
+                renderGraph.read(toneMap, exposure);
+                if (withBloom)
+                    renderGraph.read(toneMap, glow);
+                renderGraph.write(toneMap, window);
+                renderGraph.execute(&profiler);
+                if (!resolved)
+                    resolved = toneMapper.colorTarget();
+            }
+            // DEBUG_VIEW / G: the view's overdraw, shading quads, texel density, programs or triangle sizes over
+            // the tone-mapped scene
+            if (debugViewCycleRequested)
+            {
+                if (debugViews.ready())
+                    debugViews.cycle();
+                debugViewCycleRequested = false;
+            }
+            if (debugViews.active() && !placedModels.empty() && !stereo.ready())
+            {
+                GpuProfiler::Scope scope(profiler, "debug view");
+                mainFrame.bind();
+                debugViews.render(display_w, display_h, placedModels.size(), [&](size_t i, Shader &shader) {
+                    if (i < placedVisible.size() && placedVisible[i])
+                        placedModels[i].model->Draw(shader, placedMatrix(placedModels[i]), camera.Position, &cullViewProjection);
+                });
+            }
+            // CULL_DEBUG: the bounds the culling kept and dropped, through the live view
+            if (cullDebug.ready() && !stereo.ready())
+            {
+                GpuProfiler::Scope scope(profiler, "cull debug");
+                cullDebug.begin(cullViewProjection);
+                cullDebug.addSceneNodes(sceneTree);
+                for (size_t i = 0; i < placedModels.size(); ++i)
+                    cullDebug.addModel(*placedModels[i].model, placedMatrix(placedModels[i]), placedModels[i].worldMin, placedModels[i].worldMax,
+                                       i < placedVisible.size() && placedVisible[i]);
+                cullDebug.draw(viewProjection, display_w, display_h);
+            }
+            // THUMBNAIL_VIEWS: the focused model from the atlas views, tone mapped over the bottom of the window
+            if (thumbnailViews.ready() && focusedModel < placedModels.size())
+            {
+                GpuProfiler::Scope scope(profiler, "thumbnail views");
+                thumbnailViews.frame(placedModels[focusedModel].worldMin, placedModels[focusedModel].worldMax);
+                thumbnailViews.cull(sceneTree);
+                thumbnailViews.render(drawThumbnailView);
+                int x = 0, y = 0, w = 0, h = 0;
+                thumbnailViews.placement(display_w, display_h, x, y, w, h);
+                toneMapper.present(thumbnailViews.texture(), x, y, w, h);
+                glViewport(0, 0, display_w, display_h);
+            }
+            // STREAM_SESSIONS: the sessions due this frame, each from its own camera, into its own stream
+            if (sessionViews.enabled())
+            {
+                GpuProfiler::Scope scope(profiler, "session views");
+                sessionViews.update(camera, deltaTime);
+                sessionViews.render(sceneTree, farPlane, !sceneStill, display_w, display_h, toneMapper, drawSessionView);
+                glViewport(0, 0, display_w, display_h);
+            }
+            // KIOSK_DISPLAYS: every display's view, copied to its window in its own context
+            if (kiosk.ready())
+            {
+                GpuProfiler::Scope scope(profiler, "kiosk displays");
+                kiosk.render(camera, sceneTree, farPlane, display_w, display_h, toneMapper, drawKioskView);
+                kiosk.present();
+                glViewport(0, 0, display_w, display_h);
+            }
+            // this frame's transforms are the next frame's motion vector origins
+            const bool viewChanged = !hasPreviousView || unjitteredViewProjection != previousViewProjection;
+            previousViewProjection = unjitteredViewProjection;
+            hasPreviousView = true;
+            for (size_t i = 0; i < placedModels.size(); ++i)
+            {
+                placedModels[i].previousMatrix = placedMatrix(placedModels[i]);
+                placedModels[i].drawnBefore = true;
+            }
+
+            // the window as it is now (the tone-mapped scene, no HUD); read back and encoded in the background
+            if (batch.capturing())
+                batch.captured(
+                    frameCapture->capture(display_w, display_h, batch.outputPath(), resolved, toneMapper.width(), toneMapper.height()));
+            if (poster.capturing())
+                poster.readTile();
+            if (frameCapture && !capturePrefix.empty() && (captureFrames == 0 || capturedFrames < captureFrames))
+            {
+                char path[32];
+                std::snprintf(path, sizeof(path), "_%05d.png", capturedFrames++);
+                frameCapture->capture(display_w, display_h, capturePrefix + path, resolved, toneMapper.width(), toneMapper.height());
+                if (capturedFrames == captureFrames)
+                    LOG_INFO("[Capture] " << captureFrames << " frames queued, recording done");
+            }
+            // STREAM_PORT: the same, scaled, for the viewers (skipped while they're still on the last one)
+            streamer.capture(display_w, display_h);
+            // FRAME_SHARE: and to OBS and the like, without a screen capture
+            frameShare.publish(display_w, display_h);
+            if (frameCapture && debugCapture)
+            {
+                const std::string outPath = frameCapture->capture(display_w, display_h, "frame_debug.png", resolved, toneMapper.width(), toneMapper.height());
+                frameCapture->finish();
+                if (frameCapture->failed() == 0)
+                    LOG_INFO("Saved framebuffer to: " << outPath);
+                // optionally exit after capture so you can inspect the file
+                LOG_INFO("DEBUG_CAPTURE done; exiting.");
+                // leave the loop; main's teardown releases everything, as on a normal exit
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+                return;
+            }
+
+            // HUD on top of everything, after the capture so frame_debug.png shows the scene only
+            if (hudToggleRequested)
+            {
+                hud.toggle();
+                hudToggleRequested = false;
+            }
+            {
+                const ModelLoader::Progress loading = modelLoader.progress();
+                PerfHud::Status status;
+                status.models = loading.total;
+                status.importing = loading.importing;
+                status.streaming = loading.streaming;
+                status.environmentBusy = environment.busy();
+                if (cullDebug.ready())
+                    status.extra = cullDebug.hudLines();
+                hud.draw(display_w, display_h, status);
+            }
+
+            // -------------------------------------------------------------------------------
+            profiler.end();
+            benchmark.endFrame();
+            batch.endFrame();
+            // BATCH_FARM: the chunk's images go out once they're on disk
+            if (batch.chunkRendered() && frameCapture)
+            {
+                frameCapture->finish();
+                batch.submitChunk();
+            }
+            poster.endFrame();
+            frameRing().endFrame();
+            glCapture().endFrame(display_w, display_h);
+            profiler.begin("swap", false);
+            glfwSwapBuffers(window);
+            kiosk.swap();
+            profiler.end();
+            pacer.afterSwap(profiler);
+            // whether the next frame could look any different from this one
+            const bool stillRefining = (still.ready() && !still.converged()) || (pathTracer.ready() && !pathTracer.converged());
+            idleRenderer.endFrame(redrawRequested || viewChanged || !sceneStill || textureStreamer().busy() || showroomLights > 0 ||
+                                  stillRefining || streamer.busy() ||
+                                  sessionViews.busy());
+            redrawRequested = false;
+        }
+    };
+    if (renderThread)
+    {
+        // the context moves to the render thread for the loop and comes back for the teardown below
+        LOG_INFO("[RenderThread] Rendering on its own thread; input and window events stay on this one");
+        glfwMakeContextCurrent(NULL);
+        std::thread renderer([&]() {
+            glfwMakeContextCurrent(window);
+            renderLoop();
+            glfwMakeContextCurrent(NULL);
+            // the loop can also end on its own (an error): take the main thread down with it
+            glfwSetWindowShouldClose(window, true);
+            glfwPostEmptyEvent();
+        });
+        while (!glfwWindowShouldClose(window))
+        {
+            // events wake this at once; otherwise held keys (and an ORBIT_CAMERA glide) step at ~500 Hz,
+            // slower while the renderer idles
+            glfwWaitEventsTimeout(snapshots.consumerWaiting() && input.orbit.settled() ? 0.1 : 0.002);
+            publishInput(window);
+        }
+        snapshots.stop();
+        renderer.join();
+        glfwMakeContextCurrent(window);
+    }
+    else
+        renderLoop();
+    saveProfiles();
+    // the frames of a recording still being read back or encoded
+    if (frameCapture)
+    {
+        frameCapture->finish();
+        if (!capturePrefix.empty())
+            LOG_INFO("[Capture] " << frameCapture->written() << " frames saved, " << frameCapture->failed() << " failed");
+        if (batch.enabled())
+            LOG_INFO("[Batch] " << frameCapture->written() << " images written, " << frameCapture->failed() << " failed");
+        frameCapture->releaseGpu();
     }
+    sessionViews.releaseGpu();
+    streamer.releaseGpu();
+    streamer.stop();
+    frameShare.releaseGpu();
+    kiosk.releaseGpu();
+    batch.releaseGpu();
+    poster.releaseGpu();
+    pacer.releaseGpu();
+    uploadThread().stop();
 
     // glfw: terminate, clearing all previously allocated GLFW resources.
     // ------------------------------------------------------------------
+    for (size_t i = 0; i < sceneModels.size(); ++i)
+        sceneModels[i].releaseGpu();
+    modelCache.releaseGpu();
+    environment.releaseGpu();
+    probes.releaseGpu();
+    irradianceVolume.releaseGpu();
+    occlusion.releaseGpu();
+    meshletCuller.releaseGpu();
+    sceneCuller.releaseGpu();
+    weightedOIT.releaseGpu();
+    visibilityBuffer.releaseGpu();
+    gpuPicker.releaseGpu();
+    ambientOcclusion.releaseGpu();
+    screenReflections.releaseGpu();
+    tracedReflections.releaseGpu();
+    shadingRate.releaseGpu();
+    refractionCopy.releaseGpu();
+    skybox.releaseGpu();
+    impostors.releaseGpu();
+    livery.releaseGpu();
+    decals.releaseGpu();
+    atmosphere().releaseGpu();
+    bloom.releaseGpu();
+    autoExposure.releaseGpu();
+    renderGraph.releaseGpu();
+    debugViews.releaseGpu();
+    cullDebug.releaseGpu();
+    toneMapper.releaseGpu();
+    temporalAA.releaseGpu();
+    still.releaseGpu();
+    pathTracer.releaseGpu();
+    thumbnailViews.releaseGpu();
+    stereo.releaseGpu();
+    clusteredLights.releaseGpu();
+    shadows.releaseGpu();
+    profiler.releaseGpu();
+    benchmark.releaseGpu();
+    hud.releaseGpu();
+    textureStreamer().releaseGpu();
+    frameRing().releaseGpu();
+    geometryArena().releaseGpu();
+    materialOverrides().releaseGpu();
+    brdfLUTTexture.reset();
+    ltcLUTTexture.reset();
+    debugQuadVAO.reset();
+    debugQuadVBO.reset();
+    gpuMemory().reportLeaks();
     glfwTerminate();
     return 0;
 }
 
-// process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
+// pointer motion (`yoffset` up) and wheel steps, from the window (queued for the input step) or a stream viewer
 // ---------------------------------------------------------------------------------------------------------
-void processInput(GLFWwindow *window)
+static void applyMouseMove(float xoffset, float yoffset)
 {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
+    // ORBIT_CAMERA: dragging right turns the model right (the camera goes left around it)
+    if (input.orbit.active())
+        input.orbit.orbit(-xoffset * 0.25f, -yoffset * 0.25f);
+    else
+        input.camera.ProcessMouseMovement(xoffset, yoffset);
+    input.events.redraw = true;
+    inputLog.recordMove(xoffset, yoffset);
+}
 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        camera.ProcessKeyboard(FORWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        camera.ProcessKeyboard(BACKWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        camera.ProcessKeyboard(LEFT, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        camera.ProcessKeyboard(RIGHT, deltaTime);
+static void applyScroll(float steps)
+{
+    // ORBIT_CAMERA: the wheel moves in and out; otherwise it zooms the lens
+    if (input.orbit.active())
+        input.orbit.zoom(steps);
+    else
+        input.camera.ProcessMouseScroll(steps);
+    input.events.redraw = true;
+    inputLog.recordScroll(steps);
+}
+
+// a click that picks a part, from the window or a stream viewer
+static void applyPick()
+{
+    input.events.pick = true;
+    inputLog.recordPick();
+}
+
+// process all input: react to the actions held and pressed in this input step (InputActions)
+// ---------------------------------------------------------------------------------------------------------
+void processInput(const InputActions::Step &step)
+{
+    if (input.orbit.active())
+    {
+        // ORBIT_CAMERA: A/D turn, W/S zoom (and the arrows and PageUp/PageDown in camera mode, below)
+        const float turn = 90.0f * input.deltaTime; // degrees per second
+        const float zoom = 4.0f * input.deltaTime;  // wheel steps per second
+        if (step.held[InputActions::FLY_LEFT])
+            input.orbit.orbit(-turn, 0.0f);
+        if (step.held[InputActions::FLY_RIGHT])
+            input.orbit.orbit(turn, 0.0f);
+        if (step.held[InputActions::FLY_FORWARD])
+            input.orbit.zoom(zoom);
+        if (step.held[InputActions::FLY_BACK])
+            input.orbit.zoom(-zoom);
+        if (!controlModeModel)
+        {
+            if (step.held[InputActions::NUDGE_LEFT])
+                input.orbit.orbit(-turn, 0.0f);
+            if (step.held[InputActions::NUDGE_RIGHT])
+                input.orbit.orbit(turn, 0.0f);
+            if (step.held[InputActions::NUDGE_FORWARD])
+                input.orbit.zoom(zoom);
+            if (step.held[InputActions::NUDGE_BACK])
+                input.orbit.zoom(-zoom);
+            if (step.held[InputActions::NUDGE_UP])
+                input.orbit.orbit(0.0f, turn);
+            if (step.held[InputActions::NUDGE_DOWN])
+                input.orbit.orbit(0.0f, -turn);
+        }
+    }
+    else
+    {
+        if (step.held[InputActions::FLY_FORWARD])
+            input.camera.ProcessKeyboard(FORWARD, input.deltaTime);
+        if (step.held[InputActions::FLY_BACK])
+            input.camera.ProcessKeyboard(BACKWARD, input.deltaTime);
+        if (step.held[InputActions::FLY_LEFT])
+            input.camera.ProcessKeyboard(LEFT, input.deltaTime);
+        if (step.held[InputActions::FLY_RIGHT])
+            input.camera.ProcessKeyboard(RIGHT, input.deltaTime);
+    }
 
     // Controls: arrows/PageUp/PageDown act on either camera or model depending on `controlModeModel`.
-    // false = arrow keys move camera, true = arrow keys move CarModel.
-    static bool h_was = false;
-    static bool r_was = false;
-    static bool m_was = false;
-    float moveSpeed = 3.0f * deltaTime; // units per second scaled by frame
-    if (!controlModeModel)
+    // false = arrow keys move camera, true = arrow keys move the scene's movable models.
+    float moveSpeed = 3.0f * input.deltaTime; // units per second scaled by frame
+    if (!controlModeModel && !input.orbit.active())
     {
         // arrow keys move camera in camera-mode
-        if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-            camera.ProcessKeyboard(FORWARD, deltaTime);
-        if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-            camera.ProcessKeyboard(BACKWARD, deltaTime);
-        if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-            camera.ProcessKeyboard(LEFT, deltaTime);
-        if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-            camera.ProcessKeyboard(RIGHT, deltaTime);
+        if (step.held[InputActions::NUDGE_FORWARD])
+            input.camera.ProcessKeyboard(FORWARD, input.deltaTime);
+        if (step.held[InputActions::NUDGE_BACK])
+            input.camera.ProcessKeyboard(BACKWARD, input.deltaTime);
+        if (step.held[InputActions::NUDGE_LEFT])
+            input.camera.ProcessKeyboard(LEFT, input.deltaTime);
+        if (step.held[InputActions::NUDGE_RIGHT])
+            input.camera.ProcessKeyboard(RIGHT, input.deltaTime);
         // PageUp/PageDown adjust camera height (Y axis)
-        if (glfwGetKey(window, GLFW_KEY_PAGE_UP) == GLFW_PRESS)
-            camera.Position.y += moveSpeed;
-        if (glfwGetKey(window, GLFW_KEY_PAGE_DOWN) == GLFW_PRESS)
-            camera.Position.y -= moveSpeed;
+        if (step.held[InputActions::NUDGE_UP])
+            input.camera.Position.y += moveSpeed;
+        if (step.held[InputActions::NUDGE_DOWN])
+            input.camera.Position.y -= moveSpeed;
     }
-    else
+    else if (controlModeModel)
     {
-        // arrow keys move the CarModel in model-mode
-        if (!carLocked)
+        // VEHICLE_SIM: the arrows drive the car instead (up throttle, down brake and reverse, left/right steer)
+        if (!carLocked && vehicleSim.running())
+        {
+            input.drive.throttle = step.held[InputActions::NUDGE_FORWARD] ? 1.0f : 0.0f;
+            input.drive.brake = step.held[InputActions::NUDGE_BACK] ? 1.0f : 0.0f;
+            input.drive.steer = (step.held[InputActions::NUDGE_RIGHT] ? 1.0f : 0.0f) - (step.held[InputActions::NUDGE_LEFT] ? 1.0f : 0.0f);
+        }
+        // arrow keys move the movable models in model-mode
+        else if (!carLocked)
         {
-            if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-                carOffset.z -= moveSpeed;
-            if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-                carOffset.z += moveSpeed;
-            if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-                carOffset.x -= moveSpeed;
-            if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-                carOffset.x += moveSpeed;
-            if (glfwGetKey(window, GLFW_KEY_PAGE_UP) == GLFW_PRESS)
-                carOffset.y += moveSpeed;
-            if (glfwGetKey(window, GLFW_KEY_PAGE_DOWN) == GLFW_PRESS)
-                carOffset.y -= moveSpeed;
+            if (step.held[InputActions::NUDGE_FORWARD])
+                input.carOffset.z -= moveSpeed;
+            if (step.held[InputActions::NUDGE_BACK])
+                input.carOffset.z += moveSpeed;
+            if (step.held[InputActions::NUDGE_LEFT])
+                input.carOffset.x -= moveSpeed;
+            if (step.held[InputActions::NUDGE_RIGHT])
+                input.carOffset.x += moveSpeed;
+            if (step.held[InputActions::NUDGE_UP])
+                input.carOffset.y += moveSpeed;
+            if (step.held[InputActions::NUDGE_DOWN])
+                input.carOffset.y -= moveSpeed;
         }
     }
 
-    bool h_now = (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS);
-    if (h_now && !h_was)
+    if (step.pressed[InputActions::CONTROL_HELP])
     {
         showModelControlHelp = !showModelControlHelp;
-        std::cout << "Toggled model control help: " << (showModelControlHelp ? "ON" : "OFF") << std::endl;
+        LOG_INFO("Toggled model control help: " << (showModelControlHelp ? "ON" : "OFF"));
     }
-    h_was = h_now;
 
-    bool r_now = (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS);
-    if (r_now && !r_was)
+    if (step.pressed[InputActions::RESET_CAR])
     {
-        carOffset = glm::vec3(3.0f, 0.0f, 0.0f);
-        std::cout << "CarModel offset reset to " << carOffset.x << "," << carOffset.y << "," << carOffset.z << std::endl;
+        input.carOffset = glm::vec3(3.0f, 0.0f, 0.0f);
+        vehicleSim.resetPlayer();
+        LOG_INFO("CarModel offset reset to " << input.carOffset.x << "," << input.carOffset.y << "," << input.carOffset.z);
     }
-    r_was = r_now;
 
     // Toggle control mode: M switches between camera (default) and model control
-    bool m_now = (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS);
-    if (m_now && !m_was)
+    if (step.pressed[InputActions::CONTROL_MODE])
     {
         controlModeModel = !controlModeModel;
-        std::cout << "Control mode: " << (controlModeModel ? "MODEL (arrows move model)" : "CAMERA (arrows move camera)") << std::endl;
+        LOG_INFO("Control mode: " << (controlModeModel ? "MODEL (arrows move model)" : "CAMERA (arrows move camera)"));
     }
-    m_was = m_now;
+
+    // profiler summary (P), with PROFILE=1
+    if (step.pressed[InputActions::PROFILE_REPORT] && GpuProfiler::enabledByEnv())
+        input.events.profileReport = true;
 
     // Toggle lock for car model movement (L)
-    static bool l_was = false;
-    bool l_now = (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS);
-    if (l_now && !l_was)
+    if (step.pressed[InputActions::CAR_LOCK])
     {
         carLocked = !carLocked;
-        std::cout << "CarModel movement " << (carLocked ? "LOCKED" : "UNLOCKED") << std::endl;
+        LOG_INFO("CarModel movement " << (carLocked ? "LOCKED" : "UNLOCKED"));
+    }
+
+    // performance HUD (O)
+    if (step.pressed[InputActions::PERF_HUD])
+        input.events.hudToggle = true;
+
+    // next camera preset of the scene (C)
+    static size_t nextPreset = 1;
+    if (step.pressed[InputActions::CAMERA_PRESET] && !cameraPresets.empty())
+    {
+        const SceneDescription::CameraPreset &preset = cameraPresets[nextPreset % cameraPresets.size()];
+        SceneDescription::applyCamera(preset, input.camera);
+        nextPreset = nextPreset % cameraPresets.size() + 1;
+        LOG_INFO("Camera preset '" << preset.name << "'");
+    }
+
+    // tone-mapping curve (T): Reinhard, ACES, AgX
+    if (step.pressed[InputActions::TONE_CURVE])
+        input.events.toneCurveCycle = true;
+
+    // next variant of the configurator model (V)
+    if (step.pressed[InputActions::MODEL_VARIANT])
+        input.events.variantCycle = true;
+
+    // next material variant of the focused model (N)
+    if (step.pressed[InputActions::MATERIAL_VARIANT])
+        input.events.materialVariantCycle = true;
+
+    // next paint (B)
+    if (step.pressed[InputActions::PAINT])
+        input.events.paintCycle = true;
+
+    // next configurable part hidden (K)
+    if (step.pressed[InputActions::PART_OPTION])
+        input.events.partCycle = true;
+
+    // next debug view (G)
+    if (step.pressed[InputActions::DEBUG_VIEW])
+        input.events.debugViewCycle = true;
+
+    // freeze the culling camera (F), with CULL_DEBUG
+    if (step.pressed[InputActions::CULL_FREEZE] && CullDebug::enabledByEnv())
+        input.events.cullFreeze = true;
+
+    // procedural sky sun: azimuth ([ ]), elevation (; ') and intensity (- =)
+    if (proceduralSkyActive)
+    {
+        const float turn = 0.5f * input.deltaTime; // radians per second
+        glm::vec3 &sun = input.sky.sunDirection;
+        float azimuth = std::atan2(sun.z, sun.x);
+        float elevation = std::asin(glm::clamp(sun.y, -1.0f, 1.0f));
+        float intensity = input.sky.sunIntensity;
+        if (step.held[InputActions::SUN_WEST])
+            azimuth -= turn;
+        if (step.held[InputActions::SUN_EAST])
+            azimuth += turn;
+        if (step.held[InputActions::SUN_UP])
+            elevation = std::min(elevation + turn, 1.5f);
+        if (step.held[InputActions::SUN_DOWN])
+            elevation = std::max(elevation - turn, -0.3f);
+        if (step.held[InputActions::SUN_BRIGHTER])
+            intensity *= std::exp(input.deltaTime);
+        if (step.held[InputActions::SUN_DIMMER])
+            intensity *= std::exp(-input.deltaTime);
+        glm::vec3 moved(std::cos(elevation) * std::cos(azimuth), std::sin(elevation), std::cos(elevation) * std::sin(azimuth));
+        if (glm::dot(moved, sun) < 0.999999f || intensity != input.sky.sunIntensity)
+        {
+            sun = moved;
+            input.sky.sunIntensity = intensity;
+            input.events.skyChanged = true;
+        }
     }
-    l_was = l_now;
+}
+
+// main thread, once per input step: applies a camera the renderer placed, moves input's camera and car by
+// the time since the last step, and publishes them (and the events since) as the renderer's next snapshot
+// ---------------------------------------------------------------------------------------------------------
+void publishInput(GLFWwindow *window)
+{
+    const double now = EngineClock::seconds();
+    const float wallDelta = input.lastTime < 0.0 ? 0.0f : static_cast<float>(now - input.lastTime);
+    input.lastTime = now;
+    snapshots.takeCameraOverride(input.camera);
+    // INPUT_REPLAY: the fixed step and the recorded pointer, wheel and clicks due by its end
+    input.deltaTime = inputLog.step(wallDelta, input.camera, input.carOffset, [](const InputLog::Event &e) {
+        if (e.kind == InputLog::MOVE)
+            applyMouseMove(e.x, e.y);
+        else if (e.kind == InputLog::SCROLL)
+            applyScroll(e.x);
+        else
+            applyPick();
+        input.events.redraw = true;
+    });
+    glm::vec3 focusMin, focusMax;
+    if (snapshots.takeOrbitFocus(focusMin, focusMax))
+        input.orbit.focus(focusMin, focusMax, input.camera.Zoom);
+    // STREAM_PORT: the browsers' pointer, wheel and clicks since the last step; their held keys (in `remote`)
+    // keep the frames coming like the window's key repeats do
+    if (!inputLog.replaying() && (streamer.takeInput(input.remote) || !input.remote.keys.empty()))
+    {
+        if (input.remote.mouseX != 0.0f || input.remote.mouseY != 0.0f)
+            applyMouseMove(input.remote.mouseX, input.remote.mouseY);
+        if (input.remote.wheel != 0.0f)
+            applyScroll(input.remote.wheel);
+        if (input.remote.pick)
+            applyPick();
+        input.events.redraw = true;
+    }
+    // the window's input since the last step; a key is held in the window or, with STREAM_PORT, in a browser
+    // watching the stream, or INPUT_REPLAY's instead
+    const InputActions::Step &step =
+        input.actions.step([](int key, bool down) { return inputLog.keyDown(key, down || input.remote.held(key)); });
+    if (step.mouseX != 0.0f || step.mouseY != 0.0f)
+        applyMouseMove(step.mouseX, step.mouseY);
+    if (step.wheel != 0.0f)
+        applyScroll(step.wheel);
+    if (step.pick)
+        applyPick();
+    input.drive = VehicleSim::Controls();
+    processInput(step);
+    input.orbit.update(input.deltaTime, input.camera);
+    // VEHICLE_SIM: the fixed steps up to now; the renderer gets the cars between the last two
+    vehicleSim.update(input.deltaTime, input.drive);
+    SceneSnapshot &snapshot = snapshots.back();
+    snapshot.camera = input.camera;
+    snapshot.cameraSettled = input.orbit.settled();
+    snapshot.carOffset = input.carOffset;
+    vehicleSim.poses(snapshot.vehicles);
+    snapshot.sky = input.sky;
+    snapshot.showModelControlHelp = showModelControlHelp;
+    glfwGetFramebufferSize(window, &snapshot.framebufferWidth, &snapshot.framebufferHeight);
+    snapshots.publish(input.events);
 }
 
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
@@ -1178,14 +2768,19 @@ void processInput(GLFWwindow *window)
 void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
     // make sure the viewport matches the new window dimensions; note that width and
-    // height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
+    // height will be significantly larger than specified on retina displays. With RENDER_THREAD the context
+    // is current on the render thread, which sets the viewport every frame anyway.
+    if (glfwGetCurrentContext() == window)
+        glViewport(0, 0, width, height);
+    input.events.redraw = true;
 }
 
 // glfw: whenever the mouse moves, this callback is called
 // -------------------------------------------------------
 void mouse_callback(GLFWwindow *window, double xposIn, double yposIn)
 {
+    if (inputLog.replaying())
+        return;
     float xpos = static_cast<float>(xposIn);
     float ypos = static_cast<float>(yposIn);
 
@@ -1202,12 +2797,59 @@ void mouse_callback(GLFWwindow *window, double xposIn, double yposIn)
     lastX = xpos;
     lastY = ypos;
 
-    camera.ProcessMouseMovement(xoffset, yoffset);
+    input.actions.pointer(xoffset, yoffset);
+    input.events.redraw = true;
 }
 
 // glfw: whenever the mouse scroll wheel scrolls, this callback is called
 // ----------------------------------------------------------------------
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset)
 {
-    camera.ProcessMouseScroll(static_cast<float>(yoffset));
+    if (!inputLog.replaying())
+        input.actions.wheel(static_cast<float>(yoffset));
+    input.events.redraw = true;
+}
+
+// glfw: whenever a mouse button is pressed or released, this callback is called
+// ----------------------------------------------------------------------
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+{
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && !inputLog.replaying())
+        input.actions.click();
+    input.events.redraw = true;
+}
+
+// glfw: whenever a key is pressed, repeated or released, this callback is called
+// ----------------------------------------------------------------------
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        glfwSetWindowShouldClose(window, true);
+    if (!inputLog.replaying())
+        input.actions.key(key, action);
+    input.events.redraw = true;
+}
+
+// glfw: whenever the window's contents need drawing again (uncovered, restored), this callback is called
+// ----------------------------------------------------------------------
+void window_refresh_callback(GLFWwindow *window)
+{
+    input.events.redraw = true;
+}
+
+// glfw: whenever files are dropped on the window, this callback is called
+// ----------------------------------------------------------------------
+void drop_callback(GLFWwindow *window, int count, const char **paths)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        std::string path(paths[i]);
+        std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".exr")
+            input.events.droppedEnvironments.push_back(path);
+        else
+            LOG_INFO("[Environment] Ignoring dropped file '" << path << "' (not an .exr)");
+    }
+    input.events.redraw = true;
 }
@@ -0,0 +1,202 @@
+#version 330 core
+// The atmosphere's LUTs (Atmosphere, include/atmosphere.h), one per pass into a target of its own:
+//   0: transmittance to the top of the atmosphere by height and zenith angle (once)
+//   1: multiple scattering by height and sun zenith angle, from the transmittance LUT (once)
+//   2: sky radiance seen from the viewer by azimuth from the sun and elevation, from both (when the sun
+//      moves); procedural_sky.fs reads it
+// The model is AtmosphereModel's (include/atmosphere_model.h): keep the two in sync.
+out vec4 FragColor;
+
+uniform int pass;
+uniform vec2 targetTexel; // 1 / size of the LUT written
+uniform sampler2D transmittanceLut;
+uniform sampler2D multiScatteringLut;
+uniform vec3 sunDirection; // pass 2
+
+const float PI = 3.14159265;
+const float GROUND_RADIUS = 6360.0; // km
+const float TOP_RADIUS = 6460.0;
+const float VIEW_HEIGHT = 0.2;
+const vec3 RAYLEIGH_SCATTERING = vec3(5.802e-3, 13.558e-3, 33.1e-3);
+const float RAYLEIGH_HEIGHT = 8.0;
+const float MIE_SCATTERING = 3.996e-3;
+const float MIE_ABSORPTION = 4.4e-3;
+const float MIE_HEIGHT = 1.2;
+const float MIE_G = 0.8;
+const vec3 OZONE_ABSORPTION = vec3(0.650e-3, 1.881e-3, 0.085e-3);
+const vec3 GROUND_ALBEDO = vec3(0.3);
+
+void mediumAt(float height, out vec3 rayleigh, out float mie, out vec3 extinction)
+{
+    rayleigh = RAYLEIGH_SCATTERING * exp(-height / RAYLEIGH_HEIGHT);
+    float mieDensity = exp(-height / MIE_HEIGHT);
+    mie = MIE_SCATTERING * mieDensity;
+    float ozone = max(0.0, 1.0 - abs(height - 25.0) / 15.0);
+    extinction = rayleigh + (MIE_SCATTERING + MIE_ABSORPTION) * mieDensity + OZONE_ABSORPTION * ozone;
+}
+
+// distance along unit `dir` from `pos` (relative to the planet's centre) to the nearest intersection ahead
+// with the sphere of `radius`; -1 if there is none
+float raySphere(vec3 pos, vec3 dir, float radius)
+{
+    float b = dot(pos, dir);
+    float c = dot(pos, pos) - radius * radius;
+    float d = b * b - c;
+    if (d < 0.0)
+        return -1.0;
+    d = sqrt(d);
+    if (-b - d > 0.0)
+        return -b - d;
+    return -b + d > 0.0 ? -b + d : -1.0;
+}
+
+// steps grow quadratically, so rays along the ground sample the dense low air finely
+void marchStep(int step, int steps, float distance, out float t, out float dt)
+{
+    float t0 = float(step) / float(steps), t1 = float(step + 1) / float(steps);
+    t = distance * 0.5 * (t0 * t0 + t1 * t1);
+    dt = distance * (t1 * t1 - t0 * t0);
+}
+
+float rayleighPhase(float cosTheta)
+{
+    return 3.0 / (16.0 * PI) * (1.0 + cosTheta * cosTheta);
+}
+
+float miePhase(float cosTheta)
+{
+    float g2 = MIE_G * MIE_G;
+    float denominator = pow(max(1.0 + g2 - 2.0 * MIE_G * cosTheta, 1e-4), 1.5);
+    return 3.0 / (8.0 * PI) * (1.0 - g2) * (1.0 + cosTheta * cosTheta) / ((2.0 + g2) * denominator);
+}
+
+vec2 lutUv(float height, float cosZenith)
+{
+    return vec2(cosZenith * 0.5 + 0.5, height / (TOP_RADIUS - GROUND_RADIUS));
+}
+
+vec3 sunTransmittance(vec3 pos, vec3 sun)
+{
+    float r = length(pos);
+    return texture(transmittanceLut, lutUv(r - GROUND_RADIUS, dot(pos / r, sun))).rgb;
+}
+
+vec3 groundBounce(vec3 pos, vec3 sun)
+{
+    return sunTransmittance(pos, sun) * max(dot(normalize(pos), sun), 0.0) * GROUND_ALBEDO / PI;
+}
+
+vec3 transmittance(float height, float cosZenith)
+{
+    vec3 pos = vec3(0.0, GROUND_RADIUS + height, 0.0);
+    vec3 dir = vec3(sqrt(max(0.0, 1.0 - cosZenith * cosZenith)), cosZenith, 0.0);
+    if (raySphere(pos, dir, GROUND_RADIUS) > 0.0)
+        return vec3(0.0);
+    float distance = max(raySphere(pos, dir, TOP_RADIUS), 0.0);
+    const int STEPS = 40;
+    vec3 depth = vec3(0.0);
+    for (int s = 0; s < STEPS; ++s)
+    {
+        float t, dt;
+        marchStep(s, STEPS, distance, t, dt);
+        vec3 rayleigh, extinction;
+        float mie;
+        mediumAt(length(pos + dir * t) - GROUND_RADIUS, rayleigh, mie, extinction);
+        depth += extinction * dt;
+    }
+    return exp(-depth);
+}
+
+vec3 multiScattering(float height, float cosSunZenith)
+{
+    vec3 pos = vec3(0.0, GROUND_RADIUS + height, 0.0);
+    vec3 sun = vec3(sqrt(max(0.0, 1.0 - cosSunZenith * cosSunZenith)), cosSunZenith, 0.0);
+    const int RINGS = 8;
+    const int STEPS = 20;
+    vec3 luminance = vec3(0.0), transfer = vec3(0.0);
+    for (int i = 0; i < RINGS; ++i)
+        for (int j = 0; j < RINGS; ++j)
+        {
+            float cosTheta = 1.0 - 2.0 * (float(i) + 0.5) / float(RINGS);
+            float sinTheta = sqrt(max(0.0, 1.0 - cosTheta * cosTheta));
+            float phi = 2.0 * PI * (float(j) + 0.5) / float(RINGS);
+            vec3 dir = vec3(sinTheta * cos(phi), cosTheta, sinTheta * sin(phi));
+            float ground = raySphere(pos, dir, GROUND_RADIUS);
+            float distance = ground > 0.0 ? ground : max(raySphere(pos, dir, TOP_RADIUS), 0.0);
+            vec3 throughput = vec3(1.0);
+            for (int s = 0; s < STEPS; ++s)
+            {
+                float t, dt;
+                marchStep(s, STEPS, distance, t, dt);
+                vec3 p = pos + dir * t;
+                vec3 rayleigh, extinction;
+                float mie;
+                mediumAt(length(p) - GROUND_RADIUS, rayleigh, mie, extinction);
+                vec3 step = exp(-extinction * dt);
+                vec3 scattering = rayleigh + mie;
+                vec3 inScattered = scattering * sunTransmittance(p, sun) / (4.0 * PI);
+                luminance += throughput * (inScattered - inScattered * step) / extinction;
+                transfer += throughput * (scattering - scattering * step) / extinction;
+                throughput *= step;
+            }
+            if (ground > 0.0)
+                luminance += throughput * groundBounce(pos + dir * ground, sun);
+        }
+    luminance /= float(RINGS * RINGS);
+    transfer /= float(RINGS * RINGS);
+    return luminance / (1.0 - transfer);
+}
+
+vec3 skyRadiance(vec3 dir, vec3 sun)
+{
+    vec3 pos = vec3(0.0, GROUND_RADIUS + VIEW_HEIGHT, 0.0);
+    float ground = raySphere(pos, dir, GROUND_RADIUS);
+    float distance = ground > 0.0 ? ground : max(raySphere(pos, dir, TOP_RADIUS), 0.0);
+    float cosTheta = dot(dir, sun);
+    float phaseR = rayleighPhase(cosTheta), phaseM = miePhase(cosTheta);
+    const int STEPS = 32;
+    vec3 luminance = vec3(0.0), throughput = vec3(1.0);
+    for (int s = 0; s < STEPS; ++s)
+    {
+        float t, dt;
+        marchStep(s, STEPS, distance, t, dt);
+        vec3 p = pos + dir * t;
+        float r = length(p);
+        vec3 rayleigh, extinction;
+        float mie;
+        mediumAt(r - GROUND_RADIUS, rayleigh, mie, extinction);
+        vec3 step = exp(-extinction * dt);
+        vec2 uv = lutUv(r - GROUND_RADIUS, dot(p / r, sun));
+        vec3 inScattered = (rayleigh * phaseR + mie * phaseM) * texture(transmittanceLut, uv).rgb +
+                           (rayleigh + mie) * texture(multiScatteringLut, uv).rgb;
+        luminance += throughput * (inScattered - inScattered * step) / extinction;
+        throughput *= step;
+    }
+    if (ground > 0.0)
+        luminance += throughput * groundBounce(pos + dir * ground, sun);
+    return luminance;
+}
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy * targetTexel;
+    vec3 result;
+    if (pass == 0)
+        result = transmittance(uv.y * (TOP_RADIUS - GROUND_RADIUS), uv.x * 2.0 - 1.0);
+    else if (pass == 1)
+        result = multiScattering(uv.y * (TOP_RADIUS - GROUND_RADIUS), uv.x * 2.0 - 1.0);
+    else
+    {
+        // across: azimuth away from the sun, 0 .. pi (the sky is symmetric about the sun's vertical);
+        // up: elevation, squeezed towards the horizon where the sky changes fastest (procedural_sky.fs)
+        float azimuth = uv.x * PI;
+        float v = uv.y * 2.0 - 1.0;
+        float elevation = sign(v) * v * v * 0.5 * PI;
+        vec3 dir = vec3(cos(elevation) * cos(azimuth), sin(elevation), cos(elevation) * sin(azimuth));
+        // the sun in the LUT's frame, at azimuth 0
+        float sunElevation = asin(clamp(sunDirection.y, -1.0, 1.0));
+        vec3 sun = vec3(cos(sunElevation), sin(sunElevation), 0.0);
+        result = skyRadiance(dir, sun);
+    }
+    FragColor = vec4(result, 1.0);
+}
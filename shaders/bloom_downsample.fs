@@ -0,0 +1,59 @@
+#version 330 core
+// one step down the bloom chain (Bloom::build): the 13-tap filter of Jimenez's "Next generation post
+// processing in Call of Duty: Advanced Warfare", five overlapping 2x2 boxes of the level above. The first
+// step (from the HDR scene) also takes out what is below the threshold and weighs each box by its
+// brightness (Karis average), so single very bright pixels don't flicker as the camera moves.
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform vec2 sourceTexel; // 1 / size of the level read
+uniform vec2 targetTexel; // 1 / size of the level written
+uniform bool prefilter;
+uniform float threshold; // exposed radiance where the bloom starts (soft knee below it)
+uniform float knee;
+uniform bool autoExposure;
+uniform sampler2D exposureMap; // AutoExposure's one texel, so the threshold follows what the tone map shows
+
+float karisWeight(vec3 c)
+{
+    return 1.0 / (1.0 + max(c.r, max(c.g, c.b)));
+}
+
+vec3 box(vec3 a, vec3 b, vec3 c, vec3 d)
+{
+    vec3 sum = (a + b + c + d) * 0.25;
+    return prefilter ? sum * karisWeight(sum) : sum;
+}
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy * targetTexel;
+    vec3 a = texture(source, uv + sourceTexel * vec2(-2.0, 2.0)).rgb;
+    vec3 b = texture(source, uv + sourceTexel * vec2(0.0, 2.0)).rgb;
+    vec3 c = texture(source, uv + sourceTexel * vec2(2.0, 2.0)).rgb;
+    vec3 d = texture(source, uv + sourceTexel * vec2(-2.0, 0.0)).rgb;
+    vec3 e = texture(source, uv).rgb;
+    vec3 f = texture(source, uv + sourceTexel * vec2(2.0, 0.0)).rgb;
+    vec3 g = texture(source, uv + sourceTexel * vec2(-2.0, -2.0)).rgb;
+    vec3 h = texture(source, uv + sourceTexel * vec2(0.0, -2.0)).rgb;
+    vec3 i = texture(source, uv + sourceTexel * vec2(2.0, -2.0)).rgb;
+    vec3 j = texture(source, uv + sourceTexel * vec2(-1.0, 1.0)).rgb;
+    vec3 k = texture(source, uv + sourceTexel * vec2(1.0, 1.0)).rgb;
+    vec3 l = texture(source, uv + sourceTexel * vec2(-1.0, -1.0)).rgb;
+    vec3 m = texture(source, uv + sourceTexel * vec2(1.0, -1.0)).rgb;
+    vec3 color = box(j, k, l, m) * 0.5 + (box(a, b, d, e) + box(b, c, e, f) + box(d, e, g, h) + box(e, f, h, i)) * 0.125;
+    if (prefilter)
+    {
+        // the Karis weights darkened everything by 1 / (1 + brightness); undo it on the result
+        color /= max(1.0 - max(color.r, max(color.g, color.b)), 1e-4);
+        float measured = autoExposure ? texelFetch(exposureMap, ivec2(0), 0).r : 0.0;
+        float brightness = max(color.r, max(color.g, color.b)) * (measured > 0.0 ? measured : 1.0);
+        float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+        soft = soft * soft / (4.0 * knee + 1e-4);
+        color *= max(soft, brightness - threshold) / max(brightness, 1e-4);
+    }
+    // a NaN or inf from the scene would spread over the whole chain
+    if (any(isnan(color)) || any(isinf(color)))
+        color = vec3(0.0);
+    FragColor = vec4(min(color, vec3(60000.0)), 1.0);
+}
@@ -0,0 +1,21 @@
+#version 330 core
+// one step up the bloom chain (Bloom::build): a 3x3 tent over the smaller level, added onto the level it
+// was made from (the draw blends additively), so each level ends up holding itself and everything wider
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform vec2 sourceTexel; // 1 / size of the level read
+uniform vec2 targetTexel; // 1 / size of the level written
+uniform float radius;     // tent spread in source texels
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy * targetTexel;
+    vec2 d = sourceTexel * radius;
+    vec3 sum = texture(source, uv).rgb * 4.0;
+    sum += (texture(source, uv + vec2(0.0, d.y)).rgb + texture(source, uv - vec2(0.0, d.y)).rgb +
+            texture(source, uv + vec2(d.x, 0.0)).rgb + texture(source, uv - vec2(d.x, 0.0)).rgb) * 2.0;
+    sum += texture(source, uv + d).rgb + texture(source, uv - d).rgb +
+           texture(source, uv + vec2(d.x, -d.y)).rgb + texture(source, uv + vec2(-d.x, d.y)).rgb;
+    FragColor = vec4(sum / 16.0, 1.0);
+}
@@ -0,0 +1,220 @@
+// ray traversal of GpuSceneBvh's buffers, shared by the passes that trace the scene (ComputeShader's library:
+// rt_reflections.comp, path_trace.comp): the instance tree over the placed meshes' world boxes, then each
+// candidate mesh's own tree with the ray taken into its space
+
+// TriangleBVH::Node, and the instance tree's nodes in the same form (leaf: first instance and count << 2 | 3;
+// interior: right child and axis; left child = node + 1)
+struct Node
+{
+    vec3 boundsMin;
+    uint index;
+    vec3 boundsMax;
+    uint meta;
+};
+
+// TriangleBVH::Block: four triangles as lanes, padding lanes degenerate
+struct Block
+{
+    vec4 v0[3];
+    vec4 e1[3];
+    vec4 e2[3];
+    uvec4 triangle;
+};
+
+// MaterialData (material_table.h)
+struct Material
+{
+    vec4 baseColorFactor;
+    vec4 factors;              // metallic, roughness, alpha cutoff, 1 if alpha blends
+    ivec4 layers;
+    vec4 diffuseUV;
+    vec4 normalUV;
+    vec4 metallicRoughnessUV;
+    vec4 uvOffsets;
+    vec4 uvOffsetsMR;          // zw: clearcoat factor and roughness
+    vec4 specularTransmission; // xyz: specular colour * factor, w: transmission
+};
+
+// GpuSceneBvh::Instance
+const uint INSTANCE_SHADING_NORMALS = 1u;
+struct Instance
+{
+    mat4 meshFromWorld;
+    Material material;
+    uint root;
+    uint flags;
+    uint reserved0;
+    uint reserved1;
+};
+
+// GpuSceneBvh::BINDING_*; the normals are TriangleBVH::NORMAL_WORDS per block: vertex-major, lane-minor
+layout (std430, binding = 0) readonly buffer MeshNodes { Node meshNodes[]; };
+layout (std430, binding = 1) readonly buffer MeshBlocks { Block blocks[]; };
+layout (std430, binding = 2) readonly buffer MeshNormals { uvec4 blockNormals[]; };
+layout (std430, binding = 3) readonly buffer SceneNodes { Node sceneNodes[]; };
+layout (std430, binding = 4) readonly buffer Instances { Instance instances[]; };
+
+const float PI = 3.14159265359;
+// the mesh trees split by SAH down to depth 64 and by the median below; deeper subtrees than the stack holds
+// are skipped
+const int MESH_STACK = 64;
+const int SCENE_STACK = 32;
+
+// the nearest hit of TraceScene()
+struct TraceHit
+{
+    int instance;        // -1 without a hit
+    float t;
+    vec3 normal;         // unit world geometric normal (winding order)
+    vec3 shadingNormal;  // the interpolated vertex normals where the tree keeps them, else the geometric one
+};
+
+vec3 InverseDirection(vec3 d)
+{
+    return 1.0 / mix(d, vec3(1e-8), lessThan(abs(d), vec3(1e-8)));
+}
+
+// slab test against the box, limited to [0, tMax]
+bool RayBox(vec3 origin, vec3 invDir, vec3 boundsMin, vec3 boundsMax, float tMax)
+{
+    vec3 t0 = (boundsMin - origin) * invDir;
+    vec3 t1 = (boundsMax - origin) * invDir;
+    vec3 tNear = min(t0, t1);
+    vec3 tFar = max(t0, t1);
+    float tEnter = max(max(tNear.x, tNear.y), max(tNear.z, 0.0));
+    return tEnter <= min(min(tFar.x, tFar.y), min(tFar.z, tMax));
+}
+
+// Moller-Trumbore against the block's four lanes at once; a nearer hit updates tHit and where it is: the
+// block, the lane and the barycentrics of vertex 1 and 2
+void IntersectBlock(uint b, vec3 o, vec3 d, inout float tHit, inout uvec2 blockLane, inout vec2 barycentrics)
+{
+    Block block = blocks[b];
+    vec4 px = d.y * block.e2[2] - d.z * block.e2[1];
+    vec4 py = d.z * block.e2[0] - d.x * block.e2[2];
+    vec4 pz = d.x * block.e2[1] - d.y * block.e2[0];
+    vec4 det = block.e1[0] * px + block.e1[1] * py + block.e1[2] * pz;
+    vec4 inv = 1.0 / mix(det, vec4(1.0), equal(det, vec4(0.0)));
+    vec4 sx = o.x - block.v0[0], sy = o.y - block.v0[1], sz = o.z - block.v0[2];
+    vec4 u = (sx * px + sy * py + sz * pz) * inv;
+    vec4 qx = sy * block.e1[2] - sz * block.e1[1];
+    vec4 qy = sz * block.e1[0] - sx * block.e1[2];
+    vec4 qz = sx * block.e1[1] - sy * block.e1[0];
+    vec4 v = (d.x * qx + d.y * qy + d.z * qz) * inv;
+    vec4 t = (block.e2[0] * qx + block.e2[1] * qy + block.e2[2] * qz) * inv;
+    for (int l = 0; l < 4; ++l)
+    {
+        if (det[l] == 0.0 || u[l] < 0.0 || v[l] < 0.0 || u[l] + v[l] > 1.0 || t[l] <= 0.0 || t[l] >= tHit)
+            continue;
+        tHit = t[l];
+        blockLane = uvec2(b, uint(l));
+        barycentrics = vec2(u[l], v[l]);
+    }
+}
+
+// instance k's mesh tree against the world ray; the matrix is affine, so t means the same in both spaces.
+// True if it found a hit nearer than tHit.
+bool TraceMesh(uint k, vec3 worldOrigin, vec3 worldDir, inout float tHit, inout uvec2 blockLane, inout vec2 barycentrics)
+{
+    mat4 toMesh = instances[k].meshFromWorld;
+    vec3 o = (toMesh * vec4(worldOrigin, 1.0)).xyz;
+    vec3 d = mat3(toMesh) * worldDir;
+    vec3 invDir = InverseDirection(d);
+    float before = tHit;
+    uint stack[MESH_STACK];
+    int top = 0;
+    stack[top++] = instances[k].root;
+    while (top > 0)
+    {
+        uint index = stack[--top];
+        Node node = meshNodes[index];
+        if (!RayBox(o, invDir, node.boundsMin, node.boundsMax, tHit))
+            continue;
+        if ((node.meta & 3u) == 3u)
+        {
+            uint blockCount = ((node.meta >> 2) + 3u) / 4u;
+            for (uint b = node.index; b < node.index + blockCount; ++b)
+                IntersectBlock(b, o, d, tHit, blockLane, barycentrics);
+            continue;
+        }
+        if (top + 2 > MESH_STACK)
+            continue;
+        // nearer child on top
+        bool rightFirst = d[node.meta & 3u] < 0.0;
+        stack[top++] = rightFirst ? index + 1u : node.index;
+        stack[top++] = rightFirst ? node.index : index + 1u;
+    }
+    return tHit < before;
+}
+
+// octahedral snorm16 pair (VertexPacking::packNormal) to a unit vector
+vec3 UnpackNormal(uint packed)
+{
+    vec2 e = unpackSnorm2x16(packed);
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+// nearest instance along origin + t * dir, 0 < t < tMax
+TraceHit TraceScene(vec3 origin, vec3 dir, float tMax)
+{
+    TraceHit hit;
+    hit.instance = -1;
+    hit.t = tMax;
+    uvec2 blockLane = uvec2(0u);
+    vec2 barycentrics = vec2(0.0);
+    vec3 invDir = InverseDirection(dir);
+    uint stack[SCENE_STACK];
+    int top = 0;
+    stack[top++] = 0u;
+    while (top > 0)
+    {
+        uint index = stack[--top];
+        Node node = sceneNodes[index];
+        if (!RayBox(origin, invDir, node.boundsMin, node.boundsMax, hit.t))
+            continue;
+        if ((node.meta & 3u) == 3u)
+        {
+            for (uint k = node.index; k < node.index + (node.meta >> 2); ++k)
+                if (TraceMesh(k, origin, dir, hit.t, blockLane, barycentrics))
+                    hit.instance = int(k);
+            continue;
+        }
+        if (top + 2 > SCENE_STACK)
+            continue;
+        bool rightFirst = dir[node.meta & 3u] < 0.0;
+        stack[top++] = rightFirst ? index + 1u : node.index;
+        stack[top++] = rightFirst ? node.index : index + 1u;
+    }
+    hit.normal = hit.shadingNormal = vec3(0.0, 0.0, 1.0);
+    if (hit.instance < 0)
+        return hit;
+    // normals go to world space through the inverse transpose, i.e. the transpose of mesh-from-world
+    mat3 normalMatrix = transpose(mat3(instances[hit.instance].meshFromWorld));
+    Block block = blocks[blockLane.x];
+    uint l = blockLane.y;
+    vec3 e1 = vec3(block.e1[0][l], block.e1[1][l], block.e1[2][l]);
+    vec3 e2 = vec3(block.e2[0][l], block.e2[1][l], block.e2[2][l]);
+    hit.normal = normalize(normalMatrix * cross(e1, e2));
+    hit.shadingNormal = hit.normal;
+    if ((instances[hit.instance].flags & INSTANCE_SHADING_NORMALS) != 0u)
+    {
+        uint base = blockLane.x * 3u;
+        vec3 n = (1.0 - barycentrics.x - barycentrics.y) * UnpackNormal(blockNormals[base][l])
+               + barycentrics.x * UnpackNormal(blockNormals[base + 1u][l])
+               + barycentrics.y * UnpackNormal(blockNormals[base + 2u][l]);
+        if (dot(n, n) > 1e-8)
+            hit.shadingNormal = normalize(normalMatrix * n);
+    }
+    return hit;
+}
+
+// PCG hash
+uint Hash(uint x)
+{
+    uint state = x * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
@@ -0,0 +1,27 @@
+#version 330 core
+// Layered cubemap capture: the unit cube is drawn once and every triangle is emitted into all six faces
+// of the attached cube (gl_Layer = face, in GL face order), so a whole cube level is one draw call.
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 18) out;
+
+in vec3 CubePos[];
+
+out vec3 WorldPos;
+
+uniform mat4 projection;
+uniform mat4 captureViews[6];
+
+void main()
+{
+    for (int face = 0; face < 6; ++face)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            WorldPos = CubePos[i];
+            gl_Layer = face;
+            gl_Position = projection * captureViews[face] * vec4(WorldPos, 1.0);
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
@@ -0,0 +1,11 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+out vec3 CubePos;
+
+// positions only; cubemap_layered.gs projects each triangle into every face
+void main()
+{
+    CubePos = aPos;
+    gl_Position = vec4(aPos, 1.0);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+// CullDebug's boxes, blended over the window
+out vec4 FragColor;
+
+in vec4 Color;
+
+void main()
+{
+    FragColor = Color;
+}
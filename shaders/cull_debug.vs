@@ -0,0 +1,21 @@
+#version 330 core
+// one box of CullDebug as 12 lines: aCorner walks the unit cube's edges (24 corners), the box and its
+// colour come per instance
+layout (location = 0) in vec3 aCorner;
+layout (location = 1) in vec3 aBoxMin;
+layout (location = 2) in vec3 aBoxMax;
+layout (location = 3) in vec4 aColor;
+
+uniform mat4 viewProjection;
+// the boxes' model matrix, or the frozen inverse view-projection for the frozen frustum (-1..1 in clip
+// space), hence the divide
+uniform mat4 boxToWorld;
+
+out vec4 Color;
+
+void main()
+{
+    vec4 world = boxToWorld * vec4(mix(aBoxMin, aBoxMax, aCorner), 1.0);
+    gl_Position = viewProjection * vec4(world.xyz / world.w, 1.0);
+    Color = aColor;
+}
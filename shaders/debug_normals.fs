@@ -4,28 +4,26 @@ out vec4 FragColor;
 in vec2 TexCoords;
 in vec3 FragPos;
 in vec3 Normal;
-in vec3 Tangent;
-in vec3 Bitangent;
+in vec4 Tangent;
 
 uniform bool hasNormalMap;
 uniform sampler2D texture_normal1;
-uniform vec4 texture_normal1_uv;
-uniform float texture_normal1_rot;
+uniform vec4 texture_normal1_uv;     // column-major 2x2 UV matrix (Texture::uvMatrix)
+uniform vec2 texture_normal1_offset;
 
-vec2 applyUV(vec2 uv, vec4 uvparams, float rot)
+vec2 applyUV(vec2 uv, vec4 m, vec2 offset)
 {
-    vec2 offset = uvparams.xy;
-    vec2 scale = uvparams.zw;
-    float c = cos(rot);
-    float s = sin(rot);
-    mat2 R = mat2(c, -s, s, c);
-    return offset + (R * (uv * scale));
+    return offset + mat2(m.xy, m.zw) * uv;
 }
 
-vec3 getNormalFromMap(vec3 n, vec3 t, vec3 b, sampler2D normalMap, vec2 uv)
+vec3 getNormalFromMap(vec3 n, vec4 t, sampler2D normalMap, vec2 uv)
 {
-    vec3 tangentNormal = texture(normalMap, uv).xyz * 2.0 - 1.0;
-    mat3 TBN = mat3(normalize(t), normalize(b), normalize(n));
+    // same XY + rebuilt Z decode and TBN as model_loading.fs (BC5 normal maps)
+    vec3 tangentNormal;
+    tangentNormal.xy = texture(normalMap, uv).xy * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
+    vec3 T = normalize(t.xyz);
+    mat3 TBN = mat3(T, cross(n, T) * t.w, n);
     return normalize(TBN * tangentNormal);
 }
 
@@ -33,8 +31,8 @@ void main()
 {
     vec3 N = normalize(Normal);
     if (hasNormalMap) {
-        vec2 uvn = applyUV(TexCoords, texture_normal1_uv, texture_normal1_rot);
-        N = getNormalFromMap(N, Tangent, Bitangent, texture_normal1, uvn);
+        vec2 uvn = applyUV(TexCoords, texture_normal1_uv, texture_normal1_offset);
+        N = getNormalFromMap(N, Tangent, texture_normal1, uvn);
     }
     // encode normal into 0..1 for visualization
     vec3 encoded = N * 0.5 + 0.5;
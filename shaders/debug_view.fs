@@ -0,0 +1,129 @@
+#version 330 core
+// one fragment of a debug view (DebugViews). The counting views write a count that the draw adds up
+// (GL_ONE, GL_ONE) and debug_view_composite.fs turns into a heat ramp; the others write their colour, the
+// nearest surface's winning. Alpha-tested texels count as covered, and UVs are taken untransformed.
+out vec4 FragColor;
+
+in vec2 TexCoords;
+flat in vec2 Corner0;
+flat in vec2 Corner1;
+flat in vec2 Corner2;
+flat in int Behind;
+
+// DebugViews::Mode
+const int OVERDRAW = 1;
+const int QUAD_OVERDRAW = 2;
+const int TEXEL_DENSITY = 3;
+const int PERMUTATION = 4;
+const int TRIANGLE_DENSITY = 5;
+const int WIREFRAME = 6;
+
+uniform int mode;
+
+// the material's base colour texture, as Model binds it (one of the two)
+uniform bool hasBaseColor;
+uniform bool useTextureArrays;
+uniform sampler2D texture_diffuse1;
+uniform sampler2DArray diffuseArray;
+// the per-mesh flags, for the permutation view without shader variants
+uniform bool hasNormalMap;
+uniform bool hasMetallicRoughness;
+uniform float alphaCutoff;
+uniform float clearcoatFactor;
+uniform float transmissionFactor;
+
+// which side of the edge a -> b `p` is on, positive inside a counter-clockwise triangle
+float Edge(vec2 a, vec2 b, vec2 p)
+{
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+bool Covers(vec2 p, float winding)
+{
+    return Edge(Corner0, Corner1, p) * winding >= 0.0 && Edge(Corner1, Corner2, p) * winding >= 0.0 &&
+           Edge(Corner2, Corner0, p) * winding >= 0.0;
+}
+
+// the fragment shader runs on 2x2 quads, so a quad the triangle covers only partly still pays for four
+// lanes: each covered pixel adds 4 / its quad's covered pixels, which sums to 4 per quad touched
+float QuadCost()
+{
+    float winding = Edge(Corner0, Corner1, Corner2) >= 0.0 ? 1.0 : -1.0;
+    if (Behind != 0)
+        return 1.0;
+    vec2 quad = floor(gl_FragCoord.xy * 0.5) * 2.0;
+    float live = 0.0;
+    live += Covers(quad + vec2(0.5, 0.5), winding) ? 1.0 : 0.0;
+    live += Covers(quad + vec2(1.5, 0.5), winding) ? 1.0 : 0.0;
+    live += Covers(quad + vec2(0.5, 1.5), winding) ? 1.0 : 0.0;
+    live += Covers(quad + vec2(1.5, 1.5), winding) ? 1.0 : 0.0;
+    return 4.0 / max(live, 1.0);
+}
+
+// texels of the base colour texture per pixel, as log2 (the mip level the sampler picks): blue where the
+// texture is magnified, green at one texel per pixel, red from 4x4 texels per pixel on (top levels never read)
+vec3 TexelDensity()
+{
+#ifdef MATERIAL_VARIANT
+    bool textured = HAS_BASE_COLOR != 0;
+#else
+    bool textured = hasBaseColor || useTextureArrays;
+#endif
+    if (!textured)
+        return vec3(0.25);
+    vec2 size = useTextureArrays ? vec2(textureSize(diffuseArray, 0).xy) : vec2(textureSize(texture_diffuse1, 0));
+    vec2 dx = dFdx(TexCoords * size), dy = dFdy(TexCoords * size);
+    float level = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8));
+    if (level < 0.0)
+        return mix(vec3(0.0, 0.8, 0.0), vec3(0.0, 0.2, 1.0), clamp(-level / 3.0, 0.0, 1.0));
+    return mix(vec3(0.0, 0.8, 0.0), vec3(1.0, 0.0, 0.0), clamp(level / 2.0, 0.0, 1.0));
+}
+
+// one colour per model_loading program (Shader::Feature bits), hashed so neighbouring sets differ
+vec3 Permutation()
+{
+#ifdef MATERIAL_VARIANT
+    uint features = uint(HAS_BASE_COLOR) | uint(HAS_NORMAL_MAP) << 1 | uint(HAS_MR) << 2 | uint(HAS_UV_TRANSFORM) << 3 |
+                    uint(ALPHA_MASK) << 4 | uint(CLEARCOAT) << 5 | uint(TRANSMISSION) << 6 | uint(SKINNED) << 7;
+#else
+    uint features = uint(hasBaseColor) | uint(hasNormalMap) << 1 | uint(hasMetallicRoughness) << 2 |
+                    uint(alphaCutoff > 0.0) << 4 | uint(clearcoatFactor > 0.0) << 5 | uint(transmissionFactor > 0.0) << 6;
+#endif
+    uint h = (features + 1u) * 2654435761u;
+    h ^= h >> 15;
+    return vec3(uvec3(h, h >> 8, h >> 16) & 255u) / 255.0 * 0.75 + 0.25;
+}
+
+// coverage of the nearest edge at this pixel: the distance to each edge's line in window pixels, a line
+// about a pixel wide with its border antialiased. Triangles reaching behind the eye have no corners to
+// measure from and show no edges.
+float EdgeCoverage()
+{
+    if (Behind != 0)
+        return 0.0;
+    vec2 p = gl_FragCoord.xy;
+    float d0 = abs(Edge(Corner0, Corner1, p)) / max(length(Corner1 - Corner0), 1e-5);
+    float d1 = abs(Edge(Corner1, Corner2, p)) / max(length(Corner2 - Corner1), 1e-5);
+    float d2 = abs(Edge(Corner2, Corner0, p)) / max(length(Corner0 - Corner2), 1e-5);
+    return 1.0 - smoothstep(0.5, 1.5, min(d0, min(d1, d2)));
+}
+
+void main()
+{
+    if (mode == OVERDRAW)
+        FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+    else if (mode == QUAD_OVERDRAW)
+        FragColor = vec4(QuadCost(), 0.0, 0.0, 1.0);
+    else if (mode == TEXEL_DENSITY)
+        FragColor = vec4(TexelDensity(), 1.0);
+    else if (mode == PERMUTATION)
+        FragColor = vec4(Permutation(), 1.0);
+    else if (mode == WIREFRAME)
+        FragColor = vec4(0.1, 1.0, 0.3, EdgeCoverage());
+    else
+    {
+        // pixels per triangle, as a count for the ramp: 8 below a pixel, down to 1 from 128 pixels on
+        float area = Behind != 0 ? 1e6 : 0.5 * abs(Edge(Corner0, Corner1, Corner2));
+        FragColor = vec4(clamp(8.0 - log2(max(area, 1.0)), 1.0, 8.0), 0.0, 0.0, 1.0);
+    }
+}
@@ -0,0 +1,41 @@
+#version 330 core
+// DebugViews (DEBUG_VIEW): passes each triangle on with its UVs, and with its three corners in window pixels
+// on every vertex, so debug_view.fs can tell which pixels of a 2x2 quad the triangle covers and how large it
+// is on screen. model_loading.vs projects as usual; its other outputs go unused.
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+in vec2 vsTexCoords[];
+
+out vec2 TexCoords;
+flat out vec2 Corner0;
+flat out vec2 Corner1;
+flat out vec2 Corner2;
+// a corner at or behind the eye: the corners above mean nothing, and the triangle counts as large
+flat out int Behind;
+
+uniform vec2 viewportSize;
+
+void main()
+{
+    vec2 corners[3];
+    int behind = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        vec4 clip = gl_in[i].gl_Position;
+        if (clip.w <= 1e-5)
+            behind = 1;
+        corners[i] = (clip.xy / max(clip.w, 1e-5) * 0.5 + 0.5) * viewportSize;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        gl_Position = gl_in[i].gl_Position;
+        TexCoords = vsTexCoords[i];
+        Corner0 = corners[0];
+        Corner1 = corners[1];
+        Corner2 = corners[2];
+        Behind = behind;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
@@ -0,0 +1,28 @@
+#version 330 core
+// DebugViews over the window: the counting views through a heat ramp (black none, blue 1, cyan 2, green 3,
+// yellow 5, red 8, white beyond), the coloured ones as they are, the wireframe blended over the scene by
+// its coverage
+out vec4 FragColor;
+
+uniform sampler2D source;
+uniform bool ramp;
+uniform bool overlay;
+
+vec3 Heat(float count)
+{
+    const vec3 stops[6] = vec3[6](vec3(0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 1.0, 1.0), vec3(0.0, 1.0, 0.0),
+                                  vec3(1.0, 1.0, 0.0), vec3(1.0, 0.0, 0.0));
+    const float at[6] = float[6](0.0, 1.0, 2.0, 3.0, 5.0, 8.0);
+    if (count >= at[5])
+        return mix(stops[5], vec3(1.0), clamp((count - at[5]) / 8.0, 0.0, 1.0));
+    for (int i = 1; i < 6; ++i)
+        if (count < at[i])
+            return mix(stops[i - 1], stops[i], (count - at[i - 1]) / (at[i] - at[i - 1]));
+    return stops[5];
+}
+
+void main()
+{
+    vec4 value = texelFetch(source, ivec2(gl_FragCoord.xy), 0);
+    FragColor = vec4(ramp ? Heat(value.r) : value.rgb, overlay ? value.a : 1.0);
+}
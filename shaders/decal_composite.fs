@@ -0,0 +1,34 @@
+#version 330 core
+// one decal composited into a car's paint texture (DecalCompositor): the paint meshes are drawn laid out in
+// their UVs (model_loading.vs with UV_SPACE), and every texel they cover looks itself up in the decal's box
+// projector by its model-space position. Blended premultiplied over what the earlier decals left.
+layout (location = 0) out vec4 FragColor;
+// the paint's coverage of the texture, for the gutter DecalCompositor grows around the UV islands
+layout (location = 1) out vec4 Coverage;
+
+in vec3 FragPos; // model space: the compositor draws with an identity model matrix
+in vec3 Normal;
+
+uniform mat4 decalFromModel;   // model space to the decal's box, [-1, 1] on each axis
+uniform vec3 decalDirection;   // the projection's direction, into the surface
+uniform float decalOpacity;
+uniform sampler2D decalImage;
+
+void main()
+{
+    Coverage = vec4(1.0);
+    vec3 box = (decalFromModel * vec4(FragPos, 1.0)).xyz;
+    // the image's first row at the top (+up) of the box; sampled before any branch, for its derivatives
+    vec4 decal = texture(decalImage, vec2(box.x, -box.y) * 0.5 + 0.5);
+    // outside the box and on faces turned away from the projector (the far side of a door) nothing lands;
+    // the facing and the box's depth fade it out rather than cut it
+    float facing = dot(normalize(Normal), -decalDirection);
+    float weight = decalOpacity * smoothstep(0.05, 0.3, facing) * (1.0 - smoothstep(0.8, 1.0, abs(box.z)));
+    if (any(greaterThan(abs(box.xy), vec2(1.0))) || weight <= 0.0)
+    {
+        FragColor = vec4(0.0);
+        return;
+    }
+    float alpha = decal.a * weight;
+    FragColor = vec4(decal.rgb * alpha, alpha);
+}
@@ -0,0 +1,32 @@
+#version 330 core
+// the gutter around the UV islands of a composited decal texture (DecalCompositor): texels no paint covers
+// take the mean of the covered ones within two texels, so bilinear and mip lookups at an island's edge
+// don't pull the decals towards nothing. Covered texels are copied as they are.
+layout (location = 0) out vec4 FragColor;
+
+uniform sampler2D decalColor;
+uniform sampler2D decalCoverage;
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    if (texelFetch(decalCoverage, texel, 0).r > 0.5)
+    {
+        FragColor = texelFetch(decalColor, texel, 0);
+        return;
+    }
+    ivec2 size = textureSize(decalColor, 0);
+    vec4 sum = vec4(0.0);
+    float count = 0.0;
+    for (int y = -2; y <= 2; ++y)
+        for (int x = -2; x <= 2; ++x)
+        {
+            ivec2 neighbour = clamp(texel + ivec2(x, y), ivec2(0), size - 1);
+            if (texelFetch(decalCoverage, neighbour, 0).r > 0.5)
+            {
+                sum += texelFetch(decalColor, neighbour, 0);
+                count += 1.0;
+            }
+        }
+    FragColor = count > 0.0 ? sum / count : vec4(0.0);
+}
@@ -0,0 +1,5 @@
+#version 330 core
+// depth only; colour writes are masked off by the caller
+void main()
+{
+}
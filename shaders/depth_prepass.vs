@@ -0,0 +1,40 @@
+#version 330 core
+// depth-only pre-pass (DEPTH_PREPASS=1): positions only, transformed exactly like model_loading.vs so
+// the colour pass after it matches the depths with GL_LEQUAL
+layout (location = 0) in vec4 aPosition;
+layout (location = 4) in mat4 aInstance;
+
+// the same block model_loading.vs reads (Model::ObjectData)
+layout (std140) uniform Object
+{
+    mat4 model;
+    mat3 normalMatrix;
+    vec4 positionOffset;
+    vec4 positionScale;
+    mat4 previousModel;
+};
+// per view, as in model_loading.vs (FrameData)
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;
+    vec3 sunDirection;
+    float iblSeed;
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
+
+invariant gl_Position;
+
+void main()
+{
+    vec3 aPos = positionOffset.xyz + aPosition.xyz * positionScale.xyz;
+    mat4 world = model * aInstance;
+    vec4 worldPos = world * vec4(aPos, 1.0);
+    gl_Position = projection * view * worldPos;
+}
@@ -0,0 +1,20 @@
+#version 330 core
+// The frame's exposure (AutoExposure::update, GL 3.3 path, one texel): key / the mean luminance from the
+// last mip of the log luminance target, eased towards from the previous frame's exposure. Without a
+// histogram there is no percentile cut; the log average already keeps small highlights from swinging it.
+out float Exposure;
+
+uniform sampler2D logLuminance;
+uniform float logLuminanceLevel; // its 1x1 mip
+uniform sampler2D previousExposure;
+uniform float key;
+uniform float adaptation; // fraction of the way to the target this frame (1 = at once)
+uniform float minExposure;
+uniform float maxExposure;
+
+void main()
+{
+    float target = clamp(key / exp2(textureLod(logLuminance, vec2(0.5), logLuminanceLevel).r), minExposure, maxExposure);
+    float previous = texelFetch(previousExposure, ivec2(0), 0).r;
+    Exposure = previous > 0.0 ? exp2(mix(log2(previous), log2(target), adaptation)) : target;
+}
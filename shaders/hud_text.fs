@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// PerfHud atlas: white glyphs on transparent texels, plus solid palette swatches for bars and panel
+uniform sampler2D atlas;
+
+void main()
+{
+    FragColor = texture(atlas, TexCoords);
+}
@@ -0,0 +1,160 @@
+#version 330 core
+// one pixel of an impostor (Impostors): the model's surface from the atlas frames around the view direction,
+// lit like model_loading.fs lights the meshes (without the local lights, shadows and screen-space passes),
+// at its own depth and with the camera's motion
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec2 Velocity;
+layout (location = 2) out uint ObjectId;
+
+in vec3 WorldPos;
+flat in vec3 Center;
+flat in mat3 ModelToWorld;
+flat in mat3 WorldToModel;
+flat in vec2 FrameGrid;
+// the placement's paint and dirt (Mesh::instanceVariation)
+flat in uvec3 InstanceVariation;
+
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;
+    vec3 sunDirection;
+    float iblSeed;
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
+
+uniform vec3 boundsCenter;
+uniform float boundsRadius;
+uniform int frames;
+// albedo with coverage in alpha; octahedral normal (0.5 + 0.5 * e), the capture's depth and where the
+// painted material was
+uniform sampler2D impostorAlbedo;
+uniform sampler2D impostorNormalDepth;
+uniform samplerCube prefilteredMap;
+// the hand-over to the meshes (see model_loading.fs): this side keeps the pixels the meshes discard
+uniform vec2 impostorFade;
+
+const float PI = 3.14159265;
+
+// Impostors::frameDirection: the grid point decoded from the hemi-octahedral square
+vec3 FrameDirection(vec2 frame)
+{
+    vec2 e = frame / float(frames - 1) * 2.0 - 1.0;
+    vec3 d = vec3(0.5 * (e.x + e.y), 0.0, 0.5 * (e.x - e.y));
+    d.y = 1.0 - abs(d.x) - abs(d.z);
+    return normalize(d);
+}
+
+// model_loading.vs's octDecode
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+// model_loading.fs's ImpostorDither
+float ImpostorDither()
+{
+    return fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
+}
+
+float shDot(mat3 coefficients, mat3 basis)
+{
+    return dot(coefficients[0], basis[0]) + dot(coefficients[1], basis[1]) + dot(coefficients[2], basis[2]);
+}
+
+vec3 IrradianceSH(vec3 N)
+{
+    mat3 basis = mat3(1.0, N.y, N.z,
+                      N.x, N.x * N.y, N.y * N.z,
+                      3.0 * N.z * N.z - 1.0, N.x * N.z, N.x * N.x - N.y * N.y);
+    return max(vec3(shDot(irradianceSH_r, basis), shDot(irradianceSH_g, basis), shDot(irradianceSH_b, basis)), 0.0);
+}
+
+// the pixel's ray through frame `frame`: its plane through the centre faces the frame's camera, so the ray's
+// hit on it is where that camera saw the surface along the same line of sight. Adds the frame's albedo,
+// normal, surface point (model space) and paint mask, weighted by `weight` times the coverage there.
+void SampleFrame(vec2 frame, float weight, vec3 rayOrigin, vec3 rayDirection,
+                 inout vec4 albedo, inout vec3 normal, inout vec3 surface, inout float paint)
+{
+    if (weight <= 0.0)
+        return;
+    vec3 direction = FrameDirection(frame);
+    // glm::lookAt's basis, as Impostors::bake set the frame's camera up
+    vec3 up = abs(direction.y) > 0.999 ? vec3(0.0, 0.0, -1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 s = normalize(cross(-direction, up));
+    vec3 u = cross(s, -direction);
+    float facing = dot(rayDirection, direction);
+    if (abs(facing) < 1e-4)
+        return;
+    vec3 hit = rayOrigin + rayDirection * (dot(boundsCenter - rayOrigin, direction) / facing) - boundsCenter;
+    vec2 xy = vec2(dot(hit, s), dot(hit, u)) / boundsRadius;
+    if (any(greaterThan(abs(xy), vec2(1.0))))
+        return;
+    vec2 uv = (frame + xy * 0.5 + 0.5) / float(frames);
+    vec4 a = texture(impostorAlbedo, uv);
+    vec4 nd = texture(impostorNormalDepth, uv);
+    float w = weight * a.a;
+    albedo += vec4(a.rgb, a.a) * weight;
+    normal += octDecode(nd.xy * 2.0 - 1.0) * w;
+    // the orthographic capture spans the sphere's diameter, front (0) to back (1)
+    surface += (hit + direction * boundsRadius * (1.0 - 2.0 * nd.z)) * w;
+    paint += nd.w * w;
+}
+
+void main()
+{
+    // the ray in model space, where the frames are
+    vec3 rayOrigin = WorldToModel * (viewPos - Center) + boundsCenter;
+    vec3 rayDirection = normalize(WorldToModel * (WorldPos - viewPos));
+    vec2 base = clamp(floor(FrameGrid), vec2(0.0), vec2(float(frames - 2)));
+    vec2 f = clamp(FrameGrid - base, 0.0, 1.0);
+    vec4 albedo = vec4(0.0);
+    vec3 normal = vec3(0.0);
+    vec3 surface = vec3(0.0);
+    float paint = 0.0;
+    SampleFrame(base, (1.0 - f.x) * (1.0 - f.y), rayOrigin, rayDirection, albedo, normal, surface, paint);
+    SampleFrame(base + vec2(1.0, 0.0), f.x * (1.0 - f.y), rayOrigin, rayDirection, albedo, normal, surface, paint);
+    SampleFrame(base + vec2(0.0, 1.0), (1.0 - f.x) * f.y, rayOrigin, rayDirection, albedo, normal, surface, paint);
+    SampleFrame(base + vec2(1.0, 1.0), f.x * f.y, rayOrigin, rayDirection, albedo, normal, surface, paint);
+    if (albedo.a < 0.5)
+        discard;
+    vec3 baseColor = albedo.rgb / albedo.a;
+    // the placement's paint where the bake saw the painted material, its dirt as an even film (the meshes'
+    // streaks are below an impostor's resolution)
+    uint packedPaint = InstanceVariation.x;
+    if (InstanceVariation.y != 0u)
+        baseColor = mix(baseColor, vec3(uvec3(packedPaint, packedPaint >> 8, packedPaint >> 16) & 255u) / 255.0,
+                        clamp(paint / albedo.a, 0.0, 1.0));
+    baseColor = mix(baseColor, vec3(0.16, 0.13, 0.1), 0.5 * float(packedPaint >> 24) / 255.0);
+    vec3 worldSurface = Center + ModelToWorld * (surface / albedo.a);
+
+    if (impostorFade.y > 0.0 && ImpostorDither() >= clamp((length(viewPos - worldSurface) - impostorFade.x) / (impostorFade.y - impostorFade.x), 0.0, 1.0))
+        discard;
+
+    vec3 N = normalize(ModelToWorld * normal);
+    vec3 V = normalize(viewPos - worldSurface);
+    vec3 L = normalize(sunDirection);
+    // the paint's coat over a diffuse base: the diffuse lobes of model_loading.fs, a rough mirror on top
+    float NdotV = max(dot(N, V), 0.0);
+    float fresnel = 0.04 + 0.96 * pow(1.0 - NdotV, 5.0);
+    vec3 diffuse = baseColor * (IrradianceSH(N) + max(dot(N, L), 0.0) / PI);
+    vec3 reflection = textureLod(prefilteredMap, reflect(-V, N), 0.3 * prefilterMaxMip).rgb;
+    vec3 color = diffuse * (1.0 - fresnel) + reflection * fresnel;
+
+    vec4 clip = projection * view * vec4(worldSurface, 1.0);
+    gl_FragDepth = clamp(clip.z / clip.w * 0.5 + 0.5, 0.0, 1.0);
+    vec4 currentClip = unjitteredViewProjection * vec4(worldSurface, 1.0);
+    vec4 previousClip = previousViewProjection * vec4(worldSurface, 1.0);
+    Velocity = (currentClip.xy / currentClip.w - previousClip.xy / previousClip.w) * 0.5;
+    ObjectId = 0u;
+    FragColor = vec4(color, 1.0);
+}
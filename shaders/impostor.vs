@@ -0,0 +1,59 @@
+#version 330 core
+// camera-facing quad over one placement's bounding sphere (Impostors::draw sends 4 vertices per instance as
+// a strip, without attributes besides the placement's Mesh::InstanceTransform); impostor.fs finds the
+// surface in the atlas
+layout (location = 4) in mat4 aPlacement;
+// Mesh::instanceVariation of the placement
+layout (location = 15) in uvec3 aInstanceVariation;
+
+// per view, as in model_loading.vs (FrameData)
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;
+    vec3 sunDirection;
+    float iblSeed;
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
+
+// the model-space sphere the frames were captured around, and the frames per side of the atlas
+uniform vec3 boundsCenter;
+uniform float boundsRadius;
+uniform int frames;
+
+out vec3 WorldPos;
+flat out vec3 Center;
+flat out mat3 ModelToWorld;
+flat out mat3 WorldToModel;
+// the view direction on the frame grid, in frames (the four around it are blended)
+flat out vec2 FrameGrid;
+flat out uvec3 InstanceVariation;
+
+void main()
+{
+    InstanceVariation = aInstanceVariation;
+    ModelToWorld = mat3(aPlacement);
+    WorldToModel = inverse(ModelToWorld);
+    Center = (aPlacement * vec4(boundsCenter, 1.0)).xyz;
+    // towards the camera in model space, kept on the upper hemisphere the frames cover, then hemi-octahedral
+    vec3 toCamera = WorldToModel * (viewPos - Center);
+    toCamera.y = max(toCamera.y, 0.0);
+    toCamera /= max(abs(toCamera.x) + abs(toCamera.y) + abs(toCamera.z), 1e-6);
+    FrameGrid = (vec2(toCamera.x + toCamera.z, toCamera.x - toCamera.z) * 0.5 + 0.5) * float(frames - 1);
+
+    // wide enough for the sphere's silhouette in perspective, not just its radius at the centre
+    float radius = boundsRadius * length(ModelToWorld[0]);
+    float distance = length(viewPos - Center);
+    float halfSize = radius / sqrt(max(1.0 - radius * radius / (distance * distance), 0.01));
+    vec3 right = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 up = vec3(view[0][1], view[1][1], view[2][1]);
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)) * 2.0 - 1.0;
+    WorldPos = Center + (right * corner.x + up * corner.y) * halfSize;
+    gl_Position = projection * view * vec4(WorldPos, 1.0);
+}
@@ -0,0 +1,56 @@
+#version 330 core
+// projects one irradiance volume cell's capture (IrradianceVolume) onto L1 spherical harmonics. The
+// capture is premultiplied HDR with coverage in alpha; what it covers is the cell's local light, stored
+// as irradiance / PI = a + dot(b, N) with b kept relative to a's luminance, and what it leaves uncovered
+// is the share of the sky the cell sees, applied to the live environment at shading time.
+layout (location = 0) out vec4 Volume0; // rgb: a, w: sky visibility
+layout (location = 1) out vec4 Volume1; // xyz: b / luminance(a), in the volume's (model) space
+
+uniform samplerCube capture;
+uniform int captureSize;
+uniform mat3 volumeRotation; // world to volume space
+
+// world direction through face coordinates (s, t) in [-1, 1] of cube face `face`, GL cube map conventions
+vec3 FaceDirection(int face, float s, float t)
+{
+    if (face == 0) return vec3(1.0, -t, -s);
+    if (face == 1) return vec3(-1.0, -t, s);
+    if (face == 2) return vec3(s, 1.0, t);
+    if (face == 3) return vec3(s, -1.0, -t);
+    if (face == 4) return vec3(s, -t, 1.0);
+    return vec3(-s, -t, -1.0);
+}
+
+void main()
+{
+    float texel = 2.0 / float(captureSize);
+    vec3 a = vec3(0.0);
+    vec3 b = vec3(0.0);
+    float sky = 0.0;
+    float totalAngle = 0.0;
+    for (int face = 0; face < 6; ++face)
+        for (int y = 0; y < captureSize; ++y)
+            for (int x = 0; x < captureSize; ++x)
+            {
+                float s = (float(x) + 0.5) * texel - 1.0;
+                float t = (float(y) + 0.5) * texel - 1.0;
+                vec3 d = FaceDirection(face, s, t);
+                float r2 = dot(d, d);
+                // solid angle of the texel
+                float angle = texel * texel / (r2 * sqrt(r2));
+                d *= inversesqrt(r2);
+                vec4 c = textureLod(capture, d, 0.0);
+                a += c.rgb * angle;
+                b += dot(c.rgb, vec3(0.2126, 0.7152, 0.0722)) * (volumeRotation * d) * angle;
+                sky += (1.0 - c.a) * angle;
+                totalAngle += angle;
+            }
+    // L1 irradiance / PI of radiance L: a = integral of L / 4 PI, b = integral of L * direction / 2 PI
+    // (the texel angles are normalised to sum to exactly 4 PI)
+    float norm = 4.0 / totalAngle;
+    a *= norm * 0.25;
+    b *= norm * 0.5;
+    float luminance = dot(a, vec3(0.2126, 0.7152, 0.0722));
+    Volume0 = vec4(a, clamp(sky / totalAngle, 0.0, 1.0));
+    Volume1 = vec4(luminance > 1e-6 ? b / luminance : vec3(0.0), 0.0);
+}
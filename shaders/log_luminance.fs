@@ -0,0 +1,17 @@
+#version 330 core
+// log2 luminance of the HDR image into AutoExposure's square target (GL 3.3 path); its mip chain then
+// averages it down to the one texel exposure_adapt.fs reads
+out float LogLuminance;
+
+uniform sampler2D hdrImage;
+uniform vec2 targetTexel; // 1 / size of the target
+uniform float minLogLuminance;
+uniform float logLuminanceRange;
+
+void main()
+{
+    float luminance = dot(texture(hdrImage, gl_FragCoord.xy * targetTexel).rgb, vec3(0.2126, 0.7152, 0.0722));
+    // NaNs and black pixels at the bottom of the range
+    float logLuminance = luminance > 1e-5 ? log2(luminance) : minLogLuminance;
+    LogLuminance = clamp(logLuminance, minLogLuminance, minLogLuminance + logLuminanceRange);
+}
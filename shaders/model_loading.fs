@@ -1,61 +1,373 @@
 #version 330 core
-out vec4 FragColor;
+#ifdef OIT_ACCUM
+// weighted blended transparency (WeightedOIT): accumulation and revealage targets
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out float Revealage;
+#else
+layout (location = 0) out vec4 FragColor;
+#ifndef PROBE_CAPTURE
+// screen-space motion since the last frame in UV units (ToneMapper's motion vector target, for TemporalAA;
+// discarded when the target has none)
+layout (location = 1) out vec2 Velocity;
+// GPU_PICKING=1: the pick ID of the surface (ToneMapper's R32UI pick attachment, see GpuPicker; discarded
+// when the target has none)
+layout (location = 2) out uint ObjectId;
+#ifndef VISIBILITY_RESOLVE
+in vec4 CurrentClip;
+in vec4 PreviousClip;
+flat in uint PickId;
+#endif
+#endif
+#ifdef IMPOSTOR_BAKE
+// Impostors::bake: octahedral world normal (xy, 0.5 + 0.5 * e), depth through the orthographic capture (z)
+// and the paint's coverage (w, MaterialOverrides::PAINT)
+layout (location = 1) out vec4 NormalDepth;
+#endif
+#endif
 
+#ifdef VISIBILITY_RESOLVE
+// fullscreen resolve of the visibility buffer (VisibilityBuffer): there is no vertex stage output, so
+// resolveVisibility() fills these in from the pixel's triangle
+vec2 TexCoords;
+vec3 FragPos;
+vec3 Normal;
+vec4 Tangent;
+float VertexOcclusion;
+int MaterialIndex;
+vec4 CurrentClip;
+vec4 PreviousClip;
+// screen-space derivatives of TexCoords across the triangle: neighbouring pixels may belong to other
+// triangles, so the material textures are sampled with these instead of the implicit ones
+vec2 TexCoordsDx;
+vec2 TexCoordsDy;
+// the resolve draws whole placements, without instance variations
+const uvec3 InstanceVariation = uvec3(0u);
+#else
 in vec2 TexCoords;
 in vec3 FragPos;
 in vec3 Normal;
-in vec3 Tangent;
-in vec3 Bitangent;
+in vec4 Tangent;
+// ambient occlusion baked by car_cook (1 = none baked)
+in float VertexOcclusion;
+flat in int MaterialIndex;
+// the instance's look (Mesh::instanceVariation): paint RGB8 + dirt in x, the tag painted in y, seed in z
+flat in uvec3 InstanceVariation;
+#endif
 
-uniform vec3 viewPos;
+// camera and environment of the view (FrameData in frame_data.h), shared with model_loading.vs
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;  // maximum mip level for prefiltered env map
+    vec3 sunDirection;      // direction towards the sun (world space)
+    float iblSeed;          // 0, or the index of a progressive still's sample (StochasticLobe)
+    // IBL diffuse irradiance / PI as L2 spherical harmonics (SHIrradiance): per colour channel the 9
+    // coefficients, column-major, for the basis 1, y, z | x, xy, yz | 3z^2-1, xz, x^2-y^2
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    // motion vectors (see model_loading.vs)
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
+
+#ifdef VISIBILITY_RESOLVE
+// the resolved model's geometry: its shared vertex buffer (5 words per PackedVertex), index buffer, per
+// mesh the first index of the LOD drawn and the base vertex, and the MaterialTable index per vertex
+const uint PRIMITIVE_BITS = 22u; // VisibilityBuffer::PRIMITIVE_BITS
+uniform usampler2D visibilityIds;
+uniform usamplerBuffer visibilityVertices;
+uniform usamplerBuffer visibilityIndices;
+uniform isamplerBuffer visibilityRanges;
+uniform usamplerBuffer visibilityMaterials;
+// the model's first vertex in visibilityVertices (a shared page); visibilityMaterials is the model's own
+uniform int visibilityVertexBase;
+// the placement's matrices, as model_loading.vs reads them (Model::ObjectData)
+layout (std140) uniform Object
+{
+    mat4 model;
+    mat3 normalMatrix;
+    vec4 positionOffset;
+    vec4 positionScale;
+    mat4 previousModel;
+};
+#endif
 
+// per-mesh material uniforms: only used when the model's materials don't fit the material table
 uniform vec4 baseColorFactor;
+// glTF alphaMode: alpha test threshold (0 = none, MASK) and whether alpha blends (BLEND; else it's 1)
+uniform float alphaCutoff;
+uniform bool alphaBlend;
+// KHR_materials_clearcoat strength (0 = no coat) and roughness
+uniform float clearcoatFactor;
+uniform float clearcoatRoughnessFactor;
+// KHR_materials_transmission: share of the diffuse lobe that's the scene behind instead (0 = none)
+uniform float transmissionFactor;
+// KHR_materials_specular colour * factor: dielectric F0 = 0.04 * this
+uniform vec3 specularColorFactor;
+// occlusion in R of the metallicRoughness texture (ORM packing): its strength, 0 = none
+uniform float occlusionStrength;
+// MaterialOverrides tag of the material (0 = none)
+uniform int materialTag;
 
 uniform bool hasBaseColor;
 uniform bool hasNormalMap;
 uniform bool hasMetallicRoughness;
 
+// KHR_texture_transform per slot, precomputed on the CPU (Texture::uvMatrix): _uv is the column-major
+// rotation*scale matrix, _offset the translation
 uniform sampler2D texture_diffuse1;
-uniform vec4 texture_diffuse1_uv; // offset.x, offset.y, scale.x, scale.y
-uniform float texture_diffuse1_rot;
+uniform vec4 texture_diffuse1_uv;
+uniform vec2 texture_diffuse1_offset;
 
 uniform sampler2D texture_normal1;
 uniform vec4 texture_normal1_uv;
-uniform float texture_normal1_rot;
+uniform vec2 texture_normal1_offset;
 
 uniform sampler2D texture_metallicRoughness1;
 uniform vec4 texture_metallicRoughness1_uv;
-uniform float texture_metallicRoughness1_rot;
+uniform vec2 texture_metallicRoughness1_offset;
+
+// material table (see MaterialTable): factors and UV transforms come from the Materials block, indexed
+// per vertex, so meshes with different materials share one multi-draw. Textures are the slot samplers
+// above, or the layer arrays below for models packed into texture arrays.
+uniform bool useMaterialTable;
+uniform bool useTextureArrays;
+struct MaterialData
+{
+    vec4 baseColorFactor;
+    vec4 factors;               // x = metallic, y = roughness, z = alpha cutoff, w = 1 if alpha blends
+    ivec4 layers;               // diffuse / normal / metallicRoughness array layer, -1 = none; w = UV_* bits,
+                                // occlusion strength * 255 from OCCLUSION_SHIFT
+    vec4 diffuseUV;             // column-major 2x2 UV matrix (identity unless the UV_* bit is set)
+    vec4 normalUV;
+    vec4 metallicRoughnessUV;
+    vec4 uvOffsets;             // xy = diffuse, zw = normal
+    vec4 uvOffsetsMR;           // xy = metallicRoughness; z = clearcoat factor, w = clearcoat roughness
+    vec4 specularTransmission;  // xyz = specular colour * factor, w = transmission factor
+};
+// MaterialData::UV_* bits: slots whose UV transform isn't the identity
+const int UV_DIFFUSE = 1;
+const int UV_NORMAL = 2;
+const int UV_METALLIC_ROUGHNESS = 4;
+const int OCCLUSION_SHIFT = 8;
+layout (std140) uniform Materials
+{
+    MaterialData materials[112]; // MaterialTable::MAX_MATERIALS
+};
+
+// runtime edits of tagged materials (see MaterialOverrides): entry tag - 1 replaces the factors its mask
+// names, for every material with that tag
+struct MaterialOverride
+{
+    vec4 baseColor;             // rgb
+    vec4 factors;               // x = metallic, y = roughness, z = clearcoat factor, w = clearcoat roughness
+    ivec4 mask;                 // x = OVERRIDE_* bits
+};
+const int OVERRIDE_BASE_COLOR = 1;
+const int OVERRIDE_METALLIC = 2;
+const int OVERRIDE_ROUGHNESS = 4;
+const int OVERRIDE_CLEARCOAT = 8;
+const int TAG_SHIFT = 16;       // MaterialOverrides::TAG_SHIFT, in MaterialData::layers.w
+layout (std140) uniform MaterialOverrides
+{
+    MaterialOverride overrides[4]; // MaterialOverrides::MAX_TAGS
+};
+uniform sampler2DArray diffuseArray;
+uniform sampler2DArray normalArray;
+uniform sampler2DArray metallicRoughnessArray;
 
-// IBL
-uniform samplerCube irradianceMap;
+// IBL (the irradiance is in FrameData)
 uniform samplerCube prefilteredMap;
 uniform sampler2D brdfLUT;
-uniform float prefilterMaxMip; // maximum mip level for prefiltered env map
+
+// the opaque scene of this frame for transmissive materials (RefractionCopy): a mipmapped half-size copy
+// read at the fragment's own pixel. Without one (or in probe captures) they see the environment instead.
+uniform bool transmissionCopy;
+uniform sampler2D transmissionMap;
+uniform float transmissionMaxMip;
+uniform vec2 transmissionTexel;         // 1 / scene size in pixels
+
+#ifndef PROBE_CAPTURE
+// local reflection probes (ReflectionProbes): premultiplied HDR captures of the nearby geometry with
+// coverage in alpha, blended over prefilteredMap. Not compiled into the capture shader itself.
+const int MAX_PROBES = 4; // ReflectionProbes::MAX_PROBES
+uniform int probeCount;
+uniform samplerCube probeMap0;
+uniform samplerCube probeMap1;
+uniform samplerCube probeMap2;
+uniform samplerCube probeMap3;
+uniform vec4 probeSpheres[MAX_PROBES]; // xyz = capture position, w = influence radius
+uniform vec3 probeBoxMin[MAX_PROBES];  // parallax proxy box, world space
+uniform vec3 probeBoxMax[MAX_PROBES];
+uniform float probeMaxMip;
+
+// irradiance volumes (IrradianceVolume): per placed model a grid of L1 light probes in its own space, all
+// in one pair of 3D textures, slot after slot along z. volume0 holds the local light's band 0 and the share
+// of the sky seen, volume1 the luminance's band 1 direction over band 0
+const int MAX_VOLUMES = 4; // IrradianceVolume::MAX_VOLUMES
+uniform int volumeCount;
+uniform sampler3D irradianceVolume0;
+uniform sampler3D irradianceVolume1;
+uniform mat4 volumeFromWorld[MAX_VOLUMES]; // world to grid coordinates, cell centres at +0.5
+uniform mat3 volumeRotation[MAX_VOLUMES];  // world to volume directions
+uniform int volumeSlot[MAX_VOLUMES];
+uniform vec3 volumeGrid;
+
+// clustered local lights (ClusteredLights): the lights touching this fragment's cluster of the view grid.
+// Built for the main view, so probe captures leave them out.
+const int CLUSTER_X = 16; // ClusteredLights::GRID_X/Y/Z
+const int CLUSTER_Y = 9;
+const int CLUSTER_Z = 24;
+uniform int clusterLightCount;          // 0 = no local lights
+uniform vec2 clusterDepthScaleBias;     // slice = log(view depth) * x + y
+uniform vec2 clusterTileSize;           // pixels per tile
+uniform samplerBuffer lightData;        // per light: position, radius | colour, cos inner | direction, cos outer |
+                                        // area lights: half width along their right axis, half height (0 = none)
+uniform sampler2DArray ltcLut;          // LTCLUT: GGX inverse matrix terms | albedo, Fresnel part
+uniform usamplerBuffer clusterRanges;   // per cluster: first index, count
+uniform usamplerBuffer clusterIndices;  // light indices, cluster by cluster
+
+// sun shadows (ShadowCascades): cascade c covers view depths up to shadowSplits[c]
+const int MAX_CASCADES = 3; // ShadowCascades::CASCADES
+uniform int shadowCascadeCount;         // 0 = no shadows
+uniform sampler2DArrayShadow shadowMap; // one depth layer per cascade
+uniform mat4 shadowMatrices[MAX_CASCADES]; // world to [0, 1] shadow texture space
+uniform vec4 shadowSplits;
+uniform vec4 shadowTexelSizes;          // world size of a texel per cascade, 0 = nothing casts there
+
+// screen-space ambient occlusion of the opaque scene (AmbientOcclusion): half-size visibility and view
+// depth, computed from this frame's depth before the opaque shading
+uniform bool screenOcclusion;
+uniform sampler2D ambientOcclusionMap;
+
+// screen-space reflections (ScreenSpaceReflections): half-size hits of this frame's mirror rays (last
+// frame's UV, confidence, ray length) and last frame's lit scene, half size with mips
+uniform bool screenReflections;
+uniform sampler2D reflectionHits;
+uniform sampler2D reflectionHistory;
+uniform float reflectionMaxMip;
+uniform float reflectionPixelScale;     // history pixels per world unit at view depth 1
+// ray-traced reflections (RayTracedReflections) in their place: reflectionHits then holds the half-size,
+// temporally accumulated radiance of the BVH rays (premultiplied by their hit rate) of surfaces up to
+// reflectionMaxRoughness
+uniform bool tracedReflections;
+uniform float reflectionMaxRoughness;
+
+// variable-rate shading of the opaque pass (ShadingRate): a rate per 16x16 tile (0 full, 0.5 half, 1 quarter
+// rate); skipped quads are filled in by ShadingRate::reconstruct
+const int SHADING_TILE = 16; // ShadingRate::TILE
+uniform bool coarseShading;
+uniform sampler2D shadingRateMap;
+uniform int shadingPhase;                // 0..3, turns every frame under TAA
+
+// meshes handing over to their impostors (Impostors::split): between x and y (view distances) a growing
+// share of the pixels is left to the impostor, dithered so impostor.fs draws exactly the others; 0 = none
+uniform vec2 impostorFade;
+#endif
+
+// DECALS (DecalCompositor): the car's decals, premultiplied, composited into its paint's UV layout whenever
+// the decal set changes; one lookup whatever their number
+uniform bool hasPaintDecals;
+uniform sampler2D paintDecals;
+
+#if !defined(PROBE_CAPTURE) || defined(VT_FEEDBACK)
+// LIVERY (VirtualTexture): the paint's livery through a page table (per page: the cache slot x, y and level
+// of the nearest resident page) into a cache of LIVERY_PAGE texel pages with LIVERY_BORDER texel borders.
+// liverySize holds the livery's size in texels (xy) and its coarsest level (z)
+const float LIVERY_PAGE = 128.0;       // CookedFormat::LIVERY_PAGE
+const float LIVERY_BORDER = 4.0;       // CookedFormat::LIVERY_BORDER
+uniform bool virtualLivery;
+uniform vec3 liverySize;
+uniform float liveryLodBias;           // the feedback pass's coarser pixels; 0 in the scene
+uniform sampler2D liveryPageTable;
+uniform sampler2D liveryCache;
+#endif
 
 // extra factors provided by CPU
 uniform float metallicFactor;
 uniform float roughnessFactor;
 
-// apply a simple UV transform: offset + R(scale * uv)
-vec2 applyUV(vec2 uv, vec4 uvparams, float rot)
+// apply a precomputed UV transform: offset + M * uv
+vec2 applyUV(vec2 uv, vec4 m, vec2 offset)
 {
-    vec2 offset = uvparams.xy;
-    vec2 scale = uvparams.zw;
-    float c = cos(rot);
-    float s = sin(rot);
-    mat2 R = mat2(c, -s, s, c);
-    return offset + (R * (uv * scale));
+    return offset + mat2(m.xy, m.zw) * uv;
 }
 
-// helper: normal map unpack and TBN
-vec3 getNormalFromMap(vec3 n, vec3 t, vec3 b, sampler2D normalMap, vec2 uv)
+// material texture lookups; `m` is the slot's UV matrix, which scales the triangle's UV derivatives in the
+// visibility resolve
+vec4 sampleMaterial(sampler2D s, vec2 uv, vec4 m)
 {
-    vec3 tangentNormal = texture(normalMap, uv).xyz * 2.0 - 1.0;
-    mat3 TBN = mat3(normalize(t), normalize(b), normalize(n));
+#ifdef VISIBILITY_RESOLVE
+    mat2 uvMatrix = mat2(m.xy, m.zw);
+    return textureGrad(s, uv, uvMatrix * TexCoordsDx, uvMatrix * TexCoordsDy);
+#else
+    return texture(s, uv);
+#endif
+}
+
+vec4 sampleMaterial(sampler2DArray s, vec3 uvLayer, vec4 m)
+{
+#ifdef VISIBILITY_RESOLVE
+    mat2 uvMatrix = mat2(m.xy, m.zw);
+    return textureGrad(s, uvLayer, uvMatrix * TexCoordsDx, uvMatrix * TexCoordsDy);
+#else
+    return texture(s, uvLayer);
+#endif
+}
+
+#if !defined(PROBE_CAPTURE) || defined(VT_FEEDBACK)
+// the livery level a pixel with UV derivatives `dx`, `dy` samples
+float liveryLevel(vec2 dx, vec2 dy)
+{
+    dx *= liverySize.xy;
+    dy *= liverySize.xy;
+    float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8)) + liveryLodBias;
+    return clamp(floor(lod + 0.5), 0.0, liverySize.z);
+}
+
+// position of `uv` in the texels of `level`, clamped to the image like the page borders are
+vec2 liveryTexel(vec2 uv, float level)
+{
+    vec2 size = max(liverySize.xy / exp2(level), vec2(1.0));
+    return clamp(uv * size, vec2(0.0), size - 0.5);
+}
+#endif
+
+#ifndef PROBE_CAPTURE
+// the livery at `uv`, from the page it needs or the nearest coarser one that is cached
+vec4 sampleLivery(vec2 uv, vec2 dx, vec2 dy)
+{
+    float level = liveryLevel(dx, dy);
+    vec3 entry = floor(texelFetch(liveryPageTable, ivec2(liveryTexel(uv, level) / LIVERY_PAGE), int(level)).rgb * 255.0 + 0.5);
+    vec2 texel = liveryTexel(uv, entry.z);
+    vec2 cached = entry.xy * (LIVERY_PAGE + 2.0 * LIVERY_BORDER) + LIVERY_BORDER + texel - floor(texel / LIVERY_PAGE) * LIVERY_PAGE;
+    return textureLod(liveryCache, cached / vec2(textureSize(liveryCache, 0)), 0.0);
+}
+#endif
+
+// helper: normal map unpack and TBN. `n` is the normalized surface normal, `t` the interpolated tangent with
+// its handedness in w; the bitangent is rebuilt rather than interpolated
+vec3 perturbNormal(vec3 n, vec4 t, vec2 texel)
+{
+    // Z is rebuilt from XY so two-channel (BC5) normal maps work too; tangent-space normals are unit length
+    vec3 tangentNormal;
+    tangentNormal.xy = texel * 2.0 - 1.0;
+    tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
+    vec3 T = normalize(t.xyz);
+    mat3 TBN = mat3(T, cross(n, T) * t.w, n);
     return normalize(TBN * tangentNormal);
 }
 
+// specular occlusion from ambient occlusion `ao` (Lagarde & de Rousiers 2014): the grazing and rough lobes
+// see more of the occluded hemisphere than the cosine-weighted AO did
+float SpecularOcclusion(float NdotV, float ao, float roughness)
+{
+    return clamp(pow(NdotV + ao, exp2(-16.0 * roughness - 1.0)) - 1.0 + ao, 0.0, 1.0);
+}
+
 // GGX / Cook-Torrance functions
 float DistributionGGX(vec3 N, vec3 H, float roughness)
 {
@@ -93,6 +405,33 @@ vec3 FresnelSchlick(float cosTheta, vec3 F0)
     return F0 + (1.0 - F0) * pow(1.0 - cosTheta, 5.0);
 }
 
+// Cook-Torrance response to radiance arriving from direction L
+vec3 DirectBRDF(vec3 N, vec3 V, vec3 L, vec3 baseColor, float metallic, float roughness, vec3 F0)
+{
+    vec3 H = normalize(V + L);
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = FresnelSchlick(max(dot(H, V), 0.0), F0);
+    vec3 kD = (1.0 - F) * (1.0 - metallic);
+    float NdotL = max(dot(N, L), 0.0);
+    vec3 specular = NDF * G * F / (4.0 * max(dot(N, V), 0.0) * NdotL + 0.001);
+    return (kD * baseColor / 3.14159265 + specular) * NdotL;
+}
+
+float shDot(mat3 coefficients, mat3 basis)
+{
+    return dot(coefficients[0], basis[0]) + dot(coefficients[1], basis[1]) + dot(coefficients[2], basis[2]);
+}
+
+// diffuse irradiance around unit normal N from the SH coefficients
+vec3 IrradianceSH(vec3 N)
+{
+    mat3 basis = mat3(1.0, N.y, N.z,
+                      N.x, N.x * N.y, N.y * N.z,
+                      3.0 * N.z * N.z - 1.0, N.x * N.z, N.x * N.x - N.y * N.y);
+    return max(vec3(shDot(irradianceSH_r, basis), shDot(irradianceSH_g, basis), shDot(irradianceSH_b, basis)), 0.0);
+}
+
 // sample prefiltered env map with roughness using LOD
 vec3 PrefilteredEnvRadiance(vec3 R, float roughness)
 {
@@ -101,82 +440,848 @@ vec3 PrefilteredEnvRadiance(vec3 R, float roughness)
     return textureLod(prefilteredMap, R, lod).rgb;
 }
 
+// progressive stills (iblSeed > 0, StillAccumulator): the reflection direction is jittered over part of
+// the GGX lobe and the prefiltered map read a little sharper, so the running mean of the frames integrates
+// the lobe with far more directions than the prefilter's mip blur. The two widths add in quadrature:
+// alpha^2 / sqrt(2) of jitter and roughness * 2^-1/4 of lookup make the same lobe as the plain lookup.
+// The noise is interleaved gradient noise per pixel, shifted by the seed every sample.
+float InterleavedGradientNoise(vec2 p)
+{
+    return fract(52.9829189 * fract(dot(p, vec2(0.06711056, 0.00583715))));
+}
+
+vec3 StochasticLobe(vec3 R, float roughness, out float lookupRoughness)
+{
+    lookupRoughness = roughness * 0.8409;
+    vec2 xi = vec2(InterleavedGradientNoise(gl_FragCoord.xy + 5.588238 * iblSeed),
+                   InterleavedGradientNoise(gl_FragCoord.yx + 3.136717 * iblSeed));
+    float a = roughness * roughness * 0.7071;
+    float phi = 6.2831853 * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+    float sinTheta = sqrt(max(1.0 - cosTheta * cosTheta, 0.0));
+    vec3 up = abs(R.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, R));
+    vec3 bitangent = cross(R, tangent);
+    return normalize(tangent * (cos(phi) * sinTheta) + bitangent * (sin(phi) * sinTheta) + R * cosTheta);
+}
+
+#ifndef PROBE_CAPTURE
+// box projection: where the reflection ray from the fragment leaves probe i's proxy box, seen from the
+// probe's capture position
+vec3 ProbeDirection(int i, vec3 R)
+{
+    vec3 safeR = (vec3(greaterThanEqual(R, vec3(0.0))) * 2.0 - 1.0) * max(abs(R), vec3(1e-5));
+    vec3 t0 = (probeBoxMin[i] - FragPos) / safeR;
+    vec3 t1 = (probeBoxMax[i] - FragPos) / safeR;
+    vec3 tFar = max(t0, t1);
+    float t = max(min(min(tFar.x, tFar.y), tFar.z), 0.0);
+    return FragPos + R * t - probeSpheres[i].xyz;
+}
+
+// 1 near the probe, fading to 0 at its influence radius
+float ProbeWeight(int i)
+{
+    float d = length(FragPos - probeSpheres[i].xyz);
+    return 1.0 - smoothstep(0.7 * probeSpheres[i].w, probeSpheres[i].w, d);
+}
+
+// diffuse irradiance / PI around N from the irradiance volumes holding the fragment, each fading out over
+// its outer half cell; `environment` (IrradianceSH) is what's left outside them and what their sky share sees
+vec3 VolumeIrradiance(vec3 N, vec3 environment)
+{
+    vec3 sum = vec3(0.0);
+    float total = 0.0;
+    for (int i = 0; i < volumeCount; ++i)
+    {
+        vec3 cell = (volumeFromWorld[i] * vec4(FragPos, 1.0)).xyz;
+        vec3 inside = min(cell, volumeGrid - cell);
+        float w = clamp(2.0 * min(min(inside.x, inside.y), inside.z), 0.0, 1.0);
+        if (w <= 0.0)
+            continue;
+        vec3 uvw = (clamp(cell, vec3(0.5), volumeGrid - 0.5) + vec3(0.0, 0.0, float(volumeSlot[i]) * volumeGrid.z)) /
+                   (volumeGrid * vec3(1.0, 1.0, float(MAX_VOLUMES)));
+        vec4 band0 = texture(irradianceVolume0, uvw);
+        vec3 band1 = texture(irradianceVolume1, uvw).xyz;
+        sum += w * (band0.rgb * max(1.0 + dot(band1, volumeRotation[i] * N), 0.0) + band0.a * environment);
+        total += w;
+    }
+    return total > 0.0 ? mix(environment, sum / total, min(total, 1.0)) : environment;
+}
+
+// one edge's share of the cosine-weighted integral over a polygon of unit vectors around +z, times 2 PI,
+// with a fitted acos(x) / sqrt(1 - x^2) (Hill and Heitz 2016)
+float IntegrateEdge(vec3 v1, vec3 v2)
+{
+    float x = dot(v1, v2);
+    float y = abs(x);
+    float a = 0.8543985 + (0.4965155 + 0.0145206 * y) * y;
+    float b = 3.4175940 + (4.1616724 + y) * y;
+    float v = a / b;
+    float thetaOverSin = x > 0.0 ? v : 0.5 * inversesqrt(max(1.0 - x * x, 1e-7)) - v;
+    return cross(v1, v2).z * thetaOverSin;
+}
+
+// clips the quad L[0..3] to the upper hemisphere (z >= 0), leaving n = 0, 3, 4 or 5 corners in L with the
+// first repeated after the last
+void ClipQuadToHorizon(inout vec3 L[5], out int n)
+{
+    int config = (L[0].z > 0.0 ? 1 : 0) + (L[1].z > 0.0 ? 2 : 0) + (L[2].z > 0.0 ? 4 : 0) + (L[3].z > 0.0 ? 8 : 0);
+    n = 0;
+    if (config == 1)
+    {
+        n = 3;
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+        L[2] = -L[3].z * L[0] + L[0].z * L[3];
+    }
+    else if (config == 2)
+    {
+        n = 3;
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+    }
+    else if (config == 3)
+    {
+        n = 4;
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+        L[3] = -L[3].z * L[0] + L[0].z * L[3];
+    }
+    else if (config == 4)
+    {
+        n = 3;
+        L[0] = -L[3].z * L[2] + L[2].z * L[3];
+        L[1] = -L[1].z * L[2] + L[2].z * L[1];
+    }
+    else if (config == 6)
+    {
+        n = 4;
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+        L[3] = -L[3].z * L[2] + L[2].z * L[3];
+    }
+    else if (config == 7)
+    {
+        n = 5;
+        L[4] = -L[3].z * L[0] + L[0].z * L[3];
+        L[3] = -L[3].z * L[2] + L[2].z * L[3];
+    }
+    else if (config == 8)
+    {
+        n = 3;
+        L[0] = -L[0].z * L[3] + L[3].z * L[0];
+        L[1] = -L[2].z * L[3] + L[3].z * L[2];
+        L[2] = L[3];
+    }
+    else if (config == 9)
+    {
+        n = 4;
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+        L[2] = -L[2].z * L[3] + L[3].z * L[2];
+    }
+    else if (config == 11)
+    {
+        n = 5;
+        L[4] = L[3];
+        L[3] = -L[2].z * L[3] + L[3].z * L[2];
+        L[2] = -L[2].z * L[1] + L[1].z * L[2];
+    }
+    else if (config == 12)
+    {
+        n = 4;
+        L[1] = -L[1].z * L[2] + L[2].z * L[1];
+        L[0] = -L[0].z * L[3] + L[3].z * L[0];
+    }
+    else if (config == 13)
+    {
+        n = 5;
+        L[4] = L[3];
+        L[3] = L[2];
+        L[2] = -L[1].z * L[2] + L[2].z * L[1];
+        L[1] = -L[1].z * L[0] + L[0].z * L[1];
+    }
+    else if (config == 14)
+    {
+        n = 5;
+        L[4] = -L[0].z * L[3] + L[3].z * L[0];
+        L[0] = -L[0].z * L[1] + L[1].z * L[0];
+    }
+    else if (config == 15)
+        n = 4;
+    // (5 and 10, opposite corners above, can't happen for a planar quad)
+    if (n == 3)
+        L[3] = L[0];
+    if (n == 4)
+        L[4] = L[0];
+}
+
+// integral of the cosine lobe taken through Minv (in the frame of N and V) over the one-sided quad
+// `corners`, in units of 2 PI
+float LTCRect(vec3 N, vec3 V, mat3 Minv, vec3 corners[4])
+{
+    vec3 T1 = V - N * dot(V, N);
+    T1 = dot(T1, T1) > 1e-8 ? normalize(T1) : normalize(cross(N, abs(N.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0)));
+    Minv = Minv * transpose(mat3(T1, cross(N, T1), N));
+    vec3 L[5];
+    for (int k = 0; k < 4; ++k)
+        L[k] = Minv * (corners[k] - FragPos);
+    L[4] = L[3];
+    int n;
+    ClipQuadToHorizon(L, n);
+    if (n == 0)
+        return 0.0;
+    for (int k = 0; k < 5; ++k)
+        L[k] = normalize(L[k]);
+    float sum = IntegrateEdge(L[0], L[1]) + IntegrateEdge(L[1], L[2]) + IntegrateEdge(L[2], L[3]);
+    if (n >= 4)
+        sum += IntegrateEdge(L[3], L[4]);
+    if (n == 5)
+        sum += IntegrateEdge(L[4], L[0]);
+    return max(sum, 0.0);
+}
+
+// a rectangular area light of unit radiance centred at `center` with half extents ex, ey (LTC: the GGX
+// lobe fitted as a transformed cosine, LTCLUT, and the Lambert lobe as the plain cosine)
+vec3 AreaLight(vec3 N, vec3 V, vec3 baseColor, float metallic, float roughness, vec3 F0, vec3 center, vec3 ex, vec3 ey)
+{
+    vec3 corners[4] = vec3[4](center - ex - ey, center + ex - ey, center + ex + ey, center - ex + ey);
+    const float LTC_SIZE = 64.0; // LTCLUT::SIZE
+    vec2 uv = vec2(roughness, sqrt(1.0 - clamp(dot(N, V), 0.0, 1.0))) * ((LTC_SIZE - 1.0) / LTC_SIZE) + 0.5 / LTC_SIZE;
+    vec4 t1 = texture(ltcLut, vec3(uv, 0.0));
+    vec4 t2 = texture(ltcLut, vec3(uv, 1.0));
+    mat3 Minv = mat3(vec3(t1.x, 0.0, t1.y), vec3(0.0, 1.0, 0.0), vec3(t1.z, 0.0, t1.w));
+    vec3 specular = LTCRect(N, V, Minv, corners) * (F0 * t2.x + (1.0 - F0) * t2.y);
+    vec3 diffuse = LTCRect(N, V, mat3(1.0), corners) * (1.0 - metallic) * baseColor;
+    return (specular + diffuse) / 6.2831853;
+}
+
+// sum of the clustered local lights at this fragment
+vec3 ClusterLights(vec3 N, vec3 V, vec3 baseColor, float metallic, float roughness, vec3 F0)
+{
+    if (clusterLightCount == 0)
+        return vec3(0.0);
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    ivec3 cell = ivec3(gl_FragCoord.xy / clusterTileSize, log(max(depth, 1e-4)) * clusterDepthScaleBias.x + clusterDepthScaleBias.y);
+    cell = clamp(cell, ivec3(0), ivec3(CLUSTER_X - 1, CLUSTER_Y - 1, CLUSTER_Z - 1));
+    uvec2 range = texelFetch(clusterRanges, (cell.z * CLUSTER_Y + cell.y) * CLUSTER_X + cell.x).rg;
+    vec3 sum = vec3(0.0);
+    for (uint k = 0u; k < range.y; ++k)
+    {
+        int i = int(texelFetch(clusterIndices, int(range.x + k)).r);
+        vec4 positionRadius = texelFetch(lightData, 4 * i);
+        vec4 colorInner = texelFetch(lightData, 4 * i + 1);
+        vec4 directionOuter = texelFetch(lightData, 4 * i + 2);
+        vec4 areaExtent = texelFetch(lightData, 4 * i + 3);
+        vec3 toLight = positionRadius.xyz - FragPos;
+        float d2 = dot(toLight, toLight);
+        float r = positionRadius.w;
+        if (d2 >= r * r)
+            continue;
+        // windowed to reach zero at the radius
+        float window = clamp(1.0 - (d2 * d2) / (r * r * r * r), 0.0, 1.0);
+        if (areaExtent.w > 0.0)
+        {
+            // the rectangle's own solid angle makes its falloff
+            vec3 ey = normalize(cross(areaExtent.xyz, directionOuter.xyz)) * areaExtent.w;
+            sum += AreaLight(N, V, baseColor, metallic, roughness, F0, positionRadius.xyz, areaExtent.xyz, ey) *
+                   colorInner.rgb * (window * window);
+            continue;
+        }
+        vec3 L = toLight * inversesqrt(max(d2, 1e-8));
+        // inverse square
+        float attenuation = window * window / (d2 + 1.0);
+        if (directionOuter.w > -1.0)
+            attenuation *= smoothstep(directionOuter.w, colorInner.w, dot(-L, directionOuter.xyz));
+        sum += DirectBRDF(N, V, L, baseColor, metallic, roughness, F0) * colorInner.rgb * attenuation;
+    }
+    return sum;
+}
+
+// fraction of the sunlight reaching the fragment: 3x3 bilinear PCF taps in its cascade, sampled from a
+// position pushed along the normal by about a texel (more at grazing angles) against shadow acne
+float SunShadow(vec3 N, vec3 L)
+{
+    if (shadowCascadeCount == 0)
+        return 1.0;
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    int c = 0;
+    while (c < shadowCascadeCount - 1 && depth > shadowSplits[c])
+        ++c;
+    if (depth > shadowSplits[c] || shadowTexelSizes[c] == 0.0)
+        return 1.0;
+    float NdotL = clamp(dot(N, L), 0.0, 1.0);
+    vec3 offsetPos = FragPos + N * shadowTexelSizes[c] * (1.5 - NdotL);
+    vec4 p = shadowMatrices[c] * vec4(offsetPos, 1.0);
+    if (any(lessThan(p.xyz, vec3(0.0))) || any(greaterThan(p.xyz, vec3(1.0))))
+        return 1.0;
+    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    float lit = 0.0;
+    for (int y = -1; y <= 1; ++y)
+        for (int x = -1; x <= 1; ++x)
+            lit += texture(shadowMap, vec4(p.xy + vec2(x, y) * texel, float(c), p.z));
+    return lit / 9.0;
+}
+
+// the screen-space occlusion at this pixel: the four half-size texels around it, weighted by bilinear
+// position and by how close their depth is to the fragment's, so occlusion doesn't bleed across edges.
+// Fragments that weren't in the depth the occlusion came from (no texel near their depth) get none.
+float ScreenSpaceOcclusion()
+{
+    if (!screenOcclusion)
+        return 1.0;
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    vec2 coord = gl_FragCoord.xy * 0.5 - 0.5;
+    ivec2 base = ivec2(floor(coord));
+    vec2 f = coord - vec2(base);
+    ivec2 maxTexel = textureSize(ambientOcclusionMap, 0) - 1;
+    float sum = 0.0;
+    float weightSum = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 corner = ivec2(i & 1, i >> 1);
+        vec2 s = texelFetch(ambientOcclusionMap, clamp(base + corner, ivec2(0), maxTexel), 0).rg;
+        vec2 bilinear = mix(1.0 - f, f, vec2(corner));
+        float w = (bilinear.x * bilinear.y + 1e-3) * clamp(1.0 - abs(s.y - depth) / (0.05 * depth), 0.0, 1.0);
+        sum += s.x * w;
+        weightSum += w;
+    }
+    return weightSum > 1e-4 ? sum / weightSum : 1.0;
+}
+
+// whether this pixel's 2x2 quad goes unshaded at its tile's rate: half rate skips every other quad
+// (checkerboard), quarter rate keeps one quad of each 2x2 quads. shading_reconstruct.fs has the same test.
+bool SkippedQuad()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    int rate = int(texelFetch(shadingRateMap, pixel / SHADING_TILE, 0).r * 2.0 + 0.5);
+    ivec2 quad = pixel >> 1;
+    if (rate == 1)
+        return ((quad.x + quad.y + shadingPhase) & 1) != 0;
+    if (rate == 2)
+        return ((quad.x + shadingPhase) & 1) != 0 || ((quad.y + (shadingPhase >> 1)) & 1) != 0;
+    return false;
+}
+
+// share of this pixel's dither pattern at or above which impostor.fs draws instead, in [0, 1)
+float ImpostorDither()
+{
+    return fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
+}
+
+// `environment` (the specular radiance along the mirror ray) with what the screen-space ray hit over it.
+// Last frame's colour is read at the hit with the mip of the lobe's footprint there: the cone of
+// `roughness` over the ray length, as seen from the camera. Rough lobes are the environment's alone.
+// Traced reflections already integrate the lobe: their hits go over the environment by their hit rate.
+vec3 ScreenSpaceReflection(vec3 environment, float roughness)
+{
+    if (tracedReflections)
+    {
+        vec4 traced = texelFetch(reflectionHits, ivec2(gl_FragCoord.xy * 0.5), 0);
+        float fade = 1.0 - smoothstep(0.5 * reflectionMaxRoughness, reflectionMaxRoughness, roughness);
+        return mix(environment, traced.rgb + environment * (1.0 - traced.a), fade);
+    }
+    if (!screenReflections)
+        return environment;
+    vec4 hit = texelFetch(reflectionHits, ivec2(gl_FragCoord.xy * 0.5), 0);
+    float weight = hit.z * (1.0 - smoothstep(0.4, 0.7, roughness));
+    if (weight <= 0.0)
+        return environment;
+    float depth = -(view * vec4(FragPos, 1.0)).z;
+    float footprint = 2.0 * hit.w * roughness * roughness * reflectionPixelScale / max(depth + hit.w, 1e-3);
+    float mip = min(log2(max(footprint, 1.0)), reflectionMaxMip);
+    return mix(environment, textureLod(reflectionHistory, hit.xy, mip).rgb, weight);
+}
+
+// specular radiance along R: the distant prefiltered environment, with the weighted probes over it
+vec3 SpecularRadiance(vec3 R, float roughness)
+{
+    vec3 distant = PrefilteredEnvRadiance(R, roughness);
+    if (probeCount == 0)
+        return distant;
+    float lod = roughness * probeMaxMip;
+    vec4 local = vec4(0.0);
+    float weight = 0.0;
+    // samplers can't be indexed dynamically in GLSL 3.30, hence one block per probe
+    if (probeCount > 0)
+    {
+        float w = ProbeWeight(0);
+        local += w * textureLod(probeMap0, ProbeDirection(0, R), lod);
+        weight += w;
+    }
+    if (probeCount > 1)
+    {
+        float w = ProbeWeight(1);
+        local += w * textureLod(probeMap1, ProbeDirection(1, R), lod);
+        weight += w;
+    }
+    if (probeCount > 2)
+    {
+        float w = ProbeWeight(2);
+        local += w * textureLod(probeMap2, ProbeDirection(2, R), lod);
+        weight += w;
+    }
+    if (probeCount > 3)
+    {
+        float w = ProbeWeight(3);
+        local += w * textureLod(probeMap3, ProbeDirection(3, R), lod);
+        weight += w;
+    }
+    // overlapping probes average; a lone probe's fade (weight < 1) lets the distant term back in
+    local /= max(weight, 1.0);
+    return local.rgb + distant * (1.0 - local.a);
+}
+#endif
+
+#ifdef VISIBILITY_RESOLVE
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+// PackedVertex fields by hand: GLSL 3.30 has no unpackSnorm2x16/unpackHalf2x16
+float snorm16(uint bits)
+{
+    return max(float(int(bits << 16u) >> 16) / 32767.0, -1.0);
+}
+
+float halfFloat(uint bits)
+{
+    uint exponent = (bits >> 10u) & 31u;
+    float mantissa = float(bits & 1023u);
+    float magnitude = exponent == 0u ? mantissa * exp2(-24.0) : (1.0 + mantissa / 1024.0) * exp2(float(exponent) - 15.0);
+    return (bits & 0x8000u) != 0u ? -magnitude : magnitude;
+}
+
+void fetchVertex(int v, out vec3 position, out vec3 normal, out vec3 tangent, out float handedness, out float occlusion, out vec2 uv)
+{
+    uint p0 = texelFetch(visibilityVertices, v * 5).r;
+    uint p1 = texelFetch(visibilityVertices, v * 5 + 1).r;
+    uint n = texelFetch(visibilityVertices, v * 5 + 2).r;
+    uint t = texelFetch(visibilityVertices, v * 5 + 3).r;
+    uint texCoords = texelFetch(visibilityVertices, v * 5 + 4).r;
+    position = positionOffset.xyz + vec3(float(p0 & 65535u), float(p0 >> 16u), float(p1 & 65535u)) / 65535.0 * positionScale.xyz;
+    handedness = (p1 & 0x80000000u) != 0u ? 1.0 : -1.0;
+    occlusion = float((p1 >> 16u) & 32767u) / 32767.0;
+    normal = octDecode(vec2(snorm16(n & 65535u), snorm16(n >> 16u)));
+    tangent = octDecode(vec2(snorm16(t & 65535u), snorm16(t >> 16u)));
+    uv = vec2(halfFloat(texCoords & 65535u), halfFloat(texCoords >> 16u));
+}
+
+// perspective-correct barycentrics of the pixel in the triangle with clip positions c0..c2, and their change
+// one pixel to the right (ddx) and up (ddy)
+vec3 barycentrics(vec4 c0, vec4 c1, vec4 c2, out vec3 ddx, out vec3 ddy)
+{
+    vec2 size = vec2(textureSize(visibilityIds, 0));
+    vec2 ndc = gl_FragCoord.xy / size * 2.0 - 1.0;
+    vec3 invW = 1.0 / vec3(c0.w, c1.w, c2.w);
+    vec2 p0 = c0.xy * invW.x;
+    vec2 p1 = c1.xy * invW.y;
+    vec2 p2 = c2.xy * invW.z;
+    float invDet = 1.0 / determinant(mat2(p2 - p1, p0 - p1));
+    // screen-space gradients of the barycentrics divided by w, which are linear in screen space
+    vec3 dx = vec3(p1.y - p2.y, p2.y - p0.y, p0.y - p1.y) * invDet * invW;
+    vec3 dy = vec3(p2.x - p1.x, p0.x - p2.x, p1.x - p0.x) * invDet * invW;
+    vec2 delta = ndc - p0;
+    vec3 overW = vec3(invW.x, 0.0, 0.0) + delta.x * dx + delta.y * dy;
+    float pixelInvW = dot(overW, vec3(1.0));
+    vec3 lambda = overW / pixelInvW;
+    dx *= 2.0 / size.x;
+    dy *= 2.0 / size.y;
+    ddx = (overW + dx) / (pixelInvW + dot(dx, vec3(1.0))) - lambda;
+    ddy = (overW + dy) / (pixelInvW + dot(dy, vec3(1.0))) - lambda;
+    return lambda;
+}
+
+// the pixel's triangle from the ID target, interpolated like model_loading.vs's outputs would be. Only
+// meshes baked into model space reach the ID pass, so there is no instance transform.
+void resolveVisibility()
+{
+    uint id = texelFetch(visibilityIds, ivec2(gl_FragCoord.xy), 0).r;
+    // the stencil key already limits the draw to this bucket's IDs
+    int mesh = int(id >> PRIMITIVE_BITS);
+    int primitive = int(id & ((1u << PRIMITIVE_BITS) - 1u));
+    ivec2 range = texelFetch(visibilityRanges, mesh).xy;
+    int first = range.x + primitive * 3;
+    int v0 = int(texelFetch(visibilityIndices, first).r) + range.y;
+    int v1 = int(texelFetch(visibilityIndices, first + 1).r) + range.y;
+    int v2 = int(texelFetch(visibilityIndices, first + 2).r) + range.y;
+    vec3 position[3], normal[3], tangent[3];
+    float handedness[3], occlusion[3];
+    vec2 uv[3];
+    fetchVertex(v0, position[0], normal[0], tangent[0], handedness[0], occlusion[0], uv[0]);
+    fetchVertex(v1, position[1], normal[1], tangent[1], handedness[1], occlusion[1], uv[1]);
+    fetchVertex(v2, position[2], normal[2], tangent[2], handedness[2], occlusion[2], uv[2]);
+    vec4 w0 = model * vec4(position[0], 1.0);
+    vec4 w1 = model * vec4(position[1], 1.0);
+    vec4 w2 = model * vec4(position[2], 1.0);
+    mat4 viewProjection = projection * view;
+    vec3 ddx, ddy;
+    vec3 b = barycentrics(viewProjection * w0, viewProjection * w1, viewProjection * w2, ddx, ddy);
+
+    vec3 local = mat3(position[0], position[1], position[2]) * b;
+    FragPos = mat3(w0.xyz, w1.xyz, w2.xyz) * b;
+    Normal = normalize(normalMatrix * (mat3(normal[0], normal[1], normal[2]) * b));
+    Tangent = vec4(normalize(normalMatrix * (mat3(tangent[0], tangent[1], tangent[2]) * b)),
+                   handedness[0] * (determinant(normalMatrix) < 0.0 ? -1.0 : 1.0));
+    VertexOcclusion = dot(vec3(occlusion[0], occlusion[1], occlusion[2]), b);
+    mat3x2 uvs = mat3x2(uv[0], uv[1], uv[2]);
+    TexCoords = uvs * b;
+    TexCoordsDx = uvs * ddx;
+    TexCoordsDy = uvs * ddy;
+    MaterialIndex = int(texelFetch(visibilityMaterials, v0 - visibilityVertexBase).r);
+    CurrentClip = unjitteredViewProjection * vec4(FragPos, 1.0);
+    PreviousClip = previousViewProjection * (previousModel * vec4(local, 1.0));
+}
+#endif
+
+float Hash12(vec2 p)
+{
+    return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
+}
+
+// smooth value noise over `p`, shifted by the instance's `seed` so every copy gets its own pattern
+float InstanceNoise(vec2 p, uint seed)
+{
+    p += vec2(float(seed & 1023u), float((seed >> 10) & 1023u)) * 0.37;
+    vec2 i = floor(p);
+    vec2 f = fract(p);
+    f = f * f * (3.0 - 2.0 * f);
+    return mix(mix(Hash12(i), Hash12(i + vec2(1.0, 0.0)), f.x), mix(Hash12(i + vec2(0.0, 1.0)), Hash12(i + vec2(1.0, 1.0)), f.x), f.y);
+}
+
+#ifdef IMPOSTOR_BAKE
+vec2 octEncode(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n.xy;
+}
+#endif
+
 void main()
 {
+#ifdef VISIBILITY_RESOLVE
+    resolveVisibility();
+#endif
+#if !defined(OIT_ACCUM) && !defined(PROBE_CAPTURE) && !defined(VISIBILITY_RESOLVE)
+    if (impostorFade.y > 0.0 && ImpostorDither() < clamp((length(viewPos - FragPos) - impostorFade.x) / (impostorFade.y - impostorFade.x), 0.0, 1.0))
+        discard;
+#endif
     vec3 N = normalize(Normal);
     vec3 V = normalize(viewPos - FragPos);
+#if !defined(PROBE_CAPTURE) || defined(VT_FEEDBACK)
+    // the livery's level comes from the UV derivatives, taken before any branch
+#ifdef VISIBILITY_RESOLVE
+    vec2 liveryDx = TexCoordsDx, liveryDy = TexCoordsDy;
+#else
+    vec2 liveryDx = dFdx(TexCoords), liveryDy = dFdy(TexCoords);
+#endif
+#endif
+
+    // material inputs: from the table entry of this vertex's material, or from the per-mesh uniforms
+    vec4 factor = baseColorFactor;
+    float metallic = metallicFactor;
+    float roughness = roughnessFactor;
+    float cutoff = alphaCutoff;
+    bool blended = alphaBlend;
+    float clearcoat = clearcoatFactor;
+    float clearcoatRoughness = clearcoatRoughnessFactor;
+    float transmission = transmissionFactor;
+    vec3 specularColor = specularColorFactor;
+    float occlusionAmount = occlusionStrength;
+    bvec3 sampled = bvec3(hasBaseColor, hasNormalMap, hasMetallicRoughness); // diffuse / normal / metallicRoughness
+    bvec3 transformed = bvec3(true);
+    ivec3 layer = ivec3(0);
+    vec4 uvMatrix[3] = vec4[3](texture_diffuse1_uv, texture_normal1_uv, texture_metallicRoughness1_uv);
+    vec2 uvOffset[3] = vec2[3](texture_diffuse1_offset, texture_normal1_offset, texture_metallicRoughness1_offset);
+    int tag = materialTag;
+    if (useMaterialTable)
+    {
+        MaterialData mat = materials[MaterialIndex];
+        factor = mat.baseColorFactor;
+        metallic = mat.factors.x;
+        roughness = mat.factors.y;
+        cutoff = mat.factors.z;
+        blended = mat.factors.w != 0.0;
+        clearcoat = mat.uvOffsetsMR.z;
+        clearcoatRoughness = mat.uvOffsetsMR.w;
+        transmission = mat.specularTransmission.w;
+        specularColor = mat.specularTransmission.xyz;
+        occlusionAmount = float((mat.layers.w >> OCCLUSION_SHIFT) & 255) / 255.0;
+        layer = mat.layers.xyz;
+        sampled = greaterThanEqual(layer, ivec3(0));
+        transformed = notEqual(ivec3(mat.layers.w) & ivec3(UV_DIFFUSE, UV_NORMAL, UV_METALLIC_ROUGHNESS), ivec3(0));
+        uvMatrix = vec4[3](mat.diffuseUV, mat.normalUV, mat.metallicRoughnessUV);
+        uvOffset = vec2[3](mat.uvOffsets.xy, mat.uvOffsets.zw, mat.uvOffsetsMR.xy);
+        tag = (mat.layers.w >> TAG_SHIFT) & 7;
+    }
+    if (tag > 0)
+    {
+        MaterialOverride o = overrides[tag - 1];
+        if ((o.mask.x & OVERRIDE_BASE_COLOR) != 0)
+            factor.rgb = o.baseColor.rgb;
+        if ((o.mask.x & OVERRIDE_METALLIC) != 0)
+            metallic = o.factors.x;
+        if ((o.mask.x & OVERRIDE_ROUGHNESS) != 0)
+            roughness = o.factors.y;
+        if ((o.mask.x & OVERRIDE_CLEARCOAT) != 0)
+        {
+            clearcoat = o.factors.z;
+            clearcoatRoughness = o.factors.w;
+        }
+    }
+    // the instance's own paint, so a fleet of differently coloured copies is still one draw per bucket
+    if (InstanceVariation.y != 0u && tag == int(InstanceVariation.y))
+        factor.rgb = vec3(uvec3(InstanceVariation.x, InstanceVariation.x >> 8, InstanceVariation.x >> 16) & 255u) / 255.0;
+#ifdef MATERIAL_VARIANT
+    // variant compiled for one feature set (Shader::useVariant): constant conditions remove the unused
+    // lookups and transforms. Slots without a transform hold the identity, so HAS_UV_TRANSFORM applies all.
+    sampled = bvec3(HAS_BASE_COLOR != 0, HAS_NORMAL_MAP != 0, HAS_MR != 0);
+    transformed = bvec3(HAS_UV_TRANSFORM != 0);
+#endif
 
     // base color
-    vec2 baseUV = TexCoords;
-    if (hasBaseColor)
-        baseUV = applyUV(TexCoords, texture_diffuse1_uv, texture_diffuse1_rot);
     vec4 baseSample = vec4(1.0);
-    if (hasBaseColor)
-        baseSample = texture(texture_diffuse1, baseUV);
-    vec3 baseColor = baseSample.rgb * baseColorFactor.rgb;
-    float alpha = baseSample.a * baseColorFactor.a;
+    if (sampled.x)
+    {
+        vec2 uv = transformed.x ? applyUV(TexCoords, uvMatrix[0], uvOffset[0]) : TexCoords;
+        vec4 m = transformed.x ? uvMatrix[0] : vec4(1.0, 0.0, 0.0, 1.0);
+        baseSample = useTextureArrays ? sampleMaterial(diffuseArray, vec3(uv, float(layer.x)), m) : sampleMaterial(texture_diffuse1, uv, m);
+    }
 
     // normal map
-    if (hasNormalMap)
+    if (sampled.y)
     {
-        vec2 nUV = applyUV(TexCoords, texture_normal1_uv, texture_normal1_rot);
-        N = getNormalFromMap(N, Tangent, Bitangent, texture_normal1, nUV);
+        vec2 uv = transformed.y ? applyUV(TexCoords, uvMatrix[1], uvOffset[1]) : TexCoords;
+        vec4 m = transformed.y ? uvMatrix[1] : vec4(1.0, 0.0, 0.0, 1.0);
+        vec2 texel = useTextureArrays ? sampleMaterial(normalArray, vec3(uv, float(layer.y)), m).xy : sampleMaterial(texture_normal1, uv, m).xy;
+        N = perturbNormal(N, Tangent, texel);
     }
 
-    // metallic/roughness
-    float metallic = metallicFactor;
-    float roughness = roughnessFactor;
-    if (hasMetallicRoughness)
+    // metallic/roughness; glTF convention: R = occlusion or unspecified, G = roughness, B = metallic. When
+    // the material's occlusionTexture is this texture (ORM) its R comes with the same fetch.
+    float occlusion = 1.0;
+    if (sampled.z)
     {
-        vec2 mrUV = applyUV(TexCoords, texture_metallicRoughness1_uv, texture_metallicRoughness1_rot);
-        vec4 mrSample = texture(texture_metallicRoughness1, mrUV);
-        // glTF convention: R = occlusion or unspecified, G = roughness, B = metallic
+        vec2 uv = transformed.z ? applyUV(TexCoords, uvMatrix[2], uvOffset[2]) : TexCoords;
+        vec4 m = transformed.z ? uvMatrix[2] : vec4(1.0, 0.0, 0.0, 1.0);
+        vec4 mrSample = useTextureArrays ? sampleMaterial(metallicRoughnessArray, vec3(uv, float(layer.z)), m) : sampleMaterial(texture_metallicRoughness1, uv, m);
         roughness *= mrSample.g;
         metallic *= mrSample.b;
+        occlusion = 1.0 + occlusionAmount * (mrSample.r - 1.0);
+    }
+    vec3 baseColor = baseSample.rgb * factor.rgb;
+    float alpha = baseSample.a * factor.a;
+#ifndef PROBE_CAPTURE
+    // LIVERY: the livery over the paint, by its alpha
+    if (virtualLivery && tag == 1)
+    {
+        vec4 livery = sampleLivery(TexCoords, liveryDx, liveryDy);
+        baseColor = mix(baseColor, livery.rgb, livery.a);
+    }
+#endif
+    if (hasPaintDecals && tag == 1)
+    {
+        vec4 decal = sampleMaterial(paintDecals, TexCoords, vec4(1.0, 0.0, 0.0, 1.0));
+        baseColor = baseColor * (1.0 - decal.a) + decal.rgb;
+    }
+    // the instance's dirt: a dull film over a share of the surface growing with the amount, blotchy and
+    // heavier away from the upward faces
+    float dirt = float(InstanceVariation.x >> 24) / 255.0;
+    if (dirt > 0.0)
+    {
+        float grime = InstanceNoise(TexCoords * 8.0, InstanceVariation.z) * (1.0 - 0.5 * max(normalize(Normal).y, 0.0));
+        float film = smoothstep(1.0 - dirt, 1.25 - dirt, grime);
+        baseColor = mix(baseColor, vec3(0.16, 0.13, 0.1), film);
+        roughness = mix(roughness, 0.9, film);
+        metallic *= 1.0 - film;
+        clearcoat *= 1.0 - film;
     }
+    // MASK: alpha tested, then opaque; OPAQUE ignores alpha. Among the variants only ALPHA_MASK ones test.
+#ifdef MATERIAL_VARIANT
+    if (ALPHA_MASK != 0 && alpha < cutoff)
+        discard;
+#else
+    if (alpha < cutoff)
+        discard;
+#endif
+    if (!blended)
+        alpha = 1.0;
+
+#ifdef VT_FEEDBACK
+    // VirtualTexture's feedback: the livery page (x, y) and level the paint samples here, alpha marking a
+    // request; other surfaces only hide what is behind them
+    if (tag != 1)
+    {
+        FragColor = vec4(0.0);
+        return;
+    }
+    float liveryLod = liveryLevel(liveryDx, liveryDy);
+    FragColor = vec4(floor(liveryTexel(TexCoords, liveryLod) / LIVERY_PAGE), liveryLod, 255.0) / 255.0;
+    return;
+#endif
+
+#ifdef IMPOSTOR_BAKE
+    // the unlit surface: albedo with its occlusion baked in (glass darkened by its opacity rather than
+    // blended, so the impostor needs no sorting), the octahedral normal, the depth of the orthographic
+    // capture (linear across the model's bounding sphere) and where the paint is, for instance colours
+    FragColor = vec4(baseColor * occlusion * VertexOcclusion * (blended ? alpha : 1.0), 1.0);
+    NormalDepth = vec4(octEncode(N) * 0.5 + 0.5, gl_FragCoord.z, tag == 1 ? 1.0 : 0.0);
+    return;
+#endif
+
+#if !defined(OIT_ACCUM) && !defined(PROBE_CAPTURE) && !defined(VISIBILITY_RESOLVE)
+    // VRS: a skipped quad keeps its exact depth, motion and pick ID; its colour comes from the shaded
+    // neighbours afterwards, so the lighting below is never evaluated here
+    if (coarseShading && !blended && SkippedQuad())
+    {
+        Velocity = (CurrentClip.xy / CurrentClip.w - PreviousClip.xy / PreviousClip.w) * 0.5;
+        ObjectId = PickId;
+        FragColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+#endif
 
     roughness = clamp(roughness, 0.05, 1.0);
     metallic = clamp(metallic, 0.0, 1.0);
 
-    // reflectance at normal incidence for dielectrics is 0.04; for metals use baseColor
-    vec3 F0 = vec3(0.04);
+    // reflectance at normal incidence for dielectrics is 0.04 (KHR_materials_specular scales and tints it);
+    // for metals use baseColor
+    vec3 F0 = min(vec3(0.04) * specularColor, vec3(1.0));
     F0 = mix(F0, baseColor, metallic);
+    // transmission takes its share of the diffuse lobe away from the lights; only the TRANSMISSION variant
+    // (or, without variants, transmissive materials) pay for the scene behind
+#ifdef MATERIAL_VARIANT
+    bool transmissive = TRANSMISSION != 0;
+#else
+    bool transmissive = transmission > 0.0;
+#endif
+    transmission = transmissive ? clamp(transmission, 0.0, 1.0) : 0.0;
+    vec3 diffuseColor = baseColor * (1.0 - transmission);
 
-    // direct lighting: sample a single directional light for simple direct specular
-    vec3 L = normalize(vec3(-0.2, -1.0, -0.3));
+    // direct lighting: the sun (directional), then the clustered local lights
+    vec3 L = normalize(sunDirection);
     vec3 H = normalize(V + L);
-
-    float NDF = DistributionGGX(N, H, roughness);
-    float G = GeometrySmith(N, V, L, roughness);
+    // the light's Fresnel term also weights the IBL below
     vec3 F = FresnelSchlick(max(dot(H, V), 0.0), F0);
-
     vec3 kS = F;
     vec3 kD = (1.0 - kS) * (1.0 - metallic);
-
-    float NdotL = max(dot(N, L), 0.0);
-    vec3 numerator = NDF * G * F;
-    float denom = 4.0 * max(dot(N, V), 0.0) * NdotL + 0.001;
-    vec3 specular = numerator / denom;
-    vec3 Lo = (kD * baseColor / 3.14159265 + specular) * NdotL;
+    vec3 Lo = DirectBRDF(N, V, L, diffuseColor, metallic, roughness, F0);
+#ifndef PROBE_CAPTURE
+    float sunShadow = SunShadow(normalize(Normal), L);
+    Lo *= sunShadow;
+    Lo += ClusterLights(N, V, diffuseColor, metallic, roughness, F0);
+#endif
 
     // IBL: diffuse irradiance + specular prefiltered
-    vec3 irradiance = texture(irradianceMap, N).rgb;
-    vec3 diffuseIBL = irradiance * baseColor;
+    vec3 irradiance = IrradianceSH(N);
+#ifndef PROBE_CAPTURE
+    if (volumeCount > 0)
+        irradiance = VolumeIrradiance(N, irradiance);
+#endif
+    vec3 diffuseIBL = irradiance * diffuseColor;
+    // the baked occlusion already has the car's own creases; the screen-space occlusion on top only adds
+    // what other objects hide, so the darker of the two wins instead of both darkening the same crease
+    float ambientOcclusion = VertexOcclusion;
+#ifndef PROBE_CAPTURE
+    // blended surfaces aren't in the depth the screen-space occlusion saw
+    if (!blended)
+        ambientOcclusion = min(ambientOcclusion, ScreenSpaceOcclusion());
+#endif
+    diffuseIBL *= ambientOcclusion;
     vec3 R = reflect(-V, N);
-    vec3 prefilteredColor = PrefilteredEnvRadiance(R, roughness);
+    float lookupRoughness = roughness;
+    if (iblSeed > 0.0)
+        R = StochasticLobe(R, roughness, lookupRoughness);
+#ifdef PROBE_CAPTURE
+    vec3 prefilteredColor = PrefilteredEnvRadiance(R, lookupRoughness);
+#else
+    vec3 prefilteredColor = SpecularRadiance(R, lookupRoughness);
+    // like the occlusion, the rays only know the opaque depth
+    if (!blended)
+        prefilteredColor = ScreenSpaceReflection(prefilteredColor, roughness);
+#endif
     vec2 brdf = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
-    vec3 specularIBL = prefilteredColor * (F * brdf.x + brdf.y);
+    vec3 specularIBL = prefilteredColor * (F * brdf.x + brdf.y) * SpecularOcclusion(max(dot(N, V), 0.0), VertexOcclusion, roughness);
 
-    vec3 ambient = (kD * diffuseIBL + specularIBL);
+    // occlusion only darkens the indirect light
+    vec3 ambient = (kD * diffuseIBL + specularIBL) * occlusion;
+    if (transmissive)
+    {
+        // thin-walled: the light behind passes straight through, blurred by the roughness and tinted by the
+        // base colour
+#ifdef PROBE_CAPTURE
+        vec3 behind = PrefilteredEnvRadiance(-V, roughness);
+#else
+        vec3 behind = transmissionCopy ? textureLod(transmissionMap, gl_FragCoord.xy * transmissionTexel, roughness * transmissionMaxMip).rgb
+                                       : SpecularRadiance(-V, roughness);
+#endif
+        ambient += kD * transmission * baseColor * behind;
+    }
 
     vec3 color = ambient + Lo;
 
-    // tone mapping / gamma
-    color = color / (color + vec3(1.0));
-    color = pow(color, vec3(1.0/2.2));
+    // clearcoat: a dielectric GGX lobe (F0 = 0.04) on the geometric normal over the base, which keeps what the
+    // coat's Fresnel lets through. Its reflection comes from the same prefiltered map and BRDF LUT as the base
+    // lobe, and only the CLEARCOAT variant (or, without variants, coated materials) evaluate it.
+#ifdef MATERIAL_VARIANT
+    bool coated = CLEARCOAT != 0;
+#else
+    bool coated = clearcoat > 0.0;
+#endif
+    if (coated)
+    {
+        vec3 Nc = normalize(Normal);
+        float NcdotV = max(dot(Nc, V), 0.0);
+        float coatRoughness = clamp(clearcoatRoughness, 0.05, 1.0);
+        vec3 Rc = reflect(-V, Nc);
+#ifdef PROBE_CAPTURE
+        vec3 coatRadiance = PrefilteredEnvRadiance(Rc, coatRoughness);
+        float coatShadow = 1.0;
+#else
+        vec3 coatRadiance = SpecularRadiance(Rc, coatRoughness);
+        if (!blended)
+            coatRadiance = ScreenSpaceReflection(coatRadiance, coatRoughness);
+        float coatShadow = sunShadow;
+#endif
+        vec2 coatBrdf = texture(brdfLUT, vec2(NcdotV, coatRoughness)).rg;
+        // metallic 1 and F0 0.04: DirectBRDF's specular term alone
+        vec3 coatSpecular = coatRadiance * (0.04 * coatBrdf.x + coatBrdf.y)
+                          + DirectBRDF(Nc, V, L, vec3(0.0), 1.0, coatRoughness, vec3(0.04)) * coatShadow;
+        float coatFresnel = clearcoat * FresnelSchlick(NcdotV, vec3(0.04)).x;
+        color = color * (1.0 - coatFresnel) + clearcoat * coatSpecular;
+    }
+
+#ifdef PROBE_CAPTURE
+    // probe capture: linear HDR, premultiplied (coverage in alpha)
+    if (alpha < 0.01)
+        discard;
+    FragColor = vec4(color * alpha, alpha);
+    return;
+#endif
 
+    // linear HDR into the scene target; ToneMapper::resolve applies exposure, the curve and gamma once per pixel
     if (alpha < 0.01)
         discard;
 
+#ifdef OIT_ACCUM
+    // depth weight (McGuire & Bavoil 2013): nearer surfaces dominate the average where layers overlap
+    float a = min(alpha, 0.999);
+    float w = clamp(a * max(1e-2, 3e3 * pow(1.0 - gl_FragCoord.z, 3.0)), 1e-2, 3e3);
+    FragColor = vec4(color * a, a) * w;
+    Revealage = -log(1.0 - a);
+    return;
+#endif
+
+#if !defined(OIT_ACCUM) && !defined(PROBE_CAPTURE)
+    Velocity = (CurrentClip.xy / CurrentClip.w - PreviousClip.xy / PreviousClip.w) * 0.5;
+#ifdef VISIBILITY_RESOLVE
+    // picking isn't available with the visibility buffer
+    ObjectId = 0u;
+#else
+    ObjectId = PickId;
+#endif
+#endif
     FragColor = vec4(color, alpha);
 }
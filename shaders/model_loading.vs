@@ -1,29 +1,144 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+// PackedVertex (see mesh.h): quantized position + tangent handedness and baked occlusion, octahedral
+// normal/tangent, half UVs
+layout (location = 0) in vec4 aPosition;
+layout (location = 1) in vec4 aNormalTangent;
 layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
+// MaterialTable index (only set up for models drawn through the material table)
+layout (location = 3) in uint aMaterial;
+// model-from-mesh transform of instanced meshes (identity for meshes baked into model space) and its
+// normal matrix, both computed on the CPU (Mesh::InstanceTransform)
+layout (location = 4) in mat4 aInstance;
+layout (location = 8) in mat3 aInstanceNormal;
+// the instance's look (Mesh::instanceVariation): paint RGB8 + dirt, the tag painted, a random seed
+layout (location = 15) in uvec3 aInstanceVariation;
+// GPU_PICKING=1 (GpuPicker): the vertex's mesh index in its model, and the placed model's index + 1 as a
+// constant per draw (0 = not pickable)
+layout (location = 11) in uint aPickMesh;
+layout (location = 12) in uint aPickObject;
+#ifdef MATERIAL_VARIANT
+#if SKINNED
+// skinned meshes (SkinVertex in mesh.h): four palette slots and their weights (summing to 1)
+layout (location = 13) in uvec4 aJoints;
+layout (location = 14) in vec4 aWeights;
+// per model, from the frame ring (NodeAnimation): world(joint) * inverseBind per palette slot; binding point 3
+layout (std140) uniform Bones
+{
+    mat4 bones[256];
+};
+#endif
+#endif
 
+#if defined(STEREO) || defined(DEBUG_VIEW)
+// model_stereo.gs passes these on to each eye under their usual names (debug_view.gs: the UVs)
+#define TexCoords vsTexCoords
+#define FragPos vsFragPos
+#define Normal vsNormal
+#define Tangent vsTangent
+#define VertexOcclusion vsVertexOcclusion
+#define MaterialIndex vsMaterialIndex
+#define CurrentClip vsCurrentClip
+#define PreviousClip vsPreviousClip
+#define PickId vsPickId
+#define InstanceVariation vsInstanceVariation
+#endif
 out vec2 TexCoords;
 out vec3 FragPos;
 out vec3 Normal;
-out vec3 Tangent;
-out vec3 Bitangent;
+// xyz: world tangent, w: handedness; the fragment stage rebuilds the bitangent as cross(Normal, Tangent.xyz) * w
+out vec4 Tangent;
+// ambient occlusion baked by car_cook, 1 = open (and for models imported at runtime)
+out float VertexOcclusion;
+flat out int MaterialIndex;
+// clip positions of the vertex this frame (without the TemporalAA jitter) and last frame, for the motion vectors
+out vec4 CurrentClip;
+out vec4 PreviousClip;
+// pick ID of the surface (GpuPicker::OBJECT_SHIFT), 0 where nothing pickable was drawn
+flat out uint PickId;
+flat out uvec3 InstanceVariation;
+
+// per draw, from the frame ring (Model::ObjectData); binding point 1
+layout (std140) uniform Object
+{
+    mat4 model;
+    // inverse-transpose of mat3(model)
+    mat3 normalMatrix;
+    // model-space AABB the positions were quantized against (xyz)
+    vec4 positionOffset;
+    vec4 positionScale;
+    // last frame's model matrix (Model::setPreviousModelMatrix)
+    mat4 previousModel;
+};
+// per view, from the frame ring (FrameData in frame_data.h); binding point 2. model_loading.fs declares
+// the whole block too
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;
+    vec3 sunDirection;
+    float iblSeed;
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// depth_prepass.vs computes the same positions; both are invariant so the pre-pass depths match exactly
+invariant gl_Position;
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
 
 void main()
 {
+    vec3 aPos = positionOffset.xyz + aPosition.xyz * positionScale.xyz;
+    vec3 aNormal = octDecode(aNormalTangent.xy);
+    vec3 aTangent = octDecode(aNormalTangent.zw);
+#ifdef MATERIAL_VARIANT
+#if SKINNED
+    // bind pose to model space through the blended joint matrices (rigid joints: the normals take the
+    // same matrix). Motion vectors only carry the model and camera motion, not last frame's pose
+    mat4 skin = aWeights.x * bones[aJoints.x] + aWeights.y * bones[aJoints.y]
+              + aWeights.z * bones[aJoints.z] + aWeights.w * bones[aJoints.w];
+    aPos = (skin * vec4(aPos, 1.0)).xyz;
+    aNormal = normalize(mat3(skin) * aNormal);
+    aTangent = normalize(mat3(skin) * aTangent);
+#endif
+#endif
+
     TexCoords = aTexCoords;
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    MaterialIndex = int(aMaterial);
+    PickId = aPickObject == 0u ? 0u : (aPickObject << 16) | (aPickMesh & 0xffffu);
+    InstanceVariation = aInstanceVariation;
+    mat4 world = model * aInstance;
+    vec4 worldPos = world * vec4(aPos, 1.0);
     FragPos = worldPos.xyz;
-    // transform normal/tangent/bitangent to world space using the normal matrix
-    mat3 normalMatrix = mat3(transpose(inverse(model)));
-    Normal = normalize(normalMatrix * aNormal);
-    Tangent = normalize(normalMatrix * aTangent);
-    Bitangent = normalize(normalMatrix * aBitangent);
+    // transform normal/tangent to world space; (model * instance)^-T = model^-T * instance^-T. A mirroring
+    // transform turns cross(N, T) around, so it flips the handedness too
+    mat3 worldNormal = normalMatrix * aInstanceNormal;
+    Normal = normalize(worldNormal * aNormal);
+    float packedW = floor(aPosition.w * 65535.0 + 0.5);
+    float bitangentSign = packedW >= 32768.0 ? 1.0 : -1.0;
+    VertexOcclusion = (packedW - (bitangentSign > 0.0 ? 32768.0 : 0.0)) / 32767.0;
+    float handedness = bitangentSign * (determinant(worldNormal) < 0.0 ? -1.0 : 1.0);
+    Tangent = vec4(normalize(worldNormal * aTangent), handedness);
+#ifdef STEREO
+    // world space; the geometry stage projects it once per eye
+    gl_Position = worldPos;
+#elif defined(UV_SPACE)
+    // DecalCompositor: the surface laid out in its texture, so texel uv of the target is where it samples uv
+    gl_Position = vec4(aTexCoords * 2.0 - 1.0, 0.0, 1.0);
+#else
     gl_Position = projection * view * worldPos;
+#endif
+    CurrentClip = unjitteredViewProjection * worldPos;
+    PreviousClip = previousViewProjection * (previousModel * aInstance * vec4(aPos, 1.0));
 }
@@ -0,0 +1,59 @@
+#version 330 core
+// Single-pass stereo (StereoRenderer, STEREO=1): model_loading.vs leaves the world position in gl_Position,
+// and every triangle is emitted twice here, once into each eye's layer of the layered target (gl_Layer =
+// eye) through that eye's view-projection. The varyings pass through unchanged; the fragment stage shades
+// both copies from the centre eye's FrameData.
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 6) out;
+
+in vec2 vsTexCoords[];
+in vec3 vsFragPos[];
+in vec3 vsNormal[];
+in vec4 vsTangent[];
+in float vsVertexOcclusion[];
+flat in int vsMaterialIndex[];
+in vec4 vsCurrentClip[];
+in vec4 vsPreviousClip[];
+flat in uint vsPickId[];
+flat in uvec3 vsInstanceVariation[];
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Tangent;
+out float VertexOcclusion;
+flat out int MaterialIndex;
+out vec4 CurrentClip;
+out vec4 PreviousClip;
+flat out uint PickId;
+flat out uvec3 InstanceVariation;
+
+// per frame, from the frame ring (StereoRenderer::EyeData); binding point 4
+layout (std140) uniform Stereo
+{
+    mat4 eyeViewProjection[2];
+};
+
+void main()
+{
+    for (int eye = 0; eye < 2; ++eye)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            TexCoords = vsTexCoords[i];
+            FragPos = vsFragPos[i];
+            Normal = vsNormal[i];
+            Tangent = vsTangent[i];
+            VertexOcclusion = vsVertexOcclusion[i];
+            MaterialIndex = vsMaterialIndex[i];
+            CurrentClip = vsCurrentClip[i];
+            PreviousClip = vsPreviousClip[i];
+            PickId = vsPickId[i];
+            InstanceVariation = vsInstanceVariation[i];
+            gl_Layer = eye;
+            gl_Position = eyeViewProjection[eye] * gl_in[i].gl_Position;
+            EmitVertex();
+        }
+        EndPrimitive();
+    }
+}
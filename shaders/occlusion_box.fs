@@ -0,0 +1,8 @@
+#version 330 core
+// colour writes are masked off while the boxes are drawn; only the samples passing the depth test count
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(1.0);
+}
@@ -0,0 +1,12 @@
+#version 330 core
+// bounding box of one draw for an occlusion query (OcclusionCuller, GL < 4.3); aPos is a unit cube corner
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 clipFromModel;
+uniform vec3 boxMin;
+uniform vec3 boxMax;
+
+void main()
+{
+    gl_Position = clipFromModel * vec4(mix(boxMin, boxMax, aPos), 1.0);
+}
@@ -0,0 +1,17 @@
+#version 330 core
+// composites the weighted blended transparency targets over the window (blended SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+out vec4 FragColor;
+
+uniform sampler2D accumulation; // sum of w * (premultiplied colour, alpha)
+uniform sampler2D revealage;    // sum of -log(1 - alpha)
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    float coverage = 1.0 - exp(-texelFetch(revealage, texel, 0).r);
+    if (coverage < 1.0 / 255.0)
+        discard;
+    vec4 accum = texelFetch(accumulation, texel, 0);
+    // weighted average colour; the weights cancel
+    FragColor = vec4(accum.rgb / max(accum.a, 1e-5), coverage);
+}
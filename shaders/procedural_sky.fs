@@ -0,0 +1,53 @@
+#version 330 core
+out vec4 FragColor;
+
+// unnormalized view direction: from cubemap_layered.gs when baking the faces, from skybox.vs when drawn
+// as the backdrop
+in vec3 WorldPos;
+
+// keep in sync with ProceduralSky::radiance (include/procedural_sky.h)
+uniform vec3 sunDirection;
+uniform float sunIntensity;
+uniform float sunPower;
+
+// the atmosphere (Atmosphere::apply): radiance per unit sun illuminance from its sky-view LUT, the sun
+// disk dimmed by the transmittance LUT
+uniform bool atmosphere;
+uniform sampler2D skyViewLut;
+uniform sampler2D transmittanceLut;
+uniform float illuminanceScale;
+uniform vec2 sunDiskCos;      // cosines of the disk's outer and inner edge
+uniform float sunDiskRadiance;
+
+const float PI = 3.14159265;
+// the viewer's height in the transmittance LUT (AtmosphereModel::VIEW_HEIGHT over the atmosphere's depth)
+const float VIEW_HEIGHT_V = 0.2 / 100.0;
+
+vec3 AtmosphereRadiance(vec3 dir)
+{
+    // the LUT's inverse mapping (atmosphere.fs, pass 2): azimuth away from the sun, squeezed elevation
+    float azimuth = atan(dir.z, dir.x) - atan(sunDirection.z, sunDirection.x);
+    azimuth = abs(mod(azimuth + PI, 2.0 * PI) - PI);
+    float elevation = asin(clamp(dir.y, -1.0, 1.0));
+    float v = sign(elevation) * sqrt(abs(elevation) / (0.5 * PI));
+    vec3 sky = texture(skyViewLut, vec2(azimuth / PI, v * 0.5 + 0.5)).rgb;
+    float disk = smoothstep(sunDiskCos.x, sunDiskCos.y, dot(dir, sunDirection));
+    vec3 sun = disk * sunDiskRadiance * texture(transmittanceLut, vec2(dir.y * 0.5 + 0.5, VIEW_HEIGHT_V)).rgb;
+    return (sky + sun) * sunIntensity * illuminanceScale;
+}
+
+void main()
+{
+    vec3 dir = normalize(WorldPos);
+    if (atmosphere)
+    {
+        FragColor = vec4(AtmosphereRadiance(dir), 1.0);
+        return;
+    }
+    // sky gradient
+    float t = clamp(dir.y * 0.5 + 0.5, 0.0, 1.0);
+    vec3 sky = mix(vec3(0.02), vec3(0.6, 0.7, 0.9), t);
+    // sun spot
+    float sun = pow(max(dot(dir, sunDirection), 0.0), sunPower) * sunIntensity;
+    FragColor = vec4(sky + vec3(sun), 1.0);
+}
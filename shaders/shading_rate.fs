@@ -0,0 +1,47 @@
+#version 330 core
+// the next frame's shading rate of one ShadingRate::TILE x TILE tile (ShadingRate::classify), from this
+// frame's linear image: 0 full, 0.5 half, 1 quarter rate. Tiles keep full rate near the centre of the view
+// and wherever the log luminance varies (edges, highlights on the paint); flat or peripheral tiles drop.
+layout (location = 0) out float Rate;
+
+const int TILE = 16; // ShadingRate::TILE
+
+uniform sampler2D sceneColor;
+uniform float fovea; // full-rate radius, as a fraction of the half diagonal
+
+void main()
+{
+    ivec2 tile = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(sceneColor, 0);
+    // 4x4 samples spread over the tile
+    float sum = 0.0;
+    float sumSquares = 0.0;
+    float lowest = 1e9;
+    float highest = -1e9;
+    for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x)
+        {
+            ivec2 pixel = min(tile * TILE + ivec2(x, y) * (TILE / 4) + TILE / 8, size - 1);
+            vec3 rgb = texelFetch(sceneColor, pixel, 0).rgb;
+            float l = log2(dot(rgb, vec3(0.2126, 0.7152, 0.0722)) + 1e-3);
+            sum += l;
+            sumSquares += l * l;
+            lowest = min(lowest, l);
+            highest = max(highest, l);
+        }
+    float mean = sum / 16.0;
+    float variance = max(sumSquares / 16.0 - mean * mean, 0.0);
+    // 0 at the centre of the view, 1 in its corners
+    vec2 centre = (vec2(tile * TILE) + 0.5 * float(TILE)) / vec2(size) * 2.0 - 1.0;
+    float eccentricity = length(centre * vec2(size)) / length(vec2(size));
+
+    int rate;
+    if (eccentricity <= fovea)
+        rate = variance < 0.01 && highest - lowest < 0.5 ? 1 : 0;
+    else
+        rate = variance < 0.05 ? 2 : 1;
+    // a tile spanning more than three stops holds an edge or a highlight, which a reconstruction would soften
+    if (highest - lowest > 3.0)
+        rate = 0;
+    Rate = float(rate) * 0.5;
+}
@@ -0,0 +1,74 @@
+#version 330 core
+// fills the quads the scene shader skipped under variable-rate shading (ShadingRate::reconstruct): each
+// skipped pixel takes the mean of the shaded pixels two away along the direction (horizontal, vertical or
+// one of the diagonals) whose pair differs least, so edges are continued rather than blurred across.
+// Shaded pixels are discarded and keep their colour.
+layout (location = 0) out vec4 FragColor;
+
+const int TILE = 16; // ShadingRate::TILE
+
+uniform sampler2D sceneCopy;      // the scene colour after the opaque pass
+uniform sampler2D shadingRateMap; // 0 full, 0.5 half, 1 quarter rate per tile
+uniform int shadingPhase;
+
+// model_loading.fs's SkippedQuad() for any pixel
+bool Skipped(ivec2 pixel)
+{
+    int rate = int(texelFetch(shadingRateMap, pixel / TILE, 0).r * 2.0 + 0.5);
+    ivec2 quad = pixel >> 1;
+    if (rate == 1)
+        return ((quad.x + quad.y + shadingPhase) & 1) != 0;
+    if (rate == 2)
+        return ((quad.x + shadingPhase) & 1) != 0 || ((quad.y + (shadingPhase >> 1)) & 1) != 0;
+    return false;
+}
+
+bool Shaded(ivec2 pixel, ivec2 size)
+{
+    return all(greaterThanEqual(pixel, ivec2(0))) && all(lessThan(pixel, size)) && !Skipped(pixel);
+}
+
+float logLuminance(vec3 rgb)
+{
+    return log2(dot(rgb, vec3(0.2126, 0.7152, 0.0722)) + 1e-3);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    if (!Skipped(pixel))
+        discard;
+    ivec2 size = textureSize(sceneCopy, 0);
+    const ivec2 axes[4] = ivec2[4](ivec2(2, 0), ivec2(0, 2), ivec2(2, 2), ivec2(2, -2));
+    vec4 best = vec4(0.0);
+    float bestDifference = 1e9;
+    vec4 single = vec4(0.0);
+    float singles = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        ivec2 a = pixel + axes[i];
+        ivec2 b = pixel - axes[i];
+        bool hasA = Shaded(a, size);
+        bool hasB = Shaded(b, size);
+        vec4 colorA = hasA ? texelFetch(sceneCopy, a, 0) : vec4(0.0);
+        vec4 colorB = hasB ? texelFetch(sceneCopy, b, 0) : vec4(0.0);
+        if (hasA && hasB)
+        {
+            float difference = abs(logLuminance(colorA.rgb) - logLuminance(colorB.rgb));
+            if (difference < bestDifference)
+            {
+                bestDifference = difference;
+                best = (colorA + colorB) * 0.5;
+            }
+        }
+        single += colorA + colorB;
+        singles += float(hasA) + float(hasB);
+    }
+    // at tile borders a pixel may have no complete pair, only lone shaded neighbours
+    if (bestDifference < 1e9)
+        FragColor = best;
+    else if (singles > 0.0)
+        FragColor = single / singles;
+    else
+        discard;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 WorldPos;
+
+uniform samplerCube environmentMap;
+// mip of the environment drawn (SKYBOX_BLUR, 0 = sharp)
+uniform float lod;
+
+void main()
+{
+    FragColor = vec4(textureLod(environmentMap, normalize(WorldPos), lod).rgb, 1.0);
+}
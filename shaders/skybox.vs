@@ -0,0 +1,16 @@
+#version 330 core
+// fullscreen triangle on the far plane (z = w), from the vertex index (Skybox::draw sends 3 vertices without
+// attributes); the depth test against the opaque scene leaves only the uncovered pixels to the fragment shader
+out vec3 WorldPos;
+
+// inverse of projection * the view's rotation
+uniform mat4 inverseViewProjection;
+
+void main()
+{
+    vec2 corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    vec4 clip = vec4(corner * 2.0 - 1.0, 1.0, 1.0);
+    // homogeneous, so it interpolates linearly; xyz alone points the same way as the far plane point (w > 0)
+    WorldPos = (inverseViewProjection * clip).xyz;
+    gl_Position = clip;
+}
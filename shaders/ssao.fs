@@ -0,0 +1,104 @@
+#version 330 core
+// half-resolution ground-truth ambient occlusion (AmbientOcclusion, SSAO=1): along two screen directions
+// per pixel the highest horizon on either side is found in the depth copy, and the arc of the slice above
+// both horizons is integrated cosine-weighted against the normal projected into the slice (Jimenez et al.
+// 2016, "Practical Real-Time Strategies for Accurate Indirect Occlusion"). The slice directions and step
+// offsets rotate over a 4x4 pixel tile that ssao_blur.fs averages back out.
+layout (location = 0) out vec2 Occlusion; // x: visible fraction of the hemisphere, y: view depth
+
+uniform sampler2D depthMap;         // half-size copy of the scene depth
+uniform mat4 inverseProjection;
+uniform float radius;               // reach of the occluders, world units
+uniform float radiusScale;          // half-size pixels per world unit at view depth 1
+
+const int SLICES = 2;
+const int STEPS = 4;
+// longest step run in half-size pixels: near the camera the radius would cover the screen
+const float MAX_PIXEL_RADIUS = 48.0;
+const float PI = 3.14159265;
+const float HALF_PI = 1.5707963;
+// 4x4 ordered dither: neighbouring pixels get directions far apart
+const float DITHER[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+
+ivec2 maxTexel;
+
+vec3 viewPosition(ivec2 texel)
+{
+    texel = clamp(texel, ivec2(0), maxTexel);
+    float depth = texelFetch(depthMap, texel, 0).r;
+    vec2 uv = (vec2(texel) + 0.5) / vec2(maxTexel + 1);
+    vec4 p = inverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return p.xyz / p.w;
+}
+
+// the visible part of the slice between angle `h` and the projected normal `n` (both from the view vector)
+float integrateArc(float h, float n)
+{
+    return 0.25 * (-cos(2.0 * h - n) + cos(n) + 2.0 * h * sin(n));
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    maxTexel = textureSize(depthMap, 0) - 1;
+    if (texelFetch(depthMap, texel, 0).r >= 1.0)
+    {
+        // sky: nothing to occlude
+        Occlusion = vec2(1.0, 1e6);
+        return;
+    }
+    vec3 P = viewPosition(texel);
+    // normal from the nearer neighbour on each axis, so depth edges don't bend it
+    vec3 left = P - viewPosition(texel - ivec2(1, 0));
+    vec3 right = viewPosition(texel + ivec2(1, 0)) - P;
+    vec3 down = P - viewPosition(texel - ivec2(0, 1));
+    vec3 up = viewPosition(texel + ivec2(0, 1)) - P;
+    vec3 N = normalize(cross(abs(left.z) < abs(right.z) ? left : right, abs(down.z) < abs(up.z) ? down : up));
+    vec3 V = normalize(-P);
+
+    float pixelRadius = radius * radiusScale / max(-P.z, 1e-3);
+    if (pixelRadius < 1.0)
+    {
+        Occlusion = vec2(1.0, -P.z);
+        return;
+    }
+    float stepSize = min(pixelRadius, MAX_PIXEL_RADIUS) / float(STEPS);
+    float dither = DITHER[(texel.y & 3) * 4 + (texel.x & 3)];
+    float rotation = (dither + 0.5) / 16.0;
+    float jitter = fract(dither * 0.3125 + 0.25);
+    // samples fade to the unoccluded horizon between 60% and 100% of the radius
+    float falloffRange = 0.4 * radius;
+
+    float visibility = 0.0;
+    for (int s = 0; s < SLICES; ++s)
+    {
+        float phi = (float(s) + rotation) * PI / float(SLICES);
+        vec2 direction = vec2(cos(phi), sin(phi));
+        vec3 sliceDirection = vec3(direction, 0.0);
+        vec3 ortho = sliceDirection - V * dot(sliceDirection, V);
+        vec3 axis = normalize(cross(sliceDirection, V));
+        vec3 projectedN = N - axis * dot(N, axis);
+        float projectedLength = length(projectedN);
+        float cosN = clamp(dot(projectedN, V) / max(projectedLength, 1e-4), -1.0, 1.0);
+        float n = (dot(projectedN, ortho) >= 0.0 ? 1.0 : -1.0) * acos(cosN);
+        // horizons start at the normal's own hemisphere: beneath it nothing counts
+        float lowCos0 = cos(n - HALF_PI);
+        float lowCos1 = cos(n + HALF_PI);
+        float cos0 = lowCos0;
+        float cos1 = lowCos1;
+        for (int k = 0; k < STEPS; ++k)
+        {
+            ivec2 offset = ivec2(round(direction * ((float(k) + jitter) * stepSize + 1.0)));
+            vec3 d1 = viewPosition(texel + offset) - P;
+            vec3 d0 = viewPosition(texel - offset) - P;
+            float l1 = length(d1);
+            float l0 = length(d0);
+            cos1 = max(cos1, mix(lowCos1, dot(d1, V) / max(l1, 1e-4), clamp((radius - l1) / falloffRange, 0.0, 1.0)));
+            cos0 = max(cos0, mix(lowCos0, dot(d0, V) / max(l0, 1e-4), clamp((radius - l0) / falloffRange, 0.0, 1.0)));
+        }
+        float h0 = n + max(-acos(cos0) - n, -HALF_PI);
+        float h1 = n + min(acos(cos1) - n, HALF_PI);
+        visibility += projectedLength * (integrateArc(h0, n) + integrateArc(h1, n));
+    }
+    Occlusion = vec2(clamp(visibility / float(SLICES), 0.0, 1.0), -P.z);
+}
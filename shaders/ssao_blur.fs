@@ -0,0 +1,25 @@
+#version 330 core
+// averages ssao.fs's 4x4 rotation tile out of the occlusion (AmbientOcclusion), leaving out samples whose
+// depth differs from the pixel's by more than a few percent
+layout (location = 0) out vec2 Occlusion;
+
+uniform sampler2D rawOcclusion; // x: visibility, y: view depth
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(rawOcclusion, 0) - 1;
+    vec2 centre = texelFetch(rawOcclusion, texel, 0).rg;
+    float sum = 0.0;
+    float weightSum = 0.0;
+    for (int y = -1; y <= 2; ++y)
+        for (int x = -1; x <= 2; ++x)
+        {
+            vec2 s = texelFetch(rawOcclusion, clamp(texel + ivec2(x, y), ivec2(0), maxTexel), 0).rg;
+            float w = clamp(1.0 - abs(s.y - centre.y) / (0.05 * centre.y), 0.0, 1.0);
+            sum += s.x * w;
+            weightSum += w;
+        }
+    // the centre always weighs 1
+    Occlusion = vec2(sum / weightSum, centre.y);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+// nearest-depth pyramid for the screen-space reflections (ScreenSpaceReflections, SSR=1): level 0 copies
+// the half-size depth, each further level keeps the nearest of the texels it covers, three wide where the
+// level above has an odd size so no texel is left out
+layout (location = 0) out float Depth;
+
+uniform sampler2D source;   // the depth copy, or the level above (the only one in reach)
+uniform bool reduce;
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    if (!reduce)
+    {
+        Depth = texelFetch(source, texel, 0).r;
+        return;
+    }
+    ivec2 maxTexel = textureSize(source, 0) - 1;
+    ivec2 base = texel * 2;
+    ivec2 extent = ivec2(1) + ivec2(equal(base + 2, maxTexel));
+    float nearest = 1.0;
+    for (int y = 0; y <= extent.y; ++y)
+        for (int x = 0; x <= extent.x; ++x)
+            nearest = min(nearest, texelFetch(source, min(base + ivec2(x, y), maxTexel), 0).r);
+    Depth = nearest;
+}
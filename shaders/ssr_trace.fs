@@ -0,0 +1,135 @@
+#version 330 core
+// half-resolution screen-space reflections (ScreenSpaceReflections, SSR=1): each pixel's mirror ray, with
+// the normal taken from the depth, is walked through the nearest-depth pyramid (hierarchical-Z tracing,
+// Uludag 2014, "Hi-Z Screen-Space Cone-Traced Reflections"). While the ray is in front of everything in a
+// cell it crosses to the next cell and goes up a level; where it reaches a cell's nearest depth it goes
+// down a level, and at level 0 that is the hit. The hit is reprojected into the previous frame, whose
+// colour the scene shader reads there.
+layout (location = 0) out vec4 Hit; // xy: last frame's UV of the hit, z: confidence (0 = none), w: ray length
+
+uniform sampler2D hiZ;              // nearest depth per cell; level 0 is the half-size depth copy
+uniform int hiZLevels;
+uniform mat4 projection;
+uniform mat4 inverseProjection;
+uniform mat4 inverseView;
+uniform mat4 previousViewProjection; // last frame's, unjittered
+uniform float nearPlane;
+uniform float maxDistance;          // longest ray, world units
+uniform float thickness;            // how far behind the depth a ray still hits it, world units
+
+const int MAX_ITERATIONS = 48;
+
+ivec2 maxTexel;
+
+vec3 viewPosition(vec2 uv, float depth)
+{
+    vec4 p = inverseProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return p.xyz / p.w;
+}
+
+vec3 viewPosition(ivec2 texel)
+{
+    texel = clamp(texel, ivec2(0), maxTexel);
+    return viewPosition((vec2(texel) + 0.5) / vec2(maxTexel + 1), texelFetch(hiZ, texel, 0).r);
+}
+
+// view space to (UV, depth), the space in which the ray and the depth buffer are both linear
+vec3 screenPosition(vec3 p)
+{
+    vec4 clip = projection * vec4(p, 1.0);
+    return clip.xyz / clip.w * 0.5 + 0.5;
+}
+
+// distance along -z in view space of a depth buffer value
+float linearDepth(float depth)
+{
+    return -viewPosition(vec2(0.5), depth).z;
+}
+
+// the ray start + dir * t, t in [0, 1], through the pyramid; the t of the hit, or -1
+float traceRay(vec3 start, vec3 dir)
+{
+    vec2 crossing = vec2(greaterThanEqual(dir.xy, vec2(0.0)));
+    // a hundredth of a cell past the boundary, so the next step lands in the next cell
+    vec2 crossingOffset = (crossing * 2.0 - 1.0) * 0.01;
+    vec2 inverseDir = 1.0 / vec2(abs(dir.x) > 1e-6 ? dir.x : 1e-6, abs(dir.y) > 1e-6 ? dir.y : 1e-6);
+    // a surface plane is only ahead of rays going away from the camera
+    float inverseDepth = dir.z > 0.0 ? 1.0 / dir.z : 0.0;
+    int level = 0;
+    float t = 0.0;
+    for (int i = 0; i < MAX_ITERATIONS; ++i)
+    {
+        vec3 p = start + dir * t;
+        if (t > 1.0 || any(lessThan(p.xy, vec2(0.0))) || any(greaterThan(p.xy, vec2(1.0))))
+            return -1.0;
+        vec2 cells = vec2(textureSize(hiZ, level));
+        vec2 cell = floor(p.xy * cells);
+        float nearest = texelFetch(hiZ, ivec2(cell), level).r;
+        if (p.z < nearest)
+        {
+            // in front of the whole cell: on to its nearest depth if that comes before the cell's edge
+            vec2 edges = ((cell + crossing + crossingOffset) / cells - start.xy) * inverseDir;
+            float tCell = min(edges.x, edges.y);
+            float tSurface = inverseDepth > 0.0 ? (nearest - start.z) * inverseDepth : 2.0;
+            if (tSurface < tCell)
+            {
+                t = tSurface;
+                level = max(level - 1, 0);
+            }
+            else
+            {
+                t = tCell;
+                level = min(level + 1, hiZLevels - 1);
+            }
+        }
+        else if (level > 0)
+            --level;
+        else
+            return linearDepth(p.z) - linearDepth(nearest) < thickness ? t : -1.0;
+    }
+    return -1.0;
+}
+
+void main()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    maxTexel = textureSize(hiZ, 0) - 1;
+    Hit = vec4(0.0);
+    if (texelFetch(hiZ, texel, 0).r >= 1.0)
+        return;
+    vec3 P = viewPosition(texel);
+    // normal from the nearer neighbour on each axis, so depth edges don't bend it
+    vec3 left = P - viewPosition(texel - ivec2(1, 0));
+    vec3 right = viewPosition(texel + ivec2(1, 0)) - P;
+    vec3 down = P - viewPosition(texel - ivec2(0, 1));
+    vec3 up = viewPosition(texel + ivec2(0, 1)) - P;
+    vec3 N = normalize(cross(abs(left.z) < abs(right.z) ? left : right, abs(down.z) < abs(up.z) ? down : up));
+    vec3 V = normalize(-P);
+    vec3 R = reflect(-V, N);
+    // rays back towards the camera would hit the backs of things, which the depth doesn't have
+    float confidence = 1.0 - smoothstep(0.25, 0.75, R.z);
+    if (confidence <= 0.0)
+        return;
+
+    // off the surface by a hundredth of its depth, so the ray doesn't hit its own pixel; clipped to the
+    // near plane
+    vec3 origin = P + N * (0.01 * -P.z);
+    float rayLength = maxDistance;
+    if (origin.z + R.z * rayLength > -nearPlane)
+        rayLength = (-nearPlane - origin.z) / R.z;
+    vec3 start = screenPosition(origin);
+    vec3 end = screenPosition(origin + R * rayLength);
+    float t = traceRay(start, end - start);
+    if (t < 0.0)
+        return;
+    vec3 hit = mix(start, end, t);
+    vec3 hitView = viewPosition(hit.xy, hit.z);
+    vec4 previous = previousViewProjection * (inverseView * vec4(hitView, 1.0));
+    if (previous.w <= 0.0)
+        return;
+    vec2 previousUV = previous.xy / previous.w * 0.5 + 0.5;
+    // fade towards the ray's end and towards the edges of both screens, where the hit runs out of image
+    vec2 edges = min(min(hit.xy, 1.0 - hit.xy), min(previousUV, 1.0 - previousUV));
+    confidence *= (1.0 - smoothstep(0.75, 1.0, t)) * smoothstep(0.0, 0.1, min(edges.x, edges.y));
+    Hit = vec4(previousUV, confidence, length(hitView - P));
+}
@@ -0,0 +1,22 @@
+#version 330 core
+// running mean of the jittered HDR frames while the view holds still (StillAccumulator::accumulate)
+out vec4 FragColor;
+
+uniform sampler2D currentColor;
+uniform sampler2D historyColor;
+uniform float currentWeight; // 1 / sample count; 1 for the first sample drops the history
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    // a plain linear mean (no Karis weighting as in taa_resolve.fs): converged, it's the supersampled image
+    vec3 current = texelFetch(currentColor, pixel, 0).rgb;
+    if (currentWeight >= 1.0)
+    {
+        // not mix(): the history is uninitialised then and may hold NaNs, which survive a zero weight
+        FragColor = vec4(current, 1.0);
+        return;
+    }
+    vec3 mean = texelFetch(historyColor, pixel, 0).rgb;
+    FragColor = vec4(mix(mean, current, currentWeight), 1.0);
+}
@@ -0,0 +1,65 @@
+#version 330 core
+// temporal accumulation of the jittered HDR scene (TemporalAA::resolve)
+out vec4 FragColor;
+
+uniform sampler2D currentColor;
+uniform sampler2D historyColor;
+uniform sampler2D velocityMap;
+uniform float historyWeight; // 0 drops the history (first frame, camera cut)
+
+// blend on tonemap-weighted colour (Karis) so a single bright sample can't dominate the average
+vec3 weigh(vec3 c) { return c / (1.0 + max(c.r, max(c.g, c.b))); }
+vec3 unweigh(vec3 c) { return c / max(1.0 - max(c.r, max(c.g, c.b)), 1e-4); }
+
+vec3 toYCoCg(vec3 c)
+{
+    return vec3(0.25 * c.r + 0.5 * c.g + 0.25 * c.b, 0.5 * c.r - 0.5 * c.b, -0.25 * c.r + 0.5 * c.g - 0.25 * c.b);
+}
+
+vec3 fromYCoCg(vec3 c)
+{
+    return vec3(c.x + c.y - c.z, c.x + c.z, c.x - c.y - c.z);
+}
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(currentColor, 0);
+    vec3 center = vec3(0.0);
+    vec3 mean = vec3(0.0);
+    vec3 meanSquares = vec3(0.0);
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            ivec2 p = clamp(pixel + ivec2(x, y), ivec2(0), size - 1);
+            vec3 c = toYCoCg(weigh(texelFetch(currentColor, p, 0).rgb));
+            if (x == 0 && y == 0)
+                center = c;
+            mean += c;
+            meanSquares += c * c;
+        }
+    }
+    mean /= 9.0;
+    vec3 sigma = sqrt(max(meanSquares / 9.0 - mean * mean, vec3(0.0)));
+    vec3 boxMin = mean - sigma;
+    vec3 boxMax = mean + sigma;
+
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(size);
+    vec2 previousUv = uv - texelFetch(velocityMap, pixel, 0).xy;
+    float weight = historyWeight;
+    if (any(lessThan(previousUv, vec2(0.0))) || any(greaterThan(previousUv, vec2(1.0))))
+        weight = 0.0;
+
+    vec3 history = toYCoCg(weigh(texture(historyColor, previousUv).rgb));
+    // clip towards the box centre rather than clamping per channel, which shifts the hue
+    vec3 offset = history - mean;
+    vec3 extent = max(boxMax - mean, vec3(1e-4));
+    vec3 ratio = abs(offset / extent);
+    float maxRatio = max(ratio.x, max(ratio.y, ratio.z));
+    if (maxRatio > 1.0)
+        history = mean + offset / maxRatio;
+
+    vec3 result = mix(center, history, weight);
+    FragColor = vec4(unweigh(fromYCoCg(result)), 1.0);
+}
@@ -0,0 +1,64 @@
+#version 330 core
+// tone maps the linear HDR scene into the window, once per pixel (ToneMapper::resolve)
+out vec4 FragColor;
+
+uniform sampler2D hdrColor;
+uniform sampler2D bloomColor; // half resolution (Bloom::build)
+uniform float bloomStrength; // 0 = no bloom bound
+uniform bool autoExposure;
+uniform sampler2D exposureMap; // one texel, AutoExposure's measurement (0 until the first one)
+uniform float exposure;
+uniform int curve; // ToneMapper::Curve: 0 = Reinhard, 1 = ACES, 2 = AgX
+uniform vec2 outputOrigin; // lower left of the output rectangle (ToneMapper::present), else 0
+uniform vec2 outputSize; // window pixels; the scene may be rendered smaller (DynamicResolution)
+
+// Narkowicz's fit of the ACES filmic reference curve
+vec3 ACESFilm(vec3 x)
+{
+    return clamp((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14), 0.0, 1.0);
+}
+
+// AgX base look (Troy Sobotka), with the polynomial fit of its sigmoid by Benjamin Wrensch; the result
+// is already display encoded
+vec3 AgXContrast(vec3 x)
+{
+    vec3 x2 = x * x;
+    vec3 x4 = x2 * x2;
+    return 15.5 * x4 * x2 - 40.14 * x4 * x + 31.96 * x4 - 6.868 * x2 * x + 0.4298 * x2 + 0.1191 * x - 0.00232;
+}
+
+vec3 AgX(vec3 color)
+{
+    const mat3 inset = mat3(0.842479062253094, 0.0423282422610123, 0.0423756549057051,
+                            0.0784335999999992, 0.878468636469772, 0.0784336,
+                            0.0792237451477643, 0.0791661274605434, 0.879142973793104);
+    const mat3 outset = mat3(1.19687900512017, -0.0528968517574562, -0.0529716355144438,
+                             -0.0980208811401368, 1.15190312990417, -0.0980434501171241,
+                             -0.0990297440797205, -0.0989611768448433, 1.15107367264116);
+    const float minEv = -12.47393;
+    const float maxEv = 4.026069;
+    color = inset * max(color, vec3(1e-10));
+    color = (clamp(log2(color), minEv, maxEv) - minEv) / (maxEv - minEv);
+    return clamp(outset * AgXContrast(color), 0.0, 1.0);
+}
+
+void main()
+{
+    // bilinear upscale; at equal sizes this lands on texel centres and reads them unfiltered
+    vec2 uv = (gl_FragCoord.xy - outputOrigin) / outputSize;
+    vec3 color = texture(hdrColor, uv).rgb;
+    if (bloomStrength > 0.0)
+        color += texture(bloomColor, uv).rgb * bloomStrength;
+    float measured = autoExposure ? texelFetch(exposureMap, ivec2(0), 0).r : 0.0;
+    color *= exposure * (measured > 0.0 ? measured : 1.0);
+    if (curve == 2)
+    {
+        color = AgX(color);
+    }
+    else
+    {
+        color = curve == 1 ? ACESFilm(color) : color / (color + vec3(1.0));
+        color = pow(color, vec3(1.0 / 2.2));
+    }
+    FragColor = vec4(color, 1.0);
+}
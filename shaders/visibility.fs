@@ -0,0 +1,13 @@
+#version 330 core
+// the triangle covering the pixel: mesh index above VisibilityBuffer::PRIMITIVE_BITS, the primitive of the
+// mesh's draw (counted from 0 for every draw of a multi-draw) below
+const uint PRIMITIVE_BITS = 22u;
+
+layout (location = 0) out uint VisibilityId;
+
+flat in uint MeshIndex;
+
+void main()
+{
+    VisibilityId = (MeshIndex << PRIMITIVE_BITS) | uint(gl_PrimitiveID);
+}
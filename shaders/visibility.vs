@@ -0,0 +1,45 @@
+#version 330 core
+// visibility buffer ID pass (VISIBILITY_BUFFER=1): positions transformed exactly like model_loading.vs,
+// plus the index of the vertex's mesh in its model
+layout (location = 0) in vec4 aPosition;
+layout (location = 3) in uint aMesh;
+layout (location = 4) in mat4 aInstance;
+
+flat out uint MeshIndex;
+
+// the same block model_loading.vs reads (Model::ObjectData)
+layout (std140) uniform Object
+{
+    mat4 model;
+    mat3 normalMatrix;
+    vec4 positionOffset;
+    vec4 positionScale;
+    mat4 previousModel;
+};
+// per view, as in model_loading.vs (FrameData)
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    float prefilterMaxMip;
+    vec3 sunDirection;
+    float iblSeed;
+    mat3 irradianceSH_r;
+    mat3 irradianceSH_g;
+    mat3 irradianceSH_b;
+    mat4 unjitteredViewProjection;
+    mat4 previousViewProjection;
+};
+
+// forward draws of the same frame test against these depths
+invariant gl_Position;
+
+void main()
+{
+    vec3 aPos = positionOffset.xyz + aPosition.xyz * positionScale.xyz;
+    mat4 world = model * aInstance;
+    vec4 worldPos = world * vec4(aPos, 1.0);
+    gl_Position = projection * view * worldPos;
+    MeshIndex = aMesh;
+}
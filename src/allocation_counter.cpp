@@ -0,0 +1,60 @@
+// Replaces the global operator new / delete with counting versions (allocation_counter.h). Linked into
+// main (BENCHMARK=1 reports heap allocations per frame) and car_bench (allocations per startup stage).
+// The size sits in a header in front of the block so delete can keep the live count.
+#include <allocation_counter.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    const size_t HEADER = 16; // keeps the user block aligned for anything operator new promises
+
+    void *countedAlloc(size_t size)
+    {
+        void *block = std::malloc(size + HEADER);
+        if (!block)
+            return nullptr;
+        *(size_t *)block = size;
+        AllocationCounter::allocations().fetch_add(1, std::memory_order_relaxed);
+        AllocationCounter::allocatedBytes().fetch_add(size, std::memory_order_relaxed);
+        ++AllocationCounter::threadAllocations();
+        const size_t live = AllocationCounter::liveBytes().fetch_add(size, std::memory_order_relaxed) + size;
+        std::atomic<size_t> &peakLive = AllocationCounter::peakLiveBytes();
+        size_t peak = peakLive.load(std::memory_order_relaxed);
+        while (live > peak && !peakLive.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        return (char *)block + HEADER;
+    }
+
+    void countedFree(void *p)
+    {
+        if (!p)
+            return;
+        void *block = (char *)p - HEADER;
+        AllocationCounter::liveBytes().fetch_sub(*(size_t *)block, std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void *operator new(size_t size)
+{
+    void *p = countedAlloc(size);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t size)
+{
+    void *p = countedAlloc(size);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+void operator delete(void *p) noexcept { countedFree(p); }
+void operator delete[](void *p) noexcept { countedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { countedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { countedFree(p); }
@@ -6,6 +6,8 @@
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
+// Model loads textures itself from the image URIs; don't read external image files while parsing
+#define TINYGLTF_NO_EXTERNAL_IMAGE
 
 // If you are using Windows, also define this to avoid warnings about sprintf
 #define _CRT_SECURE_NO_WARNINGS
@@ -1,2 +1,4 @@
+// decompress and compress scanline blocks / tiles on all cores (std::thread)
+#define TINYEXR_USE_THREAD 1
 #define TINYEXR_IMPLEMENTATION
 #include "tinyexr.h"
@@ -0,0 +1,227 @@
+#ifndef BLOCK_COMPRESS_H
+#define BLOCK_COMPRESS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Small offline block compressors for car_cook: BC4/BC5 (RGTC) and BC7 mode 6.
+// Quality is "good enough for a car viewer", not a replacement for a dedicated encoder:
+// BC4 uses the block's min/max as endpoints, BC7 fits endpoints along the principal axis of the
+// block's RGBA values with a single subset.
+namespace BlockCompress
+{
+    // 4x4 texels of `rgba` (w x h, 4 channels) starting at (bx, by); edges are clamped
+    inline void fetchBlock(const std::vector<unsigned char> &rgba, uint32_t w, uint32_t h, uint32_t bx, uint32_t by, unsigned char out[16][4])
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+            for (uint32_t x = 0; x < 4; ++x)
+            {
+                uint32_t sx = std::min(bx + x, w - 1), sy = std::min(by + y, h - 1);
+                std::memcpy(out[y * 4 + x], &rgba[((size_t)sy * w + sx) * 4], 4);
+            }
+    }
+
+    // one BC4 block (8 bytes) from 16 single-channel values
+    inline void encodeBC4(const unsigned char values[16], unsigned char *dst)
+    {
+        unsigned char lo = 255, hi = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            lo = std::min(lo, values[i]);
+            hi = std::max(hi, values[i]);
+        }
+        dst[0] = hi;
+        dst[1] = lo;
+        // hi > lo selects the 8-value palette: hi, lo, then 6 interpolated steps from hi towards lo
+        int palette[8] = {hi, lo, 0, 0, 0, 0, 0, 0};
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = ((7 - i) * hi + i * lo) / 7;
+        uint64_t bits = 0;
+        if (hi > lo)
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                int best = 0, bestError = 256;
+                for (int p = 0; p < 8; ++p)
+                {
+                    int e = std::abs(palette[p] - (int)values[i]);
+                    if (e < bestError)
+                    {
+                        bestError = e;
+                        best = p;
+                    }
+                }
+                bits |= (uint64_t)best << (3 * i);
+            }
+        }
+        for (int i = 0; i < 6; ++i)
+            dst[2 + i] = (unsigned char)(bits >> (8 * i));
+    }
+
+    // LSB-first bit writer over a 16-byte BC7 block
+    struct BitWriter
+    {
+        unsigned char *dst;
+        int pos;
+        explicit BitWriter(unsigned char *d) : dst(d), pos(0) { std::memset(dst, 0, 16); }
+        void put(uint32_t value, int bits)
+        {
+            for (int i = 0; i < bits; ++i, ++pos)
+                if (value & (1u << i))
+                    dst[pos >> 3] |= (unsigned char)(1u << (pos & 7));
+        }
+    };
+
+    // one BC7 mode 6 block (16 bytes): RGBA 7-bit endpoints with a p-bit each, 4-bit indices
+    inline void encodeBC7(const unsigned char texels[16][4], unsigned char *dst)
+    {
+        static const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        // principal axis of the block (power iteration on the covariance)
+        float mean[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 16; ++i)
+            for (int c = 0; c < 4; ++c)
+                mean[c] += texels[i][c] / 16.0f;
+        float cov[4][4] = {{0}};
+        for (int i = 0; i < 16; ++i)
+            for (int a = 0; a < 4; ++a)
+                for (int b = 0; b < 4; ++b)
+                    cov[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+        float axis[4] = {1, 1, 1, 1};
+        for (int iter = 0; iter < 8; ++iter)
+        {
+            float next[4] = {0, 0, 0, 0}, len = 0.0f;
+            for (int a = 0; a < 4; ++a)
+                for (int b = 0; b < 4; ++b)
+                    next[a] += cov[a][b] * axis[b];
+            for (int a = 0; a < 4; ++a)
+                len += next[a] * next[a];
+            if (len < 1e-12f)
+                break;
+            len = std::sqrt(len);
+            for (int a = 0; a < 4; ++a)
+                axis[a] = next[a] / len;
+        }
+        float tmin = 1e30f, tmax = -1e30f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < 4; ++c)
+                t += (texels[i][c] - mean[c]) * axis[c];
+            tmin = std::min(tmin, t);
+            tmax = std::max(tmax, t);
+        }
+
+        // quantize both endpoints to 7 bits + shared p-bit, picking the p-bit with the smaller error
+        int endpoint[2][4], pbit[2];
+        for (int e = 0; e < 2; ++e)
+        {
+            float target[4];
+            for (int c = 0; c < 4; ++c)
+                target[c] = std::min(255.0f, std::max(0.0f, mean[c] + axis[c] * (e == 0 ? tmin : tmax)));
+            float bestError = 1e30f;
+            for (int p = 0; p < 2; ++p)
+            {
+                int q[4];
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    q[c] = std::min(127, std::max(0, (int)std::floor((target[c] - p) / 2.0f + 0.5f)));
+                    float d = (float)((q[c] << 1) | p) - target[c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pbit[e] = p;
+                    std::memcpy(endpoint[e], q, sizeof(q));
+                }
+            }
+        }
+
+        int palette[16][4];
+        for (int w = 0; w < 16; ++w)
+            for (int c = 0; c < 4; ++c)
+            {
+                int e0 = (endpoint[0][c] << 1) | pbit[0], e1 = (endpoint[1][c] << 1) | pbit[1];
+                palette[w][c] = ((64 - weights[w]) * e0 + weights[w] * e1 + 32) >> 6;
+            }
+        int index[16];
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0, bestError = 1 << 30;
+            for (int w = 0; w < 16; ++w)
+            {
+                int error = 0;
+                for (int c = 0; c < 4; ++c)
+                {
+                    int d = palette[w][c] - texels[i][c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = w;
+                }
+            }
+            index[i] = best;
+        }
+        // the anchor (texel 0) index is stored with its top bit implied zero: swap endpoints if needed
+        if (index[0] >= 8)
+        {
+            for (int c = 0; c < 4; ++c)
+                std::swap(endpoint[0][c], endpoint[1][c]);
+            std::swap(pbit[0], pbit[1]);
+            for (int i = 0; i < 16; ++i)
+                index[i] = 15 - index[i];
+        }
+
+        BitWriter out(dst);
+        out.put(1u << 6, 7); // mode 6
+        for (int c = 0; c < 4; ++c)
+        {
+            out.put((uint32_t)endpoint[0][c], 7);
+            out.put((uint32_t)endpoint[1][c], 7);
+        }
+        out.put((uint32_t)pbit[0], 1);
+        out.put((uint32_t)pbit[1], 1);
+        out.put((uint32_t)index[0], 3);
+        for (int i = 1; i < 16; ++i)
+            out.put((uint32_t)index[i], 4);
+    }
+
+    // compresses a whole RGBA8 level; `format` also selects which channels BC4/BC5 keep
+    enum Format { BC4_R, BC5_RG, BC5_GB, BC7_RGBA };
+
+    inline void compressLevel(const std::vector<unsigned char> &rgba, uint32_t w, uint32_t h, Format format, std::vector<unsigned char> &out)
+    {
+        uint32_t bw = (w + 3) / 4, bh = (h + 3) / 4;
+        size_t blockSize = format == BC4_R ? 8 : 16;
+        out.resize((size_t)bw * bh * blockSize);
+        unsigned char texels[16][4];
+        unsigned char channel[16];
+        for (uint32_t by = 0; by < bh; ++by)
+            for (uint32_t bx = 0; bx < bw; ++bx)
+            {
+                unsigned char *dst = &out[((size_t)by * bw + bx) * blockSize];
+                fetchBlock(rgba, w, h, bx * 4, by * 4, texels);
+                if (format == BC7_RGBA)
+                {
+                    encodeBC7(texels, dst);
+                    continue;
+                }
+                int first = format == BC5_GB ? 1 : 0;
+                int count = format == BC4_R ? 1 : 2;
+                for (int k = 0; k < count; ++k)
+                {
+                    for (int i = 0; i < 16; ++i)
+                        channel[i] = texels[i][first + k];
+                    encodeBC4(channel, dst + 8 * k);
+                }
+            }
+    }
+}
+
+#endif
@@ -0,0 +1,137 @@
+// Offline generator for the split-sum BRDF LUT (include/brdf_lut_data.h).
+//
+// The LUT only depends on the BRDF, not on the environment, so it is integrated once here and embedded
+// in the viewer (see BRDFLUT::create) instead of being rendered by shaders/brdf.fs on every launch.
+// This is a CPU port of brdf.fs: same Hammersley sequence, GGX importance sampling, view-side
+// Schlick-GGX geometry term (k = (r+1)^2 / 8) and sample count, evaluated at texel centres.
+//
+// usage: brdf_lut_gen [output header]   (default include/brdf_lut_data.h, run from the repo root)
+// re-run after changing the integration below and commit the regenerated header.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const float PI = 3.14159265359f;
+static const uint32_t SAMPLE_COUNT = 1024u;
+// the LUT is smooth, so 128^2 with linear filtering matches the 512^2 render of brdf.fs closely at 1/16 the size
+static const unsigned int SIZE = 128;
+
+static float radicalInverseVdC(uint32_t bits)
+{
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10f;
+}
+
+static float geometrySchlickGGX(float NdotV, float roughness)
+{
+    float r = roughness + 1.0f;
+    float k = (r * r) / 8.0f;
+    return NdotV / (NdotV * (1.0f - k) + k);
+}
+
+// N = +Z, V in the XZ plane, so the tangent frame of brdf.fs is the identity
+static void integrateBRDF(float NdotV, float roughness, float &A, float &B)
+{
+    const float Vx = std::sqrt(1.0f - NdotV * NdotV), Vz = NdotV;
+    const float a = roughness * roughness;
+    A = 0.0f;
+    B = 0.0f;
+    for (uint32_t i = 0; i < SAMPLE_COUNT; ++i)
+    {
+        const float Xi0 = float(i) / float(SAMPLE_COUNT);
+        const float Xi1 = radicalInverseVdC(i);
+        const float phi = 2.0f * PI * Xi0;
+        const float cosTheta = std::sqrt((1.0f - Xi1) / (1.0f + (a * a - 1.0f) * Xi1));
+        const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        float Hx = std::cos(phi) * sinTheta, Hy = std::sin(phi) * sinTheta, Hz = cosTheta;
+        const float hLen = std::sqrt(Hx * Hx + Hy * Hy + Hz * Hz);
+        Hx /= hLen;
+        Hy /= hLen;
+        Hz /= hLen;
+
+        const float VdotH = Vx * Hx + Vz * Hz;
+        // L = reflect(-V, H); only its z (NdotL) is needed
+        const float Lz = 2.0f * VdotH * Hz - Vz;
+        const float NdotL = std::max(Lz, 0.0f);
+        const float NdotH = std::max(Hz, 0.0f);
+        if (NdotL > 0.0f)
+        {
+            const float G = geometrySchlickGGX(NdotV, roughness);
+            const float G_Vis = (G * std::max(VdotH, 0.0f)) / (NdotH * NdotV);
+            const float Fc = std::pow(1.0f - std::max(VdotH, 0.0f), 5.0f);
+            A += (1.0f - Fc) * G_Vis;
+            B += Fc * G_Vis;
+        }
+    }
+    A /= float(SAMPLE_COUNT);
+    B /= float(SAMPLE_COUNT);
+}
+
+// IEEE 754 binary32 -> binary16, round to nearest even (LUT values are in [0, 1], no inf/NaN)
+static uint16_t toHalf(float f)
+{
+    uint32_t x;
+    std::memcpy(&x, &f, 4);
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    int32_t exponent = int32_t((x >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = x & 0x7FFFFFu;
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return (uint16_t)sign;
+        mantissa |= 0x800000u;
+        const uint32_t shift = uint32_t(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1u), halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (half & 1u)))
+            ++half;
+        return (uint16_t)(sign | half);
+    }
+    uint32_t half = (uint32_t(exponent) << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+        ++half;
+    return (uint16_t)(sign | half);
+}
+
+int main(int argc, char **argv)
+{
+    const char *outPath = argc > 1 ? argv[1] : "include/brdf_lut_data.h";
+    const unsigned int size = SIZE;
+    std::vector<uint16_t> texels(size * size * 2);
+    for (unsigned int y = 0; y < size; ++y)
+        for (unsigned int x = 0; x < size; ++x)
+        {
+            // row y = roughness, column x = NdotV, matching the texCoords of brdf.fs
+            float A, B;
+            integrateBRDF((x + 0.5f) / size, (y + 0.5f) / size, A, B);
+            texels[(y * size + x) * 2 + 0] = toHalf(A);
+            texels[(y * size + x) * 2 + 1] = toHalf(B);
+        }
+
+    FILE *out = std::fopen(outPath, "w");
+    if (!out)
+    {
+        std::fprintf(stderr, "brdf_lut_gen: can't write %s\n", outPath);
+        return 1;
+    }
+    std::fprintf(out, "// generated by tools/brdf_lut_gen.cpp - do not edit\n");
+    std::fprintf(out, "// split-sum BRDF LUT, %ux%u RG half floats (x = NdotV, y = roughness), %u samples per texel\n", size, size, SAMPLE_COUNT);
+    std::fprintf(out, "#ifndef BRDF_LUT_DATA_H\n#define BRDF_LUT_DATA_H\n\n");
+    std::fprintf(out, "#define BRDF_LUT_SIZE %u\n\n", size);
+    std::fprintf(out, "static const unsigned short BRDF_LUT_DATA[%u] = {\n", (unsigned int)texels.size());
+    for (size_t i = 0; i < texels.size(); ++i)
+        std::fprintf(out, "%s0x%04x,%s", i % 16 == 0 ? "    " : "", texels[i], i % 16 == 15 ? "\n" : "");
+    std::fprintf(out, "};\n\n#endif\n");
+    std::fclose(out);
+    std::printf("brdf_lut_gen: wrote %s (%ux%u)\n", outPath, size, size);
+    return 0;
+}
@@ -0,0 +1,422 @@
+// car_bench: startup microbenchmarks.
+// Times the loading pipeline stage by stage against the shipped assets, so changes to it can be measured:
+//
+//   car_bench [--iterations N] [--root DIR] [--filter TEXT] [--json FILE]
+//
+// Run from the build directory; assets are found under --root (default ..): both cars and
+// river_alcove_1k.exr. Every stage runs N times (default 3) from a cold start (models released, textures
+// deleted) and reports the median and minimum wall time, operator new calls and bytes, the peak of live
+// heap bytes during the stage and the process peak RSS afterwards. GL stages (uploads, IBL steps) run on
+// a hidden window's context and end with glFinish, so they include the GPU work. --filter runs only the
+// stages whose name contains TEXT.
+//
+// Stages per model: glTF JSON (tinygltf parse + buffer reads), import (Model::importFromFile, CPU only,
+// texture decodes excluded), decode textures (stb, one thread), TextureFromFile (decode + upload), load
+// model (synchronous Model load, everything), load cooked (if <model>.cooked exists), triangle BVH
+// (TRIANGLE_PICKING's per-mesh trees) and raycast (1000 rays at the model, one by one and as packets of
+// four). For the EXR: tinyexr decode and each IBL bake step.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <allocation_counter.h>
+#include <async_log.h>
+#include <model.h>
+#include <ibl_baker.h>
+#include <json.hpp>
+
+#if defined(HAS_TINYEXR)
+#include "tinyexr.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    size_t peakRssBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        return (size_t)usage.ru_maxrss; // bytes
+#else
+        return (size_t)usage.ru_maxrss * 1024; // kilobytes
+#endif
+#endif
+    }
+
+    struct Result
+    {
+        std::string name;
+        std::vector<double> ms;
+        size_t allocations = 0, bytes = 0, peakHeap = 0, peakRss = 0; // of the last iteration
+    };
+
+    struct Bench
+    {
+        int iterations = 3;
+        std::string filter;
+        bool gl = false;
+        std::vector<Result> results;
+
+        bool selected(const std::string &name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+
+        // runs `stage` `iterations` times; `prepare` and `cleanup` run around each iteration, untimed
+        void run(const std::string &name, const std::function<void()> &stage,
+                 const std::function<void()> &prepare = std::function<void()>(),
+                 const std::function<void()> &cleanup = std::function<void()>(), bool needsGl = false)
+        {
+            if (!selected(name))
+                return;
+            if (needsGl && !gl)
+            {
+                LOG_WARN("[car_bench] Skipping '" << name << "' (no GL context)");
+                return;
+            }
+            Result r;
+            r.name = name;
+            for (int i = 0; i < iterations; ++i)
+            {
+                if (prepare)
+                    prepare();
+                const size_t count0 = AllocationCounter::allocations().load(), bytes0 = AllocationCounter::allocatedBytes().load();
+                AllocationCounter::peakLiveBytes().store(AllocationCounter::liveBytes().load());
+                const size_t live0 = AllocationCounter::liveBytes().load();
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                stage();
+                if (needsGl)
+                    glFinish();
+                r.ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                r.allocations = AllocationCounter::allocations().load() - count0;
+                r.bytes = AllocationCounter::allocatedBytes().load() - bytes0;
+                r.peakHeap = AllocationCounter::peakLiveBytes().load() - live0;
+                r.peakRss = peakRssBytes();
+                if (cleanup)
+                    cleanup();
+            }
+            asyncLog().flush();
+            const std::vector<double> sorted = sortedMs(r);
+            LOG_INFO("[car_bench] " << name << ": median " << sorted[sorted.size() / 2] << " ms, min " << sorted.front() << " ms, "
+                                    << r.allocations << " allocations (" << r.bytes / 1024 << " KiB), peak heap " << r.peakHeap / 1024
+                                    << " KiB, peak RSS " << r.peakRss / (1024 * 1024) << " MiB");
+            results.push_back(r);
+        }
+
+        static std::vector<double> sortedMs(const Result &r)
+        {
+            std::vector<double> sorted(r.ms);
+            std::sort(sorted.begin(), sorted.end());
+            return sorted;
+        }
+
+        bool writeJson(const std::string &path) const
+        {
+            nlohmann::json root = nlohmann::json::array();
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                const std::vector<double> sorted = sortedMs(results[i]);
+                nlohmann::json j;
+                j["name"] = results[i].name;
+                j["median_ms"] = sorted[sorted.size() / 2];
+                j["min_ms"] = sorted.front();
+                j["iterations"] = sorted.size();
+                j["allocations"] = results[i].allocations;
+                j["allocated_bytes"] = results[i].bytes;
+                j["peak_heap_bytes"] = results[i].peakHeap;
+                j["peak_rss_bytes"] = results[i].peakRss;
+                root.push_back(j);
+            }
+            std::ofstream out(path.c_str());
+            if (!out)
+                return false;
+            out << root.dump(2) << std::endl;
+            return (bool)out;
+        }
+    };
+
+    // the model's distinct texture files, as (directory, uri, gamma)
+    struct TextureFile
+    {
+        std::string directory, uri;
+        bool gamma;
+    };
+
+    std::vector<TextureFile> textureFiles(const std::string &path)
+    {
+        Model model;
+        model.importFromFile(path);
+        std::vector<TextureFile> files;
+        std::set<std::pair<std::string, bool> > seen;
+        for (size_t m = 0; m < model.meshes.size(); ++m)
+            for (size_t i = 0; i < model.meshes[m].textures.size(); ++i)
+            {
+                const Texture &t = model.meshes[m].textures[i];
+                TextureFile f = {model.directory, t.path, t.slot == Texture::DIFFUSE};
+                if (seen.insert(std::make_pair(f.uri, f.gamma)).second)
+                    files.push_back(f);
+            }
+        return files;
+    }
+
+    // waits for the decodes importFromFile queued, so they don't run into the next stage
+    void waitForDecodes(const Model &model)
+    {
+        for (unsigned int t = 0;; ++t)
+        {
+            std::shared_ptr<CachedTexture> entry = model.pendingTextures().entry(t);
+            if (!entry)
+                break;
+            entry->image.wait();
+        }
+    }
+
+    void benchModel(Bench &bench, const std::string &label, const std::string &path)
+    {
+        bench.run(label + " glTF JSON", [&]() {
+            tinygltf::TinyGLTF loader;
+            loader.SetImageLoader(GltfLoader::skipImageData, NULL);
+            loader.SetFsCallbacks(GltfLoader::mappedFsCallbacks());
+            tinygltf::Model gltf;
+            std::string err, warn;
+            bool ok = GltfLoader::isGlbPath(path) ? loader.LoadBinaryFromFile(&gltf, &err, &warn, path)
+                                                  : loader.LoadASCIIFromFile(&gltf, &err, &warn, path);
+            if (!ok)
+                LOG_ERROR("[car_bench] Can't parse '" << path << "': " << err);
+        });
+
+        std::unique_ptr<Model> imported;
+        bench.run(label + " import", [&]() { imported->importFromFile(path); },
+                  [&]() { imported.reset(new Model()); },
+                  [&]() {
+                      waitForDecodes(*imported);
+                      imported.reset();
+                  });
+
+        const std::vector<TextureFile> files = textureFiles(path);
+        bench.run(label + " decode textures", [&]() {
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                DecodedImage img = decodeImageFile(files[i].directory + '/' + files[i].uri);
+                if (img.pixels)
+                    stbi_image_free(img.pixels);
+            }
+        });
+
+        std::vector<unsigned int> uploaded;
+        bench.run(label + " TextureFromFile", [&]() {
+            for (size_t i = 0; i < files.size(); ++i)
+                uploaded.push_back(TextureFromFile(files[i].uri.c_str(), files[i].directory, files[i].gamma));
+        },
+                  std::function<void()>(),
+                  [&]() {
+                      if (!uploaded.empty())
+                          glDeleteTextures((GLsizei)uploaded.size(), &uploaded[0]);
+                      uploaded.clear();
+                      glState().invalidate();
+                  },
+                  true);
+
+        std::unique_ptr<Model> loaded;
+        bench.run(label + " load model", [&]() { loaded.reset(new Model(path)); },
+                  std::function<void()>(), [&]() { loaded.reset(); }, true);
+
+        // rays from a ring around the model at its centre's height, aimed at the centre in 2x2 groups a few
+        // millimetres apart (what a packet of neighbouring pixels looks like)
+        const std::string bvhStage = label + " triangle BVH", rayStage = label + " raycast 1000 rays", packetStage = rayStage + " (packets)";
+        if (bench.gl && (bench.selected(bvhStage) || bench.selected(rayStage) || bench.selected(packetStage)))
+        {
+            Model picked(path, false, true);
+            bench.run(bvhStage, [&]() { picked.buildTriangleBvhs(); });
+            const glm::vec3 centre = (picked.boundsMin + picked.boundsMax) * 0.5f;
+            const float radius = glm::length(picked.boundsMax - picked.boundsMin);
+            std::vector<Model::Ray> rays;
+            for (int k = 0; k < 250; ++k)
+            {
+                const float angle = 6.2831853f * (float)k / 250.0f;
+                const glm::vec3 origin = centre + radius * glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+                for (int l = 0; l < 4; ++l)
+                {
+                    const glm::vec3 target = centre + 0.003f * radius * glm::vec3((float)(l & 1), (float)(l >> 1), 0.0f);
+                    rays.push_back(Model::Ray(origin, glm::normalize(target - origin)));
+                }
+            }
+            std::vector<Model::RayHit> hits(rays.size());
+            size_t hitCount = 0;
+            bench.run(rayStage, [&]() {
+                hitCount = 0;
+                for (size_t r = 0; r < rays.size(); ++r)
+                    hitCount += picked.raycast(rays[r], hits[r]);
+            });
+            bench.run(packetStage, [&]() { hitCount = picked.raycast(&rays[0], rays.size(), &hits[0]); });
+            LOG_INFO("[car_bench] " << label << ": " << hitCount << " of " << rays.size() << " rays hit");
+        }
+
+        const std::string cooked = CookedFormat::cookedPath(path);
+        if (std::ifstream(cooked.c_str()))
+            bench.run(label + " load cooked", [&]() {
+                if (!loaded->loadCooked(cooked, path))
+                    LOG_WARN("[car_bench] '" << cooked << "' didn't load");
+            },
+                      [&]() { loaded.reset(new Model()); }, [&]() { loaded.reset(); }, true);
+    }
+
+    void benchEnvironment(Bench &bench, const std::string &exrPath, const std::string &shaderDir)
+    {
+#if defined(HAS_TINYEXR)
+        float *rgba = nullptr;
+        int width = 0, height = 0;
+        bench.run("exr tinyexr decode", [&]() {
+            const char *err = nullptr;
+            if (LoadEXR(&rgba, &width, &height, exrPath.c_str(), &err) != TINYEXR_SUCCESS)
+            {
+                LOG_ERROR("[car_bench] Can't load '" << exrPath << "': " << (err ? err : "unknown error"));
+                if (err)
+                    FreeEXRErrorMessage(err);
+            }
+        },
+                  std::function<void()>(),
+                  [&]() {
+                      free(rgba);
+                      rgba = nullptr;
+                  });
+        if (!bench.gl)
+            return;
+
+        // bake source, as EnvironmentLoader uploads it (RGB, linear filtering)
+        const char *err = nullptr;
+        if (LoadEXR(&rgba, &width, &height, exrPath.c_str(), &err) != TINYEXR_SUCCESS)
+        {
+            if (err)
+                FreeEXRErrorMessage(err);
+            return;
+        }
+        GLuint hdrTexture = 0;
+        glGenTextures(1, &hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, width, height, 0, GL_RGBA, GL_FLOAT, rgba);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        free(rgba);
+        rgba = nullptr;
+
+        // one untimed bake compiles the programs, so the steps measure baking rather than shader compiles
+        IBLBaker baker(shaderDir);
+        IBLBakeSettings settings;
+        IBLMaps warm = baker.bake(hdrTexture, settings);
+        IBLBaker::releaseMaps(warm);
+        baker.begin(hdrTexture, settings);
+        const unsigned int steps = baker.stepCount();
+        baker.abort();
+        static const char *const stepNames[2] = {"env faces", "env mips"};
+        for (unsigned int s = 0; s < steps; ++s)
+        {
+            const std::string name = "ibl step " + std::to_string(s) + " (" + (s < 2 ? std::string(stepNames[s]) : "prefilter mip " + std::to_string(s - 2)) + ")";
+            // each iteration starts a fresh bake and runs the earlier steps untimed
+            bench.run(name, [&]() { baker.runStep(s); },
+                      [&]() {
+                          baker.begin(hdrTexture, settings);
+                          for (unsigned int k = 0; k < s; ++k)
+                              baker.runStep(k);
+                          glFinish();
+                      },
+                      [&]() { baker.abort(); }, true);
+        }
+        baker.release();
+        glDeleteTextures(1, &hdrTexture);
+        glState().invalidate();
+#else
+        (void)bench;
+        (void)exrPath;
+        (void)shaderDir;
+        LOG_WARN("[car_bench] tinyexr not compiled in, skipping the EXR stages");
+#endif
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Bench bench;
+    std::string root = "..";
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc)
+            bench.iterations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--root" && i + 1 < argc)
+            root = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            bench.filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+        {
+            LOG_INFO("usage: car_bench [--iterations N] [--root DIR] [--filter TEXT] [--json FILE]");
+            return 1;
+        }
+    }
+
+    // a hidden window for the GL stages; without one only the CPU stages run
+    GLFWwindow *window = nullptr;
+    if (glfwInit())
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(64, 64, "car_bench", NULL, NULL);
+        if (window)
+        {
+            glfwMakeContextCurrent(window);
+            bench.gl = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) != 0;
+        }
+    }
+    if (!bench.gl)
+        LOG_WARN("[car_bench] No GL context, running the CPU stages only");
+
+    benchModel(bench, "ford_raptor", root + "/ford_raptor/scene.gltf");
+    benchModel(bench, "shelby", root + "/models/2024_ford_shelby_super_snake_s650/scene.gltf");
+    benchEnvironment(bench, root + "/river_alcove_1k.exr", root + "/shaders");
+
+    if (!jsonPath.empty())
+    {
+        if (bench.writeJson(jsonPath))
+            LOG_INFO("[car_bench] Wrote " << jsonPath);
+        else
+            LOG_ERROR("[car_bench] Cannot write '" << jsonPath << "'");
+    }
+    if (window)
+        glfwDestroyWindow(window);
+    glfwTerminate();
+    asyncLog().flush();
+    return 0;
+}
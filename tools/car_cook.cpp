@@ -0,0 +1,857 @@
+// car_cook: offline asset cooker.
+// Runs the regular Model import pipeline (native glTF or Assimp) once and writes a cooked model that
+// Model::loadCooked() can memory-map and upload without parsing:
+//
+//   car_cook [--uncompressed] [--ao-rays N] [--ao-distance D] [--no-proxy] <model.gltf|glb|obj...> [output.cooked]
+//   car_cook --livery <image> [output.vtex]
+//
+// The output defaults to <model>.cooked next to the source, which is where ModelLoader looks for it.
+// No GL context is needed: vertices are packed and texture mip chains are built on the CPU.
+// Textures are block-compressed by role: BC7 for baseColor, BC5 for normal maps (XY only),
+// BC5 holding G/B for metallicRoughness; anything else stays uncompressed. --uncompressed keeps
+// every texture as 8-bit for drivers without BPTC (metallicRoughness still drops to two channels).
+// Solid-colour baseColor/metallicRoughness maps and flat normal maps are folded into the material
+// factors and dropped, so they cost neither a texture nor a bind.
+// Ambient occlusion is baked per vertex against the car's own opaque geometry (OcclusionBake): --ao-rays
+// per vertex (default 64, 0 = none) reaching --ao-distance model units (default a tenth of the model's
+// diagonal). Meshes baked into model space see every opaque mesh, instanced ones (wheels) only themselves,
+// since they move on their own; transparent meshes stay unoccluded.
+// The file starts with a low-detail proxy of the model (see CookedFormat: coarsest LODs, textures of at most
+// PROXY_TEXTURE texels) that ModelLoader draws within the first frames while the rest is read; --no-proxy
+// leaves it out.
+// --livery cooks the page file of a livery image instead (CookedFormat::LiveryHeader, default <image>.vtex,
+// where LIVERY=<image> finds it): its mip chain cut into bordered pages the viewer streams in on demand.
+// The image must be RGB(A) with power-of-two sides of at most 32768.
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <model.h>
+#include <cooked_format.h>
+#include <mapped_file.h>
+#include <mip_chain.h>
+
+#include "block_compress.h"
+#include "occlusion_bake.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void writePadding(std::ostream &out, uint64_t &cursor)
+    {
+        static const char zeros[8] = {0};
+        uint64_t aligned = CookedFormat::alignUp(cursor);
+        out.write(zeros, (std::streamsize)(aligned - cursor));
+        cursor = aligned;
+    }
+
+    template <class T>
+    void writeArray(std::ostream &out, uint64_t &cursor, const std::vector<T> &items)
+    {
+        if (!items.empty())
+            out.write((const char *)&items[0], (std::streamsize)(items.size() * sizeof(T)));
+        cursor += items.size() * sizeof(T);
+        writePadding(out, cursor);
+    }
+
+    // index list as `indexSize`-byte indices, without padding (the lists of all meshes are contiguous)
+    void writeIndices(std::ostream &out, uint64_t &cursor, const std::vector<unsigned int> &indices, uint32_t indexSize)
+    {
+        if (indices.empty())
+            return;
+        if (indexSize == 2)
+        {
+            std::vector<uint16_t> narrowed(indices.begin(), indices.end());
+            out.write((const char *)&narrowed[0], (std::streamsize)(narrowed.size() * sizeof(uint16_t)));
+        }
+        else
+            out.write((const char *)&indices[0], (std::streamsize)(indices.size() * sizeof(unsigned int)));
+        cursor += indices.size() * indexSize;
+    }
+
+    // encoding for a texture used as `type` (every use must agree, otherwise it stays uncompressed)
+    uint32_t encodingFor(Texture::Slot slot, int components, bool compress, bool packedOcclusion)
+    {
+        if (slot == Texture::DIFFUSE && compress)
+            return CookedFormat::BC7;
+        if (slot == Texture::NORMAL && components >= 3 && compress)
+            return CookedFormat::BC5;
+        // the shader only reads G (roughness) and B (metallic), and R (occlusion) when ORM packed
+        if (slot == Texture::METALLIC_ROUGHNESS && components >= 3 && packedOcclusion)
+            return compress ? CookedFormat::BC7 : CookedFormat::RAW8;
+        if (slot == Texture::METALLIC_ROUGHNESS && components >= 3)
+            return compress ? CookedFormat::BC5_GB : CookedFormat::RG8_GB;
+        return CookedFormat::RAW8;
+    }
+
+    // folds a solid-colour texture used in `slot` into the mesh's material factors (the shader multiplies
+    // the sample by them anyway). Returns false if the texture has to stay.
+    bool foldIntoFactors(CookedFormat::Mesh &cm, Texture::Slot slot, bool gamma, int components, const unsigned char texel[4])
+    {
+        if (slot == Texture::DIFFUSE)
+        {
+            // sRGB textures are sampled as linear values
+            for (int c = 0; c < 3; ++c)
+                cm.baseColorFactor[c] *= gamma ? MipChain::srgbToLinear(texel[c] / 255.0f) : texel[c] / 255.0f;
+            cm.baseColorFactor[3] *= texel[3] / 255.0f;
+            return true;
+        }
+        if (slot == Texture::METALLIC_ROUGHNESS && components >= 3)
+        {
+            // occlusion packed in R has no factor to fold into
+            if (cm.occlusionStrength > 0.0f && texel[0] < 253)
+                return false;
+            cm.roughnessFactor *= texel[1] / 255.0f;
+            cm.metallicFactor *= texel[2] / 255.0f;
+            return true;
+        }
+        // a flat tangent-space normal map changes nothing
+        if (slot == Texture::NORMAL && components >= 3)
+            return std::abs((int)texel[0] - 128) <= 2 && std::abs((int)texel[1] - 128) <= 2;
+        return false;
+    }
+
+    // expands a `components`-channel level to RGBA8 for the block compressors
+    void toRgba(const std::vector<unsigned char> &src, uint32_t components, std::vector<unsigned char> &dst)
+    {
+        size_t texels = src.size() / components;
+        dst.resize(texels * 4);
+        for (size_t i = 0; i < texels; ++i)
+        {
+            const unsigned char *p = &src[i * components];
+            unsigned char *q = &dst[i * 4];
+            q[0] = p[0];
+            q[1] = components >= 3 ? p[1] : p[0];
+            q[2] = components >= 3 ? p[2] : p[0];
+            q[3] = components == 4 ? p[3] : 255;
+        }
+    }
+
+    uint32_t addString(std::string &table, const std::string &s)
+    {
+        uint32_t offset = (uint32_t)table.size();
+        table += s;
+        return offset;
+    }
+
+    void copyVec3(float *dst, const glm::vec3 &v)
+    {
+        dst[0] = v.x;
+        dst[1] = v.y;
+        dst[2] = v.z;
+    }
+
+    bool powerOfTwo(int v) { return v > 0 && (v & (v - 1)) == 0; }
+
+    // a cooked model's tables, in file order
+    struct Tables
+    {
+        std::vector<CookedFormat::Mesh> meshes;
+        std::vector<CookedFormat::MeshTexture> meshTextures;
+        std::vector<CookedFormat::MeshLod> meshLods;
+        std::vector<CookedFormat::Meshlet> meshlets;
+        std::vector<CookedFormat::Instance> instances;
+        std::vector<CookedFormat::Node> nodes;
+        std::vector<CookedFormat::Texture> textures;
+        std::string strings;
+    };
+
+    // the counts and section offsets of `header` for `tables` laid out from `cursor` (vertexCount, indexCount
+    // and indexSize already set), and the texture data offsets; returns the end of the pixel data
+    uint64_t layoutSections(CookedFormat::Header &header, uint64_t cursor, Tables &tables)
+    {
+        header.meshCount = (uint32_t)tables.meshes.size();
+        header.meshTextureCount = (uint32_t)tables.meshTextures.size();
+        header.textureCount = (uint32_t)tables.textures.size();
+        header.meshLodCount = (uint32_t)tables.meshLods.size();
+        header.meshletCount = (uint32_t)tables.meshlets.size();
+        header.instanceCount = (uint32_t)tables.instances.size();
+        header.nodeCount = (uint32_t)tables.nodes.size();
+        header.meshOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.meshes.size() * sizeof(CookedFormat::Mesh));
+        header.meshTextureOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.meshTextures.size() * sizeof(CookedFormat::MeshTexture));
+        header.meshLodOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.meshLods.size() * sizeof(CookedFormat::MeshLod));
+        header.meshletOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.meshlets.size() * sizeof(CookedFormat::Meshlet));
+        header.instanceOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.instances.size() * sizeof(CookedFormat::Instance));
+        header.nodeOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.nodes.size() * sizeof(CookedFormat::Node));
+        header.textureOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + tables.textures.size() * sizeof(CookedFormat::Texture));
+        header.stringOffset = cursor;
+        header.stringSize = tables.strings.size();
+        cursor = CookedFormat::alignUp(cursor + tables.strings.size());
+        header.vertexOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + header.vertexCount * sizeof(PackedVertex));
+        header.indexOffset = cursor;
+        cursor = CookedFormat::alignUp(cursor + header.indexCount * header.indexSize);
+        header.pixelOffset = cursor;
+        for (size_t t = 0; t < tables.textures.size(); ++t)
+        {
+            tables.textures[t].dataOffset = cursor;
+            cursor = CookedFormat::alignUp(cursor + tables.textures[t].dataSize);
+        }
+        return cursor;
+    }
+
+    void writeTables(std::ostream &out, uint64_t &cursor, const Tables &tables)
+    {
+        writeArray(out, cursor, tables.meshes);
+        writeArray(out, cursor, tables.meshTextures);
+        writeArray(out, cursor, tables.meshLods);
+        writeArray(out, cursor, tables.meshlets);
+        writeArray(out, cursor, tables.instances);
+        writeArray(out, cursor, tables.nodes);
+        writeArray(out, cursor, tables.textures);
+        out.write(tables.strings.data(), (std::streamsize)tables.strings.size());
+        cursor += tables.strings.size();
+        writePadding(out, cursor);
+    }
+
+    // --livery: every level of `input`, largest first, cut into pages with their borders
+    int cookLivery(const std::string &input, const std::string &output)
+    {
+        MappedFile source;
+        if (!source.open(input))
+        {
+            LOG_ERROR("[car_cook] Cannot open '" << input << "'");
+            return 1;
+        }
+        int width = 0, height = 0, components = 0;
+        unsigned char *pixels = stbi_load_from_memory(source.data(), (int)source.size(), &width, &height, &components, 4);
+        if (!pixels)
+        {
+            LOG_ERROR("[car_cook] Cannot decode '" << input << "': " << stbi_failure_reason());
+            return 1;
+        }
+        std::vector<unsigned char> level(pixels, pixels + (size_t)width * height * 4), next;
+        stbi_image_free(pixels);
+        const uint32_t maxSide = CookedFormat::LIVERY_PAGE * 256;
+        if (!powerOfTwo(width) || !powerOfTwo(height) || (uint32_t)width > maxSide || (uint32_t)height > maxSide)
+        {
+            LOG_ERROR("[car_cook] Livery '" << input << "' is " << width << "x" << height << ", needs power-of-two sides up to " << maxSide);
+            return 1;
+        }
+
+        const uint32_t page = CookedFormat::LIVERY_PAGE, border = CookedFormat::LIVERY_BORDER, tile = page + 2 * border;
+        CookedFormat::LiveryHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, CookedFormat::LIVERY_MAGIC, 4);
+        header.version = CookedFormat::LIVERY_VERSION;
+        header.width = (uint32_t)width;
+        header.height = (uint32_t)height;
+        header.pageSize = page;
+        header.border = border;
+        header.levels = CookedFormat::liveryLevels(header.width, header.height);
+        for (uint32_t l = 0; l < header.levels; ++l)
+            header.pageCount += CookedFormat::liveryPages(header.width, l) * CookedFormat::liveryPages(header.height, l);
+        header.pageBytes = (uint64_t)tile * tile * 4;
+        header.pageOffset = CookedFormat::alignUp(sizeof(header));
+        header.sourceHash = CookedFormat::hashBytes(source.data(), source.size());
+        source.close();
+
+        std::ofstream out(output.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            LOG_ERROR("[car_cook] Cannot write '" << output << "'");
+            return 1;
+        }
+        uint64_t written = 0;
+        out.write((const char *)&header, sizeof(header));
+        written += sizeof(header);
+        writePadding(out, written);
+        std::vector<unsigned char> pageTexels((size_t)header.pageBytes);
+        uint32_t w = header.width, h = header.height;
+        for (uint32_t l = 0; l < header.levels; ++l)
+        {
+            const uint32_t pagesX = CookedFormat::liveryPages(header.width, l), pagesY = CookedFormat::liveryPages(header.height, l);
+            for (uint32_t py = 0; py < pagesY; ++py)
+                for (uint32_t px = 0; px < pagesX; ++px)
+                {
+                    // the page's texels and its border, clamped at the image's edges
+                    for (uint32_t ty = 0; ty < tile; ++ty)
+                    {
+                        const int64_t sy = std::min(std::max((int64_t)py * page + ty - border, (int64_t)0), (int64_t)h - 1);
+                        for (uint32_t tx = 0; tx < tile; ++tx)
+                        {
+                            const int64_t sx = std::min(std::max((int64_t)px * page + tx - border, (int64_t)0), (int64_t)w - 1);
+                            std::memcpy(&pageTexels[((size_t)ty * tile + tx) * 4], &level[((size_t)sy * w + (size_t)sx) * 4], 4);
+                        }
+                    }
+                    out.write((const char *)&pageTexels[0], (std::streamsize)pageTexels.size());
+                    written += pageTexels.size();
+                }
+            if (l + 1 < header.levels)
+            {
+                next.resize((size_t)(w > 1 ? w / 2 : 1) * (h > 1 ? h / 2 : 1) * 4);
+                MipChain::downsample(&level[0], w, h, 4, true, false, &next[0]);
+                level.swap(next);
+                w = w > 1 ? w / 2 : 1;
+                h = h > 1 ? h / 2 : 1;
+            }
+        }
+        out.close();
+        const uint64_t expected = header.pageOffset + (uint64_t)header.pageCount * header.pageBytes;
+        if (!out || written != expected)
+        {
+            LOG_ERROR("[car_cook] Failed writing '" << output << "' (" << written << " of " << expected << " bytes)");
+            std::remove(output.c_str());
+            return 1;
+        }
+        LOG_INFO("[car_cook] Wrote '" << output << "': " << width << "x" << height << " livery, " << header.levels << " levels, "
+                 << header.pageCount << " pages, " << expected / (1024 * 1024) << " MiB");
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool compress = true;
+    unsigned int occlusionRays = 64;
+    float occlusionDistance = 0.0f;
+    bool livery = false;
+    bool proxy = true;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--uncompressed")
+            compress = false;
+        else if (std::string(argv[i]) == "--livery")
+            livery = true;
+        else if (std::string(argv[i]) == "--no-proxy")
+            proxy = false;
+        else if (std::string(argv[i]) == "--ao-rays" && i + 1 < argc)
+            occlusionRays = (unsigned int)std::max(0, std::atoi(argv[++i]));
+        else if (std::string(argv[i]) == "--ao-distance" && i + 1 < argc)
+            occlusionDistance = std::max(0.0f, (float)std::atof(argv[++i]));
+        else
+            args.push_back(argv[i]);
+    }
+    if (args.empty())
+    {
+        LOG_INFO("usage: car_cook [--uncompressed] [--ao-rays N] [--ao-distance D] [--no-proxy] <model file> [output.cooked]");
+        LOG_INFO("       car_cook --livery <image> [output.vtex]");
+        return 1;
+    }
+    if (livery)
+        return cookLivery(args[0], args.size() > 1 ? args[1] : CookedFormat::liveryPath(args[0]));
+    std::string input = args[0];
+    std::string output = args.size() > 1 ? args[1] : CookedFormat::cookedPath(input);
+
+    MappedFile source;
+    if (!source.open(input))
+    {
+        LOG_ERROR("[car_cook] Cannot open '" << input << "'");
+        return 1;
+    }
+    uint64_t sourceHash = CookedFormat::hashBytes(source.data(), source.size());
+    source.close();
+
+    Model model;
+    model.importFromFile(input, true);
+    if (model.meshes.empty())
+    {
+        LOG_ERROR("[car_cook] No meshes imported from '" << input << "'");
+        return 1;
+    }
+    const TextureLoader &loader = model.pendingTextures();
+
+    // tables: one cooked texture per distinct loader ticket (TextureCache already merged identical images)
+    Tables tables;
+    std::string &strings = tables.strings;
+    std::vector<CookedFormat::Mesh> &meshes = tables.meshes;
+    std::vector<CookedFormat::MeshTexture> &meshTextures = tables.meshTextures;
+    std::vector<CookedFormat::MeshLod> &meshLods = tables.meshLods;
+    std::vector<CookedFormat::Meshlet> &meshlets = tables.meshlets;
+    std::vector<CookedFormat::Instance> &instances = tables.instances;
+    std::vector<CookedFormat::Node> &nodes = tables.nodes;
+    std::vector<CookedFormat::Texture> &textures = tables.textures;
+    std::vector<std::shared_ptr<CachedTexture> > textureEntries;
+    std::map<unsigned int, uint32_t> ticketToTexture;
+    // string table offset of each slot's name (the cooked files store the name, Texture::slotName)
+    std::map<Texture::Slot, uint32_t> slotStrings;
+    // slots each texture is used in, to pick its encoding
+    std::vector<std::vector<Texture::Slot> > textureTypes;
+    // and whether one of its metallicRoughness uses carries occlusion in R (ORM), which the encoding keeps
+    std::vector<bool> textureOcclusion;
+    size_t foldedCount = 0;
+    uint64_t vertexCount = 0, indexCount = 0;
+    for (size_t i = 0; i < model.meshes.size(); ++i)
+    {
+        const Mesh &m = model.meshes[i];
+        CookedFormat::Mesh cm;
+        std::memset(&cm, 0, sizeof(cm));
+        cm.baseVertex = (int32_t)vertexCount;
+        cm.firstIndex = (uint32_t)indexCount;
+        cm.indexCount = (uint32_t)m.indices.size();
+        cm.vertexCount = (uint32_t)m.vertices.size();
+        cm.firstTexture = (uint32_t)meshTextures.size();
+        cm.transparent = m.transparent ? (m.weightedBlend ? 2 : 1) : 0;
+        // LOD index lists follow the mesh's full list
+        cm.firstLod = (uint32_t)meshLods.size();
+        cm.lodCount = (uint32_t)m.lodIndices.size();
+        uint64_t lodCursor = indexCount + m.indices.size();
+        cm.firstMeshlet = (uint32_t)meshlets.size();
+        cm.meshletCount = (uint32_t)m.meshlets.size();
+        for (size_t c = 0; c < m.meshlets.size(); ++c)
+        {
+            CookedFormat::Meshlet cl;
+            cl.firstIndex = m.meshlets[c].firstIndex;
+            cl.indexCount = m.meshlets[c].indexCount;
+            for (int k = 0; k < 4; ++k)
+            {
+                cl.sphere[k] = m.meshlets[c].sphere[k];
+                cl.cone[k] = m.meshlets[c].cone[k];
+            }
+            meshlets.push_back(cl);
+        }
+        cm.firstInstance = (uint32_t)instances.size();
+        cm.instanceCount = (uint32_t)m.instances.size();
+        for (size_t k = 0; k < m.instances.size(); ++k)
+        {
+            CookedFormat::Instance instance;
+            std::memcpy(instance.matrix, glm::value_ptr(m.instances[k]), sizeof(instance.matrix));
+            instance.node = k < m.instanceNodes.size() ? m.instanceNodes[k] : -1;
+            instance.reserved = 0;
+            instances.push_back(instance);
+        }
+        for (size_t l = 0; l < m.lodIndices.size(); ++l)
+        {
+            CookedFormat::MeshLod lod = {(uint32_t)lodCursor, (uint32_t)m.lodIndices[l].size(), m.lodErrors[l]};
+            meshLods.push_back(lod);
+            lodCursor += m.lodIndices[l].size();
+        }
+        for (int c = 0; c < 4; ++c)
+            cm.baseColorFactor[c] = m.baseColorFactor[c];
+        cm.metallicFactor = m.metallicFactor;
+        cm.roughnessFactor = m.roughnessFactor;
+        cm.alphaMode = (uint32_t)m.alphaMode;
+        cm.alphaCutoff = m.alphaCutoff;
+        cm.clearcoatFactor = m.clearcoatFactor;
+        cm.clearcoatRoughnessFactor = m.clearcoatRoughnessFactor;
+        cm.transmissionFactor = m.transmissionFactor;
+        cm.specularFactor = m.specularFactor;
+        copyVec3(cm.specularColorFactor, m.specularColorFactor);
+        cm.occlusionStrength = m.occlusionStrength;
+        copyVec3(cm.centroid, m.centroid);
+        copyVec3(cm.boundsMin, m.boundsMin);
+        copyVec3(cm.boundsMax, m.boundsMax);
+        copyVec3(cm.localCentroid, m.localCentroid);
+        copyVec3(cm.localBoundsMin, m.localBoundsMin);
+        copyVec3(cm.localBoundsMax, m.localBoundsMax);
+        cm.uvDensity = m.uvDensity;
+        cm.materialTag = m.materialTag;
+        cm.partNode = m.partNode;
+        for (size_t t = 0; t < m.textures.size(); ++t)
+        {
+            const Texture &tex = m.textures[t];
+            std::shared_ptr<CachedTexture> entry = loader.entry(tex.id);
+            if (!entry)
+                continue;
+            // small tolerance for encoder noise in "solid" PNGs
+            DecodedImage img = entry->image.get();
+            unsigned char texel[4];
+            if (constantImage(img, texel, 2) && foldIntoFactors(cm, tex.slot, entry->gamma, img.components, texel))
+            {
+                foldedCount++;
+                continue;
+            }
+            std::map<unsigned int, uint32_t>::iterator it = ticketToTexture.find(tex.id);
+            if (it == ticketToTexture.end())
+            {
+                CookedFormat::Texture ct;
+                std::memset(&ct, 0, sizeof(ct));
+                ct.gamma = entry->gamma ? 1 : 0;
+                ct.pathOffset = addString(strings, tex.path);
+                ct.pathLength = (uint32_t)tex.path.size();
+                it = ticketToTexture.insert(std::make_pair(tex.id, (uint32_t)textures.size())).first;
+                textures.push_back(ct);
+                textureEntries.push_back(entry);
+                textureTypes.push_back(std::vector<Texture::Slot>());
+                textureOcclusion.push_back(false);
+            }
+            textureTypes[it->second].push_back(tex.slot);
+            if (tex.slot == Texture::METALLIC_ROUGHNESS && m.occlusionStrength > 0.0f)
+                textureOcclusion[it->second] = true;
+            const std::string slotName = Texture::slotName(tex.slot);
+            std::map<Texture::Slot, uint32_t>::iterator type = slotStrings.find(tex.slot);
+            if (type == slotStrings.end())
+                type = slotStrings.insert(std::make_pair(tex.slot, addString(strings, slotName))).first;
+            CookedFormat::MeshTexture mt;
+            mt.texture = it->second;
+            mt.typeOffset = type->second;
+            mt.typeLength = (uint32_t)slotName.size();
+            mt.uvOffset[0] = tex.uvOffset.x;
+            mt.uvOffset[1] = tex.uvOffset.y;
+            mt.uvScale[0] = tex.uvScale.x;
+            mt.uvScale[1] = tex.uvScale.y;
+            mt.uvRotation = tex.uvRotation;
+            meshTextures.push_back(mt);
+        }
+        cm.textureCount = (uint32_t)meshTextures.size() - cm.firstTexture;
+        meshes.push_back(cm);
+        vertexCount += m.vertices.size();
+        indexCount += m.indices.size();
+        for (size_t l = 0; l < m.lodIndices.size(); ++l)
+            indexCount += m.lodIndices[l].size();
+    }
+
+    // scene nodes, so meshes drawn through their node keep following it after loading the cooked file
+    const TransformHierarchy &hierarchy = model.nodeHierarchy();
+    for (size_t n = 0; n < hierarchy.size(); ++n)
+    {
+        CookedFormat::Node node;
+        std::memset(&node, 0, sizeof(node));
+        node.parent = hierarchy.parent((int)n);
+        node.nameOffset = addString(strings, hierarchy.name((int)n));
+        node.nameLength = (uint32_t)hierarchy.name((int)n).size();
+        std::memcpy(node.local, glm::value_ptr(hierarchy.local((int)n)), sizeof(node.local));
+        nodes.push_back(node);
+    }
+
+    // texture dimensions (waits for the pool's decodes; gray+alpha images arrive expanded to RGBA); failed
+    // decodes become the runtime's 1x1 placeholder
+    std::vector<DecodedImage> images(textures.size());
+    uint64_t pixelBytes = 0;
+    size_t compressedCount = 0;
+    for (size_t t = 0; t < textures.size(); ++t)
+    {
+        images[t] = textureEntries[t]->image.get();
+        CookedFormat::Texture &ct = textures[t];
+        if (images[t].pixels && !images[t].compressedFormat && (images[t].components == 1 || images[t].components == 3 || images[t].components == 4))
+        {
+            ct.width = (uint32_t)images[t].width;
+            ct.height = (uint32_t)images[t].height;
+            ct.components = (uint32_t)images[t].components;
+        }
+        else
+        {
+            if (images[t].compressedFormat)
+                LOG_WARN("[car_cook] KTX2 texture " << textureEntries[t]->path << " is transcoded at load, not cooked (using placeholder)");
+            else
+                LOG_WARN("[car_cook] Texture failed to load at path: " << textureEntries[t]->path << " (using placeholder)");
+            ct.width = ct.height = 1;
+            ct.components = 4;
+        }
+        ct.levels = MipChain::levelCount(ct.width, ct.height);
+        ct.encoding = encodingFor(textureTypes[t][0], (int)ct.components, compress, textureOcclusion[t]);
+        for (size_t k = 1; k < textureTypes[t].size(); ++k)
+            if (encodingFor(textureTypes[t][k], (int)ct.components, compress, textureOcclusion[t]) != ct.encoding)
+                ct.encoding = CookedFormat::RAW8;
+        if (ct.encoding == CookedFormat::RG8_GB)
+            ct.components = 2;
+        ct.dataSize = 0;
+        for (uint32_t level = 0; level < ct.levels; ++level)
+            ct.dataSize += CookedFormat::levelSize(ct, level);
+    }
+
+    // the proxy: each mesh's coarsest LOD over just the vertices it uses, and the textures from their first
+    // level of at most PROXY_TEXTURE texels on (cut from the full chain as it is written below)
+    Tables proxyTables = tables;
+    std::vector<std::vector<unsigned int> > proxyVertices(model.meshes.size()), proxyIndices(model.meshes.size());
+    std::vector<uint32_t> proxySkip(textures.size(), 0);
+    std::vector<std::vector<unsigned char> > proxyPixels(textures.size());
+    uint64_t proxyVertexCount = 0, proxyIndexCount = 0;
+    if (proxy)
+    {
+        proxyTables.meshLods.clear();
+        proxyTables.meshlets.clear();
+        for (size_t i = 0; i < model.meshes.size(); ++i)
+        {
+            const Mesh &m = model.meshes[i];
+            const std::vector<unsigned int> &coarse = m.lodIndices.empty() ? m.indices : m.lodIndices.back();
+            std::vector<unsigned int> remap(m.vertices.size(), ~0u);
+            proxyIndices[i].reserve(coarse.size());
+            for (size_t k = 0; k < coarse.size(); ++k)
+            {
+                if (remap[coarse[k]] == ~0u)
+                {
+                    remap[coarse[k]] = (unsigned int)proxyVertices[i].size();
+                    proxyVertices[i].push_back(coarse[k]);
+                }
+                proxyIndices[i].push_back(remap[coarse[k]]);
+            }
+            CookedFormat::Mesh &pm = proxyTables.meshes[i];
+            pm.baseVertex = (int32_t)proxyVertexCount;
+            pm.firstIndex = (uint32_t)proxyIndexCount;
+            pm.indexCount = (uint32_t)proxyIndices[i].size();
+            pm.vertexCount = (uint32_t)proxyVertices[i].size();
+            pm.firstLod = pm.lodCount = 0;
+            pm.firstMeshlet = pm.meshletCount = 0;
+            proxyVertexCount += proxyVertices[i].size();
+            proxyIndexCount += proxyIndices[i].size();
+        }
+        for (size_t t = 0; t < textures.size(); ++t)
+        {
+            const CookedFormat::Texture &ct = textures[t];
+            while (proxySkip[t] + 1 < ct.levels && std::max(ct.width >> proxySkip[t], ct.height >> proxySkip[t]) > CookedFormat::PROXY_TEXTURE)
+                proxySkip[t]++;
+            CookedFormat::Texture &pt = proxyTables.textures[t];
+            pt.width = std::max(1u, ct.width >> proxySkip[t]);
+            pt.height = std::max(1u, ct.height >> proxySkip[t]);
+            pt.levels = ct.levels - proxySkip[t];
+            pt.dataSize = 0;
+            for (uint32_t level = 0; level < pt.levels; ++level)
+                pt.dataSize += CookedFormat::levelSize(pt, level);
+        }
+    }
+
+    // layout
+    CookedFormat::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CookedFormat::MAGIC, 4);
+    header.version = CookedFormat::VERSION;
+    header.vertexStride = sizeof(PackedVertex);
+    // same rule as Model::uploadGeometry: indices are relative to baseVertex
+    bool shortIndices = true;
+    for (size_t i = 0; i < model.meshes.size(); ++i)
+        shortIndices = shortIndices && model.meshes[i].vertices.size() <= 65536;
+    header.indexSize = shortIndices ? 2 : 4;
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    header.sourceHash = sourceHash;
+    copyVec3(header.boundsMin, model.boundsMin);
+    copyVec3(header.boundsMax, model.boundsMax);
+    copyVec3(header.quantizationMin, model.quantizationMin);
+    copyVec3(header.quantizationMax, model.quantizationMax);
+    // the proxy's header is the model's, over its own tables (its vertices are quantized in the same box)
+    CookedFormat::Header proxyHeader = header;
+    proxyHeader.indexSize = 2;
+    for (size_t i = 0; i < proxyVertices.size(); ++i)
+        if (proxyVertices[i].size() > 65536)
+            proxyHeader.indexSize = 4;
+    proxyHeader.vertexCount = proxyVertexCount;
+    proxyHeader.indexCount = proxyIndexCount;
+    proxyHeader.fileSize = proxy ? layoutSections(proxyHeader, CookedFormat::alignUp(sizeof(proxyHeader)), proxyTables) : 0;
+    uint64_t cursor = CookedFormat::alignUp(sizeof(header));
+    if (proxy)
+    {
+        header.proxyOffset = cursor;
+        header.proxySize = proxyHeader.fileSize;
+        cursor = CookedFormat::alignUp(cursor + header.proxySize);
+    }
+    header.fileSize = layoutSections(header, cursor, tables);
+    for (size_t t = 0; t < textures.size(); ++t)
+    {
+        pixelBytes += textures[t].dataSize;
+        if (textures[t].encoding != CookedFormat::RAW8 && textures[t].encoding != CookedFormat::RG8_GB)
+            compressedCount++;
+    }
+
+    std::ofstream out(output.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        LOG_ERROR("[car_cook] Cannot write '" << output << "'");
+        return 1;
+    }
+    uint64_t written = 0;
+    out.write((const char *)&header, sizeof(header));
+    written += sizeof(header);
+    writePadding(out, written);
+    // the proxy's place, filled in once its texture levels have been cut from the chains below
+    if (proxy)
+    {
+        const std::vector<unsigned char> reserved((size_t)header.proxySize, 0);
+        out.write((const char *)&reserved[0], (std::streamsize)reserved.size());
+        written += reserved.size();
+        writePadding(out, written);
+    }
+    writeTables(out, written, tables);
+
+    // baked ambient occlusion per vertex (empty = unoccluded)
+    std::vector<std::vector<float> > occlusion(model.meshes.size());
+    if (occlusionRays > 0)
+    {
+        if (occlusionDistance <= 0.0f)
+            occlusionDistance = 0.1f * glm::length(model.boundsMax - model.boundsMin);
+        // everything opaque where it sits in model space, instanced meshes at each of their placements
+        OcclusionBake::TriangleBvh scene;
+        for (size_t i = 0; i < model.meshes.size(); ++i)
+        {
+            const Mesh &m = model.meshes[i];
+            if (m.transparent)
+                continue;
+            if (m.instances.empty())
+                OcclusionBake::addMesh(scene, m.vertices, m.indices, glm::mat4(1.0f));
+            for (size_t k = 0; k < m.instances.size(); ++k)
+                OcclusionBake::addMesh(scene, m.vertices, m.indices, m.instances[k]);
+        }
+        scene.build();
+        size_t bakedVertices = 0;
+        for (size_t i = 0; i < model.meshes.size(); ++i)
+        {
+            const Mesh &m = model.meshes[i];
+            if (m.transparent)
+                continue;
+            if (m.instances.empty())
+                OcclusionBake::bakeVertices(scene, m.vertices, glm::mat4(1.0f), occlusionRays, occlusionDistance, occlusion[i]);
+            else
+            {
+                OcclusionBake::TriangleBvh own;
+                OcclusionBake::addMesh(own, m.vertices, m.indices, glm::mat4(1.0f));
+                own.build();
+                OcclusionBake::bakeVertices(own, m.vertices, glm::mat4(1.0f), occlusionRays, occlusionDistance, occlusion[i]);
+            }
+            bakedVertices += m.vertices.size();
+        }
+        LOG_INFO("[car_cook] Baked ambient occlusion of " << bakedVertices << " vertices against " << scene.size() << " triangles ("
+                 << occlusionRays << " rays, distance " << occlusionDistance << ")");
+    }
+
+    // vertices, quantized exactly like Model::uploadGeometry
+    glm::vec3 extent = VertexPacking::quantizationExtent(model.quantizationMin, model.quantizationMax);
+    std::vector<PackedVertex> packed;
+    for (size_t i = 0; i < model.meshes.size(); ++i)
+    {
+        const Mesh &m = model.meshes[i];
+        packed.resize(m.vertices.size());
+        for (size_t v = 0; v < m.vertices.size(); ++v)
+            packed[v] = VertexPacking::pack(m.vertices, v, model.quantizationMin, extent, occlusion[i].empty() ? 1.0f : occlusion[i][v]);
+        if (!packed.empty())
+            out.write((const char *)&packed[0], (std::streamsize)(packed.size() * sizeof(PackedVertex)));
+        written += packed.size() * sizeof(PackedVertex);
+    }
+    writePadding(out, written);
+    for (size_t i = 0; i < model.meshes.size(); ++i)
+    {
+        const Mesh &m = model.meshes[i];
+        writeIndices(out, written, m.indices, header.indexSize);
+        for (size_t l = 0; l < m.lodIndices.size(); ++l)
+            writeIndices(out, written, m.lodIndices[l], header.indexSize);
+    }
+    writePadding(out, written);
+
+    // textures: level 0 as decoded, then the CPU-filtered chain
+    for (size_t t = 0; t < textures.size(); ++t)
+    {
+        const CookedFormat::Texture &ct = textures[t];
+        std::vector<unsigned char> level, next;
+        uint32_t sourceComponents = 4;
+        if (images[t].pixels && !images[t].compressedFormat && ct.width == (uint32_t)images[t].width)
+        {
+            sourceComponents = (uint32_t)images[t].components;
+            level.assign(images[t].pixels, images[t].pixels + (size_t)ct.width * ct.height * sourceComponents);
+        }
+        else
+        {
+            const unsigned char white[4] = {255, 255, 255, 255};
+            const unsigned char flatNormal[4] = {128, 128, 255, 255};
+            const unsigned char *p = textureEntries[t]->placeholder == TexturePlaceholder::FlatNormal ? flatNormal : white;
+            level.assign(p, p + 4);
+        }
+        if (ct.encoding == CookedFormat::RG8_GB)
+        {
+            // keep G/B only
+            size_t texels = level.size() / sourceComponents;
+            for (size_t i = 0; i < texels; ++i)
+            {
+                unsigned char g = level[i * sourceComponents + 1], b = level[i * sourceComponents + 2];
+                level[i * 2] = g;
+                level[i * 2 + 1] = b;
+            }
+            level.resize(texels * 2);
+        }
+        stbi_image_free(images[t].pixels);
+        images[t].pixels = NULL;
+        // the decode's pixels are gone; keep TextureCache from freeing them again on release
+        textureEntries[t]->uploaded = true;
+
+        uint32_t w = ct.width, h = ct.height;
+        const bool normalMap = textureEntries[t]->placeholder == TexturePlaceholder::FlatNormal;
+        std::vector<unsigned char> rgba, blocks;
+        for (uint32_t l = 0; l < ct.levels; ++l)
+        {
+            // mips are filtered from the uncompressed level, then each level is compressed on its own
+            const std::vector<unsigned char> *data = &level;
+            if (ct.encoding != CookedFormat::RAW8 && ct.encoding != CookedFormat::RG8_GB)
+            {
+                toRgba(level, ct.components, rgba);
+                BlockCompress::Format format = ct.encoding == CookedFormat::BC7 ? BlockCompress::BC7_RGBA
+                                             : ct.encoding == CookedFormat::BC5 ? BlockCompress::BC5_RG
+                                             : ct.encoding == CookedFormat::BC5_GB ? BlockCompress::BC5_GB
+                                                                                   : BlockCompress::BC4_R;
+                BlockCompress::compressLevel(rgba, w, h, format, blocks);
+                data = &blocks;
+            }
+            out.write((const char *)&(*data)[0], (std::streamsize)data->size());
+            written += data->size();
+            if (proxy && l >= proxySkip[t])
+                proxyPixels[t].insert(proxyPixels[t].end(), data->begin(), data->end());
+            if (l + 1 < ct.levels)
+            {
+                next.resize((size_t)(w > 1 ? w / 2 : 1) * (h > 1 ? h / 2 : 1) * ct.components);
+                MipChain::downsample(&level[0], w, h, ct.components, ct.gamma != 0, normalMap, &next[0]);
+                level.swap(next);
+                w = w > 1 ? w / 2 : 1;
+                h = h > 1 ? h / 2 : 1;
+            }
+        }
+        writePadding(out, written);
+    }
+
+    // the proxy, laid out like a file of its own at the front of this one
+    uint64_t proxyWritten = 0;
+    if (proxy)
+    {
+        std::ostringstream blob(std::ios::out | std::ios::binary);
+        blob.write((const char *)&proxyHeader, sizeof(proxyHeader));
+        proxyWritten += sizeof(proxyHeader);
+        writePadding(blob, proxyWritten);
+        writeTables(blob, proxyWritten, proxyTables);
+        for (size_t i = 0; i < model.meshes.size(); ++i)
+        {
+            const Mesh &m = model.meshes[i];
+            packed.resize(proxyVertices[i].size());
+            for (size_t v = 0; v < proxyVertices[i].size(); ++v)
+            {
+                const unsigned int source = proxyVertices[i][v];
+                packed[v] = VertexPacking::pack(m.vertices, source, model.quantizationMin, extent, occlusion[i].empty() ? 1.0f : occlusion[i][source]);
+            }
+            if (!packed.empty())
+                blob.write((const char *)&packed[0], (std::streamsize)(packed.size() * sizeof(PackedVertex)));
+            proxyWritten += packed.size() * sizeof(PackedVertex);
+        }
+        writePadding(blob, proxyWritten);
+        for (size_t i = 0; i < proxyIndices.size(); ++i)
+            writeIndices(blob, proxyWritten, proxyIndices[i], proxyHeader.indexSize);
+        writePadding(blob, proxyWritten);
+        for (size_t t = 0; t < proxyPixels.size(); ++t)
+        {
+            if (!proxyPixels[t].empty())
+                blob.write((const char *)&proxyPixels[t][0], (std::streamsize)proxyPixels[t].size());
+            proxyWritten += proxyPixels[t].size();
+            writePadding(blob, proxyWritten);
+        }
+        const std::string bytes = blob.str();
+        out.seekp((std::streamoff)header.proxyOffset);
+        out.write(bytes.data(), (std::streamsize)bytes.size());
+    }
+    out.close();
+    if (proxy && proxyWritten != proxyHeader.fileSize)
+    {
+        LOG_ERROR("[car_cook] Failed writing the proxy of '" << output << "' (" << proxyWritten << " of " << proxyHeader.fileSize << " bytes)");
+        std::remove(output.c_str());
+        return 1;
+    }
+    if (!out || written != header.fileSize)
+    {
+        LOG_ERROR("[car_cook] Failed writing '" << output << "' (" << written << " of " << header.fileSize << " bytes)");
+        std::remove(output.c_str());
+        return 1;
+    }
+    LOG_INFO("[car_cook] Wrote '" << output << "': " << meshes.size() << " meshes, " << textures.size() << " textures (" << compressedCount << " block-compressed, "
+             << foldedCount << " solid-colour uses folded into factors, "
+             << pixelBytes / (1024 * 1024) << " MiB with mips), vertices=" << vertexCount << " indices=" << indexCount
+             << ", " << header.fileSize / 1024 << " KiB total (proxy " << header.proxySize / 1024 << " KiB)");
+    return 0;
+}
@@ -0,0 +1,211 @@
+// car_farm: the coordinator of a render farm for batch jobs (include/render_farm.h).
+//
+//   car_farm <job.json> [--port N] [--chunk N] [--retries N] [--timeout S]
+//            [--gpus N] [--viewer PATH] [--gpu-env NAME]...
+//
+// Reads a BATCH_JOB file, expands its shots and turntable the way the viewer does, cuts them into chunks of
+// --chunk shots (default 8) and serves them on --port (default 7420) to the viewers started as workers with
+// BATCH_FARM=<this host>:<port>. Each worker loads the scene once and keeps asking for chunks; the images it
+// renders come back here and are saved under the job's "output" prefix with the names a local BATCH_JOB
+// would give them. A chunk goes out again when its worker disconnects, is quiet for --timeout seconds
+// (default 600) or sends failed images, at most --retries times (default 2). Progress is logged as chunks
+// come in; the exit code is 0 once every chunk is in.
+//
+// --gpus N also starts N workers on this machine, one process per GPU, each with its own context: the
+// viewer (--viewer, default ./main) with BATCH_FARM pointing here, BATCH_FARM_NAME=<host>-gpu<i> and
+// BATCH_FARM_DIR=farm_gpu<i>_, and every --gpu-env NAME set to its index <i> (default DRI_PRIME, which
+// Mesa honours; NVIDIA and other drivers pick a device through a variable of their own, or one GPU is
+// made visible per process by the system). The workers share the node's cooked models and IBL caches
+// through the OS file cache: both are mapped read-only (MappedFile), so each file is in memory once
+// however many workers render from it.
+#include <glad/glad.h>
+
+#include <async_log.h>
+#include <batch_renderer.h>
+#include <json.hpp>
+#include <render_farm.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+#ifdef _WIN32
+    typedef HANDLE Process;
+    const Process NO_PROCESS = NULL;
+#else
+    typedef pid_t Process;
+    const Process NO_PROCESS = -1;
+#endif
+
+    // starts `program` with this process's environment plus `env`
+    Process spawn(const std::string &program, const std::map<std::string, std::string> &env)
+    {
+#ifdef _WIN32
+        std::string block;
+        if (char *inherited = GetEnvironmentStringsA())
+        {
+            for (const char *var = inherited; *var; var += std::strlen(var) + 1)
+            {
+                const char *equals = std::strchr(var + 1, '=');
+                if (!equals || !env.count(std::string(var, equals)))
+                    block.append(var, std::strlen(var) + 1);
+            }
+            FreeEnvironmentStringsA(inherited);
+        }
+        for (std::map<std::string, std::string>::const_iterator it = env.begin(); it != env.end(); ++it)
+            block += it->first + "=" + it->second + '\0';
+        block += '\0';
+        std::string commandLine = "\"" + program + "\"";
+        STARTUPINFOA startup;
+        std::memset(&startup, 0, sizeof(startup));
+        startup.cb = sizeof(startup);
+        PROCESS_INFORMATION info;
+        if (!CreateProcessA(NULL, &commandLine[0], NULL, NULL, FALSE, 0, &block[0], NULL, &startup, &info))
+            return NO_PROCESS;
+        CloseHandle(info.hThread);
+        return info.hProcess;
+#else
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            for (std::map<std::string, std::string>::const_iterator it = env.begin(); it != env.end(); ++it)
+                setenv(it->first.c_str(), it->second.c_str(), 1);
+            execl(program.c_str(), program.c_str(), (char *)NULL);
+            _exit(127);
+        }
+        return pid < 0 ? NO_PROCESS : pid;
+#endif
+    }
+
+    // the worker's exit code (-1 if it couldn't be had)
+    int waitFor(Process process)
+    {
+#ifdef _WIN32
+        DWORD code = (DWORD)-1;
+        WaitForSingleObject(process, INFINITE);
+        GetExitCodeProcess(process, &code);
+        CloseHandle(process);
+        return (int)code;
+#else
+        int status = 0;
+        if (waitpid(process, &status, 0) != process || !WIFEXITED(status))
+            return -1;
+        return WEXITSTATUS(status);
+#endif
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string path;
+#ifdef _WIN32
+    std::string viewer = "main.exe";
+#else
+    std::string viewer = "./main";
+#endif
+    FarmCoordinator::Options options;
+    int gpus = 0;
+    std::vector<std::string> gpuEnv;
+    bool usage = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc)
+            options.port = std::atoi(argv[++i]);
+        else if (arg == "--chunk" && i + 1 < argc)
+            options.chunkShots = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--retries" && i + 1 < argc)
+            options.retries = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--timeout" && i + 1 < argc)
+            options.chunkTimeout = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--gpus" && i + 1 < argc)
+            gpus = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--viewer" && i + 1 < argc)
+            viewer = argv[++i];
+        else if (arg == "--gpu-env" && i + 1 < argc)
+            gpuEnv.push_back(argv[++i]);
+        else if (path.empty() && arg.compare(0, 2, "--") != 0)
+            path = arg;
+        else
+            usage = true;
+    }
+    if (path.empty() || usage || options.port <= 0 || options.port > 65535)
+    {
+        LOG_INFO("usage: car_farm <job.json> [--port N] [--chunk N] [--retries N] [--timeout S] [--gpus N] [--viewer PATH] "
+                 "[--gpu-env NAME]...");
+        asyncLog().flush();
+        return 1;
+    }
+
+    nlohmann::json job;
+    std::vector<nlohmann::json> shots;
+    try
+    {
+        std::ifstream in(path.c_str());
+        if (!in)
+        {
+            LOG_ERROR("[car_farm] Can't open job file " << path);
+            asyncLog().flush();
+            return 1;
+        }
+        job = nlohmann::json::parse(in);
+        shots = BatchRenderer::shotEntries(job);
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR("[car_farm] Bad job file " << path << ": " << e.what());
+        asyncLog().flush();
+        return 1;
+    }
+    if (shots.empty())
+    {
+        LOG_WARN("[car_farm] " << path << " lists no shots");
+        asyncLog().flush();
+        return 1;
+    }
+
+    FarmCoordinator coordinator(job, shots, options);
+    if (!coordinator.open())
+    {
+        asyncLog().flush();
+        return 1;
+    }
+    if (gpuEnv.empty())
+        gpuEnv.push_back("DRI_PRIME");
+    std::vector<Process> workers;
+    for (int gpu = 0; gpu < gpus; ++gpu)
+    {
+        const std::string index = std::to_string(gpu);
+        std::map<std::string, std::string> env;
+        env["BATCH_FARM"] = "127.0.0.1:" + std::to_string(options.port);
+        env["BATCH_FARM_NAME"] = farm::hostName() + "-gpu" + index;
+        env["BATCH_FARM_DIR"] = "farm_gpu" + index + "_";
+        for (size_t i = 0; i < gpuEnv.size(); ++i)
+            env[gpuEnv[i]] = index;
+        const Process worker = spawn(viewer, env);
+        if (worker == NO_PROCESS)
+            LOG_ERROR("[car_farm] Can't start " << viewer << " for GPU " << gpu);
+        else
+            workers.push_back(worker);
+    }
+    if (gpus > 0)
+        LOG_INFO("[car_farm] " << workers.size() << " local workers started, one per GPU");
+    const bool ok = coordinator.run();
+    for (size_t i = 0; i < workers.size(); ++i)
+        if (const int code = waitFor(workers[i]))
+            LOG_WARN("[car_farm] Local worker " << i << " exited with " << code);
+    asyncLog().flush();
+    return ok ? 0 : 1;
+}
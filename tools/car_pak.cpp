@@ -0,0 +1,176 @@
+// car_pak: packs a model directory into a single .carpak archive.
+//
+//   car_pak <model directory> [output.carpak]
+//
+// The output defaults to <directory>.carpak next to the directory, which is where VirtualFileSystem looks
+// for it when a file below the directory is missing; ship it instead of the directory (loose files, if
+// present, still win). The archive is a plain zip: geometry (.bin), cooked models and images are stored
+// uncompressed with their data 4 KB aligned (a padding extra field in the local header, the id zipalign
+// uses), so the viewer maps them in place; text (.gltf, .json, ...) is deflated and inflated on open.
+// Run car_cook first so the .cooked file goes in too.
+#include <async_log.h>
+#include <mapped_file.h>
+#include <virtual_file_system.h>
+
+#include "miniz.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    const size_t DATA_ALIGNMENT = 4096;
+    // local extra-field id for alignment padding (Android's zipalign uses the same one)
+    const unsigned short ALIGNMENT_EXTRA_ID = 0xD935;
+
+    // file paths below `root`, relative to it with '/' separators
+    void listFiles(const std::string &root, const std::string &relative, std::vector<std::string> &out)
+    {
+        const std::string dir = relative.empty() ? root : root + '/' + relative;
+#ifdef _WIN32
+        WIN32_FIND_DATAA found;
+        HANDLE find = FindFirstFileA((dir + "/*").c_str(), &found);
+        if (find == INVALID_HANDLE_VALUE)
+            return;
+        do
+        {
+            std::string name = found.cFileName;
+            if (name == "." || name == "..")
+                continue;
+            std::string path = relative.empty() ? name : relative + '/' + name;
+            if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                listFiles(root, path, out);
+            else
+                out.push_back(path);
+        } while (FindNextFileA(find, &found));
+        FindClose(find);
+#else
+        DIR *handle = opendir(dir.c_str());
+        if (!handle)
+            return;
+        while (dirent *found = readdir(handle))
+        {
+            std::string name = found->d_name;
+            if (name == "." || name == "..")
+                continue;
+            std::string path = relative.empty() ? name : relative + '/' + name;
+            struct stat st;
+            if (stat((root + '/' + path).c_str(), &st) != 0)
+                continue;
+            if (S_ISDIR(st.st_mode))
+                listFiles(root, path, out);
+            else if (S_ISREG(st.st_mode))
+                out.push_back(path);
+        }
+        closedir(handle);
+#endif
+    }
+
+    // text compresses well and is parsed from a copy anyway; everything else is mapped in place
+    bool deflates(const std::string &path)
+    {
+        static const char *const TEXT[] = {".gltf", ".json", ".txt", ".obj", ".mtl"};
+        std::string lower = path;
+        for (size_t i = 0; i < lower.size(); ++i)
+            lower[i] = (char)std::tolower((unsigned char)lower[i]);
+        for (size_t i = 0; i < sizeof(TEXT) / sizeof(TEXT[0]); ++i)
+        {
+            size_t n = std::strlen(TEXT[i]);
+            if (lower.size() >= n && lower.compare(lower.size() - n, n, TEXT[i]) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        LOG_INFO("usage: car_pak <model directory> [output.carpak]");
+        return 1;
+    }
+    std::string input = VirtualFileSystem::canonicalPath(argv[1]);
+    std::string output = argc > 2 ? std::string(argv[2]) : input + VirtualFileSystem::archiveExtension();
+
+    std::vector<std::string> files;
+    listFiles(input, std::string(), files);
+    std::sort(files.begin(), files.end());
+    if (files.empty())
+    {
+        LOG_ERROR("[car_pak] No files under '" << input << "'");
+        return 1;
+    }
+
+    mz_zip_archive zip;
+    std::memset(&zip, 0, sizeof(zip));
+    if (!mz_zip_writer_init_file(&zip, output.c_str(), 0))
+    {
+        LOG_ERROR("[car_pak] Cannot create '" << output << "'");
+        return 1;
+    }
+    uint64_t storedBytes = 0, deflatedInput = 0;
+    std::vector<char> padding;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        const std::string &name = files[i];
+        MappedFile file;
+        const bool opened = file.open(input + '/' + name);
+        const void *data = opened ? (const void *)file.data() : (const void *)"";
+        const size_t size = opened ? file.size() : 0;
+        bool ok;
+        if (deflates(name))
+        {
+            ok = mz_zip_writer_add_mem_ex_v2(&zip, name.c_str(), data, size, NULL, 0, MZ_BEST_COMPRESSION, 0, 0, NULL, NULL, 0, NULL, 0) != 0;
+            deflatedInput += size;
+        }
+        else
+        {
+            // the local header (30 bytes + name + extra) starts at the current end of the archive; pad its
+            // extra field so the data after it lands on DATA_ALIGNMENT
+            const size_t headerEnd = (size_t)zip.m_archive_size + 30 + name.size() + 4;
+            const size_t pad = (DATA_ALIGNMENT - headerEnd % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+            padding.assign(4 + pad, 0);
+            padding[0] = (char)(ALIGNMENT_EXTRA_ID & 0xFF);
+            padding[1] = (char)(ALIGNMENT_EXTRA_ID >> 8);
+            padding[2] = (char)(pad & 0xFF);
+            padding[3] = (char)(pad >> 8);
+            ok = mz_zip_writer_add_mem_ex_v2(&zip, name.c_str(), data, size, NULL, 0, MZ_NO_COMPRESSION, 0, 0, NULL,
+                                             &padding[0], (mz_uint)padding.size(), NULL, 0) != 0;
+            storedBytes += size;
+        }
+        if (!ok)
+        {
+            LOG_ERROR("[car_pak] Adding '" << name << "' failed: " << mz_zip_get_error_string(mz_zip_get_last_error(&zip)));
+            mz_zip_writer_end(&zip);
+            return 1;
+        }
+    }
+    if (!mz_zip_writer_finalize_archive(&zip))
+    {
+        LOG_ERROR("[car_pak] Writing '" << output << "' failed: " << mz_zip_get_error_string(mz_zip_get_last_error(&zip)));
+        mz_zip_writer_end(&zip);
+        return 1;
+    }
+    const uint64_t archiveSize = zip.m_archive_size;
+    mz_zip_writer_end(&zip);
+    LOG_INFO("[car_pak] Wrote '" << output << "': " << files.size() << " files, " << storedBytes / 1024 << " KB stored, "
+             << deflatedInput / 1024 << " KB deflated, " << archiveSize / 1024 << " KB in all");
+    return 0;
+}
@@ -0,0 +1,988 @@
+// car_replay: plays back a frame the viewer recorded with GL_CAPTURE (include/gl_capture.h) and times it.
+//
+//   car_replay <capture file> [--loops N] [--warmup N] [--hidden] [--json FILE]
+//
+// Opens a window the size of the recorded one, recreates the objects the frame used from the file, then
+// replays the prologue (the state the frame started with) and the frame's calls N times (default 200,
+// after 20 warm-up loops), swapping after each with vsync off. Every loop is timed on the GPU (a
+// GL_TIME_ELAPSED query around it) and on the CPU, both for submitting the calls and until the GPU has
+// finished them (glFinish), and the minimum, median, average and p99 of each are reported; --json FILE
+// saves them. Since there is no application work around the calls, the CPU submit time is what the
+// driver costs for the frame, and the same capture replayed on another driver or machine compares them.
+// Captures hold programs as shader sources, except those the shader cache loaded: capture with
+// SHADER_CACHE=0 to replay on a different driver.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+#include <gl_capture.h>
+#include <json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using namespace glcapture;
+
+    template <size_t... I>
+    struct Indices
+    {
+    };
+    template <size_t N, size_t... I>
+    struct MakeIndices : MakeIndices<N - 1, N - 1, I...>
+    {
+    };
+    template <size_t... I>
+    struct MakeIndices<0, I...>
+    {
+        typedef Indices<I...> type;
+    };
+
+    // a scalar call's argument as the recorder wrote it: pointers went in as 64-bit buffer offsets
+    template <class T>
+    struct Arg
+    {
+        static T read(Reader &r) { return r.get<T>(); }
+    };
+    template <class T>
+    struct Arg<T *>
+    {
+        static T *read(Reader &r) { return (T *)(uintptr_t)r.get<uint64_t>(); }
+    };
+
+    struct Stats
+    {
+        double min = 0, median = 0, avg = 0, p99 = 0;
+
+        static Stats of(std::vector<double> values)
+        {
+            Stats s;
+            if (values.empty())
+                return s;
+            std::sort(values.begin(), values.end());
+            s.min = values.front();
+            s.median = values[values.size() / 2];
+            s.p99 = values[std::min(values.size() - 1, values.size() * 99 / 100)];
+            for (size_t i = 0; i < values.size(); ++i)
+                s.avg += values[i];
+            s.avg /= (double)values.size();
+            return s;
+        }
+        nlohmann::json toJson() const { return {{"min_ms", min}, {"median_ms", median}, {"avg_ms", avg}, {"p99_ms", p99}}; }
+    };
+
+    class Replay
+    {
+    public:
+        Header header;
+        std::vector<unsigned char> file;
+        Reader resources, prologue, frame;
+
+        bool load(const std::string &path)
+        {
+            std::ifstream in(path.c_str(), std::ios::binary);
+            if (!in)
+                return false;
+            file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            if (file.size() < sizeof(Header))
+                return false;
+            std::memcpy(&header, &file[0], sizeof(Header));
+            if (header.magic != MAGIC || header.version != VERSION)
+                return false;
+            Reader sections(&file[sizeof(Header)], file.size() - sizeof(Header));
+            Reader *parts[3] = {&resources, &prologue, &frame};
+            for (int i = 0; i < 3; ++i)
+            {
+                size_t size = 0;
+                const unsigned char *data = sections.getBytes(size);
+                *parts[i] = Reader(data, size);
+            }
+            return !sections.failed;
+        }
+
+        // creates the recorded objects; false if the file ends early
+        bool createResources()
+        {
+            Reader r = resources;
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glActiveTexture(GL_TEXTURE0);
+            while (!r.done() && !r.failed)
+            {
+                const uint16_t op = r.get<uint16_t>();
+                switch (op)
+                {
+                case RESOURCE_BUFFER: createBuffer(r); break;
+                case RESOURCE_TEXTURE: createTexture(r); break;
+                case RESOURCE_TEXTURE_BUFFER: createTextureBuffer(r); break;
+                case RESOURCE_RENDERBUFFER: createRenderbuffer(r); break;
+                case RESOURCE_PROGRAM: createProgram(r); break;
+                case RESOURCE_VERTEX_ARRAY: createVertexArray(r); break;
+                case RESOURCE_FRAMEBUFFER: createFramebuffer(r); break;
+                default:
+                    LOG_ERROR("[car_replay] Unknown resource record " << op);
+                    return false;
+                }
+            }
+            glBindVertexArray(0);
+            glUseProgram(0);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return !r.failed;
+        }
+
+        // plays a section's calls; false if the file ends early or holds an unknown op
+        bool run(Reader r)
+        {
+            while (!r.done() && !r.failed)
+            {
+                const uint16_t op = r.get<uint16_t>();
+                if (!call(op, r))
+                {
+                    LOG_ERROR("[car_replay] Unknown call " << op);
+                    return false;
+                }
+            }
+            return !r.failed;
+        }
+
+        // calls the replay's driver lacks (skipped), by op
+        std::set<uint16_t> missing;
+
+    private:
+        std::map<GLuint, GLuint> names[NAME_KINDS];
+        // (recorded program, recorded location) -> this replay's location
+        std::map<uint64_t, GLint> locations;
+        GLuint currentProgram = 0;
+        GLuint lastProgramArgument = 0;
+
+        GLuint name(int kind, GLuint recorded)
+        {
+            if (!recorded)
+                return 0;
+            std::map<GLuint, GLuint>::const_iterator it = names[kind].find(recorded);
+            if (it != names[kind].end())
+                return it->second;
+            // not in the file (e.g. a texture target the capture doesn't cover): a fresh name keeps binds valid
+            GLuint fresh = 0;
+            switch (kind)
+            {
+            case TEXTURE: glGenTextures(1, &fresh); break;
+            case BUFFER: glGenBuffers(1, &fresh); break;
+            case FRAMEBUFFER: glGenFramebuffers(1, &fresh); break;
+            case RENDERBUFFER: glGenRenderbuffers(1, &fresh); break;
+            case VERTEX_ARRAY: glGenVertexArrays(1, &fresh); break;
+            default: break;
+            }
+            names[kind][recorded] = fresh;
+            return fresh;
+        }
+        GLint location(GLint recorded)
+        {
+            std::map<uint64_t, GLint>::const_iterator it = locations.find((uint64_t)currentProgram << 32 | (uint32_t)recorded);
+            return it != locations.end() ? it->second : recorded;
+        }
+
+        template <class T>
+        T remap(char letter, T value)
+        {
+            if (letter == 'L')
+                return (T)location((GLint)value);
+            const int kind = nameKind(letter);
+            if (kind < 0)
+                return value;
+            if (kind == PROGRAM)
+                lastProgramArgument = (GLuint)value;
+            return (T)name(kind, (GLuint)value);
+        }
+        template <class T>
+        T *remap(char, T *value)
+        {
+            return value;
+        }
+
+        template <class... A, size_t... I>
+        void callScalar(const char *letters, void(APIENTRYP function)(A...), std::tuple<A...> &args, Indices<I...>)
+        {
+            int expand[] = {0, (std::get<I>(args) = remap(letters[I], std::get<I>(args)), 0)...};
+            (void)expand;
+            function(std::get<I>(args)...);
+        }
+        template <class... A>
+        void scalar(uint16_t op, Reader &r, void(APIENTRYP function)(A...))
+        {
+            // a braced list reads the arguments left to right
+            std::tuple<A...> args{Arg<A>::read(r)...};
+            if (!function)
+            {
+                missing.insert(op);
+                return;
+            }
+            callScalar(scalarNames(op), function, args, typename MakeIndices<sizeof...(A)>::type());
+            if (op == USE_PROGRAM)
+                currentProgram = lastProgramArgument;
+        }
+
+        const void *pixels(Reader &r)
+        {
+            const uint8_t source = r.get<uint8_t>();
+            if (source == PIXELS_UNPACK_OFFSET)
+                return (const void *)(uintptr_t)r.get<uint64_t>();
+            if (source == PIXELS_BYTES)
+            {
+                size_t size = 0;
+                return r.getBytes(size);
+            }
+            return nullptr;
+        }
+
+        template <class F>
+        bool have(uint16_t op, F function)
+        {
+            if (function)
+                return true;
+            missing.insert(op);
+            return false;
+        }
+
+        // names the frame created: made again on every loop, so storage calls find fresh objects
+        void createNames(Reader &r, bool create)
+        {
+            const int kind = r.get<uint8_t>();
+            const GLenum target = create ? r.get<GLenum>() : 0;
+            const int32_t n = r.get<int32_t>();
+            for (int32_t i = 0; i < n && kind < NAME_KINDS; ++i)
+            {
+                const GLuint recorded = r.get<GLuint>();
+                GLuint &mapped = names[kind][recorded];
+                GLuint fresh = 0;
+                switch (kind)
+                {
+                case TEXTURE:
+                    if (mapped) glDeleteTextures(1, &mapped);
+                    if (create && glad_glCreateTextures) glCreateTextures(target, 1, &fresh);
+                    else glGenTextures(1, &fresh);
+                    break;
+                case BUFFER:
+                    if (mapped) glDeleteBuffers(1, &mapped);
+                    if (create && glad_glCreateBuffers) glCreateBuffers(1, &fresh);
+                    else glGenBuffers(1, &fresh);
+                    break;
+                case FRAMEBUFFER:
+                    if (mapped) glDeleteFramebuffers(1, &mapped);
+                    if (create && glad_glCreateFramebuffers) glCreateFramebuffers(1, &fresh);
+                    else glGenFramebuffers(1, &fresh);
+                    break;
+                case RENDERBUFFER:
+                    if (mapped) glDeleteRenderbuffers(1, &mapped);
+                    if (create && glad_glCreateRenderbuffers) glCreateRenderbuffers(1, &fresh);
+                    else glGenRenderbuffers(1, &fresh);
+                    break;
+                case VERTEX_ARRAY:
+                    if (mapped) glDeleteVertexArrays(1, &mapped);
+                    if (create && glad_glCreateVertexArrays) glCreateVertexArrays(1, &fresh);
+                    else glGenVertexArrays(1, &fresh);
+                    break;
+                default:
+                    break;
+                }
+                mapped = fresh;
+            }
+        }
+
+        bool call(uint16_t op, Reader &r)
+        {
+            switch (op)
+            {
+#define GL_CAPTURE_REPLAY(code, function, letters) \
+    case code:                                     \
+        scalar(code, r, glad_##function);          \
+        return true;
+                GL_CAPTURE_SCALAR_CALLS(GL_CAPTURE_REPLAY)
+#undef GL_CAPTURE_REPLAY
+            case UNIFORM_FLOATS:
+            {
+                const uint8_t shape = r.get<uint8_t>();
+                const GLint at = location(r.get<int32_t>());
+                const GLsizei count = r.get<int32_t>();
+                const GLboolean transpose = r.get<uint8_t>();
+                size_t size = 0;
+                const GLfloat *values = (const GLfloat *)r.getBytes(size);
+                switch (shape)
+                {
+                case 1: glUniform1fv(at, count, values); break;
+                case 2: glUniform2fv(at, count, values); break;
+                case 3: glUniform3fv(at, count, values); break;
+                case 4: glUniform4fv(at, count, values); break;
+                case 0x22: glUniformMatrix2fv(at, count, transpose, values); break;
+                case 0x33: glUniformMatrix3fv(at, count, transpose, values); break;
+                case 0x44: glUniformMatrix4fv(at, count, transpose, values); break;
+                default: break;
+                }
+                return true;
+            }
+            case BUFFER_DATA:
+            case BUFFER_STORAGE:
+            case NAMED_BUFFER_DATA:
+            case NAMED_BUFFER_STORAGE:
+            {
+                const bool named = op == NAMED_BUFFER_DATA || op == NAMED_BUFFER_STORAGE;
+                GLuint target = r.get<GLuint>();
+                if (named)
+                    target = name(BUFFER, target);
+                const GLsizeiptr size = (GLsizeiptr)r.get<int64_t>();
+                const GLenum usage = r.get<GLenum>();
+                size_t length = 0;
+                const void *data = r.getBytes(length);
+                if (op == BUFFER_DATA)
+                    glBufferData(target, size, data, usage);
+                else if (op == BUFFER_STORAGE && have(op, glad_glBufferStorage))
+                    glBufferStorage(target, size, data, usage);
+                else if (op == NAMED_BUFFER_DATA && have(op, glad_glNamedBufferData))
+                    glNamedBufferData(target, size, data, usage);
+                else if (op == NAMED_BUFFER_STORAGE && have(op, glad_glNamedBufferStorage))
+                    glNamedBufferStorage(target, size, data, usage);
+                return true;
+            }
+            case BUFFER_SUB_DATA:
+            case NAMED_BUFFER_SUB_DATA:
+            case MAPPED_WRITE:
+            {
+                GLuint target = r.get<GLuint>();
+                const GLintptr offset = (GLintptr)r.get<int64_t>();
+                size_t size = 0;
+                const void *data = r.getBytes(size);
+                if (op == BUFFER_SUB_DATA)
+                    glBufferSubData(target, offset, (GLsizeiptr)size, data);
+                else if (op == NAMED_BUFFER_SUB_DATA && have(op, glad_glNamedBufferSubData))
+                    glNamedBufferSubData(name(BUFFER, target), offset, (GLsizeiptr)size, data);
+                else if (op == MAPPED_WRITE && size)
+                {
+                    // written the way the frame did it, so immutable buffers take it too
+                    void *mapped = glMapBufferRange(target, offset, (GLsizeiptr)size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+                    if (mapped)
+                    {
+                        std::memcpy(mapped, data, size);
+                        glUnmapBuffer(target);
+                    }
+                }
+                return true;
+            }
+            case TEX_IMAGE_2D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>(), internalFormat = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>();
+                const GLint border = r.get<GLint>();
+                const GLenum format = r.get<GLenum>(), type = r.get<GLenum>();
+                glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels(r));
+                return true;
+            }
+            case TEX_IMAGE_3D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>(), internalFormat = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>(), depth = r.get<GLsizei>();
+                const GLint border = r.get<GLint>();
+                const GLenum format = r.get<GLenum>(), type = r.get<GLenum>();
+                glTexImage3D(target, level, internalFormat, width, height, depth, border, format, type, pixels(r));
+                return true;
+            }
+            case TEX_SUB_IMAGE_2D:
+            case TEXTURE_SUB_IMAGE_2D:
+            {
+                const GLuint target = r.get<GLuint>();
+                const GLint level = r.get<GLint>(), x = r.get<GLint>(), y = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>();
+                const GLenum format = r.get<GLenum>(), type = r.get<GLenum>();
+                const void *data = pixels(r);
+                if (op == TEX_SUB_IMAGE_2D)
+                    glTexSubImage2D(target, level, x, y, width, height, format, type, data);
+                else if (have(op, glad_glTextureSubImage2D))
+                    glTextureSubImage2D(name(TEXTURE, target), level, x, y, width, height, format, type, data);
+                return true;
+            }
+            case TEX_SUB_IMAGE_3D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>(), x = r.get<GLint>(), y = r.get<GLint>(), z = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>(), depth = r.get<GLsizei>();
+                const GLenum format = r.get<GLenum>(), type = r.get<GLenum>();
+                glTexSubImage3D(target, level, x, y, z, width, height, depth, format, type, pixels(r));
+                return true;
+            }
+            case COMPRESSED_TEX_IMAGE_2D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>();
+                const GLenum internalFormat = r.get<GLenum>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>();
+                const GLint border = r.get<GLint>();
+                const GLsizei size = r.get<GLsizei>();
+                glCompressedTexImage2D(target, level, internalFormat, width, height, border, size, pixels(r));
+                return true;
+            }
+            case COMPRESSED_TEX_IMAGE_3D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>();
+                const GLenum internalFormat = r.get<GLenum>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>(), depth = r.get<GLsizei>();
+                const GLint border = r.get<GLint>();
+                const GLsizei size = r.get<GLsizei>();
+                glCompressedTexImage3D(target, level, internalFormat, width, height, depth, border, size, pixels(r));
+                return true;
+            }
+            case COMPRESSED_TEX_SUB_IMAGE_2D:
+            case COMPRESSED_TEXTURE_SUB_IMAGE_2D:
+            {
+                const GLuint target = r.get<GLuint>();
+                const GLint level = r.get<GLint>(), x = r.get<GLint>(), y = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>();
+                const GLenum format = r.get<GLenum>();
+                const GLsizei size = r.get<GLsizei>();
+                const void *data = pixels(r);
+                if (op == COMPRESSED_TEX_SUB_IMAGE_2D)
+                    glCompressedTexSubImage2D(target, level, x, y, width, height, format, size, data);
+                else if (have(op, glad_glCompressedTextureSubImage2D))
+                    glCompressedTextureSubImage2D(name(TEXTURE, target), level, x, y, width, height, format, size, data);
+                return true;
+            }
+            case COMPRESSED_TEX_SUB_IMAGE_3D:
+            {
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<GLint>(), x = r.get<GLint>(), y = r.get<GLint>(), z = r.get<GLint>();
+                const GLsizei width = r.get<GLsizei>(), height = r.get<GLsizei>(), depth = r.get<GLsizei>();
+                const GLenum format = r.get<GLenum>();
+                const GLsizei size = r.get<GLsizei>();
+                glCompressedTexSubImage3D(target, level, x, y, z, width, height, depth, format, size, pixels(r));
+                return true;
+            }
+            case DRAW_BUFFERS:
+            {
+                const int32_t n = r.get<int32_t>();
+                std::vector<GLenum> buffers;
+                for (int32_t i = 0; i < n; ++i)
+                    buffers.push_back(r.get<GLenum>());
+                glDrawBuffers(n, buffers.empty() ? nullptr : &buffers[0]);
+                return true;
+            }
+            case CLEAR_BUFFER:
+            {
+                const uint8_t kind = r.get<uint8_t>();
+                const GLenum buffer = r.get<GLenum>();
+                const GLint drawBuffer = r.get<int32_t>();
+                uint32_t values[4];
+                for (int i = 0; i < 4; ++i)
+                    values[i] = r.get<uint32_t>();
+                if (kind == 0)
+                    glClearBufferfv(buffer, drawBuffer, (const GLfloat *)values);
+                else if (kind == 1)
+                    glClearBufferiv(buffer, drawBuffer, (const GLint *)values);
+                else
+                    glClearBufferuiv(buffer, drawBuffer, (const GLuint *)values);
+                return true;
+            }
+            case MULTI_DRAW_ELEMENTS_BASE_VERTEX:
+            {
+                const GLenum mode = r.get<GLenum>(), type = r.get<GLenum>();
+                const int32_t draws = r.get<int32_t>();
+                std::vector<GLsizei> counts;
+                std::vector<const void *> offsets;
+                std::vector<GLint> baseVertices;
+                for (int32_t i = 0; i < draws; ++i)
+                {
+                    counts.push_back(r.get<int32_t>());
+                    offsets.push_back((const void *)(uintptr_t)r.get<uint64_t>());
+                    baseVertices.push_back(r.get<int32_t>());
+                }
+                if (draws > 0)
+                    glMultiDrawElementsBaseVertex(mode, &counts[0], type, &offsets[0], draws, &baseVertices[0]);
+                return true;
+            }
+            case TEX_PARAMETER_IV:
+            {
+                const GLenum target = r.get<GLenum>(), pname = r.get<GLenum>();
+                GLint values[4];
+                for (int i = 0; i < 4; ++i)
+                    values[i] = r.get<GLint>();
+                glTexParameteriv(target, pname, values);
+                return true;
+            }
+            case CLEAR_BUFFER_DATA:
+            {
+                const GLenum target = r.get<GLenum>(), internalFormat = r.get<GLenum>(), format = r.get<GLenum>(), type = r.get<GLenum>();
+                size_t size = 0;
+                const void *data = r.getBytes(size);
+                if (have(op, glad_glClearBufferData))
+                    glClearBufferData(target, internalFormat, format, type, data);
+                return true;
+            }
+            case GEN_NAMES:
+                createNames(r, false);
+                return true;
+            case CREATE_NAMES:
+                createNames(r, true);
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void createBuffer(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLenum usage = r.get<GLenum>();
+            const int64_t size = r.get<int64_t>();
+            size_t length = 0;
+            const void *data = r.getBytes(length);
+            const GLuint buffer = name(BUFFER, recorded);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            // immutable buffers come back mutable, so the frame's uploads and maps still work
+            glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)size, length == (size_t)size ? data : nullptr,
+                         usage ? usage : GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        void createTexture(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLenum target = r.get<GLenum>();
+            const int32_t samples = r.get<int32_t>();
+            GLenum params[9];
+            GLint values[9];
+            for (int p = 0; p < 9; ++p)
+            {
+                params[p] = r.get<GLenum>();
+                values[p] = r.get<int32_t>();
+            }
+            const GLuint texture = name(TEXTURE, recorded);
+            glBindTexture(target, texture);
+            const int32_t levels = r.get<int32_t>();
+            const GLenum levelTarget = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : target;
+            const int faces = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+            for (int32_t level = 0; level < levels && !r.failed; ++level)
+            {
+                const GLsizei width = r.get<int32_t>(), height = r.get<int32_t>(), depth = r.get<int32_t>();
+                const GLenum internalFormat = r.get<GLenum>();
+                const bool compressed = r.get<uint8_t>() != 0;
+                const GLenum format = r.get<GLenum>(), type = r.get<GLenum>();
+                for (int face = 0; face < faces; ++face)
+                {
+                    size_t size = 0;
+                    const void *data = r.getBytes(size);
+                    const GLenum faceTarget = levelTarget + (GLenum)face;
+                    const bool layered = target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_3D;
+                    if (samples)
+                        glTexImage2DMultisample(target, samples, internalFormat, width, height, GL_TRUE);
+                    else if (compressed && layered)
+                        glCompressedTexImage3D(target, level, internalFormat, width, height, depth, 0, (GLsizei)size, data);
+                    else if (compressed)
+                        glCompressedTexImage2D(faceTarget, level, internalFormat, width, height, 0, (GLsizei)size, data);
+                    else if (layered)
+                        glTexImage3D(target, level, (GLint)internalFormat, width, height, depth, 0, format, type, data);
+                    else
+                        glTexImage2D(faceTarget, level, (GLint)internalFormat, width, height, 0, format, type, data);
+                }
+            }
+            if (!samples)
+                for (int p = 0; p < 9; ++p)
+                    glTexParameteri(target, params[p], values[p]);
+            glBindTexture(target, 0);
+        }
+
+        void createTextureBuffer(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLenum internalFormat = r.get<GLenum>();
+            const GLuint buffer = r.get<GLuint>();
+            glBindTexture(GL_TEXTURE_BUFFER, name(TEXTURE, recorded));
+            glTexBuffer(GL_TEXTURE_BUFFER, internalFormat, name(BUFFER, buffer));
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+        }
+
+        void createRenderbuffer(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLenum internalFormat = r.get<GLenum>();
+            const GLsizei width = r.get<int32_t>(), height = r.get<int32_t>(), samples = r.get<int32_t>();
+            glBindRenderbuffer(GL_RENDERBUFFER, name(RENDERBUFFER, recorded));
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, width, height);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        }
+
+        void createProgram(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLuint program = glCreateProgram();
+            names[PROGRAM][recorded] = program;
+            const int32_t shaders = r.get<int32_t>();
+            std::vector<GLuint> stages;
+            for (int32_t i = 0; i < shaders; ++i)
+            {
+                const GLenum type = r.get<GLenum>();
+                const std::string source = r.getString();
+                const char *text = source.c_str();
+                const GLuint shader = glCreateShader(type);
+                glShaderSource(shader, 1, &text, nullptr);
+                glCompileShader(shader);
+                glAttachShader(program, shader);
+                stages.push_back(shader);
+            }
+            const GLenum binaryFormat = r.get<GLenum>();
+            size_t binarySize = 0;
+            const void *binary = r.getBytes(binarySize);
+            if (stages.empty() && binary && glad_glProgramBinary)
+                glProgramBinary(program, binaryFormat, binary, (GLsizei)binarySize);
+            else
+                glLinkProgram(program);
+            for (size_t i = 0; i < stages.size(); ++i)
+                glDeleteShader(stages[i]);
+            GLint linked = 0;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            if (!linked)
+                LOG_WARN("[car_replay] Program " << recorded
+                                                 << (stages.empty() ? " came from the shader cache and this driver rejects its binary (capture with SHADER_CACHE=0)"
+                                                                    : " doesn't link here"));
+
+            const int32_t blocks = r.get<int32_t>();
+            for (int32_t b = 0; b < blocks; ++b)
+            {
+                const std::string block = r.getString();
+                const GLuint binding = r.get<GLuint>();
+                const GLuint index = glGetUniformBlockIndex(program, block.c_str());
+                if (linked && index != GL_INVALID_INDEX)
+                    glUniformBlockBinding(program, index, binding);
+            }
+            const int32_t uniforms = r.get<int32_t>();
+            if (linked)
+                glUseProgram(program);
+            for (int32_t u = 0; u < uniforms; ++u)
+            {
+                const std::string uniform = r.getString();
+                const GLint recordedLocation = r.get<int32_t>();
+                const uint8_t base = r.get<uint8_t>(), components = r.get<uint8_t>();
+                uint32_t raw[16];
+                for (uint8_t c = 0; c < components; ++c)
+                    raw[c] = c < 16 ? r.get<uint32_t>() : 0;
+                if (!linked)
+                    continue;
+                const GLint at = glGetUniformLocation(program, uniform.c_str());
+                locations[(uint64_t)recorded << 32 | (uint32_t)recordedLocation] = at;
+                const GLfloat *f = (const GLfloat *)raw;
+                const GLint *i = (const GLint *)raw;
+                const GLuint *ui = (const GLuint *)raw;
+                if (base == 3)
+                {
+                    if (components == 4) glUniformMatrix2fv(at, 1, GL_FALSE, f);
+                    else if (components == 9) glUniformMatrix3fv(at, 1, GL_FALSE, f);
+                    else glUniformMatrix4fv(at, 1, GL_FALSE, f);
+                }
+                else if (base == 0)
+                {
+                    if (components == 1) glUniform1fv(at, 1, f);
+                    else if (components == 2) glUniform2fv(at, 1, f);
+                    else if (components == 3) glUniform3fv(at, 1, f);
+                    else glUniform4fv(at, 1, f);
+                }
+                else if (base == 1)
+                {
+                    if (components == 1) glUniform1iv(at, 1, i);
+                    else if (components == 2) glUniform2iv(at, 1, i);
+                    else if (components == 3) glUniform3iv(at, 1, i);
+                    else glUniform4iv(at, 1, i);
+                }
+                else
+                {
+                    if (components == 1) glUniform1uiv(at, 1, ui);
+                    else if (components == 2) glUniform2uiv(at, 1, ui);
+                    else if (components == 3) glUniform3uiv(at, 1, ui);
+                    else glUniform4uiv(at, 1, ui);
+                }
+            }
+        }
+
+        void createVertexArray(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            const GLuint elements = r.get<GLuint>();
+            const bool bindingModel = r.get<uint8_t>() != 0;
+            struct Attribute
+            {
+                GLuint index;
+                bool enabled;
+                GLint size;
+                GLenum type;
+                bool normalized, integer;
+                GLuint relativeOffset, binding;
+            };
+            struct Binding
+            {
+                GLuint buffer;
+                int64_t offset;
+                GLsizei stride;
+                GLuint divisor;
+            };
+            std::vector<Attribute> attributes((size_t)std::max(r.get<int32_t>(), 0));
+            for (size_t a = 0; a < attributes.size(); ++a)
+            {
+                Attribute &at = attributes[a];
+                at.index = r.get<GLuint>();
+                at.enabled = r.get<uint8_t>() != 0;
+                at.size = r.get<int32_t>();
+                at.type = r.get<GLenum>();
+                at.normalized = r.get<uint8_t>() != 0;
+                at.integer = r.get<uint8_t>() != 0;
+                at.relativeOffset = r.get<GLuint>();
+                at.binding = r.get<GLuint>();
+            }
+            std::map<GLuint, Binding> bindings;
+            const int32_t bindingCount = r.get<int32_t>();
+            for (int32_t b = 0; b < bindingCount; ++b)
+            {
+                const GLuint index = r.get<GLuint>();
+                Binding &binding = bindings[index];
+                binding.buffer = name(BUFFER, r.get<GLuint>());
+                binding.offset = r.get<int64_t>();
+                binding.stride = r.get<int32_t>();
+                binding.divisor = r.get<GLuint>();
+            }
+            glBindVertexArray(name(VERTEX_ARRAY, recorded));
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, name(BUFFER, elements));
+            const bool separate = bindingModel && glad_glBindVertexBuffer;
+            for (size_t a = 0; a < attributes.size(); ++a)
+            {
+                const Attribute &at = attributes[a];
+                const Binding &binding = bindings[at.binding];
+                if (separate)
+                {
+                    if (at.integer)
+                        glVertexAttribIFormat(at.index, at.size, at.type, at.relativeOffset);
+                    else
+                        glVertexAttribFormat(at.index, at.size, at.type, at.normalized, at.relativeOffset);
+                    glVertexAttribBinding(at.index, at.binding);
+                    glBindVertexBuffer(at.binding, binding.buffer, (GLintptr)binding.offset, binding.stride);
+                    glVertexBindingDivisor(at.binding, binding.divisor);
+                }
+                else
+                {
+                    glBindBuffer(GL_ARRAY_BUFFER, binding.buffer);
+                    const void *pointer = (const void *)(uintptr_t)(binding.offset + at.relativeOffset);
+                    if (at.integer)
+                        glVertexAttribIPointer(at.index, at.size, at.type, binding.stride, pointer);
+                    else
+                        glVertexAttribPointer(at.index, at.size, at.type, at.normalized, binding.stride, pointer);
+                    glVertexAttribDivisor(at.index, binding.divisor);
+                }
+                if (at.enabled)
+                    glEnableVertexAttribArray(at.index);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindVertexArray(0);
+        }
+
+        void createFramebuffer(Reader &r)
+        {
+            const GLuint recorded = r.get<GLuint>();
+            glBindFramebuffer(GL_FRAMEBUFFER, name(FRAMEBUFFER, recorded));
+            const int32_t attachments = r.get<int32_t>();
+            for (int32_t a = 0; a < attachments; ++a)
+            {
+                const GLenum point = r.get<GLenum>(), type = r.get<GLenum>();
+                const GLuint object = r.get<GLuint>();
+                const GLenum target = r.get<GLenum>();
+                const GLint level = r.get<int32_t>(), layer = r.get<int32_t>();
+                const bool layered = r.get<uint8_t>() != 0;
+                if (type == GL_RENDERBUFFER)
+                    glFramebufferRenderbuffer(GL_FRAMEBUFFER, point, GL_RENDERBUFFER, name(RENDERBUFFER, object));
+                else if (layered)
+                    glFramebufferTexture(GL_FRAMEBUFFER, point, name(TEXTURE, object), level);
+                else if (target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_3D)
+                    glFramebufferTextureLayer(GL_FRAMEBUFFER, point, name(TEXTURE, object), level, layer);
+                else
+                    glFramebufferTexture2D(GL_FRAMEBUFFER, point, target, name(TEXTURE, object), level);
+            }
+            GLenum drawBuffers[8];
+            for (int i = 0; i < 8; ++i)
+                drawBuffers[i] = r.get<GLenum>();
+            GLsizei count = 8;
+            while (count > 1 && drawBuffers[count - 1] == GL_NONE)
+                --count;
+            glDrawBuffers(count, drawBuffers);
+            glReadBuffer(r.get<GLenum>());
+        }
+    };
+}
+
+int main(int argc, char **argv)
+{
+    std::string path, jsonPath;
+    int loops = 200, warmup = 20;
+    bool hidden = false, usage = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--loops" && i + 1 < argc)
+            loops = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--warmup" && i + 1 < argc)
+            warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--hidden")
+            hidden = true;
+        else if (path.empty() && arg.compare(0, 2, "--") != 0)
+            path = arg;
+        else
+            usage = true;
+    }
+    if (path.empty() || usage)
+    {
+        LOG_INFO("usage: car_replay <capture file> [--loops N] [--warmup N] [--hidden] [--json FILE]");
+        asyncLog().flush();
+        return 1;
+    }
+
+    Replay replay;
+    if (!replay.load(path))
+    {
+        LOG_ERROR("[car_replay] '" << path << "' isn't a GL_CAPTURE file of this version");
+        asyncLog().flush();
+        return 1;
+    }
+    const Header &header = replay.header;
+    if (!glfwInit())
+    {
+        LOG_ERROR("[car_replay] glfwInit failed");
+        asyncLog().flush();
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, hidden ? GLFW_FALSE : GLFW_TRUE);
+    GLFWwindow *window = glfwCreateWindow(std::max(header.width, 1), std::max(header.height, 1), "car_replay", NULL, NULL);
+    if (!window)
+    {
+        LOG_ERROR("[car_replay] Cannot create a GL 3.3 core window");
+        glfwTerminate();
+        asyncLog().flush();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        LOG_ERROR("[car_replay] Cannot load GL");
+        glfwTerminate();
+        asyncLog().flush();
+        return 1;
+    }
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    const std::string renderer = (const char *)glGetString(GL_RENDERER);
+    LOG_INFO("[car_replay] " << path << ": frame " << header.frame << ", " << header.width << "x" << header.height << ", "
+                             << header.calls << " calls, " << header.draws << " draws/dispatches, recorded on GL "
+                             << header.glMajor << "." << header.glMinor << "; replaying on " << renderer << " (GL " << major << "."
+                             << minor << ")");
+
+    if (!replay.createResources())
+    {
+        LOG_ERROR("[car_replay] The capture's resources are cut short");
+        glfwTerminate();
+        asyncLog().flush();
+        return 1;
+    }
+    glFinish();
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    std::vector<double> gpuMs, submitMs, finishMs;
+    bool ok = true;
+    for (int loop = 0; loop < warmup + loops && ok && !glfwWindowShouldClose(window); ++loop)
+    {
+        glFinish();
+        const auto start = std::chrono::steady_clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        ok = replay.run(replay.prologue) && replay.run(replay.frame);
+        glEndQuery(GL_TIME_ELAPSED);
+        const auto submitted = std::chrono::steady_clock::now();
+        glFinish();
+        const auto finished = std::chrono::steady_clock::now();
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+        if (loop == 0)
+        {
+            int errors = 0;
+            while (glGetError() != GL_NO_ERROR)
+                ++errors;
+            if (errors)
+                LOG_WARN("[car_replay] " << errors << " GL errors in the first loop (objects the capture couldn't recreate?)");
+        }
+        if (loop >= warmup)
+        {
+            gpuMs.push_back((double)elapsed / 1e6);
+            submitMs.push_back(std::chrono::duration<double, std::milli>(submitted - start).count());
+            finishMs.push_back(std::chrono::duration<double, std::milli>(finished - start).count());
+        }
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+    glDeleteQueries(1, &query);
+    if (!ok)
+        LOG_ERROR("[car_replay] The capture's calls are cut short or from another version");
+    for (std::set<uint16_t>::const_iterator it = replay.missing.begin(); it != replay.missing.end(); ++it)
+        LOG_WARN("[car_replay] Call " << *it << " isn't available on this driver, skipped");
+
+    const Stats gpu = Stats::of(gpuMs), submit = Stats::of(submitMs), finish = Stats::of(finishMs);
+    LOG_INFO("[car_replay] " << gpuMs.size() << " loops (ms)       min   median      avg      p99");
+    char line[160];
+    std::snprintf(line, sizeof(line), "  GPU              %8.3f %8.3f %8.3f %8.3f", gpu.min, gpu.median, gpu.avg, gpu.p99);
+    LOG_INFO(line);
+    std::snprintf(line, sizeof(line), "  CPU submit       %8.3f %8.3f %8.3f %8.3f", submit.min, submit.median, submit.avg, submit.p99);
+    LOG_INFO(line);
+    std::snprintf(line, sizeof(line), "  CPU to finished  %8.3f %8.3f %8.3f %8.3f", finish.min, finish.median, finish.avg, finish.p99);
+    LOG_INFO(line);
+
+    if (!jsonPath.empty())
+    {
+        nlohmann::json root;
+        root["capture"] = path;
+        root["frame"] = header.frame;
+        root["width"] = header.width;
+        root["height"] = header.height;
+        root["calls"] = header.calls;
+        root["draws"] = header.draws;
+        root["renderer"] = renderer;
+        root["gl_version"] = std::to_string(major) + "." + std::to_string(minor);
+        root["loops"] = gpuMs.size();
+        root["gpu"] = gpu.toJson();
+        root["cpu_submit"] = submit.toJson();
+        root["cpu_finished"] = finish.toJson();
+        std::ofstream out(jsonPath.c_str());
+        if (out << root.dump(2) << "\n")
+            LOG_INFO("[car_replay] Wrote " << jsonPath);
+        else
+            LOG_ERROR("[car_replay] Cannot write '" << jsonPath << "'");
+    }
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    asyncLog().flush();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// ibl_bake: bakes the IBL caches of a directory of HDRIs ahead of time.
+//
+//   ibl_bake <dir> [--shaders DIR] [--jobs N] [--force]
+//
+// Every .exr directly in <dir> goes through the viewer's own EnvironmentLoader, so the <exr>.iblcache
+// written next to it is the one the viewer would write (same decode, downsampling, SH projection, bake
+// shaders and parameters hash) and the viewer loads it instead of baking. Run from the build directory;
+// the bake shaders come from --shaders (default ../shaders). --jobs N (default 2) keeps N files in flight:
+// the next ones are read and decoded on the worker pool while one bakes on the GPU, and each decode is
+// itself split into strips across the pool (EXR_STREAM, EXR_STRIP_MB and EXR_DOWNSAMPLE apply as in the
+// viewer). Files whose cache is still valid are skipped unless --force. Each file's bake time (the GPU bake
+// and the streamed uploads) and its time since the read began are logged; the exit code is 1 if a file
+// couldn't be read or decoded. The bake runs on a hidden window's GL context, so the machine needs a GL 3.3 driver.
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <async_log.h>
+#include <environment_loader.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // the .exr files directly in `dir`, sorted
+    std::vector<std::string> listExrs(const std::string &dir)
+    {
+        std::vector<std::string> names;
+#ifdef _WIN32
+        WIN32_FIND_DATAA found;
+        HANDLE find = FindFirstFileA((dir + "/*").c_str(), &found);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+                if (!(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+                    names.push_back(found.cFileName);
+            while (FindNextFileA(find, &found));
+            FindClose(find);
+        }
+#else
+        if (DIR *handle = opendir(dir.c_str()))
+        {
+            while (dirent *found = readdir(handle))
+            {
+                struct stat st;
+                if (stat((dir + '/' + found->d_name).c_str(), &st) == 0 && S_ISREG(st.st_mode))
+                    names.push_back(found->d_name);
+            }
+            closedir(handle);
+        }
+#endif
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            std::string lower = names[i];
+            for (size_t c = 0; c < lower.size(); ++c)
+                lower[c] = (char)std::tolower((unsigned char)lower[c]);
+            if (lower.size() > 4 && lower.compare(lower.size() - 4, 4, ".exr") == 0)
+                paths.push_back(dir + '/' + names[i]);
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    double msSince(std::chrono::steady_clock::time_point since)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string dir, shaderDir = "../shaders";
+    int jobs = 2;
+    bool force = false, usage = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--shaders" && i + 1 < argc)
+            shaderDir = argv[++i];
+        else if (arg == "--jobs" && i + 1 < argc)
+            jobs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--force")
+            force = true;
+        else if (dir.empty() && arg.compare(0, 2, "--") != 0)
+            dir = arg;
+        else
+            usage = true;
+    }
+    if (dir.empty() || usage)
+    {
+        LOG_INFO("usage: ibl_bake <dir> [--shaders DIR] [--jobs N] [--force]");
+        asyncLog().flush();
+        return 1;
+    }
+    const std::vector<std::string> files = listExrs(dir);
+    if (files.empty())
+    {
+        LOG_WARN("[ibl_bake] No .exr files in " << dir);
+        asyncLog().flush();
+        return 1;
+    }
+
+    // the bake is GPU work: a hidden window's context
+    GLFWwindow *window = nullptr;
+    bool gl = false;
+    if (glfwInit())
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(64, 64, "ibl_bake", NULL, NULL);
+        if (window)
+        {
+            glfwMakeContextCurrent(window);
+            gl = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) != 0;
+        }
+    }
+    if (!gl)
+    {
+        LOG_ERROR("[ibl_bake] No GL 3.3 context, can't bake");
+        if (window)
+            glfwDestroyWindow(window);
+        glfwTerminate();
+        asyncLog().flush();
+        return 1;
+    }
+
+    // a loader per file in flight: loading one starts its read and decode, pumping it bakes
+    const size_t slots = std::min(files.size(), (size_t)jobs);
+    std::vector<std::unique_ptr<EnvironmentLoader> > loaders;
+    std::vector<std::chrono::steady_clock::time_point> requested(slots);
+    for (size_t s = 0; s < slots; ++s)
+    {
+        loaders.push_back(std::unique_ptr<EnvironmentLoader>(new EnvironmentLoader(shaderDir)));
+        loaders[s]->load(files[s], !force);
+        requested[s] = std::chrono::steady_clock::now();
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t baked = 0, upToDate = 0, failed = 0;
+    double bakeMs = 0.0;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        const size_t s = i % slots;
+        EnvironmentLoader &loader = *loaders[s];
+        const std::chrono::steady_clock::time_point bakeStart = std::chrono::steady_clock::now();
+        const bool current = loader.pump(-1.0);
+        const double ms = msSince(bakeStart);
+        if (!current)
+        {
+            ++failed;
+            LOG_ERROR("[ibl_bake] " << files[i] << " failed");
+        }
+        else if (loader.currentFromCache())
+        {
+            ++upToDate;
+            LOG_INFO("[ibl_bake] " << files[i] << " is up to date");
+        }
+        else
+        {
+            ++baked;
+            bakeMs += ms;
+            LOG_INFO("[ibl_bake] " << files[i] << " baked in " << ms << " ms (" << msSince(requested[s]) << " ms since its read began)");
+        }
+        loader.releaseGpu();
+        if (i + slots < files.size())
+        {
+            loader.load(files[i + slots], !force);
+            requested[s] = std::chrono::steady_clock::now();
+        }
+    }
+    LOG_INFO("[ibl_bake] " << files.size() << " files: " << baked << " baked (" << bakeMs << " ms baking), " << upToDate << " up to date, "
+                           << failed << " failed, " << msSince(start) << " ms in all");
+
+    loaders.clear();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    asyncLog().flush();
+    return failed ? 1 : 0;
+}
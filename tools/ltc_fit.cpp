@@ -0,0 +1,408 @@
+// Offline generator for the linearly transformed cosine LUT of the area lights (include/ltc_lut_data.h).
+//
+// A linearly transformed cosine (Heitz et al. 2016) is a clamped cosine lobe whose directions go through a
+// 3x3 matrix M; its integral over a polygon is the cosine's integral over the polygon taken through M^-1,
+// which has a closed form. For every roughness and view angle this fits M so that the LTC matches the
+// GGX lobe (height-correlated Smith, times the cosine) of model_loading.fs, by Nelder-Mead on the error
+// sampled from both distributions, starting from the neighbouring fit. Stored per texel, as in the
+// reference implementation:
+//   layer 0: the variable terms of M^-1 normalised by its middle element (m00, m02, m20, m22)
+//   layer 1: the lobe's integral (directional albedo) and its Schlick Fresnel part, then 0, 0
+// Texel (x, y) is roughness x / (SIZE - 1) and view angle acos(1 - (y / (SIZE - 1))^2), so the shader looks
+// up (roughness, sqrt(1 - NdotV)) at texel centres.
+//
+// usage: ltc_fit [output header]   (default include/ltc_lut_data.h, run from the repo root)
+// re-run after changing the fit below and commit the regenerated header; it takes a minute or so.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const float PI = 3.14159265359f;
+static const unsigned int SIZE = 64;
+// samples per side of the error estimate, per distribution
+static const int SAMPLES = 32;
+static const float MIN_ALPHA = 0.00001f;
+
+struct Vec3
+{
+    float x, y, z;
+    Vec3(float x = 0.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) {}
+    Vec3 operator+(const Vec3 &o) const { return Vec3(x + o.x, y + o.y, z + o.z); }
+    Vec3 operator-(const Vec3 &o) const { return Vec3(x - o.x, y - o.y, z - o.z); }
+    Vec3 operator*(float s) const { return Vec3(x * s, y * s, z * s); }
+};
+
+static float dot(const Vec3 &a, const Vec3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static float length(const Vec3 &v) { return std::sqrt(dot(v, v)); }
+static Vec3 normalize(const Vec3 &v) { return v * (1.0f / length(v)); }
+
+// column-major like GLSL: m[column][row]
+struct Mat3
+{
+    float m[3][3];
+    Mat3() { std::memset(m, 0, sizeof(m)); }
+    static Mat3 columns(const Vec3 &a, const Vec3 &b, const Vec3 &c)
+    {
+        Mat3 r;
+        r.m[0][0] = a.x; r.m[0][1] = a.y; r.m[0][2] = a.z;
+        r.m[1][0] = b.x; r.m[1][1] = b.y; r.m[1][2] = b.z;
+        r.m[2][0] = c.x; r.m[2][1] = c.y; r.m[2][2] = c.z;
+        return r;
+    }
+    Vec3 operator*(const Vec3 &v) const
+    {
+        return Vec3(m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z, m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z,
+                    m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z);
+    }
+    Mat3 operator*(const Mat3 &o) const
+    {
+        Mat3 r;
+        for (int c = 0; c < 3; ++c)
+            for (int row = 0; row < 3; ++row)
+                r.m[c][row] = m[0][row] * o.m[c][0] + m[1][row] * o.m[c][1] + m[2][row] * o.m[c][2];
+        return r;
+    }
+    float determinant() const
+    {
+        return m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2]) - m[1][0] * (m[0][1] * m[2][2] - m[2][1] * m[0][2]) +
+               m[2][0] * (m[0][1] * m[1][2] - m[1][1] * m[0][2]);
+    }
+    Mat3 inverse() const
+    {
+        const float d = determinant();
+        Mat3 r;
+        r.m[0][0] = (m[1][1] * m[2][2] - m[2][1] * m[1][2]) / d;
+        r.m[1][0] = -(m[1][0] * m[2][2] - m[2][0] * m[1][2]) / d;
+        r.m[2][0] = (m[1][0] * m[2][1] - m[2][0] * m[1][1]) / d;
+        r.m[0][1] = -(m[0][1] * m[2][2] - m[2][1] * m[0][2]) / d;
+        r.m[1][1] = (m[0][0] * m[2][2] - m[2][0] * m[0][2]) / d;
+        r.m[2][1] = -(m[0][0] * m[2][1] - m[2][0] * m[0][1]) / d;
+        r.m[0][2] = (m[0][1] * m[1][2] - m[1][1] * m[0][2]) / d;
+        r.m[1][2] = -(m[0][0] * m[1][2] - m[1][0] * m[0][2]) / d;
+        r.m[2][2] = (m[0][0] * m[1][1] - m[1][0] * m[0][1]) / d;
+        return r;
+    }
+};
+
+// GGX with height-correlated Smith masking, times the cosine; N = +Z
+static float smithLambda(float cosTheta, float alpha)
+{
+    const float tan2 = std::max(1.0f - cosTheta * cosTheta, 0.0f) / (cosTheta * cosTheta);
+    return 0.5f * (-1.0f + std::sqrt(1.0f + alpha * alpha * tan2));
+}
+
+static float evalBRDF(const Vec3 &V, const Vec3 &L, float alpha, float &pdf)
+{
+    pdf = 0.0f;
+    if (V.z <= 0.0f || L.z <= 0.0f)
+        return 0.0f;
+    const Vec3 H = normalize(V + L);
+    const float slopeX = H.x / H.z, slopeY = H.y / H.z;
+    float D = 1.0f / (1.0f + (slopeX * slopeX + slopeY * slopeY) / (alpha * alpha));
+    D = D * D / (PI * alpha * alpha * H.z * H.z * H.z * H.z);
+    pdf = std::fabs(D * H.z / (4.0f * dot(V, H)));
+    const float G2 = 1.0f / (1.0f + smithLambda(V.z, alpha) + smithLambda(L.z, alpha));
+    return D * G2 / (4.0f * V.z);
+}
+
+static Vec3 sampleBRDF(const Vec3 &V, float alpha, float u1, float u2)
+{
+    const float phi = 2.0f * PI * u1;
+    const float r = alpha * std::sqrt(u2 / (1.0f - u2));
+    const Vec3 N = normalize(Vec3(r * std::cos(phi), r * std::sin(phi), 1.0f));
+    return N * (2.0f * dot(N, V)) - V;
+}
+
+struct LTC
+{
+    // M = [X Y Z] * [[m11, 0, m13], [0, m22, 0], [0, 0, 1]]
+    float m11 = 1.0f, m22 = 1.0f, m13 = 0.0f;
+    Vec3 X = Vec3(1, 0, 0), Y = Vec3(0, 1, 0), Z = Vec3(0, 0, 1);
+    float magnitude = 1.0f, fresnel = 1.0f;
+    Mat3 M, invM;
+    float detM = 1.0f;
+
+    void update()
+    {
+        Mat3 scale;
+        scale.m[0][0] = m11;
+        scale.m[1][1] = m22;
+        scale.m[2][0] = m13;
+        scale.m[2][2] = 1.0f;
+        M = Mat3::columns(X, Y, Z) * scale;
+        invM = M.inverse();
+        detM = std::fabs(M.determinant());
+    }
+
+    float eval(const Vec3 &L) const
+    {
+        const Vec3 original = normalize(invM * L);
+        const Vec3 transformed = M * original;
+        const float l = length(transformed);
+        const float jacobian = detM / (l * l * l);
+        return magnitude * std::max(0.0f, original.z) / PI / jacobian;
+    }
+
+    Vec3 sample(float u1, float u2) const
+    {
+        const float theta = std::acos(std::sqrt(u1));
+        const float phi = 2.0f * PI * u2;
+        return normalize(M * Vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+};
+
+// the lobe's integral, its Fresnel-weighted part and its mean direction
+static void averageTerms(const Vec3 &V, float alpha, float &norm, float &fresnel, Vec3 &direction)
+{
+    norm = fresnel = 0.0f;
+    direction = Vec3();
+    for (int j = 0; j < SAMPLES; ++j)
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            const Vec3 L = sampleBRDF(V, alpha, (i + 0.5f) / SAMPLES, (j + 0.5f) / SAMPLES);
+            float pdf;
+            const float value = evalBRDF(V, L, alpha, pdf);
+            if (pdf <= 0.0f)
+                continue;
+            const float weight = value / pdf;
+            const Vec3 H = normalize(V + L);
+            norm += weight;
+            fresnel += weight * std::pow(1.0f - std::max(dot(V, H), 0.0f), 5.0f);
+            direction = direction + L * weight;
+        }
+    norm /= SAMPLES * SAMPLES;
+    fresnel /= SAMPLES * SAMPLES;
+    direction.y = 0.0f;
+    direction = normalize(direction);
+}
+
+// cubed difference between the LTC and the lobe, importance sampled from both
+static float fitError(const LTC &ltc, const Vec3 &V, float alpha)
+{
+    double error = 0.0;
+    for (int j = 0; j < SAMPLES; ++j)
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            const float u1 = (i + 0.5f) / SAMPLES, u2 = (j + 0.5f) / SAMPLES;
+            for (int from = 0; from < 2; ++from)
+            {
+                const Vec3 L = from == 0 ? ltc.sample(u1, u2) : sampleBRDF(V, alpha, u1, u2);
+                float pdfBRDF;
+                const float valueBRDF = evalBRDF(V, L, alpha, pdfBRDF);
+                const float valueLTC = ltc.eval(L);
+                const float pdfLTC = valueLTC / ltc.magnitude;
+                const double e = std::fabs((double)valueBRDF - valueLTC);
+                if (pdfLTC + pdfBRDF > 0.0f)
+                    error += e * e * e / (pdfLTC + pdfBRDF);
+            }
+        }
+    return (float)(error / (SAMPLES * SAMPLES));
+}
+
+static void applyParameters(LTC &ltc, const float *p, bool isotropic)
+{
+    const float m11 = std::max(p[0], 1e-7f), m22 = std::max(p[1], 1e-7f);
+    ltc.m11 = m11;
+    ltc.m22 = isotropic ? m11 : m22;
+    ltc.m13 = isotropic ? 0.0f : p[2];
+    ltc.update();
+}
+
+// downhill simplex over (m11, m22, m13) from `start`, simplex edges `delta`
+static void nelderMead(LTC &ltc, const Vec3 &V, float alpha, bool isotropic, float *start, float delta)
+{
+    const int D = 3;
+    float simplex[D + 1][D], values[D + 1];
+    for (int i = 0; i <= D; ++i)
+    {
+        for (int k = 0; k < D; ++k)
+            simplex[i][k] = start[k] + (i == k + 1 ? delta : 0.0f);
+        applyParameters(ltc, simplex[i], isotropic);
+        values[i] = fitError(ltc, V, alpha);
+    }
+    auto evaluate = [&](const float *p) {
+        applyParameters(ltc, p, isotropic);
+        return fitError(ltc, V, alpha);
+    };
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+        int best = 0, worst = 0, second = 0;
+        for (int i = 1; i <= D; ++i)
+        {
+            if (values[i] < values[best]) best = i;
+            if (values[i] > values[worst]) worst = i;
+        }
+        second = best;
+        for (int i = 0; i <= D; ++i)
+            if (i != worst && values[i] > values[second])
+                second = i;
+        if (std::fabs(values[worst] - values[best]) <= 1e-5f * (std::fabs(values[best]) + 1e-20f))
+            break;
+        float centroid[D] = {0.0f, 0.0f, 0.0f};
+        for (int i = 0; i <= D; ++i)
+            if (i != worst)
+                for (int k = 0; k < D; ++k)
+                    centroid[k] += simplex[i][k] / D;
+        float reflected[D], trial[D];
+        for (int k = 0; k < D; ++k)
+            reflected[k] = centroid[k] + (centroid[k] - simplex[worst][k]);
+        const float reflectedValue = evaluate(reflected);
+        if (reflectedValue < values[best])
+        {
+            for (int k = 0; k < D; ++k)
+                trial[k] = centroid[k] + 2.0f * (centroid[k] - simplex[worst][k]);
+            const float expandedValue = evaluate(trial);
+            const bool expand = expandedValue < reflectedValue;
+            for (int k = 0; k < D; ++k)
+                simplex[worst][k] = expand ? trial[k] : reflected[k];
+            values[worst] = expand ? expandedValue : reflectedValue;
+            continue;
+        }
+        if (reflectedValue < values[second])
+        {
+            std::memcpy(simplex[worst], reflected, sizeof(reflected));
+            values[worst] = reflectedValue;
+            continue;
+        }
+        for (int k = 0; k < D; ++k)
+            trial[k] = centroid[k] + 0.5f * (simplex[worst][k] - centroid[k]);
+        const float contractedValue = evaluate(trial);
+        if (contractedValue < values[worst])
+        {
+            std::memcpy(simplex[worst], trial, sizeof(trial));
+            values[worst] = contractedValue;
+            continue;
+        }
+        // shrink towards the best
+        for (int i = 0; i <= D; ++i)
+        {
+            if (i == best)
+                continue;
+            for (int k = 0; k < D; ++k)
+                simplex[i][k] = simplex[best][k] + 0.5f * (simplex[i][k] - simplex[best][k]);
+            values[i] = evaluate(simplex[i]);
+        }
+    }
+    int best = 0;
+    for (int i = 1; i <= D; ++i)
+        if (values[i] < values[best])
+            best = i;
+    applyParameters(ltc, simplex[best], isotropic);
+}
+
+// IEEE 754 binary32 -> binary16, round to nearest even (no inf/NaN in the LUT)
+static uint16_t toHalf(float f)
+{
+    uint32_t x;
+    std::memcpy(&x, &f, 4);
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    int32_t exponent = int32_t((x >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = x & 0x7FFFFFu;
+    if (exponent >= 31)
+        return (uint16_t)(sign | 0x7BFFu);
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return (uint16_t)sign;
+        mantissa |= 0x800000u;
+        const uint32_t shift = uint32_t(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1u), halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (half & 1u)))
+            ++half;
+        return (uint16_t)(sign | half);
+    }
+    uint32_t half = (uint32_t(exponent) << 10) | (mantissa >> 13);
+    const uint32_t rest = mantissa & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+        ++half;
+    return (uint16_t)(sign | half);
+}
+
+int main(int argc, char **argv)
+{
+    const char *outPath = argc > 1 ? argv[1] : "include/ltc_lut_data.h";
+    const unsigned int size = SIZE;
+    std::vector<Mat3> fits(size * size);
+    std::vector<float> magnitudes(size * size), fresnels(size * size);
+    // roughest first, so each view angle's normal-incidence fit starts from the rougher one next to it
+    for (int a = size - 1; a >= 0; --a)
+    {
+        // carried over from view angle to view angle
+        LTC ltc;
+        for (unsigned int t = 0; t < size; ++t)
+        {
+            const float x = t / float(size - 1);
+            const float theta = std::min(1.57f, std::acos(1.0f - x * x));
+            const Vec3 V(std::sin(theta), 0.0f, std::cos(theta));
+            const float roughness = a / float(size - 1);
+            const float alpha = std::max(roughness * roughness, MIN_ALPHA);
+            const unsigned int index = t * size + a;
+
+            Vec3 direction;
+            averageTerms(V, alpha, ltc.magnitude, ltc.fresnel, direction);
+            bool isotropic;
+            if (t == 0)
+            {
+                // normal incidence: an isotropic lobe, from the rougher fit's
+                ltc.X = Vec3(1.0f, 0.0f, 0.0f);
+                ltc.Y = Vec3(0.0f, 1.0f, 0.0f);
+                ltc.Z = Vec3(0.0f, 0.0f, 1.0f);
+                ltc.m11 = ltc.m22 = a < (int)size - 1 ? fits[index + 1].m[0][0] : 1.0f;
+                ltc.m13 = 0.0f;
+                isotropic = true;
+            }
+            else
+            {
+                // otherwise around the lobe's mean direction, from the previous view angle's fit
+                ltc.X = Vec3(direction.z, 0.0f, -direction.x);
+                ltc.Y = Vec3(0.0f, 1.0f, 0.0f);
+                ltc.Z = direction;
+                isotropic = false;
+            }
+            ltc.update();
+            float start[3] = {ltc.m11, ltc.m22, ltc.m13};
+            nelderMead(ltc, V, alpha, isotropic, start, 0.05f);
+            fits[index] = ltc.M;
+            magnitudes[index] = ltc.magnitude;
+            fresnels[index] = ltc.fresnel;
+        }
+    }
+
+    std::vector<uint16_t> texels(size * size * 8);
+    for (unsigned int i = 0; i < size * size; ++i)
+    {
+        Mat3 inv = fits[i].inverse();
+        const float middle = inv.m[1][1];
+        const float layer0[4] = {inv.m[0][0] / middle, inv.m[0][2] / middle, inv.m[2][0] / middle, inv.m[2][2] / middle};
+        const float layer1[4] = {magnitudes[i], fresnels[i], 0.0f, 0.0f};
+        for (int c = 0; c < 4; ++c)
+        {
+            texels[i * 4 + c] = toHalf(layer0[c]);
+            texels[(size * size + i) * 4 + c] = toHalf(layer1[c]);
+        }
+    }
+
+    FILE *out = std::fopen(outPath, "w");
+    if (!out)
+    {
+        std::fprintf(stderr, "ltc_fit: can't write %s\n", outPath);
+        return 1;
+    }
+    std::fprintf(out, "// generated by tools/ltc_fit.cpp - do not edit\n");
+    std::fprintf(out, "// GGX linearly transformed cosines, %ux%u RGBA half floats in 2 layers (x = roughness, y = sqrt(1 - NdotV)):\n", size, size);
+    std::fprintf(out, "// inverse matrix terms, then albedo and Fresnel part; %d^2 samples per distribution in the fit\n", SAMPLES);
+    std::fprintf(out, "#ifndef LTC_LUT_DATA_H\n#define LTC_LUT_DATA_H\n\n");
+    std::fprintf(out, "#define LTC_LUT_SIZE %u\n\n", size);
+    std::fprintf(out, "static const unsigned short LTC_LUT_DATA[%u] = {\n", (unsigned int)texels.size());
+    for (size_t i = 0; i < texels.size(); ++i)
+        std::fprintf(out, "%s0x%04x,%s", i % 16 == 0 ? "    " : "", texels[i], i % 16 == 15 ? "\n" : "");
+    std::fprintf(out, "};\n\n#endif\n");
+    std::fclose(out);
+    std::printf("ltc_fit: wrote %s (%ux%u)\n", outPath, size, size);
+    return 0;
+}
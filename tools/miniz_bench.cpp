@@ -0,0 +1,454 @@
+// miniz_bench: deflate / inflate throughput of miniz on the shipped assets, for choosing archive settings.
+//
+//   miniz_bench [--root DIR] [--levels 1,6,9] [--threads 1,4,8] [--block KB] [--iterations N] [--json FILE] [paths...]
+//
+// Run from the build directory like car_bench: the inputs default to the files under ford_raptor/ and models/
+// and the .exr files in --root (default ..); paths given on the command line (files or directories) replace
+// them. Inputs are grouped by kind (geometry, images, exr, text, other) and cut into --block KB pieces
+// (default 1024; 0 = whole files, as car_pak deflates them), each an independent zlib stream, so more than one
+// thread can work on a file. Every group is deflated at each level and inflated again with each thread count,
+// and checked round trip like src/compress_fuzzer.c; the best of N iterations (default 3) is reported in MB/s
+// of uncompressed data. With tinyexr, the ZIP/ZIPS blocks of scanline EXRs are also inflated as they are
+// stored ("exr blocks"), which is what the EXR decode spends its zlib time on.
+#include <async_log.h>
+#include <json.hpp>
+#include <mapped_file.h>
+
+#include "miniz.h"
+#if defined(HAS_TINYEXR)
+#include "tinyexr.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    // a piece of input: raw bytes to deflate, or (exr blocks) a stored zlib stream and its inflated size
+    struct Block
+    {
+        const unsigned char *data;
+        size_t size;
+        size_t rawSize;
+    };
+
+    struct Group
+    {
+        std::string name;
+        bool stored = false; // blocks are already compressed: inflate only
+        std::vector<Block> blocks;
+        size_t rawBytes = 0;
+    };
+
+    struct Result
+    {
+        std::string group;
+        int level; // -1 for stored blocks
+        unsigned int threads;
+        size_t rawBytes, compressedBytes;
+        double deflateMBs, inflateMBs; // deflate 0 for stored blocks
+    };
+
+    bool isDirectory(const std::string &path)
+    {
+#ifdef _WIN32
+        DWORD attributes = GetFileAttributesA(path.c_str());
+        return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+    }
+
+    // files below `dir` (recursively, or only its own with !recurse), as full paths
+    void listFiles(const std::string &dir, bool recurse, std::vector<std::string> &out)
+    {
+#ifdef _WIN32
+        WIN32_FIND_DATAA found;
+        HANDLE find = FindFirstFileA((dir + "/*").c_str(), &found);
+        if (find == INVALID_HANDLE_VALUE)
+            return;
+        do
+        {
+            std::string name = found.cFileName;
+            if (name == "." || name == "..")
+                continue;
+            if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                if (recurse)
+                    listFiles(dir + '/' + name, true, out);
+            }
+            else
+                out.push_back(dir + '/' + name);
+        } while (FindNextFileA(find, &found));
+        FindClose(find);
+#else
+        DIR *handle = opendir(dir.c_str());
+        if (!handle)
+            return;
+        while (dirent *found = readdir(handle))
+        {
+            std::string name = found->d_name;
+            if (name == "." || name == "..")
+                continue;
+            const std::string path = dir + '/' + name;
+            struct stat st;
+            if (stat(path.c_str(), &st) != 0)
+                continue;
+            if (S_ISDIR(st.st_mode))
+            {
+                if (recurse)
+                    listFiles(path, true, out);
+            }
+            else if (S_ISREG(st.st_mode))
+                out.push_back(path);
+        }
+        closedir(handle);
+#endif
+    }
+
+    std::string extensionOf(const std::string &path)
+    {
+        const size_t dot = path.find_last_of('.');
+        if (dot == std::string::npos || path.find_first_of("/\\", dot) != std::string::npos)
+            return std::string();
+        std::string ext = path.substr(dot + 1);
+        for (size_t i = 0; i < ext.size(); ++i)
+            ext[i] = (char)std::tolower((unsigned char)ext[i]);
+        return ext;
+    }
+
+    const char *groupOf(const std::string &path)
+    {
+        const std::string ext = extensionOf(path);
+        if (ext == "bin" || ext == "cooked" || ext == "glb")
+            return "geometry";
+        if (ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "qoi")
+            return "images";
+        if (ext == "exr")
+            return "exr";
+        if (ext == "gltf" || ext == "json" || ext == "txt" || ext == "obj" || ext == "mtl")
+            return "text";
+        return "other";
+    }
+
+    std::vector<int> parseList(const std::string &text)
+    {
+        std::vector<int> values;
+        std::stringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ','))
+            if (!item.empty())
+                values.push_back(std::atoi(item.c_str()));
+        return values;
+    }
+
+#if defined(HAS_TINYEXR)
+    // the ZIP / ZIPS chunks of a single-part scanline EXR, as stored; nothing for other files
+    void exrBlocks(const unsigned char *data, size_t size, std::vector<Block> &out)
+    {
+        EXRVersion version;
+        if (ParseEXRVersionFromMemory(&version, data, size) != TINYEXR_SUCCESS || version.tiled || version.multipart || version.non_image)
+            return;
+        EXRHeader header;
+        InitEXRHeader(&header);
+        const char *err = nullptr;
+        if (ParseEXRHeaderFromMemory(&header, &version, data, size, &err) != TINYEXR_SUCCESS)
+        {
+            if (err)
+                FreeEXRErrorMessage(err);
+            FreeEXRHeader(&header);
+            return;
+        }
+        const int lines = header.compression_type == TINYEXR_COMPRESSIONTYPE_ZIP ? 16 : header.compression_type == TINYEXR_COMPRESSIONTYPE_ZIPS ? 1 : 0;
+        size_t pixelBytes = 0;
+        for (int c = 0; c < header.num_channels; ++c)
+            pixelBytes += header.pixel_types[c] == TINYEXR_PIXELTYPE_HALF ? 2 : 4;
+        const int width = header.data_window.max_x - header.data_window.min_x + 1;
+        const int minY = header.data_window.min_y, height = header.data_window.max_y - minY + 1;
+        const size_t table = 8 + header.header_len;
+        FreeEXRHeader(&header);
+        if (lines == 0 || width <= 0 || height <= 0)
+            return;
+        const size_t blocks = (size_t)(height + lines - 1) / lines;
+        if (table + blocks * 8 > size)
+            return;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            uint64_t offset;
+            std::memcpy(&offset, data + table + b * 8, 8);
+            if (offset + 8 > size)
+                return;
+            uint32_t stored;
+            std::memcpy(&stored, data + offset + 4, 4);
+            const size_t rows = (size_t)std::min(lines, height - (int)b * lines);
+            const size_t raw = rows * width * pixelBytes;
+            // blocks that didn't compress are stored raw, no zlib stream to inflate
+            if (offset + 8 + stored > size || stored >= raw)
+                continue;
+            Block block = {data + offset + 8, stored, raw};
+            out.push_back(block);
+        }
+    }
+#endif
+
+    // runs job(0 .. count - 1) on `threads` threads taking indices from a shared counter; wall ms
+    double runParallel(size_t count, unsigned int threads, const std::function<bool(size_t)> &job, bool &ok)
+    {
+        std::atomic<size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t)
+            workers.push_back(std::thread([&]() {
+                for (size_t i = next++; i < count; i = next++)
+                    if (!job(i))
+                        failed = true;
+            }));
+        for (size_t t = 0; t < workers.size(); ++t)
+            workers[t].join();
+        ok = ok && !failed;
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double megabytesPerSecond(size_t bytes, double ms) { return ms > 0.0 ? bytes / (1024.0 * 1024.0) / (ms / 1000.0) : 0.0; }
+
+    // best-of-`iterations` deflate and inflate of `group` at `level` on `threads` threads, checked round trip
+    bool benchGroup(const Group &group, int level, unsigned int threads, int iterations, std::vector<Result> &results)
+    {
+        const size_t count = group.blocks.size();
+        std::vector<std::vector<unsigned char> > compressed(count), inflated(count);
+        std::vector<size_t> compressedSizes(count);
+        bool ok = true;
+        double deflateMs = 0.0, inflateMs = 0.0;
+        for (int i = 0; i < iterations && !group.stored; ++i)
+        {
+            const double ms = runParallel(count, threads, [&](size_t b) {
+                const Block &block = group.blocks[b];
+                std::vector<unsigned char> &out = compressed[b];
+                out.resize(mz_compressBound((mz_ulong)block.size));
+                mz_ulong size = (mz_ulong)out.size();
+                if (mz_compress2(&out[0], &size, block.data, (mz_ulong)block.size, level) != MZ_OK)
+                    return false;
+                compressedSizes[b] = size;
+                return true;
+            }, ok);
+            deflateMs = i == 0 ? ms : std::min(deflateMs, ms);
+        }
+        for (int i = 0; i < iterations; ++i)
+        {
+            const double ms = runParallel(count, threads, [&](size_t b) {
+                const Block &block = group.blocks[b];
+                const unsigned char *source = group.stored ? block.data : &compressed[b][0];
+                const size_t sourceSize = group.stored ? block.size : compressedSizes[b];
+                std::vector<unsigned char> &out = inflated[b];
+                out.resize(std::max<size_t>(block.rawSize, 1));
+                mz_ulong size = (mz_ulong)block.rawSize;
+                return mz_uncompress(&out[0], &size, source, (mz_ulong)sourceSize) == MZ_OK && size == block.rawSize;
+            }, ok);
+            inflateMs = i == 0 ? ms : std::min(inflateMs, ms);
+        }
+        // compress + uncompress gives back the input (stored blocks have no original to compare with)
+        for (size_t b = 0; b < count && ok && !group.stored; ++b)
+            ok = std::memcmp(&inflated[b][0], group.blocks[b].data, group.blocks[b].size) == 0;
+        if (!ok)
+        {
+            LOG_ERROR("[miniz_bench] " << group.name << " level " << level << ": round trip failed");
+            return false;
+        }
+
+        Result r;
+        r.group = group.name;
+        r.level = group.stored ? -1 : level;
+        r.threads = threads;
+        r.rawBytes = group.rawBytes;
+        r.compressedBytes = 0;
+        for (size_t b = 0; b < count; ++b)
+            r.compressedBytes += group.stored ? group.blocks[b].size : compressedSizes[b];
+        r.deflateMBs = group.stored ? 0.0 : megabytesPerSecond(group.rawBytes, deflateMs);
+        r.inflateMBs = megabytesPerSecond(group.rawBytes, inflateMs);
+        if (group.stored)
+            LOG_INFO("[miniz_bench] " << group.name << ", " << threads << " threads: inflate " << r.inflateMBs << " MB/s ("
+                                      << count << " streams, ratio " << (double)r.compressedBytes / r.rawBytes << ")");
+        else
+            LOG_INFO("[miniz_bench] " << group.name << " level " << level << ", " << threads << " threads: deflate " << r.deflateMBs
+                                      << " MB/s, inflate " << r.inflateMBs << " MB/s, ratio " << (double)r.compressedBytes / r.rawBytes);
+        results.push_back(r);
+        return true;
+    }
+
+    bool writeJson(const std::string &path, const std::vector<Result> &results)
+    {
+        nlohmann::json root = nlohmann::json::array();
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            nlohmann::json j;
+            j["group"] = results[i].group;
+            j["level"] = results[i].level;
+            j["threads"] = results[i].threads;
+            j["raw_bytes"] = results[i].rawBytes;
+            j["compressed_bytes"] = results[i].compressedBytes;
+            j["deflate_mb_s"] = results[i].deflateMBs;
+            j["inflate_mb_s"] = results[i].inflateMBs;
+            root.push_back(j);
+        }
+        std::ofstream out(path.c_str());
+        if (!out)
+            return false;
+        out << root.dump(2) << std::endl;
+        return (bool)out;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string root = "..";
+    std::string jsonPath;
+    std::vector<int> levels;
+    levels.push_back(1);
+    levels.push_back(6);
+    levels.push_back(9);
+    const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> threadCounts;
+    threadCounts.push_back(1);
+    if (cores / 2 > 1)
+        threadCounts.push_back((int)(cores / 2));
+    if (cores > 1)
+        threadCounts.push_back((int)cores);
+    size_t blockBytes = 1024 * 1024;
+    int iterations = 3;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--root" && i + 1 < argc)
+            root = argv[++i];
+        else if (arg == "--levels" && i + 1 < argc)
+            levels = parseList(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc)
+            threadCounts = parseList(argv[++i]);
+        else if (arg == "--block" && i + 1 < argc)
+            blockBytes = (size_t)std::max(0, std::atoi(argv[++i])) * 1024;
+        else if (arg == "--iterations" && i + 1 < argc)
+            iterations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (!arg.empty() && arg[0] != '-')
+            paths.push_back(arg);
+        else
+        {
+            LOG_INFO("usage: miniz_bench [--root DIR] [--levels 1,6,9] [--threads 1,4,8] [--block KB] [--iterations N] [--json FILE] [paths...]");
+            return 1;
+        }
+    }
+
+    std::vector<std::string> files;
+    if (paths.empty())
+    {
+        listFiles(root + "/ford_raptor", true, files);
+        listFiles(root + "/models", true, files);
+        std::vector<std::string> top;
+        listFiles(root, false, top);
+        for (size_t i = 0; i < top.size(); ++i)
+            if (extensionOf(top[i]) == "exr")
+                files.push_back(top[i]);
+    }
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        if (isDirectory(paths[i]))
+            listFiles(paths[i], true, files);
+        else
+            files.push_back(paths[i]);
+    }
+    std::sort(files.begin(), files.end());
+
+    static const char *const GROUPS[] = {"geometry", "images", "exr", "text", "other"};
+    const size_t groupCount = sizeof(GROUPS) / sizeof(GROUPS[0]);
+    std::vector<Group> groups(groupCount + 1);
+    for (size_t g = 0; g < groupCount; ++g)
+        groups[g].name = GROUPS[g];
+    Group &exrBlockGroup = groups[groupCount];
+    exrBlockGroup.name = "exr blocks";
+    exrBlockGroup.stored = true;
+
+    std::vector<std::unique_ptr<MappedFile> > mapped;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        std::unique_ptr<MappedFile> file(new MappedFile());
+        if (!file->open(files[i]) || file->size() == 0)
+            continue;
+        const char *kind = groupOf(files[i]);
+        Group &group = *std::find_if(groups.begin(), groups.end(), [&](const Group &g) { return g.name == kind; });
+        const size_t step = blockBytes ? blockBytes : file->size();
+        for (size_t at = 0; at < file->size(); at += step)
+        {
+            Block block = {file->data() + at, std::min(step, file->size() - at), 0};
+            block.rawSize = block.size;
+            group.blocks.push_back(block);
+            group.rawBytes += block.size;
+        }
+#if defined(HAS_TINYEXR)
+        if (std::string(kind) == "exr")
+        {
+            const size_t first = exrBlockGroup.blocks.size();
+            exrBlocks(file->data(), file->size(), exrBlockGroup.blocks);
+            for (size_t b = first; b < exrBlockGroup.blocks.size(); ++b)
+                exrBlockGroup.rawBytes += exrBlockGroup.blocks[b].rawSize;
+        }
+#endif
+        mapped.push_back(std::move(file));
+    }
+    if (mapped.empty())
+    {
+        LOG_ERROR("[miniz_bench] No input files (run from the build directory, or pass --root or paths)");
+        return 1;
+    }
+
+    std::vector<Result> results;
+    bool ok = true;
+    for (size_t g = 0; g < groups.size(); ++g)
+    {
+        const Group &group = groups[g];
+        if (group.blocks.empty())
+            continue;
+        LOG_INFO("[miniz_bench] " << group.name << ": " << group.rawBytes / 1024 << " KiB in " << group.blocks.size() << " blocks");
+        for (size_t l = 0; l < (group.stored ? 1 : levels.size()); ++l)
+            for (size_t t = 0; t < threadCounts.size(); ++t)
+                ok = benchGroup(group, group.stored ? -1 : levels[l], (unsigned int)std::max(1, threadCounts[t]), iterations, results) && ok;
+        asyncLog().flush();
+    }
+
+    if (!jsonPath.empty())
+    {
+        if (writeJson(jsonPath, results))
+            LOG_INFO("[miniz_bench] Wrote " << jsonPath);
+        else
+            LOG_ERROR("[miniz_bench] Cannot write '" << jsonPath << "'");
+    }
+    asyncLog().flush();
+    return ok ? 0 : 1;
+}
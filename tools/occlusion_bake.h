@@ -0,0 +1,238 @@
+#ifndef OCCLUSION_BAKE_H
+#define OCCLUSION_BAKE_H
+
+#include <glm/glm.hpp>
+
+#include <mesh.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Per-vertex ambient occlusion for car_cook: rays over each vertex's cosine-weighted hemisphere are cast
+// against the car's own triangles on the CPU (the cooker has no GL context), and the open fraction goes
+// into PackedVertex::Position[3] next to the handedness, so the runtime gets it with the vertex fetch.
+// Rays are binary (hit within `distance` or not); the directions are a Hammersley set rotated per vertex,
+// so neighbouring vertices don't band on the same few directions.
+namespace OcclusionBake
+{
+    // any-hit ray caster over a triangle soup: a binary BVH split at the median centroid of the longest
+    // axis, nodes depth first (left child = node + 1)
+    class TriangleBvh
+    {
+    public:
+        static const unsigned int LEAF_SIZE = 4;
+
+        void add(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+        {
+            glm::vec3 e1 = b - a, e2 = c - a;
+            // degenerate triangles can't block anything
+            if (glm::dot(glm::cross(e1, e2), glm::cross(e1, e2)) <= 1e-20f)
+                return;
+            Triangle t = {a, e1, e2};
+            triangles.push_back(t);
+        }
+
+        size_t size() const { return triangles.size(); }
+
+        void build()
+        {
+            nodes.clear();
+            if (triangles.empty())
+                return;
+            std::vector<glm::vec3> centroids(triangles.size());
+            for (size_t i = 0; i < triangles.size(); ++i)
+                centroids[i] = triangles[i].v0 + (triangles[i].e1 + triangles[i].e2) / 3.0f;
+            std::vector<unsigned int> order(triangles.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                order[i] = (unsigned int)i;
+            nodes.reserve(2 * (triangles.size() / LEAF_SIZE + 1));
+            buildNode(centroids, order, 0, (unsigned int)order.size());
+            std::vector<Triangle> sorted(triangles.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                sorted[i] = triangles[order[i]];
+            triangles.swap(sorted);
+        }
+
+        // true if anything lies along `origin` + t * `direction` for t in (0, maxT)
+        bool occluded(const glm::vec3 &origin, const glm::vec3 &direction, float maxT) const
+        {
+            if (nodes.empty())
+                return false;
+            glm::vec3 inverse;
+            for (int c = 0; c < 3; ++c)
+                inverse[c] = std::fabs(direction[c]) > 1e-12f ? 1.0f / direction[c] : std::numeric_limits<float>::max();
+            unsigned int stack[64];
+            int top = 0;
+            stack[top++] = 0;
+            while (top > 0)
+            {
+                const Node &node = nodes[stack[--top]];
+                if (!hitsBox(node, origin, inverse, maxT))
+                    continue;
+                if (node.right == 0)
+                {
+                    for (unsigned int i = node.first; i < node.first + node.count; ++i)
+                        if (hitsTriangle(triangles[i], origin, direction, maxT))
+                            return true;
+                    continue;
+                }
+                const unsigned int self = (unsigned int)(&node - &nodes[0]);
+                stack[top++] = node.right;
+                stack[top++] = self + 1;
+            }
+            return false;
+        }
+
+    private:
+        struct Triangle
+        {
+            glm::vec3 v0, e1, e2;
+        };
+        struct Node
+        {
+            glm::vec3 boundsMin, boundsMax;
+            unsigned int first, count;
+            unsigned int right; // 0 = leaf
+        };
+
+        std::vector<Triangle> triangles;
+        std::vector<Node> nodes;
+
+        void buildNode(const std::vector<glm::vec3> &centroids, std::vector<unsigned int> &order, unsigned int first, unsigned int count)
+        {
+            const unsigned int index = (unsigned int)nodes.size();
+            nodes.push_back(Node());
+            Node node;
+            node.first = first;
+            node.count = count;
+            node.right = 0;
+            node.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            node.boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+            glm::vec3 centroidMin = node.boundsMin, centroidMax = node.boundsMax;
+            for (unsigned int i = first; i < first + count; ++i)
+            {
+                const Triangle &t = triangles[order[i]];
+                glm::vec3 b = t.v0 + t.e1, c = t.v0 + t.e2;
+                node.boundsMin = glm::min(node.boundsMin, glm::min(t.v0, glm::min(b, c)));
+                node.boundsMax = glm::max(node.boundsMax, glm::max(t.v0, glm::max(b, c)));
+                centroidMin = glm::min(centroidMin, centroids[order[i]]);
+                centroidMax = glm::max(centroidMax, centroids[order[i]]);
+            }
+            if (count > LEAF_SIZE)
+            {
+                glm::vec3 extent = centroidMax - centroidMin;
+                int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+                unsigned int half = count / 2;
+                std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                                 [&](unsigned int a, unsigned int b) { return centroids[a][axis] < centroids[b][axis]; });
+                buildNode(centroids, order, first, half);
+                node.right = (unsigned int)nodes.size();
+                buildNode(centroids, order, first + half, count - half);
+            }
+            nodes[index] = node;
+        }
+
+        static bool hitsBox(const Node &node, const glm::vec3 &origin, const glm::vec3 &inverse, float maxT)
+        {
+            glm::vec3 t0 = (node.boundsMin - origin) * inverse, t1 = (node.boundsMax - origin) * inverse;
+            glm::vec3 entry = glm::min(t0, t1), leave = glm::max(t0, t1);
+            float enter = std::max(std::max(entry.x, entry.y), std::max(entry.z, 0.0f));
+            float exit = std::min(std::min(leave.x, leave.y), std::min(leave.z, maxT));
+            return enter <= exit;
+        }
+
+        // Moller-Trumbore, both faces
+        static bool hitsTriangle(const Triangle &t, const glm::vec3 &origin, const glm::vec3 &direction, float maxT)
+        {
+            glm::vec3 p = glm::cross(direction, t.e2);
+            float det = glm::dot(t.e1, p);
+            if (std::fabs(det) < 1e-12f)
+                return false;
+            float inverseDet = 1.0f / det;
+            glm::vec3 s = origin - t.v0;
+            float u = glm::dot(s, p) * inverseDet;
+            if (u < 0.0f || u > 1.0f)
+                return false;
+            glm::vec3 q = glm::cross(s, t.e1);
+            float v = glm::dot(direction, q) * inverseDet;
+            if (v < 0.0f || u + v > 1.0f)
+                return false;
+            float hit = glm::dot(t.e2, q) * inverseDet;
+            return hit > 0.0f && hit < maxT;
+        }
+    };
+
+    // the triangles of `v` / `indices`, through `transform`
+    inline void addMesh(TriangleBvh &bvh, const VertexStreams &v, const std::vector<unsigned int> &indices, const glm::mat4 &transform)
+    {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+            bvh.add(glm::vec3(transform * glm::vec4(v.positions[indices[i]], 1.0f)),
+                    glm::vec3(transform * glm::vec4(v.positions[indices[i + 1]], 1.0f)),
+                    glm::vec3(transform * glm::vec4(v.positions[indices[i + 2]], 1.0f)));
+    }
+
+    // radical inverse in base 2 of `i`, the second Hammersley coordinate
+    inline float radicalInverse(uint32_t i)
+    {
+        i = (i << 16u) | (i >> 16u);
+        i = ((i & 0x55555555u) << 1u) | ((i & 0xAAAAAAAAu) >> 1u);
+        i = ((i & 0x33333333u) << 2u) | ((i & 0xCCCCCCCCu) >> 2u);
+        i = ((i & 0x0F0F0F0Fu) << 4u) | ((i & 0xF0F0F0F0u) >> 4u);
+        i = ((i & 0x00FF00FFu) << 8u) | ((i & 0xFF00FF00u) >> 8u);
+        return (float)i * 2.3283064365386963e-10f;
+    }
+
+    // a well-mixed [0, 1) value per vertex for the rotation of its ray set
+    inline float hashUnit(uint32_t x)
+    {
+        x ^= x >> 16u;
+        x *= 0x7feb352du;
+        x ^= x >> 15u;
+        x *= 0x846ca68bu;
+        x ^= x >> 16u;
+        return (float)(x >> 8u) / 16777216.0f;
+    }
+
+    // open fraction (1 = nothing within `distance`) of each vertex of `v` in `transform`'s space against
+    // `bvh`, `rays` per vertex, into `occlusion`. Vertices without a usable normal stay open.
+    inline void bakeVertices(const TriangleBvh &bvh, const VertexStreams &v, const glm::mat4 &transform, unsigned int rays, float distance,
+                             std::vector<float> &occlusion)
+    {
+        occlusion.assign(v.size(), 1.0f);
+        if (rays == 0 || bvh.size() == 0)
+            return;
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+        // off the surface by a thousandth of the ray length, so the ray doesn't hit its own triangles
+        const float bias = distance * 1e-3f;
+        ThreadPool::shared().parallelFor(v.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                glm::vec3 n = normalMatrix * v.normals[i];
+                if (!VertexPacking::usable(n))
+                    continue;
+                n = glm::normalize(n);
+                const glm::vec3 t = VertexPacking::anyTangent(n), b = glm::cross(n, t);
+                const glm::vec3 origin = glm::vec3(transform * glm::vec4(v.positions[i], 1.0f)) + n * bias;
+                const float rotateU = hashUnit((uint32_t)i * 2u), rotateV = hashUnit((uint32_t)i * 2u + 1u);
+                unsigned int open = 0;
+                for (unsigned int r = 0; r < rays; ++r)
+                {
+                    // cosine-weighted: uniform on the disc, lifted onto the hemisphere
+                    float u = std::fmod((r + 0.5f) / rays + rotateU, 1.0f);
+                    float w = std::fmod(radicalInverse(r) + rotateV, 1.0f);
+                    float radius = std::sqrt(u), phi = 6.2831853f * w;
+                    glm::vec3 direction = t * (radius * std::cos(phi)) + b * (radius * std::sin(phi)) + n * std::sqrt(std::max(0.0f, 1.0f - u));
+                    if (!bvh.occluded(origin, direction, distance))
+                        ++open;
+                }
+                occlusion[i] = (float)open / (float)rays;
+            }
+        }, "bake occlusion");
+    }
+}
+
+#endif